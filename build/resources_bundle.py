@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# Packs files into a resources bundle, which shell/common/resources_bundle.cc
+# reads. The bundle is a header followed by the contents of the files, each
+# one starting on a page boundary so that it can be memory mapped on its own:
+#
+#   char[8] magic, "ELBUNDLE"
+#   uint32 version
+#   uint32 number of entries
+#   for each entry:
+#     uint16 length of the name, then the name
+#     uint64 offset of the contents from the start of the file
+#     uint64 size of the contents
+#
+# All numbers are little endian.
+
+import struct
+import sys
+
+MAGIC = b'ELBUNDLE'
+VERSION = 1
+ALIGNMENT = 64 * 1024
+
+
+def align(offset):
+  return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def main(output, entries):
+  files = []
+  for entry in entries:
+    name, path = entry.split('=', 1)
+    with open(path, 'rb') as f:
+      files.append((name.encode('utf-8'), f.read()))
+
+  header_size = len(MAGIC) + 8
+  for name, _ in files:
+    header_size += 2 + len(name) + 16
+
+  header = MAGIC + struct.pack('<II', VERSION, len(files))
+  offset = align(header_size)
+  for name, contents in files:
+    header += struct.pack('<H', len(name)) + name
+    header += struct.pack('<QQ', offset, len(contents))
+    offset = align(offset + len(contents))
+
+  with open(output, 'wb') as o:
+    o.write(header)
+    for _, contents in files:
+      o.seek(align(o.tell()))
+      o.write(contents)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1], sys.argv[2:]))
@@ -57,7 +57,18 @@ const splitPath = (archivePathOrBuffer: string | Buffer) => {
   return asar.splitPath(path.normalize(archivePath));
 };
 
-// Convert asar archive's Stats object to fs's Stats object.
+// The kinds of entries returned by archive.statValues() and statKinds().
+const enum AsarStatKind {
+  NOT_FOUND = -1,
+  FILE = 0,
+  DIRECTORY = 1,
+  LINK = 2
+}
+
+// Filled with the size and the offset of the entry by archive.statValues().
+const statValues = new Float64Array(2);
+
+// Convert asar archive's stat values to fs's Stats object.
 let nextInode = 0;
 
 const uid = process.getuid?.() ?? 0;
@@ -65,16 +76,16 @@ const gid = process.getgid?.() ?? 0;
 
 const fakeTime = new Date();
 
-const asarStatsToFsStats = function (stats: NodeJS.AsarFileStat) {
+const asarStatsToFsStats = function (kind: AsarStatKind, size: number) {
   const { Stats, constants } = require('fs');
 
   let mode = constants.S_IROTH ^ constants.S_IRGRP ^ constants.S_IRUSR ^ constants.S_IWUSR;
 
-  if (stats.isFile) {
+  if (kind === AsarStatKind.FILE) {
     mode ^= constants.S_IFREG;
-  } else if (stats.isDirectory) {
+  } else if (kind === AsarStatKind.DIRECTORY) {
     mode ^= constants.S_IFDIR;
-  } else if (stats.isLink) {
+  } else if (kind === AsarStatKind.LINK) {
     mode ^= constants.S_IFLNK;
   }
 
@@ -87,7 +98,7 @@ const asarStatsToFsStats = function (stats: NodeJS.AsarFileStat) {
     0, // rdev
     undefined, // blksize
     ++nextInode, // ino
-    stats.size,
+    size,
     undefined, // blocks,
     fakeTime.getTime(), // atim_msec
     fakeTime.getTime(), // mtim_msec
@@ -235,6 +246,24 @@ const makePromiseFunction = function (orig: Function, pathArgumentIndex: number)
 
 // Override fs APIs.
 export const wrapFsWithAsar = (fs: Record<string, any>) => {
+  // Read a packed file synchronously and validate its integrity, preferring
+  // the memory-mapped archive over a read through its fd. Compressed files are
+  // decompressed and validated in native code.
+  function readArchiveFileSync (archive: NodeJS.AsarArchive, filePath: string, info: NodeJS.AsarFileInfo) {
+    if (info.packedSize !== undefined) return archive.readCompressed(filePath) || null;
+
+    let buffer = archive.readMappedAndValidateIntegrityLater(info.offset, info.size) || null;
+    if (!buffer) {
+      const fd = archive.getFdAndValidateIntegrityLater();
+      if (!(fd >= 0)) return null;
+
+      buffer = Buffer.alloc(info.size);
+      fs.readSync(fd, buffer, 0, info.size, info.offset);
+    }
+    validateBufferIntegrity(buffer, info.integrity);
+    return buffer;
+  }
+
   const logFDs = new Map<string, number>();
   const logASARAccess = (asarPath: string, filePath: string, offset: number) => {
     if (!process.env.ELECTRON_LOG_ASAR_READS) return;
@@ -256,10 +285,10 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     const archive = getOrCreateArchive(asarPath);
     if (!archive) throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
 
-    const stats = archive.stat(filePath);
-    if (!stats) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+    const kind = archive.statValues(filePath, statValues);
+    if (kind === AsarStatKind.NOT_FOUND) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
 
-    return asarStatsToFsStats(stats);
+    return asarStatsToFsStats(kind, statValues[0]);
   };
 
   const { lstat } = fs;
@@ -279,14 +308,14 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return;
     }
 
-    const stats = archive.stat(filePath);
-    if (!stats) {
+    const kind = archive.statValues(filePath, statValues);
+    if (kind === AsarStatKind.NOT_FOUND) {
       const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
       nextTick(callback, [error]);
       return;
     }
 
-    const fsStats = asarStatsToFsStats(stats);
+    const fsStats = asarStatsToFsStats(kind, statValues[0]);
     nextTick(callback, [null, fsStats]);
   };
 
@@ -395,7 +424,7 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return;
     }
 
-    const pathExists = (archive.stat(filePath) !== false);
+    const pathExists = (archive.statValues(filePath) !== AsarStatKind.NOT_FOUND);
     nextTick(callback, [pathExists]);
   };
 
@@ -410,7 +439,7 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return Promise.reject(error);
     }
 
-    return Promise.resolve(archive.stat(filePath) !== false);
+    return Promise.resolve(archive.statValues(filePath) !== AsarStatKind.NOT_FOUND);
   };
 
   const { existsSync } = fs;
@@ -422,7 +451,7 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     const archive = getOrCreateArchive(asarPath);
     if (!archive) return false;
 
-    return archive.stat(filePath) !== false;
+    return archive.statValues(filePath) !== AsarStatKind.NOT_FOUND;
   };
 
   const { access } = fs;
@@ -455,8 +484,7 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return fs.access(realPath, mode, callback);
     }
 
-    const stats = archive.stat(filePath);
-    if (!stats) {
+    if (archive.statValues(filePath) === AsarStatKind.NOT_FOUND) {
       const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
       nextTick(callback, [error]);
       return;
@@ -496,8 +524,7 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return fs.accessSync(realPath, mode);
     }
 
-    const stats = archive.stat(filePath);
-    if (!stats) {
+    if (archive.statValues(filePath) === AsarStatKind.NOT_FOUND) {
       throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
     }
 
@@ -547,7 +574,8 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
         return fs.readFile(realPath, options, callback);
       }
 
-      const buffer = Buffer.alloc(info.size);
+      const { packedSize } = info;
+      const buffer = Buffer.alloc(packedSize === undefined ? info.size : packedSize);
       const fd = archive.getFdAndValidateIntegrityLater();
       if (!(fd >= 0)) {
         const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
@@ -556,9 +584,21 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       }
 
       logASARAccess(asarPath, filePath, info.offset);
-      fs.read(fd, buffer, 0, info.size, info.offset, (error: Error) => {
-        validateBufferIntegrity(buffer, info.integrity);
-        callback(error, encoding ? buffer.toString(encoding) : buffer);
+      fs.read(fd, buffer, 0, buffer.length, info.offset, (error: Error) => {
+        if (packedSize === undefined) {
+          validateBufferIntegrity(buffer, info.integrity);
+          callback(error, encoding ? buffer.toString(encoding) : buffer);
+          return;
+        }
+
+        // Only the decompression runs on this thread, the frames were read
+        // like those of any other file.
+        const contents = !error && archive.readCompressed(filePath, buffer);
+        if (!contents) {
+          callback(error || createError(AsarError.NOT_FOUND, { asarPath, filePath }));
+          return;
+        }
+        callback(null, encoding ? contents.toString(encoding) : contents);
       });
     }
   }
@@ -611,16 +651,32 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     const { encoding } = options;
-    const buffer = Buffer.alloc(info.size);
-    const fd = archive.getFdAndValidateIntegrityLater();
-    if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
-
     logASARAccess(asarPath, filePath, info.offset);
-    fs.readSync(fd, buffer, 0, info.size, info.offset);
-    validateBufferIntegrity(buffer, info.integrity);
+    const buffer = readArchiveFileSync(archive, filePath, info);
+    if (!buffer) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+
     return (encoding) ? buffer.toString(encoding) : buffer;
   };
 
+  // Stats all the entries of a directory in one call.
+  const toDirents = (archive: NodeJS.AsarArchive, filePath: string, files: string[]) => {
+    const childPaths = files.map(file => path.join(filePath, file));
+    const kinds = archive.statKinds(childPaths) || [];
+    const dirents = [];
+    for (let i = 0; i < files.length; i++) {
+      if (kinds[i] === AsarStatKind.FILE) {
+        dirents.push(new fs.Dirent(files[i], fs.constants.UV_DIRENT_FILE));
+      } else if (kinds[i] === AsarStatKind.DIRECTORY) {
+        dirents.push(new fs.Dirent(files[i], fs.constants.UV_DIRENT_DIR));
+      } else if (kinds[i] === AsarStatKind.LINK) {
+        dirents.push(new fs.Dirent(files[i], fs.constants.UV_DIRENT_LINK));
+      } else {
+        return { dirents, missing: childPaths[i] };
+      }
+    }
+    return { dirents, missing: undefined };
+  };
+
   const { readdir } = fs;
   fs.readdir = function (pathArgument: string, options?: { encoding?: string | null; withFileTypes?: boolean } | null, callback?: Function) {
     const pathInfo = splitPath(pathArgument);
@@ -646,22 +702,11 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-          nextTick(callback!, [error]);
-          return;
-        }
-        if (stats.isFile) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_FILE));
-        } else if (stats.isDirectory) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_DIR));
-        } else if (stats.isLink) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_LINK));
-        }
+      const { dirents, missing } = toDirents(archive, filePath, files);
+      if (missing !== undefined) {
+        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: missing });
+        nextTick(callback!, [error]);
+        return;
       }
       nextTick(callback!, [null, dirents]);
       return;
@@ -691,20 +736,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options && (options as ReaddirSyncOptions).withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        if (stats.isFile) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_FILE));
-        } else if (stats.isDirectory) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_DIR));
-        } else if (stats.isLink) {
-          dirents.push(new fs.Dirent(file, fs.constants.UV_DIRENT_LINK));
-        }
+      const { dirents, missing } = toDirents(archive, filePath, files);
+      if (missing !== undefined) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath: missing });
       }
       return dirents;
     }
@@ -730,32 +764,48 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return [str, str.length > 0];
     }
 
-    const buffer = Buffer.alloc(info.size);
-    const fd = archive.getFdAndValidateIntegrityLater();
-    if (!(fd >= 0)) return [];
-
     logASARAccess(asarPath, filePath, info.offset);
-    fs.readSync(fd, buffer, 0, info.size, info.offset);
-    validateBufferIntegrity(buffer, info.integrity);
+    const buffer = readArchiveFileSync(archive, filePath, info);
+    if (!buffer) return [];
+
     const str = buffer.toString('utf8');
     return [str, str.length > 0];
   };
 
+  // Module resolution stats the candidates of a request one after the other,
+  // the extensions after a missing path and the index files after a
+  // directory. They are stat'ed in one native call with the path before
+  // them, and the results are kept until the next batch.
+  const moduleStatBatch = new Map<string, number>();
+  const statModuleCandidates = (filename: string, result: number) => {
+    moduleStatBatch.clear();
+    const exts = Object.keys(Module._extensions);
+    const base = result === 1 ? path.join(filename, 'index') : filename;
+    const candidates = exts.map(ext => base + ext);
+    const results = asar.moduleStats(candidates);
+    if (!results) return;
+    for (let i = 0; i < candidates.length; i++) {
+      if (results[i] !== -1) moduleStatBatch.set(candidates[i], results[i]);
+    }
+  };
+
   const { internalModuleStat } = internalBinding('fs');
   internalBinding('fs').internalModuleStat = (pathArgument: string) => {
-    const pathInfo = splitPath(pathArgument);
-    if (!pathInfo.isAsar) return internalModuleStat(pathArgument);
-    const { asarPath, filePath } = pathInfo;
-
-    // -ENOENT
-    const archive = getOrCreateArchive(asarPath);
-    if (!archive) return -34;
-
-    // -ENOENT
-    const stats = archive.stat(filePath);
-    if (!stats) return -34;
+    if (isAsarDisabled() || typeof pathArgument !== 'string' || !asarRe.test(pathArgument)) {
+      return internalModuleStat(pathArgument);
+    }
+    const filename = path.normalize(pathArgument);
+    const batched = moduleStatBatch.get(filename);
+    if (batched !== undefined) {
+      moduleStatBatch.delete(filename);
+      return batched;
+    }
 
-    return (stats.isDirectory) ? 1 : 0;
+    // -1 when the path isn't in an archive, -ENOENT when it is missing.
+    const result = asar.moduleStat(filename);
+    if (result === -1) return internalModuleStat(pathArgument);
+    if (result !== 0) statModuleCandidates(filename, result);
+    return result;
   };
 
   // Calling mkdir for directory inside asar archive should throw ENOTDIR
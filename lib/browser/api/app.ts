@@ -105,6 +105,22 @@ if (process.platform === 'linux') {
   };
 }
 
+app.writeStartupTrace = async (filePath: string) => {
+  // The Trace Event Format, which chrome://tracing and Perfetto can open.
+  const traceEvents: Record<string, unknown>[] = [
+    { name: 'process_name', ph: 'M', pid: process.pid, tid: 0, args: { name: 'Browser' } }
+  ];
+  for (const { name, startTime, endTime } of app.getStartupTimeline()) {
+    const event = { name, cat: 'electron', pid: process.pid, tid: 0, ts: Math.round(startTime * 1000) };
+    if (endTime === startTime) {
+      traceEvents.push({ ...event, ph: 'i', s: 'p' });
+    } else {
+      traceEvents.push({ ...event, ph: 'X', dur: Math.round((endTime - startTime) * 1000) });
+    }
+  }
+  await fs.promises.writeFile(filePath, JSON.stringify({ traceEvents }));
+};
+
 // Routes the events to webContents.
 const events = ['certificate-error', 'select-client-certificate'];
 for (const name of events) {
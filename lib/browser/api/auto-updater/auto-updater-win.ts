@@ -2,6 +2,8 @@ import { app } from 'electron/main';
 import { EventEmitter } from 'events';
 import * as squirrelUpdate from '@electron/internal/browser/api/auto-updater/squirrel-update-win';
 
+const { createAsarDelta, applyAsarDelta } = process._linkedBinding('electron_browser_auto_updater');
+
 class AutoUpdater extends EventEmitter {
   updateAvailable: boolean = false;
   updateURL: string | null = null;
@@ -66,6 +68,14 @@ class AutoUpdater extends EventEmitter {
     });
   }
 
+  createAsarDelta (oldPath: string, newPath: string, deltaPath: string) {
+    return createAsarDelta(oldPath, newPath, deltaPath);
+  }
+
+  applyAsarDelta (archivePath: string, deltaPath: string, outputPath: string, options?: { headerHash?: string }) {
+    return applyAsarDelta(archivePath, deltaPath, outputPath, options);
+  }
+
   // Private: Emit both error object and message, this is to keep compatibility
   // with Old APIs.
   emitError (error: Error) {
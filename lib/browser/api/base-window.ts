@@ -126,4 +126,16 @@ BaseWindow.getFocusedWindow = () => {
   return BaseWindow.getAllWindows().find((win) => win.isFocused());
 };
 
+BaseWindow.batch = function <T> (fn: () => T): T {
+  if (typeof fn !== 'function') {
+    throw new TypeError('Expected a function');
+  }
+  BaseWindow._beginBatch();
+  try {
+    return fn();
+  } finally {
+    BaseWindow._endBatch();
+  }
+};
+
 module.exports = BaseWindow;
@@ -109,6 +109,10 @@ BrowserWindow.getFocusedWindow = () => {
   return null;
 };
 
+BrowserWindow.batch = (fn) => {
+  return (BaseWindow as any).batch(fn);
+};
+
 BrowserWindow.fromWebContents = (webContents: WebContents) => {
   return webContents.getOwnerBrowserWindow();
 };
@@ -14,11 +14,24 @@ class CrashReporter {
       submitURL = '',
       uploadToServer = true,
       rateLimit = false,
-      compress = true
+      compress = true,
+      uploadSchedule,
+      referencedMemoryLimit = 0,
+      extraParametersBudget = 0
     } = options || {};
 
     if (uploadToServer && !submitURL) throw new Error('submitURL must be specified when uploadToServer is true');
 
+    if (typeof referencedMemoryLimit !== 'number' || referencedMemoryLimit < 0) {
+      throw new Error('referencedMemoryLimit must be a non-negative Number');
+    }
+    if (typeof extraParametersBudget !== 'number' || extraParametersBudget < 0) {
+      throw new Error('extraParametersBudget must be a non-negative Number');
+    }
+    if (uploadSchedule !== undefined && (typeof uploadSchedule !== 'object' || uploadSchedule === null)) {
+      throw new Error('uploadSchedule must be an Object');
+    }
+
     if (!compress && uploadToServer) {
       deprecate.log('Sending uncompressed crash reports is deprecated and will be removed in a future version of Electron. Set { compress: true } to opt-in to the new behavior. Crash reports will be uploaded gzipped, which most crash reporting servers support.');
     }
@@ -33,8 +46,20 @@ class CrashReporter {
       ...globalExtra
     };
 
-    binding.start(submitURL, uploadToServer,
-      ignoreSystemCrashHandler, rateLimit, compress, globalExtraAmended, extra, false);
+    // With a schedule, the handler doesn't upload the reports by itself.
+    binding.start(submitURL, uploadToServer && !uploadSchedule,
+      ignoreSystemCrashHandler, rateLimit, compress, globalExtraAmended, extra, false,
+      referencedMemoryLimit, extraParametersBudget);
+
+    if (uploadSchedule) {
+      const {
+        interval = 5 * 60 * 1000,
+        idleTime = 60,
+        maxUploadsPerHour = 10,
+        allowCellular = false
+      } = uploadSchedule;
+      binding.startUploadScheduler(uploadToServer, interval, idleTime, maxUploadsPerHour, allowCellular);
+    }
   }
 
   getLastCrashReport () {
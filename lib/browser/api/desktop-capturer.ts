@@ -1,5 +1,17 @@
+import { EventEmitter } from 'events';
 const { createDesktopCapturer } = process._linkedBinding('electron_browser_desktop_capturer');
 
+// The thumbnails produced by getSources and watchSources, by source id. They
+// are passed to the watchers until the sources get new thumbnails.
+const thumbnailCache = new Map<string, { size: Electron.Size, thumbnail: Electron.NativeImage }>();
+
+const getCachedThumbnail = (id: string, size: Electron.Size) => {
+  const cached = thumbnailCache.get(id);
+  if (cached && cached.size.width === size.width && cached.size.height === size.height) {
+    return cached.thumbnail;
+  }
+};
+
 const deepEqual = (a: ElectronInternal.GetSourcesOptions, b: ElectronInternal.GetSourcesOptions) => JSON.stringify(a) === JSON.stringify(b);
 
 let currentlyRunning: {
@@ -56,6 +68,17 @@ export async function getSources (args: Electron.SourcesOptions) {
 
     capturer._onfinished = (sources: Electron.DesktopCapturerSource[]) => {
       stopRunning();
+      // Drop the thumbnails of the sources which no longer exist.
+      const ids = new Set(sources.map(source => source.id));
+      for (const id of thumbnailCache.keys()) {
+        const type = id.split(':')[0] as Electron.SourcesOptions['types'][number];
+        if (args.types.includes(type) && !ids.has(id)) thumbnailCache.delete(id);
+      }
+      for (const source of sources) {
+        if (!source.thumbnail.isEmpty()) {
+          thumbnailCache.set(source.id, { size: thumbnailSize, thumbnail: source.thumbnail });
+        }
+      }
       resolve(sources);
     };
 
@@ -69,3 +92,67 @@ export async function getSources (args: Electron.SourcesOptions) {
 
   return getSources;
 }
+
+class DesktopSourcesWatcher extends EventEmitter {
+  #capturer: ElectronInternal.DesktopCapturer | null;
+  #sources = new Map<string, Electron.DesktopCapturerSource>();
+
+  constructor (args: Electron.WatchSourcesOptions) {
+    super();
+
+    const captureWindow = args.types.includes('window');
+    const captureScreen = args.types.includes('screen');
+
+    const { thumbnailSize = { width: 150, height: 150 } } = args;
+    const { fetchWindowIcons = false } = args;
+    const { refreshInterval = 1000, maxThumbnailUpdatesPerSecond = 10 } = args;
+
+    const capturer = this.#capturer = createDesktopCapturer();
+
+    capturer._onsourceadded = (source) => {
+      const thumbnail = getCachedThumbnail(source.id, thumbnailSize);
+      if (thumbnail) source.thumbnail = thumbnail;
+      this.#sources.set(source.id, source);
+      this.emit('source-added', source);
+    };
+
+    capturer._onsourceremoved = (id) => {
+      this.#sources.delete(id);
+      thumbnailCache.delete(id);
+      this.emit('source-removed', id);
+    };
+
+    capturer._onsourcenamechanged = (id, name) => {
+      const source = this.#sources.get(id);
+      if (source) source.name = name;
+      this.emit('source-name-changed', id, name);
+    };
+
+    capturer._onthumbnailschanged = (updates) => {
+      for (const { id, thumbnail } of updates) {
+        const source = this.#sources.get(id);
+        if (source) source.thumbnail = thumbnail;
+        thumbnailCache.set(id, { size: thumbnailSize, thumbnail });
+        this.emit('thumbnail-changed', id, thumbnail);
+      }
+    };
+
+    capturer.startWatching(captureWindow, captureScreen, thumbnailSize, fetchWindowIcons, refreshInterval, maxThumbnailUpdatesPerSecond);
+  }
+
+  getSources () {
+    return [...this.#sources.values()];
+  }
+
+  stop () {
+    if (this.#capturer) {
+      this.#capturer.stopWatching();
+      this.#capturer = null;
+    }
+  }
+}
+
+export function watchSources (args: Electron.WatchSourcesOptions) {
+  if (!isValid(args)) throw new Error('Invalid options');
+  return new DesktopSourcesWatcher(args);
+}
@@ -0,0 +1,3 @@
+const { FileWatcher } = process._linkedBinding('electron_browser_file_watcher');
+
+export default FileWatcher;
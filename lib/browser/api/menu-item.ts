@@ -3,6 +3,9 @@ import { Menu, BrowserWindow, WebContents, KeyboardEvent } from 'electron/main';
 
 let nextCommandId = 0;
 
+// Changing these once the item is in a menu updates the native menus in place.
+const observedProperties = ['label', 'sublabel', 'toolTip', 'enabled', 'visible', 'checked'];
+
 const MenuItem = function (this: any, options: any) {
   // Preserve extra fields specified by user
   for (const key in options) {
@@ -36,6 +39,9 @@ const MenuItem = function (this: any, options: any) {
   this.overrideProperty('checked', false);
   this.overrideProperty('acceleratorWorksWhenHidden', true);
   this.overrideProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
+  for (const name of observedProperties) {
+    this.overrideObservedProperty(name);
+  }
 
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`);
@@ -87,6 +93,20 @@ MenuItem.prototype.overrideProperty = function (name: string, defaultValue: any
   }
 };
 
+MenuItem.prototype.overrideObservedProperty = function (name: string) {
+  let value = this[name];
+  Object.defineProperty(this, name, {
+    configurable: true,
+    enumerable: true,
+    get: () => value,
+    set: (newValue) => {
+      if (newValue === value) return;
+      value = newValue;
+      if (this.menu) this.menu._itemChanged(this, name);
+    }
+  });
+};
+
 MenuItem.prototype.overrideReadOnlyProperty = function (name: string, defaultValue: any) {
   this.overrideProperty(name, defaultValue);
   Object.defineProperty(this, name, {
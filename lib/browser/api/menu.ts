@@ -65,6 +65,15 @@ Menu.prototype._menuWillShow = function () {
   }
 };
 
+Menu.prototype._itemChanged = function (item, property) {
+  const index = this.items.indexOf(item);
+  if (index === -1) return;
+  if (property === 'label') this.setLabel(index, item.label);
+  else if (property === 'sublabel') this.setSublabel(index, item.sublabel);
+  else if (property === 'toolTip') this.setToolTip(index, item.toolTip);
+  this._notifyItemChanged(index);
+};
+
 Menu.prototype.popup = function (options = {}) {
   if (options == null || typeof options !== 'object') {
     throw new TypeError('Options must be an object');
@@ -281,9 +290,15 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
         get: () => checked.get(item),
         set: () => {
           this.groupsMap[item.groupId].forEach(other => {
-            if (other !== item) checked.set(other, false);
+            if (other !== item && checked.get(other)) {
+              checked.set(other, false);
+              this._itemChanged(other, 'checked');
+            }
           });
-          checked.set(item, true);
+          if (!checked.get(item)) {
+            checked.set(item, true);
+            this._itemChanged(item, 'checked');
+          }
         }
       });
       this.insertRadioItem(pos, item.commandId, item.label, item.groupId);
@@ -12,6 +12,7 @@ export const browserModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'crashReporter', loader: () => require('./crash-reporter') },
   { name: 'desktopCapturer', loader: () => require('./desktop-capturer') },
   { name: 'dialog', loader: () => require('./dialog') },
+  { name: 'FileWatcher', loader: () => require('./file-watcher') },
   { name: 'globalShortcut', loader: () => require('./global-shortcut') },
   { name: 'ipcMain', loader: () => require('./ipc-main') },
   { name: 'inAppPurchase', loader: () => require('./in-app-purchase') },
@@ -22,6 +23,7 @@ export const browserModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'net', loader: () => require('./net') },
   { name: 'netLog', loader: () => require('./net-log') },
   { name: 'Notification', loader: () => require('./notification') },
+  { name: 'OffscreenCaptureGroup', loader: () => require('./offscreen-capture-group') },
   { name: 'powerMonitor', loader: () => require('./power-monitor') },
   { name: 'powerSaveBlocker', loader: () => require('./power-save-blocker') },
   { name: 'pushNotifications', loader: () => require('./push-notifications') },
@@ -12,6 +12,9 @@ const { Session } = process._linkedBinding('electron_browser_session');
 
 const kHttpProtocols = new Set(['http:', 'https:']);
 
+// Same as the limit of the URL loader.
+const kMaxReadSize = 64 * 1024 * 1024;
+
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
 const discardableDuplicateHeaders = new Set([
@@ -88,6 +91,10 @@ class IncomingMessage extends Readable {
     return this._responseHead.httpVersion.minor;
   }
 
+  get fromCache () {
+    return this._responseHead.fromCache;
+  }
+
   get rawTrailers () {
     throw new Error('HTTP trailers are not supported');
   }
@@ -255,6 +262,10 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     throw new Error('redirect mode should be one of follow, error or manual');
   }
 
+  if (options.readSize != null && !(Number.isInteger(options.readSize) && options.readSize > 0 && options.readSize <= kMaxReadSize)) {
+    throw new TypeError(`readSize must be between 1 and ${kMaxReadSize}`);
+  }
+
   if (options.headers != null && typeof options.headers !== 'object') {
     throw new TypeError('headers must be an object');
   }
@@ -270,6 +281,9 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     origin: options.origin,
     referrerPolicy: options.referrerPolicy,
     cache: options.cache,
+    responseFile: options.responseFile,
+    readSize: options.readSize,
+    uploadFile: options.uploadFile,
     allowNonHttpProtocols: Object.hasOwn(options, kAllowNonHttpProtocols)
   };
   const headers: Record<string, string | string[]> = options.headers || {};
@@ -394,7 +408,11 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
-  _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
+  _write (chunk: Buffer, encoding: BufferEncoding, callback: (error?: Error) => void) {
+    if (this._urlLoaderOptions.uploadFile) {
+      callback(new Error('Cannot write to a request which uploads a file'));
+      return;
+    }
     this._firstWrite = true;
     if (!this._body) {
       this._body = new SlurpStream();
@@ -0,0 +1,3 @@
+const { OffscreenCaptureGroup } = process._linkedBinding('electron_browser_capture_group');
+
+export default OffscreenCaptureGroup;
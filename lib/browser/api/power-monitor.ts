@@ -9,6 +9,9 @@ const {
 } = process._linkedBinding('electron_browser_power_monitor');
 
 class PowerMonitor extends EventEmitter {
+  #pm: any;
+  #idleThreshold = 0;
+
   constructor () {
     super();
     // Don't start the event source until both a) the app is ready and b)
@@ -16,6 +19,8 @@ class PowerMonitor extends EventEmitter {
     this.once('newListener', () => {
       const pm = createPowerMonitor();
       pm.emit = this.emit.bind(this);
+      this.#pm = pm;
+      if (this.#idleThreshold > 0) pm.setIdleThreshold(this.#idleThreshold);
 
       if (process.platform === 'linux') {
         // On Linux, we inhibit shutdown in order to give the app a chance to
@@ -41,6 +46,14 @@ class PowerMonitor extends EventEmitter {
     return getSystemIdleState(idleThreshold);
   }
 
+  setIdleThreshold (idleThreshold: number) {
+    if (!Number.isInteger(idleThreshold) || idleThreshold < 0) {
+      throw new TypeError('Invalid idle threshold, must be a non-negative integer');
+    }
+    this.#idleThreshold = idleThreshold;
+    this.#pm?.setIdleThreshold(idleThreshold);
+  }
+
   getCurrentThermalState () {
     return getCurrentThermalState();
   }
@@ -114,6 +114,11 @@ Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, h
   if (!success) throw new Error(`Failed to register protocol: ${scheme}`);
 };
 
+Protocol.prototype.handleDirectory = function (this: Electron.Protocol, scheme: string, options: Electron.DirectoryProtocolOptions) {
+  if (isBuiltInScheme(scheme)) throw new Error(`Cannot serve a directory on built-in scheme: ${scheme}`);
+  if (!this.registerDirectoryProtocol(scheme, options)) throw new Error(`Failed to register protocol: ${scheme}`);
+};
+
 Protocol.prototype.unhandle = function (this: Electron.Protocol, scheme: string) {
   const unregister = isBuiltInScheme(scheme) ? this.uninterceptProtocol : this.unregisterProtocol;
   if (!unregister.call(this, scheme)) { throw new Error(`Failed to unhandle protocol: ${scheme}`); }
@@ -144,6 +149,7 @@ const protocol = {
   uninterceptProtocol: (...args) => session.defaultSession.protocol.uninterceptProtocol(...args),
   isProtocolIntercepted: (...args) => session.defaultSession.protocol.isProtocolIntercepted(...args),
   handle: (...args) => session.defaultSession.protocol.handle(...args),
+  handleDirectory: (...args) => session.defaultSession.protocol.handleDirectory(...args),
   unhandle: (...args) => session.defaultSession.protocol.unhandle(...args),
   isProtocolHandled: (...args) => session.defaultSession.protocol.isProtocolHandled(...args)
 } as typeof Electron.protocol;
@@ -1,12 +1,57 @@
 import { fetchWithSession } from '@electron/internal/browser/api/net-fetch';
-const { fromPartition, fromPath, Session } = process._linkedBinding('electron_browser_session');
+import { Readable } from 'stream';
+import { setCodeCachePath } from '@electron/internal/browser/preload-code-cache';
+const { fromPartition, fromPartitionAsync, fromPath, Session } = process._linkedBinding('electron_browser_session');
 
 Session.prototype.fetch = function (input: RequestInfo, init?: RequestInit) {
   return fetchWithSession(input, init, this);
 };
 
+Session.prototype.getBlobDataStream = function (identifier: string) {
+  const dataPipe = this._getBlobDataPipe(identifier);
+  if (!dataPipe) throw new Error('Could not get blob data handle');
+  // The next chunk is only read once the stream wants more data.
+  return new Readable({
+    read () {
+      dataPipe.read().then((chunk: Buffer | null) => {
+        this.push(chunk);
+      }, (error: Error) => {
+        this.destroy(error);
+      });
+    }
+  });
+};
+
+// The clears with a signal need an id for the native side to cancel them.
+let nextStorageClearId = 0;
+const withAbortSignal = function (session: Electron.Session, signal: AbortSignal | undefined, run: (id?: number) => Promise<void>) {
+  if (!signal) return run();
+  if (signal.aborted) return Promise.reject(new Error('The operation was aborted.'));
+  const id = ++nextStorageClearId;
+  const onAbort = () => session._cancelStorageClear(id);
+  signal.addEventListener('abort', onAbort);
+  return run(id).finally(() => signal.removeEventListener('abort', onAbort));
+};
+
+const { clearStorageData: clearStorageDataNative, evictStorage: evictStorageNative } = Session.prototype;
+Session.prototype.clearStorageData = function (options?: Electron.ClearStorageDataOptions) {
+  const { signal, ...rest } = options || {};
+  return withAbortSignal(this, signal, id => clearStorageDataNative.call(this, { ...rest, id }));
+};
+Session.prototype.evictStorage = function (origins: string[], options?: Electron.EvictStorageOptions) {
+  const { signal, ...rest } = options || {};
+  return withAbortSignal(this, signal, id => evictStorageNative.call(this, origins, { ...rest, id }));
+};
+
+const { setCodeCachePath: setCodeCachePathNative } = Session.prototype;
+Session.prototype.setCodeCachePath = function (path: string) {
+  setCodeCachePathNative.call(this, path);
+  setCodeCachePath(this, path);
+};
+
 export default {
   fromPartition,
+  fromPartitionAsync,
   fromPath,
   get defaultSession () {
     return fromPartition('');
@@ -1,11 +1,26 @@
 import { EventEmitter } from 'events';
 import { Duplex, PassThrough } from 'stream';
 import { Socket } from 'net';
+import * as os from 'os';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
-const { _fork } = process._linkedBinding('electron_browser_utility_process');
+const { _fork, setSpareProcessCount: _setSpareProcessCount, getLaunchMetrics } = process._linkedBinding('electron_browser_utility_process');
+
+function parseStdioSink (sink: Electron.UtilityProcessStdioSink, stream: string) {
+  if (sink.type === 'file') {
+    if (typeof sink.path !== 'string') {
+      throw new Error(`${stream} file sink must have a path.`);
+    }
+    return { path: sink.path, maxSize: sink.maxSize, maxFiles: sink.maxFiles };
+  } else if (sink.type === 'buffer') {
+    return { bufferSize: sink.size };
+  }
+  throw new Error(`${stream} sink type must be file or buffer.`);
+}
 
 class ForkUtilityProcess extends EventEmitter {
   #handle: ElectronInternal.UtilityProcessWrapper | null;
+  // Kept after the process exits, so that the output it buffered can be read.
+  #sinkHandle: ElectronInternal.UtilityProcessWrapper | null = null;
   #stdout: Duplex | null = null;
   #stderr: Duplex | null = null;
   constructor (modulePath: string, args?: string[], options?: Electron.ForkOptions) {
@@ -72,16 +87,26 @@ class ForkUtilityProcess extends EventEmitter {
           throw new Error('stdin value other than ignore is not supported.');
         }
 
+        const stdioSinks: Record<string, object> = {};
         if (options.stdio[1] === 'pipe') {
           this.#stdout = new PassThrough();
+        } else if (typeof options.stdio[1] === 'object' && options.stdio[1] !== null) {
+          stdioSinks.stdout = parseStdioSink(options.stdio[1], 'stdout');
         } else if (options.stdio[1] !== 'ignore' && options.stdio[1] !== 'inherit') {
-          throw new Error('stdout configuration must be of the following values: inherit, pipe, ignore');
+          throw new Error('stdout configuration must be of the following values: inherit, pipe, ignore, or a sink');
         }
 
         if (options.stdio[2] === 'pipe') {
           this.#stderr = new PassThrough();
+        } else if (typeof options.stdio[2] === 'object' && options.stdio[2] !== null) {
+          stdioSinks.stderr = parseStdioSink(options.stdio[2], 'stderr');
         } else if (options.stdio[2] !== 'ignore' && options.stdio[2] !== 'inherit') {
-          throw new Error('stderr configuration must be of the following values: inherit, pipe, ignore');
+          throw new Error('stderr configuration must be of the following values: inherit, pipe, ignore, or a sink');
+        }
+
+        if (Object.keys(stdioSinks).length > 0) {
+          (options as any).stdioSinks = stdioSinks;
+          options.stdio = options.stdio.map(value => typeof value === 'object' ? 'sink' : value) as any;
         }
       } else {
         throw new Error('configuration missing for stdin, stdout or stderr.');
@@ -89,6 +114,9 @@ class ForkUtilityProcess extends EventEmitter {
     }
 
     this.#handle = _fork({ options, modulePath, args });
+    if ((options as any).stdioSinks) {
+      this.#sinkHandle = this.#handle;
+    }
     this.#handle!.emit = (channel: string | symbol, ...args: any[]) => {
       if (channel === 'exit') {
         try {
@@ -129,12 +157,73 @@ class ForkUtilityProcess extends EventEmitter {
     return this.#stderr;
   }
 
-  postMessage (message: any, transfer?: MessagePortMain[]) {
+  get bufferedAmount () {
+    return this.#handle?.bufferedAmount ?? 0;
+  }
+
+  postMessage (message: any, transfer?: (MessagePortMain | ArrayBuffer)[]) {
     if (Array.isArray(transfer)) {
       transfer = transfer.map((o: any) => o instanceof MessagePortMain ? o._internalPort : o);
-      return this.#handle?.postMessage(message, transfer);
+      return this.#handle?.postMessage(message, transfer) ?? false;
+    }
+    return this.#handle?.postMessage(message) ?? false;
+  }
+
+  setWatermarks (watermarks: Electron.Watermarks) {
+    this.#handle?.setWatermarks(watermarks);
+  }
+
+  async invoke (channel: string, ...args: any[]) : Promise<any> {
+    if (typeof channel !== 'string') {
+      throw new TypeError('channel must be a string.');
+    }
+    if (this.#handle === null) {
+      throw new Error(`Utility process exited before replying to '${channel}'`);
+    }
+    const { error, result } = await this.#handle.invoke(channel, args);
+    if (error) {
+      throw new Error(`Error invoking remote method '${channel}': ${error}`);
+    }
+    return result;
+  }
+
+  createSharedBuffer (name: string, size: number) : SharedArrayBuffer {
+    if (typeof name !== 'string') {
+      throw new TypeError('name must be a string.');
     }
-    return this.#handle?.postMessage(message);
+    if (this.#handle === null) {
+      throw new Error('Failed to share a buffer with exited utility process');
+    }
+    return this.#handle.createSharedBuffer(name, size);
+  }
+
+  routeInvoke (channel: string) : void {
+    if (typeof channel !== 'string') {
+      throw new TypeError('channel must be a string.');
+    }
+    this.#handle?.routeInvoke(channel);
+  }
+
+  unrouteInvoke (channel: string) : void {
+    this.#handle?.unrouteInvoke(channel);
+  }
+
+  takeHeapSnapshot (filePath: string, options: Electron.TakeHeapSnapshotOptions = {}) : Promise<void> {
+    const { compression = 'none', graphOnly = false } = options;
+    if (compression !== 'none' && compression !== 'gzip') {
+      return Promise.reject(new Error(`Invalid compression: ${compression}`));
+    }
+    if (this.#handle === null) {
+      return Promise.reject(new Error('Failed to take heap snapshot of exited utility process'));
+    }
+    return this.#handle.takeHeapSnapshot(filePath, compression === 'gzip', !!graphOnly);
+  }
+
+  readOutput (stream: 'stdout' | 'stderr') : Electron.UtilityProcessOutput | null {
+    if (stream !== 'stdout' && stream !== 'stderr') {
+      throw new TypeError('stream must be stdout or stderr.');
+    }
+    return this.#sinkHandle?.readOutput(stream) ?? null;
   }
 
   kill () : boolean {
@@ -148,3 +237,189 @@ class ForkUtilityProcess extends EventEmitter {
 export function fork (modulePath: string, args?: string[], options?: Electron.ForkOptions) {
   return new ForkUtilityProcess(modulePath, args, options);
 }
+
+type PoolWorker = {
+  child: ForkUtilityProcess | null;
+  spawnedAt: number;
+  running: number;
+  completed: number;
+  restarts: number;
+  restartDelay: number;
+};
+
+type PoolTask = {
+  args: any[];
+  queuedAt: number;
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+};
+
+// Workers which exit sooner than this after being spawned are restarted with
+// a growing delay, so that a module which throws on startup doesn't keep
+// the pool respawning it in a loop.
+const kMinWorkerUptime = 1000;
+const kMaxRestartDelay = 10000;
+
+class UtilityProcessPool extends EventEmitter {
+  #modulePath: string;
+  #args: string[];
+  #forkOptions: Electron.ForkOptions;
+  #channel: string;
+  #concurrency: number;
+  #workers: PoolWorker[] = [];
+  #queue: PoolTask[] = [];
+  #closed = false;
+  #completed = 0;
+  #failed = 0;
+  #totalWaitTime = 0;
+  #totalRunTime = 0;
+
+  constructor (modulePath: string, args?: string[], options?: Electron.UtilityProcessPoolOptions) {
+    super();
+    if (args != null && typeof args === 'object' && !Array.isArray(args)) {
+      options = args;
+      args = [];
+    }
+    const { size = Math.max(os.cpus().length - 1, 1), channel = 'task', concurrency = 1, forkOptions = {} } = options || {};
+    if (!Number.isInteger(size) || size < 1) {
+      throw new Error('size must be a positive integer.');
+    }
+    if (!Number.isInteger(concurrency) || concurrency < 1) {
+      throw new Error('concurrency must be a positive integer.');
+    }
+    if (typeof channel !== 'string') {
+      throw new TypeError('channel must be a string.');
+    }
+    this.#modulePath = modulePath;
+    this.#args = args || [];
+    this.#forkOptions = forkOptions as Electron.ForkOptions;
+    this.#channel = channel;
+    this.#concurrency = concurrency;
+    for (let i = 0; i < size; i++) {
+      const worker = { child: null, spawnedAt: 0, running: 0, completed: 0, restarts: 0, restartDelay: 0 };
+      this.#workers.push(worker);
+      this.#spawn(worker);
+    }
+  }
+
+  #spawn (worker: PoolWorker) {
+    const child = new ForkUtilityProcess(this.#modulePath, this.#args, this.#forkOptions);
+    worker.child = child;
+    worker.spawnedAt = performance.now();
+    worker.running = 0;
+    child.once('exit', (code: number) => {
+      worker.child = null;
+      if (this.#closed) return;
+      this.emit('worker-exit', this.#workers.indexOf(worker), code);
+      const uptime = performance.now() - worker.spawnedAt;
+      worker.restartDelay = uptime < kMinWorkerUptime ? Math.min(Math.max(worker.restartDelay * 2, 100), kMaxRestartDelay) : 0;
+      worker.restarts++;
+      setTimeout(() => {
+        if (this.#closed) return;
+        this.#spawn(worker);
+        this.#dispatch();
+      }, worker.restartDelay);
+    });
+  }
+
+  // Tasks wait in the pool rather than in the workers, so that whichever
+  // worker frees up first takes the next one, and they go to the least busy
+  // worker when several can take them.
+  #dispatch () {
+    while (this.#queue.length > 0) {
+      let target: PoolWorker | null = null;
+      for (const worker of this.#workers) {
+        if (worker.child && worker.running < this.#concurrency && (!target || worker.running < target.running)) {
+          target = worker;
+        }
+      }
+      if (!target) return;
+      this.#runTask(target, this.#queue.shift()!);
+    }
+  }
+
+  #runTask (worker: PoolWorker, task: PoolTask) {
+    const child = worker.child!;
+    const startedAt = performance.now();
+    this.#totalWaitTime += startedAt - task.queuedAt;
+    worker.running++;
+    const done = (error: Error | null, result?: any) => {
+      this.#totalRunTime += performance.now() - startedAt;
+      // The counts of a worker start over when it is restarted.
+      if (worker.child === child) {
+        worker.running--;
+        if (!error) worker.completed++;
+      }
+      if (error) {
+        this.#failed++;
+        task.reject(error);
+      } else {
+        this.#completed++;
+        task.resolve(result);
+      }
+      this.#dispatch();
+    };
+    child.invoke(this.#channel, ...task.args).then(result => done(null, result), error => done(error));
+  }
+
+  run (...args: any[]) : Promise<any> {
+    if (this.#closed) {
+      return Promise.reject(new Error('The pool is closed'));
+    }
+    return new Promise((resolve, reject) => {
+      this.#queue.push({ args, queuedAt: performance.now(), resolve, reject });
+      this.#dispatch();
+    });
+  }
+
+  getMetrics () {
+    const settled = this.#completed + this.#failed;
+    let running = 0;
+    let restarts = 0;
+    for (const worker of this.#workers) {
+      running += worker.running;
+      restarts += worker.restarts;
+    }
+    return {
+      queueDepth: this.#queue.length,
+      running,
+      completed: this.#completed,
+      failed: this.#failed,
+      restarts,
+      averageWaitTime: settled ? this.#totalWaitTime / settled : 0,
+      averageRunTime: settled ? this.#totalRunTime / settled : 0,
+      workers: this.#workers.map(worker => ({
+        pid: worker.child?.pid,
+        running: worker.running,
+        completed: worker.completed,
+        restarts: worker.restarts
+      }))
+    };
+  }
+
+  close () : void {
+    if (this.#closed) return;
+    this.#closed = true;
+    const queue = this.#queue;
+    this.#queue = [];
+    for (const task of queue) {
+      task.reject(new Error('The pool is closed'));
+    }
+    for (const worker of this.#workers) {
+      worker.child?.kill();
+    }
+  }
+}
+
+export function createPool (modulePath: string, args?: string[], options?: Electron.UtilityProcessPoolOptions) {
+  return new UtilityProcessPool(modulePath, args, options);
+}
+
+export function setSpareProcessCount (count: number) {
+  if (!Number.isInteger(count) || count < 0) {
+    throw new TypeError('count must be a non-negative integer.');
+  }
+  _setSpareProcessCount(count);
+}
+
+export { getLaunchMetrics };
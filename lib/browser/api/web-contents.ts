@@ -4,6 +4,7 @@ import type { BrowserWindowConstructorOptions, LoadURLOptions } from 'electron/m
 import * as url from 'url';
 import * as path from 'path';
 import { openGuestWindow, makeWebPreferences, parseContentTypeFormat } from '@electron/internal/browser/guest-window-manager';
+import { setWebviewPool, getWebviewAttachMetrics } from '@electron/internal/browser/guest-view-manager';
 import { parseFeatures } from '@electron/internal/browser/parse-features-string';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
@@ -186,10 +187,70 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (worldId
   await waitTillCanExecuteJavaScript(this);
   return ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, 'executeJavaScriptInIsolatedWorld', worldId, code, !!hasUserGesture);
 };
+WebContents.prototype.executeJavaScriptInFrames = async function (code, frames, hasUserGesture) {
+  if (frames !== undefined && !Array.isArray(frames)) {
+    throw new TypeError('frames must be an array of WebFrameMain');
+  }
+  await waitTillCanExecuteJavaScript(this);
+
+  const targets: Electron.WebFrameMain[] = frames ?? this.mainFrame.framesInSubtree;
+  // One request per renderer process, which runs the script in all of its
+  // frames.
+  const framesByProcess = new Map<number, Electron.WebFrameMain[]>();
+  for (const frame of new Set(targets)) {
+    const processFrames = framesByProcess.get(frame.processId);
+    if (processFrames) {
+      processFrames.push(frame);
+    } else {
+      framesByProcess.set(frame.processId, [frame]);
+    }
+  }
+
+  const results = new Map<Electron.WebFrameMain, { result?: any, error?: string }>();
+  await Promise.all(Array.from(framesByProcess.values(), async (processFrames) => {
+    let replies: { result?: any, error?: string }[];
+    try {
+      replies = await processFrames[0]._executeJavaScriptInFrames(
+        String(code), processFrames.map(frame => frame.routingId), !!hasUserGesture);
+    } catch (error: any) {
+      replies = processFrames.map(() => ({ error: error.message }));
+    }
+    processFrames.forEach((frame, i) => results.set(frame, replies[i]));
+  }));
+
+  return targets.map(frame => ({ frame, ...results.get(frame) }));
+};
+
+// Runs in the main world of each frame, where the media elements are.
+const collectMediaPlaybackStats = `Array.from(document.querySelectorAll('audio, video'), (element) => {
+  const isVideo = element instanceof HTMLVideoElement;
+  const quality = isVideo ? element.getVideoPlaybackQuality() : null;
+  return {
+    kind: isVideo ? 'video' : 'audio',
+    src: element.currentSrc,
+    paused: element.paused,
+    currentTime: element.currentTime,
+    duration: element.duration,
+    readyState: element.readyState,
+    videoWidth: isVideo ? element.videoWidth : 0,
+    videoHeight: isVideo ? element.videoHeight : 0,
+    totalVideoFrames: quality ? quality.totalVideoFrames : 0,
+    droppedVideoFrames: quality ? quality.droppedVideoFrames : 0
+  };
+})`;
+
+WebContents.prototype.getMediaPlaybackStats = async function () {
+  const results = await this.executeJavaScriptInFrames(collectMediaPlaybackStats);
+  // Frames which went away or threw have no media to report.
+  return results.flatMap(({ frame, result }) =>
+    Array.isArray(result) ? result.map((stats) => ({ frame, ...stats })) : []);
+};
 
 // Translate the options of printToPDF.
 
-let pendingPromise: Promise<any> | undefined;
+// The jobs of a webContents are run one after the other, the ones of
+// different webContents are composited in parallel.
+const pendingPrints = new WeakMap<Electron.WebContents, Promise<any>>();
 WebContents.prototype.printToPDF = async function (options) {
   const printSettings: Record<string, any> = {
     requestID: getNextId(),
@@ -322,13 +383,20 @@ WebContents.prototype.printToPDF = async function (options) {
     printSettings.preferCSSPageSize = options.preferCSSPageSize;
   }
 
-  if (this._printToPDF) {
-    if (pendingPromise) {
-      pendingPromise = pendingPromise.then(() => this._printToPDF(printSettings));
-    } else {
-      pendingPromise = this._printToPDF(printSettings);
+  if (options.path !== undefined) {
+    if (typeof options.path !== 'string') {
+      return Promise.reject(new Error('path must be a String'));
     }
-    return pendingPromise;
+    printSettings.path = options.path;
+  }
+
+  if (this._printToPDF) {
+    const print = () => this._printToPDF(printSettings);
+    const pending = pendingPrints.get(this);
+    // A job which failed doesn't fail the ones queued after it.
+    const promise = pending ? pending.then(print, print) : print();
+    pendingPrints.set(this, promise);
+    return promise;
   } else {
     const error = new Error('Printing feature is disabled');
     return Promise.reject(error);
@@ -496,6 +564,14 @@ WebContents.prototype.loadURL = function (url, options) {
   return p;
 };
 
+WebContents.prototype.setWebviewPool = function (options) {
+  setWebviewPool(this, options);
+};
+
+WebContents.prototype.getWebviewAttachMetrics = function () {
+  return getWebviewAttachMetrics(this);
+};
+
 WebContents.prototype.setWindowOpenHandler = function (handler: (details: Electron.HandlerDetails) => ({action: 'deny'} | {action: 'allow', overrideBrowserWindowOptions?: BrowserWindowConstructorOptions, outlivesOpener?: boolean})) {
   this._windowOpenHandler = handler;
 };
@@ -801,11 +877,11 @@ WebContents.prototype._init = function () {
     app.emit('login', event, this, ...args);
   });
 
-  this.on('ready-to-show' as any, () => {
+  this.on('ready-to-show' as any, (event: Electron.Event, timings: Record<string, number>) => {
     const owner = this.getOwnerBrowserWindow();
     if (owner && !owner.isDestroyed()) {
       process.nextTick(() => {
-        owner.emit('ready-to-show');
+        owner.emit('ready-to-show', event, timings);
       });
     }
   });
@@ -884,3 +960,31 @@ export function getFocusedWebContents () {
 export function getAllWebContents () {
   return binding.getAllWebContents();
 }
+
+export async function printPagesToPDF (contents: Electron.WebContents[], options: Electron.PrintPagesToPDFOptions = {}) {
+  const { concurrency = 4, paths, printOptions = {} } = options;
+  if (typeof concurrency !== 'number' || concurrency < 1) {
+    throw new Error('concurrency must be a positive Number');
+  }
+  if (paths !== undefined && (!Array.isArray(paths) || paths.length !== contents.length)) {
+    throw new Error('paths must be an Array with a path for each webContents');
+  }
+  const results: Buffer[] = new Array(contents.length);
+  let next = 0;
+  const worker = async () => {
+    while (next < contents.length) {
+      const index = next++;
+      const path = paths ? paths[index] : undefined;
+      results[index] = await contents[index].printToPDF(path ? { ...printOptions, path } : printOptions);
+    }
+  };
+  await Promise.all(Array.from({ length: Math.min(concurrency, contents.length) }, worker));
+  return results;
+}
+
+export function capturePages (contents: Electron.WebContents[], options: Electron.CapturePagesOptions = {}) {
+  const { rect = { x: 0, y: 0, width: 0, height: 0 }, ...opts } = options;
+  // The copy requests are all issued in the same task, so the compositor
+  // serves them from the same frame.
+  return Promise.all(contents.map(c => c.captureEncodedPage(rect, opts)));
+}
@@ -6,11 +6,19 @@ import { syncMethods, asyncMethods, properties } from '@electron/internal/common
 import { webViewEvents } from '@electron/internal/browser/web-view-events';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 
+type HiddenPolicy = 'none' | 'throttle' | 'freeze';
+
 interface GuestInstance {
   elementInstanceId: number;
   visibilityState?: DocumentVisibilityState;
   embedder: Electron.WebContents;
   guest: Electron.WebContents;
+  // What happens to the guest while its <webview> element is hidden, from the
+  // hiddenpolicy and freezedelay attributes.
+  hiddenPolicy: HiddenPolicy;
+  freezeDelay: number;
+  elementVisible: boolean;
+  freezeTimer?: NodeJS.Timeout;
 }
 
 const webViewManager = process._linkedBinding('electron_browser_web_view_manager');
@@ -21,6 +29,26 @@ const supportedWebViewEvents = Object.keys(webViewEvents);
 const guestInstances = new Map<number, GuestInstance>();
 const embedderElementsMap = new Map<string, number>();
 
+// Guests created ahead of the <webview> tags of an embedder, see
+// contents.setWebviewPool().
+interface WebviewPool {
+  size: number;
+  // The webPreferences the guests were created with, see makePoolKey().
+  key: string;
+  webPreferences: Electron.WebPreferences;
+  guests: Electron.WebContents[];
+}
+
+const webviewPools = new Map<Electron.WebContents, WebviewPool>();
+
+interface AttachTimes {
+  count: number;
+  totalTime: number;
+  maxTime: number;
+}
+
+const attachMetrics = new WeakMap<Electron.WebContents, { pooled: AttachTimes, created: AttachTimes }>();
+
 function makeWebPreferences (embedder: Electron.WebContents, params: Record<string, any>) {
   // parse the 'webpreferences' attribute string, if set
   // this uses the same parsing rules as window.open uses for its features
@@ -78,8 +106,118 @@ function makeLoadURLOptions (params: Record<string, any>) {
   return opts;
 }
 
+// The attributes which aren't set are empty strings in the params of a
+// <webview>, and missing in the ones given to setWebviewPool().
+const makePoolKey = function (webPreferences: Electron.WebPreferences) {
+  return JSON.stringify(Object.entries(webPreferences).filter(([, value]) => value !== undefined && value !== ''));
+};
+
+const removeFromPool = function (this: Electron.WebContents) {
+  for (const pool of webviewPools.values()) {
+    const index = pool.guests.indexOf(this);
+    if (index !== -1) pool.guests.splice(index, 1);
+  }
+};
+
+const fillWebviewPool = function (embedder: Electron.WebContents) {
+  const pool = webviewPools.get(embedder);
+  if (!pool || embedder.isDestroyed()) return;
+  while (pool.guests.length < pool.size) {
+    const guest = (webContents as typeof ElectronInternal.WebContents).create({
+      ...pool.webPreferences,
+      type: 'webview',
+      embedder
+    });
+    // Starts the renderer process of the guest, the src is loaded once it is
+    // attached.
+    guest.loadURL('about:blank').catch(() => {});
+    guest.once('destroyed', removeFromPool);
+    pool.guests.push(guest);
+  }
+};
+
+const destroyWebviewPool = function (embedder: Electron.WebContents) {
+  const pool = webviewPools.get(embedder);
+  if (!pool) return;
+  webviewPools.delete(embedder);
+  for (const guest of pool.guests) {
+    guest.removeListener('destroyed', removeFromPool);
+    guest.destroy();
+  }
+};
+
+export const setWebviewPool = function (embedder: Electron.WebContents, options: { size?: number, attributes?: Record<string, any> } | null) {
+  destroyWebviewPool(embedder);
+  if (options === null) return;
+  if (typeof options !== 'object') {
+    throw new TypeError('Expected an object or null');
+  }
+  const { size = 1, attributes = {} } = options;
+  if (!Number.isInteger(size) || size < 1) {
+    throw new TypeError('size must be a positive integer');
+  }
+  // The boolean attributes are false when missing from a <webview>.
+  const webPreferences = makeWebPreferences(embedder, {
+    nodeintegration: false,
+    nodeintegrationinsubframes: false,
+    plugins: false,
+    disablewebsecurity: false,
+    allowpopups: false,
+    ...attributes
+  });
+  webviewPools.set(embedder, {
+    size,
+    key: makePoolKey(webPreferences),
+    webPreferences,
+    guests: []
+  });
+  watchEmbedder(embedder);
+  fillWebviewPool(embedder);
+};
+
+export const getWebviewAttachMetrics = function (embedder: Electron.WebContents) {
+  const metrics = attachMetrics.get(embedder);
+  const format = (times?: AttachTimes) => ({
+    count: times?.count ?? 0,
+    averageTime: times?.count ? times.totalTime / times.count : 0,
+    maxTime: times?.maxTime ?? 0
+  });
+  return {
+    pooled: format(metrics?.pooled),
+    created: format(metrics?.created)
+  };
+};
+
+// Takes a guest created ahead with the same webPreferences, the pool is
+// filled again after the attach.
+const claimPooledGuest = function (embedder: Electron.WebContents, webPreferences: Electron.WebPreferences) {
+  const pool = webviewPools.get(embedder);
+  if (!pool || pool.key !== makePoolKey(webPreferences)) return null;
+  const guest = pool.guests.shift();
+  if (!guest) return null;
+  guest.removeListener('destroyed', removeFromPool);
+  setImmediate(fillWebviewPool, embedder);
+  return guest;
+};
+
+const recordAttachTime = function (embedder: Electron.WebContents, pooled: boolean, time: number) {
+  let metrics = attachMetrics.get(embedder);
+  if (!metrics) {
+    metrics = {
+      pooled: { count: 0, totalTime: 0, maxTime: 0 },
+      created: { count: 0, totalTime: 0, maxTime: 0 }
+    };
+    attachMetrics.set(embedder, metrics);
+  }
+  const times = pooled ? metrics.pooled : metrics.created;
+  times.count++;
+  times.totalTime += time;
+  times.maxTime = Math.max(times.maxTime, time);
+};
+
 // Create a new guest instance.
 const createGuest = function (embedder: Electron.WebContents, embedderFrameId: number, elementInstanceId: number, params: Record<string, any>) {
+  const attachStart = performance.now();
   const webPreferences = makeWebPreferences(embedder, params);
   const event = {
     sender: embedder,
@@ -96,17 +234,23 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
     return -1;
   }
 
-  const guest = (webContents as typeof ElectronInternal.WebContents).create({
+  const pooledGuest = claimPooledGuest(embedder, webPreferences);
+  const guest = pooledGuest ?? (webContents as typeof ElectronInternal.WebContents).create({
     ...webPreferences,
     type: 'webview',
     embedder
   });
 
   const guestInstanceId = guest.id;
+  const hiddenPolicy: HiddenPolicy = ['throttle', 'freeze'].includes(params.hiddenpolicy) ? params.hiddenpolicy : 'none';
+  const freezeDelay = Number(params.freezedelay);
   guestInstances.set(guestInstanceId, {
     elementInstanceId,
     guest,
-    embedder
+    embedder,
+    hiddenPolicy,
+    freezeDelay: params.freezedelay && freezeDelay >= 0 ? freezeDelay : 10000,
+    elementVisible: true
   });
 
   // Clear the guest from map when it is destroyed.
@@ -129,6 +273,7 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
     if (params.src) {
       this.loadURL(params.src, makeLoadURLOptions(params));
     }
+    recordAttachTime(embedder, !!pooledGuest, performance.now() - attachStart);
     embedder.emit('did-attach-webview', event, guest);
   });
 
@@ -202,6 +347,29 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
   return guestInstanceId;
 };
 
+// Hides the guest of a hidden <webview> element on its own, which throttles
+// its rendering and timers like a hidden window, and freezes it after a while
+// with the freeze policy. The guest is shown with its element, and with its
+// embedder once both are visible.
+const applyHiddenPolicy = function (guestInstance: GuestInstance) {
+  const { guest, hiddenPolicy } = guestInstance;
+  if (hiddenPolicy === 'none' || guest.isDestroyed()) return;
+  clearTimeout(guestInstance.freezeTimer);
+  guestInstance.freezeTimer = undefined;
+  if (!guestInstance.elementVisible) {
+    guest._setElementVisible(false);
+    if (hiddenPolicy === 'freeze') {
+      guestInstance.freezeTimer = setTimeout(() => {
+        guestInstance.freezeTimer = undefined;
+        if (!guest.isDestroyed() && !guestInstance.elementVisible) guest.freeze();
+      }, guestInstance.freezeDelay);
+    }
+  } else if (guestInstance.visibilityState !== 'hidden') {
+    guest._setElementVisible(true);
+    guest.resume();
+  }
+};
+
 // Remove an guest-embedder relationship.
 const detachGuest = function (embedder: Electron.WebContents, guestInstanceId: number) {
   const guestInstance = guestInstances.get(guestInstanceId);
@@ -212,6 +380,8 @@ const detachGuest = function (embedder: Electron.WebContents, guestInstanceId: n
     return;
   }
 
+  clearTimeout(guestInstance.freezeTimer);
+
   webViewManager.removeGuest(embedder, guestInstanceId);
   guestInstances.delete(guestInstanceId);
 
@@ -234,6 +404,11 @@ const watchEmbedder = function (embedder: Electron.WebContents) {
       guestInstance.visibilityState = visibilityState;
       if (guestInstance.embedder === embedder) {
         guestInstance.guest._sendInternal(IPC_MESSAGES.GUEST_INSTANCE_VISIBILITY_CHANGE, visibilityState);
+        // Showing the embedder shows its guests, the hidden elements' ones are
+        // hidden again.
+        if (visibilityState === 'visible' && !guestInstance.elementVisible) {
+          applyHiddenPolicy(guestInstance);
+        }
       }
     }
   };
@@ -248,6 +423,7 @@ const watchEmbedder = function (embedder: Electron.WebContents) {
         detachGuest(embedder, guestInstanceId);
       }
     }
+    destroyWebviewPool(embedder);
     // Clear the listeners.
     embedder.removeListener('-window-visibility-change' as any, onVisibilityChange);
     watchedEmbedders.delete(embedder);
@@ -297,6 +473,13 @@ ipcMainInternal.on(IPC_MESSAGES.GUEST_VIEW_MANAGER_FOCUS_CHANGE, function (event
   event.sender.emit('-focus-change', {}, focus);
 });
 
+ipcMainInternal.on(IPC_MESSAGES.GUEST_VIEW_MANAGER_ELEMENT_VISIBILITY_CHANGE, function (event: ElectronInternal.IpcMainInternalEvent, guestInstanceId: number, visible: boolean) {
+  const guestInstance = guestInstances.get(guestInstanceId);
+  if (!guestInstance || guestInstance.embedder !== event.sender || !isWebViewTagEnabled(event.sender)) return;
+  guestInstance.elementVisible = !!visible;
+  applyHiddenPolicy(guestInstance);
+});
+
 handleMessage(IPC_MESSAGES.GUEST_VIEW_MANAGER_CALL, function (event, guestInstanceId: number, method: string, args: any[]) {
   const guest = getGuestForWebContents(guestInstanceId, event.sender);
   if (!asyncMethods.has(method)) {
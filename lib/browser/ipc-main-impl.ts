@@ -1,6 +1,8 @@
 import { EventEmitter } from 'events';
 import { IpcMainInvokeEvent } from 'electron/main';
 
+const { setIPCChannelPriority } = process._linkedBinding('electron_browser_web_contents');
+
 export class IpcMainImpl extends EventEmitter {
   private _invokeHandlers: Map<string, (e: IpcMainInvokeEvent, ...args: any[]) => void> = new Map();
 
@@ -31,4 +33,8 @@ export class IpcMainImpl extends EventEmitter {
   removeHandler (method: string) {
     this._invokeHandlers.delete(method);
   }
+
+  setChannelPriority: Electron.IpcMain['setChannelPriority'] = (channel, priority) => {
+    setIPCChannelPriority(channel, priority);
+  };
 }
@@ -19,10 +19,22 @@ export class MessagePortMain extends EventEmitter {
     return this._internalPort.close();
   }
 
-  postMessage (...args: any[]) {
+  postMessage (...args: any[]): boolean {
     if (Array.isArray(args[1])) {
       args[1] = args[1].map((o: any) => o instanceof MessagePortMain ? o._internalPort : o);
     }
     return this._internalPort.postMessage(...args);
   }
+
+  postMessages (messages: any[]): boolean {
+    return this._internalPort.postMessages(messages);
+  }
+
+  get bufferedAmount (): number {
+    return this._internalPort.bufferedAmount;
+  }
+
+  setWatermarks (watermarks: Electron.Watermarks) {
+    this._internalPort.setWatermarks(watermarks);
+  }
 }
@@ -0,0 +1,94 @@
+import { app } from 'electron/main';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+
+const { setPreloadCacheKey, setPreloadCodeCache } = process._linkedBinding('electron_browser_web_contents');
+
+// Code cache for the preload scripts of sandboxed renderers, which are
+// compiled via createPreloadScript() instead of going through Blink's script
+// loader and therefore don't benefit from Chromium's generated code cache.
+
+const codeCachePaths = new WeakMap<Electron.Session, string>();
+
+// Keys handed out to each renderer process, only the renderer which was told
+// to produce an entry is allowed to store it.
+const pendingKeys = new Map<number, Set<string>>();
+
+export const setCodeCachePath = function (session: Electron.Session, codeCachePath: string) {
+  codeCachePaths.set(session, codeCachePath);
+};
+
+const getCacheDirectory = function (session: Electron.Session) {
+  const codeCachePath = codeCachePaths.get(session) ??
+    (session.storagePath ? path.join(session.storagePath, 'Code Cache') : null);
+  // In-memory sessions don't get a cache, like the page scripts.
+  return codeCachePath ? path.join(codeCachePath, 'preload') : null;
+};
+
+// The cached data is only valid for the same source, V8 build and V8 flags,
+// V8 rejects anything else but there's no point in reading it.
+const getCacheKey = function (preloadSrc: string) {
+  return crypto.createHash('sha256')
+    .update(preloadSrc)
+    .update('\0')
+    .update(process.versions.electron)
+    .update('\0')
+    .update(process.versions.v8)
+    .update('\0')
+    .update(app.commandLine.getSwitchValue('js-flags'))
+    .digest('hex');
+};
+
+export const readCodeCache = async function (sender: Electron.WebContents, preloadSrc: string) {
+  const directory = getCacheDirectory(sender.session);
+  if (!directory) return null;
+
+  const cacheKey = getCacheKey(preloadSrc);
+  let cachedData: Buffer | null = null;
+  try {
+    cachedData = await fs.promises.readFile(path.join(directory, cacheKey));
+  } catch {
+    // Not cached yet.
+  }
+
+  // Also handed to sandboxed renderers along with the preloads which are sent
+  // before navigations commit, see PreloadScriptCache.
+  setPreloadCacheKey(preloadSrc, cacheKey);
+  if (cachedData) setPreloadCodeCache(cacheKey, cachedData);
+
+  const processId = sender.getProcessId();
+  let keys = pendingKeys.get(processId);
+  if (!keys) {
+    keys = new Set();
+    pendingKeys.set(processId, keys);
+    sender.once('render-process-gone', () => pendingKeys.delete(processId));
+    sender.once('destroyed', () => pendingKeys.delete(processId));
+  }
+  keys.add(cacheKey);
+
+  return { cacheKey, cachedData };
+};
+
+export const writeCodeCache = async function (sender: Electron.WebContents, cacheKey: string, cachedData: Uint8Array) {
+  const keys = pendingKeys.get(sender.getProcessId());
+  if (!keys?.delete(cacheKey) || !(cachedData instanceof Uint8Array)) return;
+
+  const directory = getCacheDirectory(sender.session);
+  if (!directory) return;
+
+  setPreloadCodeCache(cacheKey, cachedData);
+
+  // Write to a temporary file first so concurrent readers never see a
+  // partially written entry.
+  const file = path.join(directory, cacheKey);
+  const tempFile = `${file}.${process.pid}.tmp`;
+  try {
+    await fs.promises.mkdir(directory, { recursive: true });
+    await fs.promises.writeFile(tempFile, cachedData);
+    await fs.promises.rename(tempFile, file);
+  } catch {
+    // Failing to store the cache is not fatal, like Chromium's code cache.
+    await fs.promises.rm(tempFile, { force: true });
+  }
+};
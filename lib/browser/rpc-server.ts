@@ -2,8 +2,11 @@ import { clipboard } from 'electron/common';
 import * as fs from 'fs';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
+import { readCodeCache, writeCodeCache } from '@electron/internal/browser/preload-code-cache';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 
+const { setSandboxProcessInfo } = process._linkedBinding('electron_browser_web_contents');
+
 // Implements window.close()
 ipcMainInternal.on(IPC_MESSAGES.BROWSER_WINDOW_CLOSE, function (event) {
   const window = event.sender.getOwnerBrowserWindow();
@@ -41,30 +44,46 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, function (event, me
   return (clipboard as any)[method](...args);
 });
 
-const getPreloadScript = async function (preloadPath: string) {
+ipcMainInternal.handle(IPC_MESSAGES.BROWSER_CLIPBOARD, function (event, method: string, ...args: any[]) {
+  if (!allowedClipboardMethods.has(method)) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  return (clipboard as any)[method](...args);
+});
+
+const getPreloadScript = async function (sender: Electron.WebContents, preloadPath: string) {
   let preloadSrc = null;
   let preloadError = null;
+  let codeCache = null;
   try {
     preloadSrc = await fs.promises.readFile(preloadPath, 'utf8');
+    codeCache = await readCodeCache(sender, preloadSrc);
   } catch (error) {
     preloadError = error;
   }
-  return { preloadPath, preloadSrc, preloadError };
+  return { preloadPath, preloadSrc, preloadError, codeCache };
+};
+
+const sandboxProcessInfo = {
+  arch: process.arch,
+  platform: process.platform,
+  version: process.version,
+  versions: process.versions,
+  execPath: process.helperExecPath
 };
 
+// Sent with the preloads of sandboxed frames before their navigations commit,
+// along with the current environment. The renderer only falls back to
+// BROWSER_SANDBOX_LOAD when the preloads aren't cached yet.
+setSandboxProcessInfo(sandboxProcessInfo);
+
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event) {
   const preloadPaths = event.sender._getPreloadPaths();
 
   return {
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
-    process: {
-      arch: process.arch,
-      platform: process.platform,
-      env: { ...process.env },
-      version: process.version,
-      versions: process.versions,
-      execPath: process.helperExecPath
-    }
+    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(event.sender, path))),
+    process: { ...sandboxProcessInfo, env: { ...process.env } }
   };
 });
 
@@ -72,6 +91,10 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD, function (event) {
   return { preloadPaths: event.sender._getPreloadPaths() };
 });
 
+ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, function (event, cacheKey: string, cachedData: Uint8Array) {
+  writeCodeCache(event.sender, cacheKey, cachedData);
+});
+
 ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_ERROR, function (event, preloadPath: string, error: Error) {
   event.sender.emit('preload-error', event, preloadPath, error);
 });
@@ -1,4 +1,5 @@
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
+import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 import * as ipcRendererUtils from '@electron/internal/renderer/ipc-renderer-internal-utils';
 
 const clipboard = process._linkedBinding('electron_common_clipboard');
@@ -7,10 +8,18 @@ const makeRemoteMethod = function (method: keyof Electron.Clipboard): any {
   return (...args: any[]) => ipcRendererUtils.invokeSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, method, ...args);
 };
 
+// The methods which return a promise don't block the renderer while the main
+// process works on them.
+const asyncMethods = new Set<keyof Electron.Clipboard>(['readImageAsync', 'writeBufferAsync']);
+
+const makeRemoteAsyncMethod = function (method: keyof Electron.Clipboard): any {
+  return (...args: any[]) => ipcRendererInternal.invoke(IPC_MESSAGES.BROWSER_CLIPBOARD, method, ...args);
+};
+
 if (process.platform === 'linux') {
   // On Linux we could not access clipboard in renderer process.
   for (const method of Object.keys(clipboard) as (keyof Electron.Clipboard)[]) {
-    clipboard[method] = makeRemoteMethod(method);
+    clipboard[method] = asyncMethods.has(method) ? makeRemoteAsyncMethod(method) : makeRemoteMethod(method);
   }
 } else if (process.platform === 'darwin') {
   // Read/write to find pasteboard over IPC since only main process is notified of changes
@@ -5,13 +5,13 @@ const checkContextIsolationEnabled = () => {
 };
 
 const contextBridge: Electron.ContextBridge = {
-  exposeInMainWorld: (key: string, api: any) => {
+  exposeInMainWorld: (key: string, api: any, options?: { lazy?: boolean }) => {
     checkContextIsolationEnabled();
-    return binding.exposeAPIInWorld(0, key, api);
+    return binding.exposeAPIInWorld(0, key, api, !!options?.lazy);
   },
-  exposeInIsolatedWorld: (worldId: number, key: string, api: any) => {
+  exposeInIsolatedWorld: (worldId: number, key: string, api: any, options?: { lazy?: boolean }) => {
     checkContextIsolationEnabled();
-    return binding.exposeAPIInWorld(worldId, key, api);
+    return binding.exposeAPIInWorld(worldId, key, api, !!options?.lazy);
   }
 };
 
@@ -9,6 +9,10 @@ ipcRenderer.send = function (channel, ...args) {
   return ipc.send(internal, channel, args);
 };
 
+ipcRenderer.sendJSON = function (channel, json) {
+  return ipc.sendJSON(channel, json);
+};
+
 ipcRenderer.sendSync = function (channel, ...args) {
   return ipc.sendSync(internal, channel, args);
 };
@@ -29,6 +33,22 @@ ipcRenderer.invoke = async function (channel, ...args) {
   return result;
 };
 
+ipcRenderer.invokeSync = function (channel, ...args) {
+  const { error, result } = ipc.invokeSync(channel, args);
+  if (error) {
+    throw new Error(`Error invoking remote method '${channel}': ${error}`);
+  }
+  return result;
+};
+
+ipcRenderer.getSyncStats = function () {
+  return ipc.getSyncStats();
+};
+
+ipcRenderer.setBatching = function (enabled, options) {
+  return ipc.setBatching(enabled, options?.delay);
+};
+
 ipcRenderer.postMessage = function (channel: string, message: any, transferables: any) {
   return ipc.postMessage(channel, message, transferables);
 };
@@ -31,6 +31,12 @@ export function createGuest (iframe: HTMLIFrameElement, elementInstanceId: numbe
   return ipcRendererInternal.invoke(IPC_MESSAGES.GUEST_VIEW_MANAGER_CREATE_AND_ATTACH_GUEST, embedderFrameId, elementInstanceId, params);
 }
 
+// Tells the main process that the <webview> element of the guest was shown or
+// hidden, see the hiddenpolicy attribute.
+export function setElementVisibility (guestInstanceId: number, visible: boolean) {
+  ipcRendererInternal.send(IPC_MESSAGES.GUEST_VIEW_MANAGER_ELEMENT_VISIBILITY_CHANGE, guestInstanceId, visible);
+}
+
 export function detachGuest (guestInstanceId: number) {
   return ipcRendererUtils.invokeSync(IPC_MESSAGES.GUEST_VIEW_MANAGER_DETACH_GUEST, guestInstanceId);
 }
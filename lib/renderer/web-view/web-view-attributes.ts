@@ -266,6 +266,8 @@ export function setupWebViewAttributes (self: WebViewImpl) {
     [WEB_VIEW_ATTRIBUTES.PRELOAD, new PreloadAttribute(self)],
     [WEB_VIEW_ATTRIBUTES.BLINKFEATURES, new BlinkFeaturesAttribute(self)],
     [WEB_VIEW_ATTRIBUTES.DISABLEBLINKFEATURES, new DisableBlinkFeaturesAttribute(self)],
-    [WEB_VIEW_ATTRIBUTES.WEBPREFERENCES, new WebPreferencesAttribute(self)]
+    [WEB_VIEW_ATTRIBUTES.WEBPREFERENCES, new WebPreferencesAttribute(self)],
+    [WEB_VIEW_ATTRIBUTES.HIDDENPOLICY, new WebViewAttribute(WEB_VIEW_ATTRIBUTES.HIDDENPOLICY, self)],
+    [WEB_VIEW_ATTRIBUTES.FREEZEDELAY, new WebViewAttribute(WEB_VIEW_ATTRIBUTES.FREEZEDELAY, self)]
   ]);
 }
@@ -13,6 +13,8 @@ export const enum WEB_VIEW_ATTRIBUTES {
   BLINKFEATURES = 'blinkfeatures',
   DISABLEBLINKFEATURES = 'disableblinkfeatures',
   WEBPREFERENCES = 'webpreferences',
+  HIDDENPOLICY = 'hiddenpolicy',
+  FREEZEDELAY = 'freezedelay',
 }
 
 export const enum WEB_VIEW_ERROR_MESSAGES {
@@ -32,6 +32,10 @@ export class WebViewImpl {
 
   public attributes: Map<string, WebViewAttribute>;
 
+  // Tells whether the internal iframe is in the viewport.
+  private visibilityObserver?: IntersectionObserver;
+  private elementVisible = true;
+
   constructor (public webviewNode: HTMLElement, private hooks: WebViewImplHooks) {
     // Create internal iframe element.
     this.internalElement = this.createInternalElement();
@@ -73,6 +77,7 @@ export class WebViewImpl {
     if (this.guestInstanceId) {
       this.guestInstanceId = undefined;
     }
+    this.stopObservingVisibility();
 
     this.beforeFirstNavigation = true;
     (this.attributes.get(WEB_VIEW_ATTRIBUTES.PARTITION) as PartitionAttribute).validPartitionId = true;
@@ -194,6 +199,28 @@ export class WebViewImpl {
     }
 
     this.guestInstanceId = guestInstanceId;
+    this.observeVisibility();
+  }
+
+  // Hidden elements, like the ones of an inactive tab with display: none, and
+  // elements scrolled out of the viewport don't intersect it.
+  observeVisibility () {
+    this.stopObservingVisibility();
+    this.elementVisible = true;
+    this.visibilityObserver = new IntersectionObserver((entries) => {
+      const visible = entries[entries.length - 1].isIntersecting;
+      if (visible === this.elementVisible || this.guestInstanceId === undefined) return;
+      this.elementVisible = visible;
+      this.hooks.guestViewInternal.setElementVisibility(this.guestInstanceId, visible);
+    });
+    this.visibilityObserver.observe(this.internalElement);
+  }
+
+  stopObservingVisibility () {
+    if (this.visibilityObserver) {
+      this.visibilityObserver.disconnect();
+      this.visibilityObserver = undefined;
+    }
   }
 }
 
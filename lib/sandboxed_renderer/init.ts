@@ -4,10 +4,28 @@ import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 import type * as ipcRendererUtilsModule from '@electron/internal/renderer/ipc-renderer-internal-utils';
 import type * as ipcRendererInternalModule from '@electron/internal/renderer/ipc-renderer-internal';
 
+type SandboxPreloads = {
+  preloadScripts: {
+    preloadPath: string;
+    preloadSrc: string | null;
+    preloadError: null | Error;
+    codeCache: null | {
+      cacheKey: string;
+      cachedData: Uint8Array | null;
+    };
+  }[];
+  process: NodeJS.Process;
+};
+
 declare const binding: {
   get: (name: string) => any;
   process: NodeJS.Process;
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, cachedData?: Uint8Array | null) => {
+    fn: Function;
+    cachedData?: Uint8Array;
+  };
+  // Sent by the browser before the navigation committed, see PreloadAgent.
+  preloads?: SandboxPreloads;
 };
 
 const { EventEmitter } = events;
@@ -33,14 +51,7 @@ const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-inter
 const {
   preloadScripts,
   process: processProps
-} = ipcRendererUtils.invokeSync<{
-  preloadScripts: {
-    preloadPath: string;
-    preloadSrc: string | null;
-    preloadError: null | Error;
-  }[];
-  process: NodeJS.Process;
-}>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
+} = binding.preloads ?? ipcRendererUtils.invokeSync<SandboxPreloads>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
 
 const electron = require('electron');
 
@@ -119,22 +130,27 @@ require('@electron/internal/renderer/common-init');
 // - `process`: The `preloadProcess` object
 // - `Buffer`: Shim of `Buffer` implementation
 // - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc: string) {
+function runPreloadScript (preloadSrc: string, codeCache: typeof preloadScripts[number]['codeCache']) {
   const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports) {
   ${preloadSrc}
   })`;
 
   // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc);
+  const { fn: preloadFn, cachedData } = binding.createPreloadScript(preloadWrapperSrc, codeCache?.cachedData);
   const { setImmediate, clearImmediate } = require('timers');
 
+  // The cache was missing or rejected, let the browser store the new one.
+  if (codeCache && cachedData) {
+    ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, codeCache.cacheKey, cachedData);
+  }
+
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, {});
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+for (const { preloadPath, preloadSrc, preloadError, codeCache } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc);
+      runPreloadScript(preloadSrc, codeCache);
     } else if (preloadError) {
       throw preloadError;
     }
@@ -2,20 +2,87 @@ import { EventEmitter } from 'events';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 const { createParentPort } = process._linkedBinding('electron_utility_parent_port');
 
+type InvokeHandler = (event: Electron.ParentPortInvokeEvent, ...args: any[]) => any;
+
 export class ParentPort extends EventEmitter {
-  #port: ParentPort;
+  #port: ElectronInternal.ParentPort;
+  #invokeHandlers = new Map<string, InvokeHandler>();
+  #sharedBuffers = new Map<string, SharedArrayBuffer>();
+  #sharedBufferWaiters = new Map<string, ((buffer: SharedArrayBuffer) => void)[]>();
   constructor () {
     super();
     this.#port = createParentPort();
-    this.#port.emit = (channel: string | symbol, event: { ports: any[] }) => {
+    this.#port.emit = (channel: string | symbol, event: any, ...args: any[]) => {
+      if (channel === '-ipc-invoke') {
+        this.#invoke(event, args[0], args[1]);
+        return true;
+      }
+      if (channel === '-shared-buffer') {
+        this.#onSharedBuffer(event);
+        return true;
+      }
       if (channel === 'message') {
-        event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) };
+        event = { ...event, ports: event.ports.map((p: any) => new MessagePortMain(p)) };
       }
       this.emit(channel, event);
       return false;
     };
   }
 
+  #invoke = async ({ _replyChannel, ...event }: any, channel: string, args: any[]) => {
+    const handler = this.#invokeHandlers.get(channel);
+    try {
+      if (!handler) {
+        throw new Error(`No handler registered for '${channel}'`);
+      }
+      _replyChannel.sendReply({ result: await handler(event, ...args) });
+    } catch (err) {
+      if (handler) {
+        console.error(`Error occurred in handler for '${channel}':`, err);
+      }
+      _replyChannel.sendReply({ error: (err as Error).toString() });
+    }
+  };
+
+  #onSharedBuffer = (name: string) => {
+    this.#sharedBuffers.delete(name);
+    const waiters = this.#sharedBufferWaiters.get(name);
+    if (!waiters) return;
+    this.#sharedBufferWaiters.delete(name);
+    const buffer = this.#takeSharedBuffer(name);
+    for (const resolve of waiters) resolve(buffer!);
+  };
+
+  #takeSharedBuffer (name: string) : SharedArrayBuffer | undefined {
+    const buffer = this.#port.takeSharedBuffer(name);
+    if (buffer) this.#sharedBuffers.set(name, buffer);
+    return buffer;
+  }
+
+  getSharedBuffer (name: string) : Promise<SharedArrayBuffer> {
+    const buffer = this.#sharedBuffers.get(name) || this.#takeSharedBuffer(name);
+    if (buffer) return Promise.resolve(buffer);
+    return new Promise(resolve => {
+      const waiters = this.#sharedBufferWaiters.get(name) || [];
+      waiters.push(resolve);
+      this.#sharedBufferWaiters.set(name, waiters);
+    });
+  }
+
+  handle (channel: string, handler: InvokeHandler) : void {
+    if (this.#invokeHandlers.has(channel)) {
+      throw new Error(`Attempted to register a second handler for '${channel}'`);
+    }
+    if (typeof handler !== 'function') {
+      throw new Error(`Expected handler to be a function, but found type '${typeof handler}'`);
+    }
+    this.#invokeHandlers.set(channel, handler);
+  }
+
+  removeHandler (channel: string) : void {
+    this.#invokeHandlers.delete(channel);
+  }
+
   start () : void {
     this.#port.start();
   }
@@ -24,7 +91,23 @@ export class ParentPort extends EventEmitter {
     this.#port.pause();
   }
 
-  postMessage (message: any) : void {
-    this.#port.postMessage(message);
+  postMessage (message: any, transfer?: (MessagePortMain | ArrayBuffer)[]) : boolean {
+    if (Array.isArray(transfer)) {
+      transfer = transfer.map((o: any) => o instanceof MessagePortMain ? o._internalPort : o);
+      return this.#port.postMessage(message, transfer);
+    }
+    return this.#port.postMessage(message);
+  }
+
+  postMessages (messages: any[]) : boolean {
+    return this.#port.postMessages(messages);
+  }
+
+  get bufferedAmount () : number {
+    return this.#port.bufferedAmount;
+  }
+
+  setWatermarks (watermarks: Electron.Watermarks) : void {
+    this.#port.setWatermarks(watermarks);
   }
 }
@@ -0,0 +1,113 @@
+// Rewrites an ASAR archive so that its packed files are stored compressed with
+// brotli, as understood by shell/common/asar/asar_compression.h. Every block of
+// a file, those of its integrity if it has some, is compressed on its own so
+// that it can be read and validated without the rest of the file. Files that
+// don't get smaller are stored as they are.
+//
+// The header of the output differs from the one of the input, any hash of it
+// (e.g. ElectronAsarIntegrity in Info.plist) has to be computed again.
+//
+// Usage: node script/asar-compress.js <input.asar> <output.asar>
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+const path = require('node:path');
+const zlib = require('node:zlib');
+
+// The block size of files without integrity, the one @electron/asar uses.
+const DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+// Formats which are compressed already.
+const SKIPPED_EXTENSIONS = new Set([
+  '.br', '.gif', '.gz', '.jpeg', '.jpg', '.mp3', '.mp4', '.png', '.webm',
+  '.webp', '.woff', '.woff2', '.zip'
+]);
+
+const align4 = (n) => (n + 3) & ~3;
+
+const readJSONHeader = (fd) => {
+  const sizeBuf = Buffer.alloc(8);
+  fs.readSync(fd, sizeBuf, 0, 8, 0);
+  const headerPickleSize = sizeBuf.readUInt32LE(4);
+  const headerBuf = Buffer.alloc(headerPickleSize);
+  fs.readSync(fd, headerBuf, 0, headerPickleSize, 8);
+  const headerString = headerBuf.toString('utf8', 8, 8 + headerBuf.readInt32LE(4));
+  assert(headerString.startsWith('{'), 'archive has an indexed header, compress it before indexing it');
+  return { header: JSON.parse(headerString), dataOffset: 8 + headerPickleSize };
+};
+
+const collectFiles = (node, name, files) => {
+  if (node.files) {
+    for (const [childName, child] of Object.entries(node.files)) collectFiles(child, childName, files);
+  } else if (node.link === undefined && !node.unpacked) {
+    files.push({ name, node });
+  }
+  return files;
+};
+
+const compressBlocks = (data, blockSize) => {
+  const frames = [];
+  for (let start = 0; start < data.length; start += blockSize) {
+    const block = data.subarray(start, start + blockSize);
+    frames.push(zlib.brotliCompressSync(block, {
+      params: {
+        [zlib.constants.BROTLI_PARAM_QUALITY]: zlib.constants.BROTLI_MAX_QUALITY,
+        [zlib.constants.BROTLI_PARAM_SIZE_HINT]: block.length
+      }
+    }));
+  }
+  return frames;
+};
+
+// Same layout as the chromium-pickle-js based writer in @electron/asar.
+const pickleHeader = (header) => {
+  const headerString = Buffer.from(JSON.stringify(header), 'utf8');
+  const headerPickle = Buffer.alloc(8 + align4(headerString.length));
+  headerPickle.writeUInt32LE(headerPickle.length - 4, 0);
+  headerPickle.writeInt32LE(headerString.length, 4);
+  headerString.copy(headerPickle, 8);
+
+  const sizePickle = Buffer.alloc(8);
+  sizePickle.writeUInt32LE(4, 0);
+  sizePickle.writeUInt32LE(headerPickle.length, 4);
+  return Buffer.concat([sizePickle, headerPickle]);
+};
+
+const [input, output] = process.argv.slice(2);
+if (!input || !output) {
+  console.error('Usage: node script/asar-compress.js <input.asar> <output.asar>');
+  process.exit(1);
+}
+
+const fd = fs.openSync(input, 'r');
+const { header, dataOffset } = readJSONHeader(fd);
+const files = collectFiles(header, '', []);
+files.sort((a, b) => Number(a.node.offset) - Number(b.node.offset));
+
+const contents = [];
+let offset = 0;
+for (const { name, node } of files) {
+  // Files of an archive which was compressed already are copied as they are.
+  const storedSize = node.compression
+    ? node.compression.blocks.reduce((sum, frame) => sum + frame, 0)
+    : node.size;
+  let data = Buffer.alloc(storedSize);
+  fs.readSync(fd, data, 0, storedSize, dataOffset + Number(node.offset));
+
+  if (!node.compression && node.size > 0 && !SKIPPED_EXTENSIONS.has(path.extname(name).toLowerCase())) {
+    const blockSize = node.integrity ? node.integrity.blockSize : DEFAULT_BLOCK_SIZE;
+    const frames = compressBlocks(data, blockSize);
+    const packed = Buffer.concat(frames);
+    if (packed.length < data.length) {
+      node.compression = { algorithm: 'brotli', blockSize, blocks: frames.map(frame => frame.length) };
+      data = packed;
+    }
+  }
+
+  node.offset = String(offset);
+  offset += data.length;
+  contents.push(data);
+}
+fs.closeSync(fd);
+
+fs.writeFileSync(output, Buffer.concat([pickleHeader(header), ...contents]));
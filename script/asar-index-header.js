@@ -0,0 +1,163 @@
+// Rewrites an ASAR archive so that it uses the binary "indexed" header
+// understood by shell/common/asar/archive_index.h instead of the JSON one.
+// File contents are copied verbatim, their offsets are relative to the end
+// of the header and therefore don't change.
+//
+// Usage: node script/asar-index-header.js <input.asar> <output.asar>
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+
+const MAGIC = Buffer.from('ASARIDX\0', 'latin1');
+const VERSION = 2;
+const HEADER_SIZE = 32;
+const ENTRY_SIZE = 40;
+
+const Flags = {
+  kDirectory: 1 << 0,
+  kLink: 1 << 1,
+  kUnpacked: 1 << 2,
+  kExecutable: 1 << 3,
+  kCompressed: 1 << 4
+};
+
+const align4 = (n) => (n + 3) & ~3;
+
+const readJSONHeader = (fd) => {
+  const sizeBuf = Buffer.alloc(8);
+  fs.readSync(fd, sizeBuf, 0, 8, 0);
+  const headerPickleSize = sizeBuf.readUInt32LE(4);
+  const headerBuf = Buffer.alloc(headerPickleSize);
+  fs.readSync(fd, headerBuf, 0, headerPickleSize, 8);
+  const headerString = headerBuf.toString('utf8', 8, 8 + headerBuf.readInt32LE(4));
+  assert(!headerString.startsWith(MAGIC.toString('latin1')), 'archive already has an indexed header');
+  return { header: JSON.parse(headerString), dataOffset: 8 + headerPickleSize };
+};
+
+// Flatten the header tree into entries keyed by their '/'-separated path.
+const flatten = (header) => {
+  const entries = [];
+  const visit = (node, nodePath) => {
+    const entry = { path: nodePath, node, children: [] };
+    entries.push(entry);
+    if (node.files) {
+      for (const name of Object.keys(node.files)) {
+        const childPath = nodePath ? `${nodePath}/${name}` : name;
+        entry.children.push(childPath);
+        visit(node.files[name], childPath);
+      }
+    }
+  };
+  visit(header, '');
+  const compare = (a, b) => Buffer.compare(Buffer.from(a), Buffer.from(b));
+  entries.sort((a, b) => compare(a.path, b.path));
+  for (const entry of entries) entry.children.sort(compare);
+  return entries;
+};
+
+const buildIndex = (header) => {
+  const entries = flatten(header);
+  const indexOfPath = new Map(entries.map((entry, i) => [entry.path, i]));
+
+  // Interned string table.
+  const strings = [];
+  let stringsSize = 0;
+  const interned = new Map();
+  const intern = (str) => {
+    if (!interned.has(str)) {
+      const buf = Buffer.from(str, 'utf8');
+      interned.set(str, { offset: stringsSize, length: buf.length });
+      strings.push(buf);
+      stringsSize += buf.length;
+    }
+    return interned.get(str);
+  };
+
+  const children = [];
+  const records = entries.map(({ path, node, children: childPaths }) => {
+    const record = { path: intern(path), flags: 0, size: 0, offset: 0n, extra: { offset: 0, length: 0 }, integrity: { offset: 0, length: 0 } };
+    if (node.files) {
+      record.flags |= Flags.kDirectory;
+      record.extra = { offset: children.length, length: childPaths.length };
+      for (const childPath of childPaths) children.push(indexOfPath.get(childPath));
+    } else if (node.link !== undefined) {
+      record.flags |= Flags.kLink;
+      record.extra = intern(node.link);
+    } else {
+      record.size = node.size;
+      if (node.unpacked) record.flags |= Flags.kUnpacked;
+      if (node.executable) record.flags |= Flags.kExecutable;
+      if (node.offset !== undefined) record.offset = BigInt(node.offset);
+      if (node.integrity) {
+        const { algorithm, blockSize, hash, blocks } = node.integrity;
+        record.integrity = intern([algorithm, blockSize, hash, ...blocks].join(','));
+      }
+      if (node.compression) {
+        const { algorithm, blockSize, blocks } = node.compression;
+        record.flags |= Flags.kCompressed;
+        record.extra = intern([algorithm, blockSize, ...blocks].join(','));
+      }
+    }
+    return record;
+  });
+
+  const childrenOffset = HEADER_SIZE + entries.length * ENTRY_SIZE;
+  const stringsOffset = childrenOffset + children.length * 4;
+  const index = Buffer.alloc(align4(stringsOffset + stringsSize));
+
+  MAGIC.copy(index, 0);
+  index.writeUInt32LE(VERSION, 8);
+  index.writeUInt32LE(entries.length, 12);
+  index.writeUInt32LE(childrenOffset, 16);
+  index.writeUInt32LE(children.length, 20);
+  index.writeUInt32LE(stringsOffset, 24);
+  index.writeUInt32LE(stringsSize, 28);
+
+  records.forEach((record, i) => {
+    const o = HEADER_SIZE + i * ENTRY_SIZE;
+    index.writeUInt32LE(record.path.offset, o);
+    index.writeUInt32LE(record.path.length, o + 4);
+    index.writeUInt32LE(record.flags, o + 8);
+    index.writeUInt32LE(record.size, o + 12);
+    index.writeBigUInt64LE(record.offset, o + 16);
+    index.writeUInt32LE(record.extra.offset, o + 24);
+    index.writeUInt32LE(record.extra.length, o + 28);
+    index.writeUInt32LE(record.integrity.offset, o + 32);
+    index.writeUInt32LE(record.integrity.length, o + 36);
+  });
+  children.forEach((child, i) => index.writeUInt32LE(child, childrenOffset + i * 4));
+  Buffer.concat(strings).copy(index, stringsOffset);
+  return index;
+};
+
+// Same layout as the chromium-pickle-js based writer in @electron/asar, but
+// the header string is written as raw bytes.
+const pickleHeader = (index) => {
+  const headerPickle = Buffer.alloc(8 + align4(index.length));
+  headerPickle.writeUInt32LE(headerPickle.length - 4, 0);
+  headerPickle.writeInt32LE(index.length, 4);
+  index.copy(headerPickle, 8);
+
+  const sizePickle = Buffer.alloc(8);
+  sizePickle.writeUInt32LE(4, 0);
+  sizePickle.writeUInt32LE(headerPickle.length, 4);
+  return Buffer.concat([sizePickle, headerPickle]);
+};
+
+const [input, output] = process.argv.slice(2);
+if (!input || !output) {
+  console.error('Usage: node script/asar-index-header.js <input.asar> <output.asar>');
+  process.exit(1);
+}
+
+const fd = fs.openSync(input, 'r');
+const { header, dataOffset } = readJSONHeader(fd);
+fs.closeSync(fd);
+
+fs.writeFileSync(output, pickleHeader(buildIndex(header)));
+fs.createReadStream(input, { start: dataOffset })
+  .pipe(fs.createWriteStream(output, { flags: 'a' }))
+  .on('error', (err) => {
+    console.error('Unexpected error while writing ASAR', err);
+    process.exit(1);
+  });
@@ -0,0 +1,53 @@
+// Runs a workload of small native allocations in the main process with the
+// allocator tuned by the switches, run by run.js, see README.md.
+const { app } = require('electron');
+const crypto = require('node:crypto');
+
+const numberArg = (name, fallback) => {
+  const arg = process.argv.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? parseFloat(arg.slice(name.length + 3)) : fallback;
+};
+
+const batches = numberArg('batches', 200);
+const multiplier = numberArg('thread-cache-multiplier', undefined);
+const purgeInterval = numberArg('purge-interval', undefined);
+
+const now = () => Number(process.hrtime.bigint()) / 1000;
+
+const median = values => values.sort((a, b) => a - b)[Math.floor(values.length / 2)];
+
+// Hashing and URL parsing allocate small native objects, which is what the
+// thread cache serves.
+const runBatch = () => {
+  const start = now();
+  for (let i = 0; i < 1000; i++) {
+    crypto.createHash('sha256').update(`value ${i}`).digest('hex');
+    new URL(`https://example.com/path/${i}?query=${i}#hash`).searchParams.get('query');
+  }
+  return now() - start;
+};
+
+app.whenReady().then(async () => {
+  const options = {};
+  if (multiplier !== undefined) options.threadCacheMultiplier = multiplier;
+  if (purgeInterval !== undefined) options.purgeInterval = purgeInterval;
+  app.configureAllocator(options);
+
+  const times = [];
+  for (let i = 0; i < batches; i++) {
+    times.push(runBatch());
+    // Let the purge timer run between batches.
+    await new Promise(resolve => setTimeout(resolve, 10));
+  }
+
+  const stats = app.getAllocatorStats();
+  const { partitionAlloc } = stats;
+  console.log(JSON.stringify({
+    latency: median(times),
+    rss: process.memoryUsage().rss / 1024,
+    committed: partitionAlloc ? partitionAlloc.committed : stats.mallocUsage,
+    fragmentation: partitionAlloc ? partitionAlloc.fragmentation : 0,
+    hitRate: partitionAlloc && partitionAlloc.threadCache ? partitionAlloc.threadCache.hitRate : 0
+  }));
+  app.quit();
+});
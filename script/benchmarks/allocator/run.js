@@ -0,0 +1,41 @@
+// Starts Electron with the allocator benchmark app for each allocator
+// configuration and prints the median results of each one, see README.md.
+const cp = require('node:child_process');
+const utils = require('../../lib/utils');
+
+const args = process.argv.slice(2);
+const runsArg = args.find(arg => arg.startsWith('--runs='));
+const runs = runsArg ? parseInt(runsArg.slice('--runs='.length), 10) : 5;
+const electronPath = utils.getAbsoluteElectronExec();
+
+const modes = {
+  default: [],
+  'small thread cache': ['--thread-cache-multiplier=0.5'],
+  'large thread cache': ['--thread-cache-multiplier=8'],
+  'periodic purge': ['--purge-interval=1000']
+};
+
+const median = values => values.sort((a, b) => a - b)[Math.floor(values.length / 2)];
+
+const summary = {};
+for (const [mode, switches] of Object.entries(modes)) {
+  const results = [];
+  for (let i = 0; i < runs; i++) {
+    const { stdout, status } = cp.spawnSync(electronPath, [__dirname, ...switches, ...args], { encoding: 'utf8' });
+    if (status !== 0) {
+      console.error(`Run ${i} of ${mode} exited with ${status}`);
+      process.exit(1);
+    }
+    results.push(JSON.parse(stdout.trim().split('\n').pop()));
+  }
+  summary[mode] = {};
+  for (const metric of Object.keys(results[0])) {
+    summary[mode][metric] = Math.round(median(results.map(result => result[metric])) * 1000) / 1000;
+  }
+}
+
+if (args.includes('--json')) {
+  console.log(JSON.stringify(summary, null, 2));
+} else {
+  console.table(summary);
+}
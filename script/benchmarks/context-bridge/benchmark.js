@@ -0,0 +1,64 @@
+/* global bridge, createBenchmarkValues, gc */
+// Runs in the main world, calling the API exposed by preload.js.
+const kMinDuration = 500;
+const kAllocationCalls = 100;
+// Calls made by the isolated world for each call to bridge.callBack().
+const kCallbackBatch = 100;
+
+// Nanoseconds per call of a |fn| that makes |batch| calls.
+function measureTime (fn, batch) {
+  // Warm up, so that the functions involved are optimized.
+  for (let i = 0; i < 10; i++) fn();
+  let calls = 0;
+  const start = performance.now();
+  let elapsed = 0;
+  while (elapsed < kMinDuration) {
+    for (let i = 0; i < 10; i++) fn();
+    calls += 10 * batch;
+    elapsed = performance.now() - start;
+  }
+  return Math.round((elapsed * 1e6) / calls);
+}
+
+// Bytes of V8 heap allocated per call, which includes both worlds as they
+// share the isolate. Approximate, a GC part way through lowers it.
+function measureAllocations (fn, batch) {
+  const calls = Math.max(1, Math.round(kAllocationCalls / batch));
+  gc();
+  const before = performance.memory.usedJSHeapSize;
+  for (let i = 0; i < calls; i++) fn();
+  const after = performance.memory.usedJSHeapSize;
+  return Math.max(0, Math.round((after - before) / (calls * batch)));
+}
+
+function measure (name, direction, fn, batch = 1) {
+  return {
+    name,
+    direction,
+    'ns/call': measureTime(fn, batch),
+    'bytes/call': measureAllocations(fn, batch)
+  };
+}
+
+// eslint-disable-next-line no-unused-vars
+function runBenchmarks (filter) {
+  const values = createBenchmarkValues();
+  // The same API without the bridge, as a baseline.
+  const direct = {
+    accept: () => {},
+    get: (name) => values[name]()
+  };
+  const results = [];
+  for (const name of Object.keys(values)) {
+    if (filter && !name.includes(filter)) continue;
+    const value = values[name];
+    results.push(
+      measure(name, 'direct', () => direct.accept(value())),
+      measure(name, 'argument', () => bridge.accept(value())),
+      measure(name, 'return', () => bridge.get(name)),
+      measure(name, 'callback',
+        () => bridge.callBack(() => {}, name, kCallbackBatch), kCallbackBatch)
+    );
+  }
+  return results;
+}
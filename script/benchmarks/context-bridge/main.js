@@ -0,0 +1,29 @@
+// Measures the cost of calls through contextBridge, see README.md.
+const { app, BrowserWindow } = require('electron');
+const path = require('node:path');
+
+// For gc() and an up to date performance.memory in the benchmarks.
+app.commandLine.appendSwitch('js-flags', '--expose-gc');
+app.commandLine.appendSwitch('enable-precise-memory-info');
+
+app.whenReady().then(async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: {
+      preload: path.join(__dirname, 'preload.js'),
+      contextIsolation: true,
+      // The preload shares values.js with the page.
+      sandbox: false
+    }
+  });
+  await w.loadFile(path.join(__dirname, 'index.html'));
+  const filter = process.argv.find(arg => arg.startsWith('--filter='));
+  const results = await w.webContents.executeJavaScript(
+    `runBenchmarks(${JSON.stringify(filter ? filter.slice('--filter='.length) : '')})`);
+  if (process.argv.includes('--json')) {
+    console.log(JSON.stringify(results, null, 2));
+  } else {
+    console.table(results);
+  }
+  app.quit();
+});
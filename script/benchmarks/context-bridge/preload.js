@@ -0,0 +1,13 @@
+const { contextBridge } = require('electron');
+const { createBenchmarkValues } = require('./values');
+
+const values = createBenchmarkValues();
+
+contextBridge.exposeInMainWorld('bridge', {
+  accept: () => {},
+  get: (name) => values[name](),
+  // Calls |callback| from this world |count| times.
+  callBack: (callback, name, count) => {
+    for (let i = 0; i < count; i++) callback(values[name]());
+  }
+});
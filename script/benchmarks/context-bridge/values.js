@@ -0,0 +1,31 @@
+// The arguments of the benchmarks, by name. Each one is a function returning
+// the value to pass, most return the same value every time. Loaded in both
+// worlds, so that the values returned by the isolated world have the same
+// shape as the ones passed to it.
+// eslint-disable-next-line no-unused-vars
+function createBenchmarkValues () {
+  const constant = (value) => () => value;
+  const object = {};
+  for (let i = 0; i < 100; i++) {
+    object[`key${i}`] = i % 2 ? `value${i}` : i;
+  }
+  const fn = () => {};
+  return {
+    number: constant(42),
+    string: constant('a short string'),
+    nestedObject: constant({ a: { b: { c: [1, 2, { d: 'e' }] } }, f: 'g' }),
+    primitiveObject: constant(object),
+    numberArray: constant(Array.from({ length: 10000 }, (_, i) => i)),
+    function: constant(fn),
+    newFunction: () => () => {},
+    promise: constant(Promise.resolve(42)),
+    smallUint8Array: constant(new Uint8Array(64)),
+    uint8Array: constant(new Uint8Array(1024 * 1024)),
+    float64Array: constant(Float64Array.from({ length: 100000 }, (_, i) => i)),
+    arrayBuffer: constant(new ArrayBuffer(1024 * 1024))
+  };
+}
+
+if (typeof module !== 'undefined') {
+  module.exports = { createBenchmarkValues };
+}
@@ -0,0 +1,61 @@
+// Measures the latency and throughput of the IPC APIs for payloads of
+// different sizes and shapes, in sandboxed and node-integrated renderers, see
+// README.md.
+const { app, BrowserWindow, ipcMain } = require('electron');
+const { once } = require('node:events');
+const path = require('node:path');
+
+const getArg = (name) => {
+  const arg = process.argv.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : undefined;
+};
+
+const options = {
+  filter: getArg('filter') || '',
+  maxSize: parseInt(getArg('max-size') || String(64 * 1024 * 1024), 10),
+  minDuration: parseInt(getArg('duration') || '300', 10)
+};
+const modes = {
+  sandboxed: { sandbox: true },
+  'node-integrated': { sandbox: false, nodeIntegration: true }
+};
+
+// The main process side of each transport only acknowledges the message.
+ipcMain.on('bench-send', (event) => event.reply('bench-ack'));
+ipcMain.handle('bench-invoke', () => null);
+ipcMain.on('bench-sync', (event) => { event.returnValue = null; });
+ipcMain.on('bench-transfer', (event) => {
+  for (const port of event.ports) port.close();
+  event.reply('bench-ack');
+});
+ipcMain.on('bench-port', (event) => {
+  const [port] = event.ports;
+  port.on('message', () => port.postMessage(null));
+  port.start();
+});
+
+app.whenReady().then(async () => {
+  const results = [];
+  for (const [mode, webPreferences] of Object.entries(modes)) {
+    const w = new BrowserWindow({
+      show: false,
+      webPreferences: {
+        ...webPreferences,
+        contextIsolation: true,
+        preload: path.join(__dirname, 'preload.js')
+      }
+    });
+    await w.loadFile(path.join(__dirname, 'index.html'));
+    const done = once(w.webContents.ipc, 'bench-results');
+    w.webContents.send('bench-run', options);
+    const [, modeResults] = await done;
+    for (const result of modeResults) results.push({ mode, ...result });
+    w.destroy();
+  }
+  if (process.argv.includes('--json')) {
+    console.log(JSON.stringify(results, null, 2));
+  } else {
+    console.table(results);
+  }
+  app.quit();
+});
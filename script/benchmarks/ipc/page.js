@@ -0,0 +1,3 @@
+/* global bench */
+// Gives the isolated world a main world function to call through the bridge.
+bench.setSink(() => {});
@@ -0,0 +1,109 @@
+// Runs the benchmarks in the isolated world when the main process asks, see
+// README.md. Sandboxed preloads can't require files, so this is one script.
+const { contextBridge, ipcRenderer } = require('electron');
+
+const kSizes = [16, 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024];
+const kMaxSamples = 1000;
+const kMinSamples = 5;
+
+// Payloads of about |size| bytes, by shape.
+const shapes = {
+  flat: (size) => 'x'.repeat(size),
+  nested: (size) => {
+    // Objects of about 64 bytes, each one with a child.
+    const count = Math.max(1, Math.round(size / 64));
+    const items = [];
+    for (let i = 0; i < count; i++) {
+      items.push({ id: i, name: `item${i}`, child: { ok: true, tags: ['a', 'b'] } });
+    }
+    return { items };
+  },
+  binary: (size) => new Uint8Array(size),
+  // Binary data sent with one MessagePort to transfer.
+  transferable: (size) => new Uint8Array(size)
+};
+
+let sink = () => {};
+contextBridge.exposeInMainWorld('bench', {
+  setSink: (fn) => { sink = fn; }
+});
+
+const ack = () => new Promise(resolve => ipcRenderer.once('bench-ack', resolve));
+
+const createPort = () => {
+  const { port1, port2 } = new MessageChannel();
+  ipcRenderer.postMessage('bench-port', null, [port2]);
+  port1.start();
+  return port1;
+};
+
+// Each transport sends |payload| once and resolves when the main process got
+// it, or when the main world did for the bridge.
+const createTransports = (port) => ({
+  send: (payload) => {
+    const acked = ack();
+    ipcRenderer.send('bench-send', payload);
+    return acked;
+  },
+  invoke: (payload) => ipcRenderer.invoke('bench-invoke', payload),
+  sendSync: (payload) => { ipcRenderer.sendSync('bench-sync', payload); },
+  postMessage: (payload) => {
+    const acked = new Promise(resolve => { port.onmessage = resolve; });
+    port.postMessage(payload);
+    return acked;
+  },
+  postMessageTransfer: (payload) => {
+    const { port1, port2 } = new MessageChannel();
+    const acked = ack();
+    ipcRenderer.postMessage('bench-transfer', payload, [port2]);
+    port1.close();
+    return acked;
+  },
+  contextBridge: (payload) => { sink(payload); }
+});
+
+// Only the transports which can transfer ports take transferables.
+const supportsShape = (transport, shape) =>
+  (shape === 'transferable') === (transport === 'postMessageTransfer');
+
+const percentile = (sorted, p) => sorted[Math.min(sorted.length - 1, Math.ceil(sorted.length * p / 100) - 1)];
+const round = (value) => Math.round(value * 1000) / 1000;
+
+async function measure (send, payload, size, minDuration) {
+  // Warm up, so that the functions involved are optimized.
+  for (let i = 0; i < 3; i++) await send(payload);
+  const latencies = [];
+  const start = performance.now();
+  while (latencies.length < kMaxSamples &&
+         (latencies.length < kMinSamples || performance.now() - start < minDuration)) {
+    const sent = performance.now();
+    await send(payload);
+    latencies.push(performance.now() - sent);
+  }
+  const elapsed = (performance.now() - start) / 1000;
+  latencies.sort((a, b) => a - b);
+  return {
+    'messages/s': Math.round(latencies.length / elapsed),
+    'MB/s': round(latencies.length * size / elapsed / (1024 * 1024)),
+    'p50 (ms)': round(percentile(latencies, 50)),
+    'p99 (ms)': round(percentile(latencies, 99))
+  };
+}
+
+ipcRenderer.on('bench-run', async (event, { filter, maxSize, minDuration }) => {
+  const transports = createTransports(createPort());
+  const results = [];
+  for (const [transport, send] of Object.entries(transports)) {
+    for (const [shape, createPayload] of Object.entries(shapes)) {
+      if (!supportsShape(transport, shape)) continue;
+      const name = `${transport} ${shape}`;
+      if (filter && !name.includes(filter)) continue;
+      for (const size of kSizes) {
+        if (size > maxSize) continue;
+        const payload = createPayload(size);
+        results.push({ transport, shape, size, ...await measure(send, payload, size, minDuration) });
+      }
+    }
+  }
+  ipcRenderer.send('bench-results', results);
+});
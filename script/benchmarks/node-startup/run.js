@@ -0,0 +1,55 @@
+// Starts Electron with ELECTRON_RUN_AS_NODE and Node.js a number of times and
+// prints the median of each startup milestone of both, see README.md.
+const cp = require('node:child_process');
+const utils = require('../../lib/utils');
+
+const args = process.argv.slice(2);
+const runsArg = args.find(arg => arg.startsWith('--runs='));
+const runs = runsArg ? parseInt(runsArg.slice('--runs='.length), 10) : 20;
+const nodeArg = args.find(arg => arg.startsWith('--node='));
+const nodePath = nodeArg ? nodeArg.slice('--node='.length) : process.execPath;
+
+// The milestones of performance.nodeTiming, relative to the start of the
+// process, and when the script ran.
+const script = `
+const { nodeTiming } = require('node:perf_hooks').performance;
+console.log(JSON.stringify({
+  nodeStart: nodeTiming.nodeStart,
+  v8Start: nodeTiming.v8Start,
+  environment: nodeTiming.environment,
+  bootstrapComplete: nodeTiming.bootstrapComplete,
+  scriptStart: require('node:perf_hooks').performance.now()
+}));
+`;
+
+const targets = {
+  electron: [utils.getAbsoluteElectronExec(), { ...process.env, ELECTRON_RUN_AS_NODE: '1' }],
+  node: [nodePath, { ...process.env, ELECTRON_RUN_AS_NODE: undefined }]
+};
+
+const median = values => values.sort((a, b) => a - b)[Math.floor(values.length / 2)];
+
+const summary = {};
+for (const [name, [execPath, env]] of Object.entries(targets)) {
+  const results = [];
+  for (let i = 0; i < runs; i++) {
+    const start = process.hrtime.bigint();
+    const { stdout, status } = cp.spawnSync(execPath, ['-e', script], { encoding: 'utf8', env });
+    const wall = Number(process.hrtime.bigint() - start) / 1e6;
+    if (status !== 0) {
+      console.error(`Run ${i} of ${name} exited with ${status}`);
+      process.exit(1);
+    }
+    results.push({ ...JSON.parse(stdout.trim().split('\n').pop()), exit: wall });
+  }
+  summary[name] = {};
+  for (const milestone of Object.keys(results[0])) {
+    summary[name][milestone] = Math.round(median(results.map(result => result[milestone])) * 10) / 10;
+  }
+}
+
+if (args.includes('--json')) {
+  console.log(JSON.stringify(summary, null, 2));
+} else {
+  console.table(summary);
+}
@@ -0,0 +1,180 @@
+// Measures how fast custom protocols serve the subresources of a page for
+// each kind of response, see README.md.
+const { app, BrowserWindow, contentTracing, net, protocol } = require('electron');
+const asar = require('@electron/asar');
+const fs = require('node:fs');
+const http = require('node:http');
+const os = require('node:os');
+const path = require('node:path');
+const { PassThrough } = require('node:stream');
+const url = require('node:url');
+
+const getArg = (name, fallback) => {
+  const arg = process.argv.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : fallback;
+};
+
+const requests = parseInt(getArg('requests', '1000'), 10);
+const concurrency = parseInt(getArg('concurrency', '50'), 10);
+const bodySizes = {
+  small: 1024,
+  large: parseInt(getArg('large-size', String(4 * 1024 * 1024)), 10)
+};
+const filter = getArg('filter', '');
+const measureCpu = !process.argv.includes('--no-cpu');
+
+// Every scheme serves the same page, so that its loads are same-origin.
+const kPage = `<!DOCTYPE html>
+<html>
+<body>
+<script>
+async function run (path, requests, concurrency) {
+  let next = 0;
+  let bytes = 0;
+  const load = async () => {
+    while (next++ < requests) {
+      const response = await fetch(path);
+      bytes += (await response.arrayBuffer()).byteLength;
+    }
+  };
+  const start = performance.now();
+  await Promise.all(Array.from({ length: concurrency }, load));
+  return { elapsed: performance.now() - start, bytes };
+}
+</script>
+</body>
+</html>`;
+const bodies = {
+  '/index.html': Buffer.from(kPage),
+  '/small': Buffer.alloc(bodySizes.small, 'x'),
+  '/large': Buffer.alloc(bodySizes.large, 'x')
+};
+const mimeType = (pathname) => pathname === '/index.html' ? 'text/html' : 'application/octet-stream';
+
+// The archive is only read by the protocol handlers, the benchmark creates
+// and deletes it as a plain file.
+process.noAsar = true;
+
+const root = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-protocol-benchmark-'));
+const filesDir = path.join(root, 'files');
+const archive = path.join(root, 'bench.asar');
+fs.mkdirSync(filesDir);
+for (const [pathname, body] of Object.entries(bodies)) {
+  fs.writeFileSync(path.join(filesDir, pathname), body);
+}
+
+const server = http.createServer((req, res) => {
+  const { pathname } = new URL(req.url, 'http://127.0.0.1');
+  const body = bodies[pathname];
+  if (!body) {
+    res.statusCode = 404;
+    res.end();
+    return;
+  }
+  res.setHeader('Content-Type', mimeType(pathname));
+  res.end(body);
+});
+
+const pathnameOf = (request) => new URL(request.url).pathname;
+
+// How each kind of response is registered, by scheme.
+const handlers = {
+  string: (scheme) => protocol.registerStringProtocol(scheme, (request, callback) => {
+    const pathname = pathnameOf(request);
+    callback({ data: bodies[pathname].toString(), mimeType: mimeType(pathname) });
+  }),
+  buffer: (scheme) => protocol.registerBufferProtocol(scheme, (request, callback) => {
+    const pathname = pathnameOf(request);
+    callback({ data: bodies[pathname], mimeType: mimeType(pathname) });
+  }),
+  file: (scheme) => protocol.registerFileProtocol(scheme, (request, callback) => {
+    callback({ path: path.join(filesDir, pathnameOf(request)) });
+  }),
+  asar: (scheme) => protocol.registerFileProtocol(scheme, (request, callback) => {
+    callback({ path: path.join(archive, pathnameOf(request)) });
+  }),
+  // The body is in memory, so that this measures the stream and not the disk.
+  stream: (scheme) => protocol.registerStreamProtocol(scheme, (request, callback) => {
+    const pathname = pathnameOf(request);
+    callback({
+      statusCode: 200,
+      headers: { 'content-type': mimeType(pathname) },
+      data: new PassThrough().end(bodies[pathname])
+    });
+  }),
+  http: (scheme) => protocol.registerHttpProtocol(scheme, (request, callback) => {
+    callback({ url: `http://127.0.0.1:${server.address().port}${pathnameOf(request)}` });
+  }),
+  handle: (scheme) => protocol.handle(scheme, (request) =>
+    net.fetch(url.pathToFileURL(path.join(filesDir, new URL(request.url).pathname)).toString()))
+};
+const schemeOf = (type) => `bench-${type}`;
+
+protocol.registerSchemesAsPrivileged(Object.keys(handlers).map(type => ({
+  scheme: schemeOf(type),
+  privileges: { standard: true, secure: true, supportFetchAPI: true }
+})));
+
+// The CPU time of the tasks of the main thread and the IO thread of the
+// browser process during the trace, in milliseconds.
+const getThreadCpuTime = (trace) => {
+  const threads = {};
+  for (const event of trace.traceEvents) {
+    if (event.ph === 'M' && event.name === 'thread_name' && event.pid === process.pid) {
+      threads[event.tid] = event.args.name;
+    }
+  }
+  const time = { CrBrowserMain: 0, Chrome_IOThread: 0 };
+  for (const event of trace.traceEvents) {
+    if (event.ph !== 'X' || event.pid !== process.pid) continue;
+    if (event.name !== 'ThreadControllerImpl::RunTask') continue;
+    const thread = threads[event.tid];
+    if (thread in time) time[thread] += (event.tdur ?? event.dur) / 1000;
+  }
+  return { ui: time.CrBrowserMain, io: time.Chrome_IOThread };
+};
+
+const run = async (w, type, size) => {
+  const count = size === 'small' ? requests : Math.max(10, Math.round(requests / 10));
+  if (measureCpu) await contentTracing.startRecording({ included_categories: ['toplevel'] });
+  const { elapsed, bytes } = await w.webContents.executeJavaScript(
+    `run('/${size}', ${count}, ${concurrency})`);
+  const result = {
+    type,
+    size,
+    'requests/s': Math.round(count / (elapsed / 1000)),
+    'MB/s': Math.round(bytes / (elapsed / 1000) / (1024 * 1024) * 10) / 10
+  };
+  if (measureCpu) {
+    const tracePath = await contentTracing.stopRecording();
+    const cpu = getThreadCpuTime(JSON.parse(fs.readFileSync(tracePath, 'utf8')));
+    fs.rmSync(tracePath, { force: true });
+    result['UI µs/request'] = Math.round(cpu.ui * 1000 / count);
+    result['IO µs/request'] = Math.round(cpu.io * 1000 / count);
+  }
+  return result;
+};
+
+app.whenReady().then(async () => {
+  await asar.createPackage(filesDir, archive);
+  await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+  for (const [type, register] of Object.entries(handlers)) register(schemeOf(type));
+
+  const results = [];
+  for (const type of Object.keys(handlers)) {
+    if (filter && !type.includes(filter)) continue;
+    const w = new BrowserWindow({ show: false });
+    await w.loadURL(`${schemeOf(type)}://bench/index.html`);
+    for (const size of Object.keys(bodySizes)) results.push(await run(w, type, size));
+    w.destroy();
+  }
+
+  if (process.argv.includes('--json')) {
+    console.log(JSON.stringify(results, null, 2));
+  } else {
+    console.table(results);
+  }
+  server.close();
+  fs.rmSync(root, { recursive: true, force: true });
+  app.quit();
+});
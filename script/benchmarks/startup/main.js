@@ -0,0 +1,42 @@
+// Reports how long startup takes in the browser and renderer processes, run
+// by run.js, see README.md.
+const { app, BrowserWindow, ipcMain } = require('electron');
+const path = require('node:path');
+const { performance } = require('node:perf_hooks');
+
+// Milestones of the Node environment, relative to the start of the process.
+const nodeTiming = ({ nodeStart, v8Start, environment, bootstrapComplete }) =>
+  ({ nodeStart, v8Start, environment, bootstrapComplete });
+
+const mainLoaded = performance.now();
+
+app.whenReady().then(async () => {
+  const ready = performance.now();
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: {
+      preload: path.join(__dirname, 'preload.js'),
+      sandbox: process.argv.includes('--sandbox'),
+      nodeIntegration: process.argv.includes('--node-integration')
+    }
+  });
+  const [, renderer] = await Promise.all([
+    w.loadFile(path.join(__dirname, 'index.html')),
+    new Promise(resolve => ipcMain.once('renderer-timing', (event, timing) => resolve(timing)))
+  ]);
+  const windowLoaded = performance.now();
+
+  const traceArg = process.argv.find(arg => arg.startsWith('--trace='));
+  if (traceArg) await app.writeStartupTrace(traceArg.slice('--trace='.length));
+
+  console.log(JSON.stringify({
+    browser: {
+      ...nodeTiming(performance.nodeTiming),
+      mainLoaded,
+      ready,
+      windowLoaded
+    },
+    renderer
+  }));
+  app.quit();
+});
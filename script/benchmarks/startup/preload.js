@@ -0,0 +1,16 @@
+const preloadStart = performance.now();
+const { ipcRenderer } = require('electron');
+
+// Sandboxed preloads don't have a Node environment to report on.
+const nodeTiming = process.sandboxed
+  ? {}
+  : require('node:perf_hooks').performance.nodeTiming;
+
+window.addEventListener('load', () => {
+  ipcRenderer.send('renderer-timing', {
+    environment: nodeTiming.environment,
+    bootstrapComplete: nodeTiming.bootstrapComplete,
+    preloadStart,
+    load: performance.now()
+  });
+});
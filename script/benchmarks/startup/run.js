@@ -0,0 +1,39 @@
+// Starts Electron with the startup benchmark app a number of times and prints
+// the median of each milestone, see README.md.
+const cp = require('node:child_process');
+const path = require('node:path');
+const utils = require('../../lib/utils');
+
+const args = process.argv.slice(2);
+const runsArg = args.find(arg => arg.startsWith('--runs='));
+const runs = runsArg ? parseInt(runsArg.slice('--runs='.length), 10) : 10;
+const electronPath = utils.getAbsoluteElectronExec();
+
+const median = values => {
+  const sorted = values.filter(value => value !== undefined).sort((a, b) => a - b);
+  return sorted.length ? sorted[Math.floor(sorted.length / 2)] : undefined;
+};
+
+const results = [];
+for (let i = 0; i < runs; i++) {
+  const { stdout, status } = cp.spawnSync(electronPath, [__dirname, ...args], { encoding: 'utf8' });
+  if (status !== 0) {
+    console.error(`Run ${i} exited with ${status}`);
+    process.exit(1);
+  }
+  results.push(JSON.parse(stdout.trim().split('\n').pop()));
+}
+
+const summary = {};
+for (const type of ['browser', 'renderer']) {
+  for (const milestone of Object.keys(results[0][type])) {
+    const value = median(results.map(result => result[type][milestone]));
+    if (value !== undefined) summary[`${type}.${milestone}`] = Math.round(value * 10) / 10;
+  }
+}
+
+if (args.includes('--json')) {
+  console.log(JSON.stringify(summary, null, 2));
+} else {
+  console.table(summary);
+}
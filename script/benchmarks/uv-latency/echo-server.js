@@ -0,0 +1,12 @@
+// Echoes everything back, run with ELECTRON_RUN_AS_NODE by main.js so that
+// the other end of the socket is not served by the loop being measured.
+const net = require('node:net');
+
+const server = net.createServer(socket => {
+  socket.setNoDelay(true);
+  socket.pipe(socket);
+});
+server.listen(0, '127.0.0.1', () => {
+  process.send(server.address().port);
+});
+process.on('disconnect', () => process.exit(0));
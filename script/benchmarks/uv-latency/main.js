@@ -0,0 +1,67 @@
+// Measures how long it takes the main process to run the callback of a libuv
+// event once it happened, run by run.js, see README.md.
+const { app } = require('electron');
+const cp = require('node:child_process');
+const fs = require('node:fs');
+const net = require('node:net');
+const path = require('node:path');
+
+const samplesArg = process.argv.find(arg => arg.startsWith('--samples='));
+const samples = samplesArg ? parseInt(samplesArg.slice('--samples='.length), 10) : 1000;
+
+const now = () => Number(process.hrtime.bigint()) / 1000;
+
+const median = values => values.sort((a, b) => a - b)[Math.floor(values.length / 2)];
+
+// From writing to the socket until the echo is received.
+const measureSocket = async () => {
+  const server = cp.fork(path.join(__dirname, 'echo-server.js'), {
+    env: { ...process.env, ELECTRON_RUN_AS_NODE: '1' }
+  });
+  const [port] = await new Promise(resolve => server.once('message', (...args) => resolve(args)));
+  const socket = net.connect(port, '127.0.0.1');
+  socket.setNoDelay(true);
+  await new Promise(resolve => socket.once('connect', resolve));
+
+  const times = [];
+  for (let i = 0; i < samples; i++) {
+    const start = now();
+    socket.write('x');
+    await new Promise(resolve => socket.once('data', resolve));
+    times.push(now() - start);
+  }
+  socket.destroy();
+  server.disconnect();
+  return median(times);
+};
+
+// From starting a request on the threadpool until its callback runs.
+const measureFs = async () => {
+  const times = [];
+  for (let i = 0; i < samples; i++) {
+    const start = now();
+    await new Promise(resolve => fs.stat(__filename, resolve));
+    times.push(now() - start);
+  }
+  return median(times);
+};
+
+// How late a due timer fires.
+const measureTimer = async () => {
+  const times = [];
+  for (let i = 0; i < samples / 10; i++) {
+    const start = now();
+    await new Promise(resolve => setTimeout(resolve, 5));
+    times.push(now() - start - 5000);
+  }
+  return median(times);
+};
+
+app.whenReady().then(async () => {
+  console.log(JSON.stringify({
+    socket: await measureSocket(),
+    fs: await measureFs(),
+    timer: await measureTimer()
+  }));
+  app.quit();
+});
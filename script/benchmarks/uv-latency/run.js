@@ -0,0 +1,40 @@
+// Starts Electron with the uv latency benchmark app with and without
+// --uv-in-message-pump and prints the median latencies of each mode in
+// microseconds, see README.md.
+const cp = require('node:child_process');
+const utils = require('../../lib/utils');
+
+const args = process.argv.slice(2);
+const runsArg = args.find(arg => arg.startsWith('--runs='));
+const runs = runsArg ? parseInt(runsArg.slice('--runs='.length), 10) : 5;
+const electronPath = utils.getAbsoluteElectronExec();
+
+const modes = {
+  'embed thread': [],
+  'message pump': ['--uv-in-message-pump']
+};
+
+const median = values => values.sort((a, b) => a - b)[Math.floor(values.length / 2)];
+
+const summary = {};
+for (const [mode, switches] of Object.entries(modes)) {
+  const results = [];
+  for (let i = 0; i < runs; i++) {
+    const { stdout, status } = cp.spawnSync(electronPath, [...switches, __dirname, ...args], { encoding: 'utf8' });
+    if (status !== 0) {
+      console.error(`Run ${i} of ${mode} exited with ${status}`);
+      process.exit(1);
+    }
+    results.push(JSON.parse(stdout.trim().split('\n').pop()));
+  }
+  summary[mode] = {};
+  for (const event of Object.keys(results[0])) {
+    summary[mode][event] = Math.round(median(results.map(result => result[event])) * 10) / 10;
+  }
+}
+
+if (args.includes('--json')) {
+  console.log(JSON.stringify(summary, null, 2));
+} else {
+  console.table(summary);
+}
@@ -0,0 +1,79 @@
+// Compares the base::Value converters with content::V8ValueConverter, see
+// README.md.
+const { app } = require('electron');
+
+const v8Util = process._linkedBinding('electron_common_v8_util');
+
+const getArg = (name, defaultValue) => {
+  const arg = process.argv.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : defaultValue;
+};
+const iterations = parseInt(getArg('iterations', '20000'), 10);
+const filter = getArg('filter', '');
+
+// Shaped like the values which go through the converters the most.
+const webRequestDetails = () => ({
+  id: 1234,
+  url: 'https://example.com/assets/app.js?v=42',
+  method: 'GET',
+  webContentsId: 1,
+  frameId: 1,
+  resourceType: 'script',
+  referrer: 'https://example.com/',
+  timestamp: 1697270400000.5,
+  uploadData: [],
+  requestHeaders: {
+    Accept: '*/*',
+    'Accept-Language': 'en-US',
+    'User-Agent': 'Mozilla/5.0 Electron',
+    Referer: 'https://example.com/'
+  }
+});
+
+const cases = {
+  'webRequest details': webRequestDetails,
+  'web preferences': () => ({
+    nodeIntegration: false,
+    contextIsolation: true,
+    sandbox: true,
+    webSecurity: true,
+    zoomFactor: 1,
+    defaultFontSize: 16,
+    defaultEncoding: 'UTF-8',
+    preload: '/path/to/preload.js',
+    additionalArguments: ['--foo', '--bar'],
+    defaultFontFamily: { standard: 'Times New Roman', sansSerif: 'Arial' }
+  }),
+  'list of 100 details': () => Array.from({ length: 100 }, webRequestDetails),
+  'list of 1000 numbers': () => Array.from({ length: 1000 }, (_, i) => i * 1.5),
+  'nested 32 deep': () => {
+    let value = { leaf: true };
+    for (let i = 0; i < 32; i++) value = { depth: i, child: value };
+    return value;
+  }
+};
+
+app.whenReady().then(() => {
+  const results = {};
+  for (const [name, create] of Object.entries(cases)) {
+    if (!name.includes(filter)) continue;
+    const value = create();
+    // Warm up the code and the inline caches before measuring.
+    v8Util.benchmarkValueConversion(value, Math.ceil(iterations / 10));
+    const times = v8Util.benchmarkValueConversion(value, iterations);
+    const perCall = (ms) => Math.round(ms * 1e6 / iterations);
+    results[name] = {
+      fromV8Ns: perCall(times.fromV8),
+      genericFromV8Ns: perCall(times.genericFromV8),
+      toV8Ns: perCall(times.toV8),
+      genericToV8Ns: perCall(times.genericToV8)
+    };
+  }
+
+  if (process.argv.includes('--json')) {
+    console.log(JSON.stringify(results, null, 2));
+  } else {
+    console.table(results);
+  }
+  app.quit();
+});
@@ -0,0 +1,92 @@
+// Opens, uses and destroys a window a number of times and reports how long
+// each step took, run by run.js, see README.md.
+const { app, BrowserWindow } = require('electron');
+const { once } = require('node:events');
+const path = require('node:path');
+const { performance } = require('node:perf_hooks');
+
+const getArg = (name, fallback) => {
+  const arg = process.argv.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : fallback;
+};
+
+const iterations = parseInt(getArg('iterations', '10'), 10);
+const warmUp = parseInt(getArg('warm-up', '0'), 10);
+const profile = getArg('profile');
+// The caches of a fresh profile are empty.
+if (profile) app.setPath('userData', profile);
+
+const isRunning = pid => {
+  try {
+    process.kill(pid, 0);
+    return true;
+  } catch {
+    return false;
+  }
+};
+
+const waitForExit = async pid => {
+  while (isRunning(pid)) await new Promise(resolve => setTimeout(resolve, 1));
+};
+
+const rssKB = () => process.memoryUsage().rss / 1024;
+
+const runOnce = async () => {
+  const rssBefore = rssKB();
+  const start = performance.now();
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { preload: path.join(__dirname, 'preload.js') }
+  });
+  const created = performance.now();
+  const readyToShow = once(w, 'ready-to-show').then(() => performance.now());
+  await w.loadFile(path.join(__dirname, 'index.html'));
+  const loaded = performance.now();
+  const shown = await readyToShow;
+
+  const pong = once(w.webContents.ipc, 'pong');
+  const pinged = performance.now();
+  w.webContents.send('ping');
+  await pong;
+  const ponged = performance.now();
+
+  const pid = w.webContents.getOSProcessId();
+  const metrics = app.getAppMetrics().find(metric => metric.pid === pid);
+
+  const destroyed = once(w.webContents, 'destroyed');
+  const destroyStart = performance.now();
+  w.webContents.destroy();
+  await destroyed;
+  const destroyEnd = performance.now();
+  await waitForExit(pid);
+  const exited = performance.now();
+  if (!w.isDestroyed()) w.destroy();
+
+  return {
+    newBrowserWindow: created - start,
+    loadFile: loaded - created,
+    readyToShow: shown - start,
+    ipcRoundTrip: ponged - pinged,
+    destroy: destroyEnd - destroyStart,
+    processTeardown: exited - destroyEnd,
+    rendererWorkingSet: metrics ? metrics.memory.workingSetSize : undefined,
+    browserRssDelta: rssKB() - rssBefore
+  };
+};
+
+app.whenReady().then(async () => {
+  for (let i = 0; i < warmUp; i++) await runOnce();
+  const samples = {};
+  for (let i = 0; i < iterations; i++) {
+    for (const [metric, value] of Object.entries(await runOnce())) {
+      if (value === undefined) continue;
+      (samples[metric] = samples[metric] || []).push(value);
+    }
+  }
+  // run.js measures how long the process takes to exit from here.
+  console.log(JSON.stringify({ samples, quitTime: Date.now() }));
+  app.quit();
+});
+
+// The windows are destroyed on purpose.
+app.on('window-all-closed', () => {});
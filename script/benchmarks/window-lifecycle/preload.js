@@ -0,0 +1,3 @@
+const { ipcRenderer } = require('electron');
+
+ipcRenderer.on('ping', () => ipcRenderer.send('pong'));
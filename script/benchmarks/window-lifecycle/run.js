@@ -0,0 +1,92 @@
+// Starts Electron with the window lifecycle benchmark app with cold and warm
+// caches and prints percentiles of each step, see README.md.
+const cp = require('node:child_process');
+const fs = require('node:fs');
+const os = require('node:os');
+const path = require('node:path');
+const utils = require('../../lib/utils');
+
+const args = process.argv.slice(2);
+const getArg = (name, fallback) => {
+  const arg = args.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : fallback;
+};
+const runs = parseInt(getArg('runs', '5'), 10);
+const iterations = parseInt(getArg('iterations', '10'), 10);
+const output = getArg('output');
+const electronPath = utils.getAbsoluteElectronExec();
+
+const runElectron = (profile, switches) => {
+  const { stdout, status } = cp.spawnSync(electronPath, [__dirname, `--profile=${profile}`, ...switches], { encoding: 'utf8' });
+  if (status !== 0) {
+    console.error(`Electron exited with ${status}`);
+    process.exit(1);
+  }
+  const { samples, quitTime } = JSON.parse(stdout.trim().split('\n').pop());
+  return { ...samples, appQuit: [Date.now() - quitTime] };
+};
+
+const createProfile = () => fs.mkdtempSync(path.join(os.tmpdir(), 'electron-window-lifecycle-'));
+
+const modes = {
+  // Each run has a new profile and only its first window is measured.
+  cold: () => {
+    const results = [];
+    for (let i = 0; i < runs; i++) {
+      const profile = createProfile();
+      results.push(runElectron(profile, ['--iterations=1']));
+      fs.rmSync(profile, { recursive: true, force: true });
+    }
+    return results;
+  },
+  // The runs share a profile which was used before, and the first window of
+  // each run isn't measured.
+  warm: () => {
+    const profile = createProfile();
+    runElectron(profile, ['--iterations=1']);
+    const results = [];
+    for (let i = 0; i < runs; i++) {
+      results.push(runElectron(profile, ['--warm-up=1', `--iterations=${iterations}`]));
+    }
+    fs.rmSync(profile, { recursive: true, force: true });
+    return results;
+  }
+};
+
+const percentile = (sorted, p) => sorted[Math.min(sorted.length - 1, Math.ceil(sorted.length * p / 100) - 1)];
+const round = value => Math.round(value * 100) / 100;
+
+const report = {
+  version: cp.execFileSync(electronPath, ['--version'], { encoding: 'utf8' }).trim(),
+  platform: process.platform,
+  arch: process.arch,
+  runs,
+  iterations,
+  results: {}
+};
+for (const [mode, run] of Object.entries(modes)) {
+  const samples = {};
+  for (const result of run()) {
+    for (const [metric, values] of Object.entries(result)) {
+      (samples[metric] = samples[metric] || []).push(...values);
+    }
+  }
+  for (const [metric, values] of Object.entries(samples)) {
+    const sorted = values.sort((a, b) => a - b);
+    report.results[`${mode}.${metric}`] = {
+      count: sorted.length,
+      min: round(sorted[0]),
+      p50: round(percentile(sorted, 50)),
+      p90: round(percentile(sorted, 90)),
+      p99: round(percentile(sorted, 99)),
+      max: round(sorted[sorted.length - 1])
+    };
+  }
+}
+
+if (output) fs.writeFileSync(output, JSON.stringify(report, null, 2));
+if (args.includes('--json')) {
+  console.log(JSON.stringify(report, null, 2));
+} else {
+  console.table(report.results);
+}
@@ -0,0 +1,94 @@
+// Runs the benchmarks with an instrumented build of Electron and merges the
+// profiles they wrote with Chromium's own into the data of a PGO build, see
+// docs/development/pgo.md.
+const cp = require('node:child_process');
+const fs = require('node:fs');
+const path = require('node:path');
+const utils = require('./lib/utils');
+
+const args = process.argv.slice(2);
+const getArg = (name, fallback) => {
+  const arg = args.find(arg => arg.startsWith(`--${name}=`));
+  return arg ? arg.slice(name.length + 3) : fallback;
+};
+
+const outDir = path.resolve(utils.SRC_DIR, 'out', utils.getOutDir());
+const output = path.resolve(getArg('output', path.join(outDir, 'electron.profdata')));
+// How much Electron's profiles count against Chromium's when merged.
+const weight = parseInt(getArg('weight', '1'), 10);
+const runs = parseInt(getArg('runs', '3'), 10);
+const profrawDir = path.join(outDir, 'pgo_profraw');
+const electronPath = utils.getAbsoluteElectronExec();
+const benchmarks = path.join(utils.ELECTRON_DIR, 'script', 'benchmarks');
+
+// The processes can't write their profiles from the sandbox.
+const scenarios = [
+  ['--no-sandbox', path.join(benchmarks, 'startup')],
+  ['--no-sandbox', path.join(benchmarks, 'startup'), '--sandbox'],
+  ['--no-sandbox', path.join(benchmarks, 'window-lifecycle'), '--iterations=20'],
+  ['--no-sandbox', path.join(benchmarks, 'ipc'), '--max-size=1048576', '--duration=100'],
+  ['--no-sandbox', path.join(benchmarks, 'protocol'), '--requests=500', '--no-cpu']
+];
+
+const getLLVMProfdata = () => {
+  const exe = process.platform === 'win32' ? 'llvm-profdata.exe' : 'llvm-profdata';
+  return path.join(utils.SRC_DIR, 'third_party', 'llvm-build', 'Release+Asserts', 'bin', exe);
+};
+
+// The profile Chromium's official builds use for this platform, which
+// `gclient sync` downloads when checkout_pgo_profiles is set.
+const getChromiumProfile = () => {
+  let target;
+  if (process.platform === 'win32') {
+    target = process.arch === 'ia32' ? 'win32' : process.arch === 'arm64' ? 'win-arm64' : 'win64';
+  } else if (process.platform === 'darwin') {
+    target = process.arch === 'arm64' ? 'mac-arm' : 'mac';
+  } else {
+    target = 'linux';
+  }
+  const buildDir = path.join(utils.SRC_DIR, 'chrome', 'build');
+  const stateFile = path.join(buildDir, `${target}.pgo.txt`);
+  if (!fs.existsSync(stateFile)) return null;
+  const name = fs.readFileSync(stateFile, 'utf8').trim();
+  const profile = path.join(buildDir, 'pgo_profiles', name);
+  return fs.existsSync(profile) ? profile : null;
+};
+
+fs.rmSync(profrawDir, { recursive: true, force: true });
+fs.mkdirSync(profrawDir, { recursive: true });
+// %p and %m keep the profiles of processes running at the same time apart.
+const env = { ...process.env, LLVM_PROFILE_FILE: path.join(profrawDir, 'electron-%p-%m.profraw') };
+
+for (let i = 0; i < runs; i++) {
+  for (const scenario of scenarios) {
+    console.log(`Training run ${i + 1}/${runs}: ${path.basename(scenario[1])} ${scenario.slice(2).join(' ')}`);
+    const { status } = cp.spawnSync(electronPath, scenario, { env, stdio: ['ignore', 'ignore', 'inherit'] });
+    if (status !== 0) {
+      console.error(`${scenario.join(' ')} exited with ${status}`);
+      process.exit(1);
+    }
+  }
+}
+
+const profraws = fs.readdirSync(profrawDir)
+  .filter(file => file.endsWith('.profraw'))
+  .map(file => path.join(profrawDir, file));
+if (!profraws.length) {
+  console.error(`No profiles were written to ${profrawDir}, is ${outDir} an instrumented build?`);
+  process.exit(1);
+}
+
+const llvmProfdata = getLLVMProfdata();
+const electronProfile = path.join(profrawDir, 'electron.profdata');
+cp.execFileSync(llvmProfdata, ['merge', '-o', electronProfile, ...profraws], { stdio: 'inherit' });
+
+const chromiumProfile = getChromiumProfile();
+if (chromiumProfile) {
+  cp.execFileSync(llvmProfdata, [
+    'merge', '-o', output, `--weighted-input=${weight},${electronProfile}`, chromiumProfile
+  ], { stdio: 'inherit' });
+} else {
+  console.warn('Chromium\'s profile was not found, only Electron\'s is used.');
+  fs.copyFileSync(electronProfile, output);
+}
+console.log(`Wrote ${output}`);
@@ -13,6 +13,7 @@
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "build/build_config.h"
@@ -22,7 +23,9 @@
 #include "content/public/common/content_switches.h"
 #include "electron/electron_version.h"
 #include "shell/common/electron_paths.h"
+#include "shell/common/options_switches.h"
 #include "shell/common/thread_restrictions.h"
+#include "third_party/crashpad/crashpad/client/crashpad_info.h"  // nogncheck
 
 #if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
 #include "components/version_info/version_info_values.h"
@@ -172,6 +175,25 @@ bool ElectronCrashReporterClient::GetCollectStatsConsent() {
   return collect_stats_consent_;
 }
 
+void ElectronCrashReporterClient::SetReferencedMemoryLimit(uint32_t limit) {
+  referenced_memory_limit_ = limit;
+  // The handler reads the setting out of the process when it crashes.
+  crashpad::CrashpadInfo::GetCrashpadInfo()
+      ->set_gather_indirectly_referenced_memory(
+          limit ? crashpad::TriState::kEnabled : crashpad::TriState::kUnset,
+          limit);
+}
+
+void ElectronCrashReporterClient::SetOptionsFromCommandLine(
+    const base::CommandLine& command_line) {
+  uint32_t limit;
+  if (base::StringToUint(command_line.GetSwitchValueASCII(
+                             electron::switches::kCrashReferencedMemoryLimit),
+                         &limit)) {
+    SetReferencedMemoryLimit(limit);
+  }
+}
+
 #if BUILDFLAG(IS_MAC)
 bool ElectronCrashReporterClient::ReportingIsEnforcedByPolicy(
     bool* breakpad_enabled) {
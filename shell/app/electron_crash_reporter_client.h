@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_APP_ELECTRON_CRASH_REPORTER_CLIENT_H_
 #define ELECTRON_SHELL_APP_ELECTRON_CRASH_REPORTER_CLIENT_H_
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -13,6 +14,10 @@
 #include "build/build_config.h"
 #include "components/crash/core/app/crash_reporter_client.h"
 
+namespace base {
+class CommandLine;
+}
+
 class ElectronCrashReporterClient : public crash_reporter::CrashReporterClient {
  public:
   static void Create();
@@ -30,6 +35,15 @@ class ElectronCrashReporterClient : public crash_reporter::CrashReporterClient {
   void SetGlobalAnnotations(
       const std::map<std::string, std::string>& annotations);
 
+  // Makes the minidumps of this process include up to |limit| bytes of the
+  // heap memory referenced from its stacks, none when it is zero.
+  void SetReferencedMemoryLimit(uint32_t limit);
+  uint32_t GetReferencedMemoryLimit() const {
+    return referenced_memory_limit_;
+  }
+  // Applies the options which the browser process passed to a child process.
+  void SetOptionsFromCommandLine(const base::CommandLine& command_line);
+
   // crash_reporter::CrashReporterClient implementation.
 #if BUILDFLAG(IS_LINUX)
   void SetCrashReporterClientIdFromGUID(
@@ -85,6 +99,7 @@ class ElectronCrashReporterClient : public crash_reporter::CrashReporterClient {
   bool collect_stats_consent_ = false;
   bool rate_limit_ = false;
   bool compress_uploads_ = false;
+  uint32_t referenced_memory_limit_ = 0;
   std::map<std::string, std::string> global_annotations_;
 
   ElectronCrashReporterClient();
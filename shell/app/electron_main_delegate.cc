@@ -17,6 +17,7 @@
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
+#include "base/process/process.h"
 #include "base/strings/string_split.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
@@ -41,12 +42,16 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "shell/common/process_util.h"
+#include "shell/common/resources_bundle.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 #include "shell/utility/electron_content_utility_client.h"
 #include "third_party/abseil-cpp/absl/types/variant.h"
+#include "ui/base/l10n/l10n_util.h"
 #include "ui/base/resource/resource_bundle.h"
+#include "ui/base/resource/resource_scale_factor.h"
 #include "ui/base/ui_base_switches.h"
 
 #if BUILDFLAG(IS_MAC)
@@ -206,12 +211,49 @@ void RegisterPathProvider() {
                                       PATH_END);
 }
 
+#if BUILDFLAG(ENABLE_RESOURCES_BUNDLE)
+// Loads the same paks as LoadResourceBundle() from the regions of
+// |resources|. Returns an empty string when it has no pak for the locale.
+std::string LoadResourceBundleFromBundle(const std::string& locale,
+                                         const ResourcesBundle& resources) {
+  // The locale is resolved against the locale paks on disk, which are still
+  // shipped next to the bundle.
+  std::string loaded_locale = l10n_util::GetApplicationLocale(locale);
+  auto locale_region =
+      resources.FindRegion("locales/" + loaded_locale + ".pak");
+  if (!locale_region)
+    return std::string();
+
+  ui::ResourceBundle::InitSharedInstanceWithPakFileRegion(
+      resources.Duplicate(), *locale_region);
+  ui::ResourceBundle& bundle = ui::ResourceBundle::GetSharedInstance();
+  const auto add_pak = [&](const char* name, ui::ResourceScaleFactor scale) {
+    if (auto region = resources.FindRegion(name))
+      bundle.AddDataPackFromFileRegion(resources.Duplicate(), *region, scale);
+  };
+  add_pak("chrome_100_percent.pak", ui::k100Percent);
+  if (ui::IsScaleFactorSupported(ui::k200Percent))
+    add_pak("chrome_200_percent.pak", ui::k200Percent);
+  add_pak("resources.pak", ui::kScaleFactorNone);
+  return loaded_locale;
+}
+#endif
+
 }  // namespace
 
 std::string LoadResourceBundle(const std::string& locale) {
   const bool initialized = ui::ResourceBundle::HasSharedInstance();
   DCHECK(!initialized);
 
+#if BUILDFLAG(ENABLE_RESOURCES_BUNDLE)
+  if (const ResourcesBundle* resources = ResourcesBundle::Get()) {
+    std::string loaded_locale =
+        LoadResourceBundleFromBundle(locale, *resources);
+    if (!loaded_locale.empty())
+      return loaded_locale;
+  }
+#endif
+
   // Load other resource files.
   base::FilePath pak_dir;
 #if BUILDFLAG(IS_MAC)
@@ -239,6 +281,17 @@ const size_t ElectronMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     std::size(kNonWildcardDomainNonPortSchemes);
 
 absl::optional<int> ElectronMainDelegate::BasicStartupComplete() {
+  // Time spent loading the executable and its libraries shows up as the gap
+  // between the process start and this phase.
+  const base::Time creation_time = base::Process::Current().CreationTime();
+  if (!creation_time.is_null()) {
+    startup_timeline::Mark(
+        startup_timeline::Phase::kProcessStart,
+        base::TimeTicks::Now() - (base::Time::Now() - creation_time));
+  }
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kBasicStartupComplete);
+
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(IS_WIN)
@@ -315,6 +368,8 @@ absl::optional<int> ElectronMainDelegate::BasicStartupComplete() {
 }
 
 void ElectronMainDelegate::PreSandboxStartup() {
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kPreSandboxStartup);
   auto* command_line = base::CommandLine::ForCurrentProcess();
   std::string process_type = GetProcessType();
 
@@ -376,6 +431,10 @@ void ElectronMainDelegate::PreSandboxStartup() {
 #if !IS_MAS_BUILD()
   crash_keys::SetCrashKeysFromCommandLine(*command_line);
   crash_keys::SetPlatformCrashKey();
+  if (!IsBrowserProcess()) {
+    ElectronCrashReporterClient::Get()->SetOptionsFromCommandLine(
+        *command_line);
+  }
 #endif
 
   if (IsBrowserProcess()) {
@@ -495,6 +554,7 @@ void ElectronMainDelegate::ZygoteForked() {
 
   // Reset the command line for the newly spawned process.
   crash_keys::SetCrashKeysFromCommandLine(*command_line);
+  ElectronCrashReporterClient::Get()->SetOptionsFromCommandLine(*command_line);
 }
 #endif  // BUILDFLAG(IS_LINUX)
 
@@ -50,6 +50,10 @@
 
 namespace {
 
+// V8 runs its tasks on the platform of Node.js, Chromium's task scheduler is
+// only used by gin and Electron's bindings, which need few threads.
+constexpr size_t kMaxThreadPoolForegroundThreads = 2;
+
 // Initialize Node.js cli options to pass to Node.js
 // See https://nodejs.org/api/cli.html#cli_options
 int SetNodeCliFlags() {
@@ -201,8 +205,10 @@ int NodeMain(int argc, char* argv[]) {
     gin::V8Initializer::LoadV8Snapshot(
         gin::V8SnapshotFileType::kWithAdditionalContext);
 
-    // V8 requires a task scheduler.
-    base::ThreadPoolInstance::CreateAndStartWithDefaultParams("Electron");
+    // gin requires a task scheduler.
+    base::ThreadPoolInstance::Create("Electron");
+    base::ThreadPoolInstance::Get()->Start(
+        base::ThreadPoolInstance::InitParams(kMaxThreadPoolForegroundThreads));
 
     // Allow Node.js to track the amount of time the event loop has spent
     // idle in the kernel’s event provider .
@@ -213,7 +219,12 @@ int NodeMain(int argc, char* argv[]) {
         node::per_process::cli_options->get_per_isolate_options()
             ->get_per_env_options()
             ->experimental_fetch;
-    JavascriptEnvironment gin_env(loop, setup_wasm_streaming);
+    // Like Node.js, start as many platform workers as --v8-pool-size asks,
+    // 4 by default, rather than the up to 8 of the browser process. They are
+    // all started before the isolate is created.
+    JavascriptEnvironment gin_env(
+        loop, setup_wasm_streaming,
+        node::per_process::cli_options->v8_thread_pool_size);
 
     v8::Isolate* isolate = gin_env.isolate();
 
@@ -2,32 +2,37 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <utility>
 
 #include "base/location.h"
-#include "base/stl_util.h"
-#include "base/time/time.h"
+#include "base/memory/scoped_refptr.h"
 #include "shell/app/uv_task_runner.h"
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop, base::TimeDelta slack)
+    : loop_(loop),
+      slack_ms_(std::max<int64_t>(0, slack.InMilliseconds())),
+      timer_(new uv_timer_t) {
+  timer_->data = this;
+  uv_timer_init(loop_, timer_);
+}
 
 UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+  uv_timer_stop(timer_);
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_.get()),
+           UvTaskRunner::OnClose);
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  const uint64_t delay_ms = std::max<int64_t>(0, delay.InMilliseconds());
+  tasks_.push_back(
+      {uv_now(loop_) + delay_ms, next_sequence_num_++, std::move(task)});
+  std::push_heap(tasks_.begin(), tasks_.end(), &UvTaskRunner::RunsLater);
+  ScheduleTimer();
   return true;
 }
 
@@ -42,16 +47,52 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
 }
 
 // static
-void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
+bool UvTaskRunner::RunsLater(const DelayedTask& a, const DelayedTask& b) {
+  if (a.run_time != b.run_time)
+    return a.run_time > b.run_time;
+  return a.sequence_num > b.sequence_num;
+}
+
+void UvTaskRunner::RunDueTasks() {
+  timer_armed_ = false;
+  // Tasks posted by the ones that run here wait for the next timeout, which
+  // keeps a task that reposts itself from starving the loop.
+  const uint64_t due_time = uv_now(loop_) + slack_ms_;
+  const uint64_t end_sequence_num = next_sequence_num_;
+  while (!tasks_.empty() && tasks_.front().run_time <= due_time &&
+         tasks_.front().sequence_num < end_sequence_num) {
+    std::pop_heap(tasks_.begin(), tasks_.end(), &UvTaskRunner::RunsLater);
+    base::OnceClosure task = std::move(tasks_.back().task);
+    tasks_.pop_back();
+    std::move(task).Run();
+  }
+  ScheduleTimer();
+}
+
+void UvTaskRunner::ScheduleTimer() {
+  if (tasks_.empty()) {
+    uv_timer_stop(timer_);
+    timer_armed_ = false;
+    return;
+  }
+
+  // The timeout also runs the tasks that are due within the slack after it,
+  // so it only has to move when a task is due before it.
+  const uint64_t run_time = tasks_.front().run_time;
+  if (timer_armed_ && timer_run_time_ <= run_time)
     return;
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+  const uint64_t now = uv_now(loop_);
+  timer_armed_ = true;
+  timer_run_time_ = std::max(run_time, now);
+  uv_timer_start(timer_, UvTaskRunner::OnTimeout, timer_run_time_ - now, 0);
+}
+
+// static
+void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
+  // The tasks may drop the last reference to the runner.
+  scoped_refptr<UvTaskRunner> self(static_cast<UvTaskRunner*>(timer->data));
+  self->RunDueTasks();
 }
 
 // static
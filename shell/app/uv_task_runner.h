@@ -5,24 +5,30 @@
 #ifndef ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 #define ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <cstdint>
+#include <vector>
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 
 namespace base {
 class Location;
-class TimeDelta;
 }  // namespace base
 
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// All the delayed tasks share one uv timer, which is armed for the earliest
+// of them. Tasks are due up to |slack| early so that those posted for around
+// the same time run from the same timeout instead of each waking up the loop.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
-  explicit UvTaskRunner(uv_loop_t* loop);
+  explicit UvTaskRunner(uv_loop_t* loop,
+                        base::TimeDelta slack = base::TimeDelta());
 
   // disable copy
   UvTaskRunner(const UvTaskRunner&) = delete;
@@ -38,13 +44,37 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    // In the milliseconds of uv_now().
+    uint64_t run_time;
+    // Keeps tasks that are due at the same time in posting order.
+    uint64_t sequence_num;
+    base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+  // Puts the earliest task at the front of |tasks_|.
+  static bool RunsLater(const DelayedTask& a, const DelayedTask& b);
   static void OnTimeout(uv_timer_t* timer);
   static void OnClose(uv_handle_t* handle);
 
+  void RunDueTasks();
+  // Arms |timer_| for the earliest task.
+  void ScheduleTimer();
+
   raw_ptr<uv_loop_t> loop_;
+  const uint64_t slack_ms_;
+
+  // Owned by the loop once closed, see OnClose().
+  raw_ptr<uv_timer_t> timer_;
+  bool timer_armed_ = false;
+  // When |timer_| fires, in the milliseconds of uv_now().
+  uint64_t timer_run_time_ = 0;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  // Min-heap on the run time. Its storage is reused as tasks come and go, so
+  // posting a task doesn't allocate once the heap has grown.
+  std::vector<DelayedTask> tasks_;
+  uint64_t next_sequence_num_ = 0;
 };
 
 }  // namespace electron
@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/allocator_monitor.h"
+
+#include <memory>
+
+#include "base/allocator/partition_allocator/partition_alloc_buildflags.h"
+#include "base/functional/bind.h"
+#include "base/process/process_metrics.h"
+
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+#include "base/allocator/partition_allocator/memory_reclaimer.h"
+#include "base/allocator/partition_allocator/partition_root.h"
+#include "base/allocator/partition_allocator/partition_stats.h"
+#include "base/allocator/partition_allocator/shim/allocator_shim_default_dispatch_to_partition_alloc.h"
+#include "base/allocator/partition_allocator/thread_cache.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+// Only the totals are needed, not the buckets.
+class StatsDumper : public partition_alloc::PartitionStatsDumper {
+ public:
+  explicit StatsDumper(AllocatorMonitor::Stats* stats) : stats_(stats) {}
+
+  void PartitionDumpTotals(
+      const char* partition_name,
+      const partition_alloc::PartitionMemoryStats* memory_stats) override {
+    stats_->committed += memory_stats->total_committed_bytes / 1024;
+    stats_->resident += memory_stats->total_resident_bytes / 1024;
+    stats_->allocated += memory_stats->total_active_bytes / 1024;
+    if (!memory_stats->has_thread_cache)
+      return;
+    const partition_alloc::ThreadCacheStats& thread_cache_stats =
+        memory_stats->all_thread_caches_stats;
+    stats_->thread_cache = true;
+    stats_->thread_cache_size = thread_cache_stats.bucket_total_memory / 1024;
+    if (thread_cache_stats.alloc_count) {
+      stats_->thread_cache_hit_rate =
+          static_cast<double>(thread_cache_stats.alloc_hits) /
+          thread_cache_stats.alloc_count;
+    }
+  }
+
+  void PartitionsDumpBucketStats(
+      const char* partition_name,
+      const partition_alloc::PartitionBucketMemoryStats*) override {}
+
+ private:
+  AllocatorMonitor::Stats* stats_;
+};
+#endif
+
+}  // namespace
+
+AllocatorMonitor::AllocatorMonitor() = default;
+
+AllocatorMonitor::~AllocatorMonitor() = default;
+
+AllocatorMonitor::Stats AllocatorMonitor::GetStats() const {
+  Stats stats;
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+  stats.partition_alloc = true;
+  StatsDumper dumper(&stats);
+  allocator_shim::internal::PartitionAllocMalloc::Allocator()->DumpStats(
+      "malloc", true /* is_light_dump */, &dumper);
+  if (stats.committed) {
+    stats.fragmentation =
+        1 - static_cast<double>(stats.allocated) / stats.committed;
+  }
+#endif
+  stats.malloc_usage =
+      base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage() /
+      1024;
+  return stats;
+}
+
+void AllocatorMonitor::SetThreadCacheMultiplier(float multiplier) {
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+  partition_alloc::ThreadCacheRegistry::Instance().SetThreadCacheMultiplier(
+      multiplier);
+#endif
+}
+
+void AllocatorMonitor::SetPurgeInterval(base::TimeDelta interval) {
+  purge_interval_ = interval;
+  if (interval.is_zero()) {
+    purge_timer_.Stop();
+    return;
+  }
+  // Unretained is safe as |purge_timer_| is owned by |this|.
+  purge_timer_.Start(FROM_HERE, interval,
+                     base::BindRepeating(base::IgnoreResult(
+                                             &AllocatorMonitor::Purge),
+                                         base::Unretained(this)));
+}
+
+bool AllocatorMonitor::Purge() {
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+  partition_alloc::ThreadCacheRegistry::Instance().PurgeAll();
+  ::partition_alloc::MemoryReclaimer::Instance()->ReclaimNormal();
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace electron
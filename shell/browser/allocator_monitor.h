@@ -0,0 +1,63 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_ALLOCATOR_MONITOR_H_
+#define ELECTRON_SHELL_BROWSER_ALLOCATOR_MONITOR_H_
+
+#include <cstdint>
+
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+// Reports the state of the allocators of the browser process and tunes the
+// thread cache of PartitionAlloc, for app.getAllocatorStats() and
+// app.configureAllocator(). Only used on the UI thread.
+class AllocatorMonitor {
+ public:
+  // The sizes are in KB.
+  struct Stats {
+    // Whether malloc is served by PartitionAlloc, the other fields but
+    // |malloc_usage| are only set when it is.
+    bool partition_alloc = false;
+    uint64_t committed = 0;
+    uint64_t resident = 0;
+    uint64_t allocated = 0;
+    // The share of the committed memory which isn't allocated, from 0 to 1.
+    double fragmentation = 0;
+    bool thread_cache = false;
+    // The share of the allocations of all the threads served by their cache.
+    double thread_cache_hit_rate = 0;
+    uint64_t thread_cache_size = 0;
+    uint64_t malloc_usage = 0;
+  };
+
+  AllocatorMonitor();
+  ~AllocatorMonitor();
+
+  // disable copy
+  AllocatorMonitor(const AllocatorMonitor&) = delete;
+  AllocatorMonitor& operator=(const AllocatorMonitor&) = delete;
+
+  Stats GetStats() const;
+
+  // Scales how many objects the thread caches keep, 2 by default.
+  void SetThreadCacheMultiplier(float multiplier);
+  // Purges the thread caches and releases the empty pages of the partitions
+  // every |interval|, on top of what Chromium does. Zero stops it.
+  void SetPurgeInterval(base::TimeDelta interval);
+  base::TimeDelta purge_interval() const { return purge_interval_; }
+
+  // Returns false when malloc isn't served by PartitionAlloc.
+  bool Purge();
+
+ private:
+  base::TimeDelta purge_interval_;
+  base::RepeatingTimer purge_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_ALLOCATOR_MONITOR_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/app_metrics_sampler.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/system/sys_info.h"
+
+namespace electron {
+
+AppMetricsSnapshot::AppMetricsSnapshot() = default;
+AppMetricsSnapshot::AppMetricsSnapshot(AppMetricsSnapshot&&) = default;
+AppMetricsSnapshot& AppMetricsSnapshot::operator=(AppMetricsSnapshot&&) =
+    default;
+AppMetricsSnapshot::~AppMetricsSnapshot() = default;
+
+AppMetricsSampler::AppMetricsSampler(base::TimeDelta interval,
+                                     SnapshotCallback callback)
+    : callback_(std::move(callback)),
+      processor_count_(base::SysInfo::NumberOfProcessors()) {
+  // Unretained is safe as |timer_| is owned by |this|.
+  timer_.Start(FROM_HERE, interval,
+               base::BindRepeating(&AppMetricsSampler::Sample,
+                                   base::Unretained(this)));
+}
+
+AppMetricsSampler::~AppMetricsSampler() = default;
+
+void AppMetricsSampler::AddProcess(int id,
+                                   std::unique_ptr<ProcessMetric> process) {
+  // The first call only records the baseline of the CPU usage.
+  process->metrics->GetPlatformIndependentCPUUsage();
+  processes_[id] = std::move(process);
+}
+
+void AppMetricsSampler::RemoveProcess(int id) {
+  processes_.erase(id);
+}
+
+void AppMetricsSampler::Sample() {
+  AppMetricsSnapshot snapshot;
+  const size_t count = processes_.size();
+  snapshot.ids.reserve(count);
+  snapshot.pids.reserve(count);
+  snapshot.types.reserve(count);
+  snapshot.creation_times.reserve(count);
+  snapshot.cpu_usages.reserve(count);
+  snapshot.idle_wakeups.reserve(count);
+#if !BUILDFLAG(IS_LINUX)
+  snapshot.memory.reserve(count);
+#endif
+
+  for (const auto& [id, process] : processes_) {
+    snapshot.ids.push_back(id);
+    snapshot.pids.push_back(process->process.Pid());
+    snapshot.types.push_back(process->type);
+    snapshot.creation_times.push_back(
+        process->process.CreationTime().ToJsTime());
+    snapshot.cpu_usages.push_back(
+        process->metrics->GetPlatformIndependentCPUUsage() / processor_count_);
+#if !BUILDFLAG(IS_WIN)
+    snapshot.idle_wakeups.push_back(
+        process->metrics->GetIdleWakeupsPerSecond());
+#else
+    // Not implemented on Windows, like in App::GetAppMetrics.
+    snapshot.idle_wakeups.push_back(0);
+#endif
+#if !BUILDFLAG(IS_LINUX)
+    snapshot.memory.push_back(process->GetMemoryInfo());
+#endif
+  }
+
+  callback_.Run(std::move(snapshot));
+}
+
+}  // namespace electron
@@ -0,0 +1,73 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_APP_METRICS_SAMPLER_H_
+#define ELECTRON_SHELL_BROWSER_API_APP_METRICS_SAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/functional/callback.h"
+#include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/browser/api/process_metric.h"
+
+namespace electron {
+
+// The metrics of the app's processes at one point in time. The values of the
+// process |ids[i]| are at index |i| of every array, and |ids| is sorted.
+struct AppMetricsSnapshot {
+  AppMetricsSnapshot();
+  AppMetricsSnapshot(AppMetricsSnapshot&&);
+  AppMetricsSnapshot& operator=(AppMetricsSnapshot&&);
+  ~AppMetricsSnapshot();
+
+  size_t size() const { return ids.size(); }
+
+  // The keys of the processes in App's metrics map.
+  std::vector<int> ids;
+  std::vector<base::ProcessId> pids;
+  std::vector<int> types;
+  // In milliseconds since the epoch.
+  std::vector<double> creation_times;
+  std::vector<double> cpu_usages;
+  std::vector<int> idle_wakeups;
+#if !BUILDFLAG(IS_LINUX)
+  std::vector<ProcessMemoryInfo> memory;
+#endif
+};
+
+// Samples the metrics of the app's processes at a fixed interval. It lives on
+// a worker sequence so the system calls needed to read the metrics don't run
+// on the UI thread.
+class AppMetricsSampler {
+ public:
+  using SnapshotCallback = base::RepeatingCallback<void(AppMetricsSnapshot)>;
+
+  AppMetricsSampler(base::TimeDelta interval, SnapshotCallback callback);
+  ~AppMetricsSampler();
+
+  // disable copy
+  AppMetricsSampler(const AppMetricsSampler&) = delete;
+  AppMetricsSampler& operator=(const AppMetricsSampler&) = delete;
+
+  // |process| is a copy of the one of App, as base::ProcessMetrics computes
+  // the CPU usage relative to its previous call.
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> process);
+  void RemoveProcess(int id);
+
+ private:
+  void Sample();
+
+  std::map<int, std::unique_ptr<ProcessMetric>> processes_;
+  const SnapshotCallback callback_;
+  const int processor_count_;
+  base::RepeatingTimer timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_APP_METRICS_SAMPLER_H_
@@ -0,0 +1,273 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/background_memory_policy.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/memory_pressure_monitor.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/visibility.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+
+namespace electron::api {
+
+namespace {
+
+using MemoryPressureLevel = base::MemoryPressureListener::MemoryPressureLevel;
+
+bool IsCandidate(WebContents* web_contents,
+                 base::TimeTicks now,
+                 base::TimeDelta hidden_time) {
+  if (web_contents->GetType() != WebContents::Type::kBrowserWindow &&
+      web_contents->GetType() != WebContents::Type::kBrowserView) {
+    return false;
+  }
+  content::WebContents* contents = web_contents->web_contents();
+  if (!contents || contents->IsBeingDestroyed() ||
+      contents->GetVisibility() != content::Visibility::HIDDEN) {
+    return false;
+  }
+  // Hidden pages which play audio or are being captured are still in use.
+  if (contents->IsCurrentlyAudible() || contents->IsBeingCaptured() ||
+      web_contents->lifecycle_state() ==
+          WebContents::LifecycleState::kDiscarded) {
+    return false;
+  }
+  return now - contents->GetLastActiveTime() >= hidden_time;
+}
+
+}  // namespace
+
+// Tracks a page the policy acted on, until it is shown. WebContents restores
+// the frozen and discarded pages itself.
+class BackgroundMemoryPolicy::Page : public content::WebContentsObserver {
+ public:
+  Page(content::WebContents* web_contents, base::OnceClosure done)
+      : content::WebContentsObserver(web_contents), done_(std::move(done)) {}
+  ~Page() override = default;
+
+  // disable copy
+  Page(const Page&) = delete;
+  Page& operator=(const Page&) = delete;
+
+  size_t actions_taken() const { return actions_taken_; }
+  void set_actions_taken(size_t count) { actions_taken_ = count; }
+
+ private:
+  // content::WebContentsObserver:
+  void OnVisibilityChanged(content::Visibility visibility) override {
+    // Destroys |this|.
+    if (visibility != content::Visibility::HIDDEN)
+      std::move(done_).Run();
+  }
+
+  void WebContentsDestroyed() override { std::move(done_).Run(); }
+
+  size_t actions_taken_ = 0;
+  base::OnceClosure done_;
+};
+
+BackgroundMemoryPolicy::Options::Options() = default;
+BackgroundMemoryPolicy::Options::Options(const Options&) = default;
+BackgroundMemoryPolicy::Options& BackgroundMemoryPolicy::Options::operator=(
+    const Options&) = default;
+BackgroundMemoryPolicy::Options::~Options() = default;
+
+BackgroundMemoryPolicy::BackgroundMemoryPolicy(const Options& options,
+                                               ActionCallback callback)
+    : options_(options),
+      callback_(std::move(callback)),
+      memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&BackgroundMemoryPolicy::OnMemoryPressure,
+                              base::Unretained(this))) {
+  // Unretained is safe as |check_timer_| is owned by |this|.
+  check_timer_.Start(
+      FROM_HERE, options_.check_interval,
+      base::BindRepeating(&BackgroundMemoryPolicy::Check,
+                          base::Unretained(this)));
+}
+
+BackgroundMemoryPolicy::~BackgroundMemoryPolicy() = default;
+
+void BackgroundMemoryPolicy::OnMemoryPressure(MemoryPressureLevel level) {
+  // Act right away instead of waiting for the next check.
+  if (level != MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE)
+    Check();
+}
+
+void BackgroundMemoryPolicy::Check() {
+  if (check_pending_)
+    return;
+  check_pending_ = true;
+  // Only the footprints of the processes are needed, not the allocators.
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump(
+          {}, base::BindOnce(&BackgroundMemoryPolicy::OnGlobalDump,
+                             weak_factory_.GetWeakPtr()));
+}
+
+void BackgroundMemoryPolicy::OnGlobalDump(
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  check_pending_ = false;
+  if (!success)
+    return;
+
+  base::flat_map<base::ProcessId, uint64_t> footprints;
+  for (const auto& process_dump : dump->process_dumps())
+    footprints[process_dump.pid()] =
+        process_dump.os_dump().private_footprint_kb;
+
+  const auto* monitor = base::MemoryPressureMonitor::Get();
+  const MemoryPressureLevel pressure =
+      monitor ? monitor->GetCurrentPressureLevel()
+              : MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<base::WeakPtr<WebContents>> candidates;
+  for (WebContents* web_contents : WebContents::GetAll()) {
+    if (IsCandidate(web_contents, now, options_.hidden_time))
+      candidates.push_back(web_contents->GetWeakPtr());
+  }
+  // The least recently used pages are acted on first.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) {
+              return a->web_contents()->GetLastActiveTime() <
+                     b->web_contents()->GetLastActiveTime();
+            });
+
+  bool closed = false;
+  // The callbacks run JavaScript, which can destroy the other candidates.
+  for (const base::WeakPtr<WebContents>& web_contents : candidates) {
+    if (!web_contents || !web_contents->web_contents())
+      continue;
+    const base::ProcessId pid = web_contents->web_contents()
+                                    ->GetPrimaryMainFrame()
+                                    ->GetProcess()
+                                    ->GetProcess()
+                                    .Pid();
+    auto footprint = footprints.find(pid);
+    if (footprint == footprints.end())
+      continue;
+    const bool over_limit = options_.footprint_limit &&
+                            footprint->second > options_.footprint_limit;
+    if (!over_limit &&
+        pressure == MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE) {
+      continue;
+    }
+
+    const int32_t id = web_contents->ID();
+    auto& slot = pages_[id];
+    if (!slot) {
+      slot = std::make_unique<Page>(
+          web_contents->web_contents(),
+          base::BindOnce(&BackgroundMemoryPolicy::OnPageShownOrDestroyed,
+                         base::Unretained(this), id));
+    }
+    Page* page = slot.get();
+
+    // Actions which can't be taken on the page are skipped.
+    for (size_t i = page->actions_taken(); i < options_.actions.size(); ++i) {
+      const Action action = options_.actions[i];
+      if (action == Action::kClose &&
+          (closed ||
+           pressure != MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL)) {
+        break;
+      }
+      page->set_actions_taken(i + 1);
+      // |page| can be destroyed by the action.
+      if (TakeAction(web_contents.get(), action, pid, footprint->second)) {
+        closed |= action == Action::kClose;
+        break;
+      }
+    }
+  }
+}
+
+bool BackgroundMemoryPolicy::TakeAction(WebContents* web_contents,
+                                        Action action,
+                                        base::ProcessId pid,
+                                        uint64_t footprint) {
+  switch (action) {
+    case Action::kReduce:
+      web_contents->ReduceRendererMemory(
+          true, true, true,
+          base::BindOnce(&BackgroundMemoryPolicy::OnMemoryReduced,
+                         weak_factory_.GetWeakPtr(),
+                         web_contents->GetWeakPtr(), pid, footprint));
+      return true;
+    case Action::kFreeze:
+      if (web_contents->lifecycle_state() !=
+              WebContents::LifecycleState::kActive ||
+          !web_contents->Freeze()) {
+        return false;
+      }
+      callback_.Run(web_contents, action, footprint, absl::nullopt);
+      return true;
+    case Action::kDiscard:
+      if (!web_contents->Discard())
+        return false;
+      callback_.Run(web_contents, action, footprint, footprint);
+      return true;
+    case Action::kClose: {
+      base::WeakPtr<WebContents> weak_web_contents = web_contents->GetWeakPtr();
+      callback_.Run(web_contents, action, footprint, footprint);
+      if (weak_web_contents)
+        weak_web_contents->Close(absl::nullopt);
+      return true;
+    }
+  }
+  return false;
+}
+
+void BackgroundMemoryPolicy::OnMemoryReduced(
+    base::WeakPtr<WebContents> web_contents,
+    base::ProcessId pid,
+    uint64_t footprint,
+    bool success) {
+  if (!success || !web_contents)
+    return;
+  // Measure again to know how much was released.
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDumpForPid(
+          pid, {},
+          base::BindOnce(
+              [](base::WeakPtr<BackgroundMemoryPolicy> policy,
+                 base::WeakPtr<WebContents> web_contents, base::ProcessId pid,
+                 uint64_t footprint, bool success,
+                 std::unique_ptr<memory_instrumentation::GlobalMemoryDump>
+                     dump) {
+                if (!policy || !web_contents)
+                  return;
+                absl::optional<uint64_t> reclaimed;
+                if (success) {
+                  for (const auto& process_dump : dump->process_dumps()) {
+                    if (process_dump.pid() != pid)
+                      continue;
+                    const uint64_t now =
+                        process_dump.os_dump().private_footprint_kb;
+                    reclaimed = footprint > now ? footprint - now : 0;
+                  }
+                }
+                policy->callback_.Run(web_contents.get(), Action::kReduce,
+                                      footprint, reclaimed);
+              },
+              weak_factory_.GetWeakPtr(), std::move(web_contents), pid,
+              footprint));
+}
+
+void BackgroundMemoryPolicy::OnPageShownOrDestroyed(int32_t id) {
+  pages_.erase(id);
+}
+
+}  // namespace electron::api
@@ -0,0 +1,112 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_BACKGROUND_MEMORY_POLICY_H_
+#define ELECTRON_SHELL_BROWSER_API_BACKGROUND_MEMORY_POLICY_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/functional/callback.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
+namespace electron::api {
+
+class WebContents;
+
+// Reclaims the memory of the pages which have been hidden for a while, when
+// the system is under memory pressure or when their renderer grows past a
+// limit. Each time a page qualifies the next action of the policy is taken,
+// and the page is restored once it is shown again.
+class BackgroundMemoryPolicy {
+ public:
+  enum class Action {
+    // Clear the caches of the renderer and notify V8 of memory pressure.
+    kReduce,
+    // Freeze the page, it stops running tasks until it is shown.
+    kFreeze,
+    // Shut down the renderer if the page is its only one, the page is
+    // reloaded when it is shown.
+    kDiscard,
+    // Close the least recently used page, only under critical pressure.
+    kClose,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    // How long a page has to be hidden before the policy acts on it.
+    base::TimeDelta hidden_time = base::Minutes(1);
+    base::TimeDelta check_interval = base::Seconds(30);
+    // The private footprint of a renderer in KB above which its hidden pages
+    // are acted on without memory pressure, 0 for no limit.
+    uint64_t footprint_limit = 0;
+    std::vector<Action> actions = {Action::kReduce, Action::kFreeze};
+  };
+
+  // Called after an action is taken on |web_contents|. |footprint| is the
+  // private footprint of its renderer in KB before the action and |reclaimed|
+  // how much of it was released, when it is known.
+  using ActionCallback =
+      base::RepeatingCallback<void(WebContents* web_contents,
+                                   Action action,
+                                   uint64_t footprint,
+                                   absl::optional<uint64_t> reclaimed)>;
+
+  BackgroundMemoryPolicy(const Options& options, ActionCallback callback);
+  ~BackgroundMemoryPolicy();
+
+  // disable copy
+  BackgroundMemoryPolicy(const BackgroundMemoryPolicy&) = delete;
+  BackgroundMemoryPolicy& operator=(const BackgroundMemoryPolicy&) = delete;
+
+ private:
+  class Page;
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void Check();
+  void OnGlobalDump(
+      bool success,
+      std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump);
+  // Returns false when |action| can't be taken on the page.
+  bool TakeAction(WebContents* web_contents,
+                  Action action,
+                  base::ProcessId pid,
+                  uint64_t footprint);
+  void OnMemoryReduced(base::WeakPtr<WebContents> web_contents,
+                       base::ProcessId pid,
+                       uint64_t footprint,
+                       bool success);
+  void OnPageShownOrDestroyed(int32_t id);
+
+  const Options options_;
+  const ActionCallback callback_;
+
+  // The pages acted on, by WebContents id.
+  base::flat_map<int32_t, std::unique_ptr<Page>> pages_;
+
+  bool check_pending_ = false;
+  base::RepeatingTimer check_timer_;
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  base::WeakPtrFactory<BackgroundMemoryPolicy> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_BACKGROUND_MEMORY_POLICY_H_
@@ -0,0 +1,289 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/background_trimmer.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/barrier_closure.h"
+#include "base/containers/flat_set.h"
+#include "base/functional/bind.h"
+#include "base/process/process.h"
+#include "components/viz/client/frame_eviction_manager.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "shell/browser/allocator_monitor.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/browser.h"
+#include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/browser/window_list.h"
+#include "ui/base/idle/idle.h"
+#include "v8/include/v8.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#elif BUILDFLAG(IS_MAC)
+#include <malloc/malloc.h>
+#endif
+
+namespace electron::api {
+
+namespace {
+
+using memory_instrumentation::GlobalMemoryDump;
+using memory_instrumentation::mojom::ProcessType;
+
+std::string GetProcessTypeName(ProcessType type) {
+  switch (type) {
+    case ProcessType::BROWSER:
+      return "Browser";
+    case ProcessType::RENDERER:
+      return "Tab";
+    case ProcessType::GPU:
+      return "GPU";
+    case ProcessType::UTILITY:
+      return "Utility";
+    default:
+      return "Unknown";
+  }
+}
+
+// Returns one page of each renderer.
+std::vector<base::WeakPtr<WebContents>> GetOnePagePerRenderer() {
+  base::flat_set<int> process_ids;
+  std::vector<base::WeakPtr<WebContents>> pages;
+  for (WebContents* web_contents : WebContents::GetAll()) {
+    content::WebContents* contents = web_contents->web_contents();
+    if (!contents || contents->IsBeingDestroyed())
+      continue;
+    // The caches and the V8 heap belong to the process, not to the page.
+    const int process_id =
+        contents->GetPrimaryMainFrame()->GetProcess()->GetID();
+    if (process_ids.insert(process_id).second)
+      pages.push_back(web_contents->GetWeakPtr());
+  }
+  return pages;
+}
+
+void TrimWorkingSets() {
+#if BUILDFLAG(IS_WIN)
+  // Windows pages the trimmed memory back in as it is used again.
+  ::SetProcessWorkingSetSize(::GetCurrentProcess(), static_cast<SIZE_T>(-1),
+                             static_cast<SIZE_T>(-1));
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (!host->IsInitializedAndNotDead())
+      continue;
+    ::SetProcessWorkingSetSize(host->GetProcess().Handle(),
+                               static_cast<SIZE_T>(-1),
+                               static_cast<SIZE_T>(-1));
+  }
+#elif BUILDFLAG(IS_MAC)
+  // macOS has no working sets to trim, but the malloc zones of the main
+  // process can give their free pages back.
+  malloc_zone_pressure_relief(nullptr, 0);
+#endif
+}
+
+void OnDumpAfterTrim(BackgroundTrimmer::Report report,
+                     base::OnceCallback<void(BackgroundTrimmer::Report)> done,
+                     bool success,
+                     std::unique_ptr<GlobalMemoryDump> dump) {
+  if (success) {
+    for (const auto& process_dump : dump->process_dumps()) {
+      auto process = std::find_if(
+          report.processes.begin(), report.processes.end(),
+          [&](const auto& entry) { return entry.pid == process_dump.pid(); });
+      if (process != report.processes.end())
+        process->after = process_dump.os_dump().private_footprint_kb;
+    }
+  }
+  // Processes which went away in the meantime released everything.
+  std::move(done).Run(std::move(report));
+}
+
+void OnRenderersTrimmed(
+    BackgroundTrimmer::Report report,
+    base::OnceCallback<void(BackgroundTrimmer::Report)> done) {
+  TrimWorkingSets();
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump({}, base::BindOnce(&OnDumpAfterTrim,
+                                             std::move(report),
+                                             std::move(done)));
+}
+
+void OnDumpBeforeTrim(BackgroundTrimmer::Reason reason,
+                      base::OnceCallback<void(BackgroundTrimmer::Report)> done,
+                      bool success,
+                      std::unique_ptr<GlobalMemoryDump> dump) {
+  BackgroundTrimmer::Report report;
+  report.reason = reason;
+  if (success) {
+    for (const auto& process_dump : dump->process_dumps()) {
+      BackgroundTrimmer::ProcessReport process;
+      process.pid = process_dump.pid();
+      process.type = GetProcessTypeName(process_dump.process_type());
+      process.before = process_dump.os_dump().private_footprint_kb;
+      report.processes.push_back(std::move(process));
+    }
+  }
+
+  // The main process.
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  isolate->LowMemoryNotification();
+  ElectronBrowserMainParts::Get()->GetAllocatorMonitor()->Purge();
+  // The frames kept to show hidden windows again without waiting for their
+  // renderer, which hold GPU memory.
+  viz::FrameEvictionManager::GetInstance()->PurgeAllUnlockedFrames();
+
+  // The renderers, a critical memory pressure notification makes V8 run a
+  // full garbage collection.
+  std::vector<base::WeakPtr<WebContents>> pages = GetOnePagePerRenderer();
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      pages.size(),
+      base::BindOnce(&OnRenderersTrimmed, std::move(report), std::move(done)));
+  for (const auto& page : pages) {
+    page->ReduceRendererMemory(
+        true /* purge_caches */, true /* notify_v8 */,
+        true /* purge_partition_alloc */,
+        base::BindOnce([](base::RepeatingClosure barrier,
+                          bool success) { barrier.Run(); },
+                       barrier));
+  }
+}
+
+}  // namespace
+
+BackgroundTrimmer::Report::Report() = default;
+BackgroundTrimmer::Report::Report(Report&&) = default;
+BackgroundTrimmer::Report& BackgroundTrimmer::Report::operator=(Report&&) =
+    default;
+BackgroundTrimmer::Report::~Report() = default;
+
+BackgroundTrimmer::BackgroundTrimmer(const Options& options,
+                                     ReportCallback callback)
+    : options_(options), callback_(std::move(callback)) {
+  WindowList::AddObserver(this);
+  for (NativeWindow* window : WindowList::GetWindows())
+    window_observations_.AddObservation(window);
+  Browser::Get()->AddObserver(this);
+
+  if (!options_.idle_time.is_zero()) {
+    // Unretained is safe as |idle_timer_| is owned by |this|.
+    idle_timer_.Start(
+        FROM_HERE, std::min(options_.idle_time, base::Seconds(10)),
+        base::BindRepeating(&BackgroundTrimmer::CheckIdle,
+                            base::Unretained(this)));
+  }
+  UpdateWindowsHidden();
+}
+
+BackgroundTrimmer::~BackgroundTrimmer() {
+  Browser::Get()->RemoveObserver(this);
+  WindowList::RemoveObserver(this);
+}
+
+// static
+void BackgroundTrimmer::Trim(Reason reason,
+                             base::OnceCallback<void(Report)> done) {
+  // Only the footprints of the processes are needed, not the allocators.
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump(
+          {}, base::BindOnce(&OnDumpBeforeTrim, reason, std::move(done)));
+}
+
+void BackgroundTrimmer::OnWindowAdded(NativeWindow* window) {
+  window_observations_.AddObservation(window);
+  UpdateWindowsHidden();
+}
+
+void BackgroundTrimmer::OnWindowRemoved(NativeWindow* window) {
+  if (window_observations_.IsObservingSource(window))
+    window_observations_.RemoveObservation(window);
+  UpdateWindowsHidden();
+}
+
+void BackgroundTrimmer::OnWindowShow() {
+  UpdateWindowsHidden();
+}
+
+void BackgroundTrimmer::OnWindowHide() {
+  UpdateWindowsHidden();
+}
+
+void BackgroundTrimmer::OnWindowMinimize() {
+  UpdateWindowsHidden();
+}
+
+void BackgroundTrimmer::OnWindowRestore() {
+  UpdateWindowsHidden();
+}
+
+#if BUILDFLAG(IS_MAC)
+void BackgroundTrimmer::OnDidHide() {
+  // Hiding the app doesn't hide its windows, it is in the background as
+  // soon as it is hidden.
+  hidden_timer_.Stop();
+  if (!trimmed_while_hidden_)
+    TrimInBackground(Reason::kAppHidden);
+}
+
+void BackgroundTrimmer::OnDidUnhide() {
+  trimmed_while_hidden_ = false;
+  UpdateWindowsHidden();
+}
+#endif
+
+void BackgroundTrimmer::UpdateWindowsHidden() {
+  bool all_hidden = true;
+  for (NativeWindow* window : WindowList::GetWindows()) {
+    if (window->IsVisible() && !window->IsMinimized()) {
+      all_hidden = false;
+      break;
+    }
+  }
+  if (!all_hidden) {
+    hidden_timer_.Stop();
+    trimmed_while_hidden_ = false;
+    return;
+  }
+  if (trimmed_while_hidden_ || hidden_timer_.IsRunning())
+    return;
+  // Unretained is safe as |hidden_timer_| is owned by |this|.
+  hidden_timer_.Start(
+      FROM_HERE, options_.delay,
+      base::BindOnce(&BackgroundTrimmer::TrimInBackground,
+                     base::Unretained(this), Reason::kWindowsHidden));
+}
+
+void BackgroundTrimmer::CheckIdle() {
+  if (ui::CalculateIdleTime() < options_.idle_time.InSeconds()) {
+    trimmed_while_idle_ = false;
+    return;
+  }
+  if (!trimmed_while_idle_) {
+    trimmed_while_idle_ = true;
+    Trim(Reason::kIdle, base::BindOnce(&BackgroundTrimmer::OnTrimmed,
+                                       weak_factory_.GetWeakPtr()));
+  }
+}
+
+void BackgroundTrimmer::TrimInBackground(Reason reason) {
+  trimmed_while_hidden_ = true;
+  Trim(reason, base::BindOnce(&BackgroundTrimmer::OnTrimmed,
+                              weak_factory_.GetWeakPtr()));
+}
+
+void BackgroundTrimmer::OnTrimmed(Report report) {
+  callback_.Run(report);
+}
+
+}  // namespace electron::api
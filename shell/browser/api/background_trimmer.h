@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_BACKGROUND_TRIMMER_H_
+#define ELECTRON_SHELL_BROWSER_API_BACKGROUND_TRIMMER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/scoped_multi_source_observation.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "build/build_config.h"
+#include "shell/browser/browser_observer.h"
+#include "shell/browser/native_window.h"
+#include "shell/browser/native_window_observer.h"
+#include "shell/browser/window_list_observer.h"
+
+namespace electron::api {
+
+// Trims the memory of the whole app once it is in the background: when all
+// its windows have been hidden or minimized for a while, when the app is
+// hidden on macOS, or when the user has been idle for long enough. Each
+// trim asks the renderers to purge their caches and collect their V8 heap,
+// collects the heap of the main process, purges its allocator, evicts the
+// frames kept for hidden windows, and trims the working sets on Windows. An
+// app only gets trimmed once per background period.
+class BackgroundTrimmer : private WindowListObserver,
+                          private NativeWindowObserver,
+                          private BrowserObserver {
+ public:
+  enum class Reason {
+    kManual,
+    kWindowsHidden,
+    kAppHidden,
+    kIdle,
+  };
+
+  // The sizes are private footprints in KB.
+  struct ProcessReport {
+    base::ProcessId pid = base::kNullProcessId;
+    std::string type;
+    uint64_t before = 0;
+    uint64_t after = 0;
+  };
+
+  struct Report {
+    Report();
+    Report(Report&&);
+    Report& operator=(Report&&);
+    ~Report();
+
+    Reason reason = Reason::kManual;
+    std::vector<ProcessReport> processes;
+  };
+
+  struct Options {
+    // How long all the windows have to stay hidden before the app is trimmed.
+    base::TimeDelta delay = base::Seconds(10);
+    // How long the user has to be idle before the app is trimmed, zero to
+    // not trim on idle.
+    base::TimeDelta idle_time;
+  };
+
+  using ReportCallback = base::RepeatingCallback<void(const Report& report)>;
+
+  BackgroundTrimmer(const Options& options, ReportCallback callback);
+  ~BackgroundTrimmer() override;
+
+  // disable copy
+  BackgroundTrimmer(const BackgroundTrimmer&) = delete;
+  BackgroundTrimmer& operator=(const BackgroundTrimmer&) = delete;
+
+  // Trims the app right away, |done| gets the footprints of its processes
+  // before and after.
+  static void Trim(Reason reason, base::OnceCallback<void(Report)> done);
+
+ private:
+  // WindowListObserver:
+  void OnWindowAdded(NativeWindow* window) override;
+  void OnWindowRemoved(NativeWindow* window) override;
+
+  // NativeWindowObserver:
+  void OnWindowShow() override;
+  void OnWindowHide() override;
+  void OnWindowMinimize() override;
+  void OnWindowRestore() override;
+
+#if BUILDFLAG(IS_MAC)
+  // BrowserObserver:
+  void OnDidHide() override;
+  void OnDidUnhide() override;
+#endif
+
+  void UpdateWindowsHidden();
+  void CheckIdle();
+  void TrimInBackground(Reason reason);
+  void OnTrimmed(Report report);
+
+  const Options options_;
+  const ReportCallback callback_;
+
+  // Whether the app was trimmed since its windows were last shown, or since
+  // the user was last active.
+  bool trimmed_while_hidden_ = false;
+  bool trimmed_while_idle_ = false;
+  base::OneShotTimer hidden_timer_;
+  base::RepeatingTimer idle_timer_;
+
+  base::ScopedMultiSourceObservation<NativeWindow, NativeWindowObserver>
+      window_observations_{this};
+
+  base::WeakPtrFactory<BackgroundTrimmer> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_BACKGROUND_TRIMMER_H_
@@ -0,0 +1,108 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/crash_upload_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/task/thread_pool.h"
+#include "components/crash/core/app/crashpad.h"  // nogncheck
+#include "content/public/browser/network_service_instance.h"
+#include "net/base/network_change_notifier.h"
+#include "services/network/public/cpp/network_connection_tracker.h"
+#include "ui/base/idle/idle.h"
+
+namespace electron::api {
+
+namespace {
+
+// Requests the upload of the most recent reports which haven't been
+// uploaded, up to |budget| of them, and returns how many were.
+size_t RequestUploads(size_t budget, base::TimeDelta max_report_age) {
+  std::vector<crash_reporter::Report> reports;
+  crash_reporter::GetReports(&reports);
+  const time_t oldest = (base::Time::Now() - max_report_age).ToTimeT();
+  std::vector<const crash_reporter::Report*> pending;
+  for (const auto& report : reports) {
+    if (report.state == crash_reporter::ReportUploadState::NotUploaded &&
+        report.capture_time >= oldest) {
+      pending.push_back(&report);
+    }
+  }
+  std::sort(pending.begin(), pending.end(), [](const auto* a, const auto* b) {
+    return a->capture_time > b->capture_time;
+  });
+  const size_t count = std::min(budget, pending.size());
+  for (size_t i = 0; i < count; ++i)
+    crash_reporter::RequestSingleCrashUpload(pending[i]->local_id);
+  return count;
+}
+
+}  // namespace
+
+CrashUploadScheduler::CrashUploadScheduler(const Options& options)
+    : options_(options) {
+  // Unretained is safe as |timer_| is owned by |this|.
+  timer_.Start(FROM_HERE, options_.interval,
+               base::BindRepeating(&CrashUploadScheduler::CheckForUploads,
+                                   base::Unretained(this)));
+}
+
+CrashUploadScheduler::~CrashUploadScheduler() = default;
+
+void CrashUploadScheduler::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+void CrashUploadScheduler::CheckForUploads() {
+  if (!enabled_ || checking_)
+    return;
+  if (ui::CalculateIdleTime() < options_.idle_time.InSeconds())
+    return;
+  if (!IsConnectionAllowed())
+    return;
+
+  const base::TimeTicks hour_ago = base::TimeTicks::Now() - base::Hours(1);
+  while (!recent_uploads_.empty() && recent_uploads_.front() < hour_ago)
+    recent_uploads_.pop_front();
+  if (recent_uploads_.size() >= options_.max_uploads_per_hour)
+    return;
+
+  checking_ = true;
+  // The crashpad database is read and written from the disk.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&RequestUploads,
+                     options_.max_uploads_per_hour - recent_uploads_.size(),
+                     options_.max_report_age),
+      base::BindOnce(&CrashUploadScheduler::OnUploadsRequested,
+                     weak_factory_.GetWeakPtr()));
+}
+
+bool CrashUploadScheduler::IsConnectionAllowed() const {
+  network::NetworkConnectionTracker* tracker =
+      content::GetNetworkConnectionTracker();
+  auto type = network::mojom::ConnectionType::CONNECTION_UNKNOWN;
+  // The type isn't known until the network service replied, which the next
+  // check gets.
+  if (!tracker || !tracker->GetConnectionType(&type, base::DoNothing()))
+    return false;
+  if (type == network::mojom::ConnectionType::CONNECTION_NONE)
+    return false;
+  return options_.allow_cellular ||
+         !net::NetworkChangeNotifier::IsConnectionCellular(
+             static_cast<net::NetworkChangeNotifier::ConnectionType>(type));
+}
+
+void CrashUploadScheduler::OnUploadsRequested(size_t count) {
+  checking_ = false;
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (size_t i = 0; i < count; ++i)
+    recent_uploads_.push_back(now);
+}
+
+}  // namespace electron::api
@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_CRASH_UPLOAD_SCHEDULER_H_
+#define ELECTRON_SHELL_BROWSER_API_CRASH_UPLOAD_SCHEDULER_H_
+
+#include <cstddef>
+
+#include "base/containers/circular_deque.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron::api {
+
+// Uploads the crash reports in batches, for the uploadSchedule option of
+// crashReporter.start(), instead of the crashpad handler uploading each
+// report as soon as it is written. The handler is told to not upload the
+// reports by itself, and the reports it hasn't uploaded are requested for
+// upload one by one when the user is idle, the connection isn't cellular,
+// and the hourly budget of uploads isn't spent. Requested uploads aren't
+// subject to the consent nor to the rate limit of the handler.
+class CrashUploadScheduler {
+ public:
+  struct Options {
+    // How often the reports to upload are looked for.
+    base::TimeDelta interval = base::Minutes(5);
+    // How long the user has to be idle before reports are uploaded.
+    base::TimeDelta idle_time = base::Minutes(1);
+    size_t max_uploads_per_hour = 10;
+    bool allow_cellular = false;
+    // The reports older than this are left alone.
+    base::TimeDelta max_report_age = base::Days(7);
+  };
+
+  explicit CrashUploadScheduler(const Options& options);
+  ~CrashUploadScheduler();
+
+  // disable copy
+  CrashUploadScheduler(const CrashUploadScheduler&) = delete;
+  CrashUploadScheduler& operator=(const CrashUploadScheduler&) = delete;
+
+  // Whether the reports are uploaded, as crashReporter.setUploadToServer().
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return enabled_; }
+
+ private:
+  void CheckForUploads();
+  bool IsConnectionAllowed() const;
+  void OnUploadsRequested(size_t count);
+
+  const Options options_;
+  bool enabled_ = false;
+  bool checking_ = false;
+
+  // The times of the uploads requested in the last hour.
+  base::circular_deque<base::TimeTicks> recent_uploads_;
+
+  base::RepeatingTimer timer_;
+
+  base::WeakPtrFactory<CrashUploadScheduler> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_CRASH_UPLOAD_SCHEDULER_H_
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -11,16 +12,23 @@
 
 #include "base/command_line.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/containers/span.h"
+#include "base/barrier_callback.h"
 #include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/json/json_writer.h"
 #include "base/path_service.h"
+#include "base/ranges/algorithm.h"
 #include "base/system/sys_info.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
-#include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_features.h"
 #include "chrome/common/chrome_paths.h"
 #include "content/browser/gpu/compositor_util.h"        // nogncheck
@@ -32,8 +40,10 @@
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/common/content_switches.h"
 #include "crypto/crypto_buildflags.h"
+#include "gin/data_object_builder.h"
 #include "media/audio/audio_manager.h"
 #include "net/dns/public/dns_over_https_config.h"
 #include "net/dns/public/dns_over_https_server_config.h"
@@ -43,7 +53,10 @@
 #include "net/ssl/ssl_private_key.h"
 #include "sandbox/policy/switches.h"
 #include "services/network/network_service.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/app/command_line_args.h"
+#include "shell/browser/allocator_monitor.h"
 #include "shell/browser/api/electron_api_menu.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_utility_process.h"
@@ -52,10 +65,15 @@
 #include "shell/browser/browser_process_impl.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/event_loop_monitor.h"
+#include "shell/browser/flight_recorder.h"
+#include "shell/browser/heap_attribution.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/login_handler.h"
 #include "shell/browser/relauncher.h"
+#include "shell/browser/structured_log.h"
 #include "shell/common/application_info.h"
+#include "shell/common/decoded_image_cache.h"
 #include "shell/common/electron_command_line.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_converters/base_converter.h"
@@ -65,13 +83,17 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/optional_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/record.h"
 #include "shell/common/language_util.h"
+#include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -91,6 +113,108 @@ using electron::Browser;
 
 namespace gin {
 
+template <>
+struct Converter<electron::api::BackgroundMemoryPolicy::Action> {
+  using Action = electron::api::BackgroundMemoryPolicy::Action;
+
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     Action* out) {
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, Action val) {
+    for (const auto& [name, action_val] : Lookup)
+      if (action_val == val)
+        return gin::ConvertToV8(isolate, name);
+
+    return gin::ConvertToV8(isolate, "");
+  }
+
+ private:
+  static constexpr auto Lookup =
+      base::MakeFixedFlatMapSorted<base::StringPiece, Action>({
+          {"close", Action::kClose},
+          {"discard", Action::kDiscard},
+          {"freeze", Action::kFreeze},
+          {"reduce", Action::kReduce},
+      });
+};
+
+template <>
+struct Converter<electron::api::BackgroundTrimmer::Reason> {
+  using Reason = electron::api::BackgroundTrimmer::Reason;
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, Reason val) {
+    switch (val) {
+      case Reason::kManual:
+        return StringToV8(isolate, "manual");
+      case Reason::kWindowsHidden:
+        return StringToV8(isolate, "windows-hidden");
+      case Reason::kAppHidden:
+        return StringToV8(isolate, "app-hidden");
+      case Reason::kIdle:
+        return StringToV8(isolate, "idle");
+    }
+  }
+};
+
+template <>
+struct Converter<electron::api::BackgroundTrimmer::Report> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::BackgroundTrimmer::Report& val) {
+    std::vector<v8::Local<v8::Value>> processes;
+    for (const auto& process : val.processes) {
+      processes.push_back(
+          gin::DataObjectBuilder(isolate)
+              .Set("pid", static_cast<int>(process.pid))
+              .Set("type", process.type)
+              .Set("before", static_cast<double>(process.before))
+              .Set("after", static_cast<double>(process.after))
+              .Set("reclaimed",
+                   static_cast<double>(process.before > process.after
+                                           ? process.before - process.after
+                                           : 0))
+              .Build());
+    }
+    return gin::DataObjectBuilder(isolate)
+        .Set("reason", val.reason)
+        .Set("processes", processes)
+        .Build();
+  }
+};
+
+template <>
+struct Converter<electron::api::HangWatchdog::Source> {
+  using Source = electron::api::HangWatchdog::Source;
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, Source val) {
+    switch (val) {
+      case Source::kMainThread:
+        return StringToV8(isolate, "main-thread");
+      case Source::kUvLoop:
+        return StringToV8(isolate, "uv-loop");
+    }
+  }
+};
+
+template <>
+struct Converter<electron::api::HangWatchdog::Hang> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::HangWatchdog::Hang& val) {
+    gin::DataObjectBuilder builder(isolate);
+    builder.Set("source", val.source)
+        .Set("startTime", val.start_time.ToJsTime())
+        .Set("duration", val.duration.InMillisecondsF())
+        .Set("jsStack", val.js_stack);
+    if (!val.report_path.empty())
+      builder.Set("reportPath", val.report_path);
+    return builder.Build();
+  }
+};
+
 #if BUILDFLAG(IS_WIN)
 template <>
 struct Converter<electron::ProcessIntegrityLevel> {
@@ -431,6 +555,15 @@ IconLoader::IconSize GetIconSizeByString(const std::string& size) {
   return IconLoader::IconSize::NORMAL;
 }
 
+IconLoader::IconSize GetIconSizeFromOptions(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options))
+    return IconLoader::IconSize::NORMAL;
+  std::string icon_size_string;
+  options.Get("size", &icon_size_string);
+  return GetIconSizeByString(icon_size_string);
+}
+
 // Return the path constant from string.
 constexpr int GetPathConstant(base::StringPiece name) {
   // clang-format off
@@ -466,6 +599,22 @@ constexpr int GetPathConstant(base::StringPiece name) {
   return iter != Lookup.end() ? iter->second : -1;
 }
 
+// requestSingleInstanceLockAsync() sends the bytes of typed arrays as they
+// are, after this tag. Structured clones start with 0xFF instead.
+constexpr uint8_t kRawAdditionalDataTag = 0x00;
+
+v8::Local<v8::Value> AdditionalDataToV8(v8::Isolate* isolate,
+                                        base::span<const uint8_t> data) {
+  if (!data.empty() && data.front() == kRawAdditionalDataTag) {
+    data = data.subspan(1);
+    return node::Buffer::Copy(isolate,
+                              reinterpret_cast<const char*>(data.data()),
+                              data.size())
+        .ToLocalChecked();
+  }
+  return DeserializeV8Value(isolate, data);
+}
+
 bool NotificationCallbackWrapper(
     const base::RepeatingCallback<
         void(const base::CommandLine& command_line,
@@ -579,6 +728,74 @@ int ImportIntoCertStore(CertificateManagerModel* model, base::Value options) {
 }
 #endif
 
+std::unique_ptr<base::ProcessMetrics> CreateProcessMetrics(
+    int process_type,
+    base::ProcessHandle handle) {
+  if (process_type == content::PROCESS_TYPE_BROWSER)
+    return base::ProcessMetrics::CreateCurrentProcessMetrics();
+#if BUILDFLAG(IS_MAC)
+  return base::ProcessMetrics::CreateProcessMetrics(
+      handle, content::BrowserChildProcessHost::GetPortProvider());
+#else
+  return base::ProcessMetrics::CreateProcessMetrics(handle);
+#endif
+}
+
+// base::ProcessMetrics computes the CPU usage since its previous call, so
+// every user needs its own.
+std::unique_ptr<electron::ProcessMetric> CopyProcessMetric(
+    const electron::ProcessMetric& metric) {
+  base::ProcessHandle handle = metric.process.Handle();
+  return std::make_unique<electron::ProcessMetric>(
+      metric.type, handle, CreateProcessMetrics(metric.type, handle),
+      metric.service_name, metric.name);
+}
+
+// The renderers, by RenderProcessHost id, whose pages are all frozen.
+base::flat_set<int> GetFrozenRenderers() {
+  base::flat_map<int, bool> all_frozen;
+  for (WebContents* web_contents : WebContents::GetAll()) {
+    content::WebContents* contents = web_contents->web_contents();
+    if (!contents ||
+        web_contents->lifecycle_state() ==
+            WebContents::LifecycleState::kDiscarded) {
+      continue;
+    }
+    const int id = contents->GetPrimaryMainFrame()->GetProcess()->GetID();
+    const bool frozen = web_contents->lifecycle_state() ==
+                        WebContents::LifecycleState::kFrozen;
+    auto [it, inserted] = all_frozen.emplace(id, frozen);
+    if (!inserted)
+      it->second &= frozen;
+  }
+
+  base::flat_set<int> frozen_renderers;
+  for (const auto& [id, frozen] : all_frozen) {
+    if (frozen)
+      frozen_renderers.insert(id);
+  }
+  return frozen_renderers;
+}
+
+// The allocators reported by app.getProcessMemoryDetails(), with the names
+// of their memory-infra dumps.
+struct MemoryAllocatorDump {
+  const char* dump_name;
+  const char* name;
+};
+
+constexpr MemoryAllocatorDump kMemoryAllocatorDumps[] = {
+    {"partition_alloc/partitions", "partitionAlloc"},
+    {"malloc", "malloc"},
+    {"v8", "v8"},
+    {"blink_gc", "blinkGC"},
+    {"web_cache", "blinkCaches"},
+    {"font_caches", "fontCaches"},
+    {"cc/resource_memory", "compositor"},
+    {"gpu/gl", "gpu"},
+    {"skia", "skia"},
+};
+
 void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
                          gfx::Image icon) {
   if (!icon.IsEmpty()) {
@@ -588,6 +805,32 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+void OnIconsDataAvailable(
+    gin_helper::Promise<std::vector<absl::optional<gfx::Image>>> promise,
+    size_t count,
+    std::vector<std::pair<size_t, gfx::Image>> icons) {
+  // The icons arrive in the order their loads finished.
+  std::vector<absl::optional<gfx::Image>> result(count);
+  for (auto& [index, icon] : icons) {
+    if (!icon.IsEmpty())
+      result[index] = std::move(icon);
+  }
+  promise.Resolve(result);
+}
+
+// The fields of app.getAppMetrics() entries that every process has.
+gin_helper::RecordTemplate kProcessMetricTemplate(
+    {"cpu", "pid", "type", "creationTime"});
+gin_helper::RecordTemplate kCPUUsageTemplate(
+    {"percentCPUUsage", "idleWakeupsPerSecond"});
+#if BUILDFLAG(IS_WIN)
+gin_helper::RecordTemplate kMemoryInfoTemplate(
+    {"workingSetSize", "peakWorkingSetSize", "privateBytes"});
+#elif !BUILDFLAG(IS_LINUX)
+gin_helper::RecordTemplate kMemoryInfoTemplate(
+    {"workingSetSize", "peakWorkingSetSize"});
+#endif
+
 }  // namespace
 
 App::App() {
@@ -598,7 +841,8 @@ App::App() {
   auto pid = content::ChildProcessHost::kInvalidUniqueID;
   auto process_metric = std::make_unique<electron::ProcessMetric>(
       content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
-      base::ProcessMetrics::CreateCurrentProcessMetrics());
+      CreateProcessMetrics(content::PROCESS_TYPE_BROWSER,
+                           base::GetCurrentProcessHandle()));
   app_metrics_[pid] = std::move(process_metric);
 }
 
@@ -634,6 +878,8 @@ void App::OnQuit() {
     process_singleton_->Cleanup();
     process_singleton_.reset();
   }
+  pending_process_singleton_.reset();
+  async_process_singleton_.reset();
 }
 
 void App::OnOpenFile(bool* prevent_default, const std::string& file_path) {
@@ -665,8 +911,11 @@ void App::OnFinishLaunching(base::Value::Dict launch_info) {
 
 void App::OnPreMainMessageLoopRun() {
   content::BrowserChildProcessObserver::Add(this);
-  if (process_singleton_ && watch_singleton_socket_on_ready_) {
-    process_singleton_->StartWatching();
+  if (watch_singleton_socket_on_ready_) {
+    if (process_singleton_)
+      process_singleton_->StartWatching();
+    if (async_process_singleton_)
+      async_process_singleton_->StartWatching();
     watch_singleton_socket_on_ready_ = false;
   }
 }
@@ -865,6 +1114,8 @@ void App::BrowserChildProcessKilled(
 void App::BrowserChildProcessCrashedOrKilled(
     const content::ChildProcessData& data,
     const content::ChildProcessTerminationInfo& info) {
+  FlightRecorder::GetInstance()->OnTrigger(FlightRecorder::Trigger::kCrash);
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   auto details = gin_helper::Dictionary::CreateEmpty(isolate);
@@ -898,18 +1149,20 @@ void App::ChildProcessLaunched(int process_type,
                                base::ProcessHandle handle,
                                const std::string& service_name,
                                const std::string& name) {
-#if BUILDFLAG(IS_MAC)
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
-      handle, content::BrowserChildProcessHost::GetPortProvider());
-#else
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
-#endif
-  app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
-      process_type, handle, std::move(metrics), service_name, name);
+  auto& process_metric = app_metrics_[pid];
+  process_metric = std::make_unique<electron::ProcessMetric>(
+      process_type, handle, CreateProcessMetrics(process_type, handle),
+      service_name, name);
+  if (metrics_sampler_) {
+    metrics_sampler_.AsyncCall(&AppMetricsSampler::AddProcess)
+        .WithArgs(pid, CopyProcessMetric(*process_metric));
+  }
 }
 
 void App::ChildProcessDisconnected(int pid) {
   app_metrics_.erase(pid);
+  if (metrics_sampler_)
+    metrics_sampler_.AsyncCall(&AppMetricsSampler::RemoveProcess).WithArgs(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1057,12 +1310,12 @@ void App::OnSecondInstance(const base::CommandLine& cmd,
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   v8::Local<v8::Value> data_value =
-      DeserializeV8Value(isolate, std::move(additional_data));
+      AdditionalDataToV8(isolate, std::move(additional_data));
   Emit("second-instance", cmd.argv(), cwd, data_value);
 }
 
 bool App::HasSingleInstanceLock() const {
-  if (process_singleton_)
+  if (process_singleton_ || async_process_singleton_)
     return true;
   return false;
 }
@@ -1070,6 +1323,10 @@ bool App::HasSingleInstanceLock() const {
 bool App::RequestSingleInstanceLock(gin::Arguments* args) {
   if (HasSingleInstanceLock())
     return true;
+  if (pending_process_singleton_) {
+    args->ThrowError("The single instance lock is already being requested");
+    return false;
+  }
 
   std::string program_name = electron::Browser::Get()->GetName();
 
@@ -1112,11 +1369,99 @@ bool App::RequestSingleInstanceLock(gin::Arguments* args) {
   }
 }
 
+v8::Local<v8::Promise> App::RequestSingleInstanceLockAsync(
+    gin::Arguments* args) {
+  gin_helper::Promise<bool> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (HasSingleInstanceLock()) {
+    promise.Resolve(true);
+    return handle;
+  }
+  if (pending_process_singleton_) {
+    promise.RejectWithErrorMessage(
+        "The single instance lock is already being requested");
+    return handle;
+  }
+
+  std::vector<uint8_t> additional_data;
+  v8::Local<v8::Value> data_value;
+  if (args->GetNext(&data_value) && !data_value->IsUndefined()) {
+    if (data_value->IsArrayBufferView()) {
+      auto view = data_value.As<v8::ArrayBufferView>();
+      additional_data.resize(1 + view->ByteLength());
+      additional_data[0] = kRawAdditionalDataTag;
+      view->CopyContents(additional_data.data() + 1, view->ByteLength());
+    } else {
+      blink::CloneableMessage message;
+      if (!gin::ConvertFromV8(args->isolate(), data_value, &message)) {
+        promise.RejectWithErrorMessage(
+            "additionalData could not be serialized");
+        return handle;
+      }
+      additional_data.assign(message.encoded_message.begin(),
+                             message.encoded_message.end());
+    }
+  }
+
+  base::FilePath user_dir;
+  base::PathService::Get(chrome::DIR_USER_DATA, &user_dir);
+#if BUILDFLAG(IS_WIN)
+  bool app_is_sandboxed =
+      IsSandboxEnabled(base::CommandLine::ForCurrentProcess());
+#else
+  bool app_is_sandboxed = false;
+#endif
+
+  pending_process_singleton_ = std::make_unique<AsyncProcessSingleton>(
+      electron::Browser::Get()->GetName(), user_dir,
+      std::move(additional_data), app_is_sandboxed,
+      base::BindRepeating(
+          [](App* app, const base::CommandLine& cmd, const base::FilePath& cwd,
+             std::vector<uint8_t> additional_data) {
+            NotificationCallbackWrapper(
+                base::BindRepeating(&App::OnSecondInstance,
+                                    base::Unretained(app)),
+                cmd, cwd,
+                std::vector<const uint8_t>(additional_data.begin(),
+                                           additional_data.end()));
+          },
+          base::Unretained(this)));
+  pending_process_singleton_->NotifyOtherProcessOrCreate(
+      base::BindOnce(&App::OnSingleInstanceLockResult, base::Unretained(this),
+                     std::move(promise)));
+  return handle;
+}
+
+void App::OnSingleInstanceLockResult(gin_helper::Promise<bool> promise,
+                                     ProcessSingleton::NotifyResult result) {
+  // The lock was released in the meantime.
+  if (!pending_process_singleton_) {
+    promise.Resolve(false);
+    return;
+  }
+
+  auto process_singleton = std::move(pending_process_singleton_);
+  if (result != ProcessSingleton::NotifyResult::PROCESS_NONE) {
+    promise.Resolve(false);
+    return;
+  }
+
+  if (content::BrowserThread::IsThreadInitialized(content::BrowserThread::IO))
+    process_singleton->StartWatching();
+  else
+    watch_singleton_socket_on_ready_ = true;
+  async_process_singleton_ = std::move(process_singleton);
+  promise.Resolve(true);
+}
+
 void App::ReleaseSingleInstanceLock() {
   if (process_singleton_) {
     process_singleton_->Cleanup();
     process_singleton_.reset();
   }
+  pending_process_singleton_.reset();
+  async_process_singleton_.reset();
 }
 
 bool App::Relaunch(gin::Arguments* js_args) {
@@ -1311,28 +1656,35 @@ v8::Local<v8::Promise> App::GetFileIcon(const base::FilePath& path,
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   gin_helper::Promise<gfx::Image> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
-  base::FilePath normalized_path = path.NormalizePathSeparators();
-
-  IconLoader::IconSize icon_size;
-  gin_helper::Dictionary options;
-  if (!args->GetNext(&options)) {
-    icon_size = IconLoader::IconSize::NORMAL;
-  } else {
-    std::string icon_size_string;
-    options.Get("size", &icon_size_string);
-    icon_size = GetIconSizeByString(icon_size_string);
-  }
+  file_icon_cache_.GetIcon(
+      path.NormalizePathSeparators(), GetIconSizeFromOptions(args),
+      base::BindOnce(&OnIconDataAvailable, std::move(promise)));
+  return handle;
+}
 
-  auto* icon_manager = ElectronBrowserMainParts::Get()->GetIconManager();
-  gfx::Image* icon =
-      icon_manager->LookupIconFromFilepath(normalized_path, icon_size, 1.0f);
-  if (icon) {
-    promise.Resolve(*icon);
-  } else {
-    icon_manager->LoadIcon(
-        normalized_path, icon_size, 1.0f,
-        base::BindOnce(&OnIconDataAvailable, std::move(promise)),
-        &cancelable_task_tracker_);
+v8::Local<v8::Promise> App::GetFileIcons(
+    const std::vector<base::FilePath>& paths,
+    gin::Arguments* args) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  gin_helper::Promise<std::vector<absl::optional<gfx::Image>>> promise(
+      isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  const IconLoader::IconSize icon_size = GetIconSizeFromOptions(args);
+
+  // Runs right away when |paths| is empty.
+  auto barrier = base::BarrierCallback<std::pair<size_t, gfx::Image>>(
+      paths.size(), base::BindOnce(&OnIconsDataAvailable, std::move(promise),
+                                   paths.size()));
+  for (size_t i = 0; i < paths.size(); ++i) {
+    file_icon_cache_.GetIcon(
+        paths[i].NormalizePathSeparators(), icon_size,
+        base::BindOnce(
+            [](base::RepeatingCallback<void(std::pair<size_t, gfx::Image>)>
+                   barrier,
+               size_t index, gfx::Image icon) {
+              barrier.Run({index, std::move(icon)});
+            },
+            barrier, i));
   }
   return handle;
 }
@@ -1341,10 +1693,11 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   std::vector<gin_helper::Dictionary> result;
   result.reserve(app_metrics_.size());
   int processor_count = base::SysInfo::NumberOfProcessors();
+  const base::flat_set<int> frozen_renderers = GetFrozenRenderers();
 
   for (const auto& process_metric : app_metrics_) {
-    gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
-    gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+    gin_helper::Dictionary pid_dict = kProcessMetricTemplate.NewRecord(isolate);
+    gin_helper::Dictionary cpu_dict = kCPUUsageTemplate.NewRecord(isolate);
 
     pid_dict.SetHidden("simple", true);
     cpu_dict.SetHidden("simple", true);
@@ -1381,7 +1734,7 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
 #if !BUILDFLAG(IS_LINUX)
     auto memory_info = process_metric.second->GetMemoryInfo();
 
-    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
+    gin_helper::Dictionary memory_dict = kMemoryInfoTemplate.NewRecord(isolate);
     memory_dict.SetHidden("simple", true);
     memory_dict.Set("workingSetSize",
                     static_cast<double>(memory_info.working_set_size >> 10));
@@ -1397,6 +1750,37 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
     pid_dict.Set("memory", memory_dict);
 #endif
 
+    if (process_metric.second->type == content::PROCESS_TYPE_RENDERER) {
+      pid_dict.Set("lifecycleState",
+                   frozen_renderers.contains(process_metric.first)
+                       ? "frozen"
+                       : "active");
+    }
+
+    if (process_metric.second->type == content::PROCESS_TYPE_BROWSER) {
+      const NodeBindings::UvLoopMetrics& uv_metrics =
+          ElectronBrowserMainParts::Get()->node_bindings()->uv_loop_metrics();
+      gin_helper::Dictionary uv_dict = gin::Dictionary::CreateEmpty(isolate);
+      uv_dict.SetHidden("simple", true);
+      uv_dict.Set("uvTime", uv_metrics.uv_time.InMillisecondsF());
+      uv_dict.Set("taskTime", uv_metrics.task_time.InMillisecondsF());
+      uv_dict.Set("runs", static_cast<double>(uv_metrics.runs));
+      uv_dict.Set("overBudgetRuns",
+                  static_cast<double>(uv_metrics.over_budget_runs));
+      pid_dict.Set("uvLoop", uv_dict);
+
+      if (auto* image_cache = DecodedImageCache::Get()) {
+        gin_helper::Dictionary image_cache_dict =
+            gin::Dictionary::CreateEmpty(isolate);
+        image_cache_dict.SetHidden("simple", true);
+        image_cache_dict.Set("entries",
+                             static_cast<int>(image_cache->entry_count()));
+        image_cache_dict.Set(
+            "memory", static_cast<double>(image_cache->GetMemoryUsage() >> 10));
+        pid_dict.Set("imageCache", image_cache_dict);
+      }
+    }
+
 #if BUILDFLAG(IS_MAC)
     pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
 #elif BUILDFLAG(IS_WIN)
@@ -1412,6 +1796,607 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+v8::Local<v8::Promise> App::GetProcessMemoryDetails(v8::Isolate* isolate) {
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!Browser::Get()->is_ready()) {
+    promise.RejectWithErrorMessage(
+        "Memory details are available only after app ready");
+    return handle;
+  }
+
+  std::vector<std::string> dump_names;
+  for (const MemoryAllocatorDump& allocator : kMemoryAllocatorDumps)
+    dump_names.emplace_back(allocator.dump_name);
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump(
+          dump_names, base::BindOnce(&App::OnProcessMemoryDump,
+                                     weak_factory_.GetWeakPtr(),
+                                     std::move(promise)));
+  return handle;
+}
+
+void App::OnProcessMemoryDump(
+    gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to create memory dump");
+    return;
+  }
+
+  std::map<base::ProcessId, const ProcessMetric*> processes;
+  for (const auto& [id, process_metric] : app_metrics_)
+    processes[process_metric->process.Pid()] = process_metric.get();
+
+  std::vector<gin_helper::Dictionary> result;
+  for (const memory_instrumentation::GlobalMemoryDump::ProcessDump&
+           process_dump : dump->process_dumps()) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("pid", process_dump.pid());
+    auto it = processes.find(process_dump.pid());
+    if (it != processes.end()) {
+      dict.Set("type", content::GetProcessTypeNameInEnglish(it->second->type));
+      if (!it->second->service_name.empty())
+        dict.Set("serviceName", it->second->service_name);
+      if (!it->second->name.empty())
+        dict.Set("name", it->second->name);
+    } else {
+      dict.Set("type", content::GetProcessTypeNameInEnglish(
+                           content::PROCESS_TYPE_UNKNOWN));
+    }
+
+    const auto& os_dump = process_dump.os_dump();
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_WIN)
+    dict.Set("residentSet", os_dump.resident_set_kb);
+#endif
+    dict.Set("private", os_dump.private_footprint_kb);
+    dict.Set("shared", os_dump.shared_footprint_kb);
+
+    // Allocators the process doesn't use are left out.
+    auto allocators = gin_helper::Dictionary::CreateEmpty(isolate);
+    for (const MemoryAllocatorDump& allocator : kMemoryAllocatorDumps) {
+      absl::optional<uint64_t> size =
+          process_dump.GetMetric(allocator.dump_name, "effective_size");
+      if (size)
+        allocators.Set(allocator.name, static_cast<double>(*size >> 10));
+    }
+    dict.Set("allocators", allocators);
+    result.push_back(dict);
+  }
+  promise.Resolve(result);
+}
+
+void App::SetBackgroundMemoryPolicy(gin::Arguments* args) {
+  v8::Local<v8::Value> first = args->PeekNext();
+  if (!first.IsEmpty() && first->IsNull()) {
+    background_memory_policy_.reset();
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an object or null");
+    return;
+  }
+
+  BackgroundMemoryPolicy::Options policy;
+  double hidden_time = policy.hidden_time.InMillisecondsF();
+  double check_interval = policy.check_interval.InMillisecondsF();
+  double footprint_limit = 0;
+  options.Get("hiddenTime", &hidden_time);
+  options.Get("checkInterval", &check_interval);
+  options.Get("footprintLimit", &footprint_limit);
+  if (!(hidden_time >= 0) || !(check_interval >= 1000) ||
+      !(footprint_limit >= 0)) {
+    args->ThrowTypeError(
+        "hiddenTime and footprintLimit must not be negative, checkInterval "
+        "must be at least 1000 milliseconds");
+    return;
+  }
+  v8::Local<v8::Value> actions;
+  if (options.Get("actions", &actions) &&
+      !gin::ConvertFromV8(args->isolate(), actions, &policy.actions)) {
+    args->ThrowTypeError(
+        "actions must only contain 'reduce', 'freeze', 'discard' or 'close'");
+    return;
+  }
+  policy.hidden_time = base::Milliseconds(hidden_time);
+  policy.check_interval = base::Milliseconds(check_interval);
+  policy.footprint_limit = static_cast<uint64_t>(footprint_limit);
+
+  background_memory_policy_ = std::make_unique<BackgroundMemoryPolicy>(
+      policy, base::BindRepeating(&App::OnBackgroundMemoryAction,
+                                  weak_factory_.GetWeakPtr()));
+}
+
+void App::OnBackgroundMemoryAction(WebContents* web_contents,
+                                   BackgroundMemoryPolicy::Action action,
+                                   uint64_t footprint,
+                                   absl::optional<uint64_t> reclaimed) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("webContents", web_contents);
+  details.Set("action", action);
+  details.Set("footprint", static_cast<double>(footprint));
+  if (reclaimed)
+    details.Set("reclaimed", static_cast<double>(*reclaimed));
+  Emit("background-memory-action", details);
+}
+
+void App::SetBackgroundTrimming(gin::Arguments* args) {
+  v8::Local<v8::Value> first = args->PeekNext();
+  if (!first.IsEmpty() && first->IsNull()) {
+    background_trimmer_.reset();
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an object or null");
+    return;
+  }
+
+  BackgroundTrimmer::Options trimming;
+  double delay = trimming.delay.InMillisecondsF();
+  double idle_time = 0;
+  options.Get("delay", &delay);
+  options.Get("idleTime", &idle_time);
+  if (!(delay >= 0) || !(idle_time >= 0)) {
+    args->ThrowTypeError("delay and idleTime must not be negative");
+    return;
+  }
+  trimming.delay = base::Milliseconds(delay);
+  trimming.idle_time = base::Seconds(idle_time);
+
+  // Replacing the trimmer starts over, the app can be trimmed again.
+  background_trimmer_.reset();
+  background_trimmer_ = std::make_unique<BackgroundTrimmer>(
+      trimming,
+      base::BindRepeating(&App::OnBackgroundTrim, weak_factory_.GetWeakPtr()));
+}
+
+void App::OnBackgroundTrim(const BackgroundTrimmer::Report& report) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("background-trim", report);
+}
+
+void App::SetHangDetection(gin::Arguments* args) {
+  v8::Local<v8::Value> first = args->PeekNext();
+  if (!first.IsEmpty() && first->IsNull()) {
+    hang_watchdog_.reset();
+    return;
+  }
+
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an object or null");
+    return;
+  }
+
+  HangWatchdog::Options watchdog;
+  double threshold = watchdog.threshold.InMillisecondsF();
+  options.Get("threshold", &threshold);
+  if (!(threshold >= 100)) {
+    args->ThrowTypeError("threshold must be at least 100 milliseconds");
+    return;
+  }
+  watchdog.threshold = base::Milliseconds(threshold);
+  options.Get("reportDirectory", &watchdog.report_directory);
+  options.Get("dump", &watchdog.dump);
+
+  hang_watchdog_.reset();
+  hang_watchdog_ = std::make_unique<HangWatchdog>(
+      args->isolate(), ElectronBrowserMainParts::Get()->node_bindings(),
+      watchdog, base::BindRepeating(&App::OnHang, weak_factory_.GetWeakPtr()));
+}
+
+void App::OnHang(const HangWatchdog::Hang& hang) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("main-thread-hang", hang);
+}
+
+v8::Local<v8::Value> App::GetHangMetrics(v8::Isolate* isolate) {
+  HangWatchdog::Metrics metrics;
+  if (hang_watchdog_)
+    metrics = hang_watchdog_->metrics();
+  return gin::DataObjectBuilder(isolate)
+      .Set("count", static_cast<double>(metrics.count))
+      .Set("totalDuration", metrics.total_duration.InMillisecondsF())
+      .Set("longestDuration", metrics.longest_duration.InMillisecondsF())
+      .Build();
+}
+
+v8::Local<v8::Promise> App::TrimMemory(v8::Isolate* isolate) {
+  gin_helper::Promise<BackgroundTrimmer::Report> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  BackgroundTrimmer::Trim(
+      BackgroundTrimmer::Reason::kManual,
+      base::BindOnce(
+          [](gin_helper::Promise<BackgroundTrimmer::Report> promise,
+             BackgroundTrimmer::Report report) {
+            promise.Resolve(report);
+          },
+          std::move(promise)));
+  return handle;
+}
+
+void App::StartMetricsSampling(gin::Arguments* args) {
+  double interval_ms = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("interval", &interval_ms);
+  if (!(interval_ms >= 100)) {
+    args->ThrowTypeError("interval must be at least 100 milliseconds");
+    return;
+  }
+
+  latest_metrics_ = AppMetricsSnapshot();
+  metrics_sampler_ = base::SequenceBound<AppMetricsSampler>(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+      base::Milliseconds(interval_ms),
+      base::BindPostTaskToCurrentDefault(base::BindRepeating(
+          &App::OnAppMetricsSampled, weak_factory_.GetWeakPtr())));
+  for (const auto& [id, process_metric] : app_metrics_) {
+    metrics_sampler_.AsyncCall(&AppMetricsSampler::AddProcess)
+        .WithArgs(id, CopyProcessMetric(*process_metric));
+  }
+}
+
+void App::StopMetricsSampling() {
+  metrics_sampler_.Reset();
+  latest_metrics_ = AppMetricsSnapshot();
+}
+
+std::vector<gin_helper::Dictionary> App::GetLatestAppMetrics(
+    v8::Isolate* isolate) {
+  std::vector<gin_helper::Dictionary> result;
+  result.reserve(latest_metrics_.size());
+  for (size_t i = 0; i < latest_metrics_.size(); ++i)
+    result.push_back(ProcessMetricFromSnapshot(isolate, latest_metrics_, i));
+  return result;
+}
+
+void App::OnAppMetricsSampled(AppMetricsSnapshot snapshot) {
+  // A snapshot can still arrive after stopMetricsSampling().
+  if (!metrics_sampler_)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Only the processes which are new or whose metrics changed since the
+  // previous snapshot are emitted. Both snapshots are sorted by id.
+  std::vector<gin_helper::Dictionary> updated;
+  std::vector<base::ProcessId> removed;
+  const AppMetricsSnapshot& previous = latest_metrics_;
+  size_t j = 0;
+  for (size_t i = 0; i < snapshot.size(); ++i) {
+    while (j < previous.size() && previous.ids[j] < snapshot.ids[i])
+      removed.push_back(previous.pids[j++]);
+    bool changed = j == previous.size() || previous.ids[j] != snapshot.ids[i];
+    if (!changed) {
+      changed = previous.cpu_usages[j] != snapshot.cpu_usages[i] ||
+                previous.idle_wakeups[j] != snapshot.idle_wakeups[i];
+#if !BUILDFLAG(IS_LINUX)
+      const ProcessMemoryInfo& a = previous.memory[j];
+      const ProcessMemoryInfo& b = snapshot.memory[i];
+      changed = changed || a.working_set_size != b.working_set_size ||
+                a.peak_working_set_size != b.peak_working_set_size;
+#if BUILDFLAG(IS_WIN)
+      changed = changed || a.private_bytes != b.private_bytes;
+#endif
+#endif
+      ++j;
+    }
+    if (changed)
+      updated.push_back(ProcessMetricFromSnapshot(isolate, snapshot, i));
+  }
+  while (j < previous.size())
+    removed.push_back(previous.pids[j++]);
+
+  latest_metrics_ = std::move(snapshot);
+  if (updated.empty() && removed.empty())
+    return;
+
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("updated", updated);
+  details.Set("removed", removed);
+  Emit("app-metrics-updated", details);
+}
+
+gin_helper::Dictionary App::ProcessMetricFromSnapshot(
+    v8::Isolate* isolate,
+    const AppMetricsSnapshot& snapshot,
+    size_t index) const {
+  gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+  pid_dict.SetHidden("simple", true);
+  cpu_dict.SetHidden("simple", true);
+  cpu_dict.Set("percentCPUUsage", snapshot.cpu_usages[index]);
+  cpu_dict.Set("idleWakeupsPerSecond", snapshot.idle_wakeups[index]);
+  pid_dict.Set("cpu", cpu_dict);
+  pid_dict.Set("pid", snapshot.pids[index]);
+  pid_dict.Set("type",
+               content::GetProcessTypeNameInEnglish(snapshot.types[index]));
+  pid_dict.Set("creationTime", snapshot.creation_times[index]);
+
+  auto it = app_metrics_.find(snapshot.ids[index]);
+  if (it != app_metrics_.end()) {
+    if (!it->second->service_name.empty())
+      pid_dict.Set("serviceName", it->second->service_name);
+    if (!it->second->name.empty())
+      pid_dict.Set("name", it->second->name);
+  }
+
+#if !BUILDFLAG(IS_LINUX)
+  const ProcessMemoryInfo& memory_info = snapshot.memory[index];
+  gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
+  memory_dict.SetHidden("simple", true);
+  memory_dict.Set("workingSetSize",
+                  static_cast<double>(memory_info.working_set_size >> 10));
+  memory_dict.Set(
+      "peakWorkingSetSize",
+      static_cast<double>(memory_info.peak_working_set_size >> 10));
+#if BUILDFLAG(IS_WIN)
+  memory_dict.Set("privateBytes",
+                  static_cast<double>(memory_info.private_bytes >> 10));
+#endif
+  pid_dict.Set("memory", memory_dict);
+#endif
+
+  return pid_dict;
+}
+
+void App::SetLogFile(gin::Arguments* args) {
+  StructuredLog* log = StructuredLog::GetInstance();
+  base::FilePath path;
+  v8::Local<v8::Value> first = args->PeekNext();
+  if (!first.IsEmpty() && first->IsNull()) {
+    log->Stop();
+    return;
+  }
+  if (!args->GetNext(&path) || path.empty()) {
+    args->ThrowTypeError("path must be a string or null");
+    return;
+  }
+
+  StructuredLog::Options log_options;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    std::string format;
+    if (options.Get("format", &format)) {
+      if (format == "binary") {
+        log_options.format = StructuredLog::Format::kBinary;
+      } else if (format != "json") {
+        args->ThrowTypeError("format must be 'json' or 'binary'");
+        return;
+      }
+    }
+    double max_size;
+    if (options.Get("maxSize", &max_size)) {
+      if (!(max_size > 0)) {
+        args->ThrowTypeError("maxSize must be a positive number");
+        return;
+      }
+      log_options.max_size = static_cast<uint64_t>(max_size);
+    }
+    if (options.Get("maxFiles", &log_options.max_files) &&
+        log_options.max_files < 1) {
+      args->ThrowTypeError("maxFiles must be at least 1");
+      return;
+    }
+    options.Get("captureChromiumLogs", &log_options.capture_chromium_logs);
+  }
+  log->Start(path, log_options);
+}
+
+void App::Log(gin::Arguments* args,
+              const std::string& level,
+              const std::string& message) {
+  static constexpr auto kSeverities =
+      base::MakeFixedFlatMapSorted<base::StringPiece, int>({
+          {"debug", logging::LOGGING_VERBOSE},
+          {"error", logging::LOGGING_ERROR},
+          {"info", logging::LOGGING_INFO},
+          {"warn", logging::LOGGING_WARNING},
+      });
+  const auto* it = kSeverities.find(level);
+  if (it == kSeverities.end()) {
+    args->ThrowTypeError("level must be 'debug', 'info', 'warn' or 'error'");
+    return;
+  }
+  StructuredLog* log = StructuredLog::GetInstance();
+  if (!log->is_enabled())
+    return;
+
+  std::string fields_json;
+  base::Value::Dict fields;
+  if (args->GetNext(&fields))
+    base::JSONWriter::Write(fields, &fields_json);
+  log->Write(it->second, StructuredLog::Source::kApp, message, fields_json);
+}
+
+v8::Local<v8::Promise> App::FlushLog(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  StructuredLog::GetInstance()->Flush(base::BindOnce(
+      gin_helper::Promise<void>::ResolvePromise, std::move(promise)));
+  return handle;
+}
+
+void App::StartEventLoopMonitor(gin::Arguments* args) {
+  double long_task_threshold_ms = 50;
+  double sample_interval_ms = 100;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("longTaskThreshold", &long_task_threshold_ms);
+    options.Get("sampleInterval", &sample_interval_ms);
+  }
+  if (!(long_task_threshold_ms > 0) || !(sample_interval_ms > 0)) {
+    args->ThrowTypeError(
+        "longTaskThreshold and sampleInterval must be positive numbers");
+    return;
+  }
+  ElectronBrowserMainParts::Get()->StartEventLoopMonitor(
+      base::Milliseconds(long_task_threshold_ms),
+      base::Milliseconds(sample_interval_ms));
+}
+
+void App::StopEventLoopMonitor() {
+  ElectronBrowserMainParts::Get()->StopEventLoopMonitor();
+}
+
+v8::Local<v8::Value> App::GetEventLoopMetrics(v8::Isolate* isolate) {
+  const EventLoopMonitor* monitor =
+      ElectronBrowserMainParts::Get()->event_loop_monitor();
+  if (!monitor)
+    return v8::Null(isolate);
+
+  auto to_v8 = [isolate](const EventLoopMonitor::Histogram& histogram) {
+    std::vector<double> counts(histogram.counts.begin(),
+                               histogram.counts.end());
+    return gin::DataObjectBuilder(isolate)
+        .Set("counts", counts)
+        .Set("count", static_cast<double>(histogram.count))
+        .Set("mean", histogram.count ? histogram.total.InMillisecondsF() /
+                                           histogram.count
+                                     : 0)
+        .Set("max", histogram.max.InMillisecondsF())
+        .Build();
+  };
+
+  std::vector<v8::Local<v8::Value>> long_tasks;
+  for (const auto& task : monitor->long_tasks()) {
+    const base::Location& location = task.posted_from;
+    long_tasks.push_back(
+        gin::DataObjectBuilder(isolate)
+            .Set("function", std::string(location.function_name()
+                                             ? location.function_name()
+                                             : ""))
+            .Set("file", std::string(location.file_name()
+                                         ? location.file_name()
+                                         : ""))
+            .Set("line", location.line_number())
+            .Set("startTime", task.start_time.ToJsTime())
+            .Set("duration", task.duration.InMillisecondsF())
+            .Build());
+  }
+
+  return gin::DataObjectBuilder(isolate)
+      .Set("queueingDelay", to_v8(monitor->queueing_delay()))
+      .Set("taskDuration", to_v8(monitor->task_duration()))
+      .Set("uvRunDuration", to_v8(monitor->uv_run_duration()))
+      .Set("longTasks", long_tasks)
+      .Build();
+}
+
+v8::Local<v8::Value> App::GetAllocatorStats(v8::Isolate* isolate) {
+  AllocatorMonitor* monitor =
+      ElectronBrowserMainParts::Get()->GetAllocatorMonitor();
+  const AllocatorMonitor::Stats stats = monitor->GetStats();
+  gin::DataObjectBuilder builder(isolate);
+  builder.Set("mallocUsage", static_cast<double>(stats.malloc_usage))
+      .Set("purgeInterval", monitor->purge_interval().InMillisecondsF());
+  if (stats.partition_alloc) {
+    gin::DataObjectBuilder partition_alloc(isolate);
+    partition_alloc.Set("committed", static_cast<double>(stats.committed))
+        .Set("resident", static_cast<double>(stats.resident))
+        .Set("allocated", static_cast<double>(stats.allocated))
+        .Set("fragmentation", stats.fragmentation);
+    if (stats.thread_cache) {
+      partition_alloc.Set(
+          "threadCache",
+          gin::DataObjectBuilder(isolate)
+              .Set("size", static_cast<double>(stats.thread_cache_size))
+              .Set("hitRate", stats.thread_cache_hit_rate)
+              .Build());
+    }
+    builder.Set("partitionAlloc", partition_alloc.Build());
+  }
+  return builder.Build();
+}
+
+void App::ConfigureAllocator(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Expected an options object");
+    return;
+  }
+  AllocatorMonitor* monitor =
+      ElectronBrowserMainParts::Get()->GetAllocatorMonitor();
+  double multiplier;
+  const bool has_multiplier = options.Get("threadCacheMultiplier", &multiplier);
+  double purge_interval_ms;
+  const bool has_purge_interval =
+      options.Get("purgeInterval", &purge_interval_ms);
+  if ((has_multiplier && !(multiplier > 0)) ||
+      (has_purge_interval && purge_interval_ms != 0 &&
+       !(purge_interval_ms >= 1000))) {
+    args->ThrowTypeError(
+        "threadCacheMultiplier must be positive, purgeInterval must be 0 or at "
+        "least 1000 milliseconds");
+    return;
+  }
+  if (has_multiplier)
+    monitor->SetThreadCacheMultiplier(multiplier);
+  if (has_purge_interval)
+    monitor->SetPurgeInterval(base::Milliseconds(purge_interval_ms));
+}
+
+bool App::PurgeAllocator() {
+  return ElectronBrowserMainParts::Get()->GetAllocatorMonitor()->Purge();
+}
+
+std::vector<gin_helper::Dictionary> App::GetJSHeapAttribution(
+    v8::Isolate* isolate) {
+  std::vector<heap_attribution::Entry> entries =
+      heap_attribution::Measure(isolate);
+  base::ranges::sort(entries, std::greater<>(),
+                     &heap_attribution::Entry::retained_size);
+  std::vector<gin_helper::Dictionary> result;
+  result.reserve(entries.size());
+  for (const auto& entry : entries) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.SetHidden("simple", true);
+    dict.Set("type", entry.type);
+    dict.Set("id", entry.id);
+    dict.Set("retainedSize", static_cast<double>(entry.retained_size));
+    result.push_back(dict);
+  }
+  return result;
+}
+
+std::vector<gin_helper::Dictionary> App::GetStartupTimeline(
+    v8::Isolate* isolate) {
+  const std::vector<startup_timeline::Entry> entries =
+      startup_timeline::GetEntries();
+  std::vector<gin_helper::Dictionary> result;
+  result.reserve(entries.size());
+  // The process start, unless the platform doesn't tell.
+  const base::TimeTicks origin =
+      entries.empty() ? base::TimeTicks() : entries.front().start_time;
+  for (const auto& entry : entries) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.SetHidden("simple", true);
+    dict.Set("name", startup_timeline::GetPhaseName(entry.phase));
+    dict.Set("startTime", (entry.start_time - origin).InMillisecondsF());
+    dict.Set("endTime", (entry.end_time - origin).InMillisecondsF());
+    result.push_back(dict);
+  }
+  return result;
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, content::GetFeatureStatus());
 }
@@ -1763,6 +2748,8 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
 #endif
       .SetMethod("hasSingleInstanceLock", &App::HasSingleInstanceLock)
       .SetMethod("requestSingleInstanceLock", &App::RequestSingleInstanceLock)
+      .SetMethod("requestSingleInstanceLockAsync",
+                 &App::RequestSingleInstanceLockAsync)
       .SetMethod("releaseSingleInstanceLock", &App::ReleaseSingleInstanceLock)
       .SetMethod("relaunch", &App::Relaunch)
       .SetMethod("isAccessibilitySupportEnabled",
@@ -1774,7 +2761,28 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
       .SetMethod("disableDomainBlockingFor3DAPIs",
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
+      .SetMethod("getFileIcons", &App::GetFileIcons)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("getProcessMemoryDetails", &App::GetProcessMemoryDetails)
+      .SetMethod("setBackgroundMemoryPolicy", &App::SetBackgroundMemoryPolicy)
+      .SetMethod("setBackgroundTrimming", &App::SetBackgroundTrimming)
+      .SetMethod("trimMemory", &App::TrimMemory)
+      .SetMethod("setHangDetection", &App::SetHangDetection)
+      .SetMethod("getHangMetrics", &App::GetHangMetrics)
+      .SetMethod("startMetricsSampling", &App::StartMetricsSampling)
+      .SetMethod("stopMetricsSampling", &App::StopMetricsSampling)
+      .SetMethod("getLatestAppMetrics", &App::GetLatestAppMetrics)
+      .SetMethod("getJSHeapAttribution", &App::GetJSHeapAttribution)
+      .SetMethod("getStartupTimeline", &App::GetStartupTimeline)
+      .SetMethod("setLogFile", &App::SetLogFile)
+      .SetMethod("log", &App::Log)
+      .SetMethod("flushLog", &App::FlushLog)
+      .SetMethod("startEventLoopMonitor", &App::StartEventLoopMonitor)
+      .SetMethod("stopEventLoopMonitor", &App::StopEventLoopMonitor)
+      .SetMethod("getEventLoopMetrics", &App::GetEventLoopMetrics)
+      .SetMethod("getAllocatorStats", &App::GetAllocatorStats)
+      .SetMethod("configureAllocator", &App::ConfigureAllocator)
+      .SetMethod("purgeAllocator", &App::PurgeAllocator)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if IS_MAS_BUILD()
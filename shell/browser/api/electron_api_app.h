@@ -10,8 +10,8 @@
 #include <string>
 #include <vector>
 
-#include "base/task/cancelable_task_tracker.h"
-#include "chrome/browser/icon_manager.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/browser_child_process_observer.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
@@ -21,7 +21,13 @@
 #include "net/base/completion_once_callback.h"
 #include "net/base/completion_repeating_callback.h"
 #include "net/ssl/client_cert_identity.h"
+#include "shell/browser/api/app_metrics_sampler.h"
+#include "shell/browser/api/background_memory_policy.h"
+#include "shell/browser/api/background_trimmer.h"
+#include "shell/browser/api/file_icon_cache.h"
+#include "shell/browser/api/hang_watchdog.h"
 #include "shell/browser/api/process_metric.h"
+#include "shell/browser/async_process_singleton.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
@@ -38,6 +44,10 @@ namespace base {
 class FilePath;
 }
 
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
 namespace electron {
 
 #if BUILDFLAG(IS_WIN)
@@ -198,6 +208,9 @@ class App : public ElectronBrowserClient::Delegate,
                         const std::vector<const uint8_t> additional_data);
   bool HasSingleInstanceLock() const;
   bool RequestSingleInstanceLock(gin::Arguments* args);
+  v8::Local<v8::Promise> RequestSingleInstanceLockAsync(gin::Arguments* args);
+  void OnSingleInstanceLockResult(gin_helper::Promise<bool> promise,
+                                  ProcessSingleton::NotifyResult result);
   void ReleaseSingleInstanceLock();
   bool Relaunch(gin::Arguments* args);
   void DisableHardwareAcceleration(gin_helper::ErrorThrower thrower);
@@ -213,8 +226,49 @@ class App : public ElectronBrowserClient::Delegate,
 #endif
   v8::Local<v8::Promise> GetFileIcon(const base::FilePath& path,
                                      gin::Arguments* args);
+  v8::Local<v8::Promise> GetFileIcons(const std::vector<base::FilePath>& paths,
+                                      gin::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  v8::Local<v8::Promise> GetProcessMemoryDetails(v8::Isolate* isolate);
+  void OnProcessMemoryDump(
+      gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+      bool success,
+      std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump);
+  void SetBackgroundMemoryPolicy(gin::Arguments* args);
+  void OnBackgroundMemoryAction(WebContents* web_contents,
+                                BackgroundMemoryPolicy::Action action,
+                                uint64_t footprint,
+                                absl::optional<uint64_t> reclaimed);
+  void SetBackgroundTrimming(gin::Arguments* args);
+  void OnBackgroundTrim(const BackgroundTrimmer::Report& report);
+  v8::Local<v8::Promise> TrimMemory(v8::Isolate* isolate);
+  void SetHangDetection(gin::Arguments* args);
+  void OnHang(const HangWatchdog::Hang& hang);
+  v8::Local<v8::Value> GetHangMetrics(v8::Isolate* isolate);
+  void StartMetricsSampling(gin::Arguments* args);
+  void StopMetricsSampling();
+  std::vector<gin_helper::Dictionary> GetLatestAppMetrics(
+      v8::Isolate* isolate);
+  void OnAppMetricsSampled(AppMetricsSnapshot snapshot);
+  gin_helper::Dictionary ProcessMetricFromSnapshot(
+      v8::Isolate* isolate,
+      const AppMetricsSnapshot& snapshot,
+      size_t index) const;
+  std::vector<gin_helper::Dictionary> GetJSHeapAttribution(
+      v8::Isolate* isolate);
+  std::vector<gin_helper::Dictionary> GetStartupTimeline(v8::Isolate* isolate);
+  void SetLogFile(gin::Arguments* args);
+  void Log(gin::Arguments* args,
+           const std::string& level,
+           const std::string& message);
+  v8::Local<v8::Promise> FlushLog(v8::Isolate* isolate);
+  void StartEventLoopMonitor(gin::Arguments* args);
+  void StopEventLoopMonitor();
+  v8::Local<v8::Value> GetEventLoopMetrics(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetAllocatorStats(v8::Isolate* isolate);
+  void ConfigureAllocator(gin::Arguments* args);
+  bool PurgeAllocator();
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -250,13 +304,16 @@ class App : public ElectronBrowserClient::Delegate,
 #endif  // BUILDFLAG(IS_WIN)
 
   std::unique_ptr<ProcessSingleton> process_singleton_;
+  // Set by requestSingleInstanceLockAsync(), |pending_process_singleton_|
+  // while waiting for the lock.
+  std::unique_ptr<AsyncProcessSingleton> pending_process_singleton_;
+  std::unique_ptr<AsyncProcessSingleton> async_process_singleton_;
 
 #if BUILDFLAG(USE_NSS_CERTS)
   std::unique_ptr<CertificateManagerModel> certificate_manager_model_;
 #endif
 
-  // Tracks tasks requesting file icons.
-  base::CancelableTaskTracker cancelable_task_tracker_;
+  FileIconCache file_icon_cache_;
 
   base::FilePath app_path_;
 
@@ -264,9 +321,24 @@ class App : public ElectronBrowserClient::Delegate,
       std::map<int, std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  // Set by setBackgroundMemoryPolicy().
+  std::unique_ptr<BackgroundMemoryPolicy> background_memory_policy_;
+
+  // Set by setBackgroundTrimming().
+  std::unique_ptr<BackgroundTrimmer> background_trimmer_;
+
+  // Set by setHangDetection().
+  std::unique_ptr<HangWatchdog> hang_watchdog_;
+
+  // Set by startMetricsSampling(), |latest_metrics_| is its last snapshot.
+  base::SequenceBound<AppMetricsSampler> metrics_sampler_;
+  AppMetricsSnapshot latest_metrics_;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
   bool watch_singleton_socket_on_ready_ = false;
+
+  base::WeakPtrFactory<App> weak_factory_{this};
 };
 
 }  // namespace api
@@ -4,22 +4,58 @@
 
 #include "shell/browser/api/electron_api_auto_updater.h"
 
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/window_list.h"
+#include "shell/common/asar/asar_delta.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/time_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron::api {
 
 gin::WrapperInfo AutoUpdater::kWrapperInfo = {gin::kEmbedderNativeGin};
 
+namespace {
+
+// Runs |task| on the thread pool, it returns the error message on failure.
+v8::Local<v8::Promise> RunDeltaTask(
+    v8::Isolate* isolate,
+    base::OnceCallback<absl::optional<std::string>()> task) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      std::move(task),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise,
+             absl::optional<std::string> error) {
+            if (error)
+              promise.RejectWithErrorMessage(*error);
+            else
+              promise.Resolve();
+          },
+          std::move(promise)));
+  return handle;
+}
+
+}  // namespace
+
 AutoUpdater::AutoUpdater() {
   auto_updater::AutoUpdater::SetDelegate(this);
 }
@@ -113,6 +149,56 @@ void AutoUpdater::QuitAndInstall() {
   WindowList::CloseAllWindows();
 }
 
+// static
+v8::Local<v8::Promise> AutoUpdater::CreateAsarDelta(
+    v8::Isolate* isolate,
+    const base::FilePath& old_path,
+    const base::FilePath& new_path,
+    const base::FilePath& delta_path) {
+  return RunDeltaTask(
+      isolate, base::BindOnce(
+                   [](const base::FilePath& old_path,
+                      const base::FilePath& new_path,
+                      const base::FilePath& delta_path)
+                       -> absl::optional<std::string> {
+                     std::string error;
+                     if (asar::CreateArchiveDelta(old_path, new_path,
+                                                  delta_path, &error))
+                       return absl::nullopt;
+                     return error;
+                   },
+                   old_path, new_path, delta_path));
+}
+
+// static
+v8::Local<v8::Promise> AutoUpdater::ApplyAsarDelta(gin::Arguments* args) {
+  base::FilePath old_path, delta_path, out_path;
+  if (!args->GetNext(&old_path) || !args->GetNext(&delta_path) ||
+      !args->GetNext(&out_path)) {
+    args->ThrowTypeError("Expected the paths of the archive, the delta and "
+                         "the output");
+    return v8::Local<v8::Promise>();
+  }
+  std::string header_hash;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("headerHash", &header_hash);
+
+  return RunDeltaTask(
+      args->isolate(),
+      base::BindOnce(
+          [](const base::FilePath& old_path, const base::FilePath& delta_path,
+             const base::FilePath& out_path,
+             const std::string& header_hash) -> absl::optional<std::string> {
+            std::string error;
+            if (asar::ApplyArchiveDelta(old_path, delta_path, out_path,
+                                        header_hash, &error))
+              return absl::nullopt;
+            return error;
+          },
+          old_path, delta_path, out_path, header_hash));
+}
+
 // static
 gin::Handle<AutoUpdater> AutoUpdater::Create(v8::Isolate* isolate) {
   return gin::CreateHandle(isolate, new AutoUpdater());
@@ -125,7 +211,9 @@ gin::ObjectTemplateBuilder AutoUpdater::GetObjectTemplateBuilder(
       .SetMethod("checkForUpdates", &auto_updater::AutoUpdater::CheckForUpdates)
       .SetMethod("getFeedURL", &auto_updater::AutoUpdater::GetFeedURL)
       .SetMethod("setFeedURL", &AutoUpdater::SetFeedURL)
-      .SetMethod("quitAndInstall", &AutoUpdater::QuitAndInstall);
+      .SetMethod("quitAndInstall", &AutoUpdater::QuitAndInstall)
+      .SetMethod("createAsarDelta", &AutoUpdater::CreateAsarDelta)
+      .SetMethod("applyAsarDelta", &AutoUpdater::ApplyAsarDelta);
 }
 
 const char* AutoUpdater::GetTypeName() {
@@ -145,6 +233,9 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("autoUpdater", AutoUpdater::Create(isolate));
+  // For the updater of Windows, which is implemented in JavaScript.
+  dict.SetMethod("createAsarDelta", &AutoUpdater::CreateAsarDelta);
+  dict.SetMethod("applyAsarDelta", &AutoUpdater::ApplyAsarDelta);
 }
 
 }  // namespace
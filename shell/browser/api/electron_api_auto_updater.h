@@ -13,6 +13,14 @@
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/window_list_observer.h"
 
+namespace base {
+class FilePath;
+}
+
+namespace gin {
+class Arguments;
+}
+
 namespace electron::api {
 
 class AutoUpdater : public gin::Wrappable<AutoUpdater>,
@@ -22,6 +30,15 @@ class AutoUpdater : public gin::Wrappable<AutoUpdater>,
  public:
   static gin::Handle<AutoUpdater> Create(v8::Isolate* isolate);
 
+  // The asar deltas of shell/common/asar/asar_delta.h, which don't depend on
+  // the updater of the platform.
+  static v8::Local<v8::Promise> CreateAsarDelta(
+      v8::Isolate* isolate,
+      const base::FilePath& old_path,
+      const base::FilePath& new_path,
+      const base::FilePath& delta_path);
+  static v8::Local<v8::Promise> ApplyAsarDelta(gin::Arguments* args);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -17,6 +17,7 @@
 #include "shell/browser/api/electron_api_view.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/window_batch.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -190,6 +191,10 @@ void BaseWindow::OnWindowHide() {
   Emit("hide");
 }
 
+void BaseWindow::OnWindowOcclusionChanged(bool occluded) {
+  Emit(occluded ? "occluded" : "unoccluded");
+}
+
 void BaseWindow::OnWindowMaximize() {
   Emit("maximize");
 }
@@ -337,6 +342,10 @@ bool BaseWindow::IsFocused() {
 }
 
 void BaseWindow::Show() {
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetVisibility(window_.get(), WindowBatch::Visibility::kShow);
+    return;
+  }
   window_->Show();
 }
 
@@ -344,10 +353,18 @@ void BaseWindow::ShowInactive() {
   // This method doesn't make sense for modal window.
   if (IsModal())
     return;
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetVisibility(window_.get(), WindowBatch::Visibility::kShowInactive);
+    return;
+  }
   window_->ShowInactive();
 }
 
 void BaseWindow::Hide() {
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetVisibility(window_.get(), WindowBatch::Visibility::kHide);
+    return;
+  }
   window_->Hide();
 }
 
@@ -355,6 +372,19 @@ bool BaseWindow::IsVisible() {
   return window_->IsVisible();
 }
 
+bool BaseWindow::IsOccluded() {
+  return window_->is_occluded();
+}
+
+v8::Local<v8::Value> BaseWindow::GetOcclusionMetrics() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("occluded", window_->is_occluded());
+  dict.Set("occlusionCount", window_->occlusion_count());
+  dict.Set("occludedTime", window_->GetOccludedTime().InMillisecondsF());
+  return dict.GetHandle();
+}
+
 bool BaseWindow::IsEnabled() {
   return window_->IsEnabled();
 }
@@ -399,10 +429,18 @@ void BaseWindow::SetBounds(const gfx::Rect& bounds,
                            gin_helper::Arguments* args) {
   bool animate = false;
   args->GetNext(&animate);
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetBounds(window_.get(), bounds);
+    return;
+  }
   window_->SetBounds(bounds, animate);
 }
 
 gfx::Rect BaseWindow::GetBounds() {
+  if (auto* batch = WindowBatch::Current()) {
+    if (auto bounds = batch->GetPendingBounds(window_.get()))
+      return *bounds;
+  }
   return window_->GetBounds();
 }
 
@@ -430,12 +468,16 @@ void BaseWindow::SetSize(int width, int height, gin_helper::Arguments* args) {
   gfx::Size size = window_->GetMinimumSize();
   size.SetToMax(gfx::Size(width, height));
   args->GetNext(&animate);
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetBounds(window_.get(), gfx::Rect(GetBounds().origin(), size));
+    return;
+  }
   window_->SetSize(size, animate);
 }
 
 std::vector<int> BaseWindow::GetSize() {
   std::vector<int> result(2);
-  gfx::Size size = window_->GetSize();
+  gfx::Size size = GetBounds().size();
   result[0] = size.width();
   result[1] = size.height();
   return result;
@@ -543,6 +585,10 @@ void BaseWindow::SetAlwaysOnTop(bool top, gin_helper::Arguments* args) {
 
   ui::ZOrderLevel z_order =
       top ? ui::ZOrderLevel::kFloatingWindow : ui::ZOrderLevel::kNormal;
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetZOrderLevel(window_.get(), z_order, level, relative_level);
+    return;
+  }
   window_->SetAlwaysOnTop(z_order, level, relative_level);
 }
 
@@ -557,12 +603,17 @@ void BaseWindow::Center() {
 void BaseWindow::SetPosition(int x, int y, gin_helper::Arguments* args) {
   bool animate = false;
   args->GetNext(&animate);
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetBounds(window_.get(),
+                     gfx::Rect(gfx::Point(x, y), GetBounds().size()));
+    return;
+  }
   window_->SetPosition(gfx::Point(x, y), animate);
 }
 
 std::vector<int> BaseWindow::GetPosition() {
   std::vector<int> result(2);
-  gfx::Point pos = window_->GetPosition();
+  gfx::Point pos = GetBounds().origin();
   result[0] = pos.x();
   result[1] = pos.y();
   return result;
@@ -651,6 +702,10 @@ bool BaseWindow::HasShadow() {
 }
 
 void BaseWindow::SetOpacity(const double opacity) {
+  if (auto* batch = WindowBatch::Current()) {
+    batch->SetOpacity(window_.get(), opacity);
+    return;
+  }
   window_->SetOpacity(opacity);
 }
 
@@ -1169,21 +1224,23 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("close", &BaseWindow::Close)
       .SetMethod("focus", &BaseWindow::Focus)
       .SetMethod("blur", &BaseWindow::Blur)
-      .SetMethod("isFocused", &BaseWindow::IsFocused)
+      .SetFastMethod<&BaseWindow::IsFocused>("isFocused")
       .SetMethod("show", &BaseWindow::Show)
       .SetMethod("showInactive", &BaseWindow::ShowInactive)
       .SetMethod("hide", &BaseWindow::Hide)
-      .SetMethod("isVisible", &BaseWindow::IsVisible)
+      .SetFastMethod<&BaseWindow::IsVisible>("isVisible")
+      .SetMethod("isOccluded", &BaseWindow::IsOccluded)
+      .SetMethod("getOcclusionMetrics", &BaseWindow::GetOcclusionMetrics)
       .SetMethod("isEnabled", &BaseWindow::IsEnabled)
       .SetMethod("setEnabled", &BaseWindow::SetEnabled)
       .SetMethod("maximize", &BaseWindow::Maximize)
       .SetMethod("unmaximize", &BaseWindow::Unmaximize)
-      .SetMethod("isMaximized", &BaseWindow::IsMaximized)
+      .SetFastMethod<&BaseWindow::IsMaximized>("isMaximized")
       .SetMethod("minimize", &BaseWindow::Minimize)
       .SetMethod("restore", &BaseWindow::Restore)
-      .SetMethod("isMinimized", &BaseWindow::IsMinimized)
+      .SetFastMethod<&BaseWindow::IsMinimized>("isMinimized")
       .SetMethod("setFullScreen", &BaseWindow::SetFullScreen)
-      .SetMethod("isFullScreen", &BaseWindow::IsFullscreen)
+      .SetFastMethod<&BaseWindow::IsFullscreen>("isFullScreen")
       .SetMethod("setBounds", &BaseWindow::SetBounds)
       .SetMethod("getBounds", &BaseWindow::GetBounds)
       .SetMethod("isNormal", &BaseWindow::IsNormal)
@@ -1214,7 +1271,7 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setClosable", &BaseWindow::SetClosable)
       .SetMethod("isClosable", &BaseWindow::IsClosable)
       .SetMethod("setAlwaysOnTop", &BaseWindow::SetAlwaysOnTop)
-      .SetMethod("isAlwaysOnTop", &BaseWindow::IsAlwaysOnTop)
+      .SetFastMethod<&BaseWindow::IsAlwaysOnTop>("isAlwaysOnTop")
       .SetMethod("center", &BaseWindow::Center)
       .SetMethod("setPosition", &BaseWindow::SetPosition)
       .SetMethod("getPosition", &BaseWindow::GetPosition)
@@ -1234,7 +1291,7 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setHasShadow", &BaseWindow::SetHasShadow)
       .SetMethod("hasShadow", &BaseWindow::HasShadow)
       .SetMethod("setOpacity", &BaseWindow::SetOpacity)
-      .SetMethod("getOpacity", &BaseWindow::GetOpacity)
+      .SetFastMethod<&BaseWindow::GetOpacity>("getOpacity")
       .SetMethod("setShape", &BaseWindow::SetShape)
       .SetMethod("setRepresentedFilename", &BaseWindow::SetRepresentedFilename)
       .SetMethod("getRepresentedFilename", &BaseWindow::GetRepresentedFilename)
@@ -1345,6 +1402,8 @@ void Initialize(v8::Local<v8::Object> exports,
                                          .ToLocalChecked());
   constructor.SetMethod("fromId", &BaseWindow::FromWeakMapID);
   constructor.SetMethod("getAllWindows", &BaseWindow::GetAll);
+  constructor.SetMethod("_beginBatch", &electron::WindowBatch::Begin);
+  constructor.SetMethod("_endBatch", &electron::WindowBatch::End);
 
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("BaseWindow", constructor);
@@ -18,6 +18,7 @@
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/trackable_object.h"
+#include "shell/common/key_weak_map.h"
 
 namespace electron::api {
 
@@ -55,6 +56,7 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
   void OnWindowFocus() override;
   void OnWindowShow() override;
   void OnWindowHide() override;
+  void OnWindowOcclusionChanged(bool occluded) override;
   void OnWindowMaximize() override;
   void OnWindowUnmaximize() override;
   void OnWindowMinimize() override;
@@ -97,6 +99,8 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
   void ShowInactive();
   void Hide();
   bool IsVisible();
+  bool IsOccluded();
+  v8::Local<v8::Value> GetOcclusionMetrics();
   bool IsEnabled();
   void SetEnabled(bool enable);
   void Maximize();
@@ -8,20 +8,25 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_owner_delegate.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/common/color_parser.h"
 #include "shell/browser/api/electron_api_web_contents_view.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/electron_browser_context.h"
 #include "shell/browser/native_browser_view.h"
+#include "shell/browser/net/connection_warming.h"
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/window_list.h"
 #include "shell/common/color_util.h"
+#include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_helper/constructor.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_timeline.h"
 #include "ui/gl/gpu_switching_manager.h"
 
 #if defined(TOOLKIT_VIEWS)
@@ -37,6 +42,9 @@ namespace electron::api {
 BrowserWindow::BrowserWindow(gin::Arguments* args,
                              const gin_helper::Dictionary& options)
     : BaseWindow(args->isolate(), options) {
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kFirstBrowserWindowCreated);
+
   // Use options.webPreferences in WebContents.
   v8::Isolate* isolate = args->isolate();
   gin_helper::Dictionary web_preferences =
@@ -96,6 +104,30 @@ BrowserWindow::BrowserWindow(gin::Arguments* args,
   // Associate with BrowserWindow.
   web_contents->SetOwnerWindow(window());
 
+  // Starting the renderer and the connection to the page now overlaps them
+  // with setting up the window and with the app's code until it loads the
+  // page, instead of waiting for the navigation.
+  bool fast_first_paint = false;
+  gin_helper::Dictionary fast_first_paint_options;
+  GURL first_paint_url;
+  if (options.Get(options::kFastFirstPaint, &fast_first_paint_options)) {
+    fast_first_paint = true;
+    fast_first_paint_options.Get("url", &first_paint_url);
+  } else {
+    options.Get(options::kFastFirstPaint, &fast_first_paint);
+  }
+  if (fast_first_paint) {
+    content::WebContents* contents = web_contents->web_contents();
+    // The page's WebContentsPreferences decide the switches of the renderer,
+    // the navigation then uses it as it is still unused.
+    contents->GetPrimaryMainFrame()->GetProcess()->Init();
+    if (first_paint_url.SchemeIsHTTPOrHTTPS()) {
+      connection_warming::Warm(
+          static_cast<ElectronBrowserContext*>(contents->GetBrowserContext()),
+          {{first_paint_url}}, false);
+    }
+  }
+
   InitWithArgs(args);
 
   // Install the content view after BaseWindow's JS code is initialized.
@@ -428,6 +460,15 @@ void BrowserWindow::OnWindowHide() {
   BaseWindow::OnWindowHide();
 }
 
+void BrowserWindow::OnWindowOcclusionChanged(bool occluded) {
+  // Covered windows stop producing frames and running animation frames.
+  if (occluded)
+    web_contents()->WasOccluded();
+  else if (window()->IsVisible() && !window()->IsMinimized())
+    web_contents()->WasShown();
+  BaseWindow::OnWindowOcclusionChanged(occluded);
+}
+
 // static
 gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
                                               gin::Arguments* args) {
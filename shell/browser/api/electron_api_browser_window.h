@@ -73,6 +73,7 @@ class BrowserWindow : public BaseWindow,
       absl::optional<gin::Handle<BrowserView>> browser_view) override;
   void OnWindowShow() override;
   void OnWindowHide() override;
+  void OnWindowOcclusionChanged(bool occluded) override;
 
   // BrowserWindow APIs.
   void FocusOnWebView();
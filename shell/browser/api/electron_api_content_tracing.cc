@@ -5,16 +5,20 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_config.h"
 #include "content/public/browser/tracing_controller.h"
+#include "shell/browser/flight_recorder.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/time_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -52,10 +56,60 @@ struct Converter<base::trace_event::TraceConfig> {
   }
 };
 
+template <>
+struct Converter<electron::FlightRecorder::Trigger> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   electron::FlightRecorder::Trigger trigger) {
+    using Trigger = electron::FlightRecorder::Trigger;
+    switch (trigger) {
+      case Trigger::kLongTask:
+        return StringToV8(isolate, "long-task");
+      case Trigger::kHang:
+        return StringToV8(isolate, "hang");
+      case Trigger::kCrash:
+        return StringToV8(isolate, "crash");
+    }
+    return v8::Undefined(isolate);
+  }
+
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::FlightRecorder::Trigger* out) {
+    using Trigger = electron::FlightRecorder::Trigger;
+    std::string trigger;
+    if (!ConvertFromV8(isolate, val, &trigger))
+      return false;
+    if (trigger == "long-task")
+      *out = Trigger::kLongTask;
+    else if (trigger == "hang")
+      *out = Trigger::kHang;
+    else if (trigger == "crash")
+      *out = Trigger::kCrash;
+    else
+      return false;
+    return true;
+  }
+};
+
+template <>
+struct Converter<electron::FlightRecorder::Dump> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::FlightRecorder::Dump& dump) {
+    auto dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("path", dump.path);
+    dict.Set("trigger", dump.trigger);
+    dict.Set("time", dump.time);
+    return ConvertToV8(isolate, dict);
+  }
+};
+
 }  // namespace gin
 
 namespace {
 
+using electron::FlightRecorder;
+
 using CompletionCallback = base::OnceCallback<void(const base::FilePath&)>;
 
 absl::optional<base::FilePath> CreateTemporaryFileOnIO() {
@@ -169,6 +223,100 @@ v8::Local<v8::Promise> GetTraceBufferUsage(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Promise> StartFlightRecorder(gin_helper::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  FlightRecorder::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::vector<FlightRecorder::Trigger> triggers;
+    double buffer_size = 0;
+    double long_task_threshold = 0;
+    if ((dict.Has("categories") &&
+         !dict.Get("categories", &options.categories)) ||
+        (dict.Has("triggers") && !dict.Get("triggers", &triggers)) ||
+        (dict.Has("directory") && !dict.Get("directory", &options.directory))) {
+      args->ThrowTypeError("Invalid flight recorder options");
+      return v8::Local<v8::Promise>();
+    }
+    if (dict.Get("bufferSize", &buffer_size)) {
+      if (buffer_size < 1) {
+        args->ThrowTypeError("bufferSize must be at least 1 KB");
+        return v8::Local<v8::Promise>();
+      }
+      options.buffer_size = static_cast<size_t>(buffer_size);
+    }
+    if (dict.Get("longTaskThreshold", &long_task_threshold)) {
+      if (long_task_threshold <= 0) {
+        args->ThrowTypeError("longTaskThreshold must be positive");
+        return v8::Local<v8::Promise>();
+      }
+      options.long_task_threshold = base::Milliseconds(long_task_threshold);
+    }
+    if (!triggers.empty() && options.directory.empty()) {
+      args->ThrowTypeError("A directory is required for the triggers");
+      return v8::Local<v8::Promise>();
+    }
+    options.triggers = {triggers.begin(), triggers.end()};
+  }
+  if (options.categories.empty())
+    options.categories = FlightRecorder::GetDefaultCategories();
+
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  FlightRecorder::GetInstance()->Start(
+      options, base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                              std::move(promise)));
+  return handle;
+}
+
+void StopFlightRecorder() {
+  FlightRecorder::GetInstance()->Stop();
+}
+
+void DumpFlightRecorderTo(gin_helper::Promise<base::FilePath> promise,
+                          absl::optional<base::FilePath> file_path) {
+  if (!file_path) {
+    promise.RejectWithErrorMessage(
+        "Failed to create temporary file for trace data");
+    return;
+  }
+  FlightRecorder::GetInstance()->DumpTo(
+      *file_path, base::BindOnce(
+                      [](gin_helper::Promise<base::FilePath> promise,
+                         const base::FilePath& path,
+                         absl::optional<std::string> error) {
+                        if (error)
+                          promise.RejectWithErrorMessage(*error);
+                        else
+                          promise.Resolve(path);
+                      },
+                      std::move(promise), *file_path));
+}
+
+v8::Local<v8::Promise> DumpFlightRecorder(gin_helper::Arguments* args) {
+  gin_helper::Promise<base::FilePath> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::FilePath path;
+  if (!FlightRecorder::GetInstance()->IsRecording()) {
+    promise.RejectWithErrorMessage("Flight recorder is not recording");
+  } else if (args->GetNext(&path) && !path.empty()) {
+    DumpFlightRecorderTo(std::move(promise), absl::make_optional(path));
+  } else {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(CreateTemporaryFileOnIO),
+        base::BindOnce(DumpFlightRecorderTo, std::move(promise)));
+  }
+
+  return handle;
+}
+
+std::vector<FlightRecorder::Dump> GetFlightRecorderDumps() {
+  const auto& dumps = FlightRecorder::GetInstance()->dumps();
+  return {dumps.begin(), dumps.end()};
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -178,6 +326,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
+  dict.SetMethod("startFlightRecorder", &StartFlightRecorder);
+  dict.SetMethod("stopFlightRecorder", &StopFlightRecorder);
+  dict.SetMethod("dumpFlightRecorder", &DumpFlightRecorder);
+  dict.SetMethod("getFlightRecorderDumps", &GetFlightRecorderDumps);
 }
 
 }  // namespace
@@ -5,7 +5,12 @@
 #include "shell/browser/api/electron_api_cookies.h"
 
 #include <utility>
+#include <vector>
 
+#include "base/barrier_callback.h"
+#include "base/barrier_closure.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -25,6 +30,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/record.h"
 
 namespace gin {
 
@@ -47,11 +53,20 @@ struct Converter<net::CookieSameSite> {
   }
 };
 
+namespace {
+
+// The expiration date is only set for persistent cookies.
+gin_helper::RecordTemplate kCookieTemplate({"name", "value", "domain",
+                                            "hostOnly", "path", "secure",
+                                            "httpOnly", "session", "sameSite"});
+
+}  // namespace
+
 template <>
 struct Converter<net::CanonicalCookie> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
                                    const net::CanonicalCookie& val) {
-    gin::Dictionary dict(isolate, v8::Object::New(isolate));
+    gin_helper::Dictionary dict = kCookieTemplate.NewRecord(isolate);
     dict.Set("name", val.Name());
     dict.Set("value", val.Value());
     dict.Set("domain", val.Domain());
@@ -60,10 +75,10 @@ struct Converter<net::CanonicalCookie> {
     dict.Set("secure", val.IsSecure());
     dict.Set("httpOnly", val.IsHttpOnly());
     dict.Set("session", !val.IsPersistent());
+    dict.Set("sameSite", val.SameSite());
     if (val.IsPersistent())
       dict.Set("expirationDate", val.ExpiryDate().ToDoubleT());
-    dict.Set("sameSite", val.SameSite());
-    return ConvertToV8(isolate, dict).As<v8::Object>();
+    return dict.GetHandle();
   }
 };
 
@@ -139,6 +154,20 @@ bool MatchesCookie(const base::Value::Dict& filter,
   return true;
 }
 
+// Returns whether |cookie| would be sent in a request to |url|, like the
+// cookies returned by CookieManager::GetCookieList.
+bool MatchesURL(const GURL& url, const net::CanonicalCookie& cookie) {
+  net::CookieOptions options;
+  options.set_include_httponly();
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  return cookie
+      .IncludeForRequestURL(
+          url, options,
+          net::CookieAccessParams(net::CookieAccessSemantics::UNKNOWN, false))
+      .status.IsInclude();
+}
+
 // Remove cookies from |list| not matching |filter|, and pass it to |callback|.
 void FilterCookies(base::Value::Dict filter,
                    gin_helper::Promise<net::CookieList> promise,
@@ -160,6 +189,25 @@ void FilterCookieWithStatuses(
                 net::cookie_util::StripAccessResults(list));
 }
 
+// Splits |cookies| into the ones matching each of |filters|.
+void FilterCookiesMany(
+    std::vector<base::Value::Dict> filters,
+    gin_helper::Promise<std::vector<net::CookieList>> promise,
+    const net::CookieList& cookies) {
+  std::vector<net::CookieList> results(filters.size());
+  for (size_t i = 0; i < filters.size(); ++i) {
+    const std::string* url_string = filters[i].FindString("url");
+    const GURL url(url_string ? *url_string : "");
+    for (const auto& cookie : cookies) {
+      if ((url.is_empty() || MatchesURL(url, cookie)) &&
+          MatchesCookie(filters[i], cookie)) {
+        results[i].push_back(cookie);
+      }
+    }
+  }
+  promise.Resolve(results);
+}
+
 // Parse dictionary property to CanonicalCookie time correctly.
 base::Time ParseTimeProperty(const absl::optional<double>& value) {
   if (!value)  // empty time means ignoring the parameter
@@ -212,6 +260,67 @@ std::string StringToCookieSameSite(const std::string* str_ptr,
   return "";
 }
 
+// Creates the cookie described by |details|, returns the error message when
+// it is invalid.
+std::string CreateCookie(const base::Value::Dict& details,
+                         std::unique_ptr<net::CanonicalCookie>* cookie,
+                         GURL* cookie_url,
+                         net::CookieOptions* cookie_options) {
+  const std::string* url_string = details.FindString("url");
+  if (!url_string)
+    return "Missing required option 'url'";
+  const std::string* name = details.FindString("name");
+  const std::string* value = details.FindString("value");
+  const std::string* domain = details.FindString("domain");
+  const std::string* path = details.FindString("path");
+  bool http_only = details.FindBool("httpOnly").value_or(false);
+  const std::string* same_site_string = details.FindString("sameSite");
+  net::CookieSameSite same_site;
+  std::string error = StringToCookieSameSite(same_site_string, &same_site);
+  if (!error.empty())
+    return error;
+  bool secure = details.FindBool("secure").value_or(
+      same_site == net::CookieSameSite::NO_RESTRICTION);
+  bool same_party =
+      details.FindBool("sameParty")
+          .value_or(secure && same_site != net::CookieSameSite::STRICT_MODE);
+
+  GURL url(*url_string);
+  if (!url.is_valid()) {
+    return std::string(InclusionStatusToString(net::CookieInclusionStatus(
+        net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN)));
+  }
+
+  net::CookieInclusionStatus status;
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
+      ParseTimeProperty(details.FindDouble("expirationDate")),
+      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
+      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, same_party,
+      absl::nullopt, &status);
+
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    return std::string(InclusionStatusToString(
+        !status.IsInclude()
+            ? status
+            : net::CookieInclusionStatus(
+                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE)));
+  }
+
+  net::CookieOptions options;
+  if (http_only) {
+    options.set_include_httponly();
+  }
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+
+  *cookie = std::move(canonical_cookie);
+  *cookie_url = std::move(url);
+  *cookie_options = std::move(options);
+  return "";
+}
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -287,61 +396,14 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindString("url");
-  if (!url_string) {
-    promise.RejectWithErrorMessage("Missing required option 'url'");
-    return handle;
-  }
-  const std::string* name = details.FindString("name");
-  const std::string* value = details.FindString("value");
-  const std::string* domain = details.FindString("domain");
-  const std::string* path = details.FindString("path");
-  bool http_only = details.FindBool("httpOnly").value_or(false);
-  const std::string* same_site_string = details.FindString("sameSite");
-  net::CookieSameSite same_site;
-  std::string error = StringToCookieSameSite(same_site_string, &same_site);
+  std::unique_ptr<net::CanonicalCookie> canonical_cookie;
+  GURL url;
+  net::CookieOptions options;
+  std::string error = CreateCookie(details, &canonical_cookie, &url, &options);
   if (!error.empty()) {
     promise.RejectWithErrorMessage(error);
     return handle;
   }
-  bool secure = details.FindBool("secure").value_or(
-      same_site == net::CookieSameSite::NO_RESTRICTION);
-  bool same_party =
-      details.FindBool("sameParty")
-          .value_or(secure && same_site != net::CookieSameSite::STRICT_MODE);
-
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CookieInclusionStatus(
-            net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN)));
-    return handle;
-  }
-
-  net::CookieInclusionStatus status;
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
-      ParseTimeProperty(details.FindDouble("expirationDate")),
-      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
-      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, same_party,
-      absl::nullopt, &status);
-
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(InclusionStatusToString(
-        !status.IsInclude()
-            ? status
-            : net::CookieInclusionStatus(
-                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
-  }
-
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
-  }
-  options.set_same_site_cookie_context(
-      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
 
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
@@ -360,6 +422,121 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   return handle;
 }
 
+v8::Local<v8::Promise> Cookies::GetMany(
+    v8::Isolate* isolate,
+    std::vector<base::Value::Dict> filters) {
+  gin_helper::Promise<std::vector<net::CookieList>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // A single read of the store answers all the filters.
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  manager->GetAllCookies(base::BindOnce(&FilterCookiesMany, std::move(filters),
+                                        std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::SetMany(
+    v8::Isolate* isolate,
+    std::vector<base::Value::Dict> details) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // None of the cookies are set when one of them is invalid.
+  std::vector<std::unique_ptr<net::CanonicalCookie>> cookies(details.size());
+  std::vector<GURL> urls(details.size());
+  std::vector<net::CookieOptions> options(details.size());
+  for (size_t i = 0; i < details.size(); ++i) {
+    std::string error =
+        CreateCookie(details[i], &cookies[i], &urls[i], &options[i]);
+    if (!error.empty()) {
+      promise.RejectWithErrorMessage("Invalid cookie at index " +
+                                     base::NumberToString(i) + ": " + error);
+      return handle;
+    }
+  }
+
+  // The calls are queued on the pipe without waiting for each other, and
+  // their replies come back in order.
+  auto done = base::BarrierCallback<std::string>(
+      cookies.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise,
+             std::vector<std::string> errors) {
+            for (const std::string& error : errors) {
+              if (!error.empty()) {
+                promise.RejectWithErrorMessage(error);
+                return;
+              }
+            }
+            promise.Resolve();
+          },
+          std::move(promise)));
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  for (size_t i = 0; i < cookies.size(); ++i) {
+    manager->SetCanonicalCookie(
+        *cookies[i], urls[i], options[i],
+        base::BindOnce(
+            [](base::RepeatingCallback<void(std::string)> done, size_t index,
+               net::CookieAccessResult r) {
+              if (r.status.IsInclude()) {
+                done.Run(std::string());
+              } else {
+                done.Run("Failed to set cookie at index " +
+                         base::NumberToString(index) + ": " +
+                         std::string(InclusionStatusToString(r.status)));
+              }
+            },
+            done, i));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::RemoveMany(
+    v8::Isolate* isolate,
+    std::vector<gin_helper::Dictionary> cookies) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<network::mojom::CookieDeletionFilterPtr> filters;
+  filters.reserve(cookies.size());
+  for (const gin_helper::Dictionary& cookie : cookies) {
+    auto filter = network::mojom::CookieDeletionFilter::New();
+    GURL url;
+    std::string name;
+    if (!cookie.Get("url", &url) || !cookie.Get("name", &name)) {
+      promise.RejectWithErrorMessage(
+          "Cookies to remove must have a 'url' and a 'name'");
+      return handle;
+    }
+    filter->url = std::move(url);
+    filter->cookie_name = std::move(name);
+    filters.push_back(std::move(filter));
+  }
+
+  auto done = base::BarrierClosure(
+      filters.size(), base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                                     std::move(promise)));
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  for (auto& filter : filters) {
+    manager->DeleteCookies(
+        std::move(filter),
+        base::BindOnce([](base::RepeatingClosure done,
+                          uint32_t num_deleted) { done.Run(); },
+                       done));
+  }
+
+  return handle;
+}
+
+void Cookies::SetChangedFilter(std::vector<base::Value::Dict> filters) {
+  changed_filters_ = std::move(filters);
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -374,6 +551,13 @@ v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
 }
 
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  // The changes no filter asks for never reach JavaScript.
+  if (!changed_filters_.empty() &&
+      base::ranges::none_of(changed_filters_, [&](const auto& filter) {
+        return MatchesCookie(filter, change.cookie);
+      })) {
+    return;
+  }
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   Emit("changed", gin::ConvertToV8(isolate, change.cookie),
@@ -395,6 +579,10 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
+      .SetMethod("getMany", &Cookies::GetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("setChangedFilter", &Cookies::SetChangedFilter)
       .SetMethod("flushStore", &Cookies::FlushStore);
 }
 
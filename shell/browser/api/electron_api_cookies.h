@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
 #include "base/memory/raw_ptr.h"
@@ -53,13 +54,27 @@ class Cookies : public gin::Wrappable<Cookies>,
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
+  // Batched versions of the above. GetMany reads the store once for all the
+  // filters, SetMany and RemoveMany queue their calls without waiting for
+  // each other.
+  v8::Local<v8::Promise> GetMany(v8::Isolate*,
+                                 std::vector<base::Value::Dict> filters);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*,
+                                 std::vector<base::Value::Dict> details);
+  v8::Local<v8::Promise> RemoveMany(
+      v8::Isolate*,
+      std::vector<gin_helper::Dictionary> cookies);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
+  // Only emits the changed event for the cookies matching one of |filters|,
+  // or for all of them when it is empty.
+  void SetChangedFilter(std::vector<base::Value::Dict> filters);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
   base::CallbackListSubscription cookie_change_subscription_;
+  std::vector<base::Value::Dict> changed_filters_;
 
   // Weak reference; ElectronBrowserContext is guaranteed to outlive us.
   raw_ptr<ElectronBrowserContext> browser_context_;
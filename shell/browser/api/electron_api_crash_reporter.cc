@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,6 +37,7 @@
 #include "components/crash/core/browser/crash_upload_list_crashpad.h"  // nogncheck
 #include "components/crash/core/common/crash_key.h"
 #include "shell/app/electron_crash_reporter_client.h"
+#include "shell/browser/api/crash_upload_scheduler.h"
 #include "shell/common/crash_keys.h"
 #include "third_party/crashpad/crashpad/client/crashpad_info.h"  // nogncheck
 #endif
@@ -62,6 +64,15 @@ std::map<std::string, std::string>& GetGlobalCrashKeysMutable() {
 
 bool g_crash_reporter_initialized = false;
 
+#if !IS_MAS_BUILD()
+std::unique_ptr<electron::api::CrashUploadScheduler>& GetUploadScheduler() {
+  static base::NoDestructor<
+      std::unique_ptr<electron::api::CrashUploadScheduler>>
+      scheduler;
+  return *scheduler;
+}
+#endif
+
 }  // namespace
 
 namespace electron::api::crash_reporter {
@@ -131,7 +142,9 @@ void Start(const std::string& submit_url,
            bool compress,
            const std::map<std::string, std::string>& global_extra,
            const std::map<std::string, std::string>& extra,
-           bool is_node_process) {
+           bool is_node_process,
+           uint32_t referenced_memory_limit,
+           uint32_t extra_parameters_budget) {
   TRACE_EVENT0("electron", "crash_reporter::Start");
 #if !IS_MAS_BUILD()
   if (g_crash_reporter_initialized)
@@ -143,6 +156,10 @@ void Start(const std::string& submit_url,
   ElectronCrashReporterClient::Get()->SetShouldRateLimit(rate_limit);
   ElectronCrashReporterClient::Get()->SetShouldCompressUploads(compress);
   ElectronCrashReporterClient::Get()->SetGlobalAnnotations(global_extra);
+  ElectronCrashReporterClient::Get()->SetReferencedMemoryLimit(
+      referenced_memory_limit);
+  if (extra_parameters_budget)
+    electron::crash_keys::SetCrashKeysBudget(extra_parameters_budget);
   std::string process_type = is_node_process ? "node" : GetProcessType();
 #if BUILDFLAG(IS_LINUX)
   for (const auto& pair : extra)
@@ -234,8 +251,32 @@ v8::Local<v8::Value> GetUploadedReports(v8::Isolate* isolate) {
 }
 #endif
 
+#if !IS_MAS_BUILD()
+// Called after start() when uploadSchedule is given, which passed false for
+// |upload_to_server| so that the handler leaves the reports to the
+// scheduler.
+void StartUploadScheduler(bool upload_to_server,
+                          double interval,
+                          double idle_time,
+                          uint32_t max_uploads_per_hour,
+                          bool allow_cellular) {
+  electron::api::CrashUploadScheduler::Options options;
+  options.interval = base::Milliseconds(interval);
+  options.idle_time = base::Seconds(idle_time);
+  options.max_uploads_per_hour = max_uploads_per_hour;
+  options.allow_cellular = allow_cellular;
+  auto& scheduler = GetUploadScheduler();
+  scheduler = std::make_unique<electron::api::CrashUploadScheduler>(options);
+  scheduler->SetEnabled(upload_to_server);
+}
+#endif
+
 void SetUploadToServer(bool upload) {
 #if !IS_MAS_BUILD()
+  if (GetUploadScheduler()) {
+    GetUploadScheduler()->SetEnabled(upload);
+    return;
+  }
   ElectronCrashReporterClient::Get()->SetCollectStatsConsent(upload);
 #endif
 }
@@ -244,6 +285,8 @@ bool GetUploadToServer() {
 #if IS_MAS_BUILD()
   return false;
 #else
+  if (GetUploadScheduler())
+    return GetUploadScheduler()->IsEnabled();
   return ElectronCrashReporterClient::Get()->GetCollectStatsConsent();
 #endif
 }
@@ -272,6 +315,9 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("getParameters", &GetParameters);
   dict.SetMethod("getUploadedReports", &GetUploadedReports);
   dict.SetMethod("setUploadToServer", &SetUploadToServer);
+#if !IS_MAS_BUILD()
+  dict.SetMethod("startUploadScheduler", &StartUploadScheduler);
+#endif
   dict.SetMethod("getUploadToServer", &GetUploadToServer);
 }
 
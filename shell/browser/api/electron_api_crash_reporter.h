@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_CRASH_REPORTER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_CRASH_REPORTER_H_
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include "base/files/file_path.h"
@@ -26,7 +27,9 @@ void Start(const std::string& submit_url,
            bool compress,
            const std::map<std::string, std::string>& global_extra,
            const std::map<std::string, std::string>& extra,
-           bool is_node_process);
+           bool is_node_process,
+           uint32_t referenced_memory_limit,
+           uint32_t extra_parameters_budget);
 
 }  // namespace electron::api::crash_reporter
 
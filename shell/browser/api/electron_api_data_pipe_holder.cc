@@ -4,17 +4,24 @@
 
 #include "shell/browser/api/electron_api_data_pipe_holder.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
+#include "base/files/file.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequence_bound.h"
+#include "gin/object_template_builder.h"
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/simple_watcher.h"
 #include "net/base/net_errors.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/key_weak_map.h"
 
@@ -27,6 +34,9 @@ namespace {
 // Incremental ID.
 int g_next_id = 0;
 
+// The most data a chunk of DataPipeHolder::Read holds.
+constexpr uint32_t kMaxChunkSize = 64 * 1024;
+
 // Map that manages all the DataPipeHolder objects.
 KeyWeakMap<std::string>& AllDataPipeHolders() {
   static base::NoDestructor<KeyWeakMap<std::string>> weak_map;
@@ -138,8 +148,285 @@ class DataPipeReader {
   base::WeakPtrFactory<DataPipeReader> weak_factory_{this};
 };
 
+// Writes the data of a pipe to a file, lives on a worker sequence.
+class DataPipeFileWriter {
+ public:
+  // Called with the number of bytes written, or with absl::nullopt when the
+  // pipe or the file failed.
+  using DoneCallback = base::OnceCallback<void(absl::optional<uint64_t>)>;
+
+  DataPipeFileWriter(mojo::ScopedDataPipeConsumerHandle data_pipe,
+                     const base::FilePath& path,
+                     DoneCallback done)
+      : data_pipe_(std::move(data_pipe)),
+        file_(path, base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE),
+        handle_watcher_(FROM_HERE,
+                        mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                        base::SequencedTaskRunner::GetCurrentDefault()),
+        done_(std::move(done)) {
+    if (!file_.IsValid()) {
+      std::move(done_).Run(absl::nullopt);
+      return;
+    }
+    handle_watcher_.Watch(
+        data_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+        base::BindRepeating(&DataPipeFileWriter::OnHandleReadable,
+                            base::Unretained(this)));
+    handle_watcher_.ArmOrNotify();
+  }
+
+  ~DataPipeFileWriter() = default;
+
+  // disable copy
+  DataPipeFileWriter(const DataPipeFileWriter&) = delete;
+  DataPipeFileWriter& operator=(const DataPipeFileWriter&) = delete;
+
+ private:
+  void OnHandleReadable(MojoResult result) {
+    while (done_) {
+      const void* buffer = nullptr;
+      uint32_t available = 0;
+      result = data_pipe_->BeginReadData(&buffer, &available,
+                                         MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        handle_watcher_.ArmOrNotify();
+        return;
+      }
+      if (result != MOJO_RESULT_OK) {
+        // The producer closes the pipe once it wrote all of the data.
+        handle_watcher_.Cancel();
+        if (result == MOJO_RESULT_FAILED_PRECONDITION && file_.Flush())
+          std::move(done_).Run(written_);
+        else
+          std::move(done_).Run(absl::nullopt);
+        return;
+      }
+      const int count = file_.WriteAtCurrentPos(
+          static_cast<const char*>(buffer), static_cast<int>(available));
+      data_pipe_->EndReadData(available);
+      if (count != static_cast<int>(available)) {
+        handle_watcher_.Cancel();
+        std::move(done_).Run(absl::nullopt);
+        return;
+      }
+      written_ += available;
+    }
+  }
+
+  mojo::ScopedDataPipeConsumerHandle data_pipe_;
+  base::File file_;
+  mojo::SimpleWatcher handle_watcher_;
+  DoneCallback done_;
+  uint64_t written_ = 0;
+};
+
+// Writes the data of a DataPipeGetter to a file, deletes itself once done.
+class DataPipeToFile {
+ public:
+  DataPipeToFile(gin_helper::Promise<void> promise,
+                 mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter,
+                 const base::FilePath& path)
+      : promise_(std::move(promise)),
+        data_pipe_getter_(std::move(data_pipe_getter)) {
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    mojo::ScopedDataPipeConsumerHandle consumer_handle;
+    CHECK_EQ(mojo::CreateDataPipe(nullptr, producer_handle, consumer_handle),
+             MOJO_RESULT_OK);
+    data_pipe_getter_->Read(std::move(producer_handle),
+                            base::BindOnce(&DataPipeToFile::ReadCallback,
+                                           weak_factory_.GetWeakPtr()));
+    writer_ = base::SequenceBound<DataPipeFileWriter>(
+        base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+        std::move(consumer_handle), path,
+        base::BindPostTaskToCurrentDefault(base::BindOnce(
+            &DataPipeToFile::OnWritten, weak_factory_.GetWeakPtr())));
+  }
+
+  ~DataPipeToFile() = default;
+
+  // disable copy
+  DataPipeToFile(const DataPipeToFile&) = delete;
+  DataPipeToFile& operator=(const DataPipeToFile&) = delete;
+
+ private:
+  // Callback invoked by DataPipeGetter::Read.
+  void ReadCallback(int32_t status, uint64_t size) {
+    if (status != net::OK) {
+      OnFailure();
+      return;
+    }
+    size_ = size;
+    MaybeFinish();
+  }
+
+  void OnWritten(absl::optional<uint64_t> written) {
+    if (!written) {
+      OnFailure();
+      return;
+    }
+    written_ = written;
+    MaybeFinish();
+  }
+
+  void MaybeFinish() {
+    if (!size_ || !written_)
+      return;
+    if (*size_ != *written_) {
+      OnFailure();
+      return;
+    }
+    promise_.Resolve();
+    delete this;
+  }
+
+  void OnFailure() {
+    promise_.RejectWithErrorMessage("Could not write blob data");
+    delete this;
+  }
+
+  gin_helper::Promise<void> promise_;
+  mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter_;
+  base::SequenceBound<DataPipeFileWriter> writer_;
+  absl::optional<uint64_t> size_;
+  absl::optional<uint64_t> written_;
+
+  base::WeakPtrFactory<DataPipeToFile> weak_factory_{this};
+};
+
 }  // namespace
 
+// Reads the data pipe a chunk at a time for DataPipeHolder::Read.
+class DataPipeHolder::StreamReader {
+ public:
+  explicit StreamReader(
+      mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter)
+      : data_pipe_getter_(std::move(data_pipe_getter)),
+        handle_watcher_(FROM_HERE,
+                        mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                        base::SequencedTaskRunner::GetCurrentDefault()) {
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    CHECK_EQ(mojo::CreateDataPipe(nullptr, producer_handle, data_pipe_),
+             MOJO_RESULT_OK);
+    data_pipe_getter_->Read(std::move(producer_handle),
+                            base::BindOnce(&StreamReader::ReadCallback,
+                                           weak_factory_.GetWeakPtr()));
+    handle_watcher_.Watch(data_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+                          base::BindRepeating(&StreamReader::OnHandleReadable,
+                                              weak_factory_.GetWeakPtr()));
+  }
+
+  ~StreamReader() = default;
+
+  // disable copy
+  StreamReader(const StreamReader&) = delete;
+  StreamReader& operator=(const StreamReader&) = delete;
+
+  void Read(gin_helper::Promise<v8::Local<v8::Value>> promise) {
+    if (pending_read_) {
+      promise.RejectWithErrorMessage("The previous read is not done");
+      return;
+    }
+    pending_read_ = std::move(promise);
+    Pump();
+  }
+
+ private:
+  // Callback invoked by DataPipeGetter::Read.
+  void ReadCallback(int32_t status, uint64_t size) {
+    status_ = status;
+    size_ = size;
+    Pump();
+  }
+
+  void OnHandleReadable(MojoResult result) { Pump(); }
+
+  void Pump() {
+    if (!pending_read_)
+      return;
+    if (status_ && *status_ != net::OK) {
+      Reject();
+      return;
+    }
+    if (!data_pipe_) {
+      Finish();
+      return;
+    }
+
+    const void* buffer = nullptr;
+    uint32_t available = 0;
+    MojoResult result = data_pipe_->BeginReadData(&buffer, &available,
+                                                   MOJO_READ_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_SHOULD_WAIT) {
+      handle_watcher_.ArmOrNotify();
+      return;
+    }
+    if (result != MOJO_RESULT_OK) {
+      // The producer closes the pipe once it wrote all of the data, the end
+      // is only known once it also told the size.
+      handle_watcher_.Cancel();
+      data_pipe_.reset();
+      if (result == MOJO_RESULT_FAILED_PRECONDITION)
+        Finish();
+      else
+        Reject();
+      return;
+    }
+
+    const uint32_t length = std::min(available, kMaxChunkSize);
+    gin_helper::Promise<v8::Local<v8::Value>> promise =
+        std::move(*pending_read_);
+    pending_read_.reset();
+    read_ += length;
+    {
+      v8::HandleScope handle_scope(promise.isolate());
+      promise.Resolve(node::Buffer::Copy(promise.isolate(),
+                                         static_cast<const char*>(buffer),
+                                         length)
+                          .ToLocalChecked());
+    }
+    data_pipe_->EndReadData(length);
+  }
+
+  // Resolves the pending read with the end of the data once the size is
+  // known.
+  void Finish() {
+    if (!status_)
+      return;
+    if (read_ != size_) {
+      Reject();
+      return;
+    }
+    gin_helper::Promise<v8::Local<v8::Value>> promise =
+        std::move(*pending_read_);
+    pending_read_.reset();
+    v8::HandleScope handle_scope(promise.isolate());
+    promise.Resolve(v8::Null(promise.isolate()));
+  }
+
+  void Reject() {
+    handle_watcher_.Cancel();
+    data_pipe_.reset();
+    gin_helper::Promise<v8::Local<v8::Value>> promise =
+        std::move(*pending_read_);
+    pending_read_.reset();
+    promise.RejectWithErrorMessage("Could not get blob data");
+  }
+
+  mojo::Remote<network::mojom::DataPipeGetter> data_pipe_getter_;
+  mojo::ScopedDataPipeConsumerHandle data_pipe_;
+  mojo::SimpleWatcher handle_watcher_;
+
+  absl::optional<gin_helper::Promise<v8::Local<v8::Value>>> pending_read_;
+  // Set by DataPipeGetter::Read.
+  absl::optional<int32_t> status_;
+  uint64_t size_ = 0;
+  uint64_t read_ = 0;
+
+  base::WeakPtrFactory<StreamReader> weak_factory_{this};
+};
+
 gin::WrapperInfo DataPipeHolder::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 DataPipeHolder::DataPipeHolder(const network::DataElement& element)
@@ -162,6 +449,41 @@ v8::Local<v8::Promise> DataPipeHolder::ReadAll(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Promise> DataPipeHolder::Read(v8::Isolate* isolate) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!stream_reader_) {
+    if (!data_pipe_) {
+      promise.RejectWithErrorMessage("Could not get blob data");
+      return handle;
+    }
+    stream_reader_ = std::make_unique<StreamReader>(std::move(data_pipe_));
+  }
+
+  stream_reader_->Read(std::move(promise));
+  return handle;
+}
+
+v8::Local<v8::Promise> DataPipeHolder::WriteToFile(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!data_pipe_) {
+    promise.RejectWithErrorMessage("Could not write blob data");
+    return handle;
+  }
+
+  new DataPipeToFile(std::move(promise), std::move(data_pipe_), path);
+  return handle;
+}
+
+gin::ObjectTemplateBuilder DataPipeHolder::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<DataPipeHolder>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("read", &DataPipeHolder::Read);
+}
+
 // static
 gin::Handle<DataPipeHolder> DataPipeHolder::Create(
     v8::Isolate* isolate,
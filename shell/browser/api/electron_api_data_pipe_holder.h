@@ -5,8 +5,10 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DATA_PIPE_HOLDER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DATA_PIPE_HOLDER_H_
 
+#include <memory>
 #include <string>
 
+#include "base/files/file_path.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -32,6 +34,15 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
   // no one has complained about it yet.
   v8::Local<v8::Promise> ReadAll(v8::Isolate* isolate);
 
+  // Read the next chunk of data, resolves with null once all of it was read.
+  // The data is only read from the blob as fast as the chunks are asked for.
+  v8::Local<v8::Promise> Read(v8::Isolate* isolate);
+
+  // Write all data to |path| on a worker sequence, without going through the
+  // memory of the UI thread.
+  v8::Local<v8::Promise> WriteToFile(v8::Isolate* isolate,
+                                     const base::FilePath& path);
+
   // The unique ID that can be used to receive the object.
   const std::string& id() const { return id_; }
 
@@ -40,11 +51,18 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
   DataPipeHolder& operator=(const DataPipeHolder&) = delete;
 
  private:
+  class StreamReader;
+
+  // gin::Wrappable
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+
   explicit DataPipeHolder(const network::DataElement& element);
   ~DataPipeHolder() override;
 
   std::string id_;
   mojo::Remote<network::mojom::DataPipeGetter> data_pipe_;
+  std::unique_ptr<StreamReader> stream_reader_;
 };
 
 }  // namespace electron::api
@@ -6,21 +6,77 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/rand_util.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
+#include "third_party/inspector_protocol/crdtp/cbor.h"
+#include "third_party/inspector_protocol/crdtp/json.h"
 
 using content::DevToolsAgentHost;
 
 namespace electron::api {
 
+namespace {
+
+// The top level fields of a protocol message.
+struct MessageEnvelope {
+  absl::optional<int> id;
+  std::string method;
+  std::string session_id;
+};
+
+std::string ToString(crdtp::span<uint8_t> string8) {
+  return std::string(reinterpret_cast<const char*>(string8.data()),
+                     string8.size());
+}
+
+// Reads the top level fields of a CBOR message without decoding its params
+// or result, which are skipped as a whole.
+bool ParseEnvelope(base::span<const uint8_t> message,
+                   MessageEnvelope* envelope) {
+  crdtp::cbor::CBORTokenizer tokenizer(
+      crdtp::span<uint8_t>(message.data(), message.size()));
+  if (tokenizer.TokenTag() != crdtp::cbor::CBORTokenTag::ENVELOPE)
+    return false;
+  tokenizer.EnterEnvelope();
+  if (tokenizer.TokenTag() != crdtp::cbor::CBORTokenTag::MAP_START)
+    return false;
+  tokenizer.Next();
+  while (tokenizer.TokenTag() == crdtp::cbor::CBORTokenTag::STRING8) {
+    const std::string key = ToString(tokenizer.GetString8());
+    tokenizer.Next();
+    const crdtp::cbor::CBORTokenTag tag = tokenizer.TokenTag();
+    if (key == "id" && tag == crdtp::cbor::CBORTokenTag::INT32) {
+      envelope->id = tokenizer.GetInt32();
+    } else if (key == "method" && tag == crdtp::cbor::CBORTokenTag::STRING8) {
+      envelope->method = ToString(tokenizer.GetString8());
+    } else if (key == "sessionId" &&
+               tag == crdtp::cbor::CBORTokenTag::STRING8) {
+      envelope->session_id = ToString(tokenizer.GetString8());
+    } else if (tag == crdtp::cbor::CBORTokenTag::MAP_START ||
+               tag == crdtp::cbor::CBORTokenTag::ARRAY_START) {
+      // Containers which aren't wrapped in an envelope can't be skipped.
+      return true;
+    }
+    // Envelopes are skipped with their contents.
+    tokenizer.Next();
+  }
+  return tokenizer.TokenTag() != crdtp::cbor::CBORTokenTag::ERROR_VALUE;
+}
+
+}  // namespace
+
 gin::WrapperInfo Debugger::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
@@ -42,8 +98,36 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
 
-  base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
-                                message.size());
+  // Events are filtered before anything is decoded.
+  MessageEnvelope envelope;
+  if (!ParseEnvelope(message, &envelope))
+    return;
+  const bool is_event = !envelope.id;
+  if (is_event &&
+      (envelope.method.empty() || !ShouldEmitEvent(envelope.method))) {
+    return;
+  }
+  if (is_event && message_format_ == MessageFormat::kCBOR) {
+    Emit("raw-message", envelope.method,
+         node::Buffer::Copy(isolate,
+                            reinterpret_cast<const char*>(message.data()),
+                            message.size())
+             .ToLocalChecked(),
+         envelope.session_id);
+    return;
+  }
+
+  std::string message_str;
+  if (!crdtp::json::ConvertCBORToJSON(
+           crdtp::span<uint8_t>(message.data(), message.size()), &message_str)
+           .ok()) {
+    return;
+  }
+  if (is_event && message_format_ == MessageFormat::kJSON) {
+    Emit("raw-message", envelope.method, message_str, envelope.session_id);
+    return;
+  }
+
   absl::optional<base::Value> parsed_message = base::JSONReader::Read(
       message_str, base::JSON_REPLACE_INVALID_CHARACTERS);
   if (!parsed_message || !parsed_message->is_dict())
@@ -77,6 +161,12 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
   }
 }
 
+bool Debugger::UsesBinaryProtocol() {
+  // The agent host speaks CBOR, which lets events be filtered by reading
+  // their method without decoding them.
+  return true;
+}
+
 void Debugger::RenderFrameHostChanged(content::RenderFrameHost* old_rfh,
                                       content::RenderFrameHost* new_rfh) {
   if (agent_host_) {
@@ -161,8 +251,9 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
 
   std::string json_args;
   base::JSONWriter::Write(request, &json_args);
-  agent_host_->DispatchProtocolMessage(
-      this, base::as_bytes(base::make_span(json_args)));
+  std::vector<uint8_t> cbor_args;
+  crdtp::json::ConvertJSONToCBOR(crdtp::SpanFrom(json_args), &cbor_args);
+  agent_host_->DispatchProtocolMessage(this, cbor_args);
 
   return handle;
 }
@@ -173,6 +264,72 @@ void Debugger::ClearPendingRequests() {
   pending_requests_.clear();
 }
 
+void Debugger::SetEventFilter(gin::Arguments* args) {
+  v8::Local<v8::Value> value = args->PeekNext();
+  if (value.IsEmpty() || value->IsNullOrUndefined()) {
+    has_event_filter_ = false;
+    filter_methods_.clear();
+    filter_domains_.clear();
+    sample_rate_ = 1;
+    return;
+  }
+  gin_helper::Dictionary filter;
+  if (!args->GetNext(&filter)) {
+    args->ThrowTypeError("Filter must be an object or null.");
+    return;
+  }
+  std::vector<std::string> methods;
+  const bool has_methods = filter.Has("methods");
+  if (has_methods && !filter.Get("methods", &methods)) {
+    args->ThrowTypeError("methods must be an array of strings.");
+    return;
+  }
+  double sample_rate = 1;
+  if (filter.Has("sampleRate") &&
+      (!filter.Get("sampleRate", &sample_rate) || !(sample_rate >= 0) ||
+       sample_rate > 1)) {
+    args->ThrowTypeError("sampleRate must be a number between 0 and 1.");
+    return;
+  }
+
+  has_event_filter_ = has_methods;
+  filter_methods_.clear();
+  filter_domains_.clear();
+  for (std::string& method : methods) {
+    if (base::EndsWith(method, ".*")) {
+      method.resize(method.size() - 2);
+      filter_domains_.insert(std::move(method));
+    } else {
+      filter_methods_.insert(std::move(method));
+    }
+  }
+  sample_rate_ = sample_rate;
+}
+
+void Debugger::SetMessageFormat(gin::Arguments* args,
+                                const std::string& format) {
+  if (format == "object") {
+    message_format_ = MessageFormat::kObject;
+  } else if (format == "json") {
+    message_format_ = MessageFormat::kJSON;
+  } else if (format == "cbor") {
+    message_format_ = MessageFormat::kCBOR;
+  } else {
+    args->ThrowTypeError("format must be one of object, json or cbor.");
+  }
+}
+
+bool Debugger::ShouldEmitEvent(const std::string& method) const {
+  if (has_event_filter_ && !filter_methods_.contains(method)) {
+    const size_t dot = method.find('.');
+    if (dot == std::string::npos ||
+        !filter_domains_.contains(method.substr(0, dot))) {
+      return false;
+    }
+  }
+  return sample_rate_ >= 1 || base::RandDouble() < sample_rate_;
+}
+
 // static
 gin::Handle<Debugger> Debugger::Create(v8::Isolate* isolate,
                                        content::WebContents* web_contents) {
@@ -186,7 +343,9 @@ gin::ObjectTemplateBuilder Debugger::GetObjectTemplateBuilder(
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("setEventFilter", &Debugger::SetEventFilter)
+      .SetMethod("setMessageFormat", &Debugger::SetMessageFormat);
 }
 
 const char* Debugger::GetTypeName() {
@@ -6,7 +6,9 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 
 #include <map>
+#include <string>
 
+#include "base/containers/flat_set.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/values.h"
@@ -51,6 +53,7 @@ class Debugger : public gin::Wrappable<Debugger>,
   void AgentHostClosed(content::DevToolsAgentHost* agent_host) override;
   void DispatchProtocolMessage(content::DevToolsAgentHost* agent_host,
                                base::span<const uint8_t> message) override;
+  bool UsesBinaryProtocol() override;
 
   // content::WebContentsObserver:
   void RenderFrameHostChanged(content::RenderFrameHost* old_rfh,
@@ -60,17 +63,31 @@ class Debugger : public gin::Wrappable<Debugger>,
   using PendingRequestMap =
       std::map<int, gin_helper::Promise<base::Value::Dict>>;
 
+  // How events are emitted, see debugger.setMessageFormat().
+  enum class MessageFormat { kObject, kJSON, kCBOR };
+
   void Attach(gin::Arguments* args);
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin::Arguments* args);
   void ClearPendingRequests();
+  void SetEventFilter(gin::Arguments* args);
+  void SetMessageFormat(gin::Arguments* args, const std::string& format);
+  // Whether the event |method| passes the filter set with setEventFilter().
+  bool ShouldEmitEvent(const std::string& method) const;
 
   raw_ptr<content::WebContents> web_contents_;  // Weak Reference.
   scoped_refptr<content::DevToolsAgentHost> agent_host_;
 
   PendingRequestMap pending_requests_;
   int previous_request_id_ = 0;
+
+  bool has_event_filter_ = false;
+  base::flat_set<std::string> filter_methods_;
+  // The domains of the "Domain.*" entries of the filter.
+  base::flat_set<std::string> filter_domains_;
+  double sample_rate_ = 1;
+  MessageFormat message_format_ = MessageFormat::kObject;
 };
 
 }  // namespace electron::api
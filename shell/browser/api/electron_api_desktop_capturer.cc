@@ -4,11 +4,16 @@
 
 #include "shell/browser/api/electron_api_desktop_capturer.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "base/containers/contains.h"
+#include "base/containers/cxx20_erase.h"
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
@@ -175,16 +180,60 @@ struct Converter<electron::api::DesktopCapturer::Source> {
 
 namespace electron::api {
 
+// Observes one of the watched lists. The ids of its sources are mirrored, as
+// the lists only report the index of the sources which are removed.
+class DesktopCapturer::ListWatcher : public DesktopMediaListObserver {
+ public:
+  ListWatcher(DesktopCapturer* capturer, std::unique_ptr<DesktopMediaList> list)
+      : capturer_(capturer), list_(std::move(list)) {}
+  ~ListWatcher() override = default;
+
+  // disable copy
+  ListWatcher(const ListWatcher&) = delete;
+  ListWatcher& operator=(const ListWatcher&) = delete;
+
+  void Start() { list_->StartUpdating(this); }
+
+  DesktopMediaList* list() const { return list_.get(); }
+
+  // DesktopMediaListObserver:
+  void OnSourceAdded(int index) override {
+    ids_.insert(ids_.begin() + index, list_->GetSource(index).id);
+    capturer_->OnWatchedSourceAdded(this, index);
+  }
+  void OnSourceRemoved(int index) override {
+    const content::DesktopMediaID id = ids_[index];
+    ids_.erase(ids_.begin() + index);
+    capturer_->OnWatchedSourceRemoved(id);
+  }
+  void OnSourceMoved(int old_index, int new_index) override {
+    const content::DesktopMediaID id = ids_[old_index];
+    ids_.erase(ids_.begin() + old_index);
+    ids_.insert(ids_.begin() + new_index, id);
+  }
+  void OnSourceNameChanged(int index) override {
+    capturer_->OnWatchedSourceNameChanged(this, index);
+  }
+  void OnSourceThumbnailChanged(int index) override {
+    capturer_->OnWatchedThumbnailChanged(list_->GetSource(index).id);
+  }
+  void OnSourcePreviewChanged(size_t index) override {}
+  void OnDelegatedSourceListSelection() override {}
+  void OnDelegatedSourceListDismissed() override {}
+
+ private:
+  raw_ptr<DesktopCapturer> capturer_;
+  std::unique_ptr<DesktopMediaList> list_;
+  std::vector<content::DesktopMediaID> ids_;
+};
+
 gin::WrapperInfo DesktopCapturer::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {}
 
 DesktopCapturer::~DesktopCapturer() = default;
 
-void DesktopCapturer::StartHandling(bool capture_window,
-                                    bool capture_screen,
-                                    const gfx::Size& thumbnail_size,
-                                    bool fetch_window_icons) {
+void DesktopCapturer::InitializeCapture(bool fetch_window_icons) {
   fetch_window_icons_ = fetch_window_icons;
 #if BUILDFLAG(IS_WIN)
   if (content::desktop_capture::CreateDesktopCaptureOptions()
@@ -195,6 +244,13 @@ void DesktopCapturer::StartHandling(bool capture_window,
     using_directx_capturer_ = webrtc::ScreenCapturerWinDirectx::IsSupported();
   }
 #endif  // BUILDFLAG(IS_WIN)
+}
+
+void DesktopCapturer::StartHandling(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons) {
+  InitializeCapture(fetch_window_icons);
 
   // clear any existing captured sources.
   captured_sources_.clear();
@@ -258,59 +314,15 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
     for (int i = 0; i < list->GetSourceCount(); i++) {
       screen_sources.emplace_back(list->GetSource(i), std::string());
     }
-#if BUILDFLAG(IS_WIN)
-    // Gather the same unique screen IDs used by the electron.screen API in
-    // order to provide an association between it and
-    // desktopCapturer/getUserMedia. This is only required when using the
-    // DirectX capturer, otherwise the IDs across the APIs already match.
-    if (using_directx_capturer_) {
-      std::vector<std::string> device_names;
-      // Crucially, this list of device names will be in the same order as
-      // |media_list_sources|.
-      if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
-              &device_names)) {
-        v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-        v8::HandleScope scope(isolate);
-        gin_helper::CallMethod(this, "_onerror", "Failed to get sources.");
-
-        Unpin();
-
-        return;
-      }
+    if (!SetScreenDisplayIds(&screen_sources)) {
+      v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+      v8::HandleScope scope(isolate);
+      gin_helper::CallMethod(this, "_onerror", "Failed to get sources.");
 
-      int device_name_index = 0;
-      for (auto& source : screen_sources) {
-        const auto& device_name = device_names[device_name_index++];
-        std::wstring wide_device_name;
-        base::UTF8ToWide(device_name.c_str(), device_name.size(),
-                         &wide_device_name);
-        const int64_t device_id =
-            display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
-                wide_device_name.c_str());
-        source.display_id = base::NumberToString(device_id);
-      }
-    }
-#elif BUILDFLAG(IS_MAC)
-    // On Mac, the IDs across the APIs match.
-    for (auto& source : screen_sources) {
-      source.display_id = base::NumberToString(source.media_list_source.id.id);
-    }
-#elif BUILDFLAG(IS_LINUX)
-#if defined(USE_OZONE_PLATFORM_X11)
-    // On Linux, with X11, the source id is the numeric value of the
-    // display name atom and the display id is either the EDID or the
-    // loop index when that display was found (see
-    // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
-    std::map<int32_t, uint32_t> monitor_atom_to_display_id =
-        MonitorAtomIdToDisplayId();
-    for (auto& source : screen_sources) {
-      auto display_id_iter =
-          monitor_atom_to_display_id.find(source.media_list_source.id.id);
-      if (display_id_iter != monitor_atom_to_display_id.end())
-        source.display_id = base::NumberToString(display_id_iter->second);
+      Unpin();
+
+      return;
     }
-#endif  // defined(USE_OZONE_PLATFORM_X11)
-#endif  // BUILDFLAG(IS_WIN)
     std::move(screen_sources.begin(), screen_sources.end(),
               std::back_inserter(captured_sources_));
   }
@@ -324,6 +336,186 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   }
 }
 
+bool DesktopCapturer::SetScreenDisplayIds(
+    std::vector<DesktopCapturer::Source>* sources) {
+#if BUILDFLAG(IS_WIN)
+  // Gather the same unique screen IDs used by the electron.screen API in
+  // order to provide an association between it and
+  // desktopCapturer/getUserMedia. This is only required when using the
+  // DirectX capturer, otherwise the IDs across the APIs already match.
+  if (using_directx_capturer_) {
+    std::vector<std::string> device_names;
+    // Crucially, this list of device names will be in the same order as
+    // |media_list_sources|.
+    if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+            &device_names)) {
+      return false;
+    }
+
+    for (size_t i = 0; i < sources->size() && i < device_names.size(); i++) {
+      const auto& device_name = device_names[i];
+      std::wstring wide_device_name;
+      base::UTF8ToWide(device_name.c_str(), device_name.size(),
+                       &wide_device_name);
+      const int64_t device_id =
+          display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
+              wide_device_name.c_str());
+      (*sources)[i].display_id = base::NumberToString(device_id);
+    }
+  }
+#elif BUILDFLAG(IS_MAC)
+  // On Mac, the IDs across the APIs match.
+  for (auto& source : *sources) {
+    source.display_id = base::NumberToString(source.media_list_source.id.id);
+  }
+#elif BUILDFLAG(IS_LINUX)
+#if defined(USE_OZONE_PLATFORM_X11)
+  // On Linux, with X11, the source id is the numeric value of the
+  // display name atom and the display id is either the EDID or the
+  // loop index when that display was found (see
+  // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
+  std::map<int32_t, uint32_t> monitor_atom_to_display_id =
+      MonitorAtomIdToDisplayId();
+  for (auto& source : *sources) {
+    auto display_id_iter =
+        monitor_atom_to_display_id.find(source.media_list_source.id.id);
+    if (display_id_iter != monitor_atom_to_display_id.end())
+      source.display_id = base::NumberToString(display_id_iter->second);
+  }
+#endif  // defined(USE_OZONE_PLATFORM_X11)
+#endif  // BUILDFLAG(IS_WIN)
+  return true;
+}
+
+void DesktopCapturer::StartWatching(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons,
+                                    int refresh_interval_ms,
+                                    int max_thumbnail_updates) {
+  InitializeCapture(fetch_window_icons);
+  min_thumbnail_interval_ =
+      base::Seconds(1) / std::max(max_thumbnail_updates, 1);
+
+  std::vector<std::unique_ptr<DesktopMediaList>> lists;
+  if (capture_window) {
+    if (auto capturer = content::desktop_capture::CreateWindowCapturer();
+        capturer) {
+      lists.push_back(std::make_unique<NativeDesktopMediaList>(
+          DesktopMediaList::Type::kWindow, std::move(capturer)));
+    }
+  }
+  if (capture_screen) {
+    if (auto capturer = content::desktop_capture::CreateScreenCapturer();
+        capturer) {
+      lists.push_back(std::make_unique<NativeDesktopMediaList>(
+          DesktopMediaList::Type::kScreen, std::move(capturer)));
+    }
+  }
+
+  for (auto& list : lists) {
+    list->SetThumbnailSize(thumbnail_size);
+    // The lists enumerate the sources and capture every thumbnail once per
+    // period.
+    list->SetUpdatePeriod(
+        base::Milliseconds(std::max(refresh_interval_ms, 100)));
+    list_watchers_.push_back(
+        std::make_unique<ListWatcher>(this, std::move(list)));
+    list_watchers_.back()->Start();
+  }
+}
+
+void DesktopCapturer::StopWatching() {
+  thumbnail_timer_.Stop();
+  pending_thumbnails_.clear();
+  list_watchers_.clear();
+  Unpin();
+}
+
+void DesktopCapturer::OnWatchedSourceAdded(ListWatcher* watcher, int index) {
+  DesktopMediaList* list = watcher->list();
+  const bool is_window =
+      list->GetMediaListType() == DesktopMediaList::Type::kWindow;
+  DesktopCapturer::Source source{list->GetSource(index), std::string(),
+                                 is_window && fetch_window_icons_};
+  if (!is_window) {
+    // The display ids are found from the position of the screens in the list.
+    std::vector<DesktopCapturer::Source> screen_sources;
+    for (int i = 0; i < list->GetSourceCount(); i++)
+      screen_sources.emplace_back(list->GetSource(i), std::string());
+    if (SetScreenDisplayIds(&screen_sources))
+      source.display_id = screen_sources[index].display_id;
+  }
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, "_onsourceadded", source);
+}
+
+void DesktopCapturer::OnWatchedSourceRemoved(
+    const content::DesktopMediaID& id) {
+  base::Erase(pending_thumbnails_, id);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, "_onsourceremoved", id.ToString());
+}
+
+void DesktopCapturer::OnWatchedSourceNameChanged(ListWatcher* watcher,
+                                                 int index) {
+  const DesktopMediaList::Source& source = watcher->list()->GetSource(index);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, "_onsourcenamechanged", source.id.ToString(),
+                         base::UTF16ToUTF8(source.name));
+}
+
+void DesktopCapturer::OnWatchedThumbnailChanged(
+    const content::DesktopMediaID& id) {
+  if (!base::Contains(pending_thumbnails_, id))
+    pending_thumbnails_.push_back(id);
+  if (thumbnail_timer_.IsRunning())
+    return;
+
+  // The thumbnails which change within the same interval are reported
+  // together.
+  const base::TimeDelta delay =
+      std::max(base::TimeDelta(), last_thumbnail_update_ +
+                                      min_thumbnail_interval_ -
+                                      base::TimeTicks::Now());
+  // Unretained is safe as |thumbnail_timer_| is owned by |this|.
+  thumbnail_timer_.Start(FROM_HERE, delay,
+                         base::BindOnce(&DesktopCapturer::FlushThumbnails,
+                                        base::Unretained(this)));
+}
+
+void DesktopCapturer::FlushThumbnails() {
+  last_thumbnail_update_ = base::TimeTicks::Now();
+  std::vector<content::DesktopMediaID> pending_thumbnails;
+  pending_thumbnails.swap(pending_thumbnails_);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  std::vector<gin_helper::Dictionary> updates;
+  for (const auto& watcher : list_watchers_) {
+    DesktopMediaList* list = watcher->list();
+    for (int i = 0; i < list->GetSourceCount(); i++) {
+      const DesktopMediaList::Source& source = list->GetSource(i);
+      if (!base::Contains(pending_thumbnails, source.id))
+        continue;
+      auto update = gin_helper::Dictionary::CreateEmpty(isolate);
+      update.Set("id", source.id.ToString());
+      update.Set("thumbnail",
+                 electron::api::NativeImage::Create(
+                     isolate, gfx::Image(source.thumbnail)));
+      updates.push_back(update);
+    }
+  }
+  if (!updates.empty())
+    gin_helper::CallMethod(this, "_onthumbnailschanged", updates);
+}
+
 // static
 gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
   auto handle = gin::CreateHandle(isolate, new DesktopCapturer(isolate));
@@ -337,7 +529,9 @@ gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
 gin::ObjectTemplateBuilder DesktopCapturer::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<DesktopCapturer>::GetObjectTemplateBuilder(isolate)
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("startWatching", &DesktopCapturer::StartWatching)
+      .SetMethod("stopWatching", &DesktopCapturer::StopWatching);
 }
 
 const char* DesktopCapturer::GetTypeName() {
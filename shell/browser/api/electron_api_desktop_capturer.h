@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/media/webrtc/desktop_media_list_observer.h"
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "gin/handle.h"
@@ -37,6 +39,17 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
                      const gfx::Size& thumbnail_size,
                      bool fetch_window_icons);
 
+  // Keeps the sources up to date until StopWatching is called. The sources
+  // are reported as soon as they are enumerated, and their thumbnails as they
+  // are produced, at most |max_thumbnail_updates| times per second.
+  void StartWatching(bool capture_window,
+                     bool capture_screen,
+                     const gfx::Size& thumbnail_size,
+                     bool fetch_window_icons,
+                     int refresh_interval_ms,
+                     int max_thumbnail_updates);
+  void StopWatching();
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -62,7 +75,19 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   void OnDelegatedSourceListDismissed() override {}
 
  private:
+  class ListWatcher;
+
+  void InitializeCapture(bool fetch_window_icons);
   void UpdateSourcesList(DesktopMediaList* list);
+  // Returns false if the display ids of the screens could not be found.
+  bool SetScreenDisplayIds(std::vector<DesktopCapturer::Source>* sources);
+
+  // Called by the ListWatchers.
+  void OnWatchedSourceAdded(ListWatcher* watcher, int index);
+  void OnWatchedSourceRemoved(const content::DesktopMediaID& id);
+  void OnWatchedSourceNameChanged(ListWatcher* watcher, int index);
+  void OnWatchedThumbnailChanged(const content::DesktopMediaID& id);
+  void FlushThumbnails();
 
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
@@ -70,6 +95,13 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+
+  std::vector<std::unique_ptr<ListWatcher>> list_watchers_;
+  // The sources whose thumbnail changed since the last update.
+  std::vector<content::DesktopMediaID> pending_thumbnails_;
+  base::TimeDelta min_thumbnail_interval_;
+  base::TimeTicks last_thumbnail_update_;
+  base::OneShotTimer thumbnail_timer_;
 #if BUILDFLAG(IS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // BUILDFLAG(IS_WIN)
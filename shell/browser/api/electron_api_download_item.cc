@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/strings/utf_string_conversions.h"
+#include "gin/arguments.h"
 #include "net/base/filename_util.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/common/gin_converters/file_dialog_converter.h"
@@ -109,9 +110,31 @@ void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (download_item_->IsDone()) {
     Emit("done", item->GetState());
     Unpin();
-  } else {
-    Emit("updated", item->GetState());
+    return;
+  }
+  Emit("updated", item->GetState());
+
+  // The download can be destroyed by the listeners of 'updated'.
+  if (!download_item_ ||
+      download_item_->GetState() != download::DownloadItem::IN_PROGRESS ||
+      download_item_->IsPaused()) {
+    return;
   }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const int64_t received_bytes = download_item_->GetReceivedBytes();
+  if (!last_progress_.is_null() &&
+      (now - last_progress_ < progress_interval_ ||
+       received_bytes - last_progress_received_bytes_ < progress_bytes_)) {
+    return;
+  }
+  last_progress_ = now;
+  last_progress_received_bytes_ = received_bytes;
+  v8::HandleScope handle_scope(isolate_);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate_);
+  details.Set("receivedBytes", received_bytes);
+  details.Set("totalBytes", download_item_->GetTotalBytes());
+  details.Set("bytesPerSecond", download_item_->CurrentSpeed());
+  Emit("progress", details);
 }
 
 void DownloadItem::OnDownloadDestroyed(download::DownloadItem* /*item*/) {
@@ -248,6 +271,13 @@ double DownloadItem::GetStartTime() const {
   return download_item_->GetStartTime().ToDoubleT();
 }
 
+void DownloadItem::SetProgressInterval(double interval_ms,
+                                       gin::Arguments* args) {
+  progress_interval_ = base::Milliseconds(interval_ms);
+  progress_bytes_ = 0;
+  args->GetNext(&progress_bytes_);
+}
+
 // static
 gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
@@ -276,7 +306,8 @@ gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
       .SetMethod("getSaveDialogOptions", &DownloadItem::GetSaveDialogOptions)
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
-      .SetMethod("getStartTime", &DownloadItem::GetStartTime);
+      .SetMethod("getStartTime", &DownloadItem::GetStartTime)
+      .SetMethod("setProgressInterval", &DownloadItem::SetProgressInterval);
 }
 
 const char* DownloadItem::GetTypeName() {
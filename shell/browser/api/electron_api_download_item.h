@@ -10,6 +10,7 @@
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -19,6 +20,10 @@
 
 class GURL;
 
+namespace gin {
+class Arguments;
+}
+
 namespace electron::api {
 
 class DownloadItem : public gin::Wrappable<DownloadItem>,
@@ -76,11 +81,19 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   std::string GetLastModifiedTime() const;
   std::string GetETag() const;
   double GetStartTime() const;
+  void SetProgressInterval(double interval_ms, gin::Arguments* args);
 
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
   raw_ptr<download::DownloadItem> download_item_;
 
+  // The 'progress' event is emitted at most once per |progress_interval_|,
+  // and once at least |progress_bytes_| more bytes were received.
+  base::TimeDelta progress_interval_ = base::Seconds(1);
+  int64_t progress_bytes_ = 0;
+  base::TimeTicks last_progress_;
+  int64_t last_progress_received_bytes_ = 0;
+
   raw_ptr<v8::Isolate> isolate_;
 
   base::WeakPtrFactory<DownloadItem> weak_factory_{this};
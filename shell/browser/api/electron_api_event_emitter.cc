@@ -4,11 +4,17 @@
 
 #include "shell/browser/api/electron_api_event_emitter.h"
 
+#include <map>
+#include <string>
+
+#include "base/containers/flat_map.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/dictionary.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/node_includes.h"
 #include "v8/include/v8.h"
 
@@ -19,9 +25,33 @@ v8::Global<v8::Object>* GetEventEmitterPrototypeReference() {
   return event_emitter_prototype.get();
 }
 
+v8::Global<v8::Value>* GetEmitReference() {
+  static base::NoDestructor<v8::Global<v8::Value>> emit;
+  return emit.get();
+}
+
+// The emissions skipped because there was no listener, by event name.
+base::flat_map<std::string, uint64_t, std::less<>>& GetSkippedEmits() {
+  static base::NoDestructor<base::flat_map<std::string, uint64_t, std::less<>>>
+      skipped_emits;
+  return *skipped_emits;
+}
+
 void SetEventEmitterPrototype(v8::Isolate* isolate,
                               v8::Local<v8::Object> proto) {
   GetEventEmitterPrototypeReference()->Reset(isolate, proto);
+  v8::Local<v8::Value> emit;
+  if (proto
+          ->Get(isolate->GetCurrentContext(),
+                gin::StringToSymbol(isolate, "emit"))
+          .ToLocal(&emit)) {
+    GetEmitReference()->Reset(isolate, emit);
+  }
+}
+
+std::map<std::string, uint64_t> GetSkippedEmitCounts() {
+  const auto& skipped_emits = GetSkippedEmits();
+  return {skipped_emits.begin(), skipped_emits.end()};
 }
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -33,6 +63,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin::Dictionary dict(isolate, exports);
   dict.Set("setEventEmitterPrototype",
            base::BindRepeating(&SetEventEmitterPrototype));
+  dict.Set("getSkippedEmitCounts", base::BindRepeating(&GetSkippedEmitCounts));
 }
 
 }  // namespace
@@ -44,6 +75,42 @@ v8::Local<v8::Object> GetEventEmitterPrototype(v8::Isolate* isolate) {
   return GetEventEmitterPrototypeReference()->Get(isolate);
 }
 
+bool ShouldEmitEvent(v8::Isolate* isolate,
+                     v8::Local<v8::Object> emitter,
+                     base::StringPiece name) {
+  // Emitting 'error' without a listener throws, which has to keep happening.
+  if (name == "error" || GetEmitReference()->IsEmpty())
+    return true;
+  v8::Local<v8::Context> context = emitter->GetCreationContextChecked();
+  v8::Local<v8::Value> emit;
+  if (!emitter->Get(context, gin::StringToSymbol(isolate, "emit"))
+           .ToLocal(&emit) ||
+      emit != GetEmitReference()->Get(isolate)) {
+    return true;
+  }
+  v8::Local<v8::Value> events;
+  if (!emitter->Get(context, gin::StringToSymbol(isolate, "_events"))
+           .ToLocal(&events)) {
+    return true;
+  }
+  // The table is only created with the first listener.
+  if (events->IsObject() &&
+      events.As<v8::Object>()
+          ->HasOwnProperty(context, gin::StringToV8(isolate, name))
+          .FromMaybe(true)) {
+    return true;
+  }
+
+  auto& skipped_emits = GetSkippedEmits();
+  auto it = skipped_emits.find(name);
+  if (it == skipped_emits.end())
+    it = skipped_emits.emplace(std::string(name), 0).first;
+  it->second++;
+  TRACE_EVENT_INSTANT1("electron", "SkippedEmit", TRACE_EVENT_SCOPE_THREAD,
+                       "name", std::string(name));
+  return false;
+}
+
 }  // namespace electron
 
 NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_event_emitter, Initialize)
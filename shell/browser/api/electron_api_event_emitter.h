@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_EVENT_EMITTER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_EVENT_EMITTER_H_
 
+#include "base/strings/string_piece.h"
+
 namespace v8 {
 template <typename T>
 class Local;
@@ -16,6 +18,15 @@ namespace electron {
 
 v8::Local<v8::Object> GetEventEmitterPrototype(v8::Isolate* isolate);
 
+// Returns false when |emitter| has no listener for the |name| event, so that
+// emitting it can be skipped before the arguments are converted. The
+// listeners are looked up in the table kept by Node's EventEmitter, which is
+// always up to date. Emitters whose emit() was replaced, to forward their
+// events elsewhere, always get their events.
+bool ShouldEmitEvent(v8::Isolate* isolate,
+                     v8::Local<v8::Object> emitter,
+                     base::StringPiece name);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_EVENT_EMITTER_H_
@@ -0,0 +1,249 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_file_watcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/flat_set.h"
+#include "base/files/file_path_watcher.h"
+#include "base/functional/bind.h"
+#include "base/strings/pattern.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/timer/timer.h"
+#include "build/build_config.h"
+#include "gin/handle.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/node_includes.h"
+
+namespace electron::api {
+
+namespace {
+
+// The paths kept per coalescing window, past which only the watched path is
+// reported.
+constexpr size_t kMaxPendingChanges = 4096;
+
+constexpr base::TimeDelta kMaxCoalesceWindow = base::Seconds(10);
+
+}  // namespace
+
+class FileWatcher::Core {
+ public:
+  using ChangesCallback =
+      base::RepeatingCallback<void(std::vector<base::FilePath> paths)>;
+  using ErrorCallback =
+      base::RepeatingCallback<void(const std::string& message)>;
+
+  Core(const Options& options,
+       ChangesCallback on_changes,
+       ErrorCallback on_error)
+      : options_(options),
+        on_changes_(std::move(on_changes)),
+        on_error_(std::move(on_error)) {
+    base::FilePathWatcher::WatchOptions watch_options;
+    watch_options.type = options_.recursive
+                             ? base::FilePathWatcher::Type::kRecursive
+                             : base::FilePathWatcher::Type::kNonRecursive;
+#if BUILDFLAG(IS_WIN)
+    // Reports the paths which changed instead of the watched one.
+    watch_options.report_modified_path = true;
+#endif
+    // Unretained is safe as |watcher_| is owned by |this|.
+    if (!watcher_.WatchWithOptions(
+            options_.path, watch_options,
+            base::BindRepeating(&Core::OnPathChanged,
+                                base::Unretained(this)))) {
+      on_error_.Run("Failed to watch " + options_.path.AsUTF8Unsafe());
+    }
+  }
+
+  // disable copy
+  Core(const Core&) = delete;
+  Core& operator=(const Core&) = delete;
+
+ private:
+  void OnPathChanged(const base::FilePath& path, bool error) {
+    if (error) {
+      on_error_.Run("Failed to watch " + options_.path.AsUTF8Unsafe());
+      return;
+    }
+    if (IsIgnored(path))
+      return;
+
+    if (!overflowed_ && pending_.size() >= kMaxPendingChanges) {
+      overflowed_ = true;
+      pending_.clear();
+    }
+    if (!overflowed_)
+      pending_.insert(path);
+    // The window starts with its first change, so that a stream of changes
+    // is still emitted every |coalesce_window|.
+    if (!coalesce_timer_.IsRunning()) {
+      // Unretained is safe as |coalesce_timer_| is owned by |this|.
+      coalesce_timer_.Start(
+          FROM_HERE, options_.coalesce_window,
+          base::BindOnce(&Core::Deliver, base::Unretained(this)));
+    }
+  }
+
+  void Deliver() {
+    std::vector<base::FilePath> paths;
+    if (overflowed_)
+      paths.push_back(options_.path);
+    else
+      paths = std::move(pending_).extract();
+    pending_.clear();
+    overflowed_ = false;
+    on_changes_.Run(std::move(paths));
+  }
+
+  // Whether |path| or one of the directories it is in, relative to the
+  // watched path, matches an ignore pattern.
+  bool IsIgnored(const base::FilePath& path) const {
+    if (options_.ignore.empty())
+      return false;
+    base::FilePath relative;
+    if (!options_.path.AppendRelativePath(path, &relative))
+      return false;
+    std::string prefix;
+    for (const auto& component : relative.GetComponents()) {
+      if (!prefix.empty())
+        prefix.push_back('/');
+      prefix.append(base::FilePath(component).AsUTF8Unsafe());
+      for (const std::string& pattern : options_.ignore) {
+        if (base::MatchPattern(prefix, pattern))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  const Options options_;
+  ChangesCallback on_changes_;
+  ErrorCallback on_error_;
+
+  base::FilePathWatcher watcher_;
+  base::flat_set<base::FilePath> pending_;
+  // Set when more than |kMaxPendingChanges| paths changed in the window.
+  bool overflowed_ = false;
+  base::OneShotTimer coalesce_timer_;
+};
+
+gin::WrapperInfo FileWatcher::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+FileWatcher::Options::Options() = default;
+FileWatcher::Options::Options(const Options&) = default;
+FileWatcher::Options& FileWatcher::Options::operator=(const Options&) =
+    default;
+FileWatcher::Options::~Options() = default;
+
+FileWatcher::FileWatcher(v8::Isolate* isolate, const Options& options)
+    : options_(options) {
+  core_ = base::SequenceBound<Core>(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+      options_,
+      base::BindPostTaskToCurrentDefault(base::BindRepeating(
+          &FileWatcher::OnChanges, weak_factory_.GetWeakPtr())),
+      base::BindPostTaskToCurrentDefault(base::BindRepeating(
+          &FileWatcher::OnError, weak_factory_.GetWeakPtr())));
+  // The watcher emits its events until it is closed.
+  Pin(isolate);
+}
+
+FileWatcher::~FileWatcher() = default;
+
+// static
+gin::Handle<FileWatcher> FileWatcher::New(gin_helper::ErrorThrower thrower,
+                                          gin::Arguments* args) {
+  Options options;
+  if (!args->GetNext(&options.path) || options.path.empty()) {
+    thrower.ThrowTypeError("The path must be a non-empty string");
+    return gin::Handle<FileWatcher>();
+  }
+  gin_helper::Dictionary opts;
+  if (args->GetNext(&opts)) {
+    opts.Get("recursive", &options.recursive);
+    double coalesce_window = 0;
+    if (opts.Get("coalesceWindow", &coalesce_window)) {
+      options.coalesce_window =
+          std::clamp(base::Milliseconds(coalesce_window), base::TimeDelta(),
+                     kMaxCoalesceWindow);
+    }
+    if (opts.Has("ignore") && !opts.Get("ignore", &options.ignore)) {
+      thrower.ThrowTypeError("ignore must be an array of strings");
+      return gin::Handle<FileWatcher>();
+    }
+  }
+  return gin::CreateHandle(thrower.isolate(),
+                           new FileWatcher(thrower.isolate(), options));
+}
+
+void FileWatcher::Close() {
+  if (core_.is_null())
+    return;
+  // The watcher is destroyed on its sequence.
+  core_.Reset();
+  Unpin();
+}
+
+bool FileWatcher::IsWatching() const {
+  return !core_.is_null();
+}
+
+base::FilePath FileWatcher::GetPath() const {
+  return options_.path;
+}
+
+void FileWatcher::OnChanges(std::vector<base::FilePath> paths) {
+  // Changes can still arrive after Close().
+  if (core_.is_null())
+    return;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("change", paths);
+}
+
+void FileWatcher::OnError(const std::string& message) {
+  if (core_.is_null())
+    return;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("watch-error", message);
+}
+
+void FileWatcher::FillObjectTemplate(v8::Isolate* isolate,
+                                     v8::Local<v8::ObjectTemplate> templ) {
+  gin::ObjectTemplateBuilder(isolate, "FileWatcher", templ)
+      .SetMethod("close", &FileWatcher::Close)
+      .SetProperty("watching", &FileWatcher::IsWatching)
+      .SetProperty("path", &FileWatcher::GetPath)
+      .Build();
+}
+
+}  // namespace electron::api
+
+namespace {
+
+using electron::api::FileWatcher;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  gin_helper::Dictionary dict(isolate, exports);
+  dict.Set("FileWatcher", FileWatcher::GetConstructor(context));
+}
+
+}  // namespace
+
+NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_file_watcher, Initialize)
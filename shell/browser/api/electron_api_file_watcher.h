@@ -0,0 +1,92 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_FILE_WATCHER_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_FILE_WATCHER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "gin/wrappable.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/cleaned_up_at_exit.h"
+#include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/pinnable.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron::api {
+
+// Watches a file or a directory tree with base::FilePathWatcher, which uses
+// inotify, FSEvents or ReadDirectoryChangesW, on a sequence of its own. The
+// changes are filtered by the ignore patterns and coalesced there, and
+// emitted as one list per coalescing window.
+class FileWatcher : public gin::Wrappable<FileWatcher>,
+                    public gin_helper::EventEmitterMixin<FileWatcher>,
+                    public gin_helper::Constructible<FileWatcher>,
+                    public gin_helper::Pinnable<FileWatcher>,
+                    public gin_helper::CleanedUpAtExit {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    base::FilePath path;
+    bool recursive = false;
+    // How long the changes are collected for after the first one, before
+    // they are emitted.
+    base::TimeDelta coalesce_window = base::Milliseconds(100);
+    // Patterns of the paths relative to |path| whose changes are dropped.
+    std::vector<std::string> ignore;
+  };
+
+  // gin_helper::Constructible
+  static gin::Handle<FileWatcher> New(gin_helper::ErrorThrower thrower,
+                                      gin::Arguments* args);
+  static void FillObjectTemplate(v8::Isolate*, v8::Local<v8::ObjectTemplate>);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+
+  // disable copy
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+ protected:
+  FileWatcher(v8::Isolate* isolate, const Options& options);
+  ~FileWatcher() override;
+
+  // JS API
+  void Close();
+  bool IsWatching() const;
+  base::FilePath GetPath() const;
+
+ private:
+  class Core;
+
+  void OnChanges(std::vector<base::FilePath> paths);
+  void OnError(const std::string& message);
+
+  const Options options_;
+
+  // Lives on a sequence of its own, reset by Close().
+  base::SequenceBound<Core> core_;
+
+  base::WeakPtrFactory<FileWatcher> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_FILE_WATCHER_H_
@@ -34,7 +34,8 @@ bool RegisteringMediaKeyForUntrustedClient(const ui::Accelerator& accelerator) {
 }
 
 bool MapHasMediaKeys(
-    const std::map<ui::Accelerator, base::RepeatingClosure>& accelerator_map) {
+    const accelerator_util::AcceleratorIndex<base::RepeatingClosure>&
+        accelerator_map) {
   auto media_key = std::find_if(
       accelerator_map.begin(), accelerator_map.end(),
       [](const auto& ac) { return Command::IsMediaKey(ac.first); });
@@ -56,13 +57,17 @@ GlobalShortcut::~GlobalShortcut() {
 }
 
 void GlobalShortcut::OnKeyPressed(const ui::Accelerator& accelerator) {
-  if (!base::Contains(accelerator_callback_map_, accelerator)) {
+  auto it = accelerator_callback_map_.find(accelerator);
+  if (it == accelerator_callback_map_.end()) {
     // This should never occur, because if it does, GlobalShortcutListener
     // notifies us with wrong accelerator.
     NOTREACHED();
     return;
   }
-  accelerator_callback_map_[accelerator].Run();
+  // The callback can register or unregister shortcuts, which invalidates
+  // |it|.
+  base::RepeatingClosure callback = it->second;
+  callback.Run();
 }
 
 bool GlobalShortcut::RegisterAll(
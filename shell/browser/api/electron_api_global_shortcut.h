@@ -5,13 +5,13 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_GLOBAL_SHORTCUT_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_GLOBAL_SHORTCUT_H_
 
-#include <map>
 #include <vector>
 
 #include "base/functional/callback.h"
 #include "chrome/browser/extensions/global_shortcut_listener.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/ui/accelerator_util.h"
 #include "ui/base/accelerators/accelerator.h"
 
 namespace electron::api {
@@ -36,7 +36,7 @@ class GlobalShortcut : public extensions::GlobalShortcutListener::Observer,
   ~GlobalShortcut() override;
 
  private:
-  typedef std::map<ui::Accelerator, base::RepeatingClosure>
+  typedef accelerator_util::AcceleratorIndex<base::RepeatingClosure>
       AcceleratorCallbackMap;
 
   bool RegisterAll(const std::vector<ui::Accelerator>& accelerators,
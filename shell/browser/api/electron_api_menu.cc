@@ -194,6 +194,10 @@ void Menu::SetIcon(int index, const gfx::Image& image) {
   model_->SetIcon(index, ui::ImageModel::FromImage(image));
 }
 
+void Menu::SetLabel(int index, const std::u16string& label) {
+  model_->SetLabel(index, label);
+}
+
 void Menu::SetSublabel(int index, const std::u16string& sublabel) {
   model_->SetSecondaryLabel(index, sublabel);
 }
@@ -206,6 +210,10 @@ void Menu::SetRole(int index, const std::u16string& role) {
   model_->SetRole(index, role);
 }
 
+void Menu::NotifyItemChanged(int index) {
+  model_->NotifyItemChanged(index);
+}
+
 void Menu::Clear() {
   model_->Clear();
 }
@@ -276,9 +284,11 @@ void Menu::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("insertSeparator", &Menu::InsertSeparatorAt)
       .SetMethod("insertSubMenu", &Menu::InsertSubMenuAt)
       .SetMethod("setIcon", &Menu::SetIcon)
+      .SetMethod("setLabel", &Menu::SetLabel)
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
+      .SetMethod("_notifyItemChanged", &Menu::NotifyItemChanged)
       .SetMethod("clear", &Menu::Clear)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
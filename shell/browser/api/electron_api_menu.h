@@ -105,9 +105,11 @@ class Menu : public gin::Wrappable<Menu>,
                        const std::u16string& label,
                        Menu* menu);
   void SetIcon(int index, const gfx::Image& image);
+  void SetLabel(int index, const std::u16string& label);
   void SetSublabel(int index, const std::u16string& sublabel);
   void SetToolTip(int index, const std::u16string& toolTip);
   void SetRole(int index, const std::u16string& role);
+  void NotifyItemChanged(int index);
   void Clear();
   int GetIndexOfCommandId(int command_id) const;
   int GetItemCount() const;
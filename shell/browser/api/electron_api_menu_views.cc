@@ -7,8 +7,11 @@
 #include <memory>
 #include <utility>
 
+#include "base/task/sequenced_task_runner.h"
 #include "shell/browser/native_window_views.h"
+#include "shell/browser/ui/views/menu_model_adapter.h"
 #include "ui/display/screen.h"
+#include "ui/views/controls/menu/menu_item_view.h"
 
 using views::MenuRunner;
 
@@ -43,17 +46,23 @@ void MenuViews::PopupAt(BaseWindow* window,
   // has run.
   base::OnceClosure callback_with_ref = BindSelfToClosure(std::move(callback));
 
-  // Show the menu.
+  // Show the menu. Only its top level items are built here, so that large
+  // menus open as fast as small ones.
   //
-  // Note that while views::MenuRunner accepts RepeatingCallback as close
+  // Note that while views::MenuModelAdapter accepts RepeatingCallback as close
   // callback, it is fine passing OnceCallback to it because we reset the
   // menu runner immediately when the menu is closed.
   int32_t window_id = window->weak_map_id();
   auto close_callback = base::AdaptCallbackForRepeating(
       base::BindOnce(&MenuViews::OnClosed, weak_factory_.GetWeakPtr(),
                      window_id, std::move(callback_with_ref)));
-  menu_runners_[window_id] =
-      std::make_unique<MenuRunner>(model(), flags, std::move(close_callback));
+  auto adapter = std::make_unique<MenuModelAdapter>(
+      model(), false /* use_default_accelerator */, std::move(close_callback));
+  auto* menu = new views::MenuItemView(adapter.get());
+  adapter->BuildMenuLazily(menu);
+  menu_runners_[window_id] = std::make_unique<MenuRunner>(menu, flags);
+  ReleaseAdapter(window_id);
+  menu_adapters_[window_id] = std::move(adapter);
   menu_runners_[window_id]->RunMenuAt(
       native_window->widget(), nullptr, gfx::Rect(location, gfx::Size()),
       views::MenuAnchorPosition::kTopLeft, source_type);
@@ -75,9 +84,19 @@ void MenuViews::ClosePopupAt(int32_t window_id) {
 
 void MenuViews::OnClosed(int32_t window_id, base::OnceClosure callback) {
   menu_runners_.erase(window_id);
+  ReleaseAdapter(window_id);
   std::move(callback).Run();
 }
 
+void MenuViews::ReleaseAdapter(int32_t window_id) {
+  auto adapter = menu_adapters_.find(window_id);
+  if (adapter == menu_adapters_.end())
+    return;
+  base::SequencedTaskRunner::GetCurrentDefault()->DeleteSoon(
+      FROM_HERE, std::move(adapter->second));
+  menu_adapters_.erase(adapter);
+}
+
 // static
 gin::Handle<Menu> Menu::New(gin::Arguments* args) {
   auto handle = gin::CreateHandle(args->isolate(),
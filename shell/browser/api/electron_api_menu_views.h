@@ -13,6 +13,10 @@
 #include "ui/display/screen.h"
 #include "ui/views/controls/menu/menu_runner.h"
 
+namespace electron {
+class MenuModelAdapter;
+}
+
 namespace electron::api {
 
 class MenuViews : public Menu {
@@ -31,9 +35,12 @@ class MenuViews : public Menu {
 
  private:
   void OnClosed(int32_t window_id, base::OnceClosure callback);
+  // The menu items can still use their adapter while they are closing.
+  void ReleaseAdapter(int32_t window_id);
 
   // window ID -> open context menu
   std::map<int32_t, std::unique_ptr<views::MenuRunner>> menu_runners_;
+  std::map<int32_t, std::unique_ptr<MenuModelAdapter>> menu_adapters_;
 
   base::WeakPtrFactory<MenuViews> weak_factory_{this};
 };
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/files/file_path.h"
@@ -17,9 +18,12 @@
 #include "electron/electron_version.h"
 #include "gin/object_template_builder.h"
 #include "net/log/net_log_capture_mode.h"
+#include "shell/browser/api/net_log_capture.h"
+#include "shell/browser/api/websocket_meter.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/net/system_network_context_manager.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
@@ -89,6 +93,18 @@ NetLog::NetLog(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
 
 NetLog::~NetLog() = default;
 
+namespace {
+
+base::Value::Dict GetCustomConstants() {
+  auto command_line_string =
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
+  auto channel_string = std::string("Electron " ELECTRON_VERSION);
+  return net_log::GetPlatformConstantsForNetLog(command_line_string,
+                                                channel_string);
+}
+
+}  // namespace
+
 v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
                                             gin::Arguments* args) {
   if (log_path.empty()) {
@@ -128,11 +144,7 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
       absl::make_optional<gin_helper::Promise<void>>(args->isolate());
   v8::Local<v8::Promise> handle = pending_start_promise_->GetHandle();
 
-  auto command_line_string =
-      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
-  auto channel_string = std::string("Electron " ELECTRON_VERSION);
-  base::Value::Dict custom_constants = net_log::GetPlatformConstantsForNetLog(
-      command_line_string, channel_string);
+  base::Value::Dict custom_constants = GetCustomConstants();
 
   auto* network_context =
       browser_context_->GetDefaultStoragePartition()->GetNetworkContext();
@@ -215,12 +227,197 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::StartCapture(gin::Arguments* args) {
+  NetLogCapture::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    v8::Local<v8::Value> capture_mode_v8;
+    if (dict.Get("captureMode", &capture_mode_v8) &&
+        !gin::ConvertFromV8(args->isolate(), capture_mode_v8,
+                            &options.capture_mode)) {
+      args->ThrowTypeError("Invalid value for captureMode");
+      return v8::Local<v8::Promise>();
+    }
+    double max_size = 0;
+    if (dict.Get("maxSize", &max_size)) {
+      if (max_size < 1) {
+        args->ThrowTypeError("Invalid value for maxSize");
+        return v8::Local<v8::Promise>();
+      }
+      options.max_size = static_cast<size_t>(max_size);
+    }
+    if (dict.Has("sources") && !dict.Get("sources", &options.source_types)) {
+      args->ThrowTypeError("Invalid value for sources");
+      return v8::Local<v8::Promise>();
+    }
+    double flush_interval = 0;
+    if (dict.Get("flushInterval", &flush_interval)) {
+      if (flush_interval <= 0) {
+        args->ThrowTypeError("Invalid value for flushInterval");
+        return v8::Local<v8::Promise>();
+      }
+      options.flush_interval = base::Milliseconds(flush_interval);
+    }
+  }
+
+  if (capture_) {
+    args->ThrowTypeError("There is already a net log capture running");
+    return v8::Local<v8::Promise>();
+  }
+
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Unretained is safe as the capture is owned by |this|, which the browser
+  // context outlives.
+  capture_ = std::make_unique<NetLogCapture>(
+      base::BindRepeating(
+          [](ElectronBrowserContext* browser_context) {
+            return browser_context->GetDefaultStoragePartition()
+                ->GetNetworkContext();
+          },
+          base::Unretained(browser_context_.get())),
+      options, GetCustomConstants());
+  capture_->Start(
+      base::BindOnce(&ResolvePromiseWithNetError, std::move(promise)));
+  return handle;
+}
+
+void NetLog::StopCapture(gin_helper::ErrorThrower thrower) {
+  if (!capture_) {
+    thrower.ThrowError("No net log capture in progress");
+    return;
+  }
+  capture_.reset();
+}
+
+v8::Local<v8::Promise> NetLog::SnapshotCapture(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!capture_) {
+    promise.RejectWithErrorMessage("No net log capture in progress");
+    return handle;
+  }
+
+  base::FilePath path;
+  v8::Local<v8::Value> path_v8 = args->PeekNext();
+  if (!path_v8.IsEmpty() && !path_v8->IsUndefined() &&
+      !args->GetNext(&path)) {
+    promise.RejectWithErrorMessage("The path must be a string");
+    return handle;
+  }
+
+  capture_->Snapshot(
+      path,
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             absl::optional<std::string> json) {
+            if (!json) {
+              promise.RejectWithErrorMessage("Failed to write the net log");
+              return;
+            }
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            if (json->empty()) {
+              promise.Resolve(v8::Undefined(isolate));
+              return;
+            }
+            v8::Local<v8::Context> context = promise.GetContext();
+            v8::Context::Scope context_scope(context);
+            v8::Local<v8::Value> log;
+            if (v8::JSON::Parse(context, gin::StringToV8(isolate, *json))
+                    .ToLocal(&log)) {
+              promise.Resolve(log);
+            } else {
+              promise.RejectWithErrorMessage("Failed to parse the net log");
+            }
+          },
+          std::move(promise)));
+  return handle;
+}
+
+bool NetLog::IsCurrentlyCapturing() const {
+  return !!capture_;
+}
+
+v8::Local<v8::Promise> NetLog::StartWebSocketMeter(gin::Arguments* args) {
+  base::TimeDelta sample_interval = base::Seconds(5);
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double interval = 0;
+    if (dict.Get("sampleInterval", &interval)) {
+      if (interval <= 0) {
+        args->ThrowTypeError("Invalid value for sampleInterval");
+        return v8::Local<v8::Promise>();
+      }
+      sample_interval = base::Milliseconds(interval);
+    }
+  }
+
+  if (websocket_meter_) {
+    args->ThrowTypeError("There is already a WebSocket meter running");
+    return v8::Local<v8::Promise>();
+  }
+
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Unretained is safe as the meter is owned by |this|, which the browser
+  // context outlives.
+  websocket_meter_ = std::make_unique<WebSocketMeter>(
+      base::BindRepeating(
+          [](ElectronBrowserContext* browser_context) {
+            return browser_context->GetDefaultStoragePartition()
+                ->GetNetworkContext();
+          },
+          base::Unretained(browser_context_.get())),
+      sample_interval);
+  websocket_meter_->Start(
+      base::BindOnce(&ResolvePromiseWithNetError, std::move(promise)));
+  return handle;
+}
+
+void NetLog::StopWebSocketMeter(gin_helper::ErrorThrower thrower) {
+  if (!websocket_meter_) {
+    thrower.ThrowError("No WebSocket meter in progress");
+    return;
+  }
+  websocket_meter_.reset();
+}
+
+v8::Local<v8::Value> NetLog::GetWebSocketMetrics(v8::Isolate* isolate) const {
+  std::vector<v8::Local<v8::Value>> sockets;
+  if (websocket_meter_) {
+    for (const WebSocketMeter::Socket& socket : websocket_meter_->sockets()) {
+      gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+      dict.Set("url", socket.url);
+      dict.Set("framesSent", static_cast<double>(socket.frames_sent));
+      dict.Set("framesReceived", static_cast<double>(socket.frames_received));
+      dict.Set("bytesSent", static_cast<double>(socket.bytes_sent));
+      dict.Set("bytesReceived", static_cast<double>(socket.bytes_received));
+      dict.Set("pings", static_cast<double>(socket.pings));
+      dict.Set("pingLatency", socket.ping_latency.InMillisecondsF());
+      dict.Set("closed", socket.closed);
+      sockets.push_back(dict.GetHandle());
+    }
+  }
+  return gin::ConvertToV8(isolate, sockets);
+}
+
 gin::ObjectTemplateBuilder NetLog::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<NetLog>::GetObjectTemplateBuilder(isolate)
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
+      .SetProperty("currentlyCapturing", &NetLog::IsCurrentlyCapturing)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetMethod("startCapture", &NetLog::StartCapture)
+      .SetMethod("stopCapture", &NetLog::StopCapture)
+      .SetMethod("snapshotCapture", &NetLog::SnapshotCapture)
+      .SetMethod("startWebSocketMeter", &NetLog::StartWebSocketMeter)
+      .SetMethod("stopWebSocketMeter", &NetLog::StopWebSocketMeter)
+      .SetMethod("getWebSocketMetrics", &NetLog::GetWebSocketMetrics);
 }
 
 const char* NetLog::GetTypeName() {
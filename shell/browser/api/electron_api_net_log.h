@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NET_LOG_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NET_LOG_H_
 
+#include <memory>
+
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
@@ -15,6 +17,7 @@
 #include "mojo/public/cpp/bindings/remote.h"
 #include "net/log/net_log_capture_mode.h"
 #include "services/network/public/mojom/net_log.mojom.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -28,6 +31,9 @@ class ElectronBrowserContext;
 
 namespace api {
 
+class NetLogCapture;
+class WebSocketMeter;
+
 // The code is referenced from the net_log::NetExportFileWriter class.
 class NetLog : public gin::Wrappable<NetLog> {
  public:
@@ -39,6 +45,15 @@ class NetLog : public gin::Wrappable<NetLog> {
   v8::Local<v8::Promise> StopLogging(gin::Arguments* args);
   bool IsCurrentlyLogging() const;
 
+  v8::Local<v8::Promise> StartCapture(gin::Arguments* args);
+  void StopCapture(gin_helper::ErrorThrower thrower);
+  v8::Local<v8::Promise> SnapshotCapture(gin::Arguments* args);
+  bool IsCurrentlyCapturing() const;
+
+  v8::Local<v8::Promise> StartWebSocketMeter(gin::Arguments* args);
+  void StopWebSocketMeter(gin_helper::ErrorThrower thrower);
+  v8::Local<v8::Value> GetWebSocketMetrics(v8::Isolate* isolate) const;
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -71,6 +86,9 @@ class NetLog : public gin::Wrappable<NetLog> {
 
   scoped_refptr<base::TaskRunner> file_task_runner_;
 
+  std::unique_ptr<NetLogCapture> capture_;
+  std::unique_ptr<WebSocketMeter> websocket_meter_;
+
   base::WeakPtrFactory<NetLog> weak_ptr_factory_{this};
 };
 
@@ -71,6 +71,7 @@ Notification::Notification(gin::Arguments* args) {
     opts.Get("sound", &sound_);
     opts.Get("closeButtonText", &close_button_text_);
     opts.Get("toastXml", &toast_xml_);
+    opts.Get("groupId", &group_id_);
   }
 }
 
@@ -138,6 +139,10 @@ std::u16string Notification::GetToastXml() const {
   return toast_xml_;
 }
 
+std::string Notification::GetGroupId() const {
+  return group_id_;
+}
+
 // Setters
 void Notification::SetTitle(const std::u16string& new_title) {
   title_ = new_title;
@@ -188,6 +193,10 @@ void Notification::SetToastXml(const std::u16string& new_toast_xml) {
   toast_xml_ = new_toast_xml;
 }
 
+void Notification::SetGroupId(const std::string& new_group_id) {
+  group_id_ = new_group_id;
+}
+
 void Notification::NotificationAction(int index) {
   Emit("action", index);
 }
@@ -244,6 +253,7 @@ void Notification::Show() {
       options.close_button_text = close_button_text_;
       options.urgency = urgency_;
       options.toast_xml = toast_xml_;
+      options.tag = group_id_;
       notification_->Show(options);
     }
   }
@@ -279,6 +289,8 @@ void Notification::FillObjectTemplate(v8::Isolate* isolate,
                    &Notification::SetCloseButtonText)
       .SetProperty("toastXml", &Notification::GetToastXml,
                    &Notification::SetToastXml)
+      .SetProperty("groupId", &Notification::GetGroupId,
+                   &Notification::SetGroupId)
       .Build();
 }
 
@@ -77,6 +77,7 @@ class Notification : public gin::Wrappable<Notification>,
   std::vector<electron::NotificationAction> GetActions() const;
   std::u16string GetCloseButtonText() const;
   std::u16string GetToastXml() const;
+  std::string GetGroupId() const;
 
   // Prop Setters
   void SetTitle(const std::u16string& new_title);
@@ -91,6 +92,7 @@ class Notification : public gin::Wrappable<Notification>,
   void SetActions(const std::vector<electron::NotificationAction>& actions);
   void SetCloseButtonText(const std::u16string& text);
   void SetToastXml(const std::u16string& new_toast_xml);
+  void SetGroupId(const std::string& new_group_id);
 
  private:
   std::u16string title_;
@@ -108,6 +110,7 @@ class Notification : public gin::Wrappable<Notification>,
   std::vector<electron::NotificationAction> actions_;
   std::u16string close_button_text_;
   std::u16string toast_xml_;
+  std::string group_id_;
 
   raw_ptr<electron::NotificationPresenter> presenter_;
 
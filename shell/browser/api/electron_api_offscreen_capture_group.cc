@@ -0,0 +1,198 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_offscreen_capture_group.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/cxx20_erase.h"
+#include "base/functional/bind.h"
+#include "gin/handle.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_converters/image_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/node_includes.h"
+#include "ui/gfx/image/image.h"
+
+namespace electron::api {
+
+gin::WrapperInfo OffscreenCaptureGroup::kWrapperInfo = {
+    gin::kEmbedderNativeGin};
+
+OffscreenCaptureGroup::PendingFrame::PendingFrame() = default;
+OffscreenCaptureGroup::PendingFrame::PendingFrame(const PendingFrame&) =
+    default;
+OffscreenCaptureGroup::PendingFrame&
+OffscreenCaptureGroup::PendingFrame::operator=(const PendingFrame&) = default;
+OffscreenCaptureGroup::PendingFrame::~PendingFrame() = default;
+
+OffscreenCaptureGroup::OffscreenCaptureGroup(gin::Arguments* args)
+    : timebase_(base::TimeTicks::Now()) {
+  gin::Dictionary opts(nullptr);
+  if (args->GetNext(&opts)) {
+    int frame_rate = frame_rate_;
+    if (opts.Get("frameRate", &frame_rate))
+      SetFrameRate(frame_rate);
+  }
+}
+
+OffscreenCaptureGroup::~OffscreenCaptureGroup() = default;
+
+// static
+gin::Handle<OffscreenCaptureGroup> OffscreenCaptureGroup::New(
+    gin_helper::ErrorThrower thrower,
+    gin::Arguments* args) {
+  return gin::CreateHandle(thrower.isolate(), new OffscreenCaptureGroup(args));
+}
+
+void OffscreenCaptureGroup::OnPaint(WebContents* web_contents,
+                                    const gfx::Rect& dirty_rect,
+                                    const SkBitmap& bitmap) {
+  auto it = std::find_if(pending_frames_.begin(), pending_frames_.end(),
+                         [web_contents](const PendingFrame& frame) {
+                           return frame.web_contents.get() == web_contents;
+                         });
+  if (it == pending_frames_.end()) {
+    PendingFrame frame;
+    frame.web_contents = web_contents->GetWeakPtr();
+    frame.dirty_rect = dirty_rect;
+    frame.bitmap = bitmap;
+    pending_frames_.push_back(std::move(frame));
+  } else {
+    // Only the latest frame is emitted, its dirty rect has to include what
+    // changed in the frames it replaces.
+    it->dirty_rect.Union(dirty_rect);
+    it->bitmap = bitmap;
+  }
+  ScheduleFlush();
+}
+
+void OffscreenCaptureGroup::RemoveWebContents(WebContents* web_contents) {
+  base::EraseIf(members_, [web_contents](const auto& member) {
+    return !member || member.get() == web_contents;
+  });
+  base::EraseIf(pending_frames_, [web_contents](const PendingFrame& frame) {
+    return !frame.web_contents || frame.web_contents.get() == web_contents;
+  });
+  if (members_.empty()) {
+    flush_timer_.Stop();
+    Unpin();
+  }
+}
+
+void OffscreenCaptureGroup::Add(gin_helper::ErrorThrower thrower,
+                                gin::Handle<WebContents> web_contents) {
+  if (!web_contents->IsOffScreen()) {
+    thrower.ThrowError("The webContents must use offscreen rendering");
+    return;
+  }
+  OffscreenCaptureGroup* group = web_contents->offscreen_capture_group();
+  if (group == this)
+    return;
+  if (group) {
+    thrower.ThrowError("The webContents already belongs to a capture group");
+    return;
+  }
+
+  // The group has to outlive its members for their frames to be emitted.
+  if (members_.empty())
+    Pin(thrower.isolate());
+  members_.push_back(web_contents->GetWeakPtr());
+  web_contents->SetOffscreenCaptureGroup(GetWeakPtr());
+}
+
+void OffscreenCaptureGroup::Remove(gin::Handle<WebContents> web_contents) {
+  if (web_contents->offscreen_capture_group() != this)
+    return;
+  web_contents->SetOffscreenCaptureGroup(nullptr);
+  RemoveWebContents(web_contents.get());
+}
+
+std::vector<WebContents*> OffscreenCaptureGroup::GetWebContents() const {
+  std::vector<WebContents*> result;
+  for (const auto& member : members_) {
+    if (member)
+      result.push_back(member.get());
+  }
+  return result;
+}
+
+int OffscreenCaptureGroup::GetFrameRate() const {
+  return frame_rate_;
+}
+
+void OffscreenCaptureGroup::SetFrameRate(int frame_rate) {
+  frame_rate_ = std::clamp(frame_rate, 1, 240);
+}
+
+void OffscreenCaptureGroup::ScheduleFlush() {
+  if (flush_timer_.IsRunning())
+    return;
+
+  // The frames of all the members which are produced during the same frame
+  // interval are emitted together at its end.
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta interval = base::Seconds(1) / frame_rate_;
+  const base::TimeTicks next_tick = now.SnappedToNextTick(timebase_, interval);
+  // Unretained is safe as |flush_timer_| is owned by |this|.
+  flush_timer_.Start(FROM_HERE, next_tick - now,
+                     base::BindOnce(&OffscreenCaptureGroup::Flush,
+                                    base::Unretained(this)));
+}
+
+void OffscreenCaptureGroup::Flush() {
+  std::vector<PendingFrame> pending_frames;
+  pending_frames.swap(pending_frames_);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<gin_helper::Dictionary> frames;
+  for (const PendingFrame& pending_frame : pending_frames) {
+    if (!pending_frame.web_contents)
+      continue;
+    auto frame = gin_helper::Dictionary::CreateEmpty(isolate);
+    frame.Set("webContents", pending_frame.web_contents.get());
+    frame.Set("dirtyRect", pending_frame.dirty_rect);
+    frame.Set("image", gfx::Image::CreateFrom1xBitmap(pending_frame.bitmap));
+    frames.push_back(frame);
+  }
+  if (!frames.empty())
+    Emit("paint", frames);
+}
+
+void OffscreenCaptureGroup::FillObjectTemplate(
+    v8::Isolate* isolate,
+    v8::Local<v8::ObjectTemplate> templ) {
+  gin::ObjectTemplateBuilder(isolate, "OffscreenCaptureGroup", templ)
+      .SetMethod("add", &OffscreenCaptureGroup::Add)
+      .SetMethod("remove", &OffscreenCaptureGroup::Remove)
+      .SetMethod("getWebContents", &OffscreenCaptureGroup::GetWebContents)
+      .SetProperty("frameRate", &OffscreenCaptureGroup::GetFrameRate,
+                   &OffscreenCaptureGroup::SetFrameRate)
+      .Build();
+}
+
+}  // namespace electron::api
+
+namespace {
+
+using electron::api::OffscreenCaptureGroup;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  gin_helper::Dictionary dict(isolate, exports);
+  dict.Set("OffscreenCaptureGroup",
+           OffscreenCaptureGroup::GetConstructor(context));
+}
+
+}  // namespace
+
+NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_capture_group, Initialize)
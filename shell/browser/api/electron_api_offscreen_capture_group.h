@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_CAPTURE_GROUP_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_CAPTURE_GROUP_H_
+
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/wrappable.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/cleaned_up_at_exit.h"
+#include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/pinnable.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron::api {
+
+class WebContents;
+
+// Collects the frames of several offscreen WebContents and emits them
+// together, at most once per frame interval, instead of one paint event per
+// WebContents and frame.
+class OffscreenCaptureGroup
+    : public gin::Wrappable<OffscreenCaptureGroup>,
+      public gin_helper::EventEmitterMixin<OffscreenCaptureGroup>,
+      public gin_helper::Constructible<OffscreenCaptureGroup>,
+      public gin_helper::Pinnable<OffscreenCaptureGroup>,
+      public gin_helper::CleanedUpAtExit {
+ public:
+  // gin_helper::Constructible
+  static gin::Handle<OffscreenCaptureGroup> New(
+      gin_helper::ErrorThrower thrower,
+      gin::Arguments* args);
+  static void FillObjectTemplate(v8::Isolate*, v8::Local<v8::ObjectTemplate>);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+
+  // disable copy
+  OffscreenCaptureGroup(const OffscreenCaptureGroup&) = delete;
+  OffscreenCaptureGroup& operator=(const OffscreenCaptureGroup&) = delete;
+
+  // Called by the members instead of emitting their own paint event.
+  void OnPaint(WebContents* web_contents,
+               const gfx::Rect& dirty_rect,
+               const SkBitmap& bitmap);
+
+  // Called when a member is destroyed.
+  void RemoveWebContents(WebContents* web_contents);
+
+  base::WeakPtr<OffscreenCaptureGroup> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ protected:
+  explicit OffscreenCaptureGroup(gin::Arguments* args);
+  ~OffscreenCaptureGroup() override;
+
+  // JS API
+  void Add(gin_helper::ErrorThrower thrower,
+           gin::Handle<WebContents> web_contents);
+  void Remove(gin::Handle<WebContents> web_contents);
+  std::vector<WebContents*> GetWebContents() const;
+  int GetFrameRate() const;
+  void SetFrameRate(int frame_rate);
+
+ private:
+  struct PendingFrame {
+    PendingFrame();
+    PendingFrame(const PendingFrame&);
+    PendingFrame& operator=(const PendingFrame&);
+    ~PendingFrame();
+
+    base::WeakPtr<WebContents> web_contents;
+    // The union of the dirty rects of the frames produced since the previous
+    // flush.
+    gfx::Rect dirty_rect;
+    // The latest frame.
+    SkBitmap bitmap;
+  };
+
+  void ScheduleFlush();
+  void Flush();
+
+  std::vector<base::WeakPtr<WebContents>> members_;
+  std::vector<PendingFrame> pending_frames_;
+
+  int frame_rate_ = 60;
+  // The flushes are aligned to the ticks which follow this time.
+  const base::TimeTicks timebase_;
+  base::OneShotTimer flush_timer_;
+
+  base::WeakPtrFactory<OffscreenCaptureGroup> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_CAPTURE_GROUP_H_
@@ -4,6 +4,8 @@
 
 #include "shell/browser/api/electron_api_power_monitor.h"
 
+#include <algorithm>
+
 #include "base/power_monitor/power_monitor.h"
 #include "base/power_monitor/power_monitor_device_source.h"
 #include "base/power_monitor/power_observer.h"
@@ -60,6 +62,15 @@ struct Converter<base::PowerThermalObserver::DeviceThermalState> {
 
 namespace electron::api {
 
+namespace {
+
+// How often the idle time is checked while the system is idle, to notice when
+// it stops being so. While it is active the next check is scheduled for when
+// the threshold would be reached at the earliest instead.
+constexpr base::TimeDelta kIdleEndCheckInterval = base::Seconds(1);
+
+}  // namespace
+
 gin::WrapperInfo PowerMonitor::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 PowerMonitor::PowerMonitor(v8::Isolate* isolate) {
@@ -100,6 +111,9 @@ void PowerMonitor::OnSuspend() {
 
 void PowerMonitor::OnResume() {
   Emit("resume");
+  // The timer may not have advanced while the system was suspended.
+  if (idle_threshold_ > 0)
+    CheckIdleState();
 }
 
 void PowerMonitor::OnThermalStateChange(DeviceThermalState new_state) {
@@ -118,6 +132,38 @@ void PowerMonitor::OnSpeedLimitChange(int speed_limit) {
       gin::DataObjectBuilder(isolate).Set("limit", speed_limit).Build());
 }
 
+void PowerMonitor::SetIdleThreshold(int idle_threshold) {
+  idle_threshold_ = idle_threshold;
+  if (idle_threshold_ > 0) {
+    CheckIdleState();
+  } else {
+    idle_timer_.Stop();
+    is_idle_ = false;
+  }
+}
+
+void PowerMonitor::CheckIdleState() {
+  const int idle_time = ui::CalculateIdleTime();
+  if (!is_idle_ && idle_time >= idle_threshold_) {
+    is_idle_ = true;
+    Emit("idle-start");
+  } else if (is_idle_ && idle_time < idle_threshold_) {
+    is_idle_ = false;
+    Emit("idle-end");
+  }
+  // A listener may have changed the threshold.
+  if (idle_threshold_ <= 0)
+    return;
+
+  const base::TimeDelta delay =
+      is_idle_ ? kIdleEndCheckInterval
+               : base::Seconds(std::max(idle_threshold_ - idle_time, 1));
+  // Unretained is safe as |this| owns the timer.
+  idle_timer_.Start(FROM_HERE, delay,
+                    base::BindOnce(&PowerMonitor::CheckIdleState,
+                                   base::Unretained(this)));
+}
+
 #if BUILDFLAG(IS_LINUX)
 void PowerMonitor::SetListeningForShutdown(bool is_listening) {
   if (is_listening) {
@@ -143,6 +189,7 @@ gin::ObjectTemplateBuilder PowerMonitor::GetObjectTemplateBuilder(
   auto builder =
       gin_helper::EventEmitterMixin<PowerMonitor>::GetObjectTemplateBuilder(
           isolate);
+  builder.SetMethod("setIdleThreshold", &PowerMonitor::SetIdleThreshold);
 #if BUILDFLAG(IS_LINUX)
   builder.SetMethod("setListeningForShutdown",
                     &PowerMonitor::SetListeningForShutdown);
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_POWER_MONITOR_H_
 
 #include "base/power_monitor/power_observer.h"
+#include "base/timer/timer.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/pinnable.h"
@@ -47,6 +48,11 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
   // Called by native calles.
   bool ShouldShutdown();
 
+  // Emits "idle-start" once the system has been idle for |idle_threshold|
+  // seconds, then "idle-end" when it isn't anymore. 0 stops the detection.
+  void SetIdleThreshold(int idle_threshold);
+  void CheckIdleState();
+
 #if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN)
   void InitPlatformSpecificMonitors();
 #endif
@@ -87,6 +93,10 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
 #if BUILDFLAG(IS_LINUX)
   PowerObserverLinux power_observer_linux_{this};
 #endif
+
+  int idle_threshold_ = 0;
+  bool is_idle_ = false;
+  base::OneShotTimer idle_timer_;
 };
 
 }  // namespace electron::api
@@ -10,9 +10,8 @@
 #include "shell/common/thread_restrictions.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
-#include "base/task/task_traits.h"
-#include "base/task/thread_pool.h"
 #include "printing/backend/print_backend.h"
+#include "shell/browser/printing/printer_list_cache.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/process_util.h"
 #endif
@@ -64,24 +63,12 @@ v8::Local<v8::Promise> GetPrinterListAsync(v8::Isolate* isolate) {
   gin_helper::Promise<printing::PrinterList> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::TaskPriority::USER_VISIBLE, base::MayBlock()},
-      base::BindOnce([]() {
-        printing::PrinterList printers;
-        auto print_backend = printing::PrintBackend::CreateInstance(
-            g_browser_process->GetApplicationLocale());
-        printing::mojom::ResultCode code =
-            print_backend->EnumeratePrinters(printers);
-        if (code != printing::mojom::ResultCode::kSuccess)
-          LOG(INFO) << "Failed to enumerate printers";
-        return printers;
-      }),
-      base::BindOnce(
-          [](gin_helper::Promise<printing::PrinterList> promise,
-             const printing::PrinterList& printers) {
-            promise.Resolve(printers);
-          },
-          std::move(promise)));
+  electron::PrinterListCache::GetInstance()->GetPrinters(base::BindOnce(
+      [](gin_helper::Promise<printing::PrinterList> promise,
+         const electron::PrinterListCache::Printers& printers) {
+        promise.Resolve(printers.printers);
+      },
+      std::move(promise)));
 
   return handle;
 }
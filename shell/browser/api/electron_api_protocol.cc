@@ -8,6 +8,7 @@
 
 #include "base/command_line.h"
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "content/common/url_schemes.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "gin/object_template_builder.h"
@@ -15,7 +16,9 @@
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
@@ -196,6 +199,54 @@ ProtocolError Protocol::RegisterProtocol(ProtocolType type,
   return added ? ProtocolError::kOK : ProtocolError::kRegistered;
 }
 
+bool Protocol::RegisterDirectoryProtocol(gin_helper::ErrorThrower thrower,
+                                         const std::string& scheme,
+                                         gin_helper::Dictionary options) {
+  DirectoryProtocolOptions directory_options;
+  if (!options.Get("root", &directory_options.root) ||
+      !directory_options.root.IsAbsolute()) {
+    thrower.ThrowTypeError("'root' must be an absolute path");
+    return false;
+  }
+
+  base::Value::Dict mime_types;
+  if (options.Get("mimeTypes", &mime_types)) {
+    for (const auto [extension, mime_type] : mime_types) {
+      if (!mime_type.is_string()) {
+        thrower.ThrowTypeError("'mimeTypes' values must be strings");
+        return false;
+      }
+      directory_options.mime_types[base::ToLowerASCII(base::TrimString(
+          extension, ".", base::TRIM_LEADING))] = mime_type.GetString();
+    }
+  }
+
+  base::Value::List header_rules;
+  if (options.Get("headers", &header_rules)) {
+    for (const auto& value : header_rules) {
+      const base::Value::Dict* rule = value.GetIfDict();
+      const base::Value::Dict* headers =
+          rule ? rule->FindDict("headers") : nullptr;
+      if (!headers) {
+        thrower.ThrowTypeError("'headers' must be a list of header rules");
+        return false;
+      }
+
+      DirectoryProtocolOptions::HeaderRule& header_rule =
+          directory_options.header_rules.emplace_back();
+      if (const std::string* match = rule->FindString("match"))
+        header_rule.match = *match;
+      for (const auto [name, header_value] : *headers) {
+        if (header_value.is_string())
+          header_rule.headers.emplace_back(name, header_value.GetString());
+      }
+    }
+  }
+
+  return protocol_registry_->RegisterDirectoryProtocol(
+      scheme, std::move(directory_options));
+}
+
 bool Protocol::UnregisterProtocol(const std::string& scheme,
                                   gin::Arguments* args) {
   bool removed = protocol_registry_->UnregisterProtocol(scheme);
@@ -296,6 +347,8 @@ v8::Local<v8::ObjectTemplate> Protocol::FillObjectTemplate(
                  &Protocol::RegisterProtocolFor<ProtocolType::kStream>)
       .SetMethod("registerProtocol",
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
+      .SetMethod("registerDirectoryProtocol",
+                 &Protocol::RegisterDirectoryProtocol)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
@@ -14,6 +14,7 @@
 #include "gin/wrappable.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
 #include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/error_thrower.h"
 
 namespace electron {
 
@@ -66,6 +67,9 @@ class Protocol : public gin::Wrappable<Protocol>,
   ProtocolError RegisterProtocol(ProtocolType type,
                                  const std::string& scheme,
                                  const ProtocolHandler& handler);
+  bool RegisterDirectoryProtocol(gin_helper::ErrorThrower thrower,
+                                 const std::string& scheme,
+                                 gin_helper::Dictionary options);
   bool UnregisterProtocol(const std::string& scheme, gin::Arguments* args);
   bool IsProtocolRegistered(const std::string& scheme);
 
@@ -5,14 +5,24 @@
 #include "shell/browser/api/electron_api_safe_storage.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
 #include "components/os_crypt/sync/os_crypt.h"
 #include "shell/browser/browser.h"
 #include "shell/common/gin_converters/base_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/platform_util.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron::safestorage {
 
@@ -116,6 +126,192 @@ std::string DecryptString(v8::Isolate* isolate, v8::Local<v8::Value> buffer) {
   return plaintext;
 }
 
+namespace {
+
+enum class Operation { kEncrypt, kDecrypt };
+
+// The outputs of a batch in the order of the inputs, or the error of the
+// first input which failed.
+struct BatchResult {
+  bool available = true;
+  std::vector<std::string> outputs;
+  std::string error;
+};
+
+// A single sequence runs the operations in the order of the calls, so that
+// the key is only fetched once when many are made at startup.
+scoped_refptr<base::SequencedTaskRunner> GetCryptTaskRunner() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>> runner(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+  return *runner;
+}
+
+std::string GetErrorPrefix(Operation operation,
+                           const char* method,
+                           absl::optional<size_t> index) {
+  return base::StrCat(
+      {operation == Operation::kEncrypt ? "Error while encrypting the text"
+                                        : "Error while decrypting the "
+                                          "ciphertext",
+       index ? " at index " + base::NumberToString(*index) : std::string(),
+       " provided to safeStorage.", method, "."});
+}
+
+BatchResult RunBatch(Operation operation,
+                     const char* method,
+                     bool batch,
+                     std::vector<std::string> inputs) {
+  BatchResult result;
+  // The first call fetches the key, from the Keychain or the keyring, which
+  // OSCrypt keeps for the others.
+  if (!OSCrypt::IsEncryptionAvailable()) {
+    result.available = false;
+    return result;
+  }
+  result.outputs.resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const absl::optional<size_t> index =
+        batch ? absl::make_optional(i) : absl::nullopt;
+    bool succeeded = false;
+    if (operation == Operation::kEncrypt) {
+      succeeded = OSCrypt::EncryptString(inputs[i], &result.outputs[i]);
+    } else if (inputs[i].empty()) {
+      succeeded = true;
+    } else if (inputs[i].find(kEncryptionVersionPrefixV10) != 0 &&
+               inputs[i].find(kEncryptionVersionPrefixV11) != 0) {
+      result.error = GetErrorPrefix(operation, method, index) +
+                     " Ciphertext does not appear to be encrypted.";
+      break;
+    } else {
+      succeeded = OSCrypt::DecryptString(inputs[i], &result.outputs[i]);
+    }
+    if (!succeeded) {
+      result.error = GetErrorPrefix(operation, method, index);
+      break;
+    }
+  }
+  if (!result.error.empty())
+    result.outputs.clear();
+  return result;
+}
+
+void OnBatchDone(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                 Operation operation,
+                 const char* method,
+                 bool batch,
+                 BatchResult result) {
+  if (!result.available) {
+    promise.RejectWithErrorMessage(
+        Browser::Get()->is_ready()
+            ? GetErrorPrefix(operation, method, absl::nullopt) +
+                  (operation == Operation::kEncrypt
+                       ? " Encryption is not available."
+                       : " Decryption is not available.")
+            : "safeStorage cannot be used before app is ready");
+    return;
+  }
+  if (!result.error.empty()) {
+    promise.RejectWithErrorMessage(result.error);
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  std::vector<v8::Local<v8::Value>> outputs;
+  outputs.reserve(result.outputs.size());
+  for (const std::string& output : result.outputs) {
+    if (operation == Operation::kEncrypt) {
+      outputs.push_back(
+          node::Buffer::Copy(isolate, output.c_str(), output.size())
+              .ToLocalChecked());
+    } else {
+      outputs.push_back(gin::StringToV8(isolate, output));
+    }
+  }
+  promise.Resolve(batch ? gin::ConvertToV8(isolate, outputs) : outputs[0]);
+}
+
+v8::Local<v8::Promise> StartBatch(v8::Isolate* isolate,
+                                  Operation operation,
+                                  const char* method,
+                                  bool batch,
+                                  std::vector<std::string> inputs) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+#if BUILDFLAG(IS_LINUX)
+  // See IsEncryptionAvailable().
+  if (!Browser::Get()->is_ready()) {
+    promise.RejectWithErrorMessage(
+        "safeStorage cannot be used before app is ready");
+    return handle;
+  }
+#endif
+  GetCryptTaskRunner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&RunBatch, operation, method, batch, std::move(inputs)),
+      base::BindOnce(&OnBatchDone, std::move(promise), operation, method,
+                     batch));
+  return handle;
+}
+
+bool BuffersToStrings(v8::Isolate* isolate,
+                      const char* method,
+                      bool batch,
+                      const std::vector<v8::Local<v8::Value>>& buffers,
+                      std::vector<std::string>* out) {
+  for (v8::Local<v8::Value> buffer : buffers) {
+    if (!node::Buffer::HasInstance(buffer)) {
+      gin_helper::ErrorThrower(isolate).ThrowTypeError(base::StrCat(
+          {"Expected the first argument of ", method, "() to be ",
+           batch ? "an array of buffers" : "a buffer"}));
+      return false;
+    }
+    out->emplace_back(node::Buffer::Data(buffer),
+                      node::Buffer::Length(buffer));
+  }
+  return true;
+}
+
+}  // namespace
+
+v8::Local<v8::Promise> EncryptStringAsync(v8::Isolate* isolate,
+                                          const std::string& plaintext) {
+  return StartBatch(isolate, Operation::kEncrypt, "encryptStringAsync",
+                    /*batch=*/false, {plaintext});
+}
+
+v8::Local<v8::Promise> EncryptStringsAsync(
+    v8::Isolate* isolate,
+    std::vector<std::string> plaintexts) {
+  return StartBatch(isolate, Operation::kEncrypt, "encryptStringsAsync",
+                    /*batch=*/true, std::move(plaintexts));
+}
+
+v8::Local<v8::Promise> DecryptStringAsync(v8::Isolate* isolate,
+                                          v8::Local<v8::Value> buffer) {
+  std::vector<std::string> ciphertexts;
+  if (!BuffersToStrings(isolate, "decryptStringAsync", /*batch=*/false,
+                        {buffer}, &ciphertexts))
+    return v8::Local<v8::Promise>();
+  return StartBatch(isolate, Operation::kDecrypt, "decryptStringAsync",
+                    /*batch=*/false, std::move(ciphertexts));
+}
+
+v8::Local<v8::Promise> DecryptStringsAsync(
+    v8::Isolate* isolate,
+    const std::vector<v8::Local<v8::Value>>& buffers) {
+  std::vector<std::string> ciphertexts;
+  ciphertexts.reserve(buffers.size());
+  if (!BuffersToStrings(isolate, "decryptStringsAsync", /*batch=*/true,
+                        buffers, &ciphertexts))
+    return v8::Local<v8::Promise>();
+  return StartBatch(isolate, Operation::kDecrypt, "decryptStringsAsync",
+                    /*batch=*/true, std::move(ciphertexts));
+}
+
 }  // namespace electron::safestorage
 
 void Initialize(v8::Local<v8::Object> exports,
@@ -128,6 +324,14 @@ void Initialize(v8::Local<v8::Object> exports,
                  &electron::safestorage::IsEncryptionAvailable);
   dict.SetMethod("encryptString", &electron::safestorage::EncryptString);
   dict.SetMethod("decryptString", &electron::safestorage::DecryptString);
+  dict.SetMethod("encryptStringAsync",
+                 &electron::safestorage::EncryptStringAsync);
+  dict.SetMethod("encryptStringsAsync",
+                 &electron::safestorage::EncryptStringsAsync);
+  dict.SetMethod("decryptStringAsync",
+                 &electron::safestorage::DecryptStringAsync);
+  dict.SetMethod("decryptStringsAsync",
+                 &electron::safestorage::DecryptStringsAsync);
 }
 
 NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_safe_storage, Initialize)
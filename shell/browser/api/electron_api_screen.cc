@@ -5,6 +5,9 @@
 #include "shell/browser/api/electron_api_screen.h"
 
 #include <string>
+#include <tuple>
+
+#include "base/ranges/algorithm.h"
 
 #include "base/functional/bind.h"
 #include "gin/dictionary.h"
@@ -61,6 +64,25 @@ void DelayEmitWithMetrics(Screen* screen,
   screen->Emit(name, display, metrics);
 }
 
+// Freezes |value| and the objects in it, so that the objects of the snapshot
+// can be handed out to every caller.
+void DeepFreeze(v8::Local<v8::Context> context, v8::Local<v8::Value> value) {
+  if (!value->IsObject())
+    return;
+  v8::Local<v8::Object> object = value.As<v8::Object>();
+  v8::Local<v8::Array> keys;
+  if (object->GetOwnPropertyNames(context).ToLocal(&keys)) {
+    for (uint32_t i = 0; i < keys->Length(); ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> property;
+      if (keys->Get(context, i).ToLocal(&key) &&
+          object->Get(context, key).ToLocal(&property))
+        DeepFreeze(context, property);
+    }
+  }
+  std::ignore = object->SetIntegrityLevel(context, v8::IntegrityLevel::kFrozen);
+}
+
 }  // namespace
 
 Screen::Screen(v8::Isolate* isolate, display::Screen* screen)
@@ -103,13 +125,72 @@ static gfx::Rect DIPToScreenRect(electron::NativeWindow* window,
 
 #endif
 
+v8::Local<v8::Value> Screen::GetPrimaryDisplay(v8::Isolate* isolate) {
+  return GetDisplayObject(isolate, screen_->GetPrimaryDisplay());
+}
+
+v8::Local<v8::Array> Screen::GetAllDisplays(v8::Isolate* isolate) {
+  if (displays_.IsEmpty()) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    const std::vector<display::Display>& displays = screen_->GetAllDisplays();
+    v8::Local<v8::Array> array = v8::Array::New(isolate, displays.size());
+    display_ids_.clear();
+    for (size_t i = 0; i < displays.size(); ++i) {
+      v8::Local<v8::Value> object = gin::ConvertToV8(isolate, displays[i]);
+      DeepFreeze(context, object);
+      std::ignore = array->Set(context, i, object);
+      display_ids_.push_back(displays[i].id());
+    }
+    DeepFreeze(context, array);
+    displays_.Reset(isolate, array);
+  }
+  return displays_.Get(isolate);
+}
+
+v8::Local<v8::Value> Screen::GetDisplayNearestPoint(v8::Isolate* isolate,
+                                                    const gfx::Point& point) {
+  return GetDisplayObject(isolate, screen_->GetDisplayNearestPoint(point));
+}
+
+v8::Local<v8::Value> Screen::GetDisplayMatching(v8::Isolate* isolate,
+                                                const gfx::Rect& match_rect) {
+  return GetDisplayObject(isolate, screen_->GetDisplayMatching(match_rect));
+}
+
+v8::Local<v8::Value> Screen::GetDisplayObject(
+    v8::Isolate* isolate,
+    const display::Display& display) {
+  v8::Local<v8::Array> displays = GetAllDisplays(isolate);
+  auto it = base::ranges::find(display_ids_, display.id());
+  v8::Local<v8::Value> object;
+  if (it != display_ids_.end() &&
+      displays
+          ->Get(isolate->GetCurrentContext(),
+                static_cast<uint32_t>(it - display_ids_.begin()))
+          .ToLocal(&object))
+    return object;
+  // The display isn't in the list, such as the fallback one when there is
+  // no display.
+  object = gin::ConvertToV8(isolate, display);
+  DeepFreeze(isolate->GetCurrentContext(), object);
+  return object;
+}
+
+void Screen::OnTopologyChanged() {
+  displays_.Reset();
+  display_ids_.clear();
+  ++topology_version_;
+}
+
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  OnTopologyChanged();
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-added", new_display));
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  OnTopologyChanged();
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-removed", old_display));
@@ -117,6 +198,7 @@ void Screen::OnDisplayRemoved(const display::Display& old_display) {
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  OnTopologyChanged();
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmitWithMetrics, base::Unretained(this),
                                 "display-metrics-changed", display,
@@ -156,7 +238,8 @@ gin::ObjectTemplateBuilder Screen::GetObjectTemplateBuilder(
       .SetMethod("screenToDipRect", &ScreenToDIPRect)
       .SetMethod("dipToScreenRect", &DIPToScreenRect)
 #endif
-      .SetMethod("getDisplayMatching", &Screen::GetDisplayMatching);
+      .SetMethod("getDisplayMatching", &Screen::GetDisplayMatching)
+      .SetProperty("topologyVersion", &Screen::topology_version);
 }
 
 const char* Screen::GetTypeName() {
@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SCREEN_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SCREEN_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
@@ -13,6 +14,7 @@
 #include "shell/common/gin_helper/error_thrower.h"
 #include "ui/display/display_observer.h"
 #include "ui/display/screen.h"
+#include "v8/include/v8-persistent-handle.h"
 
 namespace gfx {
 class Point;
@@ -42,18 +44,13 @@ class Screen : public gin::Wrappable<Screen>,
   ~Screen() override;
 
   gfx::Point GetCursorScreenPoint(v8::Isolate* isolate);
-  display::Display GetPrimaryDisplay() const {
-    return screen_->GetPrimaryDisplay();
-  }
-  const std::vector<display::Display>& GetAllDisplays() const {
-    return screen_->GetAllDisplays();
-  }
-  display::Display GetDisplayNearestPoint(const gfx::Point& point) const {
-    return screen_->GetDisplayNearestPoint(point);
-  }
-  display::Display GetDisplayMatching(const gfx::Rect& match_rect) const {
-    return screen_->GetDisplayMatching(match_rect);
-  }
+  v8::Local<v8::Value> GetPrimaryDisplay(v8::Isolate* isolate);
+  v8::Local<v8::Array> GetAllDisplays(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetDisplayNearestPoint(v8::Isolate* isolate,
+                                              const gfx::Point& point);
+  v8::Local<v8::Value> GetDisplayMatching(v8::Isolate* isolate,
+                                          const gfx::Rect& match_rect);
+  uint32_t topology_version() const { return topology_version_; }
 
   // display::DisplayObserver:
   void OnDisplayAdded(const display::Display& new_display) override;
@@ -62,7 +59,19 @@ class Screen : public gin::Wrappable<Screen>,
                                uint32_t changed_metrics) override;
 
  private:
+  // Returns the object of |display| from the snapshot of the topology.
+  v8::Local<v8::Value> GetDisplayObject(v8::Isolate* isolate,
+                                        const display::Display& display);
+  void OnTopologyChanged();
+
   raw_ptr<display::Screen> screen_;
+
+  // The frozen objects of the displays, built the first time they are asked
+  // for after the topology changed, so that calls in a drag loop don't
+  // convert them again. |display_ids_| has the ids in the same order.
+  v8::Global<v8::Array> displays_;
+  std::vector<int64_t> display_ids_;
+  uint32_t topology_version_ = 0;
 };
 
 }  // namespace electron::api
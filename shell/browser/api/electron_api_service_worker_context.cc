@@ -4,10 +4,14 @@
 
 #include "shell/browser/api/electron_api_service_worker_context.h"
 
+#include <string>
 #include <utility>
 
+#include "base/strings/strcat.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/console_message.h"
+#include "content/public/browser/service_worker_external_request_result.h"
+#include "content/public/browser/service_worker_external_request_timeout_type.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
@@ -18,7 +22,10 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/blink/public/common/storage_key/storage_key.h"
+#include "url/origin.h"
 
 namespace electron::api {
 
@@ -79,6 +86,8 @@ ServiceWorkerContext::ServiceWorkerContext(
 }
 
 ServiceWorkerContext::~ServiceWorkerContext() {
+  while (!keep_alives_.empty())
+    ReleaseKeepAlive(keep_alives_.begin()->first);
   service_worker_context_->RemoveObserver(this);
 }
 
@@ -106,6 +115,63 @@ void ServiceWorkerContext::OnRegistrationCompleted(const GURL& scope) {
        gin::DataObjectBuilder(isolate).Set("scope", scope).Build());
 }
 
+void ServiceWorkerContext::OnVersionActivated(int64_t version_id,
+                                              const GURL& scope) {
+  auto iter = first_run_times_.find(version_id);
+  if (iter == first_run_times_.end())
+    return;
+  const base::TimeDelta activation_time = base::TimeTicks::Now() - iter->second;
+  first_run_times_.erase(iter);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("worker-activated",
+       gin::DataObjectBuilder(isolate)
+           .Set("versionId", version_id)
+           .Set("scope", scope)
+           .Set("activationTime", activation_time.InMillisecondsF())
+           .Build());
+}
+
+void ServiceWorkerContext::OnVersionRedundant(int64_t version_id,
+                                              const GURL& scope) {
+  first_run_times_.erase(version_id);
+}
+
+void ServiceWorkerContext::OnVersionStartingRunning(int64_t version_id) {
+  starting_times_[version_id] = base::TimeTicks::Now();
+}
+
+void ServiceWorkerContext::OnVersionStartedRunning(
+    int64_t version_id,
+    const content::ServiceWorkerRunningInfo& running_info) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  // A new version runs for the first time to be installed.
+  first_run_times_.emplace(version_id, now);
+  auto iter = starting_times_.find(version_id);
+  if (iter == starting_times_.end())
+    return;
+  const base::TimeDelta startup_time = now - iter->second;
+  starting_times_.erase(iter);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("worker-started",
+       gin::DataObjectBuilder(isolate)
+           .Set("versionId", version_id)
+           .Set("scope", running_info.scope)
+           .Set("scriptUrl", running_info.script_url)
+           .Set("renderProcessId", running_info.render_process_id)
+           .Set("startupTime", startup_time.InMillisecondsF())
+           .Build());
+}
+
+void ServiceWorkerContext::OnVersionStoppedRunning(int64_t version_id) {
+  starting_times_.erase(version_id);
+  // Only the versions which stay running until they're activated are timed.
+  first_run_times_.erase(version_id);
+  // The requests of a stopped worker are gone with it.
+  keep_alives_.erase(version_id);
+}
+
 void ServiceWorkerContext::OnDestruct(content::ServiceWorkerContext* context) {
   if (context == service_worker_context_) {
     delete this;
@@ -139,6 +205,81 @@ v8::Local<v8::Value> ServiceWorkerContext::GetWorkerInfoFromID(
                                         std::move(iter->second));
 }
 
+v8::Local<v8::Promise> ServiceWorkerContext::StartWorkerForScope(
+    v8::Isolate* isolate,
+    const GURL& scope) {
+  auto promise = std::make_shared<gin_helper::Promise<int64_t>>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetHandle();
+  if (!scope.is_valid()) {
+    promise->RejectWithErrorMessage(
+        base::StrCat({"Invalid scope: ", scope.possibly_invalid_spec()}));
+    return handle;
+  }
+  // Only one of the callbacks is called.
+  service_worker_context_->StartWorkerForScope(
+      scope, blink::StorageKey::CreateFirstParty(url::Origin::Create(scope)),
+      base::BindOnce(&ServiceWorkerContext::OnWorkerStarted, promise),
+      base::BindOnce(&ServiceWorkerContext::OnWorkerStartFailed, promise));
+  return handle;
+}
+
+// static
+void ServiceWorkerContext::OnWorkerStarted(
+    std::shared_ptr<gin_helper::Promise<int64_t>> promise,
+    int64_t version_id,
+    int process_id,
+    int thread_id) {
+  promise->Resolve(version_id);
+}
+
+// static
+void ServiceWorkerContext::OnWorkerStartFailed(
+    std::shared_ptr<gin_helper::Promise<int64_t>> promise,
+    blink::ServiceWorkerStatusCode status_code) {
+  promise->RejectWithErrorMessage(
+      base::StrCat({"Failed to start the service worker: ",
+                    blink::ServiceWorkerStatusToString(status_code)}));
+}
+
+void ServiceWorkerContext::KeepAlive(gin_helper::ErrorThrower thrower,
+                                     int64_t version_id,
+                                     double duration_ms) {
+  // The previous request is replaced, so that the duration starts now.
+  ReleaseKeepAlive(version_id);
+  if (duration_ms <= 0)
+    return;
+
+  auto request = std::make_unique<KeepAliveRequest>();
+  request->request_uuid = base::Uuid::GenerateRandomV4();
+  // The worker isn't stopped while the request is pending, the timer ends
+  // it.
+  content::ServiceWorkerExternalRequestResult result =
+      service_worker_context_->StartingExternalRequest(
+          version_id,
+          content::ServiceWorkerExternalRequestTimeoutType::kDoesNotTimeout,
+          request->request_uuid);
+  if (result != content::ServiceWorkerExternalRequestResult::kOk) {
+    thrower.ThrowError("Could not find a running service worker with that "
+                       "version_id");
+    return;
+  }
+  // Unretained is safe as |request->timer| is owned by |this|.
+  request->timer.Start(
+      FROM_HERE, base::Milliseconds(duration_ms),
+      base::BindOnce(&ServiceWorkerContext::ReleaseKeepAlive,
+                     base::Unretained(this), version_id));
+  keep_alives_[version_id] = std::move(request);
+}
+
+void ServiceWorkerContext::ReleaseKeepAlive(int64_t version_id) {
+  auto iter = keep_alives_.find(version_id);
+  if (iter == keep_alives_.end())
+    return;
+  service_worker_context_->FinishedExternalRequest(version_id,
+                                                   iter->second->request_uuid);
+  keep_alives_.erase(iter);
+}
+
 // static
 gin::Handle<ServiceWorkerContext> ServiceWorkerContext::Create(
     v8::Isolate* isolate,
@@ -155,7 +296,10 @@ gin::ObjectTemplateBuilder ServiceWorkerContext::GetObjectTemplateBuilder(
       .SetMethod("getAllRunning",
                  &ServiceWorkerContext::GetAllRunningWorkerInfo)
       .SetMethod("getFromVersionID",
-                 &ServiceWorkerContext::GetWorkerInfoFromID);
+                 &ServiceWorkerContext::GetWorkerInfoFromID)
+      .SetMethod("startWorkerForScope",
+                 &ServiceWorkerContext::StartWorkerForScope)
+      .SetMethod("keepAlive", &ServiceWorkerContext::KeepAlive);
 }
 
 const char* ServiceWorkerContext::GetTypeName() {
@@ -5,12 +5,25 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 
+#include <map>
+#include <memory>
+
+#include "base/containers/flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/uuid.h"
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/service_worker_context_observer.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "third_party/blink/public/common/service_worker/service_worker_status_code.h"
+
+namespace gin_helper {
+template <typename T>
+class Promise;
+}
 
 namespace electron {
 
@@ -30,12 +43,24 @@ class ServiceWorkerContext
   v8::Local<v8::Value> GetAllRunningWorkerInfo(v8::Isolate* isolate);
   v8::Local<v8::Value> GetWorkerInfoFromID(gin_helper::ErrorThrower thrower,
                                            int64_t version_id);
+  v8::Local<v8::Promise> StartWorkerForScope(v8::Isolate* isolate,
+                                             const GURL& scope);
+  void KeepAlive(gin_helper::ErrorThrower thrower,
+                 int64_t version_id,
+                 double duration_ms);
 
   // content::ServiceWorkerContextObserver
   void OnReportConsoleMessage(int64_t version_id,
                               const GURL& scope,
                               const content::ConsoleMessage& message) override;
   void OnRegistrationCompleted(const GURL& scope) override;
+  void OnVersionActivated(int64_t version_id, const GURL& scope) override;
+  void OnVersionRedundant(int64_t version_id, const GURL& scope) override;
+  void OnVersionStartingRunning(int64_t version_id) override;
+  void OnVersionStartedRunning(
+      int64_t version_id,
+      const content::ServiceWorkerRunningInfo& running_info) override;
+  void OnVersionStoppedRunning(int64_t version_id) override;
   void OnDestruct(content::ServiceWorkerContext* context) override;
 
   // gin::Wrappable
@@ -54,8 +79,30 @@ class ServiceWorkerContext
   ~ServiceWorkerContext() override;
 
  private:
+  // An external request which keeps a worker from being stopped while idle.
+  struct KeepAliveRequest {
+    base::Uuid request_uuid;
+    base::OneShotTimer timer;
+  };
+
+  static void OnWorkerStarted(
+      std::shared_ptr<gin_helper::Promise<int64_t>> promise,
+      int64_t version_id,
+      int process_id,
+      int thread_id);
+  static void OnWorkerStartFailed(
+      std::shared_ptr<gin_helper::Promise<int64_t>> promise,
+      blink::ServiceWorkerStatusCode status_code);
+  void ReleaseKeepAlive(int64_t version_id);
+
   raw_ptr<content::ServiceWorkerContext> service_worker_context_;
 
+  std::map<int64_t, std::unique_ptr<KeepAliveRequest>> keep_alives_;
+  // When the workers which are starting were asked to run.
+  base::flat_map<int64_t, base::TimeTicks> starting_times_;
+  // When the running versions which aren't activated yet started.
+  base::flat_map<int64_t, base::TimeTicks> first_run_times_;
+
   base::WeakPtrFactory<ServiceWorkerContext> weak_ptr_factory_{this};
 };
 
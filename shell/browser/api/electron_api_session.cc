@@ -5,12 +5,14 @@
 #include "shell/browser/api/electron_api_session.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/command_line.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
@@ -38,6 +40,7 @@
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/arguments.h"
+#include "gin/data_object_builder.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "net/base/completion_repeating_callback.h"
@@ -59,21 +62,32 @@
 #include "shell/browser/api/electron_api_service_worker_context.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/electron_api_web_request.h"
+#include "shell/browser/batching_pref_store.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/download_queue.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/connection_pool_info.h"
+#include "shell/browser/net/connection_warming.h"
+#include "shell/browser/net/host_resolution_tracker.h"
+#include "shell/browser/net/http_cache_entry_loader.h"
 #include "shell/browser/net/resolve_host_function.h"
+#include "shell/browser/renderer_sharing_manager.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_manager.h"
+#include "shell/browser/storage_usage.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/media_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/optional_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/usb_protected_classes_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -81,6 +95,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/common/storage_key/storage_key.h"
 #include "third_party/blink/public/mojom/mediastream/media_stream.mojom.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -112,28 +127,33 @@ struct ClearStorageDataOptions {
   blink::StorageKey storage_key;
   uint32_t storage_types = StoragePartition::REMOVE_DATA_MASK_ALL;
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
+  bool background = false;
+  // Set by the JS wrapper when the clear can be cancelled.
+  int32_t id = 0;
+};
+
+constexpr struct {
+  const char* name;
+  uint32_t mask;
+} kStorageTypes[] = {
+    {"cookies", StoragePartition::REMOVE_DATA_MASK_COOKIES},
+    {"filesystem", StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS},
+    {"indexdb", StoragePartition::REMOVE_DATA_MASK_INDEXEDDB},
+    {"localstorage", StoragePartition::REMOVE_DATA_MASK_LOCAL_STORAGE},
+    {"shadercache", StoragePartition::REMOVE_DATA_MASK_SHADER_CACHE},
+    {"websql", StoragePartition::REMOVE_DATA_MASK_WEBSQL},
+    {"serviceworkers", StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS},
+    {"cachestorage", StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE},
 };
 
 uint32_t GetStorageMask(const std::vector<std::string>& storage_types) {
   uint32_t storage_mask = 0;
   for (const auto& it : storage_types) {
     auto type = base::ToLowerASCII(it);
-    if (type == "cookies")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_COOKIES;
-    else if (type == "filesystem")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS;
-    else if (type == "indexdb")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_INDEXEDDB;
-    else if (type == "localstorage")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_LOCAL_STORAGE;
-    else if (type == "shadercache")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_SHADER_CACHE;
-    else if (type == "websql")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_WEBSQL;
-    else if (type == "serviceworkers")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS;
-    else if (type == "cachestorage")
-      storage_mask |= StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE;
+    for (const auto& storage_type : kStorageTypes) {
+      if (type == storage_type.name)
+        storage_mask |= storage_type.mask;
+    }
   }
   return storage_mask;
 }
@@ -194,6 +214,8 @@ struct Converter<ClearStorageDataOptions> {
       out->storage_types = GetStorageMask(types);
     if (options.Get("quotas", &types))
       out->quota_types = GetQuotaMask(types);
+    options.Get("background", &out->background);
+    options.Get("id", &out->id);
     return true;
   }
 };
@@ -258,6 +280,44 @@ struct Converter<network::mojom::SSLConfigPtr> {
   }
 };
 
+template <>
+struct Converter<electron::HttpCacheEntryLoader::Entry> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::HttpCacheEntryLoader::Entry& entry) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("url", entry.url);
+    dict.Set("statusCode", entry.headers->response_code());
+    dict.Set("headers", entry.headers.get());
+    dict.Set("mimeType", entry.mime_type);
+    dict.Set("contentLength", entry.content_length);
+    dict.Set("responseTime", entry.response_time.ToJsTime());
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::ElectronPermissionManager::CheckResult> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::ElectronPermissionManager::CheckResult* out) {
+    gin_helper::Dictionary dict;
+    // Anything but a decision object is a boolean, as before.
+    if (!ConvertFromV8(isolate, val, &dict) || !dict.Has("granted")) {
+      out->granted = val->BooleanValue(isolate);
+      return true;
+    }
+    dict.Get("granted", &out->granted);
+    dict.Get("cache", &out->cache);
+    double ttl;
+    if (dict.Get("ttl", &ttl) && ttl >= 0) {
+      out->cache = true;
+      out->cache_ttl = base::Milliseconds(ttl);
+    }
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron::api {
@@ -266,6 +326,45 @@ namespace {
 
 const char kPersistPrefix[] = "persist:";
 
+void ResolveCacheEntryPromise(
+    gin_helper::Promise<absl::optional<HttpCacheEntryLoader::Entry>> promise,
+    HttpCacheEntryLoader::Result result) {
+  if (result.has_value())
+    promise.Resolve(result.value());
+  else
+    promise.RejectWithErrorMessage(result.error());
+}
+
+struct HostResolution {
+  size_t index = 0;
+  int net_error = net::OK;
+  std::vector<net::IPEndPoint> endpoints;
+};
+
+void ResolveHostsPromise(
+    gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+    const std::vector<std::string>& hosts,
+    std::vector<HostResolution> resolutions) {
+  // The resolutions arrive in the order they complete.
+  std::sort(resolutions.begin(), resolutions.end(),
+            [](const HostResolution& a, const HostResolution& b) {
+              return a.index < b.index;
+            });
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<gin_helper::Dictionary> results;
+  for (const HostResolution& resolution : resolutions) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("host", hosts[resolution.index]);
+    if (resolution.net_error < 0)
+      dict.Set("error", net::ErrorToString(resolution.net_error));
+    else
+      dict.Set("endpoints", resolution.endpoints);
+    results.push_back(dict);
+  }
+  promise.Resolve(results);
+}
+
 void DownloadIdCallback(content::DownloadManager* download_manager,
                         const base::FilePath& path,
                         const std::vector<GURL>& url_chain,
@@ -397,7 +496,10 @@ void Session::OnDownloadCreated(content::DownloadManager* manager,
   if (prevent_default) {
     item->Cancel(true);
     item->Remove();
+    return;
   }
+  if (download_queue_)
+    download_queue_->AddDownload(item);
 }
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
@@ -461,6 +563,65 @@ v8::Local<v8::Promise> Session::ResolveHost(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::ResolveHosts(
+    std::vector<std::string> hosts,
+    absl::optional<network::mojom::ResolveHostParametersPtr> params) {
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // All of the hosts are resolved at once, the network service limits how
+  // many resolutions run in parallel.
+  auto barrier_callback = base::BarrierCallback<HostResolution>(
+      hosts.size(),
+      base::BindOnce(&ResolveHostsPromise, std::move(promise), hosts));
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    auto fn = base::MakeRefCounted<ResolveHostFunction>(
+        browser_context_, hosts[i],
+        params ? params.value().Clone() : nullptr,
+        base::BindOnce(
+            [](base::RepeatingCallback<void(HostResolution)> barrier_callback,
+               size_t index, int64_t net_error,
+               const absl::optional<net::AddressList>& addrs) {
+              HostResolution resolution;
+              resolution.index = index;
+              resolution.net_error = net_error;
+              if (net_error >= 0 && addrs)
+                resolution.endpoints = addrs->endpoints();
+              barrier_callback.Run(std::move(resolution));
+            },
+            barrier_callback, i));
+    fn->Run();
+  }
+
+  return handle;
+}
+
+gin_helper::Dictionary Session::GetHostResolverMetrics() {
+  HostResolutionTracker* tracker =
+      browser_context_->GetHostResolutionTracker();
+  const HostResolutionTracker::Metrics& metrics = tracker->metrics();
+  const uint64_t succeeded = metrics.resolutions - metrics.failures;
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate_);
+  dict.Set("resolutions", metrics.resolutions);
+  dict.Set("cacheHits", metrics.cache_hits);
+  dict.Set("failures", metrics.failures);
+  dict.Set("hitRate", succeeded ? static_cast<double>(metrics.cache_hits) /
+                                      static_cast<double>(succeeded)
+                                : 0.0);
+  dict.Set("averageLatency",
+           succeeded ? metrics.total_latency.InMillisecondsF() /
+                           static_cast<double>(succeeded)
+                     : 0.0);
+  dict.Set("maxLatency", metrics.max_latency.InMillisecondsF());
+  dict.Set("recentHosts", tracker->GetRecentHosts());
+  dict.Set("sharedHosts", metrics.shared_hosts);
+  return dict;
+}
+
+void Session::SetNetworkGroup(const std::string& group) {
+  browser_context_->GetHostResolutionTracker()->SetGroup(group);
+}
+
 v8::Local<v8::Promise> Session::GetCacheSize() {
   gin_helper::Promise<int64_t> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -497,6 +658,91 @@ v8::Local<v8::Promise> Session::ClearCache() {
   return handle;
 }
 
+v8::Local<v8::Promise> Session::LookupCache(const GURL& url) {
+  gin_helper::Promise<absl::optional<HttpCacheEntryLoader::Entry>> promise(
+      isolate_);
+  auto handle = promise.GetHandle();
+
+  HttpCacheEntryLoader::Lookup(browser_context_->GetURLLoaderFactory(), url,
+                               base::BindOnce(&ResolveCacheEntryPromise,
+                                              std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::StoreCache(const GURL& url) {
+  gin_helper::Promise<absl::optional<HttpCacheEntryLoader::Entry>> promise(
+      isolate_);
+  auto handle = promise.GetHandle();
+
+  HttpCacheEntryLoader::Store(browser_context_->GetURLLoaderFactory(), url,
+                              base::BindOnce(&ResolveCacheEntryPromise,
+                                             std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::EvictCache(const GURL& url_prefix) {
+  gin_helper::Promise<void> promise(isolate_);
+  auto handle = promise.GetHandle();
+
+  // The network service can only match cache entries by origin or domain.
+  if (!url_prefix.is_valid() || url_prefix.path_piece() != "/" ||
+      url_prefix.has_query() || url_prefix.has_ref()) {
+    promise.RejectWithErrorMessage(
+        "Only the entries of whole origins can be evicted, pass a prefix "
+        "such as https://example.com/");
+    return handle;
+  }
+
+  auto filter = network::mojom::ClearDataFilter::New();
+  filter->type = network::mojom::ClearDataFilter::Type::DELETE_MATCHES;
+  filter->origins.push_back(url::Origin::Create(url_prefix));
+  browser_context_->GetDefaultStoragePartition()
+      ->GetNetworkContext()
+      ->ClearHttpCache(base::Time(), base::Time::Max(), std::move(filter),
+                       base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                                      std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::GetCacheStats() {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate_);
+  auto handle = promise.GetHandle();
+
+  browser_context_->GetDefaultStoragePartition()
+      ->GetNetworkContext()
+      ->ComputeHttpCacheSize(
+          base::Time(), base::Time::Max(),
+          base::BindOnce(
+              [](gin_helper::Promise<gin_helper::Dictionary> promise,
+                 ElectronBrowserContext::HttpCacheStats stats,
+                 bool is_upper_bound, int64_t size_or_error) {
+                if (size_or_error < 0) {
+                  promise.RejectWithErrorMessage(
+                      net::ErrorToString(size_or_error));
+                  return;
+                }
+                v8::Isolate* isolate = promise.isolate();
+                v8::HandleScope handle_scope(isolate);
+                gin_helper::Dictionary dict =
+                    gin::Dictionary::CreateEmpty(isolate);
+                dict.Set("size", size_or_error);
+                dict.Set("requests", stats.requests);
+                dict.Set("hits", stats.hits);
+                dict.Set("hitRate",
+                         stats.requests ? static_cast<double>(stats.hits) /
+                                              stats.requests
+                                        : 0.0);
+                dict.Set("bytesFromCache", stats.bytes_from_cache);
+                promise.Resolve(dict);
+              },
+              std::move(promise), browser_context_->http_cache_stats()));
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -512,14 +758,186 @@ v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
     MediaDeviceIDSalt::Reset(browser_context()->prefs());
   }
 
-  storage_partition->ClearData(
-      options.storage_types, options.quota_types, options.storage_key,
-      base::Time(), base::Time::Max(),
-      base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
-                     std::move(promise)));
+  if (!options.background && !options.id) {
+    storage_partition->ClearData(
+        options.storage_types, options.quota_types, options.storage_key,
+        base::Time(), base::Time::Max(),
+        base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                       std::move(promise)));
+    return handle;
+  }
+
+  // In the background each type of storage is cleared on its own.
+  auto clear = std::make_unique<StorageClear>(std::move(promise));
+  clear->id = options.id;
+  clear->progress_event = "clear-storage-data-progress";
+  uint32_t remaining = options.storage_types;
+  for (const auto& storage_type : kStorageTypes) {
+    if (!(remaining & storage_type.mask))
+      continue;
+    remaining &= ~storage_type.mask;
+    clear->steps.push_back({options.storage_key, storage_type.mask,
+                            "storage", storage_type.name});
+  }
+  // The types which can't be picked individually are cleared last.
+  if (remaining)
+    clear->steps.push_back({options.storage_key, remaining, "storage",
+                            "other"});
+  clear->quota_types = options.quota_types;
+  StartStorageClear(std::move(clear));
   return handle;
 }
 
+v8::Local<v8::Promise> Session::GetStorageUsage(gin::Arguments* args) {
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<url::Origin> origins;
+  if (gin_helper::Dictionary options; args->GetNext(&options)) {
+    std::vector<GURL> urls;
+    options.Get("origins", &urls);
+    for (const GURL& url : urls) {
+      url::Origin origin = url::Origin::Create(url);
+      if (origin.opaque()) {
+        promise.RejectWithErrorMessage("Invalid origin: " + url.spec());
+        return handle;
+      }
+      origins.push_back(std::move(origin));
+    }
+  }
+
+  electron::GetStorageUsage(
+      browser_context()->GetStoragePartition(nullptr), std::move(origins),
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+             std::vector<StorageUsage> usages) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            std::vector<gin_helper::Dictionary> result;
+            for (const StorageUsage& usage : usages) {
+              auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+              dict.Set("origin", usage.origin.Serialize());
+              dict.Set("total", usage.total);
+              dict.Set("quota", usage.quota);
+              dict.Set("indexedDB", usage.indexed_db);
+              dict.Set("cacheStorage", usage.cache_storage);
+              dict.Set("serviceWorkers", usage.service_workers);
+              dict.Set("fileSystem", usage.file_system);
+              dict.Set("localStorage", usage.local_storage);
+              result.push_back(dict);
+            }
+            promise.Resolve(result);
+          },
+          std::move(promise)));
+  return handle;
+}
+
+struct Session::StorageClear {
+  struct Step {
+    blink::StorageKey storage_key;
+    uint32_t storage_types;
+    // The key and value which identify the step in the progress events.
+    const char* key;
+    std::string value;
+  };
+
+  explicit StorageClear(gin_helper::Promise<void> promise)
+      : promise(std::move(promise)) {}
+
+  int32_t id = 0;
+  const char* progress_event = nullptr;
+  std::vector<Step> steps;
+  uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
+  size_t completed = 0;
+  gin_helper::Promise<void> promise;
+};
+
+v8::Local<v8::Promise> Session::EvictStorage(const std::vector<GURL>& origins,
+                                             gin::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  ClearStorageDataOptions options;
+  args->GetNext(&options);
+
+  auto clear = std::make_unique<StorageClear>(std::move(promise));
+  for (const GURL& url : origins) {
+    url::Origin origin = url::Origin::Create(url);
+    if (origin.opaque()) {
+      clear->promise.RejectWithErrorMessage("Invalid origin: " + url.spec());
+      return handle;
+    }
+    clear->steps.push_back({blink::StorageKey::CreateFirstParty(origin),
+                            options.storage_types, "origin",
+                            origin.Serialize()});
+  }
+  clear->id = options.id;
+  clear->progress_event = "storage-eviction-progress";
+  clear->quota_types = options.quota_types;
+
+  if (options.storage_types & StoragePartition::REMOVE_DATA_MASK_COOKIES)
+    MediaDeviceIDSalt::Reset(browser_context()->prefs());
+
+  StartStorageClear(std::move(clear));
+  return handle;
+}
+
+void Session::CancelStorageClear(int32_t id) {
+  auto it = running_storage_clears_.find(id);
+  if (it == running_storage_clears_.end())
+    return;
+  running_storage_clears_.erase(it);
+  cancelled_storage_clears_.insert(id);
+}
+
+void Session::StartStorageClear(std::unique_ptr<StorageClear> clear) {
+  if (clear->id)
+    running_storage_clears_.insert(clear->id);
+  ClearNextStorage(std::move(clear));
+}
+
+void Session::ClearNextStorage(std::unique_ptr<StorageClear> clear) {
+  // A step which already started can't be interrupted, cancelling takes
+  // effect before the next one.
+  if (cancelled_storage_clears_.erase(clear->id)) {
+    clear->promise.RejectWithErrorMessage("The operation was aborted.");
+    return;
+  }
+  if (clear->completed == clear->steps.size()) {
+    running_storage_clears_.erase(clear->id);
+    clear->promise.Resolve();
+    return;
+  }
+  // Each step is a ClearData call of its own so that the backends keep
+  // serving the rest of the partition in between.
+  const StorageClear::Step& step = clear->steps[clear->completed];
+  const blink::StorageKey storage_key = step.storage_key;
+  const uint32_t storage_types = step.storage_types;
+  const uint32_t quota_types = clear->quota_types;
+  browser_context()->GetStoragePartition(nullptr)->ClearData(
+      storage_types, quota_types, storage_key, base::Time(), base::Time::Max(),
+      base::BindOnce(&Session::OnStorageCleared, weak_factory_.GetWeakPtr(),
+                     std::move(clear)));
+}
+
+void Session::OnStorageCleared(std::unique_ptr<StorageClear> clear) {
+  const StorageClear::Step& step = clear->steps[clear->completed++];
+  {
+    v8::HandleScope handle_scope(isolate_);
+    auto details = gin_helper::Dictionary::CreateEmpty(isolate_);
+    details.Set(step.key, step.value);
+    details.Set("completed", clear->completed);
+    details.Set("total", clear->steps.size());
+    Emit(clear->progress_event, details);
+  }
+  // The next step waits for the UI thread to be idle, so that the pages
+  // being loaded meanwhile go first.
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&Session::ClearNextStorage,
+                                weak_factory_.GetWeakPtr(), std::move(clear)));
+}
+
 void Session::FlushStorageData() {
   auto* storage_partition = browser_context()->GetStoragePartition(nullptr);
   storage_partition->Flush();
@@ -581,7 +999,14 @@ v8::Local<v8::Promise> Session::ForceReloadProxyConfig() {
   browser_context_->GetDefaultStoragePartition()
       ->GetNetworkContext()
       ->ForceReloadProxyConfig(base::BindOnce(
-          gin_helper::Promise<void>::ResolvePromise, std::move(promise)));
+          [](scoped_refptr<ResolveProxyHelper> resolve_proxy_helper,
+             gin_helper::Promise<void> promise) {
+            // The results cached before the reload may be out of date.
+            resolve_proxy_helper->ClearCache();
+            promise.Resolve();
+          },
+          base::WrapRefCounted(browser_context_->GetResolveProxyHelper()),
+          std::move(promise)));
 
   return handle;
 }
@@ -622,12 +1047,36 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
     args->ThrowTypeError("Must pass null or function");
     return;
   }
+  CertVerifierClient::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    double cache_ttl = 0;
+    if (dict.Get("cacheTtl", &cache_ttl) && cache_ttl > 0)
+      options.cache_ttl = base::Milliseconds(cache_ttl);
+    std::map<std::string, std::vector<std::string>> pins;
+    if (dict.Get("pins", &pins))
+      options.pins = {pins.begin(), pins.end()};
+  }
+  ApplyCertVerifyProc(proc, options);
+}
 
+void Session::ClearCertVerifyProcCache() {
+  if (cert_verify_cache_)
+    cert_verify_cache_->Clear();
+}
+
+void Session::ApplyCertVerifyProc(
+    const CertVerifierClient::CertVerifyProc& proc,
+    const CertVerifierClient::Options& options) {
+  cert_verify_proc_ = proc;
+  cert_verify_options_ = options;
+  // The results of the previous proc don't apply to this one.
+  cert_verify_cache_ = base::MakeRefCounted<CertVerifyResultCache>();
   mojo::PendingRemote<network::mojom::CertVerifierClient>
       cert_verifier_client_remote;
-  if (proc) {
+  if (proc || !options.pins.empty()) {
     mojo::MakeSelfOwnedReceiver(
-        std::make_unique<CertVerifierClient>(proc),
+        std::make_unique<CertVerifierClient>(proc, options, cert_verify_cache_),
         cert_verifier_client_remote.InitWithNewPipeAndPassReceiver());
   }
   browser_context_->GetDefaultStoragePartition()
@@ -635,6 +1084,82 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
       ->SetCertVerifierClient(std::move(cert_verifier_client_remote));
 }
 
+gin::Handle<Session> Session::CreateEphemeralSession(v8::Isolate* isolate) {
+  ElectronBrowserContext* browser_context;
+  if (!ephemeral_pool_.empty()) {
+    browser_context = ephemeral_pool_.back();
+    ephemeral_pool_.pop_back();
+  } else {
+    browser_context = ElectronBrowserContext::From(
+        base::Uuid::GenerateRandomV4().AsLowercaseString(), true);
+  }
+  FillEphemeralPool();
+
+  gin::Handle<Session> session = CreateFrom(isolate, browser_context);
+  session->CopySettingsFrom(this);
+  return session;
+}
+
+void Session::SetEphemeralPoolSize(size_t size) {
+  ephemeral_pool_size_ = size;
+  // The extra contexts are kept, they are all handed out eventually.
+  FillEphemeralPool();
+}
+
+void Session::CopySettingsFrom(Session* session) {
+  ElectronBrowserContext* source = session->browser_context();
+  SessionPreferences::FromBrowserContext(browser_context_)
+      ->set_preloads(
+          SessionPreferences::FromBrowserContext(source)->preloads());
+
+  static_cast<ElectronPermissionManager*>(
+      browser_context_->GetPermissionControllerDelegate())
+      ->CopyHandlersFrom(*static_cast<ElectronPermissionManager*>(
+          source->GetPermissionControllerDelegate()));
+
+  // The pooled contexts already have a network context: the user agent is
+  // pushed to it, and it observes the SSL config and the proxy pref.
+  const std::string user_agent = source->GetUserAgent();
+  if (user_agent != browser_context_->GetUserAgent()) {
+    browser_context_->SetUserAgent(user_agent);
+    browser_context_->GetDefaultStoragePartition()
+        ->GetNetworkContext()
+        ->SetUserAgent(user_agent);
+  }
+  browser_context_->SetSSLConfig(source->GetSSLConfig());
+  const base::Value* proxy = nullptr;
+  if (source->in_memory_pref_store()->GetValue(proxy_config::prefs::kProxy,
+                                               &proxy)) {
+    browser_context_->in_memory_pref_store()->SetValue(
+        proxy_config::prefs::kProxy, proxy->Clone(),
+        WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  }
+
+  if (session->cert_verify_proc_ || !session->cert_verify_options_.pins.empty())
+    ApplyCertVerifyProc(session->cert_verify_proc_,
+                        session->cert_verify_options_);
+}
+
+void Session::FillEphemeralPool() {
+  while (ephemeral_pool_.size() + pending_ephemeral_contexts_ <
+         ephemeral_pool_size_) {
+    pending_ephemeral_contexts_++;
+    ElectronBrowserContext::FromAsync(
+        base::Uuid::GenerateRandomV4().AsLowercaseString(), true, {},
+        base::BindOnce(&Session::OnEphemeralContextCreated,
+                       weak_factory_.GetWeakPtr()));
+  }
+}
+
+void Session::OnEphemeralContextCreated(
+    ElectronBrowserContext* browser_context) {
+  pending_ephemeral_contexts_--;
+  // Creating the network context is what makes a new session slow, it is
+  // done before the session is needed.
+  browser_context->GetDefaultStoragePartition()->GetNetworkContext();
+  ephemeral_pool_.push_back(browser_context);
+}
+
 void Session::SetPermissionRequestHandler(v8::Local<v8::Value> val,
                                           gin::Arguments* args) {
   auto* permission_manager = static_cast<ElectronPermissionManager*>(
@@ -673,6 +1198,12 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
   permission_manager->SetPermissionCheckHandler(handler);
 }
 
+void Session::ClearPermissionCheckCache() {
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->ClearPermissionCheckCache();
+}
+
 void Session::SetDisplayMediaRequestHandler(v8::Isolate* isolate,
                                             v8::Local<v8::Value> val) {
   if (val->IsNull()) {
@@ -804,14 +1335,41 @@ v8::Local<v8::Promise> Session::GetBlobData(v8::Isolate* isolate,
   return holder->ReadAll(isolate);
 }
 
+v8::Local<v8::Value> Session::GetBlobDataPipe(v8::Isolate* isolate,
+                                              const std::string& uuid) {
+  gin::Handle<DataPipeHolder> holder = DataPipeHolder::From(isolate, uuid);
+  if (holder.IsEmpty())
+    return v8::Null(isolate);
+  return holder.ToV8();
+}
+
+v8::Local<v8::Promise> Session::WriteBlobDataToFile(
+    v8::Isolate* isolate,
+    const std::string& uuid,
+    const base::FilePath& path) {
+  gin::Handle<DataPipeHolder> holder = DataPipeHolder::From(isolate, uuid);
+  if (holder.IsEmpty()) {
+    gin_helper::Promise<void> promise(isolate);
+    promise.RejectWithErrorMessage("Could not get blob data handle");
+    return promise.GetHandle();
+  }
+
+  return holder->WriteToFile(isolate, path);
+}
+
 void Session::DownloadURL(const GURL& url, gin::Arguments* args) {
   std::map<std::string, std::string> headers;
+  absl::optional<int> priority;
   gin_helper::Dictionary options;
   if (args->GetNext(&options)) {
     if (options.Has("headers") && !options.Get("headers", &headers)) {
       args->ThrowTypeError("Invalid value for headers - must be an object");
       return;
     }
+    if (options.Has("priority") && !options.Get("priority", &priority)) {
+      args->ThrowTypeError("Invalid value for priority - must be a number");
+      return;
+    }
   }
 
   auto download_params = std::make_unique<download::DownloadUrlParameters>(
@@ -821,6 +1379,16 @@ void Session::DownloadURL(const GURL& url, gin::Arguments* args) {
     download_params->add_request_header(name, value);
   }
 
+  // The queue finds the priority of the download with its guid once it is
+  // created.
+  if (priority) {
+    if (!download_queue_)
+      download_queue_ = std::make_unique<DownloadQueue>();
+    const std::string guid = base::Uuid::GenerateRandomV4().AsLowercaseString();
+    download_queue_->SetPriority(guid, *priority);
+    download_params->set_guid(guid);
+  }
+
   auto* download_manager = browser_context()->GetDownloadManager();
   download_manager->DownloadUrl(std::move(download_params));
 }
@@ -855,6 +1423,51 @@ void Session::CreateInterruptedDownload(const gin_helper::Dictionary& options) {
       length, last_modified, etag, base::Time::FromDoubleT(start_time)));
 }
 
+void Session::SetDownloadQueueOptions(const gin_helper::Dictionary& options) {
+  DownloadQueue::Options queue_options;
+  options.Get("maxConcurrent", &queue_options.max_concurrent);
+  options.Get("maxBytesPerSecond", &queue_options.max_bytes_per_second);
+  if (!download_queue_)
+    download_queue_ = std::make_unique<DownloadQueue>();
+  download_queue_->SetOptions(queue_options);
+}
+
+void Session::SetDownloadProgressInterval(double interval_ms) {
+  if (interval_ms <= 0) {
+    download_progress_timer_.Stop();
+    return;
+  }
+  // Unretained is safe as |download_progress_timer_| is owned by |this|.
+  download_progress_timer_.Start(
+      FROM_HERE, base::Milliseconds(interval_ms),
+      base::BindRepeating(&Session::EmitDownloadProgress,
+                          base::Unretained(this)));
+}
+
+void Session::EmitDownloadProgress() {
+  content::DownloadManager::DownloadVector items;
+  browser_context()->GetDownloadManager()->GetAllDownloads(&items);
+
+  v8::HandleScope handle_scope(isolate_);
+  std::vector<gin_helper::Dictionary> downloads;
+  for (download::DownloadItem* item : items) {
+    if (item->GetState() != download::DownloadItem::IN_PROGRESS ||
+        item->IsSavePackageDownload()) {
+      continue;
+    }
+    auto details = gin_helper::Dictionary::CreateEmpty(isolate_);
+    details.Set("item", DownloadItem::FromOrCreate(isolate_, item));
+    details.Set("receivedBytes", item->GetReceivedBytes());
+    details.Set("totalBytes", item->GetTotalBytes());
+    details.Set("bytesPerSecond", item->CurrentSpeed());
+    details.Set("paused", item->IsPaused());
+    downloads.push_back(details);
+  }
+  // Nothing is emitted while there are no downloads in progress.
+  if (!downloads.empty())
+    Emit("download-progress", downloads);
+}
+
 void Session::SetPreloads(const std::vector<base::FilePath>& preloads) {
   auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
   DCHECK(prefs);
@@ -1054,6 +1667,57 @@ v8::Local<v8::Promise> Session::CloseAllConnections() {
   return handle;
 }
 
+void Session::WarmConnections(
+    const std::vector<gin_helper::Dictionary>& targets,
+    gin::Arguments* args) {
+  std::vector<connection_warming::Target> warming_targets;
+  for (const gin_helper::Dictionary& options : targets) {
+    connection_warming::Target target;
+    if (!options.Get("url", &target.url) || !target.url.is_valid() ||
+        !target.url.SchemeIsHTTPOrHTTPS()) {
+      args->ThrowTypeError(
+          "Must pass valid http(s) urls to session.warmConnections.");
+      return;
+    }
+    options.Get("numSockets", &target.num_sockets);
+    const int kMaxSocketsToPreconnect = 6;
+    if (target.num_sockets < 0 ||
+        target.num_sockets > kMaxSocketsToPreconnect) {
+      args->ThrowTypeError(base::StringPrintf(
+          "numSockets is outside range [0,%d]", kMaxSocketsToPreconnect));
+      return;
+    }
+    options.Get("priority", &target.priority);
+    warming_targets.push_back(std::move(target));
+  }
+
+  bool persist = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("persist", &persist);
+  connection_warming::Warm(browser_context_, std::move(warming_targets),
+                           persist);
+}
+
+v8::Local<v8::Promise> Session::GetConnectionPoolInfo() {
+  gin_helper::Promise<base::Value::Dict> promise(isolate_);
+  auto handle = promise.GetHandle();
+
+  ConnectionPoolInfo::Get(
+      browser_context_->GetDefaultStoragePartition()->GetNetworkContext(),
+      base::BindOnce(
+          [](gin_helper::Promise<base::Value::Dict> promise,
+             ConnectionPoolInfo::Result result) {
+            if (result.has_value())
+              promise.Resolve(std::move(result).value());
+            else
+              promise.RejectWithErrorMessage(result.error());
+          },
+          std::move(promise)));
+
+  return handle;
+}
+
 v8::Local<v8::Value> Session::GetPath(v8::Isolate* isolate) {
   if (browser_context_->IsOffTheRecord()) {
     return v8::Null(isolate);
@@ -1061,6 +1725,33 @@ v8::Local<v8::Value> Session::GetPath(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, browser_context_->GetPath());
 }
 
+v8::Local<v8::Value> Session::GetCreationTimings(v8::Isolate* isolate) {
+  const ElectronBrowserContext::CreationTimings& timings =
+      browser_context_->creation_timings();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("async", timings.async);
+  dict.Set("prefsLoad", timings.prefs_load.InMillisecondsF());
+  dict.Set("contextInit", timings.context_init.InMillisecondsF());
+  dict.Set("extensionsInit", timings.extensions_init.InMillisecondsF());
+  dict.Set("total", timings.total.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+void Session::SetPreferencesCommitInterval(double interval_ms) {
+  browser_context_->user_pref_store()->SetCommitInterval(
+      base::Milliseconds(std::max(interval_ms, 0.0)));
+}
+
+v8::Local<v8::Value> Session::GetPreferencesWriteStats(v8::Isolate* isolate) {
+  const BatchingPrefStore::WriteStats& stats =
+      browser_context_->user_pref_store()->write_stats();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("writes", stats.writes);
+  dict.Set("bytes", stats.bytes);
+  dict.Set("batchedChanges", stats.batched_changes);
+  return dict.GetHandle();
+}
+
 void Session::SetCodeCachePath(gin::Arguments* args) {
   base::FilePath code_cache_path;
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
@@ -1076,6 +1767,71 @@ void Session::SetCodeCachePath(gin::Arguments* args) {
   }
 }
 
+void Session::SetSpareRenderer(gin::Arguments* args) {
+  auto* manager = SpareRendererManager::GetInstance();
+  v8::Local<v8::Value> value = args->PeekNext();
+  if (value.IsEmpty() || value->IsNullOrUndefined()) {
+    manager->Disable(browser_context_);
+    return;
+  }
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Options must be an object or null.");
+    return;
+  }
+  gin_helper::Dictionary web_preferences =
+      gin::Dictionary::CreateEmpty(args->isolate());
+  options.Get("webPreferences", &web_preferences);
+  manager->Enable(browser_context_, web_preferences);
+}
+
+v8::Local<v8::Value> Session::GetSpareRendererMetrics(v8::Isolate* isolate) {
+  SpareRendererManager::Metrics metrics =
+      SpareRendererManager::GetInstance()->GetMetrics(browser_context_);
+  return gin::DataObjectBuilder(isolate)
+      .Set("hits", static_cast<double>(metrics.hits))
+      .Set("misses", static_cast<double>(metrics.misses))
+      .Build();
+}
+
+void Session::SetRendererSharing(gin::Arguments* args) {
+  auto* manager = RendererSharingManager::GetInstance();
+  v8::Local<v8::Value> value = args->PeekNext();
+  if (value.IsEmpty() || value->IsNullOrUndefined()) {
+    manager->ClearPolicy(browser_context_);
+    return;
+  }
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Options must be an object or null.");
+    return;
+  }
+  double max_processes = 0;
+  double memory_budget = 0;
+  options.Get("maxProcesses", &max_processes);
+  options.Get("memoryBudget", &memory_budget);
+  if (!(max_processes >= 0) || !(memory_budget >= 0)) {
+    args->ThrowTypeError("maxProcesses and memoryBudget must not be negative.");
+    return;
+  }
+  RendererSharingManager::Policy policy;
+  policy.max_processes = static_cast<size_t>(max_processes);
+  policy.memory_budget = static_cast<uint64_t>(memory_budget);
+  manager->SetPolicy(browser_context_, policy);
+}
+
+v8::Local<v8::Value> Session::GetRendererSharingMetrics(
+    v8::Isolate* isolate) {
+  RendererSharingManager::Metrics metrics =
+      RendererSharingManager::GetInstance()->GetMetrics(browser_context_);
+  return gin::DataObjectBuilder(isolate)
+      .Set("processCount", static_cast<double>(metrics.process_count))
+      .Set("sharedWebContents",
+           static_cast<double>(metrics.shared_web_contents))
+      .Set("estimatedSavings", static_cast<double>(metrics.estimated_savings))
+      .Build();
+}
+
 v8::Local<v8::Promise> Session::ClearCodeCaches(
     const gin_helper::Dictionary& options) {
   auto* isolate = JavascriptEnvironment::GetIsolate();
@@ -1303,10 +2059,20 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                                  v8::Local<v8::ObjectTemplate> templ) {
   gin::ObjectTemplateBuilder(isolate, "Session", templ)
       .SetMethod("resolveHost", &Session::ResolveHost)
+      .SetMethod("resolveHosts", &Session::ResolveHosts)
+      .SetMethod("getHostResolverMetrics", &Session::GetHostResolverMetrics)
+      .SetMethod("setNetworkGroup", &Session::SetNetworkGroup)
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
+      .SetMethod("lookupCache", &Session::LookupCache)
+      .SetMethod("storeCache", &Session::StoreCache)
+      .SetMethod("evictCache", &Session::EvictCache)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
+      .SetMethod("getStorageUsage", &Session::GetStorageUsage)
+      .SetMethod("evictStorage", &Session::EvictStorage)
+      .SetMethod("_cancelStorageClear", &Session::CancelStorageClear)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("forceReloadProxyConfig", &Session::ForceReloadProxyConfig)
@@ -1314,10 +2080,16 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
       .SetMethod("disableNetworkEmulation", &Session::DisableNetworkEmulation)
       .SetMethod("setCertificateVerifyProc", &Session::SetCertVerifyProc)
+      .SetMethod("clearCertificateVerifyProcCache",
+                 &Session::ClearCertVerifyProcCache)
+      .SetMethod("createEphemeralSession", &Session::CreateEphemeralSession)
+      .SetMethod("setEphemeralPoolSize", &Session::SetEphemeralPoolSize)
       .SetMethod("setPermissionRequestHandler",
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("clearPermissionCheckCache",
+                 &Session::ClearPermissionCheckCache)
       .SetMethod("setDisplayMediaRequestHandler",
                  &Session::SetDisplayMediaRequestHandler)
       .SetMethod("setDevicePermissionHandler",
@@ -1335,9 +2107,14 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getUserAgent", &Session::GetUserAgent)
       .SetMethod("setSSLConfig", &Session::SetSSLConfig)
       .SetMethod("getBlobData", &Session::GetBlobData)
+      .SetMethod("_getBlobDataPipe", &Session::GetBlobDataPipe)
+      .SetMethod("writeBlobDataToFile", &Session::WriteBlobDataToFile)
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
+      .SetMethod("setDownloadQueueOptions", &Session::SetDownloadQueueOptions)
+      .SetMethod("setDownloadProgressInterval",
+                 &Session::SetDownloadProgressInterval)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -1366,9 +2143,21 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
       .SetMethod("closeAllConnections", &Session::CloseAllConnections)
+      .SetMethod("warmConnections", &Session::WarmConnections)
+      .SetMethod("getConnectionPoolInfo", &Session::GetConnectionPoolInfo)
       .SetMethod("getStoragePath", &Session::GetPath)
+      .SetMethod("getCreationTimings", &Session::GetCreationTimings)
+      .SetMethod("setPreferencesCommitInterval",
+                 &Session::SetPreferencesCommitInterval)
+      .SetMethod("getPreferencesWriteStats",
+                 &Session::GetPreferencesWriteStats)
       .SetMethod("setCodeCachePath", &Session::SetCodeCachePath)
       .SetMethod("clearCodeCaches", &Session::ClearCodeCaches)
+      .SetMethod("setSpareRenderer", &Session::SetSpareRenderer)
+      .SetMethod("getSpareRendererMetrics", &Session::GetSpareRendererMetrics)
+      .SetMethod("setRendererSharing", &Session::SetRendererSharing)
+      .SetMethod("getRendererSharingMetrics",
+                 &Session::GetRendererSharingMetrics)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
@@ -1400,6 +2189,39 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
       .ToV8();
 }
 
+v8::Local<v8::Promise> FromPartitionAsync(const std::string& partition,
+                                          gin::Arguments* args) {
+  gin_helper::Promise<gin::Handle<Session>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!electron::Browser::Get()->is_ready()) {
+    promise.RejectWithErrorMessage(
+        "Session can only be received when app is ready");
+    return handle;
+  }
+  base::Value::Dict options;
+  args->GetNext(&options);
+
+  std::string name = partition;
+  bool in_memory = false;
+  if (base::StartsWith(partition, kPersistPrefix,
+                       base::CompareCase::SENSITIVE)) {
+    name = partition.substr(8);
+  } else if (!partition.empty()) {
+    in_memory = true;
+  }
+  ElectronBrowserContext::FromAsync(
+      name, in_memory, std::move(options),
+      base::BindOnce(
+          [](gin_helper::Promise<gin::Handle<Session>> promise,
+             ElectronBrowserContext* browser_context) {
+            v8::HandleScope handle_scope(promise.isolate());
+            promise.Resolve(
+                Session::CreateFrom(promise.isolate(), browser_context));
+          },
+          std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Value> FromPath(const base::FilePath& path,
                               gin::Arguments* args) {
   if (!electron::Browser::Get()->is_ready()) {
@@ -1425,6 +2247,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("Session", Session::GetConstructor(context));
   dict.SetMethod("fromPartition", &FromPartition);
+  dict.SetMethod("fromPartitionAsync", &FromPartitionAsync);
   dict.SetMethod("fromPath", &FromPath);
 }
 
@@ -5,10 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SESSION_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SESSION_H_
 
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
 #include "electron/buildflags/buildflags.h"
@@ -17,6 +21,7 @@
 #include "services/network/public/mojom/host_resolver.mojom.h"
 #include "services/network/public/mojom/ssl_config.mojom.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/net/cert_verifier_client.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/constructible.h"
@@ -54,6 +59,7 @@ class ProxyConfig;
 
 namespace electron {
 
+class DownloadQueue;
 class ElectronBrowserContext;
 
 namespace api {
@@ -101,10 +107,25 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Promise> ResolveHost(
       std::string host,
       absl::optional<network::mojom::ResolveHostParametersPtr> params);
+  v8::Local<v8::Promise> ResolveHosts(
+      std::vector<std::string> hosts,
+      absl::optional<network::mojom::ResolveHostParametersPtr> params);
+  gin_helper::Dictionary GetHostResolverMetrics();
+  void SetNetworkGroup(const std::string& group);
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
   v8::Local<v8::Promise> ClearCache();
+  v8::Local<v8::Promise> LookupCache(const GURL& url);
+  v8::Local<v8::Promise> StoreCache(const GURL& url);
+  v8::Local<v8::Promise> EvictCache(const GURL& url_prefix);
+  v8::Local<v8::Promise> GetCacheStats();
   v8::Local<v8::Promise> ClearStorageData(gin::Arguments* args);
+  v8::Local<v8::Promise> GetStorageUsage(gin::Arguments* args);
+  // Clears the storage of |origins| one at a time, at background priority,
+  // and emits the progress after each one.
+  v8::Local<v8::Promise> EvictStorage(const std::vector<GURL>& origins,
+                                      gin::Arguments* args);
+  void CancelStorageClear(int32_t id);
   void FlushStorageData();
   v8::Local<v8::Promise> SetProxy(gin::Arguments* args);
   v8::Local<v8::Promise> ForceReloadProxyConfig();
@@ -112,10 +133,16 @@ class Session : public gin::Wrappable<Session>,
   void EnableNetworkEmulation(const gin_helper::Dictionary& options);
   void DisableNetworkEmulation();
   void SetCertVerifyProc(v8::Local<v8::Value> proc, gin::Arguments* args);
+  void ClearCertVerifyProcCache();
+  // Creates an in-memory session with the settings of this one, from the
+  // pool of pre-created sessions when it is not empty.
+  gin::Handle<Session> CreateEphemeralSession(v8::Isolate* isolate);
+  void SetEphemeralPoolSize(size_t size);
   void SetPermissionRequestHandler(v8::Local<v8::Value> val,
                                    gin::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  gin::Arguments* args);
+  void ClearPermissionCheckCache();
   void SetDevicePermissionHandler(v8::Local<v8::Value> val,
                                   gin::Arguments* args);
   void SetUSBProtectedClassesHandler(v8::Local<v8::Value> val,
@@ -131,8 +158,15 @@ class Session : public gin::Wrappable<Session>,
   bool IsPersistent();
   v8::Local<v8::Promise> GetBlobData(v8::Isolate* isolate,
                                      const std::string& uuid);
+  v8::Local<v8::Value> GetBlobDataPipe(v8::Isolate* isolate,
+                                       const std::string& uuid);
+  v8::Local<v8::Promise> WriteBlobDataToFile(v8::Isolate* isolate,
+                                             const std::string& uuid,
+                                             const base::FilePath& path);
   void DownloadURL(const GURL& url, gin::Arguments* args);
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
+  void SetDownloadQueueOptions(const gin_helper::Dictionary& options);
+  void SetDownloadProgressInterval(double interval_ms);
   void SetPreloads(const std::vector<base::FilePath>& preloads);
   std::vector<base::FilePath> GetPreloads() const;
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
@@ -142,9 +176,19 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options, gin::Arguments* args);
   v8::Local<v8::Promise> CloseAllConnections();
+  void WarmConnections(const std::vector<gin_helper::Dictionary>& targets,
+                       gin::Arguments* args);
+  v8::Local<v8::Promise> GetConnectionPoolInfo();
   v8::Local<v8::Value> GetPath(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetCreationTimings(v8::Isolate* isolate);
+  void SetPreferencesCommitInterval(double interval_ms);
+  v8::Local<v8::Value> GetPreferencesWriteStats(v8::Isolate* isolate);
   void SetCodeCachePath(gin::Arguments* args);
   v8::Local<v8::Promise> ClearCodeCaches(const gin_helper::Dictionary& options);
+  void SetSpareRenderer(gin::Arguments* args);
+  v8::Local<v8::Value> GetSpareRendererMetrics(v8::Isolate* isolate);
+  void SetRendererSharing(gin::Arguments* args);
+  v8::Local<v8::Value> GetRendererSharingMetrics(v8::Isolate* isolate);
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   base::Value GetSpellCheckerLanguages();
   void SetSpellCheckerLanguages(gin_helper::ErrorThrower thrower,
@@ -198,6 +242,19 @@ class Session : public gin::Wrappable<Session>,
  private:
   void SetDisplayMediaRequestHandler(v8::Isolate* isolate,
                                      v8::Local<v8::Value> val);
+  void ApplyCertVerifyProc(const CertVerifierClient::CertVerifyProc& proc,
+                           const CertVerifierClient::Options& options);
+  // Applies the settings of |session| which a clone shares. They are applied
+  // to the context itself when its network context doesn't exist yet.
+  void CopySettingsFrom(Session* session);
+  void FillEphemeralPool();
+  void OnEphemeralContextCreated(ElectronBrowserContext* browser_context);
+  void EmitDownloadProgress();
+  // A clear of the storage split in steps, run one after the other.
+  struct StorageClear;
+  void StartStorageClear(std::unique_ptr<StorageClear> clear);
+  void ClearNextStorage(std::unique_ptr<StorageClear> clear);
+  void OnStorageCleared(std::unique_ptr<StorageClear> clear);
 
   // Cached gin_helper::Wrappable objects.
   v8::Global<v8::Value> cookies_;
@@ -212,6 +269,25 @@ class Session : public gin::Wrappable<Session>,
   base::UnguessableToken network_emulation_token_;
 
   raw_ptr<ElectronBrowserContext> browser_context_;
+
+  CertVerifierClient::CertVerifyProc cert_verify_proc_;
+  CertVerifierClient::Options cert_verify_options_;
+  scoped_refptr<CertVerifyResultCache> cert_verify_cache_;
+
+  // Created once a limit or a priority is set for the downloads.
+  std::unique_ptr<DownloadQueue> download_queue_;
+  base::RepeatingTimer download_progress_timer_;
+
+  // The contexts ready to be handed out by CreateEphemeralSession().
+  std::vector<raw_ptr<ElectronBrowserContext>> ephemeral_pool_;
+  size_t ephemeral_pool_size_ = 0;
+  size_t pending_ephemeral_contexts_ = 0;
+
+  // The ids of the cancellable storage clears.
+  std::set<int32_t> running_storage_clears_;
+  std::set<int32_t> cancelled_storage_clears_;
+
+  base::WeakPtrFactory<Session> weak_factory_{this};
 };
 
 }  // namespace api
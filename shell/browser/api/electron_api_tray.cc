@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_tray.h"
 
 #include <string>
+#include <utility>
 
 #include "base/containers/fixed_flat_map.h"
 #include "gin/dictionary.h"
@@ -186,6 +187,13 @@ void Tray::SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
   if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
     return;
 
+  tray_icon_->StopAnimation();
+  // Status indicators often set the image they already show, which would
+  // still be converted and pushed to the system.
+  if (!image_.IsEmpty() && native_image->image().BackedBySameObjectAs(image_))
+    return;
+  image_ = native_image->image();
+
 #if BUILDFLAG(IS_WIN)
   tray_icon_->SetImage(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
 #else
@@ -209,6 +217,39 @@ void Tray::SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
 #endif
 }
 
+void Tray::SetAnimatedImage(
+    v8::Isolate* isolate,
+    const std::vector<v8::Local<v8::Value>>& images,
+    const absl::optional<gin_helper::Dictionary>& options,
+    gin::Arguments* args) {
+  if (!CheckAlive())
+    return;
+
+  int interval = 100;
+  if (options && options->Get("interval", &interval) && interval <= 0) {
+    args->ThrowTypeError("interval must be a positive number");
+    return;
+  }
+
+  std::vector<TrayIcon::AnimationFrame> frames;
+  frames.reserve(images.size());
+  for (v8::Local<v8::Value> image : images) {
+    NativeImage* native_image = nullptr;
+    if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
+      return;
+#if BUILDFLAG(IS_WIN)
+    // The icon belongs to |native_image|, which can be garbage collected.
+    frames.emplace_back(
+        CopyIcon(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON))));
+#else
+    frames.push_back(native_image->image());
+#endif
+  }
+
+  image_ = gfx::Image();
+  tray_icon_->SetAnimation(std::move(frames), base::Milliseconds(interval));
+}
+
 void Tray::SetToolTip(const std::string& tool_tip) {
   if (!CheckAlive())
     return;
@@ -391,6 +432,7 @@ void Tray::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isDestroyed", &Tray::IsDestroyed)
       .SetMethod("setImage", &Tray::SetImage)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
+      .SetMethod("setAnimatedImage", &Tray::SetAnimatedImage)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
       .SetMethod("getTitle", &Tray::GetTitle)
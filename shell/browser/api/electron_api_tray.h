@@ -20,6 +20,7 @@
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "ui/gfx/image/image.h"
 
 namespace gfx {
 class Image;
@@ -86,6 +87,10 @@ class Tray : public gin::Wrappable<Tray>,
   bool IsDestroyed();
   void SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
   void SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
+  void SetAnimatedImage(v8::Isolate* isolate,
+                        const std::vector<v8::Local<v8::Value>>& images,
+                        const absl::optional<gin_helper::Dictionary>& options,
+                        gin::Arguments* args);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title,
                 const absl::optional<gin_helper::Dictionary>& options,
@@ -107,6 +112,10 @@ class Tray : public gin::Wrappable<Tray>,
 
   v8::Global<v8::Value> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
+
+  // The image last passed to setImage(), so that setting it again doesn't
+  // push it to the system again.
+  gfx::Image image_;
 };
 
 }  // namespace electron::api
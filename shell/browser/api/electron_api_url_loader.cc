@@ -5,14 +5,17 @@
 #include "shell/browser/api/electron_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/containers/fixed_flat_map.h"
+#include "base/functional/callback_helpers.h"
 #include "base/memory/raw_ptr.h"
 #include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
@@ -32,9 +35,11 @@
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/net/asar/asar_url_loader_factory.h"
+#include "shell/browser/net/host_resolution_tracker.h"
 #include "shell/browser/net/proxying_url_loader_factory.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -308,6 +313,9 @@ const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
           setting: "This feature cannot be disabled."
         })");
 
+// Bounds the memory a request holds on to while coalescing its body.
+constexpr uint32_t kMaxReadSize = 64 * 1024 * 1024;
+
 }  // namespace
 
 gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
@@ -316,10 +324,14 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     ElectronBrowserContext* browser_context,
     std::unique_ptr<network::ResourceRequest> request,
-    int options)
+    int options,
+    base::FilePath response_file,
+    size_t read_size)
     : browser_context_(browser_context),
       request_options_(options),
-      request_(std::move(request)) {
+      request_(std::move(request)),
+      response_file_(std::move(response_file)),
+      read_size_(read_size) {
   if (!request_->trusted_params)
     request_->trusted_params = network::ResourceRequest::TrustedParams();
   mojo::PendingRemote<network::mojom::URLLoaderNetworkServiceObserver>
@@ -367,7 +379,16 @@ void SimpleURLLoaderWrapper::Start() {
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
   url_loader_factory_ = GetURLLoaderFactoryForURL(request_ref->url);
-  loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  if (!response_file_.empty()) {
+    // SimpleURLLoader writes the file on a sequence of its own.
+    loader_->DownloadToFile(
+        url_loader_factory_.get(),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        response_file_);
+  } else {
+    loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -482,10 +503,8 @@ SimpleURLLoaderWrapper::GetURLLoaderFactoryForURL(const GURL& url) {
             std::move(pending_remote)));
   } else if (!bypass_custom_protocol_handlers &&
              protocol_registry->IsProtocolRegistered(url.scheme())) {
-    auto& protocol_handler = protocol_registry->handlers().at(url.scheme());
     mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote =
-        ElectronURLLoaderFactory::Create(protocol_handler.first,
-                                         protocol_handler.second);
+        protocol_registry->CreateURLLoaderFactory(url.scheme());
     url_loader_factory = network::SharedURLLoaderFactory::Create(
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
@@ -636,7 +655,14 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 
   v8::Local<v8::Value> body;
   v8::Local<v8::Value> chunk_pipe_getter;
-  if (opts.Get("body", &body)) {
+  base::FilePath upload_file;
+  if (opts.Get("uploadFile", &upload_file) && !upload_file.empty()) {
+    // Read by the network service, the body never reaches JS.
+    request->request_body =
+        base::MakeRefCounted<network::ResourceRequestBody>();
+    request->request_body->AppendFileRange(
+        upload_file, 0, std::numeric_limits<uint64_t>::max(), base::Time());
+  } else if (opts.Get("body", &body)) {
     if (body->IsArrayBufferView()) {
       auto buffer_body = body.As<v8::ArrayBufferView>();
       auto backing_store = buffer_body->Buffer()->GetBackingStore();
@@ -660,6 +686,18 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     }
   }
 
+  base::FilePath response_file;
+  opts.Get("responseFile", &response_file);
+
+  uint32_t read_size = 0;
+  if (opts.Has("readSize") &&
+      (!opts.Get("readSize", &read_size) || read_size == 0 ||
+       read_size > kMaxReadSize)) {
+    args->ThrowTypeError(
+        base::StringPrintf("readSize must be between 1 and %u", kMaxReadSize));
+    return gin::Handle<SimpleURLLoaderWrapper>();
+  }
+
   std::string partition;
   gin::Handle<Session> session;
   if (!opts.Get("session", &session)) {
@@ -670,8 +708,9 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
   }
 
   auto ret = gin::CreateHandle(
-      args->isolate(), new SimpleURLLoaderWrapper(session->browser_context(),
-                                                  std::move(request), options));
+      args->isolate(),
+      new SimpleURLLoaderWrapper(session->browser_context(), std::move(request),
+                                 options, std::move(response_file), read_size));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -682,16 +721,59 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
                                             base::OnceClosure resume) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  if (read_size_ == 0) {
+    v8::HandleScope handle_scope(isolate);
+    auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
+    auto backing_store = array_buffer->GetBackingStore();
+    memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
+    Emit("data", array_buffer,
+         base::AdaptCallbackForRepeating(std::move(resume)));
+    return;
+  }
+
+  // Copy into chunks of |read_size_| and only emit the full ones, so that
+  // a large body costs a few events rather than one per read of the pipe.
+  while (!string_piece.empty()) {
+    if (!pending_chunk_)
+      pending_chunk_ = v8::ArrayBuffer::NewBackingStore(isolate, read_size_);
+    const size_t size =
+        std::min(string_piece.size(), read_size_ - pending_chunk_size_);
+    memcpy(static_cast<char*>(pending_chunk_->Data()) + pending_chunk_size_,
+           string_piece.data(), size);
+    pending_chunk_size_ += size;
+    string_piece.remove_prefix(size);
+    if (pending_chunk_size_ < read_size_)
+      break;
+    // Only the last chunk of the read waits for JS to ask for more.
+    FlushPendingChunk(string_piece.empty()
+                          ? std::move(resume)
+                          : base::OnceClosure(base::DoNothing()));
+  }
+  if (resume)
+    std::move(resume).Run();
+}
+
+void SimpleURLLoaderWrapper::FlushPendingChunk(base::OnceClosure resume) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
-  auto backing_store = array_buffer->GetBackingStore();
-  memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
-  Emit("data", array_buffer,
+  std::unique_ptr<v8::BackingStore> chunk = std::move(pending_chunk_);
+  if (pending_chunk_size_ < chunk->ByteLength()) {
+    auto last_chunk =
+        v8::ArrayBuffer::NewBackingStore(isolate, pending_chunk_size_);
+    memcpy(last_chunk->Data(), chunk->Data(), pending_chunk_size_);
+    chunk = std::move(last_chunk);
+  }
+  pending_chunk_size_ = 0;
+  Emit("data", v8::ArrayBuffer::New(isolate, std::move(chunk)),
        base::AdaptCallbackForRepeating(std::move(resume)));
 }
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
+  if (pending_chunk_size_ > 0)
+    FlushPendingChunk(base::DoNothing());
+  if (response_from_cache_)
+    browser_context_->http_cache_stats().bytes_from_cache += bytes_received_;
   if (success) {
     Emit("complete");
   } else {
@@ -704,6 +786,11 @@ void SimpleURLLoaderWrapper::OnComplete(bool success) {
 
 void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  // The path is empty if the request or writing the file failed.
+  OnComplete(!path.empty());
+}
+
 void SimpleURLLoaderWrapper::OnResponseStarted(
     const GURL& final_url,
     const network::mojom::URLResponseHead& response_head) {
@@ -716,6 +803,19 @@ void SimpleURLLoaderWrapper::OnResponseStarted(
   dict.Set("headers", response_head.headers.get());
   dict.Set("rawHeaders", response_head.raw_response_headers);
   dict.Set("mimeType", response_head.mime_type);
+  dict.Set("fromCache", response_head.was_fetched_via_cache);
+
+  response_from_cache_ = response_head.was_fetched_via_cache;
+  ElectronBrowserContext::HttpCacheStats& stats =
+      browser_context_->http_cache_stats();
+  ++stats.requests;
+  if (response_from_cache_)
+    ++stats.hits;
+  // Remembered so the host can be resolved as soon as the session is created
+  // the next time.
+  if (final_url.SchemeIsHTTPOrHTTPS())
+    browser_context_->GetHostResolutionTracker()->RecordUse(final_url.host());
+
   Emit("response-started", final_url, dict);
 }
 
@@ -772,6 +872,7 @@ void SimpleURLLoaderWrapper::OnUploadProgress(uint64_t position,
 }
 
 void SimpleURLLoaderWrapper::OnDownloadProgress(uint64_t current) {
+  bytes_received_ = current;
   Emit("download-progress", current);
 }
 
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "gin/wrappable.h"
@@ -62,7 +63,9 @@ class SimpleURLLoaderWrapper
  private:
   SimpleURLLoaderWrapper(ElectronBrowserContext* browser_context,
                          std::unique_ptr<network::ResourceRequest> request,
-                         int options);
+                         int options,
+                         base::FilePath response_file,
+                         size_t read_size);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -128,6 +131,10 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
+
+  // Emits the body received since the last chunk.
+  void FlushPendingChunk(base::OnceClosure resume);
 
   void Start();
   void Pin();
@@ -136,6 +143,15 @@ class SimpleURLLoaderWrapper
   raw_ptr<ElectronBrowserContext> browser_context_;
   int request_options_;
   std::unique_ptr<network::ResourceRequest> request_;
+  // When set, the body is written to this file instead of emitted.
+  const base::FilePath response_file_;
+  // When non-zero, the body is emitted in chunks of this size, except for the
+  // last one, instead of as it arrives.
+  const size_t read_size_;
+  std::unique_ptr<v8::BackingStore> pending_chunk_;
+  size_t pending_chunk_size_ = 0;
+  bool response_from_cache_ = false;
+  uint64_t bytes_received_ = 0;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
   v8::Global<v8::Value> pinned_wrapper_;
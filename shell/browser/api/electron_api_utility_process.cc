@@ -5,28 +5,44 @@
 #include "shell/browser/api/electron_api_utility_process.h"
 
 #include <map>
+#include <memory>
+#include <string>
 #include <utility>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/no_destructor.h"
 #include "base/process/kill.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/child_process_host.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/common/result_codes.h"
+#include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/electron_sync_ipc_handler_impl.h"
+#include "shell/browser/heap_snapshot_progress_emitter.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/spare_utility_process_manager.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/shared_memory_array_buffer.h"
+#include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/messaging/message_port_descriptor.h"
 #include "third_party/blink/public/common/messaging/transferable_message_mojom_traits.h"
@@ -51,18 +67,163 @@ GetAllUtilityProcessWrappers() {
   return *s_all_utility_process_wrappers;
 }
 
+namespace {
+
+// Channels routed with child.routeInvoke(), see
+// UtilityProcessWrapper::FromInvokeChannel().
+std::map<std::string, api::UtilityProcessWrapper*>& GetInvokeRoutes() {
+  static base::NoDestructor<std::map<std::string, api::UtilityProcessWrapper*>>
+      s_invoke_routes;
+  return *s_invoke_routes;
+}
+
+// The reply sent when the child exits before replying to an invoke().
+bool SerializeExitedError(const std::string& channel,
+                          blink::TransferableMessage* out) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  const std::string error =
+      "Utility process exited before replying to '" + channel + "'";
+  auto reply = gin::DataObjectBuilder(isolate).Set("error", error).Build();
+  return electron::SerializeV8Value(isolate, reply, out);
+}
+
+// Replies to the renderer with an error if the child never replies, e.g.
+// because it exited. Mojo requires reply callbacks to be run before they are
+// destroyed.
+class InvokeReply {
+ public:
+  InvokeReply(const std::string& channel,
+              mojom::ElectronApiIPC::InvokeCallback callback)
+      : channel_(channel), callback_(std::move(callback)) {}
+  ~InvokeReply() {
+    // If there's no current context, it means we're shutting down, so we
+    // don't need to reply.
+    if (!callback_ ||
+        JavascriptEnvironment::GetIsolate()->GetCurrentContext().IsEmpty())
+      return;
+    blink::TransferableMessage message;
+    if (SerializeExitedError(channel_, &message))
+      std::move(callback_).Run(std::move(message));
+  }
+
+  // disable copy
+  InvokeReply(const InvokeReply&) = delete;
+  InvokeReply& operator=(const InvokeReply&) = delete;
+
+  void Run(blink::TransferableMessage result) {
+    std::move(callback_).Run(std::move(result));
+  }
+
+ private:
+  std::string channel_;
+  mojom::ElectronApiIPC::InvokeCallback callback_;
+};
+
+}  // namespace
+
 namespace api {
 
 gin::WrapperInfo UtilityProcessWrapper::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
+// Unretained is safe as |buffered_amount_| is owned by |this|.
 UtilityProcessWrapper::UtilityProcessWrapper(
     node::mojom::NodeServiceParamsPtr params,
     std::u16string display_name,
     std::map<IOHandle, IOType> stdio,
+    SinkOptions sink_options,
     base::EnvironmentMap env_map,
     base::FilePath current_working_directory,
+    bool use_plugin_helper)
+    : buffered_amount_(
+          base::BindRepeating(&UtilityProcessWrapper::OnWatermark,
+                              base::Unretained(this))) {
+  absl::optional<SpareUtilityProcessManager::Spare> spare;
+  if (CanUseSpare(*params, display_name, stdio, env_map,
+                  current_working_directory, use_plugin_helper)) {
+    spare = SpareUtilityProcessManager::GetInstance()->TakeSpare();
+  }
+  if (spare) {
+    from_spare_ = true;
+    node_service_remote_ = std::move(spare->node_service);
+    // The process has launched already, 'spawn' is emitted once the caller
+    // of fork() could listen to it.
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UtilityProcessWrapper::OnSpareProcessClaimed,
+                       weak_factory_.GetWeakPtr(), std::move(spare->process)));
+  } else if (!LaunchServiceProcess(display_name, stdio, sink_options, env_map,
+                                   current_working_directory,
+                                   use_plugin_helper, params->exec_args)) {
+    return;
+  }
+  node_service_remote_.set_disconnect_with_reason_handler(
+      base::BindOnce(&UtilityProcessWrapper::OnServiceProcessDisconnected,
+                     weak_factory_.GetWeakPtr()));
+
+  // We use a separate message pipe to support postMessage API
+  // instead of the existing receiver interface so that we can
+  // support queuing of messages without having to block other
+  // interfaces.
+  blink::MessagePortDescriptorPair pipe;
+  host_port_ = pipe.TakePort0();
+  params->port = pipe.TakePort1();
+  connector_ = std::make_unique<mojo::Connector>(
+      host_port_.TakeHandleToEntangleWithEmbedder(),
+      mojo::Connector::SINGLE_THREADED_SEND,
+      base::SingleThreadTaskRunner::GetCurrentDefault());
+  connector_->set_incoming_receiver(this);
+  connector_->set_connection_error_handler(base::BindOnce(
+      &UtilityProcessWrapper::CloseConnectorPort, weak_factory_.GetWeakPtr()));
+  buffered_amount_.SetPipe(connector_->handle());
+
+  params->ipc_invoke_handler =
+      ipc_invoke_handler_remote_.BindNewPipeAndPassReceiver();
+  mojo::PendingRemote<node::mojom::IpcInvokeHandler> sync_invoke_handler;
+  params->ipc_sync_invoke_handler =
+      sync_invoke_handler.InitWithNewPipeAndPassReceiver();
+  ipc_sync_invoke_handler_remote_ =
+      mojo::SharedRemote<node::mojom::IpcInvokeHandler>(
+          std::move(sync_invoke_handler),
+          ElectronSyncIPCHandlerImpl::GetTaskRunner());
+
+  node_service_remote_->Initialize(
+      std::move(params),
+      base::BindOnce(&UtilityProcessWrapper::OnServiceInitialized,
+                     weak_factory_.GetWeakPtr()));
+}
+
+UtilityProcessWrapper::~UtilityProcessWrapper() {
+  ClearInvokeRoutes();
+}
+
+// static
+bool UtilityProcessWrapper::CanUseSpare(
+    const node::mojom::NodeServiceParams& params,
+    const std::u16string& display_name,
+    const std::map<IOHandle, IOType>& stdio,
+    const base::EnvironmentMap& env_map,
+    const base::FilePath& current_working_directory,
     bool use_plugin_helper) {
+  // These are applied when the process is launched, the spares are launched
+  // with the defaults.
+  for (const auto& [io_handle, io_type] : stdio) {
+    if (io_handle != IOHandle::STDIN && io_type != IOType::IO_INHERIT)
+      return false;
+  }
+  return params.exec_args.empty() && display_name.empty() && env_map.empty() &&
+         current_working_directory.empty() && !use_plugin_helper;
+}
+
+bool UtilityProcessWrapper::LaunchServiceProcess(
+    const std::u16string& display_name,
+    const std::map<IOHandle, IOType>& stdio,
+    const SinkOptions& sink_options,
+    const base::EnvironmentMap& env_map,
+    const base::FilePath& current_working_directory,
+    bool use_plugin_helper,
+    const std::vector<std::string>& exec_args) {
 #if BUILDFLAG(IS_WIN)
   base::win::ScopedHandle stdout_write(nullptr);
   base::win::ScopedHandle stderr_write(nullptr);
@@ -70,7 +231,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
   base::FileHandleMappingVector fds_to_remap;
 #endif
   for (const auto& [io_handle, io_type] : stdio) {
-    if (io_type == IOType::IO_PIPE) {
+    if (io_type == IOType::IO_PIPE || io_type == IOType::IO_SINK) {
 #if BUILDFLAG(IS_WIN)
       HANDLE read = nullptr;
       HANDLE write = nullptr;
@@ -86,9 +247,15 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       // https://source.chromium.org/chromium/chromium/src/+/main:base/process/launch_win.cc;l=303-332
       if (!::CreatePipe(&read, &write, nullptr, 0)) {
         PLOG(ERROR) << "pipe creation failed";
-        return;
+        return false;
       }
-      if (io_handle == IOHandle::STDOUT) {
+      if (io_type == IOType::IO_SINK) {
+        auto& write_handle =
+            io_handle == IOHandle::STDOUT ? stdout_write : stderr_write;
+        write_handle.Set(write);
+        stdio_sinks_[io_handle] = UtilityProcessStdioSink::Start(
+            base::File(read), sink_options.at(io_handle));
+      } else if (io_handle == IOHandle::STDOUT) {
         stdout_write.Set(write);
         stdout_read_handle_ = read;
         stdout_read_fd_ =
@@ -103,9 +270,15 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       int pipe_fd[2];
       if (HANDLE_EINTR(pipe(pipe_fd)) < 0) {
         PLOG(ERROR) << "pipe creation failed";
-        return;
+        return false;
       }
-      if (io_handle == IOHandle::STDOUT) {
+      if (io_type == IOType::IO_SINK) {
+        fds_to_remap.emplace_back(pipe_fd[1], io_handle == IOHandle::STDOUT
+                                                  ? STDOUT_FILENO
+                                                  : STDERR_FILENO);
+        stdio_sinks_[io_handle] = UtilityProcessStdioSink::Start(
+            base::File(pipe_fd[0]), sink_options.at(io_handle));
+      } else if (io_handle == IOHandle::STDOUT) {
         fds_to_remap.emplace_back(pipe_fd[1], STDOUT_FILENO);
         stdout_read_fd_ = pipe_fd[0];
       } else if (io_handle == IOHandle::STDERR) {
@@ -121,7 +294,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
                       OPEN_EXISTING, 0, nullptr);
       if (handle == INVALID_HANDLE_VALUE) {
         PLOG(ERROR) << "Failed to create null handle";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         stdout_write.Set(handle);
@@ -132,7 +305,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       int devnull = open("/dev/null", O_WRONLY);
       if (devnull < 0) {
         PLOG(ERROR) << "failed to open /dev/null";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         fds_to_remap.emplace_back(devnull, STDOUT_FILENO);
@@ -152,7 +325,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
           .WithDisplayName(display_name.empty()
                                ? std::u16string(u"Node Utility Process")
                                : display_name)
-          .WithExtraCommandLineSwitches(params->exec_args)
+          .WithExtraCommandLineSwitches(exec_args)
           .WithCurrentDirectory(current_working_directory)
           // Inherit parent process environment when there is no custom
           // environment provided by the user.
@@ -173,29 +346,20 @@ UtilityProcessWrapper::UtilityProcessWrapper(
               base::BindOnce(&UtilityProcessWrapper::OnServiceProcessLaunched,
                              weak_factory_.GetWeakPtr()))
           .Pass());
-  node_service_remote_.set_disconnect_with_reason_handler(
-      base::BindOnce(&UtilityProcessWrapper::OnServiceProcessDisconnected,
-                     weak_factory_.GetWeakPtr()));
-
-  // We use a separate message pipe to support postMessage API
-  // instead of the existing receiver interface so that we can
-  // support queuing of messages without having to block other
-  // interfaces.
-  blink::MessagePortDescriptorPair pipe;
-  host_port_ = pipe.TakePort0();
-  params->port = pipe.TakePort1();
-  connector_ = std::make_unique<mojo::Connector>(
-      host_port_.TakeHandleToEntangleWithEmbedder(),
-      mojo::Connector::SINGLE_THREADED_SEND,
-      base::SingleThreadTaskRunner::GetCurrentDefault());
-  connector_->set_incoming_receiver(this);
-  connector_->set_connection_error_handler(base::BindOnce(
-      &UtilityProcessWrapper::CloseConnectorPort, weak_factory_.GetWeakPtr()));
+  return true;
+}
 
-  node_service_remote_->Initialize(std::move(params));
+void UtilityProcessWrapper::OnSpareProcessClaimed(base::Process process) {
+  // The spare exited before 'spawn' could be emitted, 'exit' was emitted.
+  if (!node_service_remote_.is_connected())
+    return;
+  OnServiceProcessLaunched(process);
 }
 
-UtilityProcessWrapper::~UtilityProcessWrapper() = default;
+void UtilityProcessWrapper::OnServiceInitialized() {
+  SpareUtilityProcessManager::GetInstance()->RecordLaunch(
+      base::TimeTicks::Now() - launch_start_, from_spare_);
+}
 
 void UtilityProcessWrapper::OnServiceProcessLaunched(
     const base::Process& process) {
@@ -217,6 +381,7 @@ void UtilityProcessWrapper::OnServiceProcessDisconnected(
     const std::string& description) {
   if (pid_ != base::kNullProcessId)
     GetAllUtilityProcessWrappers().Remove(pid_);
+  ClearInvokeRoutes();
   CloseConnectorPort();
   // Emit 'exit' event
   EmitWithoutEvent("exit", error_code);
@@ -225,6 +390,7 @@ void UtilityProcessWrapper::OnServiceProcessDisconnected(
 
 void UtilityProcessWrapper::CloseConnectorPort() {
   if (!connector_closed_ && connector_->is_valid()) {
+    buffered_amount_.SetPipe(mojo::MessagePipeHandle());
     host_port_.GiveDisentangledHandle(connector_->PassMessagePipe());
     connector_ = nullptr;
     host_port_.Reset();
@@ -235,46 +401,252 @@ void UtilityProcessWrapper::CloseConnectorPort() {
 void UtilityProcessWrapper::Shutdown(int exit_code) {
   if (pid_ != base::kNullProcessId)
     GetAllUtilityProcessWrappers().Remove(pid_);
+  ClearInvokeRoutes();
   node_service_remote_.reset();
+  ipc_invoke_handler_remote_.reset();
   CloseConnectorPort();
   // Emit 'exit' event
   EmitWithoutEvent("exit", exit_code);
   Unpin();
 }
 
-void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
+bool UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   if (!node_service_remote_.is_connected())
-    return;
+    return false;
 
-  blink::TransferableMessage transferable_message;
-  v8::Local<v8::Value> message_value;
-  if (args->GetNext(&message_value)) {
-    if (!electron::SerializeV8Value(args->isolate(), message_value,
-                                    &transferable_message)) {
-      // SerializeV8Value sets an exception.
-      return;
-    }
-  }
+  v8::Local<v8::Value> message_value = v8::Undefined(args->isolate());
+  args->GetNext(&message_value);
 
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
-  if (args->GetNext(&transferables)) {
-    if (!gin::ConvertFromV8(args->isolate(), transferables, &wrapped_ports)) {
-      gin_helper::ErrorThrower(args->isolate())
-          .ThrowTypeError("Invalid value for transfer");
-      return;
-    }
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables) &&
+      !MessagePort::GetTransferables(args->isolate(), transferables,
+                                     &wrapped_ports, &array_buffers)) {
+    return false;
+  }
+
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8ValueWithTransfer(args->isolate(), message_value,
+                                              array_buffers,
+                                              &transferable_message)) {
+    // SerializeV8ValueWithTransfer sets an exception.
+    return false;
   }
 
   bool threw_exception = false;
   transferable_message.ports = MessagePort::DisentanglePorts(
       args->isolate(), wrapped_ports, &threw_exception);
   if (threw_exception)
-    return;
+    return false;
 
+  const uint64_t size =
+      BufferedAmountTracker::GetMessageSize(transferable_message);
   mojo::Message mojo_message = blink::mojom::TransferableMessage::WrapAsMessage(
       std::move(transferable_message));
   connector_->Accept(&mojo_message);
+  buffered_amount_.OnMessagePosted(size);
+  return !buffered_amount_.is_above_high_watermark();
+}
+
+uint64_t UtilityProcessWrapper::GetBufferedAmount() {
+  return buffered_amount_.GetBufferedAmount();
+}
+
+void UtilityProcessWrapper::SetWatermarks(
+    const gin_helper::Dictionary& options) {
+  uint64_t high = 0;
+  uint64_t low = 0;
+  options.Get("high", &high);
+  options.Get("low", &low);
+  buffered_amount_.SetWatermarks(high, low);
+}
+
+void UtilityProcessWrapper::OnWatermark(bool high) {
+  EmitWithoutEvent(high ? "buffered-amount-high" : "buffered-amount-low");
+}
+
+void UtilityProcessWrapper::Invoke(
+    node::mojom::IpcInvokeSenderPtr sender,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    mojom::ElectronApiIPC::InvokeCallback callback) {
+  TRACE_EVENT1("electron", "UtilityProcessWrapper::Invoke", "channel", channel);
+  ipc_invoke_handler_remote_->Invoke(
+      std::move(sender), channel, std::move(arguments),
+      base::BindOnce(
+          &InvokeReply::Run,
+          base::Owned(std::make_unique<InvokeReply>(channel,
+                                                    std::move(callback)))));
+}
+
+v8::Local<v8::Promise> UtilityProcessWrapper::InvokeFromMain(
+    v8::Isolate* isolate,
+    gin_helper::ErrorThrower thrower,
+    const std::string& channel,
+    v8::Local<v8::Value> arguments) {
+  if (!node_service_remote_.is_connected()) {
+    thrower.ThrowError("Utility process exited before replying to '" +
+                       channel + "'");
+    return v8::Local<v8::Promise>();
+  }
+  blink::CloneableMessage message;
+  if (!electron::SerializeV8Arguments(isolate, arguments, &message))
+    return v8::Local<v8::Promise>();
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  // The main process has no WebContents, process or frame id.
+  Invoke(node::mojom::IpcInvokeSender::New(0, 0, 0), channel,
+         std::move(message),
+         base::BindOnce(
+             [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+                blink::TransferableMessage result) {
+               v8::Isolate* isolate = promise.isolate();
+               v8::HandleScope handle_scope(isolate);
+               v8::Context::Scope context_scope(promise.GetContext());
+               promise.Resolve(electron::DeserializeV8ValueWithArrayBuffers(
+                   isolate, &result));
+             },
+             std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Value> UtilityProcessWrapper::CreateSharedBuffer(
+    v8::Isolate* isolate,
+    gin_helper::ErrorThrower thrower,
+    const std::string& name,
+    uint64_t size) {
+  if (!node_service_remote_.is_connected()) {
+    thrower.ThrowError("Failed to share a buffer with exited utility process");
+    return v8::Local<v8::Value>();
+  }
+  if (!size || size > v8::ArrayBuffer::kMaxByteLength) {
+    thrower.ThrowRangeError("Invalid shared buffer size");
+    return v8::Local<v8::Value>();
+  }
+  base::UnsafeSharedMemoryRegion region =
+      CreateSharedMemoryArrayBufferRegion(size);
+  v8::Local<v8::SharedArrayBuffer> buffer;
+  if (!NewSharedMemoryArrayBuffer(isolate, &region, size).ToLocal(&buffer)) {
+    thrower.ThrowError("Failed to allocate a shared buffer");
+    return v8::Local<v8::Value>();
+  }
+  node_service_remote_->ShareBuffer(name, std::move(region), size);
+  return buffer;
+}
+
+void UtilityProcessWrapper::RouteInvoke(gin::Arguments* args,
+                                        const std::string& channel) {
+  if (!node_service_remote_.is_connected())
+    return;
+  auto [it, inserted] = GetInvokeRoutes().emplace(channel, this);
+  if (!inserted) {
+    if (it->second != this) {
+      gin_helper::ErrorThrower(args->isolate())
+          .ThrowError("Attempted to route '" + channel +
+                      "' to a second utility process");
+    }
+    return;
+  }
+  blink::TransferableMessage error_reply;
+  SerializeExitedError(channel, &error_reply);
+  ElectronSyncIPCHandlerImpl::AddRoute(
+      channel, ipc_sync_invoke_handler_remote_,
+      std::move(error_reply.owned_encoded_message));
+}
+
+void UtilityProcessWrapper::UnrouteInvoke(const std::string& channel) {
+  auto& routes = GetInvokeRoutes();
+  auto it = routes.find(channel);
+  if (it != routes.end() && it->second == this) {
+    routes.erase(it);
+    ElectronSyncIPCHandlerImpl::RemoveRoute(channel);
+  }
+}
+
+void UtilityProcessWrapper::ClearInvokeRoutes() {
+  auto& routes = GetInvokeRoutes();
+  for (auto it = routes.begin(); it != routes.end();) {
+    if (it->second == this) {
+      ElectronSyncIPCHandlerImpl::RemoveRoute(it->first);
+      it = routes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+v8::Local<v8::Promise> UtilityProcessWrapper::TakeHeapSnapshot(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path,
+    bool gzip,
+    bool graph_only) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node_service_remote_.is_connected()) {
+    promise.RejectWithErrorMessage(
+        "Failed to take heap snapshot of exited utility process");
+    return handle;
+  }
+
+  ScopedAllowBlockingForElectron allow_blocking;
+  base::File file(file_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!file.IsValid()) {
+    promise.RejectWithErrorMessage(
+        "Failed to take heap snapshot with invalid file path " +
+        file_path.AsUTF8Unsafe());
+    return handle;
+  }
+
+  using ProgressEmitter =
+      HeapSnapshotProgressEmitter<node::mojom::HeapSnapshotProgress>;
+  mojo::PendingRemote<node::mojom::HeapSnapshotProgress> progress;
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<ProgressEmitter>(base::BindRepeating(
+          [](base::WeakPtr<UtilityProcessWrapper> wrapper,
+             base::Value::Dict details) {
+            if (wrapper)
+              wrapper->EmitWithoutEvent("heap-snapshot-progress", details);
+          },
+          weak_factory_.GetWeakPtr())),
+      progress.InitWithNewPipeAndPassReceiver());
+  // The reply is dropped if the process exits while taking the snapshot.
+  node_service_remote_->TakeHeapSnapshot(
+      mojo::WrapPlatformFile(base::ScopedPlatformFile(file.TakePlatformFile())),
+      gzip, graph_only, std::move(progress),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<void> promise, bool success) {
+                if (success) {
+                  promise.Resolve();
+                } else {
+                  promise.RejectWithErrorMessage(
+                      "Failed to take heap snapshot");
+                }
+              },
+              std::move(promise)),
+          false));
+  return handle;
+}
+
+v8::Local<v8::Value> UtilityProcessWrapper::ReadOutput(
+    v8::Isolate* isolate,
+    const std::string& stream) {
+  auto it = stdio_sinks_.find(stream == "stderr" ? IOHandle::STDERR
+                                                 : IOHandle::STDOUT);
+  if (it == stdio_sinks_.end() || !it->second->is_buffered())
+    return v8::Null(isolate);
+  uint64_t dropped = 0;
+  std::vector<uint8_t> output = it->second->TakeBufferedOutput(&dropped);
+  return gin::DataObjectBuilder(isolate)
+      .Set("data", node::Buffer::Copy(
+                       isolate, reinterpret_cast<const char*>(output.data()),
+                       output.size())
+                       .ToLocalChecked())
+      .Set("dropped", static_cast<double>(dropped))
+      .Build();
 }
 
 bool UtilityProcessWrapper::Kill() const {
@@ -310,7 +682,7 @@ bool UtilityProcessWrapper::Accept(mojo::Message* mojo_message) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate, message);
+      electron::DeserializeV8ValueWithArrayBuffers(isolate, &message);
   EmitWithoutEvent("message", message_value);
   return true;
 }
@@ -322,6 +694,14 @@ raw_ptr<UtilityProcessWrapper> UtilityProcessWrapper::FromProcessId(
   return !!utility_process_wrapper ? utility_process_wrapper : nullptr;
 }
 
+// static
+UtilityProcessWrapper* UtilityProcessWrapper::FromInvokeChannel(
+    const std::string& channel) {
+  auto& routes = GetInvokeRoutes();
+  auto it = routes.find(channel);
+  return it != routes.end() ? it->second : nullptr;
+}
+
 // static
 gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
     gin::Arguments* args) {
@@ -334,6 +714,7 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
   std::u16string display_name;
   bool use_plugin_helper = false;
   std::map<IOHandle, IOType> stdio;
+  SinkOptions sink_options;
   base::FilePath current_working_directory;
   base::EnvironmentMap env_map;
   node::mojom::NodeServiceParamsPtr params =
@@ -361,15 +742,30 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
 
     std::vector<std::string> stdio_arr{"ignore", "inherit", "inherit"};
     opts.Get("stdio", &stdio_arr);
+    gin_helper::Dictionary sinks;
+    const bool has_sinks = opts.Get("stdioSinks", &sinks);
     for (size_t i = 0; i < 3; i++) {
-      IOType type;
+      IOType type = IOType::IO_INHERIT;
       if (stdio_arr[i] == "ignore")
         type = IOType::IO_IGNORE;
       else if (stdio_arr[i] == "inherit")
         type = IOType::IO_INHERIT;
       else if (stdio_arr[i] == "pipe")
         type = IOType::IO_PIPE;
-
+      else if (stdio_arr[i] == "sink")
+        type = IOType::IO_SINK;
+
+      if (type == IOType::IO_SINK) {
+        UtilityProcessStdioSink::Options& options =
+            sink_options[static_cast<IOHandle>(i)];
+        gin_helper::Dictionary sink;
+        if (has_sinks && sinks.Get(i == 1 ? "stdout" : "stderr", &sink)) {
+          sink.Get("path", &options.path);
+          sink.Get("maxSize", &options.max_size);
+          sink.Get("maxFiles", &options.max_files);
+          sink.Get("bufferSize", &options.buffer_size);
+        }
+      }
       stdio.emplace(static_cast<IOHandle>(i), type);
     }
 
@@ -380,8 +776,9 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
   auto handle = gin::CreateHandle(
       args->isolate(),
       new UtilityProcessWrapper(std::move(params), display_name,
-                                std::move(stdio), env_map,
-                                current_working_directory, use_plugin_helper));
+                                std::move(stdio), std::move(sink_options),
+                                env_map, current_working_directory,
+                                use_plugin_helper));
   handle->Pin(args->isolate());
   return handle;
 }
@@ -392,6 +789,15 @@ gin::ObjectTemplateBuilder UtilityProcessWrapper::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<
              UtilityProcessWrapper>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &UtilityProcessWrapper::PostMessage)
+      .SetProperty("bufferedAmount", &UtilityProcessWrapper::GetBufferedAmount)
+      .SetMethod("setWatermarks", &UtilityProcessWrapper::SetWatermarks)
+      .SetMethod("invoke", &UtilityProcessWrapper::InvokeFromMain)
+      .SetMethod("createSharedBuffer",
+                 &UtilityProcessWrapper::CreateSharedBuffer)
+      .SetMethod("routeInvoke", &UtilityProcessWrapper::RouteInvoke)
+      .SetMethod("unrouteInvoke", &UtilityProcessWrapper::UnrouteInvoke)
+      .SetMethod("takeHeapSnapshot", &UtilityProcessWrapper::TakeHeapSnapshot)
+      .SetMethod("readOutput", &UtilityProcessWrapper::ReadOutput)
       .SetMethod("kill", &UtilityProcessWrapper::Kill)
       .SetProperty("pid", &UtilityProcessWrapper::GetOSProcessId);
 }
@@ -406,6 +812,26 @@ const char* UtilityProcessWrapper::GetTypeName() {
 
 namespace {
 
+void SetSpareProcessCount(size_t count) {
+  electron::SpareUtilityProcessManager::GetInstance()->SetCount(count);
+}
+
+v8::Local<v8::Value> GetLaunchMetrics(v8::Isolate* isolate) {
+  const auto& metrics =
+      electron::SpareUtilityProcessManager::GetInstance()->metrics();
+  auto average = [](base::TimeDelta total, uint64_t count) {
+    return count ? total.InMillisecondsF() / count : 0;
+  };
+  return gin::DataObjectBuilder(isolate)
+      .Set("spareLaunches", static_cast<double>(metrics.spare_launches))
+      .Set("coldLaunches", static_cast<double>(metrics.cold_launches))
+      .Set("averageSpareLaunchTime",
+           average(metrics.spare_launch_time, metrics.spare_launches))
+      .Set("averageColdLaunchTime",
+           average(metrics.cold_launch_time, metrics.cold_launches))
+      .Build();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -413,6 +839,8 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("_fork", &electron::api::UtilityProcessWrapper::Create);
+  dict.SetMethod("setSpareProcessCount", &SetSpareProcessCount);
+  dict.SetMethod("getLaunchMetrics", &GetLaunchMetrics);
 }
 
 }  // namespace
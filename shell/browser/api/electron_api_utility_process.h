@@ -8,16 +8,23 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/id_map.h"
 #include "base/environment.h"
 #include "base/memory/weak_ptr.h"
 #include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "electron/shell/common/api/api.mojom.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/shared_remote.h"
+#include "shell/browser/api/utility_process_stdio_sink.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/buffered_amount_tracker.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/pinnable.h"
 #include "shell/services/node/public/mojom/node_service.mojom.h"
 #include "v8/include/v8.h"
@@ -32,6 +39,10 @@ namespace base {
 class Process;
 }  // namespace base
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron::api {
 
 class UtilityProcessWrapper
@@ -41,14 +52,28 @@ class UtilityProcessWrapper
       public mojo::MessageReceiver {
  public:
   enum class IOHandle : size_t { STDIN = 0, STDOUT = 1, STDERR = 2 };
-  enum class IOType { IO_PIPE, IO_INHERIT, IO_IGNORE };
+  // IO_SINK pipes the output to a UtilityProcessStdioSink instead of
+  // JavaScript.
+  enum class IOType { IO_PIPE, IO_INHERIT, IO_IGNORE, IO_SINK };
+  using SinkOptions = std::map<IOHandle, UtilityProcessStdioSink::Options>;
 
   ~UtilityProcessWrapper() override;
   static gin::Handle<UtilityProcessWrapper> Create(gin::Arguments* args);
   static raw_ptr<UtilityProcessWrapper> FromProcessId(base::ProcessId pid);
+  // Returns the process that child.routeInvoke(channel) was called on, if it
+  // is still alive.
+  static UtilityProcessWrapper* FromInvokeChannel(const std::string& channel);
 
   void Shutdown(int exit_code);
 
+  // Forwards an ipcRenderer.invoke() to the handler registered with
+  // process.parentPort.handle() in the child. |callback| is run with the reply
+  // of the child, or with an error if the child exits first.
+  void Invoke(node::mojom::IpcInvokeSenderPtr sender,
+              const std::string& channel,
+              blink::CloneableMessage arguments,
+              mojom::ElectronApiIPC::InvokeCallback callback);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -59,15 +84,58 @@ class UtilityProcessWrapper
   UtilityProcessWrapper(node::mojom::NodeServiceParamsPtr params,
                         std::u16string display_name,
                         std::map<IOHandle, IOType> stdio,
+                        SinkOptions sink_options,
                         base::EnvironmentMap env_map,
                         base::FilePath current_working_directory,
                         bool use_plugin_helper);
+  // Whether a fork() with these options can claim a spare process, see
+  // SpareUtilityProcessManager.
+  static bool CanUseSpare(const node::mojom::NodeServiceParams& params,
+                          const std::u16string& display_name,
+                          const std::map<IOHandle, IOType>& stdio,
+                          const base::EnvironmentMap& env_map,
+                          const base::FilePath& current_working_directory,
+                          bool use_plugin_helper);
+  // Returns false when the stdio of the process couldn't be set up.
+  bool LaunchServiceProcess(const std::u16string& display_name,
+                            const std::map<IOHandle, IOType>& stdio,
+                            const SinkOptions& sink_options,
+                            const base::EnvironmentMap& env_map,
+                            const base::FilePath& current_working_directory,
+                            bool use_plugin_helper,
+                            const std::vector<std::string>& exec_args);
+  void OnSpareProcessClaimed(base::Process process);
+  void OnServiceInitialized();
   void OnServiceProcessDisconnected(uint32_t error_code,
                                     const std::string& description);
   void OnServiceProcessLaunched(const base::Process& process);
   void CloseConnectorPort();
 
-  void PostMessage(gin::Arguments* args);
+  bool PostMessage(gin::Arguments* args);
+  uint64_t GetBufferedAmount();
+  void SetWatermarks(const gin_helper::Dictionary& options);
+  void OnWatermark(bool high);
+  // child.invoke(channel, ...args), answered by the same handlers as the
+  // invokes routed from renderers.
+  v8::Local<v8::Promise> InvokeFromMain(v8::Isolate* isolate,
+                                        gin_helper::ErrorThrower thrower,
+                                        const std::string& channel,
+                                        v8::Local<v8::Value> arguments);
+  v8::Local<v8::Value> CreateSharedBuffer(v8::Isolate* isolate,
+                                          gin_helper::ErrorThrower thrower,
+                                          const std::string& name,
+                                          uint64_t size);
+  void RouteInvoke(gin::Arguments* args, const std::string& channel);
+  void UnrouteInvoke(const std::string& channel);
+  void ClearInvokeRoutes();
+  v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
+                                          const base::FilePath& file_path,
+                                          bool gzip,
+                                          bool graph_only);
+  // Returns what the buffer sink of |stream| kept since the last call, or null
+  // if its output doesn't go to a buffer.
+  v8::Local<v8::Value> ReadOutput(v8::Isolate* isolate,
+                                  const std::string& stream);
   bool Kill() const;
   v8::Local<v8::Value> GetOSProcessId(v8::Isolate* isolate) const;
 
@@ -75,6 +143,8 @@ class UtilityProcessWrapper
   bool Accept(mojo::Message* mojo_message) override;
 
   base::ProcessId pid_ = base::kNullProcessId;
+  const base::TimeTicks launch_start_ = base::TimeTicks::Now();
+  bool from_spare_ = false;
 #if BUILDFLAG(IS_WIN)
   // Non-owning handles, these will be closed when the
   // corresponding FD are closed via _close.
@@ -83,10 +153,16 @@ class UtilityProcessWrapper
 #endif
   int stdout_read_fd_ = -1;
   int stderr_read_fd_ = -1;
+  std::map<IOHandle, scoped_refptr<UtilityProcessStdioSink>> stdio_sinks_;
   bool connector_closed_ = false;
   std::unique_ptr<mojo::Connector> connector_;
   blink::MessagePortDescriptor host_port_;
+  BufferedAmountTracker buffered_amount_;
   mojo::Remote<node::mojom::NodeService> node_service_remote_;
+  mojo::Remote<node::mojom::IpcInvokeHandler> ipc_invoke_handler_remote_;
+  // Bound on ElectronSyncIPCHandlerImpl::GetTaskRunner(), for invokeSync().
+  mojo::SharedRemote<node::mojom::IpcInvokeHandler>
+      ipc_sync_invoke_handler_remote_;
   base::WeakPtrFactory<UtilityProcessWrapper> weak_factory_{this};
 };
 
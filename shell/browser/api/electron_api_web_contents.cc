@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <set>
@@ -14,9 +15,11 @@
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/containers/id_map.h"
+#include "base/containers/span.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
 #include "base/task/thread_pool.h"
@@ -55,6 +58,7 @@
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/site_instance.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/visibility.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/referrer_type_converters.h"
 #include "content/public/common/result_codes.h"
@@ -68,8 +72,11 @@
 #include "gin/wrappable.h"
 #include "media/base/mime_util.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
@@ -78,11 +85,14 @@
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
+#include "shell/browser/api/electron_api_offscreen_capture_group.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
+#include "shell/browser/api/ipc_json_payload.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
+#include "shell/browser/direct_ipc_channel_registry.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_browser_context.h"
@@ -90,10 +100,16 @@
 #include "shell/browser/electron_javascript_dialog_manager.h"
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/file_select_helper.h"
+#include "shell/browser/flight_recorder.h"
+#include "shell/browser/heap_snapshot_progress_emitter.h"
+#include "shell/browser/ipc_priority_lanes.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 #include "shell/browser/osr/osr_web_contents_view.h"
+#include "shell/browser/preload_script_cache.h"
+#include "shell/browser/renderer_sharing_manager.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_manager.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -125,6 +141,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "storage/browser/file_system/isolated_context.h"
@@ -137,10 +154,15 @@
 #include "third_party/blink/public/mojom/frame/fullscreen.mojom.h"
 #include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
 #include "third_party/blink/public/mojom/renderer_preferences.mojom.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/convert_from_argb.h"
 #include "ui/base/cursor/cursor.h"
 #include "ui/base/cursor/mojom/cursor_type.mojom-shared.h"
 #include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/codec/webp_codec.h"
 
 #if BUILDFLAG(IS_WIN)
 #include "shell/browser/native_window_views.h"
@@ -172,10 +194,10 @@
 #include "components/printing/browser/print_manager_utils.h"
 #include "components/printing/browser/print_to_pdf/pdf_print_result.h"
 #include "components/printing/browser/print_to_pdf/pdf_print_utils.h"
-#include "printing/backend/print_backend.h"  // nogncheck
-#include "printing/mojom/print.mojom.h"      // nogncheck
+#include "printing/mojom/print.mojom.h"  // nogncheck
 #include "printing/page_range.h"
 #include "shell/browser/printing/print_view_manager_electron.h"
+#include "shell/browser/printing/printer_list_cache.h"
 
 #if BUILDFLAG(IS_WIN)
 #include "printing/backend/win_helper.h"
@@ -324,6 +346,73 @@ struct Converter<electron::api::WebContents::Type> {
   }
 };
 
+template <>
+struct Converter<electron::api::WebContents::LifecycleState> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      electron::api::WebContents::LifecycleState val) {
+    using State = electron::api::WebContents::LifecycleState;
+    switch (val) {
+      case State::kActive:
+        return StringToV8(isolate, "active");
+      case State::kFrozen:
+        return StringToV8(isolate, "frozen");
+      case State::kDiscarded:
+        return StringToV8(isolate, "discarded");
+    }
+    return StringToV8(isolate, "active");
+  }
+};
+
+template <>
+struct Converter<electron::api::WebContents::PaintFormat> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::WebContents::PaintFormat* out) {
+    using Val = electron::api::WebContents::PaintFormat;
+    static constexpr auto Lookup =
+        base::MakeFixedFlatMapSorted<base::StringPiece, Val>({
+            {"bgra", Val::kBGRA},
+            {"i420", Val::kI420},
+            {"nativeImage", Val::kNativeImage},
+            {"rgba", Val::kRGBA},
+        });
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+};
+
+template <>
+struct Converter<electron::api::FrameSubscriber::Format> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::FrameSubscriber::Format* out) {
+    using Val = electron::api::FrameSubscriber::Format;
+    static constexpr auto Lookup =
+        base::MakeFixedFlatMapSorted<base::StringPiece, Val>({
+            {"bgra", Val::kBGRA},
+            {"i420", Val::kI420},
+            {"nativeImage", Val::kNativeImage},
+        });
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+};
+
+template <>
+struct Converter<electron::api::WebContents::CaptureFormat> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::WebContents::CaptureFormat* out) {
+    using Val = electron::api::WebContents::CaptureFormat;
+    static constexpr auto Lookup =
+        base::MakeFixedFlatMapSorted<base::StringPiece, Val>({
+            {"jpeg", Val::kJPEG},
+            {"png", Val::kPNG},
+            {"webp", Val::kWebP},
+        });
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+};
+
 template <>
 struct Converter<scoped_refptr<content::DevToolsAgentHost>> {
   static v8::Local<v8::Value> ToV8(
@@ -466,12 +555,60 @@ base::IDMap<WebContents*>& GetAllWebContents() {
 }
 
 void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
-                       base::ScopedClosureRunner capture_handle,
                        const SkBitmap& bitmap) {
   // Hack to enable transparency in captured image
   promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
+}
 
-  capture_handle.RunAndReset();
+absl::optional<std::vector<uint8_t>> EncodeCapturedPage(
+    WebContents::CaptureFormat format,
+    int quality,
+    const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing())
+    return std::vector<uint8_t>();
+  switch (format) {
+    case WebContents::CaptureFormat::kPNG: {
+      std::vector<uint8_t> output;
+      if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &output))
+        return absl::nullopt;
+      return output;
+    }
+    case WebContents::CaptureFormat::kJPEG: {
+      std::vector<uint8_t> output;
+      if (!gfx::JPEGCodec::Encode(bitmap, quality, &output))
+        return absl::nullopt;
+      return output;
+    }
+    case WebContents::CaptureFormat::kWebP:
+      return gfx::WebpCodec::Encode(bitmap, quality);
+  }
+}
+
+void OnCapturedPageEncoded(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                           absl::optional<std::vector<uint8_t>> output) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  if (!output) {
+    promise.RejectWithErrorMessage("Failed to encode the captured page");
+    return;
+  }
+  promise.Resolve(
+      node::Buffer::Copy(isolate, reinterpret_cast<const char*>(output->data()),
+                         output->size())
+          .ToLocalChecked());
+}
+
+void OnCaptureEncodedPageDone(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                              WebContents::CaptureFormat format,
+                              int quality,
+                              const SkBitmap& bitmap) {
+  // Encoding large pages takes long enough to drop frames on the UI thread.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EncodeCapturedPage, format, quality, bitmap),
+      base::BindOnce(&OnCapturedPageEncoded, std::move(promise)));
 }
 
 absl::optional<base::TimeDelta> GetCursorBlinkInterval() {
@@ -493,93 +630,6 @@ absl::optional<base::TimeDelta> GetCursorBlinkInterval() {
   return absl::nullopt;
 }
 
-#if BUILDFLAG(ENABLE_PRINTING)
-// This will return false if no printer with the provided device_name can be
-// found on the network. We need to check this because Chromium does not do
-// sanity checking of device_name validity and so will crash on invalid names.
-bool IsDeviceNameValid(const std::u16string& device_name) {
-#if BUILDFLAG(IS_MAC)
-  base::ScopedCFTypeRef<CFStringRef> new_printer_id(
-      base::SysUTF16ToCFStringRef(device_name));
-  PMPrinter new_printer = PMPrinterCreateFromPrinterID(new_printer_id.get());
-  bool printer_exists = new_printer != nullptr;
-  PMRelease(new_printer);
-  return printer_exists;
-#else
-  scoped_refptr<printing::PrintBackend> print_backend =
-      printing::PrintBackend::CreateInstance(
-          g_browser_process->GetApplicationLocale());
-  return print_backend->IsValidPrinter(base::UTF16ToUTF8(device_name));
-#endif
-}
-
-// This function returns a validated device name.
-// If the user passed one to webContents.print(), we check that it's valid and
-// return it or fail if the network doesn't recognize it. If the user didn't
-// pass a device name, we first try to return the system default printer. If one
-// isn't set, then pull all the printers and use the first one or fail if none
-// exist.
-std::pair<std::string, std::u16string> GetDeviceNameToUse(
-    const std::u16string& device_name) {
-#if BUILDFLAG(IS_WIN)
-  // Blocking is needed here because Windows printer drivers are oftentimes
-  // not thread-safe and have to be accessed on the UI thread.
-  ScopedAllowBlockingForElectron allow_blocking;
-#endif
-
-  if (!device_name.empty()) {
-    if (!IsDeviceNameValid(device_name))
-      return std::make_pair("Invalid deviceName provided", std::u16string());
-    return std::make_pair(std::string(), device_name);
-  }
-
-  scoped_refptr<printing::PrintBackend> print_backend =
-      printing::PrintBackend::CreateInstance(
-          g_browser_process->GetApplicationLocale());
-  std::string printer_name;
-  printing::mojom::ResultCode code =
-      print_backend->GetDefaultPrinterName(printer_name);
-
-  // We don't want to return if this fails since some devices won't have a
-  // default printer.
-  if (code != printing::mojom::ResultCode::kSuccess)
-    LOG(ERROR) << "Failed to get default printer name";
-
-  if (printer_name.empty()) {
-    printing::PrinterList printers;
-    if (print_backend->EnumeratePrinters(printers) !=
-        printing::mojom::ResultCode::kSuccess)
-      return std::make_pair("Failed to enumerate printers", std::u16string());
-    if (printers.empty())
-      return std::make_pair("No printers available on the network",
-                            std::u16string());
-
-    printer_name = printers.front().printer_name;
-  }
-
-  return std::make_pair(std::string(), base::UTF8ToUTF16(printer_name));
-}
-
-// Copied from
-// chrome/browser/ui/webui/print_preview/local_printer_handler_default.cc:L36-L54
-scoped_refptr<base::TaskRunner> CreatePrinterHandlerTaskRunner() {
-  // USER_VISIBLE because the result is displayed in the print preview dialog.
-#if !BUILDFLAG(IS_WIN)
-  static constexpr base::TaskTraits kTraits = {
-      base::MayBlock(), base::TaskPriority::USER_VISIBLE};
-#endif
-
-#if defined(USE_CUPS)
-  // CUPS is thread safe.
-  return base::ThreadPool::CreateTaskRunner(kTraits);
-#elif BUILDFLAG(IS_WIN)
-  // Windows drivers are likely not thread-safe and need to be accessed on the
-  // UI thread.
-  return content::GetUIThreadTaskRunner({base::TaskPriority::USER_VISIBLE});
-#else
-  // Be conservative on unsupported platforms.
-  return base::ThreadPool::CreateSingleThreadTaskRunner(kTraits);
-#endif
 }
 #endif
 
@@ -718,6 +768,175 @@ content::RenderFrameHost* GetRenderFrameHost(
   return frame_host;
 }
 
+// Copies the |rect| of |bitmap| in |format| to a new ArrayBuffer, with the
+// planes of the format one after the other.
+gin_helper::Dictionary CreatePaintRegion(v8::Isolate* isolate,
+                                         const SkBitmap& bitmap,
+                                         gfx::Rect rect,
+                                         WebContents::PaintFormat format) {
+  struct Plane {
+    uint64_t offset;
+    int stride;
+    int width;
+    int height;
+  };
+  std::vector<Plane> planes;
+  const char* format_name = nullptr;
+  if (format == WebContents::PaintFormat::kI420) {
+    // The chroma planes are subsampled, so the region has to start and end
+    // at even coordinates, unless it ends at the edge of the frame.
+    const int left = rect.x() & ~1;
+    const int top = rect.y() & ~1;
+    rect = gfx::Rect(left, top,
+                     std::min(bitmap.width() - left,
+                              ((rect.right() + 1) & ~1) - left),
+                     std::min(bitmap.height() - top,
+                              ((rect.bottom() + 1) & ~1) - top));
+    const int chroma_width = (rect.width() + 1) / 2;
+    const int chroma_height = (rect.height() + 1) / 2;
+    const uint64_t luma_size =
+        static_cast<uint64_t>(rect.width()) * rect.height();
+    const uint64_t chroma_size =
+        static_cast<uint64_t>(chroma_width) * chroma_height;
+    planes.push_back({0, rect.width(), rect.width(), rect.height()});
+    planes.push_back({luma_size, chroma_width, chroma_width, chroma_height});
+    planes.push_back(
+        {luma_size + chroma_size, chroma_width, chroma_width, chroma_height});
+    format_name = "i420";
+  } else {
+    planes.push_back({0, rect.width() * 4, rect.width(), rect.height()});
+    format_name = format == WebContents::PaintFormat::kBGRA ? "bgra" : "rgba";
+  }
+  const Plane& last = planes.back();
+  const size_t size = static_cast<size_t>(
+      last.offset + static_cast<uint64_t>(last.stride) * last.height);
+
+  std::unique_ptr<v8::BackingStore> backing_store =
+      v8::ArrayBuffer::NewBackingStore(isolate, size);
+  auto* data = static_cast<uint8_t*>(backing_store->Data());
+  if (format == WebContents::PaintFormat::kI420) {
+    // libyuv names the formats by their words on little endian platforms,
+    // BGRA in memory is what it calls ARGB.
+    auto* convert = bitmap.colorType() == kRGBA_8888_SkColorType
+                        ? &libyuv::ABGRToI420
+                        : &libyuv::ARGBToI420;
+    const auto* src =
+        static_cast<const uint8_t*>(bitmap.getAddr(rect.x(), rect.y()));
+    convert(src, bitmap.rowBytes(), data + planes[0].offset, planes[0].stride,
+            data + planes[1].offset, planes[1].stride, data + planes[2].offset,
+            planes[2].stride, rect.width(), rect.height());
+  } else {
+    SkImageInfo info = SkImageInfo::Make(
+        rect.width(), rect.height(),
+        format == WebContents::PaintFormat::kBGRA ? kBGRA_8888_SkColorType
+                                                  : kRGBA_8888_SkColorType,
+        bitmap.alphaType());
+    bitmap.readPixels(info, data, planes[0].stride, rect.x(), rect.y());
+  }
+
+  gin_helper::Dictionary region = gin::Dictionary::CreateEmpty(isolate);
+  region.Set("rect", rect);
+  region.Set("format", format_name);
+  region.Set("data",
+             v8::ArrayBuffer::New(isolate, std::move(backing_store)));
+  std::vector<gin_helper::Dictionary> plane_dicts;
+  for (const Plane& plane : planes) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("offset", plane.offset);
+    dict.Set("stride", plane.stride);
+    dict.Set("width", plane.width);
+    dict.Set("height", plane.height);
+    plane_dicts.push_back(dict);
+  }
+  region.Set("planes", plane_dicts);
+  return region;
+}
+
+const char* PixelFormatToString(media::VideoPixelFormat pixel_format) {
+  switch (pixel_format) {
+    // ARGB is stored as BGRA in little endian memory.
+    case media::PIXEL_FORMAT_ARGB:
+      return "bgra";
+    case media::PIXEL_FORMAT_ABGR:
+      return "rgba";
+    case media::PIXEL_FORMAT_NV12:
+      return "nv12";
+    default:
+      return "unknown";
+  }
+}
+
+gin_helper::Dictionary CreateTextureInfo(
+    v8::Isolate* isolate,
+    const OffscreenSharedTexture& texture) {
+  gin_helper::Dictionary info = gin::Dictionary::CreateEmpty(isolate);
+  info.Set("pixelFormat", PixelFormatToString(texture.pixel_format));
+  info.Set("codedSize", texture.coded_size);
+  info.Set("visibleRect", texture.visible_rect);
+  info.Set("contentRect", texture.content_rect);
+  info.Set("timestamp", texture.timestamp.InMicroseconds());
+#if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_MAC)
+#if BUILDFLAG(IS_WIN)
+  auto handle =
+      reinterpret_cast<uintptr_t>(texture.handle.dxgi_handle.Get());
+#else
+  auto handle = reinterpret_cast<uintptr_t>(texture.handle.io_surface.get());
+#endif
+  info.Set("sharedTextureHandle",
+           node::Buffer::Copy(isolate, reinterpret_cast<char*>(&handle),
+                              sizeof(handle))
+               .ToLocalChecked());
+#elif BUILDFLAG(IS_LINUX)
+  std::vector<gin_helper::Dictionary> planes;
+  for (const auto& plane : texture.handle.native_pixmap_handle.planes) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("stride", plane.stride);
+    dict.Set("offset", plane.offset);
+    dict.Set("size", plane.size);
+    dict.Set("fd", plane.fd.get());
+    planes.push_back(dict);
+  }
+  info.Set("planes", planes);
+  info.Set("modifier", base::NumberToString(
+                           texture.handle.native_pixmap_handle.modifier));
+#endif
+  return info;
+}
+
+bool ConvertInputEvent(v8::Isolate* isolate,
+                       v8::Local<v8::Value> input_event,
+                       InputEventReplay::Event* out) {
+  blink::WebInputEvent::Type type =
+      gin::GetWebInputEventType(isolate, input_event);
+  if (blink::WebInputEvent::IsMouseEventType(type)) {
+    blink::WebMouseEvent mouse_event;
+    if (!gin::ConvertFromV8(isolate, input_event, &mouse_event))
+      return false;
+    *out = mouse_event;
+    return true;
+  }
+  if (blink::WebInputEvent::IsKeyboardEventType(type)) {
+    content::NativeWebKeyboardEvent keyboard_event(
+        blink::WebKeyboardEvent::Type::kRawKeyDown,
+        blink::WebInputEvent::Modifiers::kNoModifiers, ui::EventTimeForNow());
+    if (!gin::ConvertFromV8(isolate, input_event, &keyboard_event))
+      return false;
+    // For backwards compatibility, convert `kKeyDown` to `kRawKeyDown`.
+    if (keyboard_event.GetType() == blink::WebKeyboardEvent::Type::kKeyDown)
+      keyboard_event.SetType(blink::WebKeyboardEvent::Type::kRawKeyDown);
+    *out = keyboard_event;
+    return true;
+  }
+  if (type == blink::WebInputEvent::Type::kMouseWheel) {
+    blink::WebMouseWheelEvent mouse_wheel_event;
+    if (!gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event))
+      return false;
+    *out = mouse_wheel_event;
+    return true;
+  }
+  return false;
+}
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -748,10 +967,6 @@ WebContents::WebContents(v8::Isolate* isolate,
     : content::WebContentsObserver(web_contents),
       type_(Type::kRemote),
       id_(GetAllWebContents().Add(this))
-#if BUILDFLAG(ENABLE_PRINTING)
-      ,
-      print_task_runner_(CreatePrinterHandlerTaskRunner())
-#endif
 {
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // WebContents created by extension host will have valid ViewType set.
@@ -781,10 +996,6 @@ WebContents::WebContents(v8::Isolate* isolate,
     : content::WebContentsObserver(web_contents.get()),
       type_(type),
       id_(GetAllWebContents().Add(this))
-#if BUILDFLAG(ENABLE_PRINTING)
-      ,
-      print_task_runner_(CreatePrinterHandlerTaskRunner())
-#endif
 {
   DCHECK(type != Type::kRemote)
       << "Can't take ownership of a remote WebContents";
@@ -797,10 +1008,6 @@ WebContents::WebContents(v8::Isolate* isolate,
 WebContents::WebContents(v8::Isolate* isolate,
                          const gin_helper::Dictionary& options)
     : id_(GetAllWebContents().Add(this))
-#if BUILDFLAG(ENABLE_PRINTING)
-      ,
-      print_task_runner_(CreatePrinterHandlerTaskRunner())
-#endif
 {
   // Read options.
   options.Get("backgroundThrottling", &background_throttling_);
@@ -811,6 +1018,13 @@ WebContents::WebContents(v8::Isolate* isolate,
   bool b = false;
   if (options.Get(options::kOffscreen, &b) && b)
     type_ = Type::kOffScreen;
+  gin_helper::Dictionary offscreen;
+  if (options.Get(options::kOffscreen, &offscreen)) {
+    offscreen.Get(options::kUseSharedTexture, &offscreen_use_shared_texture_);
+    offscreen.Get(options::kPaintFormat, &offscreen_paint_format_);
+    offscreen.Get(options::kUseExternalBeginFrame,
+                  &offscreen_use_external_begin_frame_);
+  }
 
   // Init embedder earlier
   options.Get("embedder", &embedder_);
@@ -849,8 +1063,9 @@ WebContents::WebContents(v8::Isolate* isolate,
 
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
-          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+          false, embedder_->offscreen_use_external_begin_frame_,
+          base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+          OnTexturePaintCallback());
       params.view = view;
       params.delegate_view = view;
 
@@ -867,19 +1082,40 @@ WebContents::WebContents(v8::Isolate* isolate,
     options.GetHidden(options::kBackgroundColor, &background_color);
     bool transparent = ParseCSSColor(background_color) == SK_ColorTRANSPARENT;
 
+    OnTexturePaintCallback texture_callback;
+    if (offscreen_use_shared_texture_) {
+      texture_callback = base::BindRepeating(&WebContents::OnTexturePaint,
+                                             base::Unretained(this));
+    }
+
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
-        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+        transparent, offscreen_use_external_begin_frame_,
+        base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)),
+        texture_callback);
     params.view = view;
     params.delegate_view = view;
 
     web_contents = content::WebContents::Create(params);
     view->SetWebContents(web_contents.get());
   } else {
-    content::WebContents::CreateParams params(session->browser_context());
+    const bool can_share_renderer =
+        type_ == Type::kBrowserWindow || type_ == Type::kBrowserView;
+    auto* renderer_sharing = RendererSharingManager::GetInstance();
+    scoped_refptr<content::SiteInstance> site_instance;
+    if (can_share_renderer) {
+      site_instance = renderer_sharing->GetSiteInstanceForWebContents(
+          session->browser_context(), options);
+    }
+    content::WebContents::CreateParams params(session->browser_context(),
+                                              site_instance);
     params.initially_hidden = !initially_shown;
+    // The renderer process of the initial frame is picked here.
+    SpareRendererManager::ScopedClaim spare_renderer_claim(
+        session->browser_context(), options);
     web_contents = content::WebContents::Create(params);
+    if (can_share_renderer)
+      renderer_sharing->AddWebContents(web_contents.get(), options);
   }
 
   InitWithSessionAndOptions(isolate, std::move(web_contents), session, options);
@@ -1477,12 +1713,38 @@ void WebContents::RendererUnresponsive(
     content::WebContents* source,
     content::RenderWidgetHost* render_widget_host,
     base::RepeatingClosure hang_monitor_restarter) {
-  Emit("unresponsive");
+  FlightRecorder::GetInstance()->OnTrigger(FlightRecorder::Trigger::kHang);
+  if (!unresponsive_diagnostics_) {
+    Emit("unresponsive");
+    return;
+  }
+  if (sampling_unresponsive_)
+    return;
+  sampling_unresponsive_ = true;
+  SampleRendererStack(base::BindOnce(&WebContents::OnUnresponsiveSample,
+                                     GetWeakPtr()));
+}
+
+void WebContents::OnUnresponsiveSample(
+    absl::optional<base::Value::Dict> details) {
+  sampling_unresponsive_ = false;
+  if (details)
+    Emit("unresponsive", *details);
+  else
+    Emit("unresponsive");
+  if (responsive_while_sampling_) {
+    responsive_while_sampling_ = false;
+    Emit("responsive");
+  }
 }
 
 void WebContents::RendererResponsive(
     content::WebContents* source,
     content::RenderWidgetHost* render_widget_host) {
+  if (sampling_unresponsive_) {
+    responsive_while_sampling_ = true;
+    return;
+  }
   Emit("responsive");
 }
 
@@ -1499,8 +1761,12 @@ void WebContents::FindReply(content::WebContents* web_contents,
                             const gfx::Rect& selection_rect,
                             int active_match_ordinal,
                             bool final_update) {
-  if (!final_update)
+  // Intermediate results of older requests are superseded by the latest one.
+  if (!final_update &&
+      (!find_in_page_incremental_ ||
+       request_id != static_cast<int>(find_in_page_request_id_))) {
     return;
+  }
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
@@ -1644,6 +1910,11 @@ void WebContents::RenderFrameCreated(
     content::RenderFrameHost* render_frame_host) {
   HandleNewRenderFrame(render_frame_host);
 
+  if (show_timeline_.renderer_ready.is_null() &&
+      render_frame_host == web_contents()->GetPrimaryMainFrame()) {
+    show_timeline_.renderer_ready = base::TimeTicks::Now();
+  }
+
   // RenderFrameCreated is called for speculative frames which may not be
   // used in certain cross-origin navigations. Invoking
   // RenderFrameHost::GetLifecycleState currently crashes when called for
@@ -1685,6 +1956,9 @@ void WebContents::RenderFrameDeleted(
   auto* web_frame = WebFrameMain::FromRenderFrameHost(render_frame_host);
   if (web_frame && web_frame->render_frame_host() == render_frame_host)
     web_frame->MarkRenderFrameDisposed();
+
+  DirectIPCChannelRegistry::GetInstance()->RemoveFrame(
+      render_frame_host->GetGlobalId());
 }
 
 void WebContents::RenderFrameHostChanged(content::RenderFrameHost* old_host,
@@ -1732,6 +2006,13 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 
 void WebContents::PrimaryMainFrameRenderProcessGone(
     base::TerminationStatus status) {
+  // The renderer was shut down on purpose by discard().
+  if (lifecycle_state_ == LifecycleState::kDiscarded)
+    return;
+
+  if (status != base::TERMINATION_STATUS_NORMAL_TERMINATION)
+    FlightRecorder::GetInstance()->OnTrigger(FlightRecorder::Trigger::kCrash);
+
   auto weak_this = GetWeakPtr();
   Emit("crashed", status == base::TERMINATION_STATUS_PROCESS_WAS_KILLED);
 
@@ -1850,6 +2131,10 @@ void WebContents::DidStopLoading() {
   Emit("did-stop-loading");
 }
 
+void WebContents::DidFirstVisuallyNonEmptyPaint() {
+  startup_timeline::Mark(startup_timeline::Phase::kFirstPaint);
+}
+
 bool WebContents::EmitNavigationEvent(
     const std::string& event_name,
     content::NavigationHandle* navigation_handle) {
@@ -1888,16 +2173,56 @@ bool WebContents::EmitNavigationEvent(
   return event->GetDefaultPrevented();
 }
 
+bool WebContents::NeedsNavigationThrottle(
+    content::NavigationHandle* navigation_handle) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto has_listeners = [&](const char* event_name) {
+    v8::Local<v8::Value> count =
+        gin_helper::CallMethod(isolate, this, "listenerCount", event_name);
+    return count.IsEmpty() || !count->IsNumber() ||
+           count.As<v8::Number>()->Value() > 0;
+  };
+  // Keep in sync with the events of ElectronNavigationThrottle.
+  bool needed = has_listeners("will-redirect");
+  if (!needed && navigation_handle->IsRendererInitiated()) {
+    needed = has_listeners("will-frame-navigate") ||
+             (navigation_handle->IsInMainFrame() &&
+              has_listeners("will-navigate"));
+  }
+  if (!needed)
+    ++fast_pathed_navigation_count_;
+  return needed;
+}
+
 void WebContents::Message(bool internal,
                           const std::string& channel,
-                          blink::CloneableMessage arguments,
+                          blink::TransferableMessage arguments,
                           content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Value> args =
+      electron::DeserializeV8ValueWithArrayBuffers(isolate, &arguments);
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
   EmitWithSender("-ipc-message", render_frame_host,
                  electron::mojom::ElectronApiIPC::InvokeCallback(), internal,
-                 channel, std::move(arguments));
+                 channel, args);
+}
+
+void WebContents::MessageJSON(const std::string& channel,
+                              mojo_base::BigBuffer json,
+                              content::RenderFrameHost* render_frame_host) {
+  TRACE_EVENT1("electron", "WebContents::MessageJSON", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<v8::Local<v8::Value>> args = {
+      IPCJSONPayload::Create(isolate, std::move(json)).ToV8()};
+  // webContents.emit('-ipc-message', new Event(), false, channel, [payload]);
+  EmitWithSender("-ipc-message", render_frame_host,
+                 electron::mojom::ElectronApiIPC::InvokeCallback(), false,
+                 channel, args);
 }
 
 void WebContents::Invoke(
@@ -1915,7 +2240,24 @@ void WebContents::Invoke(
 void WebContents::OnFirstNonEmptyLayout(
     content::RenderFrameHost* render_frame_host) {
   if (render_frame_host == web_contents()->GetPrimaryMainFrame()) {
-    Emit("ready-to-show");
+    startup_timeline::Mark(startup_timeline::Phase::kFirstNonEmptyLayout);
+    // The milliseconds from the creation of the page to each stage, the
+    // stages which were not reached are left out.
+    const base::TimeTicks now = base::TimeTicks::Now();
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    gin_helper::Dictionary timings =
+        gin_helper::Dictionary::CreateEmpty(isolate);
+    auto set_timing = [&](const char* name, base::TimeTicks time) {
+      if (!time.is_null())
+        timings.Set(name, (time - show_timeline_.created).InMillisecondsF());
+    };
+    set_timing("rendererReady", show_timeline_.renderer_ready);
+    set_timing("navigationStart", show_timeline_.navigation_start);
+    set_timing("responseStart", show_timeline_.response_start);
+    set_timing("navigationCommit", show_timeline_.navigation_commit);
+    set_timing("firstLayout", now);
+    Emit("ready-to-show", timings);
   }
 }
 
@@ -1961,8 +2303,8 @@ class ReplyChannel : public gin::Wrappable<ReplyChannel> {
   bool SendReply(v8::Isolate* isolate, v8::Local<v8::Value> arg) {
     if (!callback_)
       return false;
-    blink::CloneableMessage message;
-    if (!gin::ConvertFromV8(isolate, arg, &message)) {
+    blink::TransferableMessage message;
+    if (!electron::SerializeV8ValueWithArrayBuffers(isolate, arg, &message)) {
       return false;
     }
 
@@ -2052,6 +2394,34 @@ void WebContents::MessageTo(int32_t web_contents_id,
   }
 }
 
+mojo::PendingRemote<mojom::ElectronDirectIPC> WebContents::OpenDirectChannel(
+    int32_t web_contents_id,
+    content::RenderFrameHost* render_frame_host) {
+  TRACE_EVENT1("electron", "WebContents::OpenDirectChannel", "target",
+               web_contents_id);
+  auto* target_web_contents = FromID(web_contents_id);
+  if (!target_web_contents)
+    return mojo::NullRemote();
+  content::RenderFrameHost* frame = target_web_contents->MainFrame();
+  DCHECK(frame);
+
+  v8::HandleScope handle_scope(JavascriptEnvironment::GetIsolate());
+  gin::Handle<WebFrameMain> web_frame_main =
+      WebFrameMain::From(JavascriptEnvironment::GetIsolate(), frame);
+  if (!web_frame_main->CheckRenderFrame())
+    return mojo::NullRemote();
+
+  // Sent on the same pipe as the messages forwarded by MessageTo(), so that
+  // the target sees the messages that were sent before those on the channel.
+  mojo::PendingRemote<mojom::ElectronDirectIPC> channel;
+  web_frame_main->GetRendererApi()->ReceiveDirectChannel(
+      ID(), channel.InitWithNewPipeAndPassReceiver());
+  DirectIPCChannelRegistry::GetInstance()->Add(
+      {ID(), render_frame_host->GetGlobalId(), web_contents_id,
+       frame->GetGlobalId()});
+  return channel;
+}
+
 void WebContents::MessageHost(const std::string& channel,
                               blink::CloneableMessage arguments,
                               content::RenderFrameHost* render_frame_host) {
@@ -2063,15 +2433,61 @@ void WebContents::MessageHost(const std::string& channel,
 }
 
 void WebContents::UpdateDraggableRegions(
-    std::vector<mojom::DraggableRegionPtr> regions) {
+    content::RenderFrameHost* render_frame_host,
+    const std::vector<mojom::DraggableRegionPtr>& regions,
+    size_t start) {
   if (owner_window() && owner_window()->has_frame())
     return;
 
-  draggable_region_ = DraggableRegionsToSkRegion(regions);
+  // The regions are applied in order, so the unchanged head of the list is
+  // only applied again when the update changes a part of it.
+  const content::GlobalRenderFrameHostId frame_id =
+      render_frame_host ? render_frame_host->GetGlobalId()
+                        : content::GlobalRenderFrameHostId();
+  if (frame_id != draggable_region_frame_id_ ||
+      start < draggable_region_prefix_size_) {
+    draggable_region_frame_id_ = frame_id;
+    draggable_region_prefix_.setEmpty();
+    draggable_region_prefix_size_ = 0;
+  }
+  base::span<const mojom::DraggableRegionPtr> all_regions(regions);
+  ApplyDraggableRegions(
+      all_regions.subspan(draggable_region_prefix_size_,
+                          start - draggable_region_prefix_size_),
+      &draggable_region_prefix_);
+  draggable_region_prefix_size_ = start;
+
+  auto draggable_region = std::make_unique<SkRegion>(draggable_region_prefix_);
+  ApplyDraggableRegions(all_regions.subspan(start), draggable_region.get());
+  draggable_region_ = std::move(draggable_region);
+}
+
+void WebContents::OnVisibilityChanged(content::Visibility visibility) {
+  if (visibility == content::Visibility::HIDDEN)
+    return;
+  if (lifecycle_state_ == LifecycleState::kDiscarded) {
+    lifecycle_state_ = LifecycleState::kActive;
+    // The navigation entries outlive the renderer, so this restores the page.
+    web_contents()->GetController().Reload(content::ReloadType::NORMAL,
+                                           false /* check_for_repost */);
+  } else {
+    Resume();
+  }
 }
 
 void WebContents::DidStartNavigation(
     content::NavigationHandle* navigation_handle) {
+  // Navigating starts a new renderer for a discarded page.
+  if (navigation_handle->IsInPrimaryMainFrame() &&
+      lifecycle_state_ == LifecycleState::kDiscarded) {
+    lifecycle_state_ = LifecycleState::kActive;
+  }
+  if (navigation_handle->IsInPrimaryMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    show_timeline_.navigation_start = base::TimeTicks::Now();
+    show_timeline_.response_start = base::TimeTicks();
+    show_timeline_.navigation_commit = base::TimeTicks();
+  }
   EmitNavigationEvent("did-start-navigation", navigation_handle);
 }
 
@@ -2082,6 +2498,14 @@ void WebContents::DidRedirectNavigation(
 
 void WebContents::ReadyToCommitNavigation(
     content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsInPrimaryMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    show_timeline_.response_start = base::TimeTicks::Now();
+  }
+
+  if (!navigation_handle->IsSameDocument())
+    SendSandboxPreloads(navigation_handle);
+
   // Don't focus content in an inactive window.
   if (!owner_window())
     return;
@@ -2109,6 +2533,12 @@ void WebContents::DidFinishNavigation(
 
   if (!navigation_handle->HasCommitted())
     return;
+  if (navigation_handle->IsInPrimaryMainFrame()) {
+    startup_timeline::Mark(
+        startup_timeline::Phase::kFirstNavigationCommitted);
+    if (!navigation_handle->IsSameDocument())
+      show_timeline_.navigation_commit = base::TimeTicks::Now();
+  }
   bool is_main_frame = navigation_handle->IsInMainFrame();
   content::RenderFrameHost* frame_host =
       navigation_handle->GetRenderFrameHost();
@@ -2284,6 +2714,8 @@ void WebContents::WebContentsDestroyed() {
   // Clear the pointer stored in wrapper.
   if (GetAllWebContents().Lookup(id_))
     GetAllWebContents().Remove(id_);
+  if (offscreen_capture_group_)
+    offscreen_capture_group_->RemoveWebContents(this);
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Object> wrapper;
@@ -2346,6 +2778,60 @@ base::ProcessId WebContents::GetOSProcessID() const {
   return base::GetProcId(process_handle);
 }
 
+v8::Local<v8::Value> WebContents::GetIPCMetrics(v8::Isolate* isolate) const {
+  auto histogram_to_v8 = [isolate](const IPCChannelMetrics::Histogram& h) {
+    // Leave out the empty buckets at the end.
+    size_t bucket_count = h.buckets.size();
+    while (bucket_count && !h.buckets[bucket_count - 1])
+      --bucket_count;
+    std::vector<uint64_t> buckets(h.buckets.begin(),
+                                  h.buckets.begin() + bucket_count);
+    return gin::DataObjectBuilder(isolate)
+        .Set("count", h.count)
+        .Set("sum", h.sum)
+        .Set("min", h.min)
+        .Set("max", h.max)
+        .Set("buckets", buckets)
+        .Build();
+  };
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  for (const auto& [channel, stats] : ipc_metrics_.channels()) {
+    result.Set(channel,
+               gin::DataObjectBuilder(isolate)
+                   .Set("count", stats.size.count)
+                   .Set("size", histogram_to_v8(stats.size))
+                   .Set("serializationTime",
+                        histogram_to_v8(stats.serialization_time))
+                   .Set("queueingDelay", histogram_to_v8(stats.queueing_delay))
+                   .Set("handlerDuration",
+                        histogram_to_v8(stats.handler_duration))
+                   .Build());
+  }
+  return result.GetHandle();
+}
+
+void WebContents::ClearIPCMetrics() {
+  ipc_metrics_.Clear();
+}
+
+v8::Local<v8::Value> WebContents::GetDirectIPCChannels(
+    v8::Isolate* isolate) const {
+  std::vector<v8::Local<v8::Value>> result;
+  for (const auto& channel :
+       DirectIPCChannelRegistry::GetInstance()->GetChannels(ID())) {
+    result.push_back(
+        gin::DataObjectBuilder(isolate)
+            .Set("senderId", channel.sender_id)
+            .Set("senderProcessId", channel.sender_frame.child_id)
+            .Set("senderFrameId", channel.sender_frame.frame_routing_id)
+            .Set("targetId", channel.target_id)
+            .Set("targetProcessId", channel.target_frame.child_id)
+            .Set("targetFrameId", channel.target_frame.frame_routing_id)
+            .Build());
+  }
+  return gin::ConvertToV8(isolate, result);
+}
+
 WebContents::Type WebContents::GetType() const {
   return type_;
 }
@@ -2367,6 +2853,9 @@ void WebContents::LoadURL(const GURL& url,
     return;
   }
 
+  // A frozen page wouldn't run the navigation.
+  Resume();
+
   content::NavigationController::LoadURLParams params(url);
 
   if (!options.Get("httpReferrer", &params.referrer)) {
@@ -2567,6 +3056,73 @@ bool WebContents::IsCrashed() const {
   return web_contents()->IsCrashed();
 }
 
+bool WebContents::Freeze() {
+  if (web_contents()->GetVisibility() != content::Visibility::HIDDEN)
+    return false;
+  if (lifecycle_state_ == LifecycleState::kActive) {
+    web_contents()->SetPageFrozen(true);
+    lifecycle_state_ = LifecycleState::kFrozen;
+  }
+  return true;
+}
+
+void WebContents::Resume() {
+  if (lifecycle_state_ != LifecycleState::kFrozen)
+    return;
+  web_contents()->SetPageFrozen(false);
+  lifecycle_state_ = LifecycleState::kActive;
+}
+
+bool WebContents::Discard() {
+  if (web_contents()->GetVisibility() != content::Visibility::HIDDEN)
+    return false;
+  if (lifecycle_state_ == LifecycleState::kDiscarded)
+    return true;
+  content::RenderProcessHost* process =
+      web_contents()->GetPrimaryMainFrame()->GetProcess();
+  // Observers are notified of the shutdown synchronously, they must see the
+  // new state.
+  const LifecycleState previous_state = lifecycle_state_;
+  lifecycle_state_ = LifecycleState::kDiscarded;
+  // Only when no other page would go down with the renderer.
+  if (!process->FastShutdownIfPossible(1, true /* skip_unload_handlers */)) {
+    lifecycle_state_ = previous_state;
+    return false;
+  }
+  return true;
+}
+
+void WebContents::OnNearHeapLimit(uint64_t initial_heap_limit,
+                                  uint64_t heap_limit,
+                                  uint64_t used_heap_size) {
+  auto* web_preferences = WebContentsPreferences::From(web_contents());
+  if (!web_preferences)
+    return;
+  const auto action = web_preferences->GetNearHeapLimitAction();
+  if (action == WebContentsPreferences::NearHeapLimitAction::kCrash)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("initialHeapLimit", initial_heap_limit / 1024);
+  details.Set("heapLimit", heap_limit / 1024);
+  details.Set("usedHeapSize", used_heap_size / 1024);
+  const bool reload =
+      action == WebContentsPreferences::NearHeapLimitAction::kReload;
+  details.Set("action", reload ? "reload" : "notify");
+  base::WeakPtr<WebContents> weak_this = GetWeakPtr();
+  Emit("near-heap-limit", details);
+  if (!reload || !weak_this || !web_contents())
+    return;
+
+  // The renderer is killed before V8 runs out of memory, which emits
+  // 'render-process-gone' with the 'killed' reason.
+  web_contents()->GetPrimaryMainFrame()->GetProcess()->Shutdown(
+      content::RESULT_CODE_KILLED);
+  web_contents()->GetController().Reload(content::ReloadType::NORMAL, false);
+}
+
 void WebContents::ForcefullyCrashRenderer() {
   content::RenderWidgetHostView* view =
       web_contents()->GetRenderWidgetHostView();
@@ -3026,11 +3582,11 @@ void WebContents::Print(gin::Arguments* args) {
     settings.Set(printing::kSettingDpiVertical, dpi);
   }
 
-  print_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE, base::BindOnce(&GetDeviceNameToUse, device_name),
-      base::BindOnce(&WebContents::OnGetDeviceNameToUse,
-                     weak_factory_.GetWeakPtr(), std::move(settings),
-                     std::move(callback), silent));
+  PrinterListCache::GetInstance()->GetDeviceNameToUse(
+      device_name, base::BindOnce(&WebContents::OnGetDeviceNameToUse,
+                                  weak_factory_.GetWeakPtr(),
+                                  std::move(settings), std::move(callback),
+                                  silent));
 }
 
 // Partially duplicated and modified from
@@ -3057,6 +3613,9 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
   auto header_template = *settings.GetDict().FindString("headerTemplate");
   auto footer_template = *settings.GetDict().FindString("footerTemplate");
   auto prefer_css_page_size = settings.GetDict().FindBool("preferCSSPageSize");
+  const std::string* path = settings.GetDict().FindString("path");
+  base::FilePath pdf_path =
+      path ? base::FilePath::FromUTF8Unsafe(*path) : base::FilePath();
 
   absl::variant<printing::mojom::PrintPagesParamsPtr, std::string>
       print_pages_params = print_to_pdf::GetPrintPagesParams(
@@ -3085,13 +3644,14 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
   manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(), page_ranges,
                       std::move(params),
                       base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
-                                     std::move(promise)));
+                                     std::move(promise), std::move(pdf_path)));
 
   return handle;
 }
 
 void WebContents::OnPDFCreated(
     gin_helper::Promise<v8::Local<v8::Value>> promise,
+    const base::FilePath& path,
     print_to_pdf::PdfPrintResult print_result,
     scoped_refptr<base::RefCountedMemory> data) {
   if (print_result != print_to_pdf::PdfPrintResult::kPrintSuccess) {
@@ -3101,6 +3661,37 @@ void WebContents::OnPDFCreated(
     return;
   }
 
+  if (!path.empty()) {
+    // The document is written from the memory the compositor returned it
+    // in, so a large PDF isn't copied into the JS heap as well.
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](const base::FilePath& path,
+               scoped_refptr<base::RefCountedMemory> data) {
+              return base::WriteFile(
+                  path, base::make_span(data->front(), data->size()));
+            },
+            path, std::move(data)),
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+               bool success) {
+              if (!success) {
+                promise.RejectWithErrorMessage("Failed to write the PDF");
+                return;
+              }
+              v8::Isolate* isolate = promise.isolate();
+              gin_helper::Locker locker(isolate);
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(
+                  v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+              promise.Resolve(
+                  node::Buffer::New(isolate, 0).ToLocalChecked());
+            },
+            std::move(promise)));
+    return;
+  }
+
   v8::Isolate* isolate = promise.isolate();
   gin_helper::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
@@ -3219,10 +3810,12 @@ uint32_t WebContents::FindInPage(gin::Arguments* args) {
   uint32_t request_id = ++find_in_page_request_id_;
   gin_helper::Dictionary dict;
   auto options = blink::mojom::FindOptions::New();
+  find_in_page_incremental_ = false;
   if (args->GetNext(&dict)) {
     dict.Get("forward", &options->forward);
     dict.Get("matchCase", &options->match_case);
     dict.Get("findNext", &options->new_session);
+    dict.Get("incremental", &find_in_page_incremental_);
   }
 
   web_contents()->Find(request_id, search_text, std::move(options));
@@ -3280,71 +3873,141 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (!view)
     return;
 
-  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
-  blink::WebInputEvent::Type type =
-      gin::GetWebInputEventType(isolate, input_event);
-  if (blink::WebInputEvent::IsMouseEventType(type)) {
-    blink::WebMouseEvent mouse_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
-      return;
-    }
-  } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
-    content::NativeWebKeyboardEvent keyboard_event(
-        blink::WebKeyboardEvent::Type::kRawKeyDown,
-        blink::WebInputEvent::Modifiers::kNoModifiers, ui::EventTimeForNow());
-    if (gin::ConvertFromV8(isolate, input_event, &keyboard_event)) {
-      // For backwards compatibility, convert `kKeyDown` to `kRawKeyDown`.
-      if (keyboard_event.GetType() == blink::WebKeyboardEvent::Type::kKeyDown)
-        keyboard_event.SetType(blink::WebKeyboardEvent::Type::kRawKeyDown);
-      rwh->ForwardKeyboardEvent(keyboard_event);
-      return;
+  InputEventReplay::Event event;
+  if (!ConvertInputEvent(isolate, input_event, &event)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Invalid event object")));
+    return;
+  }
+  DispatchInputEvent(event);
+}
+
+v8::Local<v8::Promise> WebContents::SendInputEvents(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  std::vector<v8::Local<v8::Value>> values;
+  if (!args->GetNext(&values)) {
+    args->ThrowTypeError("Must pass an array of input events");
+    return v8::Local<v8::Promise>();
+  }
+  bool coalesce = true;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("coalesce", &coalesce);
+
+  // The whole array is converted before any event is sent.
+  std::vector<InputEventReplay::ScheduledEvent> events;
+  events.reserve(values.size());
+  base::TimeDelta last_time;
+  for (size_t i = 0; i < values.size(); ++i) {
+    InputEventReplay::ScheduledEvent scheduled;
+    if (!ConvertInputEvent(isolate, values[i], &scheduled.event)) {
+      args->ThrowTypeError("Invalid event object at index " +
+                           base::NumberToString(i));
+      return v8::Local<v8::Promise>();
     }
-  } else if (type == blink::WebInputEvent::Type::kMouseWheel) {
-    blink::WebMouseWheelEvent mouse_wheel_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event)) {
-      if (IsOffScreen()) {
-        GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
-            mouse_wheel_event);
-      } else {
-        // Chromium expects phase info in wheel events (and applies a
-        // DCHECK to verify it). See: https://crbug.com/756524.
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-
-        // Send a synthetic wheel event with phaseEnded to finish scrolling.
-        mouse_wheel_event.has_synthetic_phase = true;
-        mouse_wheel_event.delta_x = 0;
-        mouse_wheel_event.delta_y = 0;
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kEventNonBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
+    double time = 0;
+    gin_helper::Dictionary dict;
+    if (gin::ConvertFromV8(isolate, values[i], &dict) &&
+        dict.Get("time", &time)) {
+      if (time < 0 || base::Milliseconds(time) < last_time) {
+        args->ThrowTypeError("The times of the events must not decrease");
+        return v8::Local<v8::Promise>();
       }
-      return;
+      last_time = base::Milliseconds(time);
     }
+    scheduled.time = last_time;
+    events.push_back(std::move(scheduled));
   }
 
-  isolate->ThrowException(
-      v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!input_event_replay_) {
+    // Unretained is safe as |input_event_replay_| is owned by |this|.
+    input_event_replay_ = std::make_unique<InputEventReplay>(
+        base::BindRepeating(&WebContents::DispatchInputEvent,
+                            base::Unretained(this)));
+  }
+  input_event_replay_->Schedule(
+      std::move(events), coalesce,
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise) { promise.Resolve(); },
+          std::move(promise)));
+  return handle;
+}
+
+void WebContents::DispatchInputEvent(const InputEventReplay::Event& event) {
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (!view)
+    return;
+
+  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
+  if (const auto* mouse_event = std::get_if<blink::WebMouseEvent>(&event)) {
+    if (IsOffScreen()) {
+      GetOffScreenRenderWidgetHostView()->SendMouseEvent(*mouse_event);
+    } else {
+      rwh->ForwardMouseEvent(*mouse_event);
+    }
+  } else if (const auto* keyboard_event =
+                 std::get_if<content::NativeWebKeyboardEvent>(&event)) {
+    if (IsOffScreen())
+      GetOffScreenRenderWidgetHostView()->OnActivity();
+    rwh->ForwardKeyboardEvent(*keyboard_event);
+  } else if (const auto* wheel_event =
+                 std::get_if<blink::WebMouseWheelEvent>(&event)) {
+    if (IsOffScreen()) {
+      GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(*wheel_event);
+    } else {
+      blink::WebMouseWheelEvent mouse_wheel_event = *wheel_event;
+      // Chromium expects phase info in wheel events (and applies a
+      // DCHECK to verify it). See: https://crbug.com/756524.
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
+      mouse_wheel_event.dispatch_type =
+          blink::WebInputEvent::DispatchType::kBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
+
+      // Send a synthetic wheel event with phaseEnded to finish scrolling.
+      mouse_wheel_event.has_synthetic_phase = true;
+      mouse_wheel_event.delta_x = 0;
+      mouse_wheel_event.delta_y = 0;
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
+      mouse_wheel_event.dispatch_type =
+          blink::WebInputEvent::DispatchType::kEventNonBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
+    }
+  }
 }
 
 void WebContents::BeginFrameSubscription(gin::Arguments* args) {
   bool only_dirty = false;
+  FrameSubscriber::Format format = FrameSubscriber::Format::kNativeImage;
   FrameSubscriber::FrameCaptureCallback callback;
 
   if (args->Length() > 1) {
-    if (!args->GetNext(&only_dirty)) {
+    gin_helper::Dictionary options;
+    if (args->PeekNext()->IsObject() && args->GetNext(&options)) {
+      options.Get("onlyDirty", &only_dirty);
+      if (options.Has("format") && !options.Get("format", &format)) {
+        args->ThrowTypeError("Invalid format");
+        return;
+      }
+    } else if (!args->GetNext(&only_dirty)) {
       args->ThrowError();
       return;
     }
   }
+
+  if (format != FrameSubscriber::Format::kNativeImage) {
+    FrameSubscriber::RawFrameCaptureCallback raw_callback;
+    if (!args->GetNext(&raw_callback)) {
+      args->ThrowError();
+      return;
+    }
+    frame_subscriber_ =
+        std::make_unique<FrameSubscriber>(web_contents(), raw_callback, format);
+    return;
+  }
+
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
@@ -3358,6 +4021,76 @@ void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+v8::Local<v8::Promise> WebContents::StartRecording(const base::FilePath& path,
+                                                   gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!path.IsAbsolute()) {
+    promise.RejectWithErrorMessage("Path must be absolute");
+    return handle;
+  }
+  // A recording which failed to start can be replaced.
+  if (frame_recorder_ && !frame_recorder_->failed()) {
+    promise.RejectWithErrorMessage("The page is already being recorded");
+    return handle;
+  }
+
+  FrameRecorder::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string codec;
+    if (dict.Get("codec", &codec)) {
+      if (codec == "vp9") {
+        options.codec = media::VideoCodec::kVP9;
+      } else if (codec != "vp8") {
+        promise.RejectWithErrorMessage("Invalid codec");
+        return handle;
+      }
+    }
+    if (dict.Get("frameRate", &options.frame_rate))
+      options.frame_rate = std::clamp(options.frame_rate, 1, 60);
+    dict.Get("bitrate", &options.bitrate);
+  }
+
+  frame_recorder_ = std::make_unique<FrameRecorder>(
+      web_contents(), path, options,
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise,
+             absl::optional<std::string> error) {
+            if (error)
+              promise.RejectWithErrorMessage(*error);
+            else
+              promise.Resolve();
+          },
+          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopRecording(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!frame_recorder_) {
+    promise.RejectWithErrorMessage("The page is not being recorded");
+    return handle;
+  }
+
+  // The recorder is kept alive until the file is closed.
+  FrameRecorder* recorder = frame_recorder_.get();
+  recorder->Stop(base::BindOnce(
+      [](std::unique_ptr<FrameRecorder> recorder,
+         gin_helper::Promise<void> promise,
+         absl::optional<std::string> error) {
+        if (error)
+          promise.RejectWithErrorMessage(*error);
+        else
+          promise.Resolve();
+      },
+      std::move(frame_recorder_), std::move(promise)));
+  return handle;
+}
+
 void WebContents::StartDrag(const gin_helper::Dictionary& item,
                             gin::Arguments* args) {
   base::FilePath file;
@@ -3396,20 +4129,57 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   gfx::Rect rect;
   args->GetNext(&rect);
 
+  gin_helper::Dictionary options;
+  if (args && args->Length() == 2)
+    args->GetNext(&options);
+
+  CopyPageFromSurface(rect, options,
+                      base::BindOnce(&OnCapturePageDone, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::CaptureEncodedPage(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gfx::Rect rect;
+  args->GetNext(&rect);
+
+  gin_helper::Dictionary options;
+  CaptureFormat format = CaptureFormat::kPNG;
+  int quality = 90;
+  if (args->Length() == 2 && args->GetNext(&options)) {
+    if (options.Has("format") && !options.Get("format", &format)) {
+      promise.RejectWithErrorMessage("Invalid format");
+      return handle;
+    }
+    if (options.Get("quality", &quality))
+      quality = std::clamp(quality, 0, 100);
+  }
+
+  CopyPageFromSurface(rect, options,
+                      base::BindOnce(&OnCaptureEncodedPageDone,
+                                     std::move(promise), format, quality));
+  return handle;
+}
+
+void WebContents::CopyPageFromSurface(
+    const gfx::Rect& rect,
+    const gin_helper::Dictionary& options,
+    base::OnceCallback<void(const SkBitmap&)> callback) {
   bool stay_hidden = false;
   bool stay_awake = false;
-  if (args && args->Length() == 2) {
-    gin_helper::Dictionary options;
-    if (args->GetNext(&options)) {
-      options.Get("stayHidden", &stay_hidden);
-      options.Get("stayAwake", &stay_awake);
-    }
+  gfx::Size output_size;
+  if (!options.IsEmpty()) {
+    options.Get("stayHidden", &stay_hidden);
+    options.Get("stayAwake", &stay_awake);
+    options.Get("size", &output_size);
   }
 
   auto* const view = web_contents()->GetRenderWidgetHostView();
   if (!view) {
-    promise.Resolve(gfx::Image());
-    return handle;
+    std::move(callback).Run(SkBitmap());
+    return;
   }
 
 #if !BUILDFLAG(IS_MAC)
@@ -3419,8 +4189,8 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   auto* rfh = web_contents()->GetPrimaryMainFrame();
   if (rfh &&
       rfh->GetVisibilityState() == blink::mojom::PageVisibilityState::kHidden) {
-    promise.Resolve(gfx::Image());
-    return handle;
+    std::move(callback).Run(SkBitmap());
+    return;
   }
 #endif  // BUILDFLAG(IS_MAC)
 
@@ -3442,10 +4212,19 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   if (scale > 1.0f)
     bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
 
-  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
-                        base::BindOnce(&OnCapturePageDone, std::move(promise),
-                                       std::move(capture_handle)));
-  return handle;
+  // The copy request scales the page on the GPU, which is much cheaper than
+  // resizing the full size image afterwards.
+  if (!output_size.IsEmpty())
+    bitmap_size = output_size;
+
+  view->CopyFromSurface(
+      gfx::Rect(rect.origin(), view_size), bitmap_size,
+      base::BindOnce(
+          [](base::OnceCallback<void(const SkBitmap&)> callback,
+             base::ScopedClosureRunner capture_handle, const SkBitmap& bitmap) {
+            std::move(callback).Run(bitmap);
+          },
+          std::move(callback), std::move(capture_handle)));
 }
 
 bool WebContents::IsBeingCaptured() {
@@ -3476,12 +4255,51 @@ void WebContents::AttachToIframe(content::WebContents* embedder_web_contents,
     guest_delegate_->AttachToIframe(embedder_web_contents, embedder_frame_id);
 }
 
+void WebContents::SetElementVisible(bool visible) {
+  if (guest_delegate_)
+    guest_delegate_->SetElementVisible(visible);
+}
+
 bool WebContents::IsOffScreen() const {
   return type_ == Type::kOffScreen;
 }
 
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+  if (offscreen_capture_group_) {
+    offscreen_capture_group_->OnPaint(this, dirty_rect, bitmap);
+    return;
+  }
+
+  if (offscreen_paint_format_ == PaintFormat::kNativeImage) {
+    Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+    return;
+  }
+
+  const gfx::Rect rect = gfx::IntersectRects(
+      dirty_rect, gfx::Rect(bitmap.width(), bitmap.height()));
+  if (rect.IsEmpty() || bitmap.drawsNothing())
+    return;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  // The compositor reports a single damaged rect for each frame.
+  std::vector<gin_helper::Dictionary> regions = {
+      CreatePaintRegion(isolate, bitmap, rect, offscreen_paint_format_)};
+  Emit("paint-regions", regions);
+}
+
+void WebContents::OnTexturePaint(
+    const gfx::Rect& dirty_rect,
+    std::unique_ptr<OffscreenSharedTexture> texture) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("textureInfo", CreateTextureInfo(isolate, *texture));
+  // The capturer gets the texture back when |release| is called or garbage
+  // collected, whichever happens first.
+  dict.Set("release",
+           base::BindOnce([](std::unique_ptr<OffscreenSharedTexture>) {},
+                          std::move(texture)));
+  Emit("paint", dirty_rect, gfx::Image(), dict);
 }
 
 void WebContents::StartPainting() {
@@ -3512,6 +4330,20 @@ int WebContents::GetFrameRate() const {
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
 
+void WebContents::SetAdaptiveFrameRate(bool enabled, gin::Arguments* args) {
+  int min_frame_rate = 1;
+  args->GetNext(&min_frame_rate);
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetAdaptiveFrameRate(enabled, min_frame_rate);
+}
+
+void WebContents::SendExternalBeginFrame() {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SendExternalBeginFrame();
+}
+
 void WebContents::Invalidate() {
   if (IsOffScreen()) {
     auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
@@ -3583,6 +4415,27 @@ std::vector<base::FilePath> WebContents::GetPreloadPaths() const {
   return result;
 }
 
+void WebContents::SendSandboxPreloads(
+    content::NavigationHandle* navigation_handle) {
+  auto* web_preferences = WebContentsPreferences::From(web_contents());
+  if (!web_preferences || !web_preferences->IsSandboxed())
+    return;
+  // Like RendererClientBase::ShouldLoadPreload().
+  if (!navigation_handle->IsInMainFrame() &&
+      !web_preferences->AllowsNodeIntegrationInSubFrames())
+    return;
+
+  // The agent is associated with the navigation of the frame, so the
+  // preloads arrive before the commit. When they aren't sent the renderer
+  // asks for them with BROWSER_SANDBOX_LOAD, as before.
+  mojo::AssociatedRemote<mojom::ElectronPreloadAgent> preload_agent;
+  navigation_handle->GetRenderFrameHost()
+      ->GetRemoteAssociatedInterfaces()
+      ->GetInterface(&preload_agent);
+  preload_agent->SetPreloads(
+      PreloadScriptCache::GetInstance()->GetPreloads(GetPreloadPaths()));
+}
+
 v8::Local<v8::Value> WebContents::GetLastWebPreferences(
     v8::Isolate* isolate) const {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
@@ -3703,12 +4556,141 @@ v8::Local<v8::Promise> WebContents::GetProcessMemoryInfo(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::ReduceMemory(gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool purge_caches = true;
+  bool notify_v8 = true;
+  bool purge_partition_alloc = true;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("caches", &purge_caches);
+    options.Get("v8", &notify_v8);
+    options.Get("partitionAlloc", &purge_partition_alloc);
+  }
+
+  ReduceRendererMemory(
+      purge_caches, notify_v8, purge_partition_alloc,
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, bool success) {
+            if (success)
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage("The page has no live renderer");
+          },
+          std::move(promise)));
+  return handle;
+}
+
+void WebContents::ReduceRendererMemory(bool purge_caches,
+                                       bool notify_v8,
+                                       bool purge_partition_alloc,
+                                       base::OnceCallback<void(bool)> done) {
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    std::move(done).Run(false);
+    return;
+  }
+
+  // The remote is owned by the callback so the reply can still arrive.
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->ReduceMemory(
+      purge_caches, notify_v8, purge_partition_alloc,
+      base::BindOnce(
+          [](mojo::Remote<mojom::ElectronRenderer>* ep,
+             base::OnceCallback<void(bool)> done) {
+            std::move(done).Run(true);
+          },
+          base::Owned(std::move(electron_renderer)), std::move(done)));
+}
+
+v8::Local<v8::Promise> WebContents::CaptureJavaScriptStack(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<base::Value::Dict> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  SampleRendererStack(base::BindOnce(
+      [](gin_helper::Promise<base::Value::Dict> promise,
+         absl::optional<base::Value::Dict> details) {
+        if (details)
+          promise.Resolve(std::move(*details));
+        else
+          promise.RejectWithErrorMessage("The page has no live renderer");
+      },
+      std::move(promise)));
+  return handle;
+}
+
+void WebContents::SetUnresponsiveDiagnostics(bool enabled) {
+  unresponsive_diagnostics_ = enabled;
+}
+
+void WebContents::SampleRendererStack(
+    base::OnceCallback<void(absl::optional<base::Value::Dict>)> done) {
+  // How long the renderer waits for JavaScript to run, and for how long the
+  // CPU time is measured at least.
+  constexpr base::TimeDelta kStackTimeout = base::Seconds(1);
+  constexpr base::TimeDelta kMinSampleDuration = base::Milliseconds(500);
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    std::move(done).Run(absl::nullopt);
+    return;
+  }
+
+  // Bound to the process rather than the frame, as the frame's interfaces
+  // are handled on the main thread which is the one being sampled.
+  auto diagnostics =
+      std::make_unique<mojo::Remote<mojom::ElectronRendererDiagnostics>>();
+  frame_host->GetProcess()->BindReceiver(
+      diagnostics->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = diagnostics.get();
+  (*raw_ptr)->CaptureJavaScriptStack(
+      kStackTimeout, kMinSampleDuration,
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](mojo::Remote<mojom::ElectronRendererDiagnostics>* remote,
+                 base::OnceCallback<void(absl::optional<base::Value::Dict>)>
+                     done,
+                 mojom::JavaScriptStackSamplePtr sample) {
+                if (!sample) {
+                  std::move(done).Run(absl::nullopt);
+                  return;
+                }
+                base::Value::Dict details;
+                details.Set("jsStack", std::move(sample->stack));
+                details.Set("cpuTime", sample->cpu_time.InMillisecondsF());
+                details.Set("sampleDuration",
+                            sample->duration.InMillisecondsF());
+                std::move(done).Run(std::move(details));
+              },
+              base::Owned(std::move(diagnostics)), std::move(done)),
+          nullptr));
+}
+
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
     v8::Isolate* isolate,
-    const base::FilePath& file_path) {
+    const base::FilePath& file_path,
+    gin::Arguments* args) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  gin_helper::Dictionary options;
+  std::string compression = "none";
+  bool graph_only = false;
+  if (args->GetNext(&options)) {
+    options.Get("compression", &compression);
+    options.Get("graphOnly", &graph_only);
+  }
+  if (compression != "none" && compression != "gzip") {
+    promise.RejectWithErrorMessage("Invalid compression: " + compression);
+    return handle;
+  }
+
   ScopedAllowBlockingForElectron allow_blocking;
   uint32_t flags = base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE;
   // The snapshot file is passed to an untrusted process.
@@ -3746,8 +4728,21 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   frame_host->GetRemoteInterfaces()->GetInterface(
       electron_renderer->BindNewPipeAndPassReceiver());
   auto* raw_ptr = electron_renderer.get();
+  using ProgressEmitter =
+      HeapSnapshotProgressEmitter<mojom::HeapSnapshotProgress>;
+  mojo::PendingRemote<mojom::HeapSnapshotProgress> progress;
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<ProgressEmitter>(base::BindRepeating(
+          [](base::WeakPtr<WebContents> web_contents,
+             base::Value::Dict details) {
+            if (web_contents)
+              web_contents->Emit("heap-snapshot-progress", details);
+          },
+          GetWeakPtr())),
+      progress.InitWithNewPipeAndPassReceiver());
   (*raw_ptr)->TakeHeapSnapshot(
       mojo::WrapPlatformFile(base::ScopedPlatformFile(file.TakePlatformFile())),
+      compression == "gzip", graph_only, std::move(progress),
       base::BindOnce(
           [](mojo::Remote<mojom::ElectronRenderer>* ep,
              gin_helper::Promise<void> promise, bool success) {
@@ -4159,14 +5154,8 @@ void WebContents::UpdateHtmlApiFullscreen(bool fullscreen) {
 // static
 void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                                      v8::Local<v8::ObjectTemplate> templ) {
-  gin::InvokerOptions options;
-  options.holder_is_first_argument = true;
-  options.holder_type = "WebContents";
-  templ->Set(
-      gin::StringToSymbol(isolate, "isDestroyed"),
-      gin::CreateFunctionTemplate(
-          isolate, base::BindRepeating(&gin_helper::Destroyable::IsDestroyed),
-          options));
+  templ->Set(gin::StringToSymbol(isolate, "isDestroyed"),
+             gin_helper::Destroyable::GetIsDestroyedTemplate(isolate));
   // We use gin_helper::ObjectTemplateBuilder instead of
   // gin::ObjectTemplateBuilder here to handle the fact that WebContents is
   // destroyable.
@@ -4179,6 +5168,11 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::SetBackgroundThrottling)
       .SetMethod("getProcessId", &WebContents::GetProcessID)
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
+      .SetMethod("getIPCMetrics", &WebContents::GetIPCMetrics)
+      .SetMethod("clearIPCMetrics", &WebContents::ClearIPCMetrics)
+      .SetMethod("getFastPathedNavigationCount",
+                 &WebContents::GetFastPathedNavigationCount)
+      .SetMethod("getDirectIPCChannels", &WebContents::GetDirectIPCChannels)
       .SetMethod("equal", &WebContents::Equal)
       .SetMethod("_loadURL", &WebContents::LoadURL)
       .SetMethod("reload", &WebContents::Reload)
@@ -4186,7 +5180,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("downloadURL", &WebContents::DownloadURL)
       .SetMethod("getURL", &WebContents::GetURL)
       .SetMethod("getTitle", &WebContents::GetTitle)
-      .SetMethod("isLoading", &WebContents::IsLoading)
+      .SetFastMethod<&WebContents::IsLoading>("isLoading")
       .SetMethod("isLoadingMainFrame", &WebContents::IsLoadingMainFrame)
       .SetMethod("isWaitingForResponse", &WebContents::IsWaitingForResponse)
       .SetMethod("stop", &WebContents::Stop)
@@ -4201,7 +5195,11 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getActiveIndex", &WebContents::GetActiveIndex)
       .SetMethod("clearHistory", &WebContents::ClearHistory)
       .SetMethod("length", &WebContents::GetHistoryLength)
-      .SetMethod("isCrashed", &WebContents::IsCrashed)
+      .SetFastMethod<&WebContents::IsCrashed>("isCrashed")
+      .SetMethod("freeze", &WebContents::Freeze)
+      .SetMethod("resume", &WebContents::Resume)
+      .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("getLifecycleState", &WebContents::lifecycle_state)
       .SetMethod("forcefullyCrashRenderer",
                  &WebContents::ForcefullyCrashRenderer)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
@@ -4238,24 +5236,31 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("findInPage", &WebContents::FindInPage)
       .SetMethod("stopFindInPage", &WebContents::StopFindInPage)
       .SetMethod("focus", &WebContents::Focus)
-      .SetMethod("isFocused", &WebContents::IsFocused)
+      .SetFastMethod<&WebContents::IsFocused>("isFocused")
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("startRecording", &WebContents::StartRecording)
+      .SetMethod("stopRecording", &WebContents::StopRecording)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
       .SetMethod("detachFromOuterFrame", &WebContents::DetachFromOuterFrame)
+      .SetMethod("_setElementVisible", &WebContents::SetElementVisible)
       .SetMethod("isOffscreen", &WebContents::IsOffScreen)
       .SetMethod("startPainting", &WebContents::StartPainting)
       .SetMethod("stopPainting", &WebContents::StopPainting)
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("setAdaptiveFrameRate", &WebContents::SetAdaptiveFrameRate)
+      .SetMethod("sendExternalBeginFrame",
+                 &WebContents::SendExternalBeginFrame)
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
-      .SetMethod("getZoomLevel", &WebContents::GetZoomLevel)
+      .SetFastMethod<&WebContents::GetZoomLevel>("getZoomLevel")
       .SetMethod("setZoomFactor", &WebContents::SetZoomFactor)
-      .SetMethod("getZoomFactor", &WebContents::GetZoomFactor)
+      .SetFastMethod<&WebContents::GetZoomFactor>("getZoomFactor")
       .SetMethod("getType", &WebContents::GetType)
       .SetMethod("_getPreloadPaths", &WebContents::GetPreloadPaths)
       .SetMethod("getLastWebPreferences", &WebContents::GetLastWebPreferences)
@@ -4277,6 +5282,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("captureEncodedPage", &WebContents::CaptureEncodedPage)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -4287,6 +5293,10 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getWebRTCIPHandlingPolicy",
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("reduceMemory", &WebContents::ReduceMemory)
+      .SetMethod("captureJavaScriptStack", &WebContents::CaptureJavaScriptStack)
+      .SetMethod("setUnresponsiveDiagnostics",
+                 &WebContents::SetUnresponsiveDiagnostics)
       .SetMethod("setImageAnimationPolicy",
                  &WebContents::SetImageAnimationPolicy)
       .SetMethod("_getProcessMemoryInfo", &WebContents::GetProcessMemoryInfo)
@@ -4402,6 +5412,16 @@ WebContents* WebContents::FromID(int32_t id) {
   return GetAllWebContents().Lookup(id);
 }
 
+// static
+std::vector<WebContents*> WebContents::GetAll() {
+  std::vector<WebContents*> list;
+  for (auto iter = base::IDMap<WebContents*>::iterator(&GetAllWebContents());
+       !iter.IsAtEnd(); iter.Advance()) {
+    list.push_back(iter.GetCurrentValue());
+  }
+  return list;
+}
+
 // static
 gin::WrapperInfo WebContents::kWrapperInfo = {gin::kEmbedderNativeGin};
 
@@ -4448,6 +5468,45 @@ std::vector<gin::Handle<WebContents>> GetAllWebContentsAsV8(
   return list;
 }
 
+void SetIPCChannelPriority(gin_helper::ErrorThrower thrower,
+                           const std::string& channel,
+                           const std::string& priority) {
+  electron::IPCPriority value;
+  if (priority == "user-blocking") {
+    value = electron::IPCPriority::kUserBlocking;
+  } else if (priority == "default") {
+    value = electron::IPCPriority::kDefault;
+  } else if (priority == "background") {
+    value = electron::IPCPriority::kBackground;
+  } else {
+    thrower.ThrowTypeError(
+        "priority must be one of 'user-blocking', 'default' or 'background'");
+    return;
+  }
+  electron::IPCPriorityLanes::SetChannelPriority(channel, value);
+}
+
+// See lib/browser/preload-code-cache.ts.
+void SetPreloadCacheKey(const std::string& source,
+                        const std::string& cache_key) {
+  electron::PreloadScriptCache::GetInstance()->SetCacheKey(source, cache_key);
+}
+
+void SetPreloadCodeCache(const std::string& cache_key,
+                         v8::Local<v8::Value> cached_data) {
+  if (!cached_data->IsArrayBufferView())
+    return;
+  auto view = cached_data.As<v8::ArrayBufferView>();
+  const auto* data = static_cast<const uint8_t*>(view->Buffer()->Data()) +
+                     view->ByteOffset();
+  electron::PreloadScriptCache::GetInstance()->SetCodeCache(
+      cache_key, base::make_span(data, view->ByteLength()));
+}
+
+void SetSandboxProcessInfo(base::Value::Dict info) {
+  electron::PreloadScriptCache::GetInstance()->SetProcessInfo(std::move(info));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -4459,6 +5518,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("fromFrame", &WebContentsFromFrame);
   dict.SetMethod("fromDevToolsTargetId", &WebContentsFromDevToolsTargetID);
   dict.SetMethod("getAllWebContents", &GetAllWebContentsAsV8);
+  dict.SetMethod("setIPCChannelPriority", &SetIPCChannelPriority);
+  dict.SetMethod("setPreloadCacheKey", &SetPreloadCacheKey);
+  dict.SetMethod("setPreloadCodeCache", &SetPreloadCodeCache);
+  dict.SetMethod("setSandboxProcessInfo", &SetSandboxProcessInfo);
 }
 
 }  // namespace
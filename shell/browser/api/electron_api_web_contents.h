@@ -17,12 +17,14 @@
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
 #include "chrome/browser/devtools/devtools_eye_dropper.h"
 #include "chrome/browser/devtools/devtools_file_system_indexer.h"
 #include "chrome/browser/ui/exclusive_access/exclusive_access_context.h"  // nogncheck
 #include "chrome/browser/ui/exclusive_access/exclusive_access_manager.h"
 #include "content/common/frame.mojom.h"
 #include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/global_routing_id.h"
 #include "content/public/browser/keyboard_event_processing_result.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/web_contents.h"
@@ -32,12 +34,17 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "printing/buildflags/buildflags.h"
+#include "shell/browser/api/frame_recorder.h"
 #include "shell/browser/api/frame_subscriber.h"
+#include "shell/browser/api/input_event_replay.h"
 #include "shell/browser/api/save_page_handler.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/extended_web_contents_observer.h"
+#include "shell/browser/ipc_channel_metrics.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/ui/inspectable_web_contents_delegate.h"
 #include "shell/browser/ui/inspectable_web_contents_view_delegate.h"
@@ -79,6 +86,7 @@ namespace gin {
 class Arguments;
 }
 
+class SkBitmap;
 class SkRegion;
 
 namespace electron {
@@ -93,9 +101,12 @@ class WebDialogHelper;
 class NativeWindow;
 class OffScreenRenderWidgetHostView;
 class OffScreenWebContentsView;
+struct OffscreenSharedTexture;
 
 namespace api {
 
+class OffscreenCaptureGroup;
+
 // Wrapper around the content::WebContents.
 class WebContents : public ExclusiveAccessContext,
                     public gin::Wrappable<WebContents>,
@@ -118,6 +129,29 @@ class WebContents : public ExclusiveAccessContext,
     kOffScreen,       // Used for offscreen rendering
   };
 
+  // How offscreen rendering passes the frames to the app.
+  enum class PaintFormat {
+    kNativeImage,  // The whole frame in a NativeImage, in the paint event.
+    kBGRA,         // The dirty region in a buffer, in the paint-regions event.
+    kRGBA,
+    kI420,
+  };
+
+  // How captureEncodedPage encodes the captured image.
+  enum class CaptureFormat {
+    kPNG,
+    kJPEG,
+    kWebP,
+  };
+
+  // Set by freeze() and discard(), the page is active again once it's shown
+  // or navigated.
+  enum class LifecycleState {
+    kActive,
+    kFrozen,     // The page doesn't run tasks.
+    kDiscarded,  // The renderer was shut down, the page is reloaded.
+  };
+
   // Create a new WebContents and return the V8 wrapper of it.
   static gin::Handle<WebContents> New(v8::Isolate* isolate,
                                       const gin_helper::Dictionary& options);
@@ -134,6 +168,7 @@ class WebContents : public ExclusiveAccessContext,
   // if there is no associated wrapper.
   static WebContents* From(content::WebContents* web_contents);
   static WebContents* FromID(int32_t id);
+  static std::vector<WebContents*> GetAll();
 
   // Get the V8 wrapper of the |web_contents|, or create one if not existed.
   //
@@ -160,6 +195,12 @@ class WebContents : public ExclusiveAccessContext,
   void SetBackgroundThrottling(bool allowed);
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
+  v8::Local<v8::Value> GetIPCMetrics(v8::Isolate* isolate) const;
+  void ClearIPCMetrics();
+  uint64_t GetFastPathedNavigationCount() const {
+    return fast_pathed_navigation_count_;
+  }
+  v8::Local<v8::Value> GetDirectIPCChannels(v8::Isolate* isolate) const;
   Type GetType() const;
   bool Equal(const WebContents* web_contents) const;
   void LoadURL(const GURL& url, const gin_helper::Dictionary& options);
@@ -187,6 +228,18 @@ class WebContents : public ExclusiveAccessContext,
   void SetWebRTCIPHandlingPolicy(const std::string& webrtc_ip_handling_policy);
   std::string GetMediaSourceID(content::WebContents* request_web_contents);
   bool IsCrashed() const;
+  LifecycleState lifecycle_state() const { return lifecycle_state_; }
+  // Returns false if the page is visible.
+  bool Freeze();
+  void Resume();
+  // Returns false if the page is visible, or if its renderer can't be shut
+  // down because other pages use it.
+  bool Discard();
+  // Called when the V8 heap of the page's renderer nearly reached its limit,
+  // the sizes are in bytes.
+  void OnNearHeapLimit(uint64_t initial_heap_limit,
+                       uint64_t heap_limit,
+                       uint64_t used_heap_size);
   void ForcefullyCrashRenderer();
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent();
@@ -224,7 +277,10 @@ class WebContents : public ExclusiveAccessContext,
   void Print(gin::Arguments* args);
   // Print current page as PDF.
   v8::Local<v8::Promise> PrintToPDF(const base::Value& settings);
+  // Writes the PDF to |path| when it isn't empty, and resolves with an empty
+  // buffer instead of a copy of it.
   void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                    const base::FilePath& path,
                     print_to_pdf::PdfPrintResult print_result,
                     scoped_refptr<base::RefCountedMemory> data);
 #endif
@@ -262,11 +318,18 @@ class WebContents : public ExclusiveAccessContext,
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  // Converts the whole array before sending the events at their time.
+  v8::Local<v8::Promise> SendInputEvents(gin::Arguments* args);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(gin::Arguments* args);
   void EndFrameSubscription();
 
+  // Record the frames of the page into a video file.
+  v8::Local<v8::Promise> StartRecording(const base::FilePath& path,
+                                        gin::Arguments* args);
+  v8::Local<v8::Promise> StopRecording(v8::Isolate* isolate);
+
   // Dragging native items.
   void StartDrag(const gin_helper::Dictionary& item, gin::Arguments* args);
 
@@ -274,20 +337,37 @@ class WebContents : public ExclusiveAccessContext,
   // done.
   v8::Local<v8::Promise> CapturePage(gin::Arguments* args);
 
+  // Like CapturePage, but the image is encoded off the UI thread and resolved
+  // as a Buffer.
+  v8::Local<v8::Promise> CaptureEncodedPage(gin::Arguments* args);
+
   // Methods for creating <webview>.
   bool IsGuest() const;
   void AttachToIframe(content::WebContents* embedder_web_contents,
                       int embedder_frame_id);
   void DetachFromOuterFrame();
+  void SetElementVisible(bool visible);
 
   // Methods for offscreen rendering
   bool IsOffScreen() const;
   void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnTexturePaint(const gfx::Rect& dirty_rect,
+                      std::unique_ptr<OffscreenSharedTexture> texture);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void SetAdaptiveFrameRate(bool enabled, gin::Arguments* args);
+  void SendExternalBeginFrame();
+
+  // The group the offscreen frames are emitted by instead, if any.
+  OffscreenCaptureGroup* offscreen_capture_group() const {
+    return offscreen_capture_group_.get();
+  }
+  void SetOffscreenCaptureGroup(base::WeakPtr<OffscreenCaptureGroup> group) {
+    offscreen_capture_group_ = std::move(group);
+  }
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
 
@@ -314,6 +394,10 @@ class WebContents : public ExclusiveAccessContext,
   // Returns the preload script path of current WebContents.
   std::vector<base::FilePath> GetPreloadPaths() const;
 
+  // Sends the preloads of a sandboxed frame before |navigation_handle|
+  // commits, see PreloadScriptCache.
+  void SendSandboxPreloads(content::NavigationHandle* navigation_handle);
+
   // Returns the web preferences of current WebContents.
   v8::Local<v8::Value> GetLastWebPreferences(v8::Isolate* isolate) const;
 
@@ -324,8 +408,25 @@ class WebContents : public ExclusiveAccessContext,
   void NotifyUserActivation();
 
   v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
-                                          const base::FilePath& file_path);
+                                          const base::FilePath& file_path,
+                                          gin::Arguments* args);
   v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
+  v8::Local<v8::Promise> ReduceMemory(gin::Arguments* args);
+  // Asks the renderer of the page to release memory, see
+  // mojom::ElectronRenderer::ReduceMemory(). |done| is called with false if
+  // the page has no live renderer.
+  void ReduceRendererMemory(bool purge_caches,
+                            bool notify_v8,
+                            bool purge_partition_alloc,
+                            base::OnceCallback<void(bool)> done);
+  v8::Local<v8::Promise> CaptureJavaScriptStack(v8::Isolate* isolate);
+  void SetUnresponsiveDiagnostics(bool enabled);
+  // Samples the JavaScript stack of the main thread of the renderer of the
+  // page, see mojom::ElectronRendererDiagnostics. |done| is called with the
+  // details of the sample, or nothing if the page has no live renderer.
+  void SampleRendererStack(
+      base::OnceCallback<void(absl::optional<base::Value::Dict>)> done);
+  void OnUnresponsiveSample(absl::optional<base::Value::Dict> details);
 
   bool HandleContextMenu(content::RenderFrameHost& render_frame_host,
                          const content::ContextMenuParams& params) override;
@@ -353,6 +454,10 @@ class WebContents : public ExclusiveAccessContext,
   bool EmitNavigationEvent(const std::string& event,
                            content::NavigationHandle* navigation_handle);
 
+  // Whether ElectronNavigationThrottle has an event with listeners to emit
+  // for |navigation_handle|. The navigations which don't are counted.
+  bool NeedsNavigationThrottle(content::NavigationHandle* navigation_handle);
+
   // this.emit(name, new Event(sender, message), args...);
   template <typename... Args>
   bool EmitWithSender(base::StringPiece name,
@@ -407,11 +512,16 @@ class WebContents : public ExclusiveAccessContext,
     fullscreen_frame_ = rfh;
   }
 
+  IPCChannelMetrics& ipc_metrics() { return ipc_metrics_; }
+
   // mojom::ElectronApiIPC
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments,
+               blink::TransferableMessage arguments,
                content::RenderFrameHost* render_frame_host);
+  void MessageJSON(const std::string& channel,
+                   mojo_base::BigBuffer json,
+                   content::RenderFrameHost* render_frame_host);
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
@@ -432,10 +542,21 @@ class WebContents : public ExclusiveAccessContext,
   void MessageHost(const std::string& channel,
                    blink::CloneableMessage arguments,
                    content::RenderFrameHost* render_frame_host);
+  // Returns a channel from |render_frame_host| to the main frame of the
+  // WebContents specified by |web_contents_id|, or a null remote if there is
+  // no such WebContents.
+  mojo::PendingRemote<mojom::ElectronDirectIPC> OpenDirectChannel(
+      int32_t web_contents_id,
+      content::RenderFrameHost* render_frame_host);
 
   // mojom::ElectronWebContentsUtility
   void OnFirstNonEmptyLayout(content::RenderFrameHost* render_frame_host);
-  void UpdateDraggableRegions(std::vector<mojom::DraggableRegionPtr> regions);
+  // |regions| are all the regions of |render_frame_host|, only those from
+  // |start| changed since its last update.
+  void UpdateDraggableRegions(
+      content::RenderFrameHost* render_frame_host,
+      const std::vector<mojom::DraggableRegionPtr>& regions,
+      size_t start);
   void SetTemporaryZoomLevel(double level);
   void DoGetZoomLevel(
       electron::mojom::ElectronWebContentsUtility::DoGetZoomLevelCallback
@@ -472,6 +593,8 @@ class WebContents : public ExclusiveAccessContext,
   // Delete this if garbage collection has not started.
   void DeleteThisIfAlive();
 
+  void DispatchInputEvent(const InputEventReplay::Event& event);
+
   // Creates a InspectableWebContents object and takes ownership of
   // |web_contents|.
   void InitWithWebContents(std::unique_ptr<content::WebContents> web_contents,
@@ -596,6 +719,7 @@ class WebContents : public ExclusiveAccessContext,
   void RenderViewDeleted(content::RenderViewHost*) override;
   void PrimaryMainFrameRenderProcessGone(
       base::TerminationStatus status) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
   void DOMContentLoaded(content::RenderFrameHost* render_frame_host) override;
   void DidFinishLoad(content::RenderFrameHost* render_frame_host,
                      const GURL& validated_url) override;
@@ -604,6 +728,7 @@ class WebContents : public ExclusiveAccessContext,
                    int error_code) override;
   void DidStartLoading() override;
   void DidStopLoading() override;
+  void DidFirstVisuallyNonEmptyPaint() override;
   void DidStartNavigation(
       content::NavigationHandle* navigation_handle) override;
   void DidRedirectNavigation(
@@ -659,6 +784,12 @@ class WebContents : public ExclusiveAccessContext,
   void InitZoomController(content::WebContents* web_contents,
                           const gin_helper::Dictionary& options);
 
+  // Copies |rect| of the page, or the whole page when it is empty, runs
+  // |callback| with an empty bitmap when the page can not be captured.
+  void CopyPageFromSurface(const gfx::Rect& rect,
+                           const gin_helper::Dictionary& options,
+                           base::OnceCallback<void(const SkBitmap&)> callback);
+
   // content::WebContentsDelegate:
   bool CanOverscrollContent() override;
   std::unique_ptr<content::EyeDropper> OpenEyeDropper(
@@ -752,9 +883,17 @@ class WebContents : public ExclusiveAccessContext,
   v8::Global<v8::Value> devtools_web_contents_;
   v8::Global<v8::Value> debugger_;
 
+  IPCChannelMetrics ipc_metrics_;
+
+  // The navigations which didn't need ElectronNavigationThrottle.
+  uint64_t fast_pathed_navigation_count_ = 0;
+
   std::unique_ptr<ElectronJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  std::unique_ptr<FrameRecorder> frame_recorder_;
+  // Created by the first sendInputEvents().
+  std::unique_ptr<InputEventReplay> input_event_replay_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ScriptExecutor> script_executor_;
@@ -773,10 +912,32 @@ class WebContents : public ExclusiveAccessContext,
 
   // Request id used for findInPage request.
   uint32_t find_in_page_request_id_ = 0;
+  // Whether the latest findInPage request reports intermediate results.
+  bool find_in_page_incremental_ = false;
 
   // Whether background throttling is disabled.
   bool background_throttling_ = true;
 
+  // Set by setUnresponsiveDiagnostics(), the unresponsive event is emitted
+  // once the stack of the renderer is sampled, and the responsive event
+  // waits for it.
+  bool unresponsive_diagnostics_ = false;
+  bool sampling_unresponsive_ = false;
+  bool responsive_while_sampling_ = false;
+
+  LifecycleState lifecycle_state_ = LifecycleState::kActive;
+
+  // When the stages leading to the first paint of the page were reached,
+  // reported with the ready-to-show event.
+  struct ShowTimeline {
+    base::TimeTicks created = base::TimeTicks::Now();
+    base::TimeTicks renderer_ready;
+    base::TimeTicks navigation_start;
+    base::TimeTicks response_start;
+    base::TimeTicks navigation_commit;
+  };
+  ShowTimeline show_timeline_;
+
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
@@ -789,6 +950,10 @@ class WebContents : public ExclusiveAccessContext,
   base::WeakPtr<NativeWindow> owner_window_;
 
   bool offscreen_ = false;
+  bool offscreen_use_shared_texture_ = false;
+  bool offscreen_use_external_begin_frame_ = false;
+  PaintFormat offscreen_paint_format_ = PaintFormat::kNativeImage;
+  base::WeakPtr<OffscreenCaptureGroup> offscreen_capture_group_;
 
   // Whether window is fullscreened by HTML5 api.
   bool html_fullscreen_ = false;
@@ -829,14 +994,16 @@ class WebContents : public ExclusiveAccessContext,
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_ =
       base::ThreadPool::CreateSequencedTaskRunner({base::MayBlock()});
 
-#if BUILDFLAG(ENABLE_PRINTING)
-  const scoped_refptr<base::TaskRunner> print_task_runner_;
-#endif
-
   // Stores the frame thats currently in fullscreen, nullptr if there is none.
   raw_ptr<content::RenderFrameHost> fullscreen_frame_ = nullptr;
 
   std::unique_ptr<SkRegion> draggable_region_;
+  // The region of the first |draggable_region_prefix_size_| regions of the
+  // frame which last sent its regions, which the updates that only change
+  // the regions after them build upon.
+  content::GlobalRenderFrameHostId draggable_region_frame_id_;
+  SkRegion draggable_region_prefix_;
+  size_t draggable_region_prefix_size_ = 0;
 
   bool force_non_draggable_ = false;
 
@@ -9,15 +9,20 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
 #include "base/no_destructor.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"  // nogncheck
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/common/isolated_world_ids.h"
 #include "electron/shell/common/api/api.mojom.h"
+#include "gin/data_object_builder.h"
 #include "gin/object_template_builder.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/api/shared_ring_buffer_writer.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -29,6 +34,7 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/shared_ring_buffer.h"
 #include "shell/common/v8_value_serializer.h"
 
 namespace gin {
@@ -58,7 +64,13 @@ namespace electron::api {
 typedef std::unordered_map<int, WebFrameMain*> WebFrameMainIdMap;
 
 WebFrameMainIdMap& GetWebFrameMainMap() {
-  static base::NoDestructor<WebFrameMainIdMap> instance;
+  static base::NoDestructor<WebFrameMainIdMap> instance([] {
+    // Pages with hundreds of iframes create as many wrappers, sizing the map
+    // up front avoids rehashing it while they are created.
+    WebFrameMainIdMap map;
+    map.reserve(256);
+    return map;
+  }());
   return *instance;
 }
 
@@ -164,6 +176,53 @@ v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScript(
   return handle;
 }
 
+v8::Local<v8::Promise> WebFrameMain::ExecuteJavaScriptInFrames(
+    v8::Isolate* isolate,
+    const std::u16string& code,
+    const std::vector<int32_t>& routing_ids,
+    bool user_gesture) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (render_frame_disposed_) {
+    promise.RejectWithErrorMessage(
+        "Render frame was disposed before WebFrameMain could be accessed");
+    return handle;
+  }
+
+  // The reply is dropped if the renderer goes away before sending it.
+  GetRendererApi()->ExecuteJavaScriptInFrames(
+      code, routing_ids, user_gesture,
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+                 size_t frame_count,
+                 std::vector<mojom::FrameScriptResultPtr> results) {
+                if (results.size() != frame_count) {
+                  promise.RejectWithErrorMessage(
+                      "Render frame was disposed before the script could run");
+                  return;
+                }
+                v8::Isolate* isolate = promise.isolate();
+                v8::HandleScope scope(isolate);
+                v8::Context::Scope context_scope(promise.GetContext());
+                std::vector<v8::Local<v8::Value>> values;
+                values.reserve(results.size());
+                for (const auto& result : results) {
+                  values.push_back(
+                      gin::DataObjectBuilder(isolate)
+                          .Set(result->success ? "result" : "error",
+                               result->value)
+                          .Build());
+                }
+                promise.Resolve(gin::ConvertToV8(isolate, values));
+              },
+              std::move(promise), routing_ids.size()),
+          std::vector<mojom::FrameScriptResultPtr>()));
+
+  return handle;
+}
+
 bool WebFrameMain::Reload() {
   if (!CheckRenderFrame())
     return false;
@@ -175,7 +234,7 @@ void WebFrameMain::Send(v8::Isolate* isolate,
                         const std::string& channel,
                         v8::Local<v8::Value> args) {
   blink::CloneableMessage message;
-  if (!gin::ConvertFromV8(isolate, args, &message)) {
+  if (!electron::SerializeV8Arguments(isolate, args, &message)) {
     isolate->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate, "Failed to serialize arguments")));
     return;
@@ -260,6 +319,31 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
                                        std::move(transferable_message));
 }
 
+v8::Local<v8::Value> WebFrameMain::CreateRingBuffer(
+    gin::Arguments* args,
+    const std::string& channel) {
+  gin_helper::Dictionary options;
+  size_t capacity = 1024 * 1024;
+  args->GetNext(&options) && options.Get("capacity", &capacity);
+
+  if (!CheckRenderFrame())
+    return v8::Null(args->isolate());
+
+  base::UnsafeSharedMemoryRegion region;
+  auto buffer = SharedRingBuffer::Create(capacity, &region);
+  if (!buffer) {
+    args->ThrowError("Failed to allocate the ring buffer");
+    return v8::Null(args->isolate());
+  }
+
+  mojo::PendingRemote<mojom::ElectronRingBufferReader> reader;
+  GetRendererApi()->ReceiveRingBuffer(channel, std::move(region),
+                                      reader.InitWithNewPipeAndPassReceiver());
+  return SharedRingBufferWriter::Create(args->isolate(), std::move(buffer),
+                                        std::move(reader))
+      .ToV8();
+}
+
 int WebFrameMain::FrameTreeNodeID() const {
   return frame_tree_node_id_;
 }
@@ -325,10 +409,14 @@ std::vector<content::RenderFrameHost*> WebFrameMain::Frames() const {
   if (!CheckRenderFrame())
     return frame_hosts;
 
-  render_frame_->ForEachRenderFrameHost(
+  // Only the children are needed, not their subtrees.
+  render_frame_->ForEachRenderFrameHostWithAction(
       [&frame_hosts, this](content::RenderFrameHost* rfh) {
+        if (rfh == render_frame_)
+          return content::RenderFrameHost::FrameIterationAction::kContinue;
         if (rfh->GetParent() == render_frame_)
           frame_hosts.push_back(rfh);
+        return content::RenderFrameHost::FrameIterationAction::kSkipChildren;
       });
 
   return frame_hosts;
@@ -347,6 +435,64 @@ std::vector<content::RenderFrameHost*> WebFrameMain::FramesInSubtree() const {
   return frame_hosts;
 }
 
+v8::Local<v8::Value> WebFrameMain::GetFrameTree(v8::Isolate* isolate) const {
+  if (!CheckRenderFrame())
+    return v8::Null(isolate);
+  const std::vector<content::RenderFrameHost*> frame_hosts = FramesInSubtree();
+  const size_t count = frame_hosts.size();
+
+  base::flat_map<content::RenderFrameHost*, int32_t> indices;
+  indices.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    indices.emplace(frame_hosts[i], static_cast<int32_t>(i));
+
+  auto new_column = [isolate, count](int32_t** data) {
+    v8::Local<v8::ArrayBuffer> buffer =
+        v8::ArrayBuffer::New(isolate, count * sizeof(int32_t));
+    *data = static_cast<int32_t*>(buffer->Data());
+    return v8::Int32Array::New(buffer, 0, count);
+  };
+  int32_t* frame_tree_node_ids;
+  int32_t* process_ids;
+  int32_t* routing_ids;
+  int32_t* parent_indices;
+  v8::Local<v8::Int32Array> frame_tree_node_id_column =
+      new_column(&frame_tree_node_ids);
+  v8::Local<v8::Int32Array> process_id_column = new_column(&process_ids);
+  v8::Local<v8::Int32Array> routing_id_column = new_column(&routing_ids);
+  v8::Local<v8::Int32Array> parent_index_column = new_column(&parent_indices);
+  std::vector<v8::Local<v8::Value>> urls;
+  std::vector<v8::Local<v8::Value>> origins;
+  std::vector<v8::Local<v8::Value>> names;
+  urls.reserve(count);
+  origins.reserve(count);
+  names.reserve(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    content::RenderFrameHost* rfh = frame_hosts[i];
+    frame_tree_node_ids[i] = rfh->GetFrameTreeNodeId();
+    process_ids[i] = rfh->GetProcess()->GetID();
+    routing_ids[i] = rfh->GetRoutingID();
+    // -1 for |this| frame and for the roots of inner frame trees.
+    auto parent = indices.find(rfh->GetParent());
+    parent_indices[i] = parent != indices.end() ? parent->second : -1;
+    urls.push_back(gin::ConvertToV8(isolate, rfh->GetLastCommittedURL()));
+    origins.push_back(gin::StringToV8(
+        isolate, rfh->GetLastCommittedOrigin().Serialize()));
+    names.push_back(gin::StringToV8(isolate, rfh->GetFrameName()));
+  }
+
+  return gin::DataObjectBuilder(isolate)
+      .Set("frameTreeNodeId", frame_tree_node_id_column)
+      .Set("processId", process_id_column)
+      .Set("routingId", routing_id_column)
+      .Set("parentIndex", parent_index_column)
+      .Set("url", v8::Array::New(isolate, urls.data(), count))
+      .Set("origin", v8::Array::New(isolate, origins.data(), count))
+      .Set("name", v8::Array::New(isolate, names.data(), count))
+      .Build();
+}
+
 void WebFrameMain::DOMContentLoaded() {
   Emit("dom-ready");
 }
@@ -390,9 +536,13 @@ void WebFrameMain::FillObjectTemplate(v8::Isolate* isolate,
                                       v8::Local<v8::ObjectTemplate> templ) {
   gin_helper::ObjectTemplateBuilder(isolate, templ)
       .SetMethod("executeJavaScript", &WebFrameMain::ExecuteJavaScript)
+      .SetMethod("_executeJavaScriptInFrames",
+                 &WebFrameMain::ExecuteJavaScriptInFrames)
       .SetMethod("reload", &WebFrameMain::Reload)
       .SetMethod("_send", &WebFrameMain::Send)
       .SetMethod("_postMessage", &WebFrameMain::PostMessage)
+      .SetMethod("createRingBuffer", &WebFrameMain::CreateRingBuffer)
+      .SetMethod("getFrameTree", &WebFrameMain::GetFrameTree)
       .SetProperty("frameTreeNodeId", &WebFrameMain::FrameTreeNodeID)
       .SetProperty("name", &WebFrameMain::Name)
       .SetProperty("osProcessId", &WebFrameMain::OSProcessID)
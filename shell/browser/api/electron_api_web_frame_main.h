@@ -92,6 +92,13 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
 
   v8::Local<v8::Promise> ExecuteJavaScript(gin::Arguments* args,
                                            const std::u16string& code);
+  // Runs |code| in each of the frames specified by |routing_ids|, which must
+  // all be in the renderer process of this frame, with a single request.
+  v8::Local<v8::Promise> ExecuteJavaScriptInFrames(
+      v8::Isolate* isolate,
+      const std::u16string& code,
+      const std::vector<int32_t>& routing_ids,
+      bool user_gesture);
   bool Reload();
   void Send(v8::Isolate* isolate,
             bool internal,
@@ -101,6 +108,8 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
                    const std::string& channel,
                    v8::Local<v8::Value> message_value,
                    absl::optional<v8::Local<v8::Value>> transfer);
+  v8::Local<v8::Value> CreateRingBuffer(gin::Arguments* args,
+                                        const std::string& channel);
 
   int FrameTreeNodeID() const;
   std::string Name() const;
@@ -115,6 +124,9 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   content::RenderFrameHost* Parent() const;
   std::vector<content::RenderFrameHost*> Frames() const;
   std::vector<content::RenderFrameHost*> FramesInSubtree() const;
+  // The frames of FramesInSubtree() as one object of arrays, without creating
+  // a wrapper for each of them.
+  v8::Local<v8::Value> GetFrameTree(v8::Isolate* isolate) const;
 
   void DOMContentLoaded();
 
@@ -11,14 +11,19 @@
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/ranges/algorithm.h"
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
 #include "gin/dictionary.h"
+#include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "net/http/http_content_disposition.h"
+#include "net/http/http_util.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
@@ -31,6 +36,9 @@
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/record.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/abseil-cpp/absl/types/variant.h"
 
 static constexpr auto ResourceTypes =
     base::MakeFixedFlatMapSorted<base::StringPiece,
@@ -67,16 +75,62 @@ struct Converter<extensions::WebRequestResourceType> {
 
 namespace electron::api {
 
+// The response headers of a request as passed to listeners. The events of a
+// request usually carry the same headers, which are then only converted once.
+class ConvertedResponseHeaders
+    : public base::RefCounted<ConvertedResponseHeaders> {
+ public:
+  explicit ConvertedResponseHeaders(
+      scoped_refptr<net::HttpResponseHeaders> headers);
+
+  // disable copy
+  ConvertedResponseHeaders(const ConvertedResponseHeaders&) = delete;
+  ConvertedResponseHeaders& operator=(const ConvertedResponseHeaders&) =
+      delete;
+
+  const net::HttpResponseHeaders* headers() const { return headers_.get(); }
+
+  const base::Value::Dict& GetDict();
+
+ private:
+  friend class base::RefCounted<ConvertedResponseHeaders>;
+  ~ConvertedResponseHeaders();
+
+  scoped_refptr<net::HttpResponseHeaders> headers_;
+  absl::optional<base::Value::Dict> dict_;
+};
+
 namespace {
 
 const char kUserDataKey[] = "WebRequest";
 
+// The fields that the details of every event have.
+gin_helper::RecordTemplate kDetailsTemplate(
+    {"id", "url", "method", "timestamp", "resourceType"});
+
 // BrowserContext <=> WebRequest relationship.
 struct UserData : public base::SupportsUserData::Data {
   explicit UserData(WebRequest* data) : data(data) {}
   raw_ptr<WebRequest> data;
 };
 
+constexpr auto kRuleActions =
+    base::MakeFixedFlatMapSorted<base::StringPiece, WebRequestRule::Action>({
+        {"allow", WebRequestRule::Action::kAllow},
+        {"block", WebRequestRule::Action::kBlock},
+        {"modifyHeaders", WebRequestRule::Action::kModifyHeaders},
+        {"redirect", WebRequestRule::Action::kRedirect},
+        {"upgradeScheme", WebRequestRule::Action::kUpgradeScheme},
+    });
+
+constexpr auto kHeaderOperationTypes =
+    base::MakeFixedFlatMapSorted<base::StringPiece,
+                                 WebRequestRule::HeaderOperation::Type>({
+        {"append", WebRequestRule::HeaderOperation::Type::kAppend},
+        {"remove", WebRequestRule::HeaderOperation::Type::kRemove},
+        {"set", WebRequestRule::HeaderOperation::Type::kSet},
+    });
+
 extensions::WebRequestResourceType ParseResourceType(base::StringPiece value) {
   if (const auto* iter = ResourceTypes.find(value); iter != ResourceTypes.end())
     return iter->second;
@@ -84,13 +138,138 @@ extensions::WebRequestResourceType ParseResourceType(base::StringPiece value) {
   return extensions::WebRequestResourceType::OTHER;
 }
 
-// Convert HttpResponseHeaders to V8.
+bool ParseURLPatterns(const std::set<std::string>& filter_patterns,
+                      std::set<URLPattern>* url_patterns,
+                      std::string* error) {
+  for (const std::string& filter_pattern : filter_patterns) {
+    URLPattern pattern(URLPattern::SCHEME_ALL);
+    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      *error = "Invalid url pattern " + filter_pattern + ": " +
+               URLPattern::GetParseResultString(result);
+      return false;
+    }
+    url_patterns->emplace(std::move(pattern));
+  }
+  return true;
+}
+
+bool ParseResourceTypes(const std::set<std::string>& filter_types,
+                        std::set<extensions::WebRequestResourceType>* types,
+                        std::string* error) {
+  for (const std::string& filter_type : filter_types) {
+    auto type = ParseResourceType(filter_type);
+    if (type == extensions::WebRequestResourceType::OTHER) {
+      *error = "Invalid type " + filter_type;
+      return false;
+    }
+    types->insert(type);
+  }
+  return true;
+}
+
+// [{ header, operation, value }].
+bool ParseHeaderOperations(gin::Dictionary* action,
+                           const char* key,
+                           WebRequestRule::HeaderOperations* operations,
+                           std::string* error) {
+  std::vector<gin_helper::Dictionary> values;
+  if (!action->Get(key, &values))
+    return true;
+  for (const gin_helper::Dictionary& value : values) {
+    WebRequestRule::HeaderOperation operation;
+    std::string type;
+    value.Get("operation", &type);
+    if (const auto* iter = kHeaderOperationTypes.find(type);
+        iter != kHeaderOperationTypes.end()) {
+      operation.type = iter->second;
+    } else {
+      *error = "Invalid header operation '" + type + "'";
+      return false;
+    }
+    if (!value.Get("header", &operation.name) ||
+        !net::HttpUtil::IsValidHeaderName(operation.name)) {
+      *error = "Invalid header name '" + operation.name + "'";
+      return false;
+    }
+    operation.name = base::ToLowerASCII(operation.name);
+    if (operation.type != WebRequestRule::HeaderOperation::Type::kRemove &&
+        (!value.Get("value", &operation.value) ||
+         !net::HttpUtil::IsValidHeaderValue(operation.value))) {
+      *error = "Invalid value for header '" + operation.name + "'";
+      return false;
+    }
+    operations->push_back(std::move(operation));
+  }
+  return true;
+}
+
+// { id, priority, condition: { urls, types }, action: { type, ... } }.
+bool ParseRule(v8::Isolate* isolate,
+               v8::Local<v8::Value> value,
+               WebRequestRule* rule,
+               std::string* error) {
+  gin::Dictionary dict(isolate);
+  gin::Dictionary action(isolate);
+  if (!gin::ConvertFromV8(isolate, value, &dict) ||
+      !dict.Get("action", &action)) {
+    *error = "Rule must have property 'action'.";
+    return false;
+  }
+  dict.Get("id", &rule->id);
+  dict.Get("priority", &rule->priority);
+
+  gin::Dictionary condition(isolate);
+  if (dict.Get("condition", &condition)) {
+    std::set<std::string> filter_patterns, filter_types;
+    condition.Get("urls", &filter_patterns);
+    condition.Get("types", &filter_types);
+    std::set<URLPattern> url_patterns;
+    if (!ParseURLPatterns(filter_patterns, &url_patterns, error) ||
+        !ParseResourceTypes(filter_types, &rule->types, error)) {
+      return false;
+    }
+    rule->url_matcher = URLPatternMatcher(url_patterns);
+  }
+
+  std::string type;
+  action.Get("type", &type);
+  if (const auto* iter = kRuleActions.find(type); iter != kRuleActions.end()) {
+    rule->action = iter->second;
+  } else {
+    *error = "Invalid rule action '" + type + "'";
+    return false;
+  }
+
+  switch (rule->action) {
+    case WebRequestRule::Action::kRedirect:
+      if (!action.Get("redirectURL", &rule->redirect_url) ||
+          !rule->redirect_url.is_valid()) {
+        *error = "Redirect rule must have a valid 'redirectURL'.";
+        return false;
+      }
+      break;
+    case WebRequestRule::Action::kModifyHeaders:
+      if (!ParseHeaderOperations(&action, "requestHeaders",
+                                 &rule->request_headers, error) ||
+          !ParseHeaderOperations(&action, "responseHeaders",
+                                 &rule->response_headers, error)) {
+        return false;
+      }
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+// Convert HttpResponseHeaders to a dictionary of lists.
 //
 // Note that while we already have converters for HttpResponseHeaders, we can
 // not use it because it lowercases the header keys, while the webRequest has
 // to pass the original keys.
-v8::Local<v8::Value> HttpResponseHeadersToV8(
-    net::HttpResponseHeaders* headers) {
+base::Value::Dict HttpResponseHeadersToDict(
+    const net::HttpResponseHeaders* headers) {
   base::Value::Dict response_headers;
   if (headers) {
     size_t iter = 0;
@@ -119,8 +298,74 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
       values->Append(base::Value(value));
     }
   }
-  return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
-}
+  return response_headers;
+}
+
+// A property of |details| which is only converted to V8 when a listener reads
+// it, so that listeners which don't read it never pay for the conversion.
+class LazyDetailsProperty : public gin::Wrappable<LazyDetailsProperty> {
+ public:
+  using Value =
+      absl::variant<net::HttpRequestHeaders,
+                    scoped_refptr<network::ResourceRequestBody>,
+                    scoped_refptr<ConvertedResponseHeaders>>;
+
+  static gin::WrapperInfo kWrapperInfo;
+
+  static void Define(gin_helper::Dictionary* details,
+                     base::StringPiece key,
+                     Value value) {
+    v8::Isolate* isolate = details->isolate();
+    gin::Handle<LazyDetailsProperty> property = gin::CreateHandle(
+        isolate, new LazyDetailsProperty(std::move(value)));
+    // Becomes a plain data property once it was read.
+    details->GetHandle()
+        ->SetLazyDataProperty(isolate->GetCurrentContext(),
+                              gin::StringToSymbol(isolate, key),
+                              &LazyDetailsProperty::Get, property.ToV8())
+        .Check();
+  }
+
+  // disable copy
+  LazyDetailsProperty(const LazyDetailsProperty&) = delete;
+  LazyDetailsProperty& operator=(const LazyDetailsProperty&) = delete;
+
+ private:
+  explicit LazyDetailsProperty(Value value) : value_(std::move(value)) {}
+  ~LazyDetailsProperty() override = default;
+
+  static void Get(v8::Local<v8::Name> name,
+                  const v8::PropertyCallbackInfo<v8::Value>& info) {
+    v8::Isolate* isolate = info.GetIsolate();
+    LazyDetailsProperty* property = nullptr;
+    if (!gin::ConvertFromV8(isolate, info.Data(), &property))
+      return;
+    info.GetReturnValue().Set(absl::visit(
+        [isolate](const auto& value) { return ToV8(isolate, value); },
+        property->value_));
+  }
+
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const net::HttpRequestHeaders& headers) {
+    return gin::ConvertToV8(isolate, headers);
+  }
+
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const scoped_refptr<network::ResourceRequestBody>& body) {
+    return gin::ConvertToV8(isolate, *body);
+  }
+
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const scoped_refptr<ConvertedResponseHeaders>& headers) {
+    return gin::ConvertToV8(isolate, headers->GetDict());
+  }
+
+  const Value value_;
+};
+
+gin::WrapperInfo LazyDetailsProperty::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 // Overloaded by multiple types to fill the |details| object.
 void ToDictionary(gin_helper::Dictionary* details,
@@ -136,8 +381,6 @@ void ToDictionary(gin_helper::Dictionary* details,
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
   }
 
   auto* render_frame_host = content::RenderFrameHost::FromID(
@@ -158,12 +401,12 @@ void ToDictionary(gin_helper::Dictionary* details,
                   const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
   if (request.request_body)
-    details->Set("uploadData", *request.request_body);
+    LazyDetailsProperty::Define(details, "uploadData", request.request_body);
 }
 
 void ToDictionary(gin_helper::Dictionary* details,
                   const net::HttpRequestHeaders& headers) {
-  details->Set("requestHeaders", headers);
+  LazyDetailsProperty::Define(details, "requestHeaders", headers);
 }
 
 void ToDictionary(gin_helper::Dictionary* details, const GURL& location) {
@@ -221,34 +464,30 @@ void ReadFromResponse(v8::Isolate* isolate,
 
 }  // namespace
 
+ConvertedResponseHeaders::ConvertedResponseHeaders(
+    scoped_refptr<net::HttpResponseHeaders> headers)
+    : headers_(std::move(headers)) {}
+
+ConvertedResponseHeaders::~ConvertedResponseHeaders() = default;
+
+const base::Value::Dict& ConvertedResponseHeaders::GetDict() {
+  if (!dict_)
+    dict_ = HttpResponseHeadersToDict(headers_.get());
+  return *dict_;
+}
+
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 WebRequest::RequestFilter::RequestFilter(
-    std::set<URLPattern> url_patterns,
+    const std::set<URLPattern>& url_patterns,
     std::set<extensions::WebRequestResourceType> types)
-    : url_patterns_(std::move(url_patterns)), types_(std::move(types)) {}
+    : url_matcher_(url_patterns), types_(std::move(types)) {}
 WebRequest::RequestFilter::RequestFilter(const RequestFilter&) = default;
 WebRequest::RequestFilter::RequestFilter() = default;
 WebRequest::RequestFilter::~RequestFilter() = default;
 
-void WebRequest::RequestFilter::AddUrlPattern(URLPattern pattern) {
-  url_patterns_.emplace(std::move(pattern));
-}
-
-void WebRequest::RequestFilter::AddType(
-    extensions::WebRequestResourceType type) {
-  types_.insert(type);
-}
-
 bool WebRequest::RequestFilter::MatchesURL(const GURL& url) const {
-  if (url_patterns_.empty())
-    return true;
-
-  for (const auto& pattern : url_patterns_) {
-    if (pattern.MatchesURL(url))
-      return true;
-  }
-  return false;
+  return url_matcher_.empty() || url_matcher_.MatchesURL(url);
 }
 
 bool WebRequest::RequestFilter::MatchesType(
@@ -261,6 +500,13 @@ bool WebRequest::RequestFilter::MatchesRequest(
   return MatchesURL(info->url) && MatchesType(info->web_request_type);
 }
 
+bool WebRequest::RequestFilter::MayMatchRequest(
+    const GURL& url,
+    extensions::WebRequestResourceType type,
+    bool may_redirect) const {
+  return (may_redirect || MatchesURL(url)) && MatchesType(type);
+}
+
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(RequestFilter filter_,
                                                    SimpleListener listener_)
     : filter(std::move(filter_)), listener(listener_) {}
@@ -306,7 +552,11 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<SimpleEvent::kOnErrorOccurred>)
       .SetMethod("onCompleted",
-                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>);
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>)
+      .SetMethod("onResponseBody",
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnResponseBody>)
+      .SetMethod("setRules", &WebRequest::SetRules)
+      .SetMethod("getProxyMetrics", &WebRequest::GetProxyMetrics);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -314,13 +564,77 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
+}
+
+bool WebRequest::ShouldProxyRequest(const network::ResourceRequest& request) {
+  // Same as the type of the WebRequestInfo created for the request.
+  const auto type = extensions::ToWebRequestResourceType(request, false);
+  // A redirect keeps the type of the request but may lead to any URL. Only
+  // HTTP responses are redirects, and requests failing on a redirect end
+  // with the URL they started with.
+  const bool may_redirect =
+      request.url.SchemeIsHTTPOrHTTPS() &&
+      request.redirect_mode != network::mojom::RedirectMode::kError;
+
+  const auto may_match = [&](const auto& listener) {
+    return listener.second.filter.MayMatchRequest(request.url, type,
+                                                  may_redirect);
+  };
+  const bool should_proxy =
+      base::ranges::any_of(simple_listeners_, may_match) ||
+      base::ranges::any_of(response_listeners_, may_match) ||
+      rules_.MayMatchRequest(request.url, type, may_redirect);
+  ++(should_proxy ? proxied_requests_ : bypassed_requests_);
+  return should_proxy;
+}
+
+bool WebRequest::ShouldProxyWebSocket(const GURL& url) {
+  const auto type = extensions::WebRequestResourceType::WEB_SOCKET;
+  const auto may_match = [&](const auto& listener) {
+    return listener.second.filter.MayMatchRequest(url, type, false);
+  };
+  const bool should_proxy =
+      base::ranges::any_of(simple_listeners_, may_match) ||
+      base::ranges::any_of(response_listeners_, may_match) ||
+      rules_.MayMatchRequest(url, type, false);
+  ++(should_proxy ? proxied_requests_ : bypassed_requests_);
+  return should_proxy;
+}
+
+ResponseBodyTap::ResultCallback WebRequest::GetResponseBodyCallback(
+    extensions::WebRequestInfo* info,
+    const network::ResourceRequest& request) {
+  const auto iter = simple_listeners_.find(SimpleEvent::kOnResponseBody);
+  if (iter == std::end(simple_listeners_) ||
+      !iter->second.filter.MatchesRequest(info)) {
+    return {};
+  }
+  ResponseBodyInfo body_info = {
+      info->id,
+      info->url,
+      info->method,
+      info->web_request_type,
+      info->render_process_id,
+      info->frame_routing_id,
+      info->response_headers ? info->response_headers->response_code() : 0};
+  return base::BindOnce(&WebRequest::OnResponseBody,
+                        weak_factory_.GetWeakPtr(), std::move(body_info));
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  switch (rules_.OnBeforeRequest(*info, new_url)) {
+    case WebRequestRules::RequestAction::kBlock:
+      return net::ERR_BLOCKED_BY_CLIENT;
+    case WebRequestRules::RequestAction::kRedirect:
+      return net::OK;
+    case WebRequestRules::RequestAction::kNone:
+      break;
+  }
   return HandleResponseEvent(ResponseEvent::kOnBeforeRequest, info,
                              std::move(callback), new_url, request);
 }
@@ -329,6 +643,7 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  rules_.OnBeforeSendHeaders(*info, headers);
   return HandleResponseEvent(
       ResponseEvent::kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -343,6 +658,9 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  // Replaced by the responseHeaders of a listener, if it returns any.
+  rules_.OnHeadersReceived(*info, original_response_headers,
+                           override_response_headers);
   const std::string& status_line =
       original_response_headers ? original_response_headers->GetStatusLine()
                                 : std::string();
@@ -375,6 +693,7 @@ void WebRequest::OnErrorOccurred(extensions::WebRequestInfo* info,
   callbacks_.erase(info->id);
 
   HandleSimpleEvent(SimpleEvent::kOnErrorOccurred, info, request, net_error);
+  converted_response_headers_.erase(info->id);
 }
 
 void WebRequest::OnCompleted(extensions::WebRequestInfo* info,
@@ -383,10 +702,72 @@ void WebRequest::OnCompleted(extensions::WebRequestInfo* info,
   callbacks_.erase(info->id);
 
   HandleSimpleEvent(SimpleEvent::kOnCompleted, info, request, net_error);
+  converted_response_headers_.erase(info->id);
 }
 
 void WebRequest::OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) {
   callbacks_.erase(info->id);
+  converted_response_headers_.erase(info->id);
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  std::vector<v8::Local<v8::Value>> values;
+  if (!args->GetNext(&values)) {
+    args->ThrowTypeError("Must pass an array of rules");
+    return;
+  }
+
+  std::vector<WebRequestRule> rules;
+  rules.reserve(values.size());
+  for (v8::Local<v8::Value> value : values) {
+    WebRequestRule rule;
+    std::string error;
+    if (!ParseRule(args->isolate(), value, &rule, &error)) {
+      args->ThrowTypeError(error);
+      return;
+    }
+    rules.push_back(std::move(rule));
+  }
+  rules_.SetRules(std::move(rules));
+}
+
+v8::Local<v8::Value> WebRequest::GetProxyMetrics(v8::Isolate* isolate) const {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("proxiedRequests", static_cast<double>(proxied_requests_));
+  dict.Set("bypassedRequests", static_cast<double>(bypassed_requests_));
+  return dict.GetHandle();
+}
+
+// static
+const char* WebRequest::GetEventName(SimpleEvent event) {
+  switch (event) {
+    case SimpleEvent::kOnSendHeaders:
+      return "onSendHeaders";
+    case SimpleEvent::kOnBeforeRedirect:
+      return "onBeforeRedirect";
+    case SimpleEvent::kOnResponseStarted:
+      return "onResponseStarted";
+    case SimpleEvent::kOnCompleted:
+      return "onCompleted";
+    case SimpleEvent::kOnErrorOccurred:
+      return "onErrorOccurred";
+    case SimpleEvent::kOnResponseBody:
+      return "onResponseBody";
+  }
+  return "";
+}
+
+// static
+const char* WebRequest::GetEventName(ResponseEvent event) {
+  switch (event) {
+    case ResponseEvent::kOnBeforeRequest:
+      return "onBeforeRequest";
+    case ResponseEvent::kOnBeforeSendHeaders:
+      return "onBeforeSendHeaders";
+    case ResponseEvent::kOnHeadersReceived:
+      return "onHeadersReceived";
+  }
+  return "";
 }
 
 template <WebRequest::SimpleEvent event>
@@ -422,29 +803,13 @@ void WebRequest::SetListener(Event event,
     }
   }
 
-  RequestFilter filter;
-
-  for (const std::string& filter_pattern : filter_patterns) {
-    URLPattern pattern(URLPattern::SCHEME_ALL);
-    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
-    if (result == URLPattern::ParseResult::kSuccess) {
-      filter.AddUrlPattern(std::move(pattern));
-    } else {
-      const char* error_type = URLPattern::GetParseResultString(result);
-      args->ThrowTypeError("Invalid url pattern " + filter_pattern + ": " +
-                           error_type);
-      return;
-    }
-  }
-
-  for (const std::string& filter_type : filter_types) {
-    auto type = ParseResourceType(filter_type);
-    if (type != extensions::WebRequestResourceType::OTHER) {
-      filter.AddType(type);
-    } else {
-      args->ThrowTypeError("Invalid type " + filter_type);
-      return;
-    }
+  std::set<URLPattern> url_patterns;
+  std::set<extensions::WebRequestResourceType> types;
+  std::string error;
+  if (!ParseURLPatterns(filter_patterns, &url_patterns, &error) ||
+      !ParseResourceTypes(filter_types, &types, &error)) {
+    args->ThrowTypeError(error);
+    return;
   }
 
   // Function or null.
@@ -455,10 +820,12 @@ void WebRequest::SetListener(Event event,
     return;
   }
 
-  if (listener.is_null())
+  if (listener.is_null()) {
     listeners->erase(event);
-  else
-    (*listeners)[event] = {std::move(filter), std::move(listener)};
+  } else {
+    (*listeners)[event] = {RequestFilter(url_patterns, std::move(types)),
+                           std::move(listener)};
+  }
 }
 
 template <typename... Args>
@@ -473,10 +840,13 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
   if (!info.filter.MatchesRequest(request_info))
     return;
 
+  TRACE_EVENT2("electron", "WebRequest::HandleSimpleEvent", "event",
+               GetEventName(event), "scheme", request_info->url.scheme());
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+  gin_helper::Dictionary details = kDetailsTemplate.NewRecord(isolate);
   FillDetails(&details, request_info, args...);
+  SetResponseHeaders(&details, request_info);
   info.listener.Run(gin::ConvertToV8(isolate, details));
 }
 
@@ -494,12 +864,15 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
   if (!info.filter.MatchesRequest(request_info))
     return net::OK;
 
+  TRACE_EVENT2("electron", "WebRequest::HandleResponseEvent", "event",
+               GetEventName(event), "scheme", request_info->url.scheme());
   callbacks_[request_info->id] = std::move(callback);
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+  gin_helper::Dictionary details = kDetailsTemplate.NewRecord(isolate);
   FillDetails(&details, request_info, args...);
+  SetResponseHeaders(&details, request_info);
 
   ResponseCallback response =
       base::BindOnce(&WebRequest::OnListenerResult<Out>, base::Unretained(this),
@@ -508,6 +881,55 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
   return net::ERR_IO_PENDING;
 }
 
+void WebRequest::OnResponseBody(const ResponseBodyInfo& body_info,
+                                const ResponseBodyTap::Result& result) {
+  const auto iter = simple_listeners_.find(SimpleEvent::kOnResponseBody);
+  if (iter == std::end(simple_listeners_))
+    return;
+
+  TRACE_EVENT2("electron", "WebRequest::OnResponseBody", "scheme",
+               body_info.url.scheme(), "size", result.byte_length);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary details = kDetailsTemplate.NewRecord(isolate);
+  details.Set("id", body_info.id);
+  details.Set("url", body_info.url);
+  details.Set("method", body_info.method);
+  details.Set("timestamp", base::Time::Now().ToDoubleT() * 1000);
+  details.Set("resourceType", body_info.resource_type);
+  if (body_info.status_code)
+    details.Set("statusCode", body_info.status_code);
+  details.Set("byteLength", static_cast<double>(result.byte_length));
+  details.Set("sha256", result.sha256);
+
+  auto* render_frame_host = content::RenderFrameHost::FromID(
+      body_info.render_process_id, body_info.frame_routing_id);
+  if (render_frame_host) {
+    details.SetGetter("frame", render_frame_host);
+    auto* web_contents =
+        content::WebContents::FromRenderFrameHost(render_frame_host);
+    auto* api_web_contents = WebContents::From(web_contents);
+    if (api_web_contents) {
+      details.Set("webContents", api_web_contents);
+      details.Set("webContentsId", api_web_contents->ID());
+    }
+  }
+  iter->second.listener.Run(gin::ConvertToV8(isolate, details));
+}
+
+void WebRequest::SetResponseHeaders(gin_helper::Dictionary* details,
+                                    extensions::WebRequestInfo* info) {
+  if (!info->response_headers)
+    return;
+  scoped_refptr<ConvertedResponseHeaders>& converted =
+      converted_response_headers_[info->id];
+  if (!converted || converted->headers() != info->response_headers.get()) {
+    converted =
+        base::MakeRefCounted<ConvertedResponseHeaders>(info->response_headers);
+  }
+  LazyDetailsProperty::Define(details, "responseHeaders", converted);
+}
+
 template <typename T>
 void WebRequest::OnListenerResult(uint64_t id,
                                   T out,
@@ -9,19 +9,29 @@
 #include <set>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "extensions/common/url_pattern.h"
 #include "gin/arguments.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/net/url_pattern_matcher.h"
 #include "shell/browser/net/web_request_api_interface.h"
+#include "shell/browser/net/web_request_rules.h"
+#include "url/gurl.h"
 
 namespace content {
 class BrowserContext;
 }
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron::api {
 
+class ConvertedResponseHeaders;
+
 class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
  public:
   static gin::WrapperInfo kWrapperInfo;
@@ -50,6 +60,12 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
 
   // WebRequestAPI:
   bool HasListener() const override;
+  bool ShouldProxyRequest(const network::ResourceRequest& request) override;
+  // The same for the handshake of a WebSocket, which isn't redirected.
+  bool ShouldProxyWebSocket(const GURL& url);
+  ResponseBodyTap::ResultCallback GetResponseBodyCallback(
+      extensions::WebRequestInfo* info,
+      const network::ResourceRequest& request) override;
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -91,6 +107,7 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     kOnResponseStarted,
     kOnCompleted,
     kOnErrorOccurred,
+    kOnResponseBody,
   };
   enum class ResponseEvent {
     kOnBeforeRequest,
@@ -98,11 +115,18 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     kOnHeadersReceived,
   };
 
+  // The names of the events in traces.
+  static const char* GetEventName(SimpleEvent event);
+  static const char* GetEventName(ResponseEvent event);
+
   using SimpleListener = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
   using ResponseCallback = base::OnceCallback<void(v8::Local<v8::Value>)>;
   using ResponseListener =
       base::RepeatingCallback<void(v8::Local<v8::Value>, ResponseCallback)>;
 
+  void SetRules(gin::Arguments* args);
+  v8::Local<v8::Value> GetProxyMetrics(v8::Isolate* isolate) const;
+
   template <SimpleEvent event>
   void SetSimpleListener(gin::Arguments* args);
   template <ResponseEvent event>
@@ -121,27 +145,50 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
                           Out out,
                           Args... args);
 
+  // What the details of kOnResponseBody are made of, since the request may be
+  // gone by the time the body was read.
+  struct ResponseBodyInfo {
+    uint64_t id;
+    GURL url;
+    std::string method;
+    extensions::WebRequestResourceType resource_type;
+    int render_process_id;
+    int frame_routing_id;
+    int status_code;
+  };
+
+  void OnResponseBody(const ResponseBodyInfo& info,
+                      const ResponseBodyTap::Result& result);
+
+  // Defines |details|.responseHeaders, converting the headers only once for
+  // all the events of a request.
+  void SetResponseHeaders(gin_helper::Dictionary* details,
+                          extensions::WebRequestInfo* info);
+
   template <typename T>
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
 
   class RequestFilter {
    public:
-    RequestFilter(std::set<URLPattern>,
+    // The patterns are indexed here, once, since every request is matched
+    // against them.
+    RequestFilter(const std::set<URLPattern>&,
                   std::set<extensions::WebRequestResourceType>);
     RequestFilter(const RequestFilter&);
     RequestFilter();
     ~RequestFilter();
 
-    void AddUrlPattern(URLPattern pattern);
-    void AddType(extensions::WebRequestResourceType type);
-
     bool MatchesRequest(extensions::WebRequestInfo* info) const;
+    // Ignores the URL if |may_redirect|.
+    bool MayMatchRequest(const GURL& url,
+                         extensions::WebRequestResourceType type,
+                         bool may_redirect) const;
 
    private:
     bool MatchesURL(const GURL& url) const;
     bool MatchesType(extensions::WebRequestResourceType type) const;
 
-    std::set<URLPattern> url_patterns_;
+    URLPatternMatcher url_matcher_;
     std::set<extensions::WebRequestResourceType> types_;
   };
 
@@ -166,9 +213,20 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  std::map<uint64_t, scoped_refptr<ConvertedResponseHeaders>>
+      converted_response_headers_;
+
+  // Applied before the listeners are called.
+  WebRequestRules rules_;
+
+  // Requests the proxying URL loader factories were consulted for.
+  uint64_t proxied_requests_ = 0;
+  uint64_t bypassed_requests_ = 0;
 
   // Weak-ref, it manages us.
   raw_ptr<content::BrowserContext> browser_context_;
+
+  base::WeakPtrFactory<WebRequest> weak_factory_{this};
 };
 
 }  // namespace electron::api
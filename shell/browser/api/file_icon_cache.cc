@@ -0,0 +1,84 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/file_icon_cache.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "build/build_config.h"
+
+namespace electron::api {
+
+namespace {
+
+// The icons of the most recently used file types which are kept.
+constexpr size_t kMaxCachedIcons = 256;
+
+}  // namespace
+
+FileIconCache::FileIconCache() : cache_(kMaxCachedIcons) {}
+
+FileIconCache::~FileIconCache() = default;
+
+void FileIconCache::GetIcon(const base::FilePath& path,
+                            IconLoader::IconSize size,
+                            IconCallback callback) {
+  std::string key = GetKey(path, size);
+  auto cached = cache_.Get(key);
+  if (cached != cache_.end()) {
+    std::move(callback).Run(cached->second);
+    return;
+  }
+
+  auto [pending, inserted] = pending_.try_emplace(key);
+  pending->second.push_back(std::move(callback));
+  if (!inserted)
+    return;
+  // The loader deletes itself once it called back.
+  IconLoader::Create(path, size, 1.0f,
+                     base::BindOnce(&FileIconCache::OnIconLoaded,
+                                    weak_factory_.GetWeakPtr(), key))
+      ->Start();
+}
+
+// static
+std::string FileIconCache::GetKey(const base::FilePath& path,
+                                  IconLoader::IconSize size) {
+  const base::FilePath::StringType extension =
+      base::ToLowerASCII(path.Extension());
+#if BUILDFLAG(IS_WIN)
+  // Executables and icon files have an icon of their own.
+  const bool has_own_icon =
+      extension == L".exe" || extension == L".dll" || extension == L".ico";
+#else
+  const bool has_own_icon = false;
+#endif
+  const std::string size_prefix =
+      base::NumberToString(static_cast<int>(size));
+  if (extension.empty() || has_own_icon)
+    return base::StrCat({size_prefix, ":path:", path.AsUTF8Unsafe()});
+  return base::StrCat(
+      {size_prefix, ":ext:", base::FilePath(extension).AsUTF8Unsafe()});
+}
+
+void FileIconCache::OnIconLoaded(const std::string& key,
+                                 gfx::Image icon,
+                                 const IconLoader::IconGroup& group) {
+  // Failures aren't cached, the file could be there the next time.
+  if (!icon.IsEmpty())
+    cache_.Put(key, icon);
+  auto pending = pending_.find(key);
+  if (pending == pending_.end())
+    return;
+  std::vector<IconCallback> callbacks = std::move(pending->second);
+  pending_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(icon);
+}
+
+}  // namespace electron::api
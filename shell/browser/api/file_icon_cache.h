@@ -0,0 +1,60 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_FILE_ICON_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_API_FILE_ICON_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "chrome/browser/icon_loader.h"
+#include "ui/gfx/image/image.h"
+
+namespace electron::api {
+
+// Loads the icons of app.getFileIcon() and app.getFileIcons(). The platforms
+// pick the icon of a file by its type, so files of the same type share one
+// load and one entry of a cache of the most recently used icons. The loads
+// run in parallel on the threads of IconLoader. Only used on the UI thread.
+class FileIconCache {
+ public:
+  // Called with an empty image when the icon couldn't be loaded.
+  using IconCallback = base::OnceCallback<void(gfx::Image icon)>;
+
+  FileIconCache();
+  ~FileIconCache();
+
+  // disable copy
+  FileIconCache(const FileIconCache&) = delete;
+  FileIconCache& operator=(const FileIconCache&) = delete;
+
+  // Calls |callback| right away when the icon is cached.
+  void GetIcon(const base::FilePath& path,
+               IconLoader::IconSize size,
+               IconCallback callback);
+
+ private:
+  // The files the same key is returned for have the same icon.
+  static std::string GetKey(const base::FilePath& path,
+                            IconLoader::IconSize size);
+
+  void OnIconLoaded(const std::string& key,
+                    gfx::Image icon,
+                    const IconLoader::IconGroup& group);
+
+  base::HashingLRUCache<std::string, gfx::Image> cache_;
+  // The callbacks waiting for the loads in progress.
+  std::map<std::string, std::vector<IconCallback>> pending_;
+
+  base::WeakPtrFactory<FileIconCache> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_FILE_ICON_CACHE_H_
@@ -0,0 +1,292 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/frame_recorder.h"
+
+#include <string>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "media/base/bitrate.h"
+#include "media/base/video_encoder.h"
+#include "media/base/video_frame.h"
+#include "media/capture/mojom/video_capture_buffer.mojom.h"
+#include "media/capture/mojom/video_capture_types.mojom.h"
+#include "media/media_buildflags.h"
+#include "media/muxers/live_webm_muxer_delegate.h"
+#include "media/muxers/webm_muxer.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+#if BUILDFLAG(ENABLE_LIBVPX)
+#include "media/video/vpx_video_encoder.h"
+#endif
+
+namespace electron::api {
+
+namespace {
+
+gfx::Size GetRenderViewSize(content::RenderWidgetHostView* view) {
+  gfx::Size size = gfx::ToRoundedSize(gfx::ScaleSize(
+      gfx::SizeF(view->GetViewBounds().size()), view->GetDeviceScaleFactor()));
+  // The chroma planes of I420 frames are subsampled.
+  return gfx::Size((size.width() + 1) & ~1, (size.height() + 1) & ~1);
+}
+
+}  // namespace
+
+// Lives on a worker sequence, where it encodes the frames and writes them to
+// the file as they come.
+class FrameRecorder::Encoder {
+ public:
+  Encoder(const base::FilePath& path,
+          const Options& options,
+          const gfx::Size& frame_size,
+          StatusCallback started)
+      : video_params_(frame_size, options.frame_rate, options.codec,
+                      absl::nullopt) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+    file_.Initialize(path,
+                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (!file_.IsValid()) {
+      error_ = base::File::ErrorToString(file_.error_details());
+      std::move(started).Run(error_);
+      return;
+    }
+
+    encoder_ = std::make_unique<media::VpxVideoEncoder>();
+    muxer_ = std::make_unique<media::WebmMuxer>(
+        media::AudioCodec::kOpus, true /* has_video */, false /* has_audio */,
+        std::make_unique<media::LiveWebmMuxerDelegate>(base::BindRepeating(
+            &Encoder::WriteData, weak_factory_.GetWeakPtr())));
+
+    media::VideoEncoder::Options encoder_options;
+    encoder_options.frame_size = frame_size;
+    encoder_options.framerate = options.frame_rate;
+    encoder_options.bitrate = media::Bitrate::ConstantBitrate(options.bitrate);
+    // A key frame every two seconds keeps the file seekable.
+    encoder_options.keyframe_interval = options.frame_rate * 2;
+    encoder_->Initialize(
+        options.codec == media::VideoCodec::kVP9 ? media::VP9PROFILE_PROFILE0
+                                                 : media::VP8PROFILE_ANY,
+        encoder_options, base::DoNothing(),
+        base::BindRepeating(&Encoder::OnEncoded, weak_factory_.GetWeakPtr()),
+        base::BindOnce(&Encoder::OnInitialized, weak_factory_.GetWeakPtr(),
+                       std::move(started)));
+#else
+    error_ = "Video encoding is not supported in this build";
+    std::move(started).Run(error_);
+#endif
+  }
+
+  // disable copy
+  Encoder(const Encoder&) = delete;
+  Encoder& operator=(const Encoder&) = delete;
+
+  void Encode(scoped_refptr<media::VideoFrame> frame) {
+    if (!initialized_ || error_)
+      return;
+    encoder_->Encode(
+        std::move(frame), media::VideoEncoder::EncodeOptions(false),
+        base::BindOnce(&Encoder::OnStatus, weak_factory_.GetWeakPtr()));
+  }
+
+  void Finish(StatusCallback done) {
+    if (!initialized_) {
+      std::move(done).Run(error_);
+      return;
+    }
+    encoder_->Flush(base::BindOnce(&Encoder::OnFlushed,
+                                   weak_factory_.GetWeakPtr(),
+                                   std::move(done)));
+  }
+
+ private:
+  void OnInitialized(StatusCallback started, media::EncoderStatus status) {
+    initialized_ = status.is_ok();
+    if (!initialized_)
+      error_ = "Failed to initialize the encoder";
+    std::move(started).Run(error_);
+  }
+
+  void OnEncoded(
+      media::VideoEncoderOutput output,
+      absl::optional<media::VideoEncoder::CodecDescription> description) {
+    if (error_)
+      return;
+    // The muxer only needs the timestamps to be relative to each other.
+    muxer_->OnEncodedVideo(
+        video_params_,
+        std::string(reinterpret_cast<const char*>(output.data.get()),
+                    output.size),
+        std::string(), base::TimeTicks() + output.timestamp, output.key_frame);
+  }
+
+  void OnStatus(media::EncoderStatus status) {
+    if (!status.is_ok() && !error_)
+      error_ = "Failed to encode a frame";
+  }
+
+  void OnFlushed(StatusCallback done, media::EncoderStatus status) {
+    OnStatus(status);
+    // Destroying the muxer writes the end of the file.
+    muxer_.reset();
+    file_.Close();
+    std::move(done).Run(error_);
+  }
+
+  void WriteData(base::StringPiece data) {
+    if (error_)
+      return;
+    if (!file_.WriteAtCurrentPosAndCheck(
+            base::as_bytes(base::make_span(data)))) {
+      error_ = "Failed to write to the file";
+    }
+  }
+
+  base::File file_;
+  std::unique_ptr<media::VideoEncoder> encoder_;
+  std::unique_ptr<media::WebmMuxer> muxer_;
+  const media::Muxer::VideoParameters video_params_;
+  bool initialized_ = false;
+  absl::optional<std::string> error_;
+
+  base::WeakPtrFactory<Encoder> weak_factory_{this};
+};
+
+FrameRecorder::FrameRecorder(content::WebContents* web_contents,
+                             const base::FilePath& path,
+                             const Options& options,
+                             StatusCallback started)
+    : content::WebContentsObserver(web_contents), options_(options) {
+  content::RenderWidgetHost* host =
+      web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost();
+  if (!host->GetView()) {
+    failed_ = true;
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(started), "The page has no view to record"));
+    return;
+  }
+  frame_size_ = GetRenderViewSize(host->GetView());
+
+  encoder_ = base::SequenceBound<Encoder>(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+      path, options_, frame_size_,
+      base::BindPostTaskToCurrentDefault(
+          base::BindOnce(&FrameRecorder::OnStarted, weak_factory_.GetWeakPtr(),
+                         std::move(started))));
+  AttachToHost(host);
+}
+
+FrameRecorder::~FrameRecorder() = default;
+
+void FrameRecorder::Stop(StatusCallback done) {
+  stopped_ = true;
+  DetachFromHost();
+  // |done| is never run synchronously, it may destroy |this|.
+  if (!encoder_) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(done), absl::nullopt));
+    return;
+  }
+  encoder_.AsyncCall(&Encoder::Finish)
+      .WithArgs(base::BindPostTaskToCurrentDefault(std::move(done)));
+}
+
+void FrameRecorder::OnStarted(StatusCallback started,
+                              absl::optional<std::string> error) {
+  if (error) {
+    failed_ = true;
+    DetachFromHost();
+  }
+  std::move(started).Run(std::move(error));
+}
+
+void FrameRecorder::AttachToHost(content::RenderWidgetHost* host) {
+  host_ = host;
+
+  // The view can be null if the renderer process has crashed.
+  if (stopped_ || failed_ || !host_->GetView())
+    return;
+
+  video_capturer_ = host_->GetView()->CreateVideoCapturer();
+  video_capturer_->SetResolutionConstraints(frame_size_, frame_size_, true);
+  video_capturer_->SetAutoThrottlingEnabled(false);
+  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
+  video_capturer_->SetFormat(media::PIXEL_FORMAT_I420);
+  video_capturer_->SetMinCapturePeriod(base::Seconds(1) /
+                                       options_.frame_rate);
+  video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
+}
+
+void FrameRecorder::DetachFromHost() {
+  video_capturer_.reset();
+  host_ = nullptr;
+}
+
+void FrameRecorder::RenderFrameCreated(
+    content::RenderFrameHost* render_frame_host) {
+  if (!host_)
+    AttachToHost(render_frame_host->GetRenderWidgetHost());
+}
+
+void FrameRecorder::RenderViewDeleted(content::RenderViewHost* host) {
+  if (host->GetWidget() == host_)
+    DetachFromHost();
+}
+
+void FrameRecorder::PrimaryPageChanged(content::Page& page) {
+  if (auto* host = page.GetMainDocument().GetMainFrame()->GetRenderWidgetHost();
+      host_ != host) {
+    DetachFromHost();
+    AttachToHost(host);
+  }
+}
+
+void FrameRecorder::OnFrameCaptured(
+    ::media::mojom::VideoBufferHandlePtr data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& content_rect,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  if (!data->is_read_only_shmem_region())
+    return;
+  base::ReadOnlySharedMemoryMapping mapping =
+      data->get_read_only_shmem_region().Map();
+  if (!mapping.IsValid() ||
+      mapping.size() < media::VideoFrame::AllocationSize(info->pixel_format,
+                                                         info->coded_size)) {
+    return;
+  }
+
+  scoped_refptr<media::VideoFrame> frame = media::VideoFrame::WrapExternalData(
+      info->pixel_format, info->coded_size, info->visible_rect,
+      info->visible_rect.size(), mapping.GetMemoryAs<uint8_t>(),
+      mapping.size(), info->timestamp);
+  if (!frame)
+    return;
+  frame->set_color_space(info->color_space);
+  // The capturer reuses the buffer once the encoder is done with the frame,
+  // which drops the mapping and closes |callbacks|.
+  frame->AddDestructionObserver(
+      base::DoNothingWithBoundArgs(std::move(mapping), std::move(callbacks)));
+  encoder_.AsyncCall(&Encoder::Encode).WithArgs(std::move(frame));
+}
+
+}  // namespace electron::api
@@ -0,0 +1,103 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_FRAME_RECORDER_H_
+#define ELECTRON_SHELL_BROWSER_API_FRAME_RECORDER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace electron::api {
+
+// Records the frames of a WebContents into a WebM file. The frames are
+// captured into shared memory by the compositor, and encoded and written on
+// a worker sequence without being copied.
+class FrameRecorder : public content::WebContentsObserver,
+                      public viz::mojom::FrameSinkVideoConsumer {
+ public:
+  struct Options {
+    media::VideoCodec codec = media::VideoCodec::kVP8;
+    int frame_rate = 30;
+    // In bits per second.
+    uint32_t bitrate = 2500000;
+  };
+
+  // Called with absl::nullopt on success, or with the reason of the failure.
+  using StatusCallback =
+      base::OnceCallback<void(absl::optional<std::string> error)>;
+
+  // |started| is called once the file is created and the encoder is ready.
+  FrameRecorder(content::WebContents* web_contents,
+                const base::FilePath& path,
+                const Options& options,
+                StatusCallback started);
+  ~FrameRecorder() override;
+
+  // disable copy
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  // Stops capturing, |done| is called once the frames captured so far are
+  // written and the file is closed.
+  void Stop(StatusCallback done);
+
+  // Whether the recording could not be started.
+  bool failed() const { return failed_; }
+
+ private:
+  class Encoder;
+
+  void OnStarted(StatusCallback started, absl::optional<std::string> error);
+
+  void AttachToHost(content::RenderWidgetHost* host);
+  void DetachFromHost();
+
+  // content::WebContentsObserver:
+  void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
+  void PrimaryPageChanged(content::Page& page) override;
+  void RenderViewDeleted(content::RenderViewHost* host) override;
+
+  // viz::mojom::FrameSinkVideoConsumer:
+  void OnFrameCaptured(
+      ::media::mojom::VideoBufferHandlePtr data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& content_rect,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks) override;
+  void OnNewCropVersion(uint32_t crop_version) override {}
+  void OnFrameWithEmptyRegionCapture() override {}
+  void OnStopped() override {}
+  void OnLog(const std::string& message) override {}
+
+  const Options options_;
+  // The size of the recorded frames, the content is letterboxed into it when
+  // the page is resized.
+  gfx::Size frame_size_;
+  bool stopped_ = false;
+  bool failed_ = false;
+
+  raw_ptr<content::RenderWidgetHost> host_ = nullptr;
+  std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
+
+  base::SequenceBound<Encoder> encoder_;
+
+  base::WeakPtrFactory<FrameRecorder> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_FRAME_RECORDER_H_
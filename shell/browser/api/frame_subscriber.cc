@@ -4,15 +4,20 @@
 
 #include "shell/browser/api/frame_subscriber.h"
 
+#include <cstring>
 #include <utility>
+#include <vector>
 
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_buffer.mojom.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom-shared.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/gfx_converter.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
@@ -30,6 +35,15 @@ FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
   AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
 }
 
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const RawFrameCaptureCallback& callback,
+                                 Format format)
+    : content::WebContentsObserver(web_contents),
+      raw_callback_(callback),
+      format_(format) {
+  AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
+}
+
 FrameSubscriber::~FrameSubscriber() = default;
 
 void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
@@ -46,7 +60,9 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   video_capturer_->SetResolutionConstraints(size, size, true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB);
+  video_capturer_->SetFormat(format_ == Format::kI420
+                                 ? media::PIXEL_FORMAT_I420
+                                 : media::PIXEL_FORMAT_ARGB);
   video_capturer_->SetMinCapturePeriod(base::Seconds(1) / kMaxFrameRate);
   video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
 }
@@ -110,6 +126,12 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  if (format_ != Format::kNativeImage) {
+    // The capturer gets the buffer back once |callbacks_remote| goes away.
+    DoneRaw(*info, content_rect, mapping);
+    return;
+  }
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
   void* const pixels = const_cast<void*>(mapping.memory());
@@ -171,6 +193,53 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   callback_.Run(gfx::Image::CreateFrom1xBitmap(copy), damage);
 }
 
+void FrameSubscriber::DoneRaw(
+    const media::mojom::VideoFrameInfo& info,
+    const gfx::Rect& content_rect,
+    const base::ReadOnlySharedMemoryMapping& mapping) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // The mapping is read-only, JS could not write to an array buffer backed by
+  // it without crashing, so the planes are copied once. Unlike images this
+  // needs no conversion and no second copy.
+  const media::VideoPixelFormat format = info.pixel_format;
+  const size_t size =
+      media::VideoFrame::AllocationSize(format, info.coded_size);
+  v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, size);
+  memcpy(buffer->Data(), mapping.memory(), size);
+
+  // The capturer lays the planes out one after the other.
+  std::vector<gin_helper::Dictionary> planes;
+  uint64_t offset = 0;
+  for (size_t plane = 0; plane < media::VideoFrame::NumPlanes(format);
+       ++plane) {
+    const int stride = media::VideoFrame::RowBytes(plane, format,
+                                                   info.coded_size.width());
+    const auto rows = static_cast<uint32_t>(
+        media::VideoFrame::Rows(plane, format, info.coded_size.height()));
+    const auto columns = static_cast<uint32_t>(
+        media::VideoFrame::Columns(plane, format, info.coded_size.width()));
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("offset", offset);
+    dict.Set("stride", stride);
+    dict.Set("width", columns);
+    dict.Set("height", rows);
+    planes.push_back(dict);
+    offset += static_cast<uint64_t>(stride) * rows;
+  }
+
+  auto frame = gin_helper::Dictionary::CreateEmpty(isolate);
+  frame.Set("format", format_ == Format::kI420 ? "i420" : "bgra");
+  frame.Set("data", buffer);
+  frame.Set("planes", planes);
+  frame.Set("codedSize", info.coded_size);
+  frame.Set("visibleRect", info.visible_rect);
+  frame.Set("contentRect", content_rect);
+  frame.Set("timestamp", info.timestamp.InMillisecondsF());
+  raw_callback_.Run(gfx::Image(), content_rect, frame);
+}
+
 gfx::Size FrameSubscriber::GetRenderViewSize() const {
   content::RenderWidgetHostView* view = host_->GetView();
   gfx::Size size = view->GetViewBounds().size();
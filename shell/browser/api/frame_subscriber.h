@@ -10,12 +10,14 @@
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "v8/include/v8.h"
 
 namespace gfx {
@@ -30,12 +32,29 @@ class WebContents;
 class FrameSubscriber : public content::WebContentsObserver,
                         public viz::mojom::FrameSinkVideoConsumer {
  public:
+  // The format the captured frames are passed in.
+  enum class Format {
+    kNativeImage,
+    // The pixels of the frames are passed as they are captured, without being
+    // converted into images.
+    kBGRA,
+    kI420,
+  };
+
   using FrameCaptureCallback =
       base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+  // Called with an empty image and the raw frame.
+  using RawFrameCaptureCallback =
+      base::RepeatingCallback<void(const gfx::Image&,
+                                   const gfx::Rect&,
+                                   const gin_helper::Dictionary&)>;
 
   FrameSubscriber(content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
                   bool only_dirty);
+  FrameSubscriber(content::WebContents* web_contents,
+                  const RawFrameCaptureCallback& callback,
+                  Format format);
   ~FrameSubscriber() override;
 
   // disable copy
@@ -63,12 +82,17 @@ class FrameSubscriber : public content::WebContentsObserver,
   void OnLog(const std::string& message) override;
 
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
+  void DoneRaw(const media::mojom::VideoFrameInfo& info,
+               const gfx::Rect& content_rect,
+               const base::ReadOnlySharedMemoryMapping& mapping);
 
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  RawFrameCaptureCallback raw_callback_;
+  bool only_dirty_ = false;
+  const Format format_ = Format::kNativeImage;
 
   raw_ptr<content::RenderWidgetHost> host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
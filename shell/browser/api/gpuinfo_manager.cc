@@ -41,18 +41,24 @@ bool GPUInfoManager::NeedsCompleteGpuInfoCollection() const {
 
 // Should be posted to the task runner
 void GPUInfoManager::ProcessCompleteInfo() {
-  base::Value::Dict result = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
+  if (complete_info_promise_set_.empty())
+    return;
+  if (!complete_info_)
+    complete_info_ = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
   // We have received the complete information, resolve all promises that
   // were waiting for this info.
   for (auto& promise : complete_info_promise_set_) {
-    promise.Resolve(base::Value(result.Clone()));
+    promise.Resolve(base::Value(complete_info_->Clone()));
   }
   complete_info_promise_set_.clear();
 }
 
 void GPUInfoManager::OnGpuInfoUpdate() {
+  // Either the complete info arrived or it changed, e.g. as the GPU process
+  // restarted or the displays changed, so the cached one is stale.
+  complete_info_.reset();
   // Ignore if called when not asked for complete GPUInfo
-  if (NeedsCompleteGpuInfoCollection())
+  if (complete_info_promise_set_.empty() || NeedsCompleteGpuInfoCollection())
     return;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::ProcessCompleteInfo,
@@ -62,13 +68,18 @@ void GPUInfoManager::OnGpuInfoUpdate() {
 // Should be posted to the task runner
 void GPUInfoManager::CompleteInfoFetcher(
     gin_helper::Promise<base::Value> promise) {
+  if (complete_info_) {
+    promise.Resolve(base::Value(complete_info_->Clone()));
+    return;
+  }
+
   complete_info_promise_set_.emplace_back(std::move(promise));
 
   if (NeedsCompleteGpuInfoCollection()) {
     gpu_data_manager_->RequestDxdiagDx12VulkanVideoGpuInfoIfNeeded(
         content::GpuDataManagerImpl::kGpuInfoRequestAll, /* delayed */ false);
   } else {
-    GPUInfoManager::OnGpuInfoUpdate();
+    ProcessCompleteInfo();
   }
 }
 
@@ -12,6 +12,7 @@
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/gpu_data_manager_observer.h"
 #include "shell/common/gin_helper/promise.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron {
 
@@ -42,6 +43,8 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   // This set maintains all the promises that should be fulfilled
   // once we have the complete information data
   std::vector<gin_helper::Promise<base::Value>> complete_info_promise_set_;
+  // The complete info once collected, until the GPU info changes.
+  absl::optional<base::Value::Dict> complete_info_;
   raw_ptr<content::GpuDataManagerImpl> gpu_data_manager_;
 };
 
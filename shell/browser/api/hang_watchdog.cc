@@ -0,0 +1,301 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/hang_watchdog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "base/debug/dump_without_crashing.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/json/json_writer.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/process/process.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/thread_annotations.h"
+#include "base/values.h"
+#include "components/crash/core/common/crash_key.h"
+#include "shell/common/javascript_stack.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron::api {
+
+namespace {
+
+// How long the watchdog waits for the JavaScript stack before it writes the
+// report of a hang.
+constexpr base::TimeDelta kStackWait = base::Milliseconds(200);
+
+const char* SourceToString(HangWatchdog::Source source) {
+  switch (source) {
+    case HangWatchdog::Source::kMainThread:
+      return "main-thread";
+    case HangWatchdog::Source::kUvLoop:
+      return "uv-loop";
+  }
+  return "";
+}
+
+}  // namespace
+
+// The state shared by the UI thread and the watchdog.
+class HangWatchdog::Heartbeat
+    : public base::RefCountedThreadSafe<HangWatchdog::Heartbeat> {
+ public:
+  explicit Heartbeat(v8::Isolate* isolate) : isolate_(isolate) {}
+
+  // disable copy
+  Heartbeat(const Heartbeat&) = delete;
+  Heartbeat& operator=(const Heartbeat&) = delete;
+
+  void BeatMainThread() { main_thread_ = Now(); }
+  void BeatUvLoop() { uv_loop_ = Now(); }
+  base::TimeTicks main_thread() const { return FromMicroseconds(main_thread_); }
+  // Null until the loop ran the first time, as the polling thread only picks
+  // the timer up then.
+  base::TimeTicks uv_loop() const { return FromMicroseconds(uv_loop_); }
+
+  // Asks V8 for the JavaScript stack, which is recorded the next time
+  // JavaScript runs.
+  void RequestStack() {
+    base::AutoLock lock(lock_);
+    js_stack_.clear();
+    if (!isolate_ || wants_stack_)
+      return;
+    wants_stack_ = true;
+    // The interrupt keeps the state alive until it runs.
+    isolate_->RequestInterrupt(&Heartbeat::OnInterrupt,
+                               new scoped_refptr<Heartbeat>(this));
+  }
+
+  // Stops recording JavaScript stacks and returns the last one.
+  std::string TakeStack(bool done) {
+    base::AutoLock lock(lock_);
+    if (done)
+      wants_stack_ = false;
+    return js_stack_;
+  }
+
+  // Called on the UI thread before the isolate goes away.
+  void Detach() {
+    base::AutoLock lock(lock_);
+    isolate_ = nullptr;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Heartbeat>;
+
+  ~Heartbeat() = default;
+
+  static int64_t Now() {
+    return (base::TimeTicks::Now() - base::TimeTicks()).InMicroseconds();
+  }
+  static base::TimeTicks FromMicroseconds(int64_t us) {
+    return us ? base::TimeTicks() + base::Microseconds(us) : base::TimeTicks();
+  }
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    std::unique_ptr<scoped_refptr<Heartbeat>> self(
+        static_cast<scoped_refptr<Heartbeat>*>(data));
+    std::string stack = CaptureJavaScriptStack(isolate);
+    base::AutoLock lock((*self)->lock_);
+    if (!(*self)->wants_stack_)
+      return;
+    (*self)->wants_stack_ = false;
+    (*self)->js_stack_ = std::move(stack);
+  }
+
+  std::atomic<int64_t> main_thread_{0};
+  std::atomic<int64_t> uv_loop_{0};
+
+  base::Lock lock_;
+  raw_ptr<v8::Isolate> isolate_ GUARDED_BY(lock_);
+  bool wants_stack_ GUARDED_BY(lock_) = false;
+  std::string js_stack_ GUARDED_BY(lock_);
+};
+
+class HangWatchdog::Monitor {
+ public:
+  Monitor(scoped_refptr<Heartbeat> heartbeat,
+          const Options& options,
+          HangCallback callback)
+      : heartbeat_(std::move(heartbeat)),
+        options_(options),
+        callback_(std::move(callback)) {
+    // Unretained is safe as |check_timer_| is owned by |this|.
+    check_timer_.Start(
+        FROM_HERE, options_.threshold / 4,
+        base::BindRepeating(&Monitor::Check, base::Unretained(this)));
+  }
+
+  // disable copy
+  Monitor(const Monitor&) = delete;
+  Monitor& operator=(const Monitor&) = delete;
+
+ private:
+  base::TimeTicks LastBeat(Source source) const {
+    return source == Source::kMainThread ? heartbeat_->main_thread()
+                                         : heartbeat_->uv_loop();
+  }
+
+  void Check() {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (!in_hang_) {
+      for (Source source : {Source::kMainThread, Source::kUvLoop}) {
+        const base::TimeTicks beat = LastBeat(source);
+        if (!beat.is_null() && now - beat > options_.threshold) {
+          Begin(source, beat, now);
+          return;
+        }
+      }
+      return;
+    }
+    const base::TimeTicks beat = LastBeat(hang_.source);
+    // The report is written before the hang is over.
+    if (beat > hang_beat_ && !capture_timer_.IsRunning())
+      End(beat);
+  }
+
+  void Begin(Source source, base::TimeTicks beat, base::TimeTicks now) {
+    in_hang_ = true;
+    hang_beat_ = beat;
+    hang_ = Hang();
+    hang_.source = source;
+    hang_.start_time = base::Time::Now() - (now - beat);
+    heartbeat_->RequestStack();
+    // Unretained is safe as |capture_timer_| is owned by |this|.
+    capture_timer_.Start(
+        FROM_HERE, kStackWait,
+        base::BindOnce(&Monitor::Capture, base::Unretained(this)));
+  }
+
+  void Capture() {
+    hang_.js_stack = heartbeat_->TakeStack(/*done=*/false);
+
+    if (!options_.report_directory.empty()) {
+      base::Value::Dict report;
+      report.Set("source", SourceToString(hang_.source));
+      report.Set("startTime", hang_.start_time.ToJsTime());
+      report.Set("threshold", options_.threshold.InMillisecondsF());
+      report.Set("pid", static_cast<int>(base::Process::Current().Pid()));
+      report.Set("jsStack", hang_.js_stack);
+      std::string json;
+      base::JSONWriter::WriteWithOptions(
+          report, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+      base::FilePath path = options_.report_directory.AppendASCII(
+          base::StrCat({"hang-", base::NumberToString(static_cast<int64_t>(
+                                     hang_.start_time.ToJsTime())),
+                        ".json"}));
+      if (base::CreateDirectory(options_.report_directory) &&
+          base::WriteFile(path, json)) {
+        hang_.report_path = std::move(path);
+      } else {
+        LOG(ERROR) << "Failed to write the hang report " << path;
+      }
+    }
+
+    if (options_.dump) {
+      // The dump has the native stacks of all the threads, the JavaScript
+      // one is added to its crash keys.
+      static crash_reporter::CrashKeyString<1024> js_stack_key(
+          "hang_js_stack");
+      crash_reporter::ScopedCrashKeyString scoped_key(&js_stack_key,
+                                                      hang_.js_stack);
+      base::debug::DumpWithoutCrashing();
+    }
+  }
+
+  void End(base::TimeTicks beat) {
+    in_hang_ = false;
+    hang_.duration = beat - hang_beat_;
+    // The interrupt only runs once JavaScript runs again when the hang was
+    // in native code, which is usually right after it.
+    if (hang_.js_stack.empty())
+      hang_.js_stack = heartbeat_->TakeStack(/*done=*/true);
+    else
+      heartbeat_->TakeStack(/*done=*/true);
+    callback_.Run(hang_);
+  }
+
+  scoped_refptr<Heartbeat> heartbeat_;
+  const Options options_;
+  HangCallback callback_;
+
+  base::RepeatingTimer check_timer_;
+  base::OneShotTimer capture_timer_;
+
+  bool in_hang_ = false;
+  // The last beat before the hang.
+  base::TimeTicks hang_beat_;
+  Hang hang_;
+};
+
+HangWatchdog::Hang::Hang() = default;
+HangWatchdog::Hang::Hang(const Hang&) = default;
+HangWatchdog::Hang& HangWatchdog::Hang::operator=(const Hang&) = default;
+HangWatchdog::Hang::~Hang() = default;
+
+HangWatchdog::HangWatchdog(v8::Isolate* isolate,
+                           NodeBindings* node_bindings,
+                           const Options& options,
+                           HangCallback callback)
+    : callback_(std::move(callback)),
+      heartbeat_(base::MakeRefCounted<Heartbeat>(isolate)) {
+  heartbeat_->BeatMainThread();
+  const base::TimeDelta interval = options.threshold / 4;
+  // Unretained is safe as |heartbeat_timer_| is owned by |this|.
+  heartbeat_timer_.Start(FROM_HERE, interval,
+                         base::BindRepeating(&HangWatchdog::OnHeartbeatTimer,
+                                             base::Unretained(this)));
+
+  uv_timer_init(node_bindings->uv_loop(), uv_heartbeat_.get());
+  uv_heartbeat_.get()->data = heartbeat_.get();
+  uv_timer_start(uv_heartbeat_.get(), &HangWatchdog::OnUvHeartbeat, 0,
+                 interval.InMilliseconds());
+  // The heartbeat doesn't keep the loop alive.
+  uv_unref(uv_heartbeat_.handle());
+
+  monitor_ = base::SequenceBound<Monitor>(
+      base::ThreadPool::CreateSingleThreadTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+          base::SingleThreadTaskRunnerThreadMode::DEDICATED),
+      heartbeat_, options,
+      base::BindPostTaskToCurrentDefault(base::BindRepeating(
+          &HangWatchdog::OnHang, weak_factory_.GetWeakPtr())));
+}
+
+HangWatchdog::~HangWatchdog() {
+  // The monitor is destroyed on its thread, the isolate could be gone by
+  // then.
+  heartbeat_->Detach();
+  uv_timer_stop(uv_heartbeat_.get());
+}
+
+void HangWatchdog::OnHeartbeatTimer() {
+  heartbeat_->BeatMainThread();
+}
+
+// static
+void HangWatchdog::OnUvHeartbeat(uv_timer_t* timer) {
+  static_cast<Heartbeat*>(timer->data)->BeatUvLoop();
+}
+
+void HangWatchdog::OnHang(const Hang& hang) {
+  ++metrics_.count;
+  metrics_.total_duration += hang.duration;
+  metrics_.longest_duration =
+      std::max(metrics_.longest_duration, hang.duration);
+  callback_.Run(hang);
+}
+
+}  // namespace electron::api
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_HANG_WATCHDOG_H_
+#define ELECTRON_SHELL_BROWSER_API_HANG_WATCHDOG_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/common/node_bindings.h"
+#include "uv.h"  // NOLINT(build/include_directory)
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron::api {
+
+// Watches the UI thread of the main process and the libuv loop which runs on
+// it from a thread of its own, for app.setHangDetection(). Both send a
+// heartbeat every quarter of the threshold, a hang is when one of them
+// hasn't beaten for longer than the threshold. The watchdog then records the
+// JavaScript stack through a V8 interrupt, which runs as soon as JavaScript
+// runs, and writes a report, and a crash dump with the native stacks of all
+// the threads when asked to, without killing the process. Hangs are reported
+// to the UI thread once it beats again.
+class HangWatchdog {
+ public:
+  enum class Source {
+    // The UI thread didn't run its tasks.
+    kMainThread,
+    // The UI thread ran but the libuv loop didn't, node's timers and I/O
+    // are stalled.
+    kUvLoop,
+  };
+
+  struct Options {
+    base::TimeDelta threshold = base::Seconds(5);
+    // Where the reports are written, none are when empty.
+    base::FilePath report_directory;
+    // Whether a crash dump is uploaded by the crash reporter for each hang.
+    bool dump = false;
+  };
+
+  struct Hang {
+    Hang();
+    Hang(const Hang&);
+    Hang& operator=(const Hang&);
+    ~Hang();
+
+    Source source = Source::kMainThread;
+    base::Time start_time;
+    base::TimeDelta duration;
+    // Empty when no JavaScript ran before the hang was over.
+    std::string js_stack;
+    base::FilePath report_path;
+  };
+
+  struct Metrics {
+    uint64_t count = 0;
+    base::TimeDelta total_duration;
+    base::TimeDelta longest_duration;
+  };
+
+  using HangCallback = base::RepeatingCallback<void(const Hang& hang)>;
+
+  HangWatchdog(v8::Isolate* isolate,
+               NodeBindings* node_bindings,
+               const Options& options,
+               HangCallback callback);
+  ~HangWatchdog();
+
+  // disable copy
+  HangWatchdog(const HangWatchdog&) = delete;
+  HangWatchdog& operator=(const HangWatchdog&) = delete;
+
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  class Heartbeat;
+  class Monitor;
+
+  void OnHeartbeatTimer();
+  static void OnUvHeartbeat(uv_timer_t* timer);
+  void OnHang(const Hang& hang);
+
+  HangCallback callback_;
+  Metrics metrics_;
+
+  scoped_refptr<Heartbeat> heartbeat_;
+  base::RepeatingTimer heartbeat_timer_;
+  UvHandle<uv_timer_t> uv_heartbeat_;
+
+  // Lives on a thread of its own, so that it runs when the thread pool is
+  // busy too.
+  base::SequenceBound<Monitor> monitor_;
+
+  base::WeakPtrFactory<HangWatchdog> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_HANG_WATCHDOG_H_
@@ -0,0 +1,101 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/input_event_replay.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "ui/events/base_event_utils.h"
+
+namespace electron::api {
+
+namespace {
+
+bool IsMouseMove(const InputEventReplay::Event& event) {
+  const auto* mouse_event = std::get_if<blink::WebMouseEvent>(&event);
+  return mouse_event &&
+         mouse_event->GetType() == blink::WebInputEvent::Type::kMouseMove;
+}
+
+void SetTimeStamp(InputEventReplay::Event& event, base::TimeTicks time) {
+  std::visit([time](auto& input_event) { input_event.SetTimeStamp(time); },
+             event);
+}
+
+}  // namespace
+
+InputEventReplay::PendingEvent::PendingEvent() = default;
+InputEventReplay::PendingEvent::PendingEvent(PendingEvent&&) = default;
+InputEventReplay::PendingEvent& InputEventReplay::PendingEvent::operator=(
+    PendingEvent&&) = default;
+InputEventReplay::PendingEvent::~PendingEvent() = default;
+
+InputEventReplay::InputEventReplay(DispatchCallback dispatch)
+    : dispatch_(std::move(dispatch)) {}
+
+InputEventReplay::~InputEventReplay() = default;
+
+void InputEventReplay::Schedule(std::vector<ScheduledEvent> events,
+                                bool coalesce,
+                                base::OnceClosure done) {
+  if (events.empty()) {
+    std::move(done).Run();
+    return;
+  }
+  base::TimeTicks start = base::TimeTicks::Now();
+  if (!pending_.empty())
+    start = std::max(start, pending_.back().due);
+  for (ScheduledEvent& scheduled : events) {
+    PendingEvent pending;
+    pending.event = std::move(scheduled.event);
+    pending.due = start + scheduled.time;
+    pending.coalesce = coalesce;
+    pending_.push_back(std::move(pending));
+  }
+  pending_.back().done = std::move(done);
+
+  // The events of a batch which are due now are sent right away.
+  if (!timer_.IsRunning())
+    DispatchDueEvents();
+}
+
+void InputEventReplay::DispatchDueEvents() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  while (!pending_.empty() && pending_.front().due <= now) {
+    PendingEvent pending = std::move(pending_.front());
+    pending_.pop_front();
+    // The moves sent at once are merged into the last one, which adds up
+    // their movement.
+    if (pending.coalesce && !pending.done && IsMouseMove(pending.event)) {
+      auto& mouse_event = std::get<blink::WebMouseEvent>(pending.event);
+      while (!pending_.empty() && pending_.front().due <= now &&
+             pending_.front().coalesce && IsMouseMove(pending_.front().event)) {
+        const auto& next =
+            std::get<blink::WebMouseEvent>(pending_.front().event);
+        if (!mouse_event.CanCoalesce(next))
+          break;
+        mouse_event.Coalesce(next);
+        pending.done = std::move(pending_.front().done);
+        pending_.pop_front();
+        if (pending.done)
+          break;
+      }
+    }
+    SetTimeStamp(pending.event, ui::EventTimeForNow());
+    dispatch_.Run(pending.event);
+    if (pending.done)
+      std::move(pending.done).Run();
+  }
+
+  if (!pending_.empty()) {
+    // Unretained is safe as |timer_| is owned by |this|.
+    timer_.Start(FROM_HERE, pending_.front().due - now,
+                 base::BindOnce(&InputEventReplay::DispatchDueEvents,
+                                base::Unretained(this)));
+  }
+}
+
+}  // namespace electron::api
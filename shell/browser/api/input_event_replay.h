@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_INPUT_EVENT_REPLAY_H_
+#define ELECTRON_SHELL_BROWSER_API_INPUT_EVENT_REPLAY_H_
+
+#include <variant>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/functional/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "content/public/common/input/native_web_keyboard_event.h"
+#include "third_party/blink/public/common/input/web_mouse_event.h"
+#include "third_party/blink/public/common/input/web_mouse_wheel_event.h"
+
+namespace electron::api {
+
+// Sends the input events of webContents.sendInputEvents() at their time, one
+// batch after the other. The mouse moves which are sent together are
+// coalesced the way Chromium's input queues do.
+class InputEventReplay {
+ public:
+  using Event = std::variant<blink::WebMouseEvent,
+                             content::NativeWebKeyboardEvent,
+                             blink::WebMouseWheelEvent>;
+  using DispatchCallback = base::RepeatingCallback<void(const Event& event)>;
+
+  struct ScheduledEvent {
+    Event event;
+    // When the event is sent, after the start of its batch.
+    base::TimeDelta time;
+  };
+
+  explicit InputEventReplay(DispatchCallback dispatch);
+  ~InputEventReplay();
+
+  // disable copy
+  InputEventReplay(const InputEventReplay&) = delete;
+  InputEventReplay& operator=(const InputEventReplay&) = delete;
+
+  // The batch starts now, or once the batches before are sent. |done| is
+  // called once its last event is sent, it isn't when the replay is
+  // destroyed before.
+  void Schedule(std::vector<ScheduledEvent> events,
+                bool coalesce,
+                base::OnceClosure done);
+
+ private:
+  struct PendingEvent {
+    PendingEvent();
+    PendingEvent(PendingEvent&&);
+    PendingEvent& operator=(PendingEvent&&);
+    ~PendingEvent();
+
+    Event event;
+    base::TimeTicks due;
+    bool coalesce = false;
+    // Set on the last event of a batch.
+    base::OnceClosure done;
+  };
+
+  void DispatchDueEvents();
+
+  const DispatchCallback dispatch_;
+  base::circular_deque<PendingEvent> pending_;
+  base::OneShotTimer timer_;
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_INPUT_EVENT_REPLAY_H_
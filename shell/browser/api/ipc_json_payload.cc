@@ -0,0 +1,71 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/ipc_json_payload.h"
+
+#include <utility>
+
+#include "base/numerics/safe_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "v8/include/v8-json.h"
+
+namespace electron {
+
+gin::WrapperInfo IPCJSONPayload::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+IPCJSONPayload::IPCJSONPayload(mojo_base::BigBuffer json)
+    : json_(std::move(json)) {}
+
+IPCJSONPayload::~IPCJSONPayload() = default;
+
+// static
+gin::Handle<IPCJSONPayload> IPCJSONPayload::Create(v8::Isolate* isolate,
+                                                   mojo_base::BigBuffer json) {
+  return gin::CreateHandle(isolate, new IPCJSONPayload(std::move(json)));
+}
+
+v8::Local<v8::Value> IPCJSONPayload::GetValue(v8::Isolate* isolate) {
+  if (!value_.IsEmpty())
+    return value_.Get(isolate);
+  TRACE_EVENT1("electron", "IPCJSONPayload::GetValue", "size", json_.size());
+  v8::Local<v8::Value> json = GetJSON(isolate);
+  if (json.IsEmpty())
+    return v8::Local<v8::Value>();
+  v8::Local<v8::Value> value;
+  // A SyntaxError is left pending for the caller on invalid JSON.
+  if (!v8::JSON::Parse(isolate->GetCurrentContext(), json.As<v8::String>())
+           .ToLocal(&value)) {
+    return v8::Local<v8::Value>();
+  }
+  value_.Reset(isolate, value);
+  return value;
+}
+
+v8::Local<v8::Value> IPCJSONPayload::GetJSON(v8::Isolate* isolate) {
+  v8::Local<v8::String> json;
+  if (!v8::String::NewFromUtf8(isolate,
+                               reinterpret_cast<const char*>(json_.data()),
+                               v8::NewStringType::kNormal,
+                               base::checked_cast<int>(json_.size()))
+           .ToLocal(&json)) {
+    return v8::Local<v8::Value>();
+  }
+  return json;
+}
+
+gin::ObjectTemplateBuilder IPCJSONPayload::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<IPCJSONPayload>::GetObjectTemplateBuilder(isolate)
+      .SetProperty("value", &IPCJSONPayload::GetValue)
+      .SetProperty("json", &IPCJSONPayload::GetJSON)
+      .SetProperty("byteLength", &IPCJSONPayload::GetByteLength);
+}
+
+const char* IPCJSONPayload::GetTypeName() {
+  return "IPCJSONPayload";
+}
+
+}  // namespace electron
@@ -0,0 +1,51 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_IPC_JSON_PAYLOAD_H_
+#define ELECTRON_SHELL_BROWSER_API_IPC_JSON_PAYLOAD_H_
+
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "v8/include/v8-persistent-handle.h"
+
+namespace gin {
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+// The argument of ipcMain listeners for ipcRenderer.sendJSON(). Holds the UTF-8
+// JSON text received from the renderer and only parses it the first time
+// |value| is read.
+class IPCJSONPayload : public gin::Wrappable<IPCJSONPayload> {
+ public:
+  static gin::Handle<IPCJSONPayload> Create(v8::Isolate* isolate,
+                                            mojo_base::BigBuffer json);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  IPCJSONPayload(const IPCJSONPayload&) = delete;
+  IPCJSONPayload& operator=(const IPCJSONPayload&) = delete;
+
+ private:
+  explicit IPCJSONPayload(mojo_base::BigBuffer json);
+  ~IPCJSONPayload() override;
+
+  v8::Local<v8::Value> GetValue(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetJSON(v8::Isolate* isolate);
+  size_t GetByteLength() const { return json_.size(); }
+
+  mojo_base::BigBuffer json_;
+  v8::Global<v8::Value> value_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_IPC_JSON_PAYLOAD_H_
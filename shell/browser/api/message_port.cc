@@ -48,7 +48,10 @@ bool IsValidWrappable(const v8::Local<v8::Value>& obj) {
 
 gin::WrapperInfo MessagePort::kWrapperInfo = {gin::kEmbedderNativeGin};
 
-MessagePort::MessagePort() = default;
+// Unretained is safe as |buffered_amount_| is owned by |this|.
+MessagePort::MessagePort()
+    : buffered_amount_(base::BindRepeating(&MessagePort::OnWatermark,
+                                           base::Unretained(this))) {}
 MessagePort::~MessagePort() {
   if (!IsNeutered()) {
     // Disentangle before teardown. The MessagePortDescriptor will blow up if it
@@ -62,9 +65,9 @@ gin::Handle<MessagePort> MessagePort::Create(v8::Isolate* isolate) {
   return gin::CreateHandle(isolate, new MessagePort());
 }
 
-void MessagePort::PostMessage(gin::Arguments* args) {
+bool MessagePort::PostMessage(gin::Arguments* args) {
   if (!IsEntangled())
-    return;
+    return false;
   DCHECK(!IsNeutered());
 
   blink::TransferableMessage transferable_message;
@@ -73,34 +76,16 @@ void MessagePort::PostMessage(gin::Arguments* args) {
   v8::Local<v8::Value> message_value;
   if (!args->GetNext(&message_value)) {
     thrower.ThrowTypeError("Expected at least one argument to postMessage");
-    return;
+    return false;
   }
 
-  electron::SerializeV8Value(args->isolate(), message_value,
-                             &transferable_message);
-
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
-  if (args->GetNext(&transferables)) {
-    std::vector<v8::Local<v8::Value>> wrapped_port_values;
-    if (!gin::ConvertFromV8(args->isolate(), transferables,
-                            &wrapped_port_values)) {
-      thrower.ThrowTypeError("transferables must be an array of MessagePorts");
-      return;
-    }
-
-    for (unsigned i = 0; i < wrapped_port_values.size(); ++i) {
-      if (!IsValidWrappable(wrapped_port_values[i])) {
-        thrower.ThrowTypeError("Port at index " + base::NumberToString(i) +
-                               " is not a valid port");
-        return;
-      }
-    }
-
-    if (!gin::ConvertFromV8(args->isolate(), transferables, &wrapped_ports)) {
-      thrower.ThrowTypeError("Passed an invalid MessagePort");
-      return;
-    }
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables) &&
+      !GetTransferables(args->isolate(), transferables, &wrapped_ports,
+                        &array_buffers)) {
+    return false;
   }
 
   // Make sure we aren't connected to any of the passed-in ports.
@@ -108,19 +93,88 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     if (wrapped_ports[i].get() == this) {
       thrower.ThrowError("Port at index " + base::NumberToString(i) +
                          " contains the source port.");
-      return;
+      return false;
     }
   }
 
+  if (!electron::SerializeV8ValueWithTransfer(args->isolate(), message_value,
+                                              array_buffers,
+                                              &transferable_message)) {
+    // SerializeV8ValueWithTransfer sets an exception.
+    return false;
+  }
+
   bool threw_exception = false;
   transferable_message.ports = MessagePort::DisentanglePorts(
       args->isolate(), wrapped_ports, &threw_exception);
   if (threw_exception)
-    return;
+    return false;
+
+  return SendMessage(std::move(transferable_message));
+}
+
+bool MessagePort::PostMessages(v8::Isolate* isolate,
+                               v8::Local<v8::Value> messages) {
+  if (!IsEntangled())
+    return false;
+
+  std::vector<v8::Local<v8::Value>> message_values;
+  if (!gin::ConvertFromV8(isolate, messages, &message_values)) {
+    gin_helper::ErrorThrower(isolate).ThrowTypeError(
+        "messages must be an array");
+    return false;
+  }
+
+  // All of the messages are serialized first, so that none of them is sent
+  // if one can't be cloned.
+  std::vector<blink::TransferableMessage> transferable_messages(
+      message_values.size());
+  for (size_t i = 0; i < message_values.size(); ++i) {
+    if (!electron::SerializeV8Value(isolate, message_values[i],
+                                    &transferable_messages[i])) {
+      return false;
+    }
+  }
+
+  bool below_high_watermark = true;
+  for (auto& transferable_message : transferable_messages) {
+    // A 'buffered-amount-high' listener can close the port.
+    if (!IsEntangled())
+      return false;
+    below_high_watermark = SendMessage(std::move(transferable_message));
+  }
+  return below_high_watermark;
+}
 
-  mojo::Message mojo_message = blink::mojom::TransferableMessage::WrapAsMessage(
-      std::move(transferable_message));
+bool MessagePort::SendMessage(blink::TransferableMessage message) {
+  const uint64_t size = BufferedAmountTracker::GetMessageSize(message);
+  mojo::Message mojo_message =
+      blink::mojom::TransferableMessage::WrapAsMessage(std::move(message));
   connector_->Accept(&mojo_message);
+  buffered_amount_.OnMessagePosted(size);
+  return !buffered_amount_.is_above_high_watermark();
+}
+
+uint64_t MessagePort::GetBufferedAmount() {
+  return buffered_amount_.GetBufferedAmount();
+}
+
+void MessagePort::SetWatermarks(const gin_helper::Dictionary& options) {
+  uint64_t high = 0;
+  uint64_t low = 0;
+  options.Get("high", &high);
+  options.Get("low", &low);
+  buffered_amount_.SetWatermarks(high, low);
+}
+
+void MessagePort::OnWatermark(bool high) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate).ToLocal(&self)) {
+    gin_helper::EmitEvent(
+        isolate, self, high ? "buffered-amount-high" : "buffered-amount-low");
+  }
 }
 
 void MessagePort::Start() {
@@ -169,6 +223,7 @@ void MessagePort::Entangle(blink::MessagePortDescriptor port) {
   connector_->set_incoming_receiver(this);
   connector_->set_connection_error_handler(
       base::BindOnce(&MessagePort::Close, weak_factory_.GetWeakPtr()));
+  buffered_amount_.SetPipe(connector_->handle());
   if (HasPendingActivity())
     Pin();
 }
@@ -179,6 +234,7 @@ void MessagePort::Entangle(blink::MessagePortChannel channel) {
 
 blink::MessagePortChannel MessagePort::Disentangle() {
   DCHECK(!IsNeutered());
+  buffered_amount_.SetPipe(mojo::MessagePipeHandle());
   port_.GiveDisentangledHandle(connector_->PassMessagePipe());
   connector_ = nullptr;
   if (!HasPendingActivity())
@@ -208,6 +264,37 @@ std::vector<gin::Handle<MessagePort>> MessagePort::EntanglePorts(
   return wrapped_ports;
 }
 
+// static
+bool MessagePort::GetTransferables(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> transferables,
+    std::vector<gin::Handle<MessagePort>>* ports,
+    std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers) {
+  gin_helper::ErrorThrower thrower(isolate);
+  std::vector<v8::Local<v8::Value>> values;
+  if (!gin::ConvertFromV8(isolate, transferables, &values)) {
+    thrower.ThrowTypeError(
+        "transferables must be an array of MessagePorts and ArrayBuffers");
+    return false;
+  }
+
+  for (unsigned i = 0; i < values.size(); ++i) {
+    if (values[i]->IsArrayBuffer()) {
+      array_buffers->push_back(values[i].As<v8::ArrayBuffer>());
+      continue;
+    }
+    gin::Handle<MessagePort> port;
+    if (!IsValidWrappable(values[i]) ||
+        !gin::ConvertFromV8(isolate, values[i], &port)) {
+      thrower.ThrowTypeError("Port at index " + base::NumberToString(i) +
+                             " is not a valid port");
+      return false;
+    }
+    ports->push_back(port);
+  }
+  return true;
+}
+
 // static
 std::vector<blink::MessagePortChannel> MessagePort::DisentanglePorts(
     v8::Isolate* isolate,
@@ -273,7 +360,8 @@ bool MessagePort::Accept(mojo::Message* mojo_message) {
 
   auto ports = EntanglePorts(isolate, std::move(message.ports));
 
-  v8::Local<v8::Value> message_value = DeserializeV8Value(isolate, message);
+  v8::Local<v8::Value> message_value =
+      DeserializeV8ValueWithArrayBuffers(isolate, &message);
 
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
@@ -291,6 +379,9 @@ gin::ObjectTemplateBuilder MessagePort::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<MessagePort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &MessagePort::PostMessage)
+      .SetMethod("postMessages", &MessagePort::PostMessages)
+      .SetProperty("bufferedAmount", &MessagePort::GetBufferedAmount)
+      .SetMethod("setWatermarks", &MessagePort::SetWatermarks)
       .SetMethod("start", &MessagePort::Start)
       .SetMethod("close", &MessagePort::Close);
 }
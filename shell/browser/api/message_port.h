@@ -11,15 +11,24 @@
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "shell/common/buffered_amount_tracker.h"
 #include "third_party/blink/public/common/messaging/message_port_channel.h"
 #include "third_party/blink/public/common/messaging/message_port_descriptor.h"
 
+namespace blink {
+struct TransferableMessage;
+}
+
 namespace gin {
 class Arguments;
 template <typename T>
 class Handle;
 }  // namespace gin
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron {
 
 // A non-blink version of blink::MessagePort.
@@ -28,7 +37,10 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
   ~MessagePort() override;
   static gin::Handle<MessagePort> Create(v8::Isolate* isolate);
 
-  void PostMessage(gin::Arguments* args);
+  // Returns false once the peer has more than the high watermark to read.
+  bool PostMessage(gin::Arguments* args);
+  // Posts each of |messages|, or none of them if one can't be cloned.
+  bool PostMessages(v8::Isolate* isolate, v8::Local<v8::Value> messages);
   void Start();
   void Close();
 
@@ -44,6 +56,14 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
       v8::Isolate* isolate,
       std::vector<blink::MessagePortChannel> channels);
 
+  // Splits a transfer list into the ports and the ArrayBuffers it holds.
+  // Throws and returns false if it holds anything else.
+  static bool GetTransferables(
+      v8::Isolate* isolate,
+      v8::Local<v8::Value> transferables,
+      std::vector<gin::Handle<MessagePort>>* ports,
+      std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers);
+
   static std::vector<blink::MessagePortChannel> DisentanglePorts(
       v8::Isolate* isolate,
       const std::vector<gin::Handle<MessagePort>>& ports,
@@ -70,6 +90,11 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
   void Pin();
   void Unpin();
 
+  bool SendMessage(blink::TransferableMessage message);
+  uint64_t GetBufferedAmount();
+  void SetWatermarks(const gin_helper::Dictionary& options);
+  void OnWatermark(bool high);
+
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
@@ -83,6 +108,8 @@ class MessagePort : public gin::Wrappable<MessagePort>, mojo::MessageReceiver {
   // |connector_| while entangled.
   blink::MessagePortDescriptor port_;
 
+  BufferedAmountTracker buffered_amount_;
+
   base::WeakPtrFactory<MessagePort> weak_factory_{this};
 };
 
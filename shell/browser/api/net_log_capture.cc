@@ -0,0 +1,277 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/net_log_capture.h"
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_set.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+
+namespace electron::api {
+
+namespace {
+
+std::pair<base::FilePath, base::File> CreateSegment() {
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path))
+    return {};
+  base::File file(path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  return {std::move(path), std::move(file)};
+}
+
+}  // namespace
+
+// The ring buffer of the events, as JSON so that the size they take in the
+// log is known and snapshots don't serialize them again.
+class NetLogCapture::Buffer {
+ public:
+  Buffer(size_t max_size, std::vector<std::string> source_types)
+      : max_size_(max_size), source_types_(std::move(source_types)) {}
+
+  // disable copy
+  Buffer(const Buffer&) = delete;
+  Buffer& operator=(const Buffer&) = delete;
+
+  void Ingest(const base::FilePath& segment) {
+    std::string contents;
+    const bool read = base::ReadFileToString(segment, &contents);
+    base::DeleteFile(segment);
+    if (!read)
+      return;
+    absl::optional<base::Value> log = base::JSONReader::Read(contents);
+    contents.clear();
+    if (!log || !log->is_dict())
+      return;
+
+    if (const base::Value::Dict* constants =
+            log->GetDict().FindDict("constants")) {
+      base::JSONWriter::Write(*constants, &constants_);
+      // The ids of the source types are only known from the constants.
+      if (!source_types_.empty() && source_ids_.empty()) {
+        const base::Value::Dict* ids = constants->FindDict("logSourceType");
+        for (const std::string& type : source_types_) {
+          absl::optional<int> id = ids ? ids->FindInt(type) : absl::nullopt;
+          if (id)
+            source_ids_.insert(*id);
+        }
+      }
+    }
+
+    const base::Value::List* events = log->GetDict().FindList("events");
+    if (!events)
+      return;
+    for (const base::Value& event : *events) {
+      if (!source_types_.empty()) {
+        absl::optional<int> type =
+            event.is_dict() ? event.GetDict().FindIntByDottedPath("source.type")
+                            : absl::nullopt;
+        if (!type || !source_ids_.contains(*type))
+          continue;
+      }
+      std::string json;
+      if (!base::JSONWriter::Write(event, &json))
+        continue;
+      size_ += json.size() + 1;
+      events_.push_back(std::move(json));
+    }
+    while (size_ > max_size_ && !events_.empty()) {
+      size_ -= events_.front().size() + 1;
+      events_.pop_front();
+    }
+  }
+
+  absl::optional<std::string> Snapshot(const base::FilePath& path) {
+    std::string json;
+    json.reserve(size_ + constants_.size() + 32);
+    json.append("{\"constants\":");
+    json.append(constants_.empty() ? "{}" : constants_);
+    json.append(",\"events\":[");
+    for (size_t i = 0; i < events_.size(); ++i) {
+      if (i)
+        json.push_back(',');
+      json.append(events_[i]);
+    }
+    json.append("]}");
+    if (path.empty())
+      return json;
+    if (!base::WriteFile(path, json))
+      return absl::nullopt;
+    return std::string();
+  }
+
+ private:
+  const size_t max_size_;
+  const std::vector<std::string> source_types_;
+  base::flat_set<int> source_ids_;
+
+  std::string constants_;
+  base::circular_deque<std::string> events_;
+  // The size of the events with the commas between them.
+  size_t size_ = 0;
+};
+
+NetLogCapture::Options::Options() = default;
+NetLogCapture::Options::Options(const Options&) = default;
+NetLogCapture::Options& NetLogCapture::Options::operator=(const Options&) =
+    default;
+NetLogCapture::Options::~Options() = default;
+
+NetLogCapture::NetLogCapture(NetworkContextGetter network_context_getter,
+                             const Options& options,
+                             base::Value::Dict custom_constants)
+    : network_context_getter_(std::move(network_context_getter)),
+      options_(options),
+      custom_constants_(std::move(custom_constants)),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      buffer_(file_task_runner_, options.max_size, options.source_types) {}
+
+NetLogCapture::~NetLogCapture() {
+  if (!exporter_)
+    return;
+  // The segment can only be deleted once the network service closed it.
+  network::mojom::NetLogExporter* exporter = exporter_.get();
+  exporter->Stop(
+      base::Value::Dict(),
+      base::BindOnce(&NetLogCapture::OnSegmentStopped,
+                     base::WeakPtr<NetLogCapture>(), file_task_runner_,
+                     std::move(exporter_), segment_, base::DoNothing()));
+}
+
+void NetLogCapture::Start(StartedCallback started) {
+  started_ = std::move(started);
+  StartSegment();
+  // Unretained is safe as |flush_timer_| is owned by |this|.
+  flush_timer_.Start(FROM_HERE, options_.flush_interval,
+                     base::BindRepeating(&NetLogCapture::OnFlushTimer,
+                                         base::Unretained(this)));
+}
+
+void NetLogCapture::Snapshot(const base::FilePath& path,
+                             SnapshotCallback callback) {
+  Flush(base::BindOnce(
+      [](base::WeakPtr<NetLogCapture> capture, const base::FilePath& path,
+         SnapshotCallback callback) {
+        if (!capture)
+          return;
+        capture->buffer_.AsyncCall(&Buffer::Snapshot)
+            .WithArgs(path)
+            .Then(std::move(callback));
+      },
+      weak_factory_.GetWeakPtr(), path, std::move(callback)));
+}
+
+void NetLogCapture::StartSegment() {
+  creating_segment_ = true;
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CreateSegment),
+      base::BindOnce(
+          [](base::WeakPtr<NetLogCapture> capture,
+             scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+             std::pair<base::FilePath, base::File> segment) {
+            if (capture) {
+              capture->OnSegmentCreated(std::move(segment));
+            } else if (!segment.first.empty()) {
+              file_task_runner->PostTask(
+                  FROM_HERE, base::GetDeleteFileCallback(segment.first));
+            }
+          },
+          weak_factory_.GetWeakPtr(), file_task_runner_));
+}
+
+void NetLogCapture::OnSegmentCreated(
+    std::pair<base::FilePath, base::File> segment) {
+  creating_segment_ = false;
+  network::mojom::NetworkContext* network_context =
+      network_context_getter_.Run();
+  if (!segment.second.IsValid() || !network_context) {
+    if (!segment.first.empty())
+      file_task_runner_->PostTask(
+          FROM_HERE, base::GetDeleteFileCallback(segment.first));
+    if (started_)
+      std::move(started_).Run(net::ERR_FILE_NOT_FOUND);
+    return;
+  }
+
+  network_context->CreateNetLogExporter(
+      exporter_.BindNewPipeAndPassReceiver());
+  // Unretained is safe as |exporter_| is owned by |this|.
+  exporter_.set_disconnect_handler(base::BindOnce(
+      &NetLogCapture::OnExporterDisconnected, base::Unretained(this)));
+  segment_ = std::move(segment.first);
+  exporter_->Start(std::move(segment.second), custom_constants_.Clone(),
+                   options_.capture_mode, options_.max_size,
+                   base::BindOnce(&NetLogCapture::OnExporterStarted,
+                                  weak_factory_.GetWeakPtr()));
+}
+
+void NetLogCapture::OnExporterStarted(int32_t error) {
+  if (started_)
+    std::move(started_).Run(error);
+}
+
+void NetLogCapture::OnExporterDisconnected() {
+  // The network service crashed, a new segment is started by the next flush.
+  exporter_.reset();
+  if (!segment_.empty()) {
+    file_task_runner_->PostTask(FROM_HERE,
+                                base::GetDeleteFileCallback(segment_));
+    segment_.clear();
+  }
+  if (started_)
+    std::move(started_).Run(net::ERR_FAILED);
+}
+
+void NetLogCapture::Flush(base::OnceClosure flushed) {
+  if (!exporter_) {
+    if (!creating_segment_)
+      StartSegment();
+    std::move(flushed).Run();
+    return;
+  }
+  network::mojom::NetLogExporter* exporter = exporter_.get();
+  exporter->Stop(
+      base::Value::Dict(),
+      base::BindOnce(&NetLogCapture::OnSegmentStopped,
+                     weak_factory_.GetWeakPtr(), file_task_runner_,
+                     std::move(exporter_), std::move(segment_),
+                     std::move(flushed)));
+  segment_.clear();
+  // The next segment logs while this one is read.
+  StartSegment();
+}
+
+void NetLogCapture::OnFlushTimer() {
+  Flush(base::DoNothing());
+}
+
+// static
+void NetLogCapture::OnSegmentStopped(
+    base::WeakPtr<NetLogCapture> capture,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    mojo::Remote<network::mojom::NetLogExporter> exporter,
+    const base::FilePath& segment,
+    base::OnceClosure flushed,
+    int32_t error) {
+  if (!capture) {
+    file_task_runner->PostTask(FROM_HERE,
+                               base::GetDeleteFileCallback(segment));
+    return;
+  }
+  capture->buffer_.AsyncCall(&Buffer::Ingest)
+      .WithArgs(segment)
+      .Then(std::move(flushed));
+}
+
+}  // namespace electron::api
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_NET_LOG_CAPTURE_H_
+#define ELECTRON_SHELL_BROWSER_API_NET_LOG_CAPTURE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "net/log/net_log_capture_mode.h"
+#include "services/network/public/mojom/net_log.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace network::mojom {
+class NetworkContext;
+}
+
+namespace electron::api {
+
+// Keeps the most recent events of the net log in memory for
+// netLog.startCapture(), so that they can be looked at after a failure
+// without logging to a file that grows without bounds. The events are
+// logged by the network service, which can only write them to a file, so the
+// capture logs into a short-lived segment file which is read into the ring
+// buffer and deleted every |flush_interval|, and when a snapshot is taken.
+// The events of the source types which aren't captured are dropped then.
+class NetLogCapture {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    net::NetLogCaptureMode capture_mode = net::NetLogCaptureMode::kDefault;
+    // The size in bytes of the JSON of the events kept, the oldest events are
+    // dropped past it. A segment file doesn't grow past it either.
+    size_t max_size = 16 * 1024 * 1024;
+    // The names of the source types to keep the events of, such as
+    // URL_REQUEST or SOCKET, all of them when empty.
+    std::vector<std::string> source_types;
+    base::TimeDelta flush_interval = base::Seconds(10);
+  };
+
+  using NetworkContextGetter =
+      base::RepeatingCallback<network::mojom::NetworkContext*()>;
+  using StartedCallback = base::OnceCallback<void(int32_t error)>;
+  // Called with the JSON of the log, an empty string when it was written to
+  // a file, or nothing when it couldn't be written.
+  using SnapshotCallback =
+      base::OnceCallback<void(absl::optional<std::string> json)>;
+
+  NetLogCapture(NetworkContextGetter network_context_getter,
+                const Options& options,
+                base::Value::Dict custom_constants);
+  ~NetLogCapture();
+
+  // disable copy
+  NetLogCapture(const NetLogCapture&) = delete;
+  NetLogCapture& operator=(const NetLogCapture&) = delete;
+
+  void Start(StartedCallback started);
+
+  // Writes the log of the events kept to |path|, or passes it to |callback|
+  // when |path| is empty. The capture goes on.
+  void Snapshot(const base::FilePath& path, SnapshotCallback callback);
+
+ private:
+  class Buffer;
+
+  void StartSegment();
+  void OnSegmentCreated(std::pair<base::FilePath, base::File> segment);
+  void OnExporterStarted(int32_t error);
+  void OnExporterDisconnected();
+  // Stops logging into the current segment and starts a new one. |flushed|
+  // is called once the events of the stopped segment are in the buffer.
+  void Flush(base::OnceClosure flushed);
+  void OnFlushTimer();
+  static void OnSegmentStopped(
+      base::WeakPtr<NetLogCapture> capture,
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+      mojo::Remote<network::mojom::NetLogExporter> exporter,
+      const base::FilePath& segment,
+      base::OnceClosure flushed,
+      int32_t error);
+
+  const NetworkContextGetter network_context_getter_;
+  const Options options_;
+  const base::Value::Dict custom_constants_;
+
+  StartedCallback started_;
+
+  mojo::Remote<network::mojom::NetLogExporter> exporter_;
+  base::FilePath segment_;
+  bool creating_segment_ = false;
+
+  base::RepeatingTimer flush_timer_;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  // Lives on |file_task_runner_|, which also creates the segments.
+  base::SequenceBound<Buffer> buffer_;
+
+  base::WeakPtrFactory<NetLogCapture> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_NET_LOG_CAPTURE_H_
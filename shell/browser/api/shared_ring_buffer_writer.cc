@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/shared_ring_buffer_writer.h"
+
+#include <utility>
+
+#include "gin/arguments.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/shared_ring_buffer.h"
+#include "shell/common/v8_value_serializer.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+
+namespace electron {
+
+gin::WrapperInfo SharedRingBufferWriter::kWrapperInfo = {
+    gin::kEmbedderNativeGin};
+
+SharedRingBufferWriter::SharedRingBufferWriter(
+    std::unique_ptr<SharedRingBuffer> buffer,
+    mojo::PendingRemote<mojom::ElectronRingBufferReader> reader)
+    : buffer_(std::move(buffer)), reader_(std::move(reader)) {
+  // The reader went away, nobody will ever read what we write.
+  reader_.set_disconnect_handler(base::BindOnce(
+      &SharedRingBufferWriter::Close, base::Unretained(this)));
+}
+
+SharedRingBufferWriter::~SharedRingBufferWriter() = default;
+
+// static
+gin::Handle<SharedRingBufferWriter> SharedRingBufferWriter::Create(
+    v8::Isolate* isolate,
+    std::unique_ptr<SharedRingBuffer> buffer,
+    mojo::PendingRemote<mojom::ElectronRingBufferReader> reader) {
+  return gin::CreateHandle(isolate, new SharedRingBufferWriter(
+                                        std::move(buffer), std::move(reader)));
+}
+
+bool SharedRingBufferWriter::Write(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value)) {
+    args->ThrowTypeError("Expected a value to write");
+    return false;
+  }
+  if (IsClosed())
+    return false;
+
+  // Bytes are copied into the queue as they are, anything else goes through
+  // the structured clone algorithm like the rest of Electron's IPC.
+  auto type = SharedRingBufferRecordType::kSerializedValue;
+  base::span<const uint8_t> body;
+  blink::CloneableMessage message;
+  if (value->IsArrayBufferView()) {
+    auto view = value.As<v8::ArrayBufferView>();
+    auto backing_store = view->Buffer()->GetBackingStore();
+    type = SharedRingBufferRecordType::kBytes;
+    body = base::make_span(
+        static_cast<const uint8_t*>(backing_store->Data()) + view->ByteOffset(),
+        view->ByteLength());
+  } else {
+    if (!electron::SerializeV8Value(args->isolate(), value, &message))
+      return false;  // SerializeV8Value sets an exception.
+    body = message.encoded_message;
+  }
+
+  if (!buffer_->Write(base::as_bytes(base::make_span(&type, 1u)), body)) {
+    // The reader has scribbled over the header, stop talking to it.
+    if (buffer_->is_corrupted())
+      Close();
+    return false;
+  }
+  if (buffer_->TakeReaderWaiting())
+    reader_->Wake();
+  return true;
+}
+
+void SharedRingBufferWriter::Close() {
+  reader_.reset();
+  buffer_.reset();
+}
+
+bool SharedRingBufferWriter::IsClosed() const {
+  return !buffer_;
+}
+
+gin::ObjectTemplateBuilder SharedRingBufferWriter::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SharedRingBufferWriter>::GetObjectTemplateBuilder(
+             isolate)
+      .SetMethod("write", &SharedRingBufferWriter::Write)
+      .SetMethod("close", &SharedRingBufferWriter::Close)
+      .SetProperty("closed", &SharedRingBufferWriter::IsClosed);
+}
+
+const char* SharedRingBufferWriter::GetTypeName() {
+  return "SharedRingBufferWriter";
+}
+
+}  // namespace electron
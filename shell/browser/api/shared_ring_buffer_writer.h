@@ -0,0 +1,60 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_SHARED_RING_BUFFER_WRITER_H_
+#define ELECTRON_SHELL_BROWSER_API_SHARED_RING_BUFFER_WRITER_H_
+
+#include <memory>
+
+#include "electron/shell/common/api/api.mojom.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+class SharedRingBuffer;
+
+// The main process end of a shared memory queue whose other end is a
+// SharedRingBufferReader in a renderer, see webFrameMain.createRingBuffer().
+class SharedRingBufferWriter : public gin::Wrappable<SharedRingBufferWriter> {
+ public:
+  static gin::Handle<SharedRingBufferWriter> Create(
+      v8::Isolate* isolate,
+      std::unique_ptr<SharedRingBuffer> buffer,
+      mojo::PendingRemote<mojom::ElectronRingBufferReader> reader);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  SharedRingBufferWriter(const SharedRingBufferWriter&) = delete;
+  SharedRingBufferWriter& operator=(const SharedRingBufferWriter&) = delete;
+
+ private:
+  SharedRingBufferWriter(
+      std::unique_ptr<SharedRingBuffer> buffer,
+      mojo::PendingRemote<mojom::ElectronRingBufferReader> reader);
+  ~SharedRingBufferWriter() override;
+
+  bool Write(gin::Arguments* args);
+  void Close();
+  bool IsClosed() const;
+
+  std::unique_ptr<SharedRingBuffer> buffer_;
+  mojo::Remote<mojom::ElectronRingBufferReader> reader_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_SHARED_RING_BUFFER_WRITER_H_
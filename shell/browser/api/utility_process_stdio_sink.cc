@@ -0,0 +1,139 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/utility_process_stdio_sink.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+
+namespace electron {
+
+namespace {
+
+// Reads are as large as the pipe buffer of most platforms.
+constexpr size_t kReadSize = 64 * 1024;
+
+}  // namespace
+
+// static
+scoped_refptr<UtilityProcessStdioSink> UtilityProcessStdioSink::Start(
+    base::File pipe,
+    const Options& options) {
+  scoped_refptr<UtilityProcessStdioSink> sink(
+      new UtilityProcessStdioSink(options));
+  // The thread spends its life blocked on the pipe, which shouldn't take a
+  // worker from the pool.
+  base::ThreadPool::CreateSingleThreadTaskRunner(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::SingleThreadTaskRunnerThreadMode::DEDICATED)
+      ->PostTask(FROM_HERE, base::BindOnce(&UtilityProcessStdioSink::Read,
+                                           sink, std::move(pipe)));
+  return sink;
+}
+
+UtilityProcessStdioSink::UtilityProcessStdioSink(const Options& options)
+    : options_(options) {
+  if (is_buffered())
+    buffer_.resize(std::max<size_t>(options_.buffer_size, 1));
+}
+
+UtilityProcessStdioSink::~UtilityProcessStdioSink() = default;
+
+std::vector<uint8_t> UtilityProcessStdioSink::TakeBufferedOutput(
+    uint64_t* dropped) {
+  base::AutoLock auto_lock(lock_);
+  std::vector<uint8_t> output;
+  *dropped = dropped_;
+  dropped_ = 0;
+  if (!buffered_size_)
+    return output;
+  output.reserve(buffered_size_);
+  const size_t start =
+      (buffer_end_ + buffer_.size() - buffered_size_) % buffer_.size();
+  const size_t first = std::min(buffered_size_, buffer_.size() - start);
+  output.insert(output.end(), buffer_.begin() + start,
+                buffer_.begin() + start + first);
+  output.insert(output.end(), buffer_.begin(),
+                buffer_.begin() + (buffered_size_ - first));
+  buffered_size_ = 0;
+  return output;
+}
+
+void UtilityProcessStdioSink::Read(base::File pipe) {
+  if (!is_buffered())
+    OpenFile();
+  std::vector<uint8_t> data(kReadSize);
+  while (true) {
+    const int read = pipe.ReadAtCurrentPosNoBestEffort(
+        reinterpret_cast<char*>(data.data()), data.size());
+    // The child closed the pipe.
+    if (read <= 0)
+      break;
+    base::span<const uint8_t> chunk(data.data(), static_cast<size_t>(read));
+    if (is_buffered()) {
+      AppendToBuffer(chunk);
+    } else {
+      WriteToFile(chunk);
+    }
+  }
+}
+
+void UtilityProcessStdioSink::AppendToBuffer(base::span<const uint8_t> data) {
+  base::AutoLock auto_lock(lock_);
+  const size_t capacity = buffer_.size();
+  // Only the end of a chunk larger than the buffer is kept.
+  if (data.size() > capacity) {
+    dropped_ += data.size() - capacity;
+    data = data.last(capacity);
+  }
+  const size_t overflow = buffered_size_ + data.size() > capacity
+                              ? buffered_size_ + data.size() - capacity
+                              : 0;
+  dropped_ += overflow;
+  const size_t first = std::min(data.size(), capacity - buffer_end_);
+  memcpy(buffer_.data() + buffer_end_, data.data(), first);
+  memcpy(buffer_.data(), data.data() + first, data.size() - first);
+  buffer_end_ = (buffer_end_ + data.size()) % capacity;
+  buffered_size_ = std::min(capacity, buffered_size_ + data.size());
+}
+
+void UtilityProcessStdioSink::WriteToFile(base::span<const uint8_t> data) {
+  if (file_size_ + data.size() > options_.max_size && file_size_ > 0)
+    Rotate();
+  if (!file_.IsValid())
+    return;
+  if (file_.WriteAtCurrentPos(reinterpret_cast<const char*>(data.data()),
+                              data.size()) > 0) {
+    file_size_ += data.size();
+  }
+}
+
+void UtilityProcessStdioSink::OpenFile() {
+  file_.Initialize(options_.path, base::File::FLAG_OPEN_ALWAYS |
+                                      base::File::FLAG_APPEND);
+  file_size_ = file_.IsValid() ? std::max<int64_t>(file_.GetLength(), 0) : 0;
+}
+
+void UtilityProcessStdioSink::Rotate() {
+  file_.Close();
+  const base::FilePath& path = options_.path;
+  for (int i = options_.max_files - 1; i > 0; --i) {
+    base::FilePath from =
+        i == 1 ? path : path.AddExtensionASCII(base::NumberToString(i - 1));
+    base::ReplaceFile(from, path.AddExtensionASCII(base::NumberToString(i)),
+                      nullptr);
+  }
+  // Without old files to keep, the current one starts over.
+  base::DeleteFile(path);
+  OpenFile();
+}
+
+}  // namespace electron
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_UTILITY_PROCESS_STDIO_SINK_H_
+#define ELECTRON_SHELL_BROWSER_API_UTILITY_PROCESS_STDIO_SINK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+
+namespace electron {
+
+// Reads the stdout or stderr of a utility process on a dedicated thread and
+// writes it to a rotating file, or keeps the last bytes of it in memory, so
+// that the output of the child never goes through the UI thread. The thread
+// exits once the child closes its end of the pipe.
+class UtilityProcessStdioSink
+    : public base::RefCountedThreadSafe<UtilityProcessStdioSink> {
+ public:
+  struct Options {
+    // The file to write the output to. When empty, the output is kept in
+    // memory instead.
+    base::FilePath path;
+    // The file is rotated once it grows past this size, keeping up to
+    // |max_files| - 1 old files named <path>.1, <path>.2, etc.
+    uint64_t max_size = 10 * 1024 * 1024;
+    int max_files = 3;
+    // How many of the last bytes of the output are kept in memory.
+    size_t buffer_size = 64 * 1024;
+  };
+
+  // Starts reading from |pipe|, the read end of the child's stdio.
+  static scoped_refptr<UtilityProcessStdioSink> Start(base::File pipe,
+                                                      const Options& options);
+
+  // disable copy
+  UtilityProcessStdioSink(const UtilityProcessStdioSink&) = delete;
+  UtilityProcessStdioSink& operator=(const UtilityProcessStdioSink&) = delete;
+
+  bool is_buffered() const { return options_.path.empty(); }
+
+  // Returns the output kept in memory since the last call, and how many bytes
+  // were dropped because they didn't fit. Can be called from any thread.
+  std::vector<uint8_t> TakeBufferedOutput(uint64_t* dropped);
+
+ private:
+  friend class base::RefCountedThreadSafe<UtilityProcessStdioSink>;
+
+  explicit UtilityProcessStdioSink(const Options& options);
+  ~UtilityProcessStdioSink();
+
+  // Runs on the dedicated thread.
+  void Read(base::File pipe);
+  void AppendToBuffer(base::span<const uint8_t> data);
+  void WriteToFile(base::span<const uint8_t> data);
+  void OpenFile();
+  void Rotate();
+
+  const Options options_;
+
+  base::Lock lock_;
+  // A ring of |options_.buffer_size| bytes, |buffer_end_| is where the next
+  // byte is written.
+  std::vector<uint8_t> buffer_ GUARDED_BY(lock_);
+  size_t buffer_end_ GUARDED_BY(lock_) = 0;
+  size_t buffered_size_ GUARDED_BY(lock_) = 0;
+  uint64_t dropped_ GUARDED_BY(lock_) = 0;
+
+  // Only used on the dedicated thread.
+  base::File file_;
+  uint64_t file_size_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_UTILITY_PROCESS_STDIO_SINK_H_
@@ -0,0 +1,318 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/websocket_meter.h"
+
+#include <map>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log_capture_mode.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace electron::api {
+
+namespace {
+
+// A segment holds the events of one sample, the network service stops
+// logging into it past this size.
+constexpr uint64_t kMaxSegmentSize = 32 * 1024 * 1024;
+
+// The opcodes of the control frames, RFC 6455 section 5.5.
+constexpr int kOpcodePing = 0x9;
+constexpr int kOpcodePong = 0xA;
+
+// NetLogEventPhase::PHASE_END.
+constexpr int kPhaseEnd = 2;
+
+std::pair<base::FilePath, base::File> CreateSegment() {
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path))
+    return {};
+  base::File file(path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  return {std::move(path), std::move(file)};
+}
+
+void DeleteSegment(scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+                   const base::FilePath& segment) {
+  if (!segment.empty())
+    file_task_runner->PostTask(FROM_HERE, base::GetDeleteFileCallback(segment));
+}
+
+// The net log writes the numbers which don't fit in an int as strings.
+absl::optional<double> FindNumber(const base::Value::Dict& dict,
+                                  base::StringPiece key) {
+  const base::Value* value = dict.Find(key);
+  double number = 0;
+  if (!value)
+    return absl::nullopt;
+  if (value->is_int() || value->is_double())
+    return value->GetDouble();
+  if (value->is_string() && base::StringToDouble(value->GetString(), &number))
+    return number;
+  return absl::nullopt;
+}
+
+}  // namespace
+
+// Adds the frames of the segments up, for each socket.
+class WebSocketMeter::Parser {
+ public:
+  Parser() = default;
+
+  // disable copy
+  Parser(const Parser&) = delete;
+  Parser& operator=(const Parser&) = delete;
+
+  std::vector<Socket> Ingest(const base::FilePath& segment) {
+    std::string contents;
+    const bool read = base::ReadFileToString(segment, &contents);
+    base::DeleteFile(segment);
+    absl::optional<base::Value> log;
+    if (read)
+      log = base::JSONReader::Read(contents);
+    contents.clear();
+    if (log && log->is_dict())
+      IngestLog(log->GetDict());
+
+    std::vector<Socket> sockets;
+    for (auto it = sockets_.begin(); it != sockets_.end();) {
+      sockets.push_back(it->second.socket);
+      if (it->second.socket.closed)
+        it = sockets_.erase(it);
+      else
+        ++it;
+    }
+    return sockets;
+  }
+
+ private:
+  struct SocketState {
+    Socket socket;
+    // The time of the last ping which didn't get its pong yet, and whether
+    // it was sent.
+    absl::optional<double> ping_time;
+    bool ping_sent = false;
+    double total_ping_latency = 0;
+  };
+
+  void IngestLog(const base::Value::Dict& log) {
+    // The types of the events are only known from the constants.
+    if (const base::Value::Dict* types =
+            log.FindDictByDottedPath("constants.logEventTypes")) {
+      request_alive_ = types->FindInt("REQUEST_ALIVE").value_or(-1);
+      start_job_ = types->FindInt("URL_REQUEST_START_JOB").value_or(-1);
+      sent_frame_ = types->FindInt("WEBSOCKET_SENT_FRAME_HEADER").value_or(-1);
+      recv_frame_ = types->FindInt("WEBSOCKET_RECV_FRAME_HEADER").value_or(-1);
+    }
+
+    const base::Value::List* events = log.FindList("events");
+    if (!events)
+      return;
+    for (const base::Value& value : *events) {
+      if (!value.is_dict())
+        continue;
+      const base::Value::Dict& event = value.GetDict();
+      const absl::optional<int> type = event.FindInt("type");
+      const absl::optional<int> id = event.FindIntByDottedPath("source.id");
+      if (!type || !id)
+        continue;
+      const base::Value::Dict* params = event.FindDict("params");
+
+      if (*type == start_job_) {
+        const std::string* url = params ? params->FindString("url") : nullptr;
+        if (url && (base::StartsWith(*url, "ws://") ||
+                    base::StartsWith(*url, "wss://"))) {
+          urls_[*id] = *url;
+        }
+      } else if (*type == request_alive_) {
+        if (event.FindInt("phase") != kPhaseEnd)
+          continue;
+        urls_.erase(*id);
+        auto it = sockets_.find(*id);
+        if (it != sockets_.end())
+          it->second.socket.closed = true;
+      } else if ((*type == sent_frame_ || *type == recv_frame_) && params) {
+        const bool sent = *type == sent_frame_;
+        SocketState& state = sockets_[*id];
+        if (state.socket.url.empty()) {
+          auto url = urls_.find(*id);
+          if (url != urls_.end())
+            state.socket.url = url->second;
+        }
+        const uint64_t length =
+            FindNumber(*params, "payload_length").value_or(0);
+        if (sent) {
+          state.socket.frames_sent++;
+          state.socket.bytes_sent += length;
+        } else {
+          state.socket.frames_received++;
+          state.socket.bytes_received += length;
+        }
+
+        const absl::optional<int> opcode = params->FindInt("opcode");
+        const absl::optional<double> time = FindNumber(event, "time");
+        if (!opcode || !time)
+          continue;
+        if (*opcode == kOpcodePing) {
+          state.ping_time = time;
+          state.ping_sent = sent;
+        } else if (*opcode == kOpcodePong && state.ping_time &&
+                   state.ping_sent != sent) {
+          state.socket.pings++;
+          state.total_ping_latency += *time - *state.ping_time;
+          state.socket.ping_latency = base::Milliseconds(
+              state.total_ping_latency / state.socket.pings);
+          state.ping_time.reset();
+        }
+      }
+    }
+  }
+
+  int request_alive_ = -1;
+  int start_job_ = -1;
+  int sent_frame_ = -1;
+  int recv_frame_ = -1;
+
+  // The URLs of the handshakes which are still alive, by net log source.
+  std::map<int, std::string> urls_;
+  std::map<int, SocketState> sockets_;
+};
+
+WebSocketMeter::Socket::Socket() = default;
+WebSocketMeter::Socket::Socket(const Socket&) = default;
+WebSocketMeter::Socket& WebSocketMeter::Socket::operator=(const Socket&) =
+    default;
+WebSocketMeter::Socket::~Socket() = default;
+
+WebSocketMeter::WebSocketMeter(NetworkContextGetter network_context_getter,
+                               base::TimeDelta sample_interval)
+    : network_context_getter_(std::move(network_context_getter)),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      parser_(file_task_runner_) {
+  // Unretained is safe as |sample_timer_| is owned by |this|.
+  sample_timer_.Start(FROM_HERE, sample_interval,
+                      base::BindRepeating(&WebSocketMeter::OnSampleTimer,
+                                          base::Unretained(this)));
+}
+
+WebSocketMeter::~WebSocketMeter() {
+  if (!exporter_)
+    return;
+  // The segment can only be deleted once the network service closed it.
+  network::mojom::NetLogExporter* exporter = exporter_.get();
+  exporter->Stop(base::Value::Dict(),
+                 base::BindOnce(
+                     [](mojo::Remote<network::mojom::NetLogExporter>,
+                        scoped_refptr<base::SequencedTaskRunner> runner,
+                        const base::FilePath& segment,
+                        int32_t) { DeleteSegment(runner, segment); },
+                     std::move(exporter_), file_task_runner_, segment_));
+}
+
+void WebSocketMeter::Start(StartedCallback started) {
+  started_ = std::move(started);
+  StartSegment();
+}
+
+void WebSocketMeter::StartSegment() {
+  creating_segment_ = true;
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CreateSegment),
+      base::BindOnce(
+          [](base::WeakPtr<WebSocketMeter> meter,
+             scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+             std::pair<base::FilePath, base::File> segment) {
+            if (meter)
+              meter->OnSegmentCreated(std::move(segment));
+            else
+              DeleteSegment(file_task_runner, segment.first);
+          },
+          weak_factory_.GetWeakPtr(), file_task_runner_));
+}
+
+void WebSocketMeter::OnSegmentCreated(
+    std::pair<base::FilePath, base::File> segment) {
+  creating_segment_ = false;
+  network::mojom::NetworkContext* network_context =
+      network_context_getter_.Run();
+  if (!segment.second.IsValid() || !network_context) {
+    DeleteSegment(file_task_runner_, segment.first);
+    if (started_)
+      std::move(started_).Run(net::ERR_FILE_NOT_FOUND);
+    return;
+  }
+
+  network_context->CreateNetLogExporter(
+      exporter_.BindNewPipeAndPassReceiver());
+  // Unretained is safe as |exporter_| is owned by |this|.
+  exporter_.set_disconnect_handler(base::BindOnce(
+      &WebSocketMeter::OnExporterDisconnected, base::Unretained(this)));
+  segment_ = std::move(segment.first);
+  exporter_->Start(std::move(segment.second), base::Value::Dict(),
+                   net::NetLogCaptureMode::kDefault, kMaxSegmentSize,
+                   base::BindOnce(&WebSocketMeter::OnExporterStarted,
+                                  weak_factory_.GetWeakPtr()));
+}
+
+void WebSocketMeter::OnExporterStarted(int32_t error) {
+  if (started_)
+    std::move(started_).Run(error);
+}
+
+void WebSocketMeter::OnExporterDisconnected() {
+  // The network service crashed, a new segment is started by the next sample.
+  exporter_.reset();
+  DeleteSegment(file_task_runner_, segment_);
+  segment_.clear();
+  if (started_)
+    std::move(started_).Run(net::ERR_FAILED);
+}
+
+void WebSocketMeter::OnSampleTimer() {
+  if (!exporter_) {
+    if (!creating_segment_)
+      StartSegment();
+    return;
+  }
+  network::mojom::NetLogExporter* exporter = exporter_.get();
+  exporter->Stop(
+      base::Value::Dict(),
+      base::BindOnce(
+          [](base::WeakPtr<WebSocketMeter> meter,
+             scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+             mojo::Remote<network::mojom::NetLogExporter>,
+             const base::FilePath& segment, int32_t) {
+            if (!meter) {
+              DeleteSegment(file_task_runner, segment);
+              return;
+            }
+            meter->parser_.AsyncCall(&Parser::Ingest)
+                .WithArgs(segment)
+                .Then(base::BindOnce(&WebSocketMeter::OnSampled, meter));
+          },
+          weak_factory_.GetWeakPtr(), file_task_runner_, std::move(exporter_),
+          segment_));
+  segment_.clear();
+  // The next segment logs while this one is read.
+  StartSegment();
+}
+
+void WebSocketMeter::OnSampled(std::vector<Socket> sockets) {
+  sockets_ = std::move(sockets);
+}
+
+}  // namespace electron::api
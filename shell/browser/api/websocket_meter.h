@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_WEBSOCKET_METER_H_
+#define ELECTRON_SHELL_BROWSER_API_WEBSOCKET_METER_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/network/public/mojom/net_log.mojom.h"
+
+namespace network::mojom {
+class NetworkContext;
+}
+
+namespace electron::api {
+
+// Counts the frames of the WebSockets for netLog.startWebSocketMeter(). The
+// frames go from the renderer to the network service without passing through
+// the browser process, so the meter reads the headers of the frames which the
+// network service logs: it logs into a segment file which is read and deleted
+// every |sample_interval|, and the sockets are as of the last sample.
+class WebSocketMeter {
+ public:
+  struct Socket {
+    Socket();
+    Socket(const Socket&);
+    Socket& operator=(const Socket&);
+    ~Socket();
+
+    std::string url;
+    uint64_t frames_sent = 0;
+    uint64_t frames_received = 0;
+    // The payloads of the frames.
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+    // Between a ping and its pong, in either direction.
+    uint64_t pings = 0;
+    base::TimeDelta ping_latency;
+    // Closed sockets are reported by one sample.
+    bool closed = false;
+  };
+
+  using NetworkContextGetter =
+      base::RepeatingCallback<network::mojom::NetworkContext*()>;
+  using StartedCallback = base::OnceCallback<void(int32_t error)>;
+
+  WebSocketMeter(NetworkContextGetter network_context_getter,
+                 base::TimeDelta sample_interval);
+  ~WebSocketMeter();
+
+  // disable copy
+  WebSocketMeter(const WebSocketMeter&) = delete;
+  WebSocketMeter& operator=(const WebSocketMeter&) = delete;
+
+  void Start(StartedCallback started);
+
+  const std::vector<Socket>& sockets() const { return sockets_; }
+
+ private:
+  class Parser;
+
+  void StartSegment();
+  void OnSegmentCreated(std::pair<base::FilePath, base::File> segment);
+  void OnExporterStarted(int32_t error);
+  void OnExporterDisconnected();
+  void OnSampleTimer();
+  void OnSampled(std::vector<Socket> sockets);
+
+  const NetworkContextGetter network_context_getter_;
+
+  StartedCallback started_;
+
+  mojo::Remote<network::mojom::NetLogExporter> exporter_;
+  base::FilePath segment_;
+  bool creating_segment_ = false;
+
+  base::RepeatingTimer sample_timer_;
+
+  std::vector<Socket> sockets_;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  // Lives on |file_task_runner_|, which also creates the segments.
+  base::SequenceBound<Parser> parser_;
+
+  base::WeakPtrFactory<WebSocketMeter> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_WEBSOCKET_METER_H_
@@ -0,0 +1,193 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/async_process_singleton.h"
+
+#include <atomic>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+
+namespace electron {
+
+namespace {
+
+scoped_refptr<base::SingleThreadTaskRunner> CreateSingletonTaskRunner() {
+  // BLOCK_SHUTDOWN so that the lock is released before exiting.
+  static constexpr base::TaskTraits kTraits = {
+      base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+      base::TaskShutdownBehavior::BLOCK_SHUTDOWN};
+#if BUILDFLAG(IS_WIN)
+  // Pumps the messages of the window other instances send theirs to.
+  return base::ThreadPool::CreateCOMSTATaskRunner(
+      kTraits, base::SingleThreadTaskRunnerThreadMode::DEDICATED);
+#else
+  return base::ThreadPool::CreateSingleThreadTaskRunner(
+      kTraits, base::SingleThreadTaskRunnerThreadMode::DEDICATED);
+#endif
+}
+
+}  // namespace
+
+// Owns the ProcessSingleton, only used on the singleton thread besides
+// |accepting_messages_|.
+class AsyncProcessSingleton::Core {
+ public:
+  Core(const std::string& program_name,
+       const base::FilePath& user_data_dir,
+       std::vector<uint8_t> additional_data,
+       bool is_app_sandboxed,
+       scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+       base::WeakPtr<AsyncProcessSingleton> owner)
+      : program_name_(program_name),
+        user_data_dir_(user_data_dir),
+        additional_data_(std::move(additional_data)),
+        is_app_sandboxed_(is_app_sandboxed),
+        reply_task_runner_(std::move(reply_task_runner)),
+        owner_(std::move(owner)) {}
+
+  ~Core() {
+    if (process_singleton_)
+      process_singleton_->Cleanup();
+  }
+
+  // disable copy
+  Core(const Core&) = delete;
+  Core& operator=(const Core&) = delete;
+
+  ProcessSingleton::NotifyResult NotifyOtherProcessOrCreate() {
+    TRACE_EVENT0("electron",
+                 "AsyncProcessSingleton::NotifyOtherProcessOrCreate");
+    // The user data directory may not have been created yet.
+    base::CreateDirectoryAndGetError(user_data_dir_, nullptr);
+
+    auto callback =
+        base::BindRepeating(&Core::OnNotification, base::Unretained(this));
+#if BUILDFLAG(IS_WIN)
+    process_singleton_ = std::make_unique<ProcessSingleton>(
+        program_name_, user_data_dir_, additional_data_, is_app_sandboxed_,
+        callback);
+#else
+    process_singleton_ = std::make_unique<ProcessSingleton>(
+        user_data_dir_, additional_data_, callback);
+#endif
+
+    ProcessSingleton::NotifyResult result =
+        process_singleton_->NotifyOtherProcessOrCreate();
+    TRACE_EVENT_INSTANT1("electron", "AsyncProcessSingleton::Result",
+                         TRACE_EVENT_SCOPE_THREAD, "result",
+                         static_cast<int>(result));
+    if (result != ProcessSingleton::NotifyResult::PROCESS_NONE)
+      process_singleton_.reset();
+    return result;
+  }
+
+  void StartWatching() {
+    if (process_singleton_)
+      process_singleton_->StartWatching();
+  }
+
+  void StopAcceptingMessages() {
+    accepting_messages_.store(false, std::memory_order_relaxed);
+  }
+
+ private:
+  bool OnNotification(const base::CommandLine& command_line,
+                      const base::FilePath& current_directory,
+                      const std::vector<const uint8_t> additional_data) {
+    // Covers the time until the UI thread gets to the message.
+    const uint64_t trace_id = ++next_trace_id_;
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+        "electron", "AsyncProcessSingleton::SecondInstance",
+        TRACE_ID_LOCAL(trace_id), "additional_data_size",
+        additional_data.size());
+    std::vector<uint8_t> data(additional_data.begin(), additional_data.end());
+    reply_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&AsyncProcessSingleton::OnNotification,
+                                  owner_, command_line, current_directory,
+                                  std::move(data), trace_id));
+    // The other instance takes over if this one is going away.
+    return accepting_messages_.load(std::memory_order_relaxed);
+  }
+
+  const std::string program_name_;
+  const base::FilePath user_data_dir_;
+  // ProcessSingleton only keeps a span of it.
+  const std::vector<uint8_t> additional_data_;
+  const bool is_app_sandboxed_;
+
+  scoped_refptr<base::SequencedTaskRunner> reply_task_runner_;
+  base::WeakPtr<AsyncProcessSingleton> owner_;
+
+  std::unique_ptr<ProcessSingleton> process_singleton_;
+  std::atomic<bool> accepting_messages_{true};
+  uint64_t next_trace_id_ = 0;
+};
+
+AsyncProcessSingleton::AsyncProcessSingleton(
+    const std::string& program_name,
+    const base::FilePath& user_data_dir,
+    std::vector<uint8_t> additional_data,
+    bool is_app_sandboxed,
+    const NotificationCallback& notification_callback)
+    : notification_callback_(notification_callback),
+      task_runner_(CreateSingletonTaskRunner()),
+      core_(new Core(program_name,
+                     user_data_dir,
+                     std::move(additional_data),
+                     is_app_sandboxed,
+                     base::SequencedTaskRunner::GetCurrentDefault(),
+                     weak_factory_.GetWeakPtr()),
+            base::OnTaskRunnerDeleter(task_runner_)) {}
+
+AsyncProcessSingleton::~AsyncProcessSingleton() {
+  core_->StopAcceptingMessages();
+}
+
+void AsyncProcessSingleton::NotifyOtherProcessOrCreate(
+    ResultCallback callback) {
+  // Includes the time spent waiting for the singleton thread.
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
+      "electron", "AsyncProcessSingleton::RequestLock", TRACE_ID_LOCAL(this));
+  // |core_| is deleted on |task_runner_|, after this task.
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&Core::NotifyOtherProcessOrCreate,
+                     base::Unretained(core_.get())),
+      base::BindOnce(
+          [](const void* trace_id, ResultCallback callback,
+             ProcessSingleton::NotifyResult result) {
+            TRACE_EVENT_NESTABLE_ASYNC_END0(
+                "electron", "AsyncProcessSingleton::RequestLock",
+                TRACE_ID_LOCAL(trace_id));
+            std::move(callback).Run(result);
+          },
+          this, std::move(callback)));
+}
+
+void AsyncProcessSingleton::StartWatching() {
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Core::StartWatching,
+                                        base::Unretained(core_.get())));
+}
+
+void AsyncProcessSingleton::OnNotification(
+    const base::CommandLine& command_line,
+    const base::FilePath& current_directory,
+    std::vector<uint8_t> additional_data,
+    uint64_t trace_id) {
+  TRACE_EVENT_NESTABLE_ASYNC_END0("electron",
+                                  "AsyncProcessSingleton::SecondInstance",
+                                  TRACE_ID_LOCAL(trace_id));
+  notification_callback_.Run(command_line, current_directory,
+                             std::move(additional_data));
+}
+
+}  // namespace electron
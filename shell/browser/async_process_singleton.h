@@ -0,0 +1,79 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_ASYNC_PROCESS_SINGLETON_H_
+#define ELECTRON_SHELL_BROWSER_ASYNC_PROCESS_SINGLETON_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/single_thread_task_runner.h"
+#include "chrome/browser/process_singleton.h"
+
+namespace base {
+class CommandLine;
+}
+
+namespace electron {
+
+// A ProcessSingleton living on a dedicated thread, so that neither taking the
+// lock, which may wait for the primary instance to respond, nor receiving the
+// messages of later instances blocks the UI thread. ProcessSingleton has to
+// stay on the thread it was created on, Windows dispatches the messages of
+// its window there.
+class AsyncProcessSingleton {
+ public:
+  // Runs on the UI thread for each message of another instance.
+  using NotificationCallback =
+      base::RepeatingCallback<void(const base::CommandLine& command_line,
+                                   const base::FilePath& current_directory,
+                                   std::vector<uint8_t> additional_data)>;
+  using ResultCallback =
+      base::OnceCallback<void(ProcessSingleton::NotifyResult result)>;
+
+  AsyncProcessSingleton(const std::string& program_name,
+                        const base::FilePath& user_data_dir,
+                        std::vector<uint8_t> additional_data,
+                        bool is_app_sandboxed,
+                        const NotificationCallback& notification_callback);
+  // Releases the lock, if it was taken.
+  ~AsyncProcessSingleton();
+
+  // disable copy
+  AsyncProcessSingleton(const AsyncProcessSingleton&) = delete;
+  AsyncProcessSingleton& operator=(const AsyncProcessSingleton&) = delete;
+
+  // Same as ProcessSingleton::NotifyOtherProcessOrCreate(), with |callback|
+  // running on the calling sequence. Must only be called once.
+  void NotifyOtherProcessOrCreate(ResultCallback callback);
+
+  // Starts listening to other instances once the lock was taken. Requires the
+  // IO thread.
+  void StartWatching();
+
+ private:
+  class Core;
+
+  void OnNotification(const base::CommandLine& command_line,
+                      const base::FilePath& current_directory,
+                      std::vector<uint8_t> additional_data,
+                      uint64_t trace_id);
+
+  NotificationCallback notification_callback_;
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+  std::unique_ptr<Core, base::OnTaskRunnerDeleter> core_;
+
+  base::WeakPtrFactory<AsyncProcessSingleton> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_ASYNC_PROCESS_SINGLETON_H_
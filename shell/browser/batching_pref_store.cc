@@ -0,0 +1,185 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/batching_pref_store.h"
+
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
+#include "components/prefs/json_pref_store.h"
+
+namespace electron {
+
+BatchingPrefStore::BatchingPrefStore(scoped_refptr<JsonPrefStore> store,
+                                     const base::FilePath& path)
+    : store_(std::move(store)), path_(path) {
+  store_->AddObserver(this);
+  WatchNextWrite();
+}
+
+BatchingPrefStore::~BatchingPrefStore() {
+  store_->RemoveObserver(this);
+  // The trailing batch is written before quitting.
+  if (commit_timer_.IsRunning())
+    store_->CommitPendingWrite();
+}
+
+void BatchingPrefStore::SetCommitInterval(base::TimeDelta interval) {
+  commit_interval_ = interval;
+  // The changes held back so far are written with the new schedule.
+  if (commit_timer_.IsRunning())
+    CommitBatch();
+}
+
+void BatchingPrefStore::AddObserver(PrefStore::Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void BatchingPrefStore::RemoveObserver(PrefStore::Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+bool BatchingPrefStore::HasObservers() const {
+  return !observers_.empty();
+}
+
+bool BatchingPrefStore::IsInitializationComplete() const {
+  return store_->IsInitializationComplete();
+}
+
+bool BatchingPrefStore::GetValue(base::StringPiece key,
+                                 const base::Value** result) const {
+  return store_->GetValue(key, result);
+}
+
+base::Value::Dict BatchingPrefStore::GetValues() const {
+  return store_->GetValues();
+}
+
+void BatchingPrefStore::SetValue(const std::string& key,
+                                 base::Value value,
+                                 uint32_t flags) {
+  store_->SetValue(key, std::move(value), BatchChange(flags));
+}
+
+void BatchingPrefStore::RemoveValue(const std::string& key, uint32_t flags) {
+  store_->RemoveValue(key, BatchChange(flags));
+}
+
+bool BatchingPrefStore::GetMutableValue(const std::string& key,
+                                        base::Value** result) {
+  return store_->GetMutableValue(key, result);
+}
+
+void BatchingPrefStore::ReportValueChanged(const std::string& key,
+                                           uint32_t flags) {
+  store_->ReportValueChanged(key, BatchChange(flags));
+}
+
+void BatchingPrefStore::SetValueSilently(const std::string& key,
+                                         base::Value value,
+                                         uint32_t flags) {
+  store_->SetValueSilently(key, std::move(value), BatchChange(flags));
+}
+
+void BatchingPrefStore::RemoveValuesByPrefixSilently(
+    const std::string& prefix) {
+  store_->RemoveValuesByPrefixSilently(prefix);
+}
+
+bool BatchingPrefStore::ReadOnly() const {
+  return store_->ReadOnly();
+}
+
+PersistentPrefStore::PrefReadError BatchingPrefStore::GetReadError() const {
+  return store_->GetReadError();
+}
+
+PersistentPrefStore::PrefReadError BatchingPrefStore::ReadPrefs() {
+  return store_->ReadPrefs();
+}
+
+void BatchingPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
+  store_->ReadPrefsAsync(error_delegate);
+}
+
+void BatchingPrefStore::CommitPendingWrite(
+    base::OnceClosure reply_callback,
+    base::OnceClosure synchronous_done_callback) {
+  // The batch is part of the pending write.
+  commit_timer_.Stop();
+  store_->CommitPendingWrite(std::move(reply_callback),
+                             std::move(synchronous_done_callback));
+}
+
+void BatchingPrefStore::SchedulePendingLossyWrites() {
+  store_->SchedulePendingLossyWrites();
+}
+
+void BatchingPrefStore::OnStoreDeletionFromDisk() {
+  commit_timer_.Stop();
+  store_->OnStoreDeletionFromDisk();
+}
+
+void BatchingPrefStore::OnPrefValueChanged(const std::string& key) {
+  for (PrefStore::Observer& observer : observers_)
+    observer.OnPrefValueChanged(key);
+}
+
+void BatchingPrefStore::OnInitializationCompleted(bool succeeded) {
+  for (PrefStore::Observer& observer : observers_)
+    observer.OnInitializationCompleted(succeeded);
+}
+
+uint32_t BatchingPrefStore::BatchChange(uint32_t flags) {
+  if (commit_interval_.is_zero())
+    return flags;
+  write_stats_.batched_changes++;
+  // The first change of a batch starts the interval.
+  if (!commit_timer_.IsRunning()) {
+    // Unretained is safe as |commit_timer_| is owned by |this|.
+    commit_timer_.Start(FROM_HERE, commit_interval_,
+                        base::BindOnce(&BatchingPrefStore::CommitBatch,
+                                       base::Unretained(this)));
+  }
+  return flags | WriteablePrefStore::LOSSY_PREF_WRITE_FLAG;
+}
+
+void BatchingPrefStore::CommitBatch() {
+  commit_timer_.Stop();
+  // Lossy changes are only written by a commit, which writes right away
+  // instead of after the delay of JsonPrefStore.
+  store_->CommitPendingWrite();
+}
+
+void BatchingPrefStore::WatchNextWrite() {
+  store_->RegisterOnNextSuccessfulWriteReply(base::BindOnce(
+      &BatchingPrefStore::OnWrite, weak_factory_.GetWeakPtr()));
+}
+
+void BatchingPrefStore::OnWrite() {
+  write_stats_.writes++;
+  WatchNextWrite();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(
+          [](const base::FilePath& path) -> absl::optional<int64_t> {
+            int64_t size = 0;
+            if (!base::GetFileSize(path, &size))
+              return absl::nullopt;
+            return size;
+          },
+          path_),
+      base::BindOnce(&BatchingPrefStore::OnFileSize,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void BatchingPrefStore::OnFileSize(absl::optional<int64_t> size) {
+  if (size)
+    write_stats_.bytes += *size;
+}
+
+}  // namespace electron
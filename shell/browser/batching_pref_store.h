@@ -0,0 +1,112 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_BATCHING_PREF_STORE_H_
+#define ELECTRON_SHELL_BROWSER_BATCHING_PREF_STORE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/observer_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/prefs/persistent_pref_store.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class JsonPrefStore;
+
+namespace electron {
+
+// Wraps the JsonPrefStore of a browser context to count its writes and to
+// write the changes at most once per commit interval. JsonPrefStore writes
+// the whole file a few seconds after each change, when batching the changes
+// are marked lossy so that it doesn't schedule the write itself, and they
+// are all committed once the interval is over, or when the store is
+// destroyed at quit.
+class BatchingPrefStore : public PersistentPrefStore,
+                          public PrefStore::Observer {
+ public:
+  struct WriteStats {
+    uint64_t writes = 0;
+    // The size of the file after each write, summed.
+    uint64_t bytes = 0;
+    // The changes which were held back to be written together.
+    uint64_t batched_changes = 0;
+  };
+
+  BatchingPrefStore(scoped_refptr<JsonPrefStore> store,
+                    const base::FilePath& path);
+
+  // disable copy
+  BatchingPrefStore(const BatchingPrefStore&) = delete;
+  BatchingPrefStore& operator=(const BatchingPrefStore&) = delete;
+
+  // A zero |interval| leaves the writes to JsonPrefStore.
+  void SetCommitInterval(base::TimeDelta interval);
+  base::TimeDelta commit_interval() const { return commit_interval_; }
+  const WriteStats& write_stats() const { return write_stats_; }
+
+  // PrefStore:
+  void AddObserver(PrefStore::Observer* observer) override;
+  void RemoveObserver(PrefStore::Observer* observer) override;
+  bool HasObservers() const override;
+  bool IsInitializationComplete() const override;
+  bool GetValue(base::StringPiece key,
+                const base::Value** result) const override;
+  base::Value::Dict GetValues() const override;
+
+  // WriteablePrefStore:
+  void SetValue(const std::string& key,
+                base::Value value,
+                uint32_t flags) override;
+  void RemoveValue(const std::string& key, uint32_t flags) override;
+  bool GetMutableValue(const std::string& key, base::Value** result) override;
+  void ReportValueChanged(const std::string& key, uint32_t flags) override;
+  void SetValueSilently(const std::string& key,
+                        base::Value value,
+                        uint32_t flags) override;
+  void RemoveValuesByPrefixSilently(const std::string& prefix) override;
+
+  // PersistentPrefStore:
+  bool ReadOnly() const override;
+  PrefReadError GetReadError() const override;
+  PrefReadError ReadPrefs() override;
+  void ReadPrefsAsync(ReadErrorDelegate* error_delegate) override;
+  void CommitPendingWrite(
+      base::OnceClosure reply_callback = base::OnceClosure(),
+      base::OnceClosure synchronous_done_callback =
+          base::OnceClosure()) override;
+  void SchedulePendingLossyWrites() override;
+  void OnStoreDeletionFromDisk() override;
+
+ private:
+  ~BatchingPrefStore() override;
+
+  // PrefStore::Observer:
+  void OnPrefValueChanged(const std::string& key) override;
+  void OnInitializationCompleted(bool succeeded) override;
+
+  // Returns the flags to pass to |store_| for a change with |flags|.
+  uint32_t BatchChange(uint32_t flags);
+  void CommitBatch();
+  void WatchNextWrite();
+  void OnWrite();
+  void OnFileSize(absl::optional<int64_t> size);
+
+  scoped_refptr<JsonPrefStore> store_;
+  const base::FilePath path_;
+  base::TimeDelta commit_interval_;
+  base::OneShotTimer commit_timer_;
+  WriteStats write_stats_;
+  base::ObserverList<PrefStore::Observer, true> observers_;
+
+  base::WeakPtrFactory<BatchingPrefStore> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_BATCHING_PREF_STORE_H_
@@ -23,6 +23,7 @@
 #include "shell/common/application_info.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_helper/arguments.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 
 namespace electron {
@@ -198,6 +199,7 @@ void Browser::DidFinishLaunching(base::Value::Dict launch_info) {
   }
 
   is_ready_ = true;
+  startup_timeline::Mark(startup_timeline::Phase::kAppReady);
   if (ready_promise_) {
     ready_promise_->Resolve();
   }
@@ -296,6 +298,16 @@ void Browser::DidResignActive() {
   for (BrowserObserver& observer : observers_)
     observer.OnDidResignActive();
 }
+
+void Browser::DidHide() {
+  for (BrowserObserver& observer : observers_)
+    observer.OnDidHide();
+}
+
+void Browser::DidUnhide() {
+  for (BrowserObserver& observer : observers_)
+    observer.OnDidUnhide();
+}
 #endif
 
 }  // namespace electron
@@ -282,6 +282,9 @@ class Browser : public WindowListObserver {
   void DidBecomeActive();
   // Indicate that the app is no longer active and doesn’t have focus.
   void DidResignActive();
+  // Indicate that the app was hidden or unhidden.
+  void DidHide();
+  void DidUnhide();
 
 #endif  // BUILDFLAG(IS_MAC)
 
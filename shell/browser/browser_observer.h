@@ -82,6 +82,10 @@ class BrowserObserver : public base::CheckedObserver {
   virtual void OnDidBecomeActive() {}
   // Browser lost active status.
   virtual void OnDidResignActive() {}
+
+  // Browser was hidden or unhidden, with all its windows.
+  virtual void OnDidHide() {}
+  virtual void OnDidUnhide() {}
 #endif
 
  protected:
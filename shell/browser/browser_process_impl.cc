@@ -10,6 +10,7 @@
 
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/functional/bind.h"
 #include "base/path_service.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_paths.h"
@@ -24,6 +25,8 @@
 #include "components/proxy_config/pref_proxy_config_tracker_impl.h"
 #include "components/proxy_config/proxy_config_dictionary.h"
 #include "components/proxy_config/proxy_config_pref_names.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/browser/network_quality_observer_factory.h"
 #include "content/public/browser/network_service_instance.h"
@@ -36,6 +39,7 @@
 #include "services/device/public/cpp/geolocation/geolocation_manager.h"
 #include "services/network/public/cpp/network_switches.h"
 #include "shell/common/electron_paths.h"
+#include "shell/common/startup_timeline.h"
 #include "shell/common/thread_restrictions.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -128,7 +132,14 @@ void BrowserProcessImpl::PreCreateThreads() {
 }
 
 void BrowserProcessImpl::PreMainMessageLoopRun() {
-  CreateNetworkQualityObserver();
+  // The observer only sends the estimates of the network quality to the
+  // renderers, it is created once the startup tasks ran so that it doesn't
+  // compete with the first window.
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(
+          FROM_HERE,
+          base::BindOnce(&BrowserProcessImpl::CreateNetworkQualityObserver,
+                         weak_factory_.GetWeakPtr()));
 }
 
 void BrowserProcessImpl::PostMainMessageLoopRun() {
@@ -336,6 +347,8 @@ network::NetworkQualityTracker* BrowserProcessImpl::GetNetworkQualityTracker() {
 }
 
 void BrowserProcessImpl::CreateNetworkQualityObserver() {
+  electron::startup_timeline::ScopedPhase phase(
+      electron::startup_timeline::Phase::kCreateNetworkQualityObserver);
   DCHECK(!network_quality_observer_);
   network_quality_observer_ =
       content::CreateNetworkQualityObserver(GetNetworkQualityTracker());
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "base/command_line.h"
+#include "base/memory/weak_ptr.h"
 #include "chrome/browser/browser_process.h"
 #include "components/embedder_support/origin_trials/origin_trials_settings_storage.h"
 #include "components/prefs/pref_service.h"
@@ -126,6 +127,8 @@ class BrowserProcessImpl : public BrowserProcess {
   std::unique_ptr<
       network::NetworkQualityTracker::RTTAndThroughputEstimatesObserver>
       network_quality_observer_;
+
+  base::WeakPtrFactory<BrowserProcessImpl> weak_factory_{this};
 };
 
 #endif  // ELECTRON_SHELL_BROWSER_BROWSER_PROCESS_IMPL_H_
@@ -0,0 +1,54 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/direct_ipc_channel_registry.h"
+
+#include <iterator>
+
+#include "base/containers/cxx20_erase_vector.h"
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+
+namespace electron {
+
+// static
+DirectIPCChannelRegistry* DirectIPCChannelRegistry::GetInstance() {
+  static base::NoDestructor<DirectIPCChannelRegistry> instance;
+  return instance.get();
+}
+
+DirectIPCChannelRegistry::DirectIPCChannelRegistry() = default;
+
+DirectIPCChannelRegistry::~DirectIPCChannelRegistry() = default;
+
+void DirectIPCChannelRegistry::Add(const Channel& channel) {
+  auto it = base::ranges::find_if(channels_, [&](const Channel& existing) {
+    return existing.sender_frame == channel.sender_frame &&
+           existing.target_id == channel.target_id;
+  });
+  if (it != channels_.end())
+    *it = channel;
+  else
+    channels_.push_back(channel);
+}
+
+void DirectIPCChannelRegistry::RemoveFrame(
+    content::GlobalRenderFrameHostId frame) {
+  base::EraseIf(channels_, [frame](const Channel& channel) {
+    return channel.sender_frame == frame || channel.target_frame == frame;
+  });
+}
+
+std::vector<DirectIPCChannelRegistry::Channel>
+DirectIPCChannelRegistry::GetChannels(int32_t web_contents_id) const {
+  std::vector<Channel> result;
+  base::ranges::copy_if(channels_, std::back_inserter(result),
+                        [web_contents_id](const Channel& channel) {
+                          return channel.sender_id == web_contents_id ||
+                                 channel.target_id == web_contents_id;
+                        });
+  return result;
+}
+
+}  // namespace electron
@@ -0,0 +1,52 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_DIRECT_IPC_CHANNEL_REGISTRY_H_
+#define ELECTRON_SHELL_BROWSER_DIRECT_IPC_CHANNEL_REGISTRY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "content/public/browser/global_routing_id.h"
+
+namespace electron {
+
+// Keeps track of the channels brokered between renderers for
+// ipcRenderer.sendTo(), see webContents.getDirectIPCChannels(). The channels
+// themselves are owned by the renderers at both ends, a channel is forgotten
+// once the frame at either end is deleted. Only used on the UI thread.
+class DirectIPCChannelRegistry {
+ public:
+  struct Channel {
+    int32_t sender_id;
+    content::GlobalRenderFrameHostId sender_frame;
+    int32_t target_id;
+    content::GlobalRenderFrameHostId target_frame;
+  };
+
+  static DirectIPCChannelRegistry* GetInstance();
+
+  DirectIPCChannelRegistry();
+  ~DirectIPCChannelRegistry();
+
+  // disable copy
+  DirectIPCChannelRegistry(const DirectIPCChannelRegistry&) = delete;
+  DirectIPCChannelRegistry& operator=(const DirectIPCChannelRegistry&) =
+      delete;
+
+  // Replaces the channel from the same sender frame to the same target, if
+  // any, since the sender only opens a new one after losing the old one.
+  void Add(const Channel& channel);
+  void RemoveFrame(content::GlobalRenderFrameHostId frame);
+
+  // The channels whose sender or target is |web_contents_id|.
+  std::vector<Channel> GetChannels(int32_t web_contents_id) const;
+
+ private:
+  std::vector<Channel> channels_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_DIRECT_IPC_CHANNEL_REGISTRY_H_
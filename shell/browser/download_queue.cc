@@ -0,0 +1,192 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/download_queue.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+
+namespace electron {
+
+namespace {
+
+constexpr base::TimeDelta kRateLimiterInterval = base::Milliseconds(100);
+
+}  // namespace
+
+DownloadQueue::DownloadQueue() = default;
+
+DownloadQueue::~DownloadQueue() {
+  for (const auto& [item, entry] : entries_)
+    item->RemoveObserver(this);
+}
+
+void DownloadQueue::SetOptions(const Options& options) {
+  options_ = options;
+  Schedule();
+  UpdateRateLimiter();
+}
+
+void DownloadQueue::SetPriority(const std::string& guid, int priority) {
+  priorities_[guid] = priority;
+}
+
+void DownloadQueue::AddDownload(download::DownloadItem* item) {
+  int priority = 0;
+  if (auto it = priorities_.find(item->GetGuid()); it != priorities_.end()) {
+    priority = it->second;
+    priorities_.erase(it);
+  }
+  if (item->GetState() != download::DownloadItem::IN_PROGRESS ||
+      entries_.count(item)) {
+    return;
+  }
+
+  Entry entry;
+  entry.priority = priority;
+  entry.sequence = next_sequence_++;
+  entry.last_received_bytes = item->GetReceivedBytes();
+  if (options_.max_concurrent && RunningCount() >= options_.max_concurrent) {
+    entry.queued = true;
+    // The download isn't started yet when it is created.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&DownloadQueue::PauseQueued,
+                                  weak_factory_.GetWeakPtr(), item));
+  }
+  entries_[item] = entry;
+  item->AddObserver(this);
+  UpdateRateLimiter();
+}
+
+void DownloadQueue::OnDownloadUpdated(download::DownloadItem* item) {
+  auto it = entries_.find(item);
+  if (it == entries_.end())
+    return;
+  if (item->GetState() != download::DownloadItem::IN_PROGRESS) {
+    RemoveDownload(item);
+  } else if (!item->IsPaused() && (it->second.queued || it->second.throttled)) {
+    // Resumed by the app, it doesn't wait anymore.
+    it->second.queued = false;
+    it->second.throttled = false;
+  }
+  // A download which is done or paused by the app frees its slot.
+  Schedule();
+}
+
+void DownloadQueue::OnDownloadDestroyed(download::DownloadItem* item) {
+  RemoveDownload(item);
+  Schedule();
+}
+
+void DownloadQueue::RemoveDownload(download::DownloadItem* item) {
+  item->RemoveObserver(this);
+  entries_.erase(item);
+  UpdateRateLimiter();
+}
+
+void DownloadQueue::PauseQueued(download::DownloadItem* item) {
+  auto it = entries_.find(item);
+  if (it != entries_.end() && it->second.queued && !item->IsPaused())
+    item->Pause();
+}
+
+size_t DownloadQueue::RunningCount() const {
+  size_t count = 0;
+  for (const auto& [item, entry] : entries_) {
+    // The throttled downloads keep their slot.
+    if (!entry.queued && (entry.throttled || !item->IsPaused()))
+      count++;
+  }
+  return count;
+}
+
+void DownloadQueue::Schedule() {
+  while (!options_.max_concurrent ||
+         RunningCount() < options_.max_concurrent) {
+    auto next = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (!it->second.queued)
+        continue;
+      if (next == entries_.end() ||
+          it->second.priority > next->second.priority ||
+          (it->second.priority == next->second.priority &&
+           it->second.sequence < next->second.sequence)) {
+        next = it;
+      }
+    }
+    if (next == entries_.end())
+      return;
+    next->second.queued = false;
+    // Resuming notifies the observers, which can run Schedule() again.
+    if (!next->second.throttled)
+      next->first->Resume(false);
+  }
+}
+
+void DownloadQueue::UpdateRateLimiter() {
+  if (options_.max_bytes_per_second && !entries_.empty()) {
+    if (rate_limiter_timer_.IsRunning())
+      return;
+    budget_ = options_.max_bytes_per_second;
+    last_tick_ = base::TimeTicks::Now();
+    // Unretained is safe as |rate_limiter_timer_| is owned by |this|.
+    rate_limiter_timer_.Start(
+        FROM_HERE, kRateLimiterInterval,
+        base::BindRepeating(&DownloadQueue::OnRateLimiterTick,
+                            base::Unretained(this)));
+    return;
+  }
+  rate_limiter_timer_.Stop();
+  std::vector<download::DownloadItem*> throttled;
+  for (auto& [item, entry] : entries_) {
+    if (entry.throttled) {
+      entry.throttled = false;
+      if (!entry.queued)
+        throttled.push_back(item);
+    }
+  }
+  for (download::DownloadItem* item : throttled) {
+    if (entries_.count(item))
+      item->Resume(false);
+  }
+}
+
+void DownloadQueue::OnRateLimiterTick() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const int64_t limit = options_.max_bytes_per_second;
+  // Bursts of up to a second of data are allowed.
+  budget_ = std::min<int64_t>(
+      limit, budget_ + limit * (now - last_tick_).InSecondsF());
+  last_tick_ = now;
+
+  std::vector<download::DownloadItem*> items;
+  for (auto& [item, entry] : entries_) {
+    const int64_t received = item->GetReceivedBytes();
+    budget_ -= received - entry.last_received_bytes;
+    entry.last_received_bytes = received;
+    items.push_back(item);
+  }
+
+  // Pausing and resuming runs the observers, which can remove downloads.
+  const bool over_limit = budget_ < 0;
+  for (download::DownloadItem* item : items) {
+    auto it = entries_.find(item);
+    if (it == entries_.end())
+      continue;
+    Entry& entry = it->second;
+    if (over_limit && !entry.throttled && !entry.queued && !item->IsPaused()) {
+      entry.throttled = true;
+      item->Pause();
+    } else if (!over_limit && entry.throttled) {
+      entry.throttled = false;
+      if (!entry.queued)
+        item->Resume(false);
+    }
+  }
+}
+
+}  // namespace electron
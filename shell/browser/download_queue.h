@@ -0,0 +1,83 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_DOWNLOAD_QUEUE_H_
+#define ELECTRON_SHELL_BROWSER_DOWNLOAD_QUEUE_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/download/public/common/download_item.h"
+
+namespace electron {
+
+// Limits how many downloads of a session run at once and how fast they
+// receive data. The downloads which wait for a slot, or which went over the
+// rate limit, are paused: the download stops reading its response, and the
+// connection is throttled by TCP flow control. Only used on the UI thread.
+class DownloadQueue : public download::DownloadItem::Observer {
+ public:
+  struct Options {
+    // 0 for no limit.
+    size_t max_concurrent = 0;
+    int64_t max_bytes_per_second = 0;
+  };
+
+  DownloadQueue();
+  ~DownloadQueue() override;
+
+  // disable copy
+  DownloadQueue(const DownloadQueue&) = delete;
+  DownloadQueue& operator=(const DownloadQueue&) = delete;
+
+  void SetOptions(const Options& options);
+  // Sets the priority of the download with |guid| when it is created, the
+  // highest priority downloads get the free slots first.
+  void SetPriority(const std::string& guid, int priority);
+  void AddDownload(download::DownloadItem* item);
+
+ private:
+  struct Entry {
+    int priority = 0;
+    // The order the downloads were added in, for the same priority.
+    uint64_t sequence = 0;
+    // Paused by the queue to wait for a slot.
+    bool queued = false;
+    // Paused by the rate limiter.
+    bool throttled = false;
+    int64_t last_received_bytes = 0;
+  };
+
+  // download::DownloadItem::Observer:
+  void OnDownloadUpdated(download::DownloadItem* item) override;
+  void OnDownloadDestroyed(download::DownloadItem* item) override;
+
+  void RemoveDownload(download::DownloadItem* item);
+  void PauseQueued(download::DownloadItem* item);
+  // Starts the queued downloads while there are free slots.
+  void Schedule();
+  void UpdateRateLimiter();
+  void OnRateLimiterTick();
+  size_t RunningCount() const;
+
+  Options options_;
+  std::map<std::string, int> priorities_;
+  std::map<download::DownloadItem*, Entry> entries_;
+  uint64_t next_sequence_ = 0;
+
+  // The bytes the downloads can still receive, refilled at the rate limit.
+  int64_t budget_ = 0;
+  base::TimeTicks last_tick_;
+  base::RepeatingTimer rate_limiter_timer_;
+
+  base::WeakPtrFactory<DownloadQueue> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_DOWNLOAD_QUEUE_H_
@@ -6,9 +6,12 @@
 
 #include <utility>
 
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/browser/api/electron_api_utility_process.h"
+#include "shell/browser/ipc_channel_metrics.h"
 
 namespace electron {
 ElectronApiIPCHandlerImpl::ElectronApiIPCHandlerImpl(
@@ -37,19 +40,125 @@ void ElectronApiIPCHandlerImpl::OnConnectionError() {
 
 void ElectronApiIPCHandlerImpl::Message(bool internal,
                                         const std::string& channel,
-                                        blink::CloneableMessage arguments) {
+                                        blink::TransferableMessage arguments,
+                                        mojom::IPCMessageTimingPtr timing) {
+  lanes_.Run(internal, channel,
+             base::BindOnce(&ElectronApiIPCHandlerImpl::HandleMessage,
+                            base::Unretained(this), internal, channel,
+                            std::move(arguments), std::move(timing)));
+}
+
+void ElectronApiIPCHandlerImpl::HandleMessage(
+    bool internal,
+    const std::string& channel,
+    blink::TransferableMessage arguments,
+    mojom::IPCMessageTimingPtr timing) {
+  const size_t size = IPCChannelMetrics::GetMessageSize(arguments);
+  TRACE_EVENT2("electron", "ElectronApiIPCHandlerImpl::HandleMessage",
+               "channel", channel, "size", size);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
+    IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+    metrics.RecordMessage(internal, channel, size, *timing);
+    // The handler may destroy the WebContents.
+    base::WeakPtr<IPCChannelMetrics> weak_metrics = metrics.GetWeakPtr();
+    const base::TimeTicks start = base::TimeTicks::Now();
     api_web_contents->Message(internal, channel, std::move(arguments),
                               GetRenderFrameHost());
+    if (weak_metrics) {
+      weak_metrics->RecordHandlerDuration(internal, channel,
+                                          base::TimeTicks::Now() - start);
+    }
+  }
+}
+
+void ElectronApiIPCHandlerImpl::MessageBatch(
+    std::vector<mojom::IPCMessagePtr> messages) {
+  TRACE_EVENT1("electron", "ElectronApiIPCHandlerImpl::MessageBatch", "count",
+               messages.size());
+  // Handlers run synchronously and may destroy the WebContents, and with it
+  // this object, part way through the batch.
+  base::WeakPtr<ElectronApiIPCHandlerImpl> weak_this = GetWeakPtr();
+  for (auto& message : messages) {
+    if (!weak_this)
+      return;
+    Message(message->internal, message->channel,
+            std::move(message->arguments), std::move(message->timing));
   }
 }
+
+void ElectronApiIPCHandlerImpl::MessageJSON(const std::string& channel,
+                                            mojo_base::BigBuffer json,
+                                            mojom::IPCMessageTimingPtr timing) {
+  lanes_.Run(false, channel,
+             base::BindOnce(&ElectronApiIPCHandlerImpl::HandleMessageJSON,
+                            base::Unretained(this), channel, std::move(json),
+                            std::move(timing)));
+}
+
+void ElectronApiIPCHandlerImpl::HandleMessageJSON(
+    const std::string& channel,
+    mojo_base::BigBuffer json,
+    mojom::IPCMessageTimingPtr timing) {
+  TRACE_EVENT2("electron", "ElectronApiIPCHandlerImpl::HandleMessageJSON",
+               "channel", channel, "size", json.size());
+  api::WebContents* api_web_contents = api::WebContents::From(web_contents());
+  if (api_web_contents) {
+    IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+    metrics.RecordMessage(false, channel, json.size(), *timing);
+    // The handler may destroy the WebContents.
+    base::WeakPtr<IPCChannelMetrics> weak_metrics = metrics.GetWeakPtr();
+    const base::TimeTicks start = base::TimeTicks::Now();
+    api_web_contents->MessageJSON(channel, std::move(json),
+                                  GetRenderFrameHost());
+    if (weak_metrics) {
+      weak_metrics->RecordHandlerDuration(false, channel,
+                                          base::TimeTicks::Now() - start);
+    }
+  }
+}
+
 void ElectronApiIPCHandlerImpl::Invoke(bool internal,
                                        const std::string& channel,
                                        blink::CloneableMessage arguments,
+                                       mojom::IPCMessageTimingPtr timing,
                                        InvokeCallback callback) {
+  lanes_.Run(internal, channel,
+             base::BindOnce(&ElectronApiIPCHandlerImpl::HandleInvoke,
+                            base::Unretained(this), internal, channel,
+                            std::move(arguments), std::move(timing),
+                            std::move(callback)));
+}
+
+void ElectronApiIPCHandlerImpl::HandleInvoke(
+    bool internal,
+    const std::string& channel,
+    blink::CloneableMessage arguments,
+    mojom::IPCMessageTimingPtr timing,
+    InvokeCallback callback) {
+  const size_t size = IPCChannelMetrics::GetMessageSize(arguments);
+  TRACE_EVENT2("electron", "ElectronApiIPCHandlerImpl::HandleInvoke", "channel",
+               channel, "size", size);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
+    IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+    metrics.RecordMessage(internal, channel, size, *timing);
+    callback =
+        metrics.WrapReplyCallback(internal, channel, std::move(callback));
+    // Channels routed to a utility process are answered there, without
+    // running any JavaScript in this process.
+    api::UtilityProcessWrapper* utility_process =
+        internal ? nullptr
+                 : api::UtilityProcessWrapper::FromInvokeChannel(channel);
+    if (utility_process) {
+      content::RenderFrameHost* frame = GetRenderFrameHost();
+      utility_process->Invoke(
+          node::mojom::IpcInvokeSender::New(
+              api_web_contents->ID(), frame ? frame->GetProcess()->GetID() : 0,
+              frame ? frame->GetRoutingID() : 0),
+          channel, std::move(arguments), std::move(callback));
+      return;
+    }
     api_web_contents->Invoke(internal, channel, std::move(arguments),
                              std::move(callback), GetRenderFrameHost());
   }
@@ -68,20 +177,38 @@ void ElectronApiIPCHandlerImpl::ReceivePostMessage(
 void ElectronApiIPCHandlerImpl::MessageSync(bool internal,
                                             const std::string& channel,
                                             blink::CloneableMessage arguments,
+                                            mojom::IPCMessageTimingPtr timing,
                                             MessageSyncCallback callback) {
+  const size_t size = IPCChannelMetrics::GetMessageSize(arguments);
+  TRACE_EVENT2("electron", "ElectronApiIPCHandlerImpl::MessageSync", "channel",
+               channel, "size", size);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->MessageSync(internal, channel, std::move(arguments),
-                                  std::move(callback), GetRenderFrameHost());
+    IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+    metrics.RecordMessage(internal, channel, size, *timing);
+    api_web_contents->MessageSync(
+        internal, channel, std::move(arguments),
+        metrics.WrapReplyCallback(internal, channel, std::move(callback)),
+        GetRenderFrameHost());
   }
 }
 
 void ElectronApiIPCHandlerImpl::MessageTo(int32_t web_contents_id,
                                           const std::string& channel,
-                                          blink::CloneableMessage arguments) {
+                                          blink::CloneableMessage arguments,
+                                          mojom::IPCMessageTimingPtr timing) {
+  const size_t size = IPCChannelMetrics::GetMessageSize(arguments);
+  TRACE_EVENT2("electron", "ElectronApiIPCHandlerImpl::MessageTo", "channel",
+               channel, "size", size);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
+    IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+    metrics.RecordMessage(false /* internal */, channel, size, *timing);
+    // The handler is in another renderer, this only measures forwarding.
+    const base::TimeTicks start = base::TimeTicks::Now();
     api_web_contents->MessageTo(web_contents_id, channel, std::move(arguments));
+    metrics.RecordHandlerDuration(false /* internal */, channel,
+                                  base::TimeTicks::Now() - start);
   }
 }
 
@@ -94,6 +221,19 @@ void ElectronApiIPCHandlerImpl::MessageHost(const std::string& channel,
   }
 }
 
+void ElectronApiIPCHandlerImpl::OpenDirectChannel(
+    int32_t web_contents_id,
+    OpenDirectChannelCallback callback) {
+  api::WebContents* api_web_contents = api::WebContents::From(web_contents());
+  content::RenderFrameHost* frame = GetRenderFrameHost();
+  if (!api_web_contents || !frame) {
+    std::move(callback).Run(mojo::NullRemote());
+    return;
+  }
+  std::move(callback).Run(
+      api_web_contents->OpenDirectChannel(web_contents_id, frame));
+}
+
 content::RenderFrameHost* ElectronApiIPCHandlerImpl::GetRenderFrameHost() {
   return content::RenderFrameHost::FromID(render_frame_host_id_);
 }
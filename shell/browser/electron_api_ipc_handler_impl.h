@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_ELECTRON_API_IPC_HANDLER_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/global_routing_id.h"
@@ -13,6 +14,7 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/ipc_priority_lanes.h"
 
 namespace content {
 class RenderFrameHost;
@@ -38,22 +40,32 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
   // mojom::ElectronApiIPC:
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments) override;
+               blink::TransferableMessage arguments,
+               mojom::IPCMessageTimingPtr timing) override;
+  void MessageBatch(std::vector<mojom::IPCMessagePtr> messages) override;
+  void MessageJSON(const std::string& channel,
+                   mojo_base::BigBuffer json,
+                   mojom::IPCMessageTimingPtr timing) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
+              mojom::IPCMessageTimingPtr timing,
               InvokeCallback callback) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void MessageSync(bool internal,
                    const std::string& channel,
                    blink::CloneableMessage arguments,
+                   mojom::IPCMessageTimingPtr timing,
                    MessageSyncCallback callback) override;
   void MessageTo(int32_t web_contents_id,
                  const std::string& channel,
-                 blink::CloneableMessage arguments) override;
+                 blink::CloneableMessage arguments,
+                 mojom::IPCMessageTimingPtr timing) override;
   void MessageHost(const std::string& channel,
                    blink::CloneableMessage arguments) override;
+  void OpenDirectChannel(int32_t web_contents_id,
+                         OpenDirectChannelCallback callback) override;
 
   base::WeakPtr<ElectronApiIPCHandlerImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
@@ -67,10 +79,28 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
 
   void OnConnectionError();
 
+  // The asynchronous messages, run by |lanes_| in order of priority.
+  void HandleMessage(bool internal,
+                     const std::string& channel,
+                     blink::TransferableMessage arguments,
+                     mojom::IPCMessageTimingPtr timing);
+  void HandleMessageJSON(const std::string& channel,
+                         mojo_base::BigBuffer json,
+                         mojom::IPCMessageTimingPtr timing);
+  void HandleInvoke(bool internal,
+                    const std::string& channel,
+                    blink::CloneableMessage arguments,
+                    mojom::IPCMessageTimingPtr timing,
+                    InvokeCallback callback);
+
   content::RenderFrameHost* GetRenderFrameHost();
 
   content::GlobalRenderFrameHostId render_frame_host_id_;
 
+  // Declared before |receiver_| so that it outlives the pipe, and the reply
+  // callbacks of queued Invoke() messages are dropped after it is closed.
+  IPCPriorityLanes lanes_;
+
   mojo::AssociatedReceiver<mojom::ElectronApiIPC> receiver_{this};
 
   base::WeakPtrFactory<ElectronApiIPCHandlerImpl> weak_factory_{this};
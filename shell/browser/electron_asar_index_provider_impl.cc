@@ -0,0 +1,50 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/electron_asar_index_provider_impl.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/task/thread_pool.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+
+namespace electron {
+
+namespace {
+
+void BindOnCurrentSequence(
+    mojo::PendingReceiver<mojom::ElectronAsarIndexProvider> receiver) {
+  mojo::MakeSelfOwnedReceiver(std::make_unique<ElectronAsarIndexProviderImpl>(),
+                              std::move(receiver));
+}
+
+}  // namespace
+
+ElectronAsarIndexProviderImpl::ElectronAsarIndexProviderImpl() = default;
+
+ElectronAsarIndexProviderImpl::~ElectronAsarIndexProviderImpl() = default;
+
+// static
+void ElectronAsarIndexProviderImpl::Create(
+    mojo::PendingReceiver<mojom::ElectronAsarIndexProvider> receiver) {
+  base::ThreadPool::CreateSequencedTaskRunner(
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&BindOnCurrentSequence, std::move(receiver)));
+}
+
+void ElectronAsarIndexProviderImpl::GetSharedIndex(
+    const base::FilePath& archive_path,
+    GetSharedIndexCallback callback) {
+  std::shared_ptr<asar::Archive> archive =
+      asar::GetCachedAsarArchive(archive_path);
+  std::move(callback).Run(archive ? archive->GetSharedIndex()
+                                  : base::ReadOnlySharedMemoryRegion());
+}
+
+}  // namespace electron
@@ -0,0 +1,38 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_ELECTRON_ASAR_INDEX_PROVIDER_IMPL_H_
+#define ELECTRON_SHELL_BROWSER_ELECTRON_ASAR_INDEX_PROVIDER_IMPL_H_
+
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+
+namespace electron {
+
+// Hands out the headers of archives the browser process has already opened,
+// so that child processes don't have to parse them again. Archives that are
+// not open in the browser process are never opened on behalf of a child.
+class ElectronAsarIndexProviderImpl : public mojom::ElectronAsarIndexProvider {
+ public:
+  ElectronAsarIndexProviderImpl();
+  ~ElectronAsarIndexProviderImpl() override;
+
+  // Binds |receiver| on a sequence that may block, converting a JSON header
+  // to the shareable form can take a while for large archives.
+  static void Create(
+      mojo::PendingReceiver<mojom::ElectronAsarIndexProvider> receiver);
+
+  // disable copy
+  ElectronAsarIndexProviderImpl(const ElectronAsarIndexProviderImpl&) = delete;
+  ElectronAsarIndexProviderImpl& operator=(
+      const ElectronAsarIndexProviderImpl&) = delete;
+
+  // mojom::ElectronAsarIndexProvider:
+  void GetSharedIndex(const base::FilePath& archive_path,
+                      GetSharedIndexCallback callback) override;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_ELECTRON_ASAR_INDEX_PROVIDER_IMPL_H_
@@ -8,8 +8,10 @@
 #include <shlobj.h>
 #endif
 
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/base_switches.h"
 #include "base/command_line.h"
@@ -59,6 +61,7 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "extensions/browser/api/messaging/messaging_api_message_filter.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
+#include "net/http/http_request_headers.h"
 #include "net/ssl/ssl_cert_request_info.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "ppapi/host/ppapi_host.h"
@@ -80,11 +83,14 @@
 #include "shell/browser/badging/badge_manager.h"
 #include "shell/browser/child_web_contents_tracker.h"
 #include "shell/browser/electron_api_ipc_handler_impl.h"
+#include "shell/browser/electron_asar_index_provider_impl.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/electron_heap_limit_observer_impl.h"
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/electron_speech_recognition_manager_delegate.h"
+#include "shell/browser/electron_sync_ipc_handler_impl.h"
 #include "shell/browser/electron_web_contents_utility_handler_impl.h"
 #include "shell/browser/font_defaults.h"
 #include "shell/browser/javascript_environment.h"
@@ -101,6 +107,7 @@
 #include "shell/browser/protocol_registry.h"
 #include "shell/browser/serial/electron_serial_delegate.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_manager.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/browser/web_contents_permission_helper.h"
 #include "shell/browser/web_contents_preferences.h"
@@ -112,6 +119,7 @@
 #include "shell/common/logging.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
+#include "shell/common/resources_bundle.h"
 #include "shell/common/thread_restrictions.h"
 #include "third_party/blink/public/common/loader/url_loader_throttle.h"
 #include "third_party/blink/public/common/tokens/tokens.h"
@@ -187,6 +195,10 @@
 #include "components/crash/core/app/crashpad.h"        // nogncheck
 #endif
 
+#if !IS_MAS_BUILD()
+#include "shell/common/crash_keys.h"
+#endif
+
 #if BUILDFLAG(IS_WIN)
 #include "chrome/browser/ui/views/overlay/video_overlay_window_views.h"
 #include "shell/browser/browser.h"
@@ -511,6 +523,24 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
   }
 #endif
 
+#if !IS_MAS_BUILD()
+  // The child processes apply the minidump options of crashReporter.start()
+  // to themselves.
+  if (api::crash_reporter::IsCrashReporterEnabled()) {
+    const uint32_t limit =
+        ElectronCrashReporterClient::Get()->GetReferencedMemoryLimit();
+    if (limit) {
+      command_line->AppendSwitchASCII(switches::kCrashReferencedMemoryLimit,
+                                      base::NumberToString(limit));
+    }
+    const size_t budget = crash_keys::GetCrashKeysBudget();
+    if (budget != std::numeric_limits<size_t>::max()) {
+      command_line->AppendSwitchASCII(switches::kCrashKeysBudget,
+                                      base::NumberToString(budget));
+    }
+  }
+#endif
+
   // The zygote process is booted before JS runs, so DIR_USER_DATA isn't usable
   // at that time. It doesn't need --user-data-dir to be correct anyway, since
   // the zygote itself doesn't access anything in that directory.
@@ -575,6 +605,9 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
       if (web_preferences)
         web_preferences->AppendCommandLineSwitches(
             command_line, IsRendererSubFrame(process_id));
+    } else {
+      SpareRendererManager::GetInstance()->AppendSpareSwitches(process_id,
+                                                               command_line);
     }
   }
 }
@@ -759,6 +792,15 @@ bool ElectronBrowserClient::ShouldUseProcessPerSite(
 #endif
 }
 
+bool ElectronBrowserClient::ShouldUseSpareRenderProcessHost(
+    content::BrowserContext* browser_context,
+    const GURL& site_url) {
+  return SpareRendererManager::GetInstance()->ShouldUseSpareRenderProcessHost(
+             browser_context) &&
+         content::ContentBrowserClient::ShouldUseSpareRenderProcessHost(
+             browser_context, site_url);
+}
+
 void ElectronBrowserClient::GetMediaDeviceIDSalt(
     content::RenderFrameHost* rfh,
     const net::SiteForCookies& site_for_cookies,
@@ -937,7 +979,11 @@ std::vector<std::unique_ptr<content::NavigationThrottle>>
 ElectronBrowserClient::CreateThrottlesForNavigation(
     content::NavigationHandle* handle) {
   std::vector<std::unique_ptr<content::NavigationThrottle>> throttles;
-  throttles.push_back(std::make_unique<ElectronNavigationThrottle>(handle));
+  // The throttle only emits events, none of which have listeners for most
+  // navigations of subframes.
+  auto* api_contents = api::WebContents::From(handle->GetWebContents());
+  if (api_contents && api_contents->NeedsNavigationThrottle(handle))
+    throttles.push_back(std::make_unique<ElectronNavigationThrottle>(handle));
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   throttles.push_back(
@@ -1287,6 +1333,19 @@ void ElectronBrowserClient::CreateWebSocket(
   }
 #endif
 
+  // The sockets which no listener or rule applies to skip the proxy and its
+  // header and auth hooks, as when the session has no listener.
+  if (!web_request->ShouldProxyWebSocket(url)) {
+    std::vector<network::mojom::HttpHeaderPtr> headers;
+    if (user_agent) {
+      headers.push_back(network::mojom::HttpHeader::New(
+          net::HttpRequestHeaders::kUserAgent, *user_agent));
+    }
+    std::move(factory).Run(url, std::move(headers), std::move(handshake_client),
+                           mojo::NullRemote(), mojo::NullRemote());
+    return;
+  }
+
   ProxyingWebSocket::StartProxying(
       web_request.get(), std::move(factory), url, site_for_cookies, user_agent,
       std::move(handshake_client), true, frame->GetProcess()->GetID(),
@@ -1499,6 +1558,17 @@ bool ElectronBrowserClient::ShouldEnableStrictSiteIsolation() {
 void ElectronBrowserClient::BindHostReceiverForRenderer(
     content::RenderProcessHost* render_process_host,
     mojo::GenericPendingReceiver receiver) {
+  if (auto asar_receiver =
+          receiver.As<electron::mojom::ElectronAsarIndexProvider>()) {
+    ElectronAsarIndexProviderImpl::Create(std::move(asar_receiver));
+    return;
+  }
+  if (auto heap_limit_receiver =
+          receiver.As<electron::mojom::ElectronHeapLimitObserver>()) {
+    ElectronHeapLimitObserverImpl::Create(render_process_host->GetID(),
+                                          std::move(heap_limit_receiver));
+    return;
+  }
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   if (auto host_receiver = receiver.As<spellcheck::mojom::SpellCheckHost>()) {
     SpellCheckHostChromeImpl::Create(render_process_host->GetID(),
@@ -1562,6 +1632,8 @@ void ElectronBrowserClient::RegisterBrowserInterfaceBindersForFrame(
       base::BindRepeating(&badging::BadgeManager::BindFrameReceiver));
   map->Add<blink::mojom::KeyboardLockService>(base::BindRepeating(
       &content::KeyboardLockServiceImpl::CreateMojoService));
+  map->Add<mojom::ElectronSyncIPC>(
+      base::BindRepeating(&ElectronSyncIPCHandlerImpl::Create));
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   map->Add<extensions::mime_handler::MimeHandlerService>(
       base::BindRepeating(&BindMimeHandlerService));
@@ -1599,6 +1671,11 @@ void ElectronBrowserClient::GetAdditionalMappedFilesForChildProcess(
   if (crash_signal_fd >= 0) {
     mappings->Share(kCrashDumpSignal, crash_signal_fd);
   }
+#if BUILDFLAG(ENABLE_RESOURCES_BUNDLE)
+  // So that the child doesn't open the bundle again.
+  if (const ResourcesBundle* resources = ResourcesBundle::Get())
+    mappings->Share(kResourcesBundleDescriptor, resources->GetPlatformFile());
+#endif
 }
 #endif
 
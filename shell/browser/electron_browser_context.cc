@@ -15,6 +15,8 @@
 #include "base/no_destructor.h"
 #include "base/path_service.h"
 #include "base/strings/escape.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/pref_names.h"
@@ -37,13 +39,18 @@
 #include "services/network/public/cpp/features.h"
 #include "services/network/public/cpp/wrapper_shared_url_loader_factory.h"
 #include "services/network/public/mojom/network_context.mojom.h"
+#include "shell/browser/batching_pref_store.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/net/connection_warming.h"
+#include "shell/browser/net/host_resolution_tracker.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/renderer_sharing_manager.h"
+#include "shell/browser/spare_renderer_manager.h"
 #include "shell/browser/special_storage_policy.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/web_contents_permission_helper.h"
@@ -196,6 +203,68 @@ std::string MakePartitionName(const std::string& input) {
   return base::EscapePath(base::ToLowerASCII(input));
 }
 
+// Returns the directory of the data of |partition|.
+base::FilePath GetPartitionPath(const std::string& partition, bool in_memory) {
+  base::FilePath path;
+  base::PathService::Get(DIR_SESSION_DATA, &path);
+  if (!in_memory && !partition.empty()) {
+    path = path.Append(FILE_PATH_LITERAL("Partitions"))
+               .Append(base::FilePath::FromUTF8Unsafe(
+                   MakePartitionName(partition)));
+  }
+  return path;
+}
+
+// Reads the Preferences file of a partition on the thread pool.
+class PrefsReader : public PrefStore::Observer {
+ public:
+  using DoneCallback = base::OnceCallback<void(scoped_refptr<JsonPrefStore>)>;
+
+  PrefsReader(const base::FilePath& path, DoneCallback done)
+      : pref_store_(base::MakeRefCounted<JsonPrefStore>(
+            path.Append(FILE_PATH_LITERAL("Preferences")))),
+        done_(std::move(done)) {
+    pref_store_->AddObserver(this);
+    // The file is read on the task runner of the store.
+    pref_store_->ReadPrefsAsync(nullptr);
+  }
+
+  ~PrefsReader() override {
+    if (pref_store_)
+      pref_store_->RemoveObserver(this);
+  }
+
+  // disable copy
+  PrefsReader(const PrefsReader&) = delete;
+  PrefsReader& operator=(const PrefsReader&) = delete;
+
+ private:
+  // PrefStore::Observer:
+  void OnInitializationCompleted(bool succeeded) override {
+    // Like with the synchronous read, a missing or broken file leaves the
+    // prefs empty. |done_| destroys |this|.
+    pref_store_->RemoveObserver(this);
+    std::move(done_).Run(std::move(pref_store_));
+  }
+
+  scoped_refptr<JsonPrefStore> pref_store_;
+  DoneCallback done_;
+};
+
+// The contexts whose prefs are being read by ElectronBrowserContext::FromAsync.
+struct PendingContext {
+  std::unique_ptr<PrefsReader> reader;
+  std::vector<ElectronBrowserContext::FromCallback> callbacks;
+};
+
+std::map<ElectronBrowserContext::PartitionKey, PendingContext>&
+PendingContexts() {
+  static base::NoDestructor<
+      std::map<ElectronBrowserContext::PartitionKey, PendingContext>>
+      pending_contexts;
+  return *pending_contexts;
+}
+
 }  // namespace
 
 // static
@@ -209,12 +278,23 @@ ElectronBrowserContext::browser_context_map() {
 ElectronBrowserContext::ElectronBrowserContext(
     const PartitionOrPath partition_location,
     bool in_memory,
-    base::Value::Dict options)
+    base::Value::Dict options,
+    scoped_refptr<JsonPrefStore> user_pref_store,
+    base::TimeTicks creation_start)
     : in_memory_pref_store_(new ValueMapPrefStore),
       storage_policy_(base::MakeRefCounted<SpecialStoragePolicy>()),
       protocol_registry_(base::WrapUnique(new ProtocolRegistry)),
       in_memory_(in_memory),
       ssl_config_(network::mojom::SSLConfig::New()) {
+  const base::TimeTicks init_start = base::TimeTicks::Now();
+  creation_timings_.async = !!user_pref_store;
+
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+  // The factories of the keyed services have to be built before the prefs
+  // of the context are registered.
+  ElectronBrowserMainParts::Get()->InitializeExtensions();
+#endif
+
   // Read options.
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   use_cache_ = !command_line->HasSwitch(switches::kDisableHttpCache);
@@ -227,13 +307,7 @@ ElectronBrowserContext::ElectronBrowserContext(
 
   if (auto* path_value = std::get_if<std::reference_wrapper<const std::string>>(
           &partition_location)) {
-    base::PathService::Get(DIR_SESSION_DATA, &path_);
-    const std::string& partition_loc = path_value->get();
-    if (!in_memory && !partition_loc.empty()) {
-      path_ = path_.Append(FILE_PATH_LITERAL("Partitions"))
-                  .Append(base::FilePath::FromUTF8Unsafe(
-                      MakePartitionName(partition_loc)));
-    }
+    path_ = GetPartitionPath(path_value->get(), in_memory);
   } else if (auto* filepath_partition =
                  std::get_if<std::reference_wrapper<const base::FilePath>>(
                      &partition_location)) {
@@ -244,12 +318,18 @@ ElectronBrowserContext::ElectronBrowserContext(
   BrowserContextDependencyManager::GetInstance()->MarkBrowserContextLive(this);
 
   // Initialize Pref Registry.
-  InitPrefs();
-
-  cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  if (creation_timings_.async) {
+    creation_timings_.prefs_load = init_start - creation_start;
+    InitPrefs(std::move(user_pref_store));
+  } else {
+    const base::TimeTicks prefs_start = base::TimeTicks::Now();
+    InitPrefs(nullptr);
+    creation_timings_.prefs_load = base::TimeTicks::Now() - prefs_start;
+  }
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   if (!in_memory_) {
+    const base::TimeTicks extensions_start = base::TimeTicks::Now();
     BrowserContextDependencyManager::GetInstance()
         ->CreateBrowserContextServices(this);
 
@@ -257,12 +337,20 @@ ElectronBrowserContext::ElectronBrowserContext(
         extensions::ExtensionSystem::Get(this));
     extension_system_->InitForRegularProfile(true /* extensions_enabled */);
     extension_system_->FinishInitialization();
+    creation_timings_.extensions_init =
+        base::TimeTicks::Now() - extensions_start;
   }
 #endif
+
+  creation_timings_.total = base::TimeTicks::Now() - creation_start;
+  creation_timings_.context_init =
+      creation_timings_.total - creation_timings_.prefs_load;
 }
 
 ElectronBrowserContext::~ElectronBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  SpareRendererManager::GetInstance()->RemoveBrowserContext(this);
+  RendererSharingManager::GetInstance()->RemoveBrowserContext(this);
   NotifyWillBeDestroyed();
   // Notify any keyed services of browser context destruction.
   BrowserContextDependencyManager::GetInstance()->DestroyBrowserContextServices(
@@ -273,14 +361,18 @@ ElectronBrowserContext::~ElectronBrowserContext() {
                             std::move(resource_context_));
 }
 
-void ElectronBrowserContext::InitPrefs() {
-  auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
+void ElectronBrowserContext::InitPrefs(
+    scoped_refptr<JsonPrefStore> user_pref_store) {
   ScopedAllowBlockingForElectron allow_blocking;
   PrefServiceFactory prefs_factory;
-  scoped_refptr<JsonPrefStore> pref_store =
-      base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
-  prefs_factory.set_user_prefs(pref_store);
+  auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
+  if (!user_pref_store) {
+    user_pref_store = base::MakeRefCounted<JsonPrefStore>(prefs_path);
+    user_pref_store->ReadPrefs();  // Synchronous.
+  }
+  user_pref_store_ = base::MakeRefCounted<BatchingPrefStore>(
+      std::move(user_pref_store), prefs_path);
+  prefs_factory.set_user_prefs(user_pref_store_);
   prefs_factory.set_command_line_prefs(in_memory_pref_store());
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -310,6 +402,8 @@ void ElectronBrowserContext::InitPrefs() {
   MediaDeviceIDSalt::RegisterPrefs(registry.get());
   ZoomLevelDelegate::RegisterPrefs(registry.get());
   PrefProxyConfigTrackerImpl::RegisterPrefs(registry.get());
+  connection_warming::RegisterPrefs(registry.get());
+  HostResolutionTracker::RegisterPrefs(registry.get());
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   if (!in_memory_)
     extensions::ExtensionPrefs::RegisterProfilePrefs(registry.get());
@@ -323,6 +417,11 @@ void ElectronBrowserContext::InitPrefs() {
 #endif
 
   prefs_ = prefs_factory.Create(registry.get());
+  pref_change_registrar_.Init(prefs_.get());
+  pref_change_registrar_.Add(
+      proxy_config::prefs::kProxy,
+      base::BindRepeating(&ElectronBrowserContext::OnProxyPrefChanged,
+                          base::Unretained(this)));
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS) || \
     BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   user_prefs::UserPrefs::Set(this, prefs_.get());
@@ -343,6 +442,14 @@ void ElectronBrowserContext::InitPrefs() {
 #endif
 }
 
+CookieChangeNotifier* ElectronBrowserContext::cookie_change_notifier() {
+  // The notifier listens to the cookie manager of the network context, which
+  // it would otherwise create with the context.
+  if (!cookie_change_notifier_)
+    cookie_change_notifier_ = std::make_unique<CookieChangeNotifier>(this);
+  return cookie_change_notifier_.get();
+}
+
 void ElectronBrowserContext::SetUserAgent(const std::string& user_agent) {
   user_agent_ = user_agent;
 }
@@ -510,6 +617,11 @@ ElectronBrowserContext::GetReduceAcceptLanguageControllerDelegate() {
   return nullptr;
 }
 
+void ElectronBrowserContext::OnProxyPrefChanged() {
+  if (resolve_proxy_helper_)
+    resolve_proxy_helper_->ClearCache();
+}
+
 ResolveProxyHelper* ElectronBrowserContext::GetResolveProxyHelper() {
   if (!resolve_proxy_helper_) {
     resolve_proxy_helper_ = base::MakeRefCounted<ResolveProxyHelper>(this);
@@ -517,6 +629,13 @@ ResolveProxyHelper* ElectronBrowserContext::GetResolveProxyHelper() {
   return resolve_proxy_helper_.get();
 }
 
+HostResolutionTracker* ElectronBrowserContext::GetHostResolutionTracker() {
+  if (!host_resolution_tracker_) {
+    host_resolution_tracker_ = std::make_unique<HostResolutionTracker>(this);
+  }
+  return host_resolution_tracker_.get();
+}
+
 network::mojom::SSLConfigPtr ElectronBrowserContext::GetSSLConfig() {
   return ssl_config_.Clone();
 }
@@ -684,7 +803,8 @@ void ElectronBrowserContext::GrantDevicePermission(
     const url::Origin& origin,
     const base::Value& device,
     blink::PermissionType permission_type) {
-  granted_devices_[permission_type][origin].push_back(
+  const std::string key = GetDeviceKey(device, permission_type);
+  granted_devices_[permission_type][origin][key].push_back(
       std::make_unique<base::Value>(device.Clone()));
 }
 
@@ -700,14 +820,21 @@ void ElectronBrowserContext::RevokeDevicePermission(
   if (origin_devices_it == current_devices_it->second.end())
     return;
 
-  for (auto it = origin_devices_it->second.begin();
-       it != origin_devices_it->second.end();) {
+  const auto& key_devices_it =
+      origin_devices_it->second.find(GetDeviceKey(device, permission_type));
+  if (key_devices_it == origin_devices_it->second.end())
+    return;
+
+  for (auto it = key_devices_it->second.begin();
+       it != key_devices_it->second.end();) {
     if (DoesDeviceMatch(device, it->get(), permission_type)) {
-      it = origin_devices_it->second.erase(it);
+      it = key_devices_it->second.erase(it);
     } else {
       ++it;
     }
   }
+  if (key_devices_it->second.empty())
+    origin_devices_it->second.erase(key_devices_it);
 }
 
 bool ElectronBrowserContext::DoesDeviceMatch(
@@ -772,6 +899,36 @@ bool ElectronBrowserContext::DoesDeviceMatch(
   return false;
 }
 
+// static
+std::string ElectronBrowserContext::GetDeviceKey(
+    const base::Value& device,
+    blink::PermissionType permission_type) {
+  const base::Value::Dict& dict = device.GetDict();
+  auto id = [&dict](const char* key) {
+    absl::optional<int> value = dict.FindInt(key);
+    return value ? base::NumberToString(*value) : std::string();
+  };
+  if (permission_type ==
+          static_cast<blink::PermissionType>(
+              WebContentsPermissionHelper::PermissionType::HID) ||
+      permission_type ==
+          static_cast<blink::PermissionType>(
+              WebContentsPermissionHelper::PermissionType::USB)) {
+    return base::StrCat(
+        {id(kDeviceVendorIdKey), ":", id(kDeviceProductIdKey)});
+  } else if (permission_type ==
+             static_cast<blink::PermissionType>(
+                 WebContentsPermissionHelper::PermissionType::SERIAL)) {
+#if BUILDFLAG(IS_WIN)
+    const std::string* instance_id = dict.FindString(kDeviceInstanceIdKey);
+    return instance_id ? *instance_id : std::string();
+#else
+    return base::StrCat({id(kVendorIdKey), ":", id(kProductIdKey)});
+#endif  // BUILDFLAG(IS_WIN)
+  }
+  return std::string();
+}
+
 bool ElectronBrowserContext::CheckDevicePermission(
     const url::Origin& origin,
     const base::Value& device,
@@ -784,7 +941,12 @@ bool ElectronBrowserContext::CheckDevicePermission(
   if (origin_devices_it == current_devices_it->second.end())
     return false;
 
-  for (const auto& device_to_compare : origin_devices_it->second) {
+  const auto& key_devices_it =
+      origin_devices_it->second.find(GetDeviceKey(device, permission_type));
+  if (key_devices_it == origin_devices_it->second.end())
+    return false;
+
+  for (const auto& device_to_compare : key_devices_it->second) {
     if (DoesDeviceMatch(device, device_to_compare.get(), permission_type))
       return true;
   }
@@ -810,6 +972,58 @@ ElectronBrowserContext* ElectronBrowserContext::From(
   return new_context;
 }
 
+// static
+void ElectronBrowserContext::FromAsync(const std::string& partition,
+                                       bool in_memory,
+                                       base::Value::Dict options,
+                                       FromCallback callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  PartitionKey key(partition, in_memory);
+  auto existing = browser_context_map().find(key);
+  if (existing != browser_context_map().end() && existing->second) {
+    std::move(callback).Run(existing->second.get());
+    return;
+  }
+
+  // The partitions asked for while their prefs are read share the read.
+  PendingContext& pending = PendingContexts()[key];
+  pending.callbacks.push_back(std::move(callback));
+  if (pending.reader)
+    return;
+  pending.reader = std::make_unique<PrefsReader>(
+      GetPartitionPath(partition, in_memory),
+      base::BindOnce(&ElectronBrowserContext::OnPrefsRead, key, partition,
+                     in_memory, std::move(options), base::TimeTicks::Now()));
+}
+
+// static
+void ElectronBrowserContext::OnPrefsRead(
+    PartitionKey key,
+    std::string partition,
+    bool in_memory,
+    base::Value::Dict options,
+    base::TimeTicks creation_start,
+    scoped_refptr<JsonPrefStore> user_pref_store) {
+  auto pending = PendingContexts().extract(key);
+  std::vector<FromCallback> callbacks = std::move(pending.mapped().callbacks);
+
+  // From() may have created the context while the prefs were read.
+  ElectronBrowserContext* browser_context = nullptr;
+  auto existing = browser_context_map().find(key);
+  if (existing != browser_context_map().end() && existing->second) {
+    browser_context = existing->second.get();
+  } else {
+    browser_context = new ElectronBrowserContext(
+        std::cref(partition), in_memory, std::move(options),
+        std::move(user_pref_store), creation_start);
+    browser_context_map()[key] =
+        std::unique_ptr<ElectronBrowserContext>(browser_context);
+  }
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(browser_context);
+}
+
 ElectronBrowserContext* ElectronBrowserContext::FromPath(
     const base::FilePath& path,
     base::Value::Dict options) {
@@ -9,9 +9,13 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "chrome/browser/predictors/preconnect_manager.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/media_stream_request.h"
 #include "content/public/browser/resource_context.h"
@@ -23,6 +27,7 @@
 #include "shell/browser/media/media_device_id_salt.h"
 #include "third_party/blink/public/common/permissions/permission_utils.h"
 
+class JsonPrefStore;
 class PrefService;
 class ValueMapPrefStore;
 
@@ -49,13 +54,18 @@ class Value;
 
 namespace electron {
 
-using DevicePermissionMap =
-    std::map<blink::PermissionType,
-             std::map<url::Origin, std::vector<std::unique_ptr<base::Value>>>>;
+// The granted devices of each origin are indexed by the key of
+// ElectronBrowserContext::GetDeviceKey().
+using DevicePermissionMap = std::map<
+    blink::PermissionType,
+    std::map<url::Origin,
+             std::map<std::string, std::vector<std::unique_ptr<base::Value>>>>>;
 
 class ElectronDownloadManagerDelegate;
 class ElectronPermissionManager;
+class BatchingPrefStore;
 class CookieChangeNotifier;
+class HostResolutionTracker;
 class ResolveProxyHelper;
 class WebViewManager;
 class ProtocolRegistry;
@@ -130,6 +140,16 @@ class ElectronBrowserContext : public content::BrowserContext {
   static ElectronBrowserContext* FromPath(const base::FilePath& path,
                                           base::Value::Dict options = {});
 
+  // Like From(), but the prefs of a new BrowserContext are read on the thread
+  // pool, and its network context is only created once it is used.
+  // |callback| is called with the BrowserContext once it is ready, the
+  // partitions created at the same time are read in parallel.
+  using FromCallback = base::OnceCallback<void(ElectronBrowserContext*)>;
+  static void FromAsync(const std::string& partition,
+                        bool in_memory,
+                        base::Value::Dict options,
+                        FromCallback callback);
+
   static BrowserContextMap& browser_context_map();
 
   void SetUserAgent(const std::string& user_agent);
@@ -137,6 +157,7 @@ class ElectronBrowserContext : public content::BrowserContext {
   bool CanUseHttpCache() const;
   int GetMaxCacheSize() const;
   ResolveProxyHelper* GetResolveProxyHelper();
+  HostResolutionTracker* GetHostResolutionTracker();
   predictors::PreconnectManager* GetPreconnectManager();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
 
@@ -167,10 +188,24 @@ class ElectronBrowserContext : public content::BrowserContext {
   content::ReduceAcceptLanguageControllerDelegate*
   GetReduceAcceptLanguageControllerDelegate() override;
 
-  CookieChangeNotifier* cookie_change_notifier() const {
-    return cookie_change_notifier_.get();
-  }
+  // How long the phases of the creation of this context took.
+  struct CreationTimings {
+    // Whether the prefs were read on the thread pool.
+    bool async = false;
+    // From the start of the creation until the prefs were read.
+    base::TimeDelta prefs_load;
+    // Setting up the context on the UI thread once the prefs were read,
+    // including the extension system.
+    base::TimeDelta context_init;
+    base::TimeDelta extensions_init;
+    base::TimeDelta total;
+  };
+  const CreationTimings& creation_timings() const { return creation_timings_; }
+
+  // Created on first use, as it connects to the network context.
+  CookieChangeNotifier* cookie_change_notifier();
   PrefService* prefs() const { return prefs_.get(); }
+  BatchingPrefStore* user_pref_store() const { return user_pref_store_.get(); }
   ValueMapPrefStore* in_memory_pref_store() const {
     return in_memory_pref_store_.get();
   }
@@ -191,6 +226,14 @@ class ElectronBrowserContext : public content::BrowserContext {
     return protocol_registry_.get();
   }
 
+  // How the net.request() requests of this context used the HTTP cache.
+  struct HttpCacheStats {
+    uint64_t requests = 0;
+    uint64_t hits = 0;
+    uint64_t bytes_from_cache = 0;
+  };
+  HttpCacheStats& http_cache_stats() { return http_cache_stats_; }
+
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
   network::mojom::SSLConfigPtr GetSSLConfig();
   void SetSSLConfigClient(mojo::Remote<network::mojom::SSLConfigClient> client);
@@ -221,9 +264,14 @@ class ElectronBrowserContext : public content::BrowserContext {
                              blink::PermissionType permissionType);
 
  private:
-  ElectronBrowserContext(const PartitionOrPath partition_location,
-                         bool in_memory,
-                         base::Value::Dict options);
+  // |user_pref_store| is the already read Preferences file, or null to read
+  // it synchronously.
+  ElectronBrowserContext(
+      const PartitionOrPath partition_location,
+      bool in_memory,
+      base::Value::Dict options,
+      scoped_refptr<JsonPrefStore> user_pref_store = nullptr,
+      base::TimeTicks creation_start = base::TimeTicks::Now());
 
   ElectronBrowserContext(base::FilePath partition, base::Value::Dict options);
 
@@ -232,16 +280,32 @@ class ElectronBrowserContext : public content::BrowserContext {
       content::MediaResponseCallback callback,
       gin::Arguments* args);
 
+  // Called by FromAsync() once the Preferences file of |key| was read.
+  static void OnPrefsRead(PartitionKey key,
+                          std::string partition,
+                          bool in_memory,
+                          base::Value::Dict options,
+                          base::TimeTicks creation_start,
+                          scoped_refptr<JsonPrefStore> user_pref_store);
+
   // Initialize pref registry.
-  void InitPrefs();
+  void InitPrefs(scoped_refptr<JsonPrefStore> user_pref_store);
+
+  void OnProxyPrefChanged();
 
   bool DoesDeviceMatch(const base::Value& device,
                        const base::Value* device_to_compare,
                        blink::PermissionType permission_type);
 
+  // Devices which DoesDeviceMatch() can match have the same key, so that a
+  // check only compares the granted devices with the ids of |device|.
+  static std::string GetDeviceKey(const base::Value& device,
+                                  blink::PermissionType permission_type);
+
   scoped_refptr<ValueMapPrefStore> in_memory_pref_store_;
   std::unique_ptr<content::ResourceContext> resource_context_;
   std::unique_ptr<CookieChangeNotifier> cookie_change_notifier_;
+  scoped_refptr<BatchingPrefStore> user_pref_store_;
   std::unique_ptr<PrefService> prefs_;
   std::unique_ptr<ElectronDownloadManagerDelegate> download_manager_delegate_;
   std::unique_ptr<WebViewManager> guest_manager_;
@@ -251,12 +315,16 @@ class ElectronBrowserContext : public content::BrowserContext {
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<HostResolutionTracker> host_resolution_tracker_;
+  PrefChangeRegistrar pref_change_registrar_;
 
   absl::optional<std::string> user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  HttpCacheStats http_cache_stats_;
+  CreationTimings creation_timings_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // Owned by the KeyedService system.
@@ -45,6 +45,7 @@
 #include "services/network/public/cpp/features.h"
 #include "services/tracing/public/cpp/stack_sampling/tracing_sampler_profiler.h"
 #include "shell/app/electron_main_delegate.h"
+#include "shell/browser/allocator_monitor.h"
 #include "shell/browser/api/electron_api_app.h"
 #include "shell/browser/api/electron_api_utility_process.h"
 #include "shell/browser/browser.h"
@@ -52,7 +53,9 @@
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_web_ui_controller_factory.h"
+#include "shell/browser/event_loop_monitor.h"
 #include "shell/browser/feature_list.h"
+#include "shell/browser/heap_attribution.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_capture_devices_dispatcher.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
@@ -63,6 +66,7 @@
 #include "shell/common/logging.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_timeline.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -273,6 +277,9 @@ int ElectronBrowserMainParts::PreEarlyInitialization() {
 }
 
 void ElectronBrowserMainParts::PostEarlyInitialization() {
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kPostEarlyInitialization);
+
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::SingleThreadTaskRunner::HasCurrentDefault());
@@ -285,8 +292,10 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 
   node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
   // Create the global environment.
+  startup_timeline::MarkStart(startup_timeline::Phase::kCreateNodeEnvironment);
   node::Environment* env = node_bindings_->CreateEnvironment(
       js_env_->isolate()->GetCurrentContext(), js_env_->platform());
+  startup_timeline::MarkEnd(startup_timeline::Phase::kCreateNodeEnvironment);
   node_env_ = std::make_unique<NodeEnvironment>(env);
 
   env->set_trace_sync_io(env->options()->trace_sync_io);
@@ -300,11 +309,21 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   // Create explicit microtasks runner.
   js_env_->CreateMicrotasksRunner();
 
+  // Let V8 collect garbage while the UI thread is idle.
+  js_env_->CreateIdleGCScheduler();
+
+  // Name the wrappers of windows and WebContents in heap snapshots.
+  heap_attribution::Install(js_env_->isolate());
+
   // Wrap the uv loop with global env.
   node_bindings_->set_uv_env(env);
 
   // Load everything.
-  node_bindings_->LoadEnvironment(env);
+  {
+    startup_timeline::ScopedPhase load_phase(
+        startup_timeline::Phase::kLoadMainScript);
+    node_bindings_->LoadEnvironment(env);
+  }
 
   // We already initialized the feature list in PreEarlyInitialization(), but
   // the user JS script would not have had a chance to alter the command-line
@@ -362,7 +381,12 @@ int ElectronBrowserMainParts::PreCreateThreads() {
 #endif
 
   // Load resources bundle according to locale.
-  std::string loaded_locale = LoadResourceBundle(locale);
+  std::string loaded_locale;
+  {
+    startup_timeline::ScopedPhase phase(
+        startup_timeline::Phase::kLoadResourceBundle);
+    loaded_locale = LoadResourceBundle(locale);
+  }
 
 #if defined(USE_AURA)
   // NB: must be called _after_ locale resource bundle is loaded,
@@ -487,6 +511,9 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 int ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kPreMainMessageLoopRun);
+
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareEmbedThread();
@@ -495,19 +522,6 @@ int ElectronBrowserMainParts::PreMainMessageLoopRun() {
   // url::Add*Scheme are not threadsafe, this helps prevent data races.
   url::LockSchemeRegistries();
 
-#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
-  extensions_client_ = std::make_unique<ElectronExtensionsClient>();
-  extensions::ExtensionsClient::Set(extensions_client_.get());
-
-  // BrowserContextKeyedAPIServiceFactories require an ExtensionsBrowserClient.
-  extensions_browser_client_ =
-      std::make_unique<ElectronExtensionsBrowserClient>();
-  extensions::ExtensionsBrowserClient::Set(extensions_browser_client_.get());
-
-  extensions::EnsureBrowserContextKeyedServiceFactoriesBuilt();
-  extensions::electron::EnsureBrowserContextKeyedServiceFactoriesBuilt();
-#endif
-
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   SpellcheckServiceFactory::GetInstance();
 #endif
@@ -543,6 +557,26 @@ int ElectronBrowserMainParts::PreMainMessageLoopRun() {
   return GetExitCode();
 }
 
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+void ElectronBrowserMainParts::InitializeExtensions() {
+  if (extensions_browser_client_)
+    return;
+  startup_timeline::ScopedPhase phase(
+      startup_timeline::Phase::kInitializeExtensions);
+
+  extensions_client_ = std::make_unique<ElectronExtensionsClient>();
+  extensions::ExtensionsClient::Set(extensions_client_.get());
+
+  // BrowserContextKeyedAPIServiceFactories require an ExtensionsBrowserClient.
+  extensions_browser_client_ =
+      std::make_unique<ElectronExtensionsBrowserClient>();
+  extensions::ExtensionsBrowserClient::Set(extensions_browser_client_.get());
+
+  extensions::EnsureBrowserContextKeyedServiceFactoriesBuilt();
+  extensions::electron::EnsureBrowserContextKeyedServiceFactoriesBuilt();
+}
+#endif
+
 void ElectronBrowserMainParts::WillRunMainMessageLoop(
     std::unique_ptr<base::RunLoop>& run_loop) {
   exit_code_ = content::RESULT_CODE_NORMAL_EXIT;
@@ -638,6 +672,8 @@ void ElectronBrowserMainParts::PostMainMessageLoopRun() {
   // Destroy node platform after all destructors_ are executed, as they may
   // invoke Node/V8 APIs inside them.
   node_env_->env()->set_trace_sync_io(false);
+  event_loop_monitor_.reset();
+  js_env_->DestroyIdleGCScheduler();
   js_env_->DestroyMicrotasksRunner();
   node::Stop(node_env_->env(), node::StopFlags::kDoNotTerminateIsolate);
   node_env_.reset();
@@ -694,4 +730,26 @@ IconManager* ElectronBrowserMainParts::GetIconManager() {
   return icon_manager_.get();
 }
 
+AllocatorMonitor* ElectronBrowserMainParts::GetAllocatorMonitor() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!allocator_monitor_)
+    allocator_monitor_ = std::make_unique<AllocatorMonitor>();
+  return allocator_monitor_.get();
+}
+
+void ElectronBrowserMainParts::StartEventLoopMonitor(
+    base::TimeDelta long_task_threshold,
+    base::TimeDelta sample_interval) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Restarting resets the metrics.
+  event_loop_monitor_.reset();
+  event_loop_monitor_ = std::make_unique<EventLoopMonitor>(
+      node_bindings_.get(), long_task_threshold, sample_interval);
+}
+
+void ElectronBrowserMainParts::StopEventLoopMonitor() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  event_loop_monitor_.reset();
+}
+
 }  // namespace electron
@@ -10,6 +10,7 @@
 
 #include "base/functional/callback.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_main_parts.h"
@@ -43,8 +44,10 @@ class LinuxUiGetter;
 
 namespace electron {
 
+class AllocatorMonitor;
 class Browser;
 class ElectronBindings;
+class EventLoopMonitor;
 class JavascriptEnvironment;
 class NodeBindings;
 class NodeEnvironment;
@@ -90,7 +93,23 @@ class ElectronBrowserMainParts : public content::BrowserMainParts {
   // Returns handle to the class responsible for extracting file icons.
   IconManager* GetIconManager();
 
+  // Returns the stats and tuning of the allocators of the browser process.
+  AllocatorMonitor* GetAllocatorMonitor();
+
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+  // Sets up the extension system, which is done when the first browser
+  // context is created rather than before the ready event.
+  void InitializeExtensions();
+#endif
+
   Browser* browser() { return browser_.get(); }
+  NodeBindings* node_bindings() { return node_bindings_.get(); }
+
+  // Null unless started by app.startEventLoopMonitor().
+  EventLoopMonitor* event_loop_monitor() { return event_loop_monitor_.get(); }
+  void StartEventLoopMonitor(base::TimeDelta long_task_threshold,
+                             base::TimeDelta sample_interval);
+  void StopEventLoopMonitor();
   BrowserProcessImpl* browser_process() { return fake_browser_process_.get(); }
 
  protected:
@@ -162,7 +181,9 @@ class ElectronBrowserMainParts : public content::BrowserMainParts {
   std::unique_ptr<NodeBindings> node_bindings_;
   std::unique_ptr<ElectronBindings> electron_bindings_;
   std::unique_ptr<NodeEnvironment> node_env_;
+  std::unique_ptr<EventLoopMonitor> event_loop_monitor_;
   std::unique_ptr<IconManager> icon_manager_;
+  std::unique_ptr<AllocatorMonitor> allocator_monitor_;
   std::unique_ptr<base::FieldTrialList> field_trial_list_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
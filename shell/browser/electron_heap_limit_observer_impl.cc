@@ -0,0 +1,55 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/electron_heap_limit_observer_impl.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+
+namespace electron {
+
+ElectronHeapLimitObserverImpl::ElectronHeapLimitObserverImpl(
+    int render_process_id)
+    : render_process_id_(render_process_id) {}
+
+ElectronHeapLimitObserverImpl::~ElectronHeapLimitObserverImpl() = default;
+
+// static
+void ElectronHeapLimitObserverImpl::Create(
+    int render_process_id,
+    mojo::PendingReceiver<mojom::ElectronHeapLimitObserver> receiver) {
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<ElectronHeapLimitObserverImpl>(render_process_id),
+      std::move(receiver));
+}
+
+void ElectronHeapLimitObserverImpl::OnNearHeapLimit(uint64_t initial_heap_limit,
+                                                    uint64_t heap_limit,
+                                                    uint64_t used_heap_size) {
+  // The pages of the renderer share its heap. Handling the event can destroy
+  // the other pages.
+  std::vector<base::WeakPtr<api::WebContents>> pages;
+  for (api::WebContents* web_contents : api::WebContents::GetAll()) {
+    content::WebContents* contents = web_contents->web_contents();
+    if (contents && contents->GetPrimaryMainFrame()->GetProcess()->GetID() ==
+                        render_process_id_) {
+      pages.push_back(web_contents->GetWeakPtr());
+    }
+  }
+  for (const auto& web_contents : pages) {
+    if (web_contents) {
+      web_contents->OnNearHeapLimit(initial_heap_limit, heap_limit,
+                                    used_heap_size);
+    }
+  }
+}
+
+}  // namespace electron
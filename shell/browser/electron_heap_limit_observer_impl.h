@@ -0,0 +1,39 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_ELECTRON_HEAP_LIMIT_OBSERVER_IMPL_H_
+#define ELECTRON_SHELL_BROWSER_ELECTRON_HEAP_LIMIT_OBSERVER_IMPL_H_
+
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+
+namespace electron {
+
+// Forwards the near heap limit reports of a renderer to the pages it hosts.
+class ElectronHeapLimitObserverImpl : public mojom::ElectronHeapLimitObserver {
+ public:
+  explicit ElectronHeapLimitObserverImpl(int render_process_id);
+  ~ElectronHeapLimitObserverImpl() override;
+
+  static void Create(
+      int render_process_id,
+      mojo::PendingReceiver<mojom::ElectronHeapLimitObserver> receiver);
+
+  // disable copy
+  ElectronHeapLimitObserverImpl(const ElectronHeapLimitObserverImpl&) = delete;
+  ElectronHeapLimitObserverImpl& operator=(
+      const ElectronHeapLimitObserverImpl&) = delete;
+
+  // mojom::ElectronHeapLimitObserver:
+  void OnNearHeapLimit(uint64_t initial_heap_limit,
+                       uint64_t heap_limit,
+                       uint64_t used_heap_size) override;
+
+ private:
+  const int render_process_id_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_ELECTRON_HEAP_LIMIT_OBSERVER_IMPL_H_
@@ -29,6 +29,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "third_party/blink/public/common/permissions/permission_utils.h"
+#include "url/origin.h"
 
 namespace electron {
 
@@ -48,6 +49,10 @@ void PermissionRequestResponseCallbackWrapper(
   std::move(callback).Run(vector[0]);
 }
 
+// The results of the check handler which are kept, the least recently used
+// ones are dropped past it.
+constexpr size_t kMaxCachedChecks = 256;
+
 }  // namespace
 
 class ElectronPermissionManager::PendingRequest {
@@ -101,7 +106,8 @@ class ElectronPermissionManager::PendingRequest {
   size_t remaining_results_;
 };
 
-ElectronPermissionManager::ElectronPermissionManager() = default;
+ElectronPermissionManager::ElectronPermissionManager()
+    : check_cache_(kMaxCachedChecks) {}
 
 ElectronPermissionManager::~ElectronPermissionManager() = default;
 
@@ -122,6 +128,7 @@ void ElectronPermissionManager::SetPermissionRequestHandler(
 void ElectronPermissionManager::SetPermissionCheckHandler(
     const CheckHandler& handler) {
   check_handler_ = handler;
+  ClearPermissionCheckCache();
 }
 
 void ElectronPermissionManager::SetDevicePermissionHandler(
@@ -139,6 +146,20 @@ void ElectronPermissionManager::SetBluetoothPairingHandler(
   bluetooth_pairing_handler_ = handler;
 }
 
+void ElectronPermissionManager::CopyHandlersFrom(
+    const ElectronPermissionManager& other) {
+  request_handler_ = other.request_handler_;
+  check_handler_ = other.check_handler_;
+  device_permission_handler_ = other.device_permission_handler_;
+  protected_usb_handler_ = other.protected_usb_handler_;
+  bluetooth_pairing_handler_ = other.bluetooth_pairing_handler_;
+  ClearPermissionCheckCache();
+}
+
+void ElectronPermissionManager::ClearPermissionCheckCache() {
+  check_cache_.Clear();
+}
+
 void ElectronPermissionManager::RequestPermission(
     blink::PermissionType permission,
     content::RenderFrameHost* render_frame_host,
@@ -317,8 +338,23 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     details.Set("requestingUrl",
                 render_frame_host->GetLastCommittedURL().spec());
   }
-  details.Set("isMainFrame",
-              render_frame_host && render_frame_host->GetParent() == nullptr);
+  const bool is_main_frame =
+      render_frame_host && render_frame_host->GetParent() == nullptr;
+  details.Set("isMainFrame", is_main_frame);
+
+  const std::string* embedding_origin = details.FindString("embeddingOrigin");
+  CheckCacheKey key(permission,
+                    url::Origin::Create(requesting_origin).Serialize(),
+                    embedding_origin ? *embedding_origin : std::string(),
+                    is_main_frame);
+  auto cached = check_cache_.Get(key);
+  if (cached != check_cache_.end()) {
+    if (cached->second.expiry.is_null() ||
+        base::TimeTicks::Now() < cached->second.expiry)
+      return cached->second.granted;
+    check_cache_.Erase(cached);
+  }
+
   switch (permission) {
     case blink::PermissionType::AUDIO_CAPTURE:
       details.Set("mediaType", "audio");
@@ -329,8 +365,17 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     default:
       break;
   }
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            base::Value(std::move(details)));
+  CheckResult result =
+      check_handler_.Run(web_contents, permission, requesting_origin,
+                         base::Value(std::move(details)));
+  if (result.cache) {
+    CachedCheck entry;
+    entry.granted = result.granted;
+    if (result.cache_ttl)
+      entry.expiry = base::TimeTicks::Now() + *result.cache_ttl;
+    check_cache_.Put(std::move(key), entry);
+  }
+  return result.granted;
 }
 
 bool ElectronPermissionManager::CheckDevicePermission(
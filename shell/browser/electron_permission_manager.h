@@ -6,14 +6,19 @@
 #define ELECTRON_SHELL_BROWSER_ELECTRON_PERMISSION_MANAGER_H_
 
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
+#include "base/time/time.h"
 #include "content/public/browser/permission_controller_delegate.h"
 #include "gin/dictionary.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace base {
 class Value;
@@ -46,11 +51,20 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
                                                       blink::PermissionType,
                                                       StatusCallback,
                                                       const base::Value&)>;
+  // What the check handler returned.
+  struct CheckResult {
+    bool granted = false;
+    // Whether the result is used for the next checks of the same permission
+    // from the same origins and frame type, until |cache_ttl| passed when
+    // set, or the cache is cleared.
+    bool cache = false;
+    absl::optional<base::TimeDelta> cache_ttl;
+  };
   using CheckHandler =
-      base::RepeatingCallback<bool(content::WebContents*,
-                                   blink::PermissionType,
-                                   const GURL& requesting_origin,
-                                   const base::Value&)>;
+      base::RepeatingCallback<CheckResult(content::WebContents*,
+                                          blink::PermissionType,
+                                          const GURL& requesting_origin,
+                                          const base::Value&)>;
 
   using DeviceCheckHandler =
       base::RepeatingCallback<bool(const v8::Local<v8::Object>&)>;
@@ -67,6 +81,10 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   void SetDevicePermissionHandler(const DeviceCheckHandler& handler);
   void SetProtectedUSBHandler(const ProtectedUSBHandler& handler);
   void SetBluetoothPairingHandler(const BluetoothPairingHandler& handler);
+  // Uses the same handlers as |other|.
+  void CopyHandlersFrom(const ElectronPermissionManager& other);
+  // Forgets the results of the check handler which were cached.
+  void ClearPermissionCheckCache();
 
   // content::PermissionControllerDelegate:
   void RequestPermission(blink::PermissionType permission,
@@ -173,6 +191,18 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
   BluetoothPairingHandler bluetooth_pairing_handler_;
 
   PendingRequestsMap pending_requests_;
+
+  // The permission, the requesting and embedding origins, and whether the
+  // check is from a main frame.
+  using CheckCacheKey =
+      std::tuple<blink::PermissionType, std::string, std::string, bool>;
+  struct CachedCheck {
+    bool granted = false;
+    // Null when the result doesn't expire.
+    base::TimeTicks expiry;
+  };
+  // Mutable as checks are const.
+  mutable base::LRUCache<CheckCacheKey, CachedCheck> check_cache_;
 };
 
 }  // namespace electron
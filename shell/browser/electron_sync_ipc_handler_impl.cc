@@ -0,0 +1,191 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/electron_sync_ipc_handler_impl.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/ipc_channel_metrics.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/v8_value_serializer.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
+
+namespace electron {
+
+namespace {
+
+struct Route {
+  mojo::SharedRemote<node::mojom::IpcInvokeHandler> handler;
+  std::vector<uint8_t> error_reply;
+};
+
+// Only used on ElectronSyncIPCHandlerImpl::GetTaskRunner().
+std::map<std::string, Route>& GetRoutes() {
+  static base::NoDestructor<std::map<std::string, Route>> routes;
+  return *routes;
+}
+
+blink::TransferableMessage MakeMessage(const std::vector<uint8_t>& encoded) {
+  blink::TransferableMessage message;
+  message.owned_encoded_message = encoded;
+  message.encoded_message = message.owned_encoded_message;
+  return message;
+}
+
+// Sends the error reply of the route if the utility process goes away before
+// replying. Mojo requires reply callbacks to be run before they are destroyed.
+class RoutedReply {
+ public:
+  RoutedReply(const std::vector<uint8_t>& error_reply,
+              mojom::ElectronSyncIPC::InvokeCallback callback)
+      : error_reply_(error_reply), callback_(std::move(callback)) {}
+  ~RoutedReply() {
+    if (callback_)
+      std::move(callback_).Run(MakeMessage(error_reply_));
+  }
+
+  // disable copy
+  RoutedReply(const RoutedReply&) = delete;
+  RoutedReply& operator=(const RoutedReply&) = delete;
+
+  void Run(blink::TransferableMessage result) {
+    std::move(callback_).Run(std::move(result));
+  }
+
+ private:
+  std::vector<uint8_t> error_reply_;
+  mojom::ElectronSyncIPC::InvokeCallback callback_;
+};
+
+void InvokeOnUIThread(content::GlobalRenderFrameHostId render_frame_host_id,
+                      const std::string& channel,
+                      blink::CloneableMessage arguments,
+                      mojom::ElectronSyncIPC::InvokeCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  content::RenderFrameHost* frame =
+      content::RenderFrameHost::FromID(render_frame_host_id);
+  api::WebContents* api_web_contents =
+      frame ? api::WebContents::From(
+                  content::WebContents::FromRenderFrameHost(frame))
+            : nullptr;
+  if (!api_web_contents) {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto error = gin::DataObjectBuilder(isolate)
+                     .Set("error", "WebContents was destroyed")
+                     .Build();
+    blink::TransferableMessage message;
+    electron::SerializeV8Value(isolate, error, &message);
+    std::move(callback).Run(std::move(message));
+    return;
+  }
+  IPCChannelMetrics& metrics = api_web_contents->ipc_metrics();
+  api_web_contents->Invoke(
+      false, channel, std::move(arguments),
+      metrics.WrapReplyCallback(false, channel, std::move(callback)), frame);
+}
+
+}  // namespace
+
+ElectronSyncIPCHandlerImpl::ElectronSyncIPCHandlerImpl(
+    content::RenderFrameHost* frame_host,
+    int32_t web_contents_id)
+    : render_frame_host_id_(frame_host->GetGlobalId()),
+      web_contents_id_(web_contents_id) {}
+
+ElectronSyncIPCHandlerImpl::~ElectronSyncIPCHandlerImpl() = default;
+
+// static
+void ElectronSyncIPCHandlerImpl::Create(
+    content::RenderFrameHost* frame_host,
+    mojo::PendingReceiver<mojom::ElectronSyncIPC> receiver) {
+  api::WebContents* api_web_contents = api::WebContents::From(
+      content::WebContents::FromRenderFrameHost(frame_host));
+  auto impl = std::make_unique<ElectronSyncIPCHandlerImpl>(
+      frame_host, api_web_contents ? api_web_contents->ID() : -1);
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<ElectronSyncIPCHandlerImpl> impl,
+             mojo::PendingReceiver<mojom::ElectronSyncIPC> receiver) {
+            mojo::MakeSelfOwnedReceiver(std::move(impl), std::move(receiver));
+          },
+          std::move(impl), std::move(receiver)));
+}
+
+// static
+scoped_refptr<base::SequencedTaskRunner>
+ElectronSyncIPCHandlerImpl::GetTaskRunner() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>>
+      task_runner(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+  return *task_runner;
+}
+
+// static
+void ElectronSyncIPCHandlerImpl::AddRoute(
+    const std::string& channel,
+    mojo::SharedRemote<node::mojom::IpcInvokeHandler> handler,
+    std::vector<uint8_t> error_reply) {
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](const std::string& channel, Route route) {
+            GetRoutes().insert_or_assign(channel, std::move(route));
+          },
+          channel, Route{std::move(handler), std::move(error_reply)}));
+}
+
+// static
+void ElectronSyncIPCHandlerImpl::RemoveRoute(const std::string& channel) {
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](const std::string& channel) {
+                       GetRoutes().erase(channel);
+                     },
+                     channel));
+}
+
+void ElectronSyncIPCHandlerImpl::Invoke(const std::string& channel,
+                                        blink::CloneableMessage arguments,
+                                        InvokeCallback callback) {
+  TRACE_EVENT1("electron", "ElectronSyncIPCHandlerImpl::Invoke", "channel",
+               channel);
+  auto& routes = GetRoutes();
+  auto it = routes.find(channel);
+  if (it == routes.end()) {
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE,
+        base::BindOnce(&InvokeOnUIThread, render_frame_host_id_, channel,
+                       std::move(arguments),
+                       base::BindPostTask(GetTaskRunner(),
+                                          std::move(callback))));
+    return;
+  }
+  it->second.handler->Invoke(
+      node::mojom::IpcInvokeSender::New(web_contents_id_,
+                                        render_frame_host_id_.child_id,
+                                        render_frame_host_id_.frame_routing_id),
+      channel, std::move(arguments),
+      base::BindOnce(&RoutedReply::Run,
+                     base::Owned(std::make_unique<RoutedReply>(
+                         it->second.error_reply, std::move(callback)))));
+}
+
+}  // namespace electron
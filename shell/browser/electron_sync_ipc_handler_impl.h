@@ -0,0 +1,67 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_ELECTRON_SYNC_IPC_HANDLER_IMPL_H_
+#define ELECTRON_SHELL_BROWSER_ELECTRON_SYNC_IPC_HANDLER_IMPL_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "content/public/browser/global_routing_id.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/shared_remote.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
+
+namespace content {
+class RenderFrameHost;
+}
+
+namespace electron {
+
+// Answers ipcRenderer.invokeSync() for one frame. Lives on GetTaskRunner(),
+// where channels routed to a utility process are forwarded to it without
+// touching the UI thread. Other channels hop to the UI thread and are handled
+// by ipcMain.handle(), like ipcRenderer.invoke().
+class ElectronSyncIPCHandlerImpl : public mojom::ElectronSyncIPC {
+ public:
+  ElectronSyncIPCHandlerImpl(content::RenderFrameHost* frame_host,
+                             int32_t web_contents_id);
+  ~ElectronSyncIPCHandlerImpl() override;
+
+  static void Create(content::RenderFrameHost* frame_host,
+                     mojo::PendingReceiver<mojom::ElectronSyncIPC> receiver);
+
+  static scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
+
+  // Called on the UI thread by child.routeInvoke() and child.unrouteInvoke().
+  // |error_reply| is the encoded { error } sent when |handler| goes away
+  // before replying, V8 can't be used on GetTaskRunner() to make it then.
+  static void AddRoute(
+      const std::string& channel,
+      mojo::SharedRemote<node::mojom::IpcInvokeHandler> handler,
+      std::vector<uint8_t> error_reply);
+  static void RemoveRoute(const std::string& channel);
+
+  // disable copy
+  ElectronSyncIPCHandlerImpl(const ElectronSyncIPCHandlerImpl&) = delete;
+  ElectronSyncIPCHandlerImpl& operator=(const ElectronSyncIPCHandlerImpl&) =
+      delete;
+
+  // mojom::ElectronSyncIPC:
+  void Invoke(const std::string& channel,
+              blink::CloneableMessage arguments,
+              InvokeCallback callback) override;
+
+ private:
+  const content::GlobalRenderFrameHostId render_frame_host_id_;
+  const int32_t web_contents_id_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_ELECTRON_SYNC_IPC_HANDLER_IMPL_H_
@@ -44,10 +44,24 @@ void ElectronWebContentsUtilityHandlerImpl::OnFirstNonEmptyLayout() {
 }
 
 void ElectronWebContentsUtilityHandlerImpl::UpdateDraggableRegions(
+    uint32_t start,
+    uint32_t removed_count,
     std::vector<mojom::DraggableRegionPtr> regions) {
+  if (start > draggable_regions_.size() ||
+      removed_count > draggable_regions_.size() - start) {
+    receiver_.ReportBadMessage("Invalid draggable regions update");
+    return;
+  }
+  auto removed_begin = draggable_regions_.begin() + start;
+  draggable_regions_.erase(removed_begin, removed_begin + removed_count);
+  draggable_regions_.insert(draggable_regions_.begin() + start,
+                            std::make_move_iterator(regions.begin()),
+                            std::make_move_iterator(regions.end()));
+
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->UpdateDraggableRegions(std::move(regions));
+    api_web_contents->UpdateDraggableRegions(GetRenderFrameHost(),
+                                             draggable_regions_, start);
   }
 }
 
@@ -42,6 +42,8 @@ class ElectronWebContentsUtilityHandlerImpl
   // mojom::ElectronWebContentsUtility:
   void OnFirstNonEmptyLayout() override;
   void UpdateDraggableRegions(
+      uint32_t start,
+      uint32_t removed_count,
       std::vector<mojom::DraggableRegionPtr> regions) override;
   void SetTemporaryZoomLevel(double level) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
@@ -62,6 +64,10 @@ class ElectronWebContentsUtilityHandlerImpl
 
   content::GlobalRenderFrameHostId render_frame_host_id_;
 
+  // The draggable regions of the frame, patched by each update. The renderer
+  // keeps the connection open for them.
+  std::vector<mojom::DraggableRegionPtr> draggable_regions_;
+
   mojo::AssociatedReceiver<mojom::ElectronWebContentsUtility> receiver_{this};
 
   base::WeakPtrFactory<ElectronWebContentsUtilityHandlerImpl> weak_factory_{
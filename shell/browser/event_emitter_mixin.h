@@ -9,6 +9,7 @@
 
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
+#include "shell/browser/api/electron_api_event_emitter.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_helper/event.h"
 #include "shell/common/gin_helper/event_emitter.h"
@@ -29,7 +30,8 @@ class EventEmitterMixin {
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::Object> wrapper;
-    if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
+    if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper) ||
+        !electron::ShouldEmitEvent(isolate, wrapper, name))
       return false;
     gin::Handle<internal::Event> event = internal::Event::New(isolate);
     gin_helper::EmitEvent(isolate, wrapper, name, event,
@@ -43,7 +45,8 @@ class EventEmitterMixin {
     v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::Object> wrapper;
-    if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
+    if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper) ||
+        !electron::ShouldEmitEvent(isolate, wrapper, name))
       return;
     gin_helper::EmitEvent(isolate, wrapper, name, std::forward<Args>(args)...);
   }
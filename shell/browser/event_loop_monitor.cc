@@ -0,0 +1,87 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/event_loop_monitor.h"
+
+#include <algorithm>
+
+#include "base/bits.h"
+#include "base/functional/bind.h"
+#include "base/task/current_thread.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/common/node_bindings.h"
+
+namespace electron {
+
+void EventLoopMonitor::Histogram::Add(base::TimeDelta sample) {
+  const uint32_t ms = static_cast<uint32_t>(
+      std::clamp<int64_t>(sample.InMilliseconds(), 0, 1 << 30));
+  // Samples under 1 ms land in bucket 0, under 2 ms in bucket 1, etc.
+  const size_t bucket = ms == 0 ? 0 : base::bits::Log2Floor(ms) + 1;
+  ++counts[std::min(bucket, kBucketCount - 1)];
+  ++count;
+  total += sample;
+  max = std::max(max, sample);
+}
+
+EventLoopMonitor::EventLoopMonitor(NodeBindings* node_bindings,
+                                   base::TimeDelta long_task_threshold,
+                                   base::TimeDelta sample_interval)
+    : node_bindings_(node_bindings),
+      long_task_threshold_(long_task_threshold) {
+  base::CurrentThread::Get()->AddTaskObserver(this);
+  node_bindings_->set_uv_run_observer(base::BindRepeating(
+      &EventLoopMonitor::OnUvRun, weak_factory_.GetWeakPtr()));
+  sample_timer_.Start(FROM_HERE, sample_interval, this,
+                      &EventLoopMonitor::OnSampleTimer);
+}
+
+EventLoopMonitor::~EventLoopMonitor() {
+  node_bindings_->set_uv_run_observer({});
+  if (base::CurrentThread::IsSet())
+    base::CurrentThread::Get()->RemoveTaskObserver(this);
+}
+
+void EventLoopMonitor::WillProcessTask(const base::PendingTask& pending_task,
+                                       bool was_blocked_or_low_priority) {
+  if (depth_++ > 0)
+    return;
+  task_start_ = base::TimeTicks::Now();
+}
+
+void EventLoopMonitor::DidProcessTask(const base::PendingTask& pending_task) {
+  if (--depth_ > 0)
+    return;
+  const base::TimeDelta duration = base::TimeTicks::Now() - task_start_;
+  task_duration_.Add(duration);
+  if (duration < long_task_threshold_)
+    return;
+
+  TRACE_EVENT_INSTANT2("electron", "EventLoopMonitor::LongTask",
+                       TRACE_EVENT_SCOPE_THREAD, "ms",
+                       duration.InMillisecondsF(), "posted_from",
+                       pending_task.posted_from.ToString());
+  if (long_tasks_.size() == kMaxLongTasks)
+    long_tasks_.pop_front();
+  long_tasks_.push_back(
+      {pending_task.posted_from, base::Time::Now() - duration, duration});
+}
+
+void EventLoopMonitor::OnSampleTimer() {
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&EventLoopMonitor::OnProbe,
+                                weak_factory_.GetWeakPtr(),
+                                base::TimeTicks::Now()));
+}
+
+void EventLoopMonitor::OnProbe(base::TimeTicks posted) {
+  queueing_delay_.Add(base::TimeTicks::Now() - posted);
+}
+
+void EventLoopMonitor::OnUvRun(base::TimeDelta duration) {
+  uv_run_duration_.Add(duration);
+}
+
+}  // namespace electron
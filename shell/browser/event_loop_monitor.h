@@ -0,0 +1,97 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_EVENT_LOOP_MONITOR_H_
+#define ELECTRON_SHELL_BROWSER_EVENT_LOOP_MONITOR_H_
+
+#include <array>
+#include <cstdint>
+
+#include "base/containers/circular_deque.h"
+#include "base/location.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+class NodeBindings;
+
+// Measures how responsive the UI thread of the browser process is, for
+// app.getEventLoopMetrics(). Every task is timed, which only costs two clock
+// reads, while the time tasks wait in the queue is sampled by posting a probe
+// task at a fixed interval, as Chromium only records the queue time of tasks
+// when tracing.
+class EventLoopMonitor : public base::TaskObserver {
+ public:
+  // Bucket i counts the samples under 2^i ms, the last bucket everything
+  // longer than that.
+  static constexpr size_t kBucketCount = 14;
+
+  struct Histogram {
+    void Add(base::TimeDelta sample);
+
+    std::array<uint64_t, kBucketCount> counts = {};
+    uint64_t count = 0;
+    base::TimeDelta total;
+    base::TimeDelta max;
+  };
+
+  struct LongTask {
+    base::Location posted_from;
+    base::Time start_time;
+    base::TimeDelta duration;
+  };
+
+  // Only the most recent long tasks are kept.
+  static constexpr size_t kMaxLongTasks = 64;
+
+  EventLoopMonitor(NodeBindings* node_bindings,
+                   base::TimeDelta long_task_threshold,
+                   base::TimeDelta sample_interval);
+  ~EventLoopMonitor() override;
+
+  // disable copy
+  EventLoopMonitor(const EventLoopMonitor&) = delete;
+  EventLoopMonitor& operator=(const EventLoopMonitor&) = delete;
+
+  const Histogram& queueing_delay() const { return queueing_delay_; }
+  const Histogram& task_duration() const { return task_duration_; }
+  const Histogram& uv_run_duration() const { return uv_run_duration_; }
+  const base::circular_deque<LongTask>& long_tasks() const {
+    return long_tasks_;
+  }
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  void OnSampleTimer();
+  void OnProbe(base::TimeTicks posted);
+  void OnUvRun(base::TimeDelta duration);
+
+  raw_ptr<NodeBindings> node_bindings_;
+  const base::TimeDelta long_task_threshold_;
+
+  Histogram queueing_delay_;
+  Histogram task_duration_;
+  Histogram uv_run_duration_;
+  base::circular_deque<LongTask> long_tasks_;
+
+  // Tasks of nested run loops are part of the outermost one.
+  int depth_ = 0;
+  base::TimeTicks task_start_;
+
+  base::RepeatingTimer sample_timer_;
+
+  base::WeakPtrFactory<EventLoopMonitor> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_EVENT_LOOP_MONITOR_H_
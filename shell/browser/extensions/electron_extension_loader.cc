@@ -4,13 +4,16 @@
 
 #include "shell/browser/extensions/electron_extension_loader.h"
 
+#include <map>
 #include <utility>
 
 #include "base/auto_reset.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/sequenced_task_runner.h"
@@ -20,6 +23,7 @@
 #include "extensions/browser/extension_prefs.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/pref_names.h"
+#include "extensions/common/constants.h"
 #include "extensions/common/error_utils.h"
 #include "extensions/common/file_util.h"
 #include "extensions/common/manifest_constants.h"
@@ -30,9 +34,63 @@ using LoadErrorBehavior = ExtensionRegistrar::LoadErrorBehavior;
 
 namespace {
 
-std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
-    const base::FilePath& extension_dir,
-    int load_flags) {
+using LoadResult = std::pair<scoped_refptr<const Extension>, std::string>;
+
+// The extensions parsed by LoadUnpacked(), shared by all the sessions which
+// load the same directory, so that loading an extension into many sessions
+// only reads and validates its files once. The extensions are immutable, an
+// entry is parsed again when the directory or the manifest was modified
+// since. Only used on the extension file task runner.
+class ParsedExtensionCache {
+ public:
+  static ParsedExtensionCache* Get() {
+    static base::NoDestructor<ParsedExtensionCache> cache;
+    return cache.get();
+  }
+
+  ParsedExtensionCache() = default;
+
+  // disable copy
+  ParsedExtensionCache(const ParsedExtensionCache&) = delete;
+  ParsedExtensionCache& operator=(const ParsedExtensionCache&) = delete;
+
+  const LoadResult* Find(const base::FilePath& extension_dir,
+                         int load_flags) const {
+    auto it = entries_.find(extension_dir);
+    if (it == entries_.end() || it->second.load_flags != load_flags ||
+        it->second.modified != GetLastModified(extension_dir))
+      return nullptr;
+    return &it->second.result;
+  }
+
+  void Put(const base::FilePath& extension_dir,
+           int load_flags,
+           const LoadResult& result) {
+    entries_[extension_dir] = {load_flags, GetLastModified(extension_dir),
+                               result};
+  }
+
+ private:
+  struct Entry {
+    int load_flags;
+    std::pair<base::Time, base::Time> modified;
+    LoadResult result;
+  };
+
+  static std::pair<base::Time, base::Time> GetLastModified(
+      const base::FilePath& extension_dir) {
+    base::File::Info dir_info, manifest_info;
+    base::GetFileInfo(extension_dir, &dir_info);
+    base::GetFileInfo(extension_dir.Append(kManifestFilename), &manifest_info);
+    return {dir_info.last_modified, manifest_info.last_modified};
+  }
+
+  std::map<base::FilePath, Entry> entries_;
+};
+
+LoadResult LoadUnpacked(const base::FilePath& extension_dir,
+                        int load_flags,
+                        bool use_cache) {
   // app_shell only supports unpacked extensions.
   // NOTE: If you add packed extension support consider removing the flag
   // FOLLOW_SYMLINKS_ANYWHERE below. Packed extensions should not have symlinks.
@@ -42,6 +100,12 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
     return std::make_pair(nullptr, err);
   }
 
+  if (use_cache) {
+    if (const LoadResult* result =
+            ParsedExtensionCache::Get()->Find(extension_dir, load_flags))
+      return *result;
+  }
+
   // remove _metadata folder. Otherwise, the following warning will be thrown
   // Cannot load extension with file or directory name _metadata.
   // Filenames starting with "_" are reserved for use by the system.
@@ -87,7 +151,9 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
     }
   }
 
-  return std::make_pair(extension, warnings);
+  LoadResult result = std::make_pair(extension, warnings);
+  ParsedExtensionCache::Get()->Put(extension_dir, load_flags, result);
+  return result;
 }
 
 }  // namespace
@@ -104,7 +170,8 @@ void ElectronExtensionLoader::LoadExtension(
     int load_flags,
     base::OnceCallback<void(const Extension*, const std::string&)> cb) {
   GetExtensionFileTaskRunner()->PostTaskAndReplyWithResult(
-      FROM_HERE, base::BindOnce(&LoadUnpacked, extension_dir, load_flags),
+      FROM_HERE, base::BindOnce(&LoadUnpacked, extension_dir, load_flags,
+                                /*use_cache=*/true),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionLoad,
                      weak_factory_.GetWeakPtr(), std::move(cb)));
 }
@@ -204,8 +271,11 @@ void ElectronExtensionLoader::LoadExtensionForReload(
   // when loading this extension and retain it here. As is, reloading an
   // extension will cause the file access permission to be dropped.
   int load_flags = Extension::FOLLOW_SYMLINKS_ANYWHERE;
+  // A reload parses the files again, as the ones which aren't the manifest
+  // could have changed too.
   GetExtensionFileTaskRunner()->PostTaskAndReplyWithResult(
-      FROM_HERE, base::BindOnce(&LoadUnpacked, path, load_flags),
+      FROM_HERE,
+      base::BindOnce(&LoadUnpacked, path, load_flags, /*use_cache=*/false),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionReload,
                      weak_factory_.GetWeakPtr(), extension_id));
   did_schedule_reload_ = true;
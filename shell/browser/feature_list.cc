@@ -10,12 +10,16 @@
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "components/download/public/common/download_features.h"
 #include "components/spellcheck/common/spellcheck_features.h"
 #include "content/public/common/content_features.h"
 #include "electron/buildflags/buildflags.h"
 #include "media/base/media_switches.h"
 #include "net/base/features.h"
 #include "services/network/public/cpp/features.h"
+#include "shell/common/options_switches.h"
 
 #if BUILDFLAG(IS_MAC)
 #include "device/base/features.h"  // nogncheck
@@ -36,6 +40,18 @@ void InitializeFeatureList() {
   disable_features +=
       std::string(",") + features::kSpareRendererForSitePerProcess.name;
 
+  // Downloads of large files from servers which accept ranges get more
+  // connections, the count is a parameter of the feature.
+  unsigned parallel_requests = 0;
+  if (base::StringToUint(
+          cmd_line->GetSwitchValueASCII(switches::kParallelDownloadRequests),
+          &parallel_requests) &&
+      parallel_requests > 1) {
+    enable_features += base::StringPrintf(
+        ",%s:request_count/%u", download::features::kParallelDownloading.name,
+        parallel_requests);
+  }
+
 #if BUILDFLAG(IS_WIN)
   disable_features +=
       // Disable async spellchecker suggestions for Windows, which causes
@@ -0,0 +1,254 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/flight_recorder.h"
+
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/current_thread.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_config.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "services/tracing/public/cpp/perfetto/perfetto_config.h"
+#include "third_party/perfetto/include/perfetto/tracing/tracing.h"
+
+namespace electron {
+
+namespace {
+
+// Dumps of the triggers which come closer than this are dropped.
+constexpr base::TimeDelta kMinTriggerInterval = base::Seconds(30);
+
+constexpr size_t kMaxDumps = 16;
+
+const char* TriggerToString(FlightRecorder::Trigger trigger) {
+  switch (trigger) {
+    case FlightRecorder::Trigger::kLongTask:
+      return "long-task";
+    case FlightRecorder::Trigger::kHang:
+      return "hang";
+    case FlightRecorder::Trigger::kCrash:
+      return "crash";
+  }
+  return "";
+}
+
+// Reads the trace of a stopped session and writes it to a file. The
+// callbacks of the session run on the tracing sequence and keep the reader
+// alive until the trace is written.
+class TraceReader : public base::RefCountedThreadSafe<TraceReader> {
+ public:
+  TraceReader(std::unique_ptr<perfetto::TracingSession> session,
+              const base::FilePath& path,
+              FlightRecorder::DumpCallback callback)
+      : session_(std::move(session)),
+        path_(path),
+        callback_(std::move(callback)) {}
+
+  // disable copy
+  TraceReader(const TraceReader&) = delete;
+  TraceReader& operator=(const TraceReader&) = delete;
+
+  void Start() {
+    scoped_refptr<TraceReader> self(this);
+    session_->SetOnStopCallback([self] { self->OnStopped(); });
+    session_->Stop();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<TraceReader>;
+
+  ~TraceReader() = default;
+
+  void OnStopped() {
+    scoped_refptr<TraceReader> self(this);
+    session_->ReadTrace(
+        [self](perfetto::TracingSession::ReadTraceCallbackArgs args) {
+          if (args.size)
+            self->data_.append(args.data, args.size);
+          if (!args.has_more) {
+            content::GetUIThreadTaskRunner({})->PostTask(
+                FROM_HERE, base::BindOnce(&TraceReader::Write, self));
+          }
+        });
+  }
+
+  void Write() {
+    // The session holds the callbacks which reference |this|.
+    session_.reset();
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](const base::FilePath& path, std::string data) {
+              return base::CreateDirectory(path.DirName()) &&
+                     base::WriteFile(path, data);
+            },
+            path_, std::move(data_)),
+        base::BindOnce(
+            [](FlightRecorder::DumpCallback callback, bool success) {
+              if (success)
+                std::move(callback).Run(absl::nullopt);
+              else
+                std::move(callback).Run("Failed to write the trace");
+            },
+            std::move(callback_)));
+  }
+
+  std::unique_ptr<perfetto::TracingSession> session_;
+  const base::FilePath path_;
+  FlightRecorder::DumpCallback callback_;
+  std::string data_;
+};
+
+}  // namespace
+
+FlightRecorder::Options::Options() = default;
+FlightRecorder::Options::Options(const Options&) = default;
+FlightRecorder::Options& FlightRecorder::Options::operator=(const Options&) =
+    default;
+FlightRecorder::Options::~Options() = default;
+
+// static
+std::vector<std::string> FlightRecorder::GetDefaultCategories() {
+  return {"toplevel", "toplevel.flow", "ipc",     "mojom",
+          "electron", "navigation",    "startup", "viz"};
+}
+
+// static
+FlightRecorder* FlightRecorder::GetInstance() {
+  static base::NoDestructor<FlightRecorder> instance;
+  return instance.get();
+}
+
+FlightRecorder::FlightRecorder() = default;
+
+FlightRecorder::~FlightRecorder() = default;
+
+void FlightRecorder::Start(const Options& options, base::OnceClosure started) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Stop();
+  options_ = options;
+  on_started_ = std::move(started);
+  StartSession();
+  if (options_.triggers.contains(Trigger::kLongTask)) {
+    // Called from a task, which the observer doesn't see start.
+    depth_ = 1;
+    task_start_ = base::TimeTicks::Now();
+    base::CurrentThread::Get()->AddTaskObserver(this);
+  }
+}
+
+void FlightRecorder::Stop() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!session_)
+    return;
+  if (options_.triggers.contains(Trigger::kLongTask))
+    base::CurrentThread::Get()->RemoveTaskObserver(this);
+  // Destroying the session discards its trace.
+  session_.reset();
+  if (on_started_)
+    std::move(on_started_).Run();
+}
+
+void FlightRecorder::DumpTo(const base::FilePath& path,
+                            DumpCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!session_) {
+    std::move(callback).Run("Flight recorder is not recording");
+    return;
+  }
+  // A session can't be read while it records, the buffer is handed over to
+  // a reader and a new one records in the meantime.
+  auto reader = base::MakeRefCounted<TraceReader>(std::move(session_), path,
+                                                  std::move(callback));
+  reader->Start();
+  StartSession();
+}
+
+void FlightRecorder::OnTrigger(Trigger trigger) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!session_ || !options_.triggers.contains(trigger) ||
+      options_.directory.empty()) {
+    return;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_trigger_.is_null() && now - last_trigger_ < kMinTriggerInterval)
+    return;
+  last_trigger_ = now;
+
+  Dump dump;
+  dump.trigger = trigger;
+  dump.time = base::Time::Now();
+  dump.path = options_.directory.AppendASCII(
+      base::StrCat({"flight-recorder-", TriggerToString(trigger), "-",
+                    base::NumberToString(dump.time.ToJavaTime()),
+                    ".pftrace"}));
+  // Unretained is safe as the recorder is never destroyed.
+  DumpTo(dump.path, base::BindOnce(&FlightRecorder::OnTriggerDumped,
+                                   base::Unretained(this), dump));
+}
+
+void FlightRecorder::WillProcessTask(const base::PendingTask& pending_task,
+                                     bool was_blocked_or_low_priority) {
+  if (depth_++ > 0)
+    return;
+  task_start_ = base::TimeTicks::Now();
+}
+
+void FlightRecorder::DidProcessTask(const base::PendingTask& pending_task) {
+  if (--depth_ > 0)
+    return;
+  if (base::TimeTicks::Now() - task_start_ >= options_.long_task_threshold)
+    OnTrigger(Trigger::kLongTask);
+}
+
+void FlightRecorder::StartSession() {
+  base::trace_event::TraceConfig trace_config(
+      base::JoinString(options_.categories, ","),
+      base::trace_event::RECORD_CONTINUOUSLY);
+  perfetto::TraceConfig config = tracing::GetDefaultPerfettoConfig(
+      trace_config, /*privacy_filtering_enabled=*/false,
+      /*convert_to_legacy_json=*/false,
+      perfetto::protos::gen::ChromeConfig::BACKGROUND);
+  for (auto& buffer : *config.mutable_buffers()) {
+    buffer.set_size_kb(options_.buffer_size);
+    buffer.set_fill_policy(perfetto::TraceConfig::BufferConfig::RING_BUFFER);
+  }
+
+  const uint64_t session_id = ++session_id_;
+  session_ = perfetto::Tracing::NewTrace();
+  session_->Setup(config);
+  // Unretained is safe as the recorder is never destroyed.
+  session_->SetOnStartCallback([this, session_id] {
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(&FlightRecorder::OnSessionStarted,
+                                  base::Unretained(this), session_id));
+  });
+  session_->Start();
+}
+
+void FlightRecorder::OnSessionStarted(uint64_t session_id) {
+  if (session_id == session_id_ && on_started_)
+    std::move(on_started_).Run();
+}
+
+void FlightRecorder::OnTriggerDumped(const Dump& dump,
+                                     absl::optional<std::string> error) {
+  if (error) {
+    LOG(ERROR) << "Failed to write " << dump.path << ": " << *error;
+    return;
+  }
+  dumps_.push_back(dump);
+  if (dumps_.size() > kMaxDumps)
+    dumps_.pop_front();
+}
+
+}  // namespace electron
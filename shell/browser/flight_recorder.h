@@ -0,0 +1,129 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
+#define ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_set.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace perfetto {
+class TracingSession;
+}
+
+namespace electron {
+
+// Traces a small set of categories all the time into a ring buffer, for
+// contentTracing.startFlightRecorder(), so that the last seconds before a
+// problem can be written out when it happens. The trace is written as the
+// Perfetto protobuf the tracing service records, without the conversion to
+// JSON which contentTracing.stopRecording() does. A session of Chromium's
+// own background priority is used, which a regular recording takes
+// precedence over. Only used on the UI thread.
+class FlightRecorder : public base::TaskObserver {
+ public:
+  enum class Trigger {
+    // A task of the UI thread of the main process ran longer than the
+    // threshold.
+    kLongTask,
+    // A renderer stopped responding.
+    kHang,
+    // A child process crashed or was killed.
+    kCrash,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    std::vector<std::string> categories;
+    // The size of the ring buffer in KB.
+    size_t buffer_size = 8 * 1024;
+    base::flat_set<Trigger> triggers;
+    base::TimeDelta long_task_threshold = base::Milliseconds(500);
+    // Where the dumps of the triggers are written.
+    base::FilePath directory;
+  };
+
+  struct Dump {
+    base::FilePath path;
+    Trigger trigger;
+    base::Time time;
+  };
+
+  // Called with the error message when the dump failed.
+  using DumpCallback =
+      base::OnceCallback<void(absl::optional<std::string> error)>;
+
+  // The categories traced when none are given, they only record a few events
+  // per task.
+  static std::vector<std::string> GetDefaultCategories();
+
+  static FlightRecorder* GetInstance();
+
+  FlightRecorder();
+  ~FlightRecorder() override;
+
+  // disable copy
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  // Starts recording, or restarts it with |options| and an empty buffer.
+  // |started| is called once the processes record, or when recording is
+  // stopped before.
+  void Start(const Options& options, base::OnceClosure started);
+  void Stop();
+  bool IsRecording() const { return !!session_; }
+
+  // Writes the content of the ring buffer to |path|. Recording goes on in a
+  // new buffer.
+  void DumpTo(const base::FilePath& path, DumpCallback callback);
+
+  // Dumps the buffer to the directory of the options when |trigger| is
+  // enabled. Dumps closer than a minimum interval are dropped, so a crash
+  // loop doesn't fill the disk.
+  void OnTrigger(Trigger trigger);
+
+  // The dumps written by the triggers, the most recent last.
+  const base::circular_deque<Dump>& dumps() const { return dumps_; }
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  void StartSession();
+  void OnSessionStarted(uint64_t session_id);
+  void OnTriggerDumped(const Dump& dump, absl::optional<std::string> error);
+
+  Options options_;
+  std::unique_ptr<perfetto::TracingSession> session_;
+  // Tells the start of the current session from the ones replaced since.
+  uint64_t session_id_ = 0;
+  base::OnceClosure on_started_;
+
+  // Tasks of nested run loops are part of the outermost one.
+  int depth_ = 0;
+  base::TimeTicks task_start_;
+
+  base::TimeTicks last_trigger_;
+  base::circular_deque<Dump> dumps_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
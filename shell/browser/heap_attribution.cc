@@ -0,0 +1,180 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/heap_attribution.h"
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/browser/api/electron_api_base_window.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "v8/include/v8-profiler.h"
+
+namespace electron::heap_attribution {
+
+namespace {
+
+struct Owner {
+  const char* type;
+  int32_t id;
+  v8::Local<v8::Object> wrapper;
+};
+
+std::vector<Owner> GetOwners(v8::Isolate* isolate) {
+  std::vector<Owner> owners;
+  for (api::WebContents* web_contents : api::WebContents::GetAll()) {
+    v8::Local<v8::Object> wrapper;
+    if (web_contents->GetWrapper(isolate).ToLocal(&wrapper))
+      owners.push_back({"WebContents", web_contents->ID(), wrapper});
+  }
+  for (v8::Local<v8::Object> wrapper : api::BaseWindow::GetAll(isolate)) {
+    api::BaseWindow* window;
+    if (gin::ConvertFromV8(isolate, wrapper, &window))
+      owners.push_back({"BaseWindow", window->weak_map_id(), wrapper});
+  }
+  return owners;
+}
+
+// Merged into the node of the wrapper by V8, which then carries its name.
+class OwnerNode : public v8::EmbedderGraph::Node {
+ public:
+  OwnerNode(std::string name, v8::EmbedderGraph::Node* wrapper_node)
+      : name_(std::move(name)), wrapper_node_(wrapper_node) {}
+
+  // v8::EmbedderGraph::Node
+  const char* Name() override { return name_.c_str(); }
+  size_t SizeInBytes() override { return 0; }
+  Node* WrapperNode() override { return wrapper_node_; }
+
+ private:
+  std::string name_;
+  v8::EmbedderGraph::Node* wrapper_node_;
+};
+
+void BuildEmbedderGraph(v8::Isolate* isolate,
+                        v8::EmbedderGraph* graph,
+                        void* data) {
+  v8::HandleScope scope(isolate);
+  for (const Owner& owner : GetOwners(isolate)) {
+    graph->AddNode(std::make_unique<OwnerNode>(
+        std::string("Electron / ") + owner.type + " " +
+            base::NumberToString(owner.id),
+        graph->V8Node(owner.wrapper)));
+  }
+}
+
+// The snapshot as an adjacency list of node indices, without weak edges
+// since they don't retain anything.
+struct Graph {
+  std::vector<size_t> sizes;
+  std::vector<uint32_t> edge_offsets;
+  std::vector<uint32_t> edges;
+};
+
+Graph BuildGraph(const v8::HeapSnapshot* snapshot,
+                 std::unordered_map<const v8::HeapGraphNode*, uint32_t>*
+                     node_indices) {
+  const int node_count = snapshot->GetNodesCount();
+  node_indices->reserve(node_count);
+  for (int i = 0; i < node_count; ++i)
+    node_indices->emplace(snapshot->GetNode(i), i);
+
+  Graph graph;
+  graph.sizes.reserve(node_count);
+  graph.edge_offsets.reserve(node_count + 1);
+  for (int i = 0; i < node_count; ++i) {
+    const v8::HeapGraphNode* node = snapshot->GetNode(i);
+    graph.sizes.push_back(node->GetShallowSize());
+    graph.edge_offsets.push_back(graph.edges.size());
+    for (int j = 0; j < node->GetChildrenCount(); ++j) {
+      const v8::HeapGraphEdge* edge = node->GetChild(j);
+      if (edge->GetType() == v8::HeapGraphEdge::kWeak)
+        continue;
+      graph.edges.push_back(node_indices->at(edge->GetToNode()));
+    }
+  }
+  graph.edge_offsets.push_back(graph.edges.size());
+  return graph;
+}
+
+constexpr uint32_t kNoMark = std::numeric_limits<uint32_t>::max();
+
+// Marks the nodes reachable from |start| with |mark| without going through
+// |excluded| or nodes marked with |skip_mark|. Returns the size of the nodes
+// that were marked.
+size_t Mark(const Graph& graph,
+            uint32_t start,
+            uint32_t excluded,
+            uint32_t mark,
+            std::vector<uint32_t>* marks,
+            uint32_t skip_mark) {
+  size_t size = 0;
+  std::vector<uint32_t> stack = {start};
+  (*marks)[start] = mark;
+  while (!stack.empty()) {
+    uint32_t node = stack.back();
+    stack.pop_back();
+    size += graph.sizes[node];
+    const uint32_t end = graph.edge_offsets[node + 1];
+    for (uint32_t i = graph.edge_offsets[node]; i < end; ++i) {
+      uint32_t child = graph.edges[i];
+      if (child == excluded || (*marks)[child] == mark ||
+          (*marks)[child] == skip_mark) {
+        continue;
+      }
+      (*marks)[child] = mark;
+      stack.push_back(child);
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
+void Install(v8::Isolate* isolate) {
+  isolate->GetHeapProfiler()->AddBuildEmbedderGraphCallback(
+      &BuildEmbedderGraph, nullptr);
+}
+
+std::vector<Entry> Measure(v8::Isolate* isolate) {
+  TRACE_EVENT0("electron", "heap_attribution::Measure");
+  v8::HandleScope scope(isolate);
+  v8::HeapProfiler* profiler = isolate->GetHeapProfiler();
+  const v8::HeapSnapshot* snapshot = profiler->TakeHeapSnapshot();
+  if (!snapshot)
+    return {};
+
+  std::unordered_map<const v8::HeapGraphNode*, uint32_t> node_indices;
+  const Graph graph = BuildGraph(snapshot, &node_indices);
+  const uint32_t root = node_indices.at(snapshot->GetRoot());
+
+  // Each owner needs two marks: what the rest of the heap keeps alive, then
+  // what is only reachable through the owner.
+  std::vector<uint32_t> marks(graph.sizes.size(), 0);
+  uint32_t next_mark = 1;
+  std::vector<Entry> entries;
+  for (const Owner& owner : GetOwners(isolate)) {
+    const v8::HeapGraphNode* node =
+        snapshot->GetNodeById(profiler->GetObjectId(owner.wrapper));
+    auto it = node_indices.find(node);
+    if (it == node_indices.end())
+      continue;
+    const uint32_t wrapper = it->second;
+    const uint32_t alive_mark = next_mark++;
+    const uint32_t owned_mark = next_mark++;
+    Mark(graph, root, wrapper, alive_mark, &marks, kNoMark);
+    entries.push_back({owner.type, owner.id,
+                       Mark(graph, wrapper, root, owned_mark, &marks,
+                            alive_mark)});
+  }
+
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+  return entries;
+}
+
+}  // namespace electron::heap_attribution
@@ -0,0 +1,41 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_HEAP_ATTRIBUTION_H_
+#define ELECTRON_SHELL_BROWSER_HEAP_ATTRIBUTION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace v8 {
+class Isolate;
+}
+
+// Attributes the JavaScript heap of the browser process, which is shared by
+// the whole app, to the WebContents and BaseWindow objects that own parts of
+// it: their event listeners, the closures those capture, and anything else
+// only reachable through them.
+namespace electron::heap_attribution {
+
+struct Entry {
+  // "WebContents" or "BaseWindow".
+  std::string type;
+  int32_t id;
+  // The bytes that would be freed if the JavaScript object went away.
+  size_t retained_size;
+};
+
+// Names the wrapper objects after their owner in heap snapshots, e.g.
+// "Electron / WebContents 1", so that their retained size can be found in
+// the output of process.takeHeapSnapshot() and DevTools.
+void Install(v8::Isolate* isolate);
+
+// Takes a heap snapshot to compute the retained size of each owner, which
+// blocks the thread for about as long as writing a snapshot would.
+std::vector<Entry> Measure(v8::Isolate* isolate);
+
+}  // namespace electron::heap_attribution
+
+#endif  // ELECTRON_SHELL_BROWSER_HEAP_ATTRIBUTION_H_
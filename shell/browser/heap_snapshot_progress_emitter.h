@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_PROGRESS_EMITTER_H_
+#define ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_PROGRESS_EMITTER_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "base/functional/callback.h"
+#include "base/values.h"
+
+namespace electron {
+
+// Turns the progress reported by the process taking a heap snapshot into
+// the details of 'heap-snapshot-progress' events. |Interface| is the
+// HeapSnapshotProgress mojo interface of either renderers or utility
+// processes, which have the same methods.
+template <typename Interface>
+class HeapSnapshotProgressEmitter : public Interface {
+ public:
+  using EmitCallback = base::RepeatingCallback<void(base::Value::Dict)>;
+
+  explicit HeapSnapshotProgressEmitter(EmitCallback emit)
+      : emit_(std::move(emit)) {}
+  ~HeapSnapshotProgressEmitter() override = default;
+
+  // disable copy
+  HeapSnapshotProgressEmitter(const HeapSnapshotProgressEmitter&) = delete;
+  HeapSnapshotProgressEmitter& operator=(const HeapSnapshotProgressEmitter&) =
+      delete;
+
+  // Interface
+  void OnCapture(uint32_t done, uint32_t total) override {
+    base::Value::Dict details;
+    details.Set("phase", "capture");
+    details.Set("done", static_cast<double>(done));
+    details.Set("total", static_cast<double>(total));
+    emit_.Run(std::move(details));
+  }
+
+  void OnWrite(uint64_t bytes_written) override {
+    base::Value::Dict details;
+    details.Set("phase", "write");
+    details.Set("bytesWritten", static_cast<double>(bytes_written));
+    emit_.Run(std::move(details));
+  }
+
+ private:
+  EmitCallback emit_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_PROGRESS_EMITTER_H_
@@ -317,6 +317,8 @@ void HidChooserContext::OnHidManagerConnectionError() {
   hid_manager_.reset();
   client_receiver_.reset();
   devices_.clear();
+  // The devices are enumerated again on the next query.
+  is_initialized_ = false;
 
   std::vector<url::Origin> revoked_origins;
   revoked_origins.reserve(ephemeral_devices_.size());
@@ -96,7 +96,9 @@ HidChooserController::HidChooserController(
                          ->AsWeakPtr();
   DCHECK(chooser_context_);
 
-  chooser_context_->GetHidManager()->GetDevices(base::BindOnce(
+  // The context keeps the devices up to date from the notifications of the
+  // device service, only the first chooser waits for the enumeration.
+  chooser_context_->GetDevices(base::BindOnce(
       &HidChooserController::OnGotDevices, weak_factory_.GetWeakPtr()));
 }
 
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/idle_gc_scheduler.h"
+
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+#include "v8/include/v8-isolate.h"
+#include "v8/include/v8-platform.h"
+
+namespace electron {
+
+namespace {
+
+// How long the thread has to go without running a task to be idle.
+constexpr base::TimeDelta kIdleDelay = base::Milliseconds(100);
+
+// The time given to V8 by each idle notification, and the pause between
+// notifications while the thread stays idle.
+constexpr base::TimeDelta kIdleTime = base::Milliseconds(10);
+constexpr base::TimeDelta kIdleRoundInterval = base::Milliseconds(50);
+
+// V8 normally finishes well within this many notifications, it's only a limit
+// so that a heap that always has work left doesn't keep waking up the thread.
+constexpr int kMaxIdleRounds = 10;
+
+const char* GCTypeName(v8::GCType type) {
+  switch (type) {
+    case v8::kGCTypeScavenge:
+      return "scavenge";
+    case v8::kGCTypeMinorMarkCompact:
+      return "minor-mark-compact";
+    case v8::kGCTypeMarkSweepCompact:
+      return "mark-sweep-compact";
+    case v8::kGCTypeIncrementalMarking:
+      return "incremental-marking";
+    case v8::kGCTypeProcessWeakCallbacks:
+      return "process-weak-callbacks";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+IdleGCScheduler::IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform)
+    : isolate_(isolate), platform_(platform) {
+  isolate_->AddGCPrologueCallback(&IdleGCScheduler::OnGCPrologue, this);
+  isolate_->AddGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue, this);
+}
+
+IdleGCScheduler::~IdleGCScheduler() {
+  isolate_->RemoveGCPrologueCallback(&IdleGCScheduler::OnGCPrologue, this);
+  isolate_->RemoveGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue, this);
+}
+
+void IdleGCScheduler::DidProcessTask(const base::PendingTask& pending_task) {
+  if (std::exchange(in_idle_task_, false))
+    return;
+
+  last_task_end_ = base::TimeTicks::Now();
+  idle_rounds_ = 0;
+  if (!idle_timer_.IsRunning()) {
+    idle_timer_.Start(FROM_HERE, kIdleDelay, this,
+                      &IdleGCScheduler::OnIdleTimer);
+  }
+}
+
+void IdleGCScheduler::OnIdleTimer() {
+  in_idle_task_ = true;
+
+  // Tasks ran since the timer was started, wait for them to stop.
+  const base::TimeDelta idle_for = base::TimeTicks::Now() - last_task_end_;
+  if (idle_for < kIdleDelay) {
+    idle_timer_.Start(FROM_HERE, kIdleDelay - idle_for, this,
+                      &IdleGCScheduler::OnIdleTimer);
+    return;
+  }
+
+  bool done;
+  {
+    TRACE_EVENT1("electron", "IdleGCScheduler::IdleNotification", "round",
+                 idle_rounds_);
+    v8::Isolate::Scope isolate_scope(isolate_);
+    in_idle_notification_ = true;
+    done = isolate_->IdleNotificationDeadline(
+        platform_->MonotonicallyIncreasingTime() + kIdleTime.InSecondsF());
+    in_idle_notification_ = false;
+  }
+
+  if (!done && ++idle_rounds_ < kMaxIdleRounds) {
+    idle_timer_.Start(FROM_HERE, kIdleRoundInterval, this,
+                      &IdleGCScheduler::OnIdleTimer);
+  }
+}
+
+// static
+void IdleGCScheduler::OnGCPrologue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags,
+                                   void* data) {
+  auto* self = static_cast<IdleGCScheduler*>(data);
+  TRACE_EVENT_BEGIN2("electron", "V8.GC", "type", GCTypeName(type), "idle",
+                     self->in_idle_notification_);
+}
+
+// static
+void IdleGCScheduler::OnGCEpilogue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags,
+                                   void* data) {
+  TRACE_EVENT_END0("electron", "V8.GC");
+}
+
+}  // namespace electron
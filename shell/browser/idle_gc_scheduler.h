@@ -0,0 +1,69 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
+#define ELECTRON_SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
+
+#include "base/memory/raw_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "v8/include/v8-callbacks.h"
+
+namespace v8 {
+class Isolate;
+class Platform;
+}  // namespace v8
+
+namespace electron {
+
+// Gives the spare time of the UI thread of the browser process to V8, so that
+// incremental marking and heap finalization happen while the app is idle
+// rather than in the tasks that handle input or drive animations. Chromium has
+// no idle periods on this thread, so it is considered to be idle once it has
+// not run any task for a while, which is never the case while windows are
+// animating or input is being handled.
+class IdleGCScheduler : public base::TaskObserver {
+ public:
+  IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform);
+  ~IdleGCScheduler() override;
+
+  // disable copy
+  IdleGCScheduler(const IdleGCScheduler&) = delete;
+  IdleGCScheduler& operator=(const IdleGCScheduler&) = delete;
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override {}
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  static void OnGCPrologue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+  static void OnGCEpilogue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+
+  void OnIdleTimer();
+
+  raw_ptr<v8::Isolate> isolate_;
+  raw_ptr<v8::Platform> platform_;
+
+  base::OneShotTimer idle_timer_;
+  base::TimeTicks last_task_end_;
+  // Set while running the task of |idle_timer_|, which is not activity.
+  bool in_idle_task_ = false;
+  // Set while V8 is handling an idle notification, for the GC trace events.
+  bool in_idle_notification_ = false;
+  // Idle notifications sent since the thread last ran a task, V8 may need a
+  // few to finish its work.
+  int idle_rounds_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ipc_channel_metrics.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/functional/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
+#include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
+
+namespace electron {
+
+namespace {
+
+uint64_t ToMicroseconds(base::TimeDelta delta) {
+  // Clocks of different processes may disagree slightly.
+  return std::max<int64_t>(0, delta.InMicroseconds());
+}
+
+}  // namespace
+
+void IPCChannelMetrics::Histogram::Add(uint64_t sample) {
+  min = count ? std::min(min, sample) : sample;
+  max = count ? std::max(max, sample) : sample;
+  ++count;
+  sum += sample;
+  size_t bucket = sample ? 63 - base::bits::CountLeadingZeroBits(sample) : 0;
+  ++buckets[std::min(bucket, kBucketCount - 1)];
+}
+
+IPCChannelMetrics::IPCChannelMetrics() = default;
+
+IPCChannelMetrics::~IPCChannelMetrics() = default;
+
+// static
+size_t IPCChannelMetrics::GetMessageSize(
+    const blink::CloneableMessage& message) {
+  return message.encoded_message.size();
+}
+
+// static
+size_t IPCChannelMetrics::GetMessageSize(
+    const blink::TransferableMessage& message) {
+  size_t size = message.encoded_message.size();
+  for (const auto& contents : message.array_buffer_contents_array)
+    size += contents->contents.size();
+  return size;
+}
+
+void IPCChannelMetrics::RecordMessage(bool internal,
+                                      const std::string& channel,
+                                      size_t size,
+                                      const mojom::IPCMessageTiming& timing) {
+  const uint64_t serialization_time = ToMicroseconds(timing.serialization_time);
+  const uint64_t queueing_delay =
+      ToMicroseconds(base::TimeTicks::Now() - timing.sent);
+  TRACE_EVENT_INSTANT("electron", "IPCChannelMetrics::RecordMessage",
+                      "channel", channel, "internal", internal, "bytes", size,
+                      "serialization_us", serialization_time,
+                      "queueing_delay_us", queueing_delay);
+  if (internal)
+    return;
+  Channel* stats = GetChannel(channel);
+  stats->size.Add(size);
+  stats->serialization_time.Add(serialization_time);
+  stats->queueing_delay.Add(queueing_delay);
+}
+
+void IPCChannelMetrics::RecordHandlerDuration(bool internal,
+                                              const std::string& channel,
+                                              base::TimeDelta duration) {
+  TRACE_EVENT_INSTANT("electron", "IPCChannelMetrics::RecordHandlerDuration",
+                      "channel", channel, "internal", internal, "duration_us",
+                      ToMicroseconds(duration));
+  if (internal)
+    return;
+  GetChannel(channel)->handler_duration.Add(ToMicroseconds(duration));
+}
+
+mojom::ElectronApiIPC::InvokeCallback IPCChannelMetrics::WrapReplyCallback(
+    bool internal,
+    const std::string& channel,
+    mojom::ElectronApiIPC::InvokeCallback callback) {
+  return base::BindOnce(
+      [](base::WeakPtr<IPCChannelMetrics> metrics, bool internal,
+         const std::string& channel, base::TimeTicks start,
+         mojom::ElectronApiIPC::InvokeCallback callback,
+         blink::TransferableMessage result) {
+        if (metrics) {
+          metrics->RecordHandlerDuration(internal, channel,
+                                         base::TimeTicks::Now() - start);
+        }
+        std::move(callback).Run(std::move(result));
+      },
+      GetWeakPtr(), internal, channel, base::TimeTicks::Now(),
+      std::move(callback));
+}
+
+void IPCChannelMetrics::Clear() {
+  channels_.clear();
+}
+
+IPCChannelMetrics::Channel* IPCChannelMetrics::GetChannel(
+    const std::string& channel) {
+  auto it = channels_.find(channel);
+  if (it != channels_.end())
+    return &it->second;
+  if (channels_.size() >= kMaxChannels)
+    return &channels_[kOverflowChannel];
+  return &channels_[channel];
+}
+
+}  // namespace electron
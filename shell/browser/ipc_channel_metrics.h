@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_IPC_CHANNEL_METRICS_H_
+#define ELECTRON_SHELL_BROWSER_IPC_CHANNEL_METRICS_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "electron/shell/common/api/api.mojom.h"
+
+namespace blink {
+struct CloneableMessage;
+struct TransferableMessage;
+}  // namespace blink
+
+namespace electron {
+
+// Per-channel statistics about the IPC messages a WebContents receives from
+// its renderers, see webContents.getIPCMetrics(). Electron's internal
+// messages are traced but not counted.
+class IPCChannelMetrics {
+ public:
+  // Samples bucketed on a log2 scale: buckets[i] counts the samples in
+  // [2^i, 2^(i+1)), buckets[0] also counts zeroes.
+  struct Histogram {
+    static constexpr size_t kBucketCount = 40;
+
+    void Add(uint64_t sample);
+
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::array<uint64_t, kBucketCount> buckets = {};
+  };
+
+  struct Channel {
+    // In bytes.
+    Histogram size;
+    // In microseconds.
+    Histogram serialization_time;
+    Histogram queueing_delay;
+    Histogram handler_duration;
+  };
+
+  // Channels beyond this many are all counted under kOverflowChannel, so that
+  // apps generating channel names can't grow this without bounds.
+  static constexpr size_t kMaxChannels = 1000;
+  static constexpr char kOverflowChannel[] = "<other>";
+
+  IPCChannelMetrics();
+  ~IPCChannelMetrics();
+
+  // disable copy
+  IPCChannelMetrics(const IPCChannelMetrics&) = delete;
+  IPCChannelMetrics& operator=(const IPCChannelMetrics&) = delete;
+
+  static size_t GetMessageSize(const blink::CloneableMessage& message);
+  static size_t GetMessageSize(const blink::TransferableMessage& message);
+
+  // Called when a message of |size| bytes arrives on |channel|, just before
+  // its handler runs.
+  void RecordMessage(bool internal,
+                     const std::string& channel,
+                     size_t size,
+                     const mojom::IPCMessageTiming& timing);
+  void RecordHandlerDuration(bool internal,
+                             const std::string& channel,
+                             base::TimeDelta duration);
+
+  // Wraps the reply callback of an invoke() or sendSync() so that the time
+  // until the reply is sent is recorded as the handler duration.
+  mojom::ElectronApiIPC::InvokeCallback WrapReplyCallback(
+      bool internal,
+      const std::string& channel,
+      mojom::ElectronApiIPC::InvokeCallback callback);
+
+  void Clear();
+
+  const std::map<std::string, Channel>& channels() const { return channels_; }
+
+  base::WeakPtr<IPCChannelMetrics> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  Channel* GetChannel(const std::string& channel);
+
+  std::map<std::string, Channel> channels_;
+
+  base::WeakPtrFactory<IPCChannelMetrics> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_IPC_CHANNEL_METRICS_H_
@@ -0,0 +1,130 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ipc_priority_lanes.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+namespace {
+
+std::map<std::string, IPCPriority>& GetChannelPriorities() {
+  static base::NoDestructor<std::map<std::string, IPCPriority>> priorities;
+  return *priorities;
+}
+
+base::TaskPriority ToTaskPriority(IPCPriority priority) {
+  switch (priority) {
+    case IPCPriority::kUserBlocking:
+      return base::TaskPriority::USER_BLOCKING;
+    case IPCPriority::kDefault:
+      return base::TaskPriority::USER_VISIBLE;
+    case IPCPriority::kBackground:
+      return base::TaskPriority::BEST_EFFORT;
+  }
+}
+
+}  // namespace
+
+// static
+void IPCPriorityLanes::SetChannelPriority(const std::string& channel,
+                                          IPCPriority priority) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (priority == IPCPriority::kDefault)
+    GetChannelPriorities().erase(channel);
+  else
+    GetChannelPriorities()[channel] = priority;
+}
+
+// static
+IPCPriority IPCPriorityLanes::GetChannelPriority(const std::string& channel) {
+  const auto& priorities = GetChannelPriorities();
+  auto it = priorities.find(channel);
+  return it == priorities.end() ? IPCPriority::kDefault : it->second;
+}
+
+IPCPriorityLanes::IPCPriorityLanes() = default;
+
+IPCPriorityLanes::~IPCPriorityLanes() = default;
+
+void IPCPriorityLanes::Run(bool internal,
+                           const std::string& channel,
+                           base::OnceClosure task) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const IPCPriority priority =
+      internal ? IPCPriority::kDefault : GetChannelPriority(channel);
+  if (priority == IPCPriority::kDefault) {
+    std::move(task).Run();
+    return;
+  }
+  GetLane(priority).tasks.push_back({std::move(task), base::TimeTicks::Now()});
+  Schedule(priority);
+  if (priority == IPCPriority::kBackground)
+    StartStarvationTimer();
+}
+
+IPCPriorityLanes::Lane& IPCPriorityLanes::GetLane(IPCPriority priority) {
+  DCHECK_NE(priority, IPCPriority::kDefault);
+  return priority == IPCPriority::kUserBlocking ? user_blocking_ : background_;
+}
+
+void IPCPriorityLanes::Schedule(IPCPriority priority) {
+  Lane& lane = GetLane(priority);
+  if (lane.scheduled || lane.tasks.empty())
+    return;
+  lane.scheduled = true;
+  content::GetUIThreadTaskRunner({ToTaskPriority(priority)})
+      ->PostTask(FROM_HERE, base::BindOnce(&IPCPriorityLanes::RunNext,
+                                           weak_factory_.GetWeakPtr(),
+                                           priority));
+}
+
+void IPCPriorityLanes::RunNext(IPCPriority priority) {
+  Lane& lane = GetLane(priority);
+  lane.scheduled = false;
+  if (lane.tasks.empty())
+    return;
+  base::OnceClosure task = std::move(lane.tasks.front().task);
+  lane.tasks.pop_front();
+  // Posted before running the task, which may destroy |this|.
+  Schedule(priority);
+  std::move(task).Run();
+}
+
+void IPCPriorityLanes::RunStarvedBackgroundTasks() {
+  TRACE_EVENT1("electron", "IPCPriorityLanes::RunStarvedBackgroundTasks",
+               "queued", background_.tasks.size());
+  base::WeakPtr<IPCPriorityLanes> weak_this = weak_factory_.GetWeakPtr();
+  const base::TimeTicks deadline = base::TimeTicks::Now() - kMaxBackgroundDelay;
+  while (weak_this && !background_.tasks.empty() &&
+         background_.tasks.front().queued <= deadline) {
+    base::OnceClosure task = std::move(background_.tasks.front().task);
+    background_.tasks.pop_front();
+    std::move(task).Run();
+  }
+  if (weak_this)
+    StartStarvationTimer();
+}
+
+void IPCPriorityLanes::StartStarvationTimer() {
+  if (starvation_timer_.IsRunning() || background_.tasks.empty())
+    return;
+  const base::TimeDelta waited =
+      base::TimeTicks::Now() - background_.tasks.front().queued;
+  starvation_timer_.Start(
+      FROM_HERE, std::max(base::TimeDelta(), kMaxBackgroundDelay - waited),
+      base::BindOnce(&IPCPriorityLanes::RunStarvedBackgroundTasks,
+                     base::Unretained(this)));
+}
+
+}  // namespace electron
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_IPC_PRIORITY_LANES_H_
+#define ELECTRON_SHELL_BROWSER_IPC_PRIORITY_LANES_H_
+
+#include <string>
+
+#include "base/containers/circular_deque.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+// The priority set with ipcMain.setChannelPriority().
+enum class IPCPriority {
+  kUserBlocking,
+  kDefault,
+  kBackground,
+};
+
+// Runs the handlers of one frame's asynchronous IPC messages in lanes of
+// different priority. Messages on "default" channels are handled as soon as
+// they arrive, like they always were. The other lanes are queues drained one
+// message per task from the UI thread task queue of matching priority, so a
+// burst of background messages can't delay the rest. A background message
+// that waited for more than kMaxBackgroundDelay is run at default priority
+// instead, so that busy apps don't starve that lane.
+//
+// Messages on the same lane are handled in the order they arrived, there is
+// no ordering between lanes. Only used on the UI thread.
+class IPCPriorityLanes {
+ public:
+  static constexpr base::TimeDelta kMaxBackgroundDelay =
+      base::Milliseconds(100);
+
+  static void SetChannelPriority(const std::string& channel,
+                                 IPCPriority priority);
+  static IPCPriority GetChannelPriority(const std::string& channel);
+
+  IPCPriorityLanes();
+  ~IPCPriorityLanes();
+
+  // disable copy
+  IPCPriorityLanes(const IPCPriorityLanes&) = delete;
+  IPCPriorityLanes& operator=(const IPCPriorityLanes&) = delete;
+
+  // Runs |task| now or queues it on the lane of |channel|. Internal channels
+  // are always handled now. Tasks that didn't run yet are dropped when this
+  // is destroyed.
+  void Run(bool internal, const std::string& channel, base::OnceClosure task);
+
+ private:
+  struct PendingTask {
+    base::OnceClosure task;
+    base::TimeTicks queued;
+  };
+
+  struct Lane {
+    base::circular_deque<PendingTask> tasks;
+    bool scheduled = false;
+  };
+
+  Lane& GetLane(IPCPriority priority);
+  void Schedule(IPCPriority priority);
+  void RunNext(IPCPriority priority);
+  void RunStarvedBackgroundTasks();
+  void StartStarvationTimer();
+
+  Lane user_blocking_;
+  Lane background_;
+  base::OneShotTimer starvation_timer_;
+
+  base::WeakPtrFactory<IPCPriorityLanes> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_IPC_PRIORITY_LANES_H_
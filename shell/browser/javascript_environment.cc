@@ -20,6 +20,7 @@
 #include "base/trace_event/trace_event.h"
 #include "gin/array_buffer.h"
 #include "gin/v8_initializer.h"
+#include "shell/browser/idle_gc_scheduler.h"
 #include "shell/browser/microtasks_runner.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/node_includes.h"
@@ -103,8 +104,9 @@ gin::IsolateHolder CreateIsolateHolder(v8::Isolate* isolate) {
 }  // namespace
 
 JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop,
-                                             bool setup_wasm_streaming)
-    : isolate_(Initialize(event_loop, setup_wasm_streaming)),
+                                             bool setup_wasm_streaming,
+                                             int platform_threads)
+    : isolate_(Initialize(event_loop, setup_wasm_streaming, platform_threads)),
       isolate_holder_(CreateIsolateHolder(isolate_)),
       locker_(isolate_) {
   isolate_->Enter();
@@ -273,7 +275,8 @@ class TracingControllerImpl : public node::tracing::TracingController {
 };
 
 v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop,
-                                               bool setup_wasm_streaming) {
+                                               bool setup_wasm_streaming,
+                                               int platform_threads) {
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
   // --js-flags.
@@ -288,9 +291,13 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop,
   auto* tracing_agent = node::CreateAgent();
   auto* tracing_controller = new TracingControllerImpl();
   node::tracing::TraceEventHelper::SetAgent(tracing_agent);
+  // The workers are all started, and waited for, before this returns.
+  if (platform_threads <= 0)
+    platform_threads =
+        base::RecommendedMaxNumberOfThreadsInThreadGroup(3, 8, 0.1, 0);
   platform_ = node::MultiIsolatePlatform::Create(
-      base::RecommendedMaxNumberOfThreadsInThreadGroup(3, 8, 0.1, 0),
-      tracing_controller, gin::V8Platform::GetCurrentPageAllocator());
+      platform_threads, tracing_controller,
+      gin::V8Platform::GetCurrentPageAllocator());
 
   v8::V8::InitializePlatform(platform_.get());
   gin::IsolateHolder::Initialize(gin::IsolateHolder::kNonStrictMode,
@@ -339,6 +346,18 @@ void JavascriptEnvironment::DestroyMicrotasksRunner() {
   base::CurrentThread::Get()->RemoveTaskObserver(microtasks_runner_.get());
 }
 
+void JavascriptEnvironment::CreateIdleGCScheduler() {
+  DCHECK(!idle_gc_scheduler_);
+  idle_gc_scheduler_ = std::make_unique<IdleGCScheduler>(isolate(), platform());
+  base::CurrentThread::Get()->AddTaskObserver(idle_gc_scheduler_.get());
+}
+
+void JavascriptEnvironment::DestroyIdleGCScheduler() {
+  DCHECK(idle_gc_scheduler_);
+  base::CurrentThread::Get()->RemoveTaskObserver(idle_gc_scheduler_.get());
+  idle_gc_scheduler_.reset();
+}
+
 NodeEnvironment::NodeEnvironment(node::Environment* env) : env_(env) {}
 
 NodeEnvironment::~NodeEnvironment() {
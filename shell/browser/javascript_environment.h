@@ -19,12 +19,16 @@ class MultiIsolatePlatform;
 
 namespace electron {
 
+class IdleGCScheduler;
 class MicrotasksRunner;
 // Manage the V8 isolate and context automatically.
 class JavascriptEnvironment {
  public:
+  // |platform_threads| is the number of worker threads of the V8 platform,
+  // 0 picks it from the number of cores.
   JavascriptEnvironment(uv_loop_t* event_loop,
-                        bool setup_wasm_streaming = false);
+                        bool setup_wasm_streaming = false,
+                        int platform_threads = 0);
   ~JavascriptEnvironment();
 
   // disable copy
@@ -34,13 +38,19 @@ class JavascriptEnvironment {
   void CreateMicrotasksRunner();
   void DestroyMicrotasksRunner();
 
+  // Only for the browser process, see IdleGCScheduler.
+  void CreateIdleGCScheduler();
+  void DestroyIdleGCScheduler();
+
   node::MultiIsolatePlatform* platform() const { return platform_.get(); }
   v8::Isolate* isolate() const { return isolate_; }
 
   static v8::Isolate* GetIsolate();
 
  private:
-  v8::Isolate* Initialize(uv_loop_t* event_loop, bool setup_wasm_streaming);
+  v8::Isolate* Initialize(uv_loop_t* event_loop,
+                          bool setup_wasm_streaming,
+                          int platform_threads);
   std::unique_ptr<node::MultiIsolatePlatform> platform_;
 
   raw_ptr<v8::Isolate> isolate_;
@@ -48,6 +58,7 @@ class JavascriptEnvironment {
   v8::Locker locker_;
 
   std::unique_ptr<MicrotasksRunner> microtasks_runner_;
+  std::unique_ptr<IdleGCScheduler> idle_gc_scheduler_;
 };
 
 // Manage the Node Environment automatically.
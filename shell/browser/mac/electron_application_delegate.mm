@@ -100,6 +100,14 @@ static NSDictionary* UNNotificationResponseToNSDictionary(
   electron::Browser::Get()->DidResignActive();
 }
 
+- (void)applicationDidHide:(NSNotification*)notification {
+  electron::Browser::Get()->DidHide();
+}
+
+- (void)applicationDidUnhide:(NSNotification*)notification {
+  electron::Browser::Get()->DidUnhide();
+}
+
 - (NSMenu*)applicationDockMenu:(NSApplication*)sender {
   return menu_controller_ ? menu_controller_.menu : nil;
 }
@@ -68,13 +68,12 @@ void NativeBrowserViewViews::AutoResize(const gfx::Rect& new_window,
   if (!(flags & kAutoResizeHeight)) {
     height_delta = 0;
   }
-  if (height_delta || width_delta) {
-    auto new_view_size = view->size();
-    new_view_size.set_width(new_view_size.width() + width_delta);
-    new_view_size.set_height(new_view_size.height() + height_delta);
-    view->SetSize(new_view_size);
-  }
+  // The new bounds are computed before being applied, so that the view is
+  // laid out once per resize rather than for its size and then again for its
+  // proportions.
   auto new_view_bounds = view->bounds();
+  new_view_bounds.set_width(new_view_bounds.width() + width_delta);
+  new_view_bounds.set_height(new_view_bounds.height() + height_delta);
   if (flags & kAutoResizeHorizontal) {
     new_view_bounds.set_width(new_window.width() /
                               auto_horizontal_proportion_width_);
@@ -86,9 +85,7 @@ void NativeBrowserViewViews::AutoResize(const gfx::Rect& new_window,
                                auto_vertical_proportion_height_);
     new_view_bounds.set_y(new_window.height() / auto_vertical_proportion_top_);
   }
-  if ((flags & kAutoResizeHorizontal) || (flags & kAutoResizeVertical)) {
-    view->SetBoundsRect(new_view_bounds);
-  }
+  view->SetBoundsRect(new_view_bounds);
 }
 
 void NativeBrowserViewViews::ResetAutoResizeProportions() {
@@ -105,8 +102,12 @@ void NativeBrowserViewViews::SetBounds(const gfx::Rect& bounds) {
   if (!iwc_view)
     return;
   auto* view = iwc_view->GetView();
-  view->SetBoundsRect(bounds);
   ResetAutoResizeProportions();
+  // Apps tend to set the bounds of all of their views on every resize of the
+  // window, most of which didn't change.
+  if (view->bounds() == bounds)
+    return;
+  view->SetBoundsRect(bounds);
 
   view->InvalidateLayout();
   view->SchedulePaint();
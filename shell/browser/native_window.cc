@@ -583,6 +583,26 @@ void NativeWindow::NotifyWindowHide() {
     observer.OnWindowHide();
 }
 
+void NativeWindow::NotifyWindowOcclusionChanged(bool occluded) {
+  if (occluded == occluded_)
+    return;
+  occluded_ = occluded;
+  if (occluded) {
+    occlusion_count_++;
+    occluded_since_ = base::TimeTicks::Now();
+  } else {
+    occluded_time_ += base::TimeTicks::Now() - occluded_since_;
+  }
+  for (NativeWindowObserver& observer : observers_)
+    observer.OnWindowOcclusionChanged(occluded);
+}
+
+base::TimeDelta NativeWindow::GetOccludedTime() const {
+  if (!occluded_)
+    return occluded_time_;
+  return occluded_time_ + (base::TimeTicks::Now() - occluded_since_);
+}
+
 void NativeWindow::NotifyWindowMaximize() {
   for (NativeWindowObserver& observer : observers_)
     observer.OnWindowMaximize();
@@ -15,6 +15,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "content/public/browser/desktop_media_id.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "extensions/browser/app_window/size_constraints.h"
@@ -297,6 +298,7 @@ class NativeWindow : public base::SupportsUserData,
   void NotifyWindowShow();
   void NotifyWindowIsKeyChanged(bool is_key);
   void NotifyWindowHide();
+  void NotifyWindowOcclusionChanged(bool occluded);
   void NotifyWindowMaximize();
   void NotifyWindowUnmaximize();
   void NotifyWindowMinimize();
@@ -381,6 +383,13 @@ class NativeWindow : public base::SupportsUserData,
   NativeWindow* parent() const { return parent_; }
   bool is_modal() const { return is_modal_; }
 
+  // Whether the shown window is fully covered by other windows, or
+  // off-screen, as far as the platform can tell.
+  bool is_occluded() const { return occluded_; }
+  // How many times the window got occluded, and for how long in total.
+  int occlusion_count() const { return occlusion_count_; }
+  base::TimeDelta GetOccludedTime() const;
+
   std::list<NativeBrowserView*> browser_views() const { return browser_views_; }
 
   int32_t window_id() const { return next_id_; }
@@ -479,6 +488,12 @@ class NativeWindow : public base::SupportsUserData,
   // Is this a modal window.
   bool is_modal_ = false;
 
+  bool occluded_ = false;
+  int occlusion_count_ = 0;
+  // The time spent occluded, not counting the current occlusion.
+  base::TimeDelta occluded_time_;
+  base::TimeTicks occluded_since_;
+
   // The browser view layer.
   std::list<NativeBrowserView*> browser_views_;
 
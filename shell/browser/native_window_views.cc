@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "base/containers/contains.h"
+#include "base/functional/bind.h"
 #include "base/memory/raw_ptr.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -33,6 +34,8 @@
 #include "shell/common/options_switches.h"
 #include "ui/aura/window_tree_host.h"
 #include "ui/base/hit_test.h"
+#include "ui/display/display.h"
+#include "ui/display/screen.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/views/background.h"
@@ -74,8 +77,8 @@
 #include "shell/browser/ui/views/win_frame_view.h"
 #include "shell/browser/ui/win/electron_desktop_native_widget_aura.h"
 #include "skia/ext/skia_utils_win.h"
+#include "ui/aura/native_window_occlusion_tracker.h"
 #include "ui/base/win/shell.h"
-#include "ui/display/screen.h"
 #include "ui/display/win/screen_win.h"
 #include "ui/gfx/color_utils.h"
 #include "ui/gfx/win/msg_util.h"
@@ -114,6 +117,9 @@ gfx::Rect ScreenToDIPRect(HWND hwnd, const gfx::Rect& pixel_bounds) {
 
 namespace {
 
+// Used for the live resize when the refresh rate of the display is unknown.
+constexpr float kDefaultLiveResizeFrequency = 60.f;
+
 #if BUILDFLAG(IS_WIN)
 const LPCWSTR kUniqueTaskBarClassName = L"Shell_TrayWnd";
 
@@ -208,6 +214,7 @@ NativeWindowViews::NativeWindowViews(const gin_helper::Dictionary& options,
                                      NativeWindow* parent)
     : NativeWindow(options, parent) {
   options.Get(options::kTitle, &title_);
+  options.Get(options::kThrottleLiveResize, &throttle_live_resize_);
 
   bool menu_bar_autohide;
   if (options.Get(options::kAutoHideMenuBar, &menu_bar_autohide))
@@ -424,6 +431,17 @@ NativeWindowViews::NativeWindowViews(const gin_helper::Dictionary& options,
   if (window)
     window->AddPreTargetHandler(this);
 
+  // Listen to the occlusion state, which only the native window occlusion
+  // tracker of Windows computes for now.
+  if (aura::WindowTreeHost* host = window ? window->GetHost() : nullptr) {
+    host_observation_.Observe(host);
+#if BUILDFLAG(IS_WIN)
+    if (!host->IsNativeWindowOcclusionEnabled())
+      aura::NativeWindowOcclusionTracker::EnableNativeWindowOcclusionTracking(
+          host);
+#endif
+  }
+
 #if BUILDFLAG(IS_LINUX)
   // On linux after the widget is initialized we might have to force set the
   // bounds if the bounds are smaller than the current display
@@ -1643,7 +1661,22 @@ void NativeWindowViews::OnWidgetBoundsChanged(views::Widget* changed_widget,
   }
 }
 
+void NativeWindowViews::EndLiveResize() {
+  if (!live_resize_timer_.IsRunning())
+    return;
+  live_resize_timer_.Stop();
+  root_view_.UnlockContentSize();
+}
+
+void NativeWindowViews::UpdateLiveResize() {
+  // Resize the renderers to the current size, their new frames are then
+  // scaled until the next update.
+  root_view_.UnlockContentSize();
+  root_view_.LockContentSize();
+}
+
 void NativeWindowViews::OnWidgetDestroying(views::Widget* widget) {
+  host_observation_.Reset();
   aura::Window* window = GetNativeWindow();
   if (window)
     window->RemovePreTargetHandler(this);
@@ -1653,6 +1686,38 @@ void NativeWindowViews::OnWidgetDestroyed(views::Widget* changed_widget) {
   widget_destroyed_ = true;
 }
 
+void NativeWindowViews::OnOcclusionStateChanged(
+    aura::WindowTreeHost* host,
+    aura::Window::OcclusionState new_state,
+    const SkRegion& occluded_region) {
+  // Hidden and minimized windows are not occluded, they are reported through
+  // 'hide' and 'minimize'.
+  NotifyWindowOcclusionChanged(new_state ==
+                               aura::Window::OcclusionState::OCCLUDED);
+}
+
+void NativeWindowViews::OnWindowBeginUserBoundsChange() {
+  if (!throttle_live_resize_ || live_resize_timer_.IsRunning())
+    return;
+  // Resizing the renderers more often than the display refreshes only makes
+  // them lay out frames which are never shown.
+  const display::Display display =
+      display::Screen::GetScreen()->GetDisplayNearestWindow(GetNativeWindow());
+  const float frequency = display.display_frequency() > 0
+                              ? display.display_frequency()
+                              : kDefaultLiveResizeFrequency;
+  root_view_.LockContentSize();
+  // Unretained is safe as |live_resize_timer_| is owned by |this|.
+  live_resize_timer_.Start(
+      FROM_HERE, base::Seconds(1) / frequency,
+      base::BindRepeating(&NativeWindowViews::UpdateLiveResize,
+                          base::Unretained(this)));
+}
+
+void NativeWindowViews::OnWindowEndUserBoundsChange() {
+  EndLiveResize();
+}
+
 views::View* NativeWindowViews::GetInitiallyFocusedView() {
   return focused_view_;
 }
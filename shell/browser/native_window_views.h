@@ -12,7 +12,11 @@
 #include <string>
 
 #include "base/memory/raw_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/timer/timer.h"
 #include "shell/browser/ui/views/root_view.h"
+#include "ui/aura/window_tree_host.h"
+#include "ui/aura/window_tree_host_observer.h"
 #include "ui/views/controls/webview/unhandled_keyboard_event_handler.h"
 #include "ui/views/widget/widget_observer.h"
 
@@ -44,6 +48,7 @@ gfx::Rect ScreenToDIPRect(HWND hwnd, const gfx::Rect& pixel_bounds);
 
 class NativeWindowViews : public NativeWindow,
                           public views::WidgetObserver,
+                          public aura::WindowTreeHostObserver,
                           public ui::EventHandler {
  public:
   NativeWindowViews(const gin_helper::Dictionary& options,
@@ -200,6 +205,11 @@ class NativeWindowViews : public NativeWindow,
   void OnWidgetDestroying(views::Widget* widget) override;
   void OnWidgetDestroyed(views::Widget* widget) override;
 
+  // aura::WindowTreeHostObserver:
+  void OnOcclusionStateChanged(aura::WindowTreeHost* host,
+                               aura::Window::OcclusionState new_state,
+                               const SkRegion& occluded_region) override;
+
   // views::WidgetDelegate:
   views::View* GetInitiallyFocusedView() override;
   bool CanMaximize() const override;
@@ -213,10 +223,16 @@ class NativeWindowViews : public NativeWindow,
   std::unique_ptr<views::NonClientFrameView> CreateNonClientFrameView(
       views::Widget* widget) override;
   void OnWidgetMove() override;
+  void OnWindowBeginUserBoundsChange() override;
+  void OnWindowEndUserBoundsChange() override;
 #if BUILDFLAG(IS_WIN)
   bool ExecuteWindowsCommand(int command_id) override;
 #endif
 
+  // Stops throttling the renderer resizes of a live resize.
+  void EndLiveResize();
+  void UpdateLiveResize();
+
 #if BUILDFLAG(IS_WIN)
   void HandleSizeEvent(WPARAM w_param, LPARAM l_param);
   void ResetWindowControls();
@@ -342,6 +358,15 @@ class NativeWindowViews : public NativeWindow,
   gfx::Size widget_size_;
   double opacity_ = 1.0;
   bool widget_destroyed_ = false;
+
+  // Whether the renderers are resized at most once per frame while the user
+  // resizes the window, see throttleLiveResize.
+  bool throttle_live_resize_ = false;
+  // Runs during a throttled live resize.
+  base::RepeatingTimer live_resize_timer_;
+
+  base::ScopedObservation<aura::WindowTreeHost, aura::WindowTreeHostObserver>
+      host_observation_{this};
 };
 
 }  // namespace electron
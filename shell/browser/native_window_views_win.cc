@@ -308,6 +308,8 @@ bool NativeWindowViews::PreHandleMSG(UINT message,
       return false;
     }
     case WM_EXITSIZEMOVE: {
+      // Give the renderers their final size before 'resized' is emitted.
+      EndLiveResize();
       if (is_resizing_) {
         NotifyWindowResized();
         is_resizing_ = false;
@@ -5,13 +5,17 @@
 #include "shell/browser/net/asar/asar_url_loader.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/logging.h"
+#include "base/numerics/checked_math.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/file_url_loader.h"
 #include "electron/fuses.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -26,6 +30,7 @@
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "shell/browser/net/asar/asar_file_validator.h"
 #include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_compression.h"
 #include "shell/common/asar/asar_util.h"
 
 namespace asar {
@@ -56,6 +61,130 @@ static_assert(kDefaultFileUrlPipeSize >= net::kMaxBytesToSniff,
               "Default file data pipe size must be at least as large as a MIME-"
               "type sniffing buffer.");
 
+// Serves a packed file directly out of the memory-mapped archive. Like
+// |mojo::FileDataSource|, offsets passed to |Read| are relative to the start
+// of the range and the range itself is expressed in absolute archive offsets,
+// so the loader below can treat both sources the same way.
+class MappedFileDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  MappedFileDataSource(std::shared_ptr<Archive> archive,
+                       base::span<const uint8_t> contents,
+                       uint64_t contents_offset)
+      : archive_(std::move(archive)),
+        contents_(contents),
+        contents_offset_(contents_offset),
+        start_offset_(contents_offset),
+        end_offset_(contents_offset + contents.size()) {}
+  ~MappedFileDataSource() override = default;
+
+  // disable copy
+  MappedFileDataSource(const MappedFileDataSource&) = delete;
+  MappedFileDataSource& operator=(const MappedFileDataSource&) = delete;
+
+  void SetRange(uint64_t start, uint64_t end) {
+    start_offset_ = start;
+    end_offset_ = end;
+  }
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override {
+    return std::max(start_offset_, end_offset_) - start_offset_;
+  }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    const uint64_t contents_end = contents_offset_ + contents_.size();
+    const uint64_t readable_end = std::min(end_offset_, contents_end);
+    base::CheckedNumeric<uint64_t> checked_position = start_offset_;
+    checked_position += offset;
+    uint64_t position;
+    if (!checked_position.AssignIfValid(&position) ||
+        position < contents_offset_ || position > readable_end) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+
+    const size_t read_size = static_cast<size_t>(
+        std::min<uint64_t>(buffer.size(), readable_end - position));
+    memcpy(buffer.data(), contents_.data() + (position - contents_offset_),
+           read_size);
+    result.bytes_read = read_size;
+    return result;
+  }
+
+ private:
+  // Keeps the mapping that |contents_| points into alive.
+  std::shared_ptr<Archive> archive_;
+  base::span<const uint8_t> contents_;
+  const uint64_t contents_offset_;
+  uint64_t start_offset_;
+  uint64_t end_offset_;
+};
+
+// Serves a compressed file, decompressing one block at a time as it is
+// streamed. Offsets are those the file would have if it was stored raw, so
+// this is used like the sources above.
+class CompressedFileDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  CompressedFileDataSource(std::shared_ptr<Archive> archive,
+                           const Archive::FileInfo& info)
+      : archive_(std::move(archive)),
+        reader_(archive_.get(), info),
+        contents_offset_(info.offset),
+        start_offset_(info.offset),
+        end_offset_(info.offset + info.size) {}
+  ~CompressedFileDataSource() override = default;
+
+  // disable copy
+  CompressedFileDataSource(const CompressedFileDataSource&) = delete;
+  CompressedFileDataSource& operator=(const CompressedFileDataSource&) =
+      delete;
+
+  void SetRange(uint64_t start, uint64_t end) {
+    start_offset_ = start;
+    end_offset_ = end;
+  }
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override {
+    return std::max(start_offset_, end_offset_) - start_offset_;
+  }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    const uint64_t contents_end = contents_offset_ + reader_.size();
+    const uint64_t readable_end = std::min(end_offset_, contents_end);
+    base::CheckedNumeric<uint64_t> checked_position = start_offset_;
+    checked_position += offset;
+    uint64_t position;
+    if (!checked_position.AssignIfValid(&position) ||
+        position < contents_offset_ || position > readable_end) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+
+    const size_t read_size = static_cast<size_t>(
+        std::min<uint64_t>(buffer.size(), readable_end - position));
+    const int64_t bytes_read =
+        reader_.Read(position - contents_offset_,
+                     base::as_writable_bytes(buffer.first(read_size)));
+    if (bytes_read < 0) {
+      result.result = MOJO_RESULT_DATA_LOSS;
+      return result;
+    }
+    result.bytes_read = static_cast<size_t>(bytes_read);
+    return result;
+  }
+
+ private:
+  // Outlives |reader_|.
+  std::shared_ptr<Archive> archive_;
+  CompressedFileReader reader_;
+  const uint64_t contents_offset_;
+  uint64_t start_offset_;
+  uint64_t end_offset_;
+};
+
 // Modified from the |FileURLLoader| in |file_url_loader_factory.cc|, to serve
 // asar files instead of normal files.
 class AsarURLLoader : public network::mojom::URLLoader {
@@ -89,8 +218,15 @@ class AsarURLLoader : public network::mojom::URLLoader {
   AsarURLLoader& operator=(const AsarURLLoader&) = delete;
 
  private:
-  AsarURLLoader() = default;
-  ~AsarURLLoader() override = default;
+  AsarURLLoader() {
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN0("electron", "AsarURLLoader",
+                                      TRACE_ID_LOCAL(this));
+  }
+  ~AsarURLLoader() override {
+    TRACE_EVENT_NESTABLE_ASYNC_END1("electron", "AsarURLLoader",
+                                    TRACE_ID_LOCAL(this), "size",
+                                    total_bytes_written_);
+  }
 
   void Start(const network::ResourceRequest& request,
              mojo::PendingReceiver<network::mojom::URLLoader> loader,
@@ -150,15 +286,85 @@ class AsarURLLoader : public network::mojom::URLLoader {
       return;
     }
 
+    std::string range_header;
+    net::HttpByteRange byte_range;
+    if (request.headers.GetHeader(net::HttpRequestHeaders::kRange,
+                                  &range_header)) {
+      // Handle a simple Range header for a single range.
+      std::vector<net::HttpByteRange> ranges;
+      bool fail = false;
+      if (net::HttpUtil::ParseRangeHeader(range_header, &ranges) &&
+          ranges.size() == 1) {
+        byte_range = ranges[0];
+        if (!byte_range.ComputeBounds(info.size))
+          fail = true;
+      } else {
+        fail = true;
+      }
+
+      if (fail) {
+        OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+        return;
+      }
+    }
+
+    // Packed files are served straight out of the memory-mapped archive when
+    // possible, otherwise fall back to reading the file.
+    //
     // Note that while the |Archive| already opens a |base::File|, we still need
     // to create a new |base::File| here, as it might be accessed by multiple
     // requests at the same time.
-    base::File file(info.unpacked ? real_path : archive->path(),
-                    base::File::FLAG_OPEN | base::File::FLAG_READ);
-    auto file_data_source =
-        std::make_unique<mojo::FileDataSource>(file.Duplicate());
     std::unique_ptr<mojo::DataPipeProducer::DataSource> readable_data_source;
-    mojo::FileDataSource* file_data_source_raw = file_data_source.get();
+    mojo::FileDataSource* file_data_source_raw = nullptr;
+    MappedFileDataSource* mapped_data_source_raw = nullptr;
+    CompressedFileDataSource* compressed_data_source_raw = nullptr;
+    base::File file;
+    if (info.compression.has_value()) {
+      // The blocks of compressed files are validated as they are
+      // decompressed.
+      auto compressed_data_source =
+          std::make_unique<CompressedFileDataSource>(archive, info);
+      compressed_data_source_raw = compressed_data_source.get();
+      readable_data_source = std::move(compressed_data_source);
+      is_verifying_file = false;
+      info.integrity.reset();
+    } else if (absl::optional<base::span<const uint8_t>> mapped_contents =
+                   archive->GetFileContents(info)) {
+      auto mapped_data_source = std::make_unique<MappedFileDataSource>(
+          archive, *mapped_contents, info.offset);
+      mapped_data_source_raw = mapped_data_source.get();
+      readable_data_source = std::move(mapped_data_source);
+      // With random access to the contents the blocks that will be sent can
+      // be validated concurrently upfront, instead of one after the other
+      // while streaming. This always includes the sniffed head of the file.
+      if (is_verifying_file) {
+        const uint64_t sniff_end =
+            std::min<uint64_t>(net::kMaxBytesToSniff, info.size);
+        const uint64_t range_start =
+            byte_range.IsValid() ? byte_range.first_byte_position() : 0;
+        const uint64_t range_end = byte_range.IsValid()
+                                       ? byte_range.last_byte_position() + 1
+                                       : info.size;
+        const IntegrityPayload& integrity = info.integrity.value();
+        if (!ValidateBlocksInParallel(*archive, info.offset, integrity,
+                                      *mapped_contents, 0, sniff_end) ||
+            !ValidateBlocksInParallel(*archive, info.offset, integrity,
+                                      *mapped_contents, range_start,
+                                      range_end)) {
+          LOG(FATAL) << "Failed to validate blocks of ASAR file: "
+                     << relative_path;
+        }
+        is_verifying_file = false;
+        info.integrity.reset();
+      }
+    } else {
+      file = base::File(info.unpacked ? real_path : archive->path(),
+                        base::File::FLAG_OPEN | base::File::FLAG_READ);
+      auto file_data_source =
+          std::make_unique<mojo::FileDataSource>(file.Duplicate());
+      file_data_source_raw = file_data_source.get();
+      readable_data_source = std::move(file_data_source);
+    }
     AsarFileValidator* file_validator_raw = nullptr;
     uint32_t block_size = 0;
     if (info.integrity.has_value()) {
@@ -167,9 +373,7 @@ class AsarURLLoader : public network::mojom::URLLoader {
           std::move(info.integrity.value()), std::move(file));
       file_validator_raw = asar_validator.get();
       readable_data_source = std::make_unique<mojo::FilteredDataSource>(
-          std::move(file_data_source), std::move(asar_validator));
-    } else {
-      readable_data_source = std::move(file_data_source);
+          std::move(readable_data_source), std::move(asar_validator));
     }
 
     std::vector<char> initial_read_buffer(
@@ -181,28 +385,6 @@ class AsarURLLoader : public network::mojom::URLLoader {
       return;
     }
 
-    std::string range_header;
-    net::HttpByteRange byte_range;
-    if (request.headers.GetHeader(net::HttpRequestHeaders::kRange,
-                                  &range_header)) {
-      // Handle a simple Range header for a single range.
-      std::vector<net::HttpByteRange> ranges;
-      bool fail = false;
-      if (net::HttpUtil::ParseRangeHeader(range_header, &ranges) &&
-          ranges.size() == 1) {
-        byte_range = ranges[0];
-        if (!byte_range.ComputeBounds(info.size))
-          fail = true;
-      } else {
-        fail = true;
-      }
-
-      if (fail) {
-        OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
-        return;
-      }
-    }
-
     uint64_t first_byte_to_send = 0;
     uint64_t total_bytes_dropped_from_head = initial_read_buffer.size();
     uint64_t total_bytes_to_send = info.size;
@@ -323,9 +505,14 @@ class AsarURLLoader : public network::mojom::URLLoader {
     // (i.e., no range request) this Seek is effectively a no-op.
     //
     // Note that in Electron we also need to add file offset.
-    file_data_source_raw->SetRange(
-        first_byte_to_send + info.offset,
-        first_byte_to_send + info.offset + total_bytes_to_send);
+    const uint64_t range_start = first_byte_to_send + info.offset;
+    const uint64_t range_end = range_start + total_bytes_to_send;
+    if (mapped_data_source_raw)
+      mapped_data_source_raw->SetRange(range_start, range_end);
+    else if (compressed_data_source_raw)
+      compressed_data_source_raw->SetRange(range_start, range_end);
+    else
+      file_data_source_raw->SetRange(range_start, range_end);
     if (file_validator_raw)
       file_validator_raw->SetRange(info.offset + first_byte_to_send,
                                    total_bytes_dropped_from_head,
@@ -391,8 +578,10 @@ void CreateAsarURLLoader(
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     scoped_refptr<net::HttpResponseHeaders> extra_response_headers) {
+  // Waits on the parallel validation of integrity blocks.
   auto task_runner = base::ThreadPool::CreateSequencedTaskRunner(
-      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+      {base::MayBlock(), base::WithBaseSyncPrimitives(),
+       base::TaskPriority::USER_VISIBLE,
        base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
   task_runner->PostTask(
       FROM_HERE,
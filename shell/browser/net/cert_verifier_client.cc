@@ -4,19 +4,81 @@
 
 #include <utility>
 
+#include "base/base64.h"
+#include "base/containers/contains.h"
+#include "base/strings/string_piece.h"
+#include "crypto/sha2.h"
+#include "net/base/net_errors.h"
+#include "net/cert/asn1_util.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/x509_util.h"
 #include "shell/browser/net/cert_verifier_client.h"
 
 namespace electron {
 
+namespace {
+
+// Plenty for the hosts an app connects to.
+constexpr size_t kMaxCachedResults = 256;
+
+// Whether the public key of one of the certificates of the chain is pinned.
+bool HasPinnedKey(const net::X509Certificate& certificate,
+                  const std::vector<std::string>& pins) {
+  std::vector<const CRYPTO_BUFFER*> buffers = {certificate.cert_buffer()};
+  for (const auto& intermediate : certificate.intermediate_buffers())
+    buffers.push_back(intermediate.get());
+  for (const CRYPTO_BUFFER* buffer : buffers) {
+    base::StringPiece spki;
+    if (!net::asn1::ExtractSPKIFromDERCert(
+            net::x509_util::CryptoBufferAsStringPiece(buffer), &spki)) {
+      continue;
+    }
+    std::string hash;
+    base::Base64Encode(crypto::SHA256HashString(spki), &hash);
+    if (base::Contains(pins, "sha256/" + hash))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 VerifyRequestParams::VerifyRequestParams() = default;
 
 VerifyRequestParams::~VerifyRequestParams() = default;
 
 VerifyRequestParams::VerifyRequestParams(const VerifyRequestParams&) = default;
 
-CertVerifierClient::CertVerifierClient(CertVerifyProc proc)
-    : cert_verify_proc_(proc) {}
+CertVerifyResultCache::CertVerifyResultCache() : results_(kMaxCachedResults) {}
+
+CertVerifyResultCache::~CertVerifyResultCache() = default;
+
+absl::optional<int> CertVerifyResultCache::Get(const Key& key) {
+  auto cached = results_.Get(key);
+  if (cached == results_.end())
+    return absl::nullopt;
+  if (base::TimeTicks::Now() >= cached->second.expiry) {
+    results_.Erase(cached);
+    return absl::nullopt;
+  }
+  return cached->second.result;
+}
+
+void CertVerifyResultCache::Put(Key key, int result, base::TimeDelta ttl) {
+  results_.Put(std::move(key), {result, base::TimeTicks::Now() + ttl});
+}
+
+CertVerifierClient::Options::Options() = default;
+CertVerifierClient::Options::Options(const Options&) = default;
+CertVerifierClient::Options& CertVerifierClient::Options::operator=(
+    const Options&) = default;
+CertVerifierClient::Options::~Options() = default;
+
+CertVerifierClient::CertVerifierClient(
+    CertVerifyProc proc,
+    const Options& options,
+    scoped_refptr<CertVerifyResultCache> cache)
+    : cert_verify_proc_(proc), options_(options), cache_(std::move(cache)) {}
 
 CertVerifierClient::~CertVerifierClient() = default;
 
@@ -28,6 +90,35 @@ void CertVerifierClient::Verify(
     int flags,
     const absl::optional<std::string>& ocsp_response,
     VerifyCallback callback) {
+  // ERR_ABORTED has the network service use the result of its own
+  // verification, which pinned hosts keep when the chain has one of their
+  // keys.
+  auto pins = options_.pins.find(hostname);
+  if (pins != options_.pins.end()) {
+    std::move(callback).Run(HasPinnedKey(*certificate, pins->second)
+                                ? net::ERR_ABORTED
+                                : net::ERR_SSL_PINNED_KEY_NOT_IN_CERT_CHAIN,
+                            default_result);
+    return;
+  }
+
+  if (!cert_verify_proc_) {
+    std::move(callback).Run(net::ERR_ABORTED, default_result);
+    return;
+  }
+
+  absl::optional<CertVerifyResultCache::Key> key;
+  if (options_.cache_ttl.is_positive()) {
+    key.emplace(hostname,
+                net::X509Certificate::CalculateFingerprint256(
+                    certificate->cert_buffer()),
+                default_error);
+    if (absl::optional<int> cached = cache_->Get(*key)) {
+      std::move(callback).Run(*cached, default_result);
+      return;
+    }
+  }
+
   VerifyRequestParams params;
   params.hostname = hostname;
   params.default_result = net::ErrorToString(default_error);
@@ -39,8 +130,15 @@ void CertVerifierClient::Verify(
       params,
       base::BindOnce(
           [](VerifyCallback callback, const net::CertVerifyResult& result,
-             int err) { std::move(callback).Run(err, result); },
-          std::move(callback), default_result));
+             scoped_refptr<CertVerifyResultCache> cache,
+             absl::optional<CertVerifyResultCache::Key> key,
+             base::TimeDelta ttl, int err) {
+            if (key)
+              cache->Put(std::move(*key), err, ttl);
+            std::move(callback).Run(err, result);
+          },
+          std::move(callback), default_result, cache_, std::move(key),
+          options_.cache_ttl));
 }
 
 }  // namespace electron
@@ -6,9 +6,16 @@
 #define ELECTRON_SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "net/cert/x509_certificate.h"
 #include "services/network/public/mojom/network_context.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron {
 
@@ -25,13 +32,61 @@ struct VerifyRequestParams {
   ~VerifyRequestParams();
 };
 
+// The results of the verify proc kept for the cacheTtl of
+// ses.setCertificateVerifyProc(). Owned by the session, which clears it, and
+// the client it gave to the network context. Only used on the UI thread.
+class CertVerifyResultCache : public base::RefCounted<CertVerifyResultCache> {
+ public:
+  // The hostname, the SHA-256 fingerprint of the leaf certificate and the
+  // result of Chromium's verification.
+  using Key = std::tuple<std::string, net::SHA256HashValue, int>;
+
+  CertVerifyResultCache();
+
+  // disable copy
+  CertVerifyResultCache(const CertVerifyResultCache&) = delete;
+  CertVerifyResultCache& operator=(const CertVerifyResultCache&) = delete;
+
+  absl::optional<int> Get(const Key& key);
+  void Put(Key key, int result, base::TimeDelta ttl);
+  void Clear() { results_.Clear(); }
+
+ private:
+  friend class base::RefCounted<CertVerifyResultCache>;
+
+  ~CertVerifyResultCache();
+
+  struct CachedResult {
+    int result = 0;
+    base::TimeTicks expiry;
+  };
+  base::LRUCache<Key, CachedResult> results_;
+};
+
 class CertVerifierClient : public network::mojom::CertVerifierClient {
  public:
   using CertVerifyProc =
       base::RepeatingCallback<void(const VerifyRequestParams& request,
                                    base::OnceCallback<void(int)>)>;
 
-  explicit CertVerifierClient(CertVerifyProc proc);
+  struct Options {
+    Options();
+    Options(const Options&);
+    Options& operator=(const Options&);
+    ~Options();
+
+    // How long the results of the proc are reused, they aren't when zero.
+    base::TimeDelta cache_ttl;
+    // The hosts to the "sha256/<base64>" hashes of the public keys one of
+    // which their certificate chain must have. The proc isn't called for
+    // them.
+    base::flat_map<std::string, std::vector<std::string>> pins;
+  };
+
+  // |proc| can be null when only |options.pins| are set.
+  CertVerifierClient(CertVerifyProc proc,
+                     const Options& options,
+                     scoped_refptr<CertVerifyResultCache> cache);
   ~CertVerifierClient() override;
 
   // network::mojom::CertVerifierClient
@@ -45,6 +100,8 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
 
  private:
   CertVerifyProc cert_verify_proc_;
+  const Options options_;
+  scoped_refptr<CertVerifyResultCache> cache_;
 };
 
 }  // namespace electron
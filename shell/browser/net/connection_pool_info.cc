@@ -0,0 +1,257 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/connection_pool_info.h"
+
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/json/json_reader.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log_capture_mode.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+
+namespace electron {
+
+namespace {
+
+std::pair<base::FilePath, base::File> CreateFile() {
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path))
+    return {};
+  return {path, base::File(path, base::File::FLAG_CREATE_ALWAYS |
+                                     base::File::FLAG_WRITE)};
+}
+
+int CountOf(const base::Value::Dict& dict, base::StringPiece key) {
+  const base::Value::List* list = dict.FindList(key);
+  return list ? static_cast<int>(list->size()) : 0;
+}
+
+// The net log's names of the values differ between versions of //net, so
+// everything is looked up leniently and whatever is missing left out.
+
+base::Value::List GetSocketPools(const base::Value* info) {
+  base::Value::List result;
+  if (!info || !info->is_list())
+    return result;
+  for (const base::Value& pool : info->GetList()) {
+    const base::Value::Dict* groups =
+        pool.is_dict() ? pool.GetDict().FindDict("groups") : nullptr;
+    if (!groups)
+      continue;
+    for (const auto [name, value] : *groups) {
+      if (!value.is_dict())
+        continue;
+      const base::Value::Dict& group = value.GetDict();
+      base::Value::Dict entry;
+      entry.Set("group", name);
+      entry.Set("activeSockets",
+                group.FindInt("active_socket_count").value_or(0));
+      entry.Set("idleSockets", CountOf(group, "idle_sockets"));
+      entry.Set("connectingSockets", CountOf(group, "connect_jobs"));
+      entry.Set("pendingRequests",
+                group.FindInt("pending_request_count").value_or(0));
+      result.Append(std::move(entry));
+    }
+  }
+  return result;
+}
+
+base::Value::List GetHttp2Sessions(const base::Value* info) {
+  base::Value::List result;
+  if (!info || !info->is_list())
+    return result;
+  for (const base::Value& value : info->GetList()) {
+    if (!value.is_dict())
+      continue;
+    const base::Value::Dict& session = value.GetDict();
+    base::Value::Dict entry;
+    if (const std::string* host = session.FindString("host_port_pair"))
+      entry.Set("host", *host);
+    entry.Set("activeStreams", session.FindInt("active_streams").value_or(0));
+    // More than one means the session was reused.
+    entry.Set("streamsInitiated",
+              session.FindInt("streams_initiated_count").value_or(0));
+    result.Append(std::move(entry));
+  }
+  return result;
+}
+
+base::Value::List GetQuicSessions(const base::Value* info) {
+  base::Value::List result;
+  const base::Value::List* sessions =
+      info && info->is_dict() ? info->GetDict().FindList("sessions") : nullptr;
+  if (!sessions)
+    return result;
+  for (const base::Value& value : *sessions) {
+    if (!value.is_dict())
+      continue;
+    const base::Value::Dict& session = value.GetDict();
+    base::Value::Dict entry;
+    if (const base::Value::List* hosts = session.FindList("hosts"))
+      entry.Set("hosts", hosts->Clone());
+    if (const std::string* version = session.FindString("version"))
+      entry.Set("version", *version);
+    entry.Set("openStreams", session.FindInt("open_streams").value_or(0));
+    entry.Set("totalStreams", session.FindInt("total_streams").value_or(0));
+    result.Append(std::move(entry));
+  }
+  return result;
+}
+
+base::Value::List GetDnsCache(const base::Value* info) {
+  base::Value::List result;
+  const base::Value::List* entries =
+      info && info->is_dict()
+          ? info->GetDict().FindListByDottedPath("cache.entries")
+          : nullptr;
+  if (!entries)
+    return result;
+  for (const base::Value& value : *entries) {
+    if (!value.is_dict())
+      continue;
+    const base::Value::Dict& cached = value.GetDict();
+    const std::string* hostname = cached.FindString("hostname");
+    if (!hostname)
+      hostname = cached.FindString("host");
+    if (!hostname)
+      continue;
+    base::Value::Dict entry;
+    entry.Set("hostname", *hostname);
+    if (const base::Value::List* addresses = cached.FindList("addresses"))
+      entry.Set("addresses", addresses->Clone());
+    if (absl::optional<int> ttl = cached.FindInt("ttl"))
+      entry.Set("ttl", *ttl);
+    result.Append(std::move(entry));
+  }
+  return result;
+}
+
+ConnectionPoolInfo::Result ReadSnapshot(const base::FilePath& path) {
+  std::string contents;
+  const bool read = base::ReadFileToString(path, &contents);
+  base::DeleteFile(path);
+  if (!read)
+    return base::unexpected("Failed to read the net log");
+
+  absl::optional<base::Value> log = base::JSONReader::Read(contents);
+  const base::Value::Dict* polled_data =
+      log && log->is_dict() ? log->GetDict().FindDict("polledData") : nullptr;
+  if (!polled_data)
+    return base::unexpected("The net log has no polled data");
+
+  base::Value::Dict result;
+  result.Set("socketPools",
+             GetSocketPools(polled_data->Find("socketPoolInfo")));
+  result.Set("http2Sessions",
+             GetHttp2Sessions(polled_data->Find("spdySessionInfo")));
+  result.Set("quicSessions", GetQuicSessions(polled_data->Find("quicInfo")));
+  result.Set("dnsCache", GetDnsCache(polled_data->Find("hostResolverInfo")));
+  return result;
+}
+
+}  // namespace
+
+// static
+void ConnectionPoolInfo::Get(network::mojom::NetworkContext* network_context,
+                             ResultCallback callback) {
+  // Owns itself until |callback| has run.
+  auto* info = new ConnectionPoolInfo(std::move(callback));
+  network_context->CreateNetLogExporter(
+      info->exporter_.BindNewPipeAndPassReceiver());
+  // Unretained is safe as the exporter is owned by |info|.
+  info->exporter_.set_disconnect_handler(base::BindOnce(
+      &ConnectionPoolInfo::OnDisconnected, base::Unretained(info)));
+  info->file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CreateFile),
+      base::BindOnce(&ConnectionPoolInfo::OnFileCreated,
+                     info->weak_factory_.GetWeakPtr()));
+}
+
+ConnectionPoolInfo::ConnectionPoolInfo(ResultCallback callback)
+    : file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      callback_(std::move(callback)) {}
+
+ConnectionPoolInfo::~ConnectionPoolInfo() {
+  if (!path_.empty()) {
+    file_task_runner_->PostTask(FROM_HERE,
+                                base::GetDeleteFileCallback(path_));
+  }
+}
+
+// static
+void ConnectionPoolInfo::OnFileCreated(
+    base::WeakPtr<ConnectionPoolInfo> info,
+    std::pair<base::FilePath, base::File> file) {
+  if (!info) {
+    // The network service went away in the meantime.
+    if (!file.first.empty()) {
+      base::ThreadPool::PostTask(
+          FROM_HERE,
+          {base::MayBlock(), base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+          base::BindOnce(
+              [](std::pair<base::FilePath, base::File> file) {
+                file.second.Close();
+                base::DeleteFile(file.first);
+              },
+              std::move(file)));
+    }
+    return;
+  }
+  info->StartLogging(std::move(file));
+}
+
+void ConnectionPoolInfo::StartLogging(
+    std::pair<base::FilePath, base::File> file) {
+  path_ = std::move(file.first);
+  if (!file.second.IsValid()) {
+    Finish(base::unexpected("Failed to create the net log file"));
+    return;
+  }
+  exporter_->Start(std::move(file.second), base::Value::Dict(),
+                   net::NetLogCaptureMode::kDefault,
+                   network::mojom::NetLogExporter::kUnlimitedFileSize,
+                   base::BindOnce(&ConnectionPoolInfo::OnStarted,
+                                  base::Unretained(this)));
+}
+
+void ConnectionPoolInfo::OnStarted(int32_t error) {
+  if (error != net::OK) {
+    Finish(base::unexpected(net::ErrorToString(error)));
+    return;
+  }
+  exporter_->Stop(base::Value::Dict(),
+                  base::BindOnce(&ConnectionPoolInfo::OnStopped,
+                                 base::Unretained(this)));
+}
+
+void ConnectionPoolInfo::OnStopped(int32_t error) {
+  if (error != net::OK) {
+    Finish(base::unexpected(net::ErrorToString(error)));
+    return;
+  }
+  exporter_.reset();
+  // ReadSnapshot() deletes the file.
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadSnapshot, std::exchange(path_, {})),
+      base::BindOnce(&ConnectionPoolInfo::Finish, base::Unretained(this)));
+}
+
+void ConnectionPoolInfo::OnDisconnected() {
+  Finish(base::unexpected("Failed to start net log exporter"));
+}
+
+void ConnectionPoolInfo::Finish(Result result) {
+  exporter_.reset();
+  std::move(callback_).Run(std::move(result));
+  delete this;
+}
+
+}  // namespace electron
@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_CONNECTION_POOL_INFO_H_
+#define ELECTRON_SHELL_BROWSER_NET_CONNECTION_POOL_INFO_H_
+
+#include <string>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/types/expected.h"
+#include "base/values.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/network/public/mojom/net_log.mojom.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace network::mojom {
+class NetworkContext;
+}
+
+namespace electron {
+
+// Takes a snapshot of the socket pools, HTTP/2 and QUIC sessions and host
+// cache of a network context.
+//
+// The network service only hands these out as the polled data at the end of
+// a net log, so a net log is written to a temporary file and stopped right
+// away, without capturing any events in between.
+class ConnectionPoolInfo {
+ public:
+  // The snapshot, or the reason none could be taken.
+  using Result = base::expected<base::Value::Dict, std::string>;
+  using ResultCallback = base::OnceCallback<void(Result)>;
+
+  static void Get(network::mojom::NetworkContext* network_context,
+                  ResultCallback callback);
+
+  ~ConnectionPoolInfo();
+
+  // disable copy
+  ConnectionPoolInfo(const ConnectionPoolInfo&) = delete;
+  ConnectionPoolInfo& operator=(const ConnectionPoolInfo&) = delete;
+
+ private:
+  explicit ConnectionPoolInfo(ResultCallback callback);
+
+  static void OnFileCreated(base::WeakPtr<ConnectionPoolInfo> info,
+                            std::pair<base::FilePath, base::File> file);
+  void StartLogging(std::pair<base::FilePath, base::File> file);
+  void OnStarted(int32_t error);
+  void OnStopped(int32_t error);
+  void OnDisconnected();
+  // Deletes |this|.
+  void Finish(Result result);
+
+  mojo::Remote<network::mojom::NetLogExporter> exporter_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::FilePath path_;
+  ResultCallback callback_;
+
+  base::WeakPtrFactory<ConnectionPoolInfo> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_CONNECTION_POOL_INFO_H_
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/connection_warming.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "base/ranges/algorithm.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "chrome/browser/predictors/preconnect_manager.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "net/base/network_anonymization_key.h"
+#include "net/base/schemeful_site.h"
+#include "shell/browser/electron_browser_context.h"
+#include "url/origin.h"
+
+namespace electron::connection_warming {
+
+namespace {
+
+// List of { url, numSockets, priority } dictionaries.
+const char kPersistedTargets[] = "electron.connection_warming.targets";
+
+// Same as the limit of session.preconnect().
+constexpr int kMaxSockets = 6;
+
+base::Value::Dict TargetToValue(const Target& target) {
+  base::Value::Dict value;
+  value.Set("url", target.url.spec());
+  value.Set("numSockets", target.num_sockets);
+  value.Set("priority", target.priority);
+  return value;
+}
+
+absl::optional<Target> TargetFromValue(const base::Value& value) {
+  if (!value.is_dict())
+    return absl::nullopt;
+  const base::Value::Dict& dict = value.GetDict();
+  const std::string* url = dict.FindString("url");
+  if (!url)
+    return absl::nullopt;
+  Target target;
+  target.url = GURL(*url);
+  target.num_sockets = dict.FindInt("numSockets").value_or(1);
+  target.priority = dict.FindInt("priority").value_or(0);
+  // Preferences may have been edited by hand.
+  if (!target.url.is_valid() || !target.url.SchemeIsHTTPOrHTTPS() ||
+      target.num_sockets < 0 || target.num_sockets > kMaxSockets) {
+    return absl::nullopt;
+  }
+  return target;
+}
+
+}  // namespace
+
+void RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterListPref(kPersistedTargets);
+}
+
+void Warm(ElectronBrowserContext* browser_context,
+          std::vector<Target> targets,
+          bool persist) {
+  if (persist) {
+    base::Value::List value;
+    for (const Target& target : targets)
+      value.Append(TargetToValue(target));
+    browser_context->prefs()->SetList(kPersistedTargets, std::move(value));
+  }
+  if (targets.empty())
+    return;
+
+  TRACE_EVENT1("electron", "connection_warming::Warm", "targets",
+               targets.size());
+  // The preconnect manager works through the requests in order, a few at a
+  // time.
+  base::ranges::stable_sort(targets, std::greater<>(), &Target::priority);
+  std::vector<predictors::PreconnectRequest> requests;
+  requests.reserve(targets.size());
+  for (const Target& target : targets) {
+    url::Origin origin = url::Origin::Create(target.url);
+    requests.emplace_back(origin, target.num_sockets,
+                          net::NetworkAnonymizationKey::CreateSameSite(
+                              net::SchemefulSite(origin)));
+  }
+  browser_context->GetPreconnectManager()->Start(targets.front().url,
+                                                 std::move(requests));
+}
+
+void WarmPersistedTargets(
+    base::WeakPtr<ElectronBrowserContext> browser_context) {
+  if (!browser_context)
+    return;
+  std::vector<Target> targets;
+  for (const base::Value& value :
+       browser_context->prefs()->GetList(kPersistedTargets)) {
+    if (absl::optional<Target> target = TargetFromValue(value))
+      targets.push_back(std::move(*target));
+  }
+  Warm(browser_context.get(), std::move(targets), false);
+}
+
+}  // namespace electron::connection_warming
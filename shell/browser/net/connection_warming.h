@@ -0,0 +1,46 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_CONNECTION_WARMING_H_
+#define ELECTRON_SHELL_BROWSER_NET_CONNECTION_WARMING_H_
+
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "url/gurl.h"
+
+class PrefRegistrySimple;
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+namespace connection_warming {
+
+struct Target {
+  GURL url;
+  // Only resolves the host when 0.
+  int num_sockets = 1;
+  // Targets with a higher priority are warmed first.
+  int priority = 0;
+};
+
+void RegisterPrefs(PrefRegistrySimple* registry);
+
+// Resolves the hosts of |targets| and opens the sockets to their origins,
+// ordered by priority. With |persist|, the same happens for |targets| every
+// time |browser_context| is created from then on.
+void Warm(ElectronBrowserContext* browser_context,
+          std::vector<Target> targets,
+          bool persist);
+
+// Warms the targets persisted by the last Warm() which asked for it.
+void WarmPersistedTargets(
+    base::WeakPtr<ElectronBrowserContext> browser_context);
+
+}  // namespace connection_warming
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_CONNECTION_WARMING_H_
@@ -0,0 +1,139 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/data_pipe_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check.h"
+#include "base/functional/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// Same as the network service's default, used for bodies of unknown size.
+constexpr uint64_t kDefaultPipeCapacity = 512 * 1024;
+constexpr uint64_t kMinPipeCapacity = 4 * 1024;
+
+}  // namespace
+
+// Accumulated by a StatsDataSource on the producer's sequence, and read by
+// the writer once the write completed.
+struct DataPipeWriter::WriteStats {
+  uint64_t bytes_written = 0;
+  base::TimeDelta stall_time;
+};
+
+// Forwards to another source while measuring how long the producer waited
+// for the consumer between reads. The producer offers each read as much of
+// the pipe as is free, so a read that fills its buffer filled the pipe and
+// the time until the next read is spent waiting for the consumer.
+class DataPipeWriter::StatsDataSource
+    : public mojo::DataPipeProducer::DataSource {
+ public:
+  StatsDataSource(std::unique_ptr<mojo::DataPipeProducer::DataSource> source,
+                  std::shared_ptr<WriteStats> stats)
+      : source_(std::move(source)), stats_(std::move(stats)) {}
+  ~StatsDataSource() override = default;
+
+  // disable copy
+  StatsDataSource(const StatsDataSource&) = delete;
+  StatsDataSource& operator=(const StatsDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return source_->GetLength(); }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    if (pipe_full_)
+      stats_->stall_time += base::TimeTicks::Now() - last_read_time_;
+
+    ReadResult result = source_->Read(offset, buffer);
+    stats_->bytes_written += result.bytes_read;
+    pipe_full_ = result.result == MOJO_RESULT_OK && !buffer.empty() &&
+                 result.bytes_read == buffer.size();
+    last_read_time_ = base::TimeTicks::Now();
+    return result;
+  }
+
+ private:
+  std::unique_ptr<mojo::DataPipeProducer::DataSource> source_;
+  std::shared_ptr<WriteStats> stats_;
+  bool pipe_full_ = false;
+  base::TimeTicks last_read_time_;
+};
+
+double DataPipeWriter::Stats::throughput() const {
+  if (duration.is_zero())
+    return 0;
+  return bytes_written / duration.InSecondsF();
+}
+
+// static
+std::unique_ptr<DataPipeWriter> DataPipeWriter::Create(
+    uint64_t expected_size,
+    mojo::ScopedDataPipeConsumerHandle* consumer) {
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = static_cast<uint32_t>(
+      expected_size
+          ? std::clamp(expected_size, kMinPipeCapacity, kDefaultPipeCapacity)
+          : kDefaultPipeCapacity);
+
+  mojo::ScopedDataPipeProducerHandle producer;
+  if (mojo::CreateDataPipe(&options, producer, *consumer) != MOJO_RESULT_OK)
+    return nullptr;
+  return base::WrapUnique(new DataPipeWriter(std::move(producer)));
+}
+
+DataPipeWriter::DataPipeWriter(mojo::ScopedDataPipeProducerHandle producer)
+    : producer_(std::move(producer)), start_time_(base::TimeTicks::Now()) {}
+
+DataPipeWriter::~DataPipeWriter() = default;
+
+void DataPipeWriter::Write(
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> source,
+    WriteCallback callback) {
+  DCHECK(!is_writing_);
+  is_writing_ = true;
+
+  auto write_stats = std::make_shared<WriteStats>();
+  producer_.Write(
+      std::make_unique<StatsDataSource>(std::move(source), write_stats),
+      base::BindOnce(&DataPipeWriter::OnWrite, weak_factory_.GetWeakPtr(),
+                     write_stats, std::move(callback)));
+}
+
+void DataPipeWriter::OnWrite(std::shared_ptr<WriteStats> write_stats,
+                             WriteCallback callback,
+                             MojoResult result) {
+  is_writing_ = false;
+  bytes_written_ += write_stats->bytes_written;
+  stall_time_ += write_stats->stall_time;
+  std::move(callback).Run(result);
+}
+
+DataPipeWriter::Stats DataPipeWriter::GetStats() const {
+  Stats stats;
+  stats.bytes_written = bytes_written_;
+  stats.duration = base::TimeTicks::Now() - start_time_;
+  stats.stall_time = stall_time_;
+  return stats;
+}
+
+void DataPipeWriter::ReportStats(const char* loader) const {
+  const Stats stats = GetStats();
+  TRACE_EVENT_INSTANT("electron", "DataPipeWriter::ReportStats", "loader",
+                      loader, "bytes", stats.bytes_written, "duration_ms",
+                      stats.duration.InMillisecondsF(), "stall_ms",
+                      stats.stall_time.InMillisecondsF(), "bytes_per_second",
+                      stats.throughput());
+}
+
+}  // namespace electron
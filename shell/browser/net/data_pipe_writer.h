@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_WRITER_H_
+#define ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_WRITER_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+
+namespace electron {
+
+// Writes a response body into a data pipe as fast as the consumer drains it,
+// shared by the loaders that serve protocol responses.
+//
+// The pipe is sized after the expected body, so small bodies don't hold on to
+// a large buffer while big ones don't need a pipe as large as themselves.
+// Writes happen in pipe-sized chunks off the calling sequence and wait for
+// the consumer when the pipe is full, so they never block the caller. The
+// time spent waiting is accounted for, which tells consumers that are slow
+// to read apart from producers that are slow to write.
+class DataPipeWriter {
+ public:
+  struct Stats {
+    uint64_t bytes_written = 0;
+    // Time since the writer was created.
+    base::TimeDelta duration;
+    // Time writes spent waiting for the consumer to make room in the pipe.
+    base::TimeDelta stall_time;
+
+    // In bytes per second.
+    double throughput() const;
+  };
+
+  using WriteCallback = base::OnceCallback<void(MojoResult)>;
+
+  // Creates a pipe for a body of |expected_size| bytes, or of unknown size
+  // when zero, and stores its consumer end in |consumer|. Returns nullptr if
+  // the pipe could not be created.
+  static std::unique_ptr<DataPipeWriter> Create(
+      uint64_t expected_size,
+      mojo::ScopedDataPipeConsumerHandle* consumer);
+
+  ~DataPipeWriter();
+
+  // disable copy
+  DataPipeWriter(const DataPipeWriter&) = delete;
+  DataPipeWriter& operator=(const DataPipeWriter&) = delete;
+
+  // Writes all of |source| to the pipe and runs |callback| on the calling
+  // sequence when done. Only one write may be in flight at a time.
+  void Write(std::unique_ptr<mojo::DataPipeProducer::DataSource> source,
+             WriteCallback callback);
+
+  bool is_writing() const { return is_writing_; }
+
+  Stats GetStats() const;
+
+  // Emits a trace event with the stats of this writer, for |loader| to call
+  // once it finished the response.
+  void ReportStats(const char* loader) const;
+
+ private:
+  class StatsDataSource;
+  struct WriteStats;
+
+  explicit DataPipeWriter(mojo::ScopedDataPipeProducerHandle producer);
+
+  void OnWrite(std::shared_ptr<WriteStats> write_stats,
+               WriteCallback callback,
+               MojoResult result);
+
+  mojo::DataPipeProducer producer_;
+  const base::TimeTicks start_time_;
+  bool is_writing_ = false;
+  uint64_t bytes_written_ = 0;
+  base::TimeDelta stall_time_;
+
+  base::WeakPtrFactory<DataPipeWriter> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_WRITER_H_
@@ -0,0 +1,349 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/directory_url_loader_factory.h"
+
+#include <cinttypes>
+#include <memory>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/i18n/time_formatting.h"
+#include "base/strings/escape.h"
+#include "base/strings/pattern.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "net/base/filename_util.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+
+namespace electron {
+
+namespace {
+
+const base::FilePath::CharType kIndexFile[] = FILE_PATH_LITERAL("index.html");
+
+// Forwards to a URLLoaderClient, replacing the MIME type of the response.
+class MimeTypeOverridingClient : public network::mojom::URLLoaderClient {
+ public:
+  MimeTypeOverridingClient(
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      std::string mime_type)
+      : client_(std::move(client)), mime_type_(std::move(mime_type)) {}
+  ~MimeTypeOverridingClient() override = default;
+
+  // disable copy
+  MimeTypeOverridingClient(const MimeTypeOverridingClient&) = delete;
+  MimeTypeOverridingClient& operator=(const MimeTypeOverridingClient&) =
+      delete;
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveEarlyHints(network::mojom::EarlyHintsPtr early_hints) override {
+    client_->OnReceiveEarlyHints(std::move(early_hints));
+  }
+  void OnReceiveResponse(
+      network::mojom::URLResponseHeadPtr head,
+      mojo::ScopedDataPipeConsumerHandle body,
+      absl::optional<mojo_base::BigBuffer> cached_metadata) override {
+    head->mime_type = mime_type_;
+    head->did_mime_sniff = false;
+    if (head->headers) {
+      head->headers->SetHeader(net::HttpRequestHeaders::kContentType,
+                               mime_type_);
+    }
+    client_->OnReceiveResponse(std::move(head), std::move(body),
+                               std::move(cached_metadata));
+  }
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {
+    client_->OnReceiveRedirect(redirect_info, std::move(head));
+  }
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override {
+    client_->OnUploadProgress(current_position, total_size,
+                              std::move(callback));
+  }
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {
+    client_->OnTransferSizeUpdated(transfer_size_diff);
+  }
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    client_->OnComplete(status);
+  }
+
+ private:
+  mojo::Remote<network::mojom::URLLoaderClient> client_;
+  const std::string mime_type_;
+};
+
+struct ResolvedFile {
+  base::FilePath path;
+  std::string etag;
+  base::Time last_modified;
+};
+
+int64_t ToETagTime(base::Time time) {
+  return time.ToDeltaSinceWindowsEpoch().InMicroseconds();
+}
+
+// Maps the path of |url| to a path relative to the protocol's root, refusing
+// anything that could escape it.
+bool GetRelativePath(const GURL& url, base::FilePath* out) {
+  std::string path = base::UnescapeBinaryURLComponent(url.path_piece());
+  if (path.find('\0') != std::string::npos)
+    return false;
+#if BUILDFLAG(IS_WIN)
+  // Drive letters and alternate data streams.
+  if (path.find(':') != std::string::npos)
+    return false;
+#endif
+  base::TrimString(path, "/", &path);
+
+  base::FilePath relative = base::FilePath::FromUTF8Unsafe(path);
+  if (relative.IsAbsolute() || relative.ReferencesParent())
+    return false;
+  *out = relative;
+  return true;
+}
+
+// Finds the file to serve for |path|, which is a directory's index.html for
+// directories, and computes its validators.
+bool ResolveFile(base::FilePath path, ResolvedFile* out) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    base::FilePath asar_path, relative_path;
+    if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+      std::shared_ptr<asar::Archive> archive =
+          asar::GetOrCreateAsarArchive(asar_path);
+      asar::Archive::Stats stats;
+      if (!archive || !archive->Stat(relative_path, &stats))
+        return false;
+      if (stats.is_directory) {
+        path = path.Append(kIndexFile);
+        continue;
+      }
+
+      asar::Archive::FileInfo info;
+      base::File::Info archive_info;
+      if (!archive->GetFileInfo(relative_path, &info) ||
+          !base::GetFileInfo(asar_path, &archive_info))
+        return false;
+      // Packed files only change along with the archive, so the position in
+      // it is as good as a hash when there is no integrity.
+      out->last_modified = archive_info.last_modified;
+      out->etag =
+          info.integrity
+              ? base::StrCat({"\"", info.integrity->hash, "\""})
+              : base::StringPrintf("\"%" PRIx64 "-%x-%" PRIx64 "\"",
+                                   info.offset, info.size,
+                                   ToETagTime(archive_info.last_modified));
+    } else {
+      base::File::Info info;
+      if (!base::GetFileInfo(path, &info))
+        return false;
+      if (info.is_directory) {
+        path = path.Append(kIndexFile);
+        continue;
+      }
+
+      out->last_modified = info.last_modified;
+      out->etag = base::StringPrintf("\"%" PRIx64 "-%" PRIx64 "\"", info.size,
+                                     ToETagTime(info.last_modified));
+    }
+    out->path = path;
+    return true;
+  }
+  return false;
+}
+
+bool IsNotModified(const net::HttpRequestHeaders& headers,
+                   const ResolvedFile& file) {
+  std::string if_none_match;
+  if (headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch,
+                        &if_none_match)) {
+    for (base::StringPiece etag :
+         base::SplitStringPiece(if_none_match, ",", base::TRIM_WHITESPACE,
+                                base::SPLIT_WANT_NONEMPTY)) {
+      if (base::StartsWith(etag, "W/"))
+        etag.remove_prefix(2);
+      if (etag == "*" || etag == file.etag)
+        return true;
+    }
+    // If-None-Match takes precedence over If-Modified-Since.
+    return false;
+  }
+
+  std::string if_modified_since;
+  base::Time since;
+  if (headers.GetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+                        &if_modified_since) &&
+      base::Time::FromUTCString(if_modified_since.c_str(), &since)) {
+    // HTTP dates only have a resolution of seconds.
+    return file.last_modified.ToTimeT() <= since.ToTimeT();
+  }
+  return false;
+}
+
+void CompleteWithError(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    net::Error error) {
+  mojo::Remote<network::mojom::URLLoaderClient>(std::move(client))
+      ->OnComplete(network::URLLoaderCompletionStatus(error));
+}
+
+void SendNotModified(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  headers->ReplaceStatusLine("HTTP/1.1 304 Not Modified");
+  auto head = network::mojom::URLResponseHead::New();
+  head->headers = std::move(headers);
+  client_remote->OnReceiveResponse(std::move(head), std::move(consumer),
+                                   absl::nullopt);
+  producer.reset();  // The body is empty.
+  client_remote->OnComplete(network::URLLoaderCompletionStatus(net::OK));
+}
+
+void StartLoading(scoped_refptr<DirectoryProtocol> protocol,
+                  const network::ResourceRequest& request,
+                  mojo::PendingReceiver<network::mojom::URLLoader> loader,
+                  mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  const DirectoryProtocolOptions& options = protocol->data;
+
+  if (request.method != net::HttpRequestHeaders::kGetMethod &&
+      request.method != net::HttpRequestHeaders::kHeadMethod) {
+    CompleteWithError(std::move(client), net::ERR_METHOD_NOT_SUPPORTED);
+    return;
+  }
+
+  base::FilePath relative_path;
+  if (!GetRelativePath(request.url, &relative_path)) {
+    CompleteWithError(std::move(client), net::ERR_INVALID_URL);
+    return;
+  }
+
+  ResolvedFile file;
+  if (!ResolveFile(options.root.Append(relative_path), &file)) {
+    CompleteWithError(std::move(client), net::ERR_FILE_NOT_FOUND);
+    return;
+  }
+
+  auto headers =
+      base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200 OK");
+  headers->AddHeader("ETag", file.etag);
+  headers->AddHeader("Last-Modified",
+                     base::TimeFormatHTTP(file.last_modified));
+  // Add header to ignore CORS, like the other protocol types.
+  headers->AddHeader("Access-Control-Allow-Origin", "*");
+
+  base::FilePath served_path;
+  options.root.AppendRelativePath(file.path, &served_path);
+  const std::string served_path_utf8 =
+      served_path.NormalizePathSeparatorsTo('/').AsUTF8Unsafe();
+  for (const auto& rule : options.header_rules) {
+    if (!rule.match.empty() &&
+        !base::MatchPattern(served_path_utf8, rule.match))
+      continue;
+    for (const auto& [name, value] : rule.headers)
+      headers->SetHeader(name, value);
+  }
+
+  if (IsNotModified(request.headers, file)) {
+    SendNotModified(std::move(client), std::move(headers));
+    return;
+  }
+
+  std::string extension = base::ToLowerASCII(file.path.FinalExtension());
+  if (!extension.empty()) {
+    auto it = options.mime_types.find(extension.substr(1));
+    if (it != options.mime_types.end()) {
+      mojo::PendingRemote<network::mojom::URLLoaderClient> proxy;
+      mojo::MakeSelfOwnedReceiver(
+          std::make_unique<MimeTypeOverridingClient>(std::move(client),
+                                                     it->second),
+          proxy.InitWithNewPipeAndPassReceiver());
+      client = std::move(proxy);
+    }
+  }
+
+  network::ResourceRequest file_request = request;
+  file_request.url = net::FilePathToFileURL(file.path);
+  asar::CreateAsarURLLoader(file_request, std::move(loader), std::move(client),
+                            std::move(headers));
+}
+
+}  // namespace
+
+DirectoryProtocolOptions::HeaderRule::HeaderRule() = default;
+DirectoryProtocolOptions::HeaderRule::~HeaderRule() = default;
+DirectoryProtocolOptions::HeaderRule::HeaderRule(const HeaderRule&) = default;
+DirectoryProtocolOptions::HeaderRule&
+DirectoryProtocolOptions::HeaderRule::operator=(const HeaderRule&) = default;
+
+DirectoryProtocolOptions::DirectoryProtocolOptions() = default;
+DirectoryProtocolOptions::~DirectoryProtocolOptions() = default;
+DirectoryProtocolOptions::DirectoryProtocolOptions(
+    const DirectoryProtocolOptions&) = default;
+DirectoryProtocolOptions& DirectoryProtocolOptions::operator=(
+    const DirectoryProtocolOptions&) = default;
+
+// static
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+DirectoryURLLoaderFactory::Create(scoped_refptr<DirectoryProtocol> protocol) {
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote;
+
+  // The DirectoryURLLoaderFactory will delete itself when there are no more
+  // receivers - see the SelfDeletingURLLoaderFactory::OnDisconnect method.
+  new DirectoryURLLoaderFactory(
+      std::move(protocol), pending_remote.InitWithNewPipeAndPassReceiver());
+
+  return pending_remote;
+}
+
+DirectoryURLLoaderFactory::DirectoryURLLoaderFactory(
+    scoped_refptr<DirectoryProtocol> protocol,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver)
+    : network::SelfDeletingURLLoaderFactory(std::move(factory_receiver)),
+      protocol_(std::move(protocol)) {}
+
+DirectoryURLLoaderFactory::~DirectoryURLLoaderFactory() = default;
+
+void DirectoryURLLoaderFactory::CreateLoaderAndStart(
+    mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    int32_t request_id,
+    uint32_t options,
+    const network::ResourceRequest& request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
+  // Files are looked up on a sequence of their own, which the client proxy
+  // overriding MIME types is bound to as well.
+  base::ThreadPool::CreateSequencedTaskRunner(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(&StartLoading, protocol_, request,
+                                std::move(loader), std::move(client)));
+}
+
+}  // namespace electron
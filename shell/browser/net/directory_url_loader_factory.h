@@ -0,0 +1,88 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
+#define ELECTRON_SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/network/public/cpp/self_deleting_url_loader_factory.h"
+
+namespace electron {
+
+// A protocol that serves the files of a directory without calling into JS.
+struct DirectoryProtocolOptions {
+  struct HeaderRule {
+    HeaderRule();
+    ~HeaderRule();
+    HeaderRule(const HeaderRule&);
+    HeaderRule& operator=(const HeaderRule&);
+
+    // Glob matched against the path of the served file relative to |root|,
+    // rules without one apply to every response.
+    std::string match;
+    std::vector<std::pair<std::string, std::string>> headers;
+  };
+
+  DirectoryProtocolOptions();
+  ~DirectoryProtocolOptions();
+  DirectoryProtocolOptions(const DirectoryProtocolOptions&);
+  DirectoryProtocolOptions& operator=(const DirectoryProtocolOptions&);
+
+  // May point into an asar archive.
+  base::FilePath root;
+  // Lowercase file extension without the dot => MIME type, taking precedence
+  // over the platform's.
+  std::map<std::string, std::string> mime_types;
+  std::vector<HeaderRule> header_rules;
+};
+
+using DirectoryProtocol = base::RefCountedData<DirectoryProtocolOptions>;
+
+// scheme => protocol.
+using DirectoryProtocolMap =
+    std::map<std::string, scoped_refptr<DirectoryProtocol>>;
+
+// Serves requests for a directory protocol on the thread pool, answering
+// conditional requests from the file's ETag and Last-Modified, and Range
+// requests through the asar URL loader.
+class DirectoryURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
+ public:
+  static mojo::PendingRemote<network::mojom::URLLoaderFactory> Create(
+      scoped_refptr<DirectoryProtocol> protocol);
+
+  // disable copy
+  DirectoryURLLoaderFactory(const DirectoryURLLoaderFactory&) = delete;
+  DirectoryURLLoaderFactory& operator=(const DirectoryURLLoaderFactory&) =
+      delete;
+
+ private:
+  DirectoryURLLoaderFactory(
+      scoped_refptr<DirectoryProtocol> protocol,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver);
+  ~DirectoryURLLoaderFactory() override;
+
+  // network::mojom::URLLoaderFactory:
+  void CreateLoaderAndStart(
+      mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      int32_t request_id,
+      uint32_t options,
+      const network::ResourceRequest& request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+      const net::MutableNetworkTrafficAnnotationTag& traffic_annotation)
+      override;
+
+  scoped_refptr<DirectoryProtocol> protocol_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_DIRECTORY_URL_LOADER_FACTORY_H_
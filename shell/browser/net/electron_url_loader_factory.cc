@@ -4,6 +4,8 @@
 
 #include "shell/browser/net/electron_url_loader_factory.h"
 
+#include <algorithm>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <string>
@@ -12,11 +14,11 @@
 #include "base/containers/fixed_flat_map.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/trace_event/trace_event.h"
 #include "base/uuid.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
-#include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/filename_util.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_status_code.h"
@@ -26,6 +28,7 @@
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/data_pipe_writer.h"
 #include "shell/browser/net/node_stream_loader.h"
 #include "shell/browser/net/url_pipe_loader.h"
 #include "shell/common/electron_constants.h"
@@ -161,20 +164,62 @@ network::mojom::URLResponseHeadPtr ToResponseHead(
 }
 
 // Helper to write string to pipe.
+// Serves a response body from a string or from the backing store of a JS
+// buffer, keeping either alive until the body was written.
+class ContentsDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  explicit ContentsDataSource(std::string data)
+      : data_(std::move(data)), contents_(data_) {}
+  ContentsDataSource(std::shared_ptr<v8::BackingStore> backing_store,
+                     size_t offset,
+                     size_t length)
+      : backing_store_(std::move(backing_store)),
+        contents_(static_cast<const char*>(backing_store_->Data()) + offset,
+                  length) {}
+  ~ContentsDataSource() override = default;
+
+  // disable copy
+  ContentsDataSource(const ContentsDataSource&) = delete;
+  ContentsDataSource& operator=(const ContentsDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return contents_.size(); }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset > contents_.size()) {
+      result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
+    }
+
+    const size_t read_size = static_cast<size_t>(
+        std::min<uint64_t>(buffer.size(), contents_.size() - offset));
+    memcpy(buffer.data(), contents_.data() + offset, read_size);
+    result.bytes_read = read_size;
+    return result;
+  }
+
+ private:
+  std::string data_;
+  std::shared_ptr<v8::BackingStore> backing_store_;
+  const base::StringPiece contents_;
+};
+
 struct WriteData {
   mojo::Remote<network::mojom::URLLoaderClient> client;
-  std::string data;
-  std::unique_ptr<mojo::DataPipeProducer> producer;
+  std::unique_ptr<DataPipeWriter> writer;
 };
 
 void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   network::URLLoaderCompletionStatus status(net::ERR_FAILED);
   if (result == MOJO_RESULT_OK) {
+    const uint64_t size = write_data->writer->GetStats().bytes_written;
     status = network::URLLoaderCompletionStatus(net::OK);
-    status.encoded_data_length = write_data->data.size();
-    status.encoded_body_length = write_data->data.size();
-    status.decoded_body_length = write_data->data.size();
+    status.encoded_data_length = size;
+    status.encoded_body_length = size;
+    status.decoded_body_length = size;
   }
+  write_data->writer->ReportStats("ElectronURLLoaderFactory");
   write_data->client->OnComplete(status);
 }
 
@@ -300,7 +345,8 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
       request,
       base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
                      request_id, options, request, std::move(client),
-                     traffic_annotation, std::move(target_factory), type_));
+                     traffic_annotation, std::move(target_factory), type_,
+                     BeginHandlerTrace(request)));
 }
 
 // static
@@ -315,6 +361,18 @@ void ElectronURLLoaderFactory::OnComplete(
   }
 }
 
+// static
+uint64_t ElectronURLLoaderFactory::BeginHandlerTrace(
+    const network::ResourceRequest& request) {
+  // Only used on the UI thread.
+  static uint64_t next_trace_id = 0;
+  const uint64_t trace_id = ++next_trace_id;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("electron", "ProtocolHandler",
+                                    TRACE_ID_LOCAL(trace_id), "scheme",
+                                    request.url.scheme());
+  return trace_id;
+}
+
 // static
 void ElectronURLLoaderFactory::StartLoading(
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
@@ -325,7 +383,12 @@ void ElectronURLLoaderFactory::StartLoading(
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation,
     mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory,
     ProtocolType type,
+    uint64_t trace_id,
     gin::Arguments* args) {
+  TRACE_EVENT_NESTABLE_ASYNC_END0("electron", "ProtocolHandler",
+                                  TRACE_ID_LOCAL(trace_id));
+  TRACE_EVENT1("electron", "ElectronURLLoaderFactory::StartLoading", "scheme",
+               request.url.scheme());
   // Send network error when there is no argument passed.
   //
   // Note that we should not throw JS error in the callback no matter what is
@@ -496,9 +559,12 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     v8::Local<v8::ArrayBufferView> buffer) {
+  // Stream the body straight out of the buffer's backing store, which may
+  // be many megabytes, rather than copying it on the UI thread first.
   SendContents(std::move(client), std::move(head),
-               std::string(node::Buffer::Data(buffer.As<v8::Value>()),
-                           node::Buffer::Length(buffer.As<v8::Value>())));
+               std::make_unique<ContentsDataSource>(
+                   buffer->Buffer()->GetBackingStore(), buffer->ByteOffset(),
+                   buffer->ByteLength()));
 }
 
 // static
@@ -624,6 +690,15 @@ void ElectronURLLoaderFactory::SendContents(
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     std::string data) {
+  SendContents(std::move(client), std::move(head),
+               std::make_unique<ContentsDataSource>(std::move(data)));
+}
+
+// static
+void ElectronURLLoaderFactory::SendContents(
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client,
+    network::mojom::URLResponseHeadPtr head,
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> source) {
   mojo::Remote<network::mojom::URLLoaderClient> client_remote(
       std::move(client));
 
@@ -631,9 +706,10 @@ void ElectronURLLoaderFactory::SendContents(
   head->headers->AddHeader("Access-Control-Allow-Origin", "*");
 
   // Code below follows the pattern of data_url_loader_factory.cc.
-  mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK) {
+  std::unique_ptr<DataPipeWriter> writer =
+      DataPipeWriter::Create(source->GetLength(), &consumer);
+  if (!writer) {
     client_remote->OnComplete(
         network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
     return;
@@ -644,17 +720,11 @@ void ElectronURLLoaderFactory::SendContents(
 
   auto write_data = std::make_unique<WriteData>();
   write_data->client = std::move(client_remote);
-  write_data->data = std::move(data);
-  write_data->producer =
-      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-  auto* producer_ptr = write_data->producer.get();
-
-  base::StringPiece string_piece(write_data->data);
-  producer_ptr->Write(
-      std::make_unique<mojo::StringDataSource>(
-          string_piece, mojo::StringDataSource::AsyncWritingMode::
-                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-      base::BindOnce(OnWrite, std::move(write_data)));
+  write_data->writer = std::move(writer);
+  auto* writer_ptr = write_data->writer.get();
+
+  writer_ptr->Write(std::move(source),
+                    base::BindOnce(OnWrite, std::move(write_data)));
 }
 
 }  // namespace electron
@@ -0,0 +1,170 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/host_resolution_tracker.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/strings/strcat.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "shell/browser/electron_browser_context.h"
+#include "shell/browser/net/connection_warming.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
+#include "url/url_util.h"
+
+namespace electron {
+
+namespace {
+
+// Most recently used first.
+const char kRecentHosts[] = "electron.host_resolver.recent_hosts";
+
+constexpr size_t kMaxRecentHosts = 32;
+
+// Bounds the memory of the hosts shared in a long running group.
+constexpr size_t kMaxSharedHosts = 256;
+
+std::map<std::string, std::set<HostResolutionTracker*>>& GetGroups() {
+  static base::NoDestructor<
+      std::map<std::string, std::set<HostResolutionTracker*>>>
+      groups;
+  return *groups;
+}
+
+}  // namespace
+
+// static
+void HostResolutionTracker::RegisterPrefs(PrefRegistrySimple* registry) {
+  registry->RegisterListPref(kRecentHosts);
+}
+
+HostResolutionTracker::HostResolutionTracker(
+    ElectronBrowserContext* browser_context)
+    : browser_context_(browser_context) {}
+
+HostResolutionTracker::~HostResolutionTracker() {
+  LeaveGroup();
+}
+
+void HostResolutionTracker::RecordResolution(const std::string& host,
+                                             bool success,
+                                             bool from_cache,
+                                             base::TimeDelta latency) {
+  TRACE_EVENT_INSTANT2("electron", "HostResolutionTracker::RecordResolution",
+                       TRACE_EVENT_SCOPE_THREAD, "from_cache", from_cache,
+                       "latency_us", latency.InMicroseconds());
+  ++metrics_.resolutions;
+  if (!success) {
+    ++metrics_.failures;
+    return;
+  }
+  if (from_cache)
+    ++metrics_.cache_hits;
+  metrics_.total_latency += latency;
+  metrics_.max_latency = std::max(metrics_.max_latency, latency);
+  RecordUse(host);
+}
+
+void HostResolutionTracker::RecordUse(const std::string& host) {
+  // There is nothing to resolve for IP addresses.
+  if (host.empty() || url::HostIsIPAddress(host))
+    return;
+  const base::Value::List& hosts =
+      browser_context_->prefs()->GetList(kRecentHosts);
+  if (!hosts.empty() && hosts.front() == host)
+    return;
+
+  ScopedListPrefUpdate update(browser_context_->prefs(), kRecentHosts);
+  update->EraseValue(base::Value(host));
+  update->Insert(update->begin(), base::Value(host));
+  if (update->size() > kMaxRecentHosts)
+    update->erase(update->begin() + kMaxRecentHosts, update->end());
+
+  if (group_.empty())
+    return;
+  for (HostResolutionTracker* member : GetGroups()[group_]) {
+    if (member != this)
+      member->WarmSharedHosts({host});
+  }
+}
+
+void HostResolutionTracker::WarmUp() {
+  std::vector<connection_warming::Target> targets;
+  for (const std::string& host : GetRecentHosts()) {
+    connection_warming::Target target;
+    target.url = GURL(base::StrCat({url::kHttpsScheme, "://", host}));
+    target.num_sockets = 0;
+    if (target.url.is_valid())
+      targets.push_back(std::move(target));
+  }
+  connection_warming::Warm(browser_context_, std::move(targets), false);
+}
+
+void HostResolutionTracker::SetGroup(const std::string& group) {
+  if (group == group_)
+    return;
+  LeaveGroup();
+  if (group.empty())
+    return;
+  group_ = group;
+  auto& members = GetGroups()[group_];
+  for (HostResolutionTracker* member : members)
+    WarmSharedHosts(member->GetRecentHosts());
+  members.insert(this);
+}
+
+void HostResolutionTracker::LeaveGroup() {
+  if (group_.empty())
+    return;
+  auto& groups = GetGroups();
+  auto it = groups.find(group_);
+  if (it != groups.end()) {
+    it->second.erase(this);
+    if (it->second.empty())
+      groups.erase(it);
+  }
+  group_.clear();
+  shared_hosts_.clear();
+}
+
+void HostResolutionTracker::WarmSharedHosts(
+    const std::vector<std::string>& hosts) {
+  if (shared_hosts_.size() > kMaxSharedHosts)
+    shared_hosts_.clear();
+  std::vector<connection_warming::Target> targets;
+  for (const std::string& host : hosts) {
+    if (!shared_hosts_.insert(host).second)
+      continue;
+    connection_warming::Target target;
+    target.url = GURL(base::StrCat({url::kHttpsScheme, "://", host}));
+    target.num_sockets = 0;
+    if (target.url.is_valid())
+      targets.push_back(std::move(target));
+  }
+  if (targets.empty())
+    return;
+  metrics_.shared_hosts += targets.size();
+  connection_warming::Warm(browser_context_, std::move(targets), false);
+}
+
+std::vector<std::string> HostResolutionTracker::GetRecentHosts() const {
+  std::vector<std::string> result;
+  for (const base::Value& host :
+       browser_context_->prefs()->GetList(kRecentHosts)) {
+    if (host.is_string())
+      result.push_back(host.GetString());
+  }
+  return result;
+}
+
+}  // namespace electron
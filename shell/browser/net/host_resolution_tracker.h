@@ -0,0 +1,86 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_HOST_RESOLUTION_TRACKER_H_
+#define ELECTRON_SHELL_BROWSER_NET_HOST_RESOLUTION_TRACKER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+
+class PrefRegistrySimple;
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Keeps the metrics of the host resolutions of a browser context and the
+// hosts it used most recently, which are persisted so that they can be
+// resolved again when the context is created after a restart.
+//
+// The trackers of the contexts in the same network group share the hosts
+// they use: each network context has its own host cache, so the hosts used
+// by one member are resolved in the others to warm their cache.
+class HostResolutionTracker {
+ public:
+  struct Metrics {
+    uint64_t resolutions = 0;
+    // Resolutions answered from the host cache, the hosts file or because
+    // the host was an IP address.
+    uint64_t cache_hits = 0;
+    uint64_t failures = 0;
+    base::TimeDelta total_latency;
+    base::TimeDelta max_latency;
+    // The hosts resolved because another member of the group used them.
+    uint64_t shared_hosts = 0;
+  };
+
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
+  explicit HostResolutionTracker(ElectronBrowserContext* browser_context);
+  ~HostResolutionTracker();
+
+  // disable copy
+  HostResolutionTracker(const HostResolutionTracker&) = delete;
+  HostResolutionTracker& operator=(const HostResolutionTracker&) = delete;
+
+  void RecordResolution(const std::string& host,
+                        bool success,
+                        bool from_cache,
+                        base::TimeDelta latency);
+
+  // Moves |host| to the front of the recently used hosts.
+  void RecordUse(const std::string& host);
+
+  // Resolves the recently used hosts, warming the host cache.
+  void WarmUp();
+
+  // Moves the context to |group|, or out of its group when empty. The
+  // hosts recently used by the other members are resolved when joining.
+  void SetGroup(const std::string& group);
+  const std::string& group() const { return group_; }
+
+  const Metrics& metrics() const { return metrics_; }
+  // Most recently used first.
+  std::vector<std::string> GetRecentHosts() const;
+
+ private:
+  void LeaveGroup();
+  // Resolves |hosts| used by another member of the group.
+  void WarmSharedHosts(const std::vector<std::string>& hosts);
+
+  raw_ptr<ElectronBrowserContext> browser_context_;
+  Metrics metrics_;
+  std::string group_;
+  // The hosts already resolved for the other members.
+  base::flat_set<std::string> shared_hosts_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_HOST_RESOLUTION_TRACKER_H_
@@ -0,0 +1,153 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/http_cache_entry_loader.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace electron {
+
+namespace {
+
+const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
+    net::DefineNetworkTrafficAnnotation("electron_http_cache", R"(
+        semantics {
+          sender: "Electron Session module"
+          description:
+            "Looks up or stores an entry of the HTTP cache on behalf of the "
+            "app."
+          trigger: "Using session.lookupCache() or session.storeCache()"
+          data: "None."
+          destination: OTHER
+        }
+        policy {
+          cookies_allowed: NO
+          setting: "This feature cannot be disabled."
+        })");
+
+}  // namespace
+
+HttpCacheEntryLoader::Entry::Entry() = default;
+HttpCacheEntryLoader::Entry::Entry(const Entry&) = default;
+HttpCacheEntryLoader::Entry& HttpCacheEntryLoader::Entry::operator=(
+    const Entry&) = default;
+HttpCacheEntryLoader::Entry::~Entry() = default;
+
+// static
+void HttpCacheEntryLoader::Lookup(
+    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    const GURL& url,
+    ResultCallback callback) {
+  // Owns itself until |callback| has run.
+  (new HttpCacheEntryLoader(std::move(factory), url, std::move(callback)))
+      ->StartLookup();
+}
+
+// static
+void HttpCacheEntryLoader::Store(
+    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    const GURL& url,
+    ResultCallback callback) {
+  (new HttpCacheEntryLoader(std::move(factory), url, std::move(callback)))
+      ->StartStore();
+}
+
+HttpCacheEntryLoader::HttpCacheEntryLoader(
+    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    const GURL& url,
+    ResultCallback callback)
+    : factory_(std::move(factory)), url_(url), callback_(std::move(callback)) {}
+
+HttpCacheEntryLoader::~HttpCacheEntryLoader() = default;
+
+std::unique_ptr<network::SimpleURLLoader> HttpCacheEntryLoader::CreateLoader(
+    int load_flags) {
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url_;
+  request->load_flags = load_flags;
+  // Same as net.request() without useSessionCookies, which the cache keys of
+  // its responses depend on.
+  request->credentials_mode = network::mojom::CredentialsMode::kInclude;
+  auto loader =
+      network::SimpleURLLoader::Create(std::move(request), kTrafficAnnotation);
+  loader->SetURLLoaderFactoryOptions(
+      network::mojom::kURLLoadOptionBlockAllCookies);
+  loader->SetAllowHttpErrorResults(true);
+  return loader;
+}
+
+void HttpCacheEntryLoader::StartLookup() {
+  entry_ = Entry();
+  loader_ = CreateLoader(net::LOAD_ONLY_FROM_CACHE |
+                         net::LOAD_SKIP_CACHE_VALIDATION);
+  // Unretained is safe as |loader_| is owned by |this|.
+  loader_->SetOnResponseStartedCallback(base::BindOnce(
+      &HttpCacheEntryLoader::OnResponseStarted, base::Unretained(this)));
+  loader_->DownloadHeadersOnly(
+      factory_.get(), base::BindOnce(&HttpCacheEntryLoader::OnHeaders,
+                                     base::Unretained(this)));
+}
+
+void HttpCacheEntryLoader::StartStore() {
+  loader_ = CreateLoader(net::LOAD_BYPASS_CACHE);
+  // The body has to be read for the cache to keep all of it.
+  loader_->DownloadAsStream(factory_.get(), this);
+}
+
+void HttpCacheEntryLoader::OnResponseStarted(
+    const GURL& final_url,
+    const network::mojom::URLResponseHead& response_head) {
+  entry_.url = final_url;
+  entry_.headers = response_head.headers;
+  entry_.mime_type = response_head.mime_type;
+  entry_.content_length = response_head.content_length;
+  entry_.response_time = response_head.response_time;
+}
+
+void HttpCacheEntryLoader::OnHeaders(
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  if (headers) {
+    Finish(std::move(entry_));
+    return;
+  }
+  const int error = loader_->NetError();
+  if (error == net::ERR_CACHE_MISS)
+    Finish(absl::nullopt);
+  else
+    Finish(base::unexpected(net::ErrorToString(error)));
+}
+
+void HttpCacheEntryLoader::OnDataReceived(base::StringPiece string_piece,
+                                          base::OnceClosure resume) {
+  std::move(resume).Run();
+}
+
+void HttpCacheEntryLoader::OnComplete(bool success) {
+  if (!success) {
+    Finish(base::unexpected(net::ErrorToString(loader_->NetError())));
+    return;
+  }
+  StartLookup();
+}
+
+void HttpCacheEntryLoader::OnRetry(base::OnceClosure start_retry) {}
+
+void HttpCacheEntryLoader::Finish(Result result) {
+  loader_.reset();
+  std::move(callback_).Run(std::move(result));
+  delete this;
+}
+
+}  // namespace electron
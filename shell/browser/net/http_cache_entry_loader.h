@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_HTTP_CACHE_ENTRY_LOADER_H_
+#define ELECTRON_SHELL_BROWSER_NET_HTTP_CACHE_ENTRY_LOADER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
+#include "base/time/time.h"
+#include "base/types/expected.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpResponseHeaders;
+}
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace network::mojom {
+class URLResponseHead;
+}
+
+namespace electron {
+
+// Reads and fills entries of the HTTP cache through a URL loader factory, the
+// same way net.request() does with its default options, so that the entries
+// are the ones net.request() would use.
+//
+// The network service offers no direct access to the cache, so a lookup is a
+// request which may only be served from the cache, and storing an entry is a
+// request which bypasses it.
+class HttpCacheEntryLoader : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  struct Entry {
+    Entry();
+    Entry(const Entry&);
+    Entry& operator=(const Entry&);
+    ~Entry();
+
+    GURL url;
+    scoped_refptr<net::HttpResponseHeaders> headers;
+    std::string mime_type;
+    // -1 if unknown.
+    int64_t content_length = -1;
+    // When the cached response was received from the server.
+    base::Time response_time;
+  };
+
+  // The entry, absl::nullopt if there is none, or the reason the cache could
+  // not be read.
+  using Result = base::expected<absl::optional<Entry>, std::string>;
+  using ResultCallback = base::OnceCallback<void(Result)>;
+
+  // Looks up the entry of |url| without going to the network.
+  static void Lookup(scoped_refptr<network::SharedURLLoaderFactory> factory,
+                     const GURL& url,
+                     ResultCallback callback);
+
+  // Fetches |url| from the network, which replaces its entry if the response
+  // may be cached, and then looks the entry up.
+  static void Store(scoped_refptr<network::SharedURLLoaderFactory> factory,
+                    const GURL& url,
+                    ResultCallback callback);
+
+  ~HttpCacheEntryLoader() override;
+
+  // disable copy
+  HttpCacheEntryLoader(const HttpCacheEntryLoader&) = delete;
+  HttpCacheEntryLoader& operator=(const HttpCacheEntryLoader&) = delete;
+
+ private:
+  HttpCacheEntryLoader(scoped_refptr<network::SharedURLLoaderFactory> factory,
+                       const GURL& url,
+                       ResultCallback callback);
+
+  std::unique_ptr<network::SimpleURLLoader> CreateLoader(int load_flags);
+  void StartLookup();
+  void StartStore();
+
+  void OnResponseStarted(const GURL& final_url,
+                         const network::mojom::URLResponseHead& response_head);
+  void OnHeaders(scoped_refptr<net::HttpResponseHeaders> headers);
+
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override;
+  void OnComplete(bool success) override;
+  void OnRetry(base::OnceClosure start_retry) override;
+
+  // Deletes |this|.
+  void Finish(Result result);
+
+  scoped_refptr<network::SharedURLLoaderFactory> factory_;
+  const GURL url_;
+  ResultCallback callback_;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  Entry entry_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_HTTP_CACHE_ENTRY_LOADER_H_
@@ -6,8 +6,11 @@
 
 #include <utility>
 
+#include "base/functional/bind.h"
 #include "chrome/browser/browser_features.h"
 #include "chrome/common/chrome_constants.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/shared_cors_origin_access_list.h"
 #include "electron/fuses.h"
@@ -17,6 +20,8 @@
 #include "services/network/public/cpp/cors/origin_access_list.h"
 #include "shell/browser/browser_process_impl.h"
 #include "shell/browser/electron_browser_client.h"
+#include "shell/browser/net/connection_warming.h"
+#include "shell/browser/net/host_resolution_tracker.h"
 #include "shell/browser/net/system_network_context_manager.h"
 
 namespace electron {
@@ -34,6 +39,13 @@ bool ShouldTriggerNetworkDataMigration() {
   return false;
 }
 
+void WarmUp(base::WeakPtr<ElectronBrowserContext> browser_context) {
+  if (!browser_context)
+    return;
+  connection_warming::WarmPersistedTargets(browser_context);
+  browser_context->GetHostResolutionTracker()->WarmUp();
+}
+
 }  // namespace
 
 NetworkContextService::NetworkContextService(content::BrowserContext* context)
@@ -115,6 +127,12 @@ void NetworkContextService::ConfigureNetworkContextParams(
 
     network_context_params->file_paths->transport_security_persister_file_name =
         base::FilePath(chrome::kTransportSecurityPersisterFilename);
+
+    // Along with the alternative services and QUIC server info kept in
+    // HttpServerProperties, this lets the first requests after a restart skip
+    // the handshakes. The network context only exists once this returns.
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(&WarmUp, browser_context_->GetWeakPtr()));
   }
 
   proxy_config_monitor_.AddToNetworkContextParams(network_context_params);
@@ -49,15 +49,13 @@ NodeStreamLoader::~NodeStreamLoader() {
 }
 
 void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
-  mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
-  if (rv != MOJO_RESULT_OK) {
+  writer_ = DataPipeWriter::Create(0, &consumer);
+  if (!writer_) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
   }
 
-  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
   client_->OnReceiveResponse(std::move(head), std::move(consumer),
                              absl::nullopt);
 
@@ -79,7 +77,7 @@ void NodeStreamLoader::NotifyReadable() {
 
 void NodeStreamLoader::NotifyComplete(int result) {
   // Wait until write finishes or fails.
-  if (is_reading_ || is_writing_) {
+  if (is_reading_ || (writer_ && writer_->is_writing())) {
     ended_ = true;
     result_ = result;
     return;
@@ -87,7 +85,10 @@ void NodeStreamLoader::NotifyComplete(int result) {
 
   network::URLLoaderCompletionStatus status(result);
   status.completion_time = base::TimeTicks::Now();
-  status.decoded_body_length = bytes_written_;
+  if (writer_) {
+    status.decoded_body_length = writer_->GetStats().bytes_written;
+    writer_->ReportStats("NodeStreamLoader");
+  }
   client_->OnComplete(status);
   delete this;
 }
@@ -129,21 +130,17 @@ void NodeStreamLoader::ReadMore() {
   // Hold the buffer until the write is done.
   buffer_.Reset(isolate_, buffer);
 
-  bytes_written_ += node::Buffer::Length(buffer);
-
   // Write buffer to mojo pipe asynchronously.
   is_reading_ = false;
-  is_writing_ = true;
-  producer_->Write(std::make_unique<mojo::StringDataSource>(
-                       base::StringPiece(node::Buffer::Data(buffer),
-                                         node::Buffer::Length(buffer)),
-                       mojo::StringDataSource::AsyncWritingMode::
-                           STRING_STAYS_VALID_UNTIL_COMPLETION),
-                   base::BindOnce(&NodeStreamLoader::DidWrite, weak));
+  writer_->Write(std::make_unique<mojo::StringDataSource>(
+                     base::StringPiece(node::Buffer::Data(buffer),
+                                       node::Buffer::Length(buffer)),
+                     mojo::StringDataSource::AsyncWritingMode::
+                         STRING_STAYS_VALID_UNTIL_COMPLETION),
+                 base::BindOnce(&NodeStreamLoader::DidWrite, weak));
 }
 
 void NodeStreamLoader::DidWrite(MojoResult result) {
-  is_writing_ = false;
   // We were told to end streaming.
   if (ended_) {
     NotifyComplete(result_);
@@ -14,9 +14,9 @@
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/data_pipe_writer.h"
 #include "v8/include/v8.h"
 
 namespace electron {
@@ -74,16 +74,11 @@ class NodeStreamLoader : public network::mojom::URLLoader {
   v8::Global<v8::Value> buffer_;
 
   // Mojo data pipe where the data that is being read is written to.
-  std::unique_ptr<mojo::DataPipeProducer> producer_;
-
-  // Whether we are in the middle of write.
-  bool is_writing_ = false;
+  std::unique_ptr<DataPipeWriter> writer_;
 
   // Whether we are in the middle of a stream.read().
   bool is_reading_ = false;
 
-  size_t bytes_written_ = 0;
-
   // When NotifyComplete is called while writing, we will save the result and
   // quit with it after the write is done.
   bool ended_ = false;
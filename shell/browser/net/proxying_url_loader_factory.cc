@@ -25,6 +25,7 @@
 #include "services/network/public/cpp/features.h"
 #include "services/network/public/mojom/early_hints.mojom.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/response_body_tap.h"
 #include "shell/common/options_switches.h"
 #include "url/origin.h"
 
@@ -666,6 +667,11 @@ void ProxyingURLLoaderFactory::InProgressRequest::ContinueToResponseStarted(
   proxied_client_receiver_.Resume();
 
   factory_->web_request_api()->OnResponseStarted(&info_.value(), request_);
+  if (auto callback = factory_->web_request_api()->GetResponseBodyCallback(
+          &info_.value(), request_)) {
+    current_body_ =
+        ResponseBodyTap::Start(std::move(current_body_), std::move(callback));
+  }
   target_client_->OnReceiveResponse(current_response_.Clone(),
                                     std::move(current_body_),
                                     std::move(current_cached_metadata_));
@@ -820,7 +826,8 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
           base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
                          std::move(loader), request_id, options, request,
                          std::move(client), traffic_annotation,
-                         std::move(loader_remote), it->second.first));
+                         std::move(loader_remote), it->second.first,
+                         ElectronURLLoaderFactory::BeginHandlerTrace(request)));
       return;
     }
   }
@@ -836,7 +843,8 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
-  if (!web_request_api()->HasListener()) {
+  if (!web_request_api()->HasListener() ||
+      !web_request_api()->ShouldProxyRequest(request)) {
     // Pass-through to the original factory.
     target_factory_->CreateLoaderAndStart(std::move(loader), request_id,
                                           options, request, std::move(client),
@@ -14,8 +14,10 @@
 #include "net/base/host_port_pair.h"
 #include "net/base/net_errors.h"
 #include "net/base/network_isolation_key.h"
+#include "net/dns/public/host_resolver_source.h"
 #include "net/dns/public/resolve_error_info.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/browser/net/host_resolution_tracker.h"
 #include "url/origin.h"
 
 using content::BrowserThread;
@@ -28,6 +30,7 @@ ResolveHostFunction::ResolveHostFunction(
     network::mojom::ResolveHostParametersPtr params,
     ResolveHostCallback callback)
     : browser_context_(browser_context),
+      weak_browser_context_(browser_context->GetWeakPtr()),
       host_(std::move(host)),
       params_(std::move(params)),
       callback_(std::move(callback)) {}
@@ -41,6 +44,28 @@ void ResolveHostFunction::Run() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(!receiver_.is_bound());
 
+  start_time_ = base::TimeTicks::Now();
+  // Unless the caller chose where to resolve from, ask the cache first. The
+  // result doesn't tell whether it came from the cache otherwise, and a
+  // second round trip to the network service only costs a cache miss a
+  // little time.
+  probing_cache_ =
+      !params_ ||
+      (params_->source == net::HostResolverSource::ANY &&
+       params_->cache_usage ==
+           network::mojom::ResolveHostParameters::CacheUsage::ALLOWED);
+  if (!probing_cache_) {
+    Start(std::move(params_));
+    return;
+  }
+  auto params = params_ ? params_.Clone()
+                        : network::mojom::ResolveHostParameters::New();
+  params->source = net::HostResolverSource::LOCAL_ONLY;
+  Start(std::move(params));
+}
+
+void ResolveHostFunction::Start(
+    network::mojom::ResolveHostParametersPtr params) {
   // Start the request.
   net::HostPortPair host_port_pair(host_, 0);
   mojo::PendingRemote<network::mojom::ResolveHostClient> resolve_host_client =
@@ -54,7 +79,7 @@ void ResolveHostFunction::Run() {
       ->GetNetworkContext()
       ->ResolveHost(network::mojom::HostResolverHost::NewHostPortPair(
                         std::move(host_port_pair)),
-                    net::NetworkAnonymizationKey(), std::move(params_),
+                    net::NetworkAnonymizationKey(), std::move(params),
                     std::move(resolve_host_client));
 }
 
@@ -71,6 +96,20 @@ void ResolveHostFunction::OnComplete(
 
   receiver_.reset();
 
+  const bool from_cache = probing_cache_;
+  if (probing_cache_) {
+    probing_cache_ = false;
+    if (resolve_error_info.error == net::ERR_DNS_CACHE_MISS) {
+      Start(std::move(params_));
+      return;
+    }
+  }
+
+  if (weak_browser_context_) {
+    weak_browser_context_->GetHostResolutionTracker()->RecordResolution(
+        host_, resolve_error_info.error == net::OK, from_cache,
+        base::TimeTicks::Now() - start_time_);
+  }
   std::move(callback_).Run(resolve_error_info.error, resolved_addresses);
 }
 
@@ -9,6 +9,8 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "net/base/address_list.h"
 #include "net/dns/public/host_resolver_results.h"
@@ -46,6 +48,8 @@ class ResolveHostFunction
  private:
   friend class base::RefCountedThreadSafe<ResolveHostFunction>;
 
+  void Start(network::mojom::ResolveHostParametersPtr params);
+
   // network::mojom::ResolveHostClient implementation
   void OnComplete(int result,
                   const net::ResolveErrorInfo& resolve_error_info,
@@ -58,9 +62,17 @@ class ResolveHostFunction
 
   // Weak Ref
   raw_ptr<ElectronBrowserContext> browser_context_;
+  // For recording the resolution, the network context may outlive the
+  // browser context.
+  base::WeakPtr<ElectronBrowserContext> weak_browser_context_;
   std::string host_;
   network::mojom::ResolveHostParametersPtr params_;
   ResolveHostCallback callback_;
+
+  base::TimeTicks start_time_;
+  // Whether the current request only asks the host cache, to find out if the
+  // host needs to be resolved at all.
+  bool probing_cache_ = false;
 };
 
 }  // namespace electron
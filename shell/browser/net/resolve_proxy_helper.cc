@@ -6,10 +6,12 @@
 
 #include <utility>
 
+#include "base/containers/cxx20_erase_map.h"
 #include "base/functional/bind.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/base/net_errors.h"
 #include "net/base/network_anonymization_key.h"
 #include "net/proxy_resolution/proxy_info.h"
 #include "services/network/public/mojom/network_context.mojom.h"
@@ -19,45 +21,76 @@ using content::BrowserThread;
 
 namespace electron {
 
+namespace {
+
+// Bounds how long a result can be stale when the proxy config changes in a
+// way the prefs don't reflect, e.g. the system settings or a PAC script
+// which depends on the time of day.
+constexpr base::TimeDelta kCacheTTL = base::Seconds(30);
+
+constexpr size_t kMaxCacheSize = 256;
+
+}  // namespace
+
 ResolveProxyHelper::ResolveProxyHelper(ElectronBrowserContext* browser_context)
-    : browser_context_(browser_context) {}
+    : browser_context_(browser_context) {
+  receivers_.set_disconnect_handler(base::BindRepeating(
+      &ResolveProxyHelper::OnLookupDisconnected, base::Unretained(this)));
+}
 
 ResolveProxyHelper::~ResolveProxyHelper() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(!owned_self_);
-  DCHECK(!receiver_.is_bound());
+  DCHECK(receivers_.empty());
   // Clear all pending requests if the ProxyService is still alive.
-  pending_requests_.clear();
+  pending_lookups_.clear();
 }
 
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       ResolveProxyCallback callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  // Enqueue the pending request.
-  pending_requests_.emplace_back(url, std::move(callback));
+  const url::Origin origin = url::Origin::Create(url);
+
+  auto cached = cache_.find(origin);
+  if (cached != cache_.end()) {
+    if (cached->second.expiry > base::TimeTicks::Now()) {
+      std::move(callback).Run(cached->second.proxy);
+      return;
+    }
+    cache_.erase(cached);
+  }
 
-  // If nothing is in progress, start.
-  if (!receiver_.is_bound()) {
-    DCHECK_EQ(1u, pending_requests_.size());
-    StartPendingRequest();
+  // Opaque origins are never equal to each other, so every request for one
+  // gets a lookup of its own.
+  PendingLookup& lookup = pending_lookups_[origin];
+  lookup.callbacks.push_back(std::move(callback));
+  if (lookup.callbacks.size() == 1) {
+    lookup.cache_generation = cache_generation_;
+    StartLookup(url, origin);
   }
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
+void ResolveProxyHelper::ClearCache() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!receiver_.is_bound());
-  DCHECK(!pending_requests_.empty());
-
-  // Start the request.
-  mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
-      receiver_.BindNewPipeAndPassRemote();
-  receiver_.set_disconnect_handler(
-      base::BindOnce(&ResolveProxyHelper::OnProxyLookupComplete,
-                     base::Unretained(this), net::ERR_ABORTED, absl::nullopt));
+  // Lookups in progress may still report the old config, which is what
+  // resolving before the change would have returned too, but they aren't
+  // cached.
+  cache_.clear();
+  ++cache_generation_;
+}
+
+void ResolveProxyHelper::StartLookup(const GURL& url,
+                                     const url::Origin& origin) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!owned_self_)
+    owned_self_ = this;
+
+  mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client;
+  receivers_.Add(this, proxy_lookup_client.InitWithNewPipeAndPassReceiver(),
+                 origin);
   browser_context_->GetDefaultStoragePartition()
       ->GetNetworkContext()
-      ->LookUpProxyForURL(pending_requests_.front().url,
-                          net::NetworkAnonymizationKey(),
+      ->LookUpProxyForURL(url, net::NetworkAnonymizationKey(),
                           std::move(proxy_lookup_client));
 }
 
@@ -65,38 +98,65 @@ void ResolveProxyHelper::OnProxyLookupComplete(
     int32_t net_error,
     const absl::optional<net::ProxyInfo>& proxy_info) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!pending_requests_.empty());
-
-  receiver_.reset();
-
-  // Clear the current (completed) request.
-  PendingRequest completed_request = std::move(pending_requests_.front());
-  pending_requests_.pop_front();
+  const url::Origin origin = receivers_.current_context();
+  receivers_.Remove(receivers_.current_receiver());
 
   std::string proxy;
   if (proxy_info)
     proxy = proxy_info->ToPacString();
+  CompleteLookup(origin, net_error, proxy);
+}
 
-  if (!completed_request.callback.is_null())
-    std::move(completed_request.callback).Run(proxy);
+void ResolveProxyHelper::OnLookupDisconnected() {
+  // The receiver has already been removed from |receivers_|.
+  CompleteLookup(receivers_.current_context(), net::ERR_ABORTED,
+                 std::string());
+}
 
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+void ResolveProxyHelper::CompleteLookup(const url::Origin& origin,
+                                        int32_t net_error,
+                                        const std::string& proxy) {
+  // Keeps |this| alive until the callbacks have run, even when it was the
+  // last lookup.
+  scoped_refptr<ResolveProxyHelper> self = std::move(owned_self_);
+  if (!receivers_.empty())
+    owned_self_ = self;
+
+  PendingLookup lookup;
+  auto pending = pending_lookups_.find(origin);
+  if (pending != pending_lookups_.end()) {
+    lookup = std::move(pending->second);
+    pending_lookups_.erase(pending);
+  }
+
+  if (net_error == net::OK && !origin.opaque() &&
+      lookup.cache_generation == cache_generation_) {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (cache_.size() >= kMaxCacheSize) {
+      base::EraseIf(cache_, [now](const auto& entry) {
+        return entry.second.expiry <= now;
+      });
+      if (cache_.size() >= kMaxCacheSize)
+        cache_.clear();
+    }
+    cache_[origin] = {proxy, now + kCacheTTL};
+  }
+
+  for (auto& callback : lookup.callbacks) {
+    if (!callback.is_null())
+      std::move(callback).Run(proxy);
+  }
 }
 
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    const GURL& url,
-    ResolveProxyCallback callback)
-    : url(url), callback(std::move(callback)) {}
+ResolveProxyHelper::PendingLookup::PendingLookup() = default;
 
-ResolveProxyHelper::PendingRequest::PendingRequest(
-    ResolveProxyHelper::PendingRequest&& pending_request) noexcept = default;
+ResolveProxyHelper::PendingLookup::PendingLookup(
+    ResolveProxyHelper::PendingLookup&&) noexcept = default;
 
-ResolveProxyHelper::PendingRequest::~PendingRequest() noexcept = default;
+ResolveProxyHelper::PendingLookup::~PendingLookup() = default;
 
-ResolveProxyHelper::PendingRequest&
-ResolveProxyHelper::PendingRequest::operator=(
-    ResolveProxyHelper::PendingRequest&& pending_request) noexcept = default;
+ResolveProxyHelper::PendingLookup&
+ResolveProxyHelper::PendingLookup::operator=(
+    ResolveProxyHelper::PendingLookup&&) noexcept = default;
 
 }  // namespace electron
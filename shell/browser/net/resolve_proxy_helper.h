@@ -5,15 +5,19 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 #define ELECTRON_SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
-#include <deque>
+#include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
-#include "mojo/public/cpp/bindings/receiver.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "services/network/public/mojom/proxy_lookup_client.mojom.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
+#include "url/origin.h"
 
 namespace electron {
 
@@ -27,8 +31,14 @@ class ResolveProxyHelper
 
   explicit ResolveProxyHelper(ElectronBrowserContext* browser_context);
 
+  // Results are cached per origin for a short time, so a PAC script which
+  // returns different proxies for the paths of an origin is only asked for
+  // the first of them.
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
 
+  // Forgets the cached results, called when the proxy config changes.
+  void ClearCache();
+
   // disable copy
   ResolveProxyHelper(const ResolveProxyHelper&) = delete;
   ResolveProxyHelper& operator=(const ResolveProxyHelper&) = delete;
@@ -38,37 +48,55 @@ class ResolveProxyHelper
 
  private:
   friend class base::RefCountedThreadSafe<ResolveProxyHelper>;
-  // A PendingRequest is a resolve request that is in progress, or queued.
-  struct PendingRequest {
-   public:
-    PendingRequest(const GURL& url, ResolveProxyCallback callback);
-    PendingRequest(PendingRequest&& pending_request) noexcept;
-    ~PendingRequest();
+
+  struct CachedResult {
+    std::string proxy;
+    base::TimeTicks expiry;
+  };
+
+  // A PendingLookup holds the requests waiting for the lookup of an origin.
+  struct PendingLookup {
+    PendingLookup();
+    PendingLookup(PendingLookup&&) noexcept;
+    ~PendingLookup();
 
     // disable copy
-    PendingRequest(const PendingRequest&) = delete;
-    PendingRequest& operator=(const PendingRequest&) = delete;
+    PendingLookup(const PendingLookup&) = delete;
+    PendingLookup& operator=(const PendingLookup&) = delete;
 
-    PendingRequest& operator=(PendingRequest&& pending_request) noexcept;
+    PendingLookup& operator=(PendingLookup&&) noexcept;
 
-    GURL url;
-    ResolveProxyCallback callback;
+    std::vector<ResolveProxyCallback> callbacks;
+    // The result is only cached if the cache wasn't cleared since the lookup
+    // started.
+    uint64_t cache_generation = 0;
   };
 
-  // Starts the first pending request.
-  void StartPendingRequest();
+  // Starts a lookup for |url| on behalf of the requests for |origin|.
+  void StartLookup(const GURL& url, const url::Origin& origin);
 
   // network::mojom::ProxyLookupClient implementation.
   void OnProxyLookupComplete(
       int32_t net_error,
       const absl::optional<net::ProxyInfo>& proxy_info) override;
 
+  void OnLookupDisconnected();
+  void CompleteLookup(const url::Origin& origin,
+                      int32_t net_error,
+                      const std::string& proxy);
+
   // Self-reference. Owned as long as there's an outstanding proxy lookup.
   scoped_refptr<ResolveProxyHelper> owned_self_;
 
-  std::deque<PendingRequest> pending_requests_;
-  // Receiver for the currently in-progress request, if any.
-  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+  // Requests for an origin which is already being looked up share its
+  // result.
+  std::map<url::Origin, PendingLookup> pending_lookups_;
+  // Receivers for the in-progress lookups, which run concurrently.
+  mojo::ReceiverSet<network::mojom::ProxyLookupClient, url::Origin>
+      receivers_;
+
+  std::map<url::Origin, CachedResult> cache_;
+  uint64_t cache_generation_ = 0;
 
   // Weak Ref
   raw_ptr<ElectronBrowserContext> browser_context_;
@@ -0,0 +1,150 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/response_body_tap.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
+
+namespace electron {
+
+namespace {
+
+// Same as the network service's pipes for response bodies.
+constexpr uint32_t kPipeCapacity = 512 * 1024;
+
+}  // namespace
+
+// static
+mojo::ScopedDataPipeConsumerHandle ResponseBodyTap::Start(
+    mojo::ScopedDataPipeConsumerHandle body,
+    ResultCallback callback) {
+  if (!body)
+    return body;
+
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = kPipeCapacity;
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(&options, producer, consumer) != MOJO_RESULT_OK)
+    return body;
+
+  base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(
+                     [](mojo::ScopedDataPipeConsumerHandle source,
+                        mojo::ScopedDataPipeProducerHandle destination,
+                        ResultCallback callback) {
+                       // Owns itself until the body is passed on.
+                       (new ResponseBodyTap(std::move(source),
+                                            std::move(destination),
+                                            std::move(callback)))
+                           ->Pump();
+                     },
+                     std::move(body), std::move(producer),
+                     base::BindPostTask(
+                         base::SequencedTaskRunner::GetCurrentDefault(),
+                         std::move(callback))));
+  return consumer;
+}
+
+ResponseBodyTap::ResponseBodyTap(mojo::ScopedDataPipeConsumerHandle source,
+                                 mojo::ScopedDataPipeProducerHandle destination,
+                                 ResultCallback callback)
+    : source_(std::move(source)),
+      destination_(std::move(destination)),
+      source_watcher_(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL),
+      destination_watcher_(FROM_HERE,
+                           mojo::SimpleWatcher::ArmingPolicy::MANUAL),
+      callback_(std::move(callback)),
+      hash_(crypto::SecureHash::Create(crypto::SecureHash::SHA256)) {
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0("electron", "ResponseBodyTap",
+                                    TRACE_ID_LOCAL(this));
+  // Unretained is safe as the watchers are owned by |this|.
+  source_watcher_.Watch(
+      source_.get(),
+      MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+      base::BindRepeating(&ResponseBodyTap::OnHandleReady,
+                          base::Unretained(this)));
+  destination_watcher_.Watch(
+      destination_.get(),
+      MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+      base::BindRepeating(&ResponseBodyTap::OnHandleReady,
+                          base::Unretained(this)));
+}
+
+ResponseBodyTap::~ResponseBodyTap() {
+  TRACE_EVENT_NESTABLE_ASYNC_END1("electron", "ResponseBodyTap",
+                                  TRACE_ID_LOCAL(this), "byte_length",
+                                  byte_length_);
+}
+
+void ResponseBodyTap::OnHandleReady(MojoResult result) {
+  // Errors show up as results of reading or writing.
+  Pump();
+}
+
+void ResponseBodyTap::Pump() {
+  while (true) {
+    const void* buffer = nullptr;
+    uint32_t available = 0;
+    MojoResult result =
+        source_->BeginReadData(&buffer, &available, MOJO_READ_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_SHOULD_WAIT) {
+      source_watcher_.ArmOrNotify();
+      return;
+    }
+    if (result != MOJO_RESULT_OK) {
+      // The producer closed the pipe, after all of the body unless the
+      // request failed.
+      Finish(result == MOJO_RESULT_FAILED_PRECONDITION);
+      return;
+    }
+
+    // Only as much as fits, the client decides how fast the body flows.
+    uint32_t written = available;
+    result = destination_->WriteData(buffer, &written,
+                                     MOJO_WRITE_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_SHOULD_WAIT) {
+      source_->EndReadData(0);
+      destination_watcher_.ArmOrNotify();
+      return;
+    }
+    if (result != MOJO_RESULT_OK) {
+      source_->EndReadData(0);
+      Finish(false);
+      return;
+    }
+    hash_->Update(buffer, written);
+    byte_length_ += written;
+    source_->EndReadData(written);
+  }
+}
+
+void ResponseBodyTap::Finish(bool complete) {
+  if (complete) {
+    uint8_t digest[crypto::kSHA256Length];
+    hash_->Finish(digest, sizeof(digest));
+    std::move(callback_).Run(
+        {byte_length_,
+         base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)))});
+  }
+  delete this;
+}
+
+}  // namespace electron
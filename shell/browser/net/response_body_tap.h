@@ -0,0 +1,76 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_TAP_H_
+#define ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_TAP_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/functional/callback.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+
+namespace crypto {
+class SecureHash;
+}
+
+namespace electron {
+
+// Passes a response body on to the client of the request through another
+// data pipe, and counts and hashes the bytes on the way.
+//
+// The body is copied on a thread pool sequence, a pipe-sized chunk at a time,
+// and only as fast as the client reads it, so the memory used stays bounded
+// by the pipes no matter how large the body is.
+class ResponseBodyTap {
+ public:
+  struct Result {
+    uint64_t byte_length = 0;
+    // Lowercase hex.
+    std::string sha256;
+  };
+
+  using ResultCallback = base::OnceCallback<void(const Result&)>;
+
+  // Returns the pipe to give the client instead of |body|. |callback| runs on
+  // the calling sequence once the body's pipe was closed and everything in it
+  // was passed on, which is all of the body unless the request failed. It
+  // doesn't run if the client stops reading. Returns |body| itself if another
+  // pipe could not be created.
+  static mojo::ScopedDataPipeConsumerHandle Start(
+      mojo::ScopedDataPipeConsumerHandle body,
+      ResultCallback callback);
+
+  ~ResponseBodyTap();
+
+  // disable copy
+  ResponseBodyTap(const ResponseBodyTap&) = delete;
+  ResponseBodyTap& operator=(const ResponseBodyTap&) = delete;
+
+ private:
+  ResponseBodyTap(mojo::ScopedDataPipeConsumerHandle source,
+                  mojo::ScopedDataPipeProducerHandle destination,
+                  ResultCallback callback);
+
+  void OnHandleReady(MojoResult result);
+  // Copies until either pipe has to be waited for.
+  void Pump();
+  // Deletes |this|.
+  void Finish(bool complete);
+
+  mojo::ScopedDataPipeConsumerHandle source_;
+  mojo::ScopedDataPipeProducerHandle destination_;
+  mojo::SimpleWatcher source_watcher_;
+  mojo::SimpleWatcher destination_watcher_;
+
+  ResultCallback callback_;
+  std::unique_ptr<crypto::SecureHash> hash_;
+  uint64_t byte_length_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_TAP_H_
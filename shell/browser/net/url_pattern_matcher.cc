@@ -0,0 +1,126 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/url_pattern_matcher.h"
+
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include "base/ranges/algorithm.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+namespace {
+
+using IndexBuilder = std::map<std::string, std::vector<size_t>, std::less<>>;
+
+// Same as URLPattern, which ignores a trailing dot of both hosts.
+base::StringPiece CanonicalizeHost(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+// The part of the path every URL matching |pattern| starts with.
+std::string GetPathPrefix(const URLPattern& pattern) {
+  const std::string& path = pattern.path();
+  size_t wildcard = path.find('*');
+  if (wildcard == std::string::npos)
+    return path;
+  // "/foo/*" matches "/foo" as well.
+  if (wildcard > 0 && path[wildcard - 1] == '/')
+    --wildcard;
+  return path.substr(0, wildcard);
+}
+
+}  // namespace
+
+URLPatternMatcher::URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(const std::set<URLPattern>& patterns)
+    : patterns_(patterns.begin(), patterns.end()) {
+  IndexBuilder by_host, by_domain, by_path_prefix;
+  for (size_t i = 0; i < patterns_.size(); ++i) {
+    const URLPattern& pattern = patterns_[i];
+    const std::string host(CanonicalizeHost(pattern.host()));
+    if (pattern.match_all_urls() ||
+        (pattern.match_subdomains() && host.empty())) {
+      by_path_prefix[GetPathPrefix(pattern)].push_back(i);
+    } else if (pattern.match_subdomains()) {
+      by_domain[host].push_back(i);
+    } else {
+      by_host[host].push_back(i);
+    }
+  }
+
+  // Building the flat_maps at once is linear, inserting into them isn't.
+  auto to_index = [](IndexBuilder builder) {
+    return Index(base::sorted_unique, std::make_move_iterator(builder.begin()),
+                 std::make_move_iterator(builder.end()));
+  };
+  by_host_ = to_index(std::move(by_host));
+  by_domain_ = to_index(std::move(by_domain));
+  by_path_prefix_ = to_index(std::move(by_path_prefix));
+
+  for (const auto& [prefix, indices] : by_path_prefix_)
+    path_prefix_lengths_.push_back(prefix.size());
+  base::ranges::sort(path_prefix_lengths_);
+  path_prefix_lengths_.erase(base::ranges::unique(path_prefix_lengths_),
+                             path_prefix_lengths_.end());
+}
+
+URLPatternMatcher::URLPatternMatcher(const URLPatternMatcher&) = default;
+URLPatternMatcher& URLPatternMatcher::operator=(const URLPatternMatcher&) =
+    default;
+URLPatternMatcher::URLPatternMatcher(URLPatternMatcher&&) = default;
+URLPatternMatcher& URLPatternMatcher::operator=(URLPatternMatcher&&) = default;
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+bool URLPatternMatcher::MatchesURL(const GURL& url) const {
+  // URLPattern matches the host of filesystem: URLs' inner URL.
+  const GURL& host_url = url.inner_url() ? *url.inner_url() : url;
+  const base::StringPiece host = CanonicalizeHost(host_url.host_piece());
+
+  if (MatchesAny(by_host_, host, url))
+    return true;
+
+  if (!by_domain_.empty()) {
+    if (MatchesAny(by_domain_, host, url))
+      return true;
+    // Subdomains of IP addresses are not a thing.
+    if (!host_url.HostIsIPAddress()) {
+      base::StringPiece domain = host;
+      for (size_t dot = domain.find('.'); dot != base::StringPiece::npos;
+           dot = domain.find('.')) {
+        domain.remove_prefix(dot + 1);
+        if (MatchesAny(by_domain_, domain, url))
+          return true;
+      }
+    }
+  }
+
+  const base::StringPiece path = url.PathForRequestPiece();
+  for (size_t length : path_prefix_lengths_) {
+    if (length > path.size())
+      break;
+    if (MatchesAny(by_path_prefix_, path.substr(0, length), url))
+      return true;
+  }
+  return false;
+}
+
+bool URLPatternMatcher::MatchesAny(const Index& index,
+                                   base::StringPiece key,
+                                   const GURL& url) const {
+  const auto iter = index.find(key);
+  if (iter == index.end())
+    return false;
+  return base::ranges::any_of(iter->second, [&](size_t i) {
+    return patterns_[i].MatchesURL(url);
+  });
+}
+
+}  // namespace electron
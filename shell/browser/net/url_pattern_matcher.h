@@ -0,0 +1,62 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+#define ELECTRON_SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace electron {
+
+// Matches URLs against a set of URLPatterns without trying every pattern.
+// The patterns are indexed once by what a URL has to contain to possibly
+// match them:
+// - patterns for one host by that host,
+// - patterns for a host and its subdomains by the host, which is looked up
+//   for the host of the URL and each of its parent domains,
+// - patterns for any host by the literal start of their path, which is looked
+//   up for each indexed length of the URL's path.
+// Only the patterns found this way are matched with URLPattern::MatchesURL(),
+// so the result is the same as trying all of them.
+class URLPatternMatcher {
+ public:
+  URLPatternMatcher();
+  explicit URLPatternMatcher(const std::set<URLPattern>& patterns);
+  URLPatternMatcher(const URLPatternMatcher&);
+  URLPatternMatcher& operator=(const URLPatternMatcher&);
+  URLPatternMatcher(URLPatternMatcher&&);
+  URLPatternMatcher& operator=(URLPatternMatcher&&);
+  ~URLPatternMatcher();
+
+  bool empty() const { return patterns_.empty(); }
+
+  bool MatchesURL(const GURL& url) const;
+
+ private:
+  using Index = base::flat_map<std::string, std::vector<size_t>, std::less<>>;
+
+  bool MatchesAny(const Index& index,
+                  base::StringPiece key,
+                  const GURL& url) const;
+
+  std::vector<URLPattern> patterns_;
+
+  Index by_host_;
+  Index by_domain_;
+  Index by_path_prefix_;
+  // The distinct key lengths of |by_path_prefix_|, in ascending order.
+  std::vector<size_t> path_prefix_lengths_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_URL_PATTERN_MATCHER_H_
@@ -4,6 +4,7 @@
 
 #include "shell/browser/net/url_pipe_loader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/task/sequenced_task_runner.h"
@@ -54,6 +55,8 @@ void URLPipeLoader::Start(
 }
 
 void URLPipeLoader::NotifyComplete(int result) {
+  if (writer_)
+    writer_->ReportStats("URLPipeLoader");
   client_->OnComplete(network::URLLoaderCompletionStatus(result));
   delete this;
 }
@@ -61,16 +64,14 @@ void URLPipeLoader::NotifyComplete(int result) {
 void URLPipeLoader::OnResponseStarted(
     const GURL& final_url,
     const network::mojom::URLResponseHead& response_head) {
-  mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
-  if (rv != MOJO_RESULT_OK) {
+  writer_ = DataPipeWriter::Create(
+      std::max<int64_t>(response_head.content_length, 0), &consumer);
+  if (!writer_) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
   }
 
-  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
-
   client_->OnReceiveResponse(response_head.Clone(), std::move(consumer),
                              absl::nullopt);
 }
@@ -84,7 +85,7 @@ void URLPipeLoader::OnWrite(base::OnceClosure resume, MojoResult result) {
 
 void URLPipeLoader::OnDataReceived(base::StringPiece string_piece,
                                    base::OnceClosure resume) {
-  producer_->Write(
+  writer_->Write(
       std::make_unique<mojo::StringDataSource>(
           string_piece, mojo::StringDataSource::AsyncWritingMode::
                             STRING_MAY_BE_INVALIDATED_BEFORE_COMPLETION),
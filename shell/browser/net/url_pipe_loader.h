@@ -12,11 +12,11 @@
 #include "base/values.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
+#include "shell/browser/net/data_pipe_writer.h"
 
 namespace network {
 class SharedURLLoaderFactory;
@@ -77,7 +77,7 @@ class URLPipeLoader : public network::mojom::URLLoader,
   mojo::Receiver<network::mojom::URLLoader> url_loader_;
   mojo::Remote<network::mojom::URLLoaderClient> client_;
 
-  std::unique_ptr<mojo::DataPipeProducer> producer_;
+  std::unique_ptr<DataPipeWriter> writer_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
 
   base::WeakPtrFactory<URLPipeLoader> weak_factory_{this};
@@ -11,6 +11,7 @@
 #include "extensions/browser/api/web_request/web_request_info.h"
 #include "net/base/completion_once_callback.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "shell/browser/net/response_body_tap.h"
 
 namespace electron {
 
@@ -25,6 +26,15 @@ class WebRequestAPI {
                               int error_code)>;
 
   virtual bool HasListener() const = 0;
+  // Returns the callback for the body of the response to |info| if it is to
+  // be tapped, otherwise a null callback.
+  virtual ResponseBodyTap::ResultCallback GetResponseBodyCallback(
+      extensions::WebRequestInfo* info,
+      const network::ResourceRequest& request) = 0;
+  // Whether a listener or rule may apply to |request| or to the requests it
+  // is redirected to, so that the others can skip the proxy. Only called when
+  // HasListener() is true.
+  virtual bool ShouldProxyRequest(const network::ResourceRequest& request) = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
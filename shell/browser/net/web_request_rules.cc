@@ -0,0 +1,196 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/web_request_rules.h"
+
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "base/containers/contains.h"
+#include "base/ranges/algorithm.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace {
+
+using HeaderOperation = WebRequestRule::HeaderOperation;
+
+// The https: or wss: version of |url|, or an empty GURL if it has none.
+GURL GetUpgradedURL(const GURL& url) {
+  GURL::Replacements replacements;
+  if (url.SchemeIs(url::kHttpScheme))
+    replacements.SetSchemeStr(url::kHttpsScheme);
+  else if (url.SchemeIs(url::kWsScheme))
+    replacements.SetSchemeStr(url::kWssScheme);
+  else
+    return GURL();
+  return url.ReplaceComponents(replacements);
+}
+
+}  // namespace
+
+WebRequestRule::WebRequestRule() = default;
+WebRequestRule::WebRequestRule(const WebRequestRule&) = default;
+WebRequestRule& WebRequestRule::operator=(const WebRequestRule&) = default;
+WebRequestRule::WebRequestRule(WebRequestRule&&) = default;
+WebRequestRule& WebRequestRule::operator=(WebRequestRule&&) = default;
+WebRequestRule::~WebRequestRule() = default;
+
+bool WebRequestRule::MatchesRequest(
+    const extensions::WebRequestInfo& info) const {
+  return MayMatchRequest(info.url, info.web_request_type, false);
+}
+
+bool WebRequestRule::MayMatchRequest(const GURL& url,
+                                     extensions::WebRequestResourceType type,
+                                     bool may_redirect) const {
+  return (may_redirect || url_matcher.empty() ||
+          url_matcher.MatchesURL(url)) &&
+         (types.empty() || base::Contains(types, type));
+}
+
+WebRequestRules::WebRequestRules() = default;
+WebRequestRules::~WebRequestRules() = default;
+
+void WebRequestRules::SetRules(std::vector<WebRequestRule> rules) {
+  rules_ = std::move(rules);
+  base::ranges::stable_sort(rules_, [](const WebRequestRule& a,
+                                       const WebRequestRule& b) {
+    return std::forward_as_tuple(b.priority, a.action) <
+           std::forward_as_tuple(a.priority, b.action);
+  });
+}
+
+bool WebRequestRules::MayMatchRequest(const GURL& url,
+                                      extensions::WebRequestResourceType type,
+                                      bool may_redirect) const {
+  return base::ranges::any_of(rules_, [&](const WebRequestRule& rule) {
+    return rule.MayMatchRequest(url, type, may_redirect);
+  });
+}
+
+WebRequestRules::RequestAction WebRequestRules::OnBeforeRequest(
+    const extensions::WebRequestInfo& info,
+    GURL* new_url) const {
+  for (const WebRequestRule& rule : rules_) {
+    if (rule.action == WebRequestRule::Action::kModifyHeaders ||
+        !rule.MatchesRequest(info)) {
+      continue;
+    }
+    switch (rule.action) {
+      case WebRequestRule::Action::kAllow:
+        return RequestAction::kNone;
+      case WebRequestRule::Action::kBlock:
+        return RequestAction::kBlock;
+      case WebRequestRule::Action::kUpgradeScheme:
+      case WebRequestRule::Action::kRedirect: {
+        GURL url = rule.action == WebRequestRule::Action::kRedirect
+                       ? rule.redirect_url
+                       : GetUpgradedURL(info.url);
+        // Redirecting to the same URL would never end.
+        if (!url.is_valid() || url == info.url)
+          continue;
+        *new_url = std::move(url);
+        return RequestAction::kRedirect;
+      }
+      case WebRequestRule::Action::kModifyHeaders:
+        break;
+    }
+  }
+  return RequestAction::kNone;
+}
+
+void WebRequestRules::OnBeforeSendHeaders(
+    const extensions::WebRequestInfo& info,
+    net::HttpRequestHeaders* headers) const {
+  for (const HeaderOperation* operation :
+       GetHeaderOperations(info, &WebRequestRule::request_headers)) {
+    switch (operation->type) {
+      case HeaderOperation::Type::kSet:
+        headers->SetHeader(operation->name, operation->value);
+        break;
+      case HeaderOperation::Type::kRemove:
+        headers->RemoveHeader(operation->name);
+        break;
+      case HeaderOperation::Type::kAppend: {
+        std::string value;
+        if (headers->GetHeader(operation->name, &value))
+          value += ", ";
+        headers->SetHeader(operation->name, value + operation->value);
+        break;
+      }
+    }
+  }
+}
+
+void WebRequestRules::OnHeadersReceived(
+    const extensions::WebRequestInfo& info,
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers) const {
+  if (!original_response_headers)
+    return;
+  const auto operations =
+      GetHeaderOperations(info, &WebRequestRule::response_headers);
+  if (operations.empty())
+    return;
+
+  *override_response_headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+      original_response_headers->raw_headers());
+  net::HttpResponseHeaders* headers = override_response_headers->get();
+  for (const HeaderOperation* operation : operations) {
+    switch (operation->type) {
+      case HeaderOperation::Type::kSet:
+        headers->SetHeader(operation->name, operation->value);
+        break;
+      case HeaderOperation::Type::kRemove:
+        headers->RemoveHeader(operation->name);
+        break;
+      case HeaderOperation::Type::kAppend:
+        // Another line, which is what Set-Cookie needs.
+        headers->AddHeader(operation->name, operation->value);
+        break;
+    }
+  }
+}
+
+std::vector<const WebRequestRule::HeaderOperation*>
+WebRequestRules::GetHeaderOperations(
+    const extensions::WebRequestInfo& info,
+    WebRequestRule::HeaderOperations WebRequestRule::*operations) const {
+  std::vector<const HeaderOperation*> result;
+  // The set or remove operation which decided each header.
+  std::map<base::StringPiece, HeaderOperation::Type> decided;
+  for (const WebRequestRule& rule : rules_) {
+    if (rule.action != WebRequestRule::Action::kAllow &&
+        rule.action != WebRequestRule::Action::kModifyHeaders) {
+      continue;
+    }
+    if (!rule.MatchesRequest(info))
+      continue;
+    if (rule.action == WebRequestRule::Action::kAllow)
+      break;
+
+    for (const HeaderOperation& operation : rule.*operations) {
+      const auto iter = decided.find(operation.name);
+      if (operation.type == HeaderOperation::Type::kAppend) {
+        if (iter != decided.end() &&
+            iter->second == HeaderOperation::Type::kRemove) {
+          continue;
+        }
+      } else if (iter != decided.end()) {
+        continue;
+      } else {
+        decided.emplace(operation.name, operation.type);
+      }
+      result.push_back(&operation);
+    }
+  }
+  return result;
+}
+
+}  // namespace electron
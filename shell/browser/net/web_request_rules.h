@@ -0,0 +1,129 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+#define ELECTRON_SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_refptr.h"
+#include "extensions/browser/api/web_request/web_request_info.h"
+#include "shell/browser/net/url_pattern_matcher.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpRequestHeaders;
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace electron {
+
+struct WebRequestRule {
+  // In the order they are applied for rules of the same priority.
+  enum class Action {
+    kAllow,
+    kBlock,
+    kUpgradeScheme,
+    kRedirect,
+    kModifyHeaders,
+  };
+
+  struct HeaderOperation {
+    enum class Type {
+      kSet,
+      kRemove,
+      kAppend,
+    };
+
+    Type type;
+    // Lowercase.
+    std::string name;
+    std::string value;
+  };
+  using HeaderOperations = std::vector<HeaderOperation>;
+
+  WebRequestRule();
+  WebRequestRule(const WebRequestRule&);
+  WebRequestRule& operator=(const WebRequestRule&);
+  WebRequestRule(WebRequestRule&&);
+  WebRequestRule& operator=(WebRequestRule&&);
+  ~WebRequestRule();
+
+  bool MatchesRequest(const extensions::WebRequestInfo& info) const;
+  // Ignores the URL if |may_redirect|.
+  bool MayMatchRequest(const GURL& url,
+                       extensions::WebRequestResourceType type,
+                       bool may_redirect) const;
+
+  int id = 0;
+  int priority = 1;
+  Action action = Action::kBlock;
+
+  // Empty matches everything.
+  URLPatternMatcher url_matcher;
+  std::set<extensions::WebRequestResourceType> types;
+
+  // Only for kRedirect.
+  GURL redirect_url;
+  // Only for kModifyHeaders.
+  HeaderOperations request_headers;
+  HeaderOperations response_headers;
+};
+
+// Declarative rules which are applied to requests without calling into
+// JavaScript, loosely following chrome.declarativeNetRequest: the matching
+// rule with the highest priority decides whether a request is blocked or
+// redirected, and an allow rule keeps the rules of lower priority from
+// affecting the request at all.
+class WebRequestRules {
+ public:
+  enum class RequestAction {
+    kNone,
+    kBlock,
+    kRedirect,
+  };
+
+  WebRequestRules();
+  ~WebRequestRules();
+
+  // disable copy
+  WebRequestRules(const WebRequestRules&) = delete;
+  WebRequestRules& operator=(const WebRequestRules&) = delete;
+
+  void SetRules(std::vector<WebRequestRule> rules);
+  const std::vector<WebRequestRule>& rules() const { return rules_; }
+  bool empty() const { return rules_.empty(); }
+  bool MayMatchRequest(const GURL& url,
+                       extensions::WebRequestResourceType type,
+                       bool may_redirect) const;
+
+  // Sets |new_url| for kRedirect.
+  RequestAction OnBeforeRequest(const extensions::WebRequestInfo& info,
+                                GURL* new_url) const;
+  void OnBeforeSendHeaders(const extensions::WebRequestInfo& info,
+                           net::HttpRequestHeaders* headers) const;
+  // Leaves |override_response_headers| alone if no rule modifies the headers.
+  void OnHeadersReceived(
+      const extensions::WebRequestInfo& info,
+      const net::HttpResponseHeaders* original_response_headers,
+      scoped_refptr<net::HttpResponseHeaders>* override_response_headers) const;
+
+ private:
+  // The header operations of the modifyHeaders rules matching |info|, by
+  // descending priority, up to the first matching allow rule. Setting or
+  // removing a header which a previous operation did is left out, and so is
+  // appending to a removed one.
+  std::vector<const WebRequestRule::HeaderOperation*> GetHeaderOperations(
+      const extensions::WebRequestInfo& info,
+      WebRequestRule::HeaderOperations WebRequestRule::*operations) const;
+
+  // Sorted by descending priority, then by action.
+  std::vector<WebRequestRule> rules_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_WEB_REQUEST_RULES_H_
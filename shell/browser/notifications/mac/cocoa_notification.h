@@ -32,13 +32,18 @@ class CocoaNotification : public Notification {
   void NotificationDismissed();
 
   NSUserNotification* notification() const { return notification_; }
+  const std::string& tag() const { return tag_; }
 
  private:
   void LogAction(const char* action);
+  // Dismisses the other notifications with the same tag, which this one
+  // replaces.
+  void DismissReplacedNotifications();
 
   base::scoped_nsobject<NSUserNotification> notification_;
   std::map<std::string, unsigned> additional_action_indices_;
   unsigned action_index_;
+  std::string tag_;
 };
 
 }  // namespace electron
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/mac/mac_util.h"
@@ -107,10 +108,26 @@ void CocoaNotification::Show(const NotificationOptions& options) {
                                            options.close_button_text)];
   }
 
+  tag_ = options.tag;
+  if (!tag_.empty())
+    DismissReplacedNotifications();
+
   [NSUserNotificationCenter.defaultUserNotificationCenter
       deliverNotification:notification_];
 }
 
+void CocoaNotification::DismissReplacedNotifications() {
+  // Dismissing a notification removes it from the presenter.
+  std::vector<CocoaNotification*> replaced;
+  for (Notification* notification : presenter()->notifications()) {
+    auto* cocoa_notification = static_cast<CocoaNotification*>(notification);
+    if (cocoa_notification != this && cocoa_notification->tag() == tag_)
+      replaced.push_back(cocoa_notification);
+  }
+  for (CocoaNotification* notification : replaced)
+    notification->Dismiss();
+}
+
 void CocoaNotification::Dismiss() {
   if (notification_)
     [NSUserNotificationCenter.defaultUserNotificationCenter
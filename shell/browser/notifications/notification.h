@@ -27,6 +27,7 @@ struct NotificationOptions {
   std::u16string title;
   std::u16string subtitle;
   std::u16string msg;
+  // Notifications with the same tag replace each other.
   std::string tag;
   bool silent;
   GURL icon_url;
@@ -41,6 +42,8 @@ struct NotificationOptions {
   std::u16string toast_xml;
 
   NotificationOptions();
+  NotificationOptions(const NotificationOptions&);
+  NotificationOptions& operator=(const NotificationOptions&);
   ~NotificationOptions();
 };
 
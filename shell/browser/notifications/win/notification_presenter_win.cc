@@ -12,10 +12,11 @@
 
 #include "base/environment.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/hash/md5.h"
 #include "base/logging.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/time/time.h"
+#include "base/task/thread_pool.h"
 #include "base/win/windows_version.h"
 #include "shell/browser/notifications/win/windows_toast_notification.h"
 #include "shell/common/thread_restrictions.h"
@@ -42,6 +43,21 @@ bool SaveIconToPath(const SkBitmap& bitmap, const base::FilePath& path) {
   return base::WriteFile(path, data, size) == size;
 }
 
+std::string HashIcon(const SkBitmap& icon) {
+  base::MD5Context context;
+  base::MD5Init(&context);
+  const int size[] = {icon.width(), icon.height()};
+  base::MD5Update(&context,
+                  base::StringPiece(reinterpret_cast<const char*>(size),
+                                    sizeof(size)));
+  base::MD5Update(&context, base::StringPiece(
+                                static_cast<const char*>(icon.getPixels()),
+                                icon.computeByteSize()));
+  base::MD5Digest digest;
+  base::MD5Final(&digest, &context);
+  return base::MD5DigestToBase16(digest);
+}
+
 }  // namespace
 
 // static
@@ -58,7 +74,10 @@ NotificationPresenter* NotificationPresenter::Create() {
   return presenter.release();
 }
 
-NotificationPresenterWin::NotificationPresenterWin() = default;
+NotificationPresenterWin::NotificationPresenterWin()
+    : icon_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
 
 NotificationPresenterWin::~NotificationPresenterWin() = default;
 
@@ -67,25 +86,39 @@ bool NotificationPresenterWin::Init() {
   return temp_dir_.CreateUniqueTempDir();
 }
 
-std::wstring NotificationPresenterWin::SaveIconToFilesystem(
-    const SkBitmap& icon,
-    const GURL& origin) {
-  std::string filename;
-
-  if (origin.is_valid()) {
-    filename = base::MD5String(origin.spec()) + ".png";
-  } else {
-    base::TimeTicks now = base::TimeTicks::Now();
-    filename = std::to_string(now.ToInternalValue()) + ".png";
+void NotificationPresenterWin::SaveIconToFilesystem(const SkBitmap& icon,
+                                                    const GURL& origin,
+                                                    IconCallback callback) {
+  if (icon.drawsNothing()) {
+    std::move(callback).Run(base::UTF8ToWide(origin.spec()));
+    return;
   }
 
-  ScopedAllowBlockingForElectron allow_blocking;
+  const std::string filename = HashIcon(icon) + ".png";
   base::FilePath path = temp_dir_.GetPath().Append(base::UTF8ToWide(filename));
-  if (base::PathExists(path))
-    return path.value();
-  if (SaveIconToPath(icon, path))
-    return path.value();
-  return base::UTF8ToWide(origin.spec());
+  if (saved_icons_.contains(filename)) {
+    std::move(callback).Run(path.value());
+    return;
+  }
+
+  icon_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&SaveIconToPath, icon, path),
+      base::BindOnce(&NotificationPresenterWin::OnIconSaved,
+                     weak_factory_.GetWeakPtr(), filename, path, origin,
+                     std::move(callback)));
+}
+
+void NotificationPresenterWin::OnIconSaved(const std::string& filename,
+                                           const base::FilePath& path,
+                                           const GURL& origin,
+                                           IconCallback callback,
+                                           bool success) {
+  if (!success) {
+    std::move(callback).Run(base::UTF8ToWide(origin.spec()));
+    return;
+  }
+  saved_icons_.insert(filename);
+  std::move(callback).Run(path.value());
 }
 
 Notification* NotificationPresenterWin::CreateNotificationObject(
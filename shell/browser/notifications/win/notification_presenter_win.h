@@ -23,7 +23,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_NOTIFICATIONS_WIN_NOTIFICATION_PRESENTER_WIN_H_
 #define ELECTRON_SHELL_BROWSER_NOTIFICATIONS_WIN_NOTIFICATION_PRESENTER_WIN_H_
 
+#include <string>
+
+#include "base/containers/flat_set.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
 #include "shell/browser/notifications/notification_presenter.h"
 
 class GURL;
@@ -38,13 +45,32 @@ class NotificationPresenterWin : public NotificationPresenter {
 
   bool Init();
 
-  std::wstring SaveIconToFilesystem(const SkBitmap& icon, const GURL& origin);
+  using IconCallback = base::OnceCallback<void(const std::wstring& path)>;
+
+  // Writes |icon| to a file for the toast to show it, and calls |callback|
+  // with its path. The files are named after the hash of their content, so
+  // that an icon which is used again is only written once, and new ones are
+  // encoded and written off the UI thread.
+  void SaveIconToFilesystem(const SkBitmap& icon,
+                            const GURL& origin,
+                            IconCallback callback);
 
  private:
   Notification* CreateNotificationObject(
       NotificationDelegate* delegate) override;
 
+  void OnIconSaved(const std::string& filename,
+                   const base::FilePath& path,
+                   const GURL& origin,
+                   IconCallback callback,
+                   bool success);
+
   base::ScopedTempDir temp_dir_;
+  scoped_refptr<base::SequencedTaskRunner> icon_task_runner_;
+  // The names of the icon files written to |temp_dir_|.
+  base::flat_set<std::string> saved_icons_;
+
+  base::WeakPtrFactory<NotificationPresenterWin> weak_factory_{this};
 };
 
 }  // namespace electron
@@ -12,6 +12,7 @@
 #include <wrl\wrappers\corewrappers.h>
 
 #include "base/environment.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/strings/string_util_win.h"
 #include "base/strings/utf_string_conversions.h"
@@ -71,11 +72,23 @@ ComPtr<ABI::Windows::UI::Notifications::IToastNotificationManagerStatics>
 ComPtr<ABI::Windows::UI::Notifications::IToastNotifier>
     WindowsToastNotification::toast_notifier_;
 
+// static
+ComPtr<ABI::Windows::UI::Notifications::IToastNotificationFactory>
+    WindowsToastNotification::toast_factory_;
+
 // static
 bool WindowsToastNotification::Initialize() {
   // Just initialize, don't care if it fails or already initialized.
   Windows::Foundation::Initialize(RO_INIT_MULTITHREADED);
 
+  ScopedHString toast_str(
+      RuntimeClass_Windows_UI_Notifications_ToastNotification);
+  if (!toast_str.success())
+    return false;
+  if (FAILED(Windows::Foundation::GetActivationFactory(toast_str,
+                                                       &toast_factory_)))
+    return false;
+
   ScopedHString toast_manager_str(
       RuntimeClass_Windows_UI_Notifications_ToastNotificationManager);
   if (!toast_manager_str.success())
@@ -111,7 +124,21 @@ WindowsToastNotification::~WindowsToastNotification() {
 }
 
 void WindowsToastNotification::Show(const NotificationOptions& options) {
-  if (SUCCEEDED(ShowInternal(options))) {
+  // The custom xml takes priority over the preset template.
+  if (!options.toast_xml.empty()) {
+    ShowWithIcon(options, std::wstring());
+    return;
+  }
+  auto* presenter_win = static_cast<NotificationPresenterWin*>(presenter());
+  presenter_win->SaveIconToFilesystem(
+      options.icon, options.icon_url,
+      base::BindOnce(&WindowsToastNotification::ShowWithIcon,
+                     weak_factory_.GetWeakPtr(), options));
+}
+
+void WindowsToastNotification::ShowWithIcon(const NotificationOptions& options,
+                                            const std::wstring& icon_path) {
+  if (SUCCEEDED(ShowInternal(options, icon_path))) {
     if (IsDebuggingNotifications())
       LOG(INFO) << "Notification created";
 
@@ -123,44 +150,41 @@ void WindowsToastNotification::Show(const NotificationOptions& options) {
 void WindowsToastNotification::Dismiss() {
   if (IsDebuggingNotifications())
     LOG(INFO) << "Hiding notification";
+  if (!toast_notification_) {
+    // The toast is still waiting for its icon, it is never shown.
+    weak_factory_.InvalidateWeakPtrs();
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Notification::NotificationDismissed, GetWeakPtr()));
+    return;
+  }
   toast_notifier_->Hide(toast_notification_.Get());
 }
 
 HRESULT WindowsToastNotification::ShowInternal(
-    const NotificationOptions& options) {
+    const NotificationOptions& options,
+    const std::wstring& icon_path) {
   ComPtr<IXmlDocument> toast_xml;
-  // The custom xml takes priority over the preset template.
   if (!options.toast_xml.empty()) {
     REPORT_AND_RETURN_IF_FAILED(
         XmlDocumentFromString(base::as_wcstr(options.toast_xml), &toast_xml),
         "XML: Invalid XML");
   } else {
-    auto* presenter_win = static_cast<NotificationPresenterWin*>(presenter());
-    std::wstring icon_path =
-        presenter_win->SaveIconToFilesystem(options.icon, options.icon_url);
     REPORT_AND_RETURN_IF_FAILED(
         GetToastXml(toast_manager_.Get(), options.title, options.msg, icon_path,
                     options.timeout_type, options.silent, &toast_xml),
         "XML: Failed to create XML document");
   }
 
-  ScopedHString toast_str(
-      RuntimeClass_Windows_UI_Notifications_ToastNotification);
-  if (!toast_str.success()) {
-    NotificationFailed("Creating ScopedHString failed");
-    return E_FAIL;
-  }
-
-  ComPtr<ABI::Windows::UI::Notifications::IToastNotificationFactory>
-      toast_factory;
-  REPORT_AND_RETURN_IF_FAILED(
-      Windows::Foundation::GetActivationFactory(toast_str, &toast_factory),
-      "WinAPI: GetActivationFactory failed");
-
-  REPORT_AND_RETURN_IF_FAILED(toast_factory->CreateToastNotification(
+  REPORT_AND_RETURN_IF_FAILED(toast_factory_->CreateToastNotification(
                                   toast_xml.Get(), &toast_notification_),
                               "WinAPI: CreateToastNotification failed");
 
+  if (!options.tag.empty()) {
+    REPORT_AND_RETURN_IF_FAILED(SetGroup(options.tag),
+                                "WinAPI: Setting the toast group failed");
+  }
+
   REPORT_AND_RETURN_IF_FAILED(SetupCallbacks(toast_notification_.Get()),
                               "WinAPI: SetupCallbacks failed");
 
@@ -169,6 +193,19 @@ HRESULT WindowsToastNotification::ShowInternal(
   return S_OK;
 }
 
+HRESULT WindowsToastNotification::SetGroup(const std::string& tag) {
+  // A toast replaces the one of the same tag and group in the action center,
+  // rather than being added next to it. Windows limits tags to 64
+  // characters.
+  ComPtr<ABI::Windows::UI::Notifications::IToastNotification2> toast2;
+  RETURN_IF_FAILED(toast_notification_.As(&toast2));
+  ScopedHString group(base::UTF8ToWide(tag).substr(0, 64));
+  if (!group.success())
+    return E_FAIL;
+  RETURN_IF_FAILED(toast2->put_Tag(group));
+  return toast2->put_Group(group);
+}
+
 HRESULT WindowsToastNotification::GetToastXml(
     ABI::Windows::UI::Notifications::IToastNotificationManagerStatics*
         toastManager,
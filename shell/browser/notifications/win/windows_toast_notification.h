@@ -14,6 +14,7 @@
 #include <wrl/implements.h>
 #include <string>
 
+#include "base/memory/weak_ptr.h"
 #include "shell/browser/notifications/notification.h"
 
 using Microsoft::WRL::ClassicCom;
@@ -56,7 +57,11 @@ class WindowsToastNotification : public Notification {
  private:
   friend class ToastEventHandler;
 
-  HRESULT ShowInternal(const NotificationOptions& options);
+  void ShowWithIcon(const NotificationOptions& options,
+                    const std::wstring& icon_path);
+  HRESULT ShowInternal(const NotificationOptions& options,
+                       const std::wstring& icon_path);
+  HRESULT SetGroup(const std::string& tag);
   HRESULT GetToastXml(
       ABI::Windows::UI::Notifications::IToastNotificationManagerStatics*
           toastManager,
@@ -97,6 +102,9 @@ class WindowsToastNotification : public Notification {
       toast_manager_;
   static ComPtr<ABI::Windows::UI::Notifications::IToastNotifier>
       toast_notifier_;
+  // Activated once, rather than for each notification.
+  static ComPtr<ABI::Windows::UI::Notifications::IToastNotificationFactory>
+      toast_factory_;
 
   EventRegistrationToken activated_token_;
   EventRegistrationToken dismissed_token_;
@@ -105,6 +113,9 @@ class WindowsToastNotification : public Notification {
   ComPtr<ToastEventHandler> event_handler_;
   ComPtr<ABI::Windows::UI::Notifications::IToastNotification>
       toast_notification_;
+
+  // For the toasts which wait for their icon to be written.
+  base::WeakPtrFactory<WindowsToastNotification> weak_factory_{this};
 };
 
 class ToastEventHandler : public RuntimeClass<RuntimeClassFlags<ClassicCom>,
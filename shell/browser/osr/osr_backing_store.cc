@@ -0,0 +1,76 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_backing_store.h"
+
+#include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/gfx/geometry/skia_conversions.h"
+
+namespace electron {
+
+namespace {
+
+bool CanReuse(const SkBitmap& bitmap, const gfx::Size& size, bool opaque) {
+  // A pixel ref which isn't unique is still held by an image of a frame that
+  // was passed to the paint event.
+  return bitmap.width() == size.width() && bitmap.height() == size.height() &&
+         bitmap.isOpaque() == opaque && bitmap.pixelRef() &&
+         bitmap.pixelRef()->unique();
+}
+
+}  // namespace
+
+OffScreenBackingStore::OffScreenBackingStore() = default;
+
+OffScreenBackingStore::~OffScreenBackingStore() = default;
+
+SkBitmap* OffScreenBackingStore::BeginFrame(const gfx::Size& size,
+                                            const gfx::Rect& damage_rect,
+                                            bool opaque,
+                                            gfx::Rect* stale_rect) {
+  for (Buffer& buffer : buffers_)
+    buffer.stale_rect.Union(damage_rect);
+
+  // Prefer the buffer of the frame before the latest, which is the least
+  // likely to still be in use.
+  size_t next = (current_ + 1) % buffers_.size();
+  if (!CanReuse(buffers_[next].bitmap, size, opaque) &&
+      CanReuse(buffers_[current_].bitmap, size, opaque)) {
+    next = current_;
+  }
+
+  Buffer& buffer = buffers_[next];
+  if (!CanReuse(buffer.bitmap, size, opaque)) {
+    // Leaves the old pixels to whoever still holds them.
+    buffer.bitmap = SkBitmap();
+    buffer.bitmap.allocN32Pixels(size.width(), size.height(), opaque);
+    buffer.stale_rect = gfx::Rect(size);
+  }
+  buffer.stale_rect.Intersect(gfx::Rect(size));
+  *stale_rect = buffer.stale_rect;
+  buffer.stale_rect = gfx::Rect();
+  current_ = next;
+  return &buffer.bitmap;
+}
+
+// static
+void OffScreenBackingStore::CopyPixels(const SkBitmap& src,
+                                       const gfx::Point& origin,
+                                       const gfx::Rect& clip,
+                                       SkBitmap* dst) {
+  gfx::Rect rect(origin, gfx::Size(src.width(), src.height()));
+  rect.Intersect(clip);
+  rect.Intersect(gfx::Rect(dst->width(), dst->height()));
+  if (rect.IsEmpty())
+    return;
+
+  SkPixmap dst_pixmap;
+  if (!dst->pixmap().extractSubset(&dst_pixmap, gfx::RectToSkIRect(rect)))
+    return;
+  src.readPixels(dst_pixmap, rect.x() - origin.x(), rect.y() - origin.y());
+  dst->notifyPixelsChanged();
+}
+
+}  // namespace electron
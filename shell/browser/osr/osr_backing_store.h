@@ -0,0 +1,63 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
+#define ELECTRON_SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
+
+#include <array>
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace electron {
+
+// Double-buffered pixels of the frames of an offscreen view.
+//
+// The frames are passed to the paint event sharing their pixels, so the
+// pixels of a frame are only reused once nothing else holds them anymore.
+// A reused buffer then only needs the regions which were damaged since it
+// last held a frame to be redrawn.
+class OffScreenBackingStore {
+ public:
+  OffScreenBackingStore();
+  ~OffScreenBackingStore();
+
+  // disable copy
+  OffScreenBackingStore(const OffScreenBackingStore&) = delete;
+  OffScreenBackingStore& operator=(const OffScreenBackingStore&) = delete;
+
+  // Makes a buffer of |size| the current one for a frame in which
+  // |damage_rect| changed, and returns it. |stale_rect| is set to the region
+  // of the buffer which has to be redrawn, which is all of it when the buffer
+  // could not be reused.
+  SkBitmap* BeginFrame(const gfx::Size& size,
+                       const gfx::Rect& damage_rect,
+                       bool opaque,
+                       gfx::Rect* stale_rect);
+
+  // The buffer of the latest frame, which draws nothing before the first.
+  const SkBitmap& current() const { return buffers_[current_].bitmap; }
+
+  // Copies the pixels of |src|, placed at |origin| in |dst|, within |clip|.
+  static void CopyPixels(const SkBitmap& src,
+                         const gfx::Point& origin,
+                         const gfx::Rect& clip,
+                         SkBitmap* dst);
+
+ private:
+  struct Buffer {
+    SkBitmap bitmap;
+    // The region which changed since |bitmap| held the latest frame.
+    gfx::Rect stale_rect;
+  };
+
+  std::array<Buffer, 2> buffers_;
+  size_t current_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
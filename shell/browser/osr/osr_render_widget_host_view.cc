@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
@@ -33,7 +34,6 @@
 #include "media/base/video_frame.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
-#include "third_party/skia/include/core/SkCanvas.h"
 #include "ui/compositor/compositor.h"
 #include "ui/compositor/layer.h"
 #include "ui/compositor/layer_type.h"
@@ -54,6 +54,9 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// How long the frame rate is kept before it is halved when adapting it.
+constexpr base::TimeDelta kAdaptiveFrameRateIdleDelay = base::Milliseconds(250);
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -175,7 +178,9 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
     bool painting,
     int frame_rate,
+    bool external_begin_frame,
     const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback,
     content::RenderWidgetHost* host,
     OffScreenRenderWidgetHostView* parent_host_view,
     gfx::Size initial_size)
@@ -184,12 +189,13 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       parent_host_view_(parent_host_view),
       transparent_(transparent),
       callback_(callback),
+      texture_callback_(texture_callback),
       frame_rate_(frame_rate),
+      external_begin_frame_(external_begin_frame),
       size_(initial_size),
       painting_(painting),
       cursor_manager_(std::make_unique<content::CursorManager>(this)),
-      mouse_wheel_phase_handler_(this),
-      backing_(std::make_unique<SkBitmap>()) {
+      mouse_wheel_phase_handler_(this) {
   DCHECK(render_widget_host_);
   DCHECK(!render_widget_host_->GetView());
 
@@ -221,8 +227,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
   compositor_ = std::make_unique<ui::Compositor>(
       context_factory->AllocateFrameSinkId(), context_factory,
       base::SingleThreadTaskRunner::GetCurrentDefault(),
-      false /* enable_pixel_canvas */,
-      false /* use_external_begin_frame_control */);
+      false /* enable_pixel_canvas */, external_begin_frame_);
   compositor_->SetAcceleratedWidget(gfx::kNullAcceleratedWidget);
   compositor_->SetDelegate(this);
   compositor_->SetRootLayer(root_layer_.get());
@@ -231,9 +236,17 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
   render_widget_host_->SetView(this);
 
   if (content::GpuDataManager::GetInstance()->HardwareAccelerationEnabled()) {
+    OnTexturePaintCallback texture_paint_callback;
+    if (texture_callback_) {
+      texture_paint_callback =
+          base::BindRepeating(&OffScreenRenderWidgetHostView::OnTexturePaint,
+                              weak_ptr_factory_.GetWeakPtr());
+    }
     video_consumer_ = std::make_unique<OffScreenVideoConsumer>(
-        this, base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
-                                  weak_ptr_factory_.GetWeakPtr()));
+        this,
+        base::BindRepeating(&OffScreenRenderWidgetHostView::OnPaint,
+                            weak_ptr_factory_.GetWeakPtr()),
+        texture_paint_callback);
     video_consumer_->SetActive(IsPainting());
     video_consumer_->SetFrameRate(GetFrameRate());
   }
@@ -547,9 +560,13 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
         embedder_render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->GetFrameRate(), callback_,
-      render_widget_host, embedder_host_view, size());
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, true, embedder_host_view->GetFrameRate(),
+      embedder_host_view->UsesExternalBeginFrame(), callback_,
+      OnTexturePaintCallback(), render_widget_host, embedder_host_view, size());
+  view->SetAdaptiveFrameRate(embedder_host_view->IsAdaptiveFrameRate(),
+                             embedder_host_view->GetMinFrameRate());
+  return view;
 }
 
 const viz::FrameSinkId& OffScreenRenderWidgetHostView::GetFrameSinkId() const {
@@ -672,9 +689,14 @@ bool OffScreenRenderWidgetHostView::UpdateNSViewAndDisplay() {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  OnActivity();
+
+  // Only the damaged region changed since the reused buffers were drawn.
+  gfx::Rect stale_rect;
+  SkBitmap* backing =
+      backing_.BeginFrame(gfx::Size(bitmap.width(), bitmap.height()),
+                          damage_rect, !transparent_, &stale_rect);
+  OffScreenBackingStore::CopyPixels(bitmap, gfx::Point(), stale_rect, backing);
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -683,6 +705,17 @@ void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
   }
 }
 
+void OffScreenRenderWidgetHostView::OnTexturePaint(
+    const gfx::Rect& damage_rect,
+    std::unique_ptr<OffscreenSharedTexture> texture) {
+  OnActivity();
+  HoldResize();
+  texture_callback_.Run(
+      gfx::IntersectRects(gfx::Rect(SizeInPixels()), damage_rect),
+      std::move(texture));
+  ReleaseResize();
+}
+
 gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
   float sf = GetDeviceScaleFactor();
   return gfx::ToFlooredSize(
@@ -700,29 +733,47 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
   // Optimize for the case when there is no popup
   if (proxy_views_.empty() && !popup_host_view_) {
     frame = GetBacking();
+    composited_layers_.clear();
   } else {
     float sf = GetDeviceScaleFactor();
-    frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
-                         false);
-    if (!GetBacking().drawsNothing()) {
-      SkCanvas canvas(frame);
-      canvas.writePixels(GetBacking(), 0, 0);
-
-      if (popup_host_view_ && !popup_host_view_->GetBacking().drawsNothing()) {
-        gfx::Rect rect = popup_host_view_->popup_position_;
-        gfx::Point origin_in_pixels =
-            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf));
-        canvas.writePixels(popup_host_view_->GetBacking(), origin_in_pixels.x(),
-                           origin_in_pixels.y());
-      }
+    std::vector<std::pair<gfx::Point, const SkBitmap*>> layers;
+    if (popup_host_view_ && !popup_host_view_->GetBacking().drawsNothing()) {
+      gfx::Rect rect = popup_host_view_->popup_position_;
+      layers.emplace_back(
+          gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf)),
+          &popup_host_view_->GetBacking());
+    }
+    for (auto* proxy_view : proxy_views_) {
+      gfx::Rect rect = proxy_view->GetBounds();
+      layers.emplace_back(
+          gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf)),
+          proxy_view->GetBitmap());
+    }
 
-      for (auto* proxy_view : proxy_views_) {
-        gfx::Rect rect = proxy_view->GetBounds();
-        gfx::Point origin_in_pixels =
-            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf));
-        canvas.writePixels(*proxy_view->GetBitmap(), origin_in_pixels.x(),
-                           origin_in_pixels.y());
-      }
+    // Only the damaged region has to be composited again, unless the layers
+    // moved since the latest frame.
+    std::vector<gfx::Rect> layer_rects;
+    for (const auto& [origin, bitmap] : layers) {
+      layer_rects.emplace_back(origin,
+                               gfx::Size(bitmap->width(), bitmap->height()));
+    }
+    gfx::Rect composite_rect = damage_rect;
+    if (layer_rects != composited_layers_) {
+      composite_rect = gfx::Rect(size_in_pixels);
+      composited_layers_ = std::move(layer_rects);
+    }
+
+    if (GetBacking().drawsNothing()) {
+      frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
+                           false);
+    } else {
+      gfx::Rect stale_rect;
+      frame = *composited_.BeginFrame(size_in_pixels, composite_rect, false,
+                                      &stale_rect);
+      OffScreenBackingStore::CopyPixels(GetBacking(), gfx::Point(), stale_rect,
+                                        &frame);
+      for (const auto& [origin, bitmap] : layers)
+        OffScreenBackingStore::CopyPixels(*bitmap, origin, stale_rect, &frame);
     }
   }
 
@@ -775,6 +826,8 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
 
 void OffScreenRenderWidgetHostView::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  OnActivity();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -813,6 +866,8 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
 
 void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  OnActivity();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -930,6 +985,7 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
     frame_rate_ = frame_rate;
   }
 
+  active_frame_rate_ = frame_rate_;
   SetupFrameRate(true);
 
   if (video_consumer_) {
@@ -944,6 +1000,92 @@ int OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
 
+void OffScreenRenderWidgetHostView::SetAdaptiveFrameRate(bool enabled,
+                                                         int min_frame_rate) {
+  adaptive_frame_rate_ = enabled;
+  min_frame_rate_ = std::clamp(min_frame_rate, 1, 240);
+  active_frame_rate_ = frame_rate_;
+  idle_timer_.Stop();
+  SetupFrameRate(true);
+  if (adaptive_frame_rate_)
+    OnActivity();
+
+  if (popup_host_view_)
+    popup_host_view_->SetAdaptiveFrameRate(enabled, min_frame_rate);
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SetAdaptiveFrameRate(enabled, min_frame_rate);
+}
+
+void OffScreenRenderWidgetHostView::OnActivity() {
+  if (!adaptive_frame_rate_)
+    return;
+
+  if (active_frame_rate_ != frame_rate_) {
+    active_frame_rate_ = frame_rate_;
+    SetupFrameRate(true);
+  }
+  // Unretained is safe as |idle_timer_| is owned by |this|.
+  idle_timer_.Start(FROM_HERE, kAdaptiveFrameRateIdleDelay,
+                    base::BindOnce(&OffScreenRenderWidgetHostView::OnIdle,
+                                   base::Unretained(this)));
+}
+
+void OffScreenRenderWidgetHostView::OnIdle() {
+  active_frame_rate_ = std::max(min_frame_rate_, active_frame_rate_ / 2);
+  SetupFrameRate(true);
+
+  if (active_frame_rate_ > min_frame_rate_) {
+    idle_timer_.Start(FROM_HERE, kAdaptiveFrameRateIdleDelay,
+                      base::BindOnce(&OffScreenRenderWidgetHostView::OnIdle,
+                                     base::Unretained(this)));
+  }
+}
+
+int OffScreenRenderWidgetHostView::GetActiveFrameRate() const {
+  return adaptive_frame_rate_ && active_frame_rate_ > 0 ? active_frame_rate_
+                                                        : frame_rate_;
+}
+
+void OffScreenRenderWidgetHostView::SendExternalBeginFrame() {
+  if (!external_begin_frame_ || !compositor_)
+    return;
+
+  // A frame is not started before the previous one is done, as the
+  // compositor would drop it anyway.
+  if (!begin_frame_pending_) {
+    begin_frame_pending_ = true;
+
+    base::TimeTicks frame_time = base::TimeTicks::Now();
+    base::TimeDelta interval = base::Seconds(1) / GetFrameRate();
+    viz::BeginFrameArgs args = viz::BeginFrameArgs::Create(
+        BEGINFRAME_FROM_HERE, viz::BeginFrameArgs::kManualSourceId,
+        begin_frame_number_++, frame_time, frame_time + interval, interval,
+        viz::BeginFrameArgs::NORMAL);
+
+    // Input received since the previous frame is delivered to the renderer
+    // coalesced, flings are advanced in lockstep with the frames.
+    if (render_widget_host_)
+      render_widget_host_->ProgressFlingIfNeeded(frame_time);
+    compositor_->IssueExternalBeginFrame(
+        args, true /* force */,
+        base::BindOnce(
+            &OffScreenRenderWidgetHostView::OnExternalBeginFrameComplete,
+            weak_ptr_factory_.GetWeakPtr()));
+  }
+
+  if (!IsPopupWidget() && popup_host_view_)
+    popup_host_view_->SendExternalBeginFrame();
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SendExternalBeginFrame();
+}
+
+void OffScreenRenderWidgetHostView::OnExternalBeginFrameComplete(
+    const viz::BeginFrameAck& ack) {
+  begin_frame_pending_ = false;
+}
+
 ui::Layer* OffScreenRenderWidgetHostView::GetRootLayer() const {
   return root_layer_.get();
 }
@@ -962,7 +1104,7 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
   if (!force && frame_rate_threshold_us_ != 0)
     return;
 
-  frame_rate_threshold_us_ = 1000000 / frame_rate_;
+  frame_rate_threshold_us_ = 1000000 / GetActiveFrameRate();
 
   if (compositor_) {
     compositor_->SetDisplayVSyncParameters(
@@ -975,6 +1117,12 @@ void OffScreenRenderWidgetHostView::Invalidate() {
 }
 
 void OffScreenRenderWidgetHostView::InvalidateBounds(const gfx::Rect& bounds) {
+  // There is no backing to composite when the frames are textures, the
+  // capturer has to produce a new one.
+  if (texture_callback_ && video_consumer_) {
+    video_consumer_->RequestRefreshFrame();
+    return;
+  }
   CompositeFrame(bounds);
 }
 
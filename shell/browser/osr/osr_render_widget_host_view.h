@@ -19,6 +19,8 @@
 #include "base/memory/raw_ptr.h"
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
+#include "base/timer/timer.h"
+#include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "content/browser/renderer_host/delegated_frame_host.h"  // nogncheck
@@ -26,7 +28,9 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_view_base.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_view.h"  // nogncheck
+#include "shell/browser/osr/osr_backing_store.h"
 #include "shell/browser/osr/osr_host_display_client.h"
+#include "shell/browser/osr/osr_shared_texture.h"
 #include "shell/browser/osr/osr_video_consumer.h"
 #include "shell/browser/osr/osr_view_proxy.h"
 #include "third_party/blink/public/mojom/widget/record_content_to_visible_time_request.mojom-forward.h"
@@ -66,7 +70,9 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   OffScreenRenderWidgetHostView(bool transparent,
                                 bool painting,
                                 int frame_rate,
+                                bool external_begin_frame,
                                 const OnPaintCallback& callback,
+                                const OnTexturePaintCallback& texture_callback,
                                 content::RenderWidgetHost* render_widget_host,
                                 OffScreenRenderWidgetHostView* parent_host_view,
                                 gfx::Size initial_size);
@@ -185,6 +191,8 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void ProxyViewDestroyed(OffscreenViewProxy* proxy) override;
 
   void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnTexturePaint(const gfx::Rect& damage_rect,
+                      std::unique_ptr<OffscreenSharedTexture> texture);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
@@ -196,7 +204,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
     return widget_type_ == content::WidgetType::kPopup;
   }
 
-  const SkBitmap& GetBacking() { return *backing_.get(); }
+  const SkBitmap& GetBacking() { return backing_.current(); }
 
   void HoldResize();
   void ReleaseResize();
@@ -211,6 +219,20 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
 
+  // While enabled, the frame rate is lowered step by step down to
+  // |min_frame_rate| as long as nothing is painted, and restored to the frame
+  // rate as soon as something is painted or input arrives.
+  void SetAdaptiveFrameRate(bool enabled, int min_frame_rate);
+  bool IsAdaptiveFrameRate() const { return adaptive_frame_rate_; }
+  int GetMinFrameRate() const { return min_frame_rate_; }
+  // Restores the full frame rate when adapting it.
+  void OnActivity();
+
+  // Produces a frame, only when the compositor was created without a begin
+  // frame source of its own.
+  void SendExternalBeginFrame();
+  bool UsesExternalBeginFrame() const { return external_begin_frame_; }
+
   ui::Layer* GetRootLayer() const;
 
   content::DelegatedFrameHost* GetDelegatedFrameHost() const;
@@ -236,6 +258,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetupFrameRate(bool force);
   void ResizeRootLayer(bool force);
 
+  // The rate the compositor currently ticks at.
+  int GetActiveFrameRate() const;
+  void OnIdle();
+  void OnExternalBeginFrameComplete(const viz::BeginFrameAck& ack);
+
   viz::FrameSinkId AllocateFrameSinkId();
 
   // Applies background color without notifying the RenderWidget about
@@ -253,11 +280,23 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   const bool transparent_;
   OnPaintCallback callback_;
+  // Not null when the frames are delivered as GPU textures, which popups and
+  // proxy views aren't composited into.
+  OnTexturePaintCallback texture_callback_;
   OnPopupPaintCallback parent_callback_;
 
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  bool adaptive_frame_rate_ = false;
+  int min_frame_rate_ = 1;
+  int active_frame_rate_ = 0;
+  base::OneShotTimer idle_timer_;
+
+  const bool external_begin_frame_;
+  bool begin_frame_pending_ = false;
+  uint64_t begin_frame_number_ = viz::BeginFrameArgs::kStartingFrameNumber;
+
   gfx::Size size_;
   bool painting_;
 
@@ -295,7 +334,12 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   SkColor background_color_ = SkColor();
 
-  std::unique_ptr<SkBitmap> backing_;
+  OffScreenBackingStore backing_;
+  // The frames with the popup and the proxy views drawn over the backing.
+  OffScreenBackingStore composited_;
+  // Where the popup and the proxy views were drawn in the latest composited
+  // frame.
+  std::vector<gfx::Rect> composited_layers_;
 
   base::WeakPtrFactory<OffScreenRenderWidgetHostView> weak_ptr_factory_{this};
 };
@@ -0,0 +1,13 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_shared_texture.h"
+
+namespace electron {
+
+OffscreenSharedTexture::OffscreenSharedTexture() = default;
+
+OffscreenSharedTexture::~OffscreenSharedTexture() = default;
+
+}  // namespace electron
@@ -0,0 +1,50 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
+#define ELECTRON_SHELL_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
+
+#include <memory>
+
+#include "base/functional/callback.h"
+#include "base/time/time.h"
+#include "media/base/video_types.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+#include "ui/gfx/gpu_memory_buffer.h"
+
+namespace electron {
+
+// A frame which the capturer produced in a GPU texture. The capturer doesn't
+// reuse the texture until this is destroyed.
+struct OffscreenSharedTexture {
+  OffscreenSharedTexture();
+  ~OffscreenSharedTexture();
+
+  // disable copy
+  OffscreenSharedTexture(const OffscreenSharedTexture&) = delete;
+  OffscreenSharedTexture& operator=(const OffscreenSharedTexture&) = delete;
+
+  media::VideoPixelFormat pixel_format = media::PIXEL_FORMAT_UNKNOWN;
+  gfx::Size coded_size;
+  gfx::Rect visible_rect;
+  gfx::Rect content_rect;
+  base::TimeDelta timestamp;
+
+  // Owns the DXGI shared handle, IOSurface or dmabuf of the texture.
+  gfx::GpuMemoryBufferHandle handle;
+  // Tells the capturer the texture may be reused when it is closed.
+  mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      releaser;
+};
+
+typedef base::RepeatingCallback<void(const gfx::Rect&,
+                                     std::unique_ptr<OffscreenSharedTexture>)>
+    OnTexturePaintCallback;
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_OSR_OSR_SHARED_TEXTURE_H_
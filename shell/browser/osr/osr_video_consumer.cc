@@ -33,8 +33,10 @@ namespace electron {
 
 OffScreenVideoConsumer::OffScreenVideoConsumer(
     OffScreenRenderWidgetHostView* view,
-    OnPaintCallback callback)
+    OnPaintCallback callback,
+    OnTexturePaintCallback texture_callback)
     : callback_(callback),
+      texture_callback_(texture_callback),
       view_(view),
       video_capturer_(view->CreateVideoCapturer()) {
   video_capturer_->SetAutoThrottlingEnabled(false);
@@ -49,7 +51,10 @@ OffScreenVideoConsumer::~OffScreenVideoConsumer() = default;
 
 void OffScreenVideoConsumer::SetActive(bool active) {
   if (active) {
-    video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
+    video_capturer_->Start(
+        this, texture_callback_
+                  ? viz::mojom::BufferFormatPreference::kPreferGpuMemoryBuffer
+                  : viz::mojom::BufferFormatPreference::kDefault);
   } else {
     video_capturer_->Stop();
   }
@@ -66,22 +71,35 @@ void OffScreenVideoConsumer::SizeChanged(const gfx::Size& size_in_pixels) {
   video_capturer_->RequestRefreshFrame();
 }
 
+void OffScreenVideoConsumer::RequestRefreshFrame() {
+  video_capturer_->RequestRefreshFrame();
+}
+
 void OffScreenVideoConsumer::OnFrameCaptured(
     ::media::mojom::VideoBufferHandlePtr data,
     ::media::mojom::VideoFrameInfoPtr info,
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
-  auto& data_region = data->get_read_only_shmem_region();
-
   if (!CheckContentRect(content_rect)) {
     SizeChanged(view_->SizeInPixels());
     return;
   }
 
+  if (data->is_gpu_memory_buffer_handle()) {
+    OnTextureCaptured(std::move(data), std::move(info), content_rect,
+                      std::move(callbacks));
+    return;
+  }
+
   mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
       callbacks_remote(std::move(callbacks));
 
+  if (!data->is_read_only_shmem_region()) {
+    callbacks_remote->Done();
+    return;
+  }
+  auto& data_region = data->get_read_only_shmem_region();
   if (!data_region.IsValid()) {
     callbacks_remote->Done();
     return;
@@ -136,6 +154,32 @@ void OffScreenVideoConsumer::OnFrameCaptured(
   callback_.Run(*update_rect, bitmap);
 }
 
+void OffScreenVideoConsumer::OnTextureCaptured(
+    ::media::mojom::VideoBufferHandlePtr data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& content_rect,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  if (!texture_callback_)
+    return;
+
+  auto texture = std::make_unique<OffscreenSharedTexture>();
+  texture->pixel_format = info->pixel_format;
+  texture->coded_size = info->coded_size;
+  texture->visible_rect = info->visible_rect;
+  texture->content_rect = content_rect;
+  texture->timestamp = info->timestamp;
+  texture->handle = std::move(data->get_gpu_memory_buffer_handle());
+  texture->releaser = std::move(callbacks);
+
+  absl::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
+  if (!update_rect.has_value() || update_rect->IsEmpty()) {
+    update_rect = content_rect;
+  }
+
+  texture_callback_.Run(*update_rect, std::move(texture));
+}
+
 void OffScreenVideoConsumer::OnNewCropVersion(uint32_t crop_version) {}
 
 void OffScreenVideoConsumer::OnFrameWithEmptyRegionCapture() {}
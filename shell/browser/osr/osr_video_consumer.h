@@ -14,6 +14,7 @@
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "shell/browser/osr/osr_shared_texture.h"
 
 namespace electron {
 
@@ -24,8 +25,12 @@ typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
 
 class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
  public:
+  // Frames are captured into GPU textures and passed to |texture_callback|
+  // when it is not null, |callback| gets the frames the capturer could only
+  // produce in shared memory.
   OffScreenVideoConsumer(OffScreenRenderWidgetHostView* view,
-                         OnPaintCallback callback);
+                         OnPaintCallback callback,
+                         OnTexturePaintCallback texture_callback);
   ~OffScreenVideoConsumer() override;
 
   // disable copy
@@ -35,6 +40,7 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
   void SetActive(bool active);
   void SetFrameRate(int frame_rate);
   void SizeChanged(const gfx::Size& size_in_pixels);
+  void RequestRefreshFrame();
 
  private:
   // viz::mojom::FrameSinkVideoConsumer implementation.
@@ -51,7 +57,15 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
 
   bool CheckContentRect(const gfx::Rect& content_rect);
 
+  void OnTextureCaptured(
+      ::media::mojom::VideoBufferHandlePtr data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& content_rect,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks);
+
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
 
   raw_ptr<OffScreenRenderWidgetHostView> view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -13,8 +13,13 @@ namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
-    const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+    bool external_begin_frame,
+    const OnPaintCallback& callback,
+    const OnTexturePaintCallback& texture_callback)
+    : transparent_(transparent),
+      external_begin_frame_(external_begin_frame),
+      callback_(callback),
+      texture_callback_(texture_callback) {
 #if BUILDFLAG(IS_MAC)
   PlatformCreate();
 #endif
@@ -118,9 +123,11 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, GetSize());
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, painting_, GetFrameRate(), external_begin_frame_,
+      callback_, texture_callback_, render_widget_host, nullptr, GetSize());
+  view->SetAdaptiveFrameRate(adaptive_frame_rate_, min_frame_rate_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -134,9 +141,13 @@ OffScreenWebContentsView::CreateViewForChildWidget(
           ? web_contents_impl->GetOuterWebContents()->GetRenderWidgetHostView()
           : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->GetFrameRate(), callback_,
-                                           render_widget_host, view, GetSize());
+  auto* child_view = new OffScreenRenderWidgetHostView(
+      transparent_, painting_, view->GetFrameRate(),
+      view->UsesExternalBeginFrame(), callback_, OnTexturePaintCallback(),
+      render_widget_host, view, GetSize());
+  child_view->SetAdaptiveFrameRate(view->IsAdaptiveFrameRate(),
+                                   view->GetMinFrameRate());
+  return child_view;
 }
 
 void OffScreenWebContentsView::SetPageTitle(const std::u16string& title) {}
@@ -210,6 +221,23 @@ int OffScreenWebContentsView::GetFrameRate() const {
   }
 }
 
+void OffScreenWebContentsView::SetAdaptiveFrameRate(bool enabled,
+                                                    int min_frame_rate) {
+  auto* view = GetView();
+  adaptive_frame_rate_ = enabled;
+  min_frame_rate_ = min_frame_rate;
+  if (view != nullptr) {
+    view->SetAdaptiveFrameRate(enabled, min_frame_rate);
+  }
+}
+
+void OffScreenWebContentsView::SendExternalBeginFrame() {
+  auto* view = GetView();
+  if (view != nullptr) {
+    view->SendExternalBeginFrame();
+  }
+}
+
 OffScreenRenderWidgetHostView* OffScreenWebContentsView::GetView() const {
   if (web_contents_) {
     return static_cast<OffScreenRenderWidgetHostView*>(
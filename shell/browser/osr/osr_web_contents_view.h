@@ -30,7 +30,10 @@ class OffScreenWebContentsView : public content::WebContentsView,
                                  public content::RenderViewHostDelegateView,
                                  public NativeWindowObserver {
  public:
-  OffScreenWebContentsView(bool transparent, const OnPaintCallback& callback);
+  OffScreenWebContentsView(bool transparent,
+                           bool external_begin_frame,
+                           const OnPaintCallback& callback,
+                           const OnTexturePaintCallback& texture_callback);
   ~OffScreenWebContentsView() override;
 
   void SetWebContents(content::WebContents*);
@@ -85,6 +88,8 @@ class OffScreenWebContentsView : public content::WebContentsView,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void SetAdaptiveFrameRate(bool enabled, int min_frame_rate);
+  void SendExternalBeginFrame();
 
  private:
 #if BUILDFLAG(IS_MAC)
@@ -97,9 +102,13 @@ class OffScreenWebContentsView : public content::WebContentsView,
   raw_ptr<NativeWindow> native_window_ = nullptr;
 
   const bool transparent_;
+  const bool external_begin_frame_;
   bool painting_ = true;
   int frame_rate_ = 60;
+  bool adaptive_frame_rate_ = false;
+  int min_frame_rate_ = 1;
   OnPaintCallback callback_;
+  OnTexturePaintCallback texture_callback_;
 
   // Weak refs.
   raw_ptr<content::WebContents> web_contents_ = nullptr;
@@ -0,0 +1,210 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/preload_script_cache.h"
+
+#include <cstring>
+#include <utility>
+
+#include "base/containers/contains.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "crypto/sha2.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/thread_restrictions.h"
+#include "uv.h"  // NOLINT(build/include_directory)
+
+namespace electron {
+
+namespace {
+
+// The file of a script in an archive is the archive.
+bool GetScriptFileInfo(const base::FilePath& path, base::File::Info* info) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path))
+    return base::GetFileInfo(asar_path, info);
+  return base::GetFileInfo(path, info);
+}
+
+bool IsSameFile(const base::File::Info& a, const base::File::Info& b) {
+  return a.last_modified == b.last_modified && a.size == b.size;
+}
+
+base::ReadOnlySharedMemoryRegion CreateRegion(const void* data, size_t size) {
+  base::MappedReadOnlyRegion mapped =
+      base::ReadOnlySharedMemoryRegion::Create(size);
+  if (!mapped.IsValid())
+    return base::ReadOnlySharedMemoryRegion();
+  memcpy(mapped.mapping.memory(), data, size);
+  return std::move(mapped.region);
+}
+
+absl::optional<PreloadScriptCache::Script> LoadScript(
+    const base::FilePath& path) {
+  PreloadScriptCache::Script script;
+  std::string source;
+  base::File::Info info_after_read;
+  if (!GetScriptFileInfo(path, &script.info) ||
+      !asar::ReadFileToString(path, &source) ||
+      !GetScriptFileInfo(path, &info_after_read) ||
+      !IsSameFile(script.info, info_after_read)) {
+    return absl::nullopt;
+  }
+  // Shared memory can't be empty, empty scripts are left to
+  // BROWSER_SANDBOX_LOAD.
+  if (source.empty())
+    return absl::nullopt;
+
+  // Decoded like fs.readFile(path, 'utf8') does.
+  const std::u16string utf16 = base::UTF8ToUTF16(source);
+  script.source = CreateRegion(utf16.data(), utf16.size() * sizeof(char16_t));
+  if (!script.source.IsValid())
+    return absl::nullopt;
+  script.source_hash = crypto::SHA256HashString(source);
+  return script;
+}
+
+base::Value::Dict GetEnvironment() {
+  base::Value::Dict env;
+  uv_env_item_t* items;
+  int count;
+  if (uv_os_environ(&items, &count) != 0)
+    return env;
+  for (int i = 0; i < count; ++i)
+    env.Set(items[i].name, items[i].value);
+  uv_os_free_environ(items, count);
+  return env;
+}
+
+}  // namespace
+
+PreloadScriptCache::Script::Script() = default;
+PreloadScriptCache::Script::Script(Script&&) = default;
+PreloadScriptCache::Script& PreloadScriptCache::Script::operator=(Script&&) =
+    default;
+PreloadScriptCache::Script::~Script() = default;
+
+// static
+PreloadScriptCache* PreloadScriptCache::GetInstance() {
+  static base::NoDestructor<PreloadScriptCache> instance;
+  return instance.get();
+}
+
+PreloadScriptCache::PreloadScriptCache()
+    : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+PreloadScriptCache::~PreloadScriptCache() = default;
+
+void PreloadScriptCache::SetProcessInfo(base::Value::Dict info) {
+  process_info_ = std::move(info);
+}
+
+mojom::SandboxPreloadsPtr PreloadScriptCache::GetPreloads(
+    const std::vector<base::FilePath>& paths) {
+  if (!process_info_)
+    return nullptr;
+
+  std::vector<mojom::PreloadScriptPtr> scripts;
+  bool complete = true;
+  for (const auto& path : paths) {
+    auto it = scripts_.find(path);
+    bool fresh = false;
+    if (it != scripts_.end()) {
+      // A stat is much cheaper than the synchronous round trip of the
+      // renderer which it saves.
+      ScopedAllowBlockingForElectron allow_blocking;
+      base::File::Info info;
+      fresh = GetScriptFileInfo(path, &info) &&
+              IsSameFile(info, it->second.info);
+    }
+    if (!fresh) {
+      Load(path);
+      complete = false;
+      continue;
+    }
+    if (!complete)
+      continue;
+
+    auto script = mojom::PreloadScript::New();
+    script->path = path;
+    script->source = it->second.source.Duplicate();
+    auto key = cache_keys_.find(it->second.source_hash);
+    if (key != cache_keys_.end()) {
+      auto code_cache = code_caches_.find(key->second);
+      if (code_cache != code_caches_.end()) {
+        script->code_cache = mojom::PreloadCodeCache::New(
+            key->second, code_cache->second.Duplicate());
+      }
+    }
+    scripts.push_back(std::move(script));
+  }
+  if (!complete)
+    return nullptr;
+
+  base::Value::Dict process = process_info_->Clone();
+  process.Set("env", GetEnvironment());
+  return mojom::SandboxPreloads::New(std::move(scripts), std::move(process));
+}
+
+void PreloadScriptCache::SetCacheKey(const std::string& source,
+                                     const std::string& cache_key) {
+  cache_keys_[crypto::SHA256HashString(source)] = cache_key;
+}
+
+void PreloadScriptCache::SetCodeCache(const std::string& cache_key,
+                                      base::span<const uint8_t> data) {
+  // Only the code caches of known sources are kept.
+  if (data.empty() ||
+      !base::Contains(cache_keys_, cache_key,
+                      &decltype(cache_keys_)::value_type::second)) {
+    return;
+  }
+  base::ReadOnlySharedMemoryRegion region =
+      CreateRegion(data.data(), data.size());
+  if (region.IsValid())
+    code_caches_[cache_key] = std::move(region);
+}
+
+void PreloadScriptCache::Load(const base::FilePath& path) {
+  if (!loading_.insert(path).second)
+    return;
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&LoadScript, path),
+      base::BindOnce(&PreloadScriptCache::OnLoaded, weak_factory_.GetWeakPtr(),
+                     path));
+}
+
+void PreloadScriptCache::OnLoaded(const base::FilePath& path,
+                                  absl::optional<Script> script) {
+  loading_.erase(path);
+  if (!script)
+    return;
+
+  // Forget the code cache of the previous version of the script, unless
+  // another script has the same source.
+  auto previous = scripts_.find(path);
+  if (previous != scripts_.end() &&
+      previous->second.source_hash != script->source_hash) {
+    const std::string hash = previous->second.source_hash;
+    scripts_.erase(previous);
+    if (!base::ranges::any_of(scripts_, [&hash](const auto& entry) {
+          return entry.second.source_hash == hash;
+        })) {
+      auto key = cache_keys_.find(hash);
+      if (key != cache_keys_.end()) {
+        code_caches_.erase(key->second);
+        cache_keys_.erase(key);
+      }
+    }
+  }
+  scripts_.insert_or_assign(path, std::move(*script));
+}
+
+}  // namespace electron
@@ -0,0 +1,93 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_PRELOAD_SCRIPT_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_PRELOAD_SCRIPT_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/values.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace electron {
+
+// Keeps the preload scripts of sandboxed renderers in read-only shared
+// memory, so that they can be handed to the renderer before a navigation
+// commits instead of being read from disk and sent as strings when the
+// renderer asks for them synchronously. A script is keyed by its path and
+// only used while the modification time and size of the file are those it
+// was read with. The code caches of lib/browser/preload-code-cache.ts are
+// kept along, for whichever session they were made. Only used on the UI
+// thread.
+class PreloadScriptCache {
+ public:
+  static PreloadScriptCache* GetInstance();
+
+  PreloadScriptCache();
+  ~PreloadScriptCache();
+
+  // disable copy
+  PreloadScriptCache(const PreloadScriptCache&) = delete;
+  PreloadScriptCache& operator=(const PreloadScriptCache&) = delete;
+
+  // The properties of process which are the same for every sandboxed
+  // renderer, set by lib/browser/rpc-server.ts. The environment is added by
+  // GetPreloads().
+  void SetProcessInfo(base::Value::Dict info);
+
+  // Returns the preloads of a document whose preload scripts are at |paths|,
+  // or null when one of them isn't cached or changed on disk. Those are read
+  // in the background for the next navigations.
+  mojom::SandboxPreloadsPtr GetPreloads(
+      const std::vector<base::FilePath>& paths);
+
+  // |cache_key| is the key of the code cache of the scripts whose source is
+  // |source|.
+  void SetCacheKey(const std::string& source, const std::string& cache_key);
+  void SetCodeCache(const std::string& cache_key,
+                    base::span<const uint8_t> data);
+
+  struct Script {
+    Script();
+    Script(Script&&);
+    Script& operator=(Script&&);
+    ~Script();
+
+    base::File::Info info;
+    base::ReadOnlySharedMemoryRegion source;
+    // The SHA256 of the UTF-8 source.
+    std::string source_hash;
+  };
+
+ private:
+  void Load(const base::FilePath& path);
+  void OnLoaded(const base::FilePath& path, absl::optional<Script> script);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  absl::optional<base::Value::Dict> process_info_;
+  base::flat_map<base::FilePath, Script> scripts_;
+  base::flat_set<base::FilePath> loading_;
+  // source hash -> cache key
+  base::flat_map<std::string, std::string> cache_keys_;
+  // cache key -> code cache
+  base::flat_map<std::string, base::ReadOnlySharedMemoryRegion> code_caches_;
+
+  base::WeakPtrFactory<PreloadScriptCache> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_PRELOAD_SCRIPT_CACHE_H_
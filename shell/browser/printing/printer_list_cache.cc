@@ -0,0 +1,216 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/printing/printer_list_cache.h"
+
+#include "base/containers/contains.h"
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "chrome/browser/browser_process.h"
+#include "printing/mojom/print.mojom.h"  // nogncheck
+
+#if BUILDFLAG(IS_MAC)
+#include <ApplicationServices/ApplicationServices.h>
+
+#include "base/mac/scoped_cftyperef.h"
+#include "base/strings/sys_string_conversions.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+// While the list is used, it is refreshed often enough to stay younger than
+// |PrinterListCache::kMaxAge|, and for this long after the last use.
+constexpr base::TimeDelta kRefreshInterval = base::Seconds(20);
+constexpr base::TimeDelta kIdleTimeout = base::Minutes(5);
+
+scoped_refptr<base::SequencedTaskRunner> CreateBackendTaskRunner() {
+  // USER_VISIBLE because the printers are waited for by print().
+  static constexpr base::TaskTraits kTraits = {
+      base::MayBlock(), base::TaskPriority::USER_VISIBLE};
+
+#if defined(USE_CUPS)
+  // CUPS is thread safe.
+  return base::ThreadPool::CreateSequencedTaskRunner(kTraits);
+#elif BUILDFLAG(IS_WIN)
+  // Windows drivers are likely not thread-safe, they are only called from
+  // one thread, which isn't the UI thread so that they can't block it.
+  return base::ThreadPool::CreateCOMSTATaskRunner(
+      kTraits, base::SingleThreadTaskRunnerThreadMode::DEDICATED);
+#else
+  // Be conservative on unsupported platforms.
+  return base::ThreadPool::CreateSingleThreadTaskRunner(kTraits);
+#endif
+}
+
+PrinterListCache::Printers EnumeratePrinters(const std::string& locale) {
+  PrinterListCache::Printers result;
+  auto print_backend = printing::PrintBackend::CreateInstance(locale);
+  result.succeeded = print_backend->EnumeratePrinters(result.printers) ==
+                     printing::mojom::ResultCode::kSuccess;
+  if (!result.succeeded)
+    LOG(INFO) << "Failed to enumerate printers";
+
+  // We don't want to fail if this fails since some devices won't have a
+  // default printer.
+  if (print_backend->GetDefaultPrinterName(result.default_printer) !=
+      printing::mojom::ResultCode::kSuccess) {
+    LOG(ERROR) << "Failed to get default printer name";
+  }
+  return result;
+}
+
+// This will return false if no printer with the provided device_name can be
+// found on the network. We need to check this because Chromium does not do
+// sanity checking of device_name validity and so will crash on invalid names.
+bool IsDeviceNameValid(const std::string& locale,
+                       const std::u16string& device_name) {
+#if BUILDFLAG(IS_MAC)
+  base::ScopedCFTypeRef<CFStringRef> new_printer_id(
+      base::SysUTF16ToCFStringRef(device_name));
+  PMPrinter new_printer = PMPrinterCreateFromPrinterID(new_printer_id.get());
+  bool printer_exists = new_printer != nullptr;
+  PMRelease(new_printer);
+  return printer_exists;
+#else
+  scoped_refptr<printing::PrintBackend> print_backend =
+      printing::PrintBackend::CreateInstance(locale);
+  return print_backend->IsValidPrinter(base::UTF16ToUTF8(device_name));
+#endif
+}
+
+}  // namespace
+
+PrinterListCache::Printers::Printers() = default;
+PrinterListCache::Printers::Printers(const Printers&) = default;
+PrinterListCache::Printers& PrinterListCache::Printers::operator=(
+    const Printers&) = default;
+PrinterListCache::Printers::~Printers() = default;
+
+// static
+PrinterListCache* PrinterListCache::GetInstance() {
+  static base::NoDestructor<PrinterListCache> instance;
+  return instance.get();
+}
+
+PrinterListCache::PrinterListCache()
+    : backend_task_runner_(CreateBackendTaskRunner()) {}
+
+PrinterListCache::~PrinterListCache() = default;
+
+void PrinterListCache::GetPrinters(PrintersCallback callback) {
+  last_use_ = base::TimeTicks::Now();
+  if (!refresh_timer_.IsRunning()) {
+    // Unretained is safe as |refresh_timer_| is owned by |this|.
+    refresh_timer_.Start(FROM_HERE, kRefreshInterval,
+                         base::BindRepeating(&PrinterListCache::OnRefreshTimer,
+                                             base::Unretained(this)));
+  }
+
+  if (printers_ && last_use_ - refresh_time_ < kMaxAge) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), *printers_));
+    return;
+  }
+  pending_callbacks_.push_back(std::move(callback));
+  Refresh();
+}
+
+void PrinterListCache::GetDeviceNameToUse(const std::u16string& device_name,
+                                          DeviceNameCallback callback) {
+  GetPrinters(base::BindOnce(&PrinterListCache::OnGotPrintersForDeviceName,
+                             weak_factory_.GetWeakPtr(), device_name,
+                             std::move(callback)));
+}
+
+void PrinterListCache::OnGotPrintersForDeviceName(
+    const std::u16string& device_name,
+    DeviceNameCallback callback,
+    const Printers& printers) {
+  if (!device_name.empty()) {
+    const std::string name = base::UTF16ToUTF8(device_name);
+    if (base::Contains(printers.printers, name,
+                       &printing::PrinterBasicInfo::printer_name)) {
+      std::move(callback).Run(std::make_pair(std::string(), device_name));
+      return;
+    }
+    // The printer could have been added since the list was made, or not be
+    // enumerated, like the printers of other servers with CUPS.
+    backend_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&IsDeviceNameValid,
+                       g_browser_process->GetApplicationLocale(), device_name),
+        base::BindOnce(
+            [](const std::u16string& device_name, DeviceNameCallback callback,
+               bool valid) {
+              if (!valid) {
+                std::move(callback).Run(std::make_pair(
+                    "Invalid deviceName provided", std::u16string()));
+                return;
+              }
+              std::move(callback).Run(
+                  std::make_pair(std::string(), device_name));
+            },
+            device_name, std::move(callback)));
+    return;
+  }
+
+  std::string printer_name = printers.default_printer;
+  if (printer_name.empty()) {
+    if (!printers.succeeded) {
+      std::move(callback).Run(
+          std::make_pair("Failed to enumerate printers", std::u16string()));
+      return;
+    }
+    if (printers.printers.empty()) {
+      std::move(callback).Run(std::make_pair(
+          "No printers available on the network", std::u16string()));
+      return;
+    }
+    printer_name = printers.printers.front().printer_name;
+  }
+  std::move(callback).Run(
+      std::make_pair(std::string(), base::UTF8ToUTF16(printer_name)));
+}
+
+void PrinterListCache::Refresh() {
+  if (refreshing_)
+    return;
+  refreshing_ = true;
+  backend_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&EnumeratePrinters,
+                     g_browser_process->GetApplicationLocale()),
+      base::BindOnce(&PrinterListCache::OnRefreshed,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void PrinterListCache::OnRefreshed(Printers printers) {
+  refreshing_ = false;
+  // A failed enumeration isn't kept, the next call tries again.
+  if (printers.succeeded) {
+    printers_ = printers;
+    refresh_time_ = base::TimeTicks::Now();
+  } else {
+    printers_.reset();
+  }
+
+  std::vector<PrintersCallback> callbacks;
+  callbacks.swap(pending_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(printers);
+}
+
+void PrinterListCache::OnRefreshTimer() {
+  if (base::TimeTicks::Now() - last_use_ > kIdleTimeout) {
+    refresh_timer_.Stop();
+    return;
+  }
+  Refresh();
+}
+
+}  // namespace electron
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_PRINTING_PRINTER_LIST_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_PRINTING_PRINTER_LIST_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "printing/backend/print_backend.h"  // nogncheck
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace electron {
+
+// Keeps the printers of the system for getPrintersAsync() and
+// webContents.print(), which used to ask the print backend each time. That
+// takes seconds on Windows networks with many shared printers. The backend
+// is only used on a sequence of its own. A list is used as is for
+// |kMaxAge|, and while it is used it is refreshed in the background, so that
+// callers rarely wait for the backend. Only used on the UI thread.
+class PrinterListCache {
+ public:
+  struct Printers {
+    Printers();
+    Printers(const Printers&);
+    Printers& operator=(const Printers&);
+    ~Printers();
+
+    printing::PrinterList printers;
+    // Empty when the system has no default printer.
+    std::string default_printer;
+    // False when the printers couldn't be enumerated.
+    bool succeeded = false;
+  };
+
+  using PrintersCallback = base::OnceCallback<void(const Printers&)>;
+  // <error, device_name>
+  using DeviceNameCallback =
+      base::OnceCallback<void(std::pair<std::string, std::u16string>)>;
+
+  static constexpr base::TimeDelta kMaxAge = base::Seconds(30);
+
+  static PrinterListCache* GetInstance();
+
+  PrinterListCache();
+  ~PrinterListCache();
+
+  // disable copy
+  PrinterListCache(const PrinterListCache&) = delete;
+  PrinterListCache& operator=(const PrinterListCache&) = delete;
+
+  void GetPrinters(PrintersCallback callback);
+
+  // Resolves the printer webContents.print() prints to: |device_name| when
+  // it is a printer, the default printer when it is empty, or the first
+  // printer when there is no default one.
+  void GetDeviceNameToUse(const std::u16string& device_name,
+                          DeviceNameCallback callback);
+
+ private:
+  void Refresh();
+  void OnRefreshed(Printers printers);
+  void OnRefreshTimer();
+  void OnGotPrintersForDeviceName(const std::u16string& device_name,
+                                  DeviceNameCallback callback,
+                                  const Printers& printers);
+
+  scoped_refptr<base::SequencedTaskRunner> backend_task_runner_;
+
+  absl::optional<Printers> printers_;
+  base::TimeTicks refresh_time_;
+  base::TimeTicks last_use_;
+  bool refreshing_ = false;
+  std::vector<PrintersCallback> pending_callbacks_;
+  base::RepeatingTimer refresh_timer_;
+
+  base::WeakPtrFactory<PrinterListCache> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_PRINTING_PRINTER_LIST_CACHE_H_
@@ -42,20 +42,47 @@ void ProtocolRegistry::RegisterURLLoaderFactories(
     factories->emplace(it.first, ElectronURLLoaderFactory::Create(
                                      it.second.first, it.second.second));
   }
+  for (const auto& it : directory_handlers_)
+    factories->emplace(it.first, DirectoryURLLoaderFactory::Create(it.second));
 }
 
 bool ProtocolRegistry::RegisterProtocol(ProtocolType type,
                                         const std::string& scheme,
                                         const ProtocolHandler& handler) {
+  if (base::Contains(directory_handlers_, scheme))
+    return false;
   return handlers_.try_emplace(scheme, type, handler).second;
 }
 
+bool ProtocolRegistry::RegisterDirectoryProtocol(
+    const std::string& scheme,
+    DirectoryProtocolOptions options) {
+  if (base::Contains(handlers_, scheme))
+    return false;
+  return directory_handlers_
+      .try_emplace(scheme, base::MakeRefCounted<DirectoryProtocol>(
+                               std::move(options)))
+      .second;
+}
+
 bool ProtocolRegistry::UnregisterProtocol(const std::string& scheme) {
-  return handlers_.erase(scheme) != 0;
+  return handlers_.erase(scheme) + directory_handlers_.erase(scheme) != 0;
 }
 
 bool ProtocolRegistry::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(directory_handlers_, scheme);
+}
+
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+ProtocolRegistry::CreateURLLoaderFactory(const std::string& scheme) const {
+  auto it = directory_handlers_.find(scheme);
+  if (it != directory_handlers_.end())
+    return DirectoryURLLoaderFactory::Create(it->second);
+
+  const auto& protocol_handler = handlers_.at(scheme);
+  return ElectronURLLoaderFactory::Create(protocol_handler.first,
+                                          protocol_handler.second);
 }
 
 bool ProtocolRegistry::InterceptProtocol(ProtocolType type,
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "content/public/browser/content_browser_client.h"
+#include "shell/browser/net/directory_url_loader_factory.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
 
 namespace content {
@@ -35,9 +36,16 @@ class ProtocolRegistry {
   bool RegisterProtocol(ProtocolType type,
                         const std::string& scheme,
                         const ProtocolHandler& handler);
+  bool RegisterDirectoryProtocol(const std::string& scheme,
+                                 DirectoryProtocolOptions options);
   bool UnregisterProtocol(const std::string& scheme);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Creates a factory for the registered protocol |scheme|, which must be
+  // registered.
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> CreateURLLoaderFactory(
+      const std::string& scheme) const;
+
   bool InterceptProtocol(ProtocolType type,
                          const std::string& scheme,
                          const ProtocolHandler& handler);
@@ -50,6 +58,7 @@ class ProtocolRegistry {
   ProtocolRegistry();
 
   HandlersMap handlers_;
+  DirectoryProtocolMap directory_handlers_;
   HandlersMap intercept_handlers_;
 };
 
@@ -0,0 +1,236 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/renderer_sharing_manager.h"
+
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+#include "shell/browser/spare_renderer_manager.h"
+
+namespace electron {
+
+namespace {
+
+// The footprints only matter for the memory budget and the savings, which
+// don't need to be more precise than this.
+constexpr base::TimeDelta kSamplingInterval = base::Seconds(15);
+
+}  // namespace
+
+// A page whose renderer the next WebContents of its session can share.
+class RendererSharingManager::Page : public content::WebContentsObserver {
+ public:
+  Page(content::WebContents* web_contents, base::CommandLine command_line)
+      : content::WebContentsObserver(web_contents),
+        command_line_(std::move(command_line)) {}
+  ~Page() override = default;
+
+  // disable copy
+  Page(const Page&) = delete;
+  Page& operator=(const Page&) = delete;
+
+  const base::CommandLine& command_line() const { return command_line_; }
+
+ private:
+  // content::WebContentsObserver:
+  void WebContentsDestroyed() override {
+    content::WebContents* contents = web_contents();
+    // Destroys |this|.
+    RendererSharingManager::GetInstance()->RemovePage(
+        contents->GetBrowserContext(), contents);
+  }
+
+  const base::CommandLine command_line_;
+};
+
+// static
+RendererSharingManager* RendererSharingManager::GetInstance() {
+  static base::NoDestructor<RendererSharingManager> instance;
+  return instance.get();
+}
+
+RendererSharingManager::RendererSharingManager() = default;
+
+RendererSharingManager::~RendererSharingManager() = default;
+
+void RendererSharingManager::SetPolicy(
+    content::BrowserContext* browser_context,
+    const Policy& policy) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  profiles_[browser_context].policy = policy;
+  UpdateSampling();
+}
+
+void RendererSharingManager::ClearPolicy(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = profiles_.find(browser_context);
+  if (it == profiles_.end())
+    return;
+  // The pages stay in the BrowsingInstances they were created in.
+  it->second.policy = Policy();
+  it->second.pages.clear();
+  UpdateSampling();
+}
+
+void RendererSharingManager::RemoveBrowserContext(
+    content::BrowserContext* browser_context) {
+  profiles_.erase(browser_context);
+  UpdateSampling();
+}
+
+scoped_refptr<content::SiteInstance>
+RendererSharingManager::GetSiteInstanceForWebContents(
+    content::BrowserContext* browser_context,
+    const gin_helper::Dictionary& web_preferences) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = profiles_.find(browser_context);
+  if (it == profiles_.end())
+    return nullptr;
+  Profile& profile = it->second;
+  const Policy& policy = profile.policy;
+  if (!policy.max_processes && !policy.memory_budget)
+    return nullptr;
+
+  const auto [process_count, footprint] = MeasureRenderers(browser_context);
+  const bool over_count =
+      policy.max_processes && process_count >= policy.max_processes;
+  const bool over_budget =
+      policy.memory_budget && footprint >= policy.memory_budget;
+  if (!over_count && !over_budget)
+    return nullptr;
+
+  // Windows with other switches can't live in the same renderer.
+  const base::CommandLine command_line =
+      SpareRendererManager::MakeCommandLine(web_preferences);
+  content::WebContents* best = nullptr;
+  uint64_t best_footprint = 0;
+  for (const auto& [contents, page] : profile.pages) {
+    if (page->command_line().argv() != command_line.argv())
+      continue;
+    content::RenderProcessHost* process =
+        contents->GetPrimaryMainFrame()->GetProcess();
+    if (!process->IsInitializedAndNotDead())
+      continue;
+    // The least loaded renderer is shared first.
+    auto process_footprint = footprints_.find(process->GetProcess().Pid());
+    const uint64_t candidate_footprint =
+        process_footprint != footprints_.end() ? process_footprint->second : 0;
+    if (!best || candidate_footprint < best_footprint) {
+      best = contents;
+      best_footprint = candidate_footprint;
+    }
+  }
+  if (!best)
+    return nullptr;
+
+  profile.shared_web_contents++;
+  return best->GetPrimaryMainFrame()->GetSiteInstance();
+}
+
+void RendererSharingManager::AddWebContents(
+    content::WebContents* web_contents,
+    const gin_helper::Dictionary& web_preferences) {
+  auto it = profiles_.find(web_contents->GetBrowserContext());
+  if (it == profiles_.end() || (!it->second.policy.max_processes &&
+                                !it->second.policy.memory_budget)) {
+    return;
+  }
+  it->second.pages[web_contents] = std::make_unique<Page>(
+      web_contents, SpareRendererManager::MakeCommandLine(web_preferences));
+}
+
+RendererSharingManager::Metrics RendererSharingManager::GetMetrics(
+    content::BrowserContext* browser_context) const {
+  Metrics metrics;
+  const auto [process_count, footprint] = MeasureRenderers(browser_context);
+  metrics.process_count = process_count;
+  auto it = profiles_.find(browser_context);
+  if (it != profiles_.end())
+    metrics.shared_web_contents = it->second.shared_web_contents;
+  if (process_count)
+    metrics.estimated_savings =
+        metrics.shared_web_contents * (footprint / process_count);
+  return metrics;
+}
+
+std::pair<size_t, uint64_t> RendererSharingManager::MeasureRenderers(
+    content::BrowserContext* browser_context) const {
+  size_t count = 0;
+  uint64_t footprint = 0;
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    content::RenderProcessHost* host = it.GetCurrentValue();
+    if (host->GetBrowserContext() != browser_context ||
+        !host->IsInitializedAndNotDead()) {
+      continue;
+    }
+    count++;
+    auto process_footprint = footprints_.find(host->GetProcess().Pid());
+    if (process_footprint != footprints_.end())
+      footprint += process_footprint->second;
+  }
+  return {count, footprint};
+}
+
+void RendererSharingManager::RemovePage(
+    content::BrowserContext* browser_context,
+    content::WebContents* web_contents) {
+  auto it = profiles_.find(browser_context);
+  if (it != profiles_.end())
+    it->second.pages.erase(web_contents);
+}
+
+void RendererSharingManager::UpdateSampling() {
+  bool sampling = false;
+  for (const auto& [browser_context, profile] : profiles_) {
+    sampling |= profile.policy.max_processes || profile.policy.memory_budget;
+  }
+  if (!sampling) {
+    sampling_timer_.Stop();
+    footprints_.clear();
+    return;
+  }
+  if (sampling_timer_.IsRunning())
+    return;
+  // Unretained is safe as the manager is never destroyed.
+  sampling_timer_.Start(
+      FROM_HERE, kSamplingInterval,
+      base::BindRepeating(&RendererSharingManager::SampleFootprints,
+                          base::Unretained(this)));
+  SampleFootprints();
+}
+
+void RendererSharingManager::SampleFootprints() {
+  // Only the footprints of the processes are needed, not the allocators.
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDump(
+          {}, base::BindOnce(&RendererSharingManager::OnGlobalDump,
+                             base::Unretained(this)));
+}
+
+void RendererSharingManager::OnGlobalDump(
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  if (!success || !sampling_timer_.IsRunning())
+    return;
+  footprints_.clear();
+  for (const auto& process_dump : dump->process_dumps())
+    footprints_[process_dump.pid()] =
+        process_dump.os_dump().private_footprint_kb;
+}
+
+}  // namespace electron
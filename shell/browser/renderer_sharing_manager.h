@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_RENDERER_SHARING_MANAGER_H_
+#define ELECTRON_SHELL_BROWSER_RENDERER_SHARING_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/containers/flat_map.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/process/process_handle.h"
+#include "base/timer/timer.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+class WebContents;
+}  // namespace content
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
+namespace electron {
+
+// Lets the windows of the sessions which opted in with
+// ses.setRendererSharing() share renderer processes once the session has
+// too many of them, or once they use too much memory. Content can't tell
+// which page a process is picked for when it reuses one, so the decision is
+// made when the WebContents is created: it is put in the BrowsingInstance of
+// a page with a compatible renderer, and same-site pages of a
+// BrowsingInstance share their process. Only used on the UI thread.
+class RendererSharingManager {
+ public:
+  struct Policy {
+    // The number of renderers of the session above which new windows share
+    // one, 0 for no limit.
+    size_t max_processes = 0;
+    // The private footprint, in KB, of the renderers of the session above
+    // which new windows share one, 0 for no limit.
+    uint64_t memory_budget = 0;
+  };
+
+  struct Metrics {
+    size_t process_count = 0;
+    // How many windows were created in the renderer of another one.
+    uint64_t shared_web_contents = 0;
+    // |shared_web_contents| times the average footprint of the session's
+    // renderers, in KB.
+    uint64_t estimated_savings = 0;
+  };
+
+  static RendererSharingManager* GetInstance();
+
+  RendererSharingManager();
+  ~RendererSharingManager();
+
+  // disable copy
+  RendererSharingManager(const RendererSharingManager&) = delete;
+  RendererSharingManager& operator=(const RendererSharingManager&) = delete;
+
+  void SetPolicy(content::BrowserContext* browser_context,
+                 const Policy& policy);
+  void ClearPolicy(content::BrowserContext* browser_context);
+  // Forgets the policy and metrics of a destroyed |browser_context|.
+  void RemoveBrowserContext(content::BrowserContext* browser_context);
+
+  // Returns the SiteInstance to create a WebContents with |web_preferences|
+  // in, so that it shares the renderer of an existing page, or null when it
+  // should get its own.
+  scoped_refptr<content::SiteInstance> GetSiteInstanceForWebContents(
+      content::BrowserContext* browser_context,
+      const gin_helper::Dictionary& web_preferences);
+  // Makes |web_contents| a page that the next ones can share the renderer of.
+  void AddWebContents(content::WebContents* web_contents,
+                      const gin_helper::Dictionary& web_preferences);
+
+  Metrics GetMetrics(content::BrowserContext* browser_context) const;
+
+ private:
+  class Page;
+
+  struct Profile {
+    Policy policy;
+    uint64_t shared_web_contents = 0;
+    std::map<content::WebContents*, std::unique_ptr<Page>> pages;
+  };
+
+  // Returns the number of live renderers of |browser_context| and the sum of
+  // their last measured footprint.
+  std::pair<size_t, uint64_t> MeasureRenderers(
+      content::BrowserContext* browser_context) const;
+  void RemovePage(content::BrowserContext* browser_context,
+                  content::WebContents* web_contents);
+  void UpdateSampling();
+  void SampleFootprints();
+  void OnGlobalDump(
+      bool success,
+      std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump);
+
+  std::map<content::BrowserContext*, Profile> profiles_;
+  // The private footprint of the renderers in KB, by pid.
+  base::flat_map<base::ProcessId, uint64_t> footprints_;
+  base::RepeatingTimer sampling_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_RENDERER_SHARING_MANAGER_H_
@@ -9,6 +9,7 @@
 #include <set>
 #include <vector>
 
+#include "base/containers/queue.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
@@ -17,7 +18,7 @@
 #include "content/public/browser/serial_delegate.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "services/device/public/mojom/serial.mojom-forward.h"
+#include "services/device/public/mojom/serial.mojom.h"
 #include "shell/browser/electron_browser_context.h"
 #include "third_party/blink/public/mojom/serial/serial.mojom.h"
 #include "url/gurl.h"
@@ -79,6 +80,11 @@ class SerialChooserContext : public KeyedService,
 
   device::mojom::SerialPortManager* GetPortManager();
 
+  // Returns the ports kept up to date from the notifications of the port
+  // manager, which are only enumerated by the first call.
+  void GetDevices(
+      device::mojom::SerialPortManager::GetDevicesCallback callback);
+
   void AddPortObserver(PortObserver* observer);
   void RemovePortObserver(PortObserver* observer);
 
@@ -96,6 +102,8 @@ class SerialChooserContext : public KeyedService,
   void OnPortManagerConnectionError();
 
   bool is_initialized_ = false;
+  base::queue<device::mojom::SerialPortManager::GetDevicesCallback>
+      pending_get_devices_requests_;
 
   // Tracks the set of ports to which an origin has access to.
   std::map<url::Origin, std::set<base::UnguessableToken>> ephemeral_ports_;
@@ -0,0 +1,177 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_renderer_manager.h"
+
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/task/single_thread_task_runner.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "shell/browser/web_contents_preferences.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/options_switches.h"
+
+namespace electron {
+
+namespace {
+
+bool HasSameSwitches(const base::CommandLine& a, const base::CommandLine& b) {
+  return a.GetSwitches() == b.GetSwitches() && a.GetArgs() == b.GetArgs();
+}
+
+}  // namespace
+
+SpareRendererManager::ScopedClaim::ScopedClaim(
+    content::BrowserContext* browser_context,
+    const gin_helper::Dictionary& web_preferences)
+    : browser_context_(browser_context),
+      command_line_(MakeCommandLine(web_preferences)) {
+  auto* manager = SpareRendererManager::GetInstance();
+  DCHECK(!manager->claim_);
+  manager->claim_ = this;
+}
+
+SpareRendererManager::ScopedClaim::~ScopedClaim() {
+  auto* manager = SpareRendererManager::GetInstance();
+  manager->claim_ = nullptr;
+  auto it = manager->profiles_.find(browser_context_);
+  if (it == manager->profiles_.end() || !it->second.enabled)
+    return;
+  if (hit_) {
+    it->second.metrics.hits++;
+  } else {
+    it->second.metrics.misses++;
+  }
+  // Keep the spare for the session that is creating WebContents, this also
+  // replaces a spare content discarded without it being destroyed yet.
+  manager->current_context_ = browser_context_;
+  manager->ScheduleWarmup();
+}
+
+// static
+SpareRendererManager* SpareRendererManager::GetInstance() {
+  static base::NoDestructor<SpareRendererManager> instance;
+  return instance.get();
+}
+
+SpareRendererManager::SpareRendererManager() = default;
+
+SpareRendererManager::~SpareRendererManager() = default;
+
+void SpareRendererManager::Enable(
+    content::BrowserContext* browser_context,
+    const gin_helper::Dictionary& web_preferences) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Profile& profile = profiles_[browser_context];
+  profile.command_line = MakeCommandLine(web_preferences);
+  profile.enabled = true;
+  // The current spare may have been launched with other switches.
+  if (current_context_ == browser_context)
+    ForgetSpare();
+  current_context_ = browser_context;
+  ScheduleWarmup();
+}
+
+void SpareRendererManager::Disable(content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = profiles_.find(browser_context);
+  if (it != profiles_.end())
+    it->second.enabled = false;
+  if (current_context_ == browser_context) {
+    ForgetSpare();
+    current_context_ = nullptr;
+  }
+}
+
+void SpareRendererManager::RemoveBrowserContext(
+    content::BrowserContext* browser_context) {
+  Disable(browser_context);
+  profiles_.erase(browser_context);
+}
+
+SpareRendererManager::Metrics SpareRendererManager::GetMetrics(
+    content::BrowserContext* browser_context) const {
+  auto it = profiles_.find(browser_context);
+  return it != profiles_.end() ? it->second.metrics : Metrics();
+}
+
+bool SpareRendererManager::ShouldUseSpareRenderProcessHost(
+    content::BrowserContext* browser_context) {
+  auto it = profiles_.find(browser_context);
+  if (it == profiles_.end() || !it->second.enabled)
+    return true;
+  // The spare was launched with the switches of this session's webPreferences,
+  // only hand it to a WebContents which would have been given the same ones.
+  // Content only keeps one spare, so while ours is alive it is the one offered.
+  if (!claim_ || claim_->browser_context_ != browser_context ||
+      spare_process_id_ == -1 ||
+      !HasSameSwitches(claim_->command_line_, it->second.command_line))
+    return false;
+  claim_->hit_ = true;
+  ForgetSpare();
+  ScheduleWarmup();
+  return true;
+}
+
+void SpareRendererManager::AppendSpareSwitches(
+    int process_id,
+    base::CommandLine* command_line) {
+  if (!warming_context_)
+    return;
+  auto* host = content::RenderProcessHost::FromID(process_id);
+  if (!host || host->GetBrowserContext() != warming_context_)
+    return;
+  const base::CommandLine& switches =
+      profiles_[warming_context_.get()].command_line;
+  command_line->AppendArguments(switches, false);
+  spare_process_id_ = process_id;
+  spare_observation_.Observe(host);
+}
+
+void SpareRendererManager::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  // Content discards the spare when another process is needed for a
+  // different session or configuration, launch a new one.
+  ForgetSpare();
+  ScheduleWarmup();
+}
+
+// static
+base::CommandLine SpareRendererManager::MakeCommandLine(
+    const gin_helper::Dictionary& web_preferences) {
+  base::CommandLine command_line(base::CommandLine::NO_PROGRAM);
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSandbox))
+    command_line.AppendSwitch(switches::kEnableSandbox);
+  WebContentsPreferences::AppendCommandLineSwitchesForPreferences(
+      web_preferences, &command_line);
+  return command_line;
+}
+
+void SpareRendererManager::ScheduleWarmup() {
+  // Not launched right away, since this is called from within content while
+  // it is choosing or discarding a process.
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&SpareRendererManager::Warmup,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void SpareRendererManager::Warmup() {
+  if (!current_context_ || spare_process_id_ != -1)
+    return;
+  auto it = profiles_.find(current_context_);
+  if (it == profiles_.end() || !it->second.enabled)
+    return;
+  warming_context_ = current_context_;
+  content::RenderProcessHost::WarmupSpareRenderProcessHost(current_context_);
+  warming_context_ = nullptr;
+}
+
+void SpareRendererManager::ForgetSpare() {
+  spare_process_id_ = -1;
+  spare_observation_.Reset();
+}
+
+}  // namespace electron
@@ -0,0 +1,123 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SPARE_RENDERER_MANAGER_H_
+#define ELECTRON_SHELL_BROWSER_SPARE_RENDERER_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+
+#include "base/command_line.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace content {
+class BrowserContext;
+class RenderProcessHost;
+}  // namespace content
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace electron {
+
+// Keeps a renderer process launched ahead of time for the sessions which
+// opted in with ses.setSpareRenderer(), so that the next WebContents created
+// with matching webPreferences doesn't have to wait for a renderer to start.
+// Content keeps at most one spare renderer at a time, so the session which
+// configured or claimed it last gets it. Only used on the UI thread.
+class SpareRendererManager : public content::RenderProcessHostObserver {
+ public:
+  struct Metrics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+
+  // Marks the WebContents being created with |web_preferences| as the one
+  // allowed to take the spare renderer of |browser_context|, if the spare
+  // was launched with the same command line. Scopes must not be nested.
+  class ScopedClaim {
+   public:
+    ScopedClaim(content::BrowserContext* browser_context,
+                const gin_helper::Dictionary& web_preferences);
+    ~ScopedClaim();
+
+    // disable copy
+    ScopedClaim(const ScopedClaim&) = delete;
+    ScopedClaim& operator=(const ScopedClaim&) = delete;
+
+   private:
+    friend class SpareRendererManager;
+
+    raw_ptr<content::BrowserContext> browser_context_;
+    base::CommandLine command_line_;
+    bool hit_ = false;
+  };
+
+  static SpareRendererManager* GetInstance();
+
+  // The switches of the renderer of a WebContents created with
+  // |web_preferences|, with those inherited from the browser process that
+  // WebContentsPreferences looks at.
+  static base::CommandLine MakeCommandLine(
+      const gin_helper::Dictionary& web_preferences);
+
+  SpareRendererManager();
+  ~SpareRendererManager() override;
+
+  // disable copy
+  SpareRendererManager(const SpareRendererManager&) = delete;
+  SpareRendererManager& operator=(const SpareRendererManager&) = delete;
+
+  // Launches a spare renderer for WebContents created with |web_preferences|
+  // in |browser_context|, replacing any previous configuration.
+  void Enable(content::BrowserContext* browser_context,
+              const gin_helper::Dictionary& web_preferences);
+  void Disable(content::BrowserContext* browser_context);
+  // Forgets the configuration and metrics of a destroyed |browser_context|.
+  void RemoveBrowserContext(content::BrowserContext* browser_context);
+
+  Metrics GetMetrics(content::BrowserContext* browser_context) const;
+
+  // ElectronBrowserClient:
+  bool ShouldUseSpareRenderProcessHost(
+      content::BrowserContext* browser_context);
+  // Appends the configured switches when |process_id| is the spare renderer
+  // being launched, which has no WebContents to take them from yet.
+  void AppendSpareSwitches(int process_id, base::CommandLine* command_line);
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+ private:
+  struct Profile {
+    base::CommandLine command_line{base::CommandLine::NO_PROGRAM};
+    bool enabled = false;
+    Metrics metrics;
+  };
+
+  void ScheduleWarmup();
+  void Warmup();
+  void ForgetSpare();
+
+  std::map<content::BrowserContext*, Profile> profiles_;
+  // The session the spare renderer is kept for.
+  raw_ptr<content::BrowserContext> current_context_ = nullptr;
+  // Set while content launches the spare renderer.
+  raw_ptr<content::BrowserContext> warming_context_ = nullptr;
+  raw_ptr<ScopedClaim> claim_ = nullptr;
+  int spare_process_id_ = -1;
+  base::ScopedObservation<content::RenderProcessHost,
+                          content::RenderProcessHostObserver>
+      spare_observation_{this};
+
+  base::WeakPtrFactory<SpareRendererManager> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SPARE_RENDERER_MANAGER_H_
@@ -0,0 +1,118 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_utility_process_manager.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/task/single_thread_task_runner.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/service_process_host.h"
+
+namespace electron {
+
+SpareUtilityProcessManager::Spare::Spare() = default;
+SpareUtilityProcessManager::Spare::Spare(Spare&&) = default;
+SpareUtilityProcessManager::Spare& SpareUtilityProcessManager::Spare::operator=(
+    Spare&&) = default;
+SpareUtilityProcessManager::Spare::~Spare() = default;
+
+// static
+SpareUtilityProcessManager* SpareUtilityProcessManager::GetInstance() {
+  static base::NoDestructor<SpareUtilityProcessManager> instance;
+  return instance.get();
+}
+
+SpareUtilityProcessManager::SpareUtilityProcessManager() = default;
+
+SpareUtilityProcessManager::~SpareUtilityProcessManager() = default;
+
+void SpareUtilityProcessManager::SetCount(size_t count) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  count_ = count;
+  // Dropping the remote shuts the process down, the newest spares go first
+  // since they are the least likely to be ready.
+  while (spares_.size() > count_)
+    spares_.erase(std::prev(spares_.end()));
+  ScheduleWarmup();
+}
+
+absl::optional<SpareUtilityProcessManager::Spare>
+SpareUtilityProcessManager::TakeSpare() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (auto it = spares_.begin(); it != spares_.end(); ++it) {
+    if (!it->second.process.IsValid())
+      continue;
+    Spare spare = std::move(it->second);
+    spares_.erase(it);
+    ScheduleWarmup();
+    return spare;
+  }
+  return absl::nullopt;
+}
+
+void SpareUtilityProcessManager::RecordLaunch(base::TimeDelta launch_time,
+                                              bool spare) {
+  if (spare) {
+    metrics_.spare_launches++;
+    metrics_.spare_launch_time += launch_time;
+  } else {
+    metrics_.cold_launches++;
+    metrics_.cold_launch_time += launch_time;
+  }
+}
+
+void SpareUtilityProcessManager::ScheduleWarmup() {
+  // Not launched right away, so that replacing a claimed spare doesn't slow
+  // down the fork() which claimed it.
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&SpareUtilityProcessManager::Warmup,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void SpareUtilityProcessManager::Warmup() {
+  while (spares_.size() < count_) {
+    const int id = next_id_++;
+    Spare& spare = spares_[id];
+    // The same options as a fork() without any, see
+    // UtilityProcessWrapper::CanUseSpare().
+    content::ServiceProcessHost::Launch(
+        spare.node_service.BindNewPipeAndPassReceiver(),
+        content::ServiceProcessHost::Options()
+            .WithDisplayName(u"Node Utility Process")
+            .WithProcessCallback(
+                base::BindOnce(&SpareUtilityProcessManager::OnSpareLaunched,
+                               weak_factory_.GetWeakPtr(), id))
+            .Pass());
+    spare.node_service.set_disconnect_handler(
+        base::BindOnce(&SpareUtilityProcessManager::OnSpareDisconnected,
+                       weak_factory_.GetWeakPtr(), id));
+    spare.node_service->Warmup();
+  }
+}
+
+void SpareUtilityProcessManager::OnSpareLaunched(int id,
+                                                 const base::Process& process) {
+  auto it = spares_.find(id);
+  if (it != spares_.end())
+    it->second.process = process.Duplicate();
+}
+
+void SpareUtilityProcessManager::OnSpareDisconnected(int id) {
+  auto it = spares_.find(id);
+  if (it == spares_.end())
+    return;
+  // The spare crashed or was killed before being claimed. One which failed to
+  // launch isn't replaced, so that a broken setup doesn't launch processes in
+  // a loop.
+  const bool launched = it->second.process.IsValid();
+  spares_.erase(it);
+  if (launched)
+    ScheduleWarmup();
+}
+
+}  // namespace electron
@@ -0,0 +1,84 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_MANAGER_H_
+#define ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+
+#include "base/memory/weak_ptr.h"
+#include "base/process/process.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace electron {
+
+// Keeps utility processes launched ahead of time, with V8 and Node.js already
+// initialized, so that utilityProcess.fork() only has to load the entry
+// script. Spares are launched with the default options, and only the forks
+// which use them can claim one, see UtilityProcessWrapper. Only used on the
+// UI thread.
+class SpareUtilityProcessManager {
+ public:
+  struct Spare {
+    Spare();
+    Spare(Spare&&);
+    Spare& operator=(Spare&&);
+    ~Spare();
+
+    mojo::Remote<node::mojom::NodeService> node_service;
+    base::Process process;
+  };
+
+  // The time from fork() until the entry script was loaded, for the forks
+  // which claimed a spare and for those which launched their own process.
+  struct Metrics {
+    uint64_t spare_launches = 0;
+    uint64_t cold_launches = 0;
+    base::TimeDelta spare_launch_time;
+    base::TimeDelta cold_launch_time;
+  };
+
+  static SpareUtilityProcessManager* GetInstance();
+
+  SpareUtilityProcessManager();
+  ~SpareUtilityProcessManager();
+
+  // disable copy
+  SpareUtilityProcessManager(const SpareUtilityProcessManager&) = delete;
+  SpareUtilityProcessManager& operator=(const SpareUtilityProcessManager&) =
+      delete;
+
+  // Keeps |count| spares, 0 to stop keeping any. Extra spares are shut down.
+  void SetCount(size_t count);
+  size_t count() const { return count_; }
+
+  // Returns a spare whose process has launched, if there is one, and launches
+  // another one to replace it.
+  absl::optional<Spare> TakeSpare();
+
+  void RecordLaunch(base::TimeDelta launch_time, bool spare);
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  void ScheduleWarmup();
+  void Warmup();
+  void OnSpareLaunched(int id, const base::Process& process);
+  void OnSpareDisconnected(int id);
+
+  size_t count_ = 0;
+  int next_id_ = 0;
+  // The spares by launch order, the oldest are claimed first.
+  std::map<int, Spare> spares_;
+  Metrics metrics_;
+
+  base::WeakPtrFactory<SpareUtilityProcessManager> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SPARE_UTILITY_PROCESS_MANAGER_H_
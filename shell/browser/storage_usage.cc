@@ -0,0 +1,142 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/storage_usage.h"
+
+#include <map>
+#include <set>
+#include <utility>
+
+#include "base/barrier_callback.h"
+#include "base/functional/bind.h"
+#include "base/task/bind_post_task.h"
+#include "components/services/storage/public/mojom/local_storage_control.mojom.h"
+#include "components/services/storage/public/mojom/storage_usage_info.mojom.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "storage/browser/quota/quota_manager.h"
+#include "third_party/blink/public/common/storage_key/storage_key.h"
+#include "third_party/blink/public/mojom/quota/quota_types.mojom.h"
+
+namespace electron {
+
+namespace {
+
+using LocalStorageUsage = std::map<url::Origin, int64_t>;
+
+void OnUsageAndQuota(url::Origin origin,
+                     base::OnceCallback<void(StorageUsage)> callback,
+                     blink::mojom::QuotaStatusCode status,
+                     int64_t usage,
+                     int64_t quota,
+                     blink::mojom::UsageBreakdownPtr breakdown) {
+  StorageUsage result;
+  result.origin = std::move(origin);
+  // An origin the quota manager can't measure is reported as empty.
+  if (status == blink::mojom::QuotaStatusCode::kOk) {
+    result.total = usage;
+    result.quota = quota;
+    result.indexed_db = breakdown->indexed_database;
+    result.cache_storage = breakdown->service_worker_cache;
+    result.service_workers = breakdown->service_worker;
+    result.file_system = breakdown->file_system;
+  }
+  std::move(callback).Run(std::move(result));
+}
+
+void MeasureOnIOThread(scoped_refptr<storage::QuotaManager> quota_manager,
+                       std::vector<url::Origin> origins,
+                       StorageUsageCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  auto barrier =
+      base::BarrierCallback<StorageUsage>(origins.size(), std::move(callback));
+  for (auto& origin : origins) {
+    const auto storage_key = blink::StorageKey::CreateFirstParty(origin);
+    quota_manager->GetUsageAndQuotaWithBreakdown(
+        storage_key, blink::mojom::StorageType::kTemporary,
+        base::BindOnce(&OnUsageAndQuota, std::move(origin), barrier));
+  }
+}
+
+void GetQuotaUsageOnIOThread(scoped_refptr<storage::QuotaManager> quota_manager,
+                             std::vector<url::Origin> origins,
+                             bool all_origins,
+                             StorageUsageCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!all_origins) {
+    MeasureOnIOThread(std::move(quota_manager), std::move(origins),
+                      std::move(callback));
+    return;
+  }
+  // |origins| holds the ones which only have localStorage.
+  storage::QuotaManager* manager = quota_manager.get();
+  manager->GetStorageKeysForType(
+      blink::mojom::StorageType::kTemporary,
+      base::BindOnce(
+          [](scoped_refptr<storage::QuotaManager> quota_manager,
+             std::vector<url::Origin> origins, StorageUsageCallback callback,
+             const std::set<blink::StorageKey>& storage_keys) {
+            std::set<url::Origin> all(origins.begin(), origins.end());
+            for (const auto& storage_key : storage_keys)
+              all.insert(storage_key.origin());
+            MeasureOnIOThread(std::move(quota_manager),
+                              std::vector<url::Origin>(all.begin(), all.end()),
+                              std::move(callback));
+          },
+          std::move(quota_manager), std::move(origins), std::move(callback)));
+}
+
+void OnQuotaUsage(LocalStorageUsage local_storage,
+                  StorageUsageCallback callback,
+                  std::vector<StorageUsage> usages) {
+  for (auto& usage : usages) {
+    auto it = local_storage.find(usage.origin);
+    if (it == local_storage.end())
+      continue;
+    usage.local_storage = it->second;
+    usage.total += it->second;
+  }
+  std::move(callback).Run(std::move(usages));
+}
+
+void OnLocalStorageUsage(
+    scoped_refptr<storage::QuotaManager> quota_manager,
+    std::vector<url::Origin> origins,
+    StorageUsageCallback callback,
+    std::vector<storage::mojom::StorageUsageInfoPtr> infos) {
+  LocalStorageUsage local_storage;
+  // The keys of the third-party frames count towards their origin.
+  for (const auto& info : infos)
+    local_storage[info->storage_key.origin()] += info->total_size_bytes;
+
+  const bool all_origins = origins.empty();
+  if (all_origins) {
+    for (const auto& [origin, size] : local_storage)
+      origins.push_back(origin);
+  }
+  content::GetIOThreadTaskRunner({})->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          &GetQuotaUsageOnIOThread, std::move(quota_manager),
+          std::move(origins), all_origins,
+          base::BindPostTask(
+              content::GetUIThreadTaskRunner({}),
+              base::BindOnce(&OnQuotaUsage, std::move(local_storage),
+                             std::move(callback)))));
+}
+
+}  // namespace
+
+void GetStorageUsage(content::StoragePartition* storage_partition,
+                     std::vector<url::Origin> origins,
+                     StorageUsageCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  storage_partition->GetLocalStorageControl()->GetUsage(base::BindOnce(
+      &OnLocalStorageUsage,
+      base::WrapRefCounted(storage_partition->GetQuotaManager()),
+      std::move(origins), std::move(callback)));
+}
+
+}  // namespace electron
@@ -0,0 +1,46 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_STORAGE_USAGE_H_
+#define ELECTRON_SHELL_BROWSER_STORAGE_USAGE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/functional/callback_forward.h"
+#include "url/origin.h"
+
+namespace content {
+class StoragePartition;
+}
+
+namespace electron {
+
+// The bytes used by an origin, by kind of storage. |total| includes the
+// kinds that aren't broken down.
+struct StorageUsage {
+  url::Origin origin;
+  int64_t total = 0;
+  int64_t quota = 0;
+  int64_t indexed_db = 0;
+  int64_t cache_storage = 0;
+  int64_t service_workers = 0;
+  int64_t file_system = 0;
+  int64_t local_storage = 0;
+};
+
+using StorageUsageCallback =
+    base::OnceCallback<void(std::vector<StorageUsage>)>;
+
+// Measures the storage of |origins| in |storage_partition|, or of all the
+// origins which have data when |origins| is empty. The quota managed kinds
+// are read from the quota manager, on the IO thread, and localStorage from
+// its backend. Must be called on the UI thread, |callback| runs on it.
+void GetStorageUsage(content::StoragePartition* storage_partition,
+                     std::vector<url::Origin> origins,
+                     StorageUsageCallback callback);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_STORAGE_USAGE_H_
@@ -0,0 +1,353 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/structured_log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/auto_reset.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_local.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "shell/common/shared_ring_buffer.h"
+
+namespace electron {
+
+namespace {
+
+// Per thread, so that a thread logging heavily can't make the others drop
+// records.
+constexpr size_t kThreadBufferCapacity = 256 * 1024;
+
+// The output is written out whenever it grows past this size.
+constexpr size_t kMaxPendingOutput = 1024 * 1024;
+
+// Written in host byte order, which is little endian on every platform
+// Electron supports. The message and then the fields follow.
+struct RecordHeader {
+  // Microseconds since the Unix epoch.
+  int64_t time;
+  int32_t severity;
+  uint32_t thread_id;
+  uint32_t message_size;
+  uint32_t fields_size;
+  uint8_t source;
+  uint8_t reserved[7];
+};
+static_assert(sizeof(RecordHeader) == 32, "RecordHeader must not be padded");
+
+const char* SeverityName(int severity) {
+  switch (severity) {
+    case logging::LOGGING_INFO:
+      return "info";
+    case logging::LOGGING_WARNING:
+      return "warn";
+    case logging::LOGGING_ERROR:
+      return "error";
+    case logging::LOGGING_FATAL:
+      return "fatal";
+    default:
+      return "debug";
+  }
+}
+
+}  // namespace
+
+struct StructuredLog::ThreadBuffer {
+  std::unique_ptr<SharedRingBuffer> producer;
+  std::unique_ptr<SharedRingBuffer> consumer;
+  // Only used by the thread owning the buffer.
+  std::vector<uint8_t> scratch;
+  bool writing = false;
+};
+
+// static
+StructuredLog* StructuredLog::GetInstance() {
+  static base::NoDestructor<StructuredLog> instance;
+  return instance.get();
+}
+
+StructuredLog::StructuredLog()
+    : task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {}
+
+StructuredLog::~StructuredLog() = default;
+
+void StructuredLog::Start(const base::FilePath& path, const Options& options) {
+  if (options.capture_chromium_logs)
+    logging::SetLogMessageHandler(&StructuredLog::OnLogMessage);
+  else if (logging::GetLogMessageHandler() == &StructuredLog::OnLogMessage)
+    logging::SetLogMessageHandler(nullptr);
+
+  // The records written so far belong to the previous file, if any.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](StructuredLog* self, const base::FilePath& path,
+                        const Options& options) {
+                       self->Drain();
+                       self->CloseFile();
+                       self->OpenFile(path, options);
+                     },
+                     base::Unretained(this), path, options));
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void StructuredLog::Stop() {
+  if (logging::GetLogMessageHandler() == &StructuredLog::OnLogMessage)
+    logging::SetLogMessageHandler(nullptr);
+  enabled_.store(false, std::memory_order_relaxed);
+  task_runner_->PostTask(FROM_HERE, base::BindOnce(
+                                        [](StructuredLog* self) {
+                                          self->Drain();
+                                          self->CloseFile();
+                                        },
+                                        base::Unretained(this)));
+}
+
+void StructuredLog::Write(int severity,
+                          Source source,
+                          base::StringPiece message,
+                          base::StringPiece fields) {
+  if (!is_enabled())
+    return;
+  ThreadBuffer* buffer = GetThreadBuffer();
+  // Nothing in here should log, but a LOG() while writing would otherwise
+  // corrupt the scratch buffer.
+  if (!buffer || buffer->writing)
+    return;
+  base::AutoReset<bool> writing(&buffer->writing, true);
+
+  RecordHeader header = {};
+  header.time = (base::Time::Now() - base::Time::UnixEpoch()).InMicroseconds();
+  header.severity = severity;
+  header.thread_id = static_cast<uint32_t>(base::PlatformThread::CurrentId());
+  header.message_size = static_cast<uint32_t>(message.size());
+  header.fields_size = static_cast<uint32_t>(fields.size());
+  header.source = static_cast<uint8_t>(source);
+
+  buffer->scratch.assign(message.begin(), message.end());
+  buffer->scratch.insert(buffer->scratch.end(), fields.begin(), fields.end());
+  if (!buffer->producer->Write(base::as_bytes(base::make_span(&header, 1u)),
+                               buffer->scratch)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (buffer->producer->TakeReaderWaiting()) {
+    task_runner_->PostTask(FROM_HERE, base::BindOnce(&StructuredLog::Drain,
+                                                     base::Unretained(this)));
+  }
+}
+
+void StructuredLog::Flush(base::OnceClosure callback) {
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::BindOnce(&StructuredLog::Drain, base::Unretained(this)),
+      std::move(callback));
+}
+
+// static
+bool StructuredLog::OnLogMessage(int severity,
+                                 const char* file,
+                                 int line,
+                                 size_t message_start,
+                                 const std::string& str) {
+  base::StringPiece message(str);
+  message.remove_prefix(std::min(message_start, message.size()));
+  message = base::TrimWhitespaceASCII(message, base::TRIM_TRAILING);
+
+  base::Value::Dict fields;
+  if (file)
+    fields.Set("file", file);
+  fields.Set("line", line);
+  std::string fields_json;
+  base::JSONWriter::Write(fields, &fields_json);
+
+  GetInstance()->Write(severity, Source::kChromium, message, fields_json);
+  // Let Chromium log it as usual as well.
+  return false;
+}
+
+StructuredLog::ThreadBuffer* StructuredLog::GetThreadBuffer() {
+  static base::NoDestructor<base::ThreadLocalPointer<ThreadBuffer>> tls;
+  if (ThreadBuffer* buffer = tls->Get())
+    return buffer;
+
+  auto buffer = std::make_unique<ThreadBuffer>();
+  base::UnsafeSharedMemoryRegion region;
+  buffer->producer = SharedRingBuffer::Create(kThreadBufferCapacity, &region);
+  if (!buffer->producer)
+    return nullptr;
+  buffer->consumer = SharedRingBuffer::Attach(std::move(region));
+  if (!buffer->consumer)
+    return nullptr;
+  // The writer isn't draining the new buffer yet, so the first record has to
+  // wake it up.
+  buffer->consumer->PrepareToWait();
+
+  ThreadBuffer* raw_buffer = buffer.get();
+  {
+    base::AutoLock auto_lock(lock_);
+    buffers_.push_back(std::move(buffer));
+  }
+  tls->Set(raw_buffer);
+  return raw_buffer;
+}
+
+void StructuredLog::Drain() {
+  std::vector<SharedRingBuffer*> consumers;
+  {
+    base::AutoLock auto_lock(lock_);
+    for (const auto& buffer : buffers_)
+      consumers.push_back(buffer->consumer.get());
+  }
+
+  std::string output;
+  std::vector<uint8_t> record;
+  bool pending = true;
+  while (pending) {
+    pending = false;
+    for (SharedRingBuffer* consumer : consumers) {
+      while (consumer->Read(&record)) {
+        AppendRecord(record, &output);
+        if (output.size() > kMaxPendingOutput) {
+          WriteOutput(output);
+          output.clear();
+        }
+      }
+      // Records written since the last read have to be drained now, as their
+      // writer didn't see the reader waiting.
+      if (!consumer->PrepareToWait())
+        pending = true;
+    }
+  }
+
+  if (uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+    const std::string message = base::NumberToString(dropped) +
+                                " log records were dropped because the "
+                                "buffer of their thread was full";
+    const std::string fields =
+        "{\"dropped\":" + base::NumberToString(dropped) + "}";
+    RecordHeader header = {};
+    header.time =
+        (base::Time::Now() - base::Time::UnixEpoch()).InMicroseconds();
+    header.severity = logging::LOGGING_WARNING;
+    header.thread_id = static_cast<uint32_t>(base::PlatformThread::CurrentId());
+    header.message_size = static_cast<uint32_t>(message.size());
+    header.fields_size = static_cast<uint32_t>(fields.size());
+    header.source = static_cast<uint8_t>(Source::kApp);
+    record.resize(sizeof(header));
+    memcpy(record.data(), &header, sizeof(header));
+    record.insert(record.end(), message.begin(), message.end());
+    record.insert(record.end(), fields.begin(), fields.end());
+    AppendRecord(record, &output);
+  }
+
+  WriteOutput(output);
+}
+
+void StructuredLog::OpenFile(const base::FilePath& path,
+                             const Options& options) {
+  path_ = path;
+  options_ = options;
+  file_ = base::File(path_, base::File::FLAG_OPEN_ALWAYS |
+                                base::File::FLAG_APPEND);
+  if (!file_.IsValid())
+    return;
+  file_size_ = std::max<int64_t>(file_.GetLength(), 0);
+  if (options_.format == Format::kBinary && file_size_ == 0) {
+    file_.WriteAtCurrentPos(kBinaryMagic, 8);
+    file_size_ = 8;
+  }
+}
+
+void StructuredLog::CloseFile() {
+  file_.Close();
+  file_size_ = 0;
+}
+
+void StructuredLog::AppendRecord(const std::vector<uint8_t>& record,
+                                 std::string* output) {
+  RecordHeader header;
+  if (record.size() < sizeof(header))
+    return;
+  memcpy(&header, record.data(), sizeof(header));
+  if (record.size() !=
+      sizeof(header) + size_t{header.message_size} + header.fields_size) {
+    return;
+  }
+
+  if (options_.format == Format::kBinary) {
+    const uint32_t size = static_cast<uint32_t>(record.size());
+    output->append(reinterpret_cast<const char*>(&size), sizeof(size));
+    output->append(record.begin(), record.end());
+    return;
+  }
+
+  const char* data = reinterpret_cast<const char*>(record.data());
+  base::StringPiece message(data + sizeof(header), header.message_size);
+  base::StringPiece fields(data + sizeof(header) + header.message_size,
+                           header.fields_size);
+
+  base::Value::Dict line;
+  line.Set("time", header.time / 1000.0);
+  line.Set("level", SeverityName(header.severity));
+  line.Set("source", header.source == static_cast<uint8_t>(Source::kChromium)
+                         ? "chromium"
+                         : "app");
+  line.Set("thread", static_cast<double>(header.thread_id));
+  // Chromium's messages aren't always valid UTF-8.
+  line.Set("message", base::IsStringUTF8AllowingNoncharacters(message)
+                          ? std::string(message)
+                          : base::UTF16ToUTF8(base::UTF8ToUTF16(message)));
+  std::string json;
+  base::JSONWriter::Write(line, &json);
+  // The fields are already JSON, splice them in instead of parsing them.
+  if (!fields.empty()) {
+    json.pop_back();
+    json.append(",\"fields\":");
+    json.append(fields.begin(), fields.end());
+    json.push_back('}');
+  }
+  output->append(json);
+  output->push_back('\n');
+}
+
+void StructuredLog::WriteOutput(const std::string& output) {
+  if (output.empty() || !file_.IsValid())
+    return;
+  if (file_size_ + output.size() > options_.max_size && file_size_ > 0)
+    Rotate();
+  if (!file_.IsValid())
+    return;
+  if (file_.WriteAtCurrentPos(output.data(), output.size()) > 0)
+    file_size_ += output.size();
+}
+
+void StructuredLog::Rotate() {
+  file_.Close();
+  for (int i = options_.max_files - 1; i > 0; --i) {
+    base::FilePath from =
+        i == 1 ? path_ : path_.AddExtensionASCII(base::NumberToString(i - 1));
+    base::ReplaceFile(from, path_.AddExtensionASCII(base::NumberToString(i)),
+                      nullptr);
+  }
+  // Without old files to keep, the current one starts over.
+  base::DeleteFile(path_);
+  OpenFile(path_, options_);
+}
+
+}  // namespace electron
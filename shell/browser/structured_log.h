@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_STRUCTURED_LOG_H_
+#define ELECTRON_SHELL_BROWSER_STRUCTURED_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback_forward.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/thread_annotations.h"
+
+namespace electron {
+
+class SharedRingBuffer;
+
+// The log file written by app.setLogFile(). Records can be written from any
+// thread of the browser process without taking a lock or touching the disk:
+// each thread appends to its own SharedRingBuffer and a background sequence
+// drains the buffers into the file. When a buffer is full the record is
+// dropped rather than waiting for the writer, and the number of dropped
+// records is logged once there is space again.
+//
+// Records of one thread are written in order, records of different threads
+// are ordered by when the writer got to them and carry their own timestamp.
+class StructuredLog {
+ public:
+  enum class Format { kJSON, kBinary };
+
+  enum class Source : uint8_t { kChromium = 0, kApp = 1 };
+
+  struct Options {
+    Format format = Format::kJSON;
+    // The file is rotated once it grows past this size, keeping up to
+    // |max_files| - 1 old files named <path>.1, <path>.2, etc.
+    uint64_t max_size = 10 * 1024 * 1024;
+    int max_files = 3;
+    // Also record the messages of Chromium's LOG() macros.
+    bool capture_chromium_logs = false;
+  };
+
+  // Binary files start with these 8 bytes, followed by the records. The layout
+  // of a record is documented with app.setLogFile().
+  static constexpr char kBinaryMagic[] = "ELOG\x01\x00\x00\x00";
+
+  static StructuredLog* GetInstance();
+
+  StructuredLog();
+  ~StructuredLog();
+
+  // disable copy
+  StructuredLog(const StructuredLog&) = delete;
+  StructuredLog& operator=(const StructuredLog&) = delete;
+
+  // Starts writing to |path|, after flushing the records meant for the
+  // previous file. Only called on the UI thread.
+  void Start(const base::FilePath& path, const Options& options);
+  void Stop();
+
+  bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Can be called from any thread. |fields| is a JSON object or empty.
+  void Write(int severity,
+             Source source,
+             base::StringPiece message,
+             base::StringPiece fields);
+
+  // Runs |callback| on the calling sequence once the records written so far
+  // are in the file.
+  void Flush(base::OnceClosure callback);
+
+ private:
+  struct ThreadBuffer;
+
+  static bool OnLogMessage(int severity,
+                           const char* file,
+                           int line,
+                           size_t message_start,
+                           const std::string& str);
+
+  ThreadBuffer* GetThreadBuffer();
+
+  // Runs on |task_runner_|.
+  void Drain();
+  void OpenFile(const base::FilePath& path, const Options& options);
+  void CloseFile();
+  void AppendRecord(const std::vector<uint8_t>& record, std::string* output);
+  void WriteOutput(const std::string& output);
+  void Rotate();
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> dropped_{0};
+
+  base::Lock lock_;
+  // Never freed, a thread may be in the middle of writing to its buffer while
+  // the log is stopped.
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_ GUARDED_BY(lock_);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Only used on |task_runner_|.
+  base::File file_;
+  base::FilePath path_;
+  Options options_;
+  uint64_t file_size_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_STRUCTURED_LOG_H_
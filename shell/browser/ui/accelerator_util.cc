@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
@@ -18,6 +19,15 @@
 
 namespace accelerator_util {
 
+size_t AcceleratorHash::operator()(const ui::Accelerator& accelerator) const {
+  const uint32_t key =
+      static_cast<uint32_t>(accelerator.key_code()) << 1 |
+      (accelerator.key_state() == ui::Accelerator::KeyState::RELEASED);
+  const uint32_t modifiers = static_cast<uint32_t>(
+      ui::Accelerator::MaskOutKeyEventFlags(accelerator.modifiers()));
+  return base::HashInts(key, modifiers);
+}
+
 bool StringToAccelerator(const std::string& shortcut,
                          ui::Accelerator* accelerator) {
   if (!base::IsStringASCII(shortcut)) {
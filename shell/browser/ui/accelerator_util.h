@@ -5,20 +5,31 @@
 #ifndef ELECTRON_SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 #define ELECTRON_SHELL_BROWSER_UI_ACCELERATOR_UTIL_H_
 
-#include <map>
 #include <string>
 
 #include "base/memory/raw_ptr.h"
 #include "shell/browser/ui/electron_menu_model.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
 #include "ui/base/accelerators/accelerator.h"
 
 namespace accelerator_util {
 
+// Hashes the key code, key state and modifiers of an accelerator, which are
+// what ui::Accelerator compares.
+struct AcceleratorHash {
+  size_t operator()(const ui::Accelerator& accelerator) const;
+};
+
+// Maps accelerators to |T|, for the lookups done on every key event.
+template <typename T>
+using AcceleratorIndex =
+    absl::flat_hash_map<ui::Accelerator, T, AcceleratorHash>;
+
 typedef struct {
   size_t position;
   raw_ptr<electron::ElectronMenuModel> model;
 } MenuItem;
-typedef std::map<ui::Accelerator, MenuItem> AcceleratorTable;
+typedef AcceleratorIndex<MenuItem> AcceleratorTable;
 
 // Parse a string as an accelerator.
 bool StringToAccelerator(const std::string& shortcut,
@@ -8,13 +8,16 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <memory>
+
 #include "base/functional/callback.h"
 #include "base/mac/scoped_nsobject.h"
 #include "base/memory/weak_ptr.h"
 
 namespace electron {
+class ElectronMenuControllerObserver;
 class ElectronMenuModel;
-}
+}  // namespace electron
 
 // A controller for the cross-platform menu model. The menu that's created
 // has the tag and represented object set for each menu item. The object is a
@@ -30,10 +33,13 @@ class ElectronMenuModel;
   BOOL isMenuOpen_;
   BOOL useDefaultAccelerator_;
   base::OnceClosure closeCallback;
+  std::unique_ptr<electron::ElectronMenuControllerObserver> modelObserver_;
 }
 
-// Builds a NSMenu from the pre-built model (must not be nil). Changes made
-// to the contents of the model after calling this will not be noticed.
+// Builds a NSMenu from the pre-built model (must not be nil). Items added to
+// or removed from the model after calling this will not be noticed, but the
+// changes of the items the model notifies its observers of are applied to
+// the menu in place.
 - (id)initWithModel:(electron::ElectronMenuModel*)model
     useDefaultAccelerator:(BOOL)use;
 
@@ -56,6 +62,11 @@ class ElectronMenuModel;
     makeMenuItemForIndex:(NSInteger)index
                fromModel:(electron::ElectronMenuModel*)model;
 
+// Updates the item at |index| of |menu|, which was built from |model|.
+- (void)updateItemAtIndex:(NSInteger)index
+                   inMenu:(NSMenu*)menu
+                fromModel:(electron::ElectronMenuModel*)model;
+
 // Whether the menu is currently open.
 - (BOOL)isMenuOpen;
 
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/mac/foundation_util.h"
@@ -82,15 +83,20 @@ bool MenuHasVisibleItems(const electron::ElectronMenuModel* model) {
   return false;
 }
 
+// Inserts a disabled menu item labeled "(empty)" into |menu|.
+void AddEmptyMenuItem(NSMenu* menu) {
+  NSString* empty_menu_title =
+      l10n_util::GetNSString(IDS_APP_MENU_EMPTY_SUBMENU);
+
+  [menu addItemWithTitle:empty_menu_title action:NULL keyEquivalent:@""];
+  [[menu itemAtIndex:[menu numberOfItems] - 1] setEnabled:NO];
+}
+
 // Called when an empty submenu is created. This inserts a menu item labeled
 // "(empty)" into the submenu. Matches Windows behavior.
 NSMenu* MakeEmptySubmenu() {
   base::scoped_nsobject<NSMenu> submenu([[NSMenu alloc] initWithTitle:@""]);
-  NSString* empty_menu_title =
-      l10n_util::GetNSString(IDS_APP_MENU_EMPTY_SUBMENU);
-
-  [submenu addItemWithTitle:empty_menu_title action:NULL keyEquivalent:@""];
-  [[submenu itemAtIndex:0] setEnabled:NO];
+  AddEmptyMenuItem(submenu);
   return submenu.autorelease();
 }
 
@@ -152,6 +158,108 @@ NSArray* ConvertSharingItemToNS(const SharingItem& item) {
 
 @end
 
+// A submenu of a context menu, whose items are only made the first time it
+// opens. Context menus don't match key equivalents, so nothing needs them
+// before.
+@interface ElectronLazySubmenu : NSMenu
+@property(nonatomic, assign) BOOL populated;
+@property(nonatomic, assign) BOOL shown;
+- (instancetype)initWithModel:(electron::ElectronMenuModel*)model;
+- (electron::ElectronMenuModel*)model;
+@end
+
+@implementation ElectronLazySubmenu {
+  base::WeakPtr<electron::ElectronMenuModel> _model;
+}
+
+- (instancetype)initWithModel:(electron::ElectronMenuModel*)model {
+  if ((self = [super initWithTitle:@""])) {
+    _model = model->GetWeakPtr();
+  }
+  return self;
+}
+
+- (electron::ElectronMenuModel*)model {
+  return _model.get();
+}
+
+@end
+
+namespace {
+
+// The lazy submenus point to the controller which made them.
+void ResetLazySubmenuDelegates(NSMenu* menu) {
+  for (NSMenuItem* item in [menu itemArray]) {
+    NSMenu* submenu = [item submenu];
+    if ([submenu isKindOfClass:[ElectronLazySubmenu class]]) {
+      [submenu setDelegate:nil];
+      ResetLazySubmenuDelegates(submenu);
+    }
+  }
+}
+
+}  // namespace
+
+namespace electron {
+
+// Forwards the item changes of the models a menu was built from to its
+// controller.
+class ElectronMenuControllerObserver : public ElectronMenuModel::Observer {
+ public:
+  explicit ElectronMenuControllerObserver(ElectronMenuController* controller)
+      : controller_(controller) {}
+  ~ElectronMenuControllerObserver() override { Reset(); }
+
+  // disable copy
+  ElectronMenuControllerObserver(const ElectronMenuControllerObserver&) =
+      delete;
+  ElectronMenuControllerObserver& operator=(
+      const ElectronMenuControllerObserver&) = delete;
+
+  // Observes |model|, whose items are in |menu|.
+  void Observe(ElectronMenuModel* model, NSMenu* menu) {
+    for (Entry& entry : entries_) {
+      if (entry.model.get() == model) {
+        entry.menu.reset([menu retain]);
+        return;
+      }
+    }
+    model->AddObserver(this);
+    entries_.push_back(
+        {model->GetWeakPtr(), base::scoped_nsobject<NSMenu>([menu retain])});
+  }
+
+  void Reset() {
+    for (const Entry& entry : entries_) {
+      if (entry.model)
+        entry.model->RemoveObserver(this);
+    }
+    entries_.clear();
+  }
+
+ private:
+  struct Entry {
+    base::WeakPtr<ElectronMenuModel> model;
+    base::scoped_nsobject<NSMenu> menu;
+  };
+
+  // ElectronMenuModel::Observer:
+  void OnMenuItemChanged(ElectronMenuModel* model, size_t index) override {
+    for (const Entry& entry : entries_) {
+      if (entry.model.get() == model) {
+        [controller_ updateItemAtIndex:index inMenu:entry.menu fromModel:model];
+        return;
+      }
+    }
+  }
+
+  // Weak, owns |this|.
+  ElectronMenuController* controller_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace electron
+
 // Menu item is located for ease of removing it from the parent owner
 static base::scoped_nsobject<NSMenuItem> recentDocumentsMenuItem_;
 
@@ -174,6 +282,8 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
     model_ = model->GetWeakPtr();
     isMenuOpen_ = NO;
     useDefaultAccelerator_ = use;
+    modelObserver_ =
+        std::make_unique<electron::ElectronMenuControllerObserver>(self);
     [self menu];
   }
   return self;
@@ -181,6 +291,8 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
 
 - (void)dealloc {
   [menu_ setDelegate:nil];
+  ResetLazySubmenuDelegates(menu_);
+  modelObserver_.reset();
 
   // Close the menu if it is still open. This could happen if a tab gets closed
   // while its context menu is still open.
@@ -208,15 +320,9 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
   }
 
   model_ = model->GetWeakPtr();
+  modelObserver_->Reset();
   [menu_ removeAllItems];
-
-  const int count = model->GetItemCount();
-  for (int index = 0; index < count; index++) {
-    if (model->GetTypeAt(index) == electron::ElectronMenuModel::TYPE_SEPARATOR)
-      [self addSeparatorToMenu:menu_ atIndex:index];
-    else
-      [self addItemToMenu:menu_ atIndex:index fromModel:model];
-  }
+  [self addItemsToMenu:menu_ fromModel:model];
 }
 
 - (void)cancel {
@@ -236,7 +342,14 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
 // be invoked recursively.
 - (NSMenu*)menuFromModel:(electron::ElectronMenuModel*)model {
   NSMenu* menu = [[[NSMenu alloc] initWithTitle:@""] autorelease];
+  [self addItemsToMenu:menu fromModel:model];
+  return menu;
+}
 
+// Adds the items of |model| to the empty |menu|.
+- (void)addItemsToMenu:(NSMenu*)menu
+             fromModel:(electron::ElectronMenuModel*)model {
+  modelObserver_->Observe(model, menu);
   const int count = model->GetItemCount();
   for (int index = 0; index < count; index++) {
     if (model->GetTypeAt(index) == electron::ElectronMenuModel::TYPE_SEPARATOR)
@@ -244,8 +357,6 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
     else
       [self addItemToMenu:menu atIndex:index fromModel:model];
   }
-
-  return menu;
 }
 
 // Adds a separator item at the given index. As the separator doesn't need
@@ -369,9 +480,18 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
     electron::ElectronMenuModel* submenuModel =
         static_cast<electron::ElectronMenuModel*>(
             model->GetSubmenuModelAt(index));
-    NSMenu* submenu = MenuHasVisibleItems(submenuModel)
-                          ? [self menuFromModel:submenuModel]
-                          : MakeEmptySubmenu();
+    NSMenu* submenu;
+    if (!useDefaultAccelerator_ && role.empty()) {
+      // Only the application menu uses the default accelerators, the
+      // submenus of the other menus are made when they open.
+      submenu = [[[ElectronLazySubmenu alloc] initWithModel:submenuModel]
+          autorelease];
+      [submenu setDelegate:self];
+    } else {
+      submenu = MenuHasVisibleItems(submenuModel)
+                    ? [self menuFromModel:submenuModel]
+                    : MakeEmptySubmenu();
+    }
     [submenu setTitle:[item title]];
     [item setSubmenu:submenu];
 
@@ -450,6 +570,54 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
            atIndex:index];
 }
 
+- (void)updateItemAtIndex:(NSInteger)index
+                   inMenu:(NSMenu*)menu
+                fromModel:(electron::ElectronMenuModel*)model {
+  // The lazy submenus get the current items when they are populated.
+  if ([menu isKindOfClass:[ElectronLazySubmenu class]] &&
+      ![(ElectronLazySubmenu*)menu populated]) {
+    return;
+  }
+
+  // The menu shows "(empty)" when none of its items are visible, rebuild it
+  // when that changes.
+  const bool has_visible_items = MenuHasVisibleItems(model);
+  if (!has_visible_items || [menu numberOfItems] != model->GetItemCount() ||
+      index >= [menu numberOfItems]) {
+    ResetLazySubmenuDelegates(menu);
+    [menu removeAllItems];
+    if (has_visible_items)
+      [self addItemsToMenu:menu fromModel:model];
+    else
+      AddEmptyMenuItem(menu);
+    return;
+  }
+
+  if (model->GetTypeAt(index) == electron::ElectronMenuModel::TYPE_SEPARATOR)
+    return;
+
+  // Keep the submenus, which can be open, and only update their item.
+  NSMenuItem* item = [menu itemAtIndex:index];
+  if ([item submenu] && model->IsVisibleAt(index) &&
+      model->GetTypeAt(index) == electron::ElectronMenuModel::TYPE_SUBMENU) {
+    NSString* title =
+        l10n_util::FixUpWindowsStyleLabel(model->GetLabelAt(index));
+    [item setTitle:title];
+    [[item submenu] setTitle:title];
+    [item setToolTip:base::SysUTF16ToNSString(model->GetToolTipAt(index))];
+    [item setEnabled:model->IsEnabledAt(index)];
+    [item setHidden:NO];
+    return;
+  }
+
+  if ([[item submenu] isKindOfClass:[ElectronLazySubmenu class]]) {
+    [[item submenu] setDelegate:nil];
+    ResetLazySubmenuDelegates([item submenu]);
+  }
+  [menu removeItemAtIndex:index];
+  [self addItemToMenu:menu atIndex:index fromModel:model];
+}
+
 // Called before the menu is to be displayed to update the state (enabled,
 // radio, etc) of each item in the menu.
 - (BOOL)validateUserInterfaceItem:(id<NSValidatedUserInterfaceItem>)item {
@@ -521,13 +689,44 @@ static base::scoped_nsobject<NSMenu> recentDocumentsMenuSwap_;
   return isMenuOpen_;
 }
 
+- (void)menuNeedsUpdate:(NSMenu*)menu {
+  if (![menu isKindOfClass:[ElectronLazySubmenu class]])
+    return;
+  ElectronLazySubmenu* submenu = (ElectronLazySubmenu*)menu;
+  if ([submenu shown] || ![submenu model])
+    return;
+
+  // The listeners of 'menu-will-show' can still add items to the submenu.
+  [submenu setShown:YES];
+  [submenu model]->MenuWillShow();
+  electron::ElectronMenuModel* model = [submenu model];
+  if ([submenu populated] || !model)
+    return;
+  [submenu setPopulated:YES];
+  if (MenuHasVisibleItems(model))
+    [self addItemsToMenu:submenu fromModel:model];
+  else
+    AddEmptyMenuItem(submenu);
+}
+
 - (void)menuWillOpen:(NSMenu*)menu {
+  if ([menu isKindOfClass:[ElectronLazySubmenu class]])
+    return;
   isMenuOpen_ = YES;
   if (model_)
     model_->MenuWillShow();
 }
 
 - (void)menuDidClose:(NSMenu*)menu {
+  if ([menu isKindOfClass:[ElectronLazySubmenu class]]) {
+    ElectronLazySubmenu* submenu = (ElectronLazySubmenu*)menu;
+    if ([submenu shown]) {
+      [submenu setShown:NO];
+      if ([submenu model])
+        [submenu model]->MenuWillClose();
+    }
+    return;
+  }
   if (isMenuOpen_) {
     isMenuOpen_ = NO;
     if (model_)
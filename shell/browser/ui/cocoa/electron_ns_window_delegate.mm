@@ -50,13 +50,17 @@ using FullScreenTransitionState =
   NSWindow* window = notification.object;
 
   // check occlusion binary flag
-  if (window.occlusionState & NSWindowOcclusionStateVisible) {
+  const bool visible = window.occlusionState & NSWindowOcclusionStateVisible;
+  if (visible) {
     // The app is visible
     shell_->NotifyWindowShow();
   } else {
     // The app is not visible
     shell_->NotifyWindowHide();
   }
+  // Windows which are hidden or minimized are not occluded.
+  shell_->NotifyWindowOcclusionChanged(!visible && [window isVisible] &&
+                                       ![window isMiniaturized]);
 }
 
 // Called when the user clicks the zoom button or selects it from the Window
@@ -12,13 +12,18 @@ namespace electron {
 std::unique_ptr<SkRegion> DraggableRegionsToSkRegion(
     const std::vector<mojom::DraggableRegionPtr>& regions) {
   auto sk_region = std::make_unique<SkRegion>();
+  ApplyDraggableRegions(regions, sk_region.get());
+  return sk_region;
+}
+
+void ApplyDraggableRegions(base::span<const mojom::DraggableRegionPtr> regions,
+                           SkRegion* sk_region) {
   for (const auto& region : regions) {
     sk_region->op(
         SkIRect::MakeLTRB(region->bounds.x(), region->bounds.y(),
                           region->bounds.right(), region->bounds.bottom()),
         region->draggable ? SkRegion::kUnion_Op : SkRegion::kDifference_Op);
   }
-  return sk_region;
 }
 
 }  // namespace electron
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "shell/common/api/api.mojom.h"
 #include "third_party/skia/include/core/SkRegion.h"
 #include "ui/gfx/image/image.h"
@@ -26,6 +27,11 @@ void DragFileItems(const std::vector<base::FilePath>& files,
 std::unique_ptr<SkRegion> DraggableRegionsToSkRegion(
     const std::vector<mojom::DraggableRegionPtr>& regions);
 
+// Applies |regions| in order onto |sk_region|, the draggable ones are added
+// and the others removed.
+void ApplyDraggableRegions(base::span<const mojom::DraggableRegionPtr> regions,
+                           SkRegion* sk_region);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_BROWSER_UI_DRAG_UTIL_H_
@@ -88,6 +88,11 @@ bool ElectronMenuModel::WorksWhenHiddenAt(size_t index) const {
   return true;
 }
 
+void ElectronMenuModel::NotifyItemChanged(size_t index) {
+  for (Observer& observer : observers_)
+    observer.OnMenuItemChanged(this, index);
+}
+
 #if BUILDFLAG(IS_MAC)
 bool ElectronMenuModel::GetSharingItemAt(size_t index,
                                          SharingItem* item) const {
@@ -70,6 +70,11 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
 
     // Notifies the menu has been closed.
     virtual void OnMenuWillClose() {}
+
+    // Notifies the label, state or visibility of the item at |index| of
+    // |model| changed, so that the native menus built from it can update the
+    // item in place.
+    virtual void OnMenuItemChanged(ElectronMenuModel* model, size_t index) {}
   };
 
   explicit ElectronMenuModel(Delegate* delegate);
@@ -93,6 +98,7 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
                                   ui::Accelerator* accelerator) const;
   bool ShouldRegisterAcceleratorAt(size_t index) const;
   bool WorksWhenHiddenAt(size_t index) const;
+  void NotifyItemChanged(size_t index);
 #if BUILDFLAG(IS_MAC)
   // Return the SharingItem of menu item.
   bool GetSharingItemAt(size_t index, SharingItem* item) const;
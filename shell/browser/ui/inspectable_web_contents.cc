@@ -5,6 +5,7 @@
 
 #include "shell/browser/ui/inspectable_web_contents.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -172,6 +173,30 @@ void OnOpenItemComplete(const base::FilePath& path, const std::string& result) {
 constexpr base::TimeDelta kInitialBackoffDelay = base::Milliseconds(250);
 constexpr base::TimeDelta kMaxBackoffDelay = base::Seconds(10);
 
+// The network service hands the data over in chunks of a few KB, each
+// streamWrite() is a script evaluation in the frontend.
+constexpr size_t kStreamWriteSize = 256 * 1024;
+
+// Returns the length of the UTF-8 sequence cut at the end of |data|, which
+// is completed by the next chunk.
+size_t GetTruncatedUTF8Length(base::StringPiece data) {
+  const size_t max = std::min<size_t>(data.size(), 3);
+  for (size_t length = 1; length <= max; ++length) {
+    const auto byte = static_cast<uint8_t>(data[data.size() - length]);
+    if ((byte & 0xC0) == 0x80)
+      continue;
+    size_t expected = 1;
+    if ((byte & 0xE0) == 0xC0)
+      expected = 2;
+    else if ((byte & 0xF0) == 0xE0)
+      expected = 3;
+    else if ((byte & 0xF8) == 0xF0)
+      expected = 4;
+    return expected > length ? length : 0;
+  }
+  return 0;
+}
+
 }  // namespace
 
 class InspectableWebContents::NetworkResourceLoader
@@ -256,26 +281,47 @@ class InspectableWebContents::NetworkResourceLoader
 
   void OnDataReceived(base::StringPiece chunk,
                       base::OnceClosure resume) override {
-    base::Value chunkValue;
+    pending_data_.append(chunk.data(), chunk.size());
+    if (pending_data_.size() >= kStreamWriteSize)
+      StreamWrite(false);
+    std::move(resume).Run();
+  }
 
-    bool encoded = !base::IsStringUTF8(chunk);
-    if (encoded) {
-      std::string encoded_string;
-      base::Base64Encode(chunk, &encoded_string);
-      chunkValue = base::Value(std::move(encoded_string));
+  // Sends the data received since the last write to the frontend. Text is
+  // sent as is, only the binary data is base64 encoded, as streamWrite()
+  // only takes strings.
+  void StreamWrite(bool complete) {
+    if (pending_data_.empty())
+      return;
+    std::string data;
+    bool encoded = false;
+    if (base::IsStringUTF8(pending_data_)) {
+      data = std::move(pending_data_);
+      pending_data_.clear();
     } else {
-      chunkValue = base::Value(chunk);
+      // A character cut between two writes must not turn the resource into
+      // binary data.
+      const size_t truncated =
+          complete ? 0 : GetTruncatedUTF8Length(pending_data_);
+      const size_t length = pending_data_.size() - truncated;
+      if (truncated &&
+          base::IsStringUTF8(base::StringPiece(pending_data_.data(), length))) {
+        data = pending_data_.substr(0, length);
+        pending_data_.erase(0, length);
+      } else {
+        encoded = true;
+        data = base::Base64Encode(
+            base::as_bytes(base::make_span(pending_data_)));
+        pending_data_.clear();
+      }
     }
-    base::Value id(stream_id_);
-    base::Value encodedValue(encoded);
-
-    bindings_->CallClientFunction("DevToolsAPI", "streamWrite", std::move(id),
-                                  std::move(chunkValue),
-                                  std::move(encodedValue));
-    std::move(resume).Run();
+    bindings_->CallClientFunction(
+        "DevToolsAPI", "streamWrite", base::Value(stream_id_),
+        base::Value(std::move(data)), base::Value(encoded));
   }
 
   void OnComplete(bool success) override {
+    StreamWrite(true);
     if (!success && loader_->NetError() == net::ERR_INSUFFICIENT_RESOURCES &&
         retry_delay_ < kMaxBackoffDelay) {
       const base::TimeDelta delay =
@@ -319,6 +365,8 @@ class InspectableWebContents::NetworkResourceLoader
   URLLoaderFactoryHolder url_loader_factory_;
   DispatchCallback callback_;
   scoped_refptr<net::HttpResponseHeaders> response_headers_;
+  // The data not yet passed to streamWrite().
+  std::string pending_data_;
   base::OneShotTimer timer_;
   base::TimeDelta retry_delay_;
 };
@@ -684,10 +732,8 @@ void InspectableWebContents::LoadNetworkResource(DispatchCallback callback,
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
   } else if (protocol_registry->IsProtocolRegistered(gurl.scheme())) {
-    auto& protocol_handler = protocol_registry->handlers().at(gurl.scheme());
     mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote =
-        ElectronURLLoaderFactory::Create(protocol_handler.first,
-                                         protocol_handler.second);
+        protocol_registry->CreateURLLoaderFactory(gurl.scheme());
     url_loader_factory = network::SharedURLLoaderFactory::Create(
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
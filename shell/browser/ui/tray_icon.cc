@@ -4,6 +4,10 @@
 
 #include "shell/browser/ui/tray_icon.h"
 
+#include <utility>
+
+#include "base/functional/bind.h"
+
 namespace electron {
 
 TrayIcon::BalloonOptions::BalloonOptions() = default;
@@ -14,6 +18,50 @@ TrayIcon::~TrayIcon() = default;
 
 void TrayIcon::SetPressedImage(ImageType image) {}
 
+void TrayIcon::SetAnimation(std::vector<AnimationFrame> frames,
+                            base::TimeDelta interval) {
+  StopAnimation();
+  if (frames.empty())
+    return;
+#if !BUILDFLAG(IS_WIN)
+  for (AnimationFrame& frame : frames)
+    frame = PrepareAnimationFrame(frame);
+#endif
+  animation_frames_ = std::move(frames);
+  ShowNextAnimationFrame();
+  if (animation_frames_.size() < 2)
+    return;
+  // Unretained is safe as |animation_timer_| is owned by |this|.
+  animation_timer_.Start(
+      FROM_HERE, interval,
+      base::BindRepeating(&TrayIcon::ShowNextAnimationFrame,
+                          base::Unretained(this)));
+}
+
+void TrayIcon::StopAnimation() {
+  animation_timer_.Stop();
+  animation_frames_.clear();
+  next_animation_frame_ = 0;
+}
+
+#if !BUILDFLAG(IS_WIN)
+TrayIcon::AnimationFrame TrayIcon::PrepareAnimationFrame(
+    const gfx::Image& image) {
+  return image;
+}
+#endif
+
+void TrayIcon::ShowNextAnimationFrame() {
+  const AnimationFrame& frame = animation_frames_[next_animation_frame_];
+#if BUILDFLAG(IS_WIN)
+  SetImage(frame.get());
+#else
+  SetImage(frame);
+#endif
+  next_animation_frame_ =
+      (next_animation_frame_ + 1) % animation_frames_.size();
+}
+
 void TrayIcon::DisplayBalloon(const BalloonOptions& options) {}
 
 void TrayIcon::RemoveBalloon() {}
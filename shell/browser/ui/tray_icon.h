@@ -9,11 +9,17 @@
 #include <vector>
 
 #include "base/observer_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "shell/browser/ui/tray_icon_observer.h"
 #include "shell/common/gin_converters/guid_converter.h"
 #include "ui/gfx/geometry/rect.h"
 
+#if BUILDFLAG(IS_WIN)
+#include "base/win/scoped_gdi_object.h"
+#endif
+
 namespace electron {
 
 class TrayIcon {
@@ -22,8 +28,10 @@ class TrayIcon {
 
 #if BUILDFLAG(IS_WIN)
   using ImageType = HICON;
+  using AnimationFrame = base::win::ScopedHICON;
 #else
   using ImageType = const gfx::Image&;
+  using AnimationFrame = gfx::Image;
 #endif
 
   virtual ~TrayIcon();
@@ -38,6 +46,12 @@ class TrayIcon {
   // Sets the image associated with this status icon when pressed.
   virtual void SetPressedImage(ImageType image);
 
+  // Shows |frames| in turn, each one for |interval|, until StopAnimation() is
+  // called. The frames are converted for the platform once, up front.
+  void SetAnimation(std::vector<AnimationFrame> frames,
+                    base::TimeDelta interval);
+  void StopAnimation();
+
   // Sets the hover text for this status icon. This is also used as the label
   // for the menu item which is created as a replacement for the status icon
   // click action on platforms that do not support custom click actions for the
@@ -131,8 +145,20 @@ class TrayIcon {
  protected:
   TrayIcon();
 
+#if !BUILDFLAG(IS_WIN)
+  // Returns |image| converted to what SetImage() shows, so that showing the
+  // frames of an animation doesn't convert them again.
+  virtual AnimationFrame PrepareAnimationFrame(const gfx::Image& image);
+#endif
+
  private:
+  void ShowNextAnimationFrame();
+
   base::ObserverList<TrayIconObserver> observers_;
+
+  std::vector<AnimationFrame> animation_frames_;
+  size_t next_animation_frame_ = 0;
+  base::RepeatingTimer animation_timer_;
 };
 
 }  // namespace electron
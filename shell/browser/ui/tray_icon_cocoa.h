@@ -36,6 +36,10 @@ class TrayIconCocoa : public TrayIcon {
   void SetContextMenu(raw_ptr<ElectronMenuModel>) override;
   gfx::Rect GetBounds() override;
 
+ protected:
+  // TrayIcon:
+  AnimationFrame PrepareAnimationFrame(const gfx::Image& image) override;
+
  private:
   // Electron custom view for NSStatusItem.
   base::scoped_nsobject<StatusItemView> status_item_view_;
@@ -337,6 +337,13 @@ void TrayIconCocoa::SetImage(const gfx::Image& image) {
   [status_item_view_ setImage:image.AsNSImage()];
 }
 
+TrayIcon::AnimationFrame TrayIconCocoa::PrepareAnimationFrame(
+    const gfx::Image& image) {
+  // The NSImage is cached by the image, which the frame shares.
+  image.AsNSImage();
+  return image;
+}
+
 void TrayIconCocoa::SetPressedImage(const gfx::Image& image) {
   [status_item_view_ setAlternateImage:image.AsNSImage()];
 }
@@ -44,6 +44,12 @@ void TrayIconLinux::SetImage(const gfx::Image& image) {
     status_icon->SetIcon(image_);
 }
 
+TrayIcon::AnimationFrame TrayIconLinux::PrepareAnimationFrame(
+    const gfx::Image& image) {
+  // SetImage() finds the single representation of the frame right away.
+  return gfx::Image(GetBestImageRep(image.AsImageSkia()));
+}
+
 void TrayIconLinux::SetToolTip(const std::string& tool_tip) {
   tool_tip_ = base::UTF8ToUTF16(tool_tip);
   if (auto* status_icon = GetStatusIcon())
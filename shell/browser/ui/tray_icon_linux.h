@@ -35,6 +35,10 @@ class TrayIconLinux : public TrayIcon, public ui::StatusIconLinux::Delegate {
   ui::MenuModel* GetMenuModel() const override;
   void OnImplInitializationFailed() override;
 
+ protected:
+  // TrayIcon:
+  AnimationFrame PrepareAnimationFrame(const gfx::Image& image) override;
+
  private:
   enum class StatusIconType {
     kDbus,
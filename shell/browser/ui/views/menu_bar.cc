@@ -47,11 +47,20 @@ MenuBar::MenuBar(NativeWindow* window, RootView* root_view)
 }
 
 MenuBar::~MenuBar() {
+  if (observed_menu_model_)
+    observed_menu_model_->RemoveObserver(this);
   window_->RemoveObserver(this);
 }
 
 void MenuBar::SetMenu(ElectronMenuModel* model) {
+  if (observed_menu_model_)
+    observed_menu_model_->RemoveObserver(this);
+  observed_menu_model_.reset();
   menu_model_ = model;
+  if (model) {
+    model->AddObserver(this);
+    observed_menu_model_ = model->GetWeakPtr();
+  }
   RebuildChildren();
 }
 
@@ -114,6 +123,15 @@ void MenuBar::OnMenuClosed() {
   SetAcceleratorVisibility(pane_has_focus());
 }
 
+void MenuBar::OnMenuItemChanged(ElectronMenuModel* model, size_t index) {
+  // The submenus are built from the model each time they open, only the
+  // buttons need to be updated.
+  if (model != menu_model_ || index >= children().size())
+    return;
+  static_cast<SubmenuButton*>(children()[index])
+      ->SetTitle(model->GetLabelAt(index));
+}
+
 void MenuBar::OnWindowBlur() {
   UpdateViewColors();
   SetAcceleratorVisibility(pane_has_focus());
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_UI_VIEWS_MENU_BAR_H_
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "shell/browser/native_window_observer.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "shell/browser/ui/views/menu_delegate.h"
@@ -20,6 +21,7 @@ namespace electron {
 
 class MenuBar : public views::AccessiblePaneView,
                 public MenuDelegate::Observer,
+                public ElectronMenuModel::Observer,
                 public NativeWindowObserver {
  public:
   static const char kViewClassName[];
@@ -59,6 +61,9 @@ class MenuBar : public views::AccessiblePaneView,
   void OnBeforeExecuteCommand() override;
   void OnMenuClosed() override;
 
+  // ElectronMenuModel::Observer:
+  void OnMenuItemChanged(ElectronMenuModel* model, size_t index) override;
+
   // NativeWindowObserver:
   void OnWindowBlur() override;
   void OnWindowFocus() override;
@@ -91,6 +96,8 @@ class MenuBar : public views::AccessiblePaneView,
   raw_ptr<NativeWindow> window_;
   raw_ptr<RootView> root_view_;
   raw_ptr<ElectronMenuModel> menu_model_ = nullptr;
+  // |menu_model_| while it is alive, for removing the observer.
+  base::WeakPtr<ElectronMenuModel> observed_menu_model_;
   bool accelerator_installed_ = false;
 };
 
@@ -38,7 +38,7 @@ void MenuDelegate::RunMenu(ElectronMenuModel* model,
   adapter_ = std::make_unique<MenuModelAdapter>(model);
 
   auto* item = new views::MenuItemView(this);
-  static_cast<MenuModelAdapter*>(adapter_.get())->BuildMenu(item);
+  static_cast<MenuModelAdapter*>(adapter_.get())->BuildMenuLazily(item);
 
   menu_runner_ = std::make_unique<views::MenuRunner>(
       item, views::MenuRunner::CONTEXT_MENU | views::MenuRunner::HAS_MNEMONICS);
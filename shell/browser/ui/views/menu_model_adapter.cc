@@ -4,22 +4,87 @@
 
 #include "shell/browser/ui/views/menu_model_adapter.h"
 
+#include <utility>
+
+#include "ui/views/controls/menu/menu_item_view.h"
+#include "ui/views/controls/menu/submenu_view.h"
+
 namespace electron {
 
 MenuModelAdapter::MenuModelAdapter(ElectronMenuModel* menu_model)
     : views::MenuModelAdapter(menu_model), menu_model_(menu_model) {}
 
+MenuModelAdapter::MenuModelAdapter(
+    ElectronMenuModel* menu_model,
+    bool use_default_accelerator,
+    base::RepeatingClosure on_menu_closed_callback)
+    : views::MenuModelAdapter(menu_model, std::move(on_menu_closed_callback)),
+      menu_model_(menu_model),
+      use_default_accelerator_(use_default_accelerator) {}
+
 MenuModelAdapter::~MenuModelAdapter() = default;
 
+void MenuModelAdapter::BuildMenuLazily(views::MenuItemView* menu) {
+  DCHECK(menu);
+  // Clear the menu, like BuildMenu() does.
+  if (menu->HasSubmenu())
+    menu->GetSubmenu()->RemoveAllChildViews();
+  menus_.clear();
+  pending_submenus_.clear();
+
+  BuildItems(menu, menu_model_);
+  menu->ChildrenChanged();
+}
+
+void MenuModelAdapter::WillShowMenu(views::MenuItemView* menu) {
+  auto pending = pending_submenus_.find(menu);
+  if (pending != pending_submenus_.end()) {
+    ui::MenuModel* model = pending->second;
+    pending_submenus_.erase(pending);
+    // The listeners of 'menu-will-show' can still add items to the submenu.
+    // The MenuController replaces its empty placeholder once it is built.
+    model->MenuWillShow();
+    BuildItems(menu, model);
+    return;
+  }
+  auto it = menus_.find(menu);
+  if (it != menus_.end())
+    it->second->MenuWillShow();
+}
+
+void MenuModelAdapter::WillHideMenu(views::MenuItemView* menu) {
+  auto it = menus_.find(menu);
+  if (it != menus_.end())
+    it->second->MenuWillClose();
+}
+
 bool MenuModelAdapter::GetAccelerator(int id,
                                       ui::Accelerator* accelerator) const {
   ui::MenuModel* model = menu_model_;
   size_t index = 0;
   if (ui::MenuModel::GetModelAndIndexForCommandId(id, &model, &index)) {
     return static_cast<ElectronMenuModel*>(model)->GetAcceleratorAtWithParams(
-        index, true, accelerator);
+        index, use_default_accelerator_, accelerator);
   }
   return false;
 }
 
+void MenuModelAdapter::BuildItems(views::MenuItemView* menu,
+                                  ui::MenuModel* model) {
+  menus_[menu] = model;
+  const size_t count = model->GetItemCount();
+  for (size_t i = 0; i < count; ++i) {
+    views::MenuItemView* item = AppendMenuItem(menu, model, i);
+    if (!item)
+      continue;
+    item->SetEnabled(model->IsEnabledAt(i));
+    item->SetVisible(model->IsVisibleAt(i));
+    // The item already has an empty SubmenuView, which is filled when it is
+    // shown.
+    if (model->GetTypeAt(i) == ui::MenuModel::TYPE_SUBMENU)
+      pending_submenus_[item] = model->GetSubmenuModelAt(i);
+  }
+  menu->set_has_icons(model->HasIcons());
+}
+
 }  // namespace electron
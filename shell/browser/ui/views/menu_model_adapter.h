@@ -5,6 +5,9 @@
 #ifndef ELECTRON_SHELL_BROWSER_UI_VIEWS_MENU_MODEL_ADAPTER_H_
 #define ELECTRON_SHELL_BROWSER_UI_VIEWS_MENU_MODEL_ADAPTER_H_
 
+#include <map>
+
+#include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "ui/views/controls/menu/menu_model_adapter.h"
@@ -14,17 +17,39 @@ namespace electron {
 class MenuModelAdapter : public views::MenuModelAdapter {
  public:
   explicit MenuModelAdapter(ElectronMenuModel* menu_model);
+  // Context menus don't show the default accelerators of the roles.
+  MenuModelAdapter(ElectronMenuModel* menu_model,
+                   bool use_default_accelerator,
+                   base::RepeatingClosure on_menu_closed_callback);
   ~MenuModelAdapter() override;
 
   // disable copy
   MenuModelAdapter(const MenuModelAdapter&) = delete;
   MenuModelAdapter& operator=(const MenuModelAdapter&) = delete;
 
+  // Unlike BuildMenu(), only builds the items of |menu|: the items of a
+  // submenu are built the first time it is shown, after its model is told
+  // that it will show, so building a menu doesn't depend on the size of its
+  // submenus.
+  void BuildMenuLazily(views::MenuItemView* menu);
+
+  // views::MenuModelAdapter:
+  void WillShowMenu(views::MenuItemView* menu) override;
+  void WillHideMenu(views::MenuItemView* menu) override;
+
  protected:
   bool GetAccelerator(int id, ui::Accelerator* accelerator) const override;
 
  private:
+  void BuildItems(views::MenuItemView* menu, ui::MenuModel* model);
+
   raw_ptr<ElectronMenuModel> menu_model_;
+  const bool use_default_accelerator_ = true;
+
+  // The model of each menu whose items are built.
+  std::map<views::MenuItemView*, raw_ptr<ui::MenuModel>> menus_;
+  // The model of each submenu whose items are not built yet.
+  std::map<views::MenuItemView*, raw_ptr<ui::MenuModel>> pending_submenus_;
 };
 
 }  // namespace electron
@@ -9,6 +9,9 @@
 #include "content/public/browser/native_web_keyboard_event.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/ui/views/menu_bar.h"
+#include "ui/aura/window.h"
+#include "ui/gfx/geometry/transform.h"
+#include "ui/views/widget/widget.h"
 
 namespace electron {
 
@@ -174,6 +177,19 @@ void RootView::ResetAltState() {
   menu_bar_alt_pressed_ = false;
 }
 
+void RootView::LockContentSize() {
+  if (locked_content_size_ || !window_->content_view())
+    return;
+  locked_content_size_ = window_->content_view()->size();
+}
+
+void RootView::UnlockContentSize() {
+  if (!locked_content_size_)
+    return;
+  locked_content_size_.reset();
+  Layout();
+}
+
 void RootView::Layout() {
   if (!window_->content_view())  // Not ready yet.
     return;
@@ -184,9 +200,44 @@ void RootView::Layout() {
   if (menu_bar_)
     menu_bar_->SetBoundsRect(menu_bar_bounds);
 
-  window_->content_view()->SetBoundsRect(
-      gfx::Rect(0, menu_bar_visible_ ? menu_bar_bounds.bottom() : 0,
-                size().width(), size().height() - menu_bar_bounds.height()));
+  gfx::Rect content_bounds(0, menu_bar_visible_ ? menu_bar_bounds.bottom() : 0,
+                           size().width(),
+                           size().height() - menu_bar_bounds.height());
+  if (locked_content_size_ || native_views_scaled_)
+    ScaleNativeViews(content_bounds);
+  if (locked_content_size_)
+    content_bounds.set_size(*locked_content_size_);
+  window_->content_view()->SetBoundsRect(content_bounds);
+}
+
+void RootView::ScaleNativeViews(const gfx::Rect& content_bounds) {
+  views::Widget* widget = GetWidget();
+  if (!widget || !widget->GetNativeView())
+    return;
+  native_views_scaled_ = locked_content_size_.has_value();
+
+  float scale_x = 1.f;
+  float scale_y = 1.f;
+  if (locked_content_size_ && !locked_content_size_->IsEmpty()) {
+    scale_x = static_cast<float>(content_bounds.width()) /
+              locked_content_size_->width();
+    scale_y = static_cast<float>(content_bounds.height()) /
+              locked_content_size_->height();
+  }
+
+  // The native views are scaled around the origin of the content view.
+  gfx::Rect origin_bounds = content_bounds;
+  ConvertRectToWidget(&origin_bounds);
+  const gfx::Point origin = origin_bounds.origin();
+  for (aura::Window* child : widget->GetNativeView()->children()) {
+    const gfx::Point position = child->bounds().origin();
+    gfx::Transform transform;
+    transform.Translate((origin.x() - position.x()) * (1.f - scale_x),
+                        (origin.y() - position.y()) * (1.f - scale_y));
+    transform.Scale(scale_x, scale_y);
+    if (child->transform() != transform)
+      child->SetTransform(transform);
+  }
 }
 
 gfx::Size RootView::GetMinimumSize() const {
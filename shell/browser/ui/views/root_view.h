@@ -9,7 +9,9 @@
 
 #include "base/memory/raw_ptr.h"
 #include "shell/browser/ui/accelerator_util.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/gfx/geometry/insets.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/views/view.h"
 #include "ui/views/view_tracker.h"
 
@@ -45,6 +47,11 @@ class RootView : public views::View {
   // Register/Unregister accelerators supported by the menu model.
   void RegisterAcceleratorsWithFocusManager(ElectronMenuModel* menu_model);
   void UnregisterAcceleratorsWithFocusManager();
+  // While the content size is locked, layouts keep the content view at its
+  // current size and scale the native views of the window to the new one,
+  // which stretches their last frame instead of resizing the renderers.
+  void LockContentSize();
+  void UnlockContentSize();
 
   // views::View:
   void Layout() override;
@@ -53,9 +60,16 @@ class RootView : public views::View {
   bool AcceleratorPressed(const ui::Accelerator& accelerator) override;
 
  private:
+  // Scales the native views of the window from the locked content size to
+  // |content_bounds|, or back to their size when the content isn't locked.
+  void ScaleNativeViews(const gfx::Rect& content_bounds);
+
   // Parent window, weak ref.
   raw_ptr<NativeWindow> window_;
 
+  absl::optional<gfx::Size> locked_content_size_;
+  bool native_views_scaled_ = false;
+
   // Menu bar.
   std::unique_ptr<MenuBar> menu_bar_;
   bool menu_bar_autohide_ = false;
@@ -25,6 +25,7 @@ class SubmenuButton : public views::MenuButton {
   SubmenuButton(const SubmenuButton&) = delete;
   SubmenuButton& operator=(const SubmenuButton&) = delete;
 
+  void SetTitle(const std::u16string& title);
   void SetAcceleratorVisibility(bool visible);
   void SetUnderlineColor(SkColor color);
 
@@ -43,6 +44,7 @@ class SubmenuButton : public views::MenuButton {
   void GetCharacterPosition(const std::u16string& text,
                             int index,
                             int* pos) const;
+  void UpdateAccelerator(const std::u16string& title);
 
   char16_t accelerator_ = 0;
 
@@ -5,14 +5,20 @@
 #include "shell/browser/web_contents_preferences.h"
 
 #include <algorithm>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "base/command_line.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/json/json_writer.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
 #include "content/public/browser/render_frame_host.h"
@@ -73,24 +79,162 @@ struct Converter<blink::mojom::V8CacheOptions> {
   }
 };
 
+template <>
+struct Converter<electron::WebContentsPreferences::NearHeapLimitAction> {
+  static bool FromV8(
+      v8::Isolate* isolate,
+      v8::Local<v8::Value> val,
+      electron::WebContentsPreferences::NearHeapLimitAction* out) {
+    using Val = electron::WebContentsPreferences::NearHeapLimitAction;
+    static constexpr auto Lookup =
+        base::MakeFixedFlatMapSorted<base::StringPiece, Val>({
+            {"crash", Val::kCrash},
+            {"notify", Val::kNotify},
+            {"reload", Val::kReload},
+        });
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+};
+
 }  // namespace gin
 
 namespace electron {
 
 namespace {
-std::vector<WebContentsPreferences*>& Instances() {
-  static base::NoDestructor<std::vector<WebContentsPreferences*>> g_instances;
+// The instances by the ID of the process of the primary main frame of their
+// WebContents, so that finding the WebContents of a process doesn't go
+// through all of them.
+std::unordered_multimap<int, WebContentsPreferences*>& InstancesByProcess() {
+  static base::NoDestructor<
+      std::unordered_multimap<int, WebContentsPreferences*>>
+      g_instances;
   return *g_instances;
 }
+
+uint64_t g_next_creation_order = 0;
+
+// The switches which don't depend on the command line they are added to.
+using SwitchList = std::vector<std::pair<std::string, std::string>>;
+
+// The heap sizes are V8 flags, added to those the app passed with --js-flags
+// so that the later ones win.
+void AppendV8HeapSwitches(
+    absl::optional<int> max_old_space_size,
+    absl::optional<int> max_semi_space_size,
+    WebContentsPreferences::NearHeapLimitAction near_heap_limit_action,
+    base::CommandLine* command_line) {
+  if (max_old_space_size || max_semi_space_size) {
+    std::string js_flags =
+        command_line->GetSwitchValueASCII(::switches::kJavaScriptFlags);
+    if (max_old_space_size) {
+      js_flags += " --max-old-space-size=" +
+                  base::NumberToString(*max_old_space_size);
+    }
+    if (max_semi_space_size) {
+      js_flags += " --max-semi-space-size=" +
+                  base::NumberToString(*max_semi_space_size);
+    }
+    command_line->AppendSwitchASCII(
+        ::switches::kJavaScriptFlags,
+        base::TrimWhitespaceASCII(js_flags, base::TRIM_LEADING));
+  }
+  if (near_heap_limit_action !=
+      WebContentsPreferences::NearHeapLimitAction::kCrash)
+    command_line->AppendSwitch(switches::kNearHeapLimitNotify);
+}
+
+void GetHeapSizes(const gin_helper::Dictionary& web_preferences,
+                  absl::optional<int>* max_old_space_size,
+                  absl::optional<int>* max_semi_space_size) {
+  int size;
+  if (web_preferences.Get("maxOldSpaceSize", &size) && size > 0)
+    *max_old_space_size = size;
+  if (web_preferences.Get("maxSemiSpaceSize", &size) && size > 0)
+    *max_semi_space_size = size;
+}
 }  // namespace
 
+class WebContentsPreferences::RendererProfile
+    : public base::RefCounted<RendererProfile> {
+ public:
+  // Returns the profile with these contents, which is created when no
+  // WebContents uses it yet.
+  static scoped_refptr<const RendererProfile> Get(
+      std::vector<std::string> args,
+      SwitchList switches,
+      base::Value::Dict last_preferences) {
+    base::Value::Dict key_dict;
+    base::Value::List key_args;
+    for (const auto& arg : args)
+      key_args.Append(arg);
+    base::Value::List key_switches;
+    for (const auto& [name, value] : switches)
+      key_switches.Append(base::Value::List().Append(name).Append(value));
+    key_dict.Set("args", std::move(key_args));
+    key_dict.Set("switches", std::move(key_switches));
+    key_dict.Set("preferences", last_preferences.Clone());
+    std::string key;
+    base::JSONWriter::Write(key_dict, &key);
+
+    auto& profiles = Profiles();
+    auto it = profiles.find(key);
+    if (it != profiles.end())
+      return base::WrapRefCounted(it->second.get());
+    auto profile = base::WrapRefCounted(
+        new RendererProfile(key, std::move(args), std::move(switches),
+                            std::move(last_preferences)));
+    profiles.emplace(std::move(key), profile.get());
+    return profile;
+  }
+
+  // disable copy
+  RendererProfile(const RendererProfile&) = delete;
+  RendererProfile& operator=(const RendererProfile&) = delete;
+
+  void AppendTo(base::CommandLine* command_line) const {
+    for (const auto& [name, value] : switches_)
+      command_line->AppendSwitchASCII(name, value);
+    for (const auto& arg : args_)
+      command_line->AppendArg(arg);
+  }
+
+  const base::Value& last_preferences() const { return last_preferences_; }
+
+ private:
+  friend class base::RefCounted<RendererProfile>;
+
+  static std::map<std::string, raw_ptr<const RendererProfile>>& Profiles() {
+    static base::NoDestructor<
+        std::map<std::string, raw_ptr<const RendererProfile>>>
+        g_profiles;
+    return *g_profiles;
+  }
+
+  RendererProfile(std::string key,
+                  std::vector<std::string> args,
+                  SwitchList switches,
+                  base::Value::Dict last_preferences)
+      : key_(std::move(key)),
+        args_(std::move(args)),
+        switches_(std::move(switches)),
+        last_preferences_(std::move(last_preferences)) {}
+  ~RendererProfile() { Profiles().erase(key_); }
+
+  const std::string key_;
+  const std::vector<std::string> args_;
+  const SwitchList switches_;
+  const base::Value last_preferences_;
+};
+
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const gin_helper::Dictionary& web_preferences)
     : content::WebContentsUserData<WebContentsPreferences>(*web_contents),
-      web_contents_(web_contents) {
+      content::WebContentsObserver(web_contents),
+      web_contents_(web_contents),
+      creation_order_(g_next_creation_order++) {
   web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
-  Instances().push_back(this);
+  UpdateProcessIndex();
   SetFromDictionary(web_preferences);
 
   // If this is a <webview> tag, and the embedder is offscreen-rendered, then
@@ -107,8 +251,46 @@ WebContentsPreferences::WebContentsPreferences(
 }
 
 WebContentsPreferences::~WebContentsPreferences() {
-  Instances().erase(std::remove(Instances().begin(), Instances().end(), this),
-                    Instances().end());
+  RemoveFromProcessIndex();
+}
+
+void WebContentsPreferences::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  // The main frame moved to another process on a cross-process navigation.
+  if (new_host && !new_host->GetParent())
+    UpdateProcessIndex();
+}
+
+void WebContentsPreferences::PrimaryPageChanged(content::Page& page) {
+  // Pages restored from the back-forward cache or activated prerenders can
+  // be in another process without the frame host having changed.
+  UpdateProcessIndex();
+}
+
+void WebContentsPreferences::UpdateProcessIndex() {
+  content::RenderFrameHost* main_frame = web_contents_->GetPrimaryMainFrame();
+  const int process_id = main_frame ? main_frame->GetProcess()->GetID() : -1;
+  if (process_id == indexed_process_id_)
+    return;
+  RemoveFromProcessIndex();
+  if (process_id == -1)
+    return;
+  InstancesByProcess().emplace(process_id, this);
+  indexed_process_id_ = process_id;
+}
+
+void WebContentsPreferences::RemoveFromProcessIndex() {
+  if (indexed_process_id_ == -1)
+    return;
+  auto [begin, end] = InstancesByProcess().equal_range(indexed_process_id_);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == this) {
+      InstancesByProcess().erase(it);
+      break;
+    }
+  }
+  indexed_process_id_ = -1;
 }
 
 void WebContentsPreferences::Clear() {
@@ -152,6 +334,9 @@ void WebContentsPreferences::Clear() {
       blink::mojom::ImageAnimationPolicy::kImageAnimationPolicyAllowed;
   preload_path_ = absl::nullopt;
   v8_cache_options_ = blink::mojom::V8CacheOptions::kDefault;
+  max_old_space_size_ = absl::nullopt;
+  max_semi_space_size_ = absl::nullopt;
+  near_heap_limit_action_ = NearHeapLimitAction::kCrash;
 
 #if BUILDFLAG(IS_MAC)
   scroll_bounce_ = false;
@@ -250,6 +435,8 @@ void WebContentsPreferences::SetFromDictionary(
   }
 
   web_preferences.Get("v8CacheOptions", &v8_cache_options_);
+  GetHeapSizes(web_preferences, &max_old_space_size_, &max_semi_space_size_);
+  web_preferences.Get("nearHeapLimit", &near_heap_limit_action_);
 
 #if BUILDFLAG(IS_MAC)
   web_preferences.Get(options::kScrollBounce, &scroll_bounce_);
@@ -259,7 +446,7 @@ void WebContentsPreferences::SetFromDictionary(
   web_preferences.Get(options::kSpellcheck, &spellcheck_);
 #endif
 
-  SaveLastPreferences();
+  UpdateRendererProfile();
 }
 
 bool WebContentsPreferences::GetSafeDialogsMessage(std::string* message) const {
@@ -307,13 +494,13 @@ bool WebContentsPreferences::IsSandboxed() const {
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
-  for (WebContentsPreferences* preferences : Instances()) {
-    content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetPrimaryMainFrame()->GetProcess()->GetID() ==
-        process_id)
-      return web_contents;
+  WebContentsPreferences* oldest = nullptr;
+  auto [begin, end] = InstancesByProcess().equal_range(process_id);
+  for (auto it = begin; it != end; ++it) {
+    if (!oldest || it->second->creation_order_ < oldest->creation_order_)
+      oldest = it->second;
   }
-  return nullptr;
+  return oldest ? oldest->web_contents_.get() : nullptr;
 }
 
 // static
@@ -327,11 +514,6 @@ WebContentsPreferences* WebContentsPreferences::From(
 void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
-  // Experimental flags.
-  if (experimental_features_)
-    command_line->AppendSwitch(
-        ::switches::kEnableExperimentalWebPlatformFeatures);
-
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame = is_subframe && !node_integration_in_sub_frames_;
@@ -343,40 +525,117 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     command_line->AppendSwitch(::switches::kNoZygote);
   }
 
+  renderer_profile_->AppendTo(command_line);
+
+  // The heap sizes are merged into the --js-flags of |command_line|.
+  AppendV8HeapSwitches(max_old_space_size_, max_semi_space_size_,
+                       near_heap_limit_action_, command_line);
+}
+
+// static
+void WebContentsPreferences::AppendCommandLineSwitchesForPreferences(
+    const gin_helper::Dictionary& web_preferences,
+    base::CommandLine* command_line) {
+  bool experimental_features = false;
+  web_preferences.Get(options::kExperimentalFeatures, &experimental_features);
+  if (experimental_features)
+    command_line->AppendSwitch(
+        ::switches::kEnableExperimentalWebPlatformFeatures);
+
+  bool sandbox;
+  if (!web_preferences.Get(options::kSandbox, &sandbox)) {
+    bool node_integration = false;
+    bool node_integration_in_worker = false;
+    web_preferences.Get(options::kNodeIntegration, &node_integration);
+    web_preferences.Get(options::kNodeIntegrationInWorker,
+                        &node_integration_in_worker);
+    sandbox = !node_integration && !node_integration_in_worker;
+  }
+  if (sandbox) {
+    command_line->AppendSwitch(switches::kEnableSandbox);
+  } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
+    command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
+    command_line->AppendSwitch(::switches::kNoZygote);
+  }
+
 #if BUILDFLAG(IS_MAC)
-  // Enable scroll bounce.
-  if (scroll_bounce_)
+  bool scroll_bounce = false;
+  web_preferences.Get(options::kScrollBounce, &scroll_bounce);
+  if (scroll_bounce)
     command_line->AppendSwitch(switches::kScrollBounce);
 #endif
 
-  // Custom args for renderer process
-  for (const auto& arg : custom_args_)
+  std::vector<std::string> custom_args;
+  web_preferences.Get(options::kCustomArgs, &custom_args);
+  for (const auto& arg : custom_args)
     if (!arg.empty())
       command_line->AppendArg(arg);
 
-  // Custom command line switches.
-  for (const auto& arg : custom_switches_)
+  std::vector<std::string> custom_switches;
+  web_preferences.Get("commandLineSwitches", &custom_switches);
+  for (const auto& arg : custom_switches)
     if (!arg.empty())
       command_line->AppendSwitch(arg);
 
-  if (enable_blink_features_)
+  std::string blink_features;
+  if (web_preferences.Get(options::kEnableBlinkFeatures, &blink_features))
     command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures,
-                                    *enable_blink_features_);
-  if (disable_blink_features_)
+                                    blink_features);
+  if (web_preferences.Get(options::kDisableBlinkFeatures, &blink_features))
     command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures,
-                                    *disable_blink_features_);
+                                    blink_features);
 
-  if (node_integration_in_worker_)
+  bool node_integration_in_worker = false;
+  web_preferences.Get(options::kNodeIntegrationInWorker,
+                      &node_integration_in_worker);
+  if (node_integration_in_worker)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
-  // We are appending args to a webContents so let's save the current state
-  // of our preferences object so that during the lifetime of the WebContents
-  // we can fetch the options used to initially configure the WebContents
-  // last_preference_ = preference_.Clone();
-  SaveLastPreferences();
+  absl::optional<int> max_old_space_size;
+  absl::optional<int> max_semi_space_size;
+  GetHeapSizes(web_preferences, &max_old_space_size, &max_semi_space_size);
+  auto near_heap_limit_action = NearHeapLimitAction::kCrash;
+  web_preferences.Get("nearHeapLimit", &near_heap_limit_action);
+  AppendV8HeapSwitches(max_old_space_size, max_semi_space_size,
+                       near_heap_limit_action, command_line);
+}
+
+const base::Value* WebContentsPreferences::last_preference() const {
+  return &renderer_profile_->last_preferences();
 }
 
-void WebContentsPreferences::SaveLastPreferences() {
+void WebContentsPreferences::UpdateRendererProfile() {
+  SwitchList switches;
+  // Experimental flags.
+  if (experimental_features_)
+    switches.emplace_back(::switches::kEnableExperimentalWebPlatformFeatures,
+                          std::string());
+#if BUILDFLAG(IS_MAC)
+  // Enable scroll bounce.
+  if (scroll_bounce_)
+    switches.emplace_back(switches::kScrollBounce, std::string());
+#endif
+  // Custom command line switches.
+  for (const auto& arg : custom_switches_)
+    if (!arg.empty())
+      switches.emplace_back(arg, std::string());
+  if (enable_blink_features_)
+    switches.emplace_back(::switches::kEnableBlinkFeatures,
+                          *enable_blink_features_);
+  if (disable_blink_features_)
+    switches.emplace_back(::switches::kDisableBlinkFeatures,
+                          *disable_blink_features_);
+  if (node_integration_in_worker_)
+    switches.emplace_back(switches::kNodeIntegrationInWorker, std::string());
+
+  // Custom args for renderer process
+  std::vector<std::string> args;
+  for (const auto& arg : custom_args_)
+    if (!arg.empty())
+      args.push_back(arg);
+
+  // A snapshot of the preferences, so that during the lifetime of the
+  // WebContents we can fetch the options used to initially configure it.
   base::Value::Dict dict;
   dict.Set(options::kNodeIntegration, node_integration_);
   dict.Set(options::kNodeIntegrationInSubFrames,
@@ -393,7 +652,8 @@ void WebContentsPreferences::SaveLastPreferences() {
   dict.Set(options::kExperimentalFeatures, experimental_features_);
   dict.Set(options::kEnableBlinkFeatures, enable_blink_features_.value_or(""));
 
-  last_web_preferences_ = base::Value(std::move(dict));
+  renderer_profile_ = RendererProfile::Get(
+      std::move(args), std::move(switches), std::move(dict));
 }
 
 void WebContentsPreferences::OverrideWebkitPrefs(
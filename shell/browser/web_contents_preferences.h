@@ -10,7 +10,9 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/values.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "electron/buildflags/buildflags.h"
 #include "third_party/blink/public/mojom/v8_cache_options.mojom-forward.h"
@@ -28,8 +30,16 @@ namespace electron {
 
 // Stores and applies the preferences of WebContents.
 class WebContentsPreferences
-    : public content::WebContentsUserData<WebContentsPreferences> {
+    : public content::WebContentsUserData<WebContentsPreferences>,
+      public content::WebContentsObserver {
  public:
+  // What happens when the V8 heap of the renderer is near its limit.
+  enum class NearHeapLimitAction {
+    kCrash,   // The renderer runs out of memory, like without the option.
+    kNotify,  // The near-heap-limit event is emitted.
+    kReload,  // The event is emitted, then the page is reloaded.
+  };
+
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
@@ -47,10 +57,18 @@ class WebContentsPreferences
   void AppendCommandLineSwitches(base::CommandLine* command_line,
                                  bool is_subframe);
 
+  // Append the command parameters for the main frame renderer of a
+  // WebContents which will be created with |web_preferences|, for processes
+  // launched before the WebContents exists. Keep in sync with
+  // AppendCommandLineSwitches().
+  static void AppendCommandLineSwitchesForPreferences(
+      const gin_helper::Dictionary& web_preferences,
+      base::CommandLine* command_line);
+
   // Modify the WebPreferences according to preferences.
   void OverrideWebkitPrefs(blink::web_pref::WebPreferences* prefs);
 
-  base::Value* last_preference() { return &last_web_preferences_; }
+  const base::Value* last_preference() const;
 
   bool IsOffscreen() const { return offscreen_; }
   absl::optional<SkColor> GetBackgroundColor() const {
@@ -80,6 +98,9 @@ class WebContentsPreferences
   bool IsWebSecurityEnabled() const { return web_security_; }
   bool GetPreloadPath(base::FilePath* path) const;
   bool IsSandboxed() const;
+  NearHeapLimitAction GetNearHeapLimitAction() const {
+    return near_heap_limit_action_;
+  }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
@@ -88,13 +109,33 @@ class WebContentsPreferences
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // content::WebContentsObserver
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
+  void PrimaryPageChanged(content::Page& page) override;
+
+  // Files |this| under the process of the primary main frame of its
+  // WebContents, for GetWebContentsFromProcessID().
+  void UpdateProcessIndex();
+  void RemoveFromProcessIndex();
+
+  // What a set of preferences adds to the command line of its renderers,
+  // shared by all the WebContents with the same preferences.
+  class RendererProfile;
+
   void Clear();
-  void SaveLastPreferences();
+  void UpdateRendererProfile();
 
   // TODO(clavin): refactor to use the WebContents provided by the
   // WebContentsUserData base class instead of storing a duplicate ref
   raw_ptr<content::WebContents> web_contents_;
 
+  // GetWebContentsFromProcessID() returns the oldest WebContents of a
+  // process, like when it went through all of them.
+  const uint64_t creation_order_;
+  // The process |this| is filed under, -1 when none.
+  int indexed_process_id_ = -1;
+
   bool plugins_;
   bool experimental_features_;
   bool node_integration_;
@@ -134,6 +175,10 @@ class WebContentsPreferences
   blink::mojom::ImageAnimationPolicy image_animation_policy_;
   absl::optional<base::FilePath> preload_path_;
   blink::mojom::V8CacheOptions v8_cache_options_;
+  // In MB.
+  absl::optional<int> max_old_space_size_;
+  absl::optional<int> max_semi_space_size_;
+  NearHeapLimitAction near_heap_limit_action_;
 
 #if BUILDFLAG(IS_MAC)
   bool scroll_bounce_;
@@ -142,9 +187,10 @@ class WebContentsPreferences
   bool spellcheck_;
 #endif
 
-  // This is a snapshot of some relevant preferences at the time the renderer
-  // was launched.
-  base::Value last_web_preferences_;
+  // Computed when the preferences are set rather than for each renderer
+  // launch. Also has the snapshot of some relevant preferences at the time the
+  // renderer was launched.
+  scoped_refptr<const RendererProfile> renderer_profile_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
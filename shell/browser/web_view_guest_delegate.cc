@@ -69,6 +69,17 @@ void WebViewGuestDelegate::WillDestroy() {
   ResetZoomController();
 }
 
+void WebViewGuestDelegate::SetElementVisible(bool visible) {
+  content::WebContents* guest_web_contents = api_web_contents_->web_contents();
+  if (!visible) {
+    guest_web_contents->WasHidden();
+  } else if (embedder_web_contents_ &&
+             embedder_web_contents_->GetVisibility() ==
+                 content::Visibility::VISIBLE) {
+    guest_web_contents->WasShown();
+  }
+}
+
 content::WebContents* WebViewGuestDelegate::GetOwnerWebContents() {
   return embedder_web_contents_;
 }
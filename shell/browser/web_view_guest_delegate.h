@@ -33,6 +33,11 @@ class WebViewGuestDelegate : public content::BrowserPluginGuestDelegate,
                       int embedder_frame_id);
   void WillDestroy();
 
+  // Shows or hides the guest independently of its embedder, when its
+  // <webview> element is shown or hidden. The guest is only shown while the
+  // embedder is visible.
+  void SetElementVisible(bool visible);
+
  protected:
   // content::BrowserPluginGuestDelegate:
   content::WebContents* GetOwnerWebContents() final;
@@ -0,0 +1,148 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/window_batch.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "build/build_config.h"
+#include "shell/browser/native_window.h"
+
+namespace electron {
+
+namespace {
+
+WindowBatch* g_current_batch = nullptr;
+
+}  // namespace
+
+WindowBatch::Changes::Changes() = default;
+WindowBatch::Changes::Changes(Changes&&) = default;
+WindowBatch::Changes& WindowBatch::Changes::operator=(Changes&&) = default;
+WindowBatch::Changes::~Changes() = default;
+
+WindowBatch::WindowBatch() = default;
+
+WindowBatch::~WindowBatch() = default;
+
+// static
+WindowBatch* WindowBatch::Current() {
+  return g_current_batch;
+}
+
+// static
+void WindowBatch::Begin() {
+  if (!g_current_batch)
+    g_current_batch = new WindowBatch();
+  g_current_batch->depth_++;
+}
+
+// static
+void WindowBatch::End() {
+  if (!g_current_batch || --g_current_batch->depth_ > 0)
+    return;
+  // Applying the changes can run JavaScript, which must not see the batch.
+  std::unique_ptr<WindowBatch> batch(g_current_batch);
+  g_current_batch = nullptr;
+  batch->Apply();
+}
+
+void WindowBatch::SetBounds(NativeWindow* window, const gfx::Rect& bounds) {
+  GetChanges(window).bounds = bounds;
+}
+
+absl::optional<gfx::Rect> WindowBatch::GetPendingBounds(
+    NativeWindow* window) const {
+  for (const Changes& changes : changes_) {
+    if (changes.window.get() == window)
+      return changes.bounds;
+  }
+  return absl::nullopt;
+}
+
+void WindowBatch::SetOpacity(NativeWindow* window, double opacity) {
+  GetChanges(window).opacity = opacity;
+}
+
+void WindowBatch::SetZOrderLevel(NativeWindow* window,
+                                 ui::ZOrderLevel z_order,
+                                 const std::string& level,
+                                 int relative_level) {
+  GetChanges(window).z_order = ZOrder{z_order, level, relative_level};
+}
+
+void WindowBatch::SetVisibility(NativeWindow* window, Visibility visibility) {
+  GetChanges(window).visibility = visibility;
+}
+
+WindowBatch::Changes& WindowBatch::GetChanges(NativeWindow* window) {
+  auto it = std::find_if(changes_.begin(), changes_.end(),
+                         [window](const Changes& changes) {
+                           return changes.window.get() == window;
+                         });
+  if (it != changes_.end())
+    return *it;
+  Changes& changes = changes_.emplace_back();
+  changes.window = window->GetWeakPtr();
+  return changes;
+}
+
+void WindowBatch::Apply() {
+  RunGrouped(base::BindOnce(
+      [](std::vector<Changes> all_changes) {
+        // Windows are hidden before and shown after they are moved, so that
+        // they never show up at their old place.
+        // The events of the windows run JavaScript, which can close them.
+        WindowBounds bounds;
+        for (const Changes& changes : all_changes) {
+          NativeWindow* window = changes.window.get();
+          if (!window)
+            continue;
+          if (changes.z_order) {
+            window->SetAlwaysOnTop(changes.z_order->z_order,
+                                   changes.z_order->level,
+                                   changes.z_order->relative_level);
+          }
+          if (changes.opacity)
+            window->SetOpacity(*changes.opacity);
+          if (changes.visibility == Visibility::kHide)
+            window->Hide();
+          if (changes.bounds)
+            bounds.emplace_back(window->GetWeakPtr(), *changes.bounds);
+        }
+        ApplyBounds(bounds);
+        for (const Changes& changes : all_changes) {
+          NativeWindow* window = changes.window.get();
+          if (!window || !changes.visibility)
+            continue;
+          if (*changes.visibility == Visibility::kShow)
+            window->Show();
+          else if (*changes.visibility == Visibility::kShowInactive)
+            window->ShowInactive();
+        }
+      },
+      std::move(changes_)));
+}
+
+#if !BUILDFLAG(IS_MAC)
+// static
+void WindowBatch::RunGrouped(base::OnceClosure apply) {
+  std::move(apply).Run();
+}
+#endif
+
+#if !BUILDFLAG(IS_WIN)
+// static
+void WindowBatch::ApplyBounds(const WindowBounds& bounds) {
+  for (const auto& [window, window_bounds] : bounds) {
+    if (window)
+      window->SetBounds(window_bounds, false /* animate */);
+  }
+}
+#endif
+
+}  // namespace electron
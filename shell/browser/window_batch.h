@@ -0,0 +1,99 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_WINDOW_BATCH_H_
+#define ELECTRON_SHELL_BROWSER_WINDOW_BATCH_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/functional/callback_forward.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "ui/base/ui_base_types.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace electron {
+
+class NativeWindow;
+
+// Defers the changes made to windows between Begin() and End(), for
+// BaseWindow.batch(). Each window only keeps the last of its bounds,
+// opacity, z-order level and visibility, which are all applied at once when
+// the outermost batch ends: the bounds in one transaction on Windows, and
+// everything in one animation group on macOS, instead of one layout and OS
+// round trip per call.
+class WindowBatch {
+ public:
+  enum class Visibility {
+    kShow,
+    kShowInactive,
+    kHide,
+  };
+
+  // Null when no batch is open.
+  static WindowBatch* Current();
+  // Batches can be nested, the changes are applied when the outermost one
+  // ends.
+  static void Begin();
+  static void End();
+
+  // disable copy
+  WindowBatch(const WindowBatch&) = delete;
+  WindowBatch& operator=(const WindowBatch&) = delete;
+
+  void SetBounds(NativeWindow* window, const gfx::Rect& bounds);
+  // The bounds |window| will get, if they were changed in the batch.
+  absl::optional<gfx::Rect> GetPendingBounds(NativeWindow* window) const;
+  void SetOpacity(NativeWindow* window, double opacity);
+  void SetZOrderLevel(NativeWindow* window,
+                      ui::ZOrderLevel z_order,
+                      const std::string& level,
+                      int relative_level);
+  void SetVisibility(NativeWindow* window, Visibility visibility);
+
+ private:
+  struct ZOrder {
+    ui::ZOrderLevel z_order;
+    std::string level;
+    int relative_level;
+  };
+
+  struct Changes {
+    Changes();
+    Changes(Changes&&);
+    Changes& operator=(Changes&&);
+    ~Changes();
+
+    base::WeakPtr<NativeWindow> window;
+    absl::optional<gfx::Rect> bounds;
+    absl::optional<double> opacity;
+    absl::optional<ZOrder> z_order;
+    absl::optional<Visibility> visibility;
+  };
+
+  using WindowBounds =
+      std::vector<std::pair<base::WeakPtr<NativeWindow>, gfx::Rect>>;
+
+  WindowBatch();
+  ~WindowBatch();
+
+  Changes& GetChanges(NativeWindow* window);
+  void Apply();
+
+  // Runs |apply| in a single transaction of the windowing system, where it
+  // has one.
+  static void RunGrouped(base::OnceClosure apply);
+  // Moves and resizes the windows together.
+  static void ApplyBounds(const WindowBounds& bounds);
+
+  // In the order the windows were first changed.
+  std::vector<Changes> changes_;
+  int depth_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_WINDOW_BATCH_H_
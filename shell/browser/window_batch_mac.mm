@@ -0,0 +1,29 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/window_batch.h"
+
+#import <Cocoa/Cocoa.h>
+#import <QuartzCore/QuartzCore.h>
+
+#include <utility>
+
+#include "base/functional/callback.h"
+
+namespace electron {
+
+// static
+void WindowBatch::RunGrouped(base::OnceClosure apply) {
+  // The window server gets all the changes in one commit, without the
+  // implicit animations.
+  [NSAnimationContext beginGrouping];
+  [[NSAnimationContext currentContext] setDuration:0];
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  std::move(apply).Run();
+  [CATransaction commit];
+  [NSAnimationContext endGrouping];
+}
+
+}  // namespace electron
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/window_batch.h"
+
+#include <windows.h>
+
+#include "shell/browser/native_window.h"
+#include "ui/display/win/screen_win.h"
+
+namespace electron {
+
+// static
+void WindowBatch::ApplyBounds(const WindowBounds& bounds) {
+  // Maximized, minimized, fullscreen and fixed-size windows go through
+  // views, which keeps track of their state and size constraints.
+  WindowBounds deferred;
+  for (const auto& [window, window_bounds] : bounds) {
+    if (!window)
+      continue;
+    if (!window->IsNormal() || !window->IsResizable())
+      window->SetBounds(window_bounds, false /* animate */);
+    else
+      deferred.emplace_back(window, window_bounds);
+  }
+  if (deferred.empty())
+    return;
+
+  // The windows are moved in a single pass of the window manager, which
+  // repaints them once.
+  HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(deferred.size()));
+  for (const auto& [window, window_bounds] : deferred) {
+    if (!hdwp)
+      break;
+    HWND hwnd = window->GetAcceleratedWidget();
+    const gfx::Rect pixels =
+        display::win::ScreenWin::DIPToScreenRect(hwnd, window_bounds);
+    hdwp = ::DeferWindowPos(hdwp, hwnd, nullptr, pixels.x(), pixels.y(),
+                            pixels.width(), pixels.height(),
+                            SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE);
+  }
+  if (hdwp && ::EndDeferWindowPos(hdwp))
+    return;
+
+  // DeferWindowPos() frees the transaction when it fails.
+  for (const auto& [window, window_bounds] : deferred) {
+    if (window)
+      window->SetBounds(window_bounds, false /* animate */);
+  }
+}
+
+}  // namespace electron
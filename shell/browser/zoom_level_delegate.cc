@@ -30,6 +30,10 @@ const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 // be displayed at the default zoom level.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+// A zoom gesture changes the level of the host many times in a row, only the
+// last level is worth writing.
+constexpr base::TimeDelta kCommitDelay = base::Milliseconds(500);
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
@@ -50,7 +54,10 @@ ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
   partition_key_ = GetHash(partition_path);
 }
 
-ZoomLevelDelegate::~ZoomLevelDelegate() = default;
+ZoomLevelDelegate::~ZoomLevelDelegate() {
+  // The prefs outlive the storage partitions of the browser context.
+  CommitPendingHostZoomLevels();
+}
 
 void ZoomLevelDelegate::SetDefaultZoomLevelPref(double level) {
   if (blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel()))
@@ -75,11 +82,27 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     return;
 
   double level = change.zoom_level;
-  ScopedDictPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-  base::Value::Dict& host_zoom_dictionaries = update.Get();
-
   bool modification_is_removal =
       blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
+  pending_host_zoom_levels_[change.host] =
+      modification_is_removal ? absl::nullopt : absl::make_optional(level);
+
+  if (!commit_timer_.IsRunning()) {
+    // Unretained is safe as |commit_timer_| is owned by |this|.
+    commit_timer_.Start(
+        FROM_HERE, kCommitDelay,
+        base::BindOnce(&ZoomLevelDelegate::CommitPendingHostZoomLevels,
+                       base::Unretained(this)));
+  }
+}
+
+void ZoomLevelDelegate::CommitPendingHostZoomLevels() {
+  commit_timer_.Stop();
+  if (pending_host_zoom_levels_.empty())
+    return;
+
+  ScopedDictPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
+  base::Value::Dict& host_zoom_dictionaries = update.Get();
 
   base::Value::Dict* host_zoom_dictionary =
       host_zoom_dictionaries.FindDict(partition_key_);
@@ -89,10 +112,13 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     host_zoom_dictionary = host_zoom_dictionaries.FindDict(partition_key_);
   }
 
-  if (modification_is_removal)
-    host_zoom_dictionary->Remove(change.host);
-  else
-    host_zoom_dictionary->Set(change.host, base::Value(level));
+  for (const auto& [host, level] : pending_host_zoom_levels_) {
+    if (level)
+      host_zoom_dictionary->Set(host, base::Value(*level));
+    else
+      host_zoom_dictionary->Remove(host);
+  }
+  pending_host_zoom_levels_.clear();
 }
 
 void ZoomLevelDelegate::ExtractPerHostZoomLevels(
@@ -7,11 +7,14 @@
 
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/zoom_level_delegate.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace base {
 class FilePath;
@@ -26,7 +29,8 @@ namespace electron {
 // levels in HostZoomMap and preference system. All changes
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
-// OnZoomLevelChanged.
+// OnZoomLevelChanged. HostZoomMap keeps the levels in memory for the
+// navigations, so the per-host changes are written to the prefs in batches.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
@@ -53,10 +57,19 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   // zoom levels (if any) managed by this class (for its associated partition).
   void OnZoomLevelChanged(const content::HostZoomMap::ZoomLevelChange& change);
 
+  // Writes the per-host changes received since the last commit to the prefs.
+  void CommitPendingHostZoomLevels();
+
   raw_ptr<PrefService> pref_service_;
   raw_ptr<content::HostZoomMap> host_zoom_map_ = nullptr;
   base::CallbackListSubscription zoom_subscription_;
   std::string partition_key_;
+
+  // The per-host levels which are not written to the prefs yet, by host. A
+  // null level removes the host.
+  base::flat_map<std::string, absl::optional<double>>
+      pending_host_zoom_levels_;
+  base::OneShotTimer commit_timer_;
 };
 
 }  // namespace electron
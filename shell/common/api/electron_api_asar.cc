@@ -2,10 +2,15 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+#include <memory>
 #include <vector>
 
+#include "base/functional/callback_helpers.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/handle.h"
 #include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_compression.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -14,6 +19,52 @@
 
 namespace {
 
+// The kinds of entries returned by the compact stat calls.
+enum StatKind : int32_t {
+  kNotFound = -1,
+  kFile = 0,
+  kDirectory = 1,
+  kLink = 2,
+};
+
+// What internalModuleStat returns, -ENOENT as node's fs binding reports it
+// for missing paths, or -1 for paths which aren't in an archive.
+constexpr int32_t kModuleNotFound = -34;
+constexpr int32_t kModuleNotInArchive = -1;
+
+int32_t GetStatKind(const asar::Archive& archive,
+                    const base::FilePath& path,
+                    asar::Archive::Stats* stats) {
+  if (!archive.Stat(path, stats))
+    return kNotFound;
+  if (stats->is_directory)
+    return kDirectory;
+  return stats->is_link ? kLink : kFile;
+}
+
+int32_t GetModuleStat(const base::FilePath& path) {
+  base::FilePath asar_path, file_path;
+  if (!asar::GetAsarArchivePath(path, &asar_path, &file_path, true))
+    return kModuleNotInArchive;
+  std::shared_ptr<asar::Archive> archive =
+      asar::GetOrCreateAsarArchive(asar_path);
+  asar::Archive::Stats stats;
+  if (!archive || !archive->Stat(file_path, &stats))
+    return kModuleNotFound;
+  return stats.is_directory ? 1 : 0;
+}
+
+v8::Local<v8::Int32Array> ToInt32Array(v8::Isolate* isolate,
+                                       const std::vector<int32_t>& values) {
+  v8::Local<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(isolate, values.size() * sizeof(int32_t));
+  if (!values.empty()) {
+    memcpy(buffer->GetBackingStore()->Data(), values.data(),
+           values.size() * sizeof(int32_t));
+  }
+  return v8::Int32Array::New(buffer, 0, values.size());
+}
+
 class Archive : public node::ObjectWrap {
  public:
   static v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
@@ -24,12 +75,18 @@ class Archive : public node::ObjectWrap {
     tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFileInfo", &Archive::GetFileInfo);
-    NODE_SET_PROTOTYPE_METHOD(tpl, "stat", &Archive::Stat);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "statValues", &Archive::StatValues);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "statKinds", &Archive::StatKinds);
     NODE_SET_PROTOTYPE_METHOD(tpl, "readdir", &Archive::Readdir);
     NODE_SET_PROTOTYPE_METHOD(tpl, "realpath", &Archive::Realpath);
     NODE_SET_PROTOTYPE_METHOD(tpl, "copyFileOut", &Archive::CopyFileOut);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "prefetchFilesOut",
+                              &Archive::PrefetchFilesOut);
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFdAndValidateIntegrityLater",
                               &Archive::GetFD);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readMappedAndValidateIntegrityLater",
+                              &Archive::ReadMapped);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readCompressed", &Archive::ReadCompressed);
 
     return tpl;
   }
@@ -85,6 +142,8 @@ class Archive : public node::ObjectWrap {
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
     dict.Set("offset", info.offset);
+    if (info.compression.has_value())
+      dict.Set("packedSize", info.compression->packed_size);
     if (info.integrity.has_value()) {
       gin_helper::Dictionary integrity(isolate, v8::Object::New(isolate));
       asar::HashAlgorithm algorithm = info.integrity.value().algorithm;
@@ -102,29 +161,50 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(dict.GetHandle());
   }
 
-  // Returns a fake result of fs.stat(path).
-  static void Stat(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  // Returns the StatKind of path for a fake result of fs.stat(path), and
+  // writes its size and offset to the Float64Array when one is passed, so
+  // that no object is created per call.
+  static void StatValues(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
     auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
     base::FilePath path;
-    if (!gin::ConvertFromV8(isolate, args[0], &path)) {
-      args.GetReturnValue().Set(v8::False(isolate));
+    asar::Archive::Stats stats;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &path)) {
+      args.GetReturnValue().Set(kNotFound);
       return;
     }
 
-    asar::Archive::Stats stats;
-    if (!wrap->archive_ || !wrap->archive_->Stat(path, &stats)) {
+    const int32_t kind = GetStatKind(*wrap->archive_, path, &stats);
+    if (kind != kNotFound && args[1]->IsFloat64Array()) {
+      v8::Local<v8::Float64Array> values = args[1].As<v8::Float64Array>();
+      if (values->Length() >= 2) {
+        double* data = reinterpret_cast<double*>(
+            static_cast<uint8_t*>(values->Buffer()->GetBackingStore()->Data()) +
+            values->ByteOffset());
+        data[0] = stats.size;
+        data[1] = stats.offset;
+      }
+    }
+    args.GetReturnValue().Set(kind);
+  }
+
+  // Returns the StatKinds of many paths in an Int32Array, such as the
+  // entries of a directory.
+  static void StatKinds(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    std::vector<base::FilePath> paths;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &paths)) {
       args.GetReturnValue().Set(v8::False(isolate));
       return;
     }
 
-    gin_helper::Dictionary dict(isolate, v8::Object::New(isolate));
-    dict.Set("size", stats.size);
-    dict.Set("offset", stats.offset);
-    dict.Set("isFile", stats.is_file);
-    dict.Set("isDirectory", stats.is_directory);
-    dict.Set("isLink", stats.is_link);
-    args.GetReturnValue().Set(dict.GetHandle());
+    std::vector<int32_t> kinds;
+    kinds.reserve(paths.size());
+    asar::Archive::Stats stats;
+    for (const base::FilePath& path : paths)
+      kinds.push_back(GetStatKind(*wrap->archive_, path, &stats));
+    args.GetReturnValue().Set(ToInt32Array(isolate, kinds));
   }
 
   // Returns all files under a directory.
@@ -173,6 +253,7 @@ class Archive : public node::ObjectWrap {
       return;
     }
 
+    TRACE_EVENT0("electron", "Archive::CopyFileOut");
     base::FilePath new_path;
     if (!wrap->archive_ || !wrap->archive_->CopyFileOut(path, &new_path)) {
       args.GetReturnValue().Set(v8::False(isolate));
@@ -181,6 +262,20 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(gin::ConvertToV8(isolate, new_path));
   }
 
+  // Starts copying files out in the background, so that later copyFileOut
+  // calls for them don't have to wait.
+  static void PrefetchFilesOut(
+      const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    std::vector<base::FilePath> paths;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &paths))
+      return;
+
+    asar::PrefetchFilesOut(wrap->archive_, std::move(paths),
+                           base::DoNothing());
+  }
+
   // Return the file descriptor.
   static void GetFD(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
@@ -190,6 +285,74 @@ class Archive : public node::ObjectWrap {
         isolate, wrap->archive_ ? wrap->archive_->GetUnsafeFD() : -1));
   }
 
+  // Copies a packed file straight out of the memory-mapped archive into a new
+  // Buffer. Returns false when the caller should read through the fd instead.
+  static void ReadMapped(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    asar::Archive::FileInfo info;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &info.offset) ||
+        !gin::ConvertFromV8(isolate, args[1], &info.size)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    TRACE_EVENT1("electron", "Archive::ReadMapped", "size", info.size);
+    absl::optional<base::span<const uint8_t>> contents =
+        wrap->archive_->GetFileContents(info);
+    v8::Local<v8::Object> buffer;
+    if (!contents ||
+        !node::Buffer::Copy(isolate,
+                            reinterpret_cast<const char*>(contents->data()),
+                            contents->size())
+             .ToLocal(&buffer)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
+  // Decompresses a compressed file into a new Buffer, validating its
+  // integrity. Reads its frames from the archive unless they are passed as
+  // the second argument. Returns false on failure.
+  static void ReadCompressed(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+
+    base::FilePath path;
+    asar::Archive::FileInfo info;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &path) ||
+        !wrap->archive_->GetFileInfo(path, &info) ||
+        !info.compression.has_value()) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    absl::optional<base::span<const uint8_t>> frames;
+    if (node::Buffer::HasInstance(args[1])) {
+      frames = base::make_span(
+          reinterpret_cast<const uint8_t*>(node::Buffer::Data(args[1])),
+          node::Buffer::Length(args[1]));
+      if (frames->size() != info.compression->packed_size) {
+        args.GetReturnValue().Set(v8::False(isolate));
+        return;
+      }
+    }
+
+    TRACE_EVENT1("electron", "Archive::ReadCompressed", "size", info.size);
+    v8::Local<v8::Object> buffer;
+    if (!node::Buffer::New(isolate, info.size).ToLocal(&buffer) ||
+        !asar::CompressedFileReader(wrap->archive_.get(), info, frames)
+             .ReadAll(base::make_span(
+                 reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer)),
+                 node::Buffer::Length(buffer)))) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
   std::shared_ptr<asar::Archive> archive_;
 };
 
@@ -227,6 +390,35 @@ static void SplitPath(const v8::FunctionCallbackInfo<v8::Value>& args) {
   args.GetReturnValue().Set(dict.GetHandle());
 }
 
+// The result of internalModuleStat for a full path, without splitting it
+// and creating the objects of the archive and of the stats in JavaScript.
+static void ModuleStat(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  base::FilePath path;
+  if (!gin::ConvertFromV8(args.GetIsolate(), args[0], &path)) {
+    args.GetReturnValue().Set(kModuleNotInArchive);
+    return;
+  }
+  args.GetReturnValue().Set(GetModuleStat(path));
+}
+
+// Same as ModuleStat for many paths in one call, such as the candidates
+// module resolution tries for a request.
+static void ModuleStats(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  auto* isolate = args.GetIsolate();
+  std::vector<base::FilePath> paths;
+  if (!gin::ConvertFromV8(isolate, args[0], &paths)) {
+    args.GetReturnValue().Set(v8::False(isolate));
+    return;
+  }
+
+  TRACE_EVENT1("electron", "asar::ModuleStats", "count", paths.size());
+  std::vector<int32_t> results;
+  results.reserve(paths.size());
+  for (const base::FilePath& path : paths)
+    results.push_back(GetModuleStat(path));
+  args.GetReturnValue().Set(ToInt32Array(isolate, results));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -241,6 +433,8 @@ void Initialize(v8::Local<v8::Object> exports,
   exports->Set(context, node::FIXED_ONE_BYTE_STRING(isolate, "Archive"), cons)
       .Check();
   NODE_SET_METHOD(exports, "splitPath", &SplitPath);
+  NODE_SET_METHOD(exports, "moduleStat", &ModuleStat);
+  NODE_SET_METHOD(exports, "moduleStats", &ModuleStats);
   NODE_SET_METHOD(exports, "initAsarSupport", &InitAsarSupport);
 }
 
@@ -5,11 +5,16 @@
 #include "shell/common/api/electron_api_clipboard.h"
 
 #include <map>
+#include <memory>
+#include <utility>
 
 #include "base/containers/contains.h"
+#include "base/containers/span.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -20,6 +25,37 @@
 
 namespace electron::api {
 
+namespace {
+
+// ui::Clipboard is only used on the thread it belongs to, as the platforms
+// require, so the async methods only move the work on the payloads off it.
+
+SkBitmap DecodePng(const std::vector<uint8_t>& png) {
+  SkBitmap bitmap;
+  gfx::PNGCodec::Decode(png.data(), png.size(), &bitmap);
+  return bitmap;
+}
+
+mojo_base::BigBuffer CopyPayload(std::shared_ptr<v8::BackingStore> store,
+                                 size_t offset,
+                                 size_t length) {
+  return mojo_base::BigBuffer(base::make_span(
+      static_cast<const uint8_t*>(store->Data()) + offset, length));
+}
+
+void WritePayload(gin_helper::Promise<void> promise,
+                  ui::ClipboardBuffer clipboard_buffer,
+                  const std::u16string& format,
+                  mojo_base::BigBuffer payload) {
+  {
+    ui::ScopedClipboardWriter writer(clipboard_buffer);
+    writer.WriteUnsafeRawData(format, std::move(payload));
+  }
+  promise.Resolve();
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -37,6 +73,15 @@ std::vector<std::u16string> Clipboard::AvailableFormats(
   return format_types;
 }
 
+std::vector<std::u16string> Clipboard::AvailablePlatformFormats(
+    gin_helper::Arguments* args) {
+  // Only lists the formats, unlike ReadAvailableTypes() which reads the
+  // custom data of web pages to list the types in it.
+  return ui::Clipboard::GetForCurrentThread()
+      ->ReadAvailablePlatformSpecificFormatNames(GetClipboardBuffer(args),
+                                                 /* data_dst = */ nullptr);
+}
+
 bool Clipboard::Has(const std::string& format_string,
                     gin_helper::Arguments* args) {
   ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
@@ -116,6 +161,29 @@ void Clipboard::WriteBuffer(const std::string& format,
                             mojo_base::BigBuffer(payload_span));
 }
 
+v8::Local<v8::Promise> Clipboard::WriteBufferAsync(
+    const std::string& format,
+    const v8::Local<v8::Value> buffer,
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  // The payload is copied off the thread, straight out of the buffer's
+  // backing store which is kept alive until then.
+  v8::Local<v8::ArrayBufferView> view = buffer.As<v8::ArrayBufferView>();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&CopyPayload, view->Buffer()->GetBackingStore(),
+                     view->ByteOffset(), view->ByteLength()),
+      base::BindOnce(&WritePayload, std::move(promise),
+                     GetClipboardBuffer(args), base::UTF8ToUTF16(format)));
+  return handle;
+}
+
 void Clipboard::Write(const gin_helper::Dictionary& data,
                       gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
@@ -236,6 +304,30 @@ gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
   return image.value();
 }
 
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadPng(
+      GetClipboardBuffer(args),
+      /* data_dst = */ nullptr,
+      base::BindOnce(
+          [](gin_helper::Promise<gfx::Image> promise,
+             const std::vector<uint8_t>& png) {
+            base::ThreadPool::PostTaskAndReplyWithResult(
+                FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                base::BindOnce(&DecodePng, png),
+                base::BindOnce(
+                    [](gin_helper::Promise<gfx::Image> promise,
+                       const SkBitmap& bitmap) {
+                      promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
+                    },
+                    std::move(promise)));
+          },
+          std::move(promise)));
+  return handle;
+}
+
 void Clipboard::WriteImage(const gfx::Image& image,
                            gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
@@ -270,6 +362,8 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("availableFormats",
                  &electron::api::Clipboard::AvailableFormats);
+  dict.SetMethod("availablePlatformFormats",
+                 &electron::api::Clipboard::AvailablePlatformFormats);
   dict.SetMethod("has", &electron::api::Clipboard::Has);
   dict.SetMethod("read", &electron::api::Clipboard::Read);
   dict.SetMethod("write", &electron::api::Clipboard::Write);
@@ -283,10 +377,13 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
+  dict.SetMethod("writeBufferAsync",
+                 &electron::api::Clipboard::WriteBufferAsync);
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
 }
 
@@ -28,6 +28,8 @@ class Clipboard {
   static ui::ClipboardBuffer GetClipboardBuffer(gin_helper::Arguments* args);
   static std::vector<std::u16string> AvailableFormats(
       gin_helper::Arguments* args);
+  static std::vector<std::u16string> AvailablePlatformFormats(
+      gin_helper::Arguments* args);
   static bool Has(const std::string& format_string,
                   gin_helper::Arguments* args);
   static void Clear(gin_helper::Arguments* args);
@@ -54,6 +56,7 @@ class Clipboard {
 
   static gfx::Image ReadImage(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
 
   static std::u16string ReadFindText();
   static void WriteFindText(const std::u16string& text);
@@ -63,6 +66,10 @@ class Clipboard {
   static void WriteBuffer(const std::string& format_string,
                           const v8::Local<v8::Value> buffer,
                           gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> WriteBufferAsync(
+      const std::string& format_string,
+      const v8::Local<v8::Value> buffer,
+      gin_helper::Arguments* args);
 };
 
 }  // namespace electron::api
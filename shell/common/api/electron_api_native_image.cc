@@ -11,10 +11,16 @@
 
 #include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/barrier_callback.h"
+#include "base/containers/span.h"
+#include "base/functional/bind.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
 #include "gin/arguments.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
@@ -22,17 +28,21 @@
 #include "net/base/data_url.h"
 #include "shell/browser/browser.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/decoded_image_cache.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/process_util.h"
 #include "shell/common/skia_util.h"
 #include "shell/common/thread_restrictions.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -41,6 +51,7 @@
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/codec/webp_codec.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
@@ -119,6 +130,182 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 }
 #endif
 
+// Identifies the images decoded from identical contents.
+std::string HashImageFiles(
+    base::StringPiece type,
+    const std::vector<electron::util::ImageFile>& files) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  hash->Update(type.data(), type.size());
+  for (const electron::util::ImageFile& file : files) {
+    hash->Update(&file.scale_factor, sizeof(file.scale_factor));
+    const uint64_t size = file.contents.size();
+    hash->Update(&size, sizeof(size));
+    hash->Update(file.contents.data(), file.contents.size());
+  }
+  std::string key(crypto::kSHA256Length, '\0');
+  hash->Finish(key.data(), key.size());
+  return key;
+}
+
+enum class EncodeFormat { kPNG, kJPEG, kWebP };
+
+// Runs on the thread pool, |bitmap| shares its pixels with the image so
+// nothing is copied before the encoding.
+std::vector<uint8_t> EncodeBitmap(EncodeFormat format,
+                                  int quality,
+                                  const SkBitmap& bitmap) {
+  std::vector<uint8_t> output;
+  switch (format) {
+    case EncodeFormat::kPNG:
+      gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &output);
+      break;
+    case EncodeFormat::kJPEG:
+      gfx::JPEGCodec::Encode(bitmap, quality, &output);
+      break;
+    case EncodeFormat::kWebP:
+      if (auto webp = gfx::WebpCodec::Encode(bitmap, quality))
+        output = std::move(*webp);
+      break;
+  }
+  return output;
+}
+
+void ResolveWithBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       base::span<const uint8_t> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  // The memory cage doesn't let Buffers adopt memory allocated outside of it,
+  // so this is the one copy of the encoded data.
+  promise.Resolve(node::Buffer::Copy(isolate,
+                                     reinterpret_cast<const char*>(data.data()),
+                                     data.size())
+                      .ToLocalChecked());
+}
+
+void OnBitmapEncoded(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                     std::vector<uint8_t> output) {
+  ResolveWithBuffer(std::move(promise), output);
+}
+
+v8::Local<v8::Promise> EncodeBitmapAsync(v8::Isolate* isolate,
+                                         EncodeFormat format,
+                                         int quality,
+                                         const SkBitmap& bitmap) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EncodeBitmap, format, quality, bitmap),
+      base::BindOnce(&OnBitmapEncoded, std::move(promise)));
+  return handle;
+}
+
+SkBitmap DecodeBitmap(std::vector<uint8_t> data, int width, int height) {
+  SkBitmap bitmap;
+  electron::util::DecodeBitmapFromBuffer(data.data(), data.size(), width,
+                                         height, &bitmap);
+  return bitmap;
+}
+
+void OnBitmapDecoded(gin_helper::Promise<gfx::Image> promise,
+                     double scale_factor,
+                     SkBitmap bitmap) {
+  gfx::ImageSkia image_skia;
+  if (!bitmap.drawsNothing())
+    image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
+  promise.Resolve(gfx::Image(image_skia));
+}
+
+// Returns the size in DIPs of |image| resized with |options|, or
+// absl::nullopt when the resized image is empty.
+absl::optional<gfx::Size> GetResizedSize(const gfx::ImageSkia& image,
+                                         float scale_factor,
+                                         const base::Value::Dict& options) {
+  gfx::ImageSkiaRep image_rep = image.GetRepresentation(scale_factor);
+  gfx::Size size(image_rep.GetWidth(), image_rep.GetHeight());
+  const float aspect_ratio =
+      size.IsEmpty() ? 1.f
+                     : static_cast<float>(size.width()) /
+                           static_cast<float>(size.height());
+
+  absl::optional<int> new_width = options.FindInt("width");
+  absl::optional<int> new_height = options.FindInt("height");
+  int width = new_width.value_or(size.width());
+  int height = new_height.value_or(size.height());
+  size.SetSize(width, height);
+
+  if (width <= 0 && height <= 0) {
+    return absl::nullopt;
+  } else if (new_width && !new_height) {
+    // Scale height to preserve original aspect ratio
+    size.set_height(width);
+    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / aspect_ratio);
+  } else if (new_height && !new_width) {
+    // Scale width to preserve original aspect ratio
+    size.set_width(height);
+    size = gfx::ScaleToRoundedSize(size, aspect_ratio, 1.f);
+  }
+  return size;
+}
+
+skia::ImageOperations::ResizeMethod GetResizeMethod(
+    const base::Value::Dict& options) {
+  const std::string* quality = options.FindString("quality");
+  if (quality && *quality == "good")
+    return skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality && *quality == "better")
+    return skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+}
+
+// The bitmaps of an image with their scale factors, gfx::ImageSkia itself
+// can't leave the main thread.
+using BitmapReps = std::vector<std::pair<float, SkBitmap>>;
+
+// Runs on the thread pool, each representation is resized to |size| in DIPs
+// like gfx::ImageSkiaOperations::CreateResizedImage does.
+std::pair<size_t, BitmapReps> ResizeBitmapReps(
+    size_t index,
+    BitmapReps reps,
+    skia::ImageOperations::ResizeMethod method,
+    const gfx::Size& size) {
+  for (auto& [scale, bitmap] : reps) {
+    const gfx::Size pixel_size = gfx::ScaleToCeiledSize(size, scale);
+    bitmap = skia::ImageOperations::Resize(bitmap, method, pixel_size.width(),
+                                           pixel_size.height());
+  }
+  return {index, std::move(reps)};
+}
+
+void OnImagesResized(gin_helper::Promise<std::vector<gfx::Image>> promise,
+                     std::vector<std::pair<size_t, BitmapReps>> results) {
+  // The images are resized in parallel and finish in any order.
+  std::vector<gfx::Image> images(results.size());
+  for (const auto& [index, reps] : results) {
+    gfx::ImageSkia image_skia;
+    for (const auto& [scale, bitmap] : reps) {
+      if (!bitmap.drawsNothing())
+        image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, scale));
+    }
+    images[index] = gfx::Image(image_skia);
+  }
+  promise.Resolve(images);
+}
+
+bool GetBitmapColorType(base::StringPiece format, SkColorType* out) {
+  if (format == "bgra")
+    *out = kBGRA_8888_SkColorType;
+  else if (format == "rgba")
+    *out = kRGBA_8888_SkColorType;
+  else
+    return false;
+  return true;
+}
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
@@ -143,6 +330,19 @@ NativeImage::NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path)
 
 NativeImage::~NativeImage() {
   isolate_->AdjustAmountOfExternalAllocatedMemory(-memory_usage_);
+  if (!cache_key_.empty()) {
+    if (auto* cache = DecodedImageCache::Get())
+      cache->Release(cache_key_);
+  }
+}
+
+void NativeImage::DetachFromCache() {
+  if (cache_key_.empty())
+    return;
+  image_ = gfx::Image(*image_.AsImageSkia().DeepCopy());
+  if (auto* cache = DecodedImageCache::Get())
+    cache->Release(cache_key_);
+  cache_key_.clear();
 }
 
 void NativeImage::UpdateExternalAllocatedMemoryUsage() {
@@ -263,6 +463,54 @@ v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
   return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
 }
 
+v8::Local<v8::Value> NativeImage::CopyBitmapTo(
+    gin_helper::ErrorThrower thrower,
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  void* data = nullptr;
+  size_t length = 0;
+  if (buffer->IsArrayBufferView()) {
+    auto view = buffer.As<v8::ArrayBufferView>();
+    data = static_cast<uint8_t*>(view->Buffer()->Data()) + view->ByteOffset();
+    length = view->ByteLength();
+  } else if (buffer->IsArrayBuffer()) {
+    auto array_buffer = buffer.As<v8::ArrayBuffer>();
+    data = array_buffer->Data();
+    length = array_buffer->ByteLength();
+  } else {
+    thrower.ThrowError("buffer must be an ArrayBuffer or an ArrayBufferView");
+    return v8::Undefined(thrower.isolate());
+  }
+
+  float scale_factor = 1.0f;
+  SkColorType color_type = kN32_SkColorType;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    std::string pixel_format;
+    if (options.Get("pixelFormat", &pixel_format) &&
+        !GetBitmapColorType(pixel_format, &color_type)) {
+      thrower.ThrowError("Invalid pixelFormat");
+      return v8::Undefined(thrower.isolate());
+    }
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  // Skia swizzles the pixels while copying them, with the vectorized
+  // routines of the CPU.
+  SkImageInfo info = SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                                       color_type, kPremul_SkAlphaType);
+  const size_t size = info.computeMinByteSize();
+  if (length < size) {
+    thrower.ThrowError("buffer is too small for the bitmap");
+    return v8::Undefined(thrower.isolate());
+  }
+  if (size > 0 && !bitmap.readPixels(info, data, info.minRowBytes(), 0, 0))
+    return v8::Number::New(thrower.isolate(), 0);
+  return v8::Number::New(thrower.isolate(), static_cast<double>(size));
+}
+
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
   std::vector<unsigned char> output;
   gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
@@ -274,6 +522,37 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f &&
+      image_.HasRepresentation(gfx::Image::kImageRepPNG)) {
+    // Use the raw 1x PNG bytes, there is nothing to encode.
+    gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+    v8::Local<v8::Promise> handle = promise.GetHandle();
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    ResolveWithBuffer(std::move(promise),
+                      base::make_span(png->front(), png->size()));
+    return handle;
+  }
+
+  return EncodeBitmapAsync(
+      args->isolate(), EncodeFormat::kPNG, 0,
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap());
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  return EncodeBitmapAsync(isolate, EncodeFormat::kJPEG, quality,
+                           image_.AsBitmap());
+}
+
+v8::Local<v8::Promise> NativeImage::ToWebPAsync(v8::Isolate* isolate,
+                                                int quality) {
+  return EncodeBitmapAsync(isolate, EncodeFormat::kWebP, quality,
+                           image_.AsBitmap());
+}
+
 std::string NativeImage::ToDataURL(gin::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -351,36 +630,13 @@ gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
                                              base::Value::Dict options) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
-  gfx::Size size = GetSize(scale_factor);
-  absl::optional<int> new_width = options.FindInt("width");
-  absl::optional<int> new_height = options.FindInt("height");
-  int width = new_width.value_or(size.width());
-  int height = new_height.value_or(size.height());
-  size.SetSize(width, height);
-
-  if (width <= 0 && height <= 0) {
+  absl::optional<gfx::Size> size =
+      GetResizedSize(image_.AsImageSkia(), scale_factor, options);
+  if (!size)
     return CreateEmpty(args->isolate());
-  } else if (new_width && !new_height) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size =
-        gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio(scale_factor));
-  } else if (new_height && !new_width) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(scale_factor), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string* quality = options.FindString("quality");
-  if (quality && *quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality && *quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), GetResizeMethod(options), *size);
   return gin::CreateHandle(
       args->isolate(), new NativeImage(args->isolate(), gfx::Image(resized)));
 }
@@ -401,6 +657,10 @@ void NativeImage::AddRepresentation(const gin_helper::Dictionary& options) {
   options.Get("height", &height);
   options.Get("scaleFactor", &scale_factor);
 
+  // The representations of a shared image would be added to all the
+  // NativeImages sharing it.
+  DetachFromCache();
+
   bool skia_rep_added = false;
   gfx::ImageSkia image_skia = image_.AsImageSkia();
 
@@ -471,6 +731,69 @@ gin::Handle<NativeImage> NativeImage::CreateFromJPEG(v8::Isolate* isolate,
   return Create(isolate, gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::ResizeImages(
+    v8::Isolate* isolate,
+    const std::vector<gfx::Image>& images,
+    base::Value::Dict options) {
+  gin_helper::Promise<std::vector<gfx::Image>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (images.empty()) {
+    promise.Resolve(std::vector<gfx::Image>());
+    return handle;
+  }
+
+  const skia::ImageOperations::ResizeMethod method = GetResizeMethod(options);
+  auto barrier_callback = base::BarrierCallback<std::pair<size_t, BitmapReps>>(
+      images.size(), base::BindOnce(&OnImagesResized, std::move(promise)));
+  for (size_t i = 0; i < images.size(); ++i) {
+    const gfx::ImageSkia image_skia = images[i].AsImageSkia();
+    absl::optional<gfx::Size> size = GetResizedSize(image_skia, 1.0f, options);
+    BitmapReps reps;
+    if (size) {
+      for (const gfx::ImageSkiaRep& rep : image_skia.image_reps())
+        reps.emplace_back(rep.scale(), rep.GetBitmap());
+    }
+    if (reps.empty()) {
+      barrier_callback.Run({i, BitmapReps()});
+      continue;
+    }
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&ResizeBitmapReps, i, std::move(reps), method, *size),
+        barrier_callback);
+  }
+  return handle;
+}
+
+// static
+gin::Handle<NativeImage> NativeImage::CreateFromFiles(
+    v8::Isolate* isolate,
+    base::StringPiece type,
+    const std::vector<electron::util::ImageFile>& files) {
+  auto* cache = DecodedImageCache::Get();
+  if (!cache || files.empty()) {
+    gfx::ImageSkia image_skia;
+    electron::util::AddImageSkiaRepsFromFiles(&image_skia, files);
+    return Create(isolate, gfx::Image(image_skia));
+  }
+
+  std::string key = HashImageFiles(type, files);
+  gfx::ImageSkia image_skia = cache->Acquire(key);
+  if (image_skia.isNull()) {
+    electron::util::AddImageSkiaRepsFromFiles(&image_skia, files);
+    if (image_skia.isNull())
+      return Create(isolate, gfx::Image());
+    cache->Insert(key, image_skia);
+  }
+
+  gin::Handle<NativeImage> handle = Create(isolate, gfx::Image(image_skia));
+  handle->cache_key_ = std::move(key);
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromPath(
     v8::Isolate* isolate,
@@ -481,10 +804,8 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
     return gin::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
-  gfx::Image image(image_skia);
-  gin::Handle<NativeImage> handle = Create(isolate, image);
+  gin::Handle<NativeImage> handle = CreateFromFiles(
+      isolate, "path", electron::util::ReadImageFilesFromPath(image_path));
 #if BUILDFLAG(IS_MAC)
   if (IsTemplateFilename(image_path))
     handle->SetTemplateImage(true);
@@ -568,15 +889,52 @@ gin::Handle<NativeImage> NativeImage::CreateFromBuffer(
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  // The contents are copied as the buffer can be modified while they are
+  // decoded.
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(buffer));
+  std::vector<uint8_t> contents(data, data + node::Buffer::Length(buffer));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DecodeBitmap, std::move(contents), width, height),
+      base::BindOnce(&OnBitmapDecoded, std::move(promise), scale_factor));
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                         const GURL& url) {
   std::string mime_type, charset, data;
-  if (net::DataURL::Parse(url, &mime_type, &charset, &data)) {
-    if (mime_type == "image/png")
-      return CreateFromPNG(isolate, data.c_str(), data.size());
-    else if (mime_type == "image/jpeg")
-      return CreateFromJPEG(isolate, data.c_str(), data.size());
+  if (net::DataURL::Parse(url, &mime_type, &charset, &data) &&
+      (mime_type == "image/png" || mime_type == "image/jpeg")) {
+    std::vector<electron::util::ImageFile> files(1);
+    files[0].contents = std::move(data);
+    return CreateFromFiles(isolate, mime_type, files);
   }
 
   return CreateEmpty(isolate);
@@ -605,7 +963,11 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
                                     constructor->InstanceTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("toWebPAsync", &NativeImage::ToWebPAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
+      .SetMethod("copyBitmapTo", &NativeImage::CopyBitmapTo)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getScaleFactors", &NativeImage::GetScaleFactors)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -648,7 +1010,10 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromPath", &NativeImage::CreateFromPath);
   native_image.SetMethod("createFromBitmap", &NativeImage::CreateFromBitmap);
   native_image.SetMethod("createFromBuffer", &NativeImage::CreateFromBuffer);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
+  native_image.SetMethod("resizeImages", &NativeImage::ResizeImages);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
 #if !BUILDFLAG(IS_LINUX)
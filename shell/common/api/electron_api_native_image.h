@@ -10,10 +10,12 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/skia_util.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/image/image_skia_rep.h"
 
@@ -74,10 +76,19 @@ class NativeImage : public gin::Wrappable<NativeImage> {
       gin_helper::ErrorThrower thrower,
       v8::Local<v8::Value> buffer,
       gin::Arguments* args);
+  // Decodes the image on the thread pool.
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      v8::Local<v8::Value> buffer,
+      gin::Arguments* args);
   static gin::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                     const GURL& url);
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
                                                        std::string name);
+  // Resizes |images| in parallel on the thread pool.
+  static v8::Local<v8::Promise> ResizeImages(
+      v8::Isolate* isolate,
+      const std::vector<gfx::Image>& images,
+      base::Value::Dict options);
 #if !BUILDFLAG(IS_LINUX)
   static v8::Local<v8::Promise> CreateThumbnailFromPath(
       v8::Isolate* isolate,
@@ -108,7 +119,15 @@ class NativeImage : public gin::Wrappable<NativeImage> {
  private:
   v8::Local<v8::Value> ToPNG(gin::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  // Encode the image on the thread pool.
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToWebPAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(gin::Arguments* args);
+  // Copies the pixels into |buffer| instead of a new Buffer.
+  v8::Local<v8::Value> CopyBitmapTo(gin_helper::ErrorThrower thrower,
+                                    v8::Local<v8::Value> buffer,
+                                    gin::Arguments* args);
   std::vector<float> GetScaleFactors();
   v8::Local<v8::Value> GetBitmap(gin::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
@@ -123,6 +142,16 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
   void UpdateExternalAllocatedMemoryUsage();
 
+  // Creates an image decoded from |files|, which is shared with the other
+  // NativeImages created from the same contents.
+  static gin::Handle<NativeImage> CreateFromFiles(
+      v8::Isolate* isolate,
+      base::StringPiece type,
+      const std::vector<electron::util::ImageFile>& files);
+  // Stops sharing the image with the other NativeImages, before it is
+  // modified.
+  void DetachFromCache();
+
   // Mark the image as template image.
   void SetTemplateImage(bool setAsTemplate);
   // Determine if the image is a template image.
@@ -134,6 +163,8 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 #endif
 
   gfx::Image image_;
+  // The key of the image in the DecodedImageCache, if it is shared.
+  std::string cache_key_;
 
   raw_ptr<v8::Isolate> isolate_;
   int32_t memory_usage_ = 0;
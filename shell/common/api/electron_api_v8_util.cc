@@ -7,11 +7,14 @@
 
 #include "base/hash/hash.h"
 #include "base/run_loop.h"
+#include "base/timer/elapsed_timer.h"
+#include "content/public/renderer/v8_value_converter.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_api_key_weak_map.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 #include "url/origin.h"
@@ -120,6 +123,54 @@ void RunUntilIdle() {
   base::RunLoop().RunUntilIdle();
 }
 
+// Converts |value| to a base::Value and back |iterations| times, with the
+// gin converters and with a content::V8ValueConverter created for each call,
+// and returns how long each direction took in milliseconds.
+base::Value::Dict BenchmarkValueConversion(v8::Isolate* isolate,
+                                           v8::Local<v8::Value> value,
+                                           int iterations) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  base::Value::Dict result;
+  base::Value converted;
+  if (!gin::ConvertFromV8(isolate, value, &converted))
+    return result;
+
+  {
+    base::ElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+      v8::HandleScope handle_scope(isolate);
+      base::Value out;
+      gin::ConvertFromV8(isolate, value, &out);
+    }
+    result.Set("fromV8", timer.Elapsed().InMillisecondsF());
+  }
+  {
+    base::ElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+      v8::HandleScope handle_scope(isolate);
+      gin::ConvertToV8(isolate, converted);
+    }
+    result.Set("toV8", timer.Elapsed().InMillisecondsF());
+  }
+  {
+    base::ElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+      v8::HandleScope handle_scope(isolate);
+      content::V8ValueConverter::Create()->FromV8Value(value, context);
+    }
+    result.Set("genericFromV8", timer.Elapsed().InMillisecondsF());
+  }
+  {
+    base::ElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+      v8::HandleScope handle_scope(isolate);
+      content::V8ValueConverter::Create()->ToV8Value(converted, context);
+    }
+    result.Set("genericToV8", timer.Elapsed().InMillisecondsF());
+  }
+  return result;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -134,6 +185,7 @@ void Initialize(v8::Local<v8::Object> exports,
                  &RequestGarbageCollectionForTesting);
   dict.SetMethod("triggerFatalErrorForTesting", &TriggerFatalErrorForTesting);
   dict.SetMethod("runUntilIdle", &RunUntilIdle);
+  dict.SetMethod("benchmarkValueConversion", &BenchmarkValueConversion);
 }
 
 }  // namespace
@@ -4,6 +4,8 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -13,11 +15,16 @@
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/numerics/checked_math.h"
 #include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/values.h"
 #include "electron/fuses.h"
+#include "shell/common/asar/archive_index.h"
+#include "shell/common/asar/archive_readahead.h"
+#include "shell/common/asar/asar_compression.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/extraction_cache.h"
 #include "shell/common/asar/scoped_temporary_file.h"
 #include "shell/common/thread_restrictions.h"
 
@@ -35,6 +42,13 @@ const char kSeparators[] = "\\/";
 const char kSeparators[] = "/";
 #endif
 
+// Prefix of the region handed out by Archive::GetSharedIndex, followed by the
+// indexed header itself.
+struct SharedIndexHeader {
+  uint32_t header_size;
+  uint32_t header_validated;
+};
+
 const base::Value::Dict* GetNodeFromPath(std::string path,
                                          const base::Value::Dict& root);
 
@@ -115,6 +129,12 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
     info->executable = *executable;
   }
 
+  if (const base::Value::Dict* compression = node->FindDict("compression")) {
+    info->compression = CompressionFromValue(*compression);
+    if (!info->compression.has_value())
+      return false;
+  }
+
 #if BUILDFLAG(IS_MAC)
   if (load_integrity &&
       electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
@@ -151,7 +171,55 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
   }
 #endif
 
-  return true;
+  return !info->compression.has_value() ||
+         IsCompressionValid(info->compression.value(), info->size,
+                            info->integrity);
+}
+
+// Converts |path| to the '/'-separated form used by the indexed header.
+std::string ToIndexPath(const base::FilePath& path) {
+  std::string index_path = path.AsUTF8Unsafe();
+#if BUILDFLAG(IS_WIN)
+  std::replace(index_path.begin(), index_path.end(), '\\', '/');
+#endif
+  return index_path;
+}
+
+bool FillFileInfoWithIndexEntry(Archive::FileInfo* info,
+                                uint32_t header_size,
+                                bool load_integrity,
+                                const ArchiveIndex& index,
+                                const ArchiveIndex::Entry& entry) {
+  if (entry.is_directory() || entry.is_link())
+    return false;
+
+  info->size = entry.size;
+  info->unpacked = entry.is_unpacked();
+  if (info->unpacked)
+    return true;
+
+  info->offset = entry.offset + header_size;
+  info->executable = entry.is_executable();
+  if (entry.is_compressed()) {
+    info->compression = index.GetCompression(entry);
+    if (!info->compression.has_value())
+      return false;
+  }
+
+#if BUILDFLAG(IS_MAC)
+  if (load_integrity &&
+      electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
+    info->integrity = index.GetIntegrity(entry);
+    if (!info->integrity.has_value()) {
+      LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
+      return false;
+    }
+  }
+#endif
+
+  return !info->compression.has_value() ||
+         IsCompressionValid(info->compression.value(), info->size,
+                            info->integrity);
 }
 
 }  // namespace
@@ -161,6 +229,12 @@ IntegrityPayload::IntegrityPayload()
 IntegrityPayload::~IntegrityPayload() = default;
 IntegrityPayload::IntegrityPayload(const IntegrityPayload& other) = default;
 
+CompressionPayload::CompressionPayload()
+    : algorithm(CompressionAlgorithm::kBrotli), block_size(0), packed_size(0) {}
+CompressionPayload::~CompressionPayload() = default;
+CompressionPayload::CompressionPayload(const CompressionPayload& other) =
+    default;
+
 Archive::FileInfo::FileInfo()
     : unpacked(false), executable(false), size(0), offset(0) {}
 Archive::FileInfo::~FileInfo() = default;
@@ -264,6 +338,30 @@ bool Archive::Init() {
   }
 #endif
 
+  MapFile();
+
+  if (ArchiveIndex::IsIndexedHeader(base::as_bytes(base::make_span(header)))) {
+    // The header string follows the size pickle and the header pickle's own
+    // payload size and string length fields, use it in place when mapped.
+    constexpr size_t kIndexOffset = 16;
+    base::span<const uint8_t> index_data;
+    if (mapped_file_ &&
+        mapped_file_->length() >= kIndexOffset + header.size()) {
+      index_data =
+          base::make_span(mapped_file_->data() + kIndexOffset, header.size());
+    } else {
+      index_storage_ = std::move(header);
+      index_data = base::as_bytes(base::make_span(index_storage_));
+    }
+    index_ = ArchiveIndex::Create(index_data);
+    if (!index_) {
+      LOG(ERROR) << "Failed to parse indexed header from " << path_.value();
+      return false;
+    }
+    header_size_ = 8 + size;
+    return true;
+  }
+
   absl::optional<base::Value> value = base::JSONReader::Read(header);
   if (!value || !value->is_dict()) {
     LOG(ERROR) << "Failed to parse header";
@@ -275,6 +373,76 @@ bool Archive::Init() {
   return true;
 }
 
+bool Archive::InitFromSharedIndex(base::ReadOnlySharedMemoryRegion region) {
+  // Should only be initialized once
+  CHECK(!initialized_);
+  initialized_ = true;
+
+  if (!file_.IsValid())
+    return false;
+
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid() || mapping.size() < sizeof(SharedIndexHeader))
+    return false;
+
+  SharedIndexHeader shared_header;
+  memcpy(&shared_header, mapping.memory(), sizeof(shared_header));
+  index_ = ArchiveIndex::Create(
+      mapping.GetMemoryAsSpan<uint8_t>().subspan(sizeof(shared_header)));
+  if (!index_) {
+    LOG(ERROR) << "Failed to attach to shared header of " << path_.value();
+    return false;
+  }
+
+  header_size_ = shared_header.header_size;
+  header_validated_ = shared_header.header_validated;
+  shared_index_mapping_ = std::move(mapping);
+  MapFile();
+  return true;
+}
+
+void Archive::MapFile() {
+  // Map the archive so that packed files can be served without a read
+  // syscall and copy per access. Failing to map (e.g. running out of address
+  // space on 32-bit builds) is not fatal, callers fall back to reading |fd_|.
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  if (mapped_file->Initialize(file_.Duplicate()))
+    mapped_file_ = std::move(mapped_file);
+}
+
+base::ReadOnlySharedMemoryRegion Archive::GetSharedIndex() {
+  base::AutoLock auto_lock(shared_index_lock_);
+
+  if (!shared_index_.IsValid()) {
+    std::vector<uint8_t> serialized;
+    base::span<const uint8_t> index_data;
+    if (index_) {
+      index_data = index_->data();
+    } else if (header_) {
+      serialized = ArchiveIndex::Serialize(*header_);
+      index_data = serialized;
+    }
+    if (index_data.empty())
+      return base::ReadOnlySharedMemoryRegion();
+
+    base::MappedReadOnlyRegion mapped =
+        base::ReadOnlySharedMemoryRegion::Create(sizeof(SharedIndexHeader) +
+                                                 index_data.size());
+    if (!mapped.IsValid())
+      return base::ReadOnlySharedMemoryRegion();
+
+    SharedIndexHeader shared_header = {header_size_, header_validated_};
+    auto* memory = mapped.mapping.GetMemoryAs<uint8_t>();
+    memcpy(memory, &shared_header, sizeof(shared_header));
+    memcpy(memory + sizeof(shared_header), index_data.data(),
+           index_data.size());
+    shared_index_ = std::move(mapped.region);
+  }
+
+  return shared_index_.Duplicate();
+}
+
 #if !BUILDFLAG(IS_MAC)
 absl::optional<IntegrityPayload> Archive::HeaderIntegrity() const {
   return absl::nullopt;
@@ -286,6 +454,18 @@ absl::optional<base::FilePath> Archive::RelativePath() const {
 #endif
 
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (entry->is_link()) {
+      return GetFileInfo(
+          base::FilePath::FromUTF8Unsafe(index_->GetLinkTarget(*entry)), info);
+    }
+    return FillFileInfoWithIndexEntry(info, header_size_, header_validated_,
+                                      *index_, *entry);
+  }
+
   if (!header_)
     return false;
 
@@ -302,6 +482,24 @@ bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    if (entry->is_link()) {
+      stats->is_file = false;
+      stats->is_link = true;
+      return true;
+    }
+    if (entry->is_directory()) {
+      stats->is_file = false;
+      stats->is_directory = true;
+      return true;
+    }
+    return FillFileInfoWithIndexEntry(stats, header_size_, header_validated_,
+                                      *index_, *entry);
+  }
+
   if (!header_)
     return false;
 
@@ -327,6 +525,16 @@ bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* files) const {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    std::vector<base::StringPiece> names;
+    if (!entry || !index_->GetChildNames(*entry, &names))
+      return false;
+    for (base::StringPiece name : names)
+      files->push_back(base::FilePath::FromUTF8Unsafe(name));
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -346,6 +554,16 @@ bool Archive::Readdir(const base::FilePath& path,
 
 bool Archive::Realpath(const base::FilePath& path,
                        base::FilePath* realpath) const {
+  if (index_) {
+    const ArchiveIndex::Entry* entry = index_->Find(ToIndexPath(path));
+    if (!entry)
+      return false;
+    *realpath = entry->is_link() ? base::FilePath::FromUTF8Unsafe(
+                                       index_->GetLinkTarget(*entry))
+                                 : path;
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -365,15 +583,16 @@ bool Archive::Realpath(const base::FilePath& path,
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
-  if (!header_)
+  if (!header_ && !index_)
     return false;
 
-  base::AutoLock auto_lock(external_files_lock_);
-
-  auto it = external_files_.find(path.value());
-  if (it != external_files_.end()) {
-    *out = it->second->path();
-    return true;
+  {
+    base::AutoLock auto_lock(external_files_lock_);
+    auto it = external_files_.find(path.value());
+    if (it != external_files_.end()) {
+      *out = it->second;
+      return true;
+    }
   }
 
   FileInfo info;
@@ -385,26 +604,104 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return true;
   }
 
-  auto temp_file = std::make_unique<ScopedTemporaryFile>();
+  // The lock isn't held while extracting so that different files can be
+  // copied out in parallel. Should two threads race on the same file, the
+  // first copy wins and the other one is discarded.
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
-                               info.integrity))
-    return false;
+  base::FilePath extracted_path;
+  std::unique_ptr<ScopedTemporaryFile> temp_file;
+  if (info.compression) {
+    // Compressed files are extracted decompressed, from memory.
+    std::string contents;
+    if (!CompressedFileReader(this, info).ReadAll(&contents))
+      return false;
+    if (!ExtractToCache(nullptr, base::as_bytes(base::make_span(contents)),
+                        info, ext, &extracted_path)) {
+      temp_file = std::make_unique<ScopedTemporaryFile>();
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      if (!temp_file->Init(ext) ||
+          !base::WriteFile(temp_file->path(), contents)) {
+        return false;
+      }
+    }
+  } else if (!ExtractToCache(&file_, GetFileContents(info), info, ext,
+                             &extracted_path)) {
+    temp_file = std::make_unique<ScopedTemporaryFile>();
+    if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
+                                 info.integrity))
+      return false;
+  }
 
+  if (temp_file) {
 #if BUILDFLAG(IS_POSIX)
-  if (info.executable) {
-    // chmod a+x temp_file;
-    base::SetPosixFilePermissions(temp_file->path(), 0755);
-  }
+    if (info.executable) {
+      // chmod a+x temp_file;
+      base::SetPosixFilePermissions(temp_file->path(), 0755);
+    }
 #endif
+    extracted_path = temp_file->path();
+  }
 
-  *out = temp_file->path();
-  external_files_[path.value()] = std::move(temp_file);
+  base::AutoLock auto_lock(external_files_lock_);
+  auto [it, inserted] =
+      external_files_.try_emplace(path.value(), extracted_path);
+  if (inserted && temp_file)
+    temp_files_.push_back(std::move(temp_file));
+  *out = it->second;
   return true;
 }
 
+void Archive::StartReadahead() {
+  DCHECK(!readahead_);
+  readahead_ = ArchiveReadahead::Start(path_);
+}
+
 int Archive::GetUnsafeFD() const {
   return fd_;
 }
 
+bool Archive::IsBlockVerified(uint64_t file_offset, uint32_t block) const {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  return verified_blocks_.count({file_offset, block}) != 0;
+}
+
+void Archive::MarkBlockVerified(uint64_t file_offset, uint32_t block) {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  verified_blocks_.emplace(file_offset, block);
+}
+
+void Archive::RevalidateVerifiedBlocks() {
+  base::File::Info info;
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!file_.GetInfo(&info))
+      info = base::File::Info();
+  }
+
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  if (info.size != verified_file_info_.size ||
+      info.last_modified != verified_file_info_.last_modified) {
+    verified_blocks_.clear();
+    verified_file_info_ = info;
+  }
+}
+
+absl::optional<base::span<const uint8_t>> Archive::GetFileContents(
+    const FileInfo& info) const {
+  if (!mapped_file_ || info.unpacked)
+    return absl::nullopt;
+
+  const uint32_t size =
+      info.compression ? info.compression->packed_size : info.size;
+  base::CheckedNumeric<uint64_t> end = info.offset;
+  end += size;
+  if (!end.IsValid() || end.ValueOrDie() > mapped_file_->length())
+    return absl::nullopt;
+
+  if (readahead_)
+    readahead_->RecordRead(info.offset, size);
+
+  return base::make_span(mapped_file_->data() + info.offset, size);
+}
+
 }  // namespace asar
@@ -6,18 +6,26 @@
 #define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace asar {
 
+class ArchiveIndex;
+class ArchiveReadahead;
 class ScopedTemporaryFile;
 
 enum class HashAlgorithm {
@@ -35,6 +43,26 @@ struct IntegrityPayload {
   std::vector<std::string> blocks;
 };
 
+enum class CompressionAlgorithm {
+  kBrotli,
+};
+
+// The contents of a compressed file are a sequence of independent frames,
+// each holding |block_size| bytes of the file but the last one, so that any
+// block can be decompressed on its own. When the file has integrity its
+// blocks are the same and are hashed uncompressed.
+struct CompressionPayload {
+  CompressionPayload();
+  ~CompressionPayload();
+  CompressionPayload(const CompressionPayload& other);
+  CompressionAlgorithm algorithm;
+  uint32_t block_size;
+  // The compressed size of each frame.
+  std::vector<uint32_t> blocks;
+  // The sum of |blocks|, i.e. the size of the file in the archive.
+  uint32_t packed_size;
+};
+
 // This class represents an asar package, and provides methods to read
 // information from it. It is thread-safe after |Init| has been called.
 class Archive {
@@ -44,9 +72,11 @@ class Archive {
     ~FileInfo();
     bool unpacked;
     bool executable;
+    // The size of the file, compressed or not.
     uint32_t size;
     uint64_t offset;
     absl::optional<IntegrityPayload> integrity;
+    absl::optional<CompressionPayload> compression;
   };
 
   struct Stats : public FileInfo {
@@ -66,6 +96,15 @@ class Archive {
   // Read and parse the header.
   bool Init();
 
+  // Alternative to |Init| for child processes, attaches to a header that was
+  // already parsed by the browser process and shared by |GetSharedIndex|.
+  bool InitFromSharedIndex(base::ReadOnlySharedMemoryRegion region);
+
+  // Returns a read-only region holding the header in the indexed format,
+  // converting a JSON header on first use. Returns an invalid region if the
+  // header can't be shared.
+  base::ReadOnlySharedMemoryRegion GetSharedIndex();
+
   absl::optional<IntegrityPayload> HeaderIntegrity() const;
   absl::optional<base::FilePath> RelativePath() const;
 
@@ -82,8 +121,10 @@ class Archive {
   // Fs.realpath(path).
   bool Realpath(const base::FilePath& path, base::FilePath* realpath) const;
 
-  // Copy the file into a temporary file, and return the new path.
-  // For unpacked file, this method will return its real path.
+  // Copy the file out of the archive, and return the new path. Files with
+  // integrity are copied into a cache that persists across launches, others
+  // into a temporary file. For unpacked file, this method will return its
+  // real path.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
   // Returns the file's fd.
@@ -92,22 +133,66 @@ class Archive {
   // for integrity validation after this fd is handed over.
   int GetUnsafeFD() const;
 
+  // Returns a read-only view of a packed file's contents in the memory-mapped
+  // archive, or absl::nullopt when |info| points at an unpacked file or the
+  // archive could not be mapped. The span stays valid for the lifetime of
+  // this Archive. As with GetUnsafeFD, callers are responsible for integrity
+  // validation of the returned bytes. The contents of compressed files are
+  // their frames, see asar_compression.h.
+  absl::optional<base::span<const uint8_t>> GetFileContents(
+      const FileInfo& info) const;
+
+  // Bookkeeping of integrity blocks that were already validated, so that
+  // repeated reads of a file don't hash it again. Blocks are keyed by the
+  // offset of their file in the archive.
+  bool IsBlockVerified(uint64_t file_offset, uint32_t block) const;
+  void MarkBlockVerified(uint64_t file_offset, uint32_t block);
+  // Forgets about all validated blocks if the archive changed on disk.
+  void RevalidateVerifiedBlocks();
+
+  // Reads ahead the parts of the archive that were read at startup last
+  // time, or records them for the next launch. Only one process should do
+  // this for a given archive.
+  void StartReadahead();
+
   base::FilePath path() const { return path_; }
 
  private:
+  void MapFile();
+
   bool initialized_;
   bool header_validated_ = false;
   const base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
+  // Exactly one of |header_| and |index_| is set after a successful |Init|,
+  // depending on whether the archive has a JSON or an indexed header.
   absl::optional<base::Value::Dict> header_;
+  std::unique_ptr<ArchiveIndex> index_;
+  // Backing store for |index_| when the archive could not be mapped, or the
+  // header was attached to with |InitFromSharedIndex|.
+  std::string index_storage_;
+  base::ReadOnlySharedMemoryMapping shared_index_mapping_;
+
+  base::Lock shared_index_lock_;
+  base::ReadOnlySharedMemoryRegion shared_index_;
+
+  mutable base::Lock verified_blocks_lock_;
+  std::set<std::pair<uint64_t, uint32_t>> verified_blocks_;
+  base::File::Info verified_file_info_;
+
+  scoped_refptr<ArchiveReadahead> readahead_;
+
+  // Read-only mapping of the whole archive, null if mapping failed.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
 
-  // Cached external temporary files.
+  // Paths of files that were copied out, and the temporary files owning
+  // those that didn't go to the extraction cache.
   base::Lock external_files_lock_;
-  std::unordered_map<base::FilePath::StringType,
-                     std::unique_ptr<ScopedTemporaryFile>>
+  std::unordered_map<base::FilePath::StringType, base::FilePath>
       external_files_;
+  std::vector<std::unique_ptr<ScopedTemporaryFile>> temp_files_;
 };
 
 }  // namespace asar
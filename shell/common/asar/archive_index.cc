@@ -0,0 +1,397 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "base/memory/ptr_util.h"
+#include "base/memory/raw_ptr.h"
+#include "base/numerics/checked_math.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/strcat.h"
+#include "build/build_config.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_compression.h"
+
+namespace asar {
+
+namespace {
+
+static_assert(sizeof(ArchiveIndex::Header) == 32,
+              "The indexed asar header has a fixed size");
+static_assert(sizeof(ArchiveIndex::Entry) == 40,
+              "Indexed asar entries have a fixed size");
+#if !defined(ARCH_CPU_LITTLE_ENDIAN)
+#error "The indexed asar header is read in place and is little-endian"
+#endif
+
+// Upper bound on the number of links followed while resolving one path,
+// this also protects against link cycles.
+constexpr int kMaxLinkDepth = 40;
+
+// Checks that [offset, offset + count * element_size) fits in |limit|.
+bool IsRangeValid(uint64_t offset,
+                  uint64_t count,
+                  uint64_t element_size,
+                  uint64_t limit) {
+  base::CheckedNumeric<uint64_t> end = count;
+  end *= element_size;
+  end += offset;
+  return end.IsValid() && end.ValueOrDie() <= limit;
+}
+
+}  // namespace
+
+// static
+bool ArchiveIndex::IsIndexedHeader(base::span<const uint8_t> data) {
+  return data.size() >= sizeof(kMagic) &&
+         memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Create(
+    base::span<const uint8_t> data) {
+  if (!IsIndexedHeader(data) || data.size() < sizeof(Header))
+    return nullptr;
+  // The tables are read in place.
+  if (reinterpret_cast<uintptr_t>(data.data()) % alignof(Entry) != 0)
+    return nullptr;
+
+  Header header;
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.version == 0 || header.version > kVersion)
+    return nullptr;
+
+  if (header.entry_count == 0 ||
+      !IsRangeValid(sizeof(Header), header.entry_count, sizeof(Entry),
+                    header.children_offset) ||
+      header.children_offset % alignof(uint32_t) != 0 ||
+      !IsRangeValid(header.children_offset, header.children_count,
+                    sizeof(uint32_t), header.strings_offset) ||
+      !IsRangeValid(header.strings_offset, header.strings_size, 1,
+                    data.size())) {
+    return nullptr;
+  }
+
+  auto entries = base::make_span(
+      reinterpret_cast<const Entry*>(data.data() + sizeof(Header)),
+      header.entry_count);
+  auto children = base::make_span(
+      reinterpret_cast<const uint32_t*>(data.data() + header.children_offset),
+      header.children_count);
+  base::StringPiece strings(
+      reinterpret_cast<const char*>(data.data() + header.strings_offset),
+      header.strings_size);
+
+  // Validate everything upfront so that lookups don't need bounds checks.
+  const uint64_t strings_size = strings.size();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const Entry& entry = entries[i];
+    if (!IsRangeValid(entry.path_offset, entry.path_length, 1, strings_size) ||
+        !IsRangeValid(entry.integrity_offset, entry.integrity_length, 1,
+                      strings_size)) {
+      return nullptr;
+    }
+    if (entry.is_directory() &&
+        !IsRangeValid(entry.extra_offset, entry.extra_length, 1,
+                      children.size())) {
+      return nullptr;
+    }
+    if ((entry.is_link() || entry.is_compressed()) &&
+        !IsRangeValid(entry.extra_offset, entry.extra_length, 1,
+                      strings_size)) {
+      return nullptr;
+    }
+    // Binary search relies on a strict ordering.
+    if (i > 0 && strings.substr(entries[i - 1].path_offset,
+                                entries[i - 1].path_length) >=
+                     strings.substr(entry.path_offset, entry.path_length)) {
+      return nullptr;
+    }
+  }
+  if (entries[0].path_length != 0 || !entries[0].is_directory())
+    return nullptr;
+  for (uint32_t child : children) {
+    if (child >= entries.size())
+      return nullptr;
+  }
+
+  return base::WrapUnique(new ArchiveIndex(data, entries, children, strings));
+}
+
+// static
+std::vector<uint8_t> ArchiveIndex::Serialize(const base::Value::Dict& header) {
+  struct Node {
+    std::string path;
+    raw_ptr<const base::Value::Dict> dict;
+  };
+
+  // Flatten the tree of nested "files" dictionaries.
+  std::vector<Node> nodes;
+  std::vector<Node> pending = {{std::string(), &header}};
+  while (!pending.empty()) {
+    Node node = std::move(pending.back());
+    pending.pop_back();
+    const base::Value::Dict* files = node.dict->FindString("link")
+                                         ? nullptr
+                                         : node.dict->FindDict("files");
+    if (files) {
+      for (const auto [name, value] : *files) {
+        const base::Value::Dict* child = value.GetIfDict();
+        if (!child || name.empty() || name.find('/') != std::string::npos)
+          return {};
+        pending.push_back(
+            {node.path.empty() ? name : node.path + '/' + name, child});
+      }
+    }
+    nodes.push_back(std::move(node));
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) {
+    return a.path < b.path;
+  });
+
+  std::string strings;
+  std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> interned;
+  auto intern = [&](base::StringPiece str) {
+    auto it = interned.find(str);
+    if (it == interned.end()) {
+      it = interned
+               .emplace(std::string(str),
+                        std::make_pair(static_cast<uint32_t>(strings.size()),
+                                       static_cast<uint32_t>(str.size())))
+               .first;
+      strings.append(str.data(), str.size());
+    }
+    return it->second;
+  };
+
+  // Children of each directory, in sorted order since |nodes| is sorted.
+  std::vector<std::vector<uint32_t>> children_of(nodes.size());
+  for (size_t i = 1; i < nodes.size(); ++i) {
+    size_t separator = nodes[i].path.rfind('/');
+    std::string parent = separator == std::string::npos
+                             ? std::string()
+                             : nodes[i].path.substr(0, separator);
+    auto it = std::lower_bound(nodes.begin(), nodes.begin() + i, parent,
+                               [](const Node& node, const std::string& key) {
+                                 return node.path < key;
+                               });
+    children_of[it - nodes.begin()].push_back(static_cast<uint32_t>(i));
+  }
+
+  std::vector<Entry> entries(nodes.size());
+  std::vector<uint32_t> children;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const base::Value::Dict& dict = *nodes[i].dict;
+    Entry& entry = entries[i];
+    std::tie(entry.path_offset, entry.path_length) = intern(nodes[i].path);
+
+    if (const std::string* link = dict.FindString("link")) {
+      entry.flags = kLink;
+      std::tie(entry.extra_offset, entry.extra_length) = intern(*link);
+      continue;
+    }
+
+    if (dict.FindDict("files")) {
+      entry.flags = kDirectory;
+      entry.extra_offset = static_cast<uint32_t>(children.size());
+      entry.extra_length = static_cast<uint32_t>(children_of[i].size());
+      children.insert(children.end(), children_of[i].begin(),
+                      children_of[i].end());
+      continue;
+    }
+
+    absl::optional<int> size = dict.FindInt("size");
+    if (!size || *size < 0)
+      return {};
+    entry.size = static_cast<uint32_t>(*size);
+    if (dict.FindBool("executable").value_or(false))
+      entry.flags |= kExecutable;
+    if (dict.FindBool("unpacked").value_or(false)) {
+      entry.flags |= kUnpacked;
+    } else {
+      const std::string* offset = dict.FindString("offset");
+      if (!offset || !base::StringToUint64(*offset, &entry.offset))
+        return {};
+    }
+
+    if (const base::Value::Dict* integrity = dict.FindDict("integrity")) {
+      const std::string* algorithm = integrity->FindString("algorithm");
+      const std::string* hash = integrity->FindString("hash");
+      absl::optional<int> block_size = integrity->FindInt("blockSize");
+      const base::Value::List* blocks = integrity->FindList("blocks");
+      if (!algorithm || !hash || !block_size || !blocks)
+        return {};
+      std::string record = base::StrCat(
+          {*algorithm, ",", base::NumberToString(*block_size), ",", *hash});
+      for (const base::Value& block : *blocks) {
+        if (!block.is_string())
+          return {};
+        base::StrAppend(&record, {",", block.GetString()});
+      }
+      std::tie(entry.integrity_offset, entry.integrity_length) =
+          intern(record);
+    }
+
+    if (const base::Value::Dict* compression = dict.FindDict("compression")) {
+      absl::optional<CompressionPayload> payload =
+          CompressionFromValue(*compression);
+      if (!payload)
+        return {};
+      entry.flags |= kCompressed;
+      std::tie(entry.extra_offset, entry.extra_length) =
+          intern(CompressionToRecord(*payload));
+    }
+  }
+
+  Header index_header = {};
+  memcpy(index_header.magic, kMagic, sizeof(kMagic));
+  index_header.version = kVersion;
+  base::CheckedNumeric<uint32_t> children_offset = entries.size();
+  children_offset *= sizeof(Entry);
+  children_offset += sizeof(Header);
+  base::CheckedNumeric<uint32_t> strings_offset = children.size();
+  strings_offset *= sizeof(uint32_t);
+  strings_offset += children_offset;
+  base::CheckedNumeric<uint32_t> total_size = strings_offset + strings.size();
+  if (!total_size.IsValid())
+    return {};
+  index_header.entry_count = static_cast<uint32_t>(entries.size());
+  index_header.children_offset = children_offset.ValueOrDie();
+  index_header.children_count = static_cast<uint32_t>(children.size());
+  index_header.strings_offset = strings_offset.ValueOrDie();
+  index_header.strings_size = static_cast<uint32_t>(strings.size());
+
+  std::vector<uint8_t> data(total_size.ValueOrDie());
+  memcpy(data.data(), &index_header, sizeof(index_header));
+  memcpy(data.data() + sizeof(Header), entries.data(),
+         entries.size() * sizeof(Entry));
+  memcpy(data.data() + index_header.children_offset, children.data(),
+         children.size() * sizeof(uint32_t));
+  memcpy(data.data() + index_header.strings_offset, strings.data(),
+         strings.size());
+  return data;
+}
+
+ArchiveIndex::ArchiveIndex(base::span<const uint8_t> data,
+                           base::span<const Entry> entries,
+                           base::span<const uint32_t> children,
+                           base::StringPiece strings)
+    : data_(data), entries_(entries), children_(children), strings_(strings) {}
+
+ArchiveIndex::~ArchiveIndex() = default;
+
+const ArchiveIndex::Entry* ArchiveIndex::Find(base::StringPiece path) const {
+  std::string resolved(path);
+  for (int depth = 0; depth < kMaxLinkDepth; ++depth) {
+    if (const Entry* entry = FindExact(resolved))
+      return entry;
+
+    // Walk the parent directories looking for a link to substitute.
+    bool substituted = false;
+    for (size_t pos = resolved.find('/'); pos != std::string::npos;
+         pos = resolved.find('/', pos + 1)) {
+      const Entry* parent =
+          FindExact(base::StringPiece(resolved).substr(0, pos));
+      if (!parent)
+        return nullptr;
+      if (parent->is_link()) {
+        resolved = std::string(GetLinkTarget(*parent)) + resolved.substr(pos);
+        substituted = true;
+        break;
+      }
+    }
+    if (!substituted)
+      return nullptr;
+  }
+  return nullptr;
+}
+
+const ArchiveIndex::Entry* ArchiveIndex::FindExact(
+    base::StringPiece path) const {
+  auto it = std::lower_bound(entries_.begin(), entries_.end(), path,
+                             [this](const Entry& entry, base::StringPiece key) {
+                               return GetPath(entry) < key;
+                             });
+  if (it == entries_.end() || GetPath(*it) != path)
+    return nullptr;
+  return &*it;
+}
+
+base::StringPiece ArchiveIndex::GetPath(const Entry& entry) const {
+  return GetString(entry.path_offset, entry.path_length);
+}
+
+base::StringPiece ArchiveIndex::GetLinkTarget(const Entry& entry) const {
+  if (!entry.is_link())
+    return base::StringPiece();
+  return GetString(entry.extra_offset, entry.extra_length);
+}
+
+bool ArchiveIndex::GetChildNames(const Entry& dir,
+                                 std::vector<base::StringPiece>* names) const {
+  const Entry* node = &dir;
+  for (int depth = 0; node && node->is_link(); ++depth) {
+    if (depth == kMaxLinkDepth)
+      return false;
+    node = Find(GetLinkTarget(*node));
+  }
+  if (!node || !node->is_directory())
+    return false;
+
+  for (uint32_t child : children_.subspan(node->extra_offset,
+                                          node->extra_length)) {
+    base::StringPiece child_path = GetPath(entries_[child]);
+    size_t separator = child_path.rfind('/');
+    names->push_back(separator == base::StringPiece::npos
+                         ? child_path
+                         : child_path.substr(separator + 1));
+  }
+  return true;
+}
+
+absl::optional<IntegrityPayload> ArchiveIndex::GetIntegrity(
+    const Entry& entry) const {
+  if (entry.integrity_length == 0)
+    return absl::nullopt;
+
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      GetString(entry.integrity_offset, entry.integrity_length), ",",
+      base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  unsigned block_size = 0;
+  if (fields.size() < 3 || fields[0] != "SHA256" ||
+      !base::StringToUint(fields[1], &block_size) || block_size == 0) {
+    return absl::nullopt;
+  }
+
+  IntegrityPayload integrity;
+  integrity.algorithm = HashAlgorithm::kSHA256;
+  integrity.block_size = block_size;
+  integrity.hash = std::string(fields[2]);
+  for (size_t i = 3; i < fields.size(); ++i)
+    integrity.blocks.emplace_back(fields[i]);
+  return integrity;
+}
+
+absl::optional<CompressionPayload> ArchiveIndex::GetCompression(
+    const Entry& entry) const {
+  if (!entry.is_compressed() || entry.is_directory() || entry.is_link())
+    return absl::nullopt;
+  return CompressionFromRecord(
+      GetString(entry.extra_offset, entry.extra_length));
+}
+
+base::StringPiece ArchiveIndex::GetString(uint32_t offset,
+                                          uint32_t length) const {
+  return strings_.substr(offset, length);
+}
+
+}  // namespace asar
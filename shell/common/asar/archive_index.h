@@ -0,0 +1,136 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace asar {
+
+struct CompressionPayload;
+struct IntegrityPayload;
+
+// A read-only view over the binary "indexed" asar header. Unlike the JSON
+// header it does not need to be parsed: every lookup is a binary search over
+// a flat table of entries sorted by their full path, so the index can be used
+// in place straight out of a memory-mapped archive.
+//
+// Layout, all fields little-endian:
+//
+//   Header    fixed size, starts with |kMagic| and a version field.
+//   Entry[]   |entry_count| entries, sorted bytewise by full path. The root
+//             directory has the empty path and is always the first entry.
+//   uint32[]  |children_count| entry indices, each directory owns the
+//             contiguous range [first_child, first_child + child_count).
+//   char[]    interned string table holding paths, link targets, integrity
+//             and compression records.
+//
+// Integrity records are stored as "algorithm,blockSize,hash,block,block...",
+// compression records as "algorithm,blockSize,frame,frame...". Version 2
+// added compressed files, version 1 indexes are still read.
+class ArchiveIndex {
+ public:
+  static constexpr char kMagic[8] = {'A', 'S', 'A', 'R', 'I', 'D', 'X', '\0'};
+  static constexpr uint32_t kVersion = 2;
+
+  enum Flags : uint32_t {
+    kDirectory = 1 << 0,
+    kLink = 1 << 1,
+    kUnpacked = 1 << 2,
+    kExecutable = 1 << 3,
+    kCompressed = 1 << 4,
+  };
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t children_offset;
+    uint32_t children_count;
+    uint32_t strings_offset;
+    uint32_t strings_size;
+  };
+
+  struct Entry {
+    uint32_t path_offset;
+    uint32_t path_length;
+    uint32_t flags;
+    uint32_t size;
+    uint64_t offset;
+    // Link target string for links, children range for directories,
+    // compression record for compressed files.
+    uint32_t extra_offset;
+    uint32_t extra_length;
+    uint32_t integrity_offset;
+    uint32_t integrity_length;
+
+    bool is_directory() const { return flags & kDirectory; }
+    bool is_link() const { return flags & kLink; }
+    bool is_unpacked() const { return flags & kUnpacked; }
+    bool is_executable() const { return flags & kExecutable; }
+    bool is_compressed() const { return flags & kCompressed; }
+  };
+
+  // Whether |data| starts with the indexed header magic. The JSON header
+  // always starts with '{' so the two formats can't be confused.
+  static bool IsIndexedHeader(base::span<const uint8_t> data);
+
+  // Validates |data| and returns an index over it, or nullptr if it is
+  // malformed or of an unsupported version. |data| must outlive the index.
+  static std::unique_ptr<ArchiveIndex> Create(base::span<const uint8_t> data);
+
+  // Converts a parsed JSON header into the indexed format. Returns an empty
+  // vector if |header| can't be represented, e.g. because it is malformed.
+  static std::vector<uint8_t> Serialize(const base::Value::Dict& header);
+
+  ~ArchiveIndex();
+
+  // disable copy
+  ArchiveIndex(const ArchiveIndex&) = delete;
+  ArchiveIndex& operator=(const ArchiveIndex&) = delete;
+
+  // Finds the entry of '/'-separated |path|, resolving links in its parent
+  // directories. Returns nullptr if there is no such entry.
+  const Entry* Find(base::StringPiece path) const;
+
+  base::StringPiece GetPath(const Entry& entry) const;
+  base::StringPiece GetLinkTarget(const Entry& entry) const;
+
+  // Returns the names of the entries directly inside |dir|, following a
+  // link to a directory. Returns false if |dir| is not a directory.
+  bool GetChildNames(const Entry& dir,
+                     std::vector<base::StringPiece>* names) const;
+
+  absl::optional<IntegrityPayload> GetIntegrity(const Entry& entry) const;
+  absl::optional<CompressionPayload> GetCompression(const Entry& entry) const;
+
+  // The bytes this index was created from.
+  base::span<const uint8_t> data() const { return data_; }
+
+ private:
+  ArchiveIndex(base::span<const uint8_t> data,
+               base::span<const Entry> entries,
+               base::span<const uint32_t> children,
+               base::StringPiece strings);
+
+  const Entry* FindExact(base::StringPiece path) const;
+  base::StringPiece GetString(uint32_t offset, uint32_t length) const;
+
+  const base::span<const uint8_t> data_;
+  const base::span<const Entry> entries_;
+  const base::span<const uint32_t> children_;
+  const base::StringPiece strings_;
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
@@ -0,0 +1,223 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_readahead.h"
+
+#include <algorithm>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/bind.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/path_service.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "crypto/sha2.h"
+#include "shell/common/electron_paths.h"
+#include "shell/common/thread_restrictions.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+constexpr uint32_t kPlanVersion = 1;
+
+// How long after opening an archive its reads are recorded.
+constexpr base::TimeDelta kRecordingTime = base::Seconds(10);
+
+// Startup rarely reads more than a few thousand files.
+constexpr size_t kMaxRecordedReads = 16384;
+
+// Ranges closer than this are read ahead as one.
+constexpr uint64_t kMergeGap = 64 * 1024;
+
+const base::FilePath::CharType kReadaheadDirName[] =
+    FILE_PATH_LITERAL("AsarReadahead");
+
+base::FilePath GetPlanPath(const base::FilePath& archive_path) {
+  base::FilePath cache_dir;
+  if (!base::PathService::Get(electron::DIR_USER_CACHE, &cache_dir))
+    return base::FilePath();
+
+  const std::string path = archive_path.AsUTF8Unsafe();
+  return cache_dir.Append(kReadaheadDirName)
+      .AppendASCII(base::ToLowerASCII(base::HexEncode(
+          crypto::SHA256Hash(base::as_bytes(base::make_span(path))))));
+}
+
+int64_t ToPlanTime(base::Time time) {
+  return time.ToDeltaSinceWindowsEpoch().InMicroseconds();
+}
+
+}  // namespace
+
+// static
+scoped_refptr<ArchiveReadahead> ArchiveReadahead::Start(
+    const base::FilePath& path) {
+  auto readahead = base::WrapRefCounted(new ArchiveReadahead(path));
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&ArchiveReadahead::LoadPlanAndReadahead, readahead));
+  return readahead;
+}
+
+ArchiveReadahead::ArchiveReadahead(const base::FilePath& path)
+    : path_(path) {}
+
+ArchiveReadahead::~ArchiveReadahead() {
+#if BUILDFLAG(IS_WIN)
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  mapping_.reset();
+#endif
+}
+
+void ArchiveReadahead::RecordRead(uint64_t offset, uint64_t size) {
+  base::AutoLock auto_lock(lock_);
+  if (recording_ && reads_.size() < kMaxRecordedReads)
+    reads_.emplace_back(offset, size);
+}
+
+void ArchiveReadahead::LoadPlanAndReadahead() {
+  if (!base::GetFileInfo(path_, &file_info_)) {
+    base::AutoLock auto_lock(lock_);
+    recording_ = false;
+    reads_.clear();
+    return;
+  }
+
+  bool has_plan = false;
+  std::vector<Range> plan;
+  std::string data;
+  const base::FilePath plan_path = GetPlanPath(path_);
+  if (!plan_path.empty() && base::ReadFileToString(plan_path, &data)) {
+    base::Pickle pickle(data.data(), data.size());
+    base::PickleIterator iter(pickle);
+    uint32_t version = 0;
+    int64_t size = 0;
+    int64_t last_modified = 0;
+    uint32_t count = 0;
+    has_plan = iter.ReadUInt32(&version) && version == kPlanVersion &&
+               iter.ReadInt64(&size) && size == file_info_.size &&
+               iter.ReadInt64(&last_modified) &&
+               last_modified == ToPlanTime(file_info_.last_modified) &&
+               iter.ReadUInt32(&count) && count <= kMaxRecordedReads;
+    for (uint32_t i = 0; has_plan && i < count; ++i) {
+      uint64_t offset = 0;
+      uint64_t length = 0;
+      has_plan = iter.ReadUInt64(&offset) && iter.ReadUInt64(&length);
+      plan.emplace_back(offset, length);
+    }
+  }
+
+  if (!has_plan) {
+    base::ThreadPool::PostDelayedTask(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&ArchiveReadahead::FinishRecording, this),
+        kRecordingTime);
+    return;
+  }
+
+  {
+    base::AutoLock auto_lock(lock_);
+    recording_ = false;
+    reads_.clear();
+  }
+  Readahead(std::move(plan));
+}
+
+void ArchiveReadahead::Readahead(std::vector<Range> ranges) {
+  // Coalesce the ranges so the disk sees few, mostly sequential requests.
+  std::sort(ranges.begin(), ranges.end());
+  std::vector<Range> merged;
+  for (const auto& [offset, size] : ranges) {
+    if (offset >= static_cast<uint64_t>(file_info_.size))
+      break;
+    const uint64_t end =
+        std::min(offset + size, static_cast<uint64_t>(file_info_.size));
+    if (!merged.empty() &&
+        offset <= merged.back().first + merged.back().second + kMergeGap) {
+      merged.back().second =
+          std::max(merged.back().first + merged.back().second, end) -
+          merged.back().first;
+    } else {
+      merged.emplace_back(offset, end - offset);
+    }
+  }
+  if (merged.empty())
+    return;
+
+#if BUILDFLAG(IS_WIN)
+  mapping_ = std::make_unique<base::MemoryMappedFile>();
+  if (!mapping_->Initialize(path_)) {
+    mapping_.reset();
+    return;
+  }
+  std::vector<WIN32_MEMORY_RANGE_ENTRY> entries;
+  for (const auto& [offset, size] : merged) {
+    if (offset + size > mapping_->length())
+      break;
+    entries.push_back({const_cast<uint8_t*>(mapping_->data() + offset),
+                       static_cast<SIZE_T>(size)});
+  }
+  ::PrefetchVirtualMemory(::GetCurrentProcess(), entries.size(),
+                          entries.data(), 0);
+#else
+  base::File file(path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return;
+  for (const auto& [offset, size] : merged) {
+#if BUILDFLAG(IS_MAC)
+    radvisory advice;
+    advice.ra_offset = offset;
+    advice.ra_count = base::saturated_cast<int>(size);
+    fcntl(file.GetPlatformFile(), F_RDADVISE, &advice);
+#else
+    posix_fadvise(file.GetPlatformFile(), offset, size, POSIX_FADV_WILLNEED);
+#endif
+  }
+#endif
+}
+
+void ArchiveReadahead::FinishRecording() {
+  std::vector<Range> reads;
+  {
+    base::AutoLock auto_lock(lock_);
+    recording_ = false;
+    reads.swap(reads_);
+  }
+
+  const base::FilePath plan_path = GetPlanPath(path_);
+  if (plan_path.empty() || !base::CreateDirectory(plan_path.DirName()))
+    return;
+
+  base::Pickle pickle;
+  pickle.WriteUInt32(kPlanVersion);
+  pickle.WriteInt64(file_info_.size);
+  pickle.WriteInt64(ToPlanTime(file_info_.last_modified));
+  pickle.WriteUInt32(reads.size());
+  for (const auto& [offset, size] : reads) {
+    pickle.WriteUInt64(offset);
+    pickle.WriteUInt64(size);
+  }
+  base::ImportantFileWriter::WriteFileAtomically(
+      plan_path, base::StringPiece(static_cast<const char*>(pickle.data()),
+                                   pickle.size()));
+}
+
+}  // namespace asar
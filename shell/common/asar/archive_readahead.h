@@ -0,0 +1,77 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_READAHEAD_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_READAHEAD_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "build/build_config.h"
+
+namespace base {
+class MemoryMappedFile;
+}
+
+namespace asar {
+
+// Files are read out of an archive at startup in whatever order the app
+// happens to load them, which scatters reads all over the archive. This
+// records the ranges read during the first seconds after the archive was
+// opened, and at later launches asks the OS to read those ranges ahead in
+// offset order, so that the reads hit the page cache instead of the disk.
+//
+// Plans are kept in the user's cache directory rather than next to the
+// archive, which usually isn't writable, and are recorded again whenever the
+// archive changes.
+class ArchiveReadahead : public base::RefCountedThreadSafe<ArchiveReadahead> {
+ public:
+  // Issues readahead for the plan recorded for |path| on the thread pool, or
+  // starts recording one if there is none yet.
+  static scoped_refptr<ArchiveReadahead> Start(const base::FilePath& path);
+
+  // disable copy
+  ArchiveReadahead(const ArchiveReadahead&) = delete;
+  ArchiveReadahead& operator=(const ArchiveReadahead&) = delete;
+
+  // Records that [offset, offset + size) of the archive was read. Does
+  // nothing when not recording.
+  void RecordRead(uint64_t offset, uint64_t size);
+
+ private:
+  friend class base::RefCountedThreadSafe<ArchiveReadahead>;
+
+  using Range = std::pair<uint64_t, uint64_t>;
+
+  explicit ArchiveReadahead(const base::FilePath& path);
+  ~ArchiveReadahead();
+
+  void LoadPlanAndReadahead();
+  void Readahead(std::vector<Range> ranges);
+  void FinishRecording();
+
+  const base::FilePath path_;
+  // Only accessed on the thread pool tasks, which run one after another.
+  base::File::Info file_info_;
+#if BUILDFLAG(IS_WIN)
+  // PrefetchVirtualMemory works on a mapping, which is kept around so that
+  // unmapping it doesn't cut the prefetch short.
+  std::unique_ptr<base::MemoryMappedFile> mapping_;
+#endif
+
+  base::Lock lock_;
+  bool recording_ GUARDED_BY(lock_) = true;
+  std::vector<Range> reads_ GUARDED_BY(lock_);
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_READAHEAD_H_
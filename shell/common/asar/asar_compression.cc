@@ -0,0 +1,249 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/asar_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "base/check.h"
+#include "base/logging.h"
+#include "base/numerics/checked_math.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "crypto/sha2.h"
+#include "shell/common/thread_restrictions.h"
+#include "third_party/brotli/include/brotli/decode.h"
+
+namespace asar {
+
+namespace {
+
+const char kBrotli[] = "brotli";
+
+absl::optional<CompressionAlgorithm> AlgorithmFromName(base::StringPiece name) {
+  if (name == kBrotli)
+    return CompressionAlgorithm::kBrotli;
+  return absl::nullopt;
+}
+
+const char* AlgorithmName(CompressionAlgorithm algorithm) {
+  switch (algorithm) {
+    case CompressionAlgorithm::kBrotli:
+      return kBrotli;
+  }
+}
+
+// Packed files have 32-bit sizes whether they are compressed or not.
+bool ComputePackedSize(CompressionPayload* compression) {
+  base::CheckedNumeric<uint32_t> packed_size = 0;
+  for (uint32_t frame : compression->blocks)
+    packed_size += frame;
+  return packed_size.AssignIfValid(&compression->packed_size);
+}
+
+}  // namespace
+
+absl::optional<CompressionPayload> CompressionFromValue(
+    const base::Value::Dict& value) {
+  const std::string* name = value.FindString("algorithm");
+  absl::optional<int> block_size = value.FindInt("blockSize");
+  const base::Value::List* blocks = value.FindList("blocks");
+  if (!name || !block_size || *block_size <= 0 || !blocks)
+    return absl::nullopt;
+  absl::optional<CompressionAlgorithm> algorithm = AlgorithmFromName(*name);
+  if (!algorithm)
+    return absl::nullopt;
+
+  CompressionPayload compression;
+  compression.algorithm = *algorithm;
+  compression.block_size = static_cast<uint32_t>(*block_size);
+  for (const base::Value& block : *blocks) {
+    absl::optional<int> frame_size = block.GetIfInt();
+    if (!frame_size || *frame_size <= 0)
+      return absl::nullopt;
+    compression.blocks.push_back(static_cast<uint32_t>(*frame_size));
+  }
+  if (!ComputePackedSize(&compression))
+    return absl::nullopt;
+  return compression;
+}
+
+absl::optional<CompressionPayload> CompressionFromRecord(
+    base::StringPiece record) {
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      record, ",", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (fields.size() < 2)
+    return absl::nullopt;
+  absl::optional<CompressionAlgorithm> algorithm =
+      AlgorithmFromName(fields[0]);
+  unsigned block_size = 0;
+  if (!algorithm || !base::StringToUint(fields[1], &block_size) ||
+      block_size == 0) {
+    return absl::nullopt;
+  }
+
+  CompressionPayload compression;
+  compression.algorithm = *algorithm;
+  compression.block_size = block_size;
+  for (size_t i = 2; i < fields.size(); ++i) {
+    unsigned frame_size = 0;
+    if (!base::StringToUint(fields[i], &frame_size) || frame_size == 0)
+      return absl::nullopt;
+    compression.blocks.push_back(frame_size);
+  }
+  if (!ComputePackedSize(&compression))
+    return absl::nullopt;
+  return compression;
+}
+
+std::string CompressionToRecord(const CompressionPayload& compression) {
+  std::string record =
+      base::StrCat({AlgorithmName(compression.algorithm), ",",
+                    base::NumberToString(compression.block_size)});
+  for (uint32_t frame : compression.blocks)
+    base::StrAppend(&record, {",", base::NumberToString(frame)});
+  return record;
+}
+
+bool IsCompressionValid(const CompressionPayload& compression,
+                        uint32_t size,
+                        const absl::optional<IntegrityPayload>& integrity) {
+  if (compression.block_size == 0 ||
+      compression.blocks.size() !=
+          (static_cast<uint64_t>(size) + compression.block_size - 1) /
+              compression.block_size) {
+    return false;
+  }
+  return !integrity || (integrity->block_size == compression.block_size &&
+                        integrity->blocks.size() == compression.blocks.size());
+}
+
+CompressedFileReader::CompressedFileReader(
+    Archive* archive,
+    const Archive::FileInfo& info,
+    absl::optional<base::span<const uint8_t>> contents)
+    : archive_(archive), info_(info), contents_(contents) {
+  DCHECK(info_.compression.has_value());
+  frame_offsets_.reserve(info_.compression->blocks.size() + 1);
+  uint64_t offset = info_.offset;
+  frame_offsets_.push_back(offset);
+  for (uint32_t frame : info_.compression->blocks) {
+    offset += frame;
+    frame_offsets_.push_back(offset);
+  }
+
+  if (!contents_)
+    contents_ = archive_->GetFileContents(info_);
+  if (!contents_) {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    file_.Initialize(archive_->path(),
+                     base::File::FLAG_OPEN | base::File::FLAG_READ);
+  }
+  if (info_.integrity.has_value())
+    archive_->RevalidateVerifiedBlocks();
+}
+
+CompressedFileReader::~CompressedFileReader() {
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  file_.Close();
+}
+
+int64_t CompressedFileReader::Read(uint64_t position,
+                                   base::span<uint8_t> out) {
+  const uint32_t block_size = info_.compression->block_size;
+  size_t copied = 0;
+  while (copied < out.size() && position < info_.size) {
+    const uint32_t block = static_cast<uint32_t>(position / block_size);
+    if (current_block_ != block) {
+      block_.resize(GetBlockSize(block));
+      if (!DecompressBlock(block, block_)) {
+        current_block_.reset();
+        return -1;
+      }
+      current_block_ = block;
+    }
+
+    const size_t offset =
+        static_cast<size_t>(position - static_cast<uint64_t>(block) *
+                                           block_size);
+    const size_t count = std::min(out.size() - copied, block_.size() - offset);
+    memcpy(out.data() + copied, block_.data() + offset, count);
+    copied += count;
+    position += count;
+  }
+  return static_cast<int64_t>(copied);
+}
+
+bool CompressedFileReader::ReadAll(base::span<uint8_t> out) {
+  DCHECK_EQ(out.size(), info_.size);
+  for (uint32_t block = 0; block < info_.compression->blocks.size(); ++block) {
+    if (!DecompressBlock(
+            block, out.subspan(static_cast<size_t>(block) *
+                                   info_.compression->block_size,
+                               GetBlockSize(block)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompressedFileReader::ReadAll(std::string* contents) {
+  contents->resize(info_.size);
+  return ReadAll(base::as_writable_bytes(base::make_span(*contents)));
+}
+
+bool CompressedFileReader::DecompressBlock(uint32_t block,
+                                           base::span<uint8_t> out) {
+  const uint64_t frame_offset = frame_offsets_[block];
+  const size_t frame_size =
+      static_cast<size_t>(frame_offsets_[block + 1] - frame_offset);
+  base::span<const uint8_t> frame;
+  if (contents_) {
+    frame = contents_->subspan(
+        static_cast<size_t>(frame_offset - info_.offset), frame_size);
+  } else {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    frame_.resize(frame_size);
+    if (!file_.IsValid() ||
+        file_.Read(frame_offset, reinterpret_cast<char*>(frame_.data()),
+                   frame_.size()) != static_cast<int>(frame_.size())) {
+      return false;
+    }
+    frame = frame_;
+  }
+
+  // Every frame holds exactly one block, anything else is malformed.
+  size_t decoded_size = out.size();
+  if (BrotliDecoderDecompress(frame.size(), frame.data(), &decoded_size,
+                              out.data()) != BROTLI_DECODER_RESULT_SUCCESS ||
+      decoded_size != out.size()) {
+    LOG(ERROR) << "Failed to decompress block " << block
+               << " of a file in " << archive_->path().value();
+    return false;
+  }
+
+  if (info_.integrity.has_value() &&
+      !archive_->IsBlockVerified(info_.offset, block)) {
+    const std::array<uint8_t, crypto::kSHA256Length> hash =
+        crypto::SHA256Hash(out);
+    if (base::ToLowerASCII(base::HexEncode(hash)) !=
+        info_.integrity->blocks[block]) {
+      LOG(FATAL) << "Integrity check failed for block " << block
+                 << " of a compressed file in asar archive";
+    }
+    archive_->MarkBlockVerified(info_.offset, block);
+  }
+  return true;
+}
+
+uint32_t CompressedFileReader::GetBlockSize(uint32_t block) const {
+  const uint32_t block_size = info_.compression->block_size;
+  return std::min(block_size, info_.size - block * block_size);
+}
+
+}  // namespace asar
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ASAR_COMPRESSION_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ASAR_COMPRESSION_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/memory/raw_ptr.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+#include "shell/common/asar/archive.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace asar {
+
+// Parses the "compression" of a file in a JSON header:
+//   {"algorithm": "brotli", "blockSize": 4194304, "blocks": [1234, ...]}
+absl::optional<CompressionPayload> CompressionFromValue(
+    const base::Value::Dict& value);
+
+// The compression of a file as the indexed header stores it,
+// "algorithm,blockSize,frame,frame...".
+absl::optional<CompressionPayload> CompressionFromRecord(
+    base::StringPiece record);
+std::string CompressionToRecord(const CompressionPayload& compression);
+
+// Whether |compression| has one frame per block of a file of |size| bytes,
+// and the blocks of |integrity| if the file has some.
+bool IsCompressionValid(const CompressionPayload& compression,
+                        uint32_t size,
+                        const absl::optional<IntegrityPayload>& integrity);
+
+// Reads the decompressed contents of a compressed file, one block at a time.
+// Frames are read from the memory-mapped archive when possible and from the
+// archive file otherwise. Blocks are validated against the integrity of the
+// file the first time they are decompressed, a mismatch is fatal as with
+// ValidateIntegrityOrDie.
+class CompressedFileReader {
+ public:
+  // |archive| must outlive the reader, as must |contents| which are the
+  // frames of the file when the caller already read them.
+  CompressedFileReader(
+      Archive* archive,
+      const Archive::FileInfo& info,
+      absl::optional<base::span<const uint8_t>> contents = absl::nullopt);
+  ~CompressedFileReader();
+
+  // disable copy
+  CompressedFileReader(const CompressedFileReader&) = delete;
+  CompressedFileReader& operator=(const CompressedFileReader&) = delete;
+
+  // Copies the decompressed bytes at |position| into |out|. Returns how many
+  // were copied, which is less than the size of |out| only at the end of the
+  // file, or -1 when a frame can't be read or decompressed.
+  int64_t Read(uint64_t position, base::span<uint8_t> out);
+
+  // Decompresses the whole file into |out|, which has its size.
+  bool ReadAll(base::span<uint8_t> out);
+  bool ReadAll(std::string* contents);
+
+  uint32_t size() const { return info_.size; }
+
+ private:
+  // Decompresses |block| into |out|, which has the size of the block.
+  bool DecompressBlock(uint32_t block, base::span<uint8_t> out);
+  uint32_t GetBlockSize(uint32_t block) const;
+
+  const raw_ptr<Archive> archive_;
+  const Archive::FileInfo info_;
+  // The offset of each frame in the archive, and of the end of the last one.
+  std::vector<uint64_t> frame_offsets_;
+  // The frames of the file, otherwise they are read from |file_|.
+  absl::optional<base::span<const uint8_t>> contents_;
+  base::File file_;
+  std::vector<uint8_t> frame_;
+
+  // The last block decompressed by Read().
+  absl::optional<uint32_t> current_block_;
+  std::vector<uint8_t> block_;
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ASAR_COMPRESSION_H_
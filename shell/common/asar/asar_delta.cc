@@ -0,0 +1,468 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/asar_delta.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/pickle.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "build/build_config.h"
+#include "crypto/sha2.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/archive_index.h"
+#include "shell/common/asar/asar_compression.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace asar {
+
+namespace {
+
+#if !defined(ARCH_CPU_LITTLE_ENDIAN)
+#error "The integers of the asar deltas are written as they are in memory"
+#endif
+
+constexpr char kDeltaMagic[8] = {'A', 'S', 'A', 'R', 'D', 'L', 'T', '\0'};
+constexpr uint32_t kDeltaVersion = 1;
+
+// Files without integrity are copied in chunks of this size.
+constexpr uint32_t kChunkSize = 1024 * 1024;
+
+enum class Op : uint8_t {
+  kCopy = 0,
+  kLiteral = 1,
+};
+
+struct PackedFile {
+  std::string path;
+  // From the start of the archive.
+  uint64_t offset = 0;
+  uint32_t size = 0;
+  absl::optional<IntegrityPayload> integrity;
+
+  uint32_t block_count() const {
+    return (size + integrity->block_size - 1) / integrity->block_size;
+  }
+  uint32_t block_size(uint32_t block) const {
+    return std::min(integrity->block_size,
+                    size - block * integrity->block_size);
+  }
+};
+
+struct Header {
+  // The size pickle and the header pickle, as they start the archive.
+  std::string bytes;
+  // The JSON or indexed header in the header pickle.
+  std::string header;
+  // Sorted by offset.
+  std::vector<PackedFile> files;
+};
+
+// Only integrity whose blocks cover the file is used, other files are
+// handled as if they had none.
+absl::optional<IntegrityPayload> CheckIntegrity(
+    uint32_t size,
+    absl::optional<IntegrityPayload> integrity) {
+  if (!integrity || integrity->algorithm != HashAlgorithm::kSHA256 ||
+      integrity->block_size == 0 ||
+      integrity->blocks.size() !=
+          (size + integrity->block_size - 1) / integrity->block_size) {
+    return absl::nullopt;
+  }
+  return integrity;
+}
+
+// Compressed files are diffed as they are stored, without their integrity
+// which is that of the decompressed blocks.
+void SetCompressed(const CompressionPayload& compression, PackedFile* file) {
+  file->size = compression.packed_size;
+  file->integrity.reset();
+}
+
+void CollectJSONFiles(const base::Value::Dict& dir,
+                      const std::string& dir_path,
+                      uint32_t header_size,
+                      std::vector<PackedFile>* files) {
+  const base::Value::Dict* children = dir.FindDict("files");
+  if (!children)
+    return;
+  for (const auto [name, value] : *children) {
+    const base::Value::Dict* node = value.GetIfDict();
+    if (!node || node->Find("link"))
+      continue;
+    const std::string path =
+        dir_path.empty() ? name : base::StrCat({dir_path, "/", name});
+    if (node->Find("files")) {
+      CollectJSONFiles(*node, path, header_size, files);
+      continue;
+    }
+    absl::optional<int> size = node->FindInt("size");
+    const std::string* offset = node->FindString("offset");
+    PackedFile file;
+    if (node->FindBool("unpacked").value_or(false) || !size || *size < 0 ||
+        !offset || !base::StringToUint64(*offset, &file.offset)) {
+      continue;
+    }
+    file.path = path;
+    file.offset += header_size;
+    file.size = static_cast<uint32_t>(*size);
+    if (const base::Value::Dict* integrity = node->FindDict("integrity")) {
+      const std::string* algorithm = integrity->FindString("algorithm");
+      const std::string* hash = integrity->FindString("hash");
+      absl::optional<int> block_size = integrity->FindInt("blockSize");
+      const base::Value::List* blocks = integrity->FindList("blocks");
+      if (algorithm && *algorithm == "SHA256" && hash && block_size &&
+          *block_size > 0 && blocks) {
+        IntegrityPayload payload;
+        payload.algorithm = HashAlgorithm::kSHA256;
+        payload.hash = *hash;
+        payload.block_size = static_cast<uint32_t>(*block_size);
+        for (const base::Value& block : *blocks) {
+          if (block.is_string())
+            payload.blocks.push_back(block.GetString());
+        }
+        file.integrity = CheckIntegrity(file.size, std::move(payload));
+      }
+    }
+    if (const base::Value::Dict* compression = node->FindDict("compression")) {
+      absl::optional<CompressionPayload> payload =
+          CompressionFromValue(*compression);
+      if (!payload)
+        continue;
+      SetCompressed(*payload, &file);
+    }
+    files->push_back(std::move(file));
+  }
+}
+
+void CollectIndexedFiles(const ArchiveIndex& index,
+                         const ArchiveIndex::Entry& dir,
+                         const std::string& dir_path,
+                         uint32_t header_size,
+                         std::vector<PackedFile>* files) {
+  std::vector<base::StringPiece> names;
+  if (!index.GetChildNames(dir, &names))
+    return;
+  for (base::StringPiece name : names) {
+    const std::string path =
+        dir_path.empty() ? std::string(name)
+                         : base::StrCat({dir_path, "/", name});
+    const ArchiveIndex::Entry* entry = index.Find(path);
+    if (!entry || entry->is_link())
+      continue;
+    if (entry->is_directory()) {
+      CollectIndexedFiles(index, *entry, path, header_size, files);
+      continue;
+    }
+    if (entry->is_unpacked())
+      continue;
+    PackedFile file;
+    file.path = path;
+    file.offset = entry->offset + header_size;
+    file.size = entry->size;
+    file.integrity = CheckIntegrity(file.size, index.GetIntegrity(*entry));
+    if (entry->is_compressed()) {
+      absl::optional<CompressionPayload> payload = index.GetCompression(*entry);
+      if (!payload)
+        continue;
+      SetCompressed(*payload, &file);
+    }
+    files->push_back(std::move(file));
+  }
+}
+
+bool ParseHeader(Header* header) {
+  uint32_t size;
+  if (header->bytes.size() < 8 ||
+      !base::PickleIterator(base::Pickle(header->bytes.data(), 8))
+           .ReadUInt32(&size) ||
+      header->bytes.size() != 8 + static_cast<uint64_t>(size) ||
+      !base::PickleIterator(base::Pickle(header->bytes.data() + 8, size))
+           .ReadString(&header->header)) {
+    return false;
+  }
+
+  const uint32_t header_size = 8 + size;
+  header->files.clear();
+  base::span<const uint8_t> data = base::as_bytes(base::make_span(
+      header->header.data(), header->header.size()));
+  if (ArchiveIndex::IsIndexedHeader(data)) {
+    // The index is read in place, so its entries must be aligned.
+    std::unique_ptr<ArchiveIndex> index = ArchiveIndex::Create(data);
+    const ArchiveIndex::Entry* root = index ? index->Find("") : nullptr;
+    if (!root)
+      return false;
+    CollectIndexedFiles(*index, *root, std::string(), header_size,
+                        &header->files);
+  } else {
+    absl::optional<base::Value> value = base::JSONReader::Read(header->header);
+    if (!value || !value->is_dict())
+      return false;
+    CollectJSONFiles(value->GetDict(), std::string(), header_size,
+                     &header->files);
+  }
+  std::sort(header->files.begin(), header->files.end(),
+            [](const PackedFile& a, const PackedFile& b) {
+              return std::tie(a.offset, a.path) < std::tie(b.offset, b.path);
+            });
+  return true;
+}
+
+bool ReadExactly(base::File& file, char* data, size_t size) {
+  while (size > 0) {
+    const int read = file.ReadAtCurrentPos(
+        data, static_cast<int>(std::min<size_t>(size, kChunkSize)));
+    if (read <= 0)
+      return false;
+    data += read;
+    size -= read;
+  }
+  return true;
+}
+
+bool ReadExactlyAt(base::File& file, uint64_t offset, char* data, size_t size) {
+  return file.Read(offset, data, size) == static_cast<int>(size);
+}
+
+template <typename T>
+bool ReadValue(base::File& file, T* value) {
+  return ReadExactly(file, reinterpret_cast<char*>(value), sizeof(T));
+}
+
+bool WriteAll(base::File& file, const char* data, size_t size) {
+  return file.WriteAtCurrentPos(data, size) == static_cast<int>(size);
+}
+
+template <typename T>
+bool WriteValue(base::File& file, T value) {
+  return WriteAll(file, reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool ReadArchiveHeader(base::File& file, Header* header) {
+  char size_pickle[8];
+  uint32_t size;
+  if (!ReadExactlyAt(file, 0, size_pickle, sizeof(size_pickle)) ||
+      !base::PickleIterator(base::Pickle(size_pickle, sizeof(size_pickle)))
+           .ReadUInt32(&size)) {
+    return false;
+  }
+  header->bytes.resize(8 + static_cast<size_t>(size));
+  return ReadExactlyAt(file, 0, header->bytes.data(), header->bytes.size()) &&
+         ParseHeader(header);
+}
+
+std::string HashBlock(base::span<const char> block) {
+  const std::array<uint8_t, crypto::kSHA256Length> hash =
+      crypto::SHA256Hash(base::as_bytes(block));
+  return base::ToLowerASCII(base::HexEncode(hash));
+}
+
+// Sets |error| and returns false, so that failures are one line.
+bool Fail(std::string* error, std::string message) {
+  *error = std::move(message);
+  return false;
+}
+
+}  // namespace
+
+bool CreateArchiveDelta(const base::FilePath& old_path,
+                        const base::FilePath& new_path,
+                        const base::FilePath& delta_path,
+                        std::string* error) {
+  base::File old_file(old_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  Header old_header;
+  if (!old_file.IsValid() || !ReadArchiveHeader(old_file, &old_header))
+    return Fail(error, "Failed to read the old archive");
+  base::File new_file(new_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  Header new_header;
+  if (!new_file.IsValid() || !ReadArchiveHeader(new_file, &new_header))
+    return Fail(error, "Failed to read the new archive");
+
+  // Where each block of the old archive is.
+  std::unordered_map<std::string, uint64_t> old_blocks;
+  for (const PackedFile& file : old_header.files) {
+    if (!file.integrity)
+      continue;
+    for (uint32_t i = 0; i < file.block_count(); ++i) {
+      old_blocks.emplace(
+          file.integrity->blocks[i],
+          file.offset + static_cast<uint64_t>(i) * file.integrity->block_size);
+    }
+  }
+
+  base::File delta(delta_path,
+                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  bool written =
+      delta.IsValid() && WriteAll(delta, kDeltaMagic, sizeof(kDeltaMagic)) &&
+      WriteValue(delta, kDeltaVersion) &&
+      WriteValue<uint64_t>(delta, new_header.bytes.size()) &&
+      WriteAll(delta, new_header.bytes.data(), new_header.bytes.size());
+
+  std::vector<char> buffer;
+  for (const PackedFile& file : new_header.files) {
+    if (!written)
+      break;
+    if (!file.integrity) {
+      written = WriteValue(delta, Op::kLiteral);
+      for (uint32_t done = 0; written && done < file.size;) {
+        const uint32_t size = std::min(kChunkSize, file.size - done);
+        buffer.resize(size);
+        if (!ReadExactlyAt(new_file, file.offset + done, buffer.data(), size))
+          return Fail(error, "Failed to read " + file.path);
+        written = WriteAll(delta, buffer.data(), size);
+        done += size;
+      }
+      continue;
+    }
+    for (uint32_t i = 0; written && i < file.block_count(); ++i) {
+      auto it = old_blocks.find(file.integrity->blocks[i]);
+      if (it != old_blocks.end()) {
+        written = WriteValue(delta, Op::kCopy) && WriteValue(delta, it->second);
+        continue;
+      }
+      const uint32_t size = file.block_size(i);
+      buffer.resize(size);
+      if (!ReadExactlyAt(new_file,
+                         file.offset + static_cast<uint64_t>(i) *
+                                           file.integrity->block_size,
+                         buffer.data(), size)) {
+        return Fail(error, "Failed to read " + file.path);
+      }
+      written = WriteValue(delta, Op::kLiteral) &&
+                WriteAll(delta, buffer.data(), size);
+    }
+  }
+  if (!written) {
+    delta.Close();
+    base::DeleteFile(delta_path);
+    return Fail(error, "Failed to write the delta");
+  }
+  return true;
+}
+
+bool ApplyArchiveDelta(const base::FilePath& old_path,
+                       const base::FilePath& delta_path,
+                       const base::FilePath& out_path,
+                       const std::string& header_hash,
+                       std::string* error) {
+  base::File delta(delta_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  char magic[sizeof(kDeltaMagic)];
+  uint32_t version;
+  uint64_t header_size;
+  Header header;
+  if (!delta.IsValid() || !ReadExactly(delta, magic, sizeof(magic)) ||
+      memcmp(magic, kDeltaMagic, sizeof(magic)) != 0 ||
+      !ReadValue(delta, &version) || version != kDeltaVersion ||
+      !ReadValue(delta, &header_size) ||
+      header_size > std::numeric_limits<uint32_t>::max()) {
+    return Fail(error, "The delta is not a valid asar delta");
+  }
+  header.bytes.resize(header_size);
+  if (!ReadExactly(delta, header.bytes.data(), header.bytes.size()) ||
+      !ParseHeader(&header)) {
+    return Fail(error, "The header of the delta is invalid");
+  }
+  if (!header_hash.empty() &&
+      HashBlock(header.header) != base::ToLowerASCII(header_hash)) {
+    return Fail(error, "The header of the delta doesn't match the hash");
+  }
+
+  base::File old_file(old_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!old_file.IsValid())
+    return Fail(error, "Failed to open the old archive");
+  const int64_t old_length = old_file.GetLength();
+
+  const base::FilePath partial_path = out_path.AddExtensionASCII("partial");
+  base::File out(partial_path,
+                 base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  auto fail = [&](std::string message) {
+    out.Close();
+    base::DeleteFile(partial_path);
+    return Fail(error, std::move(message));
+  };
+  if (!out.IsValid() ||
+      out.Write(0, header.bytes.data(), header.bytes.size()) !=
+          static_cast<int>(header.bytes.size())) {
+    return fail("Failed to write the archive");
+  }
+
+  std::vector<char> buffer;
+  for (const PackedFile& file : header.files) {
+    if (!file.integrity) {
+      Op op;
+      if (!ReadValue(delta, &op) || op != Op::kLiteral)
+        return fail("The delta is truncated at " + file.path);
+      for (uint32_t done = 0; done < file.size;) {
+        const uint32_t size = std::min(kChunkSize, file.size - done);
+        buffer.resize(size);
+        if (!ReadExactly(delta, buffer.data(), size))
+          return fail("The delta is truncated at " + file.path);
+        if (out.Write(file.offset + done, buffer.data(), size) !=
+            static_cast<int>(size)) {
+          return fail("Failed to write the archive");
+        }
+        done += size;
+      }
+      continue;
+    }
+    for (uint32_t i = 0; i < file.block_count(); ++i) {
+      const uint32_t size = file.block_size(i);
+      buffer.resize(size);
+      Op op;
+      if (!ReadValue(delta, &op))
+        return fail("The delta is truncated at " + file.path);
+      if (op == Op::kCopy) {
+        uint64_t offset;
+        if (!ReadValue(delta, &offset))
+          return fail("The delta is truncated at " + file.path);
+        if (old_length < static_cast<int64_t>(size) ||
+            offset > static_cast<uint64_t>(old_length) - size ||
+            !ReadExactlyAt(old_file, offset, buffer.data(), size)) {
+          return fail("Failed to read the old archive for " + file.path);
+        }
+      } else if (op != Op::kLiteral ||
+                 !ReadExactly(delta, buffer.data(), size)) {
+        return fail("The delta is truncated at " + file.path);
+      }
+      if (HashBlock(buffer) != file.integrity->blocks[i]) {
+        return fail(base::StrCat({"Block ", base::NumberToString(i), " of ",
+                                  file.path,
+                                  " doesn't match its integrity hash"}));
+      }
+      const uint64_t position =
+          file.offset + static_cast<uint64_t>(i) * file.integrity->block_size;
+      if (out.Write(position, buffer.data(), size) != static_cast<int>(size))
+        return fail("Failed to write the archive");
+    }
+  }
+
+  char extra;
+  if (delta.ReadAtCurrentPos(&extra, 1) != 0)
+    return fail("The delta has data past its last file");
+  out.Close();
+  if (!base::ReplaceFile(partial_path, out_path, nullptr)) {
+    base::DeleteFile(partial_path);
+    return Fail(error, "Failed to move the archive to its path");
+  }
+  return true;
+}
+
+}  // namespace asar
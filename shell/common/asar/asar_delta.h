@@ -0,0 +1,56 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ASAR_DELTA_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ASAR_DELTA_H_
+
+#include <string>
+
+namespace base {
+class FilePath;
+}
+
+namespace asar {
+
+// Block-level deltas between two versions of an archive, so that an update
+// only downloads the parts of app.asar which changed. The blocks are the ones
+// of the integrity of the files, a block of the new archive whose hash is
+// also the hash of a block of the old one is copied from it, the others are
+// in the delta. The delta is read from start to end when it is applied, and
+// every block of a file with integrity is checked against its hash.
+//
+// Layout, integers little-endian:
+//
+//   char[8]   |kDeltaMagic|.
+//   uint32    The version, 1.
+//   uint64    The size of the header of the new archive.
+//   char[]    The header of the new archive, as it starts the archive.
+//   Op[]      For each packed file of the new archive in offset order, one
+//             op per integrity block, or a single one for the whole file when
+//             it has no integrity.
+//
+// An op is a uint8 kind, followed by the uint64 offset of the block in the
+// old archive for a copy, or by the bytes of the block for a literal.
+
+// Writes to |delta_path| a delta which turns the archive at |old_path| into
+// the one at |new_path|. Blocks. Returns false and sets |error| on failure.
+bool CreateArchiveDelta(const base::FilePath& old_path,
+                        const base::FilePath& new_path,
+                        const base::FilePath& delta_path,
+                        std::string* error);
+
+// Writes to |out_path| the archive made of the one at |old_path| and the
+// delta at |delta_path|. When |header_hash| isn't empty, the SHA256 of the
+// new header must be it, as it is for the asar integrity of the app. The
+// archive is written next to |out_path| and only moved there once it is
+// complete. Blocks. Returns false and sets |error| on failure.
+bool ApplyArchiveDelta(const base::FilePath& old_path,
+                       const base::FilePath& delta_path,
+                       const base::FilePath& out_path,
+                       const std::string& header_hash,
+                       std::string* error);
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ASAR_DELTA_H_
@@ -4,86 +4,294 @@
 
 #include "shell/common/asar/asar_util.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/barrier_closure.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
-#include "base/lazy_instance.h"
+#include "base/functional/bind.h"
+#include "base/functional/function_ref.h"
 #include "base/logging.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/raw_ref.h"
 #include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/thread_annotations.h"
 #include "base/threading/thread_local.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_compression.h"
+#include "shell/common/process_util.h"
 #include "shell/common/thread_restrictions.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace asar {
 
 namespace {
 
-typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
-
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
-bool IsDirectoryCached(const base::FilePath& path) {
-  static base::NoDestructor<std::map<base::FilePath, bool>>
-      s_is_directory_cache;
-  static base::NoDestructor<base::Lock> lock;
+// A map for lookups that vastly outnumber insertions, which is the case for
+// the caches below: the Node fs hooks hit them on every access to an asar
+// path, from any thread. Readers look up in their own thread's snapshot of
+// the map without taking a lock. Writers publish a modified copy of the map
+// and bump a generation counter, which makes readers refresh their snapshot
+// on their next lookup. Each snapshot also remembers its last hit, since
+// consecutive lookups on a thread tend to be for the same key.
+template <typename Key, typename Value>
+class SnapshotMap {
+ public:
+  using Map = std::map<Key, Value>;
+
+  SnapshotMap() = default;
+
+  // disable copy
+  SnapshotMap(const SnapshotMap&) = delete;
+  SnapshotMap& operator=(const SnapshotMap&) = delete;
+
+  absl::optional<Value> Find(const Key& key) {
+    Snapshot& snapshot = GetSnapshot();
+    if (snapshot.last_hit && snapshot.last_hit->first == key)
+      return snapshot.last_hit->second;
+
+    auto it = snapshot.map->find(key);
+    if (it == snapshot.map->end())
+      return absl::nullopt;
+    snapshot.last_hit = &*it;
+    return it->second;
+  }
 
-  base::AutoLock auto_lock(*lock);
-  auto& is_directory_cache = *s_is_directory_cache;
+  // Returns the value of |key|, calling |create| under the writer lock to
+  // insert it if missing. Nothing is inserted if |create| returns nullopt.
+  absl::optional<Value> FindOrInsert(
+      const Key& key,
+      base::FunctionRef<absl::optional<Value>()> create) {
+    if (absl::optional<Value> value = Find(key))
+      return value;
+
+    base::AutoLock auto_lock(lock_);
+    // Another thread might have inserted it in the meantime.
+    auto it = map_->find(key);
+    if (it != map_->end())
+      return it->second;
+
+    absl::optional<Value> value = create();
+    if (value) {
+      auto map = std::make_shared<Map>(*map_);
+      map->emplace(key, *value);
+      Publish(std::move(map));
+    }
+    return value;
+  }
 
-  auto it = is_directory_cache.find(path);
-  if (it != is_directory_cache.end()) {
-    return it->second;
+  // Values are released by each thread with its next lookup.
+  void Clear() {
+    base::AutoLock auto_lock(lock_);
+    Publish(std::make_shared<const Map>());
   }
-  electron::ScopedAllowBlockingForElectron allow_blocking;
-  return is_directory_cache[path] = base::DirectoryExists(path);
-}
 
-}  // namespace
+ private:
+  struct Snapshot {
+    uint64_t generation = 0;
+    std::shared_ptr<const Map> map;
+    raw_ptr<const typename Map::value_type> last_hit = nullptr;
+  };
+
+  Snapshot& GetSnapshot() {
+    Snapshot* snapshot = snapshots_.Get();
+    if (!snapshot) {
+      auto new_snapshot = std::make_unique<Snapshot>();
+      snapshot = new_snapshot.get();
+      snapshots_.Set(std::move(new_snapshot));
+    }
+
+    if (snapshot->generation != generation_.load(std::memory_order_acquire)) {
+      base::AutoLock auto_lock(lock_);
+      snapshot->last_hit = nullptr;
+      snapshot->map = map_;
+      snapshot->generation = generation_.load(std::memory_order_relaxed);
+    }
+    return *snapshot;
+  }
+
+  void Publish(std::shared_ptr<const Map> map)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    map_ = std::move(map);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+
+  base::Lock lock_;
+  std::shared_ptr<const Map> map_ GUARDED_BY(lock_) =
+      std::make_shared<const Map>();
+  std::atomic<uint64_t> generation_{1};
+  base::ThreadLocalOwnedPointer<Snapshot> snapshots_;
+};
+
+using ArchiveMap = SnapshotMap<base::FilePath, std::shared_ptr<Archive>>;
 
 ArchiveMap& GetArchiveCache() {
   static base::NoDestructor<ArchiveMap> s_archive_map;
   return *s_archive_map;
 }
 
-base::Lock& GetArchiveCacheLock() {
+bool IsDirectoryCached(const base::FilePath& path) {
+  static base::NoDestructor<SnapshotMap<base::FilePath, bool>>
+      s_is_directory_cache;
+
+  return s_is_directory_cache
+      ->FindOrInsert(path,
+                     [&path]() -> absl::optional<bool> {
+                       electron::ScopedAllowBlockingForElectron allow_blocking;
+                       return base::DirectoryExists(path);
+                     })
+      .value();
+}
+
+base::Lock& GetSharedIndexProviderLock() {
   static base::NoDestructor<base::Lock> lock;
   return *lock;
 }
 
-std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
-  base::AutoLock auto_lock(GetArchiveCacheLock());
-  ArchiveMap& map = GetArchiveCache();
+SharedIndexProvider& GetSharedIndexProvider() {
+  static base::NoDestructor<SharedIndexProvider> s_provider;
+  return *s_provider;
+}
 
-  // if we have it, return it
-  const auto lower = map.lower_bound(path);
-  if (lower != std::end(map) && !map.key_comp()(path, lower->first))
-    return lower->second;
+std::shared_ptr<Archive> CreateAsarArchive(const base::FilePath& path) {
+  SharedIndexProvider provider;
+  {
+    base::AutoLock auto_lock(GetSharedIndexProviderLock());
+    provider = GetSharedIndexProvider();
+  }
+
+  // Prefer attaching to the header the browser process already parsed.
+  if (provider) {
+    base::ReadOnlySharedMemoryRegion region = provider.Run(path);
+    if (region.IsValid()) {
+      auto archive = std::make_shared<Archive>(path);
+      if (archive->InitFromSharedIndex(std::move(region)))
+        return archive;
+    }
+  }
 
-  // if we can create it, return it
   auto archive = std::make_shared<Archive>(path);
-  if (archive->Init()) {
-    map.try_emplace(lower, path, archive);
-    return archive;
+  if (!archive->Init())
+    return nullptr;
+  // The browser process opens archives first, let it do the readahead for
+  // everyone since the page cache is shared anyway.
+  if (electron::IsBrowserProcess())
+    archive->StartReadahead();
+  return archive;
+}
+
+// Validates single integrity blocks of a file, possibly from several threads
+// at once.
+class BlockValidator {
+ public:
+  BlockValidator(Archive& archive,
+                 uint64_t file_offset,
+                 const IntegrityPayload& integrity,
+                 base::span<const uint8_t> contents)
+      : archive_(archive),
+        file_offset_(file_offset),
+        integrity_(integrity),
+        contents_(contents) {}
+
+  // disable copy
+  BlockValidator(const BlockValidator&) = delete;
+  BlockValidator& operator=(const BlockValidator&) = delete;
+
+  void Validate(uint32_t block) {
+    const size_t block_start =
+        static_cast<size_t>(block) * integrity_->block_size;
+    base::span<const uint8_t> data = contents_.subspan(
+        block_start, std::min<size_t>(integrity_->block_size,
+                                      contents_.size() - block_start));
+    // BoringSSL picks the SHA extensions of the CPU when they are available.
+    const std::array<uint8_t, crypto::kSHA256Length> hash =
+        crypto::SHA256Hash(data);
+    if (base::ToLowerASCII(base::HexEncode(hash)) ==
+        integrity_->blocks[block]) {
+      archive_->MarkBlockVerified(file_offset_, block);
+    } else {
+      failed_ = true;
+    }
   }
 
-  // didn't have it, couldn't create it
-  return nullptr;
+  bool failed() const { return failed_; }
+
+ private:
+  const raw_ref<Archive> archive_;
+  const uint64_t file_offset_;
+  const raw_ref<const IntegrityPayload> integrity_;
+  const base::span<const uint8_t> contents_;
+  std::atomic<bool> failed_{false};
+};
+
+}  // namespace
+
+std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
+  return GetArchiveCache()
+      .FindOrInsert(path,
+                    [&path]() -> absl::optional<std::shared_ptr<Archive>> {
+                      if (std::shared_ptr<Archive> archive =
+                              CreateAsarArchive(path))
+                        return archive;
+                      return absl::nullopt;
+                    })
+      .value_or(nullptr);
 }
 
-void ClearArchives() {
-  base::AutoLock auto_lock(GetArchiveCacheLock());
-  ArchiveMap& map = GetArchiveCache();
+std::shared_ptr<Archive> GetCachedAsarArchive(const base::FilePath& path) {
+  return GetArchiveCache().Find(path).value_or(nullptr);
+}
+
+void SetSharedIndexProvider(SharedIndexProvider provider) {
+  base::AutoLock auto_lock(GetSharedIndexProviderLock());
+  GetSharedIndexProvider() = std::move(provider);
+}
+
+void PrefetchFilesOut(std::shared_ptr<Archive> archive,
+                      std::vector<base::FilePath> paths,
+                      base::OnceClosure done) {
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      paths.size(),
+      base::BindOnce(
+          [](scoped_refptr<base::SequencedTaskRunner> task_runner,
+             base::OnceClosure done) {
+            task_runner->PostTask(FROM_HERE, std::move(done));
+          },
+          base::SequencedTaskRunner::GetCurrentDefault(), std::move(done)));
+
+  for (base::FilePath& path : paths) {
+    base::ThreadPool::PostTask(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(
+            [](std::shared_ptr<Archive> archive, const base::FilePath& path,
+               base::OnceClosure done) {
+              base::FilePath out;
+              archive->CopyFileOut(path, &out);
+              std::move(done).Run();
+            },
+            archive, std::move(path), barrier));
+  }
+}
 
-  map.clear();
+void ClearArchives() {
+  GetArchiveCache().Clear();
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -130,6 +338,18 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
+  if (info.compression.has_value())
+    return CompressedFileReader(archive.get(), info).ReadAll(contents);
+
+  if (absl::optional<base::span<const uint8_t>> mapped =
+          archive->GetFileContents(info)) {
+    if (info.integrity.has_value())
+      ValidateIntegrityOrDie(*mapped, info.integrity.value());
+    contents->assign(reinterpret_cast<const char*>(mapped->data()),
+                     mapped->size());
+    return true;
+  }
+
   base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
   if (!src.IsValid())
     return false;
@@ -169,4 +389,56 @@ void ValidateIntegrityOrDie(const char* data,
   }
 }
 
+void ValidateIntegrityOrDie(base::span<const uint8_t> data,
+                            const IntegrityPayload& integrity) {
+  ValidateIntegrityOrDie(reinterpret_cast<const char*>(data.data()),
+                         data.size(), integrity);
+}
+
+bool ValidateBlocksInParallel(Archive& archive,
+                              uint64_t file_offset,
+                              const IntegrityPayload& integrity,
+                              base::span<const uint8_t> contents,
+                              uint64_t start,
+                              uint64_t end) {
+  if (integrity.algorithm != HashAlgorithm::kSHA256 ||
+      integrity.block_size == 0 || start > end || end > contents.size()) {
+    return false;
+  }
+  if (start == end)
+    return true;
+
+  const size_t first_block = start / integrity.block_size;
+  const size_t last_block = end == 0 ? 0 : (end - 1) / integrity.block_size;
+  if (last_block >= integrity.blocks.size())
+    return false;
+
+  archive.RevalidateVerifiedBlocks();
+  std::vector<uint32_t> pending;
+  for (size_t block = first_block; block <= last_block; ++block) {
+    if (!archive.IsBlockVerified(file_offset, block))
+      pending.push_back(static_cast<uint32_t>(block));
+  }
+  if (pending.empty())
+    return true;
+
+  // Hash the first block on this thread while the thread pool takes the rest.
+  BlockValidator validator(archive, file_offset, integrity, contents);
+  base::WaitableEvent done;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      pending.size() - 1,
+      base::BindOnce(&base::WaitableEvent::Signal, base::Unretained(&done)));
+  for (size_t i = 1; i < pending.size(); ++i) {
+    base::ThreadPool::PostTask(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&BlockValidator::Validate, base::Unretained(&validator),
+                       pending[i])
+            .Then(barrier));
+  }
+  validator.Validate(pending[0]);
+  done.Wait();
+
+  return !validator.failed();
+}
+
 }  // namespace asar
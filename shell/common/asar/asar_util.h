@@ -7,6 +7,11 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/functional/callback.h"
+#include "base/memory/read_only_shared_memory_region.h"
 
 namespace base {
 class FilePath;
@@ -20,6 +25,27 @@ struct IntegrityPayload;
 // Gets or creates and caches a new Archive from the path.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
 
+// Gets a cached Archive without creating one.
+std::shared_ptr<Archive> GetCachedAsarArchive(const base::FilePath& path);
+
+// Returns the shared header of the archive at the given path as produced by
+// Archive::GetSharedIndex in the browser process, or an invalid region.
+using SharedIndexProvider =
+    base::RepeatingCallback<base::ReadOnlySharedMemoryRegion(
+        const base::FilePath&)>;
+
+// Makes GetOrCreateAsarArchive attach to headers provided by |provider|
+// before falling back to parsing them. |provider| is called on whichever
+// thread opens an archive first.
+void SetSharedIndexProvider(SharedIndexProvider provider);
+
+// Copies |paths| out of |archive| in parallel on the thread pool so that
+// later Archive::CopyFileOut calls for them return right away. |done| is run
+// on the calling sequence once all of them were copied out.
+void PrefetchFilesOut(std::shared_ptr<Archive> archive,
+                      std::vector<base::FilePath> paths,
+                      base::OnceClosure done);
+
 // Destroy cached Archive objects.
 void ClearArchives();
 
@@ -35,6 +61,21 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents);
 void ValidateIntegrityOrDie(const char* data,
                             size_t size,
                             const IntegrityPayload& integrity);
+void ValidateIntegrityOrDie(base::span<const uint8_t> data,
+                            const IntegrityPayload& integrity);
+
+// Validates the integrity blocks of a packed file that overlap the
+// [start, end) byte range of its |contents|, |file_offset| being the file's
+// offset in |archive|. Independent blocks are hashed concurrently on the
+// thread pool and blocks |archive| has already validated are skipped. Returns
+// false on a mismatch. Must be called on a sequence that allows waiting, i.e.
+// with base::WithBaseSyncPrimitives.
+bool ValidateBlocksInParallel(Archive& archive,
+                              uint64_t file_offset,
+                              const IntegrityPayload& integrity,
+                              base::span<const uint8_t> contents,
+                              uint64_t start,
+                              uint64_t end);
 
 }  // namespace asar
 
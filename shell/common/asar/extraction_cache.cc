@@ -0,0 +1,157 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/extraction_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "crypto/sha2.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/electron_paths.h"
+#include "shell/common/thread_restrictions.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+const base::FilePath::CharType kExtractionCacheDirName[] =
+    FILE_PATH_LITERAL("AsarExtractionCache");
+
+bool GetExtractionCacheDir(base::FilePath* dir) {
+  base::FilePath cache_dir;
+  if (!base::PathService::Get(electron::DIR_USER_CACHE, &cache_dir))
+    return false;
+  *dir = cache_dir.Append(kExtractionCacheDirName);
+  if (!base::CreateDirectory(*dir))
+    return false;
+#if BUILDFLAG(IS_POSIX)
+  // Cached copies are trusted once they match their hash, but nobody else
+  // should be able to swap them out in between.
+  base::SetPosixFilePermissions(*dir, base::FILE_PERMISSION_USER_MASK);
+#endif
+  return true;
+}
+
+bool IsValidCacheEntry(const base::FilePath& path,
+                       const Archive::FileInfo& info) {
+  int64_t size = 0;
+  if (!base::GetFileSize(path, &size) || size != info.size)
+    return false;
+
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  return base::ToLowerASCII(base::HexEncode(crypto::SHA256Hash(
+             base::as_bytes(base::make_span(contents))))) ==
+         info.integrity->hash;
+}
+
+// Writes |contents|, the bytes at |offset| of |src| unless it is null, to
+// |dest|.
+bool WriteContents(base::File* src,
+                   uint64_t offset,
+                   base::span<const uint8_t> contents,
+                   base::File* dest) {
+  size_t written = 0;
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+  // Let the kernel copy the data without moving it through user space, which
+  // filesystems like btrfs or XFS turn into a reflink where they can.
+  loff_t src_offset = offset;
+  while (src && written < contents.size()) {
+    ssize_t copied = HANDLE_EINTR(
+        syscall(__NR_copy_file_range, src->GetPlatformFile(), &src_offset,
+                dest->GetPlatformFile(), nullptr, contents.size() - written,
+                0u));
+    if (copied <= 0)
+      break;
+    written += copied;
+  }
+#endif
+  // Write whatever is left, e.g. on filesystems without copy_file_range.
+  const size_t remaining = contents.size() - written;
+  return dest->Write(written,
+                     reinterpret_cast<const char*>(contents.data() + written),
+                     remaining) == static_cast<int>(remaining);
+}
+
+}  // namespace
+
+bool ExtractToCache(base::File* archive_file,
+                    absl::optional<base::span<const uint8_t>> contents,
+                    const Archive::FileInfo& info,
+                    const base::FilePath::StringType& ext,
+                    base::FilePath* out) {
+  if (!info.integrity || info.integrity->algorithm != HashAlgorithm::kSHA256)
+    return false;
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::FilePath dir;
+  if (!GetExtractionCacheDir(&dir))
+    return false;
+
+  const base::FilePath path =
+      dir.Append(base::FilePath::FromASCII(info.integrity->hash))
+          .AddExtension(ext);
+  if (IsValidCacheEntry(path, info)) {
+#if BUILDFLAG(IS_POSIX)
+    if (info.executable)
+      base::SetPosixFilePermissions(path, 0755);
+#endif
+    *out = path;
+    return true;
+  }
+
+  std::vector<char> buf;
+  if (!contents) {
+    buf.resize(info.size);
+    if (archive_file->Read(info.offset, buf.data(), buf.size()) !=
+        static_cast<int>(info.size))
+      return false;
+    contents = base::as_bytes(base::make_span(buf));
+  }
+  ValidateIntegrityOrDie(*contents, info.integrity.value());
+
+  // Write to a temporary file first so that other processes extracting the
+  // same file never see a partial copy.
+  base::FilePath temp_path;
+  if (!base::CreateTemporaryFileInDir(dir, &temp_path))
+    return false;
+
+  bool written = false;
+  {
+    base::File dest(temp_path, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+    written = dest.IsValid() &&
+              WriteContents(archive_file, info.offset, *contents, &dest);
+  }
+#if BUILDFLAG(IS_POSIX)
+  if (written && info.executable)
+    base::SetPosixFilePermissions(temp_path, 0755);
+#endif
+
+  if (!written || !base::ReplaceFile(temp_path, path, nullptr)) {
+    base::DeleteFile(temp_path);
+    // Replacing fails on Windows while another process has the file loaded,
+    // in which case that copy is as good as ours.
+    if (!written || !IsValidCacheEntry(path, info))
+      return false;
+  }
+
+  *out = path;
+  return true;
+}
+
+}  // namespace asar
@@ -0,0 +1,41 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+#define ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+
+#include <cstdint>
+
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "shell/common/asar/archive.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class File;
+}
+
+namespace asar {
+
+// Packed files copied out of archives are kept in the user's cache directory
+// across launches, so that e.g. native modules are only extracted once.
+// Entries are named after the SHA256 hash in the file's integrity, which makes
+// them independent of the archive they came from and means they never go
+// stale. A cached copy is checked against that hash before it is reused.
+//
+// Copies the packed file |info| of |archive_file| into the cache unless it is
+// already there and stores the path of the cached copy in |out|. |contents|
+// are the file's bytes when the archive is memory-mapped, or the decompressed
+// bytes of a compressed file, |archive_file| is null then. Returns false when
+// the file has no SHA256 integrity or the cache can't be written, callers
+// should then fall back to a temporary file.
+bool ExtractToCache(base::File* archive_file,
+                    absl::optional<base::span<const uint8_t>> contents,
+                    const Archive::FileInfo& info,
+                    const base::FilePath::StringType& ext,
+                    base::FilePath* out);
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
@@ -0,0 +1,135 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/buffered_amount_tracker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "mojo/public/c/system/quota.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
+#include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
+
+namespace electron {
+
+namespace {
+
+// Mojo asks the peer to acknowledge every (limit + 1) / 2 messages it reads.
+// With a bigger limit the last few messages of a burst would never be
+// acknowledged, and the buffered amount would never get back to 0.
+constexpr uint64_t kUnreadMessageQuota = 1;
+
+// How often the pipe is checked for the low watermark while above the high
+// one. The peer doesn't tell when it reads, so this is polled.
+constexpr base::TimeDelta kPollInterval = base::Milliseconds(20);
+
+}  // namespace
+
+BufferedAmountTracker::BufferedAmountTracker(WatermarkCallback callback)
+    : callback_(std::move(callback)) {}
+
+BufferedAmountTracker::~BufferedAmountTracker() = default;
+
+// static
+uint64_t BufferedAmountTracker::GetMessageSize(
+    const blink::TransferableMessage& message) {
+  uint64_t size = message.encoded_message.size();
+  for (const auto& contents : message.array_buffer_contents_array)
+    size += contents->contents.size();
+  return size;
+}
+
+void BufferedAmountTracker::SetPipe(mojo::MessagePipeHandle pipe) {
+  // The pipe may be handed to another process, which shouldn't keep sending
+  // acknowledgements nobody asked for.
+  if (tracking_ && pipe_.is_valid()) {
+    MojoSetQuota(pipe_.value(), MOJO_QUOTA_TYPE_UNREAD_MESSAGE_COUNT,
+                 MOJO_QUOTA_LIMIT_NONE, nullptr);
+  }
+  pipe_ = pipe;
+  unread_sizes_.clear();
+  buffered_amount_ = 0;
+  above_high_watermark_ = false;
+  poll_timer_.Stop();
+  if (tracking_ && pipe_.is_valid()) {
+    MojoSetQuota(pipe_.value(), MOJO_QUOTA_TYPE_UNREAD_MESSAGE_COUNT,
+                 kUnreadMessageQuota, nullptr);
+  }
+}
+
+void BufferedAmountTracker::SetWatermarks(uint64_t high, uint64_t low) {
+  high_watermark_ = high;
+  low_watermark_ = std::min(low, high);
+  if (high_watermark_) {
+    EnableTracking();
+  } else {
+    above_high_watermark_ = false;
+    poll_timer_.Stop();
+  }
+}
+
+void BufferedAmountTracker::OnMessagePosted(uint64_t size) {
+  if (!tracking_ || !pipe_.is_valid())
+    return;
+  DropReadMessages();
+  unread_sizes_.push_back(size);
+  buffered_amount_ += size;
+  if (!high_watermark_ || above_high_watermark_ ||
+      buffered_amount_ <= high_watermark_) {
+    return;
+  }
+  above_high_watermark_ = true;
+  // Unretained is safe as |poll_timer_| is owned by |this|.
+  poll_timer_.Start(FROM_HERE, kPollInterval,
+                    base::BindRepeating(&BufferedAmountTracker::Poll,
+                                        base::Unretained(this)));
+  // May destroy |this|.
+  callback_.Run(true);
+}
+
+uint64_t BufferedAmountTracker::GetBufferedAmount() {
+  EnableTracking();
+  DropReadMessages();
+  return buffered_amount_;
+}
+
+void BufferedAmountTracker::EnableTracking() {
+  if (tracking_)
+    return;
+  tracking_ = true;
+  // What was posted before can't be told apart from what is posted next, so
+  // it is not counted.
+  if (pipe_.is_valid()) {
+    MojoSetQuota(pipe_.value(), MOJO_QUOTA_TYPE_UNREAD_MESSAGE_COUNT,
+                 kUnreadMessageQuota, nullptr);
+  }
+}
+
+void BufferedAmountTracker::DropReadMessages() {
+  uint64_t limit = 0;
+  uint64_t usage = 0;
+  // Fails once the pipe is closed, when nothing will be read anymore.
+  if (!pipe_.is_valid() ||
+      MojoQueryQuota(pipe_.value(), MOJO_QUOTA_TYPE_UNREAD_MESSAGE_COUNT,
+                     nullptr, &limit, &usage) != MOJO_RESULT_OK) {
+    usage = 0;
+  }
+  while (unread_sizes_.size() > usage) {
+    buffered_amount_ -= unread_sizes_.front();
+    unread_sizes_.pop_front();
+  }
+}
+
+void BufferedAmountTracker::Poll() {
+  DropReadMessages();
+  if (buffered_amount_ > low_watermark_)
+    return;
+  above_high_watermark_ = false;
+  poll_timer_.Stop();
+  // May destroy |this|.
+  callback_.Run(false);
+}
+
+}  // namespace electron
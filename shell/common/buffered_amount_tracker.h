@@ -0,0 +1,84 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_BUFFERED_AMOUNT_TRACKER_H_
+#define ELECTRON_SHELL_COMMON_BUFFERED_AMOUNT_TRACKER_H_
+
+#include <cstdint>
+
+#include "base/containers/circular_deque.h"
+#include "base/functional/callback.h"
+#include "base/timer/timer.h"
+#include "mojo/public/cpp/system/message_pipe.h"
+
+namespace blink {
+struct TransferableMessage;
+}
+
+namespace electron {
+
+// Keeps track of how many bytes were posted on a message pipe without having
+// been read by the other end yet, like WebSocket's bufferedAmount, and reports
+// when that goes above a high watermark and back down to a low one.
+//
+// Mojo only knows how many messages are unread, from the acknowledgements it
+// asks the peer for once a quota is set on the pipe, so the sizes of the
+// posted messages are remembered and dropped, oldest first, as they get read.
+// Nothing is tracked until the buffered amount is asked for or watermarks are
+// set, so that pipes nobody watches don't pay for the acknowledgements.
+class BufferedAmountTracker {
+ public:
+  // Run with true when the buffered amount goes above the high watermark and
+  // with false once it is back at or below the low watermark.
+  using WatermarkCallback = base::RepeatingCallback<void(bool high)>;
+
+  explicit BufferedAmountTracker(WatermarkCallback callback);
+  ~BufferedAmountTracker();
+
+  // disable copy
+  BufferedAmountTracker(const BufferedAmountTracker&) = delete;
+  BufferedAmountTracker& operator=(const BufferedAmountTracker&) = delete;
+
+  // The bytes |message| adds to the buffered amount: its encoded value and
+  // the contents of its transferred ArrayBuffers.
+  static uint64_t GetMessageSize(const blink::TransferableMessage& message);
+
+  // Starts tracking the messages posted on |pipe|, or stops when it is
+  // invalid. Whatever was buffered on the previous pipe is forgotten.
+  void SetPipe(mojo::MessagePipeHandle pipe);
+
+  // A |high| watermark of 0 turns the notifications off. |low| is clamped to
+  // |high|.
+  void SetWatermarks(uint64_t high, uint64_t low);
+
+  // Called after each message of |size| bytes is written to the pipe.
+  void OnMessagePosted(uint64_t size);
+
+  uint64_t GetBufferedAmount();
+  // Whether the buffered amount went above the high watermark and hasn't
+  // gone back down to the low one since.
+  bool is_above_high_watermark() const { return above_high_watermark_; }
+
+ private:
+  void EnableTracking();
+  // Forgets the sizes of the messages the peer has read.
+  void DropReadMessages();
+  // Checks for the low watermark while above the high one.
+  void Poll();
+
+  WatermarkCallback callback_;
+  mojo::MessagePipeHandle pipe_;
+  bool tracking_ = false;
+  // The sizes of the unread messages, oldest first.
+  base::circular_deque<uint64_t> unread_sizes_;
+  uint64_t buffered_amount_ = 0;
+  uint64_t high_watermark_ = 0;
+  uint64_t low_watermark_ = 0;
+  bool above_high_watermark_ = false;
+  base::RepeatingTimer poll_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_BUFFERED_AMOUNT_TRACKER_H_
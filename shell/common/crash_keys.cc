@@ -5,12 +5,15 @@
 #include "shell/common/crash_keys.h"
 
 #include <deque>
+#include <limits>
 #include <map>
 #include <string>
 
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_split.h"
 #include "components/crash/core/common/crash_key.h"
 #include "content/public/common/content_switches.h"
@@ -43,6 +46,22 @@ std::deque<std::string>& GetExtraCrashKeyNames() {
   return *crash_key_names;
 }
 
+// The sizes of the values of the extra crash keys, which the budget is
+// checked against without copying the values out of the keys.
+std::deque<size_t>& GetExtraCrashKeySizes() {
+  static base::NoDestructor<std::deque<size_t>> crash_key_sizes;
+  return *crash_key_sizes;
+}
+
+size_t g_crash_keys_budget = std::numeric_limits<size_t>::max();
+size_t g_crash_keys_size = 0;
+
+void EmitCrashKeyWarning(const std::string& warning) {
+  node::Environment* env =
+      node::Environment::GetCurrent(JavascriptEnvironment::GetIsolate());
+  EmitWarning(env, warning, "electron");
+}
+
 }  // namespace
 
 constexpr uint32_t kMaxCrashKeyNameLength = 40;
@@ -53,25 +72,42 @@ void SetCrashKey(const std::string& key, const std::string& value) {
   // Chrome DCHECK()s if we try to set an annotation with a name longer than
   // the max.
   if (key.size() >= kMaxCrashKeyNameLength) {
-    node::Environment* env =
-        node::Environment::GetCurrent(JavascriptEnvironment::GetIsolate());
-    EmitWarning(env,
-                "The crash key name, \"" + key + "\", is longer than " +
-                    std::to_string(kMaxCrashKeyNameLength) +
-                    " bytes, ignoring it.",
-                "electron");
+    EmitCrashKeyWarning("The crash key name, \"" + key +
+                        "\", is longer than " +
+                        std::to_string(kMaxCrashKeyNameLength) +
+                        " bytes, ignoring it.");
     return;
   }
 
   auto& crash_key_names = GetExtraCrashKeyNames();
+  auto& crash_key_sizes = GetExtraCrashKeySizes();
 
   auto iter = std::find(crash_key_names.begin(), crash_key_names.end(), key);
   if (iter == crash_key_names.end()) {
     crash_key_names.emplace_back(key);
+    crash_key_sizes.push_back(0);
     GetExtraCrashKeys().emplace_back(crash_key_names.back().c_str());
     iter = crash_key_names.end() - 1;
   }
-  GetExtraCrashKeys()[iter - crash_key_names.begin()].Set(value);
+  const size_t index = iter - crash_key_names.begin();
+
+  // The value this key had is given back to the budget first.
+  g_crash_keys_size -= crash_key_sizes[index];
+  // The budget can have been lowered below the size of the other keys.
+  const size_t available = g_crash_keys_size < g_crash_keys_budget
+                               ? g_crash_keys_budget - g_crash_keys_size
+                               : 0;
+  base::StringPiece fitting(value);
+  if (fitting.size() > available) {
+    EmitCrashKeyWarning("The value of the crash key \"" + key +
+                        "\" doesn't fit in the crash keys budget of " +
+                        std::to_string(g_crash_keys_budget) +
+                        " bytes, truncating it.");
+    fitting = fitting.substr(0, available);
+  }
+  crash_key_sizes[index] = fitting.size();
+  g_crash_keys_size += fitting.size();
+  GetExtraCrashKeys()[index].Set(fitting);
 }
 
 void ClearCrashKey(const std::string& key) {
@@ -79,10 +115,21 @@ void ClearCrashKey(const std::string& key) {
 
   auto iter = std::find(crash_key_names.begin(), crash_key_names.end(), key);
   if (iter != crash_key_names.end()) {
-    GetExtraCrashKeys()[iter - crash_key_names.begin()].Clear();
+    const size_t index = iter - crash_key_names.begin();
+    GetExtraCrashKeys()[index].Clear();
+    g_crash_keys_size -= GetExtraCrashKeySizes()[index];
+    GetExtraCrashKeySizes()[index] = 0;
   }
 }
 
+void SetCrashKeysBudget(size_t budget) {
+  g_crash_keys_budget = budget;
+}
+
+size_t GetCrashKeysBudget() {
+  return g_crash_keys_budget;
+}
+
 void GetCrashKeys(std::map<std::string, std::string>* keys) {
   const auto& crash_key_names = GetExtraCrashKeyNames();
   const auto& crash_keys = GetExtraCrashKeys();
@@ -103,6 +150,13 @@ bool IsRunningAsNode() {
 }  // namespace
 
 void SetCrashKeysFromCommandLine(const base::CommandLine& command_line) {
+  size_t budget;
+  if (base::StringToSizeT(
+          command_line.GetSwitchValueASCII(switches::kCrashKeysBudget),
+          &budget)) {
+    SetCrashKeysBudget(budget);
+  }
+
   // NB. this is redundant with the 'ptype' key that //components/crash
   // reports; it's present for backwards compatibility.
   static crash_reporter::CrashKeyString<16> process_type_key("process_type");
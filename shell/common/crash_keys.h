@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_COMMON_CRASH_KEYS_H_
 #define ELECTRON_SHELL_COMMON_CRASH_KEYS_H_
 
+#include <cstddef>
 #include <map>
 #include <string>
 
@@ -18,6 +19,11 @@ void SetCrashKey(const std::string& key, const std::string& value);
 void ClearCrashKey(const std::string& key);
 void GetCrashKeys(std::map<std::string, std::string>* keys);
 
+// Limits the total size of the values of the keys set with SetCrashKey, the
+// values which don't fit are truncated.
+void SetCrashKeysBudget(size_t budget);
+size_t GetCrashKeysBudget();
+
 void SetCrashKeysFromCommandLine(const base::CommandLine& command_line);
 void SetPlatformCrashKey();
 
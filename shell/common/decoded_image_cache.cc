@@ -0,0 +1,60 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/decoded_image_cache.h"
+
+#include "base/check.h"
+#include "base/no_destructor.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/image/image_skia_rep.h"
+
+namespace electron {
+
+// static
+DecodedImageCache* DecodedImageCache::Get() {
+  static base::NoDestructor<DecodedImageCache> cache;
+  // The cache is bound to the first thread which uses it, which is the main
+  // thread as the images are created there first.
+  if (cache->thread_ != base::PlatformThread::CurrentRef())
+    return nullptr;
+  return cache.get();
+}
+
+DecodedImageCache::DecodedImageCache()
+    : thread_(base::PlatformThread::CurrentRef()) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+gfx::ImageSkia DecodedImageCache::Acquire(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return gfx::ImageSkia();
+  it->second.users++;
+  return it->second.image;
+}
+
+void DecodedImageCache::Insert(const std::string& key,
+                               const gfx::ImageSkia& image) {
+  DCHECK(!image.isNull());
+  Entry& entry = entries_[key];
+  entry.image = image;
+  entry.users++;
+}
+
+void DecodedImageCache::Release(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it != entries_.end() && --it->second.users == 0)
+    entries_.erase(it);
+}
+
+size_t DecodedImageCache::GetMemoryUsage() const {
+  size_t usage = 0;
+  for (const auto& [key, entry] : entries_) {
+    for (const gfx::ImageSkiaRep& rep : entry.image.image_reps())
+      usage += rep.GetBitmap().computeByteSize();
+  }
+  return usage;
+}
+
+}  // namespace electron
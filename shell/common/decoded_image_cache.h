@@ -0,0 +1,60 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+#define ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/threading/platform_thread.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace electron {
+
+// Shares the decoded images between the NativeImages created from identical
+// sources, so that they also share the representations of every scale factor.
+// The sources are identified by the SHA256 hash of their contents. The entries
+// are weak, an entry is dropped once the last NativeImage using it is gone.
+//
+// gfx::ImageSkia can't be shared across threads, the cache is only used on the
+// main thread of the process.
+class DecodedImageCache {
+ public:
+  // Returns nullptr when not called on the main thread.
+  static DecodedImageCache* Get();
+
+  DecodedImageCache();
+  ~DecodedImageCache();
+
+  // disable copy
+  DecodedImageCache(const DecodedImageCache&) = delete;
+  DecodedImageCache& operator=(const DecodedImageCache&) = delete;
+
+  // Returns the image cached for |key| and takes a reference to it, or a null
+  // image when there is none.
+  gfx::ImageSkia Acquire(const std::string& key);
+  // Caches |image| for |key| and takes a reference to it.
+  void Insert(const std::string& key, const gfx::ImageSkia& image);
+  // Drops a reference taken by Acquire or Insert.
+  void Release(const std::string& key);
+
+  size_t entry_count() const { return entries_.size(); }
+  // The size in bytes of the bitmaps of the cached images.
+  size_t GetMemoryUsage() const;
+
+ private:
+  struct Entry {
+    gfx::ImageSkia image;
+    int users = 0;
+  };
+
+  base::flat_map<std::string, Entry> entries_;
+
+  const base::PlatformThreadRef thread_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
@@ -5,6 +5,7 @@
 #include "shell/common/gin_converters/gfx_converter.h"
 
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/record.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
 #include "ui/gfx/geometry/point.h"
@@ -15,9 +16,33 @@
 
 namespace gin {
 
+namespace {
+
+gin_helper::RecordTemplate kPointTemplate({"x", "y"});
+gin_helper::RecordTemplate kSizeTemplate({"width", "height"});
+gin_helper::RecordTemplate kRectTemplate({"x", "y", "width", "height"});
+gin_helper::RecordTemplate kDisplayTemplate({"id",
+                                             "label",
+                                             "bounds",
+                                             "workArea",
+                                             "accelerometerSupport",
+                                             "monochrome",
+                                             "colorDepth",
+                                             "colorSpace",
+                                             "depthPerComponent",
+                                             "size",
+                                             "displayFrequency",
+                                             "workAreaSize",
+                                             "scaleFactor",
+                                             "rotation",
+                                             "internal",
+                                             "touchSupport"});
+
+}  // namespace
+
 v8::Local<v8::Value> Converter<gfx::Point>::ToV8(v8::Isolate* isolate,
                                                  const gfx::Point& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary dict = kPointTemplate.NewRecord(isolate);
   dict.SetHidden("simple", true);
   dict.Set("x", val.x());
   dict.Set("y", val.y());
@@ -40,7 +65,7 @@ bool Converter<gfx::Point>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::PointF>::ToV8(v8::Isolate* isolate,
                                                   const gfx::PointF& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary dict = kPointTemplate.NewRecord(isolate);
   dict.SetHidden("simple", true);
   dict.Set("x", val.x());
   dict.Set("y", val.y());
@@ -62,7 +87,7 @@ bool Converter<gfx::PointF>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::Size>::ToV8(v8::Isolate* isolate,
                                                 const gfx::Size& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary dict = kSizeTemplate.NewRecord(isolate);
   dict.SetHidden("simple", true);
   dict.Set("width", val.width());
   dict.Set("height", val.height());
@@ -84,7 +109,7 @@ bool Converter<gfx::Size>::FromV8(v8::Isolate* isolate,
 
 v8::Local<v8::Value> Converter<gfx::Rect>::ToV8(v8::Isolate* isolate,
                                                 const gfx::Rect& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary dict = kRectTemplate.NewRecord(isolate);
   dict.SetHidden("simple", true);
   dict.Set("x", val.x());
   dict.Set("y", val.y());
@@ -141,7 +166,7 @@ struct Converter<display::Display::TouchSupport> {
 v8::Local<v8::Value> Converter<display::Display>::ToV8(
     v8::Isolate* isolate,
     const display::Display& val) {
-  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary dict = kDisplayTemplate.NewRecord(isolate);
   dict.SetHidden("simple", true);
   dict.Set("id", val.id());
   dict.Set("label", val.label());
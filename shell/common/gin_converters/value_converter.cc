@@ -4,19 +4,96 @@
 
 #include "shell/common/gin_converters/value_converter.h"
 
+#include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "base/no_destructor.h"
 #include "content/public/renderer/v8_value_converter.h"
+#include "v8/include/v8-array-buffer.h"
 
 namespace gin {
 
+namespace {
+
+// The converter only has options, which are never changed, so one instance
+// serves every call.
+content::V8ValueConverter& GetV8ValueConverter() {
+  static base::NoDestructor<std::unique_ptr<content::V8ValueConverter>>
+      converter(content::V8ValueConverter::Create());
+  return **converter;
+}
+
+v8::Local<v8::Value> ToV8Value(v8::Isolate* isolate,
+                               const base::Value& value);
+
+// The values are the same as with content::V8ValueConverter::ToV8Value,
+// without going through its generic path. The keys are internalized up
+// front, as V8 would do when adding them, and the properties are added in
+// order to fresh objects so that objects of the same shape share the
+// transitions to their hidden class.
+v8::Local<v8::Object> ToV8Object(v8::Isolate* isolate,
+                                 const base::Value::Dict& dict) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> object = v8::Object::New(isolate);
+  for (const auto [key, child] : dict) {
+    // Only fails when the isolate is terminating.
+    if (object
+            ->CreateDataProperty(context, gin::StringToSymbol(isolate, key),
+                                 ToV8Value(isolate, child))
+            .IsNothing()) {
+      break;
+    }
+  }
+  return object;
+}
+
+v8::Local<v8::Array> ToV8Array(v8::Isolate* isolate,
+                               const base::Value::List& list) {
+  std::vector<v8::Local<v8::Value>> elements;
+  elements.reserve(list.size());
+  for (const base::Value& child : list)
+    elements.push_back(ToV8Value(isolate, child));
+  return v8::Array::New(isolate, elements.data(), elements.size());
+}
+
+v8::Local<v8::Value> ToV8Value(v8::Isolate* isolate,
+                               const base::Value& value) {
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      return v8::Null(isolate);
+    case base::Value::Type::BOOLEAN:
+      return v8::Boolean::New(isolate, value.GetBool());
+    case base::Value::Type::INTEGER:
+      return v8::Integer::New(isolate, value.GetInt());
+    case base::Value::Type::DOUBLE:
+      return v8::Number::New(isolate, value.GetDouble());
+    case base::Value::Type::STRING:
+      return gin::StringToV8(isolate, value.GetString());
+    case base::Value::Type::BINARY: {
+      const base::Value::BlobStorage& blob = value.GetBlob();
+      v8::Local<v8::ArrayBuffer> buffer =
+          v8::ArrayBuffer::New(isolate, blob.size());
+      if (!blob.empty())
+        memcpy(buffer->Data(), blob.data(), blob.size());
+      return buffer;
+    }
+    case base::Value::Type::DICT:
+      return ToV8Object(isolate, value.GetDict());
+    case base::Value::Type::LIST:
+      return ToV8Array(isolate, value.GetList());
+  }
+  return v8::Null(isolate);
+}
+
+}  // namespace
+
 bool Converter<base::Value::Dict>::FromV8(v8::Isolate* isolate,
                                           v8::Local<v8::Value> val,
                                           base::Value::Dict* out) {
   std::unique_ptr<base::Value> value =
-      content::V8ValueConverter::Create()->FromV8Value(
-          val, isolate->GetCurrentContext());
+      GetV8ValueConverter().FromV8Value(val, isolate->GetCurrentContext());
   if (value && value->is_dict()) {
     *out = std::move(value->GetDict());
     return true;
@@ -25,12 +102,18 @@ bool Converter<base::Value::Dict>::FromV8(v8::Isolate* isolate,
   }
 }
 
+v8::Local<v8::Value> Converter<base::Value::Dict>::ToV8(
+    v8::Isolate* isolate,
+    const base::Value::Dict& val) {
+  v8::EscapableHandleScope handle_scope(isolate);
+  return handle_scope.Escape(ToV8Object(isolate, val));
+}
+
 bool Converter<base::Value>::FromV8(v8::Isolate* isolate,
                                     v8::Local<v8::Value> val,
                                     base::Value* out) {
   std::unique_ptr<base::Value> value =
-      content::V8ValueConverter::Create()->FromV8Value(
-          val, isolate->GetCurrentContext());
+      GetV8ValueConverter().FromV8Value(val, isolate->GetCurrentContext());
   if (value) {
     *out = std::move(*value);
     return true;
@@ -39,19 +122,23 @@ bool Converter<base::Value>::FromV8(v8::Isolate* isolate,
   }
 }
 
+v8::Local<v8::Value> Converter<base::Value>::ToV8(v8::Isolate* isolate,
+                                                  const base::Value& val) {
+  v8::EscapableHandleScope handle_scope(isolate);
+  return handle_scope.Escape(ToV8Value(isolate, val));
+}
+
 v8::Local<v8::Value> Converter<base::ValueView>::ToV8(
     v8::Isolate* isolate,
     const base::ValueView val) {
-  return content::V8ValueConverter::Create()->ToV8Value(
-      val, isolate->GetCurrentContext());
+  return GetV8ValueConverter().ToV8Value(val, isolate->GetCurrentContext());
 }
 
 bool Converter<base::Value::List>::FromV8(v8::Isolate* isolate,
                                           v8::Local<v8::Value> val,
                                           base::Value::List* out) {
   std::unique_ptr<base::Value> value =
-      content::V8ValueConverter::Create()->FromV8Value(
-          val, isolate->GetCurrentContext());
+      GetV8ValueConverter().FromV8Value(val, isolate->GetCurrentContext());
   if (value && value->is_list()) {
     *out = std::move(value->GetList());
     return true;
@@ -60,4 +147,11 @@ bool Converter<base::Value::List>::FromV8(v8::Isolate* isolate,
   }
 }
 
+v8::Local<v8::Value> Converter<base::Value::List>::ToV8(
+    v8::Isolate* isolate,
+    const base::Value::List& val) {
+  v8::EscapableHandleScope handle_scope(isolate);
+  return handle_scope.Escape(ToV8Array(isolate, val));
+}
+
 }  // namespace gin
@@ -22,9 +22,7 @@ struct Converter<base::Value::Dict> {
                      v8::Local<v8::Value> val,
                      base::Value::Dict* out);
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
-                                   const base::Value::Dict& val) {
-    return gin::ConvertToV8(isolate, base::ValueView{val});
-  }
+                                   const base::Value::Dict& val);
 };
 
 template <>
@@ -33,9 +31,7 @@ struct Converter<base::Value> {
                      v8::Local<v8::Value> val,
                      base::Value* out);
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
-                                   const base::Value& val) {
-    return gin::ConvertToV8(isolate, base::ValueView{val});
-  }
+                                   const base::Value& val);
 };
 
 template <>
@@ -44,9 +40,7 @@ struct Converter<base::Value::List> {
                      v8::Local<v8::Value> val,
                      base::Value::List* out);
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
-                                   const base::Value::List& val) {
-    return gin::ConvertToV8(isolate, base::ValueView{val});
-  }
+                                   const base::Value::List& val);
 };
 
 }  // namespace gin
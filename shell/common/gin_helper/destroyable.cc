@@ -7,6 +7,7 @@
 #include "base/no_destructor.h"
 #include "gin/converter.h"
 #include "shell/common/gin_helper/wrappable_base.h"
+#include "v8/include/v8-fast-api-calls.h"
 
 namespace gin_helper {
 
@@ -38,6 +39,12 @@ void IsDestroyedFunc(const v8::FunctionCallbackInfo<v8::Value>& info) {
       info.GetIsolate(), Destroyable::IsDestroyed(info.Holder())));
 }
 
+// Called instead of IsDestroyedFunc by optimized code, as it is checked
+// before most calls to destroyable objects.
+bool FastIsDestroyed(v8::Local<v8::Object> receiver) {
+  return Destroyable::IsDestroyed(receiver);
+}
+
 }  // namespace
 
 // static
@@ -51,23 +58,36 @@ bool Destroyable::IsDestroyed(v8::Local<v8::Object> object) {
 // static
 void Destroyable::MakeDestroyable(v8::Isolate* isolate,
                                   v8::Local<v8::FunctionTemplate> prototype) {
-  // Cache the FunctionTemplate of "destroy" and "isDestroyed".
+  // Cache the FunctionTemplate of "destroy".
   if (GetDestroyFunc()->IsEmpty()) {
     auto templ = v8::FunctionTemplate::New(isolate, DestroyFunc);
     templ->RemovePrototype();
     GetDestroyFunc()->Reset(isolate, templ);
-    templ = v8::FunctionTemplate::New(isolate, IsDestroyedFunc);
-    templ->RemovePrototype();
-    GetIsDestroyedFunc()->Reset(isolate, templ);
   }
 
   auto proto_templ = prototype->PrototypeTemplate();
   proto_templ->Set(
       gin::StringToSymbol(isolate, "destroy"),
       v8::Local<v8::FunctionTemplate>::New(isolate, *GetDestroyFunc()));
-  proto_templ->Set(
-      gin::StringToSymbol(isolate, "isDestroyed"),
-      v8::Local<v8::FunctionTemplate>::New(isolate, *GetIsDestroyedFunc()));
+  proto_templ->Set(gin::StringToSymbol(isolate, "isDestroyed"),
+                   GetIsDestroyedTemplate(isolate));
+}
+
+// static
+v8::Local<v8::FunctionTemplate> Destroyable::GetIsDestroyedTemplate(
+    v8::Isolate* isolate) {
+  // Cache the FunctionTemplate of "isDestroyed".
+  if (GetIsDestroyedFunc()->IsEmpty()) {
+    static const v8::CFunction c_function =
+        v8::CFunction::Make(&FastIsDestroyed);
+    auto templ = v8::FunctionTemplate::New(
+        isolate, IsDestroyedFunc, v8::Local<v8::Value>(),
+        v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+        v8::SideEffectType::kHasNoSideEffect, &c_function);
+    templ->RemovePrototype();
+    GetIsDestroyedFunc()->Reset(isolate, templ);
+  }
+  return v8::Local<v8::FunctionTemplate>::New(isolate, *GetIsDestroyedFunc());
 }
 
 }  // namespace gin_helper
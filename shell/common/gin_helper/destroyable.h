@@ -17,6 +17,11 @@ struct Destroyable {
   // Add "destroy" and "isDestroyed" to prototype chain.
   static void MakeDestroyable(v8::Isolate* isolate,
                               v8::Local<v8::FunctionTemplate> prototype);
+
+  // Returns the template of "isDestroyed", for objects which are destroyed
+  // in another way than with "destroy".
+  static v8::Local<v8::FunctionTemplate> GetIsDestroyedTemplate(
+      v8::Isolate* isolate);
 };
 
 }  // namespace gin_helper
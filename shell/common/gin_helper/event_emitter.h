@@ -11,6 +11,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/handle.h"
+#include "shell/browser/api/electron_api_event_emitter.h"
 #include "shell/common/gin_helper/event.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/wrappable.h"
@@ -41,7 +42,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
   bool Emit(base::StringPiece name, Args&&... args) {
     v8::HandleScope handle_scope(isolate());
     v8::Local<v8::Object> wrapper = GetWrapper();
-    if (wrapper.IsEmpty())
+    if (wrapper.IsEmpty() ||
+        !electron::ShouldEmitEvent(isolate(), wrapper, name))
       return false;
     gin::Handle<gin_helper::internal::Event> event =
         internal::Event::New(isolate());
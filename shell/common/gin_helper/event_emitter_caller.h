@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/trace_event/trace_event.h"
 #include "gin/converter.h"
 #include "gin/wrappable.h"
 
@@ -31,6 +32,7 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                const internal::ValueVector& args) {
+  TRACE_EVENT1("electron", "gin_helper::EmitEvent", "name", name);
   internal::ValueVector concatenated_args = {gin::StringToV8(isolate, name)};
   concatenated_args.reserve(1 + args.size());
   concatenated_args.insert(concatenated_args.end(), args.begin(), args.end());
@@ -44,6 +46,8 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                Args&&... args) {
+  // Includes the conversion of the arguments.
+  TRACE_EVENT1("electron", "gin_helper::EmitEvent", "name", name);
   internal::ValueVector converted_args = {
       gin::StringToV8(isolate, name),
       gin::ConvertToV8(isolate, std::forward<Args>(args))...,
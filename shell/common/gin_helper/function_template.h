@@ -16,10 +16,12 @@
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
+#include "v8/include/v8-fast-api-calls.h"
 
-// This file is forked from gin/function_template.h with 2 differences:
+// This file is forked from gin/function_template.h with 3 differences:
 // 1. Support for additional types of arguments.
 // 2. Support for warning using destroyed objects.
+// 3. Support for V8 Fast API calls.
 //
 // TODO(zcbenz): We should seek to remove this file after removing native_mate.
 
@@ -280,18 +282,79 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
 // internal reasons, thus it is generally a good idea to cache the template
 // returned by this function.  Otherwise, repeated method invocations from JS
 // will create substantial memory leaks. See http://crbug.com/463487.
+//
+// When |c_function| is given, optimized code calls it directly instead of
+// the callback, see FastMethodTraits.
 template <typename Sig>
 v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
     v8::Isolate* isolate,
     const base::RepeatingCallback<Sig> callback,
-    int callback_flags = 0) {
+    int callback_flags = 0,
+    const v8::CFunction* c_function = nullptr) {
   typedef CallbackHolder<Sig> HolderT;
   HolderT* holder = new HolderT(isolate, callback, callback_flags);
 
-  return v8::FunctionTemplate::New(isolate,
-                                   &Dispatcher<Sig>::DispatchToCallback,
-                                   gin::ConvertToV8<v8::Local<v8::External>>(
-                                       isolate, holder->GetHandle(isolate)));
+  return v8::FunctionTemplate::New(
+      isolate, &Dispatcher<Sig>::DispatchToCallback,
+      gin::ConvertToV8<v8::Local<v8::External>>(isolate,
+                                                holder->GetHandle(isolate)),
+      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+      v8::SideEffectType::kHasSideEffect, c_function);
+}
+
+// Generates the V8 Fast API implementation of the member function |kMethod|,
+// which optimized code calls without going through gin::Arguments. The
+// method may only take and return primitives, and must neither call into
+// JavaScript nor allocate on the V8 heap. When the receiver is destroyed or
+// of the wrong type the call falls back to the regular callback, which
+// throws.
+template <typename T, T kMethod>
+struct FastMethodTraits {};
+
+template <typename C,
+          typename R,
+          typename... Args,
+          R (C::*kMethod)(Args...) const>
+struct FastMethodTraits<R (C::*)(Args...) const, kMethod> {
+  static R Call(v8::Local<v8::Object> receiver,
+                Args... args,
+                v8::FastApiCallbackOptions& options) {
+    C* self = nullptr;
+    if (Destroyable::IsDestroyed(receiver) ||
+        !gin::ConvertFromV8(v8::Isolate::GetCurrent(), receiver, &self) ||
+        !self) {
+      options.fallback = true;
+      return R();
+    }
+    return (self->*kMethod)(args...);
+  }
+};
+
+template <typename C, typename R, typename... Args, R (C::*kMethod)(Args...)>
+struct FastMethodTraits<R (C::*)(Args...), kMethod> {
+  static R Call(v8::Local<v8::Object> receiver,
+                Args... args,
+                v8::FastApiCallbackOptions& options) {
+    C* self = nullptr;
+    if (Destroyable::IsDestroyed(receiver) ||
+        !gin::ConvertFromV8(v8::Isolate::GetCurrent(), receiver, &self) ||
+        !self) {
+      options.fallback = true;
+      return R();
+    }
+    return (self->*kMethod)(args...);
+  }
+};
+
+// Creates the template of the member function |kMethod| with both the
+// regular callback and the Fast API one.
+template <auto kMethod>
+v8::Local<v8::FunctionTemplate> CreateFastFunctionTemplate(
+    v8::Isolate* isolate) {
+  static const v8::CFunction c_function = v8::CFunction::Make(
+      &FastMethodTraits<decltype(kMethod), kMethod>::Call);
+  return CreateFunctionTemplate(isolate, base::BindRepeating(kMethod),
+                                HolderIsFirstArgument, &c_function);
 }
 
 // Base template - used only for non-member function pointers. Other types
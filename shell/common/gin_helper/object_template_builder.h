@@ -41,6 +41,13 @@ class ObjectTemplateBuilder {
                                    const T& callback) {
     return SetImpl(name, CallbackTraits<T>::CreateTemplate(isolate_, callback));
   }
+  // Like SetMethod(), for a member function |kMethod| that optimized code can
+  // call through the V8 Fast API. See gin_helper::FastMethodTraits for what
+  // the method is allowed to do.
+  template <auto kMethod>
+  ObjectTemplateBuilder& SetFastMethod(const base::StringPiece& name) {
+    return SetImpl(name, CreateFastFunctionTemplate<kMethod>(isolate_));
+  }
   template <typename T>
   ObjectTemplateBuilder& SetProperty(const base::StringPiece& name,
                                      const T& getter) {
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_RECORD_H_
+#define ELECTRON_SHELL_COMMON_GIN_HELPER_RECORD_H_
+
+#include <array>
+#include <cstddef>
+
+#include "gin/per_isolate_data.h"
+#include "gin/public/wrapper_info.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "v8/include/v8-template.h"
+
+namespace gin_helper {
+
+// Declares the fields of objects which are returned to JavaScript often with
+// the same shape, so that they are instantiated from an ObjectTemplate which
+// has all the fields, instead of going through a hidden class transition for
+// each field that is set:
+//
+//   gin_helper::RecordTemplate kPointTemplate({"x", "y"});
+//
+//   gin_helper::Dictionary point = kPointTemplate.NewRecord(isolate);
+//   point.Set("x", 1);
+//   point.Set("y", 2);
+//
+// The fields which aren't set stay undefined, those which are only there
+// sometimes should be left out and set as usual. Templates are declared at
+// namespace scope, the ObjectTemplate is created once per isolate.
+template <size_t N>
+class RecordTemplate {
+ public:
+  constexpr explicit RecordTemplate(const char* const (&fields)[N]) {
+    for (size_t i = 0; i < N; ++i)
+      fields_[i] = fields[i];
+  }
+
+  // disable copy
+  RecordTemplate(const RecordTemplate&) = delete;
+  RecordTemplate& operator=(const RecordTemplate&) = delete;
+
+  Dictionary NewRecord(v8::Isolate* isolate) {
+    v8::Local<v8::Object> object;
+    if (!GetObjectTemplate(isolate)
+             ->NewInstance(isolate->GetCurrentContext())
+             .ToLocal(&object)) {
+      return gin::Dictionary::CreateEmpty(isolate);
+    }
+    return Dictionary(isolate, object);
+  }
+
+ private:
+  v8::Local<v8::ObjectTemplate> GetObjectTemplate(v8::Isolate* isolate) {
+    gin::PerIsolateData* data = gin::PerIsolateData::From(isolate);
+    v8::Local<v8::ObjectTemplate> object_template =
+        data->GetObjectTemplate(&wrapper_info_);
+    if (object_template.IsEmpty()) {
+      object_template = v8::ObjectTemplate::New(isolate);
+      for (const char* field : fields_) {
+        object_template->Set(gin::StringToSymbol(isolate, field),
+                             v8::Undefined(isolate));
+      }
+      data->SetObjectTemplate(&wrapper_info_, object_template);
+    }
+    return object_template;
+  }
+
+  std::array<const char*, N> fields_ = {};
+  // Only the key of the template in gin::PerIsolateData.
+  gin::WrapperInfo wrapper_info_ = {gin::kEmbedderNativeGin};
+};
+
+}  // namespace gin_helper
+
+#endif  // ELECTRON_SHELL_COMMON_GIN_HELPER_RECORD_H_
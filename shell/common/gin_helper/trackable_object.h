@@ -7,11 +7,11 @@
 
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/event_emitter.h"
-#include "shell/common/key_weak_map.h"
 
 namespace base {
 class SupportsUserData;
@@ -53,6 +53,12 @@ class TrackableObjectBase : public CleanedUpAtExit {
 
 // All instances of TrackableObject will be kept in a weak map and can be got
 // from its ID.
+//
+// The map holds the native objects rather than weak handles to their
+// wrappers: an object removes itself from it when destroyed, which the GC of
+// its wrapper leads to, so no weak callback of its own is needed. IDs are
+// never reused and only grow, so the map is kept sorted by appending to it,
+// and enumerating it walks contiguous memory.
 template <typename T>
 class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
  public:
@@ -78,13 +84,19 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
     if (!weak_map_)
       return nullptr;
 
+    auto iter = weak_map_->find(id);
+    if (iter == weak_map_->end())
+      return nullptr;
+
+    // The wrapper may have been collected already, or the object marked as
+    // destroyed.
     v8::HandleScope scope(isolate);
-    v8::MaybeLocal<v8::Object> object = weak_map_->Get(isolate, id);
-    if (object.IsEmpty())
+    v8::Local<v8::Object> wrapper = iter->second->GetWrapper();
+    if (wrapper.IsEmpty())
       return nullptr;
 
     T* self = nullptr;
-    gin::ConvertFromV8(isolate, object.ToLocalChecked(), &self);
+    gin::ConvertFromV8(isolate, wrapper, &self);
     return self;
   }
 
@@ -99,16 +111,23 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
 
   // Returns all objects in this class's weak map.
   static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+    std::vector<v8::Local<v8::Object>> objects;
+    if (!weak_map_)
+      return objects;
+
+    objects.reserve(weak_map_->size());
+    for (const auto& [id, object] : *weak_map_) {
+      v8::Local<v8::Object> wrapper = object->GetWrapper();
+      if (!wrapper.IsEmpty())
+        objects.push_back(wrapper);
+    }
+    return objects;
   }
 
   // Removes this instance from the weak map.
   void RemoveFromWeakMap() {
-    if (weak_map_ && weak_map_->Has(weak_map_id()))
-      weak_map_->Remove(weak_map_id());
+    if (weak_map_)
+      weak_map_->erase(weak_map_id());
   }
 
  protected:
@@ -118,22 +137,25 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
 
   void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
     if (!weak_map_) {
-      weak_map_ = new electron::KeyWeakMap<int32_t>;
+      weak_map_ = new base::flat_map<int32_t, TrackableObject*>;
     }
-    weak_map_->Set(isolate, weak_map_id_, wrapper);
+    // |weak_map_id_| is the largest ID so far, appending keeps the map sorted.
+    weak_map_->emplace_hint(weak_map_->end(), weak_map_id_, this);
     gin_helper::WrappableBase::InitWith(isolate, wrapper);
   }
 
  private:
   static int32_t next_id_;
-  static electron::KeyWeakMap<int32_t>* weak_map_;  // leaked on purpose
+  static base::flat_map<int32_t, TrackableObject*>*
+      weak_map_;  // leaked on purpose
 };
 
 template <typename T>
 int32_t TrackableObject<T>::next_id_ = 0;
 
 template <typename T>
-electron::KeyWeakMap<int32_t>* TrackableObject<T>::weak_map_ = nullptr;
+base::flat_map<int32_t, TrackableObject<T>*>* TrackableObject<T>::weak_map_ =
+    nullptr;
 
 }  // namespace gin_helper
 
@@ -4,17 +4,130 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "base/files/file.h"
 #include "base/memory/raw_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 #include "v8/include/v8.h"
 
 namespace {
 
-class HeapSnapshotOutputStream : public v8::OutputStream {
+// Writes are batched into blocks of this size, which keeps the number of
+// syscalls (and progress notifications) low on multi-GB snapshots.
+constexpr size_t kBlockSize = 1024 * 1024;
+
+// Streams the snapshot to the file, optionally through gzip, so that the
+// whole serialized snapshot never has to be held in memory.
+class SnapshotWriter {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
+  SnapshotWriter(base::File* file, const electron::HeapSnapshotOptions& options)
+      : file_(file), options_(options), block_(kBlockSize) {
     DCHECK(file_);
+    if (options_.gzip) {
+      // The fastest level, the snapshot is written while the heap can't
+      // change and the JSON compresses well anyway.
+      gzip_ = deflateInit2(&stream_, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16,
+                           8, Z_DEFAULT_STRATEGY) == Z_OK;
+      failed_ = !gzip_;
+    }
+  }
+
+  ~SnapshotWriter() {
+    if (gzip_)
+      deflateEnd(&stream_);
+  }
+
+  // disable copy
+  SnapshotWriter(const SnapshotWriter&) = delete;
+  SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+  bool Write(const char* data, size_t size) {
+    if (failed_)
+      return false;
+    if (gzip_)
+      return Deflate(data, size, Z_NO_FLUSH);
+    while (size > 0) {
+      size_t count = std::min(size, block_.size() - used_);
+      memcpy(block_.data() + used_, data, count);
+      used_ += count;
+      data += count;
+      size -= count;
+      if (used_ == block_.size() && !Flush())
+        return false;
+    }
+    return true;
+  }
+
+  bool Finish() {
+    if (failed_)
+      return false;
+    if (gzip_ && !Deflate(nullptr, 0, Z_FINISH))
+      return false;
+    return Flush();
+  }
+
+ private:
+  bool Deflate(const char* data, size_t size, int flush) {
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream_.avail_in = static_cast<uInt>(size);
+    while (true) {
+      stream_.next_out = reinterpret_cast<Bytef*>(block_.data() + used_);
+      stream_.avail_out = static_cast<uInt>(block_.size() - used_);
+      int result = deflate(&stream_, flush);
+      if (result == Z_STREAM_ERROR) {
+        failed_ = true;
+        return false;
+      }
+      used_ = block_.size() - stream_.avail_out;
+      if (used_ == block_.size() && !Flush())
+        return false;
+      if (result == Z_STREAM_END)
+        return true;
+      // Without Z_FINISH deflate() keeps whatever doesn't fit in the block
+      // and emits it on the next call.
+      if (flush != Z_FINISH && stream_.avail_in == 0)
+        return true;
+    }
+  }
+
+  bool Flush() {
+    if (used_ == 0)
+      return true;
+    if (file_->WriteAtCurrentPos(block_.data(), used_) !=
+        static_cast<int>(used_)) {
+      failed_ = true;
+      return false;
+    }
+    bytes_written_ += used_;
+    used_ = 0;
+    if (options_.on_write)
+      options_.on_write.Run(bytes_written_);
+    return true;
+  }
+
+  raw_ptr<base::File> file_;
+  const electron::HeapSnapshotOptions& options_;
+  std::vector<char> block_;
+  size_t used_ = 0;
+  uint64_t bytes_written_ = 0;
+  z_stream stream_ = {};
+  bool gzip_ = false;
+  bool failed_ = false;
+};
+
+class HeapSnapshotOutputStream : public v8::OutputStream {
+ public:
+  explicit HeapSnapshotOutputStream(SnapshotWriter* writer) : writer_(writer) {
+    DCHECK(writer_);
   }
 
   bool IsComplete() const { return is_complete_; }
@@ -24,36 +137,239 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   void EndOfStream() override { is_complete_ = true; }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    return writer_->Write(data, size) ? kContinue : kAbort;
   }
 
  private:
-  raw_ptr<base::File> file_ = nullptr;
+  raw_ptr<SnapshotWriter> writer_ = nullptr;
   bool is_complete_ = false;
 };
 
+class ProgressControl : public v8::ActivityControl {
+ public:
+  explicit ProgressControl(
+      const base::RepeatingCallback<void(uint32_t, uint32_t)>& on_capture)
+      : on_capture_(on_capture) {}
+
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(uint32_t done, uint32_t total) override {
+    on_capture_.Run(done, total);
+    return kContinue;
+  }
+
+ private:
+  const base::RepeatingCallback<void(uint32_t, uint32_t)>& on_capture_;
+};
+
+// Writes the snapshot in the same format as v8::HeapSnapshot::Serialize(),
+// which DevTools can load, with every name replaced by the empty string.
+// Only the names of synthetic nodes like "(GC roots)" are kept, DevTools
+// relies on them and they don't come from the page.
+class GraphOnlySerializer {
+ public:
+  GraphOnlySerializer(v8::Isolate* isolate,
+                      const v8::HeapSnapshot* snapshot,
+                      SnapshotWriter* writer)
+      : isolate_(isolate), snapshot_(snapshot), writer_(writer) {}
+
+  // disable copy
+  GraphOnlySerializer(const GraphOnlySerializer&) = delete;
+  GraphOnlySerializer& operator=(const GraphOnlySerializer&) = delete;
+
+  bool Serialize() {
+    const int node_count = snapshot_->GetNodesCount();
+    std::unordered_map<const v8::HeapGraphNode*, int> node_indices;
+    node_indices.reserve(node_count);
+    size_t edge_count = 0;
+    for (int i = 0; i < node_count; ++i) {
+      const v8::HeapGraphNode* node = snapshot_->GetNode(i);
+      node_indices.emplace(node, i);
+      edge_count += node->GetChildrenCount();
+    }
+
+    Append(
+        "{\"snapshot\":{\"meta\":{"
+        "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\","
+        "\"edge_count\",\"trace_node_id\",\"detachedness\"],"
+        "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\","
+        "\"code\",\"closure\",\"regexp\",\"number\",\"native\","
+        "\"synthetic\",\"concatenated string\",\"sliced string\","
+        "\"symbol\",\"bigint\",\"object shape\"],\"string\",\"number\","
+        "\"number\",\"number\",\"number\",\"number\"],"
+        "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+        "\"edge_types\":[[\"context\",\"element\",\"property\","
+        "\"internal\",\"hidden\",\"shortcut\",\"weak\"],"
+        "\"string_or_number\",\"node\"],"
+        "\"trace_function_info_fields\":[\"function_id\",\"name\","
+        "\"script_name\",\"script_id\",\"line\",\"column\"],"
+        "\"trace_node_fields\":[\"id\",\"function_info_index\",\"count\","
+        "\"size\",\"children\"],"
+        "\"sample_fields\":[\"timestamp_us\",\"last_assigned_id\"],"
+        "\"location_fields\":[\"object_index\",\"script_id\",\"line\","
+        "\"column\"]},\"node_count\":");
+    AppendNumber(node_count);
+    Append(",\"edge_count\":");
+    AppendNumber(edge_count);
+    Append(",\"trace_function_count\":0},\n\"nodes\":[");
+
+    for (int i = 0; i < node_count; ++i) {
+      v8::HandleScope scope(isolate_);
+      const v8::HeapGraphNode* node = snapshot_->GetNode(i);
+      if (i > 0)
+        Append(",");
+      AppendNumber(node->GetType());
+      Append(",");
+      AppendNumber(node->GetType() == v8::HeapGraphNode::kSynthetic
+                       ? GetStringIndex(node->GetName())
+                       : 0);
+      Append(",");
+      AppendNumber(node->GetId());
+      Append(",");
+      AppendNumber(node->GetShallowSize());
+      Append(",");
+      AppendNumber(node->GetChildrenCount());
+      Append(",0,0");
+      if (!FlushIfFull())
+        return false;
+    }
+
+    Append("],\n\"edges\":[");
+    bool first = true;
+    for (int i = 0; i < node_count; ++i) {
+      v8::HandleScope scope(isolate_);
+      const v8::HeapGraphNode* node = snapshot_->GetNode(i);
+      for (int j = 0; j < node->GetChildrenCount(); ++j) {
+        const v8::HeapGraphEdge* edge = node->GetChild(j);
+        if (!first)
+          Append(",");
+        first = false;
+        AppendNumber(edge->GetType());
+        Append(",");
+        // Element and hidden edges are named by their index, which isn't
+        // anything from the page.
+        const bool indexed = edge->GetType() == v8::HeapGraphEdge::kElement ||
+                             edge->GetType() == v8::HeapGraphEdge::kHidden;
+        v8::Local<v8::Value> name = edge->GetName();
+        uint32_t index = 0;
+        if (indexed && name->IsUint32())
+          index = name.As<v8::Uint32>()->Value();
+        AppendNumber(index);
+        Append(",");
+        AppendNumber(node_indices.at(edge->GetToNode()) * kNodeFieldCount);
+        if (!FlushIfFull())
+          return false;
+      }
+    }
+
+    Append(
+        "],\n\"trace_function_infos\":[],\n\"trace_tree\":[],\n"
+        "\"samples\":[],\n\"locations\":[],\n\"strings\":[");
+    for (size_t i = 0; i < strings_.size(); ++i) {
+      if (i > 0)
+        Append(",\n");
+      AppendString(strings_[i]);
+    }
+    Append("]}");
+    return writer_->Write(buffer_.data(), buffer_.size());
+  }
+
+ private:
+  static constexpr int kNodeFieldCount = 7;
+
+  void Append(const char* data) { buffer_.append(data); }
+
+  template <typename T>
+  void AppendNumber(T value) {
+    buffer_.append(base::NumberToString(value));
+  }
+
+  // Synthetic node names are plain ASCII like "(GC roots)", escaping them
+  // like JSON.stringify() would is still cheap.
+  void AppendString(const std::string& value) {
+    buffer_.push_back('"');
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        buffer_.push_back('\\');
+        buffer_.push_back(c);
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        buffer_.push_back(' ');
+      } else {
+        buffer_.push_back(c);
+      }
+    }
+    buffer_.push_back('"');
+  }
+
+  int GetStringIndex(v8::Local<v8::String> name) {
+    std::string value(*v8::String::Utf8Value(isolate_, name));
+    auto it = string_indices_.find(value);
+    if (it != string_indices_.end())
+      return it->second;
+    strings_.push_back(value);
+    return string_indices_.emplace(value, strings_.size() - 1).first->second;
+  }
+
+  bool FlushIfFull() {
+    if (buffer_.size() < kBlockSize)
+      return true;
+    bool result = writer_->Write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+    return result;
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  const v8::HeapSnapshot* snapshot_;
+  raw_ptr<SnapshotWriter> writer_;
+  std::string buffer_;
+  // Index 0 is the name given to everything else.
+  std::vector<std::string> strings_ = {""};
+  std::unordered_map<std::string, int> string_indices_ = {{"", 0}};
+};
+
 }  // namespace
 
 namespace electron {
 
+HeapSnapshotOptions::HeapSnapshotOptions() = default;
+HeapSnapshotOptions::HeapSnapshotOptions(const HeapSnapshotOptions&) = default;
+HeapSnapshotOptions::~HeapSnapshotOptions() = default;
+
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
+  return TakeHeapSnapshot(isolate, file, HeapSnapshotOptions());
+}
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options) {
+  TRACE_EVENT2("electron", "TakeHeapSnapshot", "gzip", options.gzip,
+               "graph_only", options.graph_only);
   DCHECK(isolate);
   DCHECK(file);
 
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  std::unique_ptr<ProgressControl> control;
+  if (options.on_capture)
+    control = std::make_unique<ProgressControl>(options.on_capture);
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(control.get());
   if (!snapshot)
     return false;
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  SnapshotWriter writer(file, options);
+  bool success;
+  if (options.graph_only) {
+    success = GraphOnlySerializer(isolate, snapshot, &writer).Serialize();
+  } else {
+    HeapSnapshotOutputStream stream(&writer);
+    snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+    success = stream.IsComplete();
+  }
+  success = success && writer.Finish();
 
   const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
 
-  return stream.IsComplete();
+  return success;
 }
 
 }  // namespace electron
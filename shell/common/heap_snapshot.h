@@ -5,6 +5,10 @@
 #ifndef ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <cstdint>
+
+#include "base/functional/callback.h"
+
 namespace base {
 class File;
 }
@@ -15,7 +19,27 @@ class Isolate;
 
 namespace electron {
 
+struct HeapSnapshotOptions {
+  HeapSnapshotOptions();
+  HeapSnapshotOptions(const HeapSnapshotOptions&);
+  ~HeapSnapshotOptions();
+
+  // Compresses the snapshot with gzip while it is written.
+  bool gzip = false;
+  // Leaves out the names of objects and properties, including the contents
+  // of strings, only keeping the shape of the graph and the object sizes.
+  bool graph_only = false;
+  // Run while the heap is walked, with the number of objects done so far
+  // and V8's estimate of the total.
+  base::RepeatingCallback<void(uint32_t done, uint32_t total)> on_capture;
+  // Run each time a block of the output has been written to the file.
+  base::RepeatingCallback<void(uint64_t bytes_written)> on_write;
+};
+
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options);
 
 }  // namespace electron
 
@@ -0,0 +1,38 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/javascript_stack.h"
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "gin/converter.h"
+#include "v8/include/v8-debug.h"
+#include "v8/include/v8-local-handle.h"
+#include "v8/include/v8-primitive.h"
+
+namespace electron {
+
+std::string CaptureJavaScriptStack(v8::Isolate* isolate, int max_frames) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> trace =
+      v8::StackTrace::CurrentStackTrace(isolate, max_frames);
+  std::string stack;
+  for (int i = 0; i < trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, i);
+    std::string function, script;
+    v8::Local<v8::String> name = frame->GetFunctionName();
+    if (!name.IsEmpty())
+      gin::ConvertFromV8(isolate, name, &function);
+    v8::Local<v8::String> script_name = frame->GetScriptName();
+    if (!script_name.IsEmpty())
+      gin::ConvertFromV8(isolate, script_name, &script);
+    base::StrAppend(
+        &stack, {"    at ", function.empty() ? "<anonymous>" : function, " (",
+                 script, ":", base::NumberToString(frame->GetLineNumber()),
+                 ":", base::NumberToString(frame->GetColumn()), ")\n"});
+  }
+  return stack;
+}
+
+}  // namespace electron
@@ -0,0 +1,23 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
+#define ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
+
+#include <string>
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron {
+
+// The stack of the JavaScript running on |isolate|, one "    at" line per
+// frame like Error.prototype.stack without the message. Empty when no
+// JavaScript is running.
+std::string CaptureJavaScriptStack(v8::Isolate* isolate, int max_frames = 32);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
@@ -15,9 +15,12 @@
 #include "base/environment.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/current_thread.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/task_observer.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/content_paths.h"
@@ -34,6 +37,7 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_initializer.h"  // nogncheck
 #include "third_party/electron_node/src/debug_utils.h"
 
@@ -45,11 +49,13 @@
   V(electron_browser_app)                \
   V(electron_browser_auto_updater)       \
   V(electron_browser_browser_view)       \
+  V(electron_browser_capture_group)      \
   V(electron_browser_content_tracing)    \
   V(electron_browser_crash_reporter)     \
   V(electron_browser_desktop_capturer)   \
   V(electron_browser_dialog)             \
   V(electron_browser_event_emitter)      \
+  V(electron_browser_file_watcher)       \
   V(electron_browser_global_shortcut)    \
   V(electron_browser_in_app_purchase)    \
   V(electron_browser_menu)               \
@@ -332,18 +338,64 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
   uv_loop_configure(uv_loop_, UV_LOOP_INTERRUPT_ON_IO_CHANGE);
 }
 
+// Adds up the time spent in the tasks of the thread, leaving out the runs of
+// the loop in them, which are counted as uv time.
+class NodeBindings::TaskTimeObserver : public base::TaskObserver {
+ public:
+  explicit TaskTimeObserver(UvLoopMetrics* metrics) : metrics_(metrics) {
+    base::CurrentThread::Get()->AddTaskObserver(this);
+  }
+  ~TaskTimeObserver() override {
+    if (base::CurrentThread::IsSet())
+      base::CurrentThread::Get()->RemoveTaskObserver(this);
+  }
+
+  // disable copy
+  TaskTimeObserver(const TaskTimeObserver&) = delete;
+  TaskTimeObserver& operator=(const TaskTimeObserver&) = delete;
+
+  void AddUvTime(base::TimeDelta uv_time) {
+    if (depth_ > 0)
+      uv_time_in_task_ += uv_time;
+  }
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override {
+    // Tasks of nested run loops are part of the outermost one.
+    if (depth_++ > 0)
+      return;
+    task_start_ = base::TimeTicks::Now();
+    uv_time_in_task_ = base::TimeDelta();
+  }
+  void DidProcessTask(const base::PendingTask& pending_task) override {
+    if (--depth_ > 0)
+      return;
+    metrics_->task_time +=
+        base::TimeTicks::Now() - task_start_ - uv_time_in_task_;
+  }
+
+ private:
+  raw_ptr<UvLoopMetrics> metrics_;
+  int depth_ = 0;
+  base::TimeTicks task_start_;
+  base::TimeDelta uv_time_in_task_;
+};
+
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  if (!shared_polling_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
 
-  WakeupEmbedThread();
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
 
-  // Clear uv.
-  uv_sem_destroy(&embed_sem_);
+    // Clear uv.
+    uv_sem_destroy(&embed_sem_);
+  }
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -478,6 +530,7 @@ node::Environment* NodeBindings::CreateEnvironment(
     node::MultiIsolatePlatform* platform,
     std::vector<std::string> args,
     std::vector<std::string> exec_args) {
+  TRACE_EVENT0("electron", "NodeBindings::CreateEnvironment");
   // Feed node the path to initialization script.
   std::string process_type;
   switch (browser_env_) {
@@ -611,9 +664,11 @@ node::Environment* NodeBindings::CreateEnvironment(
 
     // Isolate message listeners are additive (you can add multiple), so instead
     // we add an extra one here to ensure that the async hook stack is properly
-    // cleared when errors are thrown.
-    context->GetIsolate()->AddMessageListenerWithErrorLevel(
-        ErrorMessageListener, v8::Isolate::kMessageError);
+    // cleared when errors are thrown. Only once per isolate though, a renderer
+    // creates an environment for every frame with Node.js.
+    if (!isolate_set_up_)
+      context->GetIsolate()->AddMessageListenerWithErrorLevel(
+          ErrorMessageListener, v8::Isolate::kMessageError);
 
     // We do not want to use the promise rejection callback that Node.js uses,
     // because it does not send PromiseRejectionEvents to the global script
@@ -629,7 +684,11 @@ node::Environment* NodeBindings::CreateEnvironment(
         node::IsolateSettingsFlags::SHOULD_NOT_SET_PREPARE_STACK_TRACE_CALLBACK;
   }
 
-  node::SetIsolateUpForNode(context->GetIsolate(), is);
+  // The settings are the same for every environment of the isolate.
+  if (!isolate_set_up_) {
+    isolate_set_up_ = true;
+    node::SetIsolateUpForNode(context->GetIsolate(), is);
+  }
 
   gin_helper::Dictionary process(context->GetIsolate(), env->process_object());
   process.SetReadOnly("type", process_type);
@@ -657,6 +716,7 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  TRACE_EVENT0("electron", "NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env, node::StartExecutionCallback{});
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -675,6 +735,11 @@ void NodeBindings::PrepareEmbedThread() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  if (StartSharedPolling()) {
+    shared_polling_ = true;
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -692,6 +757,18 @@ void NodeBindings::StartPolling() {
   // The MessageLoop should have been created, remember the one in main thread.
   task_runner_ = base::SingleThreadTaskRunner::GetCurrentDefault();
 
+  if (browser_env_ == BrowserEnvironment::kBrowser) {
+    int budget_ms = 0;
+    if (base::StringToInt(
+            base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+                switches::kUvRunBudget),
+            &budget_ms) &&
+        budget_ms > 0) {
+      uv_run_budget_ = base::Milliseconds(budget_ms);
+    }
+    task_time_observer_ = std::make_unique<TaskTimeObserver>(&uv_loop_metrics_);
+  }
+
   // Run uv loop for once to give the uv__io_poll a chance to add all events.
   UvRunOnce();
 }
@@ -705,6 +782,7 @@ void NodeBindings::UvRunOnce() {
   if (!env)
     return;
 
+  TRACE_EVENT0("electron", "NodeBindings::UvRunOnce");
   v8::HandleScope handle_scope(env->isolate());
 
   // Enter node context while dealing with uv events.
@@ -723,7 +801,9 @@ void NodeBindings::UvRunOnce() {
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
   // Deal with uv events.
+  const base::TimeTicks start = base::TimeTicks::Now();
   int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  const base::TimeDelta uv_time = base::TimeTicks::Now() - start;
 
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -733,8 +813,39 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  uv_loop_metrics_.uv_time += uv_time;
+  ++uv_loop_metrics_.runs;
+  if (task_time_observer_)
+    task_time_observer_->AddUvTime(uv_time);
+  if (uv_run_observer_)
+    uv_run_observer_.Run(uv_time);
+
+  // libuv can't stop in the middle of a run, so a run over budget is instead
+  // followed by one for the Chromium tasks that were starved by it.
+  if (!uv_run_budget_.is_zero() && uv_time > uv_run_budget_) {
+    ++uv_loop_metrics_.over_budget_runs;
+    TRACE_EVENT_INSTANT1("electron", "NodeBindings::UvRunOverBudget",
+                         TRACE_EVENT_SCOPE_THREAD, "ms",
+                         uv_time.InMillisecondsF());
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&NodeBindings::ResumePolling,
+                                          weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  ResumePolling();
+}
+
+void NodeBindings::ResumePolling() {
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (shared_polling_)
+    ContinueSharedPolling();
+  else
+    uv_sem_post(&embed_sem_);
+}
+
+bool NodeBindings::StartSharedPolling() {
+  return false;
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -5,14 +5,19 @@
 #ifndef ELECTRON_SHELL_COMMON_NODE_BINDINGS_H_
 #define ELECTRON_SHELL_COMMON_NODE_BINDINGS_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ptr_exclusion.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 #include "v8/include/v8.h"
 
@@ -122,6 +127,23 @@ class NodeBindings {
 
   bool in_worker_loop() const { return uv_loop_ == &worker_loop_; }
 
+  // How the time of the thread running the loop is split between libuv and
+  // the other tasks of the thread, only tracked in the browser process.
+  struct UvLoopMetrics {
+    base::TimeDelta uv_time;
+    base::TimeDelta task_time;
+    uint64_t runs = 0;
+    // Runs that took longer than switches::kUvRunBudget.
+    uint64_t over_budget_runs = 0;
+  };
+  const UvLoopMetrics& uv_loop_metrics() const { return uv_loop_metrics_; }
+
+  // Run with the duration of each run of the loop.
+  void set_uv_run_observer(
+      base::RepeatingCallback<void(base::TimeDelta)> observer) {
+    uv_run_observer_ = std::move(observer);
+  }
+
   // disable copy
   NodeBindings(const NodeBindings&) = delete;
   NodeBindings& operator=(const NodeBindings&) = delete;
@@ -132,9 +154,20 @@ class NodeBindings {
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Called by PrepareEmbedThread() to hand the loop to a polling thread shared
+  // with other loops instead of starting an embed thread for it, returns
+  // false when that isn't supported. ContinueSharedPolling() is then called
+  // instead of resuming the embed thread, and derived classes must stop the
+  // shared polling before they're destroyed.
+  virtual bool StartSharedPolling();
+  virtual void ContinueSharedPolling() {}
+
   // Run the libuv loop for once.
   void UvRunOnce();
 
+  // Lets the embed thread or the shared poller wait for the next event.
+  void ResumePolling();
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -151,6 +184,8 @@ class NodeBindings {
   raw_ptr<uv_loop_t> uv_loop_;
 
  private:
+  class TaskTimeObserver;
+
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
 
@@ -160,6 +195,9 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether the loop is polled by a shared thread instead of |embed_thread_|.
+  bool shared_polling_ = false;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
@@ -178,6 +216,17 @@ class NodeBindings {
   // Isolate data used in creating the environment
   raw_ptr<node::IsolateData> isolate_data_ = nullptr;
 
+  // Whether node::SetIsolateUpForNode() has been called for the isolate.
+  bool isolate_set_up_ = false;
+
+  // After a run of the loop that takes longer than this, polling only resumes
+  // once the tasks queued in the meantime have run. Zero means no budget.
+  base::TimeDelta uv_run_budget_;
+
+  UvLoopMetrics uv_loop_metrics_;
+  base::RepeatingCallback<void(base::TimeDelta)> uv_run_observer_;
+  std::unique_ptr<TaskTimeObserver> task_time_observer_;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_{this};
 };
 
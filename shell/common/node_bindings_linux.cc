@@ -5,9 +5,172 @@
 #include "shell/common/node_bindings_linux.h"
 
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/no_destructor.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/lock.h"
+#include "base/task/current_thread.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/common/options_switches.h"
 
 namespace electron {
 
+namespace {
+
+// Polls the uv loops of all the workers with Node.js integration of the
+// process on one thread, rather than having an embed thread per worker. Like
+// the embed thread, a loop is only polled between UvRunOnce() calls: Arm()
+// lets the poller wait for its next event or timeout, and the poller then
+// wakes up the worker's thread to run it and stops watching it until the
+// next Arm().
+class SharedWorkerPoller {
+ public:
+  static SharedWorkerPoller* GetInstance() {
+    static base::NoDestructor<SharedWorkerPoller> instance;
+    return instance.get();
+  }
+
+  SharedWorkerPoller() : epoll_(epoll_create1(EPOLL_CLOEXEC)) {
+    wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.ptr = this;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeup_fd_, &ev);
+    // Lives as long as the process, like the instance.
+    uv_thread_create(&thread_, ThreadRunner, this);
+  }
+
+  // disable copy
+  SharedWorkerPoller(const SharedWorkerPoller&) = delete;
+  SharedWorkerPoller& operator=(const SharedWorkerPoller&) = delete;
+
+  void Add(uv_loop_t* loop, base::RepeatingClosure wakeup) {
+    base::AutoLock auto_lock(lock_);
+    loops_[loop] = Entry{std::move(wakeup)};
+  }
+
+  // Must not be called for |loop| while the poller may call its wakeup, which
+  // is why it happens under |lock_|.
+  void Remove(uv_loop_t* loop) {
+    base::AutoLock auto_lock(lock_);
+    auto it = loops_.find(loop);
+    if (it == loops_.end())
+      return;
+    if (it->second.watched)
+      epoll_ctl(epoll_, EPOLL_CTL_DEL, uv_backend_fd(loop), nullptr);
+    loops_.erase(it);
+  }
+
+  // Called on the worker's thread after running |loop|.
+  void Arm(uv_loop_t* loop) {
+    int timeout = uv_backend_timeout(loop);
+    {
+      base::AutoLock auto_lock(lock_);
+      auto it = loops_.find(loop);
+      if (it == loops_.end())
+        return;
+      Entry& entry = it->second;
+      entry.armed = true;
+      entry.deadline =
+          timeout == -1 ? base::TimeTicks::Max()
+                        : base::TimeTicks::Now() + base::Milliseconds(timeout);
+      // One shot, so a loop with pending events doesn't keep waking up the
+      // poller until its thread gets to run it.
+      struct epoll_event ev = {0};
+      ev.events = EPOLLIN | EPOLLONESHOT;
+      ev.data.ptr = loop;
+      epoll_ctl(epoll_, entry.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD,
+                uv_backend_fd(loop), &ev);
+      entry.watched = true;
+    }
+    // Let the poller pick up the new timeout.
+    uint64_t value = 1;
+    HANDLE_EINTR(write(wakeup_fd_, &value, sizeof(value)));
+  }
+
+ private:
+  struct Entry {
+    base::RepeatingClosure wakeup;
+    bool armed = false;
+    bool watched = false;
+    base::TimeTicks deadline;
+  };
+
+  static void ThreadRunner(void* arg) {
+    static_cast<SharedWorkerPoller*>(arg)->Run();
+  }
+
+  void Run() {
+    constexpr int kMaxEvents = 64;
+    struct epoll_event events[kMaxEvents];
+    while (true) {
+      int r;
+      do {
+        r = epoll_wait(epoll_, events, kMaxEvents, GetTimeout());
+      } while (r == -1 && errno == EINTR);
+
+      base::AutoLock auto_lock(lock_);
+      for (int i = 0; i < r; ++i) {
+        if (events[i].data.ptr == this) {
+          uint64_t value;
+          HANDLE_EINTR(read(wakeup_fd_, &value, sizeof(value)));
+          continue;
+        }
+        auto it = loops_.find(static_cast<uv_loop_t*>(events[i].data.ptr));
+        if (it != loops_.end())
+          Wakeup(&it->second);
+      }
+      const base::TimeTicks now = base::TimeTicks::Now();
+      for (auto& [loop, entry] : loops_) {
+        if (entry.armed && entry.deadline <= now)
+          Wakeup(&entry);
+      }
+    }
+  }
+
+  // In milliseconds, for epoll_wait().
+  int GetTimeout() {
+    base::AutoLock auto_lock(lock_);
+    base::TimeTicks deadline = base::TimeTicks::Max();
+    for (const auto& [loop, entry] : loops_) {
+      if (entry.armed)
+        deadline = std::min(deadline, entry.deadline);
+    }
+    if (deadline.is_max())
+      return -1;
+    return std::max<int64_t>(
+        0, (deadline - base::TimeTicks::Now()).InMillisecondsRoundedUp());
+  }
+
+  void Wakeup(Entry* entry) {
+    lock_.AssertAcquired();
+    if (!entry->armed)
+      return;
+    entry->armed = false;
+    entry->wakeup.Run();
+  }
+
+  const int epoll_;
+  int wakeup_fd_;
+  uv_thread_t thread_;
+
+  base::Lock lock_;
+  std::map<uv_loop_t*, Entry> loops_ GUARDED_BY(lock_);
+};
+
+}  // namespace
+
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
@@ -17,6 +180,11 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
+NodeBindingsLinux::~NodeBindingsLinux() {
+  if (in_shared_poller_)
+    SharedWorkerPoller::GetInstance()->Remove(uv_loop_);
+}
+
 void NodeBindingsLinux::PollEvents() {
   int timeout = uv_backend_timeout(uv_loop_);
 
@@ -28,6 +196,60 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::StartSharedPolling() {
+  if (browser_env_ == BrowserEnvironment::kBrowser) {
+    in_message_pump_ = base::CommandLine::ForCurrentProcess()->HasSwitch(
+                           switches::kUvInMessagePump) &&
+                       base::CurrentUIThread::IsSet();
+    return in_message_pump_;
+  }
+  if (browser_env_ != BrowserEnvironment::kWorker)
+    return false;
+  in_shared_poller_ = true;
+  // Unretained is safe since the loop is removed before this is destroyed,
+  // and the poller never runs the callback after that.
+  SharedWorkerPoller::GetInstance()->Add(
+      uv_loop_, base::BindRepeating(&NodeBindingsLinux::WakeupMainThread,
+                                    base::Unretained(this)));
+  return true;
+}
+
+void NodeBindingsLinux::ContinueSharedPolling() {
+  if (in_shared_poller_) {
+    SharedWorkerPoller::GetInstance()->Arm(uv_loop_);
+    return;
+  }
+
+  // The backend fd is an epoll fd, which becomes readable when any of the
+  // fds of the loop has an event. The loop is then run right away on this
+  // thread, without a round trip through an embed thread. Like the embed
+  // thread, the fd is only watched between runs of the loop.
+  base::CurrentUIThread::Get()->WatchFileDescriptor(
+      uv_backend_fd(uv_loop_), false /* persistent */,
+      base::MessagePumpForUI::WATCH_READ, &backend_fd_controller_, this);
+
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout == -1) {
+    uv_timer_.Stop();
+    return;
+  }
+  // Unretained is safe since the timer is owned by this.
+  uv_timer_.Start(FROM_HERE, base::Milliseconds(timeout),
+                  base::BindOnce(&NodeBindingsLinux::OnUvTimer,
+                                 base::Unretained(this)));
+}
+
+void NodeBindingsLinux::OnFileCanReadWithoutBlocking(int fd) {
+  TRACE_EVENT0("electron", "NodeBindingsLinux::OnFileCanReadWithoutBlocking");
+  uv_timer_.Stop();
+  UvRunOnce();
+}
+
+void NodeBindingsLinux::OnUvTimer() {
+  backend_fd_controller_.StopWatchingFileDescriptor();
+  UvRunOnce();
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
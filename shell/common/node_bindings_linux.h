@@ -6,19 +6,44 @@
 #define ELECTRON_SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 
 #include "base/compiler_specific.h"
+#include "base/location.h"
+#include "base/message_loop/message_pump_for_ui.h"
+#include "base/timer/timer.h"
 #include "shell/common/node_bindings.h"
 
 namespace electron {
 
-class NodeBindingsLinux : public NodeBindings {
+class NodeBindingsLinux : public NodeBindings,
+                          public base::MessagePumpForUI::FdWatcher {
  public:
   explicit NodeBindingsLinux(BrowserEnvironment browser_env);
+  ~NodeBindingsLinux() override;
 
  private:
   void PollEvents() override;
+  // Worker loops are polled by one thread per process, see
+  // SharedWorkerPoller. With switches::kUvInMessagePump, the loop of the main
+  // process is watched by the message pump of the main thread instead.
+  bool StartSharedPolling() override;
+  void ContinueSharedPolling() override;
+
+  // base::MessagePumpForUI::FdWatcher:
+  void OnFileCanReadWithoutBlocking(int fd) override;
+  void OnFileCanWriteWithoutBlocking(int fd) override {}
+
+  void OnUvTimer();
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
+
+  bool in_shared_poller_ = false;
+
+  // Only used with switches::kUvInMessagePump.
+  bool in_message_pump_ = false;
+  base::MessagePumpForUI::FdWatchController backend_fd_controller_{FROM_HERE};
+  // Runs the loop when its next timer is due, since the backend fd only
+  // becomes readable for I/O.
+  base::OneShotTimer uv_timer_;
 };
 
 }  // namespace electron
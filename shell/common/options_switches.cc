@@ -31,6 +31,14 @@ const char kFullscreen[] = "fullscreen";
 const char kTrafficLightPosition[] = "trafficLightPosition";
 const char kRoundedCorners[] = "roundedCorners";
 
+// Whether the renderers are resized at most once per frame while the user
+// resizes the window.
+const char kThrottleLiveResize[] = "throttleLiveResize";
+
+// Whether the renderer is launched, and the connection to the page warmed,
+// while the window is being set up.
+const char kFastFirstPaint[] = "fastFirstPaint";
+
 // The color to use as the theme and symbol colors respectively for Window
 // Controls Overlay if enabled on Windows.
 const char kOverlayButtonColor[] = "color";
@@ -159,6 +167,15 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+// Whether offscreen rendering delivers the frames as GPU textures.
+const char kUseSharedTexture[] = "useSharedTexture";
+
+// The format offscreen rendering passes the frames in.
+const char kPaintFormat[] = "paintFormat";
+
+// Whether offscreen rendering only produces frames when asked to.
+const char kUseExternalBeginFrame[] = "useExternalBeginFrame";
+
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
 // Disable window resizing when HTML Fullscreen API is activated.
@@ -242,6 +259,10 @@ const char kScrollBounce[] = "scroll-bounce";
 // Command switch passed to renderer process to control nodeIntegration.
 const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 
+// Command switch passed to renderer process to report when the V8 heap of its
+// main thread is near its limit.
+const char kNearHeapLimitNotify[] = "near-heap-limit-notify";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -254,6 +275,9 @@ const char kDiskCacheSize[] = "disk-cache-size";
 // Ignore the limit of 6 connections per host.
 const char kIgnoreConnectionsLimit[] = "ignore-connections-limit";
 
+// Splits the large downloads in this many range requests.
+const char kParallelDownloadRequests[] = "parallel-download-requests";
+
 // Whitelist containing servers for which Integrated Authentication is enabled.
 const char kAuthServerWhitelist[] = "auth-server-whitelist";
 
@@ -269,6 +293,21 @@ const char kDisableNTLMv2[] = "disable-ntlm-v2";
 
 const char kEnableWebSQL[] = "enable-websql";
 
+// If set, the main thread's message pump watches the libuv loop of the main
+// process directly instead of an embed thread polling it. Linux only.
+const char kUvInMessagePump[] = "uv-in-message-pump";
+
+// The time in milliseconds after which a run of the libuv loop of the main
+// process is followed by Chromium tasks before polling the loop again.
+const char kUvRunBudget[] = "uv-run-budget";
+
+// The size in bytes the values of the extra crash keys of a process can take.
+const char kCrashKeysBudget[] = "crash-keys-budget";
+
+// The size in bytes of the memory referenced from the stacks of a process
+// which its minidumps include.
+const char kCrashReferencedMemoryLimit[] = "crash-referenced-memory-limit";
+
 }  // namespace switches
 
 }  // namespace electron
@@ -59,6 +59,8 @@ extern const char kBackgroundMaterial[];
 extern const char kVisualEffectState[];
 extern const char kTrafficLightPosition[];
 extern const char kRoundedCorners[];
+extern const char kThrottleLiveResize[];
+extern const char kFastFirstPaint[];
 extern const char ktitleBarOverlay[];
 extern const char kOverlayButtonColor[];
 extern const char kOverlaySymbolColor[];
@@ -81,6 +83,9 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kUseSharedTexture[];
+extern const char kPaintFormat[];
+extern const char kUseExternalBeginFrame[];
 extern const char kNodeIntegrationInSubFrames[];
 extern const char kDisableHtmlFullscreenWindowResize[];
 extern const char kJavaScript[];
@@ -119,18 +124,26 @@ extern const char kAppPath[];
 
 extern const char kScrollBounce[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kNearHeapLimitNotify[];
 
 extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
 
 extern const char kDiskCacheSize[];
 extern const char kIgnoreConnectionsLimit[];
+extern const char kParallelDownloadRequests[];
 extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
 extern const char kEnableAuthNegotiatePort[];
 extern const char kDisableNTLMv2[];
 
 extern const char kEnableWebSQL[];
+
+extern const char kUvInMessagePump[];
+extern const char kUvRunBudget[];
+
+extern const char kCrashKeysBudget[];
+extern const char kCrashReferencedMemoryLimit[];
 }  // namespace switches
 
 }  // namespace electron
@@ -0,0 +1,156 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/resources_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/base_paths.h"
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/path_service.h"
+#include "base/sys_byteorder.h"
+
+#if BUILDFLAG(IS_LINUX)
+#include "base/posix/global_descriptors.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+constexpr char kMagic[] = "ELBUNDLE";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr uint32_t kVersion = 1;
+// The index is in one read, it is a few KB for all the locales.
+constexpr int kMaxIndexSize = 64 * 1024;
+
+// Reads the little endian numbers of the index.
+class IndexReader {
+ public:
+  IndexReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    if (size_ - position_ < sizeof(T))
+      return false;
+    memcpy(value, data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    if constexpr (sizeof(T) == 2)
+      *value = base::ByteSwapToLE16(*value);
+    else if constexpr (sizeof(T) == 4)
+      *value = base::ByteSwapToLE32(*value);
+    else
+      *value = base::ByteSwapToLE64(*value);
+    return true;
+  }
+
+  bool ReadString(size_t length, std::string* value) {
+    if (size_ - position_ < length)
+      return false;
+    value->assign(data_ + position_, length);
+    position_ += length;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+std::unique_ptr<ResourcesBundle> OpenResourcesBundle() {
+  base::File file;
+#if BUILDFLAG(IS_LINUX)
+  int fd = base::GlobalDescriptors::GetInstance()->MaybeGet(
+      kResourcesBundleDescriptor);
+  if (fd != -1)
+    file = base::File(fd);
+#endif
+  if (!file.IsValid()) {
+    base::FilePath dir;
+    if (!base::PathService::Get(base::DIR_MODULE, &dir))
+      return nullptr;
+    file = base::File(dir.Append(FILE_PATH_LITERAL("resources.bundle")),
+                      base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!file.IsValid())
+      return nullptr;
+  }
+  auto bundle = std::make_unique<ResourcesBundle>(std::move(file));
+  return bundle->FindRegion("resources.pak") ? std::move(bundle) : nullptr;
+}
+
+}  // namespace
+
+// static
+ResourcesBundle* ResourcesBundle::Get() {
+  static base::NoDestructor<std::unique_ptr<ResourcesBundle>> bundle(
+      OpenResourcesBundle());
+  return bundle->get();
+}
+
+ResourcesBundle::ResourcesBundle(base::File file) : file_(std::move(file)) {
+  if (!ReadIndex()) {
+    LOG(ERROR) << "The resources bundle is invalid, loading the paks instead";
+    entries_.clear();
+  }
+}
+
+ResourcesBundle::~ResourcesBundle() = default;
+
+absl::optional<base::MemoryMappedFile::Region> ResourcesBundle::FindRegion(
+    base::StringPiece name) const {
+  auto it = entries_.find(name);
+  if (it == entries_.end())
+    return absl::nullopt;
+  return it->second;
+}
+
+bool ResourcesBundle::ReadIndex() {
+  const int64_t length = file_.GetLength();
+  if (length <= 0)
+    return false;
+  std::vector<char> index(
+      static_cast<size_t>(std::min<int64_t>(length, kMaxIndexSize)));
+  const int read = file_.Read(0, index.data(), index.size());
+  if (read < 0 || static_cast<size_t>(read) != index.size())
+    return false;
+
+  IndexReader reader(index.data(), index.size());
+  std::string magic;
+  uint32_t version, count;
+  if (!reader.ReadString(kMagicSize, &magic) || magic != kMagic ||
+      !reader.Read(&version) || version != kVersion || !reader.Read(&count)) {
+    return false;
+  }
+
+  std::vector<std::pair<std::string, base::MemoryMappedFile::Region>> entries;
+  entries.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint16_t name_length;
+    std::string name;
+    uint64_t offset, size;
+    if (!reader.Read(&name_length) || !reader.ReadString(name_length, &name) ||
+        !reader.Read(&offset) || !reader.Read(&size)) {
+      return false;
+    }
+    const uint64_t file_length = static_cast<uint64_t>(length);
+    if (offset > file_length || size > file_length - offset)
+      return false;
+    entries.emplace_back(
+        std::move(name),
+        base::MemoryMappedFile::Region{static_cast<int64_t>(offset),
+                                       static_cast<size_t>(size)});
+  }
+  entries_ = base::flat_map<std::string, base::MemoryMappedFile::Region>(
+      std::move(entries));
+  return true;
+}
+
+}  // namespace electron
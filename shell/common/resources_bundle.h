@@ -0,0 +1,65 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_RESOURCES_BUNDLE_H_
+#define ELECTRON_SHELL_COMMON_RESOURCES_BUNDLE_H_
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/strings/string_piece.h"
+#include "build/build_config.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+#if BUILDFLAG(IS_LINUX)
+#include "content/public/common/content_descriptors.h"
+#endif
+
+namespace electron {
+
+#if BUILDFLAG(IS_LINUX)
+// The descriptor of the bundle in the child processes.
+constexpr int kResourcesBundleDescriptor = kContentIPCDescriptorMax + 1;
+#endif
+
+// The resource paks packed into one file by the resources_bundle target when
+// enable_resources_bundle is set, see build/resources_bundle.py. Processes
+// open it once at startup instead of opening each pak. On Linux the browser
+// process maps it into its children, which don't open it again.
+class ResourcesBundle {
+ public:
+  // The bundle of this process, opened on the first call. nullptr when there
+  // is none, the paks are loaded from their own files then.
+  static ResourcesBundle* Get();
+
+  explicit ResourcesBundle(base::File file);
+  ~ResourcesBundle();
+
+  // disable copy
+  ResourcesBundle(const ResourcesBundle&) = delete;
+  ResourcesBundle& operator=(const ResourcesBundle&) = delete;
+
+  // Where the contents of the file named |name|, e.g. "resources.pak" or
+  // "locales/en-US.pak", are in the bundle.
+  absl::optional<base::MemoryMappedFile::Region> FindRegion(
+      base::StringPiece name) const;
+
+  // For the APIs which take ownership of the file they map.
+  base::File Duplicate() const { return file_.Duplicate(); }
+  base::PlatformFile GetPlatformFile() const {
+    return file_.GetPlatformFile();
+  }
+
+ private:
+  bool ReadIndex();
+
+  base::File file_;
+  base::flat_map<std::string, base::MemoryMappedFile::Region> entries_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_RESOURCES_BUNDLE_H_
@@ -0,0 +1,116 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/shared_memory_array_buffer.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/memory/platform_shared_memory_region.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/system/sys_info.h"
+#include "build/build_config.h"
+#include "v8/include/v8-initialization.h"
+#include "v8/include/v8-platform.h"
+
+namespace electron {
+
+namespace {
+
+size_t GetAllocationGranularity() {
+#if defined(V8_ENABLE_SANDBOX)
+  return v8::V8::GetSandboxAddressSpace()->allocation_granularity();
+#else
+  return base::SysInfo::VMAllocationGranularity();
+#endif
+}
+
+// Mapped in whole allocation units, which must all be backed by the region.
+size_t GetMappedSize(size_t size) {
+  return base::bits::AlignUp(std::max<size_t>(size, 1),
+                             GetAllocationGranularity());
+}
+
+#if defined(V8_ENABLE_SANDBOX)
+v8::PlatformSharedMemoryHandle GetV8Handle(
+    const base::subtle::PlatformSharedMemoryRegion& region) {
+#if BUILDFLAG(IS_WIN)
+  return v8::SharedMemoryHandleFromFileMapping(region.GetPlatformHandle());
+#elif BUILDFLAG(IS_MAC)
+  return v8::SharedMemoryHandleFromMachMemoryEntry(region.GetPlatformHandle());
+#else
+  return v8::SharedMemoryHandleFromFileDescriptor(
+      region.GetPlatformHandle().fd);
+#endif
+}
+
+struct SandboxMapping {
+  v8::VirtualAddressSpace::Address address;
+  size_t size;
+};
+
+// Can run on any thread, once the last buffer using the backing store is
+// gone.
+void FreeSandboxMapping(void* data, size_t length, void* deleter_data) {
+  std::unique_ptr<SandboxMapping> mapping(
+      static_cast<SandboxMapping*>(deleter_data));
+  v8::V8::GetSandboxAddressSpace()->FreeSharedPages(mapping->address,
+                                                    mapping->size);
+}
+#else
+void FreeMapping(void* data, size_t length, void* deleter_data) {
+  delete static_cast<base::WritableSharedMemoryMapping*>(deleter_data);
+}
+#endif
+
+}  // namespace
+
+base::UnsafeSharedMemoryRegion CreateSharedMemoryArrayBufferRegion(
+    size_t size) {
+  return base::UnsafeSharedMemoryRegion::Create(GetMappedSize(size));
+}
+
+v8::MaybeLocal<v8::SharedArrayBuffer> NewSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion* region,
+    size_t size) {
+  const size_t mapped_size = GetMappedSize(size);
+  if (!region->IsValid() || region->GetSize() < mapped_size)
+    return {};
+
+#if defined(V8_ENABLE_SANDBOX)
+  // The platform handle is only reachable through the serialization API, the
+  // region is put back together right after.
+  base::subtle::PlatformSharedMemoryRegion platform_region =
+      base::UnsafeSharedMemoryRegion::TakeHandleForSerialization(
+          std::move(*region));
+  v8::VirtualAddressSpace* address_space = v8::V8::GetSandboxAddressSpace();
+  const v8::VirtualAddressSpace::Address address =
+      address_space->AllocateSharedPages(
+          v8::VirtualAddressSpace::kNoHint, mapped_size,
+          v8::PagePermissions::kReadWrite, GetV8Handle(platform_region), 0);
+  *region =
+      base::UnsafeSharedMemoryRegion::Deserialize(std::move(platform_region));
+  if (!address)
+    return {};
+  std::unique_ptr<v8::BackingStore> backing_store =
+      v8::SharedArrayBuffer::NewBackingStore(
+          reinterpret_cast<void*>(address), size, &FreeSandboxMapping,
+          new SandboxMapping{address, mapped_size});
+#else
+  auto mapping = std::make_unique<base::WritableSharedMemoryMapping>(
+      region->MapAt(0, mapped_size));
+  if (!mapping->IsValid())
+    return {};
+  void* data = mapping->memory();
+  std::unique_ptr<v8::BackingStore> backing_store =
+      v8::SharedArrayBuffer::NewBackingStore(data, size, &FreeMapping,
+                                             mapping.release());
+#endif
+  return v8::SharedArrayBuffer::New(isolate, std::move(backing_store));
+}
+
+}  // namespace electron
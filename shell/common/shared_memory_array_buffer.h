@@ -0,0 +1,37 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
+#define ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
+
+#include <cstddef>
+
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "v8/include/v8-array-buffer.h"
+
+namespace electron {
+
+// SharedArrayBuffers over shared memory, so that two processes can work on
+// the same bytes without copying them. Atomics work across the processes on
+// such buffers, except for Atomics.wait() and Atomics.notify() which only
+// wake up the threads of the process that calls them.
+//
+// With the V8 sandbox, ArrayBuffers can only live inside of it, so the memory
+// is mapped into the sandbox's address space instead of being mapped by base.
+
+// Creates a region that NewSharedMemoryArrayBuffer() can map |size| bytes
+// of, in this process and in others. Returns an invalid region on failure.
+base::UnsafeSharedMemoryRegion CreateSharedMemoryArrayBufferRegion(size_t size);
+
+// Returns a SharedArrayBuffer over the first |size| bytes of |region|, or an
+// empty handle if they can't be mapped. |region| stays usable, e.g. to be sent
+// to another process.
+v8::MaybeLocal<v8::SharedArrayBuffer> NewSharedMemoryArrayBuffer(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion* region,
+    size_t size);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_SHARED_MEMORY_ARRAY_BUFFER_H_
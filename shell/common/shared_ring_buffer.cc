@@ -0,0 +1,174 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/shared_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/memory/ptr_util.h"
+
+namespace electron {
+
+// Each index sits on its own cache line so that the producer and the consumer
+// don't keep stealing the line from each other.
+struct SharedRingBuffer::Header {
+  alignas(64) std::atomic<uint64_t> write_index;
+  alignas(64) std::atomic<uint64_t> read_index;
+  alignas(64) std::atomic<uint32_t> reader_waiting;
+};
+
+namespace {
+
+using Length = uint32_t;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory atomics must be lock free");
+
+}  // namespace
+
+// static
+std::unique_ptr<SharedRingBuffer> SharedRingBuffer::Create(
+    size_t capacity,
+    base::UnsafeSharedMemoryRegion* region) {
+  capacity = size_t{1} << base::bits::Log2Ceiling(static_cast<uint32_t>(
+                 std::clamp(capacity, kMinCapacity, kMaxCapacity)));
+
+  *region = base::UnsafeSharedMemoryRegion::Create(sizeof(Header) + capacity);
+  if (!region->IsValid())
+    return nullptr;
+  base::WritableSharedMemoryMapping mapping = region->Map();
+  if (!mapping.IsValid())
+    return nullptr;
+  // Freshly created shared memory is zero-filled, which is an empty queue.
+  return base::WrapUnique(new SharedRingBuffer(std::move(mapping), capacity));
+}
+
+// static
+std::unique_ptr<SharedRingBuffer> SharedRingBuffer::Attach(
+    base::UnsafeSharedMemoryRegion region) {
+  if (!region.IsValid() || region.GetSize() <= sizeof(Header))
+    return nullptr;
+  size_t capacity = region.GetSize() - sizeof(Header);
+  if (!base::bits::IsPowerOfTwo(capacity) || capacity > kMaxCapacity)
+    return nullptr;
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+  auto buffer =
+      base::WrapUnique(new SharedRingBuffer(std::move(mapping), capacity));
+  buffer->read_index_ =
+      buffer->header()->read_index.load(std::memory_order_acquire);
+  return buffer;
+}
+
+SharedRingBuffer::SharedRingBuffer(base::WritableSharedMemoryMapping mapping,
+                                   size_t capacity)
+    : mapping_(std::move(mapping)),
+      data_(mapping_.GetMemoryAsSpan<uint8_t>().subspan(sizeof(Header))),
+      capacity_(capacity) {}
+
+SharedRingBuffer::~SharedRingBuffer() = default;
+
+SharedRingBuffer::Header* SharedRingBuffer::header() const {
+  return static_cast<Header*>(mapping_.memory());
+}
+
+bool SharedRingBuffer::Write(base::span<const uint8_t> prefix,
+                             base::span<const uint8_t> body) {
+  if (corrupted_)
+    return false;
+  uint64_t read_index = header()->read_index.load(std::memory_order_acquire);
+  if (read_index > write_index_ || write_index_ - read_index > capacity_) {
+    corrupted_ = true;
+    return false;
+  }
+  size_t free = capacity_ - (write_index_ - read_index);
+  if (body.size() > free || prefix.size() + sizeof(Length) > free - body.size())
+    return false;
+
+  Length length = prefix.size() + body.size();
+  uint64_t position = write_index_;
+  CopyIn(position, base::as_bytes(base::make_span(&length, 1u)));
+  position += sizeof(Length);
+  CopyIn(position, prefix);
+  position += prefix.size();
+  CopyIn(position, body);
+  write_index_ = position + body.size();
+  // Sequentially consistent so that it is ordered before the load of
+  // |reader_waiting| in TakeReaderWaiting(), see PrepareToWait().
+  header()->write_index.store(write_index_, std::memory_order_seq_cst);
+  return true;
+}
+
+bool SharedRingBuffer::TakeReaderWaiting() {
+  return header()->reader_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+}
+
+bool SharedRingBuffer::Read(std::vector<uint8_t>* record) {
+  if (corrupted_)
+    return false;
+  uint64_t write_index = header()->write_index.load(std::memory_order_acquire);
+  if (write_index < read_index_ || write_index - read_index_ > capacity_) {
+    corrupted_ = true;
+    return false;
+  }
+  uint64_t available = write_index - read_index_;
+  if (available == 0)
+    return false;
+
+  Length length;
+  if (available < sizeof(Length)) {
+    corrupted_ = true;
+    return false;
+  }
+  CopyOut(read_index_, base::as_writable_bytes(base::make_span(&length, 1u)));
+  if (length > available - sizeof(Length)) {
+    corrupted_ = true;
+    return false;
+  }
+  record->resize(length);
+  CopyOut(read_index_ + sizeof(Length), base::make_span(*record));
+  read_index_ += sizeof(Length) + length;
+  header()->read_index.store(read_index_, std::memory_order_release);
+  return true;
+}
+
+bool SharedRingBuffer::PrepareToWait() {
+  // The producer publishes |write_index| before it checks |reader_waiting|,
+  // and we set |reader_waiting| before we check |write_index| again, so at
+  // least one of us sees the other's store and a record is never left
+  // unnoticed.
+  header()->reader_waiting.store(1, std::memory_order_seq_cst);
+  if (header()->write_index.load(std::memory_order_seq_cst) == read_index_)
+    return true;
+  header()->reader_waiting.store(0, std::memory_order_relaxed);
+  return false;
+}
+
+void SharedRingBuffer::CopyIn(uint64_t position,
+                              base::span<const uint8_t> data) {
+  if (data.empty())
+    return;
+  size_t offset = position & (capacity_ - 1);
+  size_t first = std::min(data.size(), capacity_ - offset);
+  memcpy(&data_[offset], data.data(), first);
+  if (first < data.size())
+    memcpy(data_.data(), data.data() + first, data.size() - first);
+}
+
+void SharedRingBuffer::CopyOut(uint64_t position,
+                               base::span<uint8_t> data) const {
+  if (data.empty())
+    return;
+  size_t offset = position & (capacity_ - 1);
+  size_t first = std::min(data.size(), capacity_ - offset);
+  memcpy(data.data(), &data_[offset], first);
+  if (first < data.size())
+    memcpy(data.data() + first, data_.data(), data.size() - first);
+}
+
+}  // namespace electron
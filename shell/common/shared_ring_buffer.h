@@ -0,0 +1,108 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_SHARED_RING_BUFFER_H_
+#define ELECTRON_SHELL_COMMON_SHARED_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+
+namespace electron {
+
+// A single-producer/single-consumer queue of variable sized records living in
+// shared memory. Each side of the queue creates its own SharedRingBuffer over
+// the same region; neither side takes a lock and records are copied straight
+// into and out of the mapping.
+//
+// The queue doesn't wake the consumer up by itself. When the consumer runs
+// out of records it calls PrepareToWait(), and the producer checks
+// TakeReaderWaiting() after each Write() to find out whether the consumer has
+// to be notified through some other channel.
+//
+// The consumer end may live in a less privileged process, so the producer
+// never trusts anything the consumer writes into the shared header.
+class SharedRingBuffer {
+ public:
+  // Rounded up to a power of two and clamped to [kMinCapacity, kMaxCapacity].
+  static constexpr size_t kMinCapacity = 4 * 1024;
+  static constexpr size_t kMaxCapacity = 64 * 1024 * 1024;
+
+  // Creates a new, empty queue and its producer end. The region to hand to
+  // the consumer is returned in |region|.
+  static std::unique_ptr<SharedRingBuffer> Create(
+      size_t capacity,
+      base::UnsafeSharedMemoryRegion* region);
+
+  // Creates the consumer end of a queue created by Create(). Returns nullptr
+  // if |region| is not a valid queue.
+  static std::unique_ptr<SharedRingBuffer> Attach(
+      base::UnsafeSharedMemoryRegion region);
+
+  ~SharedRingBuffer();
+
+  // disable copy
+  SharedRingBuffer(const SharedRingBuffer&) = delete;
+  SharedRingBuffer& operator=(const SharedRingBuffer&) = delete;
+
+  size_t capacity() const { return capacity_; }
+
+  // Whether the other end corrupted the shared header. Once set, Write() and
+  // Read() always fail.
+  bool is_corrupted() const { return corrupted_; }
+
+  // Producer: appends a record made of |prefix| followed by |body|. Returns
+  // false if there is not enough free space for it right now.
+  bool Write(base::span<const uint8_t> prefix, base::span<const uint8_t> body);
+  bool Write(base::span<const uint8_t> record) { return Write({}, record); }
+
+  // Producer: whether the consumer went idle, clearing the flag.
+  bool TakeReaderWaiting();
+
+  // Consumer: pops the oldest record into |record|. Returns false if the queue
+  // is empty.
+  bool Read(std::vector<uint8_t>* record);
+
+  // Consumer: marks the consumer as idle. Returns false, without going idle,
+  // if records were written in the meantime and should be read first.
+  bool PrepareToWait();
+
+ private:
+  struct Header;
+
+  SharedRingBuffer(base::WritableSharedMemoryMapping mapping, size_t capacity);
+
+  Header* header() const;
+  void CopyIn(uint64_t position, base::span<const uint8_t> data);
+  void CopyOut(uint64_t position, base::span<uint8_t> data) const;
+
+  base::WritableSharedMemoryMapping mapping_;
+  base::span<uint8_t> data_;
+  const size_t capacity_;
+
+  // This end's own copy of the index it owns. The shared copy is only ever
+  // written from here, never read back.
+  uint64_t write_index_ = 0;
+  uint64_t read_index_ = 0;
+
+  bool corrupted_ = false;
+};
+
+// First byte of the records written by SharedRingBufferWriter in the main
+// process and read by SharedRingBufferReader in renderers.
+enum class SharedRingBufferRecordType : uint8_t {
+  // The rest of the record is the contents of an ArrayBufferView.
+  kBytes = 0,
+  // The rest of the record is the output of SerializeV8Value.
+  kSerializedValue = 1,
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_SHARED_RING_BUFFER_H_
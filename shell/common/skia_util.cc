@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -89,19 +91,22 @@ bool AddImageSkiaRepFromJPEG(gfx::ImageSkia* image,
   return true;
 }
 
-bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
-                               const unsigned char* data,
-                               size_t size,
-                               int width,
-                               int height,
-                               double scale_factor) {
+bool DecodeBitmapFromBuffer(const unsigned char* data,
+                            size_t size,
+                            int width,
+                            int height,
+                            SkBitmap* bitmap) {
   // Try PNG first.
-  if (AddImageSkiaRepFromPNG(image, data, size, scale_factor))
+  if (gfx::PNGCodec::Decode(data, size, bitmap))
     return true;
 
   // Try JPEG second.
-  if (AddImageSkiaRepFromJPEG(image, data, size, scale_factor))
+  if (auto jpeg = gfx::JPEGCodec::Decode(data, size)) {
+    // See the workaround in AddImageSkiaRepFromJPEG.
+    jpeg->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
+    *bitmap = std::move(*jpeg);
     return true;
+  }
 
   if (width == 0 || height == 0)
     return false;
@@ -110,46 +115,70 @@ bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
   if (size < info.computeMinByteSize())
     return false;
 
+  bitmap->allocN32Pixels(width, height, false);
+  bitmap->writePixels({info, data, bitmap->rowBytes()});
+  return true;
+}
+
+bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
+                               const unsigned char* data,
+                               size_t size,
+                               int width,
+                               int height,
+                               double scale_factor) {
   SkBitmap bitmap;
-  bitmap.allocN32Pixels(width, height, false);
-  bitmap.writePixels({info, data, bitmap.rowBytes()});
+  if (!DecodeBitmapFromBuffer(data, size, width, height, &bitmap))
+    return false;
 
   image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
   return true;
 }
 
-bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
-                             const base::FilePath& path,
-                             double scale_factor) {
-  std::string file_contents;
+void ReadImageFileFromPath(std::vector<ImageFile>* files,
+                           const base::FilePath& path,
+                           float scale_factor) {
+  ImageFile file;
+  file.scale_factor = scale_factor;
   {
     electron::ScopedAllowBlockingForElectron allow_blocking;
-    if (!asar::ReadFileToString(path, &file_contents))
-      return false;
+    if (!asar::ReadFileToString(path, &file.contents))
+      return;
   }
-
-  const auto* data =
-      reinterpret_cast<const unsigned char*>(file_contents.data());
-  size_t size = file_contents.size();
-
-  return AddImageSkiaRepFromBuffer(image, data, size, 0, 0, scale_factor);
+  files->push_back(std::move(file));
 }
 
-bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
-                                   const base::FilePath& path) {
-  bool succeed = false;
+std::vector<ImageFile> ReadImageFilesFromPath(const base::FilePath& path) {
+  std::vector<ImageFile> files;
   std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
-  if (base::MatchPattern(filename, "*@*x"))
+  if (base::MatchPattern(filename, "*@*x")) {
     // Don't search for other representations if the DPI has been specified.
-    return AddImageSkiaRepFromPath(image, path, GetScaleFactorFromPath(path));
-  else
-    succeed |= AddImageSkiaRepFromPath(image, path, 1.0f);
+    ReadImageFileFromPath(&files, path, GetScaleFactorFromPath(path));
+    return files;
+  }
 
-  for (const ScaleFactorPair& pair : kScaleFactorPairs)
-    succeed |= AddImageSkiaRepFromPath(
-        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+  ReadImageFileFromPath(&files, path, 1.0f);
+  for (const ScaleFactorPair& pair : kScaleFactorPairs) {
+    ReadImageFileFromPath(&files, path.InsertBeforeExtensionASCII(pair.name),
+                          pair.scale);
+  }
+  return files;
+}
+
+bool AddImageSkiaRepsFromFiles(gfx::ImageSkia* image,
+                               const std::vector<ImageFile>& files) {
+  bool succeed = false;
+  for (const ImageFile& file : files) {
+    succeed |= AddImageSkiaRepFromBuffer(
+        image, reinterpret_cast<const unsigned char*>(file.contents.data()),
+        file.contents.size(), 0, 0, file.scale_factor);
+  }
   return succeed;
 }
+
+bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
+                                   const base::FilePath& path) {
+  return AddImageSkiaRepsFromFiles(image, ReadImageFilesFromPath(path));
+}
 #if BUILDFLAG(IS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
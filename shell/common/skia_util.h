@@ -5,6 +5,11 @@
 #ifndef ELECTRON_SHELL_COMMON_SKIA_UTIL_H_
 #define ELECTRON_SHELL_COMMON_SKIA_UTIL_H_
 
+#include <string>
+#include <vector>
+
+class SkBitmap;
+
 namespace base {
 class FilePath;
 }
@@ -15,6 +20,19 @@ class ImageSkia;
 
 namespace electron::util {
 
+// The encoded contents of an image representation.
+struct ImageFile {
+  float scale_factor = 1.0f;
+  std::string contents;
+};
+
+// Reads the image at |path| and the ones of its other scale factors, like
+// file@2x.png, without decoding them.
+std::vector<ImageFile> ReadImageFilesFromPath(const base::FilePath& path);
+
+bool AddImageSkiaRepsFromFiles(gfx::ImageSkia* image,
+                               const std::vector<ImageFile>& files);
+
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
                                    const base::FilePath& path);
 
@@ -25,6 +43,14 @@ bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                int height,
                                double scale_factor);
 
+// Decodes a PNG, JPEG or, when |width| and |height| are set, a raw bitmap.
+// Unlike the functions above it can be called on any thread.
+bool DecodeBitmapFromBuffer(const unsigned char* data,
+                            size_t size,
+                            int width,
+                            int height,
+                            SkBitmap* bitmap);
+
 bool AddImageSkiaRepFromJPEG(gfx::ImageSkia* image,
                              const unsigned char* data,
                              size_t size,
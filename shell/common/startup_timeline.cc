@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_timeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "base/ranges/algorithm.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron::startup_timeline {
+
+namespace {
+
+constexpr size_t kPhaseCount = static_cast<size_t>(Phase::kMaxValue) + 1;
+
+// Microseconds of base::TimeTicks, 0 until the phase is recorded.
+std::atomic<int64_t> g_start_times[kPhaseCount];
+std::atomic<int64_t> g_end_times[kPhaseCount];
+
+int64_t ToMicroseconds(base::TimeTicks time) {
+  // Keeps a time of 0 meaning unset.
+  return std::max<int64_t>((time - base::TimeTicks()).InMicroseconds(), 1);
+}
+
+base::TimeTicks FromMicroseconds(int64_t microseconds) {
+  return base::TimeTicks() + base::Microseconds(microseconds);
+}
+
+// Sets |value| unless it was set already.
+bool SetOnce(std::atomic<int64_t>& value, int64_t microseconds) {
+  int64_t expected = 0;
+  return value.compare_exchange_strong(expected, microseconds,
+                                       std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void MarkStart(Phase phase, base::TimeTicks time) {
+  const size_t index = static_cast<size_t>(phase);
+  if (!SetOnce(g_start_times[index], ToMicroseconds(time)))
+    return;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      "electron", GetPhaseName(phase), TRACE_ID_LOCAL(&g_start_times[index]),
+      time);
+}
+
+void MarkEnd(Phase phase, base::TimeTicks time) {
+  const size_t index = static_cast<size_t>(phase);
+  if (!g_start_times[index].load(std::memory_order_relaxed) ||
+      !SetOnce(g_end_times[index], ToMicroseconds(time))) {
+    return;
+  }
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      "electron", GetPhaseName(phase), TRACE_ID_LOCAL(&g_start_times[index]),
+      time);
+}
+
+void Mark(Phase phase, base::TimeTicks time) {
+  MarkStart(phase, time);
+  MarkEnd(phase, time);
+}
+
+std::vector<Entry> GetEntries() {
+  std::vector<Entry> entries;
+  for (size_t i = 0; i < kPhaseCount; ++i) {
+    const int64_t start = g_start_times[i].load(std::memory_order_relaxed);
+    const int64_t end = g_end_times[i].load(std::memory_order_relaxed);
+    if (start && end) {
+      entries.push_back({static_cast<Phase>(i), FromMicroseconds(start),
+                         FromMicroseconds(end)});
+    }
+  }
+  base::ranges::stable_sort(entries, {}, &Entry::start_time);
+  return entries;
+}
+
+const char* GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kProcessStart:
+      return "process-start";
+    case Phase::kBasicStartupComplete:
+      return "basic-startup-complete";
+    case Phase::kPreSandboxStartup:
+      return "pre-sandbox-startup";
+    case Phase::kLoadResourceBundle:
+      return "load-resource-bundle";
+    case Phase::kPostEarlyInitialization:
+      return "post-early-initialization";
+    case Phase::kCreateNodeEnvironment:
+      return "create-node-environment";
+    case Phase::kLoadMainScript:
+      return "load-main-script";
+    case Phase::kPreMainMessageLoopRun:
+      return "pre-main-message-loop-run";
+    case Phase::kAppReady:
+      return "app-ready";
+    case Phase::kFirstBrowserWindowCreated:
+      return "first-browser-window-created";
+    case Phase::kFirstNavigationCommitted:
+      return "first-navigation-committed";
+    case Phase::kFirstNonEmptyLayout:
+      return "first-non-empty-layout";
+    case Phase::kFirstPaint:
+      return "first-paint";
+    case Phase::kInitializeExtensions:
+      return "initialize-extensions";
+    case Phase::kCreateNetworkQualityObserver:
+      return "create-network-quality-observer";
+  }
+  return "";
+}
+
+}  // namespace electron::startup_timeline
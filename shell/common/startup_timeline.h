@@ -0,0 +1,73 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace electron::startup_timeline {
+
+// The phases of starting the browser process, in the order they usually
+// happen. Only the first occurrence of each phase is recorded, so that the
+// ones for windows and renderers describe the first of them.
+enum class Phase {
+  kProcessStart,
+  kBasicStartupComplete,
+  kPreSandboxStartup,
+  kLoadResourceBundle,
+  kPostEarlyInitialization,
+  kCreateNodeEnvironment,
+  kLoadMainScript,
+  kPreMainMessageLoopRun,
+  kAppReady,
+  kFirstBrowserWindowCreated,
+  kFirstNavigationCommitted,
+  kFirstNonEmptyLayout,
+  kFirstPaint,
+  // Subsystems which are set up when first needed rather than before the
+  // ready event.
+  kInitializeExtensions,
+  kCreateNetworkQualityObserver,
+  kMaxValue = kCreateNetworkQualityObserver,
+};
+
+struct Entry {
+  Phase phase;
+  base::TimeTicks start_time;
+  // Same as |start_time| for phases which are a single point in time.
+  base::TimeTicks end_time;
+};
+
+// Can be called from any thread.
+void MarkStart(Phase phase, base::TimeTicks time = base::TimeTicks::Now());
+void MarkEnd(Phase phase, base::TimeTicks time = base::TimeTicks::Now());
+// Records a phase which is a single point in time.
+void Mark(Phase phase, base::TimeTicks time = base::TimeTicks::Now());
+
+// The phases recorded so far, ordered by start time. Phases which haven't
+// ended yet are left out.
+std::vector<Entry> GetEntries();
+
+const char* GetPhaseName(Phase phase);
+
+// Records the time taken by the enclosing scope as |phase|.
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(Phase phase) : phase_(phase) { MarkStart(phase_); }
+  ~ScopedPhase() { MarkEnd(phase_); }
+
+  // disable copy
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  const Phase phase_;
+};
+
+}  // namespace electron::startup_timeline
+
+#endif  // ELECTRON_SHELL_COMMON_STARTUP_TIMELINE_H_
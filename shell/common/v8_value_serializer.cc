@@ -4,16 +4,28 @@
 
 #include "shell/common/v8_value_serializer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bits.h"
+#include "base/containers/contains.h"
 #include "base/memory/raw_ptr.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread_local.h"
 #include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "skia/public/mojom/bitmap.mojom.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 #include "third_party/blink/public/common/messaging/web_message_port.h"
+#include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
 #include "ui/gfx/image/image_skia.h"
 #include "v8/include/v8.h"
 
@@ -21,23 +33,301 @@ namespace electron {
 
 namespace {
 enum SerializationTag {
+  kArrayBufferViewTag = 'V',
   kNativeImageTag = 'i',
   kTrailerOffsetTag = 0xFE,
   kVersionTag = 0xFF
 };
+
+using ArrayBufferContents =
+    std::vector<blink::mojom::SerializedArrayBufferContentsPtr>;
+
+// The kinds of ArrayBufferViews, with the same subtags as V8 uses for them.
+#define ELECTRON_TYPED_ARRAYS(V)          \
+  V(Int8Array, int8_t, 'b')               \
+  V(Uint8Array, uint8_t, 'B')             \
+  V(Uint8ClampedArray, uint8_t, 'C')      \
+  V(Int16Array, int16_t, 'w')             \
+  V(Uint16Array, uint16_t, 'W')           \
+  V(Int32Array, int32_t, 'd')             \
+  V(Uint32Array, uint32_t, 'D')           \
+  V(Float32Array, float, 'f')             \
+  V(Float64Array, double, 'F')            \
+  V(BigInt64Array, int64_t, 'q')          \
+  V(BigUint64Array, uint64_t, 'Q')
+
+constexpr uint8_t kDataViewSubtag = '?';
+
+bool GetArrayBufferViewSubtag(v8::Local<v8::ArrayBufferView> view,
+                              uint8_t* subtag) {
+#define GET_SUBTAG(Type, ctype, tag) \
+  if (view->Is##Type()) {            \
+    *subtag = tag;                   \
+    return true;                     \
+  }
+  ELECTRON_TYPED_ARRAYS(GET_SUBTAG)
+#undef GET_SUBTAG
+  if (view->IsDataView()) {
+    *subtag = kDataViewSubtag;
+    return true;
+  }
+  return false;
+}
+
+constexpr uint32_t kBlinkWireFormatVersion = 19;
+
+// Reuses the memory messages are encoded into, one pool per thread. Small
+// messages are written into a scratch buffer that is kept around and copied
+// out at their final size. Bigger ones get a buffer reserved for the size of
+// recent messages, so that it doesn't keep growing while the value is
+// written, and are handed over without a copy.
+class EncodeBufferPool {
+ public:
+  static constexpr size_t kMinBufferSize = 256;
+  static constexpr size_t kMaxScratchSize = 64 * 1024;
+  static constexpr size_t kMaxReservedSize = 8 * 1024 * 1024;
+
+  static EncodeBufferPool* GetCurrent() {
+    static base::NoDestructor<base::ThreadLocalOwnedPointer<EncodeBufferPool>>
+        lazy_tls;
+    if (!lazy_tls->Get())
+      lazy_tls->Set(std::make_unique<EncodeBufferPool>());
+    return lazy_tls->Get();
+  }
+
+  std::vector<uint8_t> Acquire(bool* is_scratch) {
+    size_t size = std::clamp(recent_size_, kMinBufferSize, kMaxReservedSize);
+    size = size_t{1} << base::bits::Log2Ceiling(static_cast<uint32_t>(size));
+    std::vector<uint8_t> buffer;
+    // A getter run while serializing may send a message of its own, in which
+    // case the scratch buffer is already taken.
+    *is_scratch = !scratch_in_use_ && size <= kMaxScratchSize;
+    if (*is_scratch) {
+      scratch_in_use_ = true;
+      buffer = std::move(scratch_);
+      buffer.clear();
+    }
+    buffer.reserve(size);
+    return buffer;
+  }
+
+  // Moves the first |size| bytes written to |buffer| into |out|.
+  void Release(std::vector<uint8_t> buffer,
+               bool is_scratch,
+               size_t size,
+               std::vector<uint8_t>* out) {
+    // Remembers the largest recent message, forgetting it bit by bit.
+    recent_size_ = std::max(size, recent_size_ - recent_size_ / 8);
+    DCHECK_LE(size, buffer.size());
+    buffer.resize(size);
+    if (!is_scratch || buffer.capacity() > kMaxScratchSize) {
+      Discard({}, is_scratch);
+      *out = std::move(buffer);
+      return;
+    }
+    out->assign(buffer.begin(), buffer.end());
+    Discard(std::move(buffer), is_scratch);
+  }
+
+  void Discard(std::vector<uint8_t> buffer, bool is_scratch) {
+    if (!is_scratch)
+      return;
+    scratch_in_use_ = false;
+    if (buffer.capacity() <= kMaxScratchSize)
+      scratch_ = std::move(buffer);
+  }
+
+ private:
+  std::vector<uint8_t> scratch_;
+  bool scratch_in_use_ = false;
+  size_t recent_size_ = 0;
+};
+
+// A buffer from the current thread's EncodeBufferPool, given back to it when
+// this goes away.
+class EncodeBuffer {
+ public:
+  EncodeBuffer()
+      : pool_(EncodeBufferPool::GetCurrent()),
+        data_(pool_->Acquire(&is_scratch_)) {}
+  ~EncodeBuffer() {
+    if (pool_)
+      pool_->Discard(std::move(data_), is_scratch_);
+  }
+
+  // disable copy
+  EncodeBuffer(const EncodeBuffer&) = delete;
+  EncodeBuffer& operator=(const EncodeBuffer&) = delete;
+
+  std::vector<uint8_t>& data() { return data_; }
+
+  // Makes the first |size| bytes the encoded message of |out|.
+  void MoveTo(size_t size, blink::CloneableMessage* out) {
+    DCHECK(pool_);
+    pool_->Release(std::move(data_), is_scratch_, size,
+                   &out->owned_encoded_message);
+    pool_ = nullptr;
+    out->encoded_message = out->owned_encoded_message;
+    out->sender_agent_cluster_id =
+        blink::WebMessagePort::GetEmbedderAgentClusterID();
+  }
+
+ private:
+  raw_ptr<EncodeBufferPool> pool_;
+  bool is_scratch_ = false;
+  std::vector<uint8_t> data_;
+};
+
+// Encodes IPC argument lists made up only of strings, numbers, booleans, null
+// and undefined, which most of them are, into the same wire format as
+// V8Serializer without going through v8::ValueSerializer.
+class PrimitiveArgumentsWriter {
+ public:
+  PrimitiveArgumentsWriter(v8::Isolate* isolate, std::vector<uint8_t>* out)
+      : isolate_(isolate), out_(out) {}
+
+  // Returns false if |args| is not such a list, after which |out| holds
+  // garbage.
+  bool Write(v8::Local<v8::Value> args) {
+    if (!args->IsArray())
+      return false;
+    v8::Local<v8::Array> array = args.As<v8::Array>();
+    v8::Local<v8::Context> context = isolate_->GetCurrentContext();
+    const uint32_t length = array->Length();
+
+    WriteTag(kVersionTag);
+    WriteVarint(kBlinkWireFormatVersion);
+    WriteTag(kVersionTag);
+    WriteVarint(kV8WireFormatVersion);
+    WriteTag(kBeginDenseArrayTag);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      if (!array->Get(context, i).ToLocal(&element) || !WriteValue(element))
+        return false;
+    }
+    WriteTag(kEndDenseArrayTag);
+    WriteVarint(0);  // properties
+    WriteVarint(length);
+    return true;
+  }
+
+ private:
+  // The tags v8::ValueSerializer uses for these values, see
+  // v8/src/objects/value-serializer.cc.
+  enum Tag : uint8_t {
+    kPaddingTag = '\0',
+    kUndefinedTag = '_',
+    kNullTag = '0',
+    kTrueTag = 'T',
+    kFalseTag = 'F',
+    kInt32Tag = 'I',
+    kDoubleTag = 'N',
+    kOneByteStringTag = '"',
+    kTwoByteStringTag = 'c',
+    kBeginDenseArrayTag = 'A',
+    kEndDenseArrayTag = '$',
+  };
+  // The oldest version of V8's format that encodes all of the above in the
+  // same way as the current one.
+  static constexpr uint32_t kV8WireFormatVersion = 13;
+
+  bool WriteValue(v8::Local<v8::Value> value) {
+    if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsInt32()) {
+      WriteTag(kInt32Tag);
+      const int32_t number = value.As<v8::Int32>()->Value();
+      WriteVarint((static_cast<uint32_t>(number) << 1) ^
+                  static_cast<uint32_t>(number >> 31));
+    } else if (value->IsNumber()) {
+      WriteTag(kDoubleTag);
+      const double number = value.As<v8::Number>()->Value();
+      memcpy(Grow(sizeof(number)), &number, sizeof(number));
+    } else if (value->IsTrue()) {
+      WriteTag(kTrueTag);
+    } else if (value->IsFalse()) {
+      WriteTag(kFalseTag);
+    } else if (value->IsNull()) {
+      WriteTag(kNullTag);
+    } else if (value->IsUndefined()) {
+      WriteTag(kUndefinedTag);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    const int length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(kOneByteStringTag);
+      WriteVarint(length);
+      string->WriteOneByte(isolate_, Grow(length), 0, length,
+                           v8::String::NO_NULL_TERMINATION);
+      return;
+    }
+    const uint32_t byte_length = length * sizeof(uint16_t);
+    // Like V8, keep the characters two byte aligned.
+    size_t varint_size = 1;
+    for (uint32_t v = byte_length; v >= 0x80; v >>= 7)
+      ++varint_size;
+    if ((out_->size() + 1 + varint_size) & 1)
+      WriteTag(kPaddingTag);
+    WriteTag(kTwoByteStringTag);
+    WriteVarint(byte_length);
+    string->Write(isolate_, reinterpret_cast<uint16_t*>(Grow(byte_length)), 0,
+                  length, v8::String::NO_NULL_TERMINATION);
+  }
+
+  void WriteTag(uint8_t tag) { out_->push_back(tag); }
+
+  void WriteVarint(uint32_t value) {
+    for (; value >= 0x80; value >>= 7)
+      out_->push_back(static_cast<uint8_t>(value) | 0x80);
+    out_->push_back(static_cast<uint8_t>(value));
+  }
+
+  uint8_t* Grow(size_t size) {
+    out_->resize(out_->size() + size);
+    return out_->data() + out_->size() - size;
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  raw_ptr<std::vector<uint8_t>> out_;
+};
+
+bool SerializePrimitiveArguments(v8::Isolate* isolate,
+                                 v8::Local<v8::Value> args,
+                                 blink::CloneableMessage* out) {
+  EncodeBuffer buffer;
+  if (!PrimitiveArgumentsWriter(isolate, &buffer.data()).Write(args))
+    return false;
+  buffer.MoveTo(buffer.data().size(), out);
+  return true;
+}
+
 }  // namespace
 
 class V8Serializer : public v8::ValueSerializer::Delegate {
  public:
-  explicit V8Serializer(v8::Isolate* isolate)
-      : isolate_(isolate), serializer_(isolate, this) {}
+  // When |array_buffer_contents| is set, large buffers of ArrayBufferViews are
+  // added to it instead of being written inline.
+  explicit V8Serializer(v8::Isolate* isolate,
+                        ArrayBufferContents* array_buffer_contents = nullptr)
+      : isolate_(isolate),
+        serializer_(isolate, this),
+        array_buffer_contents_(array_buffer_contents) {
+    if (array_buffer_contents_)
+      serializer_.SetTreatArrayBufferViewsAsHostObjects(true);
+  }
   ~V8Serializer() override = default;
 
   bool Serialize(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
     gin_helper::MicrotasksScope microtasks_scope(
         isolate_, isolate_->GetCurrentContext()->GetMicrotaskQueue(),
         v8::MicrotasksScope::kDoNotRunMicrotasks);
-    WriteBlinkEnvelope(19);
+    WriteBlinkEnvelope(kBlinkWireFormatVersion);
 
     serializer_.WriteHeader();
     bool wrote_value;
@@ -50,11 +340,8 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
     DCHECK(wrote_value);
 
     std::pair<uint8_t*, size_t> buffer = serializer_.Release();
-    DCHECK_EQ(buffer.first, data_.data());
-    out->encoded_message = base::make_span(buffer.first, buffer.second);
-    out->owned_encoded_message = std::move(data_);
-    out->sender_agent_cluster_id =
-        blink::WebMessagePort::GetEmbedderAgentClusterID();
+    DCHECK_EQ(buffer.first, buffer_.data().data());
+    buffer_.MoveTo(buffer.second, out);
 
     return true;
   }
@@ -63,19 +350,30 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   void* ReallocateBufferMemory(void* old_buffer,
                                size_t size,
                                size_t* actual_size) override {
-    DCHECK_EQ(old_buffer, data_.data());
-    data_.resize(size);
-    *actual_size = data_.capacity();
-    return data_.data();
+    std::vector<uint8_t>& data = buffer_.data();
+    DCHECK(!old_buffer || old_buffer == data.data());
+    data.resize(size);
+    *actual_size = data.capacity();
+    return data.data();
   }
 
   void FreeBufferMemory(void* buffer) override {
-    DCHECK_EQ(buffer, data_.data());
-    data_ = {};
+    // |buffer_| gives the memory back to the pool when it goes away.
+    DCHECK_EQ(buffer, buffer_.data().data());
   }
 
+  // Writes |buffer| as a reference to the |id|th ArrayBuffer of the message
+  // instead of its contents.
+  void TransferArrayBuffer(uint32_t id, v8::Local<v8::ArrayBuffer> buffer) {
+    serializer_.TransferArrayBuffer(id, buffer);
+  }
+
+  // v8::ValueSerializer::Delegate
   v8::Maybe<bool> WriteHostObject(v8::Isolate* isolate,
                                   v8::Local<v8::Object> object) override {
+    if (array_buffer_contents_ && object->IsArrayBufferView())
+      return WriteArrayBufferView(object.As<v8::ArrayBufferView>());
+
     api::NativeImage* native_image;
     if (gin::ConvertFromV8(isolate, object, &native_image)) {
       // Serialize the NativeImage
@@ -104,6 +402,37 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
  private:
   void WriteTag(SerializationTag tag) { serializer_.WriteRawBytes(&tag, 1); }
 
+  // Views are written as their buffer, which V8 serializes as usual unless it
+  // is big enough to be carried out of line, followed by the view's type and
+  // range.
+  v8::Maybe<bool> WriteArrayBufferView(v8::Local<v8::ArrayBufferView> view) {
+    uint8_t subtag;
+    if (!GetArrayBufferViewSubtag(view, &subtag))
+      return v8::ValueSerializer::Delegate::WriteHostObject(isolate_, view);
+
+    v8::Local<v8::ArrayBuffer> buffer = view->Buffer();
+    if (buffer->ByteLength() >= kOutOfLineArrayBufferThreshold &&
+        !base::Contains(out_of_line_buffers_, buffer)) {
+      serializer_.TransferArrayBuffer(out_of_line_buffers_.size(), buffer);
+      out_of_line_buffers_.push_back(buffer);
+      auto backing_store = buffer->GetBackingStore();
+      auto contents = blink::mojom::SerializedArrayBufferContents::New();
+      contents->contents = mojo_base::BigBuffer(
+          base::make_span(static_cast<const uint8_t*>(backing_store->Data()),
+                          backing_store->ByteLength()));
+      array_buffer_contents_->push_back(std::move(contents));
+    }
+
+    WriteTag(kArrayBufferViewTag);
+    if (serializer_.WriteValue(isolate_->GetCurrentContext(), buffer)
+            .IsNothing())
+      return v8::Nothing<bool>();
+    serializer_.WriteRawBytes(&subtag, 1);
+    serializer_.WriteUint64(view->ByteOffset());
+    serializer_.WriteUint64(view->ByteLength());
+    return v8::Just(true);
+  }
+
   void WriteBlinkEnvelope(uint32_t blink_version) {
     // Write a dummy blink version envelope for compatibility with
     // blink::V8ScriptValueSerializer
@@ -112,15 +441,20 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   }
 
   raw_ptr<v8::Isolate> isolate_;
-  std::vector<uint8_t> data_;
+  EncodeBuffer buffer_;
   v8::ValueSerializer serializer_;
+  raw_ptr<ArrayBufferContents> array_buffer_contents_;
+  std::vector<v8::Local<v8::ArrayBuffer>> out_of_line_buffers_;
 };
 
 class V8Deserializer : public v8::ValueDeserializer::Delegate {
  public:
-  V8Deserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
+  V8Deserializer(v8::Isolate* isolate,
+                 base::span<const uint8_t> data,
+                 ArrayBufferContents* array_buffer_contents = nullptr)
       : isolate_(isolate),
-        deserializer_(isolate, data.data(), data.size(), this) {}
+        deserializer_(isolate, data.data(), data.size(), this),
+        array_buffer_contents_(array_buffer_contents) {}
   V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
       : V8Deserializer(isolate, message.encoded_message) {}
 
@@ -136,6 +470,8 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     if (!deserializer_.ReadHeader(context).To(&read_header))
       return v8::Null(isolate_);
     DCHECK(read_header);
+    if (array_buffer_contents_)
+      TransferArrayBuffers();
     v8::Local<v8::Value> value;
     if (!deserializer_.ReadValue(context).ToLocal(&value))
       return v8::Null(isolate_);
@@ -151,6 +487,8 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
         if (api::NativeImage* native_image = ReadNativeImage(isolate))
           return native_image->GetWrapper(isolate);
         break;
+      case kArrayBufferViewTag:
+        return ReadArrayBufferView(isolate);
     }
     // Throws an exception.
     return v8::ValueDeserializer::Delegate::ReadHostObject(isolate);
@@ -165,6 +503,52 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     return true;
   }
 
+  // The memory cage doesn't let ArrayBuffers wrap the shared memory that the
+  // contents arrived in, so this is the one copy made on this side.
+  void TransferArrayBuffers() {
+    for (size_t i = 0; i < array_buffer_contents_->size(); ++i) {
+      mojo_base::BigBuffer contents =
+          std::move((*array_buffer_contents_)[i]->contents);
+      v8::Local<v8::ArrayBuffer> buffer =
+          v8::ArrayBuffer::New(isolate_, contents.size());
+      if (contents.size())
+        memcpy(buffer->GetBackingStore()->Data(), contents.data(),
+               contents.size());
+      deserializer_.TransferArrayBuffer(i, buffer);
+    }
+    array_buffer_contents_->clear();
+  }
+
+  v8::MaybeLocal<v8::Object> ReadArrayBufferView(v8::Isolate* isolate) {
+    v8::Local<v8::Value> value;
+    if (!deserializer_.ReadValue(isolate->GetCurrentContext())
+             .ToLocal(&value) ||
+        !value->IsArrayBuffer())
+      return {};
+    v8::Local<v8::ArrayBuffer> buffer = value.As<v8::ArrayBuffer>();
+    uint8_t subtag = 0;
+    uint64_t byte_offset = 0;
+    uint64_t byte_length = 0;
+    if (!ReadTag(&subtag) || !deserializer_.ReadUint64(&byte_offset) ||
+        !deserializer_.ReadUint64(&byte_length) ||
+        byte_offset > buffer->ByteLength() ||
+        byte_length > buffer->ByteLength() - byte_offset)
+      return {};
+
+    switch (subtag) {
+#define NEW_TYPED_ARRAY(Type, ctype, tag)                                 \
+  case tag:                                                               \
+    if (byte_offset % sizeof(ctype) || byte_length % sizeof(ctype))       \
+      return {};                                                          \
+    return v8::Type::New(buffer, byte_offset, byte_length / sizeof(ctype));
+      ELECTRON_TYPED_ARRAYS(NEW_TYPED_ARRAY)
+#undef NEW_TYPED_ARRAY
+      case kDataViewSubtag:
+        return v8::DataView::New(buffer, byte_offset, byte_length);
+    }
+    return {};
+  }
+
   bool ReadBlinkEnvelope(uint32_t* blink_version) {
     // Read a dummy blink version envelope for compatibility with
     // blink::V8ScriptValueDeserializer
@@ -220,6 +604,7 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
 
   raw_ptr<v8::Isolate> isolate_;
   v8::ValueDeserializer deserializer_;
+  raw_ptr<ArrayBufferContents> array_buffer_contents_;
 };
 
 bool SerializeV8Value(v8::Isolate* isolate,
@@ -238,4 +623,77 @@ v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
   return V8Deserializer(isolate, data).Deserialize();
 }
 
+bool SerializeV8ValueWithTransfer(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer,
+    blink::TransferableMessage* out) {
+  for (size_t i = 0; i < transfer.size(); ++i) {
+    const std::string index = base::NumberToString(i);
+    if (!transfer[i]->IsDetachable()) {
+      isolate->ThrowException(v8::Exception::Error(gin::StringToV8(
+          isolate, "ArrayBuffer at index " + index + " can't be detached.")));
+      return false;
+    }
+    if (std::find(transfer.begin(), transfer.begin() + i, transfer[i]) !=
+        transfer.begin() + i) {
+      isolate->ThrowException(v8::Exception::Error(gin::StringToV8(
+          isolate, "ArrayBuffer at index " + index + " is a duplicate.")));
+      return false;
+    }
+  }
+
+  V8Serializer serializer(isolate);
+  for (size_t i = 0; i < transfer.size(); ++i)
+    serializer.TransferArrayBuffer(i, transfer[i]);
+  if (!serializer.Serialize(value, out))
+    return false;
+
+  // Like blink::SerializedScriptValue, the contents are moved to the message
+  // and the buffers are left detached.
+  out->array_buffer_contents_array.clear();
+  for (v8::Local<v8::ArrayBuffer> buffer : transfer) {
+    auto backing_store = buffer->GetBackingStore();
+    auto contents = blink::mojom::SerializedArrayBufferContents::New();
+    contents->contents = mojo_base::BigBuffer(
+        base::make_span(static_cast<const uint8_t*>(backing_store->Data()),
+                        backing_store->ByteLength()));
+    out->array_buffer_contents_array.push_back(std::move(contents));
+    if (buffer->Detach(v8::Local<v8::Value>()).IsNothing())
+      return false;
+  }
+  return true;
+}
+
+bool SerializeV8ValueWithArrayBuffers(v8::Isolate* isolate,
+                                      v8::Local<v8::Value> value,
+                                      blink::TransferableMessage* out) {
+  out->array_buffer_contents_array.clear();
+  return V8Serializer(isolate, &out->array_buffer_contents_array)
+      .Serialize(value, out);
+}
+
+v8::Local<v8::Value> DeserializeV8ValueWithArrayBuffers(
+    v8::Isolate* isolate,
+    blink::TransferableMessage* in) {
+  return V8Deserializer(isolate, in->encoded_message,
+                        &in->array_buffer_contents_array)
+      .Deserialize();
+}
+
+bool SerializeV8Arguments(v8::Isolate* isolate,
+                          v8::Local<v8::Value> args,
+                          blink::CloneableMessage* out) {
+  return SerializePrimitiveArguments(isolate, args, out) ||
+         SerializeV8Value(isolate, args, out);
+}
+
+bool SerializeV8ArgumentsWithArrayBuffers(v8::Isolate* isolate,
+                                          v8::Local<v8::Value> args,
+                                          blink::TransferableMessage* out) {
+  out->array_buffer_contents_array.clear();
+  return SerializePrimitiveArguments(isolate, args, out) ||
+         SerializeV8ValueWithArrayBuffers(isolate, args, out);
+}
+
 }  // namespace electron
@@ -5,10 +5,13 @@
 #ifndef ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 #define ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 
+#include <vector>
+
 #include "base/containers/span.h"
 #include "ui/gfx/image/image_skia_rep.h"
 
 namespace v8 {
+class ArrayBuffer;
 class Isolate;
 template <class T>
 class Local;
@@ -17,7 +20,8 @@ class Value;
 
 namespace blink {
 struct CloneableMessage;
-}
+struct TransferableMessage;
+}  // namespace blink
 
 namespace electron {
 
@@ -29,6 +33,47 @@ v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data);
 
+// The buffers of typed arrays and DataViews of at least this many bytes are
+// carried out of line by SerializeV8ValueWithArrayBuffers().
+inline constexpr size_t kOutOfLineArrayBufferThreshold = 256 * 1024;
+
+// Like SerializeV8Value(), but the contents of large ArrayBuffers viewed by
+// typed arrays (including Buffers) and DataViews go in
+// |out->array_buffer_contents_array| instead of the encoded message. They are
+// copied once, straight into a mojo BigBuffer which mojo sends through shared
+// memory, rather than into the encoded message that is copied again on its way
+// to the other process. The ArrayBuffers are not detached.
+bool SerializeV8ValueWithArrayBuffers(v8::Isolate* isolate,
+                                      v8::Local<v8::Value> value,
+                                      blink::TransferableMessage* out);
+// Like SerializeV8Value(), but the ArrayBuffers in |transfer| are
+// transferred as with the transfer list of window.postMessage(): their
+// contents go in |out->array_buffer_contents_array|, through shared memory,
+// and they are detached. Throws if one of them can't be transferred.
+bool SerializeV8ValueWithTransfer(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer,
+    blink::TransferableMessage* out);
+// Counterpart of SerializeV8ValueWithArrayBuffers() and
+// SerializeV8ValueWithTransfer(). Consumes the array buffer contents of |in|.
+v8::Local<v8::Value> DeserializeV8ValueWithArrayBuffers(
+    v8::Isolate* isolate,
+    blink::TransferableMessage* in);
+
+// Like SerializeV8Value() and SerializeV8ValueWithArrayBuffers(), for the
+// array of arguments of an IPC message. Lists made up only of strings,
+// numbers, booleans, null and undefined are encoded without going through
+// v8::ValueSerializer. The elements of |args| may be read twice, so it must be
+// an array created by Electron, such as the one for a rest parameter, that
+// can't have getters on it.
+bool SerializeV8Arguments(v8::Isolate* isolate,
+                          v8::Local<v8::Value> args,
+                          blink::CloneableMessage* out);
+bool SerializeV8ArgumentsWithArrayBuffers(v8::Isolate* isolate,
+                                          v8::Local<v8::Value> args,
+                                          blink::TransferableMessage* out);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
@@ -4,6 +4,7 @@
 
 #include "shell/renderer/api/electron_api_context_bridge.h"
 
+#include <cstring>
 #include <memory>
 #include <set>
 #include <string>
@@ -47,6 +48,15 @@ const char kProxyFunctionPrivateKey[] = "electron_contextBridge_proxy_fn";
 const char kSupportsDynamicPropertiesPrivateKey[] =
     "electron_contextBridge_supportsDynamicProperties";
 const char kOriginalFunctionPrivateKey[] = "electron_contextBridge_original_fn";
+// The last proxy made for a function, one key for each value of
+// support_dynamic_properties since it is baked into the proxy.
+const char kCachedProxyFunctionPrivateKey[] =
+    "electron_contextBridge_cached_fn";
+const char kCachedDynamicProxyFunctionPrivateKey[] =
+    "electron_contextBridge_cached_dynamic_fn";
+// The value behind a key of a lazily exposed API, until it is first read.
+const char kLazyValuePrivateKey[] = "electron_contextBridge_lazy_value";
+const char kLazyProxyPrivateKey[] = "electron_contextBridge_lazy_proxy";
 
 }  // namespace context_bridge
 
@@ -103,6 +113,16 @@ bool IsPlainObject(const v8::Local<v8::Value>& object) {
            object->IsModuleNamespaceObject() || object->IsProxy());
 }
 
+// Certain primitives always use the current contexts prototype and we can
+// pass these through directly which is significantly more performant than
+// copying them. This list of primitives is based on the classification of
+// "primitive value" as defined in the ECMA262 spec
+// https://tc39.es/ecma262/#sec-primitive-value
+bool IsPrimitive(const v8::Local<v8::Value>& value) {
+  return value->IsString() || value->IsNumber() || value->IsNullOrUndefined() ||
+         value->IsBoolean() || value->IsSymbol() || value->IsBigInt();
+}
+
 bool IsPlainArray(const v8::Local<v8::Value>& arr) {
   if (!arr->IsArray())
     return false;
@@ -110,6 +130,52 @@ bool IsPlainArray(const v8::Local<v8::Value>& arr) {
   return !arr->IsTypedArray();
 }
 
+// Copies all of |source| into a new ArrayBuffer in the current context, or
+// returns the copy made earlier in the same call when views share a buffer.
+v8::Local<v8::ArrayBuffer> CopyArrayBuffer(
+    v8::Isolate* isolate,
+    v8::Local<v8::ArrayBuffer> source,
+    context_bridge::ObjectCache* object_cache) {
+  v8::Local<v8::Value> cached;
+  if (object_cache->GetCachedProxiedObject(source).ToLocal(&cached))
+    return cached.As<v8::ArrayBuffer>();
+  const size_t length = source->ByteLength();
+  v8::Local<v8::ArrayBuffer> copy = v8::ArrayBuffer::New(isolate, length);
+  if (length)
+    memcpy(copy->Data(), source->Data(), length);
+  object_cache->CacheProxiedObject(source, copy);
+  return copy;
+}
+
+// A view of the same type, offset and length as |source| on |buffer|.
+v8::Local<v8::TypedArray> NewTypedArrayLike(v8::Local<v8::TypedArray> source,
+                                            v8::Local<v8::ArrayBuffer> buffer) {
+  const size_t offset = source->ByteOffset();
+  const size_t length = source->Length();
+  if (source->IsUint8Array())
+    return v8::Uint8Array::New(buffer, offset, length);
+  if (source->IsUint8ClampedArray())
+    return v8::Uint8ClampedArray::New(buffer, offset, length);
+  if (source->IsInt8Array())
+    return v8::Int8Array::New(buffer, offset, length);
+  if (source->IsUint16Array())
+    return v8::Uint16Array::New(buffer, offset, length);
+  if (source->IsInt16Array())
+    return v8::Int16Array::New(buffer, offset, length);
+  if (source->IsUint32Array())
+    return v8::Uint32Array::New(buffer, offset, length);
+  if (source->IsInt32Array())
+    return v8::Int32Array::New(buffer, offset, length);
+  if (source->IsFloat32Array())
+    return v8::Float32Array::New(buffer, offset, length);
+  if (source->IsFloat64Array())
+    return v8::Float64Array::New(buffer, offset, length);
+  if (source->IsBigInt64Array())
+    return v8::BigInt64Array::New(buffer, offset, length);
+  DCHECK(source->IsBigUint64Array());
+  return v8::BigUint64Array::New(buffer, offset, length);
+}
+
 void SetPrivate(v8::Local<v8::Context> context,
                 v8::Local<v8::Object> target,
                 const std::string& key,
@@ -155,15 +221,8 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     return v8::MaybeLocal<v8::Value>();
   }
 
-  // Certain primitives always use the current contexts prototype and we can
-  // pass these through directly which is significantly more performant than
-  // copying them. This list of primitives is based on the classification of
-  // "primitive value" as defined in the ECMA262 spec
-  // https://tc39.es/ecma262/#sec-primitive-value
-  if (value->IsString() || value->IsNumber() || value->IsNullOrUndefined() ||
-      value->IsBoolean() || value->IsSymbol() || value->IsBigInt()) {
+  if (IsPrimitive(value))
     return v8::MaybeLocal<v8::Value>(value);
-  }
 
   // Check Cache
   auto cached_value = object_cache->GetCachedProxiedObject(value);
@@ -195,6 +254,24 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         return v8::MaybeLocal<v8::Value>(proxy_func);
       }
 
+      // Functions that were already sent to the destination context reuse
+      // their proxy, instead of making a new one on every call that passes
+      // them. The proxy is kept on the function itself, so it lives exactly as
+      // long as the function does and no lookup table is needed. A function
+      // passed to another context replaces it, there are rarely more than two
+      // worlds in a frame.
+      const char* cache_key =
+          support_dynamic_properties
+              ? context_bridge::kCachedDynamicProxyFunctionPrivateKey
+              : context_bridge::kCachedProxyFunctionPrivateKey;
+      if (GetPrivate(source_context, func, cache_key).ToLocal(&proxy_func) &&
+          proxy_func->IsFunction() &&
+          proxy_func.As<v8::Object>()->GetCreationContextChecked() ==
+              destination_context) {
+        object_cache->CacheProxiedObject(value, proxy_func);
+        return v8::MaybeLocal<v8::Value>(proxy_func);
+      }
+
       v8::Local<v8::Object> state =
           v8::Object::New(destination_context->GetIsolate());
       SetPrivate(destination_context, state,
@@ -209,6 +286,13 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         return v8::MaybeLocal<v8::Value>();
       SetPrivate(destination_context, proxy_func.As<v8::Object>(),
                  context_bridge::kOriginalFunctionPrivateKey, func);
+      // Not checked, the cache is only an optimization.
+      std::ignore = func->SetPrivate(
+          source_context,
+          v8::Private::ForApi(source_context->GetIsolate(),
+                              gin::StringToV8(source_context->GetIsolate(),
+                                              cache_key)),
+          proxy_func);
       object_cache->CacheProxiedObject(value, proxy_func);
       return v8::MaybeLocal<v8::Value>(proxy_func);
     }
@@ -356,26 +440,54 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   if (IsPlainArray(value)) {
     v8::Context::Scope destination_context_scope(destination_context);
     v8::Local<v8::Array> arr = value.As<v8::Array>();
-    size_t length = arr->Length();
-    v8::Local<v8::Array> cloned_arr =
-        v8::Array::New(destination_context->GetIsolate(), length);
-    for (size_t i = 0; i < length; i++) {
-      auto value_for_array = PassValueToOtherContext(
-          source_context, destination_context,
-          arr->Get(source_context, i).ToLocalChecked(), object_cache,
-          support_dynamic_properties, recursion_depth + 1, error_target);
-      if (value_for_array.IsEmpty())
-        return v8::MaybeLocal<v8::Value>();
-
-      if (!IsTrue(cloned_arr->Set(destination_context, static_cast<int>(i),
-                                  value_for_array.ToLocalChecked()))) {
+    const uint32_t length = arr->Length();
+    // Elements are collected first so that the clone is made in bulk, which
+    // is much cheaper than setting its elements one by one. Primitives, the
+    // common case, are used as is.
+    std::vector<v8::Local<v8::Value>> elements;
+    elements.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+      v8::Local<v8::Value> element;
+      if (!arr->Get(source_context, i).ToLocal(&element))
         return v8::MaybeLocal<v8::Value>();
+      if (!IsPrimitive(element)) {
+        if (!PassValueToOtherContext(source_context, destination_context,
+                                     element, object_cache,
+                                     support_dynamic_properties,
+                                     recursion_depth + 1, error_target)
+                 .ToLocal(&element))
+          return v8::MaybeLocal<v8::Value>();
       }
+      elements.push_back(element);
     }
+    v8::Local<v8::Array> cloned_arr = v8::Array::New(
+        destination_context->GetIsolate(), elements.data(), elements.size());
     object_cache->CacheProxiedObject(value, cloned_arr);
     return v8::MaybeLocal<v8::Value>(cloned_arr);
   }
 
+  // ArrayBuffers and typed arrays are copied with a single memcpy instead of
+  // a round trip through the V8 serializer. Shared and resizable buffers are
+  // left to the serializer, which keeps them shared or resizable.
+  if (value->IsArrayBuffer() || value->IsTypedArray()) {
+    v8::Local<v8::ArrayBuffer> buffer =
+        value->IsArrayBuffer() ? value.As<v8::ArrayBuffer>()
+                               : value.As<v8::TypedArray>()->Buffer();
+    if (!buffer->IsSharedArrayBuffer() &&
+        !buffer->GetBackingStore()->IsResizableByUserJavaScript()) {
+      v8::Context::Scope destination_context_scope(destination_context);
+      v8::Local<v8::Value> cloned_value = CopyArrayBuffer(
+          destination_context->GetIsolate(), buffer, object_cache);
+      if (value->IsTypedArray()) {
+        auto view = value.As<v8::TypedArray>();
+        cloned_value =
+            NewTypedArrayLike(view, cloned_value.As<v8::ArrayBuffer>());
+      }
+      object_cache->CacheProxiedObject(value, cloned_value);
+      return v8::MaybeLocal<v8::Value>(cloned_value);
+    }
+  }
+
   // Custom logic to "clone" Element references
   blink::WebElement elem = blink::WebElement::FromV8Value(value);
   if (!elem.IsNull()) {
@@ -426,7 +538,8 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
 }
 
 void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
-  TRACE_EVENT0("electron", "ContextBridge::ProxyFunctionWrapper");
+  TRACE_EVENT1("electron", "ContextBridge::ProxyFunctionWrapper", "args",
+               info.Length());
   CHECK(info.Data()->IsObject());
   v8::Local<v8::Object> data = info.Data().As<v8::Object>();
   bool support_dynamic_properties = false;
@@ -632,6 +745,11 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
       if (!api.Get(key, &value))
         continue;
 
+      if (IsPrimitive(value)) {
+        proxy.Set(key, value);
+        continue;
+      }
+
       auto passed_value = PassValueToOtherContext(
           source_context, destination_context, value, object_cache,
           support_dynamic_properties, recursion_depth + 1, error_target);
@@ -644,10 +762,117 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
   }
 }
 
+namespace {
+
+// The getter of a key of an API exposed with { lazy: true }. The value is only
+// passed over the bridge, and frozen, the first time the key is read.
+void LazyAPIGetter(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  TRACE_EVENT0("electron", "ContextBridge::LazyAPIGetter");
+  CHECK(info.Data()->IsObject());
+  v8::Local<v8::Object> state = info.Data().As<v8::Object>();
+  v8::Local<v8::Context> destination_context =
+      state->GetCreationContextChecked();
+  v8::Local<v8::Value> proxy;
+  if (GetPrivate(destination_context, state,
+                 context_bridge::kLazyProxyPrivateKey)
+          .ToLocal(&proxy) &&
+      !proxy->IsUndefined()) {
+    info.GetReturnValue().Set(proxy);
+    return;
+  }
+
+  v8::Local<v8::Value> value;
+  if (!GetPrivate(destination_context, state,
+                  context_bridge::kLazyValuePrivateKey)
+           .ToLocal(&value) ||
+      !value->IsObject())
+    return;
+
+  {
+    context_bridge::ObjectCache object_cache;
+    v8::Context::Scope destination_context_scope(destination_context);
+    if (!PassValueToOtherContext(
+             value.As<v8::Object>()->GetCreationContextChecked(),
+             destination_context, value, &object_cache, false, 0,
+             BridgeErrorTarget::kDestination)
+             .ToLocal(&proxy))
+      return;
+    if (!base::FeatureList::IsEnabled(features::kContextBridgeMutability) &&
+        proxy->IsObject() && !proxy->IsTypedArray() &&
+        !DeepFreeze(proxy.As<v8::Object>(), destination_context))
+      return;
+    SetPrivate(destination_context, state,
+               context_bridge::kLazyProxyPrivateKey, proxy);
+    // The original is no longer needed, the proxy keeps what it uses alive.
+    std::ignore = state->DeletePrivate(
+        destination_context,
+        v8::Private::ForApi(
+            info.GetIsolate(),
+            gin::StringToV8(info.GetIsolate(),
+                            context_bridge::kLazyValuePrivateKey)));
+  }
+  info.GetReturnValue().Set(proxy);
+}
+
+// Exposes every enumerable own key of |api_object| through a getter that only
+// passes its value over the bridge when it is first read, see LazyAPIGetter.
+// Primitive values are copied right away since there is nothing to defer.
+v8::MaybeLocal<v8::Object> CreateLazyProxyForAPI(
+    v8::Local<v8::Object> api_object,
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context) {
+  v8::Isolate* isolate = destination_context->GetIsolate();
+  v8::Context::Scope destination_context_scope(destination_context);
+  v8::Local<v8::Object> proxy = v8::Object::New(isolate);
+  v8::Local<v8::Array> keys;
+  if (!api_object
+           ->GetOwnPropertyNames(
+               source_context,
+               static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE),
+               v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return v8::MaybeLocal<v8::Object>(proxy);
+
+  const bool configurable =
+      base::FeatureList::IsEnabled(features::kContextBridgeMutability);
+  for (uint32_t i = 0; i < keys->Length(); i++) {
+    v8::Local<v8::Value> key;
+    v8::Local<v8::Value> value;
+    if (!keys->Get(source_context, i).ToLocal(&key) ||
+        !api_object->Get(source_context, key).ToLocal(&value))
+      return v8::MaybeLocal<v8::Object>();
+
+    if (IsPrimitive(value)) {
+      if (!IsTrue(proxy->CreateDataProperty(destination_context,
+                                            key.As<v8::Name>(), value)))
+        return v8::MaybeLocal<v8::Object>();
+      continue;
+    }
+
+    v8::Local<v8::Object> state = v8::Object::New(isolate);
+    SetPrivate(destination_context, state,
+               context_bridge::kLazyValuePrivateKey, value);
+    v8::Local<v8::Function> getter;
+    if (!v8::Function::New(destination_context, LazyAPIGetter, state)
+             .ToLocal(&getter))
+      return v8::MaybeLocal<v8::Object>();
+    v8::PropertyDescriptor desc(getter, v8::Undefined(isolate));
+    desc.set_enumerable(true);
+    desc.set_configurable(configurable);
+    if (!IsTrue(proxy->DefineProperty(destination_context, key.As<v8::Name>(),
+                                      desc)))
+      return v8::MaybeLocal<v8::Object>();
+  }
+  return v8::MaybeLocal<v8::Object>(proxy);
+}
+
+}  // namespace
+
 void ExposeAPIInWorld(v8::Isolate* isolate,
                       const int world_id,
                       const std::string& key,
                       v8::Local<v8::Value> api,
+                      bool lazy,
                       gin_helper::Arguments* args) {
   TRACE_EVENT2("electron", "ContextBridge::ExposeAPIInWorld", "key", key,
                "worldId", world_id);
@@ -680,21 +905,39 @@ void ExposeAPIInWorld(v8::Isolate* isolate,
     context_bridge::ObjectCache object_cache;
     v8::Context::Scope target_context_scope(target_context);
 
-    v8::MaybeLocal<v8::Value> maybe_proxy = PassValueToOtherContext(
-        electron_isolated_context, target_context, api, &object_cache, false, 0,
-        BridgeErrorTarget::kSource);
-    if (maybe_proxy.IsEmpty())
+    // Only objects can be exposed lazily, other values are cheap to pass or,
+    // like functions, only proxied anyway.
+    lazy = lazy && IsPlainObject(api);
+    v8::Local<v8::Value> proxy;
+    if (lazy) {
+      v8::Local<v8::Object> lazy_proxy;
+      if (!CreateLazyProxyForAPI(api.As<v8::Object>(),
+                                 electron_isolated_context, target_context)
+               .ToLocal(&lazy_proxy))
+        return;
+      proxy = lazy_proxy;
+    } else if (!PassValueToOtherContext(electron_isolated_context,
+                                        target_context, api, &object_cache,
+                                        false, 0, BridgeErrorTarget::kSource)
+                    .ToLocal(&proxy)) {
       return;
-    auto proxy = maybe_proxy.ToLocalChecked();
+    }
 
     if (base::FeatureList::IsEnabled(features::kContextBridgeMutability)) {
       global.Set(key, proxy);
       return;
     }
 
-    if (proxy->IsObject() && !proxy->IsTypedArray() &&
-        !DeepFreeze(proxy.As<v8::Object>(), target_context))
+    // DeepFreeze() would read, and so pass, every lazy value. Their getters
+    // freeze them instead.
+    if (lazy) {
+      if (!IsTrue(proxy.As<v8::Object>()->SetIntegrityLevel(
+              target_context, v8::IntegrityLevel::kFrozen)))
+        return;
+    } else if (proxy->IsObject() && !proxy->IsTypedArray() &&
+               !DeepFreeze(proxy.As<v8::Object>(), target_context)) {
       return;
+    }
 
     global.SetReadOnlyNonConfigurable(key, proxy);
   }
@@ -2,15 +2,27 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
+#include "gin/data_object_builder.h"
 #include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -22,6 +34,8 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
+#include "third_party/blink/public/common/browser_interface_broker_proxy.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
 
@@ -41,6 +55,37 @@ RenderFrame* GetCurrentRenderFrame() {
   return RenderFrame::FromWebFrame(frame);
 }
 
+// Timing of a message whose arguments started being serialized at
+// |serialization_start|, for the main process's webContents.getIPCMetrics().
+electron::mojom::IPCMessageTimingPtr MakeTiming(
+    base::TimeTicks serialization_start) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  return electron::mojom::IPCMessageTiming::New(now,
+                                                now - serialization_start);
+}
+
+// How long a renderer was blocked waiting for the replies of one kind of
+// synchronous message.
+struct SyncStats {
+  void Add(base::TimeDelta blocked) {
+    ++count;
+    total += blocked;
+    max = std::max(max, blocked);
+  }
+
+  v8::Local<v8::Value> ToV8(v8::Isolate* isolate) const {
+    return gin::DataObjectBuilder(isolate)
+        .Set("count", count)
+        .Set("totalTime", total.InMicroseconds())
+        .Set("maxTime", max.InMicroseconds())
+        .Build();
+  }
+
+  uint64_t count = 0;
+  base::TimeDelta total;
+  base::TimeDelta max;
+};
+
 class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                     public content::RenderFrameObserver {
  public:
@@ -62,13 +107,22 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
         &electron_ipc_remote_);
   }
 
-  void OnDestruct() override { electron_ipc_remote_.reset(); }
+  void OnDestruct() override {
+    FlushBatch();
+    electron_ipc_remote_.reset();
+    sync_ipc_remote_.reset();
+    direct_channels_.clear();
+  }
 
   void WillReleaseScriptContext(v8::Local<v8::Context> context,
                                 int32_t world_id) override {
     if (weak_context_.IsEmpty() ||
-        weak_context_.Get(context->GetIsolate()) == context)
+        weak_context_.Get(context->GetIsolate()) == context) {
+      FlushBatch();
       electron_ipc_remote_.reset();
+      sync_ipc_remote_.reset();
+      direct_channels_.clear();
+    }
   }
 
   // gin::Wrappable:
@@ -76,11 +130,15 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       v8::Isolate* isolate) override {
     return gin::Wrappable<IPCRenderer>::GetObjectTemplateBuilder(isolate)
         .SetMethod("send", &IPCRenderer::SendMessage)
+        .SetMethod("sendJSON", &IPCRenderer::SendJSON)
         .SetMethod("sendSync", &IPCRenderer::SendSync)
+        .SetMethod("invokeSync", &IPCRenderer::InvokeSync)
+        .SetMethod("getSyncStats", &IPCRenderer::GetSyncStats)
         .SetMethod("sendTo", &IPCRenderer::SendTo)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
         .SetMethod("invoke", &IPCRenderer::Invoke)
-        .SetMethod("postMessage", &IPCRenderer::PostMessage);
+        .SetMethod("postMessage", &IPCRenderer::PostMessage)
+        .SetMethod("setBatching", &IPCRenderer::SetBatching);
   }
 
   const char* GetTypeName() override { return "IPCRenderer"; }
@@ -91,15 +149,82 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                    bool internal,
                    const std::string& channel,
                    v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendMessage", "channel", channel);
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
-    blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    blink::TransferableMessage message;
+    if (!electron::SerializeV8ArgumentsWithArrayBuffers(isolate, arguments,
+                                                         &message)) {
+      return;
+    }
+    // Time spent in the queue counts towards the queueing delay.
+    auto timing = MakeTiming(start);
+    if (batching_enabled_ && !internal) {
+      pending_batch_.push_back(electron::mojom::IPCMessage::New(
+          internal, channel, std::move(message), std::move(timing)));
+      ScheduleFlush();
       return;
     }
-    electron_ipc_remote_->Message(internal, channel, std::move(message));
+    FlushBatch();
+    electron_ipc_remote_->Message(internal, channel, std::move(message),
+                                  std::move(timing));
+  }
+
+  // Sends the JSON text |json| as UTF-8 bytes rather than as a structured
+  // clone, the main process only parses it when a listener reads it.
+  void SendJSON(v8::Isolate* isolate,
+                gin_helper::ErrorThrower thrower,
+                const std::string& channel,
+                v8::Local<v8::String> json) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendJSON", "channel", channel);
+    if (!electron_ipc_remote_) {
+      thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
+      return;
+    }
+    const base::TimeTicks start = base::TimeTicks::Now();
+    mojo_base::BigBuffer payload(json->Utf8Length(isolate));
+    json->WriteUtf8(isolate, reinterpret_cast<char*>(payload.data()),
+                    base::checked_cast<int>(payload.size()), nullptr,
+                    v8::String::NO_NULL_TERMINATION |
+                        v8::String::REPLACE_INVALID_UTF8);
+    auto timing = MakeTiming(start);
+    FlushBatch();
+    electron_ipc_remote_->MessageJSON(channel, std::move(payload),
+                                      std::move(timing));
+  }
+
+  // When enabled, ipcRenderer.send() messages are queued and sent to the main
+  // process together once the current task finishes, or after |delay_ms| if
+  // it is positive. Every other kind of message flushes the queue first so
+  // that the main process still sees messages in the order they were sent.
+  void SetBatching(bool enabled, absl::optional<double> delay_ms) {
+    batching_enabled_ = enabled;
+    batch_delay_ = base::Milliseconds(std::max(0.0, delay_ms.value_or(0)));
+    if (!enabled)
+      FlushBatch();
+  }
+
+  void ScheduleFlush() {
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
+    render_frame()
+        ->GetTaskRunner(blink::TaskType::kInternalDefault)
+        ->PostDelayedTask(FROM_HERE,
+                          base::BindOnce(&IPCRenderer::FlushBatch,
+                                         weak_factory_.GetWeakPtr()),
+                          batch_delay_);
+  }
+
+  void FlushBatch() {
+    flush_scheduled_ = false;
+    if (pending_batch_.empty() || !electron_ipc_remote_)
+      return;
+    electron_ipc_remote_->MessageBatch(std::move(pending_batch_));
+    pending_batch_.clear();
   }
 
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
@@ -107,22 +232,32 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                                 bool internal,
                                 const std::string& channel,
                                 v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::Invoke", "channel", channel);
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Promise>();
     }
+    const base::TimeTicks start = base::TimeTicks::Now();
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8Arguments(isolate, arguments, &message)) {
       return v8::Local<v8::Promise>();
     }
-    gin_helper::Promise<blink::CloneableMessage> p(isolate);
+    auto timing = MakeTiming(start);
+    FlushBatch();
+    gin_helper::Promise<v8::Local<v8::Value>> p(isolate);
     auto handle = p.GetHandle();
 
     electron_ipc_remote_->Invoke(
-        internal, channel, std::move(message),
+        internal, channel, std::move(message), std::move(timing),
         base::BindOnce(
-            [](gin_helper::Promise<blink::CloneableMessage> p,
-               blink::CloneableMessage result) { p.Resolve(result); },
+            [](gin_helper::Promise<v8::Local<v8::Value>> p,
+               blink::TransferableMessage result) {
+              v8::Isolate* isolate = p.isolate();
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(p.GetContext());
+              p.Resolve(electron::DeserializeV8ValueWithArrayBuffers(
+                  isolate, &result));
+            },
             std::move(p)));
 
     return handle;
@@ -164,6 +299,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       ports.emplace_back(port.value());
     }
 
+    FlushBatch();
     transferable_message.ports = std::move(ports);
     electron_ipc_remote_->ReceivePostMessage(channel,
                                              std::move(transferable_message));
@@ -174,16 +310,64 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
               int32_t web_contents_id,
               const std::string& channel,
               v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendTo", "channel", channel);
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
+    const base::TimeTicks start = base::TimeTicks::Now();
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8Arguments(isolate, arguments, &message)) {
+      return;
+    }
+    auto timing = MakeTiming(start);
+
+    // The first message to a WebContents goes through the main process,
+    // which is then asked for a direct channel to it. Messages sent until
+    // the channel arrives are held back, so that they can't overtake the
+    // ones sent before.
+    DirectChannel& direct = direct_channels_[web_contents_id];
+    if (direct.remote.is_bound() && !direct.remote.is_connected())
+      direct.remote.reset();
+    if (direct.remote) {
+      direct.remote->Message(channel, std::move(message));
       return;
     }
+    if (direct.opening) {
+      direct.pending.push_back(
+          {channel, std::move(message), std::move(timing)});
+      return;
+    }
+    FlushBatch();
     electron_ipc_remote_->MessageTo(web_contents_id, channel,
-                                    std::move(message));
+                                    std::move(message), std::move(timing));
+    direct.opening = true;
+    electron_ipc_remote_->OpenDirectChannel(
+        web_contents_id,
+        base::BindOnce(&IPCRenderer::OnDirectChannelOpened,
+                       weak_factory_.GetWeakPtr(), web_contents_id));
+  }
+
+  void OnDirectChannelOpened(
+      int32_t web_contents_id,
+      mojo::PendingRemote<electron::mojom::ElectronDirectIPC> remote) {
+    DirectChannel& direct = direct_channels_[web_contents_id];
+    direct.opening = false;
+    if (remote)
+      direct.remote.Bind(std::move(remote));
+    std::vector<PendingDirectMessage> pending;
+    pending.swap(direct.pending);
+    for (auto& message : pending) {
+      if (direct.remote) {
+        direct.remote->Message(message.channel, std::move(message.arguments));
+      } else if (electron_ipc_remote_) {
+        electron_ipc_remote_->MessageTo(web_contents_id, message.channel,
+                                        std::move(message.arguments),
+                                        std::move(message.timing));
+      }
+    }
+    if (!direct.remote)
+      direct_channels_.erase(web_contents_id);
   }
 
   void SendToHost(v8::Isolate* isolate,
@@ -195,9 +379,10 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return;
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8Arguments(isolate, arguments, &message)) {
       return;
     }
+    FlushBatch();
     electron_ipc_remote_->MessageHost(channel, std::move(message));
   }
 
@@ -206,23 +391,93 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
                                 bool internal,
                                 const std::string& channel,
                                 v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::SendSync", "channel", channel);
     if (!electron_ipc_remote_) {
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Value>();
     }
+    const base::TimeTicks start = base::TimeTicks::Now();
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8Arguments(isolate, arguments, &message)) {
       return v8::Local<v8::Value>();
     }
+    auto timing = MakeTiming(start);
 
-    blink::CloneableMessage result;
+    FlushBatch();
+    blink::TransferableMessage result;
+    const base::TimeTicks call_start = base::TimeTicks::Now();
     electron_ipc_remote_->MessageSync(internal, channel, std::move(message),
-                                      &result);
-    return electron::DeserializeV8Value(isolate, result);
+                                      std::move(timing), &result);
+    send_sync_stats_.Add(base::TimeTicks::Now() - call_start);
+    return electron::DeserializeV8ValueWithArrayBuffers(isolate, &result);
+  }
+
+  v8::Local<v8::Value> InvokeSync(v8::Isolate* isolate,
+                                  gin_helper::ErrorThrower thrower,
+                                  const std::string& channel,
+                                  v8::Local<v8::Value> arguments) {
+    TRACE_EVENT1("electron", "IPCRenderer::InvokeSync", "channel", channel);
+    if (!electron_ipc_remote_) {
+      thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
+      return v8::Local<v8::Value>();
+    }
+    blink::CloneableMessage message;
+    if (!electron::SerializeV8Arguments(isolate, arguments, &message)) {
+      return v8::Local<v8::Value>();
+    }
+    if (!sync_ipc_remote_) {
+      render_frame()->GetBrowserInterfaceBroker()->GetInterface(
+          sync_ipc_remote_.BindNewPipeAndPassReceiver());
+    }
+
+    FlushBatch();
+    blink::TransferableMessage result;
+    const base::TimeTicks call_start = base::TimeTicks::Now();
+    if (!sync_ipc_remote_->Invoke(channel, std::move(message), &result)) {
+      thrower.ThrowError("Lost connection to the main process");
+      return v8::Local<v8::Value>();
+    }
+    invoke_sync_stats_.Add(base::TimeTicks::Now() - call_start);
+    return electron::DeserializeV8ValueWithArrayBuffers(isolate, &result);
+  }
+
+  v8::Local<v8::Value> GetSyncStats(v8::Isolate* isolate) const {
+    return gin::DataObjectBuilder(isolate)
+        .Set("sendSync", send_sync_stats_.ToV8(isolate))
+        .Set("invokeSync", invoke_sync_stats_.ToV8(isolate))
+        .Build();
   }
 
   v8::Global<v8::Context> weak_context_;
   mojo::AssociatedRemote<electron::mojom::ElectronApiIPC> electron_ipc_remote_;
+  // Not associated with |electron_ipc_remote_|, so that its messages are
+  // answered off the browser UI thread, see mojom::ElectronSyncIPC.
+  mojo::Remote<electron::mojom::ElectronSyncIPC> sync_ipc_remote_;
+
+  // ipcRenderer.sendTo() messages are sent directly to their target once the
+  // main process connected this frame to it, see
+  // mojom::ElectronApiIPC::OpenDirectChannel().
+  struct PendingDirectMessage {
+    std::string channel;
+    blink::CloneableMessage arguments;
+    electron::mojom::IPCMessageTimingPtr timing;
+  };
+  struct DirectChannel {
+    mojo::Remote<electron::mojom::ElectronDirectIPC> remote;
+    bool opening = false;
+    std::vector<PendingDirectMessage> pending;
+  };
+  std::map<int32_t, DirectChannel> direct_channels_;
+
+  SyncStats send_sync_stats_;
+  SyncStats invoke_sync_stats_;
+
+  bool batching_enabled_ = false;
+  bool flush_scheduled_ = false;
+  base::TimeDelta batch_delay_;
+  std::vector<electron::mojom::IPCMessagePtr> pending_batch_;
+
+  base::WeakPtrFactory<IPCRenderer> weak_factory_{this};
 };
 
 gin::WrapperInfo IPCRenderer::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -6,15 +6,15 @@
 
 #include <iterator>
 #include <memory>
-#include <set>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "base/containers/contains.h"
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
-#include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "components/spellcheck/renderer/spellcheck_worditerator.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template.h"
@@ -27,6 +27,9 @@ namespace electron::api {
 
 namespace {
 
+// The number of words whose spelling is remembered.
+constexpr size_t kWordCacheSize = 10000;
+
 bool HasWordCharacters(const std::u16string& text, int index) {
   const char16_t* data = text.data();
   int length = text.length();
@@ -40,45 +43,182 @@ bool HasWordCharacters(const std::u16string& text, int index) {
   return false;
 }
 
-struct Word {
-  blink::WebTextCheckingResult result;
+}  // namespace
+
+// The WebTextCheckingResult is only made on the main thread, as it holds
+// WebStrings.
+struct SpellCheckClient::Word {
+  int location = 0;
+  int length = 0;
   std::u16string text;
   std::vector<std::u16string> contraction_words;
 };
 
-}  // namespace
-
 class SpellCheckClient::SpellcheckRequest {
  public:
   SpellcheckRequest(
-      const std::u16string& text,
+      uint64_t id,
       std::unique_ptr<blink::WebTextCheckingCompletion> completion)
-      : text_(text), completion_(std::move(completion)) {}
+      : id_(id), completion_(std::move(completion)) {}
   SpellcheckRequest(const SpellcheckRequest&) = delete;
   SpellcheckRequest& operator=(const SpellcheckRequest&) = delete;
   ~SpellcheckRequest() = default;
 
-  const std::u16string& text() const { return text_; }
+  uint64_t id() const { return id_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
 
  private:
-  std::u16string text_;          // Text to be checked in this task.
+  const uint64_t id_;
   std::vector<Word> word_list_;  // List of Words found in text
   // The interface to send the misspelled ranges to Blink.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 };
 
+// Lives on a worker sequence. Blink sends the text of a whole editable
+// element with every request, so the words of the paragraphs of the previous
+// request are kept, and only the paragraphs which changed are split again.
+class SpellCheckClient::Tokenizer {
+ public:
+  explicit Tokenizer(const std::string& language) {
+    character_attributes_.SetDefaultLanguage(language);
+  }
+
+  // disable copy
+  Tokenizer(const Tokenizer&) = delete;
+  Tokenizer& operator=(const Tokenizer&) = delete;
+
+  absl::optional<std::vector<Word>> Tokenize(const std::u16string& text) {
+    if (!HasWordCharacters(text, 0))
+      return absl::nullopt;
+
+    if (!text_iterator_.IsInitialized() &&
+        !text_iterator_.Initialize(&character_attributes_, true)) {
+      // We failed to initialize text_iterator_, return as spelled correctly.
+      VLOG(1) << "Failed to initialize SpellcheckWordIterator";
+      return std::vector<Word>();
+    }
+
+    if (!contraction_iterator_.IsInitialized() &&
+        !contraction_iterator_.Initialize(&character_attributes_, false)) {
+      // We failed to initialize the word iterator, return as spelled
+      // correctly.
+      VLOG(1) << "Failed to initialize contraction_iterator_";
+      return std::vector<Word>();
+    }
+
+    std::vector<Word> words;
+    base::flat_map<std::u16string, std::vector<Word>> paragraphs;
+    size_t start = 0;
+    while (start < text.size()) {
+      size_t end = text.find(u'\n', start);
+      end = end == std::u16string::npos ? text.size() : end + 1;
+      std::u16string paragraph = text.substr(start, end - start);
+
+      // The words of a paragraph are relative to its start.
+      auto it = paragraphs_.find(paragraph);
+      std::vector<Word> paragraph_words = it != paragraphs_.end()
+                                              ? it->second
+                                              : TokenizeParagraph(paragraph);
+      for (Word word : paragraph_words) {
+        word.location += base::checked_cast<int>(start);
+        words.push_back(std::move(word));
+      }
+      paragraphs.insert_or_assign(std::move(paragraph),
+                                  std::move(paragraph_words));
+      start = end;
+    }
+    paragraphs_ = std::move(paragraphs);
+    return words;
+  }
+
+ private:
+  std::vector<Word> TokenizeParagraph(const std::u16string& paragraph) {
+    text_iterator_.SetText(paragraph.c_str(), paragraph.size());
+
+    std::vector<Word> words;
+    std::u16string word;
+    size_t word_start;
+    size_t word_length;
+    for (;;) {  // Run until end of text
+      const auto status =
+          text_iterator_.GetNextWord(&word, &word_start, &word_length);
+      if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
+        break;
+      if (status == SpellcheckWordIterator::IS_SKIPPABLE)
+        continue;
+
+      Word& word_entry = words.emplace_back();
+      word_entry.location = base::checked_cast<int>(word_start);
+      word_entry.length = base::checked_cast<int>(word_length);
+      word_entry.text = word;
+      // If the given word is a concatenated word of two or more valid words
+      // (e.g. "hello:hello"), we should treat it as a valid word.
+      IsContraction(word, &word_entry.contraction_words);
+    }
+    return words;
+  }
+
+  // Returns whether or not the given string is a contraction.
+  // This function is a fall-back when the SpellcheckWordIterator class
+  // returns a concatenated word which is not in the selected dictionary
+  // (e.g. "in'n'out") but each word is valid.
+  // Output variable contraction_words will contain individual
+  // words in the contraction, and is left empty when it isn't one.
+  bool IsContraction(const std::u16string& contraction,
+                     std::vector<std::u16string>* contraction_words) {
+    DCHECK(contraction_iterator_.IsInitialized());
+
+    contraction_iterator_.SetText(contraction.c_str(), contraction.length());
+
+    std::u16string word;
+    size_t word_start;
+    size_t word_length;
+    for (auto status = contraction_iterator_.GetNextWord(&word, &word_start,
+                                                         &word_length);
+         status != SpellcheckWordIterator::IS_END_OF_TEXT;
+         status = contraction_iterator_.GetNextWord(&word, &word_start,
+                                                    &word_length)) {
+      if (status == SpellcheckWordIterator::IS_SKIPPABLE)
+        continue;
+
+      contraction_words->push_back(word);
+    }
+    if (contraction_words->size() > 1)
+      return true;
+    contraction_words->clear();
+    return false;
+  }
+
+  // Represents character attributes used for filtering out characters which
+  // are not supported by this SpellCheck object.
+  SpellcheckCharAttribute character_attributes_;
+
+  // Represents word iterators used in this spellchecker. The |text_iterator_|
+  // splits text provided by Blink into words, contractions, or concatenated
+  // words. The |contraction_iterator_| splits a concatenated word extracted
+  // by |text_iterator_| into word components so we can treat a concatenated
+  // word consisting only of correct words as a correct word.
+  SpellcheckWordIterator text_iterator_;
+  SpellcheckWordIterator contraction_iterator_;
+
+  // The words of the paragraphs of the last text, by their text.
+  base::flat_map<std::u16string, std::vector<Word>> paragraphs_;
+};
+
 SpellCheckClient::SpellCheckClient(const std::string& language,
                                    v8::Isolate* isolate,
                                    v8::Local<v8::Object> provider)
-    : isolate_(isolate),
+    : tokenizer_(base::ThreadPool::CreateSequencedTaskRunner(
+                     {base::TaskPriority::USER_VISIBLE,
+                      base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}),
+                 language),
+      word_cache_(kWordCacheSize),
+      isolate_(isolate),
       context_(isolate, isolate->GetCurrentContext()),
       provider_(isolate, provider) {
   DCHECK(!context_.IsEmpty());
 
-  character_attributes_.SetDefaultLanguage(language);
-
   // Persistent the method.
   v8::Local<v8::Function> spell_check;
   gin_helper::Dictionary(isolate, provider).Get("spellCheck", &spell_check);
@@ -92,9 +232,8 @@ SpellCheckClient::~SpellCheckClient() {
 void SpellCheckClient::RequestCheckingOfText(
     const blink::WebString& textToCheck,
     std::unique_ptr<blink::WebTextCheckingCompletion> completionCallback) {
-  std::u16string text(textToCheck.Utf16());
   // Ignore invalid requests.
-  if (text.empty() || !HasWordCharacters(text, 0)) {
+  if (textToCheck.IsEmpty() || spell_check_.IsEmpty()) {
     completionCallback->DidCancelCheckingText();
     return;
   }
@@ -104,12 +243,14 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_ =
-      std::make_unique<SpellcheckRequest>(text, std::move(completionCallback));
+  const uint64_t request_id = ++last_request_id_;
+  pending_request_param_ = std::make_unique<SpellcheckRequest>(
+      request_id, std::move(completionCallback));
 
-  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&SpellCheckClient::SpellCheckText, AsWeakPtr()));
+  tokenizer_.AsyncCall(&Tokenizer::Tokenize)
+      .WithArgs(textToCheck.Utf16())
+      .Then(base::BindOnce(&SpellCheckClient::OnTextTokenized, AsWeakPtr(),
+                           request_id));
 }
 
 bool SpellCheckClient::IsSpellCheckingEnabled() const {
@@ -125,81 +266,75 @@ bool SpellCheckClient::IsShowingSpellingUI() {
 void SpellCheckClient::UpdateSpellingUIWithMisspelledWord(
     const blink::WebString& word) {}
 
-void SpellCheckClient::SpellCheckText() {
-  const auto& text = pending_request_param_->text();
-  if (text.empty() || spell_check_.IsEmpty()) {
+void SpellCheckClient::OnTextTokenized(
+    uint64_t request_id,
+    absl::optional<std::vector<Word>> words) {
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+  if (!words) {
     pending_request_param_->completion()->DidCancelCheckingText();
     pending_request_param_ = nullptr;
     return;
   }
 
-  if (!text_iterator_.IsInitialized() &&
-      !text_iterator_.Initialize(&character_attributes_, true)) {
-    // We failed to initialize text_iterator_, return as spelled correctly.
-    VLOG(1) << "Failed to initialize SpellcheckWordIterator";
-    return;
+  std::unordered_set<std::u16string> unknown;
+  for (const auto& word : *words) {
+    if (word_cache_.Get(word.text) == word_cache_.end())
+      unknown.insert(word.text);
+    for (const auto& w : word.contraction_words) {
+      if (word_cache_.Get(w) == word_cache_.end())
+        unknown.insert(w);
+    }
   }
+  pending_request_param_->wordlist() = std::move(*words);
 
-  if (!contraction_iterator_.IsInitialized() &&
-      !contraction_iterator_.Initialize(&character_attributes_, false)) {
-    // We failed to initialize the word iterator, return as spelled correctly.
-    VLOG(1) << "Failed to initialize contraction_iterator_";
+  if (unknown.empty()) {
+    FinishRequest();
     return;
   }
 
-  text_iterator_.SetText(text.c_str(), text.size());
-
-  SpellCheckScope scope(*this);
-  std::u16string word;
-  size_t word_start;
-  size_t word_length;
-  std::set<std::u16string> words;
-  auto& word_list = pending_request_param_->wordlist();
-  Word word_entry;
-  for (;;) {  // Run until end of text
-    const auto status =
-        text_iterator_.GetNextWord(&word, &word_start, &word_length);
-    if (status == SpellcheckWordIterator::IS_END_OF_TEXT)
-      break;
-    if (status == SpellcheckWordIterator::IS_SKIPPABLE)
-      continue;
-
-    word_entry.result.location = base::checked_cast<int>(word_start);
-    word_entry.result.length = base::checked_cast<int>(word_length);
-    word_entry.text = word;
-    word_entry.contraction_words.clear();
-
-    word_list.push_back(word_entry);
-    words.insert(word);
-    // If the given word is a concatenated word of two or more valid words
-    // (e.g. "hello:hello"), we should treat it as a valid word.
-    if (IsContraction(scope, word, &word_entry.contraction_words)) {
-      for (const auto& w : word_entry.contraction_words) {
-        words.insert(w);
-      }
-    }
-  }
-
   // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  SpellCheckScope scope(*this);
+  SpellCheckWords(scope, request_id,
+                  std::vector<std::u16string>(unknown.begin(), unknown.end()));
 }
 
 void SpellCheckClient::OnSpellCheckDone(
+    uint64_t request_id,
     const std::vector<std::u16string>& misspelled_words) {
-  std::vector<blink::WebTextCheckingResult> results;
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
   std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
+  // The words which were sent are the ones which aren't cached.
+  auto cache = [this, &misspelled](const std::u16string& word) {
+    if (word_cache_.Peek(word) == word_cache_.end())
+      word_cache_.Put(word, !base::Contains(misspelled, word));
+  };
+  for (const auto& word : pending_request_param_->wordlist()) {
+    cache(word.text);
+    for (const auto& contraction_word : word.contraction_words)
+      cache(contraction_word);
+  }
+  FinishRequest();
+}
 
-  auto& word_list = pending_request_param_->wordlist();
+void SpellCheckClient::FinishRequest() {
+  auto is_misspelled = [this](const std::u16string& word) {
+    auto it = word_cache_.Peek(word);
+    return it != word_cache_.end() && !it->second;
+  };
 
-  for (const auto& word : word_list) {
-    if (base::Contains(misspelled, word.text)) {
+  std::vector<blink::WebTextCheckingResult> results;
+  for (const auto& word : pending_request_param_->wordlist()) {
+    if (is_misspelled(word.text)) {
       // If this is a contraction, iterate through parts and accept the word
       // if none of them are misspelled
       if (!word.contraction_words.empty()) {
         auto all_correct = true;
         for (const auto& contraction_word : word.contraction_words) {
-          if (base::Contains(misspelled, contraction_word)) {
+          if (is_misspelled(contraction_word)) {
             all_correct = false;
             break;
           }
@@ -207,15 +342,19 @@ void SpellCheckClient::OnSpellCheckDone(
         if (all_correct)
           continue;
       }
-      results.push_back(word.result);
+      blink::WebTextCheckingResult& result = results.emplace_back();
+      result.location = word.location;
+      result.length = word.length;
     }
   }
   pending_request_param_->completion()->DidFinishCheckingText(results);
   pending_request_param_ = nullptr;
 }
 
-void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
-                                       const std::set<std::u16string>& words) {
+void SpellCheckClient::SpellCheckWords(
+    const SpellCheckScope& scope,
+    uint64_t request_id,
+    const std::vector<std::u16string>& words) {
   DCHECK(!scope.spell_check_.IsEmpty());
 
   auto context = isolate_->GetCurrentContext();
@@ -224,8 +363,8 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
       v8::MicrotasksScope::kDoNotRunMicrotasks);
 
   v8::Local<v8::FunctionTemplate> templ = gin_helper::CreateFunctionTemplate(
-      isolate_,
-      base::BindRepeating(&SpellCheckClient::OnSpellCheckDone, AsWeakPtr()));
+      isolate_, base::BindRepeating(&SpellCheckClient::OnSpellCheckDone,
+                                    AsWeakPtr(), request_id));
   v8::Local<v8::Value> args[] = {gin::ConvertToV8(isolate_, words),
                                  templ->GetFunction(context).ToLocalChecked()};
   // Call javascript with the words and the callback function
@@ -233,36 +372,6 @@ void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
       .IsEmpty();
 }
 
-// Returns whether or not the given string is a contraction.
-// This function is a fall-back when the SpellcheckWordIterator class
-// returns a concatenated word which is not in the selected dictionary
-// (e.g. "in'n'out") but each word is valid.
-// Output variable contraction_words will contain individual
-// words in the contraction.
-bool SpellCheckClient::IsContraction(
-    const SpellCheckScope& scope,
-    const std::u16string& contraction,
-    std::vector<std::u16string>* contraction_words) {
-  DCHECK(contraction_iterator_.IsInitialized());
-
-  contraction_iterator_.SetText(contraction.c_str(), contraction.length());
-
-  std::u16string word;
-  size_t word_start;
-  size_t word_length;
-  for (auto status =
-           contraction_iterator_.GetNextWord(&word, &word_start, &word_length);
-       status != SpellcheckWordIterator::IS_END_OF_TEXT;
-       status = contraction_iterator_.GetNextWord(&word, &word_start,
-                                                  &word_length)) {
-    if (status == SpellcheckWordIterator::IS_SKIPPABLE)
-      continue;
-
-    contraction_words->push_back(word);
-  }
-  return contraction_words->size() > 1;
-}
-
 SpellCheckClient::SpellCheckScope::SpellCheckScope(
     const SpellCheckClient& client)
     : handle_scope_(client.isolate_),
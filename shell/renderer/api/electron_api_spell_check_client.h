@@ -6,14 +6,15 @@
 #define ELECTRON_SHELL_RENDERER_API_ELECTRON_API_SPELL_CHECK_CLIENT_H_
 
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
-#include "components/spellcheck/renderer/spellcheck_worditerator.h"
+#include "base/threading/sequence_bound.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/platform/web_spell_check_panel_host_client.h"
 #include "third_party/blink/public/platform/web_vector.h"
 #include "third_party/blink/public/web/web_text_check_client.h"
@@ -41,6 +42,9 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
 
  private:
   class SpellcheckRequest;
+  class Tokenizer;
+  struct Word;
+
   // blink::WebTextCheckClient:
   void RequestCheckingOfText(const blink::WebString& textToCheck,
                              std::unique_ptr<blink::WebTextCheckingCompletion>
@@ -63,44 +67,42 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
     ~SpellCheckScope();
   };
 
-  // Run through the word iterator and send out requests
-  // to the JS API for checking spellings of words in the current
-  // request.
-  void SpellCheckText();
+  // Called with the words the tokenizer found in the text of the request
+  // |request_id|, or nothing when it has no words to check. Sends the words
+  // which aren't in |word_cache_| to the JS API in one batch.
+  void OnTextTokenized(uint64_t request_id,
+                       absl::optional<std::vector<Word>> words);
 
   // Call JavaScript to check spelling a word.
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
   void SpellCheckWords(const SpellCheckScope& scope,
-                       const std::set<std::u16string>& words);
-
-  // Returns whether or not the given word is a contraction of valid words
-  // (e.g. "word:word").
-  // Output variable contraction_words will contain individual
-  // words in the contraction.
-  bool IsContraction(const SpellCheckScope& scope,
-                     const std::u16string& contraction,
-                     std::vector<std::u16string>* contraction_words);
+                       uint64_t request_id,
+                       const std::vector<std::u16string>& words);
 
   // Callback for the JS API which returns the list of misspelled words.
-  void OnSpellCheckDone(const std::vector<std::u16string>& misspelled_words);
+  void OnSpellCheckDone(uint64_t request_id,
+                        const std::vector<std::u16string>& misspelled_words);
+
+  // Sends the misspelled ranges of the pending request to Blink, once all of
+  // its words are in |word_cache_|.
+  void FinishRequest();
 
-  // Represents character attributes used for filtering out characters which
-  // are not supported by this SpellCheck object.
-  SpellcheckCharAttribute character_attributes_;
+  // Splits the text of the requests into words on a worker thread, so that
+  // long documents don't stall typing.
+  base::SequenceBound<Tokenizer> tokenizer_;
 
-  // Represents word iterators used in this spellchecker. The |text_iterator_|
-  // splits text provided by Blink into words, contractions, or concatenated
-  // words. The |contraction_iterator_| splits a concatenated word extracted by
-  // |text_iterator_| into word components so we can treat a concatenated word
-  // consisting only of correct words as a correct word.
-  SpellcheckWordIterator text_iterator_;
-  SpellcheckWordIterator contraction_iterator_;
+  // Whether the words seen so far are spelled correctly, by the provider of
+  // this client, which is for a single language.
+  base::HashingLRUCache<std::u16string, bool> word_cache_;
 
   // The parameters of a pending background-spellchecking request.
   // (When Blink sends two or more requests, we cancel the previous
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
+  // Tells the replies for the pending request from the ones for the requests
+  // canceled before.
+  uint64_t last_request_id_ = 0;
 
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Context> context_;
@@ -33,6 +33,7 @@
 #include "shell/renderer/api/context_bridge/object_cache.h"
 #include "shell/renderer/api/electron_api_context_bridge.h"
 #include "shell/renderer/api/electron_api_spell_check_client.h"
+#include "shell/renderer/injected_style_sheets.h"
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/page/page_zoom.h"
@@ -583,13 +584,8 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
       return std::u16string();
 
     blink::WebFrame* web_frame = render_frame->GetWebFrame();
-    if (web_frame->IsWebLocalFrame()) {
-      return web_frame->ToWebLocalFrame()
-          ->GetDocument()
-          .InsertStyleSheet(blink::WebString::FromUTF8(css), nullptr,
-                            css_origin)
-          .Utf16();
-    }
+    if (web_frame->IsWebLocalFrame())
+      return InsertStyleSheet(web_frame->ToWebLocalFrame(), css, css_origin);
     return std::u16string();
   }
 
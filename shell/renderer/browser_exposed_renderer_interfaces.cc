@@ -8,10 +8,12 @@
 
 #include "base/functional/bind.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "build/build_config.h"
 #include "electron/buildflags/buildflags.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
 #include "shell/renderer/renderer_client_base.h"
+#include "shell/renderer/renderer_diagnostics.h"
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 #include "components/spellcheck/renderer/spellcheck.h"
@@ -32,6 +34,11 @@ void BindSpellChecker(
 void ExposeElectronRendererInterfacesToBrowser(
     electron::RendererClientBase* client,
     mojo::BinderMap* binders) {
+  // Off the main thread, which it reports on when it's busy.
+  binders->Add<electron::mojom::ElectronRendererDiagnostics>(
+      base::BindRepeating(&electron::RendererDiagnostics::Bind),
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_BLOCKING}));
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   binders->Add<spellcheck::mojom::SpellChecker>(
       base::BindRepeating(&BindSpellChecker, client),
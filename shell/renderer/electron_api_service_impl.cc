@@ -9,9 +9,15 @@
 #include <utility>
 #include <vector>
 
+#include "base/allocator/buildflags.h"
 #include "base/environment.h"
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted.h"
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "content/public/common/isolated_world_ids.h"
+#include "gin/handle.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -19,14 +25,24 @@
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/shared_ring_buffer.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
+#include "shell/renderer/shared_ring_buffer_reader.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/mojom/frame/user_activation_notification_type.mojom-shared.h"
+#include "third_party/blink/public/platform/web_vector.h"
 #include "third_party/blink/public/web/blink.h"
+#include "third_party/blink/public/web/web_cache.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
+#include "third_party/blink/public/web/web_script_source.h"
+
+#if BUILDFLAG(USE_PARTITION_ALLOC)
+#include "base/allocator/partition_allocator/memory_reclaimer.h"
+#endif
 
 namespace electron {
 
@@ -99,6 +115,68 @@ void EmitIPCEvent(v8::Local<v8::Context> context,
   InvokeIpcCallback(context, "onMessage", argv);
 }
 
+const char kFrameRemovedError[] =
+    "WebFrame was removed before script could run. This normally means the "
+    "underlying frame was destroyed";
+
+// Collects the results of ExecuteJavaScriptInFrames(), the reply is sent once
+// the last per-frame completion callback holding a reference has run or has
+// been dropped by Blink because its frame went away.
+class BatchedScriptExecution
+    : public base::RefCounted<BatchedScriptExecution> {
+ public:
+  using Callback = mojom::ElectronRenderer::ExecuteJavaScriptInFramesCallback;
+
+  BatchedScriptExecution(size_t frame_count, Callback callback)
+      : callback_(std::move(callback)) {
+    results_.reserve(frame_count);
+    for (size_t i = 0; i < frame_count; ++i) {
+      results_.push_back(mojom::FrameScriptResult::New(
+          false, base::Value(kFrameRemovedError)));
+    }
+  }
+
+  // disable copy
+  BatchedScriptExecution(const BatchedScriptExecution&) = delete;
+  BatchedScriptExecution& operator=(const BatchedScriptExecution&) = delete;
+
+  void Completed(size_t index,
+                 const blink::WebVector<v8::Local<v8::Value>>& result) {
+    if (result.empty())
+      return;
+
+    mojom::FrameScriptResultPtr& frame_result = results_[index];
+    if (result[0].IsEmpty()) {
+      frame_result->value = base::Value(
+          "Script failed to execute, this normally means an error was thrown. "
+          "Check the renderer console for the error.");
+      return;
+    }
+
+    v8::Isolate* isolate = blink::MainThreadIsolate();
+    v8::HandleScope handle_scope(isolate);
+    // The properties of objects are read in the context they belong to.
+    absl::optional<v8::Context::Scope> context_scope;
+    if (result[0]->IsObject())
+      context_scope.emplace(
+          result[0].As<v8::Object>()->GetCreationContextChecked());
+
+    // Values that can't be converted, like undefined, are sent as null.
+    base::Value value;
+    gin::ConvertFromV8(isolate, result[0], &value);
+    frame_result->success = true;
+    frame_result->value = std::move(value);
+  }
+
+ private:
+  friend class base::RefCounted<BatchedScriptExecution>;
+
+  ~BatchedScriptExecution() { std::move(callback_).Run(std::move(results_)); }
+
+  std::vector<mojom::FrameScriptResultPtr> results_;
+  Callback callback_;
+};
+
 }  // namespace
 
 ElectronApiServiceImpl::~ElectronApiServiceImpl() = default;
@@ -173,6 +251,72 @@ void ElectronApiServiceImpl::Message(bool internal,
   EmitIPCEvent(context, internal, channel, {}, args, sender_id);
 }
 
+void ElectronApiServiceImpl::ReceiveDirectChannel(
+    int32_t sender_id,
+    mojo::PendingReceiver<mojom::ElectronDirectIPC> receiver) {
+  direct_ipc_receivers_.Add(this, std::move(receiver), sender_id);
+}
+
+void ElectronApiServiceImpl::ExecuteJavaScriptInFrames(
+    const std::u16string& code,
+    const std::vector<int32_t>& routing_ids,
+    bool user_gesture,
+    ExecuteJavaScriptInFramesCallback callback) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::ExecuteJavaScriptInFrames",
+               "frames", routing_ids.size());
+  auto execution = base::MakeRefCounted<BatchedScriptExecution>(
+      routing_ids.size(), std::move(callback));
+
+  // Every frame gets the same source with the same (empty) origin so that
+  // V8's per-isolate compilation cache hands the script compiled for the
+  // first frame to the others, instead of parsing and compiling it again.
+  const blink::WebScriptSource source{blink::WebString::FromUTF16(code)};
+  for (size_t i = 0; i < routing_ids.size(); ++i) {
+    content::RenderFrame* frame =
+        content::RenderFrame::FromRoutingID(routing_ids[i]);
+    if (!frame || !frame->GetWebFrame())
+      continue;
+
+    frame->GetWebFrame()->RequestExecuteScript(
+        content::ISOLATED_WORLD_ID_GLOBAL, base::make_span(&source, 1u),
+        user_gesture ? blink::mojom::UserActivationOption::kActivate
+                     : blink::mojom::UserActivationOption::kDoNotActivate,
+        blink::mojom::EvaluationTiming::kSynchronous,
+        blink::mojom::LoadEventBlockingOption::kDoNotBlock,
+        base::NullCallback(),
+        base::BindOnce(&BatchedScriptExecution::Completed, execution, i),
+        blink::BackForwardCacheAware::kAllow,
+        blink::mojom::WantResultOption::kWantResult,
+        blink::mojom::PromiseResultOption::kAwait);
+  }
+}
+
+void ElectronApiServiceImpl::ReduceMemory(bool purge_caches,
+                                          bool notify_v8,
+                                          bool purge_partition_alloc,
+                                          ReduceMemoryCallback callback) {
+  TRACE_EVENT0("electron", "ElectronApiServiceImpl::ReduceMemory");
+  if (purge_caches)
+    blink::WebCache::Clear();
+  if (notify_v8) {
+    blink::MainThreadIsolate()->MemoryPressureNotification(
+        v8::MemoryPressureLevel::kCritical);
+  }
+#if BUILDFLAG(USE_PARTITION_ALLOC)
+  if (purge_partition_alloc)
+    ::partition_alloc::MemoryReclaimer::Instance()->ReclaimAll();
+#endif
+  std::move(callback).Run();
+}
+
+void ElectronApiServiceImpl::Message(const std::string& channel,
+                                     blink::CloneableMessage arguments) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::DirectMessage", "channel",
+               channel);
+  Message(false /* internal */, channel, std::move(arguments),
+          direct_ipc_receivers_.current_context());
+}
+
 void ElectronApiServiceImpl::ReceivePostMessage(
     const std::string& channel,
     blink::TransferableMessage message) {
@@ -201,8 +345,39 @@ void ElectronApiServiceImpl::ReceivePostMessage(
                0);
 }
 
+void ElectronApiServiceImpl::ReceiveRingBuffer(
+    const std::string& channel,
+    base::UnsafeSharedMemoryRegion region,
+    mojo::PendingReceiver<mojom::ElectronRingBufferReader> reader) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  // Dropping |reader| tells the writer that nobody is listening.
+  auto buffer = SharedRingBuffer::Attach(std::move(region));
+  if (!buffer)
+    return;
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  std::vector<v8::Local<v8::Value>> args = {
+      SharedRingBufferReader::Create(context, std::move(buffer),
+                                     std::move(reader))
+          .ToV8()};
+
+  EmitIPCEvent(context, false, channel, {}, gin::ConvertToV8(isolate, args),
+               0);
+}
+
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    bool gzip,
+    bool graph_only,
+    mojo::PendingRemote<mojom::HeapSnapshotProgress> progress,
     TakeHeapSnapshotCallback callback) {
   ScopedAllowBlockingForElectron allow_blocking;
 
@@ -215,8 +390,24 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   }
   base::File base_file(std::move(platform_file));
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  electron::HeapSnapshotOptions options;
+  options.gzip = gzip;
+  options.graph_only = graph_only;
+  // Messages are written to the pipe right away, so the browser sees the
+  // progress while this thread is still busy.
+  mojo::Remote<mojom::HeapSnapshotProgress> progress_remote(
+      std::move(progress));
+  if (progress_remote.is_bound()) {
+    options.on_capture =
+        base::BindRepeating(&mojom::HeapSnapshotProgress::OnCapture,
+                            base::Unretained(progress_remote.get()));
+    options.on_write =
+        base::BindRepeating(&mojom::HeapSnapshotProgress::OnWrite,
+                            base::Unretained(progress_remote.get()));
+  }
+
+  bool success = electron::TakeHeapSnapshot(blink::MainThreadIsolate(),
+                                            &base_file, options);
 
   std::move(callback).Run(success);
 }
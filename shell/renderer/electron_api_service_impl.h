@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
@@ -14,12 +15,15 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 
 namespace electron {
 
 class RendererClientBase;
 
 class ElectronApiServiceImpl : public mojom::ElectronRenderer,
+                               public mojom::ElectronDirectIPC,
                                public content::RenderFrameObserver {
  public:
   ElectronApiServiceImpl(content::RenderFrame* render_frame,
@@ -38,8 +42,33 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                int32_t sender_id) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
-  void TakeHeapSnapshot(mojo::ScopedHandle file,
-                        TakeHeapSnapshotCallback callback) override;
+  void ReceiveRingBuffer(
+      const std::string& channel,
+      base::UnsafeSharedMemoryRegion region,
+      mojo::PendingReceiver<mojom::ElectronRingBufferReader> reader) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      bool gzip,
+      bool graph_only,
+      mojo::PendingRemote<mojom::HeapSnapshotProgress> progress,
+      TakeHeapSnapshotCallback callback) override;
+  void ReceiveDirectChannel(
+      int32_t sender_id,
+      mojo::PendingReceiver<mojom::ElectronDirectIPC> receiver) override;
+  void ExecuteJavaScriptInFrames(
+      const std::u16string& code,
+      const std::vector<int32_t>& routing_ids,
+      bool user_gesture,
+      ExecuteJavaScriptInFramesCallback callback) override;
+  void ReduceMemory(bool purge_caches,
+                    bool notify_v8,
+                    bool purge_partition_alloc,
+                    ReduceMemoryCallback callback) override;
+
+  // mojom::ElectronDirectIPC:
+  void Message(const std::string& channel,
+               blink::CloneableMessage arguments) override;
+
   void ProcessPendingMessages();
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
@@ -63,6 +92,8 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
 
   mojo::PendingReceiver<mojom::ElectronRenderer> pending_receiver_;
   mojo::Receiver<mojom::ElectronRenderer> receiver_{this};
+  // The context of each receiver is the webContents id of its sender.
+  mojo::ReceiverSet<mojom::ElectronDirectIPC, int32_t> direct_ipc_receivers_;
 
   RendererClientBase* renderer_client_;
   base::WeakPtrFactory<ElectronApiServiceImpl> weak_factory_{this};
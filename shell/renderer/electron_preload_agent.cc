@@ -0,0 +1,119 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/electron_preload_agent.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/numerics/safe_conversions.h"
+#include "gin/converter.h"
+#include "gin/data_object_builder.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
+#include "v8/include/v8-array-buffer.h"
+#include "v8/include/v8-primitive.h"
+#include "v8/include/v8-typed-array.h"
+
+namespace electron {
+
+namespace {
+
+v8::MaybeLocal<v8::String> SourceFromRegion(
+    v8::Isolate* isolate,
+    const base::ReadOnlySharedMemoryRegion& region) {
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return {};
+  return v8::String::NewFromTwoByte(
+      isolate, mapping.GetMemoryAs<uint16_t>(), v8::NewStringType::kNormal,
+      base::checked_cast<int>(mapping.size() / sizeof(uint16_t)));
+}
+
+v8::MaybeLocal<v8::Uint8Array> BufferFromRegion(
+    v8::Isolate* isolate,
+    const base::ReadOnlySharedMemoryRegion& region) {
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return {};
+  // Copied, as the renderer could write to the array.
+  auto buffer = v8::ArrayBuffer::New(isolate, mapping.size());
+  memcpy(buffer->Data(), mapping.memory(), mapping.size());
+  return v8::Uint8Array::New(buffer, 0, mapping.size());
+}
+
+}  // namespace
+
+PreloadAgent::PreloadAgent(content::RenderFrame* frame,
+                           blink::AssociatedInterfaceRegistry* registry)
+    : content::RenderFrameObserver(frame),
+      content::RenderFrameObserverTracker<PreloadAgent>(frame) {
+  // Unretained is safe as |registry| is owned by the frame, which outlives
+  // |this|.
+  registry->AddInterface<mojom::ElectronPreloadAgent>(base::BindRepeating(
+      &PreloadAgent::BindPendingReceiver, base::Unretained(this)));
+}
+
+PreloadAgent::~PreloadAgent() = default;
+
+v8::Local<v8::Value> PreloadAgent::TakePreloads(v8::Isolate* isolate) {
+  mojom::SandboxPreloadsPtr preloads = std::move(preloads_);
+  if (!preloads)
+    return v8::Local<v8::Value>();
+
+  std::vector<v8::Local<v8::Value>> scripts;
+  for (const auto& script : preloads->scripts) {
+    v8::Local<v8::String> source;
+    if (!SourceFromRegion(isolate, script->source).ToLocal(&source))
+      return v8::Local<v8::Value>();
+
+    v8::Local<v8::Value> code_cache = v8::Null(isolate);
+    v8::Local<v8::Uint8Array> cached_data;
+    if (script->code_cache &&
+        BufferFromRegion(isolate, script->code_cache->data)
+            .ToLocal(&cached_data)) {
+      code_cache = gin::DataObjectBuilder(isolate)
+                       .Set("cacheKey", script->code_cache->cache_key)
+                       .Set("cachedData", cached_data)
+                       .Build();
+    }
+
+    scripts.push_back(gin::DataObjectBuilder(isolate)
+                          .Set("preloadPath", script->path)
+                          .Set("preloadSrc", source)
+                          .Set("preloadError", v8::Null(isolate))
+                          .Set("codeCache", code_cache)
+                          .Build());
+  }
+
+  return gin::DataObjectBuilder(isolate)
+      .Set("preloadScripts", scripts)
+      .Set("process", preloads->process)
+      .Build();
+}
+
+void PreloadAgent::BindPendingReceiver(
+    mojo::PendingAssociatedReceiver<mojom::ElectronPreloadAgent>
+        pending_receiver) {
+  receivers_.Add(this, std::move(pending_receiver));
+}
+
+void PreloadAgent::DidCommitProvisionalLoad(ui::PageTransition transition) {
+  // The preloads of a navigation are sent right before its commit, the
+  // document of any other commit asks for them.
+  preloads_ = std::move(pending_preloads_);
+}
+
+void PreloadAgent::OnDestruct() {
+  delete this;
+}
+
+void PreloadAgent::SetPreloads(mojom::SandboxPreloadsPtr preloads) {
+  pending_preloads_ = std::move(preloads);
+}
+
+}  // namespace electron
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_ELECTRON_PRELOAD_AGENT_H_
+#define ELECTRON_SHELL_RENDERER_ELECTRON_PRELOAD_AGENT_H_
+
+#include "content/public/renderer/render_frame_observer.h"
+#include "content/public/renderer/render_frame_observer_tracker.h"
+#include "mojo/public/cpp/bindings/associated_receiver_set.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "shell/common/api/api.mojom.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "v8/include/v8-forward.h"
+
+namespace electron {
+
+// Receives the preloads the browser sends to sandboxed frames before their
+// navigations commit, so that sandboxed_renderer/init.ts doesn't have to ask
+// for them with BROWSER_SANDBOX_LOAD.
+class PreloadAgent : public content::RenderFrameObserver,
+                     public content::RenderFrameObserverTracker<PreloadAgent>,
+                     public mojom::ElectronPreloadAgent {
+ public:
+  PreloadAgent(content::RenderFrame* frame,
+               blink::AssociatedInterfaceRegistry* registry);
+  ~PreloadAgent() override;
+
+  // disable copy
+  PreloadAgent(const PreloadAgent&) = delete;
+  PreloadAgent& operator=(const PreloadAgent&) = delete;
+
+  // Returns the preloads of the current document in the shape of the reply
+  // to BROWSER_SANDBOX_LOAD, or an empty handle when the browser didn't send
+  // them. They can only be taken once.
+  v8::Local<v8::Value> TakePreloads(v8::Isolate* isolate);
+
+ private:
+  void BindPendingReceiver(
+      mojo::PendingAssociatedReceiver<mojom::ElectronPreloadAgent>
+          pending_receiver);
+
+  // content::RenderFrameObserver:
+  void DidCommitProvisionalLoad(ui::PageTransition transition) override;
+  void OnDestruct() override;
+
+  // mojom::ElectronPreloadAgent:
+  void SetPreloads(mojom::SandboxPreloadsPtr preloads) override;
+
+  // Those of the navigation about to commit, then of the committed document.
+  mojom::SandboxPreloadsPtr pending_preloads_;
+  mojom::SandboxPreloadsPtr preloads_;
+
+  mojo::AssociatedReceiverSet<mojom::ElectronPreloadAgent> receivers_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_RENDERER_ELECTRON_PRELOAD_AGENT_H_
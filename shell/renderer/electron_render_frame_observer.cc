@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/functional/bind.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/trace_event/trace_event.h"
@@ -24,6 +25,7 @@
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -140,9 +142,32 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
 }
 
 void ElectronRenderFrameObserver::DraggableRegionsChanged() {
+  // Layouts forced by scripts can change the regions several times before
+  // the frame is produced, only the last ones are sent.
+  if (draggable_regions_update_pending_)
+    return;
+  draggable_regions_update_pending_ = true;
+  render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault)
+      ->PostTask(
+          FROM_HERE,
+          base::BindOnce(&ElectronRenderFrameObserver::SendDraggableRegions,
+                         weak_factory_.GetWeakPtr()));
+}
+
+void ElectronRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_update_pending_ = false;
+  if (!draggable_regions_remote_.is_bound() ||
+      !draggable_regions_remote_.is_connected()) {
+    // The browser starts from an empty list with each connection.
+    draggable_regions_remote_.reset();
+    draggable_regions_.clear();
+    render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
+        &draggable_regions_remote_);
+  }
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<mojom::DraggableRegionPtr> regions;
+  regions.reserve(webregions.size());
   for (auto& webregion : webregions) {
     auto region = mojom::DraggableRegion::New();
     render_frame_->ConvertViewportToWindow(&webregion.bounds);
@@ -151,11 +176,31 @@ void ElectronRenderFrameObserver::DraggableRegionsChanged() {
     regions.push_back(std::move(region));
   }
 
-  mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
-      web_contents_utility_remote;
-  render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
-      &web_contents_utility_remote);
-  web_contents_utility_remote->UpdateDraggableRegions(std::move(regions));
+  // Only the regions between the unchanged head and tail of the list are
+  // sent, the browser patches the list it has.
+  size_t start = 0;
+  while (start < regions.size() && start < draggable_regions_.size() &&
+         regions[start].Equals(draggable_regions_[start])) {
+    ++start;
+  }
+  if (start == regions.size() && start == draggable_regions_.size())
+    return;
+  size_t tail = 0;
+  while (tail < regions.size() - start &&
+         tail < draggable_regions_.size() - start &&
+         regions[regions.size() - tail - 1].Equals(
+             draggable_regions_[draggable_regions_.size() - tail - 1])) {
+    ++tail;
+  }
+
+  std::vector<mojom::DraggableRegionPtr> changed;
+  changed.reserve(regions.size() - start - tail);
+  for (size_t i = start; i < regions.size() - tail; ++i)
+    changed.push_back(regions[i].Clone());
+  const size_t removed_count = draggable_regions_.size() - start - tail;
+  draggable_regions_ = std::move(regions);
+  draggable_regions_remote_->UpdateDraggableRegions(start, removed_count,
+                                                    std::move(changed));
 }
 
 void ElectronRenderFrameObserver::WillReleaseScriptContext(
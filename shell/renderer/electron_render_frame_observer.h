@@ -6,8 +6,12 @@
 #define ELECTRON_SHELL_RENDERER_ELECTRON_RENDER_FRAME_OBSERVER_H_
 
 #include <string>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame_observer.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
 #include "ipc/ipc_platform_file.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 
@@ -43,10 +47,20 @@ class ElectronRenderFrameObserver : public content::RenderFrameObserver {
   bool IsIsolatedWorld(int world_id);
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
                           const std::string& channel);
+  void SendDraggableRegions();
 
   bool has_delayed_node_initialization_ = false;
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
+
+  // The draggable regions last sent to the browser, through a connection of
+  // their own as the browser keeps its copy of them with it.
+  mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
+      draggable_regions_remote_;
+  std::vector<mojom::DraggableRegionPtr> draggable_regions_;
+  bool draggable_regions_update_pending_ = false;
+
+  base::WeakPtrFactory<ElectronRenderFrameObserver> weak_factory_{this};
 };
 
 }  // namespace electron
@@ -6,10 +6,16 @@
 
 #include "base/command_line.h"
 #include "base/containers/contains.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_thread.h"
 #include "electron/buildflags/buildflags.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/shared_remote.h"
 #include "net/http/http_request_headers.h"
 #include "shell/common/api/electron_bindings.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_bindings.h"
@@ -24,6 +30,19 @@
 
 namespace electron {
 
+namespace {
+
+base::ReadOnlySharedMemoryRegion GetSharedAsarIndex(
+    const mojo::SharedRemote<mojom::ElectronAsarIndexProvider>& provider,
+    const base::FilePath& archive_path) {
+  base::ReadOnlySharedMemoryRegion region;
+  if (!provider->GetSharedIndex(archive_path, &region))
+    return base::ReadOnlySharedMemoryRegion();
+  return region;
+}
+
+}  // namespace
+
 ElectronRendererClient::ElectronRendererClient()
     : node_bindings_(
           NodeBindings::Create(NodeBindings::BrowserEnvironment::kRenderer)),
@@ -32,6 +51,21 @@ ElectronRendererClient::ElectronRendererClient()
 
 ElectronRendererClient::~ElectronRendererClient() = default;
 
+void ElectronRendererClient::RenderThreadStarted() {
+  RendererClientBase::RenderThreadStarted();
+
+  // Attach to asar headers the browser process has already parsed instead of
+  // parsing them again in every renderer.
+  mojo::PendingRemote<mojom::ElectronAsarIndexProvider> asar_index_provider;
+  content::RenderThread::Get()->BindHostReceiver(
+      asar_index_provider.InitWithNewPipeAndPassReceiver());
+  asar::SetSharedIndexProvider(base::BindRepeating(
+      &GetSharedAsarIndex,
+      mojo::SharedRemote<mojom::ElectronAsarIndexProvider>(
+          std::move(asar_index_provider),
+          base::ThreadPool::CreateSequencedTaskRunner({}))));
+}
+
 void ElectronRendererClient::RenderFrameCreated(
     content::RenderFrame* render_frame) {
   new ElectronRenderFrameObserver(render_frame, this);
@@ -71,6 +105,7 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!ShouldLoadPreload(renderer_context, render_frame))
     return;
 
+  TRACE_EVENT0("electron", "ElectronRendererClient::DidCreateScriptContext");
   injected_frames_.insert(render_frame);
 
   if (!node_integration_initialized_) {
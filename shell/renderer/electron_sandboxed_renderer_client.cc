@@ -4,7 +4,9 @@
 
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -12,11 +14,13 @@
 #include "base/command_line.h"
 #include "base/containers/contains.h"
 #include "base/files/file_path.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/path_service.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
+#include "gin/data_object_builder.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -25,6 +29,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/renderer/electron_preload_agent.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/web/blink.h"
@@ -82,14 +87,57 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
+// Compiles the wrapped preload script, consuming |cached_data| from the
+// preload code cache when the browser has one. Returns { fn, cachedData }
+// where cachedData is only set when the cache was missing or rejected, and is
+// sent back to the browser by sandboxed_renderer/init.js to be stored.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> source) {
+                                         v8::Local<v8::String> source,
+                                         gin_helper::Arguments* args) {
   auto context = isolate->GetCurrentContext();
-  auto maybe_script = v8::Script::Compile(context, source);
+
+  v8::Local<v8::Value> cached_data_value;
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data;
+  if (args->GetNext(&cached_data_value) &&
+      cached_data_value->IsArrayBufferView()) {
+    auto view = cached_data_value.As<v8::ArrayBufferView>();
+    const auto* data =
+        static_cast<const uint8_t*>(view->Buffer()->Data()) +
+        view->ByteOffset();
+    cached_data = std::make_unique<v8::ScriptCompiler::CachedData>(
+        data, base::checked_cast<int>(view->ByteLength()),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+
+  const bool has_cached_data = !!cached_data;
+  v8::ScriptCompiler::Source script_source(source, cached_data.release());
+  auto maybe_script = v8::ScriptCompiler::Compile(
+      context, &script_source,
+      has_cached_data ? v8::ScriptCompiler::kConsumeCodeCache
+                      : v8::ScriptCompiler::kNoCompileOptions);
   v8::Local<v8::Script> script;
   if (!maybe_script.ToLocal(&script))
     return v8::Local<v8::Value>();
-  return script->Run(context).ToLocalChecked();
+
+  // The wrapper function is parenthesized so V8 compiles it eagerly, creating
+  // the cache right after running the script therefore covers its body.
+  v8::Local<v8::Value> fn = script->Run(context).ToLocalChecked();
+  gin::DataObjectBuilder result(isolate);
+  result.Set("fn", fn);
+
+  const v8::ScriptCompiler::CachedData* consumed =
+      script_source.GetCachedData();
+  if (!has_cached_data || (consumed && consumed->rejected)) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> new_cached_data(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (new_cached_data) {
+      auto buffer = v8::ArrayBuffer::New(isolate, new_cached_data->length);
+      memcpy(buffer->Data(), new_cached_data->data, new_cached_data->length);
+      result.Set("cachedData",
+                 v8::Uint8Array::New(buffer, 0, new_cached_data->length));
+    }
+  }
+  return result.Build();
 }
 
 double Uptime() {
@@ -153,6 +201,8 @@ void ElectronSandboxedRendererClient::InitializeBindings(
 void ElectronSandboxedRendererClient::RenderFrameCreated(
     content::RenderFrame* render_frame) {
   new ElectronRenderFrameObserver(render_frame, this);
+  new PreloadAgent(render_frame,
+                   render_frame->GetAssociatedInterfaceRegistry());
   RendererClientBase::RenderFrameCreated(render_frame);
 }
 
@@ -185,6 +235,12 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
   auto binding = v8::Object::New(isolate);
   InitializeBindings(binding, context, render_frame);
 
+  // Read by sandboxed_renderer/init.js instead of asking the browser.
+  v8::Local<v8::Value> preloads =
+      PreloadAgent::Get(render_frame)->TakePreloads(isolate);
+  if (!preloads.IsEmpty())
+    gin_helper::Dictionary(isolate, binding).Set("preloads", preloads);
+
   std::vector<v8::Local<v8::String>> sandbox_preload_bundle_params = {
       node::FIXED_ONE_BYTE_STRING(isolate, "binding")};
 
@@ -0,0 +1,75 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/injected_style_sheets.h"
+
+#include "base/containers/lru_cache.h"
+#include "base/no_destructor.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser_context.h"  // nogncheck
+#include "third_party/blink/renderer/core/css/style_engine.h"  // nogncheck
+#include "third_party/blink/renderer/core/css/style_sheet_contents.h"  // nogncheck
+#include "third_party/blink/renderer/core/dom/document.h"  // nogncheck
+#include "third_party/blink/renderer/core/frame/local_frame.h"  // nogncheck
+#include "third_party/blink/renderer/core/frame/web_local_frame_impl.h"  // nogncheck
+#include "third_party/blink/renderer/platform/heap/garbage_collected.h"  // nogncheck
+#include "third_party/blink/renderer/platform/heap/persistent.h"  // nogncheck
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string.h"  // nogncheck
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"  // nogncheck
+
+namespace electron {
+
+namespace {
+
+// Stylesheets are usually injected by the handful (a theme, some fixes), a
+// few entries are enough to cover them without keeping old ones alive.
+constexpr size_t kMaxCachedStyleSheets = 8;
+
+using StyleSheetCache =
+    base::HashingLRUCache<std::string,
+                          blink::Persistent<blink::StyleSheetContents>>;
+
+StyleSheetCache& GetStyleSheetCache() {
+  static base::NoDestructor<StyleSheetCache> cache(kMaxCachedStyleSheets);
+  return *cache;
+}
+
+// Prefixed so that they don't collide with the keys Blink generates for
+// blink::WebDocument::InsertStyleSheet.
+std::string GenerateStyleSheetKey() {
+  static uint64_t next_key = 0;
+  return base::StrCat({"electron-", base::NumberToString(++next_key)});
+}
+
+}  // namespace
+
+std::u16string InsertStyleSheet(blink::WebLocalFrame* frame,
+                                const std::string& css,
+                                blink::WebCssOrigin origin) {
+  blink::Document* document =
+      static_cast<blink::WebLocalFrameImpl*>(frame)->GetFrame()->GetDocument();
+  auto* context =
+      blink::MakeGarbageCollected<blink::CSSParserContext>(*document);
+
+  StyleSheetCache& cache = GetStyleSheetCache();
+  blink::StyleSheetContents* contents = nullptr;
+  auto it = cache.Get(css);
+  if (it != cache.end() && *it->second->ParserContext() == *context) {
+    contents = it->second.Get();
+  } else {
+    contents = blink::MakeGarbageCollected<blink::StyleSheetContents>(context);
+    contents->ParseString(WTF::String::FromUTF8(css));
+    if (contents->IsCacheableForStyleElement())
+      cache.Put(css, contents);
+  }
+
+  const std::string key = GenerateStyleSheetKey();
+  document->GetStyleEngine().InjectSheet(
+      WTF::AtomicString(WTF::String::FromUTF8(key)), contents, origin);
+  return base::UTF8ToUTF16(key);
+}
+
+}  // namespace electron
@@ -0,0 +1,33 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_INJECTED_STYLE_SHEETS_H_
+#define ELECTRON_SHELL_RENDERER_INJECTED_STYLE_SHEETS_H_
+
+#include <string>
+
+#include "third_party/blink/public/web/web_document.h"
+
+namespace blink {
+class WebLocalFrame;
+}
+
+namespace electron {
+
+// Injects |css| into the document of |frame| like
+// blink::WebDocument::InsertStyleSheet, and returns the key with which it can
+// be removed with blink::WebDocument::RemoveInsertedStyleSheet.
+//
+// The parsed sheets are kept per renderer process and keyed by their
+// contents, so that injecting the same stylesheet into other frames reuses the
+// parse instead of running it again. A parse is only reused by documents
+// which would have parsed it the same way (same base URL, parser mode...),
+// and never for sheets with @import rules as those load per document.
+std::u16string InsertStyleSheet(blink::WebLocalFrame* frame,
+                                const std::string& css,
+                                blink::WebCssOrigin origin);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_RENDERER_INJECTED_STYLE_SHEETS_H_
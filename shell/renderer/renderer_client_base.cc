@@ -288,6 +288,32 @@ void RendererClientBase::RenderThreadStarted() {
     SetCurrentProcessExplicitAppUserModelID(app_id.c_str());
   }
 #endif
+
+  if (command_line->HasSwitch(switches::kNearHeapLimitNotify)) {
+    content::RenderThread::Get()->BindHostReceiver(
+        heap_limit_observer_.BindNewPipeAndPassReceiver());
+    blink::MainThreadIsolate()->AddNearHeapLimitCallback(
+        &RendererClientBase::OnNearHeapLimit, this);
+  }
+}
+
+// static
+size_t RendererClientBase::OnNearHeapLimit(void* data,
+                                           size_t current_heap_limit,
+                                           size_t initial_heap_limit) {
+  // The limit is only raised once, V8 runs out of memory the next time.
+  if (current_heap_limit > initial_heap_limit)
+    return current_heap_limit;
+
+  auto* self = static_cast<RendererClientBase*>(data);
+  v8::HeapStatistics heap_statistics;
+  blink::MainThreadIsolate()->GetHeapStatistics(&heap_statistics);
+  // Enough headroom for the browser process to get the message and tear the
+  // page down.
+  const size_t heap_limit = current_heap_limit + current_heap_limit / 4;
+  self->heap_limit_observer_->OnNearHeapLimit(
+      initial_heap_limit, heap_limit, heap_statistics.used_heap_size());
+  return heap_limit;
 }
 
 void RendererClientBase::ExposeInterfacesToBrowser(mojo::BinderMap* binders) {
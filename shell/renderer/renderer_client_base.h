@@ -10,6 +10,8 @@
 
 #include "content/public/renderer/content_renderer_client.h"
 #include "electron/buildflags/buildflags.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "printing/buildflags/buildflags.h"
 #include "shell/common/gin_helper/dictionary.h"
 // In SHARED_INTERMEDIATE_DIR.
@@ -149,6 +151,11 @@ class RendererClientBase : public content::ContentRendererClient
 #endif
 
  private:
+  // v8::NearHeapLimitCallback for the main thread isolate.
+  static size_t OnNearHeapLimit(void* data,
+                                size_t current_heap_limit,
+                                size_t initial_heap_limit);
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ExtensionsClient> extensions_client_;
   std::unique_ptr<ElectronExtensionsRendererClient> extensions_renderer_client_;
@@ -161,6 +168,9 @@ class RendererClientBase : public content::ContentRendererClient
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   std::unique_ptr<SpellCheck> spellcheck_;
 #endif
+
+  // Bound when the page asked for webPreferences.nearHeapLimit.
+  mojo::Remote<mojom::ElectronHeapLimitObserver> heap_limit_observer_;
 };
 
 }  // namespace electron
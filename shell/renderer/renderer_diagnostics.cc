@@ -0,0 +1,120 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/renderer_diagnostics.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/process/process_metrics.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/common/javascript_stack.h"
+#include "third_party/blink/public/web/blink.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron {
+
+namespace {
+
+using CaptureCallback =
+    mojom::ElectronRendererDiagnostics::CaptureJavaScriptStackCallback;
+
+// One CaptureJavaScriptStack() request, which the interrupt on the main
+// thread and the timeout on the diagnostics sequence race to finish.
+class StackCapture : public base::RefCountedThreadSafe<StackCapture> {
+ public:
+  StackCapture(base::TimeDelta min_duration, CaptureCallback callback)
+      : task_runner_(base::SequencedTaskRunner::GetCurrentDefault()),
+        callback_(std::move(callback)),
+        metrics_(base::ProcessMetrics::CreateCurrentProcessMetrics()),
+        start_(base::TimeTicks::Now()),
+        min_end_(start_ + min_duration),
+        start_cpu_(metrics_->GetCumulativeCPUUsage()) {}
+
+  // disable copy
+  StackCapture(const StackCapture&) = delete;
+  StackCapture& operator=(const StackCapture&) = delete;
+
+  void Start(v8::Isolate* isolate, base::TimeDelta timeout) {
+    // The interrupt keeps the capture alive until it runs.
+    isolate->RequestInterrupt(&StackCapture::OnInterrupt,
+                              new scoped_refptr<StackCapture>(this));
+    task_runner_->PostDelayedTask(
+        FROM_HERE,
+        base::BindOnce(&StackCapture::Finish, base::WrapRefCounted(this),
+                       std::string()),
+        timeout);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<StackCapture>;
+
+  ~StackCapture() = default;
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    std::unique_ptr<scoped_refptr<StackCapture>> self(
+        static_cast<scoped_refptr<StackCapture>*>(data));
+    std::string stack = CaptureJavaScriptStack(isolate);
+    (*self)->task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&StackCapture::Finish, *self, std::move(stack)));
+  }
+
+  void Finish(std::string stack) {
+    if (!callback_)
+      return;
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (now < min_end_) {
+      task_runner_->PostDelayedTask(
+          FROM_HERE,
+          base::BindOnce(&StackCapture::Finish, base::WrapRefCounted(this),
+                         std::move(stack)),
+          min_end_ - now);
+      return;
+    }
+    auto sample = mojom::JavaScriptStackSample::New();
+    sample->stack = std::move(stack);
+    sample->cpu_time = metrics_->GetCumulativeCPUUsage() - start_cpu_;
+    sample->duration = now - start_;
+    std::move(callback_).Run(std::move(sample));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  CaptureCallback callback_;
+  std::unique_ptr<base::ProcessMetrics> metrics_;
+  const base::TimeTicks start_;
+  const base::TimeTicks min_end_;
+  const base::TimeDelta start_cpu_;
+};
+
+}  // namespace
+
+// static
+void RendererDiagnostics::Bind(
+    mojo::PendingReceiver<mojom::ElectronRendererDiagnostics> receiver) {
+  mojo::MakeSelfOwnedReceiver(std::make_unique<RendererDiagnostics>(),
+                              std::move(receiver));
+}
+
+RendererDiagnostics::RendererDiagnostics() = default;
+
+RendererDiagnostics::~RendererDiagnostics() = default;
+
+void RendererDiagnostics::CaptureJavaScriptStack(
+    base::TimeDelta timeout,
+    base::TimeDelta min_duration,
+    CaptureJavaScriptStackCallback callback) {
+  auto capture =
+      base::MakeRefCounted<StackCapture>(min_duration, std::move(callback));
+  // The isolate of the main thread lives as long as the process, requesting
+  // an interrupt is safe from any thread.
+  capture->Start(blink::MainThreadIsolate(), timeout);
+}
+
+}  // namespace electron
@@ -0,0 +1,35 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
+#define ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
+
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+
+namespace electron {
+
+// Answers the diagnostics requests of the browser process about the main
+// thread of this renderer, from a sequence of the thread pool.
+class RendererDiagnostics : public mojom::ElectronRendererDiagnostics {
+ public:
+  static void Bind(
+      mojo::PendingReceiver<mojom::ElectronRendererDiagnostics> receiver);
+
+  RendererDiagnostics();
+  ~RendererDiagnostics() override;
+
+  // disable copy
+  RendererDiagnostics(const RendererDiagnostics&) = delete;
+  RendererDiagnostics& operator=(const RendererDiagnostics&) = delete;
+
+  // mojom::ElectronRendererDiagnostics
+  void CaptureJavaScriptStack(base::TimeDelta timeout,
+                              base::TimeDelta min_duration,
+                              CaptureJavaScriptStackCallback callback) override;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
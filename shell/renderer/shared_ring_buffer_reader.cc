@@ -0,0 +1,194 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/shared_ring_buffer_reader.h"
+
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/task/single_thread_task_runner.h"
+#include "gin/arguments.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/shared_ring_buffer.h"
+#include "shell/common/v8_value_serializer.h"
+#include "third_party/blink/public/web/blink.h"
+
+namespace electron {
+
+namespace {
+
+constexpr size_t kMaxRecordsPerTask = 256;
+
+v8::Local<v8::Value> RecordToV8(v8::Isolate* isolate,
+                                base::span<const uint8_t> record) {
+  if (record.empty())
+    return v8::Undefined(isolate);
+  auto type = static_cast<SharedRingBufferRecordType>(record[0]);
+  auto body = record.subspan(1);
+  switch (type) {
+    case SharedRingBufferRecordType::kBytes: {
+      auto array_buffer = v8::ArrayBuffer::New(isolate, body.size());
+      if (!body.empty())
+        memcpy(array_buffer->Data(), body.data(), body.size());
+      return v8::Uint8Array::New(array_buffer, 0, body.size());
+    }
+    case SharedRingBufferRecordType::kSerializedValue:
+      return DeserializeV8Value(isolate, body);
+  }
+  return v8::Undefined(isolate);
+}
+
+}  // namespace
+
+gin::WrapperInfo SharedRingBufferReader::kWrapperInfo = {
+    gin::kEmbedderNativeGin};
+
+SharedRingBufferReader::SharedRingBufferReader(
+    v8::Local<v8::Context> context,
+    std::unique_ptr<SharedRingBuffer> buffer,
+    mojo::PendingReceiver<mojom::ElectronRingBufferReader> receiver)
+    : context_(context->GetIsolate(), context), buffer_(std::move(buffer)) {
+  context_.SetWeak();
+  receiver_.Bind(std::move(receiver));
+  receiver_.set_disconnect_handler(base::BindOnce(
+      &SharedRingBufferReader::OnDisconnect, base::Unretained(this)));
+}
+
+SharedRingBufferReader::~SharedRingBufferReader() = default;
+
+// static
+gin::Handle<SharedRingBufferReader> SharedRingBufferReader::Create(
+    v8::Local<v8::Context> context,
+    std::unique_ptr<SharedRingBuffer> buffer,
+    mojo::PendingReceiver<mojom::ElectronRingBufferReader> receiver) {
+  return gin::CreateHandle(
+      context->GetIsolate(),
+      new SharedRingBufferReader(context, std::move(buffer),
+                                 std::move(receiver)));
+}
+
+void SharedRingBufferReader::Wake() {
+  ScheduleDrain();
+}
+
+void SharedRingBufferReader::Start(gin::Arguments* args) {
+  v8::Local<v8::Function> listener;
+  if (!args->GetNext(&listener)) {
+    args->ThrowTypeError("Expected a listener function");
+    return;
+  }
+  v8::Local<v8::Function> close_listener;
+  if (args->GetNext(&close_listener))
+    close_listener_.Reset(args->isolate(), close_listener);
+
+  if (!buffer_ || !listener_.IsEmpty())
+    return;
+  listener_.Reset(args->isolate(), listener);
+  Pin();
+  // Records may have been written before anyone was listening.
+  ScheduleDrain();
+}
+
+void SharedRingBufferReader::Close() {
+  if (!buffer_)
+    return;
+  buffer_.reset();
+  receiver_.reset();
+  listener_.Reset();
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Function> close_listener = close_listener_.Get(isolate);
+  close_listener_.Reset();
+  if (!close_listener.IsEmpty() && !context_.IsEmpty()) {
+    v8::Local<v8::Context> context = context_.Get(isolate);
+    v8::Context::Scope context_scope(context);
+    v8::MicrotasksScope microtasks_scope(isolate, context->GetMicrotaskQueue(),
+                                         v8::MicrotasksScope::kRunMicrotasks);
+    std::ignore = close_listener->Call(context, v8::Undefined(isolate), 0,
+                                       nullptr);
+  }
+  Unpin();
+}
+
+void SharedRingBufferReader::ScheduleDrain() {
+  if (drain_scheduled_ || listener_.IsEmpty())
+    return;
+  drain_scheduled_ = true;
+  base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&SharedRingBufferReader::Drain,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void SharedRingBufferReader::Drain() {
+  drain_scheduled_ = false;
+  if (!buffer_ || listener_.IsEmpty())
+    return;
+  if (context_.IsEmpty()) {
+    Close();
+    return;
+  }
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = context_.Get(isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope microtasks_scope(isolate, context->GetMicrotaskQueue(),
+                                       v8::MicrotasksScope::kRunMicrotasks);
+  v8::Local<v8::Function> listener = listener_.Get(isolate);
+
+  std::vector<uint8_t> record;
+  for (size_t i = 0; i < kMaxRecordsPerTask; ++i) {
+    if (!buffer_ || !buffer_->Read(&record))
+      break;
+    v8::Local<v8::Value> value = RecordToV8(isolate, record);
+    std::ignore = listener->Call(context, v8::Undefined(isolate), 1, &value);
+  }
+
+  // The listener may have closed us.
+  if (!buffer_)
+    return;
+  if (buffer_->is_corrupted()) {
+    Close();
+  } else if (!buffer_->PrepareToWait()) {
+    ScheduleDrain();
+  } else if (writer_closed_) {
+    Close();
+  }
+}
+
+void SharedRingBufferReader::OnDisconnect() {
+  // Keep reading until the queue is empty, nothing can be added to it now.
+  writer_closed_ = true;
+  ScheduleDrain();
+}
+
+void SharedRingBufferReader::Pin() {
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate).ToLocal(&self))
+    pinned_.Reset(isolate, self);
+}
+
+void SharedRingBufferReader::Unpin() {
+  pinned_.Reset();
+}
+
+gin::ObjectTemplateBuilder SharedRingBufferReader::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SharedRingBufferReader>::GetObjectTemplateBuilder(
+             isolate)
+      .SetMethod("start", &SharedRingBufferReader::Start)
+      .SetMethod("close", &SharedRingBufferReader::Close);
+}
+
+const char* SharedRingBufferReader::GetTypeName() {
+  return "SharedRingBufferReader";
+}
+
+}  // namespace electron
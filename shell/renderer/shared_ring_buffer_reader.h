@@ -0,0 +1,89 @@
+// Copyright (c) 2023 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_SHARED_RING_BUFFER_READER_H_
+#define ELECTRON_SHELL_RENDERER_SHARED_RING_BUFFER_READER_H_
+
+#include <memory>
+
+#include "base/memory/weak_ptr.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "v8/include/v8.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+class SharedRingBuffer;
+
+// The renderer end of a queue created with webFrameMain.createRingBuffer().
+// Records are read straight out of shared memory; the main process only
+// sends a Wake() after this reader went idle.
+class SharedRingBufferReader : public gin::Wrappable<SharedRingBufferReader>,
+                               public mojom::ElectronRingBufferReader {
+ public:
+  static gin::Handle<SharedRingBufferReader> Create(
+      v8::Local<v8::Context> context,
+      std::unique_ptr<SharedRingBuffer> buffer,
+      mojo::PendingReceiver<mojom::ElectronRingBufferReader> receiver);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  SharedRingBufferReader(const SharedRingBufferReader&) = delete;
+  SharedRingBufferReader& operator=(const SharedRingBufferReader&) = delete;
+
+ private:
+  SharedRingBufferReader(
+      v8::Local<v8::Context> context,
+      std::unique_ptr<SharedRingBuffer> buffer,
+      mojo::PendingReceiver<mojom::ElectronRingBufferReader> receiver);
+  ~SharedRingBufferReader() override;
+
+  // mojom::ElectronRingBufferReader:
+  void Wake() override;
+
+  void Start(gin::Arguments* args);
+  void Close();
+
+  // Hands queued records to the listener, a bounded number per task so that a
+  // busy writer can't starve the rest of the renderer.
+  void Drain();
+  void ScheduleDrain();
+  void OnDisconnect();
+
+  // Like MessagePort, a started reader is kept alive by the queue rather than
+  // by JavaScript references to it.
+  void Pin();
+  void Unpin();
+
+  v8::Global<v8::Context> context_;
+  v8::Global<v8::Function> listener_;
+  v8::Global<v8::Function> close_listener_;
+  v8::Global<v8::Value> pinned_;
+
+  std::unique_ptr<SharedRingBuffer> buffer_;
+  mojo::Receiver<mojom::ElectronRingBufferReader> receiver_{this};
+
+  bool drain_scheduled_ = false;
+  // The writer is gone, close once the remaining records are read.
+  bool writer_closed_ = false;
+
+  base::WeakPtrFactory<SharedRingBufferReader> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_RENDERER_SHARED_RING_BUFFER_READER_H_
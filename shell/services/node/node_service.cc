@@ -7,13 +7,19 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/files/file.h"
+#include "base/functional/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/heap_snapshot.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/thread_restrictions.h"
 #include "shell/services/node/parent_port.h"
 
 namespace electron {
@@ -36,17 +42,34 @@ NodeService::~NodeService() {
   }
 }
 
-void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
+void NodeService::Warmup() {
   if (NodeBindings::IsInitialized())
     return;
 
-  ParentPort::GetInstance()->Initialize(std::move(params->port));
-
   js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
 
   v8::HandleScope scope(js_env_->isolate());
 
   node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
+}
+
+void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params,
+                             InitializeCallback callback) {
+  if (node_env_) {
+    std::move(callback).Run();
+    return;
+  }
+
+  ParentPort* parent_port = ParentPort::GetInstance();
+  parent_port->Initialize(std::move(params->port));
+  parent_port->BindIpcInvokeHandler(std::move(params->ipc_invoke_handler));
+  parent_port->BindIpcInvokeHandler(
+      std::move(params->ipc_sync_invoke_handler));
+
+  // Already done for spare processes.
+  Warmup();
+
+  v8::HandleScope scope(js_env_->isolate());
 
   // Append program path for process.argv0
   auto program = base::CommandLine::ForCurrentProcess()->GetProgram();
@@ -95,10 +118,52 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
   // both Node Env and JavaScriptEnviroment are setup to perform
   // a clean shutdown of this process.
   node_bindings_->LoadEnvironment(env);
+  std::move(callback).Run();
 
   // Run entry script.
   node_bindings_->PrepareEmbedThread();
   node_bindings_->StartPolling();
 }
 
+void NodeService::TakeHeapSnapshot(
+    mojo::ScopedHandle file,
+    bool gzip,
+    bool graph_only,
+    mojo::PendingRemote<node::mojom::HeapSnapshotProgress> progress,
+    TakeHeapSnapshotCallback callback) {
+  ScopedAllowBlockingForElectron allow_blocking;
+
+  base::ScopedPlatformFile platform_file;
+  if (!js_env_ ||
+      mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
+          MOJO_RESULT_OK) {
+    std::move(callback).Run(false);
+    return;
+  }
+  base::File base_file(std::move(platform_file));
+
+  HeapSnapshotOptions options;
+  options.gzip = gzip;
+  options.graph_only = graph_only;
+  mojo::Remote<node::mojom::HeapSnapshotProgress> progress_remote(
+      std::move(progress));
+  if (progress_remote.is_bound()) {
+    options.on_capture =
+        base::BindRepeating(&node::mojom::HeapSnapshotProgress::OnCapture,
+                            base::Unretained(progress_remote.get()));
+    options.on_write =
+        base::BindRepeating(&node::mojom::HeapSnapshotProgress::OnWrite,
+                            base::Unretained(progress_remote.get()));
+  }
+
+  std::move(callback).Run(
+      electron::TakeHeapSnapshot(js_env_->isolate(), &base_file, options));
+}
+
+void NodeService::ShareBuffer(const std::string& name,
+                              base::UnsafeSharedMemoryRegion region,
+                              uint64_t size) {
+  ParentPort::GetInstance()->AddSharedBuffer(name, std::move(region), size);
+}
+
 }  // namespace electron
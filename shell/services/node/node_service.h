@@ -6,8 +6,10 @@
 #define ELECTRON_SHELL_SERVICES_NODE_NODE_SERVICE_H_
 
 #include <memory>
+#include <string>
 
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "shell/services/node/public/mojom/node_service.mojom.h"
 
@@ -28,7 +30,18 @@ class NodeService : public node::mojom::NodeService {
   NodeService& operator=(const NodeService&) = delete;
 
   // mojom::NodeService implementation:
-  void Initialize(node::mojom::NodeServiceParamsPtr params) override;
+  void Warmup() override;
+  void Initialize(node::mojom::NodeServiceParamsPtr params,
+                  InitializeCallback callback) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      bool gzip,
+      bool graph_only,
+      mojo::PendingRemote<node::mojom::HeapSnapshotProgress> progress,
+      TakeHeapSnapshotCallback callback) override;
+  void ShareBuffer(const std::string& name,
+                   base::UnsafeSharedMemoryRegion region,
+                   uint64_t size) override;
 
  private:
   bool node_env_stopped_ = false;
@@ -5,19 +5,83 @@
 #include "shell/services/node/parent_port.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/arguments.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
+#include "gin/object_template_builder.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/shared_memory_array_buffer.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/messaging/transferable_message_mojom_traits.h"
 
 namespace electron {
 
+namespace {
+
+// Wraps the reply callback of an invoke() routed to this process, so that an
+// error is sent if the handler never replies. Mojo requires reply callbacks to
+// be run before they are destroyed.
+class ReplyChannel : public gin::Wrappable<ReplyChannel> {
+ public:
+  using InvokeCallback = node::mojom::IpcInvokeHandler::InvokeCallback;
+  static gin::Handle<ReplyChannel> Create(v8::Isolate* isolate,
+                                          InvokeCallback callback) {
+    return gin::CreateHandle(isolate, new ReplyChannel(std::move(callback)));
+  }
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override {
+    return gin::Wrappable<ReplyChannel>::GetObjectTemplateBuilder(isolate)
+        .SetMethod("sendReply", &ReplyChannel::SendReply);
+  }
+  const char* GetTypeName() override { return "ReplyChannel"; }
+
+  void SendError(const std::string& msg) {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    // If there's no current context, it means we're shutting down, so we
+    // don't need to send an event.
+    if (!isolate->GetCurrentContext().IsEmpty()) {
+      v8::HandleScope scope(isolate);
+      auto message = gin::DataObjectBuilder(isolate).Set("error", msg).Build();
+      SendReply(isolate, message);
+    }
+  }
+
+ private:
+  explicit ReplyChannel(InvokeCallback callback)
+      : callback_(std::move(callback)) {}
+  ~ReplyChannel() override {
+    if (callback_)
+      SendError("reply was never sent");
+  }
+
+  bool SendReply(v8::Isolate* isolate, v8::Local<v8::Value> arg) {
+    if (!callback_)
+      return false;
+    blink::TransferableMessage message;
+    if (!electron::SerializeV8ValueWithArrayBuffers(isolate, arg, &message))
+      return false;
+    std::move(callback_).Run(std::move(message));
+    return true;
+  }
+
+  InvokeCallback callback_;
+};
+
+gin::WrapperInfo ReplyChannel::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+}  // namespace
+
 gin::WrapperInfo ParentPort::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 ParentPort* ParentPort::GetInstance() {
@@ -25,7 +89,10 @@ ParentPort* ParentPort::GetInstance() {
   return instance.get();
 }
 
-ParentPort::ParentPort() = default;
+// Unretained is safe as |buffered_amount_| is owned by |this|.
+ParentPort::ParentPort()
+    : buffered_amount_(base::BindRepeating(&ParentPort::OnWatermark,
+                                           base::Unretained(this))) {}
 ParentPort::~ParentPort() = default;
 
 void ParentPort::Initialize(blink::MessagePortDescriptor port) {
@@ -38,22 +105,152 @@ void ParentPort::Initialize(blink::MessagePortDescriptor port) {
   connector_->set_incoming_receiver(this);
   connector_->set_connection_error_handler(
       base::BindOnce(&ParentPort::Close, base::Unretained(this)));
+  buffered_amount_.SetPipe(connector_->handle());
 }
 
-void ParentPort::PostMessage(v8::Local<v8::Value> message_value) {
-  if (!connector_closed_ && connector_ && connector_->is_valid()) {
-    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-    blink::TransferableMessage transferable_message;
-    electron::SerializeV8Value(isolate, message_value, &transferable_message);
-    mojo::Message mojo_message =
-        blink::mojom::TransferableMessage::WrapAsMessage(
-            std::move(transferable_message));
-    connector_->Accept(&mojo_message);
+void ParentPort::BindIpcInvokeHandler(
+    mojo::PendingReceiver<node::mojom::IpcInvokeHandler> receiver) {
+  if (receiver.is_valid())
+    ipc_invoke_handler_receivers_.Add(this, std::move(receiver));
+}
+
+void ParentPort::AddSharedBuffer(const std::string& name,
+                                 base::UnsafeSharedMemoryRegion region,
+                                 uint64_t size) {
+  if (!region.IsValid())
+    return;
+  shared_buffers_[name] = {std::move(region), size};
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  // parentPort.emit('-shared-buffer', name);
+  if (GetWrapper(isolate).ToLocal(&self))
+    gin_helper::EmitEvent(isolate, self, "-shared-buffer", name);
+}
+
+v8::Local<v8::Value> ParentPort::TakeSharedBuffer(v8::Isolate* isolate,
+                                                  const std::string& name) {
+  auto it = shared_buffers_.find(name);
+  if (it == shared_buffers_.end())
+    return v8::Undefined(isolate);
+  auto [region, size] = std::move(it->second);
+  shared_buffers_.erase(it);
+  v8::Local<v8::SharedArrayBuffer> buffer;
+  if (!NewSharedMemoryArrayBuffer(isolate, &region, size).ToLocal(&buffer)) {
+    gin_helper::ErrorThrower(isolate).ThrowError(
+        "Failed to map the shared buffer '" + name + "'");
+    return v8::Local<v8::Value>();
+  }
+  return buffer;
+}
+
+bool ParentPort::PostMessage(gin::Arguments* args) {
+  if (!IsConnected())
+    return false;
+
+  v8::Local<v8::Value> message_value;
+  if (!args->GetNext(&message_value)) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowTypeError("Expected at least one argument to postMessage");
+    return false;
+  }
+
+  v8::Local<v8::Value> transferables;
+  std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables) &&
+      !MessagePort::GetTransferables(args->isolate(), transferables,
+                                     &wrapped_ports, &array_buffers)) {
+    return false;
+  }
+
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8ValueWithTransfer(args->isolate(), message_value,
+                                              array_buffers,
+                                              &transferable_message)) {
+    // SerializeV8ValueWithTransfer sets an exception.
+    return false;
+  }
+
+  bool threw_exception = false;
+  transferable_message.ports = MessagePort::DisentanglePorts(
+      args->isolate(), wrapped_ports, &threw_exception);
+  if (threw_exception)
+    return false;
+
+  return SendMessage(std::move(transferable_message));
+}
+
+bool ParentPort::PostMessages(v8::Isolate* isolate,
+                              v8::Local<v8::Value> messages) {
+  if (!IsConnected())
+    return false;
+
+  std::vector<v8::Local<v8::Value>> message_values;
+  if (!gin::ConvertFromV8(isolate, messages, &message_values)) {
+    gin_helper::ErrorThrower(isolate).ThrowTypeError(
+        "messages must be an array");
+    return false;
+  }
+
+  // All of the messages are serialized first, so that none of them is sent
+  // if one can't be cloned.
+  std::vector<blink::TransferableMessage> transferable_messages(
+      message_values.size());
+  for (size_t i = 0; i < message_values.size(); ++i) {
+    if (!electron::SerializeV8Value(isolate, message_values[i],
+                                    &transferable_messages[i])) {
+      return false;
+    }
+  }
+
+  bool below_high_watermark = true;
+  for (auto& transferable_message : transferable_messages) {
+    if (!IsConnected())
+      return false;
+    below_high_watermark = SendMessage(std::move(transferable_message));
+  }
+  return below_high_watermark;
+}
+
+bool ParentPort::IsConnected() const {
+  return !connector_closed_ && connector_ && connector_->is_valid();
+}
+
+bool ParentPort::SendMessage(blink::TransferableMessage message) {
+  const uint64_t size = BufferedAmountTracker::GetMessageSize(message);
+  mojo::Message mojo_message =
+      blink::mojom::TransferableMessage::WrapAsMessage(std::move(message));
+  connector_->Accept(&mojo_message);
+  buffered_amount_.OnMessagePosted(size);
+  return !buffered_amount_.is_above_high_watermark();
+}
+
+uint64_t ParentPort::GetBufferedAmount() {
+  return buffered_amount_.GetBufferedAmount();
+}
+
+void ParentPort::SetWatermarks(const gin_helper::Dictionary& options) {
+  uint64_t high = 0;
+  uint64_t low = 0;
+  options.Get("high", &high);
+  options.Get("low", &low);
+  buffered_amount_.SetWatermarks(high, low);
+}
+
+void ParentPort::OnWatermark(bool high) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate).ToLocal(&self)) {
+    gin_helper::EmitEvent(
+        isolate, self, high ? "buffered-amount-high" : "buffered-amount-low");
   }
 }
 
 void ParentPort::Close() {
   if (!connector_closed_ && connector_->is_valid()) {
+    buffered_amount_.SetPipe(mojo::MessagePipeHandle());
     port_.GiveDisentangledHandle(connector_->PassMessagePipe());
     connector_ = nullptr;
     port_.Reset();
@@ -85,7 +282,7 @@ bool ParentPort::Accept(mojo::Message* mojo_message) {
   auto wrapped_ports =
       MessagePort::EntanglePorts(isolate, std::move(message.ports));
   v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate, message);
+      electron::DeserializeV8ValueWithArrayBuffers(isolate, &message);
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
     return false;
@@ -97,6 +294,30 @@ bool ParentPort::Accept(mojo::Message* mojo_message) {
   return true;
 }
 
+void ParentPort::Invoke(node::mojom::IpcInvokeSenderPtr sender,
+                        const std::string& channel,
+                        blink::CloneableMessage arguments,
+                        InvokeCallback callback) {
+  TRACE_EVENT1("electron", "ParentPort::Invoke", "channel", channel);
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto reply_channel = ReplyChannel::Create(isolate, std::move(callback));
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self)) {
+    reply_channel->SendError("No handler registered for '" + channel + "'");
+    return;
+  }
+  auto event = gin::DataObjectBuilder(isolate)
+                   .Set("senderId", sender->web_contents_id)
+                   .Set("processId", sender->process_id)
+                   .Set("frameId", sender->frame_id)
+                   .Set("_replyChannel", reply_channel)
+                   .Build();
+  v8::Local<v8::Value> args = electron::DeserializeV8Value(isolate, arguments);
+  // parentPort.emit('-ipc-invoke', event, channel, args);
+  gin_helper::EmitEvent(isolate, self, "-ipc-invoke", event, channel, args);
+}
+
 // static
 gin::Handle<ParentPort> ParentPort::Create(v8::Isolate* isolate) {
   return gin::CreateHandle(isolate, ParentPort::GetInstance());
@@ -107,6 +328,10 @@ gin::ObjectTemplateBuilder ParentPort::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<ParentPort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &ParentPort::PostMessage)
+      .SetMethod("postMessages", &ParentPort::PostMessages)
+      .SetProperty("bufferedAmount", &ParentPort::GetBufferedAmount)
+      .SetMethod("setWatermarks", &ParentPort::SetWatermarks)
+      .SetMethod("takeSharedBuffer", &ParentPort::TakeSharedBuffer)
       .SetMethod("start", &ParentPort::Start)
       .SetMethod("pause", &ParentPort::Pause);
 }
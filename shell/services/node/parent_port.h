@@ -5,12 +5,20 @@
 #ifndef ELECTRON_SHELL_SERVICES_NODE_PARENT_PORT_H_
 #define ELECTRON_SHELL_SERVICES_NODE_PARENT_PORT_H_
 
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
 
+#include "base/memory/unsafe_shared_memory_region.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/buffered_amount_tracker.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
 
 namespace v8 {
 template <class T>
@@ -25,13 +33,18 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
+namespace gin_helper {
+class Dictionary;
+}
+
 namespace electron {
 
 // There is only a single instance of this class
 // for the lifetime of a Utility Process which
 // also means that GC lifecycle is ignored by this class.
 class ParentPort : public gin::Wrappable<ParentPort>,
-                   public mojo::MessageReceiver {
+                   public mojo::MessageReceiver,
+                   public node::mojom::IpcInvokeHandler {
  public:
   static ParentPort* GetInstance();
   static gin::Handle<ParentPort> Create(v8::Isolate* isolate);
@@ -42,6 +55,13 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   ParentPort();
   ~ParentPort() override;
   void Initialize(blink::MessagePortDescriptor port);
+  void BindIpcInvokeHandler(
+      mojo::PendingReceiver<node::mojom::IpcInvokeHandler> receiver);
+  // Keeps a region shared by the parent until the child asks for it with
+  // parentPort.getSharedBuffer(name).
+  void AddSharedBuffer(const std::string& name,
+                       base::UnsafeSharedMemoryRegion region,
+                       uint64_t size);
 
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
@@ -50,7 +70,15 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   const char* GetTypeName() override;
 
  private:
-  void PostMessage(v8::Local<v8::Value> message_value);
+  bool PostMessage(gin::Arguments* args);
+  bool PostMessages(v8::Isolate* isolate, v8::Local<v8::Value> messages);
+  bool IsConnected() const;
+  bool SendMessage(blink::TransferableMessage message);
+  uint64_t GetBufferedAmount();
+  void SetWatermarks(const gin_helper::Dictionary& options);
+  void OnWatermark(bool high);
+  v8::Local<v8::Value> TakeSharedBuffer(v8::Isolate* isolate,
+                                        const std::string& name);
   void Close();
   void Start();
   void Pause();
@@ -58,9 +86,22 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
+  // node::mojom::IpcInvokeHandler
+  void Invoke(node::mojom::IpcInvokeSenderPtr sender,
+              const std::string& channel,
+              blink::CloneableMessage arguments,
+              InvokeCallback callback) override;
+
   bool connector_closed_ = false;
   std::unique_ptr<mojo::Connector> connector_;
   blink::MessagePortDescriptor port_;
+  BufferedAmountTracker buffered_amount_;
+  // The regions shared by the parent that the child hasn't mapped yet, with
+  // their size.
+  std::map<std::string, std::pair<base::UnsafeSharedMemoryRegion, uint64_t>>
+      shared_buffers_;
+  mojo::ReceiverSet<node::mojom::IpcInvokeHandler>
+      ipc_invoke_handler_receivers_;
 };
 
 }  // namespace electron
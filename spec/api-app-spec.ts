@@ -10,6 +10,7 @@ import { app, BrowserWindow, Menu, session, net as electronNet, WebContents } fr
 import { closeWindow, closeAllWindows } from './lib/window-helpers';
 import { ifdescribe, ifit, listen, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
+import { setTimeout } from 'node:timers/promises';
 import split = require('split')
 
 const fixturesPath = path.resolve(__dirname, 'fixtures');
@@ -351,6 +352,49 @@ describe('app module', () => {
     });
   });
 
+  describe('app.requestSingleInstanceLockAsync', () => {
+    it('prevents the second launch of app', async function () {
+      this.timeout(120000);
+      const appPath = path.join(fixturesPath, 'api', 'singleton-data');
+      const first = cp.spawn(process.execPath, [appPath, '--async']);
+      const firstStdoutLines = first.stdout.pipe(split());
+      while ((await once(firstStdoutLines, 'data')).toString() !== 'started') {
+        // wait.
+      }
+      const received = once(firstStdoutLines, 'data');
+
+      const second = cp.spawn(process.execPath, [appPath, '--async', '--send-data']);
+      const [code2] = await once(second, 'exit');
+      expect(code2).to.equal(1);
+      const [code1] = await once(first, 'exit');
+      expect(code1).to.equal(0);
+
+      const [, additionalData] = (await received)[0].toString('ascii').split('||');
+      expect(JSON.parse(additionalData)).to.have.property('testkey', 'testvalue1');
+    });
+
+    it('sends Buffers as binary data', async function () {
+      this.timeout(120000);
+      const appPath = path.join(fixturesPath, 'api', 'singleton-data');
+      // The first instance takes the lock with the synchronous API, it
+      // receives binary data all the same.
+      const first = cp.spawn(process.execPath, [appPath]);
+      const firstStdoutLines = first.stdout.pipe(split());
+      while ((await once(firstStdoutLines, 'data')).toString() !== 'started') {
+        // wait.
+      }
+      const received = once(firstStdoutLines, 'data');
+
+      const second = cp.spawn(process.execPath, [appPath, '--async', '--send-data', '--send-binary']);
+      const [code2] = await once(second, 'exit');
+      expect(code2).to.equal(1);
+      await once(first, 'exit');
+
+      const [, additionalData] = (await received)[0].toString('ascii').split('||');
+      expect(JSON.parse(additionalData)).to.deep.equal({ type: 'Buffer', data: [1, 2, 3, 0, 255] });
+    });
+  });
+
   describe('app.relaunch', () => {
     let server: net.Server | null = null;
     const socketPath = process.platform === 'win32' ? '\\\\.\\pipe\\electron-app-relaunch' : '/tmp/electron-app-relaunch';
@@ -1338,6 +1382,27 @@ describe('app module', () => {
         expect(size.width).to.equal(sizes.large);
       });
     });
+
+    describe('getFileIcons()', () => {
+      it('fetches the icons in the order of the paths', async () => {
+        const icons = await app.getFileIcons([iconPath, iconPath], { size: 'small' });
+        expect(icons).to.have.lengthOf(2);
+        for (const icon of icons) {
+          expect(icon).to.not.be.null();
+          expect(icon!.getSize()).to.deep.equal({ width: sizes.small, height: sizes.small });
+        }
+      });
+
+      it('resolves with an empty array for no paths', async () => {
+        expect(await app.getFileIcons([])).to.deep.equal([]);
+      });
+
+      it('returns the same icon as getFileIcon()', async () => {
+        const [icon] = await app.getFileIcons([iconPath]);
+        const single = await app.getFileIcon(iconPath);
+        expect(icon!.toDataURL()).to.equal(single.toDataURL());
+      });
+    });
   });
 
   describe('getAppMetrics() API', () => {
@@ -1377,6 +1442,18 @@ describe('app module', () => {
         if (process.platform === 'win32') {
           expect(entry.integrityLevel).to.be.a('string');
         }
+
+        if (entry.type === 'Browser') {
+          expect(entry.uvLoop).to.have.property('uvTime').that.is.at.least(0);
+          expect(entry.uvLoop).to.have.property('taskTime').that.is.greaterThan(0);
+          expect(entry.uvLoop).to.have.property('runs').that.is.greaterThan(0);
+          expect(entry.uvLoop).to.have.property('overBudgetRuns', 0);
+          expect(entry.imageCache).to.have.property('entries').that.is.a('number');
+          expect(entry.imageCache).to.have.property('memory').that.is.a('number');
+        } else {
+          expect(entry).to.not.have.property('uvLoop');
+          expect(entry).to.not.have.property('imageCache');
+        }
       }
 
       if (process.platform === 'darwin') {
@@ -1387,6 +1464,317 @@ describe('app module', () => {
     });
   });
 
+  describe('app.getProcessMemoryDetails()', () => {
+    it('returns the memory of each allocator per process', async () => {
+      const details = await app.getProcessMemoryDetails();
+      const browser = details.find(entry => entry.pid === process.pid);
+      expect(browser).to.have.property('type', 'Browser');
+      expect(browser!.private).to.be.a('number').that.is.greaterThan(0);
+      expect(browser!.shared).to.be.a('number');
+      expect(browser!.allocators.v8).to.be.a('number').that.is.greaterThan(0);
+    });
+  });
+
+  describe('app.setBackgroundMemoryPolicy()', () => {
+    afterEach(() => {
+      app.setBackgroundMemoryPolicy(null);
+    });
+
+    it('accepts a policy and null', () => {
+      expect(() => app.setBackgroundMemoryPolicy({ hiddenTime: 0, actions: ['reduce', 'freeze', 'discard'] })).to.not.throw();
+      expect(() => app.setBackgroundMemoryPolicy(null)).to.not.throw();
+    });
+
+    it('validates the policy', () => {
+      expect(() => app.setBackgroundMemoryPolicy({ checkInterval: 10 })).to.throw(/at least 1000 milliseconds/);
+      expect(() => app.setBackgroundMemoryPolicy({ actions: ['sleep' as any] })).to.throw(/actions must only contain/);
+    });
+  });
+
+  describe('app.setBackgroundTrimming()', () => {
+    afterEach(async () => {
+      app.setBackgroundTrimming(null);
+      await closeAllWindows();
+    });
+
+    it('trims the app once its windows are hidden', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      app.setBackgroundTrimming({ delay: 100 });
+      const [, report] = await once(app, 'background-trim');
+      expect(report.reason).to.equal('windows-hidden');
+      const browser = report.processes.find((entry: any) => entry.pid === process.pid);
+      expect(browser).to.have.property('type', 'Browser');
+      expect(browser.reclaimed).to.equal(Math.max(browser.before - browser.after, 0));
+    });
+
+    it('validates the options', () => {
+      expect(() => app.setBackgroundTrimming({ delay: -1 })).to.throw(/must not be negative/);
+    });
+  });
+
+  describe('app.setHangDetection()', () => {
+    afterEach(() => {
+      app.setHangDetection(null);
+    });
+
+    it('reports a hang of the main thread with its JavaScript stack', async () => {
+      const reportDirectory = fs.mkdtempSync(path.join(app.getPath('temp'), 'electron-hang-'));
+      try {
+        app.setHangDetection({ threshold: 100, reportDirectory });
+        const spinMainThread = () => {
+          const end = Date.now() + 1000;
+          while (Date.now() < end);
+        };
+        setImmediate(spinMainThread);
+        const [, details] = await once(app, 'main-thread-hang');
+        expect(details.source).to.equal('main-thread');
+        expect(details.duration).to.be.at.least(100);
+        expect(details.jsStack).to.include('spinMainThread');
+        const report = JSON.parse(fs.readFileSync(details.reportPath, 'utf8'));
+        expect(report.source).to.equal('main-thread');
+        expect(report.jsStack).to.equal(details.jsStack);
+        const metrics = app.getHangMetrics();
+        expect(metrics.count).to.equal(1);
+        expect(metrics.longestDuration).to.equal(details.duration);
+      } finally {
+        fs.removeSync(reportDirectory);
+      }
+    });
+
+    it('validates the options', () => {
+      expect(() => app.setHangDetection({ threshold: 10 })).to.throw(/at least 100 milliseconds/);
+    });
+
+    it('has no metrics when not watching', () => {
+      expect(app.getHangMetrics()).to.deep.equal({ count: 0, totalDuration: 0, longestDuration: 0 });
+    });
+  });
+
+  describe('app.trimMemory()', () => {
+    afterEach(closeAllWindows);
+
+    it('reports the footprint of the processes', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const report = await app.trimMemory();
+      expect(report.reason).to.equal('manual');
+      const renderer = report.processes.find(entry => entry.pid === w.webContents.getOSProcessId());
+      expect(renderer).to.have.property('type', 'Tab');
+      expect(renderer!.before).to.be.greaterThan(0);
+    });
+  });
+
+  describe('app.startMetricsSampling()', () => {
+    afterEach(() => {
+      app.stopMetricsSampling();
+    });
+
+    it('samples the metrics in the background', async () => {
+      expect(app.getLatestAppMetrics()).to.deep.equal([]);
+      app.startMetricsSampling({ interval: 100 });
+      const [, details] = await once(app, 'app-metrics-updated');
+      expect(details.updated).to.be.an('array').that.is.not.empty();
+      expect(details.removed).to.be.an('array');
+      const latest = app.getLatestAppMetrics();
+      const browser = latest.find(entry => entry.type === 'Browser');
+      expect(browser).to.have.property('pid', process.pid);
+      expect(browser!.cpu.percentCPUUsage).to.be.a('number');
+      expect(browser!.creationTime).to.be.a('number').that.is.greaterThan(0);
+    });
+
+    it('discards the metrics when stopped', async () => {
+      app.startMetricsSampling({ interval: 100 });
+      await once(app, 'app-metrics-updated');
+      app.stopMetricsSampling();
+      expect(app.getLatestAppMetrics()).to.deep.equal([]);
+    });
+
+    it('validates the interval', () => {
+      expect(() => app.startMetricsSampling({ interval: 10 })).to.throw(/at least 100 milliseconds/);
+    });
+  });
+
+  describe('app.getStartupTimeline()', () => {
+    it('returns the phases of the startup in order', () => {
+      const timeline = app.getStartupTimeline();
+      const names = timeline.map(phase => phase.name);
+      expect(names).to.include.members(['basic-startup-complete', 'post-early-initialization', 'load-main-script', 'app-ready']);
+      expect(names.indexOf('load-main-script')).to.be.lessThan(names.indexOf('app-ready'));
+      for (let i = 0; i < timeline.length; i++) {
+        expect(timeline[i].endTime).to.be.at.least(timeline[i].startTime);
+        if (i > 0) expect(timeline[i].startTime).to.be.at.least(timeline[i - 1].startTime);
+      }
+    });
+
+    it('records the first window and its first paint', async () => {
+      const w = new BrowserWindow({ show: false });
+      try {
+        await w.loadURL('data:text/html,<h1>hello</h1>');
+        const names = app.getStartupTimeline().map(phase => phase.name);
+        expect(names).to.include.members(['first-browser-window-created', 'first-navigation-committed']);
+      } finally {
+        w.destroy();
+      }
+    });
+
+    it('records the subsystems which are set up when first needed', () => {
+      const names = app.getStartupTimeline().map(phase => phase.name);
+      expect(names).to.include.members(['initialize-extensions', 'create-network-quality-observer']);
+      expect(names.indexOf('initialize-extensions')).to.be.greaterThan(names.indexOf('pre-main-message-loop-run'));
+    });
+  });
+
+  describe('app.writeStartupTrace()', () => {
+    const tracePath = path.join(app.getPath('temp'), 'electron-startup-trace.json');
+    afterEach(() => fs.rmSync(tracePath, { force: true }));
+
+    it('writes the timeline in the trace event format', async () => {
+      await app.writeStartupTrace(tracePath);
+      const { traceEvents } = JSON.parse(fs.readFileSync(tracePath, 'utf8'));
+      const names = traceEvents.filter((event: any) => event.ph !== 'M').map((event: any) => event.name);
+      expect(names).to.deep.equal(app.getStartupTimeline().map(phase => phase.name));
+      const ready = traceEvents.find((event: any) => event.name === 'app-ready');
+      expect(ready).to.include({ ph: 'i', pid: process.pid });
+    });
+  });
+
+  describe('app.setLogFile()', () => {
+    const logPath = path.join(app.getPath('temp'), 'electron-structured.log');
+    const removeLogs = () => {
+      for (const file of [logPath, `${logPath}.1`, `${logPath}.2`]) {
+        fs.rmSync(file, { force: true });
+      }
+    };
+
+    beforeEach(removeLogs);
+    afterEach(async () => {
+      app.setLogFile(null);
+      await app.flushLog();
+      removeLogs();
+    });
+
+    it('writes JSON records', async () => {
+      app.setLogFile(logPath);
+      app.log('info', 'hello', { answer: 42 });
+      app.log('error', 'oops');
+      await app.flushLog();
+
+      const records = fs.readFileSync(logPath, 'utf8').trim().split('\n').map(line => JSON.parse(line));
+      expect(records).to.have.lengthOf(2);
+      expect(records[0]).to.include({ level: 'info', source: 'app', message: 'hello' });
+      expect(records[0].fields).to.deep.equal({ answer: 42 });
+      expect(records[0].time).to.be.closeTo(Date.now(), 60000);
+      expect(records[1]).to.include({ level: 'error', message: 'oops' });
+      expect(records[1]).to.not.have.property('fields');
+    });
+
+    it('writes binary records', async () => {
+      app.setLogFile(logPath, { format: 'binary' });
+      app.log('warn', 'binary');
+      await app.flushLog();
+
+      const data = fs.readFileSync(logPath);
+      expect(data.subarray(0, 4).toString()).to.equal('ELOG');
+      const size = data.readUInt32LE(8);
+      expect(data).to.have.lengthOf(12 + size);
+      expect(data.readInt32LE(20)).to.equal(1);
+      const messageSize = data.readUInt32LE(28);
+      expect(data.subarray(44, 44 + messageSize).toString()).to.equal('binary');
+    });
+
+    it('rotates the file once it is too large', async () => {
+      app.setLogFile(logPath, { maxSize: 1024, maxFiles: 2 });
+      for (let i = 0; i < 10; i++) {
+        app.log('info', 'x'.repeat(200));
+        await app.flushLog();
+      }
+
+      expect(fs.statSync(logPath).size).to.be.at.most(1024);
+      expect(fs.existsSync(`${logPath}.1`)).to.be.true();
+      expect(fs.existsSync(`${logPath}.2`)).to.be.false();
+    });
+
+    it('does nothing without a log file', async () => {
+      app.log('info', 'dropped');
+      await app.flushLog();
+      expect(fs.existsSync(logPath)).to.be.false();
+    });
+
+    it('rejects an invalid level', () => {
+      expect(() => app.log('loud' as any, 'message')).to.throw(/level must be/);
+    });
+  });
+
+  describe('event loop monitor', () => {
+    afterEach(() => app.stopEventLoopMonitor());
+
+    it('returns null while stopped', () => {
+      expect(app.getEventLoopMetrics()).to.be.null();
+    });
+
+    it('records long tasks and queueing delay', async () => {
+      app.startEventLoopMonitor({ longTaskThreshold: 20, sampleInterval: 10 });
+      await setTimeout(0);
+      const end = Date.now() + 50;
+      while (Date.now() < end);
+      await setTimeout(100);
+
+      const metrics = app.getEventLoopMetrics()!;
+      expect(metrics.queueingDelay.count).to.be.greaterThan(0);
+      expect(metrics.taskDuration.count).to.be.greaterThan(0);
+      expect(metrics.taskDuration.counts).to.have.lengthOf(14);
+      expect(metrics.uvRunDuration.max).to.be.at.least(50);
+      expect(metrics.longTasks).to.have.length.at.least(1);
+      expect(metrics.longTasks[0].duration).to.be.at.least(20);
+    });
+
+    it('rejects invalid options', () => {
+      expect(() => app.startEventLoopMonitor({ longTaskThreshold: -1 })).to.throw(/must be positive/);
+    });
+  });
+
+  describe('allocator stats and tuning', () => {
+    afterEach(() => app.configureAllocator({ purgeInterval: 0 }));
+
+    it('reports the allocators of the main process', () => {
+      const stats = app.getAllocatorStats();
+      expect(stats.mallocUsage).to.be.a('number');
+      expect(stats.purgeInterval).to.equal(0);
+      if (stats.partitionAlloc) {
+        expect(stats.partitionAlloc.committed).to.be.greaterThan(0);
+        expect(stats.partitionAlloc.fragmentation).to.be.within(0, 1);
+      }
+    });
+
+    it('sets the purge interval', () => {
+      app.configureAllocator({ threadCacheMultiplier: 2, purgeInterval: 5000 });
+      expect(app.getAllocatorStats().purgeInterval).to.equal(5000);
+      expect(app.purgeAllocator()).to.equal(!!app.getAllocatorStats().partitionAlloc);
+    });
+
+    it('rejects invalid options', () => {
+      expect(() => app.configureAllocator({ threadCacheMultiplier: 0 })).to.throw(/must be positive/);
+      expect(() => app.configureAllocator({ purgeInterval: 10 })).to.throw(/at least 1000/);
+    });
+  });
+
+  describe('getJSHeapAttribution() API', () => {
+    afterEach(closeAllWindows);
+
+    it('attributes what a window retains to it', () => {
+      const w = new BrowserWindow({ show: false });
+      const retained = new Array(1024 * 1024).fill(0);
+      w.webContents.on('did-finish-load', () => retained.length);
+
+      const attribution = app.getJSHeapAttribution();
+      const webContentsEntry = attribution.find(entry => entry.type === 'WebContents' && entry.id === w.webContents.id);
+      expect(webContentsEntry).to.have.property('retainedSize').that.is.at.least(1024 * 1024);
+      const windowEntry = attribution.find(entry => entry.type === 'BaseWindow' && entry.id === w.id);
+      expect(windowEntry).to.have.property('retainedSize').that.is.greaterThan(0);
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
@@ -1462,6 +1850,12 @@ describe('app module', () => {
       }
     });
 
+    it('returns the same complete GPUInfo when called again', async () => {
+      const first = await app.getGPUInfo('complete');
+      const second = await app.getGPUInfo('complete');
+      expect(second).to.deep.equal(first);
+    });
+
     it('fails for invalid info_type', () => {
       const invalidType = 'invalid';
       const expectedErrorMessage = "Invalid info type. Use 'basic' or 'complete'";
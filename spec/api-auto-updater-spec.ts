@@ -2,6 +2,9 @@ import { autoUpdater } from 'electron/main';
 import { expect } from 'chai';
 import { ifit, ifdescribe } from './lib/spec-helpers';
 import { once } from 'node:events';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import type * as fs from 'node:fs';
 
 ifdescribe(!process.mas)('autoUpdater module', function () {
   describe('checkForUpdates', function () {
@@ -86,4 +89,51 @@ ifdescribe(!process.mas)('autoUpdater module', function () {
       expect(error.message).to.equal('No update available, can\'t quit and install');
     });
   });
+
+  describe('asar deltas', () => {
+    // The archives are read as files, not as the directories of the asar
+    // support.
+    const originalFs: typeof fs = require('original-fs');
+    const fixtures = path.join(__dirname, 'fixtures', 'test.asar');
+    let dir: string;
+    beforeEach(() => {
+      dir = originalFs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-delta-'));
+    });
+    afterEach(() => {
+      originalFs.rmSync(dir, { recursive: true, force: true });
+    });
+
+    it('rebuilds the new archive from the old one and the delta', async () => {
+      const deltaPath = path.join(dir, 'delta');
+      const outputPath = path.join(dir, 'out.asar');
+      await autoUpdater.createAsarDelta(path.join(fixtures, 'a.asar'), path.join(fixtures, 'echo.asar'), deltaPath);
+      await autoUpdater.applyAsarDelta(path.join(fixtures, 'a.asar'), deltaPath, outputPath);
+      expect(originalFs.readFileSync(outputPath).equals(originalFs.readFileSync(path.join(fixtures, 'echo.asar')))).to.be.true();
+    });
+
+    it('copies the blocks the old archive has', async () => {
+      const archivePath = path.join(fixtures, 'a.asar');
+      const deltaPath = path.join(dir, 'delta');
+      const outputPath = path.join(dir, 'out.asar');
+      await autoUpdater.createAsarDelta(archivePath, archivePath, deltaPath);
+      expect(originalFs.statSync(deltaPath).size).to.be.lessThan(originalFs.statSync(archivePath).size);
+      await autoUpdater.applyAsarDelta(archivePath, deltaPath, outputPath);
+      expect(originalFs.readFileSync(outputPath).equals(originalFs.readFileSync(archivePath))).to.be.true();
+    });
+
+    it('rejects a delta applied to another archive', async () => {
+      const deltaPath = path.join(dir, 'delta');
+      const outputPath = path.join(dir, 'out.asar');
+      await autoUpdater.createAsarDelta(path.join(fixtures, 'a.asar'), path.join(fixtures, 'a.asar'), deltaPath);
+      await expect(autoUpdater.applyAsarDelta(path.join(fixtures, 'echo.asar'), deltaPath, outputPath)).to.eventually.be.rejected();
+      expect(originalFs.existsSync(outputPath)).to.be.false();
+    });
+
+    it('rejects a header which does not match headerHash', async () => {
+      const deltaPath = path.join(dir, 'delta');
+      const outputPath = path.join(dir, 'out.asar');
+      await autoUpdater.createAsarDelta(path.join(fixtures, 'a.asar'), path.join(fixtures, 'echo.asar'), deltaPath);
+      await expect(autoUpdater.applyAsarDelta(path.join(fixtures, 'a.asar'), deltaPath, outputPath, { headerHash: '00'.repeat(32) })).to.eventually.be.rejectedWith(/doesn't match the hash/);
+    });
+  });
 });
@@ -7,9 +7,10 @@ import * as http from 'node:http';
 import * as os from 'node:os';
 import { AddressInfo } from 'node:net';
 import { app, BrowserWindow, BrowserView, dialog, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, webFrameMain, session, WebContents, WebFrameMain } from 'electron/main';
+import { nativeImage } from 'electron/common';
 
 import { emittedUntil, emittedNTimes } from './lib/events-helpers';
-import { ifit, ifdescribe, defer, listen } from './lib/spec-helpers';
+import { ifit, ifdescribe, defer, listen, waitUntil } from './lib/spec-helpers';
 import { closeWindow, closeAllWindows } from './lib/window-helpers';
 import { areColorsSimilar, captureScreen, HexColors, getPixelColor } from './lib/screen-helpers';
 import { once } from 'node:events';
@@ -259,6 +260,19 @@ describe('BrowserWindow module', () => {
         contents.getProcessId();
       }).to.throw('Object has been destroyed');
     });
+    it('throws from getters called by optimized code after being destroyed', async () => {
+      const contents = w.webContents;
+      const getZoomFactor = () => contents.getZoomFactor();
+      // Enough calls for the getter to be optimized.
+      for (let i = 0; i < 100000; i++) {
+        expect(getZoomFactor()).to.equal(1);
+        expect(contents.isDestroyed()).to.equal(false);
+      }
+      w.destroy();
+      await new Promise(setImmediate);
+      expect(contents.isDestroyed()).to.equal(true);
+      expect(getZoomFactor).to.throw('Object has been destroyed');
+    });
     it('should not crash when destroying windows with pending events', () => {
       const focusListener = () => { };
       app.on('browser-window-focus', focusListener);
@@ -364,6 +378,14 @@ describe('BrowserWindow module', () => {
       w.loadURL('about:blank');
       await readyToShow;
     });
+    it('should emit ready-to-show event with the first paint timings', async () => {
+      const readyToShow = once(w, 'ready-to-show');
+      w.loadURL('about:blank');
+      const [, timings] = await readyToShow;
+      expect(timings.navigationStart).to.be.a('number');
+      expect(timings.navigationCommit).to.be.at.least(timings.navigationStart);
+      expect(timings.firstLayout).to.be.at.least(timings.navigationCommit);
+    });
     // DISABLED-FIXME(deepak1556): The error code now seems to be `ERR_FAILED`, verify what
     // changed and adjust the test.
     it('should emit did-fail-load event for files that do not exist', async () => {
@@ -1105,6 +1127,33 @@ describe('BrowserWindow module', () => {
       });
     });
 
+    describe('BrowserWindow.isOccluded()', () => {
+      it('is false for a hidden window', () => {
+        expect(w.isOccluded()).to.equal(false);
+        const metrics = w.getOcclusionMetrics();
+        expect(metrics).to.deep.equal({ occluded: false, occlusionCount: 0, occludedTime: 0 });
+      });
+
+      ifit(process.platform !== 'linux')('emits occluded when the window is covered', async () => {
+        w.setBounds({ x: 100, y: 100, width: 300, height: 300 });
+        await w.loadURL('about:blank');
+        const shown = once(w, 'show');
+        w.show();
+        await shown;
+        const cover = new BrowserWindow({ show: false, x: 50, y: 50, width: 400, height: 400 });
+        const occluded = once(w, 'occluded');
+        cover.show();
+        await occluded;
+        expect(w.isOccluded()).to.equal(true);
+        expect(w.getOcclusionMetrics().occlusionCount).to.equal(1);
+        expect(await w.webContents.executeJavaScript('document.visibilityState')).to.equal('hidden');
+        const unoccluded = once(w, 'unoccluded');
+        await closeWindow(cover);
+        await unoccluded;
+        expect(w.isOccluded()).to.equal(false);
+      });
+    });
+
     describe('BrowserWindow.showInactive()', () => {
       it('should not focus on window', () => {
         w.showInactive();
@@ -2237,6 +2286,52 @@ describe('BrowserWindow module', () => {
       // Values can be 0,2,3,4, or 6. We want 6, which is RGB + Alpha
       expect(imgBuffer[25]).to.equal(6);
     });
+
+    it('scales the image to the size option', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.setBackgroundThrottling(false);
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await once(w, 'ready-to-show');
+
+      const image = await w.capturePage(undefined, { size: { width: 40, height: 30 } });
+      expect(image.getSize()).to.deep.equal({ width: 40, height: 30 });
+    });
+  });
+
+  describe('webContents.captureEncodedPage(rect, opts)', () => {
+    afterEach(closeAllWindows);
+
+    it('rejects invalid formats', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.webContents.captureEncodedPage(undefined, { format: 'gif' as any })).to.eventually.be.rejectedWith('Invalid format');
+    });
+
+    for (const [format, magic] of [['png', '89504e47'], ['jpeg', 'ffd8ff'], ['webp', '52494646']] as const) {
+      it(`encodes the page as ${format}`, async () => {
+        const w = new BrowserWindow({ show: false });
+        w.webContents.setBackgroundThrottling(false);
+        w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+        await once(w, 'ready-to-show');
+
+        const buffer = await w.webContents.captureEncodedPage(undefined, { format, size: { width: 40, height: 30 } });
+        expect(buffer.toString('hex')).to.match(new RegExp(`^${magic}`));
+      });
+    }
+
+    it('captures several pages at once', async () => {
+      const windows = [new BrowserWindow({ show: false }), new BrowserWindow({ show: false })];
+      await Promise.all(windows.map(async (w) => {
+        w.webContents.setBackgroundThrottling(false);
+        w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+        await once(w, 'ready-to-show');
+      }));
+
+      const buffers = await webContents.capturePages(windows.map(w => w.webContents), { format: 'jpeg', size: { width: 40, height: 30 } });
+      expect(buffers).to.have.lengthOf(2);
+      for (const buffer of buffers) {
+        expect(nativeImage.createFromBuffer(buffer).getSize()).to.deep.equal({ width: 40, height: 30 });
+      }
+    });
   });
 
   describe('BrowserWindow.setProgressBar(progress)', () => {
@@ -2637,6 +2732,88 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.batch(fn)', () => {
+    afterEach(closeAllWindows);
+
+    it('returns the value returned by the function', () => {
+      expect(BrowserWindow.batch(() => 42)).to.equal(42);
+    });
+
+    it('throws when not given a function', () => {
+      expect(() => {
+        (BrowserWindow.batch as any)('not a function');
+      }).to.throw(/Expected a function/);
+    });
+
+    it('applies the bounds of the windows when the function returns', () => {
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      const b1 = { x: 10, y: 20, width: 300, height: 200 };
+      const b2 = { x: 320, y: 20, width: 300, height: 200 };
+      BrowserWindow.batch(() => {
+        w1.setBounds(b1);
+        w2.setPosition(b2.x, b2.y);
+        w2.setSize(b2.width, b2.height);
+        expectBoundsEqual(w1.getBounds(), b1);
+        expectBoundsEqual(w2.getBounds(), b2);
+      });
+      expectBoundsEqual(w1.getBounds(), b1);
+      expectBoundsEqual(w2.getBounds(), b2);
+    });
+
+    it('only applies the last change of a window', () => {
+      const w = new BrowserWindow({ show: false });
+      const bounds = { x: 50, y: 60, width: 400, height: 300 };
+      BrowserWindow.batch(() => {
+        w.setBounds({ x: 0, y: 0, width: 200, height: 200 });
+        w.setBounds(bounds);
+        w.setOpacity(0.2);
+        w.setOpacity(0.5);
+      });
+      expectBoundsEqual(w.getBounds(), bounds);
+      if (process.platform !== 'linux') {
+        expect(w.getOpacity()).to.equal(0.5);
+      }
+    });
+
+    it('applies the changes when the function throws', () => {
+      const w = new BrowserWindow({ show: false });
+      const bounds = { x: 30, y: 40, width: 250, height: 250 };
+      expect(() => {
+        BrowserWindow.batch(() => {
+          w.setBounds(bounds);
+          throw new Error('oops');
+        });
+      }).to.throw('oops');
+      expectBoundsEqual(w.getBounds(), bounds);
+    });
+
+    it('can be nested', () => {
+      const w = new BrowserWindow({ show: false });
+      const bounds = { x: 70, y: 80, width: 320, height: 240 };
+      const result = BrowserWindow.batch(() => {
+        BrowserWindow.batch(() => {
+          w.setBounds(bounds);
+        });
+        expectBoundsEqual(w.getBounds(), bounds);
+        return 'done';
+      });
+      expect(result).to.equal('done');
+      expectBoundsEqual(w.getBounds(), bounds);
+    });
+
+    it('skips the windows destroyed during the batch', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        BrowserWindow.batch(() => {
+          w.setBounds({ x: 0, y: 0, width: 100, height: 100 });
+          w.show();
+          w.destroy();
+        });
+      }).to.not.throw();
+    });
+  });
+
   describe('Opening a BrowserWindow from a link', () => {
     let appProcess: childProcess.ChildProcessWithoutNullStreams | undefined;
 
@@ -2848,6 +3025,45 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  ifdescribe(process.platform === 'win32')('"throttleLiveResize" option', () => {
+    afterEach(closeAllWindows);
+    it('resizes the page right away outside of a live resize', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        width: 400,
+        height: 400,
+        useContentSize: true,
+        throttleLiveResize: true
+      });
+      await w.loadURL('about:blank');
+      const resized = once(w, 'resize');
+      w.setContentSize(300, 200);
+      await resized;
+      const resizedPage = await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const check = () => (innerWidth === 300 && innerHeight === 200) ? resolve(true) : setTimeout(check, 10);
+        check();
+      })`);
+      expect(resizedPage).to.be.true();
+    });
+  });
+
+  describe('"fastFirstPaint" option', () => {
+    afterEach(closeAllWindows);
+    it('starts the renderer before the page is loaded', async () => {
+      const w = new BrowserWindow({ show: false, fastFirstPaint: true });
+      await waitUntil(() => w.webContents.getOSProcessId() !== 0);
+    });
+    it('loads the page it warmed the connection of', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        fastFirstPaint: { url: 'http://127.0.0.1:1' }
+      });
+      const readyToShow = once(w, 'ready-to-show');
+      w.loadURL('about:blank');
+      await readyToShow;
+    });
+  });
+
   ifdescribe(['win32', 'darwin'].includes(process.platform))('"titleBarStyle" option', () => {
     const testWindowsOverlay = async (style: any) => {
       const w = new BrowserWindow({
@@ -3351,6 +3567,27 @@ describe('BrowserWindow module', () => {
         const [, argv] = await once(ipcMain, 'answer');
         expect(argv).to.include('--my-magic-arg=foo');
       });
+
+      it('keeps the args of windows with the same preferences apart', async () => {
+        const preload = path.join(fixtures, 'module', 'check-arguments.js');
+        const getArgv = async (additionalArguments: string[]) => {
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: { nodeIntegration: true, preload, additionalArguments }
+          });
+          const answer = once(w.webContents.ipc, 'answer');
+          w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+          const [, argv] = await answer;
+          return argv as string[];
+        };
+        const first = await getArgv(['--my-magic-arg=first']);
+        const second = await getArgv(['--my-magic-arg=first']);
+        const third = await getArgv(['--my-magic-arg=third']);
+        expect(first).to.include('--my-magic-arg=first');
+        expect(second).to.include('--my-magic-arg=first');
+        expect(third).to.include('--my-magic-arg=third');
+        expect(third).to.not.include('--my-magic-arg=first');
+      });
     });
 
     describe('"node-integration" option', () => {
@@ -3422,6 +3659,39 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload');
       });
 
+      it('runs the current version of the preload script on every load', async () => {
+        const preloadDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-preload-'));
+        defer(() => fs.rmSync(preloadDir, { recursive: true, force: true }));
+        const preloadPath = path.join(preloadDir, 'preload.js');
+        const writePreload = (version: number, mtime: Date) => {
+          fs.writeFileSync(preloadPath, `window.preloadVersion = ${version}; window.preloadEnv = process.env.ELECTRON_SPEC_PRELOAD_ENV;`);
+          fs.utimesSync(preloadPath, mtime, mtime);
+        };
+        writePreload(1, new Date(2000, 0, 1));
+
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            sandbox: true,
+            preload: preloadPath,
+            contextIsolation: false
+          }
+        });
+        const load = async () => {
+          await w.loadURL('about:blank');
+          return w.webContents.executeJavaScript('[window.preloadVersion, window.preloadEnv]');
+        };
+        expect(await load()).to.deep.equal([1, undefined]);
+        // The preload is cached from then on.
+        process.env.ELECTRON_SPEC_PRELOAD_ENV = 'set';
+        defer(() => { delete process.env.ELECTRON_SPEC_PRELOAD_ENV; });
+        await setTimeout(100);
+        expect(await load()).to.deep.equal([1, 'set']);
+
+        writePreload(2, new Date(2001, 0, 1));
+        expect(await load()).to.deep.equal([2, 'set']);
+      });
+
       it('exposes "loaded" event to preload script', async () => {
         const w = new BrowserWindow({
           show: false,
@@ -4383,6 +4653,63 @@ describe('BrowserWindow module', () => {
         // upstream native_mate's implementation to gin.
       }).to.throw('Error processing argument at index 1, conversion failure from ');
     });
+
+    it('throws error when the format is invalid', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.beginFrameSubscription({ format: 'png' as any }, () => {});
+      }).to.throw('Invalid format');
+    });
+
+    for (const format of ['bgra', 'i420'] as const) {
+      it(`subscribes to raw ${format} frames`, async () => {
+        const w = new BrowserWindow({ show: false });
+        await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+        const [image, , frame] = await new Promise<[Electron.NativeImage, Electron.Rectangle, Electron.CapturedFrame?]>(resolve => {
+          w.webContents.beginFrameSubscription({ format }, (...args) => resolve(args));
+        });
+        w.webContents.endFrameSubscription();
+
+        expect(image.isEmpty()).to.be.true('image is empty');
+        expect(frame).to.be.an('object');
+        expect(frame!.format).to.equal(format);
+        expect(frame!.planes).to.have.lengthOf(format === 'i420' ? 3 : 1);
+        const last = frame!.planes[frame!.planes.length - 1];
+        expect(frame!.data.byteLength).to.be.at.least(last.offset + last.stride * last.height);
+        expect(frame!.planes[0].width).to.equal(frame!.codedSize.width);
+      });
+    }
+  });
+
+  describe('startRecording method', () => {
+    afterEach(closeAllWindows);
+
+    it('rejects relative paths', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.webContents.startRecording('video.webm')).to.eventually.be.rejectedWith('Path must be absolute');
+    });
+
+    it('rejects when the page is not being recorded', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.webContents.stopRecording()).to.eventually.be.rejectedWith('The page is not being recorded');
+    });
+
+    it('records the page into a file', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'electron-recording-'));
+      const videoPath = path.join(tmpDir, 'video.webm');
+      try {
+        await w.webContents.startRecording(videoPath, { codec: 'vp9', frameRate: 10 });
+        await expect(w.webContents.startRecording(videoPath)).to.eventually.be.rejectedWith('The page is already being recorded');
+        await setTimeout(500);
+        await w.webContents.stopRecording();
+        const { size } = await fs.promises.stat(videoPath);
+        expect(size).to.be.greaterThan(0);
+      } finally {
+        await fs.promises.rm(tmpDir, { recursive: true, force: true });
+      }
+    });
   });
 
   describe('savePage method', () => {
@@ -6102,6 +6429,70 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
     });
 
+    it('does not change the images of earlier frames', async () => {
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, first] = await once(w.webContents, 'paint') as [any, Electron.Rectangle, Electron.NativeImage];
+      const pixels = Buffer.from(first.toBitmap());
+      for (let i = 0; i < 5; i++) {
+        await once(w.webContents, 'paint');
+      }
+      expect(first.toBitmap().equals(pixels)).to.be.true('pixels changed');
+    });
+
+    for (const format of ['bgra', 'rgba', 'i420'] as const) {
+      it(`passes the dirty regions in ${format}`, async () => {
+        const c = new BrowserWindow({
+          width: 100,
+          height: 100,
+          show: false,
+          webPreferences: {
+            backgroundThrottling: false,
+            offscreen: { paintFormat: format }
+          }
+        });
+        c.webContents.on('paint', () => {
+          expect.fail('paint should not be emitted');
+        });
+        c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        const [, regions] = await once(c.webContents, 'paint-regions') as [any, Electron.PaintRegion[]];
+        expect(regions).to.have.lengthOf(1);
+        const [{ rect, data, planes }] = regions;
+        expect(regions[0].format).to.equal(format);
+        expect(planes).to.have.lengthOf(format === 'i420' ? 3 : 1);
+        expect(planes[0].width).to.equal(rect.width);
+        expect(planes[0].height).to.equal(rect.height);
+        const last = planes[planes.length - 1];
+        expect(data.byteLength).to.equal(last.offset + last.stride * last.height);
+        c.destroy();
+      });
+    }
+
+    it('paints textures or images with useSharedTexture', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { useSharedTexture: true }
+        }
+      });
+      expect(c.webContents.isOffscreen()).to.be.true('isOffscreen');
+      const paint = once(c.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage, Electron.OffscreenSharedTexture?]>;
+      c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, image, texture] = await paint;
+      // The frames are images when the GPU can't capture them into textures.
+      if (texture) {
+        expect(image.isEmpty()).to.be.true('image is empty');
+        expect(texture.textureInfo.codedSize.width).to.be.at.least(100);
+        expect(texture.release).to.be.a('function');
+        texture.release();
+      } else {
+        expect(image.isEmpty()).to.be.false('image is empty');
+      }
+      c.destroy();
+    });
+
     describe('window.webContents.isOffscreen()', () => {
       it('is true for offscreen type', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
@@ -6183,6 +6574,45 @@ describe('BrowserWindow module', () => {
         await once(w.webContents, 'paint') as [any, Electron.Rectangle, Electron.NativeImage];
         expect(w.webContents.frameRate).to.equal(30);
       });
+
+      it('keeps painting with an adaptive frame rate', async () => {
+        const domReady = once(w.webContents, 'dom-ready');
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+        await domReady;
+
+        w.webContents.setAdaptiveFrameRate(true, 5);
+        // Let the frame rate drop while nothing changes.
+        await setTimeout(1000);
+        w.webContents.invalidate();
+
+        await once(w.webContents, 'paint') as [any, Electron.Rectangle, Electron.NativeImage];
+        expect(w.webContents.getFrameRate()).to.equal(60);
+      });
+    });
+
+    it('paints on external begin frames with useExternalBeginFrame', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: { useExternalBeginFrame: true }
+        }
+      });
+      const domReady = once(c.webContents, 'dom-ready');
+      c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      await domReady;
+
+      const paint = once(c.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      const interval = setInterval(() => c.webContents.sendExternalBeginFrame(), 16);
+      try {
+        const [, , image] = await paint;
+        expect(image.isEmpty()).to.be.false('image is empty');
+      } finally {
+        clearInterval(interval);
+        c.destroy();
+      }
     });
   });
 
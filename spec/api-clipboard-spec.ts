@@ -18,6 +18,16 @@ ifdescribe(process.platform !== 'win32' || process.arch !== 'arm64')('clipboard
     });
   });
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with a NativeImage instance', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.writeImage(i);
+      const readImage = await clipboard.readImageAsync();
+      expect(readImage.toDataURL()).to.equal(i.toDataURL());
+    });
+  });
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天';
@@ -116,6 +126,17 @@ ifdescribe(process.platform !== 'win32' || process.arch !== 'arm64')('clipboard
     });
   });
 
+  describe('clipboard.availablePlatformFormats()', () => {
+    it('lists the platform name of the formats in the clipboard', () => {
+      clipboard.writeText('platform formats');
+      const formats = clipboard.availablePlatformFormats();
+      expect(formats).to.be.an('array').that.is.not.empty();
+      for (const format of formats) {
+        expect(format).to.be.a('string');
+      }
+    });
+  });
+
   describe('clipboard.readBuffer(format)', () => {
     it('writes a Buffer for the specified format', function () {
       const buffer = Buffer.from('writeBuffer', 'utf8');
@@ -129,6 +150,16 @@ ifdescribe(process.platform !== 'win32' || process.arch !== 'arm64')('clipboard
       }).to.throw(/buffer must be a node Buffer/);
     });
 
+    it('writes a Buffer asynchronously', async () => {
+      const buffer = Buffer.alloc(4 * 1024 * 1024, 'writeBufferAsync');
+      await clipboard.writeBufferAsync('public/utf8-plain-text', buffer.subarray(16));
+      expect(buffer.subarray(16).equals(clipboard.readBuffer('public/utf8-plain-text'))).to.equal(true);
+    });
+
+    it('rejects when a non-Buffer is written asynchronously', async () => {
+      await expect(clipboard.writeBufferAsync('public/utf8-plain-text', 'hello' as any)).to.eventually.be.rejectedWith(/buffer must be a node Buffer/);
+    });
+
     ifit(process.platform !== 'win32')('writes a Buffer using a raw format that is used by native apps', function () {
       const message = 'Hello from Electron!';
       const buffer = Buffer.from(message);
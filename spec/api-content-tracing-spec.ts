@@ -118,7 +118,101 @@ ifdescribe(!(['arm', 'arm64', 'ia32'].includes(process.arch)))('contentTracing',
     });
   });
 
+  describe('flight recorder', function () {
+    this.timeout(10e3);
+
+    const dumpPath = path.join(app.getPath('temp'), 'flight-recorder.pftrace');
+    afterEach(() => {
+      contentTracing.stopFlightRecorder();
+      if (fs.existsSync(dumpPath)) {
+        fs.unlinkSync(dumpPath);
+      }
+    });
+
+    it('dumps the ring buffer as a protobuf trace', async () => {
+      await app.whenReady();
+      await contentTracing.startFlightRecorder({ bufferSize: 1024 });
+      await setTimeout(100);
+      const resultPath = await contentTracing.dumpFlightRecorder(dumpPath);
+      expect(resultPath).to.equal(dumpPath);
+      const data = fs.readFileSync(dumpPath);
+      expect(data.length).to.be.above(0);
+      // A protobuf trace, not JSON.
+      expect(data[0]).to.not.equal('{'.charCodeAt(0));
+    });
+
+    it('keeps recording after a dump', async () => {
+      await app.whenReady();
+      await contentTracing.startFlightRecorder();
+      await contentTracing.dumpFlightRecorder(dumpPath);
+      const second = await contentTracing.dumpFlightRecorder();
+      expect(fs.statSync(second).size).to.be.above(0);
+      fs.unlinkSync(second);
+    });
+
+    it('runs alongside a regular recording', async () => {
+      await app.whenReady();
+      await contentTracing.startFlightRecorder();
+      const resultFilePath = await record({}, outputFilePath);
+      expect(fs.existsSync(resultFilePath)).to.be.true('output exists');
+      await contentTracing.dumpFlightRecorder(dumpPath);
+      expect(fs.existsSync(dumpPath)).to.be.true('dump exists');
+    });
+
+    it('rejects dumps when it is not recording', async () => {
+      await expect(contentTracing.dumpFlightRecorder()).to.be.rejectedWith('Flight recorder is not recording');
+    });
+
+    it('requires a directory for the triggers', () => {
+      expect(() => contentTracing.startFlightRecorder({ triggers: ['hang'] })).to.throw(/A directory is required/);
+    });
+
+    it('rejects unknown triggers', () => {
+      expect(() => contentTracing.startFlightRecorder({ triggers: ['foo' as any], directory: app.getPath('temp') })).to.throw(/Invalid flight recorder options/);
+    });
+
+    it('dumps the buffer on a long task', async () => {
+      await app.whenReady();
+      const directory = fs.mkdtempSync(path.join(app.getPath('temp'), 'flight-recorder-'));
+      await contentTracing.startFlightRecorder({
+        triggers: ['long-task'],
+        longTaskThreshold: 50,
+        directory
+      });
+      await setTimeout(10);
+      const start = Date.now();
+      while (Date.now() - start < 100);
+      await new Promise<void>(resolve => {
+        const check = () => {
+          if (contentTracing.getFlightRecorderDumps().length) resolve();
+          else setTimeout(50).then(check);
+        };
+        check();
+      });
+      const [dump] = contentTracing.getFlightRecorderDumps();
+      expect(dump.trigger).to.equal('long-task');
+      expect(dump.time).to.be.an.instanceOf(Date);
+      expect(path.dirname(dump.path)).to.equal(directory);
+      expect(fs.statSync(dump.path).size).to.be.above(0);
+      fs.rmSync(directory, { recursive: true, force: true });
+    });
+  });
+
   describe('captured events', () => {
+    it('include the events of the electron category', async () => {
+      await app.whenReady();
+      await contentTracing.startRecording({
+        categoryFilter: 'electron',
+        traceOptions: 'record-until-full'
+      });
+      // Timers run from the Node.js event loop.
+      for (let i = 0; i < 10; i++) await setTimeout(10);
+      const path = await contentTracing.stopRecording();
+      const parsed = JSON.parse(fs.readFileSync(path, 'utf8'));
+      const names = new Set(parsed.traceEvents.filter((x: any) => x.cat === 'electron').map((x: any) => x.name));
+      expect(names.has('NodeBindings::UvRunOnce')).to.be.true();
+    });
+
     it('include V8 samples from the main process', async function () {
       // This test is flaky on macOS CI.
       this.retries(3);
@@ -402,6 +402,66 @@ describe('contextBridge', () => {
         expect(result).equal(true);
       });
 
+      it('should reuse the proxy of a function sent over the bridge more than once', async () => {
+        await makeBindingWindow(() => {
+          const fn = () => 'value';
+          let last: any;
+          contextBridge.exposeInMainWorld('example', {
+            getFn: () => fn,
+            isLast: (other: any) => {
+              const same = other === last;
+              last = other;
+              return same;
+            }
+          });
+        });
+        const result = await callWithBindings(async (root: any) => {
+          const fn = () => null;
+          root.example.isLast(fn);
+          return [
+            root.example.getFn() === root.example.getFn(),
+            root.example.isLast(fn),
+            root.example.isLast(() => null)
+          ];
+        });
+        expect(result).to.deep.equal([true, true, false]);
+      });
+
+      it('should expose lazy APIs that are passed on first read', async () => {
+        await makeBindingWindow(() => {
+          const api = {
+            version: 1,
+            data: { count: 1, list: [1, 2] },
+            nested: { greet: (name: string) => `hello ${name}` }
+          };
+          contextBridge.exposeInMainWorld('example', api, { lazy: true });
+          api.data.count = 2;
+        });
+        const result = await callWithBindings((root: any) => {
+          const descriptor = Object.getOwnPropertyDescriptor(root.example, 'data')!;
+          return [
+            typeof descriptor.get,
+            Object.getOwnPropertyDescriptor(root.example, 'version')!.value,
+            Object.keys(root.example),
+            root.example.data.count,
+            root.example.data === root.example.data,
+            Object.isFrozen(root.example),
+            Object.isFrozen(root.example.data.list),
+            root.example.nested.greet('world')
+          ];
+        });
+        expect(result).to.deep.equal([
+          'function',
+          1,
+          ['version', 'data', 'nested'],
+          2,
+          true,
+          true,
+          true,
+          'hello world'
+        ]);
+      });
+
       it('should properly handle errors thrown in proxied functions', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', () => { throw new Error('oh no'); });
@@ -555,6 +615,71 @@ describe('contextBridge', () => {
         expect(result).equal(true);
       });
 
+      it('should copy typed arrays and ArrayBuffers with their contents', async () => {
+        await makeBindingWindow(() => {
+          const buffer = new ArrayBuffer(16);
+          new Uint8Array(buffer).set([...Array(16).keys()]);
+          contextBridge.exposeInMainWorld('example', {
+            getBuffer: () => buffer,
+            getViews: () => [new Uint16Array(buffer, 2, 3), new Float64Array(buffer, 8, 1)],
+            getBigInts: () => new BigInt64Array([1n, -2n])
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const buffer = root.example.getBuffer();
+          const [u16, f64] = root.example.getViews();
+          const bigInts = root.example.getBigInts();
+          return [
+            Object.getPrototypeOf(buffer) === ArrayBuffer.prototype,
+            [...new Uint8Array(buffer)],
+            Object.getPrototypeOf(u16) === Uint16Array.prototype,
+            [u16.byteOffset, u16.length, u16.buffer.byteLength],
+            [...new Uint8Array(u16.buffer, u16.byteOffset, u16.byteLength)],
+            u16.buffer === f64.buffer,
+            Object.getPrototypeOf(bigInts) === BigInt64Array.prototype,
+            [...bigInts].map(String)
+          ];
+        });
+        expect(result).to.deep.equal([
+          true,
+          [...Array(16).keys()],
+          true,
+          [2, 3, 16],
+          [2, 3, 4, 5, 6, 7],
+          true,
+          true,
+          ['1', '-2']
+        ]);
+      });
+
+      it('should copy arrays and objects of primitives', async () => {
+        await makeBindingWindow(() => {
+          contextBridge.exposeInMainWorld('example', {
+            getArray: () => [1, 'two', true, null, undefined, 3n, 0.5],
+            getSparseArray: () => [1, , 3], // eslint-disable-line no-sparse-arrays
+            getObject: () => ({ a: 1, b: 'two', c: false, d: null })
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const arr = root.example.getArray();
+          const obj = root.example.getObject();
+          return [
+            Array.isArray(arr),
+            arr.map(String),
+            root.example.getSparseArray().length,
+            Object.getPrototypeOf(obj) === Object.prototype,
+            obj
+          ];
+        });
+        expect(result).to.deep.equal([
+          true,
+          ['1', 'two', 'true', 'null', 'undefined', '3', '0.5'],
+          3,
+          true,
+          { a: 1, b: 'two', c: false, d: null }
+        ]);
+      });
+
       it('should proxy regexps', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', /a/g);
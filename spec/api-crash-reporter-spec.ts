@@ -331,6 +331,25 @@ ifdescribe(!isLinuxOnArm && !process.mas && !process.env.DISABLE_CRASH_REPORTER_
       expect(crash).not.to.have.property('c'.repeat(kKeyLengthMax + 10));
       expect(crash).not.to.have.property('c'.repeat(kKeyLengthMax));
     });
+
+    it('should truncate extra values past the extraParametersBudget', async () => {
+      const { port, waitForCrash } = await startServer();
+      const { remotely } = await startRemoteControlApp();
+      remotely((port: number) => {
+        require('electron').crashReporter.start({
+          submitURL: `http://127.0.0.1:${port}`,
+          compress: false,
+          ignoreSystemCrashHandler: true,
+          extraParametersBudget: 100,
+          extra: { first: 'a'.repeat(80) }
+        });
+        require('electron').crashReporter.addExtraParameter('second', 'b'.repeat(80));
+        setTimeout().then(() => process.crash());
+      }, port);
+      const crash = await waitForCrash();
+      expect(crash.first).to.equal('a'.repeat(80));
+      expect(crash.second).to.equal('b'.repeat(20));
+    });
   });
 
   describe('globalExtra', () => {
@@ -595,6 +614,18 @@ ifdescribe(!isLinuxOnArm && !process.mas && !process.env.DISABLE_CRASH_REPORTER_
       }).not.to.throw();
     });
 
+    it('rejects invalid minidump options', () => {
+      expect(() => {
+        crashReporter.start({ uploadToServer: false, referencedMemoryLimit: -1 });
+      }).to.throw('referencedMemoryLimit must be a non-negative Number');
+      expect(() => {
+        crashReporter.start({ uploadToServer: false, extraParametersBudget: 'big' as any });
+      }).to.throw('extraParametersBudget must be a non-negative Number');
+      expect(() => {
+        crashReporter.start({ uploadToServer: false, uploadSchedule: 1 as any });
+      }).to.throw('uploadSchedule must be an Object');
+    });
+
     it('can be called twice', async () => {
       const { remotely } = await startRemoteControlApp();
       await expect(remotely(() => {
@@ -629,6 +660,14 @@ ifdescribe(!isLinuxOnArm && !process.mas && !process.env.DISABLE_CRASH_REPORTER_
       await remotely(() => { require('electron').crashReporter.setUploadToServer(true); });
       expect(await remotely(() => require('electron').crashReporter.getUploadToServer())).to.be.true();
     });
+
+    it('is updated by setUploadToServer when uploads are scheduled', async () => {
+      const { remotely } = await startRemoteControlApp();
+      await remotely(() => { require('electron').crashReporter.start({ submitURL: 'http://127.0.0.1', uploadSchedule: {} }); });
+      expect(await remotely(() => require('electron').crashReporter.getUploadToServer())).to.be.true();
+      await remotely(() => { require('electron').crashReporter.setUploadToServer(false); });
+      expect(await remotely(() => require('electron').crashReporter.getUploadToServer())).to.be.false();
+    });
   });
 
   describe('when not started', () => {
@@ -215,4 +215,71 @@ describe('debugger module', () => {
       w.webContents.debugger.sendCommand('Target.setDiscoverTargets', { discover: true });
     });
   });
+
+  describe('debugger.setEventFilter', () => {
+    it('only emits the events of the filter', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setEventFilter({ methods: ['Runtime.*'] });
+      const methods: string[] = [];
+      w.webContents.debugger.on('message', (event, method) => methods.push(method));
+      await w.webContents.debugger.sendCommand('Page.enable');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      const created = emittedUntil(w.webContents.debugger, 'message',
+        (event: Electron.Event, method: string) => method === 'Runtime.executionContextCreated');
+      w.webContents.reload();
+      await created;
+      w.webContents.debugger.detach();
+      expect(methods).to.not.be.empty();
+      expect(methods.every(method => method.startsWith('Runtime.'))).to.be.true();
+    });
+
+    it('drops every event with a sample rate of 0', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setEventFilter({ sampleRate: 0 });
+      let messages = 0;
+      w.webContents.debugger.on('message', () => messages++);
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      const res = await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: '4+2' });
+      expect(res.result.value).to.equal(6);
+      w.webContents.debugger.detach();
+      expect(messages).to.equal(0);
+    });
+
+    it('throws for an invalid filter', () => {
+      expect(() => w.webContents.debugger.setEventFilter({ sampleRate: 2 })).to.throw(/sampleRate must be a number between 0 and 1/);
+    });
+  });
+
+  describe('debugger.setMessageFormat', () => {
+    it('emits JSON strings with the json format', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setMessageFormat('json');
+      const message = emittedUntil(w.webContents.debugger, 'raw-message',
+        (event: Electron.Event, method: string) => method === 'Runtime.executionContextCreated');
+      w.webContents.debugger.sendCommand('Runtime.enable');
+      const [,, data] = await message;
+      w.webContents.debugger.detach();
+      expect(JSON.parse(data as string).params.context).to.be.an('object');
+    });
+
+    it('emits CBOR buffers with the cbor format', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setMessageFormat('cbor');
+      const message = emittedUntil(w.webContents.debugger, 'raw-message',
+        (event: Electron.Event, method: string) => method === 'Runtime.executionContextCreated');
+      w.webContents.debugger.sendCommand('Runtime.enable');
+      const [,, data] = await message;
+      w.webContents.debugger.detach();
+      expect(data).to.be.an.instanceOf(Buffer);
+      expect((data as Buffer).length).to.be.greaterThan(0);
+    });
+
+    it('throws for an invalid format', () => {
+      expect(() => w.webContents.debugger.setMessageFormat('xml' as any)).to.throw(/format must be one of object, json or cbor/);
+    });
+  });
 });
@@ -242,4 +242,35 @@ ifdescribe(!process.arch.includes('arm') && process.platform !== 'win32')('deskt
       destroyWindows();
     }
   });
+
+  describe('watchSources', () => {
+    it('throws an error for invalid options', () => {
+      expect(() => desktopCapturer.watchSources(['screen'] as any)).to.throw('Invalid options');
+    });
+
+    it('reports the sources before their thumbnails', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], thumbnailSize: { width: 64, height: 64 } });
+      try {
+        const [, source] = await once(watcher, 'source-added');
+        expect(source.id).to.be.a('string').that.is.not.empty();
+        const [, id, thumbnail] = await once(watcher, 'thumbnail-changed');
+        expect(watcher.getSources().map(source => source.id)).to.include(id);
+        expect(thumbnail.isEmpty()).to.be.false('thumbnail is empty');
+      } finally {
+        watcher.stop();
+      }
+    });
+
+    it('reports the cached thumbnails', async () => {
+      const thumbnailSize = { width: 32, height: 32 };
+      await desktopCapturer.getSources({ types: ['screen'], thumbnailSize });
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], thumbnailSize });
+      try {
+        const [, source] = await once(watcher, 'source-added');
+        expect(source.thumbnail.isEmpty()).to.be.false('thumbnail is empty');
+      } finally {
+        watcher.stop();
+      }
+    });
+  });
 });
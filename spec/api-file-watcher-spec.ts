@@ -0,0 +1,84 @@
+import { expect } from 'chai';
+import { app, FileWatcher } from 'electron/main';
+import { once } from 'node:events';
+import * as fs from 'fs-extra';
+import * as path from 'node:path';
+import { setTimeout } from 'node:timers/promises';
+
+describe('FileWatcher module', () => {
+  let dir: string;
+  let watcher: FileWatcher | undefined;
+
+  beforeEach(async () => {
+    dir = await fs.mkdtemp(path.resolve(app.getPath('temp'), 'electron-file-watcher-spec-'));
+  });
+
+  afterEach(async () => {
+    watcher?.close();
+    watcher = undefined;
+    await fs.remove(dir);
+  });
+
+  const nextChange = async (w: FileWatcher) => {
+    const [, paths] = await once(w, 'change');
+    return paths as string[];
+  };
+
+  it('throws without a path', () => {
+    expect(() => new (FileWatcher as any)()).to.throw(/path must be a non-empty string/);
+  });
+
+  it('emits the changes in a directory', async () => {
+    watcher = new FileWatcher(dir);
+    expect(watcher.path).to.equal(dir);
+    expect(watcher.watching).to.be.true();
+    // The watch is set up on another thread.
+    await setTimeout(200);
+    const changed = nextChange(watcher);
+    await fs.writeFile(path.join(dir, 'a.txt'), 'a');
+    expect(await changed).to.not.be.empty();
+  });
+
+  it('coalesces the changes of a window into one event', async () => {
+    watcher = new FileWatcher(dir, { coalesceWindow: 500 });
+    await setTimeout(200);
+    let events = 0;
+    watcher.on('change', () => { events++; });
+    for (let i = 0; i < 10; i++) {
+      await fs.writeFile(path.join(dir, `${i}.txt`), 'x');
+    }
+    await setTimeout(1000);
+    expect(events).to.equal(1);
+  });
+
+  it('watches subdirectories when recursive', async () => {
+    await fs.mkdir(path.join(dir, 'sub'));
+    watcher = new FileWatcher(dir, { recursive: true });
+    await setTimeout(200);
+    const changed = nextChange(watcher);
+    await fs.writeFile(path.join(dir, 'sub', 'b.txt'), 'b');
+    expect(await changed).to.not.be.empty();
+  });
+
+  it('drops the changes of the ignored paths', async () => {
+    await fs.mkdir(path.join(dir, 'ignored'));
+    watcher = new FileWatcher(dir, { recursive: true, ignore: ['ignored', '*.log'] });
+    await setTimeout(200);
+    const changed = nextChange(watcher);
+    await fs.writeFile(path.join(dir, 'ignored', 'c.txt'), 'c');
+    await fs.writeFile(path.join(dir, 'd.log'), 'd');
+    await fs.writeFile(path.join(dir, 'e.txt'), 'e');
+    const paths = await changed;
+    expect(paths.some(p => p.includes('ignored') || p.endsWith('.log'))).to.be.false();
+  });
+
+  it('stops emitting once closed', async () => {
+    watcher = new FileWatcher(dir);
+    await setTimeout(200);
+    watcher.close();
+    expect(watcher.watching).to.be.false();
+    watcher.on('change', () => { throw new Error('change emitted after close'); });
+    await fs.writeFile(path.join(dir, 'f.txt'), 'f');
+    await setTimeout(500);
+  });
+});
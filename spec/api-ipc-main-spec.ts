@@ -89,4 +89,55 @@ describe('ipc main module', () => {
       expect(v).to.equal('hello');
     });
   });
+
+  describe('ipcMain.setChannelPriority', () => {
+    afterEach(() => {
+      ipcMain.setChannelPriority('bulk', 'default');
+      ipcMain.setChannelPriority('urgent', 'default');
+      ipcMain.removeAllListeners('bulk');
+      ipcMain.removeAllListeners('urgent');
+    });
+
+    it('throws for an unknown priority', () => {
+      expect(() => {
+        ipcMain.setChannelPriority('bulk', 'lowest' as any);
+      }).to.throw(/priority must be one of/);
+    });
+
+    it('handles user-blocking messages before queued background messages', async () => {
+      ipcMain.setChannelPriority('bulk', 'background');
+      ipcMain.setChannelPriority('urgent', 'user-blocking');
+      const received: string[] = [];
+      const done = new Promise<void>(resolve => {
+        const record = (name: string) => {
+          received.push(name);
+          if (received.length === 51) resolve();
+        };
+        ipcMain.on('bulk', (e, i) => record(`bulk-${i}`));
+        ipcMain.on('urgent', () => record('urgent'));
+      });
+
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      await w.loadURL('about:blank');
+      // Batched so that all of the messages arrive in the same task.
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setBatching(true)
+        for (let i = 0; i < 50; i++) ipcRenderer.send('bulk', i)
+        ipcRenderer.send('urgent')
+        ipcRenderer.setBatching(false)
+      }`);
+      await done;
+      expect(received).to.deep.equal([
+        'urgent',
+        ...[...Array(50).keys()].map(i => `bulk-${i}`)
+      ]);
+    });
+  });
 });
@@ -31,6 +31,15 @@ describe('ipcRenderer module', () => {
       expect(received).to.deep.equal(obj);
     });
 
+    it('can send strings, numbers, booleans, null and undefined', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.send('message', 'ascii', 'caf\\u00e9', '\\u{1F600}x', '', 0, -0, -1, 2 ** 31, 0.5, NaN, -Infinity, true, false, null, undefined)
+      }`);
+      const [, ...received] = await once(ipcMain, 'message');
+      expect(received).to.deep.equal(['ascii', 'café', '\u{1F600}x', '', 0, -0, -1, 2 ** 31, 0.5, NaN, -Infinity, true, false, null, undefined]);
+    });
+
     it('can send instances of Date as Dates', async () => {
       const isoDate = new Date().toISOString();
       w.webContents.executeJavaScript(`{
@@ -115,6 +124,96 @@ describe('ipcRenderer module', () => {
     });
   });
 
+  describe('sendJSON()', () => {
+    it('parses the payload when its value is read', async () => {
+      const obj = { text: 'café \u{1F600}', list: [1, 2, 3], nested: { ok: true } };
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.sendJSON('message', JSON.stringify(${JSON.stringify(obj)}))
+      }`);
+      const [, payload] = await once(ipcMain, 'message');
+      expect(payload.json).to.equal(JSON.stringify(obj));
+      expect(payload.byteLength).to.equal(Buffer.byteLength(JSON.stringify(obj)));
+      expect(payload.value).to.deep.equal(obj);
+      expect(payload.value).to.equal(payload.value);
+    });
+
+    it('throws a SyntaxError when reading the value of invalid JSON', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.sendJSON('message', '{ invalid')
+      }`);
+      const [, payload] = await once(ipcMain, 'message');
+      expect(payload.json).to.equal('{ invalid');
+      expect(() => payload.value).to.throw(SyntaxError);
+    });
+
+    it('keeps its order with batched messages', async () => {
+      const received: string[] = [];
+      const done = new Promise<void>(resolve => {
+        ipcMain.on('ordered', function listener (event, arg) {
+          received.push(typeof arg === 'string' ? arg : arg.value);
+          if (received.length === 3) {
+            ipcMain.removeListener('ordered', listener);
+            resolve();
+          }
+        });
+      });
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setBatching(true, { delay: 1000 })
+        ipcRenderer.send('ordered', 'first')
+        ipcRenderer.sendJSON('ordered', '"second"')
+        ipcRenderer.send('ordered', 'third')
+        ipcRenderer.setBatching(false)
+      }`);
+      await done;
+      expect(received).to.deep.equal(['first', 'second', 'third']);
+    });
+  });
+
+  describe('setBatching()', () => {
+    afterEach(async () => {
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.setBatching(false)`);
+    });
+
+    it('delivers batched messages in order', async () => {
+      const received: number[] = [];
+      const done = new Promise<void>(resolve => {
+        ipcMain.on('batched', function listener (event, i) {
+          received.push(i);
+          if (received.length === 100) {
+            ipcMain.removeListener('batched', listener);
+            resolve();
+          }
+        });
+      });
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setBatching(true, { delay: 10 })
+        for (let i = 0; i < 100; i++) ipcRenderer.send('batched', i)
+      }`);
+      await done;
+      expect(received).to.deep.equal([...Array(100).keys()]);
+    });
+
+    it('sends queued messages before a synchronous message', async () => {
+      const received: string[] = [];
+      ipcMain.once('queued', () => { received.push('queued'); });
+      ipcMain.once('sync', (event) => {
+        received.push('sync');
+        event.returnValue = null;
+      });
+      await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.setBatching(true, { delay: 1000 })
+        ipcRenderer.send('queued')
+        ipcRenderer.sendSync('sync')
+      }`);
+      expect(received).to.deep.equal(['queued', 'sync']);
+    });
+  });
+
   describe('sendSync()', () => {
     it('can be replied to by setting event.returnValue', async () => {
       ipcMain.once('echo', (event, msg) => {
@@ -128,6 +227,54 @@ describe('ipcRenderer module', () => {
     });
   });
 
+  describe('invokeSync()', () => {
+    afterEach(() => {
+      ipcMain.removeHandler('invoke-sync');
+    });
+
+    it('returns the result of the ipcMain handler', async () => {
+      ipcMain.handle('invoke-sync', async (event, a, b) => a + b);
+      const result = await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.invokeSync('invoke-sync', 1, 2)
+      `);
+      expect(result).to.equal(3);
+    });
+
+    it('throws when the handler throws', async () => {
+      ipcMain.handle('invoke-sync', () => { throw new Error('handler failed'); });
+      const message = await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        try {
+          ipcRenderer.invokeSync('invoke-sync')
+        } catch (e) {
+          e.message
+        }
+      }`);
+      expect(message).to.match(/handler failed/);
+    });
+  });
+
+  describe('getSyncStats()', () => {
+    it('counts the time spent blocked in sendSync()', async () => {
+      ipcMain.once('sync-stats', (event) => {
+        const end = Date.now() + 20;
+        while (Date.now() < end) { /* block the main process */ }
+        event.returnValue = null;
+      });
+      const { before, after } = await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const before = ipcRenderer.getSyncStats()
+        ipcRenderer.sendSync('sync-stats')
+        const after = ipcRenderer.getSyncStats()
+        ;({ before, after })
+      }`);
+      expect(after.sendSync.count).to.equal(before.sendSync.count + 1);
+      expect(after.sendSync.totalTime - before.sendSync.totalTime).to.be.at.least(20000);
+      expect(after.sendSync.maxTime).to.be.at.least(20000);
+      expect(after.invokeSync).to.deep.equal(before.invokeSync);
+    });
+  });
+
   describe('sendTo()', () => {
     const generateSpecs = (description: string, webPreferences: WebPreferences) => {
       describe(description, () => {
@@ -165,6 +312,33 @@ describe('ipcRenderer module', () => {
           })`);
           expect(data).to.equal(payload);
         });
+
+        it('keeps messages in order over the direct channel', async () => {
+          const data = await w.webContents.executeJavaScript(`new Promise(resolve => {
+            const { ipcRenderer } = require('electron')
+            const received = []
+            ipcRenderer.on('pong', function listener (event, data) {
+              received.push(data)
+              if (received.length === 10) {
+                ipcRenderer.removeListener('pong', listener)
+                resolve(received)
+              }
+            })
+            for (let i = 0; i < 10; i++) {
+              ipcRenderer.sendTo(${contents.id}, 'ping', i)
+            }
+          })`);
+          expect(data).to.deep.equal([...Array(10).keys()]);
+          const channels = w.webContents.getDirectIPCChannels();
+          expect(channels).to.deep.include({
+            senderId: w.webContents.id,
+            senderProcessId: w.webContents.mainFrame.processId,
+            senderFrameId: w.webContents.mainFrame.routingId,
+            targetId: contents.id,
+            targetProcessId: contents.mainFrame.processId,
+            targetFrameId: contents.mainFrame.routingId
+          });
+        });
       });
     };
 
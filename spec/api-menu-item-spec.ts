@@ -41,6 +41,35 @@ describe('MenuItems', () => {
       expect(item).to.have.property('role').that.is.a('string');
       expect(item).to.have.property('icon');
     });
+
+    it('updates the menu when the label, sublabel or toolTip change', () => {
+      const menu = Menu.buildFromTemplate([{ label: 'a' }, { label: 'b' }]);
+      const item = menu.items[1];
+      item.label = 'c';
+      item.sublabel = 'd';
+      item.toolTip = 'e';
+      expect((menu as any).getLabelAt(1)).to.equal('c');
+      expect((menu as any).getSublabelAt(1)).to.equal('d');
+      expect((menu as any).getToolTipAt(1)).to.equal('e');
+      expect((menu as any).getLabelAt(0)).to.equal('a');
+    });
+
+    it('keeps the menu state in sync when enabled, visible or checked change', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'a', type: 'checkbox' },
+        { label: 'b', type: 'radio' },
+        { label: 'c', type: 'radio', checked: true }
+      ]);
+      menu.items[0].enabled = false;
+      menu.items[0].visible = false;
+      menu.items[0].checked = true;
+      expect(menu.items[0].enabled).to.be.false('item enabled');
+      expect(menu.items[0].visible).to.be.false('item visible');
+      expect(menu.items[0].checked).to.be.true('item checked');
+      menu.items[1].checked = true;
+      expect(menu.items[1].checked).to.be.true('item checked');
+      expect(menu.items[2].checked).to.be.false('item checked');
+    });
   });
 
   describe('MenuItem.click', () => {
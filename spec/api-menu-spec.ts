@@ -854,6 +854,15 @@ describe('Menu module', function () {
       menu.closePopup();
     });
 
+    it('does not show the submenus when the menu is popped up', (done) => {
+      const submenu = Menu.buildFromTemplate(Array.from({ length: 1000 }, (_, i) => ({ label: `${i}` })));
+      submenu.on('menu-will-show', () => done(new Error('The submenu was shown')));
+      const menu = Menu.buildFromTemplate([{ label: 'submenu', submenu }]);
+      menu.on('menu-will-close', () => done());
+      menu.popup({ window: w });
+      menu.closePopup();
+    });
+
     it('prevents menu from getting garbage-collected when popuping', async () => {
       const menu = Menu.buildFromTemplate([{ role: 'paste' }]);
       menu.popup({ window: w });
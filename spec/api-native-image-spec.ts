@@ -271,6 +271,52 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('createFromBufferAsync(buffer, options)', () => {
+    it('decodes the image', async () => {
+      const imageA = nativeImage.createFromPath(imageLogo.path);
+
+      const imageB = await nativeImage.createFromBufferAsync(imageA.toPNG());
+      expect(imageB.getSize()).to.deep.equal({ width: 538, height: 190 });
+      expect(imageA.toBitmap().equals(imageB.toBitmap())).to.be.true();
+
+      const imageC = await nativeImage.createFromBufferAsync(imageA.toBitmap(),
+        { width: 538, height: 190, scaleFactor: 2.0 });
+      expect(imageC.getSize()).to.deep.equal({ width: 269, height: 95 });
+    });
+
+    it('resolves with an empty image when the buffer can not be decoded', async () => {
+      const image = await nativeImage.createFromBufferAsync(Buffer.from([1, 2, 3, 4]));
+      expect(image.isEmpty()).to.be.true();
+    });
+
+    it('rejects invalid arguments', async () => {
+      await expect(nativeImage.createFromBufferAsync(null as any)).to.eventually.be.rejectedWith('buffer must be a node Buffer');
+    });
+  });
+
+  describe('toPNGAsync(), toJPEGAsync() and toWebPAsync()', () => {
+    it('encodes the image', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+
+      const png = await image.toPNGAsync();
+      expect(png.equals(image.toPNG())).to.be.true();
+
+      const jpeg = await image.toJPEGAsync(100);
+      expect(nativeImage.createFromBuffer(jpeg).getSize()).to.deep.equal({ width: 538, height: 190 });
+
+      const webp = await image.toWebPAsync(80);
+      expect(webp.subarray(0, 4).toString()).to.equal('RIFF');
+      expect(webp.subarray(8, 12).toString()).to.equal('WEBP');
+    });
+
+    it('supports a scale factor', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      const png = await image.toPNGAsync({ scaleFactor: 2.0 });
+      expect(nativeImage.createFromBuffer(png, { scaleFactor: 2.0 }).getSize()).to.deep.equal(
+        { width: imageLogo.width / 2, height: imageLogo.height / 2 });
+    });
+  });
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty()).to.be.true();
@@ -473,6 +519,83 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('resizeImages(images, options)', () => {
+    it('resizes the images like resize()', async () => {
+      const image = nativeImage.createFromPath(path.join(fixturesPath, 'assets', 'logo.png'));
+      const [resized, byPath] = await nativeImage.resizeImages([image, image1x1.path], { width: 269 });
+      expect(resized.getSize()).to.deep.equal({ width: 269, height: 95 });
+      expect(resized.toBitmap().equals(image.resize({ width: 269 }).toBitmap())).to.be.true();
+      expect(byPath.getSize()).to.deep.equal({ width: 269, height: 269 });
+    });
+
+    it('returns empty images for empty sizes', async () => {
+      const image = nativeImage.createFromPath(image1x1.path);
+      const [resized, empty] = await nativeImage.resizeImages([image, nativeImage.createEmpty()], { width: 0, height: 0 });
+      expect(resized.isEmpty()).to.be.true();
+      expect(empty.isEmpty()).to.be.true();
+      expect(await nativeImage.resizeImages([], { width: 1 })).to.deep.equal([]);
+    });
+  });
+
+  describe('copyBitmapTo(buffer, options)', () => {
+    it('copies the same pixels as toBitmap()', () => {
+      const image = nativeImage.createFromPath(image3x3.path);
+      const bitmap = image.toBitmap();
+      const buffer = Buffer.alloc(bitmap.length + 4);
+      expect(image.copyBitmapTo(buffer)).to.equal(bitmap.length);
+      expect(buffer.subarray(0, bitmap.length).equals(bitmap)).to.be.true();
+    });
+
+    it('swaps the red and blue channels', () => {
+      const image = nativeImage.createFromPath(image3x3.path);
+      const bgra = new Uint8Array(36);
+      const rgba = new ArrayBuffer(36);
+      image.copyBitmapTo(bgra, { pixelFormat: 'bgra' });
+      image.copyBitmapTo(rgba, { pixelFormat: 'rgba' });
+      const rgbaBytes = new Uint8Array(rgba);
+      for (let i = 0; i < 36; i += 4) {
+        expect(rgbaBytes[i]).to.equal(bgra[i + 2]);
+        expect(rgbaBytes[i + 1]).to.equal(bgra[i + 1]);
+        expect(rgbaBytes[i + 2]).to.equal(bgra[i]);
+        expect(rgbaBytes[i + 3]).to.equal(bgra[i + 3]);
+      }
+    });
+
+    it('throws for invalid arguments', () => {
+      const image = nativeImage.createFromPath(image3x3.path);
+      expect(() => image.copyBitmapTo(new Uint8Array(4))).to.throw(/buffer is too small/);
+      expect(() => image.copyBitmapTo(null as any)).to.throw(/must be an ArrayBuffer/);
+      expect(() => image.copyBitmapTo(new Uint8Array(36), { pixelFormat: 'argb' as any })).to.throw(/Invalid pixelFormat/);
+    });
+  });
+
+  describe('decoded image sharing', () => {
+    it('shares the decoded pixels of images created from the same file', () => {
+      const imagePath = path.join(fixturesPath, 'assets', 'logo.png');
+      const image = nativeImage.createFromPath(imagePath);
+      const other = nativeImage.createFromPath(imagePath);
+      expect(other.toBitmap().equals(image.toBitmap())).to.be.true();
+    });
+
+    it('does not modify the other images when adding a representation', () => {
+      const image = nativeImage.createFromPath(image1x1.path);
+      const other = nativeImage.createFromPath(image1x1.path);
+      image.addRepresentation({
+        scaleFactor: 2.0,
+        buffer: nativeImage.createFromPath(image2x2.path).toPNG()
+      });
+      expect(image.getScaleFactors()).to.deep.equal([1, 2]);
+      expect(other.getScaleFactors()).to.deep.equal([1]);
+    });
+
+    it('shares the decoded pixels of images created from the same data URL', () => {
+      const dataURL = nativeImage.createFromPath(image1x1.path).toDataURL();
+      const image = nativeImage.createFromDataURL(dataURL);
+      const other = nativeImage.createFromDataURL(dataURL);
+      expect(other.toBitmap().equals(image.toBitmap())).to.be.true();
+    });
+  });
+
   describe('addRepresentation()', () => {
     it('does not add representation when the buffer is too small', () => {
       const image = nativeImage.createEmpty();
@@ -4,9 +4,10 @@ import * as fs from 'node:fs';
 import * as os from 'node:os';
 import * as path from 'node:path';
 import * as ChildProcess from 'node:child_process';
-import { session, net } from 'electron/main';
+import { session, net, webContents } from 'electron/main';
+import * as WebSocket from 'ws';
 import { Socket } from 'node:net';
-import { ifit, listen } from './lib/spec-helpers';
+import { defer, ifit, listen, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
 
 const appPath = path.join(__dirname, 'fixtures', 'api', 'net-log');
@@ -118,6 +119,107 @@ describe('netLog module', () => {
     expect(JSON.parse(dump).events.some((x: any) => x.params && x.params.bytes && Buffer.from(x.params.bytes, 'base64').includes(unique))).to.be.true('uuid present in dump');
   });
 
+  describe('capture', () => {
+    const request = () => new Promise<void>((resolve) => {
+      const req = net.request(serverUrl);
+      req.on('response', (response) => {
+        response.on('data', () => {});
+        response.on('end', () => resolve());
+      });
+      req.end();
+    });
+
+    afterEach(() => {
+      if (testNetLog().currentlyCapturing) {
+        testNetLog().stopCapture();
+      }
+    });
+
+    it('keeps the events in memory until .stopCapture() is called', async () => {
+      await testNetLog().startCapture();
+      expect(testNetLog().currentlyCapturing).to.be.true('currently capturing');
+      expect(testNetLog().currentlyLogging).to.be.false('currently logging');
+
+      await request();
+      const log = await testNetLog().snapshotCapture();
+      expect(log.constants).to.be.an('object');
+      expect(log.events).to.be.an('array').that.is.not.empty();
+
+      testNetLog().stopCapture();
+      expect(testNetLog().currentlyCapturing).to.be.false('currently capturing');
+    });
+
+    it('writes a snapshot to a file', async () => {
+      await testNetLog().startCapture({ captureMode: 'includeSensitive' });
+      await request();
+      await testNetLog().snapshotCapture(dumpFileDynamic);
+      const log = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'));
+      expect(log.events).to.be.an('array').that.is.not.empty();
+      expect(testNetLog().currentlyCapturing).to.be.true('currently capturing');
+    });
+
+    it('only keeps the events of the sources requested', async () => {
+      await testNetLog().startCapture({ sources: ['URL_REQUEST'] });
+      await request();
+      const log = await testNetLog().snapshotCapture();
+      const urlRequest = log.constants.logSourceType.URL_REQUEST;
+      expect(log.events).to.be.an('array').that.is.not.empty();
+      for (const event of log.events) {
+        expect(event.source.type).to.equal(urlRequest);
+      }
+    });
+
+    it('throws when the capture is misused', async () => {
+      expect(() => testNetLog().stopCapture()).to.throw('No net log capture in progress');
+      await expect(testNetLog().snapshotCapture()).to.be.rejectedWith('No net log capture in progress');
+      expect(() => testNetLog().startCapture({ maxSize: 'aoeu' as any })).to.throw();
+      await testNetLog().startCapture();
+      expect(() => testNetLog().startCapture()).to.throw('There is already a net log capture running');
+    });
+  });
+
+  describe('WebSocket meter', () => {
+    it('counts the frames of the WebSockets', async () => {
+      const wsServer = http.createServer();
+      const wss = new WebSocket.Server({ server: wsServer });
+      wss.on('connection', (ws) => {
+        ws.on('message', (message) => ws.send(message));
+      });
+      const { port } = await listen(wsServer);
+      const contents = (webContents as typeof ElectronInternal.WebContents).create({ session: session.fromPartition('net-log') });
+      await testNetLog().startWebSocketMeter({ sampleInterval: 100 });
+      defer(() => {
+        testNetLog().stopWebSocketMeter();
+        contents.destroy();
+        wss.close();
+        wsServer.close();
+      });
+
+      await contents.loadURL('about:blank');
+      await contents.executeJavaScript(`new Promise((resolve, reject) => {
+        const ws = new WebSocket('ws://127.0.0.1:${port}/meter');
+        let received = 0;
+        ws.onopen = () => { for (let i = 0; i < 3; i++) ws.send('hello'); };
+        ws.onmessage = () => { if (++received === 3) resolve(); };
+        ws.onerror = () => reject(new Error('failed to connect'));
+      })`);
+
+      await waitUntil(() => testNetLog().getWebSocketMetrics().some(socket => socket.url.endsWith('/meter') && socket.framesReceived >= 3));
+      const socket = testNetLog().getWebSocketMetrics().find(socket => socket.url.endsWith('/meter'))!;
+      expect(socket.framesSent).to.be.at.least(3);
+      expect(socket.bytesSent).to.be.at.least(15);
+      expect(socket.bytesReceived).to.be.at.least(15);
+    });
+
+    it('throws when the meter is misused', async () => {
+      expect(() => testNetLog().startWebSocketMeter({ sampleInterval: -1 })).to.throw('Invalid value for sampleInterval');
+      await testNetLog().startWebSocketMeter();
+      expect(() => testNetLog().startWebSocketMeter()).to.throw('There is already a WebSocket meter running');
+      testNetLog().stopWebSocketMeter();
+      expect(() => testNetLog().stopWebSocketMeter()).to.throw('No WebSocket meter in progress');
+    });
+  });
+
   ifit(process.platform !== 'linux')('should begin and end logging automatically when --log-net-log is passed', async () => {
     const appProcess = ChildProcess.spawn(process.execPath,
       [appPath], {
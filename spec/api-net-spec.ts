@@ -1,7 +1,9 @@
 import { expect } from 'chai';
 import * as dns from 'node:dns';
 import { net, session, ClientRequest, BrowserWindow, ClientRequestConstructorOptions, protocol } from 'electron/main';
+import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as os from 'node:os';
 import * as url from 'node:url';
 import * as path from 'node:path';
 import { Socket } from 'node:net';
@@ -1741,6 +1743,63 @@ describe('net module', () => {
     });
   });
 
+  describe('bulk transfers', () => {
+    it('writes the response body to responseFile', async () => {
+      const body = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(body);
+      });
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-spec-'));
+      defer(() => fs.rmSync(dir, { recursive: true, force: true }));
+      const responseFile = path.join(dir, 'body');
+      const urlRequest = net.request({ url: serverUrl, responseFile });
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      expect(await collectStreamBodyBuffer(response)).to.have.lengthOf(0);
+      expect(fs.readFileSync(responseFile).equals(body)).to.be.true('body matches');
+    });
+
+    it('coalesces the response body into chunks of readSize', async () => {
+      const body = randomBuffer(kOneMegaByte + 1);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        // Many small writes, which arrive as many small reads.
+        for (let i = 0; i < body.length; i += kOneKiloByte) {
+          response.write(body.subarray(i, i + kOneKiloByte));
+        }
+        response.end();
+      });
+      const readSize = 256 * kOneKiloByte;
+      const urlRequest = net.request({ url: serverUrl, readSize });
+      const response = await getResponse(urlRequest);
+      const chunks: Buffer[] = [];
+      response.on('data', (chunk) => chunks.push(chunk));
+      await once(response, 'end');
+      expect(chunks.map(chunk => chunk.length)).to.deep.equal([readSize, readSize, readSize, readSize, 1]);
+      expect(Buffer.concat(chunks).equals(body)).to.be.true('body matches');
+    });
+
+    it('rejects an invalid readSize', () => {
+      expect(() => {
+        net.request({ url: 'http://127.0.0.1', readSize: 0 });
+      }).to.throw(/readSize must be between/);
+    });
+
+    it('uploads the request body from uploadFile', async () => {
+      const body = randomBuffer(kOneMegaByte);
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-spec-'));
+      defer(() => fs.rmSync(dir, { recursive: true, force: true }));
+      const uploadFile = path.join(dir, 'body');
+      fs.writeFileSync(uploadFile, body);
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        const received = await collectStreamBodyBuffer(request);
+        response.end(received.equals(body) ? 'match' : 'mismatch');
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl, uploadFile });
+      const response = await getResponse(urlRequest);
+      expect(await collectStreamBody(response)).to.equal('match');
+    });
+  });
+
   describe('IncomingMessage API', () => {
     it('response object should implement the IncomingMessage API', async () => {
       const customHeaderName = 'Some-Custom-Header-Name';
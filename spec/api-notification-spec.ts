@@ -145,5 +145,27 @@ describe('Notification module', () => {
     }
   });
 
+  it('inits, gets and sets the group', () => {
+    const n = new Notification({
+      groupId: 'messages'
+    });
+    expect(n.groupId).to.equal('messages');
+
+    n.groupId = 'other messages';
+    expect(n.groupId).to.equal('other messages');
+  });
+
+  ifit(process.platform === 'darwin')('closes the notifications it replaces in its group', async () => {
+    const first = new Notification({ title: 'first', groupId: 'messages', silent: true });
+    const second = new Notification({ title: 'second', groupId: 'messages', silent: true });
+    const shown = once(first, 'show');
+    first.show();
+    await shown;
+    const closed = once(first, 'close');
+    second.show();
+    await closed;
+    second.close();
+  });
+
   // TODO(sethlu): Find way to test init with notification icon?
 });
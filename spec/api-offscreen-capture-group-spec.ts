@@ -0,0 +1,82 @@
+import { expect } from 'chai';
+import { BrowserWindow, OffscreenCaptureGroup } from 'electron/main';
+import { once } from 'node:events';
+import * as path from 'node:path';
+import { closeAllWindows } from './lib/window-helpers';
+
+const fixtures = path.resolve(__dirname, 'fixtures');
+
+describe('OffscreenCaptureGroup module', () => {
+  afterEach(closeAllWindows);
+
+  const createOffscreenWindow = () => new BrowserWindow({
+    width: 100,
+    height: 100,
+    show: false,
+    webPreferences: { backgroundThrottling: false, offscreen: true }
+  });
+
+  it('clamps the frame rate', () => {
+    expect(new OffscreenCaptureGroup().frameRate).to.equal(60);
+    expect(new OffscreenCaptureGroup({ frameRate: 30 }).frameRate).to.equal(30);
+    expect(new OffscreenCaptureGroup({ frameRate: 1000 }).frameRate).to.equal(240);
+  });
+
+  it('rejects web contents which are not offscreen', () => {
+    const w = new BrowserWindow({ show: false });
+    const group = new OffscreenCaptureGroup();
+    expect(() => group.add(w.webContents)).to.throw(/offscreen rendering/);
+  });
+
+  it('rejects web contents of another group', () => {
+    const w = createOffscreenWindow();
+    new OffscreenCaptureGroup().add(w.webContents);
+    expect(() => new OffscreenCaptureGroup().add(w.webContents)).to.throw(/already belongs/);
+  });
+
+  it('emits the frames of its web contents together', async () => {
+    const group = new OffscreenCaptureGroup();
+    const windows = [createOffscreenWindow(), createOffscreenWindow()];
+    for (const w of windows) group.add(w.webContents);
+    expect(group.getWebContents()).to.have.lengthOf(2);
+
+    const pending = new Set(windows.map(w => w.webContents.id));
+    const painted = new Promise<void>(resolve => {
+      group.on('paint', (event, frames) => {
+        for (const frame of frames) {
+          expect(frame.image.isEmpty()).to.be.false('image is empty');
+          pending.delete(frame.webContents.id);
+        }
+        if (pending.size === 0) resolve();
+      });
+    });
+    const paintEmitted = () => { throw new Error('paint emitted by a member'); };
+    for (const w of windows) {
+      w.webContents.on('paint', paintEmitted);
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+    }
+    await painted;
+    for (const w of windows) w.webContents.off('paint', paintEmitted);
+  });
+
+  it('stops collecting the frames of removed web contents', async () => {
+    const group = new OffscreenCaptureGroup();
+    const w = createOffscreenWindow();
+    group.add(w.webContents);
+    group.remove(w.webContents);
+    expect(group.getWebContents()).to.be.empty();
+
+    w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+    await once(w.webContents, 'paint');
+  });
+
+  it('removes destroyed web contents', async () => {
+    const group = new OffscreenCaptureGroup();
+    const w = createOffscreenWindow();
+    group.add(w.webContents);
+    const destroyed = once(w.webContents, 'destroyed');
+    w.destroy();
+    await destroyed;
+    expect(group.getWebContents()).to.be.empty();
+  });
+});
@@ -11,6 +11,7 @@ import * as dbus from 'dbus-native';
 import { ifdescribe, startRemoteControlApp } from './lib/spec-helpers';
 import { promisify } from 'node:util';
 import { setTimeout } from 'node:timers/promises';
+import { once } from 'node:events';
 
 describe('powerMonitor', () => {
   let logindMock: any, dbusMockPowerMonitor: any, getCalls: any, emitSignal: any, reset: any;
@@ -170,6 +171,35 @@ describe('powerMonitor', () => {
       });
     });
 
+    describe('powerMonitor.setIdleThreshold', () => {
+      afterEach(() => {
+        powerMonitor.setIdleThreshold(0);
+        powerMonitor.removeAllListeners('idle-start');
+      });
+
+      it('emits idle-start once the system is idle for the threshold', async () => {
+        const idleTime = powerMonitor.getSystemIdleTime();
+        const idleStart = once(powerMonitor, 'idle-start');
+        powerMonitor.setIdleThreshold(Math.max(idleTime, 1));
+        // The system is only guaranteed to be idle for as long as it already is.
+        if (idleTime >= 1) await idleStart;
+      });
+
+      it('does not accept invalid thresholds', () => {
+        expect(() => {
+          powerMonitor.setIdleThreshold(-1);
+        }).to.throw(/must be a non-negative integer/);
+
+        expect(() => {
+          powerMonitor.setIdleThreshold(1.5);
+        }).to.throw(/must be a non-negative integer/);
+
+        expect(() => {
+          powerMonitor.setIdleThreshold('a' as any);
+        }).to.throw(/must be a non-negative integer/);
+      });
+    });
+
     describe('powerMonitor.getSystemIdleTime', () => {
       it('returns current system idle time', () => {
         const idleTime = powerMonitor.getSystemIdleTime();
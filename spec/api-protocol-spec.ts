@@ -6,6 +6,7 @@ import * as path from 'node:path';
 import * as url from 'node:url';
 import * as http from 'node:http';
 import * as fs from 'node:fs';
+import * as os from 'node:os';
 import * as qs from 'node:querystring';
 import * as stream from 'node:stream';
 import { EventEmitter, once } from 'node:events';
@@ -1542,4 +1543,60 @@ describe('protocol module', () => {
       expect(interceptedTime).to.be.lessThan(rawTime * 1.5);
     });
   });
+
+  describe('handleDirectory', () => {
+    let root: string;
+    before(() => {
+      root = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-handle-directory-'));
+      fs.writeFileSync(path.join(root, 'index.html'), 'index');
+      fs.writeFileSync(path.join(root, 'data.blob'), text);
+    });
+    after(() => { fs.rmSync(root, { recursive: true, force: true }); });
+
+    it('serves files from the root directory', async () => {
+      protocol.handleDirectory('test-scheme', { root });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      const resp = await net.fetch('test-scheme://app/data.blob');
+      expect(resp.status).to.equal(200);
+      expect(resp.headers.get('etag')).to.be.a('string');
+      expect(await resp.text()).to.equal(text);
+    });
+
+    it('serves index.html for directories', async () => {
+      protocol.handleDirectory('test-scheme', { root });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      const body = await net.fetch('test-scheme://app/').then(r => r.text());
+      expect(body).to.equal('index');
+    });
+
+    it('responds with 304 when the ETag matches', async () => {
+      protocol.handleDirectory('test-scheme', { root });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      const etag = (await net.fetch('test-scheme://app/data.blob')).headers.get('etag')!;
+      const resp = await net.fetch('test-scheme://app/data.blob', { headers: { 'If-None-Match': etag } });
+      expect(resp.status).to.equal(304);
+    });
+
+    it('applies mimeTypes and header rules', async () => {
+      protocol.handleDirectory('test-scheme', {
+        root,
+        mimeTypes: { blob: 'text/x-blob' },
+        headers: [{ match: '*.blob', headers: { 'X-Test': 'yes' } }]
+      });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      const resp = await net.fetch('test-scheme://app/data.blob');
+      expect(resp.headers.get('content-type')).to.equal('text/x-blob');
+      expect(resp.headers.get('x-test')).to.equal('yes');
+    });
+
+    it('does not serve files outside of the root directory', async () => {
+      protocol.handleDirectory('test-scheme', { root });
+      defer(() => { protocol.unhandle('test-scheme'); });
+      await expect(net.fetch('test-scheme://app/..%2F..%2Fetc%2Fpasswd')).to.eventually.be.rejected();
+    });
+
+    it('throws for built-in schemes', () => {
+      expect(() => protocol.handleDirectory('https', { root })).to.throw(/built-in/);
+    });
+  });
 });
@@ -87,6 +87,42 @@ ifdescribe(process.platform !== 'linux')('safeStorage module', () => {
       }).to.throw(Error);
     });
   });
+
+  describe('SafeStorage.encryptStringAsync() and decryptStringAsync()', () => {
+    it('round-trips a string', async () => {
+      const plaintext = '€ - utf symbol';
+      const encrypted = await safeStorage.encryptStringAsync(plaintext);
+      expect(Buffer.isBuffer(encrypted)).to.equal(true);
+      expect(safeStorage.decryptString(encrypted)).to.equal(plaintext);
+      expect(await safeStorage.decryptStringAsync(encrypted)).to.equal(plaintext);
+    });
+
+    it('rejects unencrypted input', async () => {
+      const plaintextBuffer = Buffer.from('I am unencoded!', 'utf-8');
+      await expect(safeStorage.decryptStringAsync(plaintextBuffer)).to.eventually.be.rejectedWith(/does not appear to be encrypted/);
+    });
+
+    it('throws on non-buffer input', () => {
+      expect(() => {
+        safeStorage.decryptStringAsync({} as any);
+      }).to.throw(/to be a buffer/);
+    });
+  });
+
+  describe('SafeStorage.encryptStringsAsync() and decryptStringsAsync()', () => {
+    it('round-trips the strings in order', async () => {
+      const plaintexts = ['a', 'b', '', 'plaintext'];
+      const encrypted = await safeStorage.encryptStringsAsync(plaintexts);
+      expect(encrypted).to.have.lengthOf(plaintexts.length);
+      expect(await safeStorage.decryptStringsAsync(encrypted)).to.deep.equal(plaintexts);
+    });
+
+    it('rejects with the index of the invalid input', async () => {
+      const encrypted = await safeStorage.encryptStringsAsync(['a']);
+      const promise = safeStorage.decryptStringsAsync([encrypted[0], Buffer.from('I am unencoded!')]);
+      await expect(promise).to.eventually.be.rejectedWith(/at index 1/);
+    });
+  });
   describe('safeStorage persists encryption key across app relaunch', () => {
     it('can decrypt after closing and reopening app', async () => {
       const fixturesPath = path.resolve(__dirname, 'fixtures');
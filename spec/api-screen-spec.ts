@@ -86,4 +86,26 @@ describe('screen module', () => {
       expect(workArea).to.have.property('height').that.is.greaterThan(0);
     });
   });
+
+  describe('screen.getAllDisplays()', () => {
+    it('returns the same frozen objects until the topology changes', () => {
+      const displays = screen.getAllDisplays();
+      expect(displays).to.be.an('array').that.is.not.empty();
+      expect(Object.isFrozen(displays)).to.be.true();
+      expect(Object.isFrozen(displays[0])).to.be.true();
+      expect(Object.isFrozen(displays[0].bounds)).to.be.true();
+      expect(screen.getAllDisplays()).to.equal(displays);
+      expect(displays).to.include(screen.getPrimaryDisplay());
+      expect(displays).to.include(screen.getDisplayNearestPoint(displays[0].bounds));
+    });
+  });
+
+  describe('screen.topologyVersion', () => {
+    it('is a number which stays the same between calls', () => {
+      const version = screen.topologyVersion;
+      expect(version).to.be.a('number');
+      screen.getAllDisplays();
+      expect(screen.topologyVersion).to.equal(version);
+    });
+  });
 });
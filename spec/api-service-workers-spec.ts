@@ -70,6 +70,53 @@ describe('session.serviceWorkers', () => {
     });
   });
 
+  describe('startWorkerForScope()', () => {
+    it('resolves with the version of the active service worker', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      const [, { versionId }] = await once(ses.serviceWorkers, 'worker-activated');
+      const startedVersionId = await ses.serviceWorkers.startWorkerForScope(`${baseUrl}/`);
+      expect(startedVersionId).to.equal(versionId);
+      expect(ses.serviceWorkers.getFromVersionID(versionId)).to.have.property('scope', `${baseUrl}/`);
+    });
+
+    it('rejects when no service worker is registered for the scope', async () => {
+      await expect(ses.serviceWorkers.startWorkerForScope(`${baseUrl}/`)).to.eventually.be.rejectedWith(/Failed to start the service worker/);
+    });
+  });
+
+  describe('keepAlive()', () => {
+    it('throws when the service worker is not running', () => {
+      expect(() => ses.serviceWorkers.keepAlive(12345, 1000)).to.throw(/Could not find a running service worker/);
+    });
+
+    it('accepts a running service worker', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      const [, { versionId }] = await once(ses.serviceWorkers, 'console-message');
+      expect(() => ses.serviceWorkers.keepAlive(versionId, 1000)).to.not.throw();
+      expect(() => ses.serviceWorkers.keepAlive(versionId, 0)).to.not.throw();
+    });
+  });
+
+  describe('worker-started event', () => {
+    it('reports the startup time of a service worker', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      const [, details] = await once(ses.serviceWorkers, 'worker-started');
+      expect(details).to.have.property('scope', `${baseUrl}/`);
+      expect(details).to.have.property('scriptUrl', `${baseUrl}/sw.js`);
+      expect(details.renderProcessId).to.be.a('number');
+      expect(details.startupTime).to.be.a('number').that.is.at.least(0);
+    });
+  });
+
+  describe('worker-activated event', () => {
+    it('is emitted when a new service worker is activated', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      const [, details] = await once(ses.serviceWorkers, 'worker-activated');
+      expect(details).to.have.property('scope', `${baseUrl}/`);
+      expect(details.activationTime).to.be.a('number').that.is.at.least(0);
+    });
+  });
+
   describe('console-message event', () => {
     it('should correctly keep the source, message and level', async () => {
       const messages: Record<string, Electron.MessageDetails> = {};
@@ -3,12 +3,14 @@ import * as http from 'node:http';
 import * as https from 'node:https';
 import * as path from 'node:path';
 import * as fs from 'node:fs';
+import * as os from 'node:os';
 import * as ChildProcess from 'node:child_process';
+import * as crypto from 'node:crypto';
 import { app, session, BrowserWindow, net, ipcMain, Session, webFrameMain, WebFrameMain } from 'electron/main';
 import * as send from 'send';
 import * as auth from 'basic-auth';
 import { closeAllWindows } from './lib/window-helpers';
-import { defer, listen } from './lib/spec-helpers';
+import { defer, listen, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
 import { setTimeout } from 'node:timers/promises';
 
@@ -28,6 +30,62 @@ describe('session module', () => {
     });
   });
 
+  describe('session.fromPartitionAsync(partition, options)', () => {
+    it('resolves the existing session with same partition', async () => {
+      expect(await session.fromPartitionAsync('test')).to.equal(session.fromPartition('test'));
+    });
+
+    it('creates the sessions asked for at the same time once', async () => {
+      const [a, b] = await Promise.all([
+        session.fromPartitionAsync('persist:from-partition-async'),
+        session.fromPartitionAsync('persist:from-partition-async')
+      ]);
+      expect(a).to.equal(b);
+      expect(a).to.equal(session.fromPartition('persist:from-partition-async'));
+      const timings = a.getCreationTimings();
+      expect(timings.async).to.be.true();
+      expect(timings.total).to.be.at.least(timings.prefsLoad);
+    });
+  });
+
+  describe('ses.getCreationTimings()', () => {
+    it('returns the timings of a session created synchronously', () => {
+      const timings = session.fromPartition('persist:creation-timings').getCreationTimings();
+      expect(timings.async).to.be.false();
+      expect(timings.total).to.be.at.least(timings.contextInit);
+    });
+  });
+
+  describe('ses.createEphemeralSession()', () => {
+    it('creates in-memory sessions with the settings of the template', async () => {
+      const template = session.fromPartition('ephemeral-template');
+      const preload = path.join(fixtures, 'module', 'set-global.js');
+      template.setPreloads([preload]);
+      template.setUserAgent('ephemeral-agent');
+      await template.setProxy({ proxyRules: 'http=myproxy:80' });
+
+      const ses = template.createEphemeralSession();
+      expect(ses).to.not.equal(template);
+      expect(ses.isPersistent()).to.be.false();
+      expect(ses.getPreloads()).to.deep.equal([preload]);
+      expect(ses.getUserAgent()).to.equal('ephemeral-agent');
+      expect(await ses.resolveProxy('http://example.com/')).to.equal('PROXY myproxy:80');
+
+      ses.setPreloads([]);
+      expect(template.getPreloads()).to.deep.equal([preload]);
+    });
+
+    it('hands out the pooled sessions', async () => {
+      const template = session.fromPartition('ephemeral-pool-template');
+      template.setEphemeralPoolSize(2);
+      // The pool is filled in the background.
+      await setTimeout(500);
+      const a = template.createEphemeralSession();
+      const b = template.createEphemeralSession();
+      expect(a).to.not.equal(b);
+    });
+  });
+
   describe('session.fromPath(path)', () => {
     it('returns storage path of a session which was created with an absolute path', () => {
       const tmppath = require('electron').app.getPath('temp');
@@ -86,6 +144,7 @@ describe('session module', () => {
       expect(c.name).to.equal(name);
       expect(c.value).to.equal(value);
       expect(c.session).to.equal(true);
+      expect(c).to.not.have.property('expirationDate');
     });
 
     it('sets cookies without name', async () => {
@@ -210,6 +269,54 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true);
     });
 
+    it('only emits a changed event for the cookies matching the filter', async () => {
+      const { cookies } = session.fromPartition('cookies-changed-filter');
+      cookies.setChangedFilter([{ name: 'wanted' }]);
+      const changed = once(cookies, 'changed');
+      await cookies.set({ url, name: 'unwanted', value });
+      await cookies.set({ url, name: 'wanted', value });
+      const [, cookie] = await changed;
+      expect(cookie.name).to.equal('wanted');
+    });
+
+    describe('ses.cookies.setMany()', () => {
+      it('sets all the cookies', async () => {
+        const { cookies } = session.defaultSession;
+        await cookies.setMany([{ url, name: 'a', value }, { url, name: 'b', value }]);
+        const list = await cookies.get({ url });
+        expect(list.map(c => c.name).sort()).to.deep.equal(['a', 'b']);
+      });
+
+      it('sets none of the cookies when one is invalid', async () => {
+        const { cookies } = session.defaultSession;
+        await expect(cookies.setMany([
+          { url, name: 'a', value },
+          { url: 'not-a-url', name: 'b', value }
+        ])).to.eventually.be.rejectedWith(/index 1/);
+        expect(await cookies.get({ url })).to.be.empty();
+      });
+    });
+
+    describe('ses.cookies.getMany()', () => {
+      it('resolves the cookies matching each filter', async () => {
+        const { cookies } = session.defaultSession;
+        await cookies.setMany([{ url, name: 'a', value }, { url, name: 'b', value }]);
+        const [a, b, all] = await cookies.getMany([{ url, name: 'a' }, { url, name: 'b' }, { url }]);
+        expect(a.map(c => c.name)).to.deep.equal(['a']);
+        expect(b.map(c => c.name)).to.deep.equal(['b']);
+        expect(all).to.have.lengthOf(2);
+      });
+    });
+
+    describe('ses.cookies.removeMany()', () => {
+      it('removes all the cookies', async () => {
+        const { cookies } = session.defaultSession;
+        await cookies.setMany([{ url, name: 'a', value }, { url, name: 'b', value }]);
+        await cookies.removeMany([{ url, name: 'a' }, { url, name: 'b' }]);
+        expect(await cookies.get({ url })).to.be.empty();
+      });
+    });
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo';
@@ -263,6 +370,143 @@ describe('session module', () => {
         // trying until it is.
       }
     });
+
+    it('clears each type of storage in the background', async () => {
+      const ses = session.fromPartition(`clear-storage-${Math.random()}`);
+      const progress: { storage: string, completed: number, total: number }[] = [];
+      ses.on('clear-storage-data-progress', (event, details) => { progress.push(details); });
+      await ses.clearStorageData({ storages: ['cookies', 'localstorage'], background: true });
+      expect(progress).to.deep.equal([
+        { storage: 'cookies', completed: 1, total: 2 },
+        { storage: 'localstorage', completed: 2, total: 2 }
+      ]);
+    });
+
+    it('clears the other data last in the background', async () => {
+      const ses = session.fromPartition(`clear-storage-${Math.random()}`);
+      const storages: string[] = [];
+      ses.on('clear-storage-data-progress', (event, details) => { storages.push(details.storage); });
+      await ses.clearStorageData({ background: true });
+      expect(storages).to.include('indexdb');
+      expect(storages[storages.length - 1]).to.equal('other');
+    });
+
+    it('can be cancelled with a signal', async () => {
+      const ses = session.fromPartition(`clear-storage-${Math.random()}`);
+      const controller = new AbortController();
+      ses.once('clear-storage-data-progress', () => controller.abort());
+      await expect(ses.clearStorageData({ signal: controller.signal }))
+        .to.eventually.be.rejectedWith(/aborted/);
+    });
+
+    it('rejects right away with an aborted signal', async () => {
+      await expect(session.defaultSession.clearStorageData({ signal: AbortSignal.abort() }))
+        .to.eventually.be.rejectedWith(/aborted/);
+    });
+
+    it('does not emit the progress without listeners', async () => {
+      const { getSkippedEmitCounts } = process._linkedBinding('electron_browser_event_emitter');
+      const ses = session.fromPartition(`clear-storage-${Math.random()}`);
+      const skipped = getSkippedEmitCounts()['clear-storage-data-progress'] || 0;
+      await ses.clearStorageData({ storages: ['cookies', 'localstorage'], background: true });
+      expect(getSkippedEmitCounts()['clear-storage-data-progress']).to.equal(skipped + 2);
+
+      const progress: string[] = [];
+      const listener = (event: Electron.Event, details: { storage: string }) => { progress.push(details.storage); };
+      ses.on('clear-storage-data-progress', listener);
+      ses.off('clear-storage-data-progress', listener);
+      ses.once('clear-storage-data-progress', listener);
+      await ses.clearStorageData({ storages: ['cookies', 'localstorage'], background: true });
+      expect(progress).to.deep.equal(['cookies']);
+      expect(getSkippedEmitCounts()['clear-storage-data-progress']).to.equal(skipped + 3);
+    });
+  });
+
+  describe('ses.getStorageUsage(options)', () => {
+    afterEach(closeAllWindows);
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => { res.end('<html></html>'); });
+      serverUrl = (await listen(server)).url;
+    });
+    after(() => server.close());
+
+    const storeData = async (ses: Session) => {
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      await w.webContents.executeJavaScript(`
+        localStorage.setItem('key', 'x'.repeat(1024));
+        new Promise((resolve, reject) => {
+          const request = indexedDB.open('db');
+          request.onupgradeneeded = () => request.result.createObjectStore('store');
+          request.onsuccess = () => {
+            const transaction = request.result.transaction('store', 'readwrite');
+            transaction.objectStore('store').put('y'.repeat(1024), 'key');
+            transaction.oncomplete = resolve;
+            transaction.onerror = reject;
+          };
+          request.onerror = reject;
+        });
+      `);
+      return new URL(serverUrl).origin;
+    };
+
+    it('breaks down the usage of an origin', async () => {
+      const ses = session.fromPartition(`storage-usage-${Math.random()}`);
+      const origin = await storeData(ses);
+      ses.flushStorageData();
+      const [usage] = await ses.getStorageUsage({ origins: [origin] });
+      expect(usage.origin).to.equal(origin);
+      expect(usage.indexedDB).to.be.greaterThan(0);
+      expect(usage.localStorage).to.be.at.least(0);
+      expect(usage.quota).to.be.greaterThan(0);
+      expect(usage.total).to.be.at.least(usage.indexedDB + usage.localStorage);
+    });
+
+    it('measures all the origins with data by default', async () => {
+      const ses = session.fromPartition(`storage-usage-${Math.random()}`);
+      const origin = await storeData(ses);
+      const usages = await ses.getStorageUsage();
+      expect(usages.map(usage => usage.origin)).to.include(origin);
+    });
+
+    it('rejects invalid origins', async () => {
+      await expect(session.defaultSession.getStorageUsage({ origins: ['not a url'] }))
+        .to.eventually.be.rejectedWith(/Invalid origin/);
+    });
+  });
+
+  describe('ses.evictStorage(origins, options)', () => {
+    afterEach(closeAllWindows);
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => { res.end('<html></html>'); });
+      serverUrl = (await listen(server)).url;
+    });
+    after(() => server.close());
+
+    it('clears each origin and reports the progress', async () => {
+      const ses = session.fromPartition(`evict-storage-${Math.random()}`);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      await w.webContents.executeJavaScript('localStorage.setItem("key", "value")');
+      const origin = new URL(serverUrl).origin;
+      const other = 'https://example.com';
+      const progress: { origin: string, completed: number, total: number }[] = [];
+      ses.on('storage-eviction-progress', (event, details) => { progress.push(details); });
+      await ses.evictStorage([origin, other], { storages: ['localstorage'] });
+      expect(progress).to.deep.equal([
+        { origin, completed: 1, total: 2 },
+        { origin: other, completed: 2, total: 2 }
+      ]);
+      await waitUntil(async () => await w.webContents.executeJavaScript('localStorage.length') === 0);
+    });
+
+    it('resolves right away without origins', async () => {
+      await session.defaultSession.evictStorage([]);
+    });
   });
 
   describe('will-download event', () => {
@@ -371,6 +615,26 @@ describe('session module', () => {
       expect(proxy).to.equal('PROXY myproxy:80');
     });
 
+    it('resolves concurrent lookups', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      const proxies = await Promise.all([
+        customSession.resolveProxy('http://example.com/a'),
+        customSession.resolveProxy('http://example.com/b'),
+        customSession.resolveProxy('http://example.org/'),
+        customSession.resolveProxy('https://example.org/')
+      ]);
+      expect(proxies).to.deep.equal([
+        'PROXY myproxy:80', 'PROXY myproxy:80', 'PROXY myproxy:80', 'DIRECT'
+      ]);
+    });
+
+    it('does not reuse results from before the proxy settings changed', async () => {
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY myproxy:80');
+      await customSession.setProxy({ proxyRules: 'http=otherproxy:80' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY otherproxy:80');
+    });
+
     it('allows removing the implicit bypass rules for localhost', async () => {
       const config = {
         proxyRules: 'http=myproxy:80',
@@ -531,6 +795,45 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.resolveHosts(hosts)', () => {
+    it('resolves each host in order', async () => {
+      const customSession = session.fromPartition('resolvehosts');
+      const results = await customSession.resolveHosts([
+        'ipv4.localhost2', 'notfound.localhost2', 'ipv6.localhost2'
+      ]);
+      expect(results.map(result => result.host)).to.deep.equal([
+        'ipv4.localhost2', 'notfound.localhost2', 'ipv6.localhost2'
+      ]);
+      expect(results[0].endpoints![0].address).to.equal('10.0.0.1');
+      expect(results[1].endpoints).to.be.undefined();
+      expect(results[1].error).to.match(/net::ERR_NAME_NOT_RESOLVED/);
+      expect(results[2].endpoints![0].address).to.equal('::1');
+    });
+
+    it('resolves an empty list', async () => {
+      const results = await session.fromPartition('resolvehosts').resolveHosts([]);
+      expect(results).to.deep.equal([]);
+    });
+  });
+
+  describe('ses.getHostResolverMetrics()', () => {
+    it('counts the resolutions of the session', async () => {
+      const customSession = session.fromPartition(`resolvermetrics-${Math.random()}`);
+      await customSession.resolveHost('ipv4.localhost2');
+      await customSession.resolveHost('127.0.0.1');
+      await expect(customSession.resolveHost('notfound.localhost2'))
+        .to.eventually.be.rejected();
+      const metrics = customSession.getHostResolverMetrics();
+      expect(metrics.resolutions).to.equal(3);
+      expect(metrics.failures).to.equal(1);
+      // IP addresses never need a DNS query.
+      expect(metrics.cacheHits).to.be.at.least(1);
+      expect(metrics.hitRate).to.be.within(0.5, 1);
+      expect(metrics.maxLatency).to.be.at.least(metrics.averageLatency);
+      expect(metrics.recentHosts).to.deep.equal(['ipv4.localhost2']);
+    });
+  });
+
   describe('ses.getBlobData()', () => {
     const scheme = 'cors-blob';
     const protocol = session.defaultSession.protocol;
@@ -622,6 +925,57 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getBlobDataStream() and ses.writeBlobDataToFile()', () => {
+    const scheme = 'cors-blob';
+    const protocol = session.defaultSession.protocol;
+    const url = `${scheme}://host`;
+    const data = new Array(200_000).fill('a').join('');
+    after(async () => {
+      await protocol.unregisterProtocol(scheme);
+    });
+    afterEach(closeAllWindows);
+
+    const getBlobUUID = async () => {
+      const content = `<html>
+                       <script>
+                       let fd = new FormData();
+                       fd.append("data", new Blob(new Array(200_000).fill('a')));
+                       fetch('${url}', {method:'POST', body: fd });
+                       </script>
+                       </html>`;
+      const uuid = new Promise<string>((resolve) => {
+        protocol.registerStringProtocol(scheme, (request, callback) => {
+          if (request.method === 'GET') {
+            callback({ data: content, mimeType: 'text/html' });
+          } else if (request.method === 'POST') {
+            resolve(request.uploadData![1].blobUUID!);
+          }
+        });
+      });
+      const w = new BrowserWindow({ show: false });
+      w.loadURL(url);
+      return uuid;
+    };
+
+    it('streams the blob data in chunks', async () => {
+      const uuid = await getBlobUUID();
+      const chunks: Buffer[] = [];
+      for await (const chunk of session.defaultSession.getBlobDataStream(uuid)) {
+        chunks.push(chunk);
+      }
+      expect(chunks.length).to.be.greaterThan(1);
+      expect(Buffer.concat(chunks).toString()).to.equal(data);
+    });
+
+    it('writes the blob data to a file', async () => {
+      const uuid = await getBlobUUID();
+      const filePath = path.join(os.tmpdir(), `blob-data-${Date.now()}`);
+      defer(() => fs.promises.rm(filePath, { force: true }));
+      await session.defaultSession.writeBlobDataToFile(uuid, filePath);
+      expect(await fs.promises.readFile(filePath, 'utf8')).to.equal(data);
+    });
+  });
+
   describe('ses.setCertificateVerifyProc(callback)', () => {
     let server: http.Server;
     let serverUrl: string;
@@ -712,6 +1066,44 @@ describe('session module', () => {
       expect(numVerificationRequests).to.equal(1);
     });
 
+    it('accepts a cacheTtl for the results of the proc', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setCertificateVerifyProc((e, callback) => callback(e.hostname === '127.0.0.1' ? 0 : -3), { cacheTtl: 60 * 1000 });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      expect(w.webContents.getTitle()).to.equal('hello');
+      expect(() => ses.clearCertificateVerifyProcCache()).to.not.throw();
+    });
+
+    describe('pins', () => {
+      const spkiHash = (publicKey: crypto.KeyObject) => {
+        const spki = publicKey.export({ type: 'spki', format: 'der' });
+        return `sha256/${crypto.createHash('sha256').update(spki).digest('base64')}`;
+      };
+
+      it('rejects the certificate without calling the proc when no key is pinned', async () => {
+        const ses = session.fromPartition(`${Math.random()}`);
+        let numVerificationRequests = 0;
+        ses.setCertificateVerifyProc((e, callback) => {
+          if (e.hostname === '127.0.0.1') numVerificationRequests++;
+          callback(0);
+        }, { pins: { '127.0.0.1': [spkiHash(crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' }).publicKey)] } });
+
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+        await expect(w.loadURL(serverUrl)).to.eventually.be.rejectedWith(/ERR_SSL_PINNED_KEY_NOT_IN_CERT_CHAIN/);
+        expect(numVerificationRequests).to.equal(0);
+      });
+
+      it('uses the result of Chromium when a key of the chain is pinned', async () => {
+        const ses = session.fromPartition(`${Math.random()}`);
+        ses.setCertificateVerifyProc(null, { pins: { '127.0.0.1': [spkiHash(new crypto.X509Certificate(fs.readFileSync(path.join(fixtures, 'certificates', 'intermediateCA.pem'))).publicKey)] } });
+
+        const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+        await expect(w.loadURL(serverUrl)).to.eventually.be.rejectedWith(/ERR_CERT_(AUTHORITY|COMMON_NAME)_INVALID/);
+      });
+    });
+
     it('does not cancel requests in other sessions', async () => {
       const ses1 = session.fromPartition(`${Math.random()}`);
       ses1.setCertificateVerifyProc((opts, cb) => cb(0));
@@ -1103,6 +1495,134 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setNetworkGroup(group)', () => {
+    it('resolves the hosts used by the group when joining', async () => {
+      const first = session.fromPartition(`network-group-${Math.random()}`);
+      const second = session.fromPartition(`network-group-${Math.random()}`);
+      await first.resolveHost('localhost');
+      first.setNetworkGroup('spec-group');
+      defer(() => first.setNetworkGroup(''));
+      second.setNetworkGroup('spec-group');
+      defer(() => second.setNetworkGroup(''));
+      expect(second.getHostResolverMetrics().sharedHosts).to.equal(1);
+      expect(first.getHostResolverMetrics().sharedHosts).to.equal(0);
+    });
+
+    it('shares the hosts used afterwards', async () => {
+      const first = session.fromPartition(`network-group-${Math.random()}`);
+      const second = session.fromPartition(`network-group-${Math.random()}`);
+      first.setNetworkGroup('spec-group-2');
+      defer(() => first.setNetworkGroup(''));
+      second.setNetworkGroup('spec-group-2');
+      defer(() => second.setNetworkGroup(''));
+      await first.resolveHost('localhost');
+      expect(second.getHostResolverMetrics().sharedHosts).to.equal(1);
+    });
+  });
+
+  describe('ses.setPreferencesCommitInterval(interval)', () => {
+    it('writes the changes in batches', async () => {
+      const ses = session.fromPartition(`persist:prefs-batching-${Math.random()}`);
+      ses.setPreferencesCommitInterval(200);
+      const { writes } = ses.getPreferencesWriteStats();
+      ses.setSpellCheckerLanguages(['en-US']);
+      ses.setSpellCheckerEnabled(false);
+      ses.setSpellCheckerEnabled(true);
+      await waitUntil(() => ses.getPreferencesWriteStats().writes > writes);
+      const stats = ses.getPreferencesWriteStats();
+      expect(stats.writes).to.equal(writes + 1);
+      expect(stats.batchedChanges).to.be.at.least(2);
+      await waitUntil(() => ses.getPreferencesWriteStats().bytes > 0);
+    });
+  });
+
+  describe('ses.setDownloadQueueOptions(options)', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      // Sends a chunk every 50ms, so that the downloads stay in progress.
+      server = http.createServer((req, res) => {
+        res.writeHead(200, { 'Content-Type': 'application/octet-stream', 'Content-Length': 1024 * 1024 });
+        const timer = setInterval(() => res.write(Buffer.alloc(1024)), 50);
+        res.on('close', () => clearInterval(timer));
+      });
+      serverUrl = (await listen(server)).url;
+    });
+    after(() => server.close());
+
+    const startDownload = async (ses: Session, name: string, priority?: number) => {
+      const created = once(ses, 'will-download') as Promise<[Electron.Event, Electron.DownloadItem]>;
+      ses.downloadURL(`${serverUrl}/${name}`, priority === undefined ? undefined : { priority });
+      const [, item] = await created;
+      item.setSavePath(path.join(os.tmpdir(), `${name}-${Math.random()}`));
+      return item;
+    };
+
+    it('waits for a free slot in the order of the priorities', async () => {
+      const ses = session.fromPartition(`download-queue-${Math.random()}`);
+      ses.setDownloadQueueOptions({ maxConcurrent: 1 });
+      const first = await startDownload(ses, 'first');
+      const low = await startDownload(ses, 'low', 1);
+      const high = await startDownload(ses, 'high', 2);
+      await waitUntil(() => low.isPaused() && high.isPaused());
+      expect(first.isPaused()).to.be.false();
+
+      first.cancel();
+      await waitUntil(() => !high.isPaused());
+      expect(low.isPaused()).to.be.true();
+      high.cancel();
+      await waitUntil(() => !low.isPaused());
+      low.cancel();
+    });
+
+    it('frees the slot of a download paused by the app', async () => {
+      const ses = session.fromPartition(`download-queue-${Math.random()}`);
+      ses.setDownloadQueueOptions({ maxConcurrent: 1 });
+      const first = await startDownload(ses, 'first');
+      const second = await startDownload(ses, 'second');
+      await waitUntil(() => second.isPaused());
+      first.pause();
+      await waitUntil(() => !second.isPaused());
+      first.cancel();
+      second.cancel();
+    });
+
+    it('emits throttled progress events', async () => {
+      const ses = session.fromPartition(`download-queue-${Math.random()}`);
+      const item = await startDownload(ses, 'progress');
+      item.setProgressInterval(200);
+      const [, details] = await once(item, 'progress');
+      expect(details.receivedBytes).to.be.a('number');
+      expect(details.totalBytes).to.equal(1024 * 1024);
+      item.cancel();
+    });
+
+    it('emits the progress events once enough bytes were received', async () => {
+      const ses = session.fromPartition(`download-queue-${Math.random()}`);
+      const item = await startDownload(ses, 'progress-bytes');
+      item.setProgressInterval(0, 4096);
+      const received: number[] = [];
+      item.on('progress', (event, details) => { received.push(details.receivedBytes); });
+      await waitUntil(() => received.length >= 3);
+      item.cancel();
+      for (let i = 1; i < received.length; i++) {
+        expect(received[i] - received[i - 1]).to.be.at.least(4096);
+      }
+    });
+
+    it('reports all the downloads in one session event', async () => {
+      const ses = session.fromPartition(`download-queue-${Math.random()}`);
+      const first = await startDownload(ses, 'first');
+      const second = await startDownload(ses, 'second');
+      ses.setDownloadProgressInterval(100);
+      defer(() => ses.setDownloadProgressInterval(0));
+      const [, downloads] = await once(ses, 'download-progress');
+      expect(downloads.map((download: any) => download.item)).to.have.members([first, second]);
+      first.cancel();
+      second.cancel();
+    });
+  });
+
   describe('ses.createInterruptedDownload(options)', () => {
     afterEach(closeAllWindows);
     it('can create an interrupted download item', async () => {
@@ -1356,6 +1876,71 @@ describe('session module', () => {
       expect(handlerDetails!.isMainFrame).to.be.false();
       expect(handlerDetails!.embeddingOrigin).to.equal('file:///');
     });
+
+    describe('cached decisions', () => {
+      let w: BrowserWindow;
+      let calls: number;
+      beforeEach(async () => {
+        w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            partition: 'very-temp-permission-cache'
+          }
+        });
+        calls = 0;
+        w.webContents.session.protocol.interceptStringProtocol('https', (req, cb) => {
+          cb('<html></html>');
+        });
+        await w.loadURL('https://myfakesite/');
+      });
+      afterEach(() => {
+        w.webContents.session.setPermissionCheckHandler(null);
+        w.webContents.session.protocol.uninterceptProtocol('https');
+      });
+
+      const queryClipboardRead = () => w.webContents.executeJavaScript(`
+        navigator.permissions.query({name: 'clipboard-read'}).then(permission => permission.state)
+      `, true);
+      const countChecks = (decision: Electron.PermissionCheckDecision) => {
+        w.webContents.session.setPermissionCheckHandler((wc, permission) => {
+          if (permission !== 'clipboard-read') return false;
+          calls++;
+          return decision;
+        });
+      };
+
+      it('does not call the handler again for a cached decision', async () => {
+        countChecks({ granted: true, cache: true });
+        expect(await queryClipboardRead()).to.equal('granted');
+        expect(await queryClipboardRead()).to.equal('granted');
+        expect(calls).to.equal(1);
+      });
+
+      it('calls the handler again after clearPermissionCheckCache()', async () => {
+        countChecks({ granted: false, cache: true });
+        expect(await queryClipboardRead()).to.equal('denied');
+        w.webContents.session.clearPermissionCheckCache();
+        expect(await queryClipboardRead()).to.equal('denied');
+        expect(calls).to.equal(2);
+      });
+
+      it('calls the handler again once the ttl passed', async () => {
+        countChecks({ granted: true, ttl: 100 });
+        await queryClipboardRead();
+        await queryClipboardRead();
+        expect(calls).to.equal(1);
+        await setTimeout(200);
+        await queryClipboardRead();
+        expect(calls).to.equal(2);
+      });
+
+      it('does not cache decisions which are not cacheable', async () => {
+        countChecks({ granted: true });
+        await queryClipboardRead();
+        await queryClipboardRead();
+        expect(calls).to.equal(2);
+      });
+    });
   });
 
   describe('ses.isPersistent()', () => {
@@ -1449,6 +2034,108 @@ describe('session module', () => {
         session.defaultSession.setCodeCachePath(path.join(app.getPath('userData'), 'electron-test-code-cache'));
       }).to.not.throw();
     });
+
+    it('stores the code cache of sandboxed preload scripts', async () => {
+      const ses = session.fromPartition('persist:code-cache-' + Math.random());
+      const codeCachePath = fs.mkdtempSync(path.join(app.getPath('temp'), 'electron-test-code-cache-'));
+      defer(() => fs.rmSync(codeCachePath, { recursive: true, force: true }));
+      ses.setCodeCachePath(codeCachePath);
+
+      const preloadCachePath = path.join(codeCachePath, 'preload');
+      const loadWindow = async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            session: ses,
+            sandbox: true,
+            preload: path.join(fixtures, 'module', 'empty.js')
+          }
+        });
+        await w.loadURL('about:blank');
+        w.destroy();
+      };
+
+      await loadWindow();
+      await waitUntil(() => fs.existsSync(preloadCachePath) &&
+        fs.readdirSync(preloadCachePath).some(file => !file.endsWith('.tmp')));
+      const [entry] = fs.readdirSync(preloadCachePath);
+      const { mtimeMs } = fs.statSync(path.join(preloadCachePath, entry));
+
+      // The second window consumes the entry rather than replacing it.
+      await loadWindow();
+      await setTimeout(500);
+      expect(fs.readdirSync(preloadCachePath)).to.deep.equal([entry]);
+      expect(fs.statSync(path.join(preloadCachePath, entry)).mtimeMs).to.equal(mtimeMs);
+    });
+  });
+
+  describe('ses.setSpareRenderer()', () => {
+    afterEach(closeAllWindows);
+
+    it('uses the spare renderer for windows with matching preferences', async () => {
+      const ses = session.fromPartition('spare-renderer-' + Math.random());
+      ses.setSpareRenderer({ webPreferences: { sandbox: true } });
+      defer(() => ses.setSpareRenderer(null));
+      // The spare renderer is launched asynchronously.
+      await setTimeout(100);
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w.loadURL('about:blank');
+      expect(ses.getSpareRendererMetrics()).to.deep.equal({ hits: 1, misses: 0 });
+
+      await setTimeout(100);
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: false } });
+      await w2.loadURL('about:blank');
+      expect(ses.getSpareRendererMetrics()).to.deep.equal({ hits: 1, misses: 1 });
+    });
+
+    it('throws for invalid options', () => {
+      expect(() => {
+        session.defaultSession.setSpareRenderer('foo' as any);
+      }).to.throw('Options must be an object or null.');
+    });
+  });
+
+  describe('ses.setRendererSharing()', () => {
+    afterEach(closeAllWindows);
+
+    it('shares the renderer of same-site windows above the process limit', async () => {
+      const server = http.createServer((req, res) => res.end('<title>shared</title>'));
+      const { url } = await listen(server);
+      defer(() => server.close());
+      const ses = session.fromPartition('renderer-sharing-' + Math.random());
+      ses.setRendererSharing({ maxProcesses: 1 });
+      defer(() => ses.setRendererSharing(null));
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(url);
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w2.loadURL(url);
+      expect(w2.webContents.getOSProcessId()).to.equal(w.webContents.getOSProcessId());
+      const metrics = ses.getRendererSharingMetrics();
+      expect(metrics.processCount).to.equal(1);
+      expect(metrics.sharedWebContents).to.equal(1);
+      expect(metrics.estimatedSavings).to.be.a('number');
+    });
+
+    it('does not share the renderer of windows with other switches', async () => {
+      const ses = session.fromPartition('renderer-sharing-' + Math.random());
+      ses.setRendererSharing({ maxProcesses: 1 });
+      defer(() => ses.setRendererSharing(null));
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w.loadURL('about:blank');
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: false } });
+      await w2.loadURL('about:blank');
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w.webContents.getOSProcessId());
+      expect(ses.getRendererSharingMetrics().sharedWebContents).to.equal(0);
+    });
+
+    it('throws for invalid options', () => {
+      expect(() => {
+        session.defaultSession.setRendererSharing({ maxProcesses: -1 });
+      }).to.throw('maxProcesses and memoryBudget must not be negative.');
+    });
   });
 
   describe('ses.setSSLConfig()', () => {
@@ -1501,4 +2188,106 @@ describe('session module', () => {
       await expect(request()).to.be.rejectedWith(/ERR_SSL_VERSION_OR_CIPHER_MISMATCH/);
     });
   });
+
+  describe('ses.warmConnections()', () => {
+    it('opens the requested sockets', async () => {
+      const server = http.createServer((req, res) => { res.end(); });
+      let connections = 0;
+      server.on('connection', () => { connections++; });
+      const { url } = await listen(server);
+      defer(() => server.close());
+
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.warmConnections([{ url, numSockets: 3, priority: 1 }]);
+      await waitUntil(() => connections === 3);
+    });
+
+    it('validates the targets', () => {
+      expect(() => {
+        session.defaultSession.warmConnections([{ url: 'file:///' }]);
+      }).to.throw(/valid http\(s\) urls/);
+      expect(() => {
+        session.defaultSession.warmConnections([{ url: 'http://127.0.0.1', numSockets: 7 }]);
+      }).to.throw(/numSockets is outside range/);
+    });
+  });
+
+  describe('ses.getConnectionPoolInfo()', () => {
+    it('reports the idle sockets', async () => {
+      const server = http.createServer((req, res) => { res.end('hi'); });
+      const { port } = await listen(server);
+      defer(() => server.close());
+
+      const ses = session.fromPartition(`${Math.random()}`);
+      const response = await ses.fetch(`http://127.0.0.1:${port}`);
+      expect(await response.text()).to.equal('hi');
+
+      const info = await ses.getConnectionPoolInfo();
+      expect(info.http2Sessions).to.be.an('array');
+      expect(info.quicSessions).to.be.an('array');
+      expect(info.dnsCache).to.be.an('array');
+      const group = info.socketPools.find(group => group.group.includes(`127.0.0.1:${port}`));
+      expect(group).to.not.be.undefined();
+      expect(group!.idleSockets).to.equal(1);
+    });
+  });
+
+  describe('HTTP cache entries', () => {
+    let ses: Session;
+    let serverUrl: string;
+    let server: http.Server;
+    beforeEach(async () => {
+      ses = session.fromPartition(`${Math.random()}`);
+      server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', req.url === '/no-store' ? 'no-store' : 'max-age=3600');
+        res.end('cached');
+      });
+      serverUrl = (await listen(server)).url;
+    });
+    afterEach(() => {
+      server.close();
+    });
+
+    it('stores, looks up and evicts entries', async () => {
+      expect(await ses.lookupCache(`${serverUrl}/a`)).to.be.null();
+
+      const entry = await ses.storeCache(`${serverUrl}/a`);
+      expect(entry).to.not.be.null();
+      expect(entry!.statusCode).to.equal(200);
+      expect(entry!.headers['cache-control']).to.deep.equal(['max-age=3600']);
+
+      const found = await ses.lookupCache(`${serverUrl}/a`);
+      expect(found!.url).to.equal(`${serverUrl}/a`);
+
+      await ses.evictCache(`${serverUrl}/`);
+      expect(await ses.lookupCache(`${serverUrl}/a`)).to.be.null();
+    });
+
+    it('does not store responses which may not be cached', async () => {
+      expect(await ses.storeCache(`${serverUrl}/no-store`)).to.be.null();
+    });
+
+    it('rejects eviction prefixes with a path', async () => {
+      await expect(ses.evictCache(`${serverUrl}/a`)).to.eventually.be.rejectedWith(/whole origins/);
+    });
+
+    it('counts the net.request responses served from the cache', async () => {
+      const request = async (cache?: 'only-if-cached') => {
+        const urlRequest = net.request({ url: `${serverUrl}/b`, session: ses, cache });
+        urlRequest.end();
+        const [response] = await once(urlRequest, 'response') as [Electron.IncomingMessage];
+        expect(response.fromCache).to.equal(cache === 'only-if-cached');
+        response.resume();
+        await once(response, 'end');
+      };
+      await request();
+      await request('only-if-cached');
+      const stats = await ses.getCacheStats();
+      expect(stats.requests).to.equal(2);
+      expect(stats.hits).to.equal(1);
+      expect(stats.hitRate).to.equal(0.5);
+      expect(stats.bytesFromCache).to.equal('cached'.length);
+      expect(stats.size).to.be.greaterThan(0);
+    });
+  });
 });
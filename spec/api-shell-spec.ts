@@ -84,6 +84,50 @@ describe('shell module', () => {
     });
   });
 
+  describe('shell.readDirectoryInfo()', () => {
+    let dir: string;
+    before(async () => {
+      dir = await fs.mkdtemp(path.resolve(app.getPath('temp'), 'electron-shell-spec-'));
+      await fs.writeFile(path.join(dir, 'a.txt'), 'hello');
+      await fs.writeFile(path.join(dir, 'b.log'), 'world!');
+      await fs.mkdir(path.join(dir, 'sub'));
+      await fs.writeFile(path.join(dir, 'sub', 'c.txt'), '');
+    });
+    after(() => fs.remove(dir));
+
+    const entries = (info: Electron.DirectoryInfo) => info.names.map((name, i) => ({
+      name,
+      size: info.sizes[i],
+      modifiedTime: info.modifiedTimes[i],
+      isDirectory: info.isDirectory[i]
+    })).sort((a, b) => a.name.localeCompare(b.name));
+
+    it('reads the entries of a directory', async () => {
+      const result = entries(await shell.readDirectoryInfo(dir));
+      expect(result.map(e => e.name)).to.deep.equal(['a.txt', 'b.log', 'sub']);
+      expect(result.map(e => e.isDirectory)).to.deep.equal([false, false, true]);
+      expect(result[0].size).to.equal(5);
+      expect(result[1].size).to.equal(6);
+      const { mtimeMs } = await fs.stat(path.join(dir, 'a.txt'));
+      expect(result[0].modifiedTime).to.be.closeTo(mtimeMs, 1000);
+    });
+
+    it('reads the subdirectories when recursive', async () => {
+      const result = entries(await shell.readDirectoryInfo(dir, { recursive: true }));
+      expect(result.map(e => e.name)).to.deep.equal(['a.txt', 'b.log', 'sub', path.join('sub', 'c.txt')]);
+    });
+
+    it('only returns the entries matching the filter', async () => {
+      const result = entries(await shell.readDirectoryInfo(dir, { recursive: true, filter: '*.txt' }));
+      expect(result.map(e => e.name)).to.deep.equal(['a.txt', path.join('sub', 'c.txt')]);
+    });
+
+    it('rejects when the path is not a directory', async () => {
+      await expect(shell.readDirectoryInfo(path.join(dir, 'a.txt'))).to.eventually.be.rejectedWith(/Failed to read the directory/);
+      await expect(shell.readDirectoryInfo(path.join(dir, 'does-not-exist'))).to.eventually.be.rejected();
+    });
+  });
+
   const shortcutOptions = {
     target: 'C:\\target',
     description: 'description',
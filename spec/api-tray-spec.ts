@@ -144,6 +144,27 @@ describe('tray module', () => {
     });
   });
 
+  describe('tray.setAnimatedImage(images[, options])', () => {
+    it('throws a descriptive error for a missing file', () => {
+      const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
+      expect(() => {
+        tray.setAnimatedImage([nativeImage.createEmpty(), badPath]);
+      }).to.throw(/Failed to load image from path (.+)/);
+    });
+
+    it('throws for an invalid interval', () => {
+      expect(() => {
+        tray.setAnimatedImage([nativeImage.createEmpty()], { interval: 0 });
+      }).to.throw(/interval must be a positive number/);
+    });
+
+    it('can be replaced by tray.setImage()', () => {
+      tray.setAnimatedImage([nativeImage.createEmpty(), nativeImage.createEmpty()], { interval: 10 });
+      tray.setAnimatedImage([]);
+      tray.setImage(nativeImage.createEmpty());
+    });
+  });
+
   describe('tray.setPressedImage(image)', () => {
     it('throws a descriptive error for a missing file', () => {
       const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
@@ -1,10 +1,14 @@
 import { expect } from 'chai';
 import * as childProcess from 'node:child_process';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
 import * as path from 'node:path';
-import { BrowserWindow, MessageChannelMain, utilityProcess } from 'electron/main';
-import { ifit } from './lib/spec-helpers';
+import * as zlib from 'node:zlib';
+import { app, BrowserWindow, MessageChannelMain, ipcMain, utilityProcess } from 'electron/main';
+import { ifit, waitUntil } from './lib/spec-helpers';
 import { closeWindow } from './lib/window-helpers';
 import { once } from 'node:events';
+import { setTimeout } from 'node:timers/promises';
 
 const fixturesPath = path.resolve(__dirname, 'fixtures', 'api', 'utility-process');
 const isWindowsOnArm = process.platform === 'win32' && process.arch === 'arm64';
@@ -97,6 +101,32 @@ describe('utilityProcess module', () => {
     });
   });
 
+  describe('takeHeapSnapshot() API', () => {
+    it('writes a gzip compressed snapshot of the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      const filePath = path.join(app.getPath('temp'), 'utility.heapsnapshot.gz');
+      const phases = new Set<string>();
+      child.on('heap-snapshot-progress', (progress) => phases.add(progress.phase));
+      try {
+        await child.takeHeapSnapshot(filePath, { compression: 'gzip' });
+        const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+        expect(snapshot.snapshot.node_count).to.be.greaterThan(0);
+        expect([...phases]).to.include('write');
+      } finally {
+        fs.rmSync(filePath, { force: true });
+        child.kill();
+      }
+    });
+
+    it('rejects after the child process exited', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      const filePath = path.join(app.getPath('temp'), 'exited.heapsnapshot');
+      await expect(child.takeHeapSnapshot(filePath)).to.eventually.be.rejectedWith(/exited utility process/);
+    });
+  });
+
   describe('pid property', () => {
     it('is valid when child process launches successfully', async () => {
       const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
@@ -177,6 +207,62 @@ describe('utilityProcess module', () => {
     });
   });
 
+  describe('readOutput() API', () => {
+    it('returns null when the stream is not sent to a buffer sink', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'log.js'));
+      await once(child, 'spawn');
+      expect(child.readOutput('stdout')).to.be.null();
+      await once(child, 'exit');
+    });
+
+    it('returns the end of the output kept by buffer sinks', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'log.js'), [], {
+        stdio: ['ignore', { type: 'buffer' }, { type: 'buffer', size: 3 }]
+      });
+      expect(child.stdout).to.be.null();
+      await once(child, 'exit');
+      let stdout = '';
+      let stderr = '';
+      let dropped = 0;
+      await waitUntil(() => {
+        stdout += child.readOutput('stdout')!.data.toString('utf8');
+        const output = child.readOutput('stderr')!;
+        stderr += output.data.toString('utf8');
+        dropped += output.dropped;
+        return stdout === 'hello\n' && stderr.length === 3;
+      });
+      expect(stderr).to.equal('rld');
+      expect(dropped).to.equal(2);
+    });
+
+    it('writes the output of file sinks to the file', async () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-utility-stdio-'));
+      const file = path.join(dir, 'stdout.log');
+      try {
+        const child = utilityProcess.fork(path.join(fixturesPath, 'log.js'), [], {
+          stdio: ['ignore', { type: 'file', path: file }, 'ignore']
+        });
+        await once(child, 'exit');
+        await waitUntil(() => fs.existsSync(file) && fs.readFileSync(file, 'utf8') === 'hello\n');
+      } finally {
+        fs.rmSync(dir, { recursive: true, force: true });
+      }
+    });
+
+    it('throws for an invalid sink', () => {
+      expect(() => {
+        utilityProcess.fork(path.join(fixturesPath, 'log.js'), [], {
+          stdio: ['ignore', { type: 'socket' } as any, 'ignore']
+        });
+      }).to.throw(/stdout sink type must be file or buffer/);
+      expect(() => {
+        utilityProcess.fork(path.join(fixturesPath, 'log.js'), [], {
+          stdio: ['ignore', 'ignore', { type: 'file' }]
+        });
+      }).to.throw(/stderr file sink must have a path/);
+    });
+  });
+
   describe('postMessage() API', () => {
     it('establishes a default ipc channel with the child process', async () => {
       const result = 'I will be echoed.';
@@ -203,6 +289,233 @@ describe('utilityProcess module', () => {
       expect(child.kill()).to.be.true();
       await exit;
     });
+
+    it('transfers ArrayBuffers both ways', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'transfer-array-buffer.js'));
+      await once(child, 'spawn');
+      const buffer = new Uint8Array([1, 2, 3]).buffer;
+      child.postMessage(buffer, [buffer]);
+      expect(buffer.byteLength).to.equal(0);
+      const [data] = await once(child, 'message');
+      expect(data).to.be.an.instanceOf(ArrayBuffer);
+      expect([...new Uint8Array(data)]).to.deep.equal([3, 2, 1]);
+      const [{ detached }] = await once(child, 'message');
+      expect(detached).to.be.true();
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('throws when an ArrayBuffer is transferred twice', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      const buffer = new ArrayBuffer(8);
+      expect(() => child.postMessage(buffer, [buffer, buffer])).to.throw(/ArrayBuffer at index 1 is a duplicate/);
+      expect(buffer.byteLength).to.equal(8);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('reports the messages the child has not read yet', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message-queue.js'));
+      await once(child, 'spawn');
+      child.setWatermarks({ high: 1024 });
+      const high = once(child, 'buffered-amount-high');
+      expect(child.postMessage('a'.repeat(512))).to.be.true();
+      expect(child.postMessage('b'.repeat(1024))).to.be.false();
+      await high;
+      expect(child.bufferedAmount).to.be.at.least(1536);
+      // The child starts reading after a few seconds.
+      const low = once(child, 'buffered-amount-low');
+      child.postMessage('c');
+      await low;
+      expect(child.bufferedAmount).to.equal(0);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('invoke() API', () => {
+    it('answers with the handler of the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'invoke-handler.js'));
+      await once(child, 'message');
+      const reply = await child.invoke('utility-echo', 1, 'two');
+      expect(reply).to.deep.equal({ args: [1, 'two'], senderId: 0 });
+      await expect(child.invoke('utility-throw')).to.eventually.be.rejectedWith(/handler failed/);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('createSharedBuffer() API', () => {
+    it('shares memory with the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'shared-buffer.js'));
+      await once(child, 'spawn');
+      const buffer = child.createSharedBuffer('data', 16);
+      expect(buffer).to.be.an.instanceOf(SharedArrayBuffer);
+      expect(buffer.byteLength).to.equal(16);
+      const view = new Int32Array(buffer);
+      view[0] = 41;
+      child.postMessage('data');
+      await once(child, 'message');
+      expect(Atomics.load(view, 0)).to.equal(42);
+      expect(view[1]).to.equal(16);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('throws for an invalid size', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      expect(() => child.createSharedBuffer('data', 0)).to.throw(/Invalid shared buffer size/);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('setSpareProcessCount() API', () => {
+    afterEach(() => {
+      utilityProcess.setSpareProcessCount(0);
+    });
+
+    it('throws for an invalid count', () => {
+      expect(() => utilityProcess.setSpareProcessCount(-1)).to.throw(/count must be a non-negative integer/);
+      expect(() => utilityProcess.setSpareProcessCount(1.5)).to.throw(/count must be a non-negative integer/);
+    });
+
+    it('forks from a spare process', async () => {
+      const { spareLaunches } = utilityProcess.getLaunchMetrics();
+      utilityProcess.setSpareProcessCount(1);
+      // The spare can still be launching when the first forks are made.
+      for (let i = 0; i < 20 && utilityProcess.getLaunchMetrics().spareLaunches === spareLaunches; i++) {
+        await setTimeout(250);
+        const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'));
+        await once(child, 'spawn');
+        child.postMessage('hello');
+        const [data] = await once(child, 'message');
+        expect(data).to.equal('hello');
+        const exit = once(child, 'exit');
+        expect(child.kill()).to.be.true();
+        await exit;
+      }
+      const metrics = utilityProcess.getLaunchMetrics();
+      expect(metrics.spareLaunches).to.be.greaterThan(spareLaunches);
+      expect(metrics.averageSpareLaunchTime).to.be.greaterThan(0);
+    });
+
+    it('does not fork from a spare process with custom options', async () => {
+      utilityProcess.setSpareProcessCount(1);
+      await setTimeout(1000);
+      const { spareLaunches } = utilityProcess.getLaunchMetrics();
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'), [], {
+        stdio: 'ignore'
+      });
+      await once(child, 'spawn');
+      child.postMessage('hello');
+      await once(child, 'message');
+      expect(utilityProcess.getLaunchMetrics().spareLaunches).to.equal(spareLaunches);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('createPool() API', () => {
+    it('dispatches tasks to the processes of the pool', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), { size: 2 });
+      try {
+        const results = await Promise.all([1, 2, 3, 4].map(n => pool.run('double', n)));
+        expect(results).to.deep.equal([2, 4, 6, 8]);
+        const pids = await Promise.all([pool.run('pid'), pool.run('pid')]);
+        expect(new Set(pids).size).to.equal(2);
+        const metrics = pool.getMetrics();
+        expect(metrics.completed).to.equal(6);
+        expect(metrics.queueDepth).to.equal(0);
+        expect(metrics.workers).to.have.lengthOf(2);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('restarts processes which exit', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), { size: 1 });
+      try {
+        const workerExit = once(pool, 'worker-exit');
+        await expect(pool.run('exit')).to.eventually.be.rejectedWith(/exited before replying/);
+        const [index, code] = await workerExit;
+        expect(index).to.equal(0);
+        expect(code).to.equal(1);
+        expect(await pool.run('double', 21)).to.equal(42);
+        const metrics = pool.getMetrics();
+        expect(metrics.restarts).to.equal(1);
+        expect(metrics.failed).to.equal(1);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('rejects the tasks run after close()', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-worker.js'), { size: 1 });
+      pool.close();
+      await expect(pool.run('double', 1)).to.eventually.be.rejectedWith(/The pool is closed/);
+    });
+  });
+
+  describe('routeInvoke() API', () => {
+    let w: BrowserWindow;
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      await closeWindow(w);
+      w = null as unknown as BrowserWindow;
+    });
+
+    const invoke = (channel: string, ...args: any[]) => w.webContents.executeJavaScript(
+      `require('electron').ipcRenderer.invoke(${JSON.stringify(channel)}, ...${JSON.stringify(args)})`);
+
+    it('answers invokes of renderers from the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'invoke-handler.js'));
+      await once(child, 'message');
+      child.routeInvoke('utility-echo');
+      child.routeInvoke('utility-throw');
+      expect(await invoke('utility-echo', 'hello', 42)).to.deep.equal({ args: ['hello', 42], senderId: w.webContents.id });
+      await expect(invoke('utility-throw')).to.eventually.be.rejectedWith(/handler failed/);
+      const result = await w.webContents.executeJavaScript(`require('electron').ipcRenderer.invokeSync('utility-echo', 'sync')`);
+      expect(result).to.deep.equal({ args: ['sync'], senderId: w.webContents.id });
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('stops routing when the child process exits', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'invoke-handler.js'));
+      await once(child, 'message');
+      child.routeInvoke('utility-echo');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+      ipcMain.handleOnce('utility-echo', () => 'main');
+      expect(await invoke('utility-echo')).to.equal('main');
+    });
+
+    it('throws when the channel is routed to another child process', async () => {
+      const children = [0, 1].map(() => utilityProcess.fork(path.join(fixturesPath, 'invoke-handler.js')));
+      await Promise.all(children.map(child => once(child, 'spawn')));
+      children[0].routeInvoke('utility-echo');
+      expect(() => children[1].routeInvoke('utility-echo')).to.throw(/second utility process/);
+      await Promise.all(children.map(child => {
+        const exit = once(child, 'exit');
+        expect(child.kill()).to.be.true();
+        return exit;
+      }));
+    });
   });
 
   describe('behavior', () => {
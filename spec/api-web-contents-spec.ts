@@ -3,6 +3,7 @@ import { AddressInfo } from 'node:net';
 import * as path from 'node:path';
 import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as zlib from 'node:zlib';
 import { BrowserWindow, ipcMain, webContents, session, app, BrowserView, WebContents } from 'electron/main';
 import { closeAllWindows } from './lib/window-helpers';
 import { ifdescribe, defer, waitUntil, listen, ifit } from './lib/spec-helpers';
@@ -353,6 +354,126 @@ describe('webContents module', () => {
     });
   });
 
+  describe('with many webContents', () => {
+    const count = 1000;
+    let contents: WebContents[] = [];
+    afterEach(() => {
+      for (const wc of contents) wc.destroy();
+      contents = [];
+    });
+    afterEach(closeAllWindows);
+
+    it('launches renderers with the preferences of their webContents', async function () {
+      this.timeout(120000);
+      const start = performance.now();
+      for (let i = 0; i < count; i++) {
+        contents.push((webContents as typeof ElectronInternal.WebContents).create());
+      }
+      const created = performance.now();
+      // The command line of the renderer comes from the preferences of the
+      // webContents of its process.
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const launched = performance.now();
+      expect(await w.webContents.executeJavaScript('typeof require')).to.equal('function');
+      console.log(`created ${count} webContents in ${Math.round(created - start)}ms, launched a renderer in ${Math.round(launched - created)}ms`);
+    });
+
+    it('keeps track of the webContents after cross-process navigations', async function () {
+      this.timeout(120000);
+      for (let i = 0; i < count; i++) {
+        contents.push((webContents as typeof ElectronInternal.WebContents).create());
+      }
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: false, nodeIntegration: true, contextIsolation: false } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
+      const firstProcessId = w.webContents.getOSProcessId();
+      // A navigation to another site swaps the process.
+      const server = http.createServer((req, res) => res.end('<p>swapped</p>'));
+      defer(() => server.close());
+      const { url } = await listen(server);
+      await w.loadURL(url);
+      expect(w.webContents.getOSProcessId()).to.not.equal(firstProcessId);
+      expect(await w.webContents.executeJavaScript('typeof require')).to.equal('function');
+    });
+  });
+
+  describe('webContents.getMediaPlaybackStats()', () => {
+    afterEach(closeAllWindows);
+
+    it('resolves with an empty array for a page without media', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(await w.webContents.getMediaPlaybackStats()).to.deep.equal([]);
+    });
+
+    it('reports the media elements of the page', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
+      await w.webContents.executeJavaScript(`new Promise((resolve, reject) => {
+        const video = document.createElement('video');
+        video.muted = true;
+        video.onloadedmetadata = resolve;
+        video.onerror = () => reject(new Error('video failed to load'));
+        video.src = '../cat-spin.mp4';
+        document.body.appendChild(video);
+        const audio = document.createElement('audio');
+        audio.src = '../assets/tone.wav';
+        document.body.appendChild(audio);
+      })`);
+      const stats = await w.webContents.getMediaPlaybackStats();
+      expect(stats.map(({ kind }) => kind)).to.deep.equal(['video', 'audio']);
+      const [video, audio] = stats;
+      expect(video.frame).to.equal(w.webContents.mainFrame);
+      expect(video.src).to.match(/cat-spin\.mp4$/);
+      expect(video.paused).to.be.true();
+      expect(video.videoWidth).to.be.greaterThan(0);
+      expect(video.droppedVideoFrames).to.be.a('number');
+      expect(audio.videoWidth).to.equal(0);
+      expect(audio.totalVideoFrames).to.equal(0);
+    });
+  });
+
+  describe('webContents.executeJavaScriptInFrames', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'sub-frames', 'frame-with-frame-container.html'));
+    });
+    after(closeAllWindows);
+
+    it('runs the code in all frames by default', async () => {
+      const results = await w.webContents.executeJavaScriptInFrames('location.href');
+      const frames = w.webContents.mainFrame.framesInSubtree;
+      expect(results.map(({ frame }) => frame)).to.deep.equal(frames);
+      expect(results.map(({ result }) => result)).to.deep.equal(frames.map(frame => frame.url));
+    });
+
+    it('runs the code in the given frames only', async () => {
+      const [, subframe] = w.webContents.mainFrame.framesInSubtree;
+      const results = await w.webContents.executeJavaScriptInFrames('window.name = "picked"', [subframe]);
+      expect(results).to.have.lengthOf(1);
+      expect(results[0].frame).to.equal(subframe);
+      expect(await w.webContents.executeJavaScript('window.name')).to.not.equal('picked');
+      expect(await subframe.executeJavaScript('window.name')).to.equal('picked');
+    });
+
+    it('waits for promises', async () => {
+      const results = await w.webContents.executeJavaScriptInFrames('Promise.resolve(42)');
+      expect(results.map(({ result }) => result)).to.deep.equal(results.map(() => 42));
+    });
+
+    it('reports errors per frame', async () => {
+      const results = await w.webContents.executeJavaScriptInFrames('if (window !== top) throw new Error("nope"); 1');
+      expect(results[0]).to.have.property('result', 1);
+      expect(results[0]).to.not.have.property('error');
+      for (const result of results.slice(1)) {
+        expect(result).to.have.property('error').that.is.a('string');
+        expect(result).to.not.have.property('result');
+      }
+    });
+  });
+
   describe('loadURL() promise API', () => {
     let w: BrowserWindow;
 
@@ -822,6 +943,48 @@ describe('webContents module', () => {
     });
   });
 
+  describe('sendInputEvents(events)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'key-events.html'));
+    });
+    afterEach(closeAllWindows);
+
+    it('sends the events in order at their times', async () => {
+      const keys: string[] = [];
+      const listener = (event: Electron.IpcMainEvent, key: string) => { keys.push(key); };
+      ipcMain.on('keydown', listener);
+      defer(() => ipcMain.removeListener('keydown', listener));
+      const start = Date.now();
+      await w.webContents.sendInputEvents([
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'keyDown', keyCode: 'B', time: 100 } as any
+      ]);
+      expect(Date.now() - start).to.be.at.least(90);
+      await waitUntil(() => keys.length === 2);
+      expect(keys).to.deep.equal(['a', 'b']);
+    });
+
+    it('throws on an invalid event', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([
+          { type: 'keyDown', keyCode: 'A' },
+          { type: 'not-an-event' } as any
+        ]);
+      }).to.throw('Invalid event object at index 1');
+    });
+
+    it('throws when the times decrease', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([
+          { type: 'keyDown', keyCode: 'A', time: 50 } as any,
+          { type: 'keyDown', keyCode: 'B', time: 10 } as any
+        ]);
+      }).to.throw('The times of the events must not decrease');
+    });
+  });
+
   describe('insertCSS', () => {
     afterEach(closeAllWindows);
     it('supports inserting CSS', async () => {
@@ -840,6 +1003,47 @@ describe('webContents module', () => {
       const result = await w.webContents.executeJavaScript('window.getComputedStyle(document.body).getPropertyValue("background-repeat")');
       expect(result).to.equal('repeat');
     });
+
+    it('keeps the same CSS inserted several times independent', async () => {
+      const css = 'body { background-repeat: round; }';
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      await Promise.all([w1.loadURL('about:blank'), w2.loadURL('about:blank')]);
+      const key1 = await w1.webContents.insertCSS(css);
+      const key2 = await w1.webContents.insertCSS(css);
+      await w2.webContents.insertCSS(css);
+      expect(key1).to.not.equal(key2);
+
+      const getBackgroundRepeat = (w: BrowserWindow) => w.webContents.executeJavaScript('window.getComputedStyle(document.body).getPropertyValue("background-repeat")');
+      await w1.webContents.removeInsertedCSS(key1);
+      expect(await getBackgroundRepeat(w1)).to.equal('round');
+      await w1.webContents.removeInsertedCSS(key2);
+      expect(await getBackgroundRepeat(w1)).to.equal('repeat');
+      expect(await getBackgroundRepeat(w2)).to.equal('round');
+    });
+  });
+
+  describe('findInPage()', () => {
+    afterEach(closeAllWindows);
+    it('reports the results of incremental requests until the final one', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'content.html'));
+      w.webContents.focus();
+
+      const results: Electron.Result[] = [];
+      const finalResult = new Promise<void>(resolve => {
+        w.webContents.on('found-in-page', (event, result) => {
+          results.push(result);
+          if (result.finalUpdate) resolve();
+        });
+      });
+      const requestId = w.webContents.findInPage('virtual', { incremental: true });
+      await finalResult;
+
+      expect(results.map(result => result.requestId)).to.deep.equal(results.map(() => requestId));
+      expect(results[results.length - 1].matches).to.equal(3);
+      w.webContents.stopFindInPage('clearSelection');
+    });
   });
 
   describe('inspectElement()', () => {
@@ -933,6 +1137,76 @@ describe('webContents module', () => {
     });
   });
 
+  describe('getIPCMetrics()', () => {
+    afterEach(closeAllWindows);
+    it('records messages per channel', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      w.webContents.ipc.handle('metrics-invoke', () => 'pong');
+      const received = once(w.webContents.ipc, 'metrics-send');
+      await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron');
+        ipcRenderer.send('metrics-send', 'x'.repeat(1000));
+        await ipcRenderer.invoke('metrics-invoke');
+        await ipcRenderer.invoke('metrics-invoke');
+      })()`);
+      await received;
+
+      const metrics = w.webContents.getIPCMetrics();
+      expect(metrics['metrics-send'].count).to.equal(1);
+      expect(metrics['metrics-send'].size.min).to.be.above(1000);
+      expect(metrics['metrics-invoke'].count).to.equal(2);
+      for (const key of ['size', 'serializationTime', 'queueingDelay', 'handlerDuration'] as const) {
+        const histogram = metrics['metrics-invoke'][key];
+        expect(histogram.count).to.equal(2);
+        expect(histogram.buckets.reduce((a, b) => a + b, 0)).to.equal(2);
+      }
+
+      w.webContents.clearIPCMetrics();
+      expect(w.webContents.getIPCMetrics()).to.deep.equal({});
+    });
+  });
+
+  describe('getFastPathedNavigationCount()', () => {
+    afterEach(closeAllWindows);
+    const addFrames = async (w: BrowserWindow, count: number) => {
+      let loaded = 0;
+      const framesLoaded = new Promise<void>(resolve => {
+        w.webContents.on('did-frame-finish-load', (event, isMainFrame) => {
+          if (!isMainFrame && ++loaded === count) resolve();
+        });
+      });
+      await w.webContents.executeJavaScript(`
+        for (let i = 0; i < ${count}; i++) {
+          const iframe = document.createElement('iframe');
+          iframe.src = 'blank.html?' + i;
+          document.body.appendChild(iframe);
+        }
+      `);
+      await framesLoaded;
+    };
+
+    it('counts the navigations without navigation listeners', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
+      const before = w.webContents.getFastPathedNavigationCount();
+      expect(before).to.be.at.least(1);
+      await addFrames(w, 5);
+      expect(w.webContents.getFastPathedNavigationCount()).to.equal(before + 5);
+    });
+
+    it('does not count the navigations with listeners', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'blank.html'));
+      const urls: string[] = [];
+      w.webContents.on('will-frame-navigate', ({ url }) => { urls.push(url); });
+      const before = w.webContents.getFastPathedNavigationCount();
+      await addFrames(w, 5);
+      expect(w.webContents.getFastPathedNavigationCount()).to.equal(before);
+      expect(urls).to.have.lengthOf(5);
+    });
+  });
+
   describe('getMediaSourceId()', () => {
     afterEach(closeAllWindows);
     it('returns a valid stream id', () => {
@@ -1768,6 +2042,128 @@ describe('webContents module', () => {
     generateSpecs('with sandbox', true);
   });
 
+  describe('reduceMemory()', () => {
+    afterEach(closeAllWindows);
+
+    it('releases the memory of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.reduceMemory()).to.eventually.be.fulfilled();
+      await expect(w.webContents.reduceMemory({ caches: false, partitionAlloc: false })).to.eventually.be.fulfilled();
+    });
+
+    it('rejects when the page has no renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const gone = once(w.webContents, 'render-process-gone');
+      w.webContents.forcefullyCrashRenderer();
+      await gone;
+      await expect(w.webContents.reduceMemory()).to.eventually.be.rejectedWith('The page has no live renderer');
+    });
+  });
+
+  describe('captureJavaScriptStack()', () => {
+    afterEach(closeAllWindows);
+
+    it('samples the stack of a busy renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        function spinRenderer () {
+          const end = Date.now() + 2000;
+          while (Date.now() < end);
+        }
+        setTimeout(spinRenderer);
+      `);
+      const sample = await w.webContents.captureJavaScriptStack();
+      expect(sample.jsStack).to.include('spinRenderer');
+      expect(sample.sampleDuration).to.be.at.least(500);
+      expect(sample.cpuTime).to.be.above(0);
+    });
+
+    it('has an empty stack when no JavaScript runs', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const sample = await w.webContents.captureJavaScriptStack();
+      expect(sample.jsStack).to.equal('');
+    });
+
+    it('rejects when the page has no renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const gone = once(w.webContents, 'render-process-gone');
+      w.webContents.forcefullyCrashRenderer();
+      await gone;
+      await expect(w.webContents.captureJavaScriptStack()).to.eventually.be.rejectedWith('The page has no live renderer');
+    });
+  });
+
+  describe('freeze() and discard()', () => {
+    afterEach(closeAllWindows);
+
+    it('freezes a hidden page until it is resumed', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(w.webContents.getLifecycleState()).to.equal('active');
+      expect(w.webContents.freeze()).to.be.true();
+      expect(w.webContents.getLifecycleState()).to.equal('frozen');
+      const metric = app.getAppMetrics().find(entry => entry.pid === w.webContents.getOSProcessId());
+      expect(metric).to.have.property('lifecycleState', 'frozen');
+      w.webContents.resume();
+      expect(w.webContents.getLifecycleState()).to.equal('active');
+      expect(await w.webContents.executeJavaScript('1 + 1')).to.equal(2);
+    });
+
+    it('does not freeze or discard a visible page', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const shown = once(w, 'show');
+      w.show();
+      await shown;
+      expect(w.webContents.freeze()).to.be.false();
+      expect(w.webContents.discard()).to.be.false();
+      expect(w.webContents.getLifecycleState()).to.equal('active');
+    });
+
+    it('reloads a discarded page when it is navigated', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.on('render-process-gone', () => {
+        expect.fail('render-process-gone should not be emitted');
+      });
+      expect(w.webContents.discard()).to.be.true();
+      expect(w.webContents.getLifecycleState()).to.equal('discarded');
+      await w.loadURL('data:text/html,<title>restored</title>');
+      expect(w.webContents.getLifecycleState()).to.equal('active');
+      expect(w.webContents.getTitle()).to.equal('restored');
+    });
+  });
+
+  describe('near-heap-limit event', () => {
+    afterEach(closeAllWindows);
+
+    it('is emitted when the heap of a renderer nearly reaches its limit', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { maxOldSpaceSize: 16, nearHeapLimit: 'notify' }
+      });
+      await w.loadURL('about:blank');
+      const nearHeapLimit = once(w.webContents, 'near-heap-limit');
+      w.webContents.executeJavaScript(`
+        const chunks = [];
+        const grow = () => {
+          for (let i = 0; i < 1000; i++) chunks.push(new Array(1000).fill(i));
+          setTimeout(grow);
+        };
+        grow();
+      `);
+      const [, details] = await nearHeapLimit;
+      expect(details.action).to.equal('notify');
+      expect(details.heapLimit).to.be.greaterThan(details.initialHeapLimit);
+      expect(details.usedHeapSize).to.be.greaterThan(0);
+    });
+  });
+
   describe('takeHeapSnapshot()', () => {
     afterEach(closeAllWindows);
 
@@ -1800,6 +2196,34 @@ describe('webContents module', () => {
       }
     });
 
+    it('writes a compressed snapshot without strings', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript('window.secret = "heap-snapshot-secret-" + "value"');
+
+      const filePath = path.join(app.getPath('temp'), 'graph-only.heapsnapshot.gz');
+      const phases = new Set<string>();
+      w.webContents.on('heap-snapshot-progress', (event, progress) => phases.add(progress.phase));
+      try {
+        await w.webContents.takeHeapSnapshot(filePath, { compression: 'gzip', graphOnly: true });
+        const json = zlib.gunzipSync(fs.readFileSync(filePath)).toString();
+        expect(json).to.not.include('heap-snapshot-secret-value');
+        const snapshot = JSON.parse(json);
+        expect(snapshot.nodes).to.have.lengthOf(snapshot.snapshot.node_count * snapshot.snapshot.meta.node_fields.length);
+        expect(snapshot.strings).to.include('(GC roots)');
+        expect([...phases]).to.include.members(['capture', 'write']);
+      } finally {
+        fs.rmSync(filePath, { force: true });
+      }
+    });
+
+    it('rejects an invalid compression', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const filePath = path.join(app.getPath('temp'), 'test.heapsnapshot');
+      await expect(w.webContents.takeHeapSnapshot(filePath, { compression: 'zip' as any })).to.eventually.be.rejectedWith('Invalid compression: zip');
+    });
+
     it('fails with invalid file path', async () => {
       const w = new BrowserWindow({
         show: false,
@@ -2060,6 +2484,40 @@ describe('webContents module', () => {
       // Check that correct # of pages are rendered.
       expect(doc.numPages).to.equal(3);
     });
+
+    it('writes the PDF to a path', async () => {
+      await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+      const pdfPath = path.join(app.getPath('temp'), 'print-to-pdf-path.pdf');
+      defer(() => fs.rmSync(pdfPath, { force: true }));
+      const data = await w.webContents.printToPDF({ path: pdfPath });
+      expect(data).to.be.an.instanceof(Buffer).that.is.empty();
+
+      const doc = await pdfjs.getDocument(fs.readFileSync(pdfPath)).promise;
+      expect(doc.numPages).to.equal(1);
+    });
+
+    it('rejects when path is not a string', async () => {
+      await expect(w.webContents.printToPDF({ path: 1 as any })).to.eventually.be.rejectedWith('path must be a String');
+    });
+
+    it('prints many webContents with webContents.printPagesToPDF()', async () => {
+      const windows = [w, new BrowserWindow({ show: false }), new BrowserWindow({ show: false })];
+      await Promise.all(windows.map((win, i) => win.loadURL(`data:text/html,<h1>Page ${i}</h1>`)));
+
+      const results = await webContents.printPagesToPDF(windows.map(win => win.webContents), {
+        printOptions: { landscape: true },
+        concurrency: 2
+      });
+      expect(results).to.have.lengthOf(3);
+      for (const data of results) {
+        expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+      }
+    });
+
+    it('rejects webContents.printPagesToPDF() with too few paths', async () => {
+      await expect(webContents.printPagesToPDF([w.webContents], { paths: [] })).to.eventually.be.rejectedWith(/paths must be an Array/);
+    });
   });
 
   describe('PictureInPicture video', () => {
@@ -77,6 +77,27 @@ describe('webFrameMain module', () => {
       ]);
     });
 
+    it('can take a snapshot of the frame tree', () => {
+      const tree = webFrame.getFrameTree();
+      const frames = webFrame.framesInSubtree;
+      expect(tree.url).to.deep.equal(frames.map(frame => frame.url));
+      expect(tree.origin).to.deep.equal(frames.map(frame => frame.origin));
+      expect(tree.name).to.deep.equal(frames.map(frame => frame.name));
+      expect([...tree.frameTreeNodeId]).to.deep.equal(frames.map(frame => frame.frameTreeNodeId));
+      expect([...tree.processId]).to.deep.equal(frames.map(frame => frame.processId));
+      expect([...tree.routingId]).to.deep.equal(frames.map(frame => frame.routingId));
+      expect([...tree.parentIndex]).to.deep.equal(frames.map(frame => frame.parent ? frames.indexOf(frame.parent) : -1));
+    });
+
+    it('can take a snapshot of a subtree', () => {
+      const tree = webFrame.frames[0].getFrameTree();
+      expect(tree.url).to.deep.equal([
+        fileUrl('frame-with-frame.html'),
+        fileUrl('frame.html')
+      ]);
+      expect([...tree.parentIndex]).to.deep.equal([-1, 0]);
+    });
+
     it('can traverse all frames in subtree', () => {
       const urls = webFrame.frames[0].framesInSubtree.map(frame => frame.url);
       expect(urls).to.deep.equal([
@@ -281,6 +302,40 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('WebFrame.createRingBuffer', () => {
+    it('delivers messages to the renderer in order', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const received = w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.once('ring', (e, reader) => {
+          const messages = []
+          reader.start(m => messages.push(m), () => resolve(messages))
+        })
+      })`);
+      // Wait for the listener to be installed.
+      await w.webContents.executeJavaScript('0');
+      const writer = w.webContents.mainFrame.createRingBuffer('ring', { capacity: 4096 });
+      expect(writer.write({ hello: 'world' })).to.be.true();
+      expect(writer.write(Buffer.from('bytes'))).to.be.true();
+      expect(writer.write(42)).to.be.true();
+      writer.close();
+      expect(writer.closed).to.be.true();
+      const [value, bytes, number] = await received;
+      expect(value).to.deep.equal({ hello: 'world' });
+      expect(Buffer.from(bytes).toString()).to.equal('bytes');
+      expect(number).to.equal(42);
+    });
+
+    it('refuses messages that do not fit', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const writer = w.webContents.mainFrame.createRingBuffer('ring', { capacity: 4096 });
+      expect(writer.write(Buffer.alloc(8192))).to.be.false();
+      writer.close();
+    });
+  });
+
   describe('RenderFrame lifespan', () => {
     let w: BrowserWindow;
 
@@ -55,11 +55,14 @@ describe('webFrame module', () => {
 
     const spellCheckerFeedback =
       new Promise<[string[], boolean]>(resolve => {
+        const checked: string[] = [];
         ipcMain.on('spec-spell-check', (e, words, callbackDefined) => {
-          if (words.length === 5) {
-            // The API calls the provider after every completed word.
-            // The promise is resolved only after this event is received with all words.
-            resolve([words, callbackDefined]);
+          // The API calls the provider after every completed word, with the
+          // words it hasn't checked before.
+          checked.push(...words);
+          if (new Set(checked).size === 5) {
+            // The promise is resolved only after all words are received.
+            resolve([checked, callbackDefined]);
           }
         });
       });
@@ -1,4 +1,5 @@
 import { expect } from 'chai';
+import * as crypto from 'node:crypto';
 import * as http from 'node:http';
 import * as http2 from 'node:http2';
 import * as qs from 'node:querystring';
@@ -109,6 +110,27 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
     });
 
+    it('can filter URLs among many patterns', async () => {
+      const urls = [defaultURL + 'filter/*'];
+      for (let i = 0; i < 10000; i++) {
+        urls.push(`*://*.host${i}.example/*`, `http://host${i}.example/*`, `*://*/path${i}/*`);
+      }
+      ses.webRequest.onBeforeRequest({ urls }, cancel);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+      await expect(ajax(`${defaultURL}path42/test`)).to.eventually.be.rejected();
+    });
+
+    it('can filter URLs of any host by path', async () => {
+      ses.webRequest.onBeforeRequest({ urls: ['*://*/filter/*'] }, cancel);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+      // Like for any URLPattern, "/filter/*" matches "/filter" too.
+      await expect(ajax(`${defaultURL}filter`)).to.eventually.be.rejected();
+    });
+
     it('can filter URLs and types', async () => {
       const filter1: Electron.WebRequestFilter = { urls: [defaultURL + 'filter/*'], types: ['xhr'] };
       ses.webRequest.onBeforeRequest(filter1, cancel);
@@ -294,6 +316,17 @@ describe('webRequest module', () => {
       expect(data).to.equal('/');
     });
 
+    it('keeps the details after the request has completed', async () => {
+      let savedDetails: Electron.OnBeforeSendHeadersListenerDetails | undefined;
+      ses.webRequest.onBeforeSendHeaders((details, callback) => {
+        savedDetails = details;
+        callback({});
+      });
+      await ajax(defaultURL, { headers: { 'Foo.Bar': 'baz' } });
+      expect(savedDetails!.requestHeaders['Foo.Bar']).to.equal('baz');
+      expect({ ...savedDetails }).to.have.property('requestHeaders').that.deep.equals(savedDetails!.requestHeaders);
+    });
+
     it('can change the request headers', async () => {
       ses.webRequest.onBeforeSendHeaders((details, callback) => {
         const requestHeaders = details.requestHeaders;
@@ -585,6 +618,137 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.onResponseBody', () => {
+    afterEach(() => {
+      ses.webRequest.onResponseBody(null);
+    });
+
+    it('receives the size and hash of the body', async () => {
+      let received: Electron.OnResponseBodyListenerDetails | undefined;
+      const done = new Promise<void>((resolve) => {
+        ses.webRequest.onResponseBody((details) => {
+          if (details.url === `${defaultURL}body/test`) {
+            received = details;
+            resolve();
+          }
+        });
+      });
+      const { data } = await ajax(`${defaultURL}body/test`);
+      expect(data).to.equal('/body/test');
+      await done;
+      expect(received!.byteLength).to.equal(Buffer.byteLength('/body/test'));
+      expect(received!.sha256).to.equal(crypto.createHash('sha256').update('/body/test').digest('hex'));
+      expect(received!.statusCode).to.equal(200);
+    });
+  });
+
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules([]);
+      ses.webRequest.onBeforeRequest(null);
+    });
+
+    it('can block requests', async () => {
+      ses.webRequest.setRules([
+        { action: { type: 'block' }, condition: { urls: [defaultURL + 'filter/*'] } }
+      ]);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+    });
+
+    it('does not call the listener for requests it blocks', async () => {
+      let called = false;
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        called = true;
+        callback({});
+      });
+      ses.webRequest.setRules([{ action: { type: 'block' } }]);
+      await expect(ajax(defaultURL)).to.eventually.be.rejected();
+      expect(called).to.be.false();
+    });
+
+    it('prefers allow rules of the same priority', async () => {
+      ses.webRequest.setRules([
+        { action: { type: 'block' } },
+        { action: { type: 'allow' }, condition: { urls: [defaultURL + 'allow/*'] } }
+      ]);
+      const { data } = await ajax(`${defaultURL}allow/test`);
+      expect(data).to.equal('/allow/test');
+      await expect(ajax(`${defaultURL}test`)).to.eventually.be.rejected();
+    });
+
+    it('applies the rule with the highest priority', async () => {
+      ses.webRequest.setRules([
+        { action: { type: 'block' } },
+        {
+          priority: 2,
+          action: { type: 'redirect', redirectURL: `${defaultURL}redirect` },
+          condition: { urls: [defaultURL + 'test'] }
+        }
+      ]);
+      const { data } = await ajax(`${defaultURL}test`);
+      expect(data).to.equal('/redirect');
+    });
+
+    it('can modify the request headers', async () => {
+      ses.webRequest.setRules([{
+        action: {
+          type: 'modifyHeaders',
+          requestHeaders: [{ header: 'Accept', operation: 'set', value: '*/*;test/header' }]
+        }
+      }]);
+      const { data } = await ajax(defaultURL);
+      expect(data).to.equal('/header/received');
+    });
+
+    it('can modify the response headers', async () => {
+      ses.webRequest.setRules([{
+        action: {
+          type: 'modifyHeaders',
+          responseHeaders: [
+            { header: 'Custom', operation: 'set', value: 'Changed' },
+            { header: 'X-Added', operation: 'append', value: 'Value' }
+          ]
+        }
+      }, {
+        priority: 0,
+        action: {
+          type: 'modifyHeaders',
+          responseHeaders: [{ header: 'Custom', operation: 'remove' }]
+        }
+      }]);
+      const { headers } = await ajax(defaultURL);
+      expect(headers).to.have.property('custom', 'Changed');
+      expect(headers).to.have.property('x-added', 'Value');
+    });
+
+    it('does not proxy requests which no rule can apply to', async () => {
+      ses.webRequest.setRules([{ action: { type: 'block' }, condition: { urls: ['<all_urls>'], types: ['stylesheet'] } }]);
+      const { bypassedRequests } = ses.webRequest.getProxyMetrics();
+      const { data } = await ajax(defaultURL);
+      expect(data).to.equal('/');
+      expect(ses.webRequest.getProxyMetrics().bypassedRequests).to.equal(bypassedRequests + 1);
+    });
+
+    it('throws for invalid rules', () => {
+      expect(() => {
+        ses.webRequest.setRules([{ action: { type: 'unknown' as any } }]);
+      }).to.throw("Invalid rule action 'unknown'");
+      expect(() => {
+        ses.webRequest.setRules([{ action: { type: 'redirect' } }]);
+      }).to.throw(/redirectURL/);
+      expect(() => {
+        ses.webRequest.setRules([{
+          action: {
+            type: 'modifyHeaders',
+            requestHeaders: [{ header: 'Invalid Name', operation: 'set', value: '' }]
+          }
+        }]);
+      }).to.throw("Invalid header name 'Invalid Name'");
+    });
+  });
+
   describe('WebSocket connections', () => {
     it('can be proxyed', async () => {
       // Setup server.
@@ -679,5 +843,33 @@ describe('webRequest module', () => {
       expect(reqHeaders['/websocket'].foo).to.equal('bar');
       expect(reqHeaders['/'].foo).to.equal('bar');
     });
+
+    it('are not proxyed when no listener applies to them', async () => {
+      const server = http.createServer();
+      const wss = new WebSocket.Server({ server });
+      const { port } = await listen(server);
+      const ses = session.fromPartition(`${Math.random()}`);
+      let proxied = false;
+      ses.webRequest.onBeforeSendHeaders({ urls: ['http://example.com/*'] }, (details, callback) => {
+        proxied = true;
+        callback({});
+      });
+      const contents = (webContents as typeof ElectronInternal.WebContents).create({ session: ses });
+      defer(() => {
+        contents.destroy();
+        wss.close();
+        server.close();
+      });
+
+      await contents.loadURL('about:blank');
+      const { bypassedRequests } = ses.webRequest.getProxyMetrics();
+      await contents.executeJavaScript(`new Promise((resolve, reject) => {
+        const ws = new WebSocket('ws://127.0.0.1:${port}');
+        ws.onopen = () => { ws.close(); resolve(); };
+        ws.onerror = () => reject(new Error('failed to connect'));
+      })`);
+      expect(ses.webRequest.getProxyMetrics().bypassedRequests).to.equal(bypassedRequests + 1);
+      expect(proxied).to.be.false();
+    });
   });
 });
@@ -1,4 +1,7 @@
 import { expect } from 'chai';
+import * as asar from '@electron/asar';
+import * as cp from 'node:child_process';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { Worker } from 'node:worker_threads';
@@ -127,6 +130,60 @@ describe('asar package', () => {
       });
     });
   });
+
+  describe('compressed files', () => {
+    let compressedAsar: string;
+    let tmpDir: string;
+    // Spans two blocks of 4MB.
+    const bigContents = Array.from({ length: 200000 }, (_, i) => `line ${i} of a compressible file\n`).join('');
+
+    before(async () => {
+      tmpDir = await importedFs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-asar-compressed-'));
+      const src = path.join(tmpDir, 'src');
+      await importedFs.promises.mkdir(src);
+      await importedFs.promises.writeFile(path.join(src, 'big.txt'), bigContents);
+      await importedFs.promises.writeFile(path.join(src, 'index.html'), `<title>compressed</title><!-- ${'x'.repeat(4096)} -->`);
+      const rawAsar = path.join(tmpDir, 'raw.asar');
+      await asar.createPackage(src, rawAsar);
+
+      compressedAsar = path.join(tmpDir, 'compressed.asar');
+      const { status } = cp.spawnSync(process.execPath, [path.resolve(__dirname, '../script/asar-compress.js'), rawAsar, compressedAsar], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1' }
+      });
+      expect(status).to.equal(0);
+      expect(importedFs.statSync(compressedAsar).size).to.be.lessThan(importedFs.statSync(rawAsar).size);
+    });
+
+    after(async () => {
+      await importedFs.promises.rm(tmpDir, { force: true, recursive: true });
+    });
+
+    it('reads them with fs', async () => {
+      const p = path.join(compressedAsar, 'big.txt');
+      expect(importedFs.statSync(p).size).to.equal(bigContents.length);
+      expect(importedFs.readFileSync(p, 'utf8')).to.equal(bigContents);
+      expect(await importedFs.promises.readFile(p, 'utf8')).to.equal(bigContents);
+    });
+
+    it('copies them out decompressed', () => {
+      const dest = path.join(tmpDir, 'big-copy.txt');
+      importedFs.copyFileSync(path.join(compressedAsar, 'big.txt'), dest);
+      expect(importedFs.readFileSync(dest, 'utf8')).to.equal(bigContents);
+    });
+
+    it('serves them over file: with ranges', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(compressedAsar, 'index.html'));
+      expect(await w.webContents.executeJavaScript('document.title')).to.equal('compressed');
+
+      // Across the end of the first block.
+      const start = 4 * 1024 * 1024 - 10;
+      const fileUrl = JSON.stringify(url.pathToFileURL(path.join(compressedAsar, 'big.txt')).href);
+      const text = await w.webContents.executeJavaScript(
+        `fetch(${fileUrl}, { headers: { Range: 'bytes=${start}-${start + 99}' } }).then(r => r.text())`);
+      expect(text).to.equal(bigContents.slice(start, start + 100));
+    });
+  });
 });
 
 // eslint-disable-next-line @typescript-eslint/no-unused-vars
@@ -1308,6 +1365,26 @@ describe('asar package', function () {
       });
     });
 
+    describe('internalModuleStat', function () {
+      itremote('stats files and directories', function () {
+        const { internalModuleStat } = (process as any).binding('fs');
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'file1'))).to.equal(0);
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'dir1'))).to.equal(1);
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'not-exist'))).to.equal(-34);
+        expect(internalModuleStat(path.join(asarDir, 'not-exist.asar', 'file1'))).to.equal(-34);
+      });
+
+      itremote('returns the batched results of the candidates of a path', function () {
+        const { internalModuleStat } = (process as any).binding('fs');
+        const p = path.join(asarDir, 'a.asar', 'file1');
+        expect(internalModuleStat(p)).to.equal(0);
+        expect(internalModuleStat(p + '.js')).to.equal(-34);
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'dir1'))).to.equal(1);
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'dir1', 'index.js'))).to.equal(-34);
+        expect(internalModuleStat(path.join(asarDir, 'a.asar', 'dir1', 'file1'))).to.equal(0);
+      });
+    });
+
     describe('util.promisify', function () {
       itremote('can promisify all fs functions', function () {
         const originalFs = require('original-fs');
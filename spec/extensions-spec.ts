@@ -1,5 +1,5 @@
 import { expect } from 'chai';
-import { app, session, BrowserWindow, ipcMain, WebContents, Extension, Session } from 'electron/main';
+import { app, session, webContents, BrowserWindow, ipcMain, WebContents, Extension, Session } from 'electron/main';
 import { closeAllWindows, closeWindow } from './lib/window-helpers';
 import * as http from 'node:http';
 import * as path from 'node:path';
@@ -8,6 +8,7 @@ import * as WebSocket from 'ws';
 import { emittedNTimes, emittedUntil } from './lib/events-helpers';
 import { ifit, listen } from './lib/spec-helpers';
 import { once } from 'node:events';
+import { setTimeout as setTimeoutAsync } from 'node:timers/promises';
 
 const uuid = require('uuid');
 
@@ -411,7 +412,29 @@ describe('chrome extensions', () => {
     });
   });
 
+  it('loads the same extension into several sessions', async () => {
+    const extensionPath = path.join(fixtures, 'extensions', 'red-bg');
+    const sessions = [1, 2, 3].map(() => session.fromPartition(`persist:${uuid.v4()}`));
+    const extensions = await Promise.all(sessions.map(s => s.loadExtension(extensionPath)));
+    for (const extension of extensions) {
+      expect(extension.id).to.equal(extensions[0].id);
+      expect(extension.manifest).to.deep.equal(extensions[0].manifest);
+    }
+    const w = new BrowserWindow({ show: false, webPreferences: { session: sessions[2] } });
+    await w.loadURL(url);
+    const bg = await w.webContents.executeJavaScript('document.documentElement.style.backgroundColor');
+    expect(bg).to.equal('red');
+  });
+
   describe('background pages', () => {
+    it('does not start a lazy background page when loading the extension', async () => {
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      await customSession.loadExtension(path.join(fixtures, 'extensions', 'lazy-background-page'));
+      await setTimeoutAsync(500);
+      const backgroundPages = webContents.getAllWebContents().filter(wc => wc.session === customSession && wc.getType() === 'backgroundPage');
+      expect(backgroundPages).to.be.empty();
+    });
+
     it('loads a lazy background page when sending a message', async () => {
       const customSession = session.fromPartition(`persist:${uuid.v4()}`);
       await customSession.loadExtension(path.join(fixtures, 'extensions', 'lazy-background-page'));
@@ -3,10 +3,6 @@ const { app } = require('electron');
 // Send data from the second instance to the first instance.
 const sendAdditionalData = app.commandLine.hasSwitch('send-data');
 
-app.whenReady().then(() => {
-  console.log('started'); // ping parent
-});
-
 let obj = {
   level: 1,
   testkey: 'testvalue1',
@@ -22,8 +18,9 @@ if (app.commandLine.hasSwitch('data-content')) {
   }
 }
 
-const gotTheLock = sendAdditionalData
-  ? app.requestSingleInstanceLock(obj) : app.requestSingleInstanceLock();
+if (app.commandLine.hasSwitch('send-binary')) {
+  obj = Buffer.from([1, 2, 3, 0, 255]);
+}
 
 app.on('second-instance', (event, args, workingDirectory, data) => {
   setImmediate(() => {
@@ -32,6 +29,28 @@ app.on('second-instance', (event, args, workingDirectory, data) => {
   });
 });
 
-if (!gotTheLock) {
-  app.exit(1);
+if (app.commandLine.hasSwitch('async')) {
+  const request = sendAdditionalData
+    ? app.requestSingleInstanceLockAsync(obj) : app.requestSingleInstanceLockAsync();
+  request.then((gotTheLock) => {
+    if (!gotTheLock) {
+      app.exit(1);
+      return;
+    }
+    // Other instances can only be notified once the lock was taken.
+    app.whenReady().then(() => {
+      console.log('started'); // ping parent
+    });
+  });
+} else {
+  app.whenReady().then(() => {
+    console.log('started'); // ping parent
+  });
+
+  const gotTheLock = sendAdditionalData
+    ? app.requestSingleInstanceLock(obj) : app.requestSingleInstanceLock();
+
+  if (!gotTheLock) {
+    app.exit(1);
+  }
 }
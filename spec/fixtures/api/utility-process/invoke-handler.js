@@ -0,0 +1,7 @@
+process.parentPort.handle('utility-echo', (event, ...args) => {
+  return { args, senderId: event.senderId };
+});
+process.parentPort.handle('utility-throw', async () => {
+  throw new Error('handler failed');
+});
+process.parentPort.postMessage('ready');
@@ -0,0 +1,5 @@
+process.parentPort.handle('task', (event, op, value) => {
+  if (op === 'exit') process.exit(1);
+  if (op === 'pid') return process.pid;
+  return value * 2;
+});
@@ -0,0 +1,7 @@
+process.parentPort.on('message', async (e) => {
+  const buffer = await process.parentPort.getSharedBuffer(e.data);
+  const view = new Int32Array(buffer);
+  view[1] = buffer.byteLength;
+  Atomics.add(view, 0, 1);
+  process.parentPort.postMessage('done');
+});
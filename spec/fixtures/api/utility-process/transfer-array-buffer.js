@@ -0,0 +1,6 @@
+process.parentPort.on('message', (e) => {
+  const view = new Uint8Array(e.data);
+  view.reverse();
+  const detached = process.parentPort.postMessage(e.data, [e.data]) && e.data.byteLength === 0;
+  process.parentPort.postMessage({ detached });
+});
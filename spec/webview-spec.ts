@@ -3,7 +3,7 @@ import * as url from 'node:url';
 import { BrowserWindow, session, ipcMain, app, WebContents } from 'electron/main';
 import { closeAllWindows } from './lib/window-helpers';
 import { emittedUntil } from './lib/events-helpers';
-import { ifit, ifdescribe, defer, itremote, useRemoteContext, listen } from './lib/spec-helpers';
+import { ifit, ifdescribe, defer, itremote, useRemoteContext, listen, waitUntil } from './lib/spec-helpers';
 import { expect } from 'chai';
 import * as http from 'node:http';
 import * as auth from 'basic-auth';
@@ -218,6 +218,75 @@ describe('<webview> tag', function () {
     });
   });
 
+  describe('webContents.setWebviewPool()', () => {
+    afterEach(closeAllWindows);
+
+    const attachWebView = (w: BrowserWindow, attributes: Record<string, string>) => {
+      return w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const webview = new WebView()
+        for (const [name, value] of Object.entries(${JSON.stringify(attributes)})) {
+          webview.setAttribute(name, value)
+        }
+        webview.addEventListener('did-finish-load', () => resolve(webview.getURL()), { once: true })
+        document.body.appendChild(webview)
+      })`);
+    };
+
+    it('attaches webviews to the guests kept ready', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { webviewTag: true } });
+      await w.loadURL('about:blank');
+      w.webContents.setWebviewPool({ size: 1 });
+      expect(await attachWebView(w, { src: 'data:text/html,first' })).to.equal('data:text/html,first');
+      expect(await attachWebView(w, { src: 'data:text/html,second' })).to.equal('data:text/html,second');
+      const metrics = w.webContents.getWebviewAttachMetrics();
+      expect(metrics.pooled.count).to.equal(2);
+      expect(metrics.created.count).to.equal(0);
+      expect(metrics.pooled.maxTime).to.be.at.least(metrics.pooled.averageTime);
+    });
+
+    it('creates guests for webviews with other web preferences', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { webviewTag: true } });
+      await w.loadURL('about:blank');
+      w.webContents.setWebviewPool({ size: 1, attributes: { partition: 'webview-pool' } });
+      await attachWebView(w, { src: 'about:blank' });
+      await attachWebView(w, { src: 'about:blank', partition: 'webview-pool' });
+      const metrics = w.webContents.getWebviewAttachMetrics();
+      expect(metrics.created.count).to.equal(1);
+      expect(metrics.pooled.count).to.equal(1);
+    });
+
+    it('validates the options', () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { webviewTag: true } });
+      expect(() => w.webContents.setWebviewPool({ size: 0 })).to.throw(/size must be a positive integer/);
+    });
+  });
+
+  describe('hiddenpolicy attribute', () => {
+    afterEach(closeAllWindows);
+
+    it('freezes the guest while its element is hidden', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { webviewTag: true } });
+      await w.loadURL('about:blank');
+      const didAttachWebview = once(w.webContents, 'did-attach-webview') as Promise<[any, WebContents]>;
+      await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const webview = new WebView()
+        webview.setAttribute('src', 'about:blank')
+        webview.setAttribute('hiddenpolicy', 'freeze')
+        webview.setAttribute('freezedelay', '0')
+        webview.addEventListener('did-finish-load', resolve, { once: true })
+        document.body.appendChild(webview)
+      })`);
+      const [, guest] = await didAttachWebview;
+      expect(guest.getLifecycleState()).to.equal('active');
+
+      await w.webContents.executeJavaScript('document.querySelector("webview").style.display = "none"');
+      await waitUntil(() => guest.getLifecycleState() === 'frozen');
+
+      await w.webContents.executeJavaScript('document.querySelector("webview").style.display = ""');
+      await waitUntil(() => guest.getLifecycleState() === 'active');
+    });
+  });
+
   describe('did-attach event', () => {
     afterEach(closeAllWindows);
     it('is emitted when a webview has been attached', async () => {
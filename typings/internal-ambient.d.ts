@@ -15,17 +15,22 @@ declare namespace NodeJS {
 
   interface IpcRendererBinding {
     send(internal: boolean, channel: string, args: any[]): void;
+    sendJSON(channel: string, json: string): void;
     sendSync(internal: boolean, channel: string, args: any[]): any;
     sendToHost(channel: string, args: any[]): void;
     sendTo(webContentsId: number, channel: string, args: any[]): void;
     invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
+    invokeSync<T>(channel: string, args: any[]): { error: string, result: T };
+    getSyncStats(): { sendSync: Electron.SyncIpcStats, invokeSync: Electron.SyncIpcStats };
     postMessage(channel: string, message: any, transferables: MessagePort[]): void;
+    setBatching(enabled: boolean, delay?: number): void;
   }
 
   interface V8UtilBinding {
     getHiddenValue<T>(obj: any, key: string): T;
     setHiddenValue<T>(obj: any, key: string, value: T): void;
     deleteHiddenValue(obj: any, key: string): void;
+    benchmarkValueConversion(value: any, iterations: number): { fromV8: number, toV8: number, genericFromV8: number, genericToV8: number };
     requestGarbageCollectionForTesting(): void;
     runUntilIdle(): void;
     triggerFatalErrorForTesting(): void;
@@ -53,27 +58,25 @@ declare namespace NodeJS {
     size: number;
     unpacked: boolean;
     offset: number;
+    // Only set for compressed files, the size of their frames.
+    packedSize?: number;
     integrity?: {
       algorithm: 'SHA256';
       hash: string;
     }
   };
 
-  type AsarFileStat = {
-    size: number;
-    offset: number;
-    isFile: boolean;
-    isDirectory: boolean;
-    isLink: boolean;
-  }
-
   interface AsarArchive {
     getFileInfo(path: string): AsarFileInfo | false;
-    stat(path: string): AsarFileStat | false;
+    statValues(path: string, values?: Float64Array): number;
+    statKinds(paths: string[]): Int32Array | false;
     readdir(path: string): string[] | false;
     realpath(path: string): string | false;
     copyFileOut(path: string): string | false;
+    prefetchFilesOut(paths: string[]): void;
     getFdAndValidateIntegrityLater(): number | -1;
+    readMappedAndValidateIntegrityLater(offset: number, size: number): Buffer | false;
+    readCompressed(path: string, frames?: Buffer): Buffer | false;
   }
 
   interface AsarBinding {
@@ -85,6 +88,8 @@ declare namespace NodeJS {
       asarPath: string;
       filePath: string;
     };
+    moduleStat(path: string): number;
+    moduleStats(paths: string[]): Int32Array | false;
     initAsarSupport(require: NodeJS.Require): void;
   }
 
@@ -110,6 +115,7 @@ declare namespace NodeJS {
 
   interface SessionBinding {
     fromPartition: typeof Electron.Session.fromPartition,
+    fromPartitionAsync: typeof Electron.Session.fromPartitionAsync,
     fromPath: typeof Electron.Session.fromPath,
     Session: typeof Electron.Session
   }
@@ -164,6 +170,9 @@ declare namespace NodeJS {
     mode?: string;
     destination?: string;
     bypassCustomProtocolHandlers?: boolean;
+    responseFile?: string;
+    readSize?: number;
+    uploadFile?: string;
   };
   type ResponseHead = {
     statusCode: number;
@@ -171,6 +180,7 @@ declare namespace NodeJS {
     httpVersion: { major: number, minor: number };
     rawHeaders: { key: string, value: string }[];
     headers: Record<string, string[]>;
+    fromCache: boolean;
   };
 
   type RedirectInfo = {
@@ -207,11 +217,20 @@ declare namespace NodeJS {
     _linkedBinding(name: 'electron_common_shell'): Electron.Shell;
     _linkedBinding(name: 'electron_common_v8_util'): V8UtilBinding;
     _linkedBinding(name: 'electron_browser_app'): { app: Electron.App, App: Function };
-    _linkedBinding(name: 'electron_browser_auto_updater'): { autoUpdater: Electron.AutoUpdater };
+    _linkedBinding(name: 'electron_browser_auto_updater'): {
+      autoUpdater: Electron.AutoUpdater;
+      createAsarDelta: Electron.AutoUpdater['createAsarDelta'];
+      applyAsarDelta: Electron.AutoUpdater['applyAsarDelta'];
+    };
     _linkedBinding(name: 'electron_browser_browser_view'): { BrowserView: typeof Electron.BrowserView };
+    _linkedBinding(name: 'electron_browser_capture_group'): { OffscreenCaptureGroup: typeof Electron.OffscreenCaptureGroup };
     _linkedBinding(name: 'electron_browser_crash_reporter'): CrashReporterBinding;
     _linkedBinding(name: 'electron_browser_desktop_capturer'): { createDesktopCapturer(): ElectronInternal.DesktopCapturer; };
-    _linkedBinding(name: 'electron_browser_event_emitter'): { setEventEmitterPrototype(prototype: Object): void; };
+    _linkedBinding(name: 'electron_browser_event_emitter'): {
+      setEventEmitterPrototype(prototype: Object): void;
+      getSkippedEmitCounts(): Record<string, number>;
+    };
+    _linkedBinding(name: 'electron_browser_file_watcher'): { FileWatcher: typeof Electron.FileWatcher };
     _linkedBinding(name: 'electron_browser_global_shortcut'): { globalShortcut: Electron.GlobalShortcut };
     _linkedBinding(name: 'electron_browser_image_view'): { ImageView: any };
     _linkedBinding(name: 'electron_browser_in_app_purchase'): { inAppPurchase: Electron.InAppPurchase };
@@ -51,6 +51,11 @@ declare namespace Electron {
     }
   }
 
+  interface Session {
+    _getBlobDataPipe(identifier: string): { read(): Promise<Buffer | null> } | null;
+    _cancelStorageClear(id: number): void;
+  }
+
   interface TouchBar {
     _removeFromWindow: (win: BrowserWindow) => void;
   }
@@ -80,11 +85,13 @@ declare namespace Electron {
     // <webview>
     attachToIframe(embedderWebContents: Electron.WebContents, embedderFrameId: number): void;
     detachFromOuterFrame(): void;
+    _setElementVisible(visible: boolean): void;
     setEmbedder(embedder: Electron.WebContents): void;
     viewInstanceId: number;
   }
 
   interface WebFrameMain {
+    _executeJavaScriptInFrames(code: string, routingIds: number[], userGesture: boolean): Promise<{ result?: any, error?: string }[]>;
     _send(internal: boolean, channel: string, args: any): void;
     _sendInternal(channel: string, ...args: any[]): void;
     _postMessage(channel: string, message: any, transfer?: any[]): void;
@@ -112,11 +119,14 @@ declare namespace Electron {
     _callMenuWillShow(): void;
     _executeCommand(event: KeyboardEvent, id: number): void;
     _menuWillShow(): void;
+    _itemChanged(item: MenuItem, property: string): void;
+    _notifyItemChanged(index: number): void;
     commandsMap: Record<string, MenuItem>;
     groupsMap: Record<string, MenuItem[]>;
     getItemCount(): number;
     popupAt(window: BaseWindow, x: number, y: number, positioning: number, sourceType: Required<Electron.PopupOptions>['sourceType'], callback: () => void): void;
     closePopupAt(id: number): void;
+    setLabel(index: number, label: string): void;
     setSublabel(index: number, label: string): void;
     setToolTip(index: number, tooltip: string): void;
     setIcon(index: number, image: string | NativeImage): void;
@@ -132,6 +142,7 @@ declare namespace Electron {
 
   interface MenuItem {
     overrideReadOnlyProperty(property: string, value: any): void;
+    overrideObservedProperty(property: string): void;
     groupId: number;
     getDefaultRoleAccelerator(): Accelerator | undefined;
     getCheckStatus(): boolean;
@@ -160,6 +171,9 @@ declare namespace Electron {
     static getAllWindows(): BaseWindow[];
     isFocused(): boolean;
     static getFocusedWindow(): BaseWindow | undefined;
+    static batch<T>(fn: () => T): T;
+    static _beginBatch(): void;
+    static _endBatch(): void;
     setMenu(menu: Menu): void;
   }
   class WebContentsView {
@@ -185,6 +199,7 @@ declare namespace Electron {
   interface Protocol {
     registerProtocol(scheme: string, handler: any): boolean;
     interceptProtocol(scheme: string, handler: any): boolean;
+    registerDirectoryProtocol(scheme: string, options: Electron.DirectoryProtocolOptions): boolean;
   }
 
   namespace Main {
@@ -199,6 +214,12 @@ declare namespace ElectronInternal {
     startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
     _onerror?: (error: string) => void;
     _onfinished?: (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => void;
+    startWatching(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, refreshInterval: number, maxThumbnailUpdates: number): void;
+    stopWatching(): void;
+    _onsourceadded?: (source: Electron.DesktopCapturerSource) => void;
+    _onsourceremoved?: (id: string) => void;
+    _onsourcenamechanged?: (id: string, name: string) => void;
+    _onthumbnailschanged?: (updates: { id: string, thumbnail: Electron.NativeImage }[]) => void;
   }
 
   interface GetSourcesOptions {
@@ -263,14 +284,26 @@ declare namespace ElectronInternal {
 
   interface UtilityProcessWrapper extends NodeJS.EventEmitter {
     readonly pid: (number) | (undefined);
+    readonly bufferedAmount: number;
     kill(): boolean;
-    postMessage(message: any, transfer?: any[]): void;
+    postMessage(message: any, transfer?: any[]): boolean;
+    setWatermarks(watermarks: Electron.Watermarks): void;
+    invoke(channel: string, args: any[]): Promise<{ error?: string, result?: any }>;
+    createSharedBuffer(name: string, size: number): SharedArrayBuffer;
+    routeInvoke(channel: string): void;
+    unrouteInvoke(channel: string): void;
+    takeHeapSnapshot(filePath: string, gzip: boolean, graphOnly: boolean): Promise<void>;
+    readOutput(stream: string): Electron.UtilityProcessOutput | null;
   }
 
   interface ParentPort extends NodeJS.EventEmitter {
     start(): void;
     pause(): void;
-    postMessage(message: any): void;
+    postMessage(message: any, transfer?: any[]): boolean;
+    postMessages(messages: any[]): boolean;
+    takeSharedBuffer(name: string): SharedArrayBuffer | undefined;
+    readonly bufferedAmount: number;
+    setWatermarks(watermarks: Electron.Watermarks): void;
   }
 
   class WebViewElement extends HTMLElement {